@@ -0,0 +1,93 @@
+# Build-time precompilation of the programs of Boost.Compute algorithms.
+#
+# boost_compute_embed_programs(<output_variable>
+#                              [NAME <name>]
+#                              [ALGORITHMS <algorithm>...]
+#                              [TYPES <type>...]
+#                              [DEVICES <device name>...])
+#
+# Adds a generator executable which runs boost::compute::warmup() for each
+# of the TYPES (e.g. "int" "float", by default "int") and ALGORITHMS (any
+# of "sort", "reduce", "scan", "min_max" or "all", the default) on each of
+# the DEVICES (parts of device names, by default the default device) and
+# writes the binaries of the programs it builds to a C++ source file. The
+# path of the source file is stored in <output_variable>, adding it to the
+# sources of an executable embeds the binaries, which are then used by the
+# program caches instead of compiling the programs at run time:
+#
+#   boost_compute_embed_programs(EMBEDDED_PROGRAMS
+#     ALGORITHMS sort reduce
+#     TYPES int float
+#     DEVICES "GTX 1080" "Radeon"
+#   )
+#   add_executable(server server.cpp ${EMBEDDED_PROGRAMS})
+#
+# The generator is compiled with the include directories of the calling
+# directory and linked with ${OPENCL_LIBRARIES} and ${Boost_LIBRARIES}. It
+# runs on the build machine, so the devices must be present there. Devices whose name or driver differs at run time fall back to
+# compiling the programs.
+
+set(BOOST_COMPUTE_EMBED_PROGRAMS_TEMPLATE
+  ${CMAKE_CURRENT_LIST_DIR}/BoostComputeEmbedPrograms.cpp.in
+)
+
+function(boost_compute_embed_programs output_variable)
+  set(name ${output_variable})
+  set(algorithms all)
+  set(types int)
+  set(devices)
+
+  set(list)
+  foreach(arg ${ARGN})
+    if(arg STREQUAL "NAME" OR arg STREQUAL "ALGORITHMS" OR
+       arg STREQUAL "TYPES" OR arg STREQUAL "DEVICES")
+      set(list ${arg})
+      if(arg STREQUAL "ALGORITHMS")
+        set(algorithms)
+      elseif(arg STREQUAL "TYPES")
+        set(types)
+      endif()
+    elseif(list STREQUAL "NAME")
+      set(name ${arg})
+    elseif(list STREQUAL "ALGORITHMS")
+      list(APPEND algorithms ${arg})
+    elseif(list STREQUAL "TYPES")
+      list(APPEND types ${arg})
+    elseif(list STREQUAL "DEVICES")
+      list(APPEND devices ${arg})
+    else()
+      message(FATAL_ERROR "boost_compute_embed_programs: unknown argument ${arg}")
+    endif()
+  endforeach()
+
+  # warmup_algorithm flags, mpl::vector of the types and device names
+  set(BOOST_COMPUTE_EMBED_ALGORITHMS "0")
+  foreach(algorithm ${algorithms})
+    set(BOOST_COMPUTE_EMBED_ALGORITHMS
+      "${BOOST_COMPUTE_EMBED_ALGORITHMS} | boost::compute::warmup_${algorithm}"
+    )
+  endforeach()
+  string(REPLACE ";" ", " BOOST_COMPUTE_EMBED_TYPES "${types}")
+  set(BOOST_COMPUTE_EMBED_DEVICES "")
+  foreach(device ${devices})
+    set(BOOST_COMPUTE_EMBED_DEVICES "${BOOST_COMPUTE_EMBED_DEVICES}\"${device}\", ")
+  endforeach()
+  set(BOOST_COMPUTE_EMBED_NAME ${name})
+
+  set(generator_source ${CMAKE_CURRENT_BINARY_DIR}/${name}_generator.cpp)
+  set(output ${CMAKE_CURRENT_BINARY_DIR}/${name}.cpp)
+
+  configure_file(${BOOST_COMPUTE_EMBED_PROGRAMS_TEMPLATE} ${generator_source} @ONLY)
+
+  add_executable(${name}_generator ${generator_source})
+  target_link_libraries(${name}_generator ${OPENCL_LIBRARIES} ${Boost_LIBRARIES})
+
+  add_custom_command(
+    OUTPUT ${output}
+    COMMAND ${name}_generator ${output}
+    DEPENDS ${name}_generator
+    COMMENT "Precompiling Boost.Compute programs for ${name}"
+  )
+
+  set(${output_variable} ${output} PARENT_SCOPE)
+endfunction()
@@ -13,7 +13,9 @@
 #include <opencv2/imgproc/imgproc.hpp>
 
 #include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/experimental/k_means.hpp>
 #include <boost/compute/image/image2d.hpp>
 #include <boost/compute/interop/opencv/core.hpp>
 #include <boost/compute/interop/opencv/highgui.hpp>
@@ -25,7 +27,7 @@
 namespace compute = boost::compute;
 
 using compute::dim;
-using compute::int_;
+using compute::uint_;
 using compute::float_;
 using compute::float2_;
 
@@ -59,87 +61,19 @@ int main()
         queue
     );
 
-    // initialize all points to cluster 0
-    compute::vector<int_> clusters(n_points, context);
-    compute::fill(clusters.begin(), clusters.end(), 0, queue);
+    // cluster of each point
+    compute::vector<uint_> clusters(n_points, context);
 
     // create initial means with the first k points
     compute::vector<float2_> means(k, context);
     compute::copy_n(points.begin(), k, means.begin(), queue);
 
-    // k-means clustering program source
-    const char k_means_source[] = BOOST_COMPUTE_STRINGIZE_SOURCE(
-        __kernel void assign_clusters(__global const float2 *points,
-                                      __global const float2 *means,
-                                      const int k,
-                                      __global int *clusters)
-        {
-            const uint gid = get_global_id(0);
-
-            const float2 point = points[gid];
-
-            // find the closest cluster
-            float current_distance = 0;
-            int closest_cluster = -1;
-
-            // find closest cluster mean to the point
-            for(int i = 0; i < k; i++){
-                const float2 mean = means[i];
-
-                int distance_to_mean = distance(point, mean);
-                if(closest_cluster == -1 || distance_to_mean < current_distance){
-                    current_distance = distance_to_mean;
-                    closest_cluster = i;
-                }
-            }
-
-            // write new cluster
-            clusters[gid] = closest_cluster;
-        }
-
-        __kernel void update_means(__global const float2 *points,
-                                   const uint n_points,
-                                   __global float2 *means,
-                                   __global const int *clusters)
-        {
-            const uint k = get_global_id(0);
-
-            float2 sum = { 0, 0 };
-            float count = 0;
-            for(uint i = 0; i < n_points; i++){
-                if(clusters[i] == k){
-                    sum += points[i];
-                    count += 1;
-                }
-            }
-
-            means[k] = sum / count;
-        }
+    // run the k-means algorithm for up to 25 iterations
+    compute::experimental::k_means(
+        points.begin(), points.end(), means.begin(), means.end(),
+        clusters.begin(), 25, 0, queue
     );
 
-    // build the k-means program
-    compute::program k_means_program =
-        compute::program::build_with_source(k_means_source, context);
-
-    // setup the k-means kernels
-    compute::kernel assign_clusters_kernel(k_means_program, "assign_clusters");
-    assign_clusters_kernel.set_arg(0, points);
-    assign_clusters_kernel.set_arg(1, means);
-    assign_clusters_kernel.set_arg(2, int_(k));
-    assign_clusters_kernel.set_arg(3, clusters);
-
-    compute::kernel update_means_kernel(k_means_program, "update_means");
-    update_means_kernel.set_arg(0, points);
-    update_means_kernel.set_arg(1, int_(n_points));
-    update_means_kernel.set_arg(2, means);
-    update_means_kernel.set_arg(3, clusters);
-
-    // run the k-means algorithm
-    for(int iteration = 0; iteration < 25; iteration++){
-        queue.enqueue_1d_range_kernel(assign_clusters_kernel, 0, n_points, 0);
-        queue.enqueue_1d_range_kernel(update_means_kernel, 0, k, 0);
-    }
-
     // create output image
     compute::image2d image(
         context, width, height, compute::image_format(CL_RGBA, CL_UNSIGNED_INT8)
@@ -149,7 +83,7 @@ int main()
     // one the draw to points calculated in coordinates on the image
     const char draw_walk_source[] = BOOST_COMPUTE_STRINGIZE_SOURCE(
         __kernel void draw_points(__global const float2 *points,
-                                  __global const int *clusters,
+                                  __global const uint *clusters,
                                   __write_only image2d_t image)
         {
             const uint i = get_global_id(0);
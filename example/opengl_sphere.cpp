@@ -97,16 +97,18 @@ compute::opengl_buffer tesselate_sphere(float radius,
     kernel.set_arg<compute::uint_>(2, theta_slices);
     kernel.set_arg(3, vertex_buffer);
 
-    // acqurire buffer so that it is accessible to OpenCL
-    compute::opengl_enqueue_acquire_buffer(vertex_buffer, queue);
-
-    // execute tesselate_sphere kernel
-    queue.enqueue_nd_range_kernel(
-        kernel, dim(0, 0), dim(phi_slices, theta_slices), dim(1, 1)
-    );
+    // acquire buffer so that it is accessible to OpenCL, it is released
+    // (and accessible to OpenGL again) at the end of the scope
+    {
+        compute::opengl_scoped_acquire acquire(
+            &vertex_buffer, &vertex_buffer + 1, queue
+        );
 
-    // release buffer so that it is accessible to OpenGL
-    compute::opengl_enqueue_release_buffer(vertex_buffer, queue);
+        // execute tesselate_sphere kernel
+        queue.enqueue_nd_range_kernel(
+            kernel, dim(0, 0), dim(phi_slices, theta_slices), dim(1, 1)
+        );
+    }
 
     return vertex_buffer;
 }
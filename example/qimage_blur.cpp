@@ -109,26 +109,27 @@ int main(int argc, char *argv[])
     compute::command_queue queue(context, gpu);
     std::cout << "device: " << gpu.name() << std::endl;
 
-    // get the opencl image format for the qimage
-    compute::image_format format =
-        compute::qt_qimage_format_to_image_format(qimage.format());
-
-    // create input and output images on the gpu
-    compute::image2d input_image(context, width, height, format);
-    compute::image2d output_image(context, width, height, format);
-
-    // copy host qimage to gpu image
-    compute::qt_copy_qimage_to_image2d(qimage, input_image, queue);
+    // create input and output images on the gpu which use the pixels of
+    // the qimages as their storage (without copies on integrated gpus)
+    const QImage &input_qimage = qimage;
+    QImage output_qimage(width, height, qimage.format());
+
+    compute::image2d input_image =
+        compute::qt_qimage_create_image2d(input_qimage, context);
+    compute::image2d output_image =
+        compute::qt_qimage_create_image2d(
+            output_qimage, context, compute::image2d::write_only
+        );
 
     // apply box filter
     box_filter_image(input_image, output_image, 7, 7, queue);
 
-    // copy gpu blurred image from to host qimage
-    compute::qt_copy_image2d_to_qimage(output_image, qimage, queue);
+    // make the blurred pixels available in the output qimage
+    compute::qt_sync_image2d_to_qimage_async(output_image, queue).wait();
 
     // show image as a pixmap
     QLabel label;
-    label.setPixmap(QPixmap::fromImage(qimage));
+    label.setPixmap(QPixmap::fromImage(output_qimage));
     label.show();
 
     return app.exec();
@@ -26,6 +26,7 @@
 #include <boost/compute/iterator.hpp>
 #include <boost/compute/kernel.hpp>
 #include <boost/compute/lambda.hpp>
+#include <boost/compute/linear_algebra.hpp>
 #include <boost/compute/pipe.hpp>
 #include <boost/compute/platform.hpp>
 #include <boost/compute/program.hpp>
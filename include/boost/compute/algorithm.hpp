@@ -16,19 +16,24 @@
 /// Meta-header to include all Boost.Compute algorithm headers.
 
 #include <boost/compute/algorithm/accumulate.hpp>
+#include <boost/compute/algorithm/aggregate_by_key.hpp>
 #include <boost/compute/algorithm/adjacent_difference.hpp>
 #include <boost/compute/algorithm/adjacent_find.hpp>
 #include <boost/compute/algorithm/all_of.hpp>
 #include <boost/compute/algorithm/any_of.hpp>
+#include <boost/compute/algorithm/apply_permutation.hpp>
 #include <boost/compute/algorithm/binary_search.hpp>
 #include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/copy_if.hpp>
 #include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/copy_rect.hpp>
 #include <boost/compute/algorithm/count.hpp>
 #include <boost/compute/algorithm/count_if.hpp>
 #include <boost/compute/algorithm/equal.hpp>
 #include <boost/compute/algorithm/equal_range.hpp>
 #include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/exclusive_scan_by_key.hpp>
+#include <boost/compute/algorithm/expand.hpp>
 #include <boost/compute/algorithm/fill.hpp>
 #include <boost/compute/algorithm/fill_n.hpp>
 #include <boost/compute/algorithm/find.hpp>
@@ -38,24 +43,30 @@
 #include <boost/compute/algorithm/for_each.hpp>
 #include <boost/compute/algorithm/for_each_n.hpp>
 #include <boost/compute/algorithm/gather.hpp>
+#include <boost/compute/algorithm/gather_if.hpp>
 #include <boost/compute/algorithm/generate.hpp>
 #include <boost/compute/algorithm/generate_n.hpp>
+#include <boost/compute/algorithm/histogram.hpp>
 #include <boost/compute/algorithm/inclusive_scan.hpp>
+#include <boost/compute/algorithm/inclusive_scan_by_key.hpp>
 #include <boost/compute/algorithm/includes.hpp>
 #include <boost/compute/algorithm/inner_product.hpp>
 #include <boost/compute/algorithm/iota.hpp>
 #include <boost/compute/algorithm/is_partitioned.hpp>
 #include <boost/compute/algorithm/is_permutation.hpp>
 #include <boost/compute/algorithm/is_sorted.hpp>
+#include <boost/compute/algorithm/load_balanced_search.hpp>
 #include <boost/compute/algorithm/lower_bound.hpp>
 #include <boost/compute/algorithm/lexicographical_compare.hpp> 
 #include <boost/compute/algorithm/max_element.hpp>
 #include <boost/compute/algorithm/merge.hpp>
+#include <boost/compute/algorithm/merge_runs.hpp>
 #include <boost/compute/algorithm/min_element.hpp>
 #include <boost/compute/algorithm/minmax_element.hpp>
 #include <boost/compute/algorithm/mismatch.hpp>
 #include <boost/compute/algorithm/next_permutation.hpp>
 #include <boost/compute/algorithm/none_of.hpp>
+#include <boost/compute/algorithm/partial_sort.hpp>
 #include <boost/compute/algorithm/partial_sum.hpp>
 #include <boost/compute/algorithm/partition.hpp>
 #include <boost/compute/algorithm/partition_copy.hpp>
@@ -63,28 +74,47 @@
 #include <boost/compute/algorithm/prev_permutation.hpp>
 #include <boost/compute/algorithm/random_shuffle.hpp>
 #include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/reduce_by_key.hpp>
+#include <boost/compute/algorithm/reduce_columns.hpp>
+#include <boost/compute/algorithm/reduce_rows.hpp>
 #include <boost/compute/algorithm/remove.hpp>
 #include <boost/compute/algorithm/remove_if.hpp>
 #include <boost/compute/algorithm/replace.hpp>
 #include <boost/compute/algorithm/replace_copy.hpp>
+#include <boost/compute/algorithm/reproducible_reduce.hpp>
 #include <boost/compute/algorithm/reverse.hpp>
 #include <boost/compute/algorithm/reverse_copy.hpp>
+#include <boost/compute/algorithm/rolling_reduce.hpp>
 #include <boost/compute/algorithm/rotate.hpp>
 #include <boost/compute/algorithm/rotate_copy.hpp>
+#include <boost/compute/algorithm/sample_if.hpp>
 #include <boost/compute/algorithm/scatter.hpp>
+#include <boost/compute/algorithm/scatter_add.hpp>
+#include <boost/compute/algorithm/scatter_if.hpp>
+#include <boost/compute/algorithm/scatter_reduce.hpp>
+#include <boost/compute/algorithm/scratch_size.hpp>
 #include <boost/compute/algorithm/search.hpp>
 #include <boost/compute/algorithm/search_n.hpp>
+#include <boost/compute/algorithm/search_patterns.hpp>
+#include <boost/compute/algorithm/segmented_sort.hpp>
 #include <boost/compute/algorithm/set_difference.hpp>
 #include <boost/compute/algorithm/set_intersection.hpp>
 #include <boost/compute/algorithm/set_symmetric_difference.hpp>
 #include <boost/compute/algorithm/set_union.hpp>
 #include <boost/compute/algorithm/sort.hpp>
 #include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/algorithm/sort_by_transform.hpp>
+#include <boost/compute/algorithm/sort_indices.hpp>
+#include <boost/compute/algorithm/sort_strings.hpp>
+#include <boost/compute/algorithm/split.hpp>
 #include <boost/compute/algorithm/stable_partition.hpp>
 #include <boost/compute/algorithm/stable_sort.hpp>
 #include <boost/compute/algorithm/swap_ranges.hpp>
+#include <boost/compute/algorithm/tabulate.hpp>
 #include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/algorithm/transform_if.hpp>
 #include <boost/compute/algorithm/transform_reduce.hpp>
+#include <boost/compute/algorithm/transpose.hpp>
 #include <boost/compute/algorithm/unique.hpp>
 #include <boost/compute/algorithm/unique_copy.hpp>
 #include <boost/compute/algorithm/upper_bound.hpp>
@@ -20,16 +20,50 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
 #include <boost/compute/algorithm/reduce.hpp>
 #include <boost/compute/algorithm/detail/serial_accumulate.hpp>
 #include <boost/compute/container/array.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/detail/device_future.hpp>
+#include <boost/compute/detail/enqueue_wait_list.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
 
 namespace boost {
 namespace compute {
 namespace detail {
 
+// accumulates the values of [first, last) and init to result on the device
+// with a single work-item
+template<class InputIterator, class OutputIterator, class T, class BinaryFunction>
+inline void accumulate_on_device(InputIterator first,
+                                 InputIterator last,
+                                 OutputIterator result,
+                                 T init,
+                                 BinaryFunction function,
+                                 command_queue &queue)
+{
+    serial_accumulate(first, last, result, init, function, queue);
+}
+
+// associative functions are reduced in parallel. generic_reduce() combines
+// the values in order, so the function need not be commutative, and init
+// is then combined with the reduced value.
+template<class InputIterator, class OutputIterator, class T, class Function>
+inline void accumulate_on_device(InputIterator first,
+                                 InputIterator last,
+                                 OutputIterator result,
+                                 T init,
+                                 associative_function<Function> function,
+                                 command_queue &queue)
+{
+    scratch_vector<T> value(1, queue);
+    generic_reduce(first, last, value.begin(), function, queue);
+    serial_accumulate(value.begin(), value.end(), result, init, function, queue);
+}
+
 template<class InputIterator, class T, class BinaryFunction>
 inline T generic_accumulate(InputIterator first,
                             InputIterator last,
@@ -46,7 +80,7 @@ inline T generic_accumulate(InputIterator first,
 
     // accumulate on device
     array<T, 1> device_result(context);
-    detail::serial_accumulate(
+    detail::accumulate_on_device(
         first, last, device_result.begin(), init, function, queue
     );
 
@@ -122,6 +156,29 @@ inline T dispatch_accumulate(InputIterator first,
     }
 }
 
+template<class InputIterator, class T, class BinaryFunction>
+inline future<T> dispatch_accumulate_async(InputIterator first,
+                                           InputIterator last,
+                                           T init,
+                                           BinaryFunction function,
+                                           command_queue &queue)
+{
+    boost::shared_ptr<device_future_value<T> > value =
+        boost::make_shared<device_future_value<T> >(queue);
+
+    if(first == last){
+        ::boost::compute::fill_n(value->begin(), 1, init, queue);
+    }
+    else if(can_accumulate_with_reduce(init, function)){
+        dispatch_reduce(first, last, value->begin(), function, queue);
+    }
+    else {
+        accumulate_on_device(first, last, value->begin(), init, function, queue);
+    }
+
+    return make_device_future(value, queue);
+}
+
 } // end detail namespace
 
 /// Returns the result of applying \p function to the elements in the
@@ -148,6 +205,10 @@ inline T dispatch_accumulate(InputIterator first,
 /// acceptable, the more efficient parallel \c reduce() algorithm should be
 /// used instead.
 ///
+/// Other functions are accumulated serially unless they are declared
+/// associative with \c make_associative(), in which case the values are
+/// reduced in parallel while preserving their order.
+///
 /// For example:
 /// \code
 /// // with vec = boost::compute::vector<int>
@@ -159,7 +220,7 @@ inline T dispatch_accumulate(InputIterator first,
 /// reduce(vec.begin(), vec.end(), &result, plus<float>()); // fast
 /// \endcode
 ///
-/// \see reduce()
+/// \see reduce(), make_associative()
 template<class InputIterator, class T, class BinaryFunction>
 inline T accumulate(InputIterator first,
                     InputIterator last,
@@ -167,9 +228,25 @@ inline T accumulate(InputIterator first,
                     BinaryFunction function,
                     command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("accumulate")
+
     return detail::dispatch_accumulate(first, last, init, function, queue);
 }
 
+/// \overload
+template<class InputIterator, class T, class BinaryFunction>
+inline T accumulate(InputIterator first,
+                    InputIterator last,
+                    T init,
+                    BinaryFunction function,
+                    command_queue &queue,
+                    const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::accumulate(first, last, init, function, queue);
+}
+
 /// \overload
 template<class InputIterator, class T>
 inline T accumulate(InputIterator first,
@@ -177,11 +254,92 @@ inline T accumulate(InputIterator first,
                     T init,
                     command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("accumulate")
+
     typedef typename std::iterator_traits<InputIterator>::value_type IT;
 
     return detail::dispatch_accumulate(first, last, init, plus<IT>(), queue);
 }
 
+/// \overload
+template<class InputIterator, class T>
+inline T accumulate(InputIterator first,
+                    InputIterator last,
+                    T init,
+                    command_queue &queue,
+                    const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::accumulate(first, last, init, queue);
+}
+
+/// Asynchronous version of accumulate(). The result is kept on the device
+/// until it is requested with \c future::get() so the host is not
+/// blocked while the values are accumulated.
+///
+/// For example:
+/// \code
+/// boost::compute::future<int> sum =
+///     boost::compute::accumulate_async(vec.begin(), vec.end(), 0, queue);
+/// // ... enqueue other work ...
+/// int result = sum.get();
+/// \endcode
+///
+/// \see accumulate(), reduce_async()
+template<class InputIterator, class T, class BinaryFunction>
+inline future<T> accumulate_async(InputIterator first,
+                                  InputIterator last,
+                                  T init,
+                                  BinaryFunction function,
+                                  command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("accumulate_async")
+
+    return detail::dispatch_accumulate_async(first, last, init, function, queue);
+}
+
+/// \overload
+template<class InputIterator, class T, class BinaryFunction>
+inline future<T> accumulate_async(InputIterator first,
+                                  InputIterator last,
+                                  T init,
+                                  BinaryFunction function,
+                                  command_queue &queue,
+                                  const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::accumulate_async(first, last, init, function, queue);
+}
+
+/// \overload
+template<class InputIterator, class T>
+inline future<T> accumulate_async(InputIterator first,
+                                  InputIterator last,
+                                  T init,
+                                  command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("accumulate_async")
+
+    typedef typename std::iterator_traits<InputIterator>::value_type IT;
+
+    return detail::dispatch_accumulate_async(first, last, init, plus<IT>(), queue);
+}
+
+/// \overload
+template<class InputIterator, class T>
+inline future<T> accumulate_async(InputIterator first,
+                                  InputIterator last,
+                                  T init,
+                                  command_queue &queue,
+                                  const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::accumulate_async(first, last, init, queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
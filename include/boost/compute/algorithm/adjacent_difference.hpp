@@ -12,13 +12,16 @@
 #define BOOST_COMPUTE_ALGORITHM_ADJACENT_DIFFERENCE_HPP
 
 #include <iterator>
+#include <algorithm>
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/adjacent_tile.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/functional/operator.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
 
 namespace boost {
 namespace compute {
@@ -48,20 +51,35 @@ adjacent_difference(InputIterator first,
         return result;
     }
 
-    size_t count = detail::iterator_range_size(first, last);
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    const size_t count = detail::iterator_range_size(first, last);
 
+    // each work-group loads its tile of values and the value before it
+    // into local memory once, so every value is read from global memory
+    // a single time instead of twice
     detail::meta_kernel k("adjacent_difference");
+    k.add_set_arg<uint_>("count", static_cast<uint_>(count));
+    size_t tile_arg = k.add_arg<value_type *>(memory_object::local_memory, "tile");
 
-    k << "const uint i = get_global_id(0);\n"
-      << "if(i == 0){\n"
-      << "    " << result[k.var<uint_>("0")] << " = " << first[k.var<uint_>("0")] << ";\n"
+    k << "const uint lid = get_local_id(0);\n"
+      << "const uint tile_start = get_group_id(0) * get_local_size(0);\n"
+      << "const uint i = tile_start + lid;\n";
+    detail::load_adjacent_tile(k, first, "tile");
+    k << "if(i == 0){\n"
+      << "    " << result[k.var<uint_>("0")] << " = tile[1];\n"
       << "}\n"
-      << "else {\n"
+      << "else if(i < count){\n"
       << "    " << result[k.var<uint_>("i")] << " = "
-      <<               op(first[k.var<uint_>("i")], first[k.var<uint_>("i-1")]) << ";\n"
+      <<               op(k.var<value_type>("tile[lid+1]"),
+                          k.var<value_type>("tile[lid]")) << ";\n"
       << "}\n";
 
-    k.exec_1d(queue, 0, count, 1);
+    const size_t work_group_size = k.work_group_size(queue, 256);
+    k.set_arg(tile_arg, local_buffer<value_type>(work_group_size + 1));
+
+    const size_t work_groups = (count + work_group_size - 1) / work_group_size;
+    k.exec_1d(queue, 0, work_groups * work_group_size, work_group_size);
 
     return result + count;
 }
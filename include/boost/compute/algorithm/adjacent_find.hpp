@@ -16,6 +16,7 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/detail/find_with_early_exit.hpp>
 #include <boost/compute/container/detail/scalar.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
@@ -64,6 +65,31 @@ serial_adjacent_find(InputIterator first,
     return first + output.read(queue);
 }
 
+// emits code which sets "match" to true if compare returns true for the
+// values at positions "i" and "i + 1"
+template<class InputIterator, class Compare>
+class adjacent_find_matcher
+{
+public:
+    adjacent_find_matcher(InputIterator first, Compare compare)
+        : m_first(first),
+          m_compare(compare)
+    {
+    }
+
+    void operator()(meta_kernel &k) const
+    {
+        k << "match = " << m_compare(m_first[k.expr<uint_>("i")],
+                                     m_first[k.expr<uint_>("i+1")]) << ";\n";
+    }
+
+private:
+    InputIterator m_first;
+    Compare m_compare;
+};
+
+// the work-items stop once an adjacent pair before their current chunk
+// has been found (see find_with_early_exit())
 template<class InputIterator, class Compare>
 inline InputIterator
 adjacent_find_with_atomics(InputIterator first,
@@ -71,32 +97,22 @@ adjacent_find_with_atomics(InputIterator first,
                            Compare compare,
                            command_queue &queue)
 {
-    if(first == last){
+    size_t count = detail::iterator_range_size(first, last);
+    if(count < 2){
         return last;
     }
 
-    const context &context = queue.get_context();
-    size_t count = detail::iterator_range_size(first, last);
-
-    // initialize output to the last index
-    detail::scalar<uint_> output(context);
-    output.write(static_cast<uint_>(count), queue);
-
-    detail::meta_kernel k("adjacent_find_with_atomics");
-
-    size_t output_arg = k.add_arg<uint_ *>(memory_object::global_memory, "output");
-
-    k << "const uint i = get_global_id(0);\n"
-      << "if(" << compare(first[k.expr<uint_>("i")],
-                          first[k.expr<uint_>("i+1")]) << "){\n"
-      << "    atomic_min(output, i);\n"
-      << "}\n";
-
-    k.set_arg(output_arg, output.get_buffer());
-
-    k.exec_1d(queue, 0, count - 1, 1);
+    const size_t index = find_with_early_exit(
+        count - 1,
+        adjacent_find_matcher<InputIterator, Compare>(first, compare),
+        false,
+        queue
+    );
+    if(index == count - 1){
+        return last;
+    }
 
-    return first + output.read(queue);
+    return first + index;
 }
 
 } // end detail namespace
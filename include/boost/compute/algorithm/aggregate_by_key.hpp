@@ -0,0 +1,642 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_AGGREGATE_BY_KEY_HPP
+#define BOOST_COMPUTE_ALGORITHM_AGGREGATE_BY_KEY_HPP
+
+#include <limits>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/gather.hpp>
+#include <boost/compute/algorithm/reduce_by_key.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
+#include <boost/compute/container/unordered_map.hpp>
+#include <boost/compute/functional/atomic.hpp>
+#include <boost/compute/functional/hash.hpp>
+#include <boost/compute/functional/integer.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/constant_iterator.hpp>
+#include <boost/compute/iterator/strided_iterator.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+enum aggregate_kind {
+    aggregate_count,
+    aggregate_sum,
+    aggregate_min,
+    aggregate_max,
+    aggregate_kinds
+};
+
+// the initial values of the min and max aggregates (in opencl c and on
+// the host)
+template<class T>
+struct aggregate_limits
+{
+    static const char* device_highest() { return "INT_MAX"; }
+    static const char* device_lowest() { return "INT_MIN"; }
+    static T highest() { return (std::numeric_limits<T>::max)(); }
+    static T lowest() { return (std::numeric_limits<T>::min)(); }
+};
+
+template<>
+struct aggregate_limits<uint_>
+{
+    static const char* device_highest() { return "UINT_MAX"; }
+    static const char* device_lowest() { return "0u"; }
+    static uint_ highest() { return (std::numeric_limits<uint_>::max)(); }
+    static uint_ lowest() { return 0; }
+};
+
+template<>
+struct aggregate_limits<float_>
+{
+    static const char* device_highest() { return "INFINITY"; }
+    static const char* device_lowest() { return "(-INFINITY)"; }
+    static float_ highest() { return std::numeric_limits<float_>::infinity(); }
+    static float_ lowest() { return -std::numeric_limits<float_>::infinity(); }
+};
+
+} // end detail namespace
+
+/// \class aggregators
+/// \brief The aggregates computed by aggregate_by_key().
+///
+/// Each aggregate is requested by passing the device range its values are
+/// stored in, one value per group:
+/// \code
+/// boost::compute::aggregators<float> aggregates;
+/// aggregates.count(counts.begin()).sum(sums.begin()).max(maxima.begin());
+/// \endcode
+///
+/// \see aggregate_by_key()
+template<class T>
+class aggregators
+{
+public:
+    typedef T value_type;
+
+    /// Creates an empty set of aggregates.
+    aggregators()
+    {
+        std::fill(m_requested, m_requested + detail::aggregate_kinds, false);
+    }
+
+    /// Stores the number of values of each group in \p result.
+    aggregators& count(const buffer_iterator<uint_> &result)
+    {
+        m_count = result;
+        m_requested[detail::aggregate_count] = true;
+        return *this;
+    }
+
+    /// Stores the sum of the values of each group in \p result.
+    aggregators& sum(const buffer_iterator<T> &result)
+    {
+        m_results[detail::aggregate_sum] = result;
+        m_requested[detail::aggregate_sum] = true;
+        return *this;
+    }
+
+    /// Stores the smallest value of each group in \p result.
+    aggregators& min(const buffer_iterator<T> &result)
+    {
+        m_results[detail::aggregate_min] = result;
+        m_requested[detail::aggregate_min] = true;
+        return *this;
+    }
+
+    /// Stores the largest value of each group in \p result.
+    aggregators& max(const buffer_iterator<T> &result)
+    {
+        m_results[detail::aggregate_max] = result;
+        m_requested[detail::aggregate_max] = true;
+        return *this;
+    }
+
+    /// \internal_
+    bool requested(detail::aggregate_kind kind) const
+    {
+        return m_requested[kind];
+    }
+
+    /// \internal_
+    const buffer_iterator<uint_>& count_result() const
+    {
+        return m_count;
+    }
+
+    /// \internal_
+    const buffer_iterator<T>& result(detail::aggregate_kind kind) const
+    {
+        return m_results[kind];
+    }
+
+private:
+    bool m_requested[detail::aggregate_kinds];
+    buffer_iterator<uint_> m_count;
+    buffer_iterator<T> m_results[detail::aggregate_kinds];
+};
+
+namespace detail {
+
+// returns the name of the function atomically combining a value of type T
+// with op ("add", "min" or "max") in address_space. float values are
+// updated with the functions of make_atomic_float_function_source().
+template<class T>
+inline std::string aggregate_atomic_function(meta_kernel &k,
+                                             const std::string &op,
+                                             const std::string &address_space)
+{
+    if(!boost::is_same<T, float_>::value){
+        return "atomic_" + op;
+    }
+
+    const std::string name =
+        "boost_aggregate_atomic_" + op + (address_space == "__local" ? "_local" : "_global");
+    k.add_function(name, make_atomic_float_function_source<float_>(name, op, address_space));
+
+    return name;
+}
+
+// writes the code combining the values (one expression per kind) into the
+// aggregates of slot in the arrays beginning with prefix
+template<class T>
+inline void aggregate_by_key_update(meta_kernel &k,
+                                    const aggregators<T> &aggregates,
+                                    const std::string &address_space,
+                                    const std::string &prefix,
+                                    const std::string &slot,
+                                    const std::string (&values)[aggregate_kinds])
+{
+    static const char *names[] = { "count", "sum", "min", "max" };
+    static const char *ops[] = { "add", "add", "min", "max" };
+
+    for(int kind = 0; kind < aggregate_kinds; kind++){
+        if(!aggregates.requested(aggregate_kind(kind))){
+            continue;
+        }
+
+        const std::string function = kind == aggregate_count ?
+            std::string("atomic_add") :
+            aggregate_atomic_function<T>(k, ops[kind], address_space);
+
+        k << function << "(&" << prefix << names[kind] << "[" << slot << "], " <<
+             values[kind] << ");\n";
+    }
+}
+
+// writes the code finding (or inserting) the key with the uint bits and
+// hash h in the global table. afterwards found is set and gslot is the
+// slot of the key.
+template<class Key>
+inline void aggregate_by_key_global_slot(meta_kernel &k)
+{
+    const uint_ empty = unordered_map_sentinels<Key>::empty();
+
+    k <<
+        "uint gslot = h & mask;\n" <<
+        "uint found = 0;\n" <<
+        "for(uint probe = 0; probe <= mask; probe++){\n" <<
+        "    const uint old = atomic_cmpxchg(&gkeys[gslot], " << empty << "u, bits);\n" <<
+        "    if(old == " << empty << "u || old == bits){\n" <<
+        "        found = 1;\n" <<
+        "        break;\n" <<
+        "    }\n" <<
+        "    gslot = (gslot + 1) & mask;\n" <<
+        "}\n";
+}
+
+// aggregates count values into a hash table of table_size slots (a power
+// of two) with one slot per group. each work-group aggregates its values
+// in a table of local_size slots in local memory first, values whose key
+// does not fit are aggregated in the global table directly.
+//
+// returns false if the global table was too small for the keys or if one
+// of the keys equals the empty() or erased() value of
+// unordered_map_sentinels<Key>, which mark the slots of the table.
+template<class KeyIterator, class ValueIterator, class OutputKeyIterator, class T>
+inline bool aggregate_by_key_with_hash(KeyIterator keys_first,
+                                       size_t count,
+                                       ValueIterator values_first,
+                                       OutputKeyIterator keys_result,
+                                       const aggregators<T> &aggregates,
+                                       size_t table_size,
+                                       size_t local_size,
+                                       size_t &groups,
+                                       command_queue &queue)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type key_type;
+
+    static const char *names[] = { "count", "sum", "min", "max" };
+
+    const context &context = queue.get_context();
+    const uint_ empty = unordered_map_sentinels<key_type>::empty();
+    const uint_ erased = unordered_map_sentinels<key_type>::erased();
+
+    // the global table
+    scratch_vector<key_type> keys(table_size, queue);
+    scratch_vector<uint_> counts(aggregates.requested(aggregate_count) ? table_size : 1, queue);
+    scratch_vector<T> sums(aggregates.requested(aggregate_sum) ? table_size : 1, queue);
+    scratch_vector<T> minima(aggregates.requested(aggregate_min) ? table_size : 1, queue);
+    scratch_vector<T> maxima(aggregates.requested(aggregate_max) ? table_size : 1, queue);
+    scratch_vector<uint_> overflow(1, queue);
+
+    fill(make_buffer_iterator<uint_>(keys.get_buffer(), 0),
+         make_buffer_iterator<uint_>(keys.get_buffer(), table_size),
+         empty,
+         queue);
+    fill(counts.begin(), counts.end(), uint_(0), queue);
+    fill(sums.begin(), sums.end(), T(0), queue);
+    fill(minima.begin(), minima.end(), aggregate_limits<T>::highest(), queue);
+    fill(maxima.begin(), maxima.end(), aggregate_limits<T>::lowest(), queue);
+    fill(overflow.begin(), overflow.end(), uint_(0), queue);
+
+    const std::string initial[] = {
+        "0", "0", aggregate_limits<T>::device_highest(), aggregate_limits<T>::device_lowest()
+    };
+    const std::string value_updates[] = { "1", "value", "value", "value" };
+    const std::string merge_updates[] = { "lcount[j]", "lsum[j]", "lmin[j]", "lmax[j]" };
+
+    meta_kernel k("aggregate_by_key_with_hash");
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t mask_arg = k.add_arg<const uint_>("mask");
+    size_t keys_arg = k.add_arg<uint_ *>(memory_object::global_memory, "gkeys");
+    size_t counts_arg = k.add_arg<uint_ *>(memory_object::global_memory, "gcount");
+    size_t sums_arg = k.add_arg<T *>(memory_object::global_memory, "gsum");
+    size_t minima_arg = k.add_arg<T *>(memory_object::global_memory, "gmin");
+    size_t maxima_arg = k.add_arg<T *>(memory_object::global_memory, "gmax");
+    size_t overflow_arg = k.add_arg<uint_ *>(memory_object::global_memory, "overflow");
+
+    k << "__local uint lkeys[" << uint_(local_size) << "];\n";
+    for(int kind = 0; kind < aggregate_kinds; kind++){
+        if(aggregates.requested(aggregate_kind(kind))){
+            k << "__local " << (kind == aggregate_count ? "uint" : type_name<T>()) <<
+                 " l" << names[kind] << "[" << uint_(local_size) << "];\n";
+        }
+    }
+
+    k <<
+        "const uint lid = get_local_id(0);\n" <<
+        "for(uint j = lid; j < " << uint_(local_size) << "; j += get_local_size(0)){\n" <<
+        "    lkeys[j] = " << empty << "u;\n";
+    for(int kind = 0; kind < aggregate_kinds; kind++){
+        if(aggregates.requested(aggregate_kind(kind))){
+            k << "    l" << names[kind] << "[j] = " << initial[kind] << ";\n";
+        }
+    }
+    k <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+
+        // aggregate the values of the work-group in the local table
+        "for(uint i = get_global_id(0); i < count; i += get_global_size(0)){\n" <<
+        "    " << k.decl<const key_type>("key") << " = " << keys_first[k.var<uint_>("i")] << ";\n" <<
+        "    " << k.decl<const T>("value") << " = " << values_first[k.var<uint_>("i")] << ";\n" <<
+        "    const uint bits = as_uint(key);\n" <<
+        "    if(bits == " << empty << "u || bits == " << erased << "u){\n" <<
+        // the key is one of the reserved values of the table
+        "        *overflow = 1;\n" <<
+        "        continue;\n" <<
+        "    }\n" <<
+        "    const uint h = (uint) " << hash<key_type>()(k.var<const key_type>("key")) << ";\n" <<
+        "    uint slot = h & " << uint_(local_size - 1) << ";\n" <<
+        "    uint stored = 0;\n" <<
+        "    for(uint probe = 0; probe < " << uint_(local_size) << "; probe++){\n" <<
+        "        const uint old = atomic_cmpxchg(&lkeys[slot], " << empty << "u, bits);\n" <<
+        "        if(old == " << empty << "u || old == bits){\n";
+    aggregate_by_key_update(k, aggregates, "__local", "l", "slot", value_updates);
+    k <<
+        "            stored = 1;\n" <<
+        "            break;\n" <<
+        "        }\n" <<
+        "        slot = (slot + 1) & " << uint_(local_size - 1) << ";\n" <<
+        "    }\n" <<
+        "    if(!stored){\n";
+    aggregate_by_key_global_slot<key_type>(k);
+    k <<
+        "        if(found){\n";
+    aggregate_by_key_update(k, aggregates, "__global", "g", "gslot", value_updates);
+    k <<
+        "        }\n" <<
+        "        else {\n" <<
+        "            *overflow = 1;\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+
+        // merge the local table into the global table
+        "for(uint j = lid; j < " << uint_(local_size) << "; j += get_local_size(0)){\n" <<
+        "    const uint bits = lkeys[j];\n" <<
+        "    if(bits == " << empty << "u){\n" <<
+        "        continue;\n" <<
+        "    }\n" <<
+        "    " << k.decl<const key_type>("key") << " = as_" << type_name<key_type>() << "(bits);\n" <<
+        "    const uint h = (uint) " << hash<key_type>()(k.var<const key_type>("key")) << ";\n";
+    aggregate_by_key_global_slot<key_type>(k);
+    k <<
+        "    if(found){\n";
+    aggregate_by_key_update(k, aggregates, "__global", "g", "gslot", merge_updates);
+    k <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        *overflow = 1;\n" <<
+        "    }\n" <<
+        "}\n";
+
+    const device &device = queue.get_device();
+    const size_t work_group_size =
+        get_work_group_size_parameter(device, "__boost_aggregate_by_key", "wgs", 256);
+    const size_t work_groups = (std::min)(
+        size_t(device.compute_units()) * 4,
+        (count + work_group_size - 1) / work_group_size
+    );
+
+    kernel kernel = k.compile(context);
+    kernel.set_arg(count_arg, static_cast<uint_>(count));
+    kernel.set_arg(mask_arg, static_cast<uint_>(table_size - 1));
+    kernel.set_arg(keys_arg, keys.get_buffer());
+    kernel.set_arg(counts_arg, counts.get_buffer());
+    kernel.set_arg(sums_arg, sums.get_buffer());
+    kernel.set_arg(minima_arg, minima.get_buffer());
+    kernel.set_arg(maxima_arg, maxima.get_buffer());
+    kernel.set_arg(overflow_arg, overflow.get_buffer());
+    queue.enqueue_1d_range_kernel(
+        kernel, 0, work_groups * work_group_size, work_group_size
+    );
+
+    if(read_single_value<uint_>(overflow.get_buffer(), 0, queue) != 0){
+        return false;
+    }
+
+    // the slots of the groups, ordered by their keys
+    scratch_vector<uint_> slots(table_size, queue);
+    buffer_iterator<uint_> slots_end = stream_compact(
+        keys.begin(),
+        table_size,
+        slots.begin(),
+        unordered_map_used_slot<key_type>(keys.begin()),
+        true,
+        queue
+    );
+    groups = iterator_range_size(slots.begin(), slots_end);
+
+    scratch_vector<key_type> group_keys(groups, queue);
+    gather(slots.begin(), slots_end, keys.begin(), group_keys.begin(), queue);
+    sort_by_key(group_keys.begin(), group_keys.end(), slots.begin(), queue);
+    copy(group_keys.begin(), group_keys.end(), keys_result, queue);
+
+    if(aggregates.requested(aggregate_count)){
+        gather(slots.begin(), slots_end, counts.begin(), aggregates.count_result(), queue);
+    }
+    if(aggregates.requested(aggregate_sum)){
+        gather(slots.begin(), slots_end, sums.begin(), aggregates.result(aggregate_sum), queue);
+    }
+    if(aggregates.requested(aggregate_min)){
+        gather(slots.begin(), slots_end, minima.begin(), aggregates.result(aggregate_min), queue);
+    }
+    if(aggregates.requested(aggregate_max)){
+        gather(slots.begin(), slots_end, maxima.begin(), aggregates.result(aggregate_max), queue);
+    }
+
+    return true;
+}
+
+// sorts a copy of the keys and values and reduces each requested
+// aggregate with reduce_by_key()
+template<class KeyIterator, class ValueIterator, class OutputKeyIterator, class T>
+inline size_t aggregate_by_key_with_sort(KeyIterator keys_first,
+                                         size_t count,
+                                         ValueIterator values_first,
+                                         OutputKeyIterator keys_result,
+                                         const aggregators<T> &aggregates,
+                                         command_queue &queue)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type key_type;
+
+    scratch_vector<key_type> keys(count, queue);
+    scratch_vector<T> values(count, queue);
+    copy_n(keys_first, count, keys.begin(), queue);
+    copy_n(values_first, count, values.begin(), queue);
+    sort_by_key(keys.begin(), keys.end(), values.begin(), queue);
+
+    // the keys of the groups are written by each reduction
+    scratch_vector<key_type> group_keys(count, queue);
+    buffer_iterator<key_type> group_keys_end = group_keys.begin();
+    bool reduced = false;
+
+    if(aggregates.requested(aggregate_count)){
+        group_keys_end = reduce_by_key(
+            keys.begin(), keys.end(), make_constant_iterator<uint_>(1),
+            group_keys.begin(), aggregates.count_result(), plus<uint_>(), queue
+        ).first;
+        reduced = true;
+    }
+    if(aggregates.requested(aggregate_sum)){
+        group_keys_end = reduce_by_key(
+            keys.begin(), keys.end(), values.begin(),
+            group_keys.begin(), aggregates.result(aggregate_sum), plus<T>(), queue
+        ).first;
+        reduced = true;
+    }
+    if(aggregates.requested(aggregate_min)){
+        group_keys_end = reduce_by_key(
+            keys.begin(), keys.end(), values.begin(),
+            group_keys.begin(), aggregates.result(aggregate_min), min<T>(), queue
+        ).first;
+        reduced = true;
+    }
+    if(aggregates.requested(aggregate_max)){
+        group_keys_end = reduce_by_key(
+            keys.begin(), keys.end(), values.begin(),
+            group_keys.begin(), aggregates.result(aggregate_max), max<T>(), queue
+        ).first;
+        reduced = true;
+    }
+    if(!reduced){
+        // only the keys of the groups were requested
+        scratch_vector<uint_> discarded(count, queue);
+        group_keys_end = reduce_by_key(
+            keys.begin(), keys.end(), make_constant_iterator<uint_>(1),
+            group_keys.begin(), discarded.begin(), plus<uint_>(), queue
+        ).first;
+    }
+
+    copy(group_keys.begin(), group_keys_end, keys_result, queue);
+
+    return iterator_range_size(group_keys.begin(), group_keys_end);
+}
+
+// returns the number of distinct keys in a sample of the count keys
+// beginning at keys_first and stores the size of the sample in sample_size
+template<class KeyIterator>
+inline size_t aggregate_by_key_sample_groups(KeyIterator keys_first,
+                                             size_t count,
+                                             size_t &sample_size,
+                                             command_queue &queue)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type key_type;
+
+    sample_size = (std::min)(count, size_t(1024));
+    const size_t stride = count / sample_size;
+
+    std::vector<key_type> sample(sample_size);
+    strided_iterator<KeyIterator> sample_first =
+        make_strided_iterator(keys_first, static_cast<std::ptrdiff_t>(stride));
+    copy(sample_first, sample_first + sample_size, sample.begin(), queue);
+
+    std::sort(sample.begin(), sample.end());
+    return static_cast<size_t>(
+        std::unique(sample.begin(), sample.end()) - sample.begin()
+    );
+}
+
+} // end detail namespace
+
+/// Groups the values in the range beginning at \p values_first by the
+/// keys in the range [\p keys_first, \p keys_last) and computes the
+/// requested \p aggregates (the count, sum, minimum and maximum) of the
+/// values of each group. The distinct keys are written in ascending order
+/// to the range beginning at \p keys_result and the aggregates of each
+/// group to the same position of the result ranges of \p aggregates.
+///
+/// Returns the number of groups.
+///
+/// Unlike reduce_by_key(), the keys do not need to be sorted. For keys of
+/// few groups (as estimated from a sample of the keys) the values are
+/// aggregated with atomics in a hash table, of which each work-group keeps
+/// a private copy in local memory. Otherwise the keys and values are
+/// sorted and each aggregate is computed with reduce_by_key().
+///
+/// For example, to compute the number and the sum of the values of each
+/// key:
+/// \code
+/// boost::compute::aggregators<float> aggregates;
+/// aggregates.count(counts.begin()).sum(sums.begin());
+///
+/// size_t groups = boost::compute::aggregate_by_key(
+///     keys.begin(), keys.end(), values.begin(), group_keys.begin(), aggregates, queue
+/// );
+/// \endcode
+///
+/// The keys must be 32-bit types supported by \ref hash "hash<Key>". Keys
+/// equal to one of the values unordered_map reserves for empty and erased
+/// slots are detected by the hash table, which then falls back to sorting.
+/// The values must be \c int_, \c uint_ or \c float_. The order in which float
+/// values are added is unspecified.
+///
+/// The largest number of sampled groups for which the hash table is used
+/// is the \c "hash_threshold" parameter of the \c "__boost_aggregate_by_key"
+/// object in the parameter cache (zero always sorts).
+///
+/// \see reduce_by_key(), unordered_map
+template<class InputKeyIterator, class InputValueIterator, class OutputKeyIterator, class T>
+inline size_t aggregate_by_key(InputKeyIterator keys_first,
+                               InputKeyIterator keys_last,
+                               InputValueIterator values_first,
+                               OutputKeyIterator keys_result,
+                               const aggregators<T> &aggregates,
+                               command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputKeyIterator>::value_type key_type;
+
+    BOOST_STATIC_ASSERT_MSG(
+        sizeof(key_type) == sizeof(uint_),
+        "aggregate_by_key keys must be 32-bit types"
+    );
+    BOOST_STATIC_ASSERT_MSG(
+        (boost::is_same<T, int_>::value ||
+         boost::is_same<T, uint_>::value ||
+         boost::is_same<T, float_>::value),
+        "aggregate_by_key values must be int_, uint_ or float_"
+    );
+
+    const size_t count = detail::iterator_range_size(keys_first, keys_last);
+    if(count == 0){
+        return 0;
+    }
+
+    const device &device = queue.get_device();
+    boost::shared_ptr<detail::parameter_cache> parameters =
+        detail::parameter_cache::get_global_cache(device);
+    const size_t hash_threshold =
+        parameters->get("__boost_aggregate_by_key", "hash_threshold", uint_(1024));
+
+    // the hash table is used if the keys repeat within the sample and
+    // have few groups
+    size_t sample_size = 0;
+    const size_t sampled_groups =
+        detail::aggregate_by_key_sample_groups(keys_first, count, sample_size, queue);
+
+    if(sampled_groups <= hash_threshold && sampled_groups * 2 <= sample_size){
+        // the global table has room for four times the sampled groups and
+        // the local tables are as large as fits half of the local memory
+        size_t table_size = 64;
+        while(table_size < sampled_groups * 4){
+            table_size *= 2;
+        }
+
+        size_t slot_bytes = sizeof(uint_);
+        for(int kind = 0; kind < detail::aggregate_kinds; kind++){
+            if(aggregates.requested(detail::aggregate_kind(kind))){
+                slot_bytes += sizeof(T);
+            }
+        }
+
+        const size_t local_limit =
+            static_cast<size_t>(detail::device_profile::get(device)->local_memory_size()) / 2 / slot_bytes;
+        size_t local_size = 16;
+        while(local_size * 2 <= local_limit && local_size < sampled_groups * 2){
+            local_size *= 2;
+        }
+
+        size_t groups = 0;
+        if(detail::aggregate_by_key_with_hash(keys_first, count, values_first, keys_result,
+                                              aggregates, table_size, local_size, groups, queue)){
+            return groups;
+        }
+
+        // the sample missed too many groups for the table (or a key is
+        // reserved by the table), sort instead
+    }
+
+    return detail::aggregate_by_key_with_sort(
+        keys_first, count, values_first, keys_result, aggregates, queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_AGGREGATE_BY_KEY_HPP
@@ -0,0 +1,61 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_APPLY_PERMUTATION_HPP
+#define BOOST_COMPUTE_ALGORITHM_APPLY_PERMUTATION_HPP
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/gather_columns.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Copies the values of the range beginning at \p input in the order given
+/// by the indices in the range [\p first, \p last) to the range beginning
+/// at \p result, i.e. the value at \c input[first[i]] is copied to
+/// \c result[i] (like gather()).
+///
+/// The input and output may be zip_iterator's, in which case each column
+/// of the input is copied to the corresponding column of the output by a
+/// single kernel reading each index once. This applies a permutation
+/// returned by sort_indices() to several ranges at once.
+///
+/// The output ranges must not overlap with the input ranges.
+///
+/// \see sort_indices(), gather()
+template<class IndexIterator, class InputIterator, class OutputIterator>
+inline void apply_permutation(IndexIterator first,
+                              IndexIterator last,
+                              InputIterator input,
+                              OutputIterator result,
+                              command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("apply_permutation")
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    detail::meta_kernel k("apply_permutation");
+    k << "const uint i = get_global_id(0);\n" <<
+         "const uint p = " << first[k.var<uint_>("i")] << ";\n";
+    detail::gather_columns(k, input, result);
+
+    k.exec_1d(queue, 0, count);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_APPLY_PERMUTATION_HPP
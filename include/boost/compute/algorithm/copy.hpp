@@ -13,6 +13,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <vector>
 
 #include <boost/utility/enable_if.hpp>
 
@@ -22,12 +23,19 @@
 #include <boost/compute/buffer.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/copy_between_contexts.hpp>
+#include <boost/compute/algorithm/detail/copy_bits.hpp>
+#include <boost/compute/algorithm/detail/copy_convert.hpp>
 #include <boost/compute/algorithm/detail/copy_on_device.hpp>
 #include <boost/compute/algorithm/detail/copy_to_device.hpp>
 #include <boost/compute/algorithm/detail/copy_to_host.hpp>
 #include <boost/compute/async/future.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/enqueue_wait_list.hpp>
 #include <boost/compute/detail/is_contiguous_iterator.hpp>
+#include <boost/compute/detail/pinned_host_registry.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/staging_ring.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/type_traits/is_device_iterator.hpp>
 
@@ -56,6 +64,86 @@ struct can_copy_with_copy_buffer :
         >
     >::type {};
 
+// returns true if copies between the host and buffer can map the buffer
+// instead of transferring the values. this is the case for buffers in host
+// memory (allocated or used by the implementation, see mapped_view and
+// zero_copy_allocator) on devices sharing their memory with the host.
+inline bool can_copy_by_mapping(const buffer &buffer, command_queue &queue)
+{
+    const cl_mem_flags host_memory = CL_MEM_ALLOC_HOST_PTR | CL_MEM_USE_HOST_PTR;
+    if((buffer.get_memory_flags() & host_memory) == 0){
+        return false;
+    }
+
+    return device_profile::get(queue.get_device())->host_unified_memory();
+}
+
+// copies [first, last) to result by mapping its buffer if possible (see
+// can_copy_by_mapping()), otherwise nothing is copied and false is returned
+template<class HostIterator, class DeviceIterator>
+inline bool try_copy_to_device_map(HostIterator,
+                                   HostIterator,
+                                   DeviceIterator &,
+                                   command_queue &)
+{
+    return false;
+}
+
+template<class HostIterator, class T>
+inline bool try_copy_to_device_map(HostIterator first,
+                                   HostIterator last,
+                                   buffer_iterator<T> &result,
+                                   command_queue &queue)
+{
+    if(!can_copy_by_mapping(result.get_buffer(), queue)){
+        return false;
+    }
+
+    result = copy_to_device_map(first, last, result, queue);
+    return true;
+}
+
+// copies [first, last) to result by mapping the buffer of first if possible
+// (see can_copy_by_mapping()), otherwise nothing is copied and false is
+// returned
+template<class DeviceIterator, class HostIterator>
+inline bool try_copy_to_host_map(DeviceIterator,
+                                 DeviceIterator,
+                                 HostIterator &,
+                                 command_queue &)
+{
+    return false;
+}
+
+template<class T, class HostIterator>
+inline bool try_copy_to_host_map(buffer_iterator<T> first,
+                                 buffer_iterator<T> last,
+                                 HostIterator &result,
+                                 command_queue &queue)
+{
+    if(!can_copy_by_mapping(first.get_buffer(), queue)){
+        return false;
+    }
+
+    result = copy_to_host_map(first, last, result, queue);
+    return true;
+}
+
+// returns true if the host range of count values beginning at first is
+// pinned memory (see pinned_host_vector, whose iterators are pointers),
+// which the driver can transfer directly without staging
+template<class HostIterator>
+inline bool is_pinned_host_range(HostIterator, size_t)
+{
+    return false;
+}
+
+template<class T>
+inline bool is_pinned_host_range(T *first, size_t count)
+{
+    return is_pinned_host_memory(first, count * sizeof(T));
+}
+
 // host -> device
 template<class InputIterator, class OutputIterator>
 inline OutputIterator
@@ -68,18 +156,51 @@ dispatch_copy(InputIterator first,
                   is_device_iterator<OutputIterator>::value
               >::type* = 0)
 {
-    if(is_contiguous_iterator<InputIterator>::value){
+    typedef typename std::iterator_traits<OutputIterator>::value_type T;
+
+    if(try_copy_to_device_map(first, last, result, queue)){
+        return result;
+    }
+
+    // copies between different scalar types transfer the smaller type
+    if(try_copy_to_device_convert(first, last, result, queue)){
+        return result;
+    }
+
+    // large copies from pageable host memory and all copies from
+    // non-contiguous input go through the pinned staging ring of the queue
+    const size_t count = iterator_range_size(first, last);
+    if(is_contiguous_iterator<InputIterator>::value &&
+       (count * sizeof(T) < staging_ring::threshold(queue) ||
+        is_pinned_host_range(first, count))){
         return copy_to_device(first, last, result, queue);
     }
     else {
-        // for non-contiguous input we first copy the values to
-        // a temporary std::vector and then copy from there
-        typedef typename std::iterator_traits<InputIterator>::value_type T;
-        std::vector<T> vector(first, last);
-        return copy_to_device(vector.begin(), vector.end(), result, queue);
+        return copy_to_device_staged(first, last, result, queue);
     }
 }
 
+// host -> device (std::vector<bool>, transferred as bits)
+template<class T>
+inline buffer_iterator<T>
+dispatch_copy(std::vector<bool>::const_iterator first,
+              std::vector<bool>::const_iterator last,
+              buffer_iterator<T> result,
+              command_queue &queue)
+{
+    return copy_bits_to_device(first, last, result, queue);
+}
+
+template<class T>
+inline buffer_iterator<T>
+dispatch_copy(std::vector<bool>::iterator first,
+              std::vector<bool>::iterator last,
+              buffer_iterator<T> result,
+              command_queue &queue)
+{
+    return copy_bits_to_device(first, last, result, queue);
+}
+
 // host -> device (async)
 template<class InputIterator, class OutputIterator>
 inline future<OutputIterator>
@@ -112,19 +233,41 @@ dispatch_copy(InputIterator first,
                   !is_device_iterator<OutputIterator>::value
               >::type* = 0)
 {
-    if(is_contiguous_iterator<OutputIterator>::value){
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    if(try_copy_to_host_map(first, last, result, queue)){
+        return result;
+    }
+
+    // copies between different scalar types transfer the smaller type
+    if(try_copy_to_host_convert(first, last, result, queue)){
+        return result;
+    }
+
+    // large copies to pageable host memory and all copies to
+    // non-contiguous output go through the pinned staging ring of the queue
+    const size_t count = iterator_range_size(first, last);
+    if(is_contiguous_iterator<OutputIterator>::value &&
+       (count * sizeof(T) < staging_ring::threshold(queue) ||
+        is_pinned_host_range(result, count))){
         return copy_to_host(first, last, result, queue);
     }
     else {
-        // for non-contiguous input we first copy the values to
-        // a temporary std::vector and then copy from there
-        typedef typename std::iterator_traits<InputIterator>::value_type T;
-        std::vector<T> vector(iterator_range_size(first, last));
-        copy_to_host(first, last, vector.begin(), queue);
-        return std::copy(vector.begin(), vector.end(), result);
+        return copy_to_host_staged(first, last, result, queue);
     }
 }
 
+// device -> host (std::vector<bool>, transferred as bits)
+template<class T>
+inline std::vector<bool>::iterator
+dispatch_copy(const buffer_iterator<T> first,
+              const buffer_iterator<T> last,
+              std::vector<bool>::iterator result,
+              command_queue &queue)
+{
+    return copy_bits_to_host(first, last, result, queue);
+}
+
 // device -> host (async)
 template<class InputIterator, class OutputIterator>
 inline future<OutputIterator>
@@ -193,6 +336,10 @@ dispatch_copy(InputIterator first,
         return result;
     }
 
+    if(is_copy_between_contexts(first.get_buffer(), result.get_buffer(), queue)){
+        return copy_between_contexts(first, last, result, queue);
+    }
+
     queue.enqueue_copy_buffer(first.get_buffer(),
                               result.get_buffer(),
                               first.get_index() * sizeof(value_type),
@@ -249,6 +396,11 @@ dispatch_copy_async(InputIterator first,
         return make_future(result, event());
     }
 
+    if(is_copy_between_contexts(first.get_buffer(), result.get_buffer(), queue)){
+        // the copy is staged through the host, which waits for it
+        return make_future(copy_between_contexts(first, last, result, queue), event());
+    }
+
     event event_ =
 		queue.enqueue_copy_buffer_async(
             first.get_buffer(),
@@ -295,6 +447,17 @@ dispatch_copy(InputIterator first,
 /// with non-contiguous data-structures (e.g. \c std::list<T>) as
 /// well as with "fancy" iterators (e.g. transform_iterator).
 ///
+/// Copies between the host and the device of different scalar types
+/// (e.g. from a \c std::vector<uchar_> to a \c vector<float>) transfer the
+/// smaller of the two types: widening conversions are done on the device
+/// with one kernel and narrowing ones on the host, so no more than the
+/// compact values cross the bus.
+///
+/// copy() also copies between buffers of different contexts (e.g. of
+/// devices from different platforms). The values are then staged
+/// through pinned host memory in chunks, writing each chunk to the
+/// destination while the next one is read from the source.
+///
 /// \param first first element in the range to copy
 /// \param last last element in the range to copy
 /// \param result first element in the result range
@@ -339,9 +502,24 @@ inline OutputIterator copy(InputIterator first,
                            OutputIterator result,
                            command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("copy")
+
     return detail::dispatch_copy(first, last, result, queue);
 }
 
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline OutputIterator copy(InputIterator first,
+                           InputIterator last,
+                           OutputIterator result,
+                           command_queue &queue,
+                           const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::copy(first, last, result, queue);
+}
+
 /// Copies the values in the range [\p first, \p last) to the range
 /// beginning at \p result. The copy is performed asynchronously.
 ///
@@ -356,6 +534,20 @@ copy_async(InputIterator first,
     return detail::dispatch_copy_async(first, last, result, queue);
 }
 
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline future<OutputIterator>
+copy_async(InputIterator first,
+           InputIterator last,
+           OutputIterator result,
+           command_queue &queue,
+           const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::copy_async(first, last, result, queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
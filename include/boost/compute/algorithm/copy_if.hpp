@@ -17,6 +17,7 @@
 #include <boost/compute/algorithm/count.hpp>
 #include <boost/compute/algorithm/count_if.hpp>
 #include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
@@ -34,49 +35,14 @@ inline OutputIterator copy_if_impl(InputIterator first,
                                    bool copyIndex,
                                    command_queue &queue)
 {
-    typedef typename std::iterator_traits<OutputIterator>::difference_type difference_type;
-
-    size_t count = detail::iterator_range_size(first, last);
-    if(count == 0){
-        return result;
-    }
-
-    const context &context = queue.get_context();
-
-    // storage for destination indices
-    ::boost::compute::vector<cl_uint> indices(count, context);
-
-    // write counts
-    ::boost::compute::detail::meta_kernel k1("copy_if_write_counts");
-    k1 << indices.begin()[k1.get_global_id(0)] << " = "
-           << predicate(first[k1.get_global_id(0)]) << " ? 1 : 0;\n";
-    k1.exec_1d(queue, 0, count);
-
-    // count number of elements to be copied
-    size_t copied_element_count =
-        ::boost::compute::count(indices.begin(), indices.end(), 1, queue);
-
-    // scan indices
-    ::boost::compute::exclusive_scan(indices.begin(),
-                                     indices.end(),
-                                     indices.begin(),
-                                     queue);
-
-    // copy values
-    ::boost::compute::detail::meta_kernel k2("copy_if_do_copy");
-    k2 << "if(" << predicate(first[k2.get_global_id(0)]) << ")" <<
-          "    " << result[indices.begin()[k2.get_global_id(0)]] << "=";
-
-    if(copyIndex){
-        k2 << k2.get_global_id(0) << ";\n";
-    }
-    else {
-        k2 << first[k2.get_global_id(0)] << ";\n";
-    }
-
-    k2.exec_1d(queue, 0, count);
-
-    return result + static_cast<difference_type>(copied_element_count);
+    return detail::stream_compact(
+        first,
+        detail::iterator_range_size(first, last),
+        result,
+        stream_compact_if<InputIterator, Predicate>(first, predicate),
+        copyIndex,
+        queue
+    );
 }
 
 template<class InputIterator, class Predicate>
@@ -101,6 +67,8 @@ inline OutputIterator copy_index_if(InputIterator first,
                                     Predicate predicate,
                                     command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("copy_index_if")
+
     return detail::copy_if_impl(first, last, result, predicate, true, queue);
 }
 
@@ -115,6 +83,8 @@ inline OutputIterator copy_if(InputIterator first,
                               Predicate predicate,
                               command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("copy_if")
+
     return detail::copy_if_impl(first, last, result, predicate, false, queue);
 }
 
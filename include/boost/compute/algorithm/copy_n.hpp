@@ -14,6 +14,7 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/detail/enqueue_wait_list.hpp>
 
 namespace boost {
 namespace compute {
@@ -37,6 +38,8 @@ inline OutputIterator copy_n(InputIterator first,
                              OutputIterator result,
                              command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("copy_n")
+
     typedef typename std::iterator_traits<InputIterator>::difference_type difference_type;
 
     return ::boost::compute::copy(first,
@@ -45,6 +48,19 @@ inline OutputIterator copy_n(InputIterator first,
                                   queue);
 }
 
+/// \overload
+template<class InputIterator, class Size, class OutputIterator>
+inline OutputIterator copy_n(InputIterator first,
+                             Size count,
+                             OutputIterator result,
+                             command_queue &queue,
+                             const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::copy_n(first, count, result, queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
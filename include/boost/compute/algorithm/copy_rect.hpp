@@ -0,0 +1,189 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_COPY_RECT_HPP
+#define BOOST_COMPUTE_ALGORITHM_COPY_RECT_HPP
+
+#include <boost/assert.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+
+#if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// fills the origin and region (in bytes for the first dimension) of a
+// width x height rectangle of values of type T starting at index
+template<class T>
+inline void copy_rect_extents(size_t index,
+                              size_t width,
+                              size_t height,
+                              size_t origin[3],
+                              size_t region[3])
+{
+    origin[0] = index * sizeof(T);
+    origin[1] = 0;
+    origin[2] = 0;
+
+    region[0] = width * sizeof(T);
+    region[1] = height;
+    region[2] = 1;
+}
+
+} // end detail namespace
+
+/// Copies the \p width x \p height rectangle of values starting at
+/// \p first, whose rows are \p first_pitch values apart, to the rectangle
+/// starting at \p result, whose rows are \p result_pitch values apart.
+/// Returns an iterator to the value following the last row of the result.
+///
+/// The copy is done by the device with \c clEnqueueCopyBufferRect without
+/// launching a kernel.
+///
+/// For example, to copy the 64x64 block at row 32 and column 16 of a
+/// 1024x1024 matrix to a packed 64x64 matrix:
+///
+/// \code
+/// boost::compute::copy_rect(
+///     matrix.begin() + 32 * 1024 + 16, 1024,
+///     block.begin(), 64,
+///     64, 64,
+///     queue
+/// );
+/// \endcode
+///
+/// \opencl_version_warning{1,1}
+///
+/// \see copy(), transpose()
+template<class T>
+inline buffer_iterator<T>
+copy_rect(const buffer_iterator<T> &first,
+          size_t first_pitch,
+          const buffer_iterator<T> &result,
+          size_t result_pitch,
+          size_t width,
+          size_t height,
+          command_queue &queue = system::default_queue())
+{
+    BOOST_ASSERT(width <= first_pitch && width <= result_pitch);
+    if(width == 0 || height == 0){
+        return result;
+    }
+
+    size_t src_origin[3];
+    size_t dst_origin[3];
+    size_t region[3];
+    detail::copy_rect_extents<T>(first.get_index(), width, height, src_origin, region);
+    detail::copy_rect_extents<T>(result.get_index(), width, height, dst_origin, region);
+
+    queue.enqueue_copy_buffer_rect(
+        first.get_buffer(),
+        result.get_buffer(),
+        src_origin,
+        dst_origin,
+        region,
+        first_pitch * sizeof(T),
+        0,
+        result_pitch * sizeof(T),
+        0
+    );
+
+    return result + static_cast<std::ptrdiff_t>(height * result_pitch);
+}
+
+/// \overload
+///
+/// Copies a pitched rectangle from the host to the device with
+/// \c clEnqueueWriteBufferRect.
+template<class T>
+inline buffer_iterator<T>
+copy_rect(const T *first,
+          size_t first_pitch,
+          const buffer_iterator<T> &result,
+          size_t result_pitch,
+          size_t width,
+          size_t height,
+          command_queue &queue = system::default_queue())
+{
+    BOOST_ASSERT(width <= first_pitch && width <= result_pitch);
+    if(width == 0 || height == 0){
+        return result;
+    }
+
+    size_t buffer_origin[3];
+    size_t region[3];
+    detail::copy_rect_extents<T>(result.get_index(), width, height, buffer_origin, region);
+    const size_t host_origin[3] = { 0, 0, 0 };
+
+    queue.enqueue_write_buffer_rect(
+        result.get_buffer(),
+        buffer_origin,
+        host_origin,
+        region,
+        result_pitch * sizeof(T),
+        0,
+        first_pitch * sizeof(T),
+        0,
+        const_cast<T *>(first)
+    );
+
+    return result + static_cast<std::ptrdiff_t>(height * result_pitch);
+}
+
+/// \overload
+///
+/// Copies a pitched rectangle from the device to the host with
+/// \c clEnqueueReadBufferRect.
+template<class T>
+inline T*
+copy_rect(const buffer_iterator<T> &first,
+          size_t first_pitch,
+          T *result,
+          size_t result_pitch,
+          size_t width,
+          size_t height,
+          command_queue &queue = system::default_queue())
+{
+    BOOST_ASSERT(width <= first_pitch && width <= result_pitch);
+    if(width == 0 || height == 0){
+        return result;
+    }
+
+    size_t buffer_origin[3];
+    size_t region[3];
+    detail::copy_rect_extents<T>(first.get_index(), width, height, buffer_origin, region);
+    const size_t host_origin[3] = { 0, 0, 0 };
+
+    queue.enqueue_read_buffer_rect(
+        first.get_buffer(),
+        buffer_origin,
+        host_origin,
+        region,
+        first_pitch * sizeof(T),
+        0,
+        result_pitch * sizeof(T),
+        0,
+        result
+    );
+
+    return result + height * result_pitch;
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // CL_VERSION_1_1
+
+#endif // BOOST_COMPUTE_ALGORITHM_COPY_RECT_HPP
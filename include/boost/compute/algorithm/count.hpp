@@ -16,6 +16,7 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/count_if.hpp>
 #include <boost/compute/type_traits/vector_size.hpp>
+#include <boost/compute/detail/enqueue_wait_list.hpp>
 
 namespace boost {
 namespace compute {
@@ -30,6 +31,8 @@ inline size_t count(InputIterator first,
                     const T &value,
                     command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("count")
+
     typedef typename std::iterator_traits<InputIterator>::value_type value_type;
 
     using ::boost::compute::_1;
@@ -49,6 +52,62 @@ inline size_t count(InputIterator first,
     }
 }
 
+/// \overload
+template<class InputIterator, class T>
+inline size_t count(InputIterator first,
+                    InputIterator last,
+                    const T &value,
+                    command_queue &queue,
+                    const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::count(first, last, value, queue);
+}
+
+/// Asynchronous version of count().
+///
+/// \see count(), count_if_async()
+template<class InputIterator, class T>
+inline future<size_t> count_async(InputIterator first,
+                                  InputIterator last,
+                                  const T &value,
+                                  command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("count_async")
+
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    using ::boost::compute::_1;
+    using ::boost::compute::lambda::all;
+
+    if(vector_size<value_type>::value == 1){
+        return ::boost::compute::count_if_async(first,
+                                                last,
+                                                _1 == value,
+                                                queue);
+    }
+    else {
+        return ::boost::compute::count_if_async(first,
+                                                last,
+                                                all(_1 == value),
+                                                queue);
+    }
+}
+
+/// \overload
+template<class InputIterator, class T>
+inline future<size_t> count_async(InputIterator first,
+                                  InputIterator last,
+                                  const T &value,
+                                  command_queue &queue,
+                                  const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::count_async(first, last, value, queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
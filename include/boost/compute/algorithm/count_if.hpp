@@ -17,8 +17,16 @@
 #include <boost/compute/algorithm/detail/count_if_with_ballot.hpp>
 #include <boost/compute/algorithm/detail/count_if_with_reduce.hpp>
 #include <boost/compute/algorithm/detail/count_if_with_threads.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
 #include <boost/compute/algorithm/detail/serial_count_if.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/detail/device_future.hpp>
+#include <boost/compute/detail/enqueue_wait_list.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/sub_group.hpp>
+#include <boost/compute/utility/kernel_variants.hpp>
 
 namespace boost {
 namespace compute {
@@ -31,6 +39,8 @@ inline size_t count_if(InputIterator first,
                        Predicate predicate,
                        command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("count_if")
+
     const device &device = queue.get_device();
 
     size_t input_size = detail::iterator_range_size(first, last);
@@ -38,22 +48,132 @@ inline size_t count_if(InputIterator first,
         return 0;
     }
 
-    if(device.type() & device::cpu){
-        if(input_size < 1024){
-            return detail::serial_count_if(first, last, predicate, queue);
-        }
-        else {
-            return detail::count_if_with_threads(first, last, predicate, queue);
-        }
+    // ranges smaller than the "serial_threshold" parameter of
+    // "__boost_count_if" in the parameter cache are counted by a single
+    // work-item
+    boost::shared_ptr<detail::parameter_cache> parameters =
+        detail::parameter_cache::get_global_cache(device);
+    const size_t serial_threshold = parameters->get(
+        "__boost_count_if",
+        "serial_threshold",
+        static_cast<uint_>(
+            (std::min)(detail::device_profile::get(device)->serial_threshold(),
+                       size_t(1) << 24)
+        )
+    );
+
+    if(input_size < serial_threshold){
+        return detail::serial_count_if(first, last, predicate, queue);
+    }
+
+    // the parallel variant for the device is chosen by the "count_if"
+    // variants of the kernel variant registry
+    const std::string variant =
+        kernel_variant_registry::get_global_registry()->select("count_if", device, "reduce");
+
+    if(variant == "threads"){
+        return detail::count_if_with_threads(first, last, predicate, queue);
+    }
+    else if(variant == "ballot"){
+        return detail::count_if_with_ballot(first, last, predicate, queue);
+    }
+    else {
+        return detail::count_if_with_reduce(first, last, predicate, queue);
+    }
+}
+
+/// \overload
+template<class InputIterator, class Predicate>
+inline size_t count_if(InputIterator first,
+                       InputIterator last,
+                       Predicate predicate,
+                       command_queue &queue,
+                       const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::count_if(first, last, predicate, queue);
+}
+
+/// \overload
+///
+/// Stores the number of elements for which \p predicate returns \c true
+/// (as a \c ulong_) to \p result instead of returning it. When \p result
+/// is a device iterator the count stays on the device and can be used by
+/// later algorithms without synchronizing with the host.
+template<class InputIterator, class Predicate, class OutputIterator>
+inline OutputIterator count_if(InputIterator first,
+                               InputIterator last,
+                               Predicate predicate,
+                               OutputIterator result,
+                               command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("count_if")
+
+    if(first == last){
+        ::boost::compute::fill_n(result, 1, ulong_(0), queue);
     }
     else {
-        if(input_size < 32){
-            return detail::serial_count_if(first, last, predicate, queue);
-        }
-        else {
-            return detail::count_if_with_reduce(first, last, predicate, queue);
-        }
+        detail::count_if_with_reduce(first, last, predicate, result, queue);
     }
+
+    return result + 1;
+}
+
+/// \overload
+template<class InputIterator, class Predicate, class OutputIterator>
+inline OutputIterator count_if(InputIterator first,
+                               InputIterator last,
+                               Predicate predicate,
+                               OutputIterator result,
+                               command_queue &queue,
+                               const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::count_if(first, last, predicate, result, queue);
+}
+
+/// Asynchronous version of count_if(). The count is kept on the device
+/// until it is requested with \c future::get() so the host is not blocked
+/// while the values are counted.
+///
+/// The count is always computed with reduce(), the serial and ballot
+/// variants used by count_if() read their partial counts on the host.
+///
+/// \see count_if(), count_async()
+template<class InputIterator, class Predicate>
+inline future<size_t> count_if_async(InputIterator first,
+                                     InputIterator last,
+                                     Predicate predicate,
+                                     command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("count_if_async")
+
+    boost::shared_ptr<detail::device_future_value<size_t, ulong_> > value =
+        boost::make_shared<detail::device_future_value<size_t, ulong_> >(queue);
+
+    if(first == last){
+        ::boost::compute::fill_n(value->begin(), 1, ulong_(0), queue);
+    }
+    else {
+        detail::count_if_with_reduce(first, last, predicate, value->begin(), queue);
+    }
+
+    return detail::make_device_future(value, queue);
+}
+
+/// \overload
+template<class InputIterator, class Predicate>
+inline future<size_t> count_if_async(InputIterator first,
+                                     InputIterator last,
+                                     Predicate predicate,
+                                     command_queue &queue,
+                                     const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::count_if_async(first, last, predicate, queue);
 }
 
 } // end compute namespace
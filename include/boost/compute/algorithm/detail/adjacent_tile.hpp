@@ -0,0 +1,50 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_ADJACENT_TILE_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_ADJACENT_TILE_HPP
+
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// writes code loading the tile of values [tile_start, tile_start +
+// get_local_size(0)) of the input to tile[1..] in local memory, and the
+// value preceding the tile to tile[0], so that each work-item can compare
+// its value with its predecessor (tile[lid] and tile[lid+1]) while each
+// value is read only once from global memory (plus one value per tile).
+//
+// the kernel must declare "lid", "tile_start" and "count" and all
+// work-items of the work-group must execute the code.
+template<class InputIterator>
+inline void load_adjacent_tile(meta_kernel &k,
+                               InputIterator first,
+                               const char *tile)
+{
+    k <<
+        "if(tile_start + lid < count){\n" <<
+        "    " << tile << "[lid+1] = " <<
+                first[k.var<uint_>("tile_start + lid")] << ";\n" <<
+        "}\n" <<
+        "if(lid == 0 && tile_start > 0){\n" <<
+        "    " << tile << "[0] = " <<
+                first[k.var<uint_>("tile_start - 1")] << ";\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n";
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_ADJACENT_TILE_HPP
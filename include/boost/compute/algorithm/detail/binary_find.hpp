@@ -15,6 +15,8 @@
 #include <boost/compute/algorithm/find_if.hpp>
 #include <boost/compute/algorithm/transform.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/index_type.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
 
 namespace boost {
 namespace compute {
@@ -29,10 +31,12 @@ class binary_find_kernel : public meta_kernel
 {
 public:
     size_t threads;
+    size_t block;
 
     binary_find_kernel() : meta_kernel("binary_find")
     {
         threads = 128;
+        block = 0;
     }
 
     template<class InputIterator, class UnaryPredicate>
@@ -41,17 +45,22 @@ public:
                    UnaryPredicate predicate)
     {
         typedef typename std::iterator_traits<InputIterator>::value_type value_type;
-        int block = (iterator_range_size(first, last)-1)/(threads-1);
+        const size_t count = iterator_range_size(first, last);
+        block = (count - 1) / (threads - 1);
 
         m_index_arg = add_arg<uint_ *>(memory_object::global_memory, "index");
 
         atomic_min<uint_> atomic_min_uint;
 
+        // the smallest work-item whose position satisfies the predicate is
+        // stored, so the index only needs 64 bits for the positions
         *this <<
-            "uint i = get_global_id(0) * " << block << ";\n" <<
+            "const uint id = get_global_id(0);\n" <<
+            "const " << index_type_name(count) << " i = " <<
+                "id * (" << index_type_name(count) << ")" << block << ";\n" <<
             decl<value_type>("value") << "=" << first[var<uint_>("i")] << ";\n" <<
             "if(" << predicate(var<value_type>("value")) << ") {\n" <<
-                atomic_min_uint(var<uint_ *>("index"), var<uint_>("i")) << ";\n" <<
+                atomic_min_uint(var<uint_ *>("index"), var<uint_>("id")) << ";\n" <<
             "}\n";
 
     }
@@ -84,20 +93,31 @@ inline InputIterator binary_find(InputIterator first,
                                  UnaryPredicate predicate,
                                  command_queue &queue = system::default_queue())
 {
-    size_t find_if_limit = 128;
-    size_t threads = 128;
+    // the number of work-items searching the range in each step can be
+    // tuned with the "threads" parameter of "__boost_binary_find" in the
+    // parameter cache
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(queue.get_device());
+
+    size_t threads = (std::max)(
+        static_cast<size_t>(parameters->get("__boost_binary_find", "threads", 128)),
+        size_t(2)
+    );
+    size_t find_if_limit = threads;
     size_t count = iterator_range_size(first, last);
 
     while(count > find_if_limit) {
 
         scalar<uint_> index(queue.get_context());
-        index.write(static_cast<uint_>(count), queue);
+        index.write(static_cast<uint_>(threads), queue);
 
         binary_find_kernel kernel;
+        kernel.threads = threads;
         kernel.set_range(first, last, predicate);
         kernel.exec(queue, index);
 
-        size_t i = index.read(queue);
+        const size_t id = index.read(queue);
+        const size_t i = id == threads ? count : id * kernel.block;
 
         if(i == count) {
             first = last - count%threads;
@@ -0,0 +1,122 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_COPY_BETWEEN_CONTEXTS_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_COPY_BETWEEN_CONTEXTS_HPP
+
+#include <algorithm>
+
+#include <boost/assert.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/staging_ring.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns true if the buffers can not be copied with clEnqueueCopyBuffer()
+// on queue because one of them belongs to another context. buffers of the
+// devices of a single context are copied by the implementation, which may
+// use peer-to-peer transfers between the devices.
+inline bool is_copy_between_contexts(const buffer &source,
+                                     const buffer &destination,
+                                     const command_queue &queue)
+{
+    const context &context = queue.get_context();
+
+    return source.get_context() != context ||
+           destination.get_context() != context;
+}
+
+// returns queue if it belongs to context, otherwise a new queue for the
+// first device of context
+inline command_queue queue_for_context(const context &context,
+                                       const command_queue &queue)
+{
+    if(queue.get_context() == context){
+        return queue;
+    }
+
+    return command_queue(context, context.get_device());
+}
+
+// copies [first, last) to result where the buffers belong to different
+// contexts. there is no portable way to transfer memory between contexts,
+// so the values are read to the pinned staging ring of queue on a queue of
+// the source context and written from it on a queue of the destination
+// context. the events of the two contexts can not wait for each other, so
+// the host waits for the read of each chunk before writing it. the write of
+// a chunk then runs while the next chunk is read into another slot.
+template<class T>
+inline buffer_iterator<T>
+copy_between_contexts(const buffer_iterator<T> first,
+                      const buffer_iterator<T> last,
+                      buffer_iterator<T> result,
+                      command_queue &queue)
+{
+    const size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        return result;
+    }
+
+    const buffer &source = first.get_buffer();
+    const buffer &destination = result.get_buffer();
+
+    command_queue read_queue = queue_for_context(source.get_context(), queue);
+    command_queue write_queue = queue_for_context(destination.get_context(), queue);
+
+    boost::shared_ptr<staging_ring> ring = staging_ring::get_global_ring(queue);
+    scoped_lock lock(ring->get_mutex());
+
+    const size_t chunk = ring->chunk_size() / sizeof(T);
+    BOOST_ASSERT(chunk > 0);
+
+    const size_t chunk_count = (count + chunk - 1) / chunk;
+    const size_t slot_count = ring->slot_count();
+
+    for(size_t i = 0; i < chunk_count; i++){
+        const size_t slot = i % slot_count;
+        const size_t n = (std::min)(chunk, count - i * chunk);
+
+        // waits for the write of the previous chunk in the slot
+        void *staging = ring->acquire(slot);
+
+        read_queue.enqueue_read_buffer(
+            source, (first.get_index() + i * chunk) * sizeof(T), n * sizeof(T), staging
+        );
+
+        ring->release(
+            slot,
+            write_queue.enqueue_write_buffer_async(
+                destination,
+                (result.get_index() + i * chunk) * sizeof(T),
+                n * sizeof(T),
+                staging
+            )
+        );
+    }
+
+    // the values must be written before they are used on another queue
+    ring->wait();
+
+    return result + count;
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_COPY_BETWEEN_CONTEXTS_HPP
@@ -0,0 +1,162 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_COPY_BITS_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_COPY_BITS_HPP
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// masks with fewer values are transferred one value at a time, packing
+// them costs more than the kernel launch saves
+inline size_t copy_bits_threshold()
+{
+    return 4096;
+}
+
+// packs the count values beginning at first into words of 32 bits, the
+// bit of each value is set if it is non-zero
+template<class InputIterator>
+inline void pack_bits(InputIterator first,
+                      size_t count,
+                      const buffer_iterator<uint_> words,
+                      command_queue &queue)
+{
+    const size_t word_count = (count + 31) / 32;
+
+    meta_kernel k("pack_bits");
+    k.add_set_arg<const uint_>("count", static_cast<uint_>(count));
+    k <<
+        "const uint word = get_global_id(0);\n" <<
+        "const uint begin = word * 32;\n" <<
+        "const uint end = min(begin + 32, count);\n" <<
+        "uint bits = 0;\n" <<
+        "for(uint i = begin; i < end; i++){\n" <<
+        "    if(" << first[k.var<uint_>("i")] << "){\n" <<
+        "        bits |= 1u << (i - begin);\n" <<
+        "    }\n" <<
+        "}\n" <<
+        words[k.var<uint_>("word")] << " = bits;\n";
+
+    k.exec_1d(queue, 0, word_count);
+}
+
+// sets the count values beginning at result to the bits of words
+template<class OutputIterator>
+inline void unpack_bits(const buffer_iterator<uint_> words,
+                        size_t count,
+                        OutputIterator result,
+                        command_queue &queue)
+{
+    typedef typename std::iterator_traits<OutputIterator>::value_type T;
+
+    meta_kernel k("unpack_bits");
+    k <<
+        "const uint i = get_global_id(0);\n" <<
+        result[k.var<uint_>("i")] << " = (" << type_name<T>() << ")((" <<
+            words[k.var<uint_>("i / 32")] << " >> (i % 32)) & 1);\n";
+
+    k.exec_1d(queue, 0, count);
+}
+
+// copies [first, last) on the device to the std::vector<bool> at result.
+// the values are packed to bits on the device, so eight to 64 times less
+// memory is transferred.
+template<class T>
+inline std::vector<bool>::iterator
+copy_bits_to_host(const buffer_iterator<T> first,
+                  const buffer_iterator<T> last,
+                  std::vector<bool>::iterator result,
+                  command_queue &queue)
+{
+    const size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        return result;
+    }
+    else if(count < copy_bits_threshold()){
+        std::vector<T> values(count);
+        queue.enqueue_read_buffer(
+            first.get_buffer(), first.get_index() * sizeof(T), count * sizeof(T), &values[0]
+        );
+        return std::copy(values.begin(), values.end(), result);
+    }
+
+    const size_t word_count = (count + 31) / 32;
+    buffer words(queue.get_context(), word_count * sizeof(uint_));
+    pack_bits(first, count, buffer_iterator<uint_>(words, 0), queue);
+
+    std::vector<uint_> host_words(word_count);
+    queue.enqueue_read_buffer(words, 0, word_count * sizeof(uint_), &host_words[0]);
+
+    for(size_t i = 0; i < count; i++){
+        *result++ = ((host_words[i / 32] >> (i % 32)) & 1) != 0;
+    }
+
+    return result;
+}
+
+// copies the std::vector<bool> values in [first, last) to the device
+// range beginning at result as zeros and ones. the bits are transferred
+// and unpacked on the device.
+template<class BitIterator, class T>
+inline buffer_iterator<T> copy_bits_to_device(BitIterator first,
+                                              BitIterator last,
+                                              buffer_iterator<T> result,
+                                              command_queue &queue)
+{
+    const size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        return result;
+    }
+    else if(count < copy_bits_threshold()){
+        std::vector<T> values(first, last);
+        queue.enqueue_write_buffer(
+            result.get_buffer(), result.get_index() * sizeof(T), count * sizeof(T), &values[0]
+        );
+        return result + count;
+    }
+
+    const size_t word_count = (count + 31) / 32;
+    std::vector<uint_> host_words(word_count, 0);
+    for(size_t i = 0; i < count; i++, ++first){
+        if(*first){
+            host_words[i / 32] |= uint_(1) << (i % 32);
+        }
+    }
+
+    buffer words(
+        queue.get_context(),
+        word_count * sizeof(uint_),
+        buffer::read_only | buffer::copy_host_ptr,
+        &host_words[0]
+    );
+    unpack_bits(buffer_iterator<uint_>(words, 0), count, result, queue);
+
+    return result + count;
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_COPY_BITS_HPP
@@ -0,0 +1,279 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_COPY_CONVERT_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_COPY_CONVERT_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/copy_on_device.hpp>
+#include <boost/compute/algorithm/detail/copy_to_device.hpp>
+#include <boost/compute/algorithm/detail/copy_to_host.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/type_traits/is_fundamental.hpp>
+#include <boost/compute/type_traits/is_vector_type.hpp>
+#include <boost/compute/detail/is_contiguous_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/staging_ring.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// meta-function returning true if a copy between the host values of type
+// Host and the device values of type Device converts them (between two
+// different scalar types, which OpenCL C converts implicitly)
+template<class Host, class Device>
+struct is_converting_copy
+    : public boost::mpl::bool_<
+          !boost::is_same<Host, Device>::value &&
+          is_fundamental<Host>::value &&
+          is_fundamental<Device>::value &&
+          !is_vector_type<Host>::value &&
+          !is_vector_type<Device>::value &&
+          !boost::is_same<Host, bool>::value &&
+          !boost::is_same<Device, bool>::value
+      > {};
+
+// copies the host values [first, last) to result converting them on the
+// host, so the smaller device values are transferred
+template<class HostIterator, class T>
+inline buffer_iterator<T> copy_to_device_convert_on_host(HostIterator first,
+                                                         HostIterator last,
+                                                         buffer_iterator<T> result,
+                                                         command_queue &queue)
+{
+    const size_t count = iterator_range_size(first, last);
+    if(count * sizeof(T) >= staging_ring::threshold(queue)){
+        // the values are converted while they are copied to the staging ring
+        return copy_to_device_staged(first, last, result, queue);
+    }
+
+    std::vector<T> values(first, last);
+    return copy_to_device(values.begin(), values.end(), result, queue);
+}
+
+// copies the host values [first, last) to result converting them on the
+// device, so the smaller host values are transferred
+template<class HostIterator, class T>
+inline buffer_iterator<T> copy_to_device_convert_on_device(HostIterator first,
+                                                           HostIterator last,
+                                                           buffer_iterator<T> result,
+                                                           command_queue &queue)
+{
+    typedef typename std::iterator_traits<HostIterator>::value_type host_type;
+
+    const size_t count = iterator_range_size(first, last);
+
+    scratch_vector<host_type> values(count, queue);
+    if(is_contiguous_iterator<HostIterator>::value &&
+       count * sizeof(host_type) < staging_ring::threshold(queue)){
+        copy_to_device(first, last, values.begin(), queue);
+    }
+    else {
+        copy_to_device_staged(first, last, values.begin(), queue);
+    }
+
+    return copy_on_device(values.begin(), values.end(), result, queue);
+}
+
+// copies the host values [first, last) of a different scalar type to result
+// transferring the smaller of the two types: narrowing (and same size)
+// conversions are done on the host and widening ones on the device
+template<class HostIterator, class T>
+inline buffer_iterator<T> copy_to_device_convert(HostIterator first,
+                                                 HostIterator last,
+                                                 buffer_iterator<T> result,
+                                                 command_queue &queue)
+{
+    typedef typename std::iterator_traits<HostIterator>::value_type host_type;
+
+    if(first == last){
+        return result;
+    }
+
+    if(sizeof(host_type) < sizeof(T)){
+        return copy_to_device_convert_on_device(first, last, result, queue);
+    }
+    else {
+        return copy_to_device_convert_on_host(first, last, result, queue);
+    }
+}
+
+// copies the device values [first, last) to result converting them on the
+// host, so the smaller device values are transferred
+template<class T, class HostIterator>
+inline HostIterator copy_to_host_convert_on_host(buffer_iterator<T> first,
+                                                 buffer_iterator<T> last,
+                                                 HostIterator result,
+                                                 command_queue &queue)
+{
+    const size_t count = iterator_range_size(first, last);
+    if(count * sizeof(T) >= staging_ring::threshold(queue)){
+        // the values are converted while they are copied from the staging
+        // ring
+        return copy_to_host_staged(first, last, result, queue);
+    }
+
+    std::vector<T> values(count);
+    copy_to_host(first, last, values.begin(), queue);
+    return std::copy(values.begin(), values.end(), result);
+}
+
+// copies the device values [first, last) to result converting them on the
+// device, so the smaller host values are transferred
+template<class T, class HostIterator>
+inline HostIterator copy_to_host_convert_on_device(buffer_iterator<T> first,
+                                                   buffer_iterator<T> last,
+                                                   HostIterator result,
+                                                   command_queue &queue)
+{
+    typedef typename std::iterator_traits<HostIterator>::value_type host_type;
+
+    const size_t count = iterator_range_size(first, last);
+
+    scratch_vector<host_type> values(count, queue);
+    copy_on_device(first, last, values.begin(), queue);
+
+    if(is_contiguous_iterator<HostIterator>::value &&
+       count * sizeof(host_type) < staging_ring::threshold(queue)){
+        return copy_to_host(values.begin(), values.end(), result, queue);
+    }
+    else {
+        return copy_to_host_staged(values.begin(), values.end(), result, queue);
+    }
+}
+
+// copies the device values [first, last) to the host values of a different
+// scalar type at result transferring the smaller of the two types
+template<class T, class HostIterator>
+inline HostIterator copy_to_host_convert(buffer_iterator<T> first,
+                                         buffer_iterator<T> last,
+                                         HostIterator result,
+                                         command_queue &queue)
+{
+    typedef typename std::iterator_traits<HostIterator>::value_type host_type;
+
+    if(first == last){
+        return result;
+    }
+
+    if(sizeof(host_type) < sizeof(T)){
+        return copy_to_host_convert_on_device(first, last, result, queue);
+    }
+    else {
+        return copy_to_host_convert_on_host(first, last, result, queue);
+    }
+}
+
+// copies [first, last) to result with copy_to_device_convert() if the copy
+// converts the values (see is_converting_copy), otherwise nothing is copied
+// and false is returned
+template<class HostIterator, class DeviceIterator>
+inline bool try_copy_to_device_convert(HostIterator,
+                                       HostIterator,
+                                       DeviceIterator &,
+                                       command_queue &)
+{
+    return false;
+}
+
+template<class HostIterator, class T>
+inline bool try_copy_to_device_convert(HostIterator first,
+                                       HostIterator last,
+                                       buffer_iterator<T> &result,
+                                       command_queue &queue)
+{
+    typedef typename std::iterator_traits<HostIterator>::value_type host_type;
+
+    return try_copy_to_device_convert(
+        first, last, result, queue, is_converting_copy<host_type, T>()
+    );
+}
+
+template<class HostIterator, class T>
+inline bool try_copy_to_device_convert(HostIterator,
+                                       HostIterator,
+                                       buffer_iterator<T> &,
+                                       command_queue &,
+                                       boost::mpl::false_)
+{
+    return false;
+}
+
+template<class HostIterator, class T>
+inline bool try_copy_to_device_convert(HostIterator first,
+                                       HostIterator last,
+                                       buffer_iterator<T> &result,
+                                       command_queue &queue,
+                                       boost::mpl::true_)
+{
+    result = copy_to_device_convert(first, last, result, queue);
+    return true;
+}
+
+// copies [first, last) to result with copy_to_host_convert() if the copy
+// converts the values (see is_converting_copy), otherwise nothing is copied
+// and false is returned
+template<class DeviceIterator, class HostIterator>
+inline bool try_copy_to_host_convert(DeviceIterator,
+                                     DeviceIterator,
+                                     HostIterator &,
+                                     command_queue &)
+{
+    return false;
+}
+
+template<class T, class HostIterator>
+inline bool try_copy_to_host_convert(buffer_iterator<T> first,
+                                     buffer_iterator<T> last,
+                                     HostIterator &result,
+                                     command_queue &queue)
+{
+    typedef typename std::iterator_traits<HostIterator>::value_type host_type;
+
+    return try_copy_to_host_convert(
+        first, last, result, queue, is_converting_copy<host_type, T>()
+    );
+}
+
+template<class T, class HostIterator>
+inline bool try_copy_to_host_convert(buffer_iterator<T>,
+                                     buffer_iterator<T>,
+                                     HostIterator &,
+                                     command_queue &,
+                                     boost::mpl::false_)
+{
+    return false;
+}
+
+template<class T, class HostIterator>
+inline bool try_copy_to_host_convert(buffer_iterator<T> first,
+                                     buffer_iterator<T> last,
+                                     HostIterator &result,
+                                     command_queue &queue,
+                                     boost::mpl::true_)
+{
+    result = copy_to_host_convert(first, last, result, queue);
+    return true;
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_COPY_CONVERT_HPP
@@ -13,14 +13,22 @@
 
 #include <iterator>
 
+#include <boost/optional.hpp>
+#include <boost/utility/in_place_factory.hpp>
+
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/async/future.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/iterator/discard_iterator.hpp>
+#include <boost/compute/iterator/transform_iterator.hpp>
 #include <boost/compute/memory/svm_ptr.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/meta_kernel_memo.hpp>
+#include <boost/compute/detail/vector_width.hpp>
 #include <boost/compute/detail/work_size.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/types/half.hpp>
 
 namespace boost {
 namespace compute {
@@ -38,16 +46,271 @@ inline size_t pick_copy_work_group_size(size_t n, const device &device)
     else return 1;
 }
 
+// returns the number of values to store at once with vstoren() when
+// copying to result, or one if the values are stored one by one
+template<class Iterator>
+inline uint_ copy_vector_width(const Iterator &result, const device &device)
+{
+    (void) result;
+    (void) device;
+
+    return 1;
+}
+
+template<class T>
+inline uint_ copy_vector_width(const buffer_iterator<T> &result, const device &device)
+{
+    (void) result;
+
+    return preferred_vector_width<T>(device);
+}
+
+// declares the vector of values (with vector index i) loaded by a work-item
+// of a vectorized copy. nothing is loaded for iterators which are not
+// backed by a buffer of scalar values.
+template<class Iterator>
+inline void copy_vector_load(meta_kernel &k, const Iterator &first, uint_ width)
+{
+    (void) k;
+    (void) first;
+    (void) width;
+}
+
+template<class T>
+inline void copy_vector_load(meta_kernel &k,
+                             const buffer_iterator<T> &first,
+                             uint_ width)
+{
+    if(is_vector_access_type<T>::value){
+        k << type_name<T>() << width << " values = " <<
+             k.vload<T>(width, "i", first.get_buffer(), first.get_index()) << ";\n";
+    }
+}
+
+template<class T, class UnaryFunction>
+inline void copy_vector_load(meta_kernel &k,
+                             const transform_iterator<buffer_iterator<T>, UnaryFunction> &first,
+                             uint_ width)
+{
+    copy_vector_load(k, first.base(), width);
+}
+
+// emits the value j of the vector with vector index i of a vectorized copy
+// from the input iterator itself
+template<class Iterator>
+inline void copy_vector_scalar_component(meta_kernel &k,
+                                         const Iterator &first,
+                                         uint_ width,
+                                         uint_ j)
+{
+    k << first[k.expr<uint_>("i * " + boost::lexical_cast<std::string>(width) +
+                             " + " + boost::lexical_cast<std::string>(j))];
+}
+
+// emits the value j of the vector with vector index i of a vectorized copy
+template<class Iterator>
+inline void copy_vector_component(meta_kernel &k,
+                                  const Iterator &first,
+                                  uint_ width,
+                                  uint_ j)
+{
+    copy_vector_scalar_component(k, first, width, j);
+}
+
+template<class T>
+inline void copy_vector_component(meta_kernel &k,
+                                  const buffer_iterator<T> &first,
+                                  uint_ width,
+                                  uint_ j)
+{
+    if(is_vector_access_type<T>::value){
+        k << "values." << vector_component(j);
+    }
+    else {
+        copy_vector_scalar_component(k, first, width, j);
+    }
+}
+
+template<class T, class UnaryFunction>
+inline void copy_vector_component(meta_kernel &k,
+                                  const transform_iterator<buffer_iterator<T>, UnaryFunction> &first,
+                                  uint_ width,
+                                  uint_ j)
+{
+    if(is_vector_access_type<T>::value){
+        k << first.functor()(k.var<T>("values." + vector_component(j)));
+    }
+    else {
+        copy_vector_scalar_component(k, first, width, j);
+    }
+}
+
+// emits the statement copying the value at index of first to result
+template<class InputIterator, class OutputIterator>
+inline void copy_value(meta_kernel &k,
+                       const InputIterator &first,
+                       const OutputIterator &result,
+                       const std::string &index)
+{
+    k << result[k.expr<uint_>(index)] << '=' << first[k.expr<uint_>(index)] << ";\n";
+}
+
+// the values copied to buffers of half_ and bfloat16_ values are
+// converted from float when stored
+template<class InputIterator>
+inline void copy_value(meta_kernel &k,
+                       const InputIterator &first,
+                       const buffer_iterator<half_> &result,
+                       const std::string &index)
+{
+    half_store(k, result, index, first[k.expr<uint_>(index)]);
+}
+
+template<class InputIterator>
+inline void copy_value(meta_kernel &k,
+                       const InputIterator &first,
+                       const buffer_iterator<bfloat16_> &result,
+                       const std::string &index)
+{
+    half_store(k, result, index, first[k.expr<uint_>(index)]);
+}
+
+// emits the body of a copy kernel storing width values at once with
+// vstoren() (only used for buffers of scalar values)
+template<class InputIterator, class OutputIterator>
+inline void copy_vector_body(meta_kernel &k,
+                             const InputIterator &first,
+                             const OutputIterator &result,
+                             uint_ width,
+                             uint_ vpt,
+                             uint_ tpb)
+{
+    (void) k;
+    (void) first;
+    (void) result;
+    (void) width;
+    (void) vpt;
+    (void) tpb;
+}
+
+// each work-item copies vpt vectors of width values (loading them with
+// vloadn() if the input is a buffer of scalar values), the values after
+// the last vector are copied one by one.
+template<class InputIterator, class T>
+inline void copy_vector_body(meta_kernel &k,
+                             const InputIterator &first,
+                             const buffer_iterator<T> &result,
+                             uint_ width,
+                             uint_ vpt,
+                             uint_ tpb)
+{
+    k <<
+        "const uint vector_count = count / " << width << ";\n" <<
+        "uint i = get_local_id(0) + " <<
+           "(" << vpt * tpb << " * get_group_id(0));\n" <<
+        "for(uint v = 0; v < " << vpt << "; v++){\n" <<
+        "    if(i < vector_count){\n";
+    copy_vector_load(k, first, width);
+    k <<
+        "        " << type_name<T>() << width << " result_values;\n";
+    for(uint_ j = 0; j < width; j++){
+        k << "        result_values." << vector_component(j) << " = " <<
+             "(" << type_name<T>() << ")(";
+        copy_vector_component(k, first, width, j);
+        k << ");\n";
+    }
+    k <<
+        "        " << k.vstore<T>(width, "result_values", "i",
+                                  result.get_buffer(), result.get_index()) << ";\n" <<
+        "    }\n" <<
+        "    i += " << tpb << ";\n" <<
+        "}\n" <<
+        "const uint index = vector_count * " << width << " + get_global_id(0);\n" <<
+        "if(index < count){\n" <<
+        "    ";
+    copy_value(k, first, result, "index");
+    k << "}\n";
+}
+
+// emits the loop copying the vectors of a chunk (only used for buffers of
+// scalar values), which advances index past them
+template<class InputIterator, class OutputIterator>
+inline void copy_chunked_vectors(meta_kernel &k,
+                                 const InputIterator &first,
+                                 const OutputIterator &result,
+                                 uint_ width)
+{
+    (void) k;
+    (void) first;
+    (void) result;
+    (void) width;
+}
+
+template<class InputIterator, class T>
+inline void copy_chunked_vectors(meta_kernel &k,
+                                 const InputIterator &first,
+                                 const buffer_iterator<T> &result,
+                                 uint_ width)
+{
+    if(width == 1){
+        return;
+    }
+
+    k <<
+        "for(uint i = start / " << width << "; i < end / " << width << "; i++){\n";
+    copy_vector_load(k, first, width);
+    k <<
+        "    " << type_name<T>() << width << " result_values;\n";
+    for(uint_ j = 0; j < width; j++){
+        k << "    result_values." << vector_component(j) << " = " <<
+             "(" << type_name<T>() << ")(";
+        copy_vector_component(k, first, width, j);
+        k << ");\n";
+    }
+    k <<
+        "    " << k.vstore<T>(width, "result_values", "i",
+                              result.get_buffer(), result.get_index()) << ";\n" <<
+        "}\n" <<
+        "index = max(start, (end / " << width << ") * " << width << ");\n";
+}
+
+// emits the body of a copy kernel for cpu devices, in which each
+// work-item copies a contiguous chunk of values (a multiple of width) as
+// vectors of width values followed by the values after the last vector
+template<class InputIterator, class OutputIterator>
+inline void copy_chunked_body(meta_kernel &k,
+                              const InputIterator &first,
+                              const OutputIterator &result,
+                              uint_ width)
+{
+    k <<
+        "const uint start = get_global_id(0) * chunk;\n" <<
+        "const uint end = min(start + chunk, count);\n" <<
+        "uint index = start;\n";
+    copy_chunked_vectors(k, first, result, width);
+    k <<
+        "for(; index < end; index++){\n" <<
+        "    ";
+    copy_value(k, first, result, "index");
+    k << "}\n";
+}
+
 template<class InputIterator, class OutputIterator>
 class copy_kernel : public meta_kernel
 {
 public:
-    copy_kernel()
+    copy_kernel(const device &device)
         : meta_kernel("copy")
     {
-        m_count = 0;
-        m_vpt = 4;
-        m_tpb = 128;
+        init(device, is_cpu_device(device));
+    }
+
+    // if chunked is true each work-item copies a contiguous chunk of the
+    // range, which is faster on cpu devices
+    copy_kernel(const device &device, bool chunked)
+        : meta_kernel("copy")
+    {
+        init(device, chunked);
     }
 
     void set_range(InputIterator first,
@@ -55,19 +318,17 @@ public:
                    OutputIterator result)
     {
         m_count_arg = add_arg<uint_>("count");
-
-        *this <<
-            "uint index = get_local_id(0) + " <<
-               "(" << m_vpt * m_tpb << " * get_group_id(0));\n" <<
-            "for(uint i = 0; i < " << m_vpt << "; i++){\n" <<
-            "    if(index < count){\n" <<
-                     result[expr<uint_>("index")] << '=' <<
-                         first[expr<uint_>("index")] << ";\n" <<
-            "        index += " << m_tpb << ";\n"
-            "    }\n"
-            "}\n";
-
         m_count = detail::iterator_range_size(first, last);
+        m_width = copy_vector_width(result, m_device);
+        if(m_chunked){
+            m_chunk_arg = add_arg<uint_>("chunk");
+        }
+
+        // the source of the kernel is only generated if it was not memoized
+        // for the iterators (see exec()). they are constructed in place as
+        // closures capturing references can not be assigned.
+        m_first = boost::in_place(first);
+        m_result = boost::in_place(result);
     }
 
     event exec(command_queue &queue)
@@ -77,18 +338,120 @@ public:
             return event();
         }
 
-        size_t global_work_size = calculate_work_size(m_count, m_vpt, m_tpb);
+        if(m_chunked){
+            return exec_chunked(queue);
+        }
+
+        // each work-item copies vectors of m_width values, at least one
+        // work-group copies the values after the last vector
+        size_t global_work_size = calculate_work_size(
+            (std::max)(m_count / m_width, size_t(1)), m_vpt, m_tpb
+        );
+
+        ::boost::compute::kernel kernel = compile_memoized(queue.get_context());
+        kernel.set_arg(m_count_arg, uint_(m_count));
+
+        return queue.enqueue_1d_range_kernel_async(
+                   kernel, 0, global_work_size, m_tpb
+               );
+    }
+
+private:
+    void init(const device &device, bool chunked)
+    {
+        m_count = 0;
+        m_vpt = 4;
+        m_tpb = 128;
+        m_width = 1;
+        m_chunked = chunked;
+        m_device = device;
+    }
+
+    // one work-item per chunk of at least 4096 values, chunks are whole
+    // vectors so only the last one copies values after its vectors
+    event exec_chunked(command_queue &queue)
+    {
+        const size_t work_items = cpu_work_item_count(m_count, 4096, m_device);
+
+        size_t chunk = (m_count + work_items - 1) / work_items;
+        chunk = ((chunk + m_width - 1) / m_width) * m_width;
+
+        ::boost::compute::kernel kernel = compile_memoized(queue.get_context());
+        kernel.set_arg(m_count_arg, uint_(m_count));
+        kernel.set_arg(m_chunk_arg, uint_(chunk));
+
+        return queue.enqueue_1d_range_kernel_async(kernel, 0, work_items, 1);
+    }
+
+    // returns the copy kernel, which is memoized by the type of the kernel
+    // and by the iterators when they fully determine its source
+    ::boost::compute::kernel compile_memoized(const context &context)
+    {
+        static const char tag = 0;
+
+        meta_kernel_memo_key key(&tag);
+        key.append(*m_first);
+        key.append(*m_result);
+        key.append_bytes(&m_width, sizeof(m_width));
+        key.append_bytes(&m_chunked, sizeof(m_chunked));
+
+        meta_kernel_memo &memo = meta_kernel_memo::get_global_cache();
+        if(key.valid()){
+            if(boost::optional< ::boost::compute::kernel > kernel = memo.get(key, context)){
+                return *kernel;
+            }
+        }
+
+        generate(*m_first, *m_result);
 
-        set_arg(m_count_arg, uint_(m_count));
+        ::boost::compute::kernel kernel = compile(context);
+        if(key.valid()){
+            memo.insert(key, *this);
+        }
 
-        return exec_1d(queue, 0, global_work_size, m_tpb);
+        return kernel;
+    }
+
+    void generate(const InputIterator &first, const OutputIterator &result)
+    {
+        // the input and output ranges of copy() may not overlap
+        set_restrict_buffers(true);
+
+        if(m_chunked){
+            copy_chunked_body(*this, first, result, m_width);
+            return;
+        }
+
+        set_reqd_work_group_size(m_tpb);
+
+        if(m_width > 1){
+            copy_vector_body(*this, first, result, m_width, m_vpt, m_tpb);
+            return;
+        }
+
+        *this <<
+            "uint index = get_local_id(0) + " <<
+               "(" << m_vpt * m_tpb << " * get_group_id(0));\n" <<
+            "for(uint i = 0; i < " << m_vpt << "; i++){\n" <<
+            "    if(index < count){\n";
+        copy_value(*this, first, result, "index");
+        *this <<
+            "        index += " << m_tpb << ";\n"
+            "    }\n"
+            "}\n";
     }
 
 private:
     size_t m_count;
     size_t m_count_arg;
+    size_t m_chunk_arg;
     uint_ m_vpt;
     uint_ m_tpb;
+    uint_ m_width;
+    bool m_chunked;
+    device m_device;
+    boost::optional<InputIterator> m_first;
+    boost::optional<OutputIterator> m_result;
 };
 
 template<class InputIterator, class OutputIterator>
@@ -97,7 +460,7 @@ inline OutputIterator copy_on_device(InputIterator first,
                                      OutputIterator result,
                                      command_queue &queue)
 {
-    copy_kernel<InputIterator, OutputIterator> kernel;
+    copy_kernel<InputIterator, OutputIterator> kernel(queue.get_device());
 
     kernel.set_range(first, last, result);
     kernel.exec(queue);
@@ -122,7 +485,7 @@ inline future<OutputIterator> copy_on_device_async(InputIterator first,
                                                    OutputIterator result,
                                                    command_queue &queue)
 {
-    copy_kernel<InputIterator, OutputIterator> kernel;
+    copy_kernel<InputIterator, OutputIterator> kernel(queue.get_device());
 
     kernel.set_range(first, last, result);
     event event_ = kernel.exec(queue);
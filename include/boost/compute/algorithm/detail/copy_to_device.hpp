@@ -11,14 +11,23 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_COPY_TO_DEVICE_HPP
 #define BOOST_COMPUTE_ALGORITHM_DETAIL_COPY_TO_DEVICE_HPP
 
+#include <algorithm>
 #include <iterator>
+#include <vector>
 
+#include <boost/assert.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/utility/addressof.hpp>
 
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/async/future.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/soa_iterator.hpp>
+#include <boost/compute/iterator/strided_iterator.hpp>
 #include <boost/compute/memory/svm_ptr.hpp>
+#include <boost/compute/detail/is_contiguous_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/staging_ring.hpp>
 
 namespace boost {
 namespace compute {
@@ -82,6 +91,42 @@ inline future<DeviceIterator> copy_to_device_async(HostIterator first,
 }
 
 #ifdef CL_VERSION_2_0
+// copies [first, last) to result by mapping the buffer of result and
+// copying the values on the host. used for buffers which the host can
+// access directly (see can_copy_by_mapping()).
+template<class HostIterator, class T>
+inline buffer_iterator<T> copy_to_device_map(HostIterator first,
+                                             HostIterator last,
+                                             buffer_iterator<T> result,
+                                             command_queue &queue)
+{
+    size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        return result;
+    }
+
+    cl_map_flags flags = CL_MAP_WRITE;
+    #ifdef CL_VERSION_1_2
+    if(queue.get_version() >= 120){
+        flags = CL_MAP_WRITE_INVALIDATE_REGION;
+    }
+    #endif
+
+    const buffer &buffer = result.get_buffer();
+    T *ptr = static_cast<T *>(
+        queue.enqueue_map_buffer(
+            buffer, flags, result.get_index() * sizeof(T), count * sizeof(T)
+        )
+    );
+    std::copy(first, last, ptr);
+
+    event unmap_event;
+    queue.enqueue_unmap_buffer(buffer, ptr, wait_list(), &unmap_event);
+    unmap_event.wait();
+
+    return result + static_cast<std::ptrdiff_t>(count);
+}
+
 // copy_to_device() specialization for svm_ptr
 template<class HostIterator, class T>
 inline svm_ptr<T> copy_to_device(HostIterator first,
@@ -120,6 +165,225 @@ inline future<svm_ptr<T> > copy_to_device_async(HostIterator first,
 }
 #endif // CL_VERSION_2_0
 
+// enqueues a write of count values from host_ptr to the strided range
+// starting at result. the values are written with a single rectangular
+// transfer (one row per value) when supported, otherwise one value at a
+// time.
+template<class T>
+inline event enqueue_write_strided(const T *host_ptr,
+                                   size_t count,
+                                   strided_iterator<buffer_iterator<T> > result,
+                                   command_queue &queue)
+{
+    const size_t stride = result.stride();
+    event event_;
+
+    #ifdef CL_VERSION_1_1
+    if(queue.get_version() >= 110){
+        const size_t buffer_origin[3] = { result.get_index() * sizeof(T), 0, 0 };
+        const size_t host_origin[3] = { 0, 0, 0 };
+        const size_t region[3] = { sizeof(T), count, 1 };
+
+        queue.enqueue_write_buffer_rect(result.get_buffer(),
+                                        buffer_origin,
+                                        host_origin,
+                                        region,
+                                        stride * sizeof(T),
+                                        0,
+                                        sizeof(T),
+                                        0,
+                                        const_cast<T *>(host_ptr),
+                                        wait_list(),
+                                        &event_);
+        return event_;
+    }
+    #endif // CL_VERSION_1_1
+
+    for(size_t i = 0; i < count; i++){
+        event_ = queue.enqueue_write_buffer_async(
+            result.get_buffer(),
+            (result.get_index() + i * stride) * sizeof(T),
+            sizeof(T),
+            host_ptr + i
+        );
+    }
+    return event_;
+}
+
+// copy_to_device() specialization for strided ranges of a buffer
+template<class HostIterator, class T>
+inline strided_iterator<buffer_iterator<T> >
+copy_to_device(HostIterator first,
+               HostIterator last,
+               strided_iterator<buffer_iterator<T> > result,
+               command_queue &queue)
+{
+    typedef typename
+        strided_iterator<buffer_iterator<T> >::difference_type
+        difference_type;
+
+    size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        return result;
+    }
+
+    enqueue_write_strided(::boost::addressof(*first), count, result, queue).wait();
+
+    return result + static_cast<difference_type>(count);
+}
+
+// copy_to_device_async() specialization for strided ranges of a buffer
+template<class HostIterator, class T>
+inline future<strided_iterator<buffer_iterator<T> > >
+copy_to_device_async(HostIterator first,
+                     HostIterator last,
+                     strided_iterator<buffer_iterator<T> > result,
+                     command_queue &queue)
+{
+    typedef typename
+        strided_iterator<buffer_iterator<T> >::difference_type
+        difference_type;
+
+    size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        return future<strided_iterator<buffer_iterator<T> > >();
+    }
+
+    event event_ =
+        enqueue_write_strided(::boost::addressof(*first), count, result, queue);
+
+    return make_future(result + static_cast<difference_type>(count), event_);
+}
+
+// gathers one member of the structs in [first, first + count) and writes
+// it to its buffer in the structure-of-arrays starting at result
+template<class T, class HostIterator>
+struct soa_write_member
+{
+    soa_write_member(HostIterator first_,
+                     size_t count_,
+                     const soa_iterator<T> &result_,
+                     command_queue &queue_)
+        : first(first_),
+          count(count_),
+          result(result_),
+          queue(queue_),
+          n(0)
+    {
+    }
+
+    template<class Member>
+    void operator()(Member T::*member, const char *)
+    {
+        std::vector<Member> values;
+        values.reserve(count);
+
+        HostIterator iter = first;
+        for(size_t i = 0; i < count; i++, ++iter){
+            values.push_back((*iter).*member);
+        }
+
+        queue.enqueue_write_buffer(result.get_member_buffer(n),
+                                   result.get_index() * sizeof(Member),
+                                   count * sizeof(Member),
+                                   &values[0]);
+        n++;
+    }
+
+    HostIterator first;
+    size_t count;
+    soa_iterator<T> result;
+    command_queue &queue;
+    size_t n;
+};
+
+// copy_to_device() specialization for structure-of-arrays, each member is
+// transposed on the host and written with a single transfer
+template<class HostIterator, class T>
+inline soa_iterator<T> copy_to_device(HostIterator first,
+                                      HostIterator last,
+                                      soa_iterator<T> result,
+                                      command_queue &queue)
+{
+    typedef typename soa_iterator<T>::difference_type difference_type;
+
+    size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        return result;
+    }
+
+    soa_write_member<T, HostIterator> write(first, count, result, queue);
+    adapted_struct_members<T>::for_each(write);
+
+    return result + static_cast<difference_type>(count);
+}
+
+// copies [first, last) to the device through the pinned staging ring of
+// queue. the values of each chunk are copied (and converted) into a
+// staging slot on the host while the transfer of the previous chunk runs.
+template<class HostIterator, class T>
+inline buffer_iterator<T> copy_to_device_staged(HostIterator first,
+                                                HostIterator last,
+                                                buffer_iterator<T> result,
+                                                command_queue &queue)
+{
+    if(first == last){
+        return result;
+    }
+
+    boost::shared_ptr<staging_ring> ring = staging_ring::get_global_ring(queue);
+    scoped_lock lock(ring->get_mutex());
+
+    const size_t chunk = ring->chunk_size() / sizeof(T);
+    BOOST_ASSERT(chunk > 0);
+
+    // the input is only traversed once so it may be a single pass range
+    size_t offset = result.get_index();
+    size_t slot = 0;
+    while(first != last){
+        T *staging = static_cast<T *>(ring->acquire(slot));
+
+        size_t n = 0;
+        for(; n < chunk && first != last; n++, ++first){
+            staging[n] = *first;
+        }
+
+        ring->release(
+            slot,
+            queue.enqueue_write_buffer_async(result.get_buffer(),
+                                             offset * sizeof(T),
+                                             n * sizeof(T),
+                                             staging)
+        );
+
+        offset += n;
+        slot = (slot + 1) % ring->slot_count();
+    }
+
+    // the copy is blocking, wait for the last transfers
+    ring->wait();
+
+    return buffer_iterator<T>(result.get_buffer(), offset);
+}
+
+// copy_to_device_staged() for device iterators without a buffer, the
+// values are copied directly (or through a temporary std::vector if the
+// host range is not contiguous)
+template<class HostIterator, class DeviceIterator>
+inline DeviceIterator copy_to_device_staged(HostIterator first,
+                                            HostIterator last,
+                                            DeviceIterator result,
+                                            command_queue &queue)
+{
+    if(is_contiguous_iterator<HostIterator>::value){
+        return copy_to_device(first, last, result, queue);
+    }
+
+    typedef typename std::iterator_traits<HostIterator>::value_type T;
+    std::vector<T> vector(first, last);
+    return copy_to_device(vector.begin(), vector.end(), result, queue);
+}
+
 } // end detail namespace
 } // end compute namespace
 } // end boost namespace
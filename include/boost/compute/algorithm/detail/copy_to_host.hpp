@@ -11,15 +11,24 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_COPY_TO_HOST_HPP
 #define BOOST_COMPUTE_ALGORITHM_DETAIL_COPY_TO_HOST_HPP
 
+#include <algorithm>
 #include <iterator>
+#include <vector>
 
+#include <boost/assert.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/utility/addressof.hpp>
 
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/async/future.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/soa_iterator.hpp>
+#include <boost/compute/iterator/strided_iterator.hpp>
 #include <boost/compute/memory/svm_ptr.hpp>
 #include <boost/compute/detail/iterator_plus_distance.hpp>
+#include <boost/compute/detail/is_contiguous_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/staging_ring.hpp>
 
 namespace boost {
 namespace compute {
@@ -51,6 +60,171 @@ inline HostIterator copy_to_host(DeviceIterator first,
     return iterator_plus_distance(result, count);
 }
 
+// copies [first, last) to result by mapping the buffer of first and
+// copying the values on the host. used for buffers which the host can
+// access directly (see can_copy_by_mapping()).
+template<class T, class HostIterator>
+inline HostIterator copy_to_host_map(buffer_iterator<T> first,
+                                     buffer_iterator<T> last,
+                                     HostIterator result,
+                                     command_queue &queue)
+{
+    size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        return result;
+    }
+
+    const buffer &buffer = first.get_buffer();
+    const T *ptr = static_cast<const T *>(
+        queue.enqueue_map_buffer(
+            buffer, CL_MAP_READ, first.get_index() * sizeof(T), count * sizeof(T)
+        )
+    );
+    result = std::copy(ptr, ptr + count, result);
+    queue.enqueue_unmap_buffer(buffer, const_cast<T *>(ptr));
+
+    return result;
+}
+
+// enqueues a read of count values of the strided range starting at first
+// to host_ptr. the values are read with a single rectangular transfer (one
+// row per value) when supported, otherwise one value at a time.
+template<class T>
+inline event enqueue_read_strided(strided_iterator<buffer_iterator<T> > first,
+                                  size_t count,
+                                  T *host_ptr,
+                                  command_queue &queue)
+{
+    const size_t stride = first.stride();
+    event event_;
+
+    #ifdef CL_VERSION_1_1
+    if(queue.get_version() >= 110){
+        const size_t buffer_origin[3] = { first.get_index() * sizeof(T), 0, 0 };
+        const size_t host_origin[3] = { 0, 0, 0 };
+        const size_t region[3] = { sizeof(T), count, 1 };
+
+        queue.enqueue_read_buffer_rect(first.get_buffer(),
+                                       buffer_origin,
+                                       host_origin,
+                                       region,
+                                       stride * sizeof(T),
+                                       0,
+                                       sizeof(T),
+                                       0,
+                                       host_ptr,
+                                       wait_list(),
+                                       &event_);
+        return event_;
+    }
+    #endif // CL_VERSION_1_1
+
+    for(size_t i = 0; i < count; i++){
+        event_ = queue.enqueue_read_buffer_async(
+            first.get_buffer(),
+            (first.get_index() + i * stride) * sizeof(T),
+            sizeof(T),
+            host_ptr + i
+        );
+    }
+    return event_;
+}
+
+// copy_to_host() specialization for strided ranges of a buffer
+template<class T, class HostIterator>
+inline HostIterator copy_to_host(strided_iterator<buffer_iterator<T> > first,
+                                 strided_iterator<buffer_iterator<T> > last,
+                                 HostIterator result,
+                                 command_queue &queue)
+{
+    size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        return result;
+    }
+
+    enqueue_read_strided(first, count, ::boost::addressof(*result), queue).wait();
+
+    return iterator_plus_distance(result, count);
+}
+
+// copy_to_host_async() specialization for strided ranges of a buffer
+template<class T, class HostIterator>
+inline future<HostIterator>
+copy_to_host_async(strided_iterator<buffer_iterator<T> > first,
+                   strided_iterator<buffer_iterator<T> > last,
+                   HostIterator result,
+                   command_queue &queue)
+{
+    size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        return future<HostIterator>();
+    }
+
+    event event_ =
+        enqueue_read_strided(first, count, ::boost::addressof(*result), queue);
+
+    return make_future(iterator_plus_distance(result, count), event_);
+}
+
+// reads one member of the structs in the structure-of-arrays starting at
+// first and scatters it to the structs in [result, result + count)
+template<class T, class HostIterator>
+struct soa_read_member
+{
+    soa_read_member(const soa_iterator<T> &first_,
+                    size_t count_,
+                    HostIterator result_,
+                    command_queue &queue_)
+        : first(first_),
+          count(count_),
+          result(result_),
+          queue(queue_),
+          n(0)
+    {
+    }
+
+    template<class Member>
+    void operator()(Member T::*member, const char *)
+    {
+        std::vector<Member> values(count);
+        queue.enqueue_read_buffer(first.get_member_buffer(n),
+                                  first.get_index() * sizeof(Member),
+                                  count * sizeof(Member),
+                                  &values[0]);
+
+        HostIterator iter = result;
+        for(size_t i = 0; i < count; i++, ++iter){
+            (*iter).*member = values[i];
+        }
+        n++;
+    }
+
+    soa_iterator<T> first;
+    size_t count;
+    HostIterator result;
+    command_queue &queue;
+    size_t n;
+};
+
+// copy_to_host() specialization for structure-of-arrays, each member is
+// read with a single transfer and transposed on the host
+template<class T, class HostIterator>
+inline HostIterator copy_to_host(soa_iterator<T> first,
+                                 soa_iterator<T> last,
+                                 HostIterator result,
+                                 command_queue &queue)
+{
+    size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        return result;
+    }
+
+    soa_read_member<T, HostIterator> read(first, count, result, queue);
+    adapted_struct_members<T>::for_each(read);
+
+    return iterator_plus_distance(result, count);
+}
+
 // copy_to_host() specialization for std::vector<bool>
 template<class DeviceIterator>
 inline std::vector<bool>::iterator
@@ -130,6 +304,87 @@ inline future<HostIterator> copy_to_host_async(svm_ptr<T> first,
 }
 #endif // CL_VERSION_2_0
 
+// copies [first, last) to the host through the pinned staging ring of
+// queue. the transfers of the next chunks run while the values of each
+// chunk are copied (and converted) from its staging slot to result.
+template<class T, class HostIterator>
+inline HostIterator copy_to_host_staged(buffer_iterator<T> first,
+                                        buffer_iterator<T> last,
+                                        HostIterator result,
+                                        command_queue &queue)
+{
+    size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        return result;
+    }
+
+    boost::shared_ptr<staging_ring> ring = staging_ring::get_global_ring(queue);
+    scoped_lock lock(ring->get_mutex());
+
+    const size_t chunk = ring->chunk_size() / sizeof(T);
+    BOOST_ASSERT(chunk > 0);
+
+    const size_t chunk_count = (count + chunk - 1) / chunk;
+    const size_t slot_count = ring->slot_count();
+    const size_t offset = first.get_index();
+
+    // start the transfers of the first chunk of each slot
+    for(size_t i = 0; i < (std::min)(chunk_count, slot_count); i++){
+        const size_t n = (std::min)(chunk, count - i * chunk);
+
+        ring->release(
+            i,
+            queue.enqueue_read_buffer_async(first.get_buffer(),
+                                            (offset + i * chunk) * sizeof(T),
+                                            n * sizeof(T),
+                                            ring->acquire(i))
+        );
+    }
+
+    for(size_t i = 0; i < chunk_count; i++){
+        const size_t slot = i % slot_count;
+        const size_t n = (std::min)(chunk, count - i * chunk);
+
+        const T *staging = static_cast<const T *>(ring->acquire(slot));
+        result = std::copy(staging, staging + n, result);
+
+        // reuse the slot for the next chunk
+        const size_t next = i + slot_count;
+        if(next < chunk_count){
+            const size_t next_n = (std::min)(chunk, count - next * chunk);
+
+            ring->release(
+                slot,
+                queue.enqueue_read_buffer_async(first.get_buffer(),
+                                                (offset + next * chunk) * sizeof(T),
+                                                next_n * sizeof(T),
+                                                ring->acquire(slot))
+            );
+        }
+    }
+
+    return result;
+}
+
+// copy_to_host_staged() for device iterators without a buffer, the values
+// are copied directly (or through a temporary std::vector if the host range
+// is not contiguous)
+template<class DeviceIterator, class HostIterator>
+inline HostIterator copy_to_host_staged(DeviceIterator first,
+                                        DeviceIterator last,
+                                        HostIterator result,
+                                        command_queue &queue)
+{
+    if(is_contiguous_iterator<HostIterator>::value){
+        return copy_to_host(first, last, result, queue);
+    }
+
+    typedef typename std::iterator_traits<DeviceIterator>::value_type T;
+    std::vector<T> vector(iterator_range_size(first, last));
+    copy_to_host(first, last, vector.begin(), queue);
+    return std::copy(vector.begin(), vector.end(), result);
+}
+
 } // end detail namespace
 } // end compute namespace
 } // end boost namespace
@@ -11,26 +11,35 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_COUNT_IF_WITH_BALLOT_HPP
 #define BOOST_COMPUTE_ALGORITHM_DETAIL_COUNT_IF_WITH_BALLOT_HPP
 
+#include <algorithm>
+
 #include <boost/compute/context.hpp>
 #include <boost/compute/command_queue.hpp>
-#include <boost/compute/container/vector.hpp>
 #include <boost/compute/algorithm/reduce.hpp>
-#include <boost/compute/functional/detail/nvidia_ballot.hpp>
-#include <boost/compute/functional/detail/nvidia_popcount.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/sub_group.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
 namespace detail {
 
+// counts the elements matching predicate in each work-group with the
+// device's sub-group (or work-group) functions and then reduces the
+// counts of the work-groups. requires sub_group_functions::supported().
 template<class InputIterator, class Predicate>
 inline size_t count_if_with_ballot(InputIterator first,
                                    InputIterator last,
                                    Predicate predicate,
                                    command_queue &queue)
 {
+    const sub_group_functions sub_groups(queue.get_device());
+
     size_t count = iterator_range_size(first, last);
-    size_t block_size = 32;
+    size_t block_size =
+        (std::min)(size_t(256), device_profile::get(queue.get_device())->max_work_group_size());
     size_t block_count = count / block_size;
     if(block_count * block_size != count){
         block_count++;
@@ -38,12 +47,11 @@ inline size_t count_if_with_ballot(InputIterator first,
 
     const ::boost::compute::context &context = queue.get_context();
 
-    ::boost::compute::vector<uint_> counts(block_count, context);
-
-    ::boost::compute::detail::nvidia_popcount<uint_> popc;
-    ::boost::compute::detail::nvidia_ballot<uint_> ballot;
+    scratch_vector<uint_> counts(block_count, queue);
 
     meta_kernel k("count_if_with_ballot");
+    sub_groups.enable(k);
+
     k <<
         "const uint gid = get_global_id(0);\n" <<
 
@@ -51,15 +59,31 @@ inline size_t count_if_with_ballot(InputIterator first,
         "if(gid < count)\n" <<
         "    value = " << predicate(first[k.var<const uint_>("gid")]) << ";\n" <<
 
-        "uint bits = " << ballot(k.var<const uint_>("value")) << ";\n" <<
+        "const uint n = " << sub_groups.count("value") << ";\n";
 
-        "if(get_local_id(0) == 0)\n" <<
-            counts.begin()[k.var<uint_>("get_group_id(0)") ]
-                << " = " << popc(k.var<uint_>("bits")) << ";\n";
+    if(sub_groups.is_work_group()){
+        k <<
+            "if(get_local_id(0) == 0)\n" <<
+            "    " << counts.begin()[k.var<uint_>("get_group_id(0)")] << " = n;\n";
+    }
+    else {
+        k <<
+            "__local uint sub_group_counts[256];\n" <<
+            "if(" << sub_groups.local_id() << " == 0)\n" <<
+            "    sub_group_counts[" << sub_groups.group_id() << "] = n;\n" <<
+            "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+            "if(get_local_id(0) == 0){\n" <<
+            "    uint total = 0;\n" <<
+            "    for(uint i = 0; i < " << sub_groups.group_count() << "; i++)\n" <<
+            "        total += sub_group_counts[i];\n" <<
+            "    " << counts.begin()[k.var<uint_>("get_group_id(0)")] << " = total;\n" <<
+            "}\n";
+    }
 
     k.add_set_arg<const uint_>("count", count);
 
-    k.exec_1d(queue, 0, block_size * block_count, block_size);
+    kernel kernel = k.compile(context, sub_groups.options());
+    queue.enqueue_1d_range_kernel(kernel, 0, block_size * block_count, block_size);
 
     uint_ result;
     ::boost::compute::reduce(
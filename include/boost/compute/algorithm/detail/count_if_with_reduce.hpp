@@ -59,23 +59,35 @@ struct countable_predicate
     Predicate m_predicate;
 };
 
-// counts the number of elements matching predicate using reduce()
-template<class InputIterator, class Predicate>
-inline size_t count_if_with_reduce(InputIterator first,
-                                   InputIterator last,
-                                   Predicate predicate,
-                                   command_queue &queue)
+// counts the number of elements matching predicate using reduce() and
+// stores the count (as a ulong) to result
+template<class InputIterator, class Predicate, class OutputIterator>
+inline void count_if_with_reduce(InputIterator first,
+                                 InputIterator last,
+                                 Predicate predicate,
+                                 OutputIterator result,
+                                 command_queue &queue)
 {
     countable_predicate<Predicate> reduce_predicate(predicate);
 
-    ulong_ count = 0;
     ::boost::compute::reduce(
         ::boost::compute::make_transform_iterator(first, reduce_predicate),
         ::boost::compute::make_transform_iterator(last, reduce_predicate),
-        &count,
+        result,
         ::boost::compute::plus<ulong_>(),
         queue
     );
+}
+
+// counts the number of elements matching predicate using reduce()
+template<class InputIterator, class Predicate>
+inline size_t count_if_with_reduce(InputIterator first,
+                                   InputIterator last,
+                                   Predicate predicate,
+                                   command_queue &queue)
+{
+    ulong_ count = 0;
+    count_if_with_reduce(first, last, predicate, &count, queue);
 
     return static_cast<size_t>(count);
 }
@@ -14,6 +14,7 @@
 #include <numeric>
 
 #include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/work_size.hpp>
 #include <boost/compute/container/vector.hpp>
 
 namespace boost {
@@ -79,11 +80,9 @@ public:
 
         const size_t minimum_block_size = 2048;
         if(m_size / threads < minimum_block_size){
-            threads = static_cast<size_t>(
-                          (std::max)(
-                              std::ceil(float(m_size) / minimum_block_size),
-                              1.0f
-                          )
+            threads = (std::max)(
+                          calculate_work_size(m_size, minimum_block_size, 1),
+                          size_t(1)
                       );
         }
 
@@ -11,14 +11,42 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_FIND_EXTREMA_HPP
 #define BOOST_COMPUTE_ALGORITHM_DETAIL_FIND_EXTREMA_HPP
 
+#include <utility>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/device_profile.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/algorithm/detail/find_extrema_with_atomics.hpp>
+#include <boost/compute/algorithm/detail/find_extrema_with_reduce.hpp>
 #include <boost/compute/algorithm/detail/serial_find_extrema.hpp>
 
 namespace boost {
 namespace compute {
 namespace detail {
 
+// minimum input size for which the two-pass reduction is used on GPUs.
+// smaller inputs are faster with a single kernel using atomics.
+static const size_t find_extrema_reduce_threshold = 32768;
+
+// returns true if the two-pass reduction should be used to find the
+// extrema of count values. the atomics based method is limited by
+// contention on the global index for large inputs and on CPUs.
+inline bool use_find_extrema_with_reduce(size_t count, command_queue &queue)
+{
+    // use the reduction for OpenCL version 1.0 due to
+    // problems with atomic_cmpxchg()
+    #ifndef CL_VERSION_1_1
+        return true;
+    #endif
+
+    if(!device_profile::get(queue.get_device())->has_local_memory()){
+        return true;
+    }
+
+    return count >= find_extrema_reduce_threshold;
+}
+
 template<class InputIterator>
 inline InputIterator find_extrema(InputIterator first,
                                   InputIterator last,
@@ -33,19 +61,32 @@ inline InputIterator find_extrema(InputIterator first,
     }
 
     // use serial method for small inputs
-    if(count < 64){
+    if(count < device_profile::get(queue.get_device())->serial_threshold()){
         return serial_find_extrema(first, last, sign, queue);
     }
 
-    // use serial method for OpenCL version 1.0 due to
-    // problems with atomic_cmpxchg()
-    #ifndef CL_VERSION_1_1
-        return serial_find_extrema(first, last, sign, queue);
-    #endif
+    if(use_find_extrema_with_reduce(count, queue)){
+        return find_extrema_with_reduce(first, last, sign, queue);
+    }
 
     return find_extrema_with_atomics(first, last, sign, queue);
 }
 
+// finds both the minimum and the maximum, if possible in a single sweep
+template<class InputIterator>
+inline std::pair<InputIterator, InputIterator>
+find_minmax(InputIterator first, InputIterator last, command_queue &queue)
+{
+    size_t count = iterator_range_size(first, last);
+
+    if(count >= 64 && use_find_extrema_with_reduce(count, queue)){
+        return find_minmax_with_reduce(first, last, queue);
+    }
+
+    return std::make_pair(find_extrema(first, last, '<', queue),
+                          find_extrema(first, last, '>', queue));
+}
+
 } // end detail namespace
 } // end compute namespace
 } // end boost namespace
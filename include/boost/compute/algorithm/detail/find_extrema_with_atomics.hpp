@@ -16,6 +16,7 @@
 #include <boost/compute/container/detail/scalar.hpp>
 #include <boost/compute/functional/atomic.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/sub_group.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
@@ -28,6 +29,7 @@ inline InputIterator find_extrema_with_atomics(InputIterator first,
                                                char sign,
                                                command_queue &queue)
 {
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
     typedef typename std::iterator_traits<InputIterator>::difference_type difference_type;
 
     const context &context = queue.get_context();
@@ -36,11 +38,37 @@ inline InputIterator find_extrema_with_atomics(InputIterator first,
     atomic_cmpxchg<uint_> atomic_cmpxchg_uint;
 
     k <<
-        "const uint gid = get_global_id(0);\n" <<
+        "const uint gid = get_global_id(0);\n";
+
+    // find the extremum of each sub-group (with the lowest index) so
+    // that only one work-item per sub-group updates the global index
+    const sub_group_functions sub_groups(queue.get_device());
+    const bool use_sub_groups = sub_groups.supports<value_type>();
+    if(use_sub_groups){
+        sub_groups.enable(k);
+
+        const std::string op = sign == '<' ? "min" : "max";
+
+        k <<
+            k.decl<const value_type>("value") << " = " << first[k.var<uint_>("gid")] << ";\n" <<
+            k.decl<const value_type>("extremum") << " = " <<
+                sub_groups.reduce(op, "value") << ";\n" <<
+            "const uint candidate = " <<
+                sub_groups.reduce("min", "value == extremum ? gid : UINT_MAX") << ";\n" <<
+            "if(gid != candidate)\n" <<
+            "    return;\n";
+    }
+
+    // equal values are ordered by their index so that the first extremum
+    // is found whatever the order of the atomic updates
+    k <<
         "uint old_index = *index;\n" <<
         "while(" << first[k.var<uint_>("gid")]
                  << sign
-                 << first[k.var<uint_>("old_index")] << "){\n" <<
+                 << first[k.var<uint_>("old_index")] << " ||\n" <<
+        "      (gid < old_index && " << first[k.var<uint_>("gid")]
+                 << " == "
+                 << first[k.var<uint_>("old_index")] << ")){\n" <<
         "  if(" << atomic_cmpxchg_uint(k.var<uint_ *>("index"),
                                        k.var<uint_>("old_index"),
                                        k.var<uint_>("gid")) << " == old_index)\n" <<
@@ -51,7 +79,9 @@ inline InputIterator find_extrema_with_atomics(InputIterator first,
 
     size_t index_arg_index = k.add_arg<uint_ *>(memory_object::global_memory, "index");
 
-    kernel kernel = k.compile(context);
+    kernel kernel = k.compile(
+        context, use_sub_groups ? sub_groups.options() : std::string()
+    );
 
     // setup index buffer
     scalar<uint_> index(context);
@@ -0,0 +1,274 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_FIND_EXTREMA_WITH_REDUCE_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_FIND_EXTREMA_WITH_REDUCE_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include <boost/lexical_cast.hpp>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// maximum number of extrema searched for in a single pass (min and max)
+static const size_t find_extrema_max_signs = 2;
+
+// returns the work-group size for finding extrema of type T
+template<class T>
+inline size_t find_extrema_work_group_size(command_queue &queue)
+{
+    const boost::shared_ptr<device_profile> profile =
+        device_profile::get(queue.get_device());
+
+    size_t work_group_size = (std::min)(size_t(256), profile->max_work_group_size());
+    work_group_size = (std::min)(
+        work_group_size,
+        static_cast<size_t>(
+            profile->local_memory_size() /
+                (find_extrema_max_signs * (sizeof(T) + sizeof(uint_)))
+        )
+    );
+
+    // round down to a power of two
+    size_t power = 1;
+    while(power * 2 <= work_group_size){
+        power *= 2;
+    }
+
+    return power;
+}
+
+// finds the extremum of the values in each work-group's part of the input
+// for each comparison operator in signs. every work-item first scans a
+// strided subset of the input and the work-group then reduces the
+// (value, index) pairs of its work-items in local memory. of equal values
+// the one with the lowest index is chosen.
+//
+// in the first pass the index of a value is its position in the input. in
+// later passes (when use_indices is true) the indices are read from
+// indices.
+template<class InputIterator, class T>
+inline void find_extrema_reduce_pass(InputIterator first,
+                                     size_t count,
+                                     buffer_iterator<uint_> indices,
+                                     bool use_indices,
+                                     const std::string &signs,
+                                     buffer_iterator<T> *result_values,
+                                     buffer_iterator<uint_> *result_indices,
+                                     size_t work_group_size,
+                                     size_t work_group_count,
+                                     command_queue &queue)
+{
+    meta_kernel k("find_extrema_reduce");
+    size_t count_arg = k.add_arg<const uint_>("count");
+
+    k <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint global_size = get_global_size(0);\n";
+
+    for(size_t j = 0; j < signs.size(); j++){
+        k <<
+            "__local " << k.type<T>() << " lvalues" << j << "[" << work_group_size << "];\n" <<
+            "__local uint lindices" << j << "[" << work_group_size << "];\n" <<
+            k.decl<T>("best" + boost::lexical_cast<std::string>(j)) << ";\n" <<
+            "uint best_index" << j << " = UINT_MAX;\n";
+    }
+
+    // find the extrema of the values of each work-item
+    k <<
+        "for(uint i = get_global_id(0); i < count; i += global_size){\n" <<
+        "    " << k.decl<const T>("value") << " = " << first[k.var<uint_>("i")] << ";\n";
+    if(use_indices){
+        k <<
+        "    const uint index = " << indices[k.var<uint_>("i")] << ";\n";
+    }
+    else {
+        k <<
+        "    const uint index = i;\n";
+    }
+    for(size_t j = 0; j < signs.size(); j++){
+        k <<
+        "    if(best_index" << j << " == UINT_MAX ||\n" <<
+        "       value " << signs[j] << " best" << j << " ||\n" <<
+        "       (!(best" << j << " " << signs[j] << " value) && index < best_index" << j << ")){\n" <<
+        "        best" << j << " = value;\n" <<
+        "        best_index" << j << " = index;\n" <<
+        "    }\n";
+    }
+    k <<
+        "}\n";
+
+    // reduce the extrema of the work-items
+    for(size_t j = 0; j < signs.size(); j++){
+        k <<
+            "lvalues" << j << "[lid] = best" << j << ";\n" <<
+            "lindices" << j << "[lid] = best_index" << j << ";\n";
+    }
+    k <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(uint offset = get_local_size(0) / 2; offset > 0; offset >>= 1){\n" <<
+        "    if(lid < offset){\n";
+    for(size_t j = 0; j < signs.size(); j++){
+        const std::string n = boost::lexical_cast<std::string>(j);
+        const std::string value = "lvalues" + n + "[lid]";
+        const std::string other_value = "lvalues" + n + "[lid + offset]";
+        const std::string index = "lindices" + n + "[lid]";
+        const std::string other_index = "lindices" + n + "[lid + offset]";
+
+        k <<
+        "        if(" << other_index << " != UINT_MAX &&\n" <<
+        "           (" << index << " == UINT_MAX ||\n" <<
+        "            " << other_value << " " << signs[j] << " " << value << " ||\n" <<
+        "            (!(" << value << " " << signs[j] << " " << other_value << ") &&\n" <<
+        "             " << other_index << " < " << index << "))){\n" <<
+        "            " << value << " = " << other_value << ";\n" <<
+        "            " << index << " = " << other_index << ";\n" <<
+        "        }\n";
+    }
+    k <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n";
+
+    // write the extrema of the work-group
+    k <<
+        "if(lid == 0){\n";
+    for(size_t j = 0; j < signs.size(); j++){
+        k <<
+        "    " << result_values[j][k.var<uint_>("get_group_id(0)")] << " = lvalues" << j << "[0];\n" <<
+        "    " << result_indices[j][k.var<uint_>("get_group_id(0)")] << " = lindices" << j << "[0];\n";
+    }
+    k <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(count_arg, static_cast<uint_>(count));
+
+    queue.enqueue_1d_range_kernel(
+        kernel, 0, work_group_count * work_group_size, work_group_size
+    );
+}
+
+// finds the index of the extremum for each comparison operator in signs
+// (at most find_extrema_max_signs) of the values in [first, last) in a
+// single sweep over the input. the extrema of each work-group are found
+// in a first pass and then reduced by a single work-group.
+template<class InputIterator>
+inline void find_extrema_with_reduce(InputIterator first,
+                                     InputIterator last,
+                                     const std::string &signs,
+                                     uint_ *result,
+                                     command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    const size_t count = iterator_range_size(first, last);
+    const device &device = queue.get_device();
+
+    const size_t work_group_size = find_extrema_work_group_size<value_type>(queue);
+
+    // enough work-groups to fill the device, each work-item scans at
+    // least a few values before the reduction in local memory
+    const size_t max_work_group_count =
+        (std::max)(size_t(1), size_t(device_profile::get(device)->compute_units() * 4));
+    const size_t work_group_count = (std::min)(
+        max_work_group_count,
+        (count + 4 * work_group_size - 1) / (4 * work_group_size)
+    );
+
+    scratch_vector<value_type> values0(work_group_count, queue);
+    scratch_vector<value_type> values1(signs.size() > 1 ? work_group_count : 0, queue);
+    scratch_vector<uint_> indices0(work_group_count, queue);
+    scratch_vector<uint_> indices1(signs.size() > 1 ? work_group_count : 0, queue);
+
+    buffer_iterator<value_type> values[] = { values0.begin(), values1.begin() };
+    buffer_iterator<uint_> indices[] = { indices0.begin(), indices1.begin() };
+
+    // find the extrema of each work-group
+    find_extrema_reduce_pass(
+        first, count, buffer_iterator<uint_>(), false, signs,
+        values, indices, work_group_size, work_group_count, queue
+    );
+
+    // reduce the extrema of the work-groups
+    if(work_group_count > 1){
+        scratch_vector<value_type> final_values(signs.size(), queue);
+        scratch_vector<uint_> final_indices(signs.size(), queue);
+
+        for(size_t j = 0; j < signs.size(); j++){
+            buffer_iterator<value_type> final_value = final_values.begin() + j;
+            buffer_iterator<uint_> final_index = final_indices.begin() + j;
+
+            find_extrema_reduce_pass(
+                values[j], work_group_count, indices[j], true, signs.substr(j, 1),
+                &final_value, &final_index, work_group_size, 1, queue
+            );
+        }
+
+        for(size_t j = 0; j < signs.size(); j++){
+            result[j] = read_single_value<uint_>(final_indices.get_buffer(), j, queue);
+        }
+    }
+    else {
+        for(size_t j = 0; j < signs.size(); j++){
+            result[j] = read_single_value<uint_>(indices[j].get_buffer(), 0, queue);
+        }
+    }
+}
+
+template<class InputIterator>
+inline InputIterator find_extrema_with_reduce(InputIterator first,
+                                              InputIterator last,
+                                              char sign,
+                                              command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::difference_type difference_type;
+
+    uint_ index = 0;
+    find_extrema_with_reduce(first, last, std::string(1, sign), &index, queue);
+
+    return first + static_cast<difference_type>(index);
+}
+
+// finds the minimum and maximum in a single sweep over the input
+template<class InputIterator>
+inline std::pair<InputIterator, InputIterator>
+find_minmax_with_reduce(InputIterator first,
+                        InputIterator last,
+                        command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::difference_type difference_type;
+
+    uint_ indices[2] = { 0, 0 };
+    find_extrema_with_reduce(first, last, "<>", indices, queue);
+
+    return std::make_pair(first + static_cast<difference_type>(indices[0]),
+                          first + static_cast<difference_type>(indices[1]));
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_FIND_EXTREMA_WITH_REDUCE_HPP
@@ -14,25 +14,41 @@
 #include <iterator>
 
 #include <boost/compute/types.hpp>
-#include <boost/compute/functional.hpp>
 #include <boost/compute/command_queue.hpp>
-#include <boost/compute/container/detail/scalar.hpp>
+#include <boost/compute/algorithm/detail/find_with_early_exit.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
-#include <boost/compute/type_traits/type_name.hpp>
-#include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
 namespace detail {
 
+// stores the index of the first element matching predicate (or count if
+// there is none) to index without reading it on the host. the work-items
+// stop as soon as a match before their current chunk has been found (see
+// find_with_early_exit()).
+template<class InputIterator, class UnaryPredicate>
+inline void find_if_with_atomics(InputIterator first,
+                                 size_t count,
+                                 UnaryPredicate predicate,
+                                 buffer_iterator<uint_> index,
+                                 command_queue &queue)
+{
+    find_with_early_exit(
+        count,
+        find_if_matcher<InputIterator, UnaryPredicate>(first, predicate),
+        false,
+        index,
+        queue
+    );
+}
+
 template<class InputIterator, class UnaryPredicate>
 inline InputIterator find_if_with_atomics(InputIterator first,
                                           InputIterator last,
                                           UnaryPredicate predicate,
                                           command_queue &queue)
 {
-    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
     typedef typename std::iterator_traits<InputIterator>::difference_type difference_type;
 
     size_t count = detail::iterator_range_size(first, last);
@@ -40,31 +56,14 @@ inline InputIterator find_if_with_atomics(InputIterator first,
         return last;
     }
 
-    const context &context = queue.get_context();
-
-    detail::meta_kernel k("find_if");
-    size_t index_arg = k.add_arg<int *>(memory_object::global_memory, "index");
-    atomic_min<uint_> atomic_min_uint;
-
-    k << k.decl<const uint_>("i") << " = get_global_id(0);\n"
-      << k.decl<const value_type>("value") << "="
-      <<     first[k.var<const uint_>("i")] << ";\n"
-      << "if(" << predicate(k.var<const value_type>("value")) << "){\n"
-      << "    " << atomic_min_uint(k.var<uint_ *>("index"), k.var<uint_>("i")) << ";\n"
-      << "}\n";
-
-    kernel kernel = k.compile(context);
-
-    scalar<uint_> index(context);
-    kernel.set_arg(index_arg, index.get_buffer());
-
-    // initialize index to the last iterator's index
-    index.write(static_cast<uint_>(count), queue);
-
-    queue.enqueue_1d_range_kernel(kernel, 0, count, 0);
+    const size_t index = find_with_early_exit(
+        count,
+        find_if_matcher<InputIterator, UnaryPredicate>(first, predicate),
+        false,
+        queue
+    );
 
-    // read index and return iterator
-    return first + static_cast<difference_type>(index.read(queue));
+    return first + static_cast<difference_type>(index);
 }
 
 } // end detail namespace
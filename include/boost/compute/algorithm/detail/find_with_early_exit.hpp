@@ -0,0 +1,219 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_FIND_WITH_EARLY_EXIT_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_FIND_WITH_EARLY_EXIT_HPP
+
+#include <algorithm>
+#include <iterator>
+
+#include <boost/assert.hpp>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/index_type.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/work_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// emits code which sets "match" to true if the value at position "i"
+// satisfies predicate
+template<class InputIterator, class UnaryPredicate>
+class find_if_matcher
+{
+public:
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    find_if_matcher(InputIterator first, UnaryPredicate predicate)
+        : m_first(first),
+          m_predicate(predicate)
+    {
+    }
+
+    void operator()(meta_kernel &k) const
+    {
+        k << k.decl<const value_type>("value") << "="
+          <<     m_first[k.var<const uint_>("i")] << ";\n"
+          << "match = " << m_predicate(k.var<const value_type>("value")) << ";\n";
+    }
+
+private:
+    InputIterator m_first;
+    UnaryPredicate m_predicate;
+};
+
+// stores the smallest position in [0, count) accepted by matcher (or
+// count if there is none) to index without reading it on the host. if
+// reverse is true the largest accepted position p is searched for and
+// count - 1 - p is stored instead.
+//
+// the work-items stride over the positions in chunks of the global work
+// size (times the block of positions each work-item searches on cpu
+// devices). before each chunk every work-item reads the current result and
+// stops once a match was found before the start of the chunk, so the work
+// done is bounded by the position of the first match (plus one chunk)
+// rather than by count.
+//
+// matcher(k) must emit code setting the bool variable "match" for the
+// position in the variable "i". it may add its own arguments to k.
+//
+// the positions searched are offset by base, so "i" is base plus the
+// position. it is a uint unless base + count needs 64-bit indices, the
+// stored result is always relative to base.
+template<class Matcher>
+inline void find_with_early_exit(size_t count,
+                                 const Matcher &matcher,
+                                 bool reverse,
+                                 buffer_iterator<uint_> index,
+                                 command_queue &queue,
+                                 size_t base = 0)
+{
+    BOOST_ASSERT(!requires_64bit_indices(count));
+
+    // initialize index to the "not found" value
+    ::boost::compute::fill_n(index, 1, static_cast<uint_>(count), queue);
+
+    if(count == 0){
+        return;
+    }
+
+    const device &device = queue.get_device();
+
+    // on cpu devices each work-item searches contiguous blocks of values
+    // instead of single values, with a few work-items per compute unit
+    const bool cpu = is_cpu_device(device);
+    const size_t block = cpu ? 1024 : 1;
+
+    size_t work_group_size = 1;
+    size_t global_size = cpu_work_item_count(count, block, device);
+    if(!cpu){
+        work_group_size = get_work_group_size_parameter(
+            device, "__boost_find_if", "wgs", 256
+        );
+        const size_t max_global_size =
+            (std::max)(device.compute_units(), uint_(1)) * work_group_size * 4;
+        global_size = (std::min)(
+            max_global_size,
+            ((count + work_group_size - 1) / work_group_size) * work_group_size
+        );
+    }
+
+    detail::meta_kernel k("find_with_early_exit");
+    size_t index_arg = k.add_arg<uint_ *>(memory_object::global_memory, "index");
+    size_t offset_arg = k.add_arg<const uint_>("index_offset");
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t reverse_arg = k.add_arg<const uint_>("reverse");
+    const bool wide = requires_64bit_indices(base + count);
+    size_t base_arg = wide ? k.add_arg<const ulong_>("base") : 0;
+    atomic_min<uint_> atomic_min_uint;
+
+    k << "__global volatile uint *found = index + index_offset;\n"
+      << "const uint stride = get_global_size(0) * " << uint_(block) << ";\n"
+      << "for(uint chunk = 0; chunk < count; chunk += stride){\n"
+      // a match before this chunk was found, nothing left to do
+      << "    if(*found <= chunk){\n"
+      << "        break;\n"
+      << "    }\n";
+    if(block == 1){
+        k << "    const uint p = chunk + get_global_id(0);\n"
+          << "    if(p >= count){\n"
+          << "        break;\n"
+          << "    }\n";
+    }
+    else {
+        k << "    const uint start = chunk + get_global_id(0) * " << uint_(block) << ";\n"
+          << "    if(start >= count){\n"
+          << "        break;\n"
+          << "    }\n"
+          << "    const uint end = min(start + " << uint_(block) << ", count);\n"
+          << "    for(uint p = start; p < end; p++){\n";
+    }
+    k << "    const " << index_type_name(base + count) << " i = "
+      <<          (wide ? "base + " : "") << "(reverse ? count - 1 - p : p);\n"
+      << "    bool match = false;\n"
+      << "    {\n";
+    matcher(k);
+    k << "    }\n"
+      << "    if(match){\n"
+      << "        " << atomic_min_uint(k.var<uint_ *>("index + index_offset"), k.var<uint_>("p")) << ";\n";
+    if(block > 1){
+        // the later values of the block can not be the first match
+        k << "        break;\n"
+          << "    }\n";
+    }
+    k << "    }\n"
+      << "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(index_arg, index.get_buffer());
+    kernel.set_arg(offset_arg, static_cast<uint_>(index.get_index()));
+    kernel.set_arg(count_arg, static_cast<uint_>(count));
+    kernel.set_arg(reverse_arg, static_cast<uint_>(reverse ? 1 : 0));
+    if(wide){
+        kernel.set_arg(base_arg, static_cast<ulong_>(base));
+    }
+
+    queue.enqueue_1d_range_kernel(kernel, 0, global_size, work_group_size);
+}
+
+// returns the smallest (or, if reverse is true, the largest) position in
+// [0, count) accepted by matcher, or count if there is none.
+//
+// ranges with more positions than fit in a uint are searched in windows
+// of 2^31 positions, in order from the front (or back) until one of them
+// has a match. the positions within each window are uints, so only the
+// offset of the window is 64-bit.
+template<class Matcher>
+inline size_t find_with_early_exit(size_t count,
+                                   const Matcher &matcher,
+                                   bool reverse,
+                                   command_queue &queue)
+{
+    if(count == 0){
+        return 0;
+    }
+
+    const size_t window_size =
+        requires_64bit_indices(count) ? size_t(1) << 31 : count;
+
+    scalar<uint_> index(queue.get_context());
+    const buffer_iterator<uint_> index_iterator(index.get_buffer(), 0);
+
+    for(size_t searched = 0; searched < count; searched += window_size){
+        const size_t window_count = (std::min)(window_size, count - searched);
+        const size_t base =
+            reverse ? count - searched - window_count : searched;
+
+        find_with_early_exit(
+            window_count, matcher, reverse, index_iterator, queue, base
+        );
+
+        const size_t result = static_cast<size_t>(index.read(queue));
+        if(result != window_count){
+            return reverse ? base + window_count - 1 - result : base + result;
+        }
+    }
+
+    return count;
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_FIND_WITH_EARLY_EXIT_HPP
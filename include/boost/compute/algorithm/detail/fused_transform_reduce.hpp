@@ -0,0 +1,543 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_FUSED_TRANSFORM_REDUCE_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_FUSED_TRANSFORM_REDUCE_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/functional/get.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/detail/vector_width.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns the number of values of the iterator to load at once with
+// vloadn() on the device, or one if they can only be loaded one by one
+template<class Iterator>
+inline uint_ fused_transform_reduce_vector_width(const Iterator &iterator,
+                                                 const device &device)
+{
+    (void) iterator;
+    (void) device;
+
+    return 1;
+}
+
+template<class T>
+inline uint_ fused_transform_reduce_vector_width(const buffer_iterator<T> &iterator,
+                                                 const device &device)
+{
+    (void) iterator;
+
+    return preferred_vector_width<T>(device);
+}
+
+// returns an expression loading the vector with the given index from a
+// buffer iterator (only valid when the vector width is greater than one)
+template<class Iterator>
+inline std::string fused_transform_reduce_vload(meta_kernel &k,
+                                                const Iterator &iterator,
+                                                uint_ width,
+                                                const std::string &index)
+{
+    (void) k;
+    (void) iterator;
+    (void) width;
+    (void) index;
+
+    return std::string();
+}
+
+template<class T>
+inline std::string fused_transform_reduce_vload(meta_kernel &k,
+                                                const buffer_iterator<T> &iterator,
+                                                uint_ width,
+                                                const std::string &index)
+{
+    return k.vload<T>(width, index, iterator.get_buffer(), iterator.get_index());
+}
+
+// predicate of the fused reduction selecting every value
+struct fused_select_all
+{
+};
+
+// emits the start of the block reducing the value x if it is selected
+// by predicate
+template<class Predicate, class Expr>
+inline void fused_select_begin(meta_kernel &k,
+                               const Predicate &predicate,
+                               const Expr &x)
+{
+    k << "if(" << predicate(x) << "){\n";
+}
+
+template<class Expr>
+inline void fused_select_begin(meta_kernel &k,
+                               const fused_select_all &predicate,
+                               const Expr &x)
+{
+    (void) k;
+    (void) predicate;
+    (void) x;
+}
+
+template<class Predicate>
+inline void fused_select_end(meta_kernel &k, const Predicate &predicate)
+{
+    (void) predicate;
+
+    k << "}\n";
+}
+
+inline void fused_select_end(meta_kernel &k, const fused_select_all &predicate)
+{
+    (void) k;
+    (void) predicate;
+}
+
+// input of the fused reduction applying a unary function to the values
+// of one range for which predicate (applied to the untransformed value)
+// returns true
+template<class InputIterator,
+         class UnaryFunction,
+         class Predicate = fused_select_all>
+class fused_unary_input
+{
+public:
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        boost::compute::result_of<UnaryFunction(value_type)>::type result_type;
+
+    fused_unary_input(InputIterator first,
+                      UnaryFunction function,
+                      Predicate predicate = Predicate())
+        : m_first(first),
+          m_function(function),
+          m_predicate(predicate)
+    {
+    }
+
+    uint_ vector_width(const device &device) const
+    {
+        return fused_transform_reduce_vector_width(m_first, device);
+    }
+
+    // emits the transformed value at index
+    void load(meta_kernel &k, const std::string &index)
+    {
+        k << m_function(m_first[k.var<const uint_>(index)]);
+    }
+
+    // declares the vector of values at vector index (only when
+    // vector_width() is greater than one)
+    void load_vector(meta_kernel &k, uint_ width, const std::string &index)
+    {
+        k << type_name<value_type>() << width << " v0 = "
+          << fused_transform_reduce_vload(k, m_first, width, index) << ";\n";
+    }
+
+    // emits the transformed value of a component of the loaded vector
+    void load_component(meta_kernel &k, const std::string &component)
+    {
+        k << m_function(k.var<value_type>("v0." + component));
+    }
+
+    // emits the start of the block reducing the value at index if it is
+    // selected
+    void begin_select(meta_kernel &k, const std::string &index)
+    {
+        fused_select_begin(k, m_predicate, m_first[k.var<const uint_>(index)]);
+    }
+
+    void begin_select_component(meta_kernel &k, const std::string &component)
+    {
+        fused_select_begin(k, m_predicate, k.var<value_type>("v0." + component));
+    }
+
+    void end_select(meta_kernel &k)
+    {
+        fused_select_end(k, m_predicate);
+    }
+
+private:
+    InputIterator m_first;
+    UnaryFunction m_function;
+    Predicate m_predicate;
+};
+
+// input of the fused reduction applying a binary function to two ranges
+template<class InputIterator1, class InputIterator2, class BinaryFunction>
+class fused_binary_input
+{
+public:
+    typedef typename std::iterator_traits<InputIterator1>::value_type value_type1;
+    typedef typename std::iterator_traits<InputIterator2>::value_type value_type2;
+    typedef typename
+        boost::compute::result_of<BinaryFunction(value_type1, value_type2)>::type
+        result_type;
+
+    fused_binary_input(InputIterator1 first1,
+                       InputIterator2 first2,
+                       BinaryFunction function)
+        : m_first1(first1),
+          m_first2(first2),
+          m_function(function)
+    {
+    }
+
+    uint_ vector_width(const device &device) const
+    {
+        // both ranges are loaded with the same width (which are powers
+        // of two)
+        return (std::min)(fused_transform_reduce_vector_width(m_first1, device),
+                          fused_transform_reduce_vector_width(m_first2, device));
+    }
+
+    void load(meta_kernel &k, const std::string &index)
+    {
+        k << m_function(m_first1[k.var<const uint_>(index)],
+                        m_first2[k.var<const uint_>(index)]);
+    }
+
+    void load_vector(meta_kernel &k, uint_ width, const std::string &index)
+    {
+        k << type_name<value_type1>() << width << " v0 = "
+          << fused_transform_reduce_vload(k, m_first1, width, index) << ";\n"
+          << type_name<value_type2>() << width << " v1 = "
+          << fused_transform_reduce_vload(k, m_first2, width, index) << ";\n";
+    }
+
+    void load_component(meta_kernel &k, const std::string &component)
+    {
+        k << m_function(k.var<value_type1>("v0." + component),
+                        k.var<value_type2>("v1." + component));
+    }
+
+    // all values are selected
+    void begin_select(meta_kernel &k, const std::string &index)
+    {
+        (void) k;
+        (void) index;
+    }
+
+    void begin_select_component(meta_kernel &k, const std::string &component)
+    {
+        (void) k;
+        (void) component;
+    }
+
+    void end_select(meta_kernel &k)
+    {
+        (void) k;
+    }
+
+private:
+    InputIterator1 m_first1;
+    InputIterator2 m_first2;
+    BinaryFunction m_function;
+};
+
+// returns the work-group size for the fused reduction of values of type T
+template<class T>
+inline size_t fused_transform_reduce_work_group_size(command_queue &queue)
+{
+    const boost::shared_ptr<device_profile> profile =
+        device_profile::get(queue.get_device());
+
+    size_t work_group_size = (std::min)(size_t(256), profile->max_work_group_size());
+    work_group_size = (std::min)(
+        work_group_size,
+        static_cast<size_t>(profile->local_memory_size() / (sizeof(T) + sizeof(uint_)))
+    );
+
+    // round down to a power of two
+    size_t power = 1;
+    while(power * 2 <= work_group_size){
+        power *= 2;
+    }
+
+    return power;
+}
+
+// emits the statement adding x to the private sum of the work-item
+template<class T, class BinaryFunction>
+inline void fused_transform_reduce_accumulate(meta_kernel &k,
+                                              BinaryFunction function)
+{
+    k <<
+        "    if(has_sum){\n" <<
+        "        sum = " << function(k.var<T>("sum"), k.var<T>("x")) << ";\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        sum = x;\n" <<
+        "        has_sum = 1;\n" <<
+        "    }\n";
+}
+
+// reduces the selected transformed values of input in each work-group.
+// every work-item first reduces a strided part of the input in private
+// memory, loading contiguous buffers with vloadn() when width is greater
+// than one, and the work-group then reduces the values of its work-items
+// in local memory.
+//
+// the result of a work-group is only written if it was given at least one
+// selected value. if result_has_sum is not null, it is set to one for the
+// work-groups which wrote their result and to zero for the others.
+template<class Input, class BinaryFunction, class T>
+inline void fused_transform_reduce_pass(Input &input,
+                                        size_t count,
+                                        BinaryFunction function,
+                                        buffer_iterator<T> result,
+                                        const buffer_iterator<uint_> *result_has_sum,
+                                        uint_ width,
+                                        size_t work_group_size,
+                                        size_t work_group_count,
+                                        command_queue &queue)
+{
+    meta_kernel k("fused_transform_reduce");
+    size_t count_arg = k.add_arg<const uint_>("count");
+
+    k <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint global_size = get_global_size(0);\n" <<
+        "__local " << k.type<T>() << " scratch[" << work_group_size << "];\n" <<
+        "__local uint scratch_has_sum[" << work_group_size << "];\n" <<
+        k.decl<T>("sum") << ";\n" <<
+        "uint has_sum = 0;\n";
+
+    if(width > 1){
+        k <<
+            "const uint vector_count = count / " << width << ";\n" <<
+            "for(uint i = get_global_id(0); i < vector_count; i += global_size){\n";
+        input.load_vector(k, width, "i");
+        for(uint_ j = 0; j < width; j++){
+            k << "{\n";
+            input.begin_select_component(k, vector_component(j));
+            k << k.decl<const T>("x") << " = ";
+            input.load_component(k, vector_component(j));
+            k << ";\n";
+            fused_transform_reduce_accumulate<T>(k, function);
+            input.end_select(k);
+            k << "}\n";
+        }
+        k <<
+            "}\n" <<
+            // values after the last full vector
+            "if(vector_count * " << width << " + get_global_id(0) < count){\n" <<
+            "    const uint i = vector_count * " << width << " + get_global_id(0);\n";
+        input.begin_select(k, "i");
+        k << "    " << k.decl<const T>("x") << " = ";
+        input.load(k, "i");
+        k << ";\n";
+        fused_transform_reduce_accumulate<T>(k, function);
+        input.end_select(k);
+        k <<
+            "}\n";
+    }
+    else {
+        k <<
+            "for(uint i = get_global_id(0); i < count; i += global_size){\n";
+        input.begin_select(k, "i");
+        k << "    " << k.decl<const T>("x") << " = ";
+        input.load(k, "i");
+        k << ";\n";
+        fused_transform_reduce_accumulate<T>(k, function);
+        input.end_select(k);
+        k <<
+            "}\n";
+    }
+
+    // reduce the sums of the work-items, work-items without any
+    // value are skipped
+    k <<
+        "scratch[lid] = sum;\n" <<
+        "scratch_has_sum[lid] = has_sum;\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(uint offset = get_local_size(0) / 2; offset > 0; offset >>= 1){\n" <<
+        "    if(lid < offset && scratch_has_sum[lid + offset]){\n" <<
+        "        if(scratch_has_sum[lid]){\n" <<
+        "            scratch[lid] = " <<
+                         function(k.var<T>("scratch[lid]"),
+                                  k.var<T>("scratch[lid + offset]")) << ";\n" <<
+        "        }\n" <<
+        "        else {\n" <<
+        "            scratch[lid] = scratch[lid + offset];\n" <<
+        "            scratch_has_sum[lid] = 1;\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n" <<
+        "if(lid == 0 && scratch_has_sum[0]){\n" <<
+        "    " << result[k.var<uint_>("get_group_id(0)")] << " = scratch[0];\n" <<
+        "}\n";
+    if(result_has_sum){
+        k <<
+            "if(lid == 0){\n" <<
+            "    " << (*result_has_sum)[k.var<uint_>("get_group_id(0)")] <<
+                      " = scratch_has_sum[0];\n" <<
+            "}\n";
+    }
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(count_arg, static_cast<uint_>(count));
+
+    queue.enqueue_1d_range_kernel(
+        kernel, 0, work_group_count * work_group_size, work_group_size
+    );
+}
+
+// reduces the selected transformed values of input to result. the
+// transformed values are never stored, the input is read once in the first
+// pass and only the sums of its work-groups are reduced by the second pass.
+//
+// if init is not null it is reduced along with the values of the input.
+// otherwise result is left unchanged when no value is selected.
+//
+// the values are combined in an unspecified order so function must be
+// associative and commutative.
+template<class Input, class BinaryFunction, class T>
+inline void dispatch_fused_transform_reduce(Input &input,
+                                            size_t count,
+                                            BinaryFunction function,
+                                            buffer_iterator<T> result,
+                                            command_queue &queue,
+                                            const T *init = 0)
+{
+    const device &device = queue.get_device();
+    const size_t work_group_size = fused_transform_reduce_work_group_size<T>(queue);
+
+    // enough work-groups to fill the device, each work-item reduces at
+    // least a few values (or vectors of values) in private memory
+    const uint_ width = input.vector_width(device);
+    const size_t units = count / width;
+    const size_t max_work_group_count =
+        (std::max)(size_t(1), size_t(device_profile::get(device)->compute_units() * 4));
+    const size_t work_group_count = (std::max)(
+        size_t(1),
+        (std::min)(
+            max_work_group_count,
+            (units + 4 * work_group_size - 1) / (4 * work_group_size)
+        )
+    );
+
+    if(work_group_count == 1 && !init){
+        fused_transform_reduce_pass(
+            input, count, function, result, 0, width, work_group_size, 1, queue
+        );
+        return;
+    }
+
+    // the sums of the work-groups, followed by init
+    const size_t sum_count = work_group_count + (init ? 1 : 0);
+    scratch_vector<T> sums(sum_count, queue);
+    scratch_vector<uint_> has_sums(sum_count, queue);
+    const buffer_iterator<uint_> has_sums_begin = has_sums.begin();
+
+    fused_transform_reduce_pass(
+        input, count, function, sums.begin(), &has_sums_begin,
+        width, work_group_size, work_group_count, queue
+    );
+
+    if(init){
+        write_single_value<T>(*init, sums.get_buffer(), work_group_count, queue);
+        write_single_value<uint_>(1, has_sums.get_buffer(), work_group_count, queue);
+    }
+
+    // reduce the sums of the work-groups which were given any selected value
+    typedef zip_iterator<
+        boost::tuple<buffer_iterator<T>, buffer_iterator<uint_> >
+    > sums_iterator;
+
+    fused_unary_input<sums_iterator, get<0>, get<1> > sums_input(
+        make_zip_iterator(boost::make_tuple(sums.begin(), has_sums.begin())),
+        get<0>(),
+        get<1>()
+    );
+    fused_transform_reduce_pass(
+        sums_input, sum_count, function, result, 0, 1, work_group_size, 1, queue
+    );
+}
+
+// reduces transform(first[i]) for each i in [0, count) with function
+template<class InputIterator, class UnaryFunction, class BinaryFunction, class T>
+inline void fused_transform_reduce(InputIterator first,
+                                   size_t count,
+                                   UnaryFunction transform,
+                                   BinaryFunction function,
+                                   buffer_iterator<T> result,
+                                   command_queue &queue)
+{
+    fused_unary_input<InputIterator, UnaryFunction> input(first, transform);
+    dispatch_fused_transform_reduce(input, count, function, result, queue);
+}
+
+// reduces init and transform(first[i]) for each i in [0, count) for which
+// predicate(first[i]) returns true with function
+template<class InputIterator,
+         class UnaryFunction,
+         class Predicate,
+         class BinaryFunction,
+         class T>
+inline void fused_transform_reduce_if(InputIterator first,
+                                      size_t count,
+                                      UnaryFunction transform,
+                                      Predicate predicate,
+                                      BinaryFunction function,
+                                      const T &init,
+                                      buffer_iterator<T> result,
+                                      command_queue &queue)
+{
+    fused_unary_input<InputIterator, UnaryFunction, Predicate> input(
+        first, transform, predicate
+    );
+    dispatch_fused_transform_reduce(input, count, function, result, queue, &init);
+}
+
+// reduces transform(first1[i], first2[i]) for each i in [0, count) with
+// function
+template<class InputIterator1,
+         class InputIterator2,
+         class BinaryTransformFunction,
+         class BinaryFunction,
+         class T>
+inline void fused_transform_reduce(InputIterator1 first1,
+                                   InputIterator2 first2,
+                                   size_t count,
+                                   BinaryTransformFunction transform,
+                                   BinaryFunction function,
+                                   buffer_iterator<T> result,
+                                   command_queue &queue)
+{
+    fused_binary_input<InputIterator1, InputIterator2, BinaryTransformFunction>
+        input(first1, first2, transform);
+    dispatch_fused_transform_reduce(input, count, function, result, queue);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_FUSED_TRANSFORM_REDUCE_HPP
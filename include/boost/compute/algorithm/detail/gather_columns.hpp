@@ -0,0 +1,170 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_GATHER_COLUMNS_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_GATHER_COLUMNS_HPP
+
+#include <boost/tuple/tuple.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
+#include <boost/compute/type_traits/is_fundamental.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// true if values can be copied from input to result as uint, uint2 or
+// uint4 words instead of as values of their type. this is the case for
+// structs (and pairs) in buffers whose size is a multiple of four bytes,
+// which the device compiler may otherwise load member by member. scalar
+// and vector types are already loaded with a single instruction.
+template<class InputIterator, class OutputIterator>
+struct is_word_copyable : public boost::false_type {};
+
+template<class T>
+struct is_word_copyable<buffer_iterator<T>, buffer_iterator<T> >
+    : public boost::integral_constant<
+          bool, !is_fundamental<T>::value && sizeof(T) % 4 == 0
+      > {};
+
+// writes the assignment of input[input_index] to result[result_index]
+template<class InputIterator, class OutputIterator>
+inline void copy_column_value(meta_kernel &k,
+                              const InputIterator &input,
+                              const char *input_index,
+                              const OutputIterator &result,
+                              const char *result_index,
+                              boost::false_type)
+{
+    k << result[k.var<uint_>(result_index)] << " = " <<
+         input[k.var<uint_>(input_index)] << ";\n";
+}
+
+// copies the value with the widest words dividing its size. the values
+// (and so the words) are aligned as the buffers are aligned to at least
+// 16 bytes.
+template<class T>
+inline void copy_column_value(meta_kernel &k,
+                              const buffer_iterator<T> &input,
+                              const char *input_index,
+                              const buffer_iterator<T> &result,
+                              const char *result_index,
+                              boost::true_type)
+{
+    const size_t word_size =
+        sizeof(T) % 16 == 0 ? 16 : sizeof(T) % 8 == 0 ? 8 : 4;
+    const char *word_type =
+        word_size == 16 ? "uint4" : word_size == 8 ? "uint2" : "uint";
+
+    k << "{\n" <<
+         "__global const " << word_type << " *src = " <<
+             "(__global const " << word_type << " *)(" <<
+             k.get_buffer_identifier<T>(input.get_buffer()) << " + " <<
+             uint_(input.get_index()) << " + " << input_index << ");\n" <<
+         "__global " << word_type << " *dst = " <<
+             "(__global " << word_type << " *)(" <<
+             k.get_buffer_identifier<T>(result.get_buffer()) << " + " <<
+             uint_(result.get_index()) << " + " << result_index << ");\n" <<
+         "for(uint w = 0; w < " << uint_(sizeof(T) / word_size) << "; w++){\n" <<
+         "    dst[w] = src[w];\n" <<
+         "}\n" <<
+         "}\n";
+}
+
+template<class InputIterator, class OutputIterator>
+inline void copy_column(meta_kernel &k,
+                        const InputIterator &input,
+                        const char *input_index,
+                        const OutputIterator &result,
+                        const char *result_index)
+{
+    copy_column_value(
+        k, input, input_index, result, result_index,
+        typename is_word_copyable<InputIterator, OutputIterator>::type()
+    );
+}
+
+inline void copy_columns(meta_kernel &k,
+                         const boost::tuples::null_type &inputs,
+                         const char *input_index,
+                         const boost::tuples::null_type &results,
+                         const char *result_index)
+{
+    (void) k;
+    (void) inputs;
+    (void) input_index;
+    (void) results;
+    (void) result_index;
+}
+
+// writes the assignments for each pair of input and output iterators of
+// a zip_iterator
+template<class InputHead, class InputTail, class OutputHead, class OutputTail>
+inline void copy_columns(meta_kernel &k,
+                         const boost::tuples::cons<InputHead, InputTail> &inputs,
+                         const char *input_index,
+                         const boost::tuples::cons<OutputHead, OutputTail> &results,
+                         const char *result_index)
+{
+    copy_column(k, inputs.get_head(), input_index, results.get_head(), result_index);
+    copy_columns(k, inputs.get_tail(), input_index, results.get_tail(), result_index);
+}
+
+template<class InputIterator, class OutputIterator>
+inline void dispatch_copy_columns(meta_kernel &k,
+                                  const InputIterator &input,
+                                  const char *input_index,
+                                  const OutputIterator &result,
+                                  const char *result_index)
+{
+    copy_column(k, input, input_index, result, result_index);
+}
+
+template<class InputTuple, class OutputTuple>
+inline void dispatch_copy_columns(meta_kernel &k,
+                                  const zip_iterator<InputTuple> &input,
+                                  const char *input_index,
+                                  const zip_iterator<OutputTuple> &result,
+                                  const char *result_index)
+{
+    copy_columns(
+        k, input.get_iterator_tuple(), input_index,
+        result.get_iterator_tuple(), result_index
+    );
+}
+
+// writes the assignment of the value at index p of input to index i of
+// result (for each column if they are zip_iterator's)
+template<class InputIterator, class OutputIterator>
+inline void gather_columns(meta_kernel &k,
+                           const InputIterator &input,
+                           const OutputIterator &result)
+{
+    dispatch_copy_columns(k, input, "p", result, "i");
+}
+
+// writes the assignment of the value at index i of input to index p of
+// result (for each column if they are zip_iterator's)
+template<class InputIterator, class OutputIterator>
+inline void scatter_columns(meta_kernel &k,
+                            const InputIterator &input,
+                            const OutputIterator &result)
+{
+    dispatch_copy_columns(k, input, "i", result, "p");
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_GATHER_COLUMNS_HPP
@@ -16,6 +16,7 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/work_size.hpp>
 #include <boost/compute/memory/local_buffer.hpp>
 
 namespace boost {
@@ -93,6 +94,7 @@ inline void inplace_reduce(Iterator first,
     const buffer *input_buffer = &first.get_buffer();
     const buffer *output_buffer = &output.get_buffer();
 
+    k.set_reqd_work_group_size(block_size);
     kernel kernel = k.compile(context);
 
     while(input_size > 1){
@@ -107,10 +109,7 @@ inline void inplace_reduce(Iterator first,
                                       block_size);
 
         input_size =
-            static_cast<size_t>(
-                std::ceil(float(input_size) / (block_size * values_per_thread)
-            )
-        );
+            calculate_work_size(input_size, block_size * values_per_thread, 1);
 
         block_count = input_size / (block_size * values_per_thread);
         if(block_count * block_size * values_per_thread != input_size)
@@ -0,0 +1,188 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_LEXICOGRAPHIC_RADIX_SORT_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_LEXICOGRAPHIC_RADIX_SORT_HPP
+
+#include <iterator>
+
+#include <boost/tuple/tuple.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/gather.hpp>
+#include <boost/compute/algorithm/detail/radix_sort.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// meta-function returning true if the values of each iterator in the
+// cons list of a zip_iterator's iterator tuple are radix-sortable
+template<class Columns>
+struct are_radix_sortable_columns;
+
+template<>
+struct are_radix_sortable_columns<boost::tuples::null_type>
+    : public boost::true_type {};
+
+template<class Head, class Tail>
+struct are_radix_sortable_columns<boost::tuples::cons<Head, Tail> >
+    : public boost::integral_constant<
+          bool,
+          is_radix_sortable<
+              typename std::iterator_traits<Head>::value_type
+          >::value &&
+          are_radix_sortable_columns<Tail>::value
+      > {};
+
+// meta-function returning true if zip_iterator's with IteratorTuple can be
+// sorted with lexicographic_radix_sort()
+template<class IteratorTuple>
+struct is_lexicographic_radix_sortable
+    : public are_radix_sortable_columns<typename IteratorTuple::inherited> {};
+
+// stably sorts the indices by the values of column, the first pass sorts
+// the values themselves and later passes the values gathered in the order
+// of the indices sorted so far
+template<class Iterator>
+inline void lexicographic_radix_sort_column(Iterator column,
+                                            size_t count,
+                                            buffer_iterator<uint_> indices,
+                                            bool first_pass,
+                                            command_queue &queue)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    scratch_vector<value_type> keys(count, queue);
+    if(first_pass){
+        ::boost::compute::copy(column, column + count, keys.begin(), queue);
+        radix_sort_indices(keys.begin(), keys.end(), indices, queue);
+    }
+    else {
+        ::boost::compute::gather(
+            indices, indices + count, column, keys.begin(), queue
+        );
+        radix_sort_by_key(keys.begin(), keys.end(), indices, queue);
+    }
+}
+
+inline void lexicographic_radix_sort_columns(const boost::tuples::null_type &columns,
+                                             size_t count,
+                                             buffer_iterator<uint_> indices,
+                                             bool &first_pass,
+                                             command_queue &queue)
+{
+    (void) columns;
+    (void) count;
+    (void) indices;
+    (void) first_pass;
+    (void) queue;
+}
+
+// sorts by the least significant (last) column first
+template<class Head, class Tail>
+inline void lexicographic_radix_sort_columns(const boost::tuples::cons<Head, Tail> &columns,
+                                             size_t count,
+                                             buffer_iterator<uint_> indices,
+                                             bool &first_pass,
+                                             command_queue &queue)
+{
+    lexicographic_radix_sort_columns(
+        columns.get_tail(), count, indices, first_pass, queue
+    );
+    lexicographic_radix_sort_column(
+        columns.get_head(), count, indices, first_pass, queue
+    );
+    first_pass = false;
+}
+
+// reorders each column by the indices
+inline void lexicographic_permute_columns(const boost::tuples::null_type &columns,
+                                          size_t count,
+                                          buffer_iterator<uint_> indices,
+                                          command_queue &queue)
+{
+    (void) columns;
+    (void) count;
+    (void) indices;
+    (void) queue;
+}
+
+template<class Head, class Tail>
+inline void lexicographic_permute_columns(const boost::tuples::cons<Head, Tail> &columns,
+                                          size_t count,
+                                          buffer_iterator<uint_> indices,
+                                          command_queue &queue)
+{
+    typedef typename std::iterator_traits<Head>::value_type value_type;
+
+    const Head &column = columns.get_head();
+
+    scratch_vector<value_type> values(count, queue);
+    ::boost::compute::copy(column, column + count, values.begin(), queue);
+    ::boost::compute::gather(
+        indices, indices + count, values.begin(), column, queue
+    );
+
+    lexicographic_permute_columns(columns.get_tail(), count, indices, queue);
+}
+
+// writes to indices the permutation sorting the rows of the columns of
+// the zip_iterator range [first, last) lexicographically. this is a least
+// significant digit sort over the columns: each radix sort pass is stable
+// and reorders the same index buffer by one column, beginning with the
+// last one, so no keys are packed into wider types.
+template<class IteratorTuple>
+inline void lexicographic_radix_sort_indices(zip_iterator<IteratorTuple> first,
+                                             zip_iterator<IteratorTuple> last,
+                                             buffer_iterator<uint_> indices,
+                                             command_queue &queue)
+{
+    const size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    bool first_pass = true;
+    lexicographic_radix_sort_columns(
+        first.get_iterator_tuple(), count, indices, first_pass, queue
+    );
+}
+
+// sorts the rows of the columns of the zip_iterator range [first, last)
+// lexicographically
+template<class IteratorTuple>
+inline void lexicographic_radix_sort(zip_iterator<IteratorTuple> first,
+                                     zip_iterator<IteratorTuple> last,
+                                     command_queue &queue)
+{
+    const size_t count = iterator_range_size(first, last);
+    if(count < 2){
+        return;
+    }
+
+    scratch_vector<uint_> indices(count, queue);
+    lexicographic_radix_sort_indices(first, last, indices.begin(), queue);
+    lexicographic_permute_columns(
+        first.get_iterator_tuple(), count, indices.begin(), queue
+    );
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_LEXICOGRAPHIC_RADIX_SORT_HPP
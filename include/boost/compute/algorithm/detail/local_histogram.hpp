@@ -0,0 +1,56 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_LOCAL_HISTOGRAM_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_LOCAL_HISTOGRAM_HPP
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// opencl functions for counting values in per-work-group bins stored in
+// local memory. each work-group clears its bins, increments them with
+// local atomics and then either merges them into the global bins with
+// local_histogram_merge() (histogram()) or stores them per work-group
+// (the count step of radix_sort()).
+const char local_histogram_source[] =
+"inline void local_histogram_clear(__local uint *bins, const uint bin_count)\n"
+"{\n"
+"    for(uint i = get_local_id(0); i < bin_count; i += get_local_size(0)){\n"
+"        bins[i] = 0;\n"
+"    }\n"
+"    barrier(CLK_LOCAL_MEM_FENCE);\n"
+"}\n"
+
+"inline void local_histogram_add(__local uint *bins, const uint bin)\n"
+"{\n"
+"    atomic_inc(bins + bin);\n"
+"}\n"
+
+     // adds the counts of the work-group to the global bins, bins which
+     // are empty in the work-group are skipped
+"inline void local_histogram_merge(__local uint *bins,\n"
+"                                  __global uint *output,\n"
+"                                  const uint bin_count)\n"
+"{\n"
+"    barrier(CLK_LOCAL_MEM_FENCE);\n"
+"    for(uint i = get_local_id(0); i < bin_count; i += get_local_size(0)){\n"
+"        const uint n = bins[i];\n"
+"        if(n != 0){\n"
+"            atomic_add(output + i, n);\n"
+"        }\n"
+"    }\n"
+"}\n";
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_LOCAL_HISTOGRAM_HPP
@@ -0,0 +1,209 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_MERGE_SORT_ON_CPU_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_MERGE_SORT_ON_CPU_HPP
+
+#include <iterator>
+
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/work_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// number of values in the runs sorted with an insertion sort before the
+// merge passes of merge_sort_on_cpu()
+static const size_t merge_sort_on_cpu_run_size = 32;
+
+// sorts each run of run values in place with an insertion sort. each
+// work-item sorts the runs of its chunk of chunk values (a multiple of
+// run).
+template<class T, class Compare>
+inline void merge_sort_on_cpu_sort_runs(buffer_iterator<T> first,
+                                        Compare compare,
+                                        size_t count,
+                                        size_t chunk,
+                                        size_t work_items,
+                                        command_queue &queue)
+{
+    meta_kernel k("merge_sort_on_cpu_sort_runs");
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t chunk_arg = k.add_arg<const uint_>("chunk");
+
+    k <<
+        "const uint start = get_global_id(0) * chunk;\n" <<
+        "const uint end = min(start + chunk, count);\n" <<
+        "for(uint run_start = start; run_start < end; run_start += " <<
+            uint_(merge_sort_on_cpu_run_size) << "){\n" <<
+        "    const uint run_end = min(run_start + " <<
+                 uint_(merge_sort_on_cpu_run_size) << ", end);\n" <<
+        "    for(uint i = run_start + 1; i < run_end; i++){\n" <<
+        "        " << k.decl<T>("key") << " = " << first[k.var<uint_>("i")] << ";\n" <<
+        "        uint j = i;\n" <<
+        "        while(j > run_start && " <<
+                     compare(k.var<T>("key"), first[k.var<uint_>("j-1")]) << "){\n" <<
+        "            " << first[k.var<uint_>("j")] << " = " <<
+                          first[k.var<uint_>("j-1")] << ";\n" <<
+        "            j--;\n" <<
+        "        }\n" <<
+        "        " << first[k.var<uint_>("j")] << " = key;\n" <<
+        "    }\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(count_arg, static_cast<uint_>(count));
+    kernel.set_arg(chunk_arg, static_cast<uint_>(chunk));
+
+    queue.enqueue_1d_range_kernel(kernel, 0, work_items, 1);
+}
+
+// merges pairs of adjacent sorted runs of width values from input into
+// output. each work-item writes a contiguous chunk of chunk values of the
+// output, which may cover several pairs (or part of one). where the chunk
+// starts inside a pair the position in its two runs is found by a binary
+// search along the merge path.
+template<class T, class Compare>
+inline kernel merge_sort_on_cpu_merge_kernel(buffer_iterator<T> input,
+                                             buffer_iterator<T> output,
+                                             Compare compare,
+                                             size_t &count_arg,
+                                             size_t &width_arg,
+                                             size_t &chunk_arg,
+                                             command_queue &queue)
+{
+    meta_kernel k("merge_sort_on_cpu_merge_pass");
+    count_arg = k.add_arg<const uint_>("count");
+    width_arg = k.add_arg<const uint_>("width");
+    chunk_arg = k.add_arg<const uint_>("chunk");
+
+    k <<
+        "const uint out_start = get_global_id(0) * chunk;\n" <<
+        "const uint out_end = min(out_start + chunk, count);\n" <<
+        "const uint pair_size = 2 * width;\n" <<
+        "uint out = out_start;\n" <<
+        "while(out < out_end){\n" <<
+        "    const uint pair_start = (out / pair_size) * pair_size;\n" <<
+        "    const uint a_start = pair_start;\n" <<
+        "    const uint a_end = min(pair_start + width, count);\n" <<
+        "    const uint b_start = a_end;\n" <<
+        "    const uint b_end = min(pair_start + pair_size, count);\n" <<
+        "    const uint diag = out - pair_start;\n" <<
+
+        // number of values from the first run preceding diag in the output
+        "    uint lo = diag > (b_end - b_start) ? diag - (b_end - b_start) : 0;\n" <<
+        "    uint hi = min(diag, a_end - a_start);\n" <<
+        "    while(lo < hi){\n" <<
+        "        const uint mid = (lo + hi) / 2;\n" <<
+        "        if(" << compare(input[k.expr<uint_>("b_start + diag - 1 - mid")],
+                                 input[k.expr<uint_>("a_start + mid")]) << "){\n" <<
+        "            hi = mid;\n" <<
+        "        }\n" <<
+        "        else {\n" <<
+        "            lo = mid + 1;\n" <<
+        "        }\n" <<
+        "    }\n" <<
+
+        // merge up to the end of the pair (or chunk), taking values from
+        // the first run on ties
+        "    uint i = a_start + lo;\n" <<
+        "    uint j = b_start + diag - lo;\n" <<
+        "    const uint end = min(out_end, b_end);\n" <<
+        "    for(; out < end; out++){\n" <<
+        "        if(i < a_end && (j >= b_end || !(" <<
+                     compare(input[k.var<uint_>("j")], input[k.var<uint_>("i")]) << "))){\n" <<
+        "            " << output[k.var<uint_>("out")] << " = " <<
+                          input[k.var<uint_>("i")] << ";\n" <<
+        "            i++;\n" <<
+        "        }\n" <<
+        "        else {\n" <<
+        "            " << output[k.var<uint_>("out")] << " = " <<
+                          input[k.var<uint_>("j")] << ";\n" <<
+        "            j++;\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "}\n";
+
+    return k.compile(queue.get_context());
+}
+
+// stable comparison sort for cpu devices. the range is split into a few
+// contiguous chunks per compute unit, the runs of each chunk are sorted
+// with an insertion sort and then merged in passes of doubling width, in
+// which each work-item again writes one contiguous chunk of the output.
+// no local memory or barriers are used.
+template<class T, class Compare>
+inline void merge_sort_on_cpu(buffer_iterator<T> first,
+                              buffer_iterator<T> last,
+                              Compare compare,
+                              command_queue &queue)
+{
+    const size_t count = iterator_range_size(first, last);
+    if(count < 2){
+        return;
+    }
+
+    const size_t run = merge_sort_on_cpu_run_size;
+    const size_t work_items =
+        cpu_work_item_count(count, 64 * run, queue.get_device());
+
+    // chunks of whole runs
+    size_t chunk = (count + work_items - 1) / work_items;
+    chunk = ((chunk + run - 1) / run) * run;
+
+    merge_sort_on_cpu_sort_runs(first, compare, count, chunk, work_items, queue);
+
+    if(count <= run){
+        return;
+    }
+
+    scratch_vector<T> tmp(count, queue);
+    buffer_iterator<T> keys[] = { first, tmp.begin() };
+
+    // one kernel for each direction between the input and temporary storage
+    size_t count_args[2];
+    size_t width_args[2];
+    size_t chunk_args[2];
+    kernel kernels[2];
+    for(size_t i = 0; i < 2; i++){
+        kernels[i] = merge_sort_on_cpu_merge_kernel(
+            keys[i], keys[1 - i], compare,
+            count_args[i], width_args[i], chunk_args[i], queue
+        );
+        kernels[i].set_arg(count_args[i], static_cast<uint_>(count));
+        kernels[i].set_arg(chunk_args[i], static_cast<uint_>(chunk));
+    }
+
+    size_t input = 0;
+    for(size_t width = run; width < count; width *= 2){
+        kernels[input].set_arg(width_args[input], static_cast<uint_>(width));
+        queue.enqueue_1d_range_kernel(kernels[input], 0, work_items, 1);
+
+        input = 1 - input;
+    }
+
+    // copy back to the input range
+    if(input == 1){
+        ::boost::compute::copy(tmp.begin(), tmp.end(), first, queue);
+    }
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_MERGE_SORT_ON_CPU_HPP
@@ -0,0 +1,320 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_MERGE_SORT_ON_GPU_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_MERGE_SORT_ON_GPU_HPP
+
+#include <algorithm>
+#include <iterator>
+
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// maximum number of output elements merged by each work-item
+static const size_t merge_sort_tile_size = 8;
+
+// sorts each block of work_group_size elements in local memory. each
+// work-item computes the final position of its element by counting the
+// elements in the block which are ordered before it. elements comparing
+// equal keep their relative order.
+template<class KeyIterator, class ValueIterator, class Compare>
+inline void merge_sort_block_sort(KeyIterator keys_first,
+                                  ValueIterator values_first,
+                                  Compare compare,
+                                  size_t count,
+                                  size_t work_group_size,
+                                  bool sort_by_key,
+                                  command_queue &queue)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type key_type;
+    typedef typename std::iterator_traits<ValueIterator>::value_type value_type;
+
+    meta_kernel k("merge_sort_block_sort");
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t local_keys_arg = k.add_arg<key_type *>(memory_object::local_memory, "lkeys");
+
+    k <<
+        "const uint gid = get_global_id(0);\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint block_start = get_group_id(0) * get_local_size(0);\n" <<
+        "const uint n = min((uint) get_local_size(0), count - block_start);\n" <<
+        k.decl<key_type>("key") << ";\n";
+    if(sort_by_key){
+        k << k.decl<value_type>("value") << ";\n";
+    }
+    k <<
+        "if(gid < count){\n" <<
+        "    key = " << keys_first[k.var<const uint_>("gid")] << ";\n";
+    if(sort_by_key){
+        k <<
+        "    value = " << values_first[k.var<const uint_>("gid")] << ";\n";
+    }
+    k <<
+        "    lkeys[lid] = key;\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "if(gid < count){\n" <<
+        "    uint rank = 0;\n" <<
+        "    for(uint j = 0; j < n; j++){\n" <<
+        "        if(" << compare(k.var<const key_type>("lkeys[j]"),
+                                 k.var<const key_type>("key")) << " ||\n" <<
+        "           (j < lid && !(" << compare(k.var<const key_type>("key"),
+                                               k.var<const key_type>("lkeys[j]")) << "))){\n" <<
+        "            rank++;\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "    " << keys_first[k.expr<uint_>("block_start + rank")] << " = key;\n";
+    if(sort_by_key){
+        k <<
+        "    " << values_first[k.expr<uint_>("block_start + rank")] << " = value;\n";
+    }
+    k <<
+        "}\n";
+
+    const context &context = queue.get_context();
+    ::boost::compute::kernel kernel = k.compile(context);
+    kernel.set_arg(count_arg, static_cast<uint_>(count));
+    kernel.set_arg(local_keys_arg, local_buffer<key_type>(work_group_size));
+
+    const size_t global_size =
+        ((count + work_group_size - 1) / work_group_size) * work_group_size;
+
+    queue.enqueue_1d_range_kernel(kernel, 0, global_size, work_group_size);
+}
+
+// merges pairs of adjacent sorted runs from keys_first into result_keys.
+// the pairs start every pair_size elements and their first run has width
+// elements. each work-item produces up to merge_sort_tile_size elements of
+// the output and finds where its tile starts in the two input runs by a
+// binary search along the merge path.
+template<class KeyIterator,
+         class ValueIterator,
+         class ResultKeyIterator,
+         class ResultValueIterator,
+         class Compare>
+inline void merge_sort_merge_pass(KeyIterator keys_first,
+                                  ValueIterator values_first,
+                                  ResultKeyIterator result_keys,
+                                  ResultValueIterator result_values,
+                                  Compare compare,
+                                  size_t count,
+                                  size_t width,
+                                  size_t pair_size,
+                                  bool sort_by_key,
+                                  command_queue &queue)
+{
+    meta_kernel k("merge_sort_merge_pass");
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t width_arg = k.add_arg<const uint_>("width");
+    size_t pair_size_arg = k.add_arg<const uint_>("pair_size");
+    size_t tile_arg = k.add_arg<const uint_>("tile");
+
+    k <<
+        "const uint out_start = get_global_id(0) * tile;\n" <<
+        "if(out_start >= count){\n" <<
+        "    return;\n" <<
+        "}\n" <<
+        "const uint pair_start = (out_start / pair_size) * pair_size;\n" <<
+        "const uint a_start = pair_start;\n" <<
+        "const uint a_end = min(pair_start + width, count);\n" <<
+        "const uint b_start = a_end;\n" <<
+        "const uint b_end = min(pair_start + pair_size, count);\n" <<
+        "const uint diag = out_start - pair_start;\n" <<
+
+        // find the number of elements from the first run which precede
+        // position diag in the merged output
+        "uint lo = diag > (b_end - b_start) ? diag - (b_end - b_start) : 0;\n" <<
+        "uint hi = min(diag, a_end - a_start);\n" <<
+        "while(lo < hi){\n" <<
+        "    const uint mid = (lo + hi) / 2;\n" <<
+        "    if(" << compare(keys_first[k.expr<uint_>("b_start + diag - 1 - mid")],
+                             keys_first[k.expr<uint_>("a_start + mid")]) << "){\n" <<
+        "        hi = mid;\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        lo = mid + 1;\n" <<
+        "    }\n" <<
+        "}\n" <<
+
+        // merge the tile, taking elements from the first run on ties
+        "uint i = a_start + lo;\n" <<
+        "uint j = b_start + diag - lo;\n" <<
+        "const uint out_end = min(out_start + tile, b_end);\n" <<
+        "for(uint out = out_start; out < out_end; out++){\n" <<
+        "    if(i < a_end && (j >= b_end || !(" <<
+                 compare(keys_first[k.var<uint_>("j")],
+                         keys_first[k.var<uint_>("i")]) << "))){\n" <<
+        "        " << result_keys[k.var<uint_>("out")] << " = " <<
+                      keys_first[k.var<uint_>("i")] << ";\n";
+    if(sort_by_key){
+        k <<
+        "        " << result_values[k.var<uint_>("out")] << " = " <<
+                      values_first[k.var<uint_>("i")] << ";\n";
+    }
+    k <<
+        "        i++;\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        " << result_keys[k.var<uint_>("out")] << " = " <<
+                      keys_first[k.var<uint_>("j")] << ";\n";
+    if(sort_by_key){
+        k <<
+        "        " << result_values[k.var<uint_>("out")] << " = " <<
+                      values_first[k.var<uint_>("j")] << ";\n";
+    }
+    k <<
+        "        j++;\n" <<
+        "    }\n" <<
+        "}\n";
+
+    const context &context = queue.get_context();
+    ::boost::compute::kernel kernel = k.compile(context);
+    kernel.set_arg(count_arg, static_cast<uint_>(count));
+    kernel.set_arg(width_arg, static_cast<uint_>(width));
+    kernel.set_arg(pair_size_arg, static_cast<uint_>(pair_size));
+
+    // pair_size is a power of two (or there is a single pair) so tiles
+    // never span two pairs of runs
+    const size_t tile = (std::min)(merge_sort_tile_size, pair_size);
+    kernel.set_arg(tile_arg, static_cast<uint_>(tile));
+
+    const size_t global_size = (count + tile - 1) / tile;
+
+    queue.enqueue_1d_range_kernel(kernel, 0, global_size, 0);
+}
+
+template<class T>
+inline size_t merge_sort_work_group_size(command_queue &queue)
+{
+    const device &device = queue.get_device();
+
+    size_t work_group_size = 128;
+    work_group_size = (std::min)(work_group_size, device.max_work_group_size());
+    work_group_size = (std::min)(
+        work_group_size,
+        static_cast<size_t>(device.local_memory_size() / (2 * sizeof(T)))
+    );
+
+    // round down to a power of two
+    size_t power = 1;
+    while(power * 2 <= work_group_size){
+        power *= 2;
+    }
+
+    return power;
+}
+
+// returns the size in bytes of the temporary buffers used by
+// merge_sort_on_gpu() for count keys of type T (and values of type
+// ValueType for sort_by_key)
+template<class T, class ValueType>
+inline size_t merge_sort_on_gpu_scratch_size(size_t count,
+                                             bool sort_by_key,
+                                             command_queue &queue)
+{
+    if(count <= merge_sort_work_group_size<T>(queue)){
+        return 0;
+    }
+
+    return buffer_pool::size_class(count * sizeof(T)) +
+           buffer_pool::size_class(sort_by_key ? count * sizeof(ValueType) : 0);
+}
+
+template<class T, class ValueType, class Compare>
+inline void merge_sort_on_gpu_impl(buffer_iterator<T> keys_first,
+                                   buffer_iterator<T> keys_last,
+                                   buffer_iterator<ValueType> values_first,
+                                   Compare compare,
+                                   bool sort_by_key,
+                                   command_queue &queue)
+{
+    const size_t count = iterator_range_size(keys_first, keys_last);
+    if(count < 2){
+        return;
+    }
+
+    const size_t work_group_size = merge_sort_work_group_size<T>(queue);
+
+    // sort blocks in-place
+    merge_sort_block_sort(
+        keys_first, values_first, compare, count, work_group_size, sort_by_key, queue
+    );
+
+    if(count <= work_group_size){
+        return;
+    }
+
+    // merge sorted runs, alternating between the input and temporary storage
+    scratch_vector<T> tmp_keys(count, queue);
+    scratch_vector<ValueType> tmp_values(sort_by_key ? count : 0, queue);
+
+    buffer_iterator<T> keys[] = { keys_first, tmp_keys.begin() };
+    buffer_iterator<ValueType> values[] = { values_first, tmp_values.begin() };
+
+    size_t input = 0;
+    for(size_t width = work_group_size; width < count; width *= 2){
+        merge_sort_merge_pass(
+            keys[input], values[input], keys[1 - input], values[1 - input],
+            compare, count, width, 2 * width, sort_by_key, queue
+        );
+
+        input = 1 - input;
+    }
+
+    // copy back to the input range
+    if(input == 1){
+        ::boost::compute::copy(
+            tmp_keys.begin(), tmp_keys.end(), keys_first, queue
+        );
+
+        if(sort_by_key){
+            ::boost::compute::copy(
+                tmp_values.begin(), tmp_values.end(), values_first, queue
+            );
+        }
+    }
+}
+
+// stable parallel comparison sort for arbitrary types and comparators.
+// blocks are first sorted in local memory and then merged in passes of
+// doubling width.
+template<class T, class Compare>
+inline void merge_sort_on_gpu(buffer_iterator<T> first,
+                              buffer_iterator<T> last,
+                              Compare compare,
+                              command_queue &queue)
+{
+    merge_sort_on_gpu_impl(first, last, first, compare, false, queue);
+}
+
+template<class Key, class Value, class Compare>
+inline void merge_sort_by_key_on_gpu(buffer_iterator<Key> keys_first,
+                                     buffer_iterator<Key> keys_last,
+                                     buffer_iterator<Value> values_first,
+                                     Compare compare,
+                                     command_queue &queue)
+{
+    merge_sort_on_gpu_impl(keys_first, keys_last, values_first, compare, true, queue);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_MERGE_SORT_ON_GPU_HPP
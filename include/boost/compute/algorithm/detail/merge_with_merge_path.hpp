@@ -14,11 +14,13 @@
 #include <iterator>
 
 #include <boost/compute/algorithm/detail/merge_path.hpp>
-#include <boost/compute/algorithm/fill_n.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/work_size.hpp>
 #include <boost/compute/system.hpp>
+#include <boost/compute/utility/fill_batch.hpp>
 
 namespace boost {
 namespace compute {
@@ -137,6 +139,33 @@ private:
 /// \param comp Comparator which performs less than function
 /// \param queue Queue on which to execute
 ///
+// returns the size in bytes of the temporary buffers used to merge count
+// values with merge_with_merge_path()
+inline size_t merge_with_merge_path_scratch_size(size_t count)
+{
+    const size_t tile_size = 1024;
+    const size_t tiles = (count + tile_size - 1) / tile_size + 1;
+
+    return 2 * buffer_pool::size_class(tiles * sizeof(uint_));
+}
+
+// returns the number of output values merged by each work-item when
+// merging count values. on cpu devices the output is split into a few
+// tiles per compute unit (rounded up to a power of two, which bounds the
+// number of distinct kernels as the tile size is part of their source).
+inline size_t merge_with_merge_path_tile_size(size_t count, const device &device)
+{
+    size_t tile_size = 1024;
+    if(is_cpu_device(device)){
+        const size_t tiles = cpu_work_item_count(count, tile_size, device);
+        while(tile_size * tiles < count){
+            tile_size *= 2;
+        }
+    }
+
+    return tile_size;
+}
+
 template<class InputIterator1, class InputIterator2, class OutputIterator, class Compare>
 inline OutputIterator
 merge_with_merge_path(InputIterator1 first1,
@@ -147,29 +176,35 @@ merge_with_merge_path(InputIterator1 first1,
                         Compare comp,
                         command_queue &queue = system::default_queue())
 {
-    int tile_size = 1024;
-
     int count1 = iterator_range_size(first1, last1);
     int count2 = iterator_range_size(first2, last2);
 
-    vector<uint_> tile_a((count1+count2+tile_size-1)/tile_size+1, queue.get_context());
-    vector<uint_> tile_b((count1+count2+tile_size-1)/tile_size+1, queue.get_context());
+    int tile_size = static_cast<int>(
+        merge_with_merge_path_tile_size(count1 + count2, queue.get_device())
+    );
+
+    scratch_vector<uint_> tile_a((count1+count2+tile_size-1)/tile_size+1, queue);
+    scratch_vector<uint_> tile_b((count1+count2+tile_size-1)/tile_size+1, queue);
 
     // Tile the sets
     merge_path_kernel tiling_kernel;
-    tiling_kernel.tile_size = 1024;
+    tiling_kernel.tile_size = tile_size;
     tiling_kernel.set_range(first1, last1, first2, last2,
                             tile_a.begin()+1, tile_b.begin()+1, comp);
-    fill_n(tile_a.begin(), 1, 0, queue);
-    fill_n(tile_b.begin(), 1, 0, queue);
+    fill_batch first_tiles;
+    first_tiles.add(tile_a.begin(), tile_a.begin()+1, 0);
+    first_tiles.add(tile_b.begin(), tile_b.begin()+1, 0);
+    first_tiles.enqueue(queue);
     tiling_kernel.exec(queue);
 
-    fill_n(tile_a.end()-1, 1, count1, queue);
-    fill_n(tile_b.end()-1, 1, count2, queue);
+    fill_batch last_tiles;
+    last_tiles.add(tile_a.end()-1, tile_a.end(), count1);
+    last_tiles.add(tile_b.end()-1, tile_b.end(), count2);
+    last_tiles.enqueue(queue);
 
     // Merge
     serial_merge_kernel merge_kernel;
-    merge_kernel.tile_size = 1024;
+    merge_kernel.tile_size = tile_size;
     merge_kernel.set_range(first1, first2, tile_a.begin(), tile_a.end(),
                             tile_b.begin(), result, comp);
 
@@ -0,0 +1,294 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_MULTI_REDUCE_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_MULTI_REDUCE_HPP
+
+#include <iterator>
+
+#include <boost/tuple/tuple.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+#include <boost/preprocessor/repetition.hpp>
+
+#include <boost/compute/config.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/detail/fused_transform_reduce.hpp>
+#include <boost/compute/functional/get.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/types/tuple.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// the accumulator of a multi-reduction, the tuple of the results of each
+// of the unary functions in the Functions tuple applied to Arg
+template<class Functions,
+         class Arg,
+         int N = boost::tuples::length<Functions>::value>
+struct multi_reduce_accumulator;
+
+#define BOOST_COMPUTE_DETAIL_MULTI_REDUCE_LANE_TYPE(z, n, unused)              \
+    typename ::boost::compute::result_of<                                      \
+        typename boost::tuples::element<n, Functions>::type(Arg)               \
+    >::type
+
+#define BOOST_COMPUTE_DETAIL_MULTI_REDUCE_ACCUMULATOR(z, n, unused)            \
+template<class Functions, class Arg>                                           \
+struct multi_reduce_accumulator<Functions, Arg, n>                             \
+{                                                                              \
+    typedef boost::tuple<                                                      \
+        BOOST_PP_ENUM(n, BOOST_COMPUTE_DETAIL_MULTI_REDUCE_LANE_TYPE, ~)       \
+    > type;                                                                    \
+};
+
+BOOST_PP_REPEAT_FROM_TO(1, BOOST_COMPUTE_MAX_ARITY, BOOST_COMPUTE_DETAIL_MULTI_REDUCE_ACCUMULATOR, ~)
+
+#undef BOOST_COMPUTE_DETAIL_MULTI_REDUCE_ACCUMULATOR
+#undef BOOST_COMPUTE_DETAIL_MULTI_REDUCE_LANE_TYPE
+
+// emits the comma separated fields I to N of an accumulator
+template<int I, int N>
+struct multi_reduce_lanes
+{
+    // the fields of the accumulator of the value arg
+    template<class Functions, class Arg>
+    static void transform(meta_kernel &k,
+                          const Functions &functions,
+                          const Arg &arg)
+    {
+        k << (I > 0 ? ", " : "") << boost::tuples::get<I>(functions)(arg);
+
+        multi_reduce_lanes<I + 1, N>::transform(k, functions, arg);
+    }
+
+    // the fields of the reduction of the accumulators x and y
+    template<class Functions, class Arg1, class Arg2>
+    static void reduce(meta_kernel &k,
+                       const Functions &functions,
+                       const Arg1 &x,
+                       const Arg2 &y)
+    {
+        k << (I > 0 ? ", " : "")
+          << boost::tuples::get<I>(functions)(
+                 ::boost::compute::get<I>()(x), ::boost::compute::get<I>()(y)
+             );
+
+        multi_reduce_lanes<I + 1, N>::reduce(k, functions, x, y);
+    }
+};
+
+template<int N>
+struct multi_reduce_lanes<N, N>
+{
+    template<class Functions, class Arg>
+    static void transform(meta_kernel&, const Functions&, const Arg&)
+    {
+    }
+
+    template<class Functions, class Arg1, class Arg2>
+    static void reduce(meta_kernel&, const Functions&, const Arg1&, const Arg2&)
+    {
+    }
+};
+
+template<class Functions, class Arg, class Accumulator>
+struct invoked_multi_reduce_transform
+{
+    typedef Accumulator result_type;
+
+    invoked_multi_reduce_transform(const Functions &functions, const Arg &arg)
+        : m_functions(functions),
+          m_arg(arg)
+    {
+    }
+
+    Functions m_functions;
+    Arg m_arg;
+};
+
+template<class Functions, class Arg, class Accumulator>
+inline meta_kernel&
+operator<<(meta_kernel &k,
+           const invoked_multi_reduce_transform<Functions, Arg, Accumulator> &expr)
+{
+    k.inject_type<Accumulator>();
+
+    k << "((" << type_name<Accumulator>() << "){";
+    multi_reduce_lanes<0, boost::tuples::length<Functions>::value>::transform(
+        k, expr.m_functions, expr.m_arg
+    );
+    return k << "})";
+}
+
+// unary function returning the accumulator with the results of each of the
+// functions applied to its argument. the argument expression is repeated
+// for each function, which is only a single load for the buffer iterators
+// the fused reduction reads its values from.
+template<class Functions>
+class multi_reduce_transform
+{
+public:
+    template<class Signature>
+    struct result;
+
+    template<class F, class Arg>
+    struct result<F(Arg)>
+    {
+        typedef typename multi_reduce_accumulator<
+            Functions, typename boost::remove_cv<Arg>::type
+        >::type type;
+    };
+
+    explicit multi_reduce_transform(const Functions &functions)
+        : m_functions(functions)
+    {
+    }
+
+    template<class Arg>
+    invoked_multi_reduce_transform<
+        Functions,
+        Arg,
+        typename multi_reduce_accumulator<
+            Functions, typename boost::remove_cv<typename Arg::result_type>::type
+        >::type
+    >
+    operator()(const Arg &arg) const
+    {
+        typedef typename multi_reduce_accumulator<
+            Functions, typename boost::remove_cv<typename Arg::result_type>::type
+        >::type accumulator_type;
+
+        return invoked_multi_reduce_transform<
+                   Functions, Arg, accumulator_type
+               >(m_functions, arg);
+    }
+
+private:
+    Functions m_functions;
+};
+
+template<class Functions, class Arg1, class Arg2>
+struct invoked_multi_reduce_function
+{
+    typedef typename boost::remove_cv<typename Arg1::result_type>::type result_type;
+
+    invoked_multi_reduce_function(const Functions &functions,
+                                  const Arg1 &arg1,
+                                  const Arg2 &arg2)
+        : m_functions(functions),
+          m_arg1(arg1),
+          m_arg2(arg2)
+    {
+    }
+
+    Functions m_functions;
+    Arg1 m_arg1;
+    Arg2 m_arg2;
+};
+
+template<class Functions, class Arg1, class Arg2>
+inline meta_kernel&
+operator<<(meta_kernel &k,
+           const invoked_multi_reduce_function<Functions, Arg1, Arg2> &expr)
+{
+    typedef typename
+        invoked_multi_reduce_function<Functions, Arg1, Arg2>::result_type
+        accumulator_type;
+
+    k.inject_type<accumulator_type>();
+
+    k << "((" << type_name<accumulator_type>() << "){";
+    multi_reduce_lanes<0, boost::tuples::length<Functions>::value>::reduce(
+        k, expr.m_functions, expr.m_arg1, expr.m_arg2
+    );
+    return k << "})";
+}
+
+// binary function reducing two accumulators field by field, each of the
+// fields with the function at the same position of the Functions tuple
+template<class Functions>
+class multi_reduce_function
+{
+public:
+    template<class Signature>
+    struct result;
+
+    template<class F, class Arg1, class Arg2>
+    struct result<F(Arg1, Arg2)>
+    {
+        typedef typename boost::remove_cv<Arg1>::type type;
+    };
+
+    explicit multi_reduce_function(const Functions &functions)
+        : m_functions(functions)
+    {
+    }
+
+    template<class Arg1, class Arg2>
+    invoked_multi_reduce_function<Functions, Arg1, Arg2>
+    operator()(const Arg1 &arg1, const Arg2 &arg2) const
+    {
+        return invoked_multi_reduce_function<Functions, Arg1, Arg2>(
+            m_functions, arg1, arg2
+        );
+    }
+
+private:
+    Functions m_functions;
+};
+
+// reduces the values of [first, last) with several reductions at once. the
+// j-th field of result is the reduction with the j-th function of reductions
+// of the values transformed with the j-th function of transforms. the input
+// is read once by the fused reduction whose accumulator is the tuple of the
+// partial results.
+template<class InputIterator,
+         class OutputIterator,
+         class Transforms,
+         class Reductions>
+inline void multi_transform_reduce(InputIterator first,
+                                   InputIterator last,
+                                   OutputIterator result,
+                                   const Transforms &transforms,
+                                   const Reductions &reductions,
+                                   command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        multi_reduce_accumulator<Transforms, value_type>::type accumulator_type;
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    scratch_vector<accumulator_type> value(1, queue);
+    fused_transform_reduce(
+        first,
+        count,
+        multi_reduce_transform<Transforms>(transforms),
+        multi_reduce_function<Reductions>(reductions),
+        value.begin(),
+        queue
+    );
+    ::boost::compute::copy_n(value.begin(), 1, result, queue);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_MULTI_REDUCE_HPP
@@ -0,0 +1,103 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_PARALLEL_HOST_SORT_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_PARALLEL_HOST_SORT_HPP
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+
+#include <boost/compute/config.hpp>
+#include <boost/compute/async/thread_pool.hpp>
+#include <boost/compute/detail/mutex.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+template<class Iterator, class Compare>
+inline void host_sort_range(Iterator first, Iterator last, Compare compare)
+{
+    std::sort(first, last, compare);
+}
+
+template<class Iterator, class Compare>
+inline void host_merge_ranges(Iterator first,
+                              Iterator middle,
+                              Iterator last,
+                              Compare compare)
+{
+    std::inplace_merge(first, middle, last, compare);
+}
+
+// sorts the host range [first, last) with compare. when thread-safety is
+// enabled the range is split into one chunk per hardware thread, which
+// are sorted concurrently and then merged pairwise (also concurrently).
+template<class Iterator, class Compare>
+inline void parallel_host_sort(Iterator first, Iterator last, Compare compare)
+{
+    typedef typename std::iterator_traits<Iterator>::difference_type difference_type;
+
+    const size_t count = static_cast<size_t>(std::distance(first, last));
+
+    // chunks smaller than this are not worth a thread
+    const size_t min_chunk_size = 4096;
+
+    size_t chunk_count = 1;
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+    chunk_count = (std::min)(
+        size_t(thread::hardware_concurrency()), count / min_chunk_size
+    );
+    #endif // BOOST_COMPUTE_THREAD_SAFE
+    (void) min_chunk_size;
+
+    if(chunk_count < 2){
+        std::sort(first, last, compare);
+        return;
+    }
+
+    std::vector<Iterator> bounds(chunk_count + 1);
+    for(size_t i = 0; i <= chunk_count; i++){
+        bounds[i] = first + static_cast<difference_type>(count * i / chunk_count);
+    }
+
+    std::vector<boost::function<void()> > tasks;
+    for(size_t i = 0; i < chunk_count; i++){
+        tasks.push_back(
+            boost::bind(&host_sort_range<Iterator, Compare>,
+                        bounds[i], bounds[i + 1], compare)
+        );
+    }
+    invoke_concurrently(tasks, chunk_count);
+
+    for(size_t width = 1; width < chunk_count; width *= 2){
+        tasks.clear();
+        for(size_t i = 0; i + width < chunk_count; i += 2 * width){
+            tasks.push_back(
+                boost::bind(&host_merge_ranges<Iterator, Compare>,
+                            bounds[i],
+                            bounds[i + width],
+                            bounds[(std::min)(i + 2 * width, chunk_count)],
+                            compare)
+            );
+        }
+        invoke_concurrently(tasks, tasks.size());
+    }
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_PARALLEL_HOST_SORT_HPP
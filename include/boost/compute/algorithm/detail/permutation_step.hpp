@@ -0,0 +1,147 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_PERMUTATION_STEP_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_PERMUTATION_STEP_HPP
+
+#include <iterator>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/reverse.hpp>
+#include <boost/compute/algorithm/detail/find_with_early_exit.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// emits code which sets "match" to true if the value at position "i" is
+// less (or, for the previous permutation, greater) than the next value
+template<class InputIterator>
+class permutation_pivot_matcher
+{
+public:
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    permutation_pivot_matcher(InputIterator first, bool next)
+        : m_first(first),
+          m_next(next)
+    {
+    }
+
+    void operator()(meta_kernel &k) const
+    {
+        k << k.decl<const value_type>("value") << " = "
+          <<     m_first[k.var<const uint_>("i")] << ";\n"
+          << k.decl<const value_type>("next_value") << " = "
+          <<     m_first[k.expr<const uint_>("i+1")] << ";\n"
+          << "match = " << (m_next ? "value < next_value" : "value > next_value")
+          << ";\n";
+    }
+
+private:
+    InputIterator m_first;
+    bool m_next;
+};
+
+// emits code which sets "match" to true if the value at position "i" of
+// the suffix after the pivot is greater (or less) than the pivot value
+template<class InputIterator>
+class permutation_swap_matcher
+{
+public:
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    permutation_swap_matcher(InputIterator first, size_t pivot, bool next)
+        : m_first(first),
+          m_pivot(pivot),
+          m_next(next)
+    {
+    }
+
+    void operator()(meta_kernel &k) const
+    {
+        k.add_set_arg<const uint_>("pivot", static_cast<uint_>(m_pivot));
+
+        k << k.decl<const value_type>("value") << " = "
+          <<     m_first[k.expr<const uint_>("pivot+1+i")] << ";\n"
+          << k.decl<const value_type>("pivot_value") << " = "
+          <<     m_first[k.var<const uint_>("pivot")] << ";\n"
+          << "match = " << (m_next ? "value > pivot_value" : "value < pivot_value")
+          << ";\n";
+    }
+
+private:
+    InputIterator m_first;
+    size_t m_pivot;
+    bool m_next;
+};
+
+// transforms [first, last) into the next (or previous) permutation and
+// returns false if it wrapped around to the first (or last) one.
+//
+// the pivot is the last position whose value is less (greater) than the
+// next value and it is swapped with the last value after it which is
+// greater (less) than it, both found with a reverse early-exit search so
+// the work done is bounded by the length of the suffix which changes
+// (usually a few values) instead of by the size of the range. only the two
+// positions are read on the host.
+template<class InputIterator>
+inline bool permutation_step(InputIterator first,
+                             InputIterator last,
+                             bool next,
+                             command_queue &queue)
+{
+    const size_t count = iterator_range_size(first, last);
+    if(count < 2){
+        return false;
+    }
+
+    const size_t pivot = find_with_early_exit(
+        count - 1, permutation_pivot_matcher<InputIterator>(first, next), true, queue
+    );
+    if(pivot == count - 1){
+        // last (or first) permutation, wrap around
+        ::boost::compute::reverse(first, last, queue);
+        return false;
+    }
+
+    const size_t swap = pivot + 1 + find_with_early_exit(
+        count - pivot - 1,
+        permutation_swap_matcher<InputIterator>(first, pivot, next),
+        true,
+        queue
+    );
+
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    meta_kernel k("permutation_swap");
+    k.add_set_arg<const uint_>("a", static_cast<uint_>(pivot));
+    k.add_set_arg<const uint_>("b", static_cast<uint_>(swap));
+    k << k.decl<const value_type>("tmp") << " = "
+      <<     first[k.var<const uint_>("a")] << ";\n"
+      << first[k.var<const uint_>("a")] << " = "
+      <<     first[k.var<const uint_>("b")] << ";\n"
+      << first[k.var<const uint_>("b")] << " = tmp;\n";
+    k.exec_1d(queue, 0, 1, 1);
+
+    ::boost::compute::reverse(
+        first + static_cast<std::ptrdiff_t>(pivot + 1), last, queue
+    );
+
+    return true;
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_PERMUTATION_STEP_HPP
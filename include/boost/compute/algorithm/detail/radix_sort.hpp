@@ -11,21 +11,41 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_RADIX_SORT_HPP
 #define BOOST_COMPUTE_ALGORITHM_DETAIL_RADIX_SORT_HPP
 
+#include <vector>
+#include <cstring>
+#include <utility>
+#include <algorithm>
 #include <iterator>
 
 #include <boost/assert.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/not.hpp>
+#include <boost/mpl/or.hpp>
 #include <boost/type_traits/is_signed.hpp>
 #include <boost/type_traits/is_floating_point.hpp>
 
 #include <boost/compute/kernel.hpp>
 #include <boost/compute/program.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/reverse.hpp>
+#include <boost/compute/algorithm/detail/local_histogram.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/kernel_cache.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/index_type.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/detail/scratch_memory.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
 #include <boost/compute/type_traits/is_fundamental.hpp>
 #include <boost/compute/type_traits/is_vector_type.hpp>
 #include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/types/half.hpp>
 #include <boost/compute/utility/program_cache.hpp>
 
 namespace boost {
@@ -35,9 +55,12 @@ namespace detail {
 // meta-function returning true if type T is radix-sortable
 template<class T>
 struct is_radix_sortable :
-    boost::mpl::and_<
-        typename ::boost::compute::is_fundamental<T>::type,
-        typename boost::mpl::not_<typename is_vector_type<T>::type>::type
+    boost::mpl::or_<
+        boost::mpl::and_<
+            typename ::boost::compute::is_fundamental<T>::type,
+            typename boost::mpl::not_<typename is_vector_type<T>::type>::type
+        >,
+        is_half_type<T>
     >
 {
 };
@@ -91,93 +114,147 @@ const char radix_sort_source[] =
 "#define RADIX_MASK ((((T)(1)) << K_BITS) - 1)\n"
 "#define SIGN_BIT ((sizeof(T) * CHAR_BIT) - 1)\n"
 
-"inline uint radix(const T x, const uint low_bit)\n"
+"inline T radix_key(const T x)\n"
 "{\n"
 "#if defined(IS_FLOATING_POINT)\n"
 "    const T mask = -(x >> SIGN_BIT) | (((T)(1)) << SIGN_BIT);\n"
-"    return ((x ^ mask) >> low_bit) & RADIX_MASK;\n"
+"    return x ^ mask;\n"
 "#elif defined(IS_SIGNED)\n"
-"    return ((x ^ (((T)(1)) << SIGN_BIT)) >> low_bit) & RADIX_MASK;\n"
+"    return x ^ (((T)(1)) << SIGN_BIT);\n"
 "#else\n"
-"    return (x >> low_bit) & RADIX_MASK;\n"
+"    return x;\n"
 "#endif\n"
 "}\n"
 
-"__kernel void count(__global const T *input,\n"
-"                    const uint input_offset,\n"
-"                    const uint input_size,\n"
-"                    __global uint *global_counts,\n"
-"                    __global uint *global_offsets,\n"
-"                    __local uint *local_counts,\n"
-"                    const uint low_bit)\n"
+"inline uint radix(const T x, const uint low_bit)\n"
+"{\n"
+"    return (radix_key(x) >> low_bit) & RADIX_MASK;\n"
+"}\n"
+
+     // computes the bits which differ between the keys in each block of
+     // the input and the first key
+"__kernel __attribute__((reqd_work_group_size(BLOCK_SIZE, 1, 1)))\n"
+"void diff_bits(__global const T * restrict input,\n"
+"               const INDEX_T input_offset,\n"
+"               const INDEX_T input_size,\n"
+"               __global T * restrict output)\n"
 "{\n"
-     // work-item parameters
-"    const uint gid = get_global_id(0);\n"
 "    const uint lid = get_local_id(0);\n"
+"    const T first = radix_key(input[input_offset]);\n"
+"    __local T local_bits[BLOCK_SIZE];\n"
 
-     // zero local counts
-"    if(lid < K2_BITS){\n"
-"        local_counts[lid] = 0;\n"
+"    T bits = 0;\n"
+"    for(INDEX_T i = get_global_id(0); i < input_size; i += get_global_size(0)){\n"
+"        bits |= radix_key(input[input_offset+i]) ^ first;\n"
 "    }\n"
+"    local_bits[lid] = bits;\n"
 "    barrier(CLK_LOCAL_MEM_FENCE);\n"
 
-     // reduce local counts
-"    if(gid < input_size){\n"
-"        T value = input[input_offset+gid];\n"
-"        uint bucket = radix(value, low_bit);\n"
-"        atomic_inc(local_counts + bucket);\n"
+"    if(lid == 0){\n"
+"        for(uint i = 1; i < BLOCK_SIZE; i++){\n"
+"            bits |= local_bits[i];\n"
+"        }\n"
+"        output[get_group_id(0)] = bits;\n"
 "    }\n"
-"    barrier(CLK_LOCAL_MEM_FENCE);\n"
-
-     // write block-relative offsets
-"    if(lid < K2_BITS){\n"
-"        global_counts[K2_BITS*get_group_id(0) + lid] = local_counts[lid];\n"
+"}\n"
 
-         // write global offsets
-"        if(get_group_id(0) == (get_num_groups(0) - 1)){\n"
-"            global_offsets[lid] = local_counts[lid];\n"
-"        }\n"
+     // combines the bits of the blocks written by diff_bits() into the
+     // first one, which the passes read to find the constant digits
+"__kernel void combine_diff_bits(__global T *bits, const uint count)\n"
+"{\n"
+"    T combined = 0;\n"
+"    for(uint i = 0; i < count; i++){\n"
+"        combined |= bits[i];\n"
 "    }\n"
+"    bits[0] = combined;\n"
 "}\n"
 
-"__kernel void scan(__global const uint *block_offsets,\n"
-"                   __global uint *global_offsets,\n"
-"                   const uint block_count)\n"
+"inline bool is_constant_digit(__global const T *diff_bits, const uint low_bit)\n"
 "{\n"
-"    __global const uint *last_block_offsets =\n"
-"        block_offsets + K2_BITS * (block_count - 1);\n"
-
-     // calculate and scan global_offsets
-"    uint sum = 0;\n"
-"    for(uint i = 0; i < K2_BITS; i++){\n"
-"        uint x = global_offsets[i] + last_block_offsets[i];\n"
-"        global_offsets[i] = sum;\n"
-"        sum += x;\n"
+"    return ((diff_bits[0] >> low_bit) & RADIX_MASK) == 0;\n"
+"}\n"
+
+"__kernel __attribute__((reqd_work_group_size(BLOCK_SIZE, 1, 1)))\n"
+"void count(__global const T * restrict input,\n"
+"           const INDEX_T input_offset,\n"
+"           const INDEX_T input_size,\n"
+"           __global INDEX_T * restrict global_counts,\n"
+"           __local uint *local_counts,\n"
+"           const uint low_bit,\n"
+"           __global const T *diff_bits)\n"
+"{\n"
+     // the digit is the same in all keys, the scatter copies them
+"    if(is_constant_digit(diff_bits, low_bit)){\n"
+"        return;\n"
+"    }\n"
+     // work-item parameters
+"    const INDEX_T gid = get_global_id(0);\n"
+"    const uint lid = get_local_id(0);\n"
+
+     // count the digits of the block in local memory
+"    local_histogram_clear(local_counts, K2_BITS);\n"
+"    if(gid < input_size){\n"
+"        T value = input[input_offset+gid];\n"
+"        uint bucket = radix(value, low_bit);\n"
+"        local_histogram_add(local_counts, bucket);\n"
+"    }\n"
+"    barrier(CLK_LOCAL_MEM_FENCE);\n"
+
+     // write counts in bucket-major order so that an exclusive scan of
+     // the counts gives the output offset of each bucket in each block
+"    for(uint i = lid; i < K2_BITS; i += BLOCK_SIZE){\n"
+"        global_counts[(INDEX_T) i * get_num_groups(0) + get_group_id(0)] = local_counts[i];\n"
 "    }\n"
 "}\n"
 
-"__kernel void scatter(__global const T *input,\n"
-"                      const uint input_offset,\n"
-"                      const uint input_size,\n"
-"                      const uint low_bit,\n"
-"                      __global const uint *counts,\n"
-"                      __global const uint *global_offsets,\n"
+"__kernel __attribute__((reqd_work_group_size(BLOCK_SIZE, 1, 1)))\n"
+"void scatter(__global const T * restrict input,\n"
+"             const INDEX_T input_offset,\n"
+"             const INDEX_T input_size,\n"
+"             const uint low_bit,\n"
+"             __global const T *diff_bits,\n"
+"             __global const INDEX_T * restrict offsets,\n"
 "#ifndef SORT_BY_KEY\n"
-"                      __global T *output,\n"
-"                      const uint output_offset)\n"
+"             __global T * restrict output,\n"
+"             const INDEX_T output_offset)\n"
+"#else\n"
+"             __global T * restrict keys_output,\n"
+"             const INDEX_T keys_output_offset,\n"
+"             __global T2 * restrict values_input,\n"
+"             const INDEX_T values_input_offset,\n"
+"             __global T2 * restrict values_output,\n"
+"#ifndef SORT_INDICES\n"
+"             const INDEX_T values_output_offset)\n"
 "#else\n"
-"                      __global T *keys_output,\n"
-"                      const uint keys_output_offset,\n"
-"                      __global T2 *values_input,\n"
-"                      const uint values_input_offset,\n"
-"                      __global T2 *values_output,\n"
-"                      const uint values_output_offset)\n"
+"             const INDEX_T values_output_offset,\n"
+"             const uint first_pass)\n"
+"#endif\n"
 "#endif\n"
 "{\n"
      // work-item parameters
-"    const uint gid = get_global_id(0);\n"
+"    const INDEX_T gid = get_global_id(0);\n"
 "    const uint lid = get_local_id(0);\n"
 
+     // the digit is the same in all keys, so the stable order is the
+     // current one and the values are copied as they are
+"    if(is_constant_digit(diff_bits, low_bit)){\n"
+"        if(gid < input_size){\n"
+"#ifndef SORT_BY_KEY\n"
+"            output[output_offset+gid] = input[input_offset+gid];\n"
+"#else\n"
+"            keys_output[keys_output_offset+gid] = input[input_offset+gid];\n"
+"#ifndef SORT_INDICES\n"
+"            values_output[values_output_offset+gid] =\n"
+"                values_input[values_input_offset+gid];\n"
+"#else\n"
+"            values_output[values_output_offset+gid] =\n"
+"                first_pass ? gid : values_input[values_input_offset+gid];\n"
+"#endif\n"
+"#endif\n"
+"        }\n"
+"        return;\n"
+"    }\n"
+
      // copy input to local memory
 "    T value;\n"
 "    uint bucket;\n"
@@ -186,12 +263,6 @@ const char radix_sort_source[] =
 "        value = input[input_offset+gid];\n"
 "        bucket = radix(value, low_bit);\n"
 "        local_input[lid] = bucket;\n"
-"    }\n"
-
-     // copy block counts to local memory
-"    __local uint local_counts[(1 << K_BITS)];\n"
-"    if(lid < K2_BITS){\n"
-"        local_counts[lid] = counts[get_group_id(0) * K2_BITS + lid];\n"
 "    }\n"
 
      // wait until local memory is ready
@@ -202,7 +273,7 @@ const char radix_sort_source[] =
 "    }\n"
 
      // get global offset
-"    uint offset = global_offsets[bucket] + local_counts[bucket];\n"
+"    INDEX_T offset = offsets[(INDEX_T) bucket * get_num_groups(0) + get_group_id(0)];\n"
 
      // calculate local offset
 "    uint local_offset = 0;\n"
@@ -217,16 +288,141 @@ const char radix_sort_source[] =
 "#else\n"
      // write key and value if doing sort_by_key
 "    keys_output[keys_output_offset+offset + local_offset] = value;\n"
+"#ifndef SORT_INDICES\n"
 "    values_output[values_output_offset+offset + local_offset] =\n"
 "        values_input[values_input_offset+gid];\n"
+"#else\n"
+     // the first pass writes the indices of the keys instead of
+     // reading them
+"    values_output[values_output_offset+offset + local_offset] =\n"
+"        first_pass ? gid : values_input[values_input_offset+gid];\n"
+"#endif\n"
 "#endif\n"
 "}\n";
 
+// parameters for the radix sort algorithm
+struct radix_sort_parameters
+{
+    // number of bits sorted in each pass (at most 8)
+    uint_ k;
+
+    // number of elements processed by each work-group
+    uint_ block_size;
+};
+
+// returns the radix sort parameters for keys of type T on the queue's
+// device. the defaults sort 8-bit digits on GPUs with enough local memory
+// for the larger histograms (halving the number of passes compared to
+// 4-bit digits) and use wider blocks on CPUs, which reduces the number of
+// work-groups and the size of the counts to scan.
+//
+// the parameters can be overridden through the global parameter_cache
+// for the device with the object name "__boost_radix_sort_" followed by
+// the type name (e.g. "__boost_radix_sort_uint") and the parameters "k"
+// and "block_size".
+template<class T>
+inline radix_sort_parameters get_radix_sort_parameters(command_queue &queue)
+{
+    const device &device = queue.get_device();
+
+    radix_sort_parameters params;
+    params.k = 4;
+    params.block_size = 128;
+
+    const boost::shared_ptr<device_profile> profile = device_profile::get(device);
+    if(profile->has_local_memory()){
+        if(sizeof(T) >= 4 && profile->local_memory_size() >= 16 * 1024){
+            params.k = 8;
+            params.block_size = 256;
+        }
+    }
+    else {
+        params.block_size = 256;
+    }
+
+    const std::string object =
+        std::string("__boost_radix_sort_") + type_name<T>();
+
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(device);
+
+    params.k = parameters->get(object, "k", params.k);
+    params.block_size = parameters->get(object, "block_size", params.block_size);
+
+    // digits are at most 8 bits wide and the block size must be
+    // supported by the device
+    params.k = (std::max)(uint_(1), (std::min)(params.k, uint_(8)));
+    params.block_size = static_cast<uint_>(
+        (std::min)(size_t(params.block_size), device.max_work_group_size())
+    );
+
+    return params;
+}
+
+// writes the identity permutation to the indices of radix_sort_indices()
+// when all of the keys are equal. only indices of type uint_ are sorted.
+template<class T2>
+inline void radix_sort_write_indices(const buffer_iterator<T2>,
+                                     size_t,
+                                     command_queue &)
+{
+}
+
+inline void radix_sort_write_indices(const buffer_iterator<uint_> indices,
+                                     size_t count,
+                                     command_queue &queue)
+{
+    ::boost::compute::iota(indices, indices + count, uint_(0), queue);
+}
+
+// minimum number of values for which the radix sort checks which digits
+// differ between the keys. blocking sorts read the bits back and skip the
+// passes over constant digits, asynchronous sorts keep them on the device
+// and such passes only copy the keys (the counts are still scanned).
+static const size_t radix_sort_skip_digits_threshold = 65536;
+
+// returns the size in bytes of the temporary buffers used by radix_sort()
+// for count keys of type T (and values of type T2 for sort_by_key)
 template<class T, class T2>
+inline size_t radix_sort_scratch_size(size_t count,
+                                      bool sort_by_key,
+                                      command_queue &queue)
+{
+    typedef typename radix_sort_value_type<sizeof(T)>::type sort_type;
+
+    if(count == 0){
+        return 0;
+    }
+
+    const radix_sort_parameters params = get_radix_sort_parameters<T>(queue);
+    const size_t k2 = size_t(1) << params.k;
+    const size_t block_count = (count + params.block_size - 1) / params.block_size;
+    const size_t index_size =
+        requires_64bit_indices(count) ? sizeof(ulong_) : sizeof(uint_);
+    const size_t diff_bits_count =
+        count >= radix_sort_skip_digits_threshold ? 64 : 1;
+
+    return buffer_pool::size_class(diff_bits_count * sizeof(sort_type)) +
+           buffer_pool::size_class(count * sizeof(T)) +
+           buffer_pool::size_class(sort_by_key ? count * sizeof(T2) : 0) +
+           buffer_pool::size_class(block_count * k2 * index_size);
+}
+
+// sorts the range [first, last) by bits [begin_bit, end_bit) of the keys
+// (after flipping sign bits so that unsigned comparison orders them).
+//
+// the offsets and counts are Index values, which is uint_ unless the
+// ranges extend past 32-bit indices (see the overload below).
+template<class T, class T2, class Index>
 inline void radix_sort_impl(const buffer_iterator<T> first,
                             const buffer_iterator<T> last,
                             const buffer_iterator<T2> values_first,
-                            command_queue &queue)
+                            uint_ begin_bit,
+                            uint_ end_bit,
+                            command_queue &queue,
+                            bool sort_indices,
+                            bool blocking,
+                            Index)
 {
 
     typedef T value_type;
@@ -236,10 +432,16 @@ inline void radix_sort_impl(const buffer_iterator<T> first,
 
     size_t count = detail::iterator_range_size(first, last);
 
+    end_bit = (std::min)(end_bit, static_cast<uint_>(sizeof(sort_type) * CHAR_BIT));
+    if(count == 0 || begin_bit >= end_bit){
+        return;
+    }
+
     // sort parameters
-    const uint_ k = 4;
+    const radix_sort_parameters params = get_radix_sort_parameters<value_type>(queue);
+    const uint_ k = params.k;
     const uint_ k2 = 1 << k;
-    const uint_ block_size = 128;
+    const uint_ block_size = params.block_size;
 
     uint_ block_count = static_cast<uint_>(count / block_size);
     if(block_count * block_size != count){
@@ -257,13 +459,20 @@ inline void radix_sort_impl(const buffer_iterator<T> first,
     if(sort_by_key){
         cache_key += std::string("_with_") + type_name<T2>();
     }
+    if(sort_indices){
+        cache_key += "_indices";
+    }
+    if(sizeof(Index) != sizeof(uint_)){
+        cache_key += "_64";
+    }
 
     std::stringstream options;
     options << "-DK_BITS=" << k;
     options << " -DT=" << type_name<sort_type>();
     options << " -DBLOCK_SIZE=" << block_size;
+    options << " -DINDEX_T=" << type_name<Index>();
 
-    if(boost::is_floating_point<value_type>::value){
+    if(boost::is_floating_point<value_type>::value || is_half_type<value_type>::value){
         options << " -DIS_FLOATING_POINT";
     }
 
@@ -273,96 +482,111 @@ inline void radix_sort_impl(const buffer_iterator<T> first,
 
     if(sort_by_key){
         options << " -DSORT_BY_KEY";
-        options << " -DT2=" << type_name<T2>();
+        // half-precision values are only moved, as their bits
+        options << " -DT2=" << (is_half_type<T2>::value ? "ushort" : type_name<T2>());
         options << enable_double<T2>();
     }
 
+    if(sort_indices){
+        options << " -DSORT_INDICES";
+    }
+
     // load (or create) radix sort program
     boost::shared_ptr<program_cache> cache =
         program_cache::get_global_cache(context);
 
-    program radix_sort_program =
-        cache->get_or_build(cache_key, options.str(), radix_sort_source, context);
-
-    kernel count_kernel(radix_sort_program, "count");
-    kernel scan_kernel(radix_sort_program, "scan");
-    kernel scatter_kernel(radix_sort_program, "scatter");
+    program radix_sort_program = cache->get_or_build(
+        cache_key,
+        options.str(),
+        std::string(local_histogram_source) + radix_sort_source,
+        context
+    );
+
+    kernel count_kernel = get_cached_kernel(radix_sort_program, "count");
+    kernel scatter_kernel = get_cached_kernel(radix_sort_program, "scatter");
+
+    // for large inputs find the bits which differ between any of the keys
+    // so that the passes over digits which are the same in all keys (e.g.
+    // the high bits of small integer keys) are skipped. the count and
+    // scatter kernels read the bits on the device, where such passes only
+    // copy the keys, so asynchronous sorts do not wait for them.
+    const bool find_digits = count >= radix_sort_skip_digits_threshold;
+    scratch_vector<sort_type> diff_bits(find_digits ? 64 : 1, queue);
+    if(find_digits){
+        const uint_ groups = static_cast<uint_>(diff_bits.size());
+
+        kernel diff_kernel = get_cached_kernel(radix_sort_program, "diff_bits");
+        diff_kernel.set_arg(0, first.get_buffer());
+        diff_kernel.set_arg(1, static_cast<Index>(first.get_index()));
+        diff_kernel.set_arg(2, static_cast<Index>(count));
+        diff_kernel.set_arg(3, diff_bits.get_buffer());
+        queue.enqueue_1d_range_kernel(diff_kernel, 0, groups * block_size, block_size);
+
+        kernel combine_kernel =
+            get_cached_kernel(radix_sort_program, "combine_diff_bits");
+        combine_kernel.set_arg(0, diff_bits.get_buffer());
+        combine_kernel.set_arg(1, groups);
+        queue.enqueue_task(combine_kernel);
+    }
+    else {
+        ::boost::compute::fill_n(diff_bits.begin(), 1, ~sort_type(0), queue);
+    }
 
     // setup temporary buffers
-    vector<value_type> output(count, context);
-    vector<T2> values_output(sort_by_key ? count : 0, context);
-    vector<uint_> offsets(k2, context);
-    vector<uint_> counts(block_count * k2, context);
+    scratch_vector<value_type> output(count, queue);
+    scratch_vector<T2> values_output(sort_by_key ? count : 0, queue);
+    scratch_vector<Index> counts(block_count * k2, queue);
+
+    // blocking sorts wait for the bits (computed while the temporary
+    // buffers were allocated) and leave out the passes over the constant
+    // digits entirely
+    sort_type digits = ~sort_type(0);
+    if(find_digits && blocking){
+        digits = read_single_value<sort_type>(diff_bits.get_buffer(), 0, queue);
+    }
 
     const buffer *input_buffer = &first.get_buffer();
-    uint_ input_offset = first.get_index();
+    Index input_offset = static_cast<Index>(first.get_index());
     const buffer *output_buffer = &output.get_buffer();
-    uint_ output_offset = 0;
+    Index output_offset = 0;
     const buffer *values_input_buffer = &values_first.get_buffer();
-    uint_ values_input_offset = values_first.get_index();
+    Index values_input_offset = static_cast<Index>(values_first.get_index());
     const buffer *values_output_buffer = &values_output.get_buffer();
-    uint_ values_output_offset = 0;
+    Index values_output_offset = 0;
+
+    uint_ passes = 0;
+    for(uint_ low_bit = begin_bit; low_bit < end_bit; low_bit += k){
+        if(((digits >> low_bit) & sort_type(k2 - 1)) == 0){
+            continue;
+        }
+
+        passes++;
 
-    for(uint_ i = 0; i < sizeof(sort_type) * CHAR_BIT / k; i++){
         // write counts
         count_kernel.set_arg(0, *input_buffer);
         count_kernel.set_arg(1, input_offset);
-        count_kernel.set_arg(2, static_cast<uint_>(count));
+        count_kernel.set_arg(2, static_cast<Index>(count));
         count_kernel.set_arg(3, counts);
-        count_kernel.set_arg(4, offsets);
-        count_kernel.set_arg(5, block_size * sizeof(uint_), 0);
-        count_kernel.set_arg(6, i * k);
+        count_kernel.set_arg(4, k2 * sizeof(uint_), 0);
+        count_kernel.set_arg(5, low_bit);
+        count_kernel.set_arg(6, diff_bits.get_buffer());
         queue.enqueue_1d_range_kernel(count_kernel,
                                       0,
                                       block_count * block_size,
                                       block_size);
 
-        // scan counts
-        if(k == 1){
-            typedef uint2_ counter_type;
-            ::boost::compute::exclusive_scan(
-                make_buffer_iterator<counter_type>(counts.get_buffer(), 0),
-                make_buffer_iterator<counter_type>(counts.get_buffer(), counts.size() / 2),
-                make_buffer_iterator<counter_type>(counts.get_buffer()),
-                queue
-            );
-        }
-        else if(k == 2){
-            typedef uint4_ counter_type;
-            ::boost::compute::exclusive_scan(
-                make_buffer_iterator<counter_type>(counts.get_buffer(), 0),
-                make_buffer_iterator<counter_type>(counts.get_buffer(), counts.size() / 4),
-                make_buffer_iterator<counter_type>(counts.get_buffer()),
-                queue
-            );
-        }
-        else if(k == 4){
-            typedef uint16_ counter_type;
-            ::boost::compute::exclusive_scan(
-                make_buffer_iterator<counter_type>(counts.get_buffer(), 0),
-                make_buffer_iterator<counter_type>(counts.get_buffer(), counts.size() / 16),
-                make_buffer_iterator<counter_type>(counts.get_buffer()),
-                queue
-            );
-        }
-        else {
-            BOOST_ASSERT(false && "unknown k");
-            break;
-        }
-
-        // scan global offsets
-        scan_kernel.set_arg(0, counts);
-        scan_kernel.set_arg(1, offsets);
-        scan_kernel.set_arg(2, block_count);
-        queue.enqueue_task(scan_kernel);
+        // scan counts to get the output offsets of each bucket in each block
+        ::boost::compute::exclusive_scan(
+            counts.begin(), counts.end(), counts.begin(), queue
+        );
 
         // scatter values
         scatter_kernel.set_arg(0, *input_buffer);
         scatter_kernel.set_arg(1, input_offset);
-        scatter_kernel.set_arg(2, static_cast<uint_>(count));
-        scatter_kernel.set_arg(3, i * k);
-        scatter_kernel.set_arg(4, counts);
-        scatter_kernel.set_arg(5, offsets);
+        scatter_kernel.set_arg(2, static_cast<Index>(count));
+        scatter_kernel.set_arg(3, low_bit);
+        scatter_kernel.set_arg(4, diff_bits.get_buffer());
+        scatter_kernel.set_arg(5, counts);
         scatter_kernel.set_arg(6, *output_buffer);
         scatter_kernel.set_arg(7, output_offset);
         if(sort_by_key){
@@ -371,6 +595,9 @@ inline void radix_sort_impl(const buffer_iterator<T> first,
             scatter_kernel.set_arg(10, *values_output_buffer);
             scatter_kernel.set_arg(11, values_output_offset);
         }
+        if(sort_indices){
+            scatter_kernel.set_arg(12, uint_(passes == 1 ? 1 : 0));
+        }
         queue.enqueue_1d_range_kernel(scatter_kernel,
                                       0,
                                       block_count * block_size,
@@ -382,23 +609,314 @@ inline void radix_sort_impl(const buffer_iterator<T> first,
         std::swap(input_offset, output_offset);
         std::swap(values_input_offset, values_output_offset);
     }
+
+    // if all of the passes were skipped the keys are already sorted and
+    // the indices still have to be written
+    if(passes == 0 && sort_indices){
+        radix_sort_write_indices(values_first, count, queue);
+    }
+
+    // with an odd number of passes the sorted values are in the
+    // temporary buffers and have to be copied back
+    if(passes % 2 == 1){
+        ::boost::compute::copy(output.begin(), output.end(), first, queue);
+
+        if(sort_by_key){
+            ::boost::compute::copy(
+                values_output.begin(), values_output.end(), values_first, queue
+            );
+        }
+    }
+}
+
+// sorts with 32-bit offsets and counts unless the ranges extend past them
+template<class T, class T2>
+inline void radix_sort_impl(const buffer_iterator<T> first,
+                            const buffer_iterator<T> last,
+                            const buffer_iterator<T2> values_first,
+                            uint_ begin_bit,
+                            uint_ end_bit,
+                            command_queue &queue,
+                            bool sort_indices = false,
+                            bool blocking = true)
+{
+    const size_t count = detail::iterator_range_size(first, last);
+    const size_t end =
+        (std::max)(first.get_index(), values_first.get_index()) + count;
+
+    if(requires_64bit_indices(end)){
+        radix_sort_impl(
+            first, last, values_first, begin_bit, end_bit, queue,
+            sort_indices, blocking, ulong_()
+        );
+    }
+    else {
+        radix_sort_impl(
+            first, last, values_first, begin_bit, end_bit, queue,
+            sort_indices, blocking, uint_()
+        );
+    }
+}
+
+// minimum number of keys per chunk of the chunked radix sort, smaller
+// chunks are sorted on the host instead
+static const size_t radix_sort_min_chunk_size = 4096;
+
+// orders host keys as radix_sort_impl() orders them on the device (by
+// their bits with the sign bits flipped)
+template<class T>
+struct radix_sort_host_less
+{
+    typedef typename radix_sort_value_type<sizeof(T)>::type sort_type;
+
+    static sort_type key(const T &value)
+    {
+        sort_type bits;
+        std::memcpy(&bits, &value, sizeof(T));
+
+        const sort_type sign = sort_type(1) << (sizeof(sort_type) * CHAR_BIT - 1);
+        if(boost::is_floating_point<T>::value || is_half_type<T>::value){
+            return (bits & sign) ? sort_type(~bits) : sort_type(bits | sign);
+        }
+        else if(boost::is_signed<T>::value){
+            return sort_type(bits ^ sign);
+        }
+
+        return bits;
+    }
+
+    bool operator()(const T &a, const T &b) const
+    {
+        return key(a) < key(b);
+    }
+
+    template<class T2>
+    bool operator()(const std::pair<T, T2> &a, const std::pair<T, T2> &b) const
+    {
+        return key(a.first) < key(b.first);
+    }
+};
+
+// stably sorts the host range [first, last) whose runs of run_size values
+// are sorted already (or, if run_size is zero, which is not sorted at all)
+template<class Iterator, class Compare>
+inline void radix_sort_runs_on_host(Iterator first,
+                                    Iterator last,
+                                    size_t run_size,
+                                    Compare compare)
+{
+    const size_t count = static_cast<size_t>(std::distance(first, last));
+    if(run_size == 0){
+        std::stable_sort(first, last, compare);
+        return;
+    }
+
+    for(size_t width = run_size; width < count; width *= 2){
+        for(size_t i = 0; i + width < count; i += 2 * width){
+            std::inplace_merge(
+                first + i, first + i + width, first + (std::min)(i + 2 * width, count), compare
+            );
+        }
+    }
+}
+
+// returns the number of keys which can be radix sorted at once with the
+// available device memory: count if the whole range fits, otherwise count
+// halved until a chunk fits, or zero if such chunks would be smaller than
+// radix_sort_min_chunk_size
+template<class T, class T2>
+inline size_t radix_sort_chunk_size(size_t count,
+                                    bool sort_by_key,
+                                    command_queue &queue)
+{
+    size_t chunk = count;
+    while(!fits_scratch_memory(
+              radix_sort_scratch_size<T, T2>(chunk, sort_by_key, queue),
+              chunk * sizeof(T),
+              queue)){
+        chunk /= 2;
+        if(chunk < radix_sort_min_chunk_size){
+            return 0;
+        }
+    }
+
+    return chunk;
+}
+
+// sorts the keys [first, last) (and the values at values_first) with less
+// device memory than radix_sort_impl(). chunks of chunk keys are sorted on
+// the device one after the other and the sorted runs are read back and
+// merged on the host, or if chunk is zero all of the keys are sorted on the
+// host. the order of the keys is the same as with radix_sort_impl().
+template<class T, class T2>
+inline void radix_sort_spilled(const buffer_iterator<T> first,
+                               const buffer_iterator<T> last,
+                               const buffer_iterator<T2> values_first,
+                               size_t chunk,
+                               command_queue &queue)
+{
+    const size_t count = iterator_range_size(first, last);
+    const bool sort_by_key = (values_first.get_buffer().get() != 0);
+
+    for(size_t i = 0; chunk != 0 && i < count; i += chunk){
+        const size_t n = (std::min)(chunk, count - i);
+        if(sort_by_key){
+            radix_sort_impl(
+                first + i, first + i + n, values_first + i, 0, ~uint_(0), queue
+            );
+        }
+        else {
+            radix_sort_impl(
+                first + i, first + i + n, values_first, 0, ~uint_(0), queue
+            );
+        }
+    }
+
+    std::vector<T> keys(count);
+    ::boost::compute::copy(first, last, keys.begin(), queue);
+
+    if(!sort_by_key){
+        radix_sort_runs_on_host(
+            keys.begin(), keys.end(), chunk, radix_sort_host_less<T>()
+        );
+        ::boost::compute::copy(keys.begin(), keys.end(), first, queue);
+        return;
+    }
+
+    std::vector<T2> values(count);
+    ::boost::compute::copy(values_first, values_first + count, values.begin(), queue);
+
+    std::vector<std::pair<T, T2> > pairs(count);
+    for(size_t i = 0; i < count; i++){
+        pairs[i] = std::make_pair(keys[i], values[i]);
+    }
+    radix_sort_runs_on_host(
+        pairs.begin(), pairs.end(), chunk, radix_sort_host_less<T>()
+    );
+    for(size_t i = 0; i < count; i++){
+        keys[i] = pairs[i].first;
+        values[i] = pairs[i].second;
+    }
+
+    ::boost::compute::copy(keys.begin(), keys.end(), first, queue);
+    ::boost::compute::copy(values.begin(), values.end(), values_first, queue);
+}
+
+// sorts all bits of the keys [first, last) (and the values at
+// values_first), in chunks or on the host (see radix_sort_spilled()) if
+// the temporary buffers for the whole range do not fit into the available
+// device memory. unless blocking is false the sort waits for the bits of
+// the keys which differ to skip the passes over constant digits.
+template<class T, class T2>
+inline void radix_sort_all_bits(const buffer_iterator<T> first,
+                                const buffer_iterator<T> last,
+                                const buffer_iterator<T2> values_first,
+                                command_queue &queue,
+                                bool blocking = true)
+{
+    const size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    const bool sort_by_key = (values_first.get_buffer().get() != 0);
+    const size_t chunk = radix_sort_chunk_size<T, T2>(count, sort_by_key, queue);
+    if(chunk == count){
+        radix_sort_impl(
+            first, last, values_first, 0, ~uint_(0), queue, false, blocking
+        );
+        return;
+    }
+
+    if(chunk != 0){
+        BOOST_COMPUTE_DETAIL_TRACE_STRATEGY("radix_sort", "chunked")
+    }
+    else {
+        BOOST_COMPUTE_DETAIL_TRACE_STRATEGY("radix_sort", "host")
+    }
+    radix_sort_spilled(first, last, values_first, chunk, queue);
+}
+
+// writes to indices the permutation sorting the keys [first, last) (which
+// are sorted too). the indices are written by the first scatter pass so
+// that, unlike radix_sort_by_key() with an iota() range, no values are
+// read in that pass.
+template<class T>
+inline void radix_sort_indices(const buffer_iterator<T> first,
+                               const buffer_iterator<T> last,
+                               const buffer_iterator<uint_> indices,
+                               command_queue &queue)
+{
+    radix_sort_impl(first, last, indices, 0, ~uint_(0), queue, true);
 }
 
+// sorts the keys [first, last). if blocking is false the sort does not
+// read anything back from the device (see radix_sort_all_bits()).
 template<class Iterator>
 inline void radix_sort(Iterator first,
                        Iterator last,
+                       command_queue &queue,
+                       bool blocking = true)
+{
+    radix_sort_all_bits(first, last, buffer_iterator<int>(), queue, blocking);
+}
+
+template<class Iterator>
+inline void radix_sort(Iterator first,
+                       Iterator last,
+                       uint_ begin_bit,
+                       uint_ end_bit,
                        command_queue &queue)
 {
-    radix_sort_impl(first, last, buffer_iterator<int>(), queue);
+    radix_sort_impl(first, last, buffer_iterator<int>(), begin_bit, end_bit, queue);
+}
+
+// reverses the order of the sorted keys (for descending sorts). the
+// bits of half-precision keys are moved without converting them.
+template<class T>
+inline void radix_sort_reverse(buffer_iterator<T> first,
+                               buffer_iterator<T> last,
+                               command_queue &queue)
+{
+    ::boost::compute::reverse(first, last, queue);
+}
+
+inline void radix_sort_reverse(buffer_iterator<half_> first,
+                               buffer_iterator<half_> last,
+                               command_queue &queue)
+{
+    ::boost::compute::reverse(
+        half_bits_iterator(first), half_bits_iterator(last), queue
+    );
+}
+
+inline void radix_sort_reverse(buffer_iterator<bfloat16_> first,
+                               buffer_iterator<bfloat16_> last,
+                               command_queue &queue)
+{
+    ::boost::compute::reverse(
+        half_bits_iterator(first), half_bits_iterator(last), queue
+    );
+}
+
+template<class KeyIterator, class ValueIterator>
+inline void radix_sort_by_key(KeyIterator keys_first,
+                              KeyIterator keys_last,
+                              ValueIterator values_first,
+                              command_queue &queue)
+{
+    radix_sort_all_bits(keys_first, keys_last, values_first, queue);
 }
 
 template<class KeyIterator, class ValueIterator>
 inline void radix_sort_by_key(KeyIterator keys_first,
                               KeyIterator keys_last,
                               ValueIterator values_first,
+                              uint_ begin_bit,
+                              uint_ end_bit,
                               command_queue &queue)
 {
-    radix_sort_impl(keys_first, keys_last, values_first, queue);
+    radix_sort_impl(keys_first, keys_last, values_first, begin_bit, end_bit, queue);
 }
 
 } // end detail namespace
@@ -0,0 +1,298 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_REDUCE_MATRIX_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_REDUCE_MATRIX_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/fused_transform_reduce.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/vector_width.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// emits the reduction in local memory of the private sums of count
+// work-items (a power of two) whose local ids are lid + j * stride. the
+// work-item with position zero (lid / stride) ends with the result in
+// scratch[lid] if any of the work-items had a value.
+template<class T, class BinaryFunction>
+inline void reduce_matrix_local_tree(meta_kernel &k,
+                                     BinaryFunction function,
+                                     const std::string &position,
+                                     size_t count,
+                                     size_t stride)
+{
+    k <<
+        "scratch[lid] = sum;\n" <<
+        "scratch_has_sum[lid] = has_sum;\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(uint offset = " << uint_(count / 2) << "; offset > 0; offset >>= 1){\n" <<
+        "    const uint other = lid + offset * " << uint_(stride) << ";\n" <<
+        "    if(" << position << " < offset && scratch_has_sum[other]){\n" <<
+        "        if(scratch_has_sum[lid]){\n" <<
+        "            scratch[lid] = " <<
+                         function(k.var<T>("scratch[lid]"),
+                                  k.var<T>("scratch[other]")) << ";\n" <<
+        "        }\n" <<
+        "        else {\n" <<
+        "            scratch[lid] = scratch[other];\n" <<
+        "            scratch_has_sum[lid] = 1;\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n";
+}
+
+// returns the largest power of two not greater than x (or one)
+inline size_t reduce_matrix_floor_pow2(size_t x)
+{
+    size_t power = 1;
+    while(power * 2 <= x){
+        power *= 2;
+    }
+    return power;
+}
+
+// reduces each of the rows of the matrix whose value (i, j) is
+// first[i * row_stride + j * column_stride] with one work-group per row.
+// contiguous rows of scalars are read with vloadn() when their size and
+// stride are multiples of the vector width.
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void reduce_matrix_rows(InputIterator first,
+                               size_t rows,
+                               size_t columns,
+                               size_t row_stride,
+                               size_t column_stride,
+                               OutputIterator result,
+                               BinaryFunction function,
+                               command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        boost::compute::result_of<BinaryFunction(value_type, value_type)>::type T;
+
+    const device &device = queue.get_device();
+
+    uint_ width = fused_transform_reduce_vector_width(first, device);
+    if(column_stride != 1 || columns % width != 0 || row_stride % width != 0){
+        width = 1;
+    }
+
+    // no more work-items than (vectors of) values in a row
+    size_t work_group_size = fused_transform_reduce_work_group_size<T>(queue);
+    while(work_group_size > 1 && work_group_size / 2 >= columns / width){
+        work_group_size /= 2;
+    }
+
+    meta_kernel k("reduce_rows");
+    size_t columns_arg = k.add_arg<const uint_>("columns");
+    size_t row_stride_arg = k.add_arg<const uint_>("row_stride");
+    size_t column_stride_arg = k.add_arg<const uint_>("column_stride");
+
+    k <<
+        "const uint row = get_group_id(0);\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "__local " << k.type<T>() << " scratch[" << work_group_size << "];\n" <<
+        "__local uint scratch_has_sum[" << work_group_size << "];\n" <<
+        k.decl<T>("sum") << ";\n" <<
+        "uint has_sum = 0;\n";
+
+    if(width > 1){
+        k <<
+            "const uint vector_count = columns / " << width << ";\n" <<
+            "const uint row_start = row * (row_stride / " << width << ");\n" <<
+            "for(uint j = lid; j < vector_count; j += get_local_size(0)){\n" <<
+            "    const uint i = row_start + j;\n" <<
+            "    " << type_name<value_type>() << width << " v0 = " <<
+                     fused_transform_reduce_vload(k, first, width, "i") << ";\n";
+        for(uint_ c = 0; c < width; c++){
+            k << "{\n" <<
+                 k.decl<const T>("x") << " = v0." << vector_component(c) << ";\n";
+            fused_transform_reduce_accumulate<T>(k, function);
+            k << "}\n";
+        }
+        k <<
+            "}\n";
+    }
+    else {
+        k <<
+            "for(uint j = lid; j < columns; j += get_local_size(0)){\n" <<
+            "    " << k.decl<const T>("x") << " = " <<
+                     first[k.var<uint_>("row * row_stride + j * column_stride")] << ";\n";
+        fused_transform_reduce_accumulate<T>(k, function);
+        k <<
+            "}\n";
+    }
+
+    reduce_matrix_local_tree<T>(k, function, "lid", work_group_size, 1);
+
+    k <<
+        "if(lid == 0){\n" <<
+        "    " << result[k.var<uint_>("row")] << " = scratch[0];\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(columns_arg, static_cast<uint_>(columns));
+    kernel.set_arg(row_stride_arg, static_cast<uint_>(row_stride));
+    kernel.set_arg(column_stride_arg, static_cast<uint_>(column_stride));
+
+    queue.enqueue_1d_range_kernel(
+        kernel, 0, rows * work_group_size, work_group_size
+    );
+}
+
+// reduces the rows [group * rows_per_group, (group + 1) * rows_per_group)
+// of each column for each of the row_groups groups of rows and stores the
+// result of the group to result[group * columns + column]. work-groups
+// are tiles of tile_columns x tile_rows work-items, each of the rows of
+// the tile reads tile_columns consecutive values of a row of the matrix.
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void reduce_matrix_columns_pass(InputIterator first,
+                                       size_t rows,
+                                       size_t columns,
+                                       size_t row_stride,
+                                       size_t column_stride,
+                                       size_t rows_per_group,
+                                       size_t row_groups,
+                                       size_t tile_columns,
+                                       size_t tile_rows,
+                                       OutputIterator result,
+                                       BinaryFunction function,
+                                       command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        boost::compute::result_of<BinaryFunction(value_type, value_type)>::type T;
+
+    meta_kernel k("reduce_columns");
+    size_t rows_arg = k.add_arg<const uint_>("rows");
+    size_t columns_arg = k.add_arg<const uint_>("columns");
+    size_t row_stride_arg = k.add_arg<const uint_>("row_stride");
+    size_t column_stride_arg = k.add_arg<const uint_>("column_stride");
+    size_t rows_per_group_arg = k.add_arg<const uint_>("rows_per_group");
+
+    k <<
+        "const uint column = get_global_id(0);\n" <<
+        "const uint lx = get_local_id(0);\n" <<
+        "const uint ly = get_local_id(1);\n" <<
+        "const uint lid = ly * " << uint_(tile_columns) << " + lx;\n" <<
+        "__local " << k.type<T>() << " scratch[" << tile_columns * tile_rows << "];\n" <<
+        "__local uint scratch_has_sum[" << tile_columns * tile_rows << "];\n" <<
+        "const uint row_begin = get_group_id(1) * rows_per_group;\n" <<
+        "const uint row_end = min(row_begin + rows_per_group, rows);\n" <<
+        k.decl<T>("sum") << ";\n" <<
+        "uint has_sum = 0;\n" <<
+        "if(column < columns){\n" <<
+        "    for(uint i = row_begin + ly; i < row_end; i += " << uint_(tile_rows) << "){\n" <<
+        "        " << k.decl<const T>("x") << " = " <<
+                     first[k.var<uint_>("i * row_stride + column * column_stride")] << ";\n";
+    fused_transform_reduce_accumulate<T>(k, function);
+    k <<
+        "    }\n" <<
+        "}\n";
+
+    reduce_matrix_local_tree<T>(k, function, "ly", tile_rows, tile_columns);
+
+    // the first row of each group of rows is reduced by the first row of
+    // the tile so it always has a value
+    k <<
+        "if(ly == 0 && column < columns){\n" <<
+        "    " << result[k.var<uint_>("get_group_id(1) * columns + column")] <<
+                  " = scratch[lx];\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(rows_arg, static_cast<uint_>(rows));
+    kernel.set_arg(columns_arg, static_cast<uint_>(columns));
+    kernel.set_arg(row_stride_arg, static_cast<uint_>(row_stride));
+    kernel.set_arg(column_stride_arg, static_cast<uint_>(column_stride));
+    kernel.set_arg(rows_per_group_arg, static_cast<uint_>(rows_per_group));
+
+    const size_t global_size[] = {
+        (columns + tile_columns - 1) / tile_columns * tile_columns,
+        row_groups * tile_rows
+    };
+    const size_t local_size[] = { tile_columns, tile_rows };
+    queue.enqueue_nd_range_kernel(kernel, 2, 0, global_size, local_size);
+}
+
+// reduces each of the columns of the matrix whose value (i, j) is
+// first[i * row_stride + j * column_stride]. when there are too few
+// columns to fill the device, the rows are split in groups which are
+// reduced separately and the partial results of the groups are then
+// reduced by a second pass.
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void reduce_matrix_columns(InputIterator first,
+                                  size_t rows,
+                                  size_t columns,
+                                  size_t row_stride,
+                                  size_t column_stride,
+                                  OutputIterator result,
+                                  BinaryFunction function,
+                                  command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        boost::compute::result_of<BinaryFunction(value_type, value_type)>::type T;
+
+    const device &device = queue.get_device();
+
+    // tiles of 32 x 8 work-items, or less if the device can't run them
+    const size_t work_group_size = fused_transform_reduce_work_group_size<T>(queue);
+    const size_t tile_columns = (std::min)(size_t(32), work_group_size);
+    const size_t tile_rows = (std::min)(size_t(8), work_group_size / tile_columns);
+
+    const size_t column_groups = (columns + tile_columns - 1) / tile_columns;
+    const size_t target_groups = (std::max)(size_t(1), size_t(device.compute_units() * 4));
+
+    // each group of rows gives at least a few rows to every work-item
+    size_t row_groups = (std::min)(
+        (rows + 4 * tile_rows - 1) / (4 * tile_rows),
+        (target_groups + column_groups - 1) / column_groups
+    );
+    row_groups = (std::max)(size_t(1), row_groups);
+    const size_t rows_per_group = (rows + row_groups - 1) / row_groups;
+    row_groups = (rows + rows_per_group - 1) / rows_per_group;
+
+    if(row_groups == 1){
+        reduce_matrix_columns_pass(
+            first, rows, columns, row_stride, column_stride, rows, 1,
+            tile_columns, tile_rows, result, function, queue
+        );
+        return;
+    }
+
+    scratch_vector<T> partials(row_groups * columns, queue);
+    reduce_matrix_columns_pass(
+        first, rows, columns, row_stride, column_stride, rows_per_group,
+        row_groups, tile_columns, tile_rows, partials.begin(), function, queue
+    );
+    reduce_matrix_columns_pass(
+        partials.begin(), row_groups, columns, columns, 1, row_groups, 1,
+        tile_columns, tile_rows, result, function, queue
+    );
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_REDUCE_MATRIX_HPP
@@ -15,12 +15,15 @@
 
 #include <boost/compute/program.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/kernel_cache.hpp>
+#include <boost/compute/detail/sub_group.hpp>
 #include <boost/compute/detail/vendor.hpp>
 #include <boost/compute/detail/work_size.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/type_traits/result_of.hpp>
 #include <boost/compute/type_traits/type_name.hpp>
 #include <boost/compute/utility/program_cache.hpp>
+#include <boost/compute/utility/kernel_variants.hpp>
 #include <boost/compute/utility/source.hpp>
 
 namespace boost {
@@ -85,6 +88,38 @@ struct ReduceBody<T,true>
     }
 };
 
+/// \internal
+/// body reduction with sub-group (or work-group) functions, the
+/// sum of the work-group is stored in scratch[0]
+template<typename T>
+inline std::string sub_group_reduce_body(const sub_group_functions &sub_groups)
+{
+    std::stringstream k;
+    if(sub_groups.is_work_group()){
+        k << "sum = " << sub_groups.reduce("add", "sum") << ";\n" <<
+             "if(lid == 0){\n" <<
+             "    scratch[0] = sum;\n" <<
+             "}\n";
+    }
+    else {
+        // reduce each sub-group and then the sums of the sub-groups
+        k << "sum = " << sub_groups.reduce("add", "sum") << ";\n" <<
+             "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+             "if(" << sub_groups.local_id() << " == 0){\n" <<
+             "    scratch[" << sub_groups.group_id() << "] = sum;\n" <<
+             "}\n" <<
+             "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+             "if(lid == 0){\n" <<
+             "    sum = scratch[0];\n" <<
+             "    for(uint i = 1; i < " << sub_groups.group_count() << "; i++){\n" <<
+             "        sum += scratch[i];\n" <<
+             "    }\n" <<
+             "    scratch[0] = sum;\n" <<
+             "}\n";
+    }
+    return k.str();
+}
+
 template<class InputIterator, class Function>
 inline void initial_reduce(InputIterator first,
                            InputIterator last,
@@ -120,11 +155,20 @@ inline void initial_reduce(InputIterator first,
         "    }\n" <<
         "}\n" <<
 
-        "scratch[lid] = sum;\n" <<
+        "scratch[lid] = sum;\n";
 
-        // local reduction
-        ReduceBody<T,false>::body() <<
+    // local reduction
+    const sub_group_functions sub_groups(queue.get_device());
+    const bool use_sub_groups = sub_groups.supports<T>();
+    if(use_sub_groups){
+        sub_groups.enable(k);
+        k << sub_group_reduce_body<T>(sub_groups);
+    }
+    else {
+        k << ReduceBody<T,false>::body();
+    }
 
+    k <<
         // write sum to output
         "if(lid == 0){\n" <<
         "    output[get_group_id(0)] = scratch[0];\n" <<
@@ -133,6 +177,11 @@ inline void initial_reduce(InputIterator first,
     const context &context = queue.get_context();
     std::stringstream options;
     options << "-DVPT=" << vpt << " -DTPB=" << tpb;
+    if(use_sub_groups){
+        options << " " << sub_groups.options();
+    }
+    k.set_restrict_buffers(true);
+    k.set_reqd_work_group_size(tpb);
     kernel generic_reduce_kernel = k.compile(context, options.str());
     generic_reduce_kernel.set_arg(output_arg, result);
 
@@ -198,8 +247,17 @@ inline void reduce_on_gpu(InputIterator first,
 
         "scratch[lid] = sum;\n";
 
-    // discrimination on vendor name
-    if(is_nvidia_device(device))
+    // use sub-group functions if available, otherwise the "reduce"
+    // variant of the kernel variant registry
+    const sub_group_functions sub_groups(device);
+    const bool use_sub_groups = sub_groups.supports<T>();
+    const bool warp_unrolled = !use_sub_groups &&
+        kernel_variant_registry::get_global_registry()->select("reduce", device) == "warp_unrolled";
+    if(use_sub_groups){
+        sub_groups.enable(k);
+        k << sub_group_reduce_body<T>(sub_groups);
+    }
+    else if(warp_unrolled)
         k << ReduceBody<T,true>::body();
     else
         k << ReduceBody<T,false>::body();
@@ -212,6 +270,7 @@ inline void reduce_on_gpu(InputIterator first,
 
     uint_ vpt = 8;
     uint_ tpb = 128;
+    k.set_reqd_work_group_size(tpb);
 
     size_t count = std::distance(first, last);
 
@@ -221,23 +280,33 @@ inline void reduce_on_gpu(InputIterator first,
     boost::shared_ptr<program_cache> cache =
         program_cache::get_global_cache(context);
 
-    std::string cache_key = std::string("__boost_reduce_on_gpu_") + type_name<T>();
+    std::stringstream cache_key;
+    cache_key << "__boost_reduce_on_gpu_" << type_name<T>();
+    if(use_sub_groups){
+        cache_key << "_sub_group_" << sub_groups.backend();
+    }
+    else if(warp_unrolled){
+        cache_key << "_warp_unrolled";
+    }
 
     std::stringstream options;
     options << "-DT=" << type_name<T>() << " -DVPT=" << vpt << " -DTPB=" << tpb;
+    if(use_sub_groups){
+        options << " " << sub_groups.options();
+    }
 
     program reduce_program =
-        cache->get_or_build(cache_key, options.str(), k.source(), context);
+        cache->get_or_build(cache_key.str(), options.str(), k.source(), context);
 
     // create reduce kernel
-    kernel reduce_kernel(reduce_program, "reduce");
+    kernel reduce_kernel = get_cached_kernel(reduce_program, "reduce");
 
     // first pass, reduce from input to ping
-    buffer ping(context, std::ceil(float(count) / vpt / tpb) * sizeof(T));
+    buffer ping(context, calculate_work_size(count, vpt * tpb, 1) * sizeof(T));
     initial_reduce(first, last, ping, function, reduce_kernel, vpt, tpb, queue);
 
     // update count after initial reduce
-    count = std::ceil(float(count) / vpt / tpb);
+    count = calculate_work_size(count, vpt * tpb, 1);
 
     // middle pass(es), reduce between ping and pong
     const buffer *input_buffer = &ping;
@@ -251,14 +320,11 @@ inline void reduce_on_gpu(InputIterator first,
             reduce_kernel.set_arg(3, *output_buffer);
             reduce_kernel.set_arg(4, uint_(0));
 
-            size_t work_size = std::ceil(float(count) / vpt);
-            if(work_size % tpb != 0){
-                work_size += tpb - work_size % tpb;
-            }
+            size_t work_size = calculate_work_size(count, vpt, tpb);
             queue.enqueue_1d_range_kernel(reduce_kernel, 0, work_size, tpb);
 
             std::swap(input_buffer, output_buffer);
-            count = std::ceil(float(count) / vpt / tpb);
+            count = calculate_work_size(count, vpt * tpb, 1);
         }
     }
 
@@ -0,0 +1,152 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_REPRODUCIBLE_REDUCE_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_REPRODUCIBLE_REDUCE_HPP
+
+#include <algorithm>
+#include <iterator>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// the partitioning of the reproducible reduction. these are constants (and
+// not tuned for the device) as the order in which the values are combined
+// must only depend on the number of values.
+static const size_t reproducible_reduce_lanes = 32;
+static const size_t reproducible_reduce_block_size = 1024;
+
+// returns the number of partial results of a pass over count values
+inline size_t reproducible_reduce_pass_size(size_t count)
+{
+    const size_t lanes = reproducible_reduce_lanes;
+    const size_t block_size = reproducible_reduce_block_size;
+    const size_t blocks = (count + block_size - 1) / block_size;
+
+    return (blocks - 1) * lanes + (std::min)(lanes, count - (blocks - 1) * block_size);
+}
+
+// reduces the count values of input by blocks of block_size values. each
+// block is split in lanes, lane l of block b reduces the values
+// b * block_size + l + k * lanes in order and its result is stored to
+// result[b * lanes + l]. consecutive work-items read consecutive values.
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void reproducible_reduce_pass(InputIterator first,
+                                     size_t count,
+                                     OutputIterator result,
+                                     BinaryFunction function,
+                                     command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        boost::compute::result_of<BinaryFunction(value_type, value_type)>::type T;
+
+    meta_kernel k("reproducible_reduce");
+    k.add_opencl_pragma("FP_CONTRACT OFF");
+    size_t count_arg = k.add_arg<const uint_>("count");
+
+    k <<
+        "const uint j = get_global_id(0);\n" <<
+        "const uint block = j / " << uint_(reproducible_reduce_lanes) << ";\n" <<
+        "const uint start = block * " << uint_(reproducible_reduce_block_size) <<
+            " + j % " << uint_(reproducible_reduce_lanes) << ";\n" <<
+        "const uint end = min((block + 1) * " <<
+            uint_(reproducible_reduce_block_size) << ", count);\n" <<
+        k.decl<T>("sum") << " = " << first[k.var<uint_>("start")] << ";\n" <<
+        "for(uint i = start + " << uint_(reproducible_reduce_lanes) << "; i < end; i += " <<
+            uint_(reproducible_reduce_lanes) << "){\n" <<
+        "    sum = " << function(k.var<T>("sum"), first[k.var<uint_>("i")]) << ";\n" <<
+        "}\n" <<
+        result[k.var<uint_>("j")] << " = sum;\n";
+
+    k.set_arg(count_arg, static_cast<uint_>(count));
+
+    k.exec_1d(queue, 0, reproducible_reduce_pass_size(count));
+}
+
+// reduces the count values of input in order with a single work-item
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void reproducible_reduce_serial(InputIterator first,
+                                       size_t count,
+                                       OutputIterator result,
+                                       BinaryFunction function,
+                                       command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        boost::compute::result_of<BinaryFunction(value_type, value_type)>::type T;
+
+    meta_kernel k("reproducible_reduce_serial");
+    k.add_opencl_pragma("FP_CONTRACT OFF");
+    size_t count_arg = k.add_arg<const uint_>("count");
+
+    k <<
+        k.decl<T>("sum") << " = " << first[k.var<uint_>("0")] << ";\n" <<
+        "for(uint i = 1; i < count; i++){\n" <<
+        "    sum = " << function(k.var<T>("sum"), first[k.var<uint_>("i")]) << ";\n" <<
+        "}\n" <<
+        result[k.var<uint_>("0")] << " = sum;\n";
+
+    k.set_arg(count_arg, static_cast<uint_>(count));
+    k.exec(queue);
+}
+
+// reduces the count values of input to result with an order of operations
+// which only depends on count. the values are reduced by passes of
+// reproducible_reduce_pass() until a single block remains, which is then
+// reduced serially, so the result is the same on every device and for
+// every run (given correctly rounded operations, which is the case for
+// the additions and multiplications of OpenCL).
+template<class InputIterator, class BinaryFunction, class T>
+inline void reproducible_reduce(InputIterator first,
+                                size_t count,
+                                buffer_iterator<T> result,
+                                BinaryFunction function,
+                                command_queue &queue)
+{
+    if(count <= reproducible_reduce_block_size){
+        reproducible_reduce_serial(first, count, result, function, queue);
+        return;
+    }
+
+    size_t partial_count = reproducible_reduce_pass_size(count);
+    scratch_vector<T> partials(partial_count, queue);
+    reproducible_reduce_pass(first, count, partials.begin(), function, queue);
+
+    // the passes alternate between the two temporaries
+    buffer_iterator<T> input = partials.begin();
+    if(partial_count > reproducible_reduce_block_size){
+        scratch_vector<T> next(reproducible_reduce_pass_size(partial_count), queue);
+        buffer_iterator<T> output = next.begin();
+        while(partial_count > reproducible_reduce_block_size){
+            reproducible_reduce_pass(input, partial_count, output, function, queue);
+            partial_count = reproducible_reduce_pass_size(partial_count);
+            std::swap(input, output);
+        }
+        reproducible_reduce_serial(input, partial_count, result, function, queue);
+        return;
+    }
+
+    reproducible_reduce_serial(input, partial_count, result, function, queue);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_REPRODUCIBLE_REDUCE_HPP
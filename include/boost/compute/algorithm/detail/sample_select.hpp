@@ -0,0 +1,337 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_SAMPLE_SELECT_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_SAMPLE_SELECT_HPP
+
+#include <algorithm>
+#include <iterator>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// inputs of at most this size are sorted instead of narrowed down further
+static const size_t sample_select_sort_threshold = 1 << 15;
+
+// number of values sampled in each pass
+static const size_t sample_select_sample_count = 1024;
+
+// distance (in samples) of the splitters from the expected rank of the
+// selected value in the sorted samples
+static const size_t sample_select_splitter_distance = 32;
+
+// selects the values of one of the buckets defined by the two splitters
+// lo = splitters[0] and hi = splitters[1]. bucket 0 holds the values less
+// than lo, bucket 1 the values in [lo, hi] and bucket 2 the values greater
+// than hi. the splitters are read by the kernels so that the same program
+// is used whatever their values are.
+template<class InputIterator, class Compare>
+struct sample_select_bucket
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    sample_select_bucket(InputIterator first_,
+                         Compare compare_,
+                         buffer_iterator<value_type> splitters_,
+                         int bucket_)
+        : first(first_),
+          compare(compare_),
+          splitters(splitters_),
+          bucket(bucket_)
+    {
+    }
+
+    void select(meta_kernel &k) const
+    {
+        if(bucket == 0){
+            k << compare(first[k.var<uint_>("i")], splitters[k.var<uint_>("0")]);
+        }
+        else if(bucket == 1){
+            k << "!(" << compare(first[k.var<uint_>("i")], splitters[k.var<uint_>("0")]) << ") && " <<
+                 "!(" << compare(splitters[k.var<uint_>("1")], first[k.var<uint_>("i")]) << ")";
+        }
+        else {
+            k << compare(splitters[k.var<uint_>("1")], first[k.var<uint_>("i")]);
+        }
+    }
+
+    InputIterator first;
+    Compare compare;
+    buffer_iterator<value_type> splitters;
+    int bucket;
+};
+
+// counts the values of [first, first + count) in buckets 0 and 1 and
+// stores the counts in counts[0] and counts[1]
+template<class InputIterator, class Compare>
+inline void sample_select_count(InputIterator first,
+                                size_t count,
+                                Compare compare,
+                                buffer_iterator<
+                                    typename std::iterator_traits<InputIterator>::value_type
+                                > splitters,
+                                const buffer &counts,
+                                command_queue &queue)
+{
+    const device &device = queue.get_device();
+
+    size_t work_group_size = (std::min)(size_t(256), device.max_work_group_size());
+    size_t power = 1;
+    while(power * 2 <= work_group_size){
+        power *= 2;
+    }
+    work_group_size = power;
+
+    const size_t max_work_group_count = (std::max)(size_t(1), size_t(device.compute_units() * 4));
+    const size_t work_group_count = (std::min)(
+        max_work_group_count,
+        (count + 4 * work_group_size - 1) / (4 * work_group_size)
+    );
+
+    const sample_select_bucket<InputIterator, Compare> less_than(
+        first, compare, splitters, 0
+    );
+    const sample_select_bucket<InputIterator, Compare> between(
+        first, compare, splitters, 1
+    );
+
+    meta_kernel k("sample_select_count");
+    size_t count_arg = k.add_arg<const uint_>("count");
+    const std::string counts_ptr = k.get_buffer_identifier<uint_>(counts);
+
+    k <<
+        "__local uint lcounts0[" << work_group_size << "];\n" <<
+        "__local uint lcounts1[" << work_group_size << "];\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "uint n0 = 0;\n" <<
+        "uint n1 = 0;\n" <<
+        "for(uint i = get_global_id(0); i < count; i += get_global_size(0)){\n" <<
+        "    if(";
+    less_than.select(k);
+    k << "){\n" <<
+        "        n0++;\n" <<
+        "    }\n" <<
+        "    else if(";
+    between.select(k);
+    k << "){\n" <<
+        "        n1++;\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "lcounts0[lid] = n0;\n" <<
+        "lcounts1[lid] = n1;\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(uint offset = get_local_size(0) / 2; offset > 0; offset >>= 1){\n" <<
+        "    if(lid < offset){\n" <<
+        "        lcounts0[lid] += lcounts0[lid + offset];\n" <<
+        "        lcounts1[lid] += lcounts1[lid + offset];\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n" <<
+        "if(lid == 0){\n" <<
+        "    atomic_add(&" << counts_ptr << "[0], lcounts0[0]);\n" <<
+        "    atomic_add(&" << counts_ptr << "[1], lcounts1[0]);\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(count_arg, static_cast<uint_>(count));
+
+    queue.enqueue_1d_range_kernel(
+        kernel, 0, work_group_count * work_group_size, work_group_size
+    );
+}
+
+// narrows the candidates for the value with rank nth in [first,
+// first + count) down to one bucket and stores its values in candidates.
+// the splitters are chosen from a sorted sample of the input so that the
+// bucket most likely contains the value and is small. returns the number
+// of values in the bucket and updates nth to the rank in the bucket.
+template<class InputIterator, class Compare>
+inline size_t sample_select_pass(InputIterator first,
+                                 size_t count,
+                                 size_t &nth,
+                                 Compare compare,
+                                 vector<
+                                     typename std::iterator_traits<InputIterator>::value_type
+                                 > &candidates,
+                                 command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    const size_t sample_count = (std::min)(sample_select_sample_count, count);
+    const size_t d = sample_select_splitter_distance;
+
+    // take evenly spaced samples of the input and sort them
+    scratch_vector<value_type> samples(sample_count, queue);
+
+    meta_kernel k("sample_select_sample");
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t sample_count_arg = k.add_arg<const uint_>("sample_count");
+    k <<
+        "const uint i = (uint)(((ulong) get_global_id(0) * count) / sample_count);\n" <<
+        samples.begin()[k.var<uint_>("get_global_id(0)")] << " = " <<
+            first[k.var<uint_>("i")] << ";\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(count_arg, static_cast<uint_>(count));
+    kernel.set_arg(sample_count_arg, static_cast<uint_>(sample_count));
+    queue.enqueue_1d_range_kernel(kernel, 0, sample_count, 0);
+
+    ::boost::compute::sort(samples.begin(), samples.end(), compare, queue);
+
+    // choose the splitters around the expected rank in the samples
+    const size_t rank = static_cast<size_t>(
+        (static_cast<double>(nth) * sample_count) / count
+    );
+    const size_t lo = rank > d ? rank - d : 0;
+    const size_t hi = (std::min)(rank + d, sample_count - 1);
+
+    scratch_vector<value_type> splitters(2, queue);
+    ::boost::compute::copy_n(samples.begin() + lo, 1, splitters.begin(), queue);
+    ::boost::compute::copy_n(samples.begin() + hi, 1, splitters.begin() + 1, queue);
+
+    // count the values below and between the splitters
+    scratch_vector<uint_> counts(2, queue);
+    ::boost::compute::fill(counts.begin(), counts.end(), uint_(0), queue);
+    sample_select_count(
+        first, count, compare, splitters.begin(), counts.get_buffer(), queue
+    );
+
+    uint_ host_counts[2];
+    ::boost::compute::copy(counts.begin(), counts.end(), host_counts, queue);
+
+    int bucket = 1;
+    size_t bucket_count = host_counts[1];
+    if(nth < host_counts[0]){
+        bucket = 0;
+        bucket_count = host_counts[0];
+    }
+    else if(nth >= host_counts[0] + host_counts[1]){
+        bucket = 2;
+        bucket_count = count - host_counts[0] - host_counts[1];
+        nth -= host_counts[0] + host_counts[1];
+    }
+    else {
+        nth -= host_counts[0];
+    }
+
+    if(bucket_count == count){
+        // the splitters did not narrow down the candidates (e.g. when
+        // most of the values are equal)
+        return count;
+    }
+
+    candidates.resize_uninitialized(bucket_count);
+    stream_compact(
+        first,
+        count,
+        candidates.begin(),
+        sample_select_bucket<InputIterator, Compare>(
+            first, compare, splitters.begin(), bucket
+        ),
+        false,
+        queue
+    );
+
+    return bucket_count;
+}
+
+// rearranges [first, last) into the values less than the value with rank
+// nth, the values equal to it and the values greater than it. each group
+// keeps the order of the input.
+//
+// the selected value is found by repeatedly keeping only the bucket of a
+// sample-based split which contains it, until few enough candidates are
+// left to sort them. the values are then partitioned around it in a single
+// pass for each group.
+template<class Iterator, class Compare>
+inline void sample_select(Iterator first,
+                          size_t nth,
+                          Iterator last,
+                          Compare compare,
+                          command_queue &queue)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    const context &context = queue.get_context();
+    const size_t count = iterator_range_size(first, last);
+
+    // find the selected value
+    vector<value_type> candidates(context);
+    vector<value_type> next_candidates(context);
+
+    size_t rank = nth;
+    size_t candidate_count = sample_select_pass(
+        first, count, rank, compare, candidates, queue
+    );
+
+    if(candidate_count == count){
+        // nothing has been copied to the candidates
+        candidates.assign(first, last, queue);
+    }
+
+    while(candidate_count > sample_select_sort_threshold){
+        const size_t next_count = sample_select_pass(
+            candidates.begin(), candidate_count, rank, compare, next_candidates, queue
+        );
+        if(next_count == candidate_count){
+            break;
+        }
+
+        candidates.swap(next_candidates);
+        candidate_count = next_count;
+    }
+
+    ::boost::compute::sort(
+        candidates.begin(), candidates.begin() + candidate_count, compare, queue
+    );
+
+    // use the selected value as both splitters
+    scratch_vector<value_type> splitters(2, queue);
+    ::boost::compute::copy_n(candidates.begin() + rank, 1, splitters.begin(), queue);
+    ::boost::compute::copy_n(candidates.begin() + rank, 1, splitters.begin() + 1, queue);
+
+    // partition the input around the selected value
+    vector<value_type> tmp(count, context);
+    typename vector<value_type>::iterator end = tmp.begin();
+    for(int bucket = 0; bucket < 3; bucket++){
+        end = stream_compact(
+            first,
+            count,
+            end,
+            sample_select_bucket<Iterator, Compare>(
+                first, compare, splitters.begin(), bucket
+            ),
+            false,
+            queue
+        );
+    }
+
+    ::boost::compute::copy(tmp.begin(), tmp.end(), first, queue);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_SAMPLE_SELECT_HPP
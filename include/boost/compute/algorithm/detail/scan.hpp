@@ -14,6 +14,8 @@
 #include <boost/compute/device.hpp>
 #include <boost/compute/algorithm/detail/scan_on_cpu.hpp>
 #include <boost/compute/algorithm/detail/scan_on_gpu.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
@@ -26,9 +28,9 @@ inline OutputIterator scan(InputIterator first,
                            bool exclusive,
                            command_queue &queue)
 {
-    const device &device = queue.get_device();
+    const size_t count = detail::iterator_range_size(first, last);
 
-    if(device.type() & device::cpu){
+    if(count < device_profile::get(queue.get_device())->serial_threshold()){
         return scan_on_cpu(first, last, result, exclusive, queue);
     }
     else {
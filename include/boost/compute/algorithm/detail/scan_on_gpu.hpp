@@ -15,10 +15,14 @@
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/detail/scan_on_cpu.hpp>
+#include <boost/compute/algorithm/detail/single_pass_scan.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/sub_group.hpp>
 #include <boost/compute/memory/local_buffer.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
 
 namespace boost {
 namespace compute {
@@ -31,7 +35,8 @@ public:
     local_scan_kernel(InputIterator first,
                       InputIterator last,
                       OutputIterator result,
-                      bool exclusive)
+                      bool exclusive,
+                      const sub_group_functions &sub_groups)
         : meta_kernel("local_scan")
     {
         typedef typename std::iterator_traits<InputIterator>::value_type T;
@@ -80,15 +85,47 @@ public:
             "barrier(CLK_LOCAL_MEM_FENCE);\n";
 
         // perform scan
-        *this <<
-            "for(uint i = 1; i < block_size; i <<= 1){\n" <<
-            "    " << decl<const T>("x") << " = lid >= i ? scratch[lid-i] : 0;\n" <<
-            "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
-            "    if(lid >= i){\n" <<
-            "        scratch[lid] = scratch[lid] + x;\n" <<
-            "    }\n" <<
-            "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
-            "}\n";
+        if(sub_groups.supports<T>() && sub_groups.is_work_group()){
+            sub_groups.enable(*this);
+
+            *this <<
+                "scratch[lid] = " << sub_groups.scan_inclusive("add", "scratch[lid]") << ";\n";
+        }
+        else if(sub_groups.supports<T>()){
+            sub_groups.enable(*this);
+
+            // scan each sub-group and add the sums of the preceding
+            // sub-groups (scanned by the first work-item)
+            *this <<
+                "__local " << type<T>() << " sub_group_sums[256];\n" <<
+                decl<const T>("x") << " = " <<
+                    sub_groups.scan_inclusive("add", "scratch[lid]") << ";\n" <<
+                "if(" << sub_groups.local_id() << " == " << sub_groups.size() << " - 1){\n" <<
+                "    sub_group_sums[" << sub_groups.group_id() << "] = x;\n" <<
+                "}\n" <<
+                "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+                "if(lid == 0){\n" <<
+                "    " << decl<T>("sum") << " = 0;\n" <<
+                "    for(uint i = 0; i < " << sub_groups.group_count() << "; i++){\n" <<
+                "        " << decl<const T>("y") << " = sub_group_sums[i];\n" <<
+                "        sub_group_sums[i] = sum;\n" <<
+                "        sum = sum + y;\n" <<
+                "    }\n" <<
+                "}\n" <<
+                "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+                "scratch[lid] = x + sub_group_sums[" << sub_groups.group_id() << "];\n";
+        }
+        else {
+            *this <<
+                "for(uint i = 1; i < block_size; i <<= 1){\n" <<
+                "    " << decl<const T>("x") << " = lid >= i ? scratch[lid-i] : 0;\n" <<
+                "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+                "    if(lid >= i){\n" <<
+                "        scratch[lid] = scratch[lid] + x;\n" <<
+                "    }\n" <<
+                "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+                "}\n";
+        }
 
         // copy results to output
         if(checked){
@@ -162,21 +199,24 @@ public:
     size_t m_count_arg;
 };
 
+// returns the smallest power of two not less than the size of the range,
+// limited to max_block_size (which must be a power of two)
 template<class InputIterator>
-inline size_t pick_scan_block_size(InputIterator first, InputIterator last)
+inline size_t pick_scan_block_size(InputIterator first,
+                                   InputIterator last,
+                                   size_t max_block_size = 256)
 {
     size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        return 0;
+    }
+
+    size_t block_size = 1;
+    while(block_size < count && block_size < max_block_size){
+        block_size *= 2;
+    }
 
-    if(count == 0)        { return 0; }
-    else if(count <= 1)   { return 1; }
-    else if(count <= 2)   { return 2; }
-    else if(count <= 4)   { return 4; }
-    else if(count <= 8)   { return 8; }
-    else if(count <= 16)  { return 16; }
-    else if(count <= 32)  { return 32; }
-    else if(count <= 64)  { return 64; }
-    else if(count <= 128) { return 128; }
-    else                  { return 256; }
+    return block_size;
 }
 
 template<class InputIterator, class OutputIterator>
@@ -196,7 +236,15 @@ inline OutputIterator scan_impl(InputIterator first,
     const context &context = queue.get_context();
     const size_t count = detail::iterator_range_size(first, last);
 
-    size_t block_size = pick_scan_block_size(first, last);
+    // the largest block size can be tuned with the "block_size" parameter
+    // of "__boost_scan_<type>" in the parameter cache
+    const size_t max_block_size = get_work_group_size_parameter(
+        queue.get_device(),
+        std::string("__boost_scan_") + type_name<value_type>(),
+        "block_size",
+        256
+    );
+    size_t block_size = pick_scan_block_size(first, last, max_block_size);
     size_t block_count = count / block_size;
 
     if(block_count * block_size < count){
@@ -211,10 +259,14 @@ inline OutputIterator scan_impl(InputIterator first,
     ::boost::compute::fill(block_sums.begin(), block_sums.end(), zero, queue);
 
     // local scan
+    const sub_group_functions sub_groups(queue.get_device());
+
     local_scan_kernel<InputIterator, OutputIterator>
-        local_scan_kernel(first, last, result, exclusive);
+        local_scan_kernel(first, last, result, exclusive, sub_groups);
 
-    ::boost::compute::kernel kernel = local_scan_kernel.compile(context);
+    ::boost::compute::kernel kernel = local_scan_kernel.compile(
+        context, sub_groups.supports<value_type>() ? sub_groups.options() : std::string()
+    );
     kernel.set_arg(local_scan_kernel.m_scratch_arg, local_buffer<value_type>(block_size));
     kernel.set_arg(local_scan_kernel.m_block_sums_arg, block_sums);
     kernel.set_arg(local_scan_kernel.m_block_size_arg, static_cast<cl_uint>(block_size));
@@ -296,10 +348,20 @@ inline OutputIterator scan_on_gpu(InputIterator first,
                                   bool exclusive,
                                   command_queue &queue)
 {
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
     if(first == last){
         return result;
     }
 
+    // large inputs are scanned in a single pass on devices which support
+    // it. each value is read before it is written by the same work-item
+    // so the single-pass scan can also be performed in-place.
+    const size_t count = iterator_range_size(first, last);
+    if(use_single_pass_scan<value_type>(count, queue)){
+        return single_pass_scan(first, last, result, exclusive, queue);
+    }
+
     return dispatch_scan(first, last, result, exclusive, queue);
 }
 
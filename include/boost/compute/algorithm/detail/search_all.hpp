@@ -11,74 +11,83 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_SEARCH_ALL_HPP
 #define BOOST_COMPUTE_ALGORITHM_DETAIL_SEARCH_ALL_HPP
 
-#include <boost/compute/algorithm/copy.hpp>
-#include <boost/compute/container/vector.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/find_with_early_exit.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
-#include <boost/compute/lambda.hpp>
-#include <boost/compute/system.hpp>
 
 namespace boost {
 namespace compute {
 namespace detail {
 
-///
-/// \brief Search kernel class
-///
-/// Subclass of meta_kernel which is capable of performing pattern matching
-///
-template<class PatternIterator, class TextIterator, class OutputIterator>
-class search_kernel : public meta_kernel
+// emits code which sets "match" to true if the pattern [p_first, p_last)
+// occurs in the text at position "i" (for find_with_early_exit())
+template<class PatternIterator, class TextIterator>
+class search_matcher
 {
 public:
-    search_kernel() : meta_kernel("search")
-    {}
-
-    void set_range(PatternIterator p_first,
+    search_matcher(PatternIterator p_first,
                    PatternIterator p_last,
-                   TextIterator t_first,
-                   TextIterator t_last,
-                   OutputIterator result)
+                   TextIterator t_first)
+        : m_p_first(p_first),
+          m_p_count(iterator_range_size(p_first, p_last)),
+          m_t_first(t_first)
     {
-        m_p_count = iterator_range_size(p_first, p_last);
-        m_p_count_arg = add_arg<uint_>("p_count");
-
-        m_count = iterator_range_size(t_first, t_last);
-        m_count = m_count + 1 - m_p_count;
-
-        *this <<
-            "uint i = get_global_id(0);\n" <<
-            "uint i1 = i;\n" <<
-            "uint j;\n" <<
-            "for(j = 0; j<p_count; j++,i++)\n" <<
-            "{\n" <<
-            "   if(" << p_first[expr<uint_>("j")] << " != " <<
-                    t_first[expr<uint_>("i")] << ")\n" <<
-            "       j = p_count + 1;\n" <<
-            "}\n" <<
-            "if(j == p_count)\n" <<
-            result[expr<uint_>("i1")] << " = 1;\n" <<
-            "else\n" <<
-            result[expr<uint_>("i1")] << " = 0;\n";
     }
 
-    event exec(command_queue &queue)
+    void operator()(meta_kernel &k) const
     {
-        if(m_count == 0) {
-            return event();
-        }
+        k.add_set_arg<uint_>("p_count", static_cast<uint_>(m_p_count));
 
-        set_arg(m_p_count_arg, uint_(m_p_count));
-
-        return exec_1d(queue, 0, m_count);
+        k << "uint j = 0;\n"
+          << "while(j < p_count && "
+          <<       m_p_first[k.var<uint_>("j")] << " == "
+          <<       m_t_first[k.expr<uint_>("i + j")] << "){\n"
+          << "    j++;\n"
+          << "}\n"
+          << "match = j == p_count;\n";
     }
 
 private:
+    PatternIterator m_p_first;
     size_t m_p_count;
-    size_t m_p_count_arg;
-    size_t m_count;
+    TextIterator m_t_first;
 };
 
+// returns the position of the first (or, if last is true, the last)
+// occurence of [p_first, p_last) in [t_first, t_last), or the size of the
+// text if there is none
+template<class TextIterator, class PatternIterator>
+inline size_t search_position(TextIterator t_first,
+                              TextIterator t_last,
+                              PatternIterator p_first,
+                              PatternIterator p_last,
+                              bool last,
+                              command_queue &queue)
+{
+    const size_t t_count = iterator_range_size(t_first, t_last);
+    const size_t p_count = iterator_range_size(p_first, p_last);
+
+    if(p_count == 0){
+        return last ? t_count : 0;
+    }
+    if(p_count > t_count){
+        return t_count;
+    }
+
+    // candidate positions for the start of the pattern
+    const size_t count = t_count + 1 - p_count;
+
+    const size_t position = find_with_early_exit(
+        count,
+        search_matcher<PatternIterator, TextIterator>(p_first, p_last, t_first),
+        last,
+        queue
+    );
+
+    return position == count ? t_count : position;
+}
+
 } //end detail namespace
 } //end compute namespace
 } //end boost namespace
@@ -0,0 +1,198 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_SEGMENTED_SCAN_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_SEGMENTED_SCAN_HPP
+
+#include <algorithm>
+#include <iterator>
+
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/inclusive_scan.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns the work-group size used for segmented scans of values of type T
+template<class T>
+inline size_t segmented_scan_work_group_size(command_queue &queue)
+{
+    const device &device = queue.get_device();
+
+    size_t work_group_size = (std::min)(size_t(256), device.max_work_group_size());
+    work_group_size = (std::min)(
+        work_group_size,
+        static_cast<size_t>(device.local_memory_size() / (2 * (sizeof(T) + sizeof(uint_))))
+    );
+
+    // round down to a power of two
+    size_t power = 1;
+    while(power * 2 <= work_group_size){
+        power *= 2;
+    }
+
+    return power;
+}
+
+// writes the segment index of each of the count keys beginning at
+// keys_first to segments_first. a new segment begins with each key for
+// which predicate(previous_key, key) is false.
+template<class KeyIterator, class BinaryPredicate>
+inline void segment_ids(KeyIterator keys_first,
+                        size_t count,
+                        buffer_iterator<uint_> segments_first,
+                        BinaryPredicate predicate,
+                        command_queue &queue)
+{
+    meta_kernel k("segment_heads");
+
+    k <<
+        "const uint i = get_global_id(0);\n" <<
+        "if(i == 0){\n" <<
+        "    " << segments_first[k.var<const uint_>("i")] << " = 0;\n" <<
+        "}\n" <<
+        "else {\n" <<
+        "    " << segments_first[k.var<const uint_>("i")] << " = (" <<
+                  predicate(keys_first[k.expr<uint_>("i - 1")],
+                            keys_first[k.var<const uint_>("i")]) << ") ? 0 : 1;\n" <<
+        "}\n";
+
+    k.exec_1d(queue, 0, count);
+
+    ::boost::compute::inclusive_scan(
+        segments_first, segments_first + count, segments_first, queue
+    );
+}
+
+// computes the inclusive segmented scan of the count values beginning at
+// values_first into result. the segments are given by the non-decreasing
+// segment indices beginning at segments_first.
+//
+// each work-group scans a block of the values in local memory and stores
+// the scanned value and segment of its last element. the carries of all
+// blocks are then scanned recursively in the same way and added to the
+// elements at the beginning of each block which continue the segment of
+// the previous block.
+template<class InputIterator, class T, class BinaryFunction>
+inline void segmented_inclusive_scan(buffer_iterator<uint_> segments_first,
+                                     size_t count,
+                                     InputIterator values_first,
+                                     buffer_iterator<T> result,
+                                     BinaryFunction function,
+                                     command_queue &queue)
+{
+    if(count == 0){
+        return;
+    }
+
+    const context &context = queue.get_context();
+
+    const size_t work_group_size = segmented_scan_work_group_size<T>(queue);
+    const size_t block_count = (count + work_group_size - 1) / work_group_size;
+
+    scratch_vector<uint_> carry_segments(block_count, queue);
+    scratch_vector<T> carry_values(block_count, queue);
+
+    // scan each block
+    meta_kernel k("segmented_scan_block");
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t local_segments_arg =
+        k.add_arg<uint_ *>(memory_object::local_memory, "lsegments");
+    size_t local_values_arg =
+        k.add_arg<T *>(memory_object::local_memory, "lvalues");
+
+    k <<
+        "const uint gid = get_global_id(0);\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint group = get_group_id(0);\n" <<
+        "const uint last = min((uint) get_local_size(0), count - group * (uint) get_local_size(0)) - 1;\n" <<
+        "if(gid < count){\n" <<
+        "    lsegments[lid] = " << segments_first[k.var<const uint_>("gid")] << ";\n" <<
+        "    lvalues[lid] = " << values_first[k.var<const uint_>("gid")] << ";\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(uint offset = 1; offset < get_local_size(0); offset <<= 1){\n" <<
+        "    const bool combine = lid <= last && lid >= offset &&\n" <<
+        "                         lsegments[lid - offset] == lsegments[lid];\n" <<
+        "    " << k.decl<T>("x") << ";\n" <<
+        "    if(combine){\n" <<
+        "        x = " << function(k.var<T>("lvalues[lid - offset]"),
+                                   k.var<T>("lvalues[lid]")) << ";\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    if(combine){\n" <<
+        "        lvalues[lid] = x;\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n" <<
+        "if(gid < count){\n" <<
+        "    " << result[k.var<const uint_>("gid")] << " = lvalues[lid];\n" <<
+        "}\n" <<
+        "if(lid == last){\n" <<
+        "    " << carry_segments.begin()[k.var<const uint_>("group")] << " = lsegments[lid];\n" <<
+        "    " << carry_values.begin()[k.var<const uint_>("group")] << " = lvalues[lid];\n" <<
+        "}\n";
+
+    kernel block_kernel = k.compile(context);
+    block_kernel.set_arg(count_arg, static_cast<uint_>(count));
+    block_kernel.set_arg(local_segments_arg, local_buffer<uint_>(work_group_size));
+    block_kernel.set_arg(local_values_arg, local_buffer<T>(work_group_size));
+
+    queue.enqueue_1d_range_kernel(
+        block_kernel, 0, block_count * work_group_size, work_group_size
+    );
+
+    if(block_count == 1){
+        return;
+    }
+
+    // scan the carries of the blocks
+    scratch_vector<T> carry_scan(block_count, queue);
+    segmented_inclusive_scan(
+        carry_segments.begin(),
+        block_count,
+        carry_values.begin(),
+        carry_scan.begin(),
+        function,
+        queue
+    );
+
+    // add the carries to the elements continuing the previous block's segment
+    meta_kernel add_k("segmented_scan_add_carry");
+    size_t block_size_arg = add_k.add_arg<const uint_>("block_size");
+
+    add_k <<
+        "const uint i = get_global_id(0);\n" <<
+        "const uint block = i / block_size;\n" <<
+        "if(" << segments_first[add_k.var<const uint_>("i")] << " == " <<
+                 carry_segments.begin()[add_k.expr<uint_>("block - 1")] << "){\n" <<
+        "    " << result[add_k.var<const uint_>("i")] << " = " <<
+                  function(carry_scan.begin()[add_k.expr<uint_>("block - 1")],
+                           result[add_k.var<const uint_>("i")]) << ";\n" <<
+        "}\n";
+
+    kernel add_kernel = add_k.compile(context);
+    add_kernel.set_arg(block_size_arg, static_cast<uint_>(work_group_size));
+
+    queue.enqueue_1d_range_kernel(
+        add_kernel, work_group_size, count - work_group_size, 0
+    );
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_SEGMENTED_SCAN_HPP
@@ -0,0 +1,504 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_SET_OPERATION_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_SET_OPERATION_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/detail/balanced_path.hpp>
+#include <boost/compute/algorithm/detail/vectorized_binary_search.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_memory.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/utility/fill_batch.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// set operations computed by set_operation()
+enum set_operation_kind {
+    set_operation_intersection,
+    set_operation_union,
+    set_operation_difference,
+    set_operation_symmetric_difference
+};
+
+// writes the code for a value (in the variable named value) taken from
+// the first range (source 'a'), the second range ('b') or from both ('c')
+// to the output of the set operation. when counting, the output values are
+// only counted.
+template<class OutputIterator>
+inline void set_operation_emit(meta_kernel &k,
+                               set_operation_kind kind,
+                               char source,
+                               const std::string &value,
+                               OutputIterator result,
+                               bool write)
+{
+    bool emit = false;
+    switch(kind){
+    case set_operation_intersection:
+        emit = source == 'c';
+        break;
+    case set_operation_union:
+        emit = true;
+        break;
+    case set_operation_difference:
+        emit = source == 'a';
+        break;
+    case set_operation_symmetric_difference:
+        emit = source != 'c';
+        break;
+    }
+
+    if(!emit){
+        return;
+    }
+    else if(write){
+        k << result[k.var<uint_>("index")] << " = " << value << ";\n" <<
+             "index++;\n";
+    }
+    else {
+        k << "index++;\n";
+    }
+}
+
+// runs the set operation for each tile of the balanced path. the values
+// of the tiles of each work-group are first loaded to local memory (the
+// values of the first range followed by the values of the second range)
+// and then merged serially by one work-item per tile.
+//
+// when write is false the number of output values of each tile is stored
+// in offsets. otherwise the output values of each tile are written to
+// result starting at the index given by offsets.
+template<class InputIterator1, class InputIterator2, class OutputIterator>
+inline void set_operation_pass(InputIterator1 first1,
+                               InputIterator2 first2,
+                               buffer_iterator<uint_> tile_a,
+                               buffer_iterator<uint_> tile_b,
+                               size_t tile_count,
+                               size_t tile_size,
+                               buffer_iterator<uint_> offsets,
+                               OutputIterator result,
+                               set_operation_kind kind,
+                               bool write,
+                               size_t work_group_size,
+                               command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator1>::value_type value_type;
+
+    meta_kernel k(write ? "set_operation_write" : "set_operation_count");
+    size_t tile_count_arg = k.add_arg<const uint_>("tile_count");
+
+    k <<
+        "__local " << k.type<value_type>() << " lvalues[" <<
+            work_group_size * tile_size + 1 << "];\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint first_tile = get_group_id(0) * get_local_size(0);\n" <<
+        "const uint last_tile = min(first_tile + (uint) get_local_size(0), tile_count);\n" <<
+        "const uint a0 = " << tile_a[k.var<uint_>("first_tile")] << ";\n" <<
+        "const uint b0 = " << tile_b[k.var<uint_>("first_tile")] << ";\n" <<
+        "const uint a_size = " << tile_a[k.var<uint_>("last_tile")] << " - a0;\n" <<
+        "const uint b_size = " << tile_b[k.var<uint_>("last_tile")] << " - b0;\n" <<
+        "for(uint j = lid; j < a_size; j += get_local_size(0)){\n" <<
+        "    lvalues[j] = " << first1[k.var<uint_>("a0 + j")] << ";\n" <<
+        "}\n" <<
+        "for(uint j = lid; j < b_size; j += get_local_size(0)){\n" <<
+        "    lvalues[a_size + j] = " << first2[k.var<uint_>("b0 + j")] << ";\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "const uint i = first_tile + lid;\n" <<
+        "if(i < last_tile){\n" <<
+        "uint start1 = " << tile_a[k.var<uint_>("i")] << " - a0;\n" <<
+        "const uint end1 = " << tile_a[k.var<uint_>("i+1")] << " - a0;\n" <<
+        "uint start2 = " << tile_b[k.var<uint_>("i")] << " - b0 + a_size;\n" <<
+        "const uint end2 = " << tile_b[k.var<uint_>("i+1")] << " - b0 + a_size;\n";
+    if(write){
+        k << "uint index = " << offsets[k.var<uint_>("i")] << ";\n";
+    }
+    else {
+        k << "uint index = 0;\n";
+    }
+    k <<
+        "while(start1 < end1 && start2 < end2){\n" <<
+        "    " << k.decl<const value_type>("a") << " = lvalues[start1];\n" <<
+        "    " << k.decl<const value_type>("b") << " = lvalues[start2];\n" <<
+        "    if(a < b){\n";
+    set_operation_emit(k, kind, 'a', "a", result, write);
+    k <<
+        "        start1++;\n" <<
+        "    }\n" <<
+        "    else if(b < a){\n";
+    set_operation_emit(k, kind, 'b', "b", result, write);
+    k <<
+        "        start2++;\n" <<
+        "    }\n" <<
+        "    else {\n";
+    set_operation_emit(k, kind, 'c', "a", result, write);
+    k <<
+        "        start1++;\n" <<
+        "        start2++;\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "for(; start1 < end1; start1++){\n";
+    set_operation_emit(k, kind, 'a', "lvalues[start1]", result, write);
+    k <<
+        "}\n" <<
+        "for(; start2 < end2; start2++){\n";
+    set_operation_emit(k, kind, 'b', "lvalues[start2]", result, write);
+    k <<
+        "}\n";
+    if(!write){
+        k << offsets[k.var<uint_>("i")] << " = index;\n";
+    }
+    k <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(tile_count_arg, static_cast<uint_>(tile_count));
+
+    const size_t work_group_count =
+        (tile_count + work_group_size - 1) / work_group_size;
+    queue.enqueue_1d_range_kernel(
+        kernel, 0, work_group_count * work_group_size, work_group_size
+    );
+}
+
+// returns the number of values per tile for set operations on values of
+// type T
+template<class T>
+inline size_t set_operation_tile_size(command_queue &queue)
+{
+    const device &device = queue.get_device();
+
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(device);
+
+    const bool is_cpu = !device_profile::get(device)->has_local_memory();
+    const size_t tile_size = parameters->get(
+        std::string("__boost_set_operation_") + type_name<T>(),
+        "tile_size",
+        static_cast<uint_>(is_cpu ? 256 : 8)
+    );
+
+    return (std::max)(tile_size, size_t(1));
+}
+
+// returns the size in bytes of the temporary buffers used by
+// set_operation() for ranges of count1 and count2 values of type T
+template<class T>
+inline size_t set_operation_scratch_size(size_t count1,
+                                         size_t count2,
+                                         command_queue &queue)
+{
+    if(count1 + count2 == 0){
+        return 0;
+    }
+
+    const size_t tile_size = set_operation_tile_size<T>(queue);
+    const size_t tile_count = (count1 + count2 + tile_size - 1) / tile_size;
+
+    // tile boundaries in both ranges and output offsets
+    return 3 * buffer_pool::size_class((tile_count + 1) * sizeof(uint_));
+}
+
+// computes the set operation of the sorted ranges [first1, last1) and
+// [first2, last2).
+//
+// the input is split into tiles along the balanced path (the merge path
+// with equal values of both ranges kept in the same tile). the output
+// size of each tile is counted in a first pass and scanned to get the
+// position of the output of each tile, which is then written by a second
+// pass. no temporary copy of the output is needed.
+//
+// the number of values per tile can be tuned with the "tile_size"
+// parameter of the "__boost_set_operation_<type>" object in the parameter
+// cache. serial merging of long tiles works best on CPUs while GPUs need
+// short tiles and many work-items.
+template<class InputIterator1, class InputIterator2, class OutputIterator>
+inline OutputIterator set_operation_impl(InputIterator1 first1,
+                                         InputIterator1 last1,
+                                         InputIterator2 first2,
+                                         InputIterator2 last2,
+                                         OutputIterator result,
+                                         set_operation_kind kind,
+                                         command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator1>::value_type value_type;
+    typedef typename std::iterator_traits<OutputIterator>::difference_type difference_type;
+
+    const size_t count1 = iterator_range_size(first1, last1);
+    const size_t count2 = iterator_range_size(first2, last2);
+    if(count1 + count2 == 0){
+        return result;
+    }
+
+    const device &device = queue.get_device();
+
+    const bool is_cpu = !device_profile::get(device)->has_local_memory();
+    const size_t tile_size = set_operation_tile_size<value_type>(queue);
+
+    // the values of the tiles of each work-group must fit in local memory
+    size_t work_group_size = (std::min)(size_t(is_cpu ? 16 : 128), device.max_work_group_size());
+    while(work_group_size > 1 &&
+          (work_group_size * tile_size + 1) * sizeof(value_type) > device.local_memory_size()){
+        work_group_size /= 2;
+    }
+
+    const size_t tile_count = (count1 + count2 + tile_size - 1) / tile_size;
+
+    // tile boundaries in both ranges
+    scratch_vector<uint_> tile_a(tile_count + 1, queue);
+    scratch_vector<uint_> tile_b(tile_count + 1, queue);
+
+    balanced_path_kernel tiling_kernel;
+    tiling_kernel.tile_size = static_cast<unsigned int>(tile_size);
+    tiling_kernel.set_range(first1, last1, first2, last2,
+                            tile_a.begin() + 1, tile_b.begin() + 1);
+    fill_batch first_tiles;
+    first_tiles.add(tile_a.begin(), tile_a.begin() + 1, 0);
+    first_tiles.add(tile_b.begin(), tile_b.begin() + 1, 0);
+    first_tiles.enqueue(queue);
+    tiling_kernel.exec(queue);
+
+    // count the output values of each tile, the last value will be the
+    // total after the scan
+    scratch_vector<uint_> offsets(tile_count + 1, queue);
+
+    fill_batch last_tiles;
+    last_tiles.add(tile_a.end() - 1, tile_a.end(), count1);
+    last_tiles.add(tile_b.end() - 1, tile_b.end(), count2);
+    last_tiles.add(offsets.end() - 1, offsets.end(), 0);
+    last_tiles.enqueue(queue);
+
+    set_operation_pass(
+        first1, first2, tile_a.begin(), tile_b.begin(), tile_count, tile_size,
+        offsets.begin(), result, kind, false, work_group_size, queue
+    );
+
+    exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), queue);
+
+    // write the output values of each tile
+    set_operation_pass(
+        first1, first2, tile_a.begin(), tile_b.begin(), tile_count, tile_size,
+        offsets.begin(), result, kind, true, work_group_size, queue
+    );
+
+    const uint_ total =
+        read_single_value<uint_>(offsets.get_buffer(), tile_count, queue);
+
+    return result + static_cast<difference_type>(total);
+}
+
+// returns the name of the algorithm computing the set operation kind
+inline const char* set_operation_name(set_operation_kind kind)
+{
+    switch(kind){
+    case set_operation_intersection:
+        return "set_intersection";
+    case set_operation_union:
+        return "set_union";
+    case set_operation_difference:
+        return "set_difference";
+    default:
+        return "set_symmetric_difference";
+    }
+}
+
+// returns the number of values (of both ranges together) for which the
+// temporary buffers of set_operation_impl() fit into the available device
+// memory, count is halved until they fit
+template<class T>
+inline size_t set_operation_chunk_size(size_t count, command_queue &queue)
+{
+    const size_t tile_size = set_operation_tile_size<T>(queue);
+
+    size_t chunk = count;
+    while(chunk > 2 * tile_size){
+        const size_t bytes =
+            ::boost::compute::detail::set_operation_scratch_size<T>(chunk, 0, queue);
+        if(fits_scratch_memory(bytes, bytes / 3, queue)){
+            break;
+        }
+        chunk /= 2;
+    }
+
+    return chunk;
+}
+
+// returns the lower (or upper) bounds of the value at value in the sorted
+// ranges [first1, last1) and [first2, last2). the bounds are searched for
+// on the device and written to bounds, so the kernels are the same for
+// every value.
+template<class InputIterator1, class InputIterator2, class ValueIterator>
+inline std::pair<size_t, size_t>
+set_operation_split(InputIterator1 first1,
+                    InputIterator1 last1,
+                    InputIterator2 first2,
+                    InputIterator2 last2,
+                    ValueIterator value,
+                    vectorized_binary_search_kind kind,
+                    const scratch_vector<uint_> &bounds,
+                    command_queue &queue)
+{
+    vectorized_binary_search(
+        first1, last1, value, value + 1, bounds.begin(), kind, queue
+    );
+    vectorized_binary_search(
+        first2, last2, value, value + 1, bounds.begin() + 1, kind, queue
+    );
+
+    uint_ host_bounds[2];
+    ::boost::compute::copy(bounds.begin(), bounds.end(), host_bounds, queue);
+
+    return std::make_pair(size_t(host_bounds[0]), size_t(host_bounds[1]));
+}
+
+// computes the set operation of the sorted ranges [first1, last1) and
+// [first2, last2) with set_operation_impl() on chunks of at most about
+// chunk values of both ranges, whose temporary buffers are smaller.
+//
+// both ranges are split before the same value so that all of the equal
+// values of both ranges (whose numbers determine how many of them are
+// output) are in the same chunk. a split before the value at half of the
+// chunk in the first range leaves at most half of the chunk before it in
+// that range. if more are left in the second range, both are split before
+// the value at half of the chunk in the second range instead, which is
+// smaller. runs of equal values longer than half of the chunk are kept in
+// one chunk.
+template<class InputIterator1, class InputIterator2, class OutputIterator>
+inline OutputIterator set_operation_chunked(InputIterator1 first1,
+                                            InputIterator1 last1,
+                                            InputIterator2 first2,
+                                            InputIterator2 last2,
+                                            OutputIterator result,
+                                            set_operation_kind kind,
+                                            size_t chunk,
+                                            command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator1>::difference_type difference_type1;
+    typedef typename std::iterator_traits<InputIterator2>::difference_type difference_type2;
+
+    const size_t half = (std::max)(chunk / 2, size_t(1));
+    const scratch_vector<uint_> bounds(2, queue);
+
+    for(;;){
+        const size_t count1 = iterator_range_size(first1, last1);
+        const size_t count2 = iterator_range_size(first2, last2);
+        if(count1 + count2 <= chunk){
+            return set_operation_impl(
+                first1, last1, first2, last2, result, kind, queue
+            );
+        }
+
+        std::pair<size_t, size_t> split;
+        bool split_in_second = true;
+        if(count1 > half){
+            split = set_operation_split(
+                first1, last1, first2, last2, first1 + half,
+                vectorized_search_lower_bound, bounds, queue
+            );
+            split_in_second = split.second > half;
+        }
+        if(split_in_second){
+            split = set_operation_split(
+                first1, last1, first2, last2, first2 + half,
+                vectorized_search_lower_bound, bounds, queue
+            );
+        }
+
+        // both ranges begin with the split value
+        if(split.first == 0 && split.second == 0){
+            if(split_in_second){
+                split = set_operation_split(
+                    first1, last1, first2, last2, first2 + half,
+                    vectorized_search_upper_bound, bounds, queue
+                );
+            }
+            else {
+                split = set_operation_split(
+                    first1, last1, first2, last2, first1 + half,
+                    vectorized_search_upper_bound, bounds, queue
+                );
+            }
+        }
+
+        const InputIterator1 split1 = first1 + static_cast<difference_type1>(split.first);
+        const InputIterator2 split2 = first2 + static_cast<difference_type2>(split.second);
+        result = set_operation_impl(first1, split1, first2, split2, result, kind, queue);
+
+        first1 = split1;
+        first2 = split2;
+    }
+}
+
+// computes the set operation of the sorted ranges [first1, last1) and
+// [first2, last2) with set_operation_impl(), or in chunks with
+// set_operation_chunked() if its temporary buffers for the whole ranges do
+// not fit into the available device memory or could not be allocated (the
+// output is only written after all of them were allocated)
+template<class InputIterator1, class InputIterator2, class OutputIterator>
+inline OutputIterator set_operation(InputIterator1 first1,
+                                    InputIterator1 last1,
+                                    InputIterator2 first2,
+                                    InputIterator2 last2,
+                                    OutputIterator result,
+                                    set_operation_kind kind,
+                                    command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator1>::value_type value_type;
+
+    const size_t count =
+        iterator_range_size(first1, last1) + iterator_range_size(first2, last2);
+
+    size_t chunk = set_operation_chunk_size<value_type>(count, queue);
+    if(chunk == count){
+        try {
+            return set_operation_impl(
+                first1, last1, first2, last2, result, kind, queue
+            );
+        }
+        catch(const opencl_error &e){
+            if(!is_allocation_failure(e) || count < 2){
+                throw;
+            }
+            chunk = count / 2;
+        }
+    }
+
+    BOOST_COMPUTE_DETAIL_TRACE_STRATEGY(set_operation_name(kind), "chunked")
+    return set_operation_chunked(
+        first1, last1, first2, last2, result, kind, chunk, queue
+    );
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_SET_OPERATION_HPP
@@ -0,0 +1,236 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_SET_SEARCH_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_SET_SEARCH_HPP
+
+#include <iterator>
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/detail/find_with_early_exit.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/utility/fill_batch.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns true if a set operation on a range of small_count values and a
+// range of large_count values should search each of the smaller range's
+// values in the larger range (O(small * log(large)) work) instead of
+// merging both ranges (O(small + large) work).
+//
+// the ratio of the range sizes above which searching is used can be tuned
+// with the "ratio" parameter of the "__boost_set_search_<type>" object in
+// the parameter cache.
+template<class T>
+inline bool set_operation_use_search(size_t small_count,
+                                     size_t large_count,
+                                     command_queue &queue)
+{
+    if(small_count == 0){
+        return false;
+    }
+
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(queue.get_device());
+
+    const size_t ratio = parameters->get(
+        std::string("__boost_set_search_") + type_name<T>(), "ratio", 16
+    );
+
+    return large_count / small_count >= ratio;
+}
+
+// emits code which sets the uint variable "lower" to the index of the
+// first value in [first, first + hi) which is not less than "value"
+template<class InputIterator>
+inline void set_search_lower_bound(meta_kernel &k,
+                                   InputIterator first,
+                                   const std::string &hi)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    k << "lower = 0;\n"
+      << "hi = " << hi << ";\n"
+      << "while(lower < hi){\n"
+      << "    const uint mid = lower + (hi - lower) / 2;\n"
+      << "    " << k.decl<const value_type>("x") << " = "
+      <<            first[k.var<const uint_>("mid")] << ";\n"
+      << "    if(x < value){\n"
+      << "        lower = mid + 1;\n"
+      << "    }\n"
+      << "    else {\n"
+      << "        hi = mid;\n"
+      << "    }\n"
+      << "}\n";
+}
+
+// emits code which sets "has_match" to true if the value at position "i" of
+// the sorted range [first, first + count) has a match in the sorted range
+// [search_first, search_first + search_count).
+//
+// equal values are matched in order, the value with rank r among the
+// equal values of its range matches the value of the same rank in the
+// searched range (if there are more than r equal values there). this
+// gives the multiset semantics of the merge based set operations. the
+// index of the match is stored in "match_index".
+template<class InputIterator, class SearchIterator>
+inline void set_search_match(meta_kernel &k,
+                             InputIterator first,
+                             SearchIterator search_first,
+                             size_t search_count)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    k.add_set_arg<const uint_>("search_count", static_cast<uint_>(search_count));
+
+    k << k.decl<const value_type>("value") << " = "
+      <<     first[k.var<const uint_>("i")] << ";\n"
+      << "uint lower;\n"
+      << "uint hi;\n";
+
+    // rank among the equal values before it
+    set_search_lower_bound(k, first, "i");
+    k << "const uint rank = i - lower;\n";
+
+    set_search_lower_bound(k, search_first, "search_count");
+    k << "const uint match_index = lower + rank;\n"
+      << "const bool has_match = match_index < search_count &&\n"
+      << "    !(value < " << search_first[k.var<const uint_>("match_index")] << ");\n";
+}
+
+// emits code which sets "match" to true if the value at position "i" of
+// [first, first + count) has no match in the searched range
+template<class InputIterator, class SearchIterator>
+class set_search_missing_matcher
+{
+public:
+    set_search_missing_matcher(InputIterator first,
+                               SearchIterator search_first,
+                               size_t search_count)
+        : m_first(first),
+          m_search_first(search_first),
+          m_search_count(search_count)
+    {
+    }
+
+    void operator()(meta_kernel &k) const
+    {
+        set_search_match(k, m_first, m_search_first, m_search_count);
+        k << "match = !has_match;\n";
+    }
+
+private:
+    InputIterator m_first;
+    SearchIterator m_search_first;
+    size_t m_search_count;
+};
+
+// returns true if every value of [first, first + count) has a match in
+// [search_first, search_first + search_count). the search stops early at
+// the first value without a match.
+template<class InputIterator, class SearchIterator>
+inline bool set_search_includes(InputIterator first,
+                                size_t count,
+                                SearchIterator search_first,
+                                size_t search_count,
+                                command_queue &queue)
+{
+    return find_with_early_exit(
+        count,
+        set_search_missing_matcher<InputIterator, SearchIterator>(
+            first, search_first, search_count
+        ),
+        false,
+        queue
+    ) == count;
+}
+
+// copies the values of [first, first + count) which have a match in the
+// searched range (or, if matched is false, which have none) to result and
+// returns the end of the output. if from_search is true the matching value
+// of the searched range is copied instead of the searched value.
+//
+// one pass searches each value and stores whether it is copied, the flags
+// are scanned to the output positions and a second pass copies the values.
+template<class InputIterator, class SearchIterator, class OutputIterator>
+inline OutputIterator set_search_copy(InputIterator first,
+                                      size_t count,
+                                      SearchIterator search_first,
+                                      size_t search_count,
+                                      OutputIterator result,
+                                      bool matched,
+                                      bool from_search,
+                                      command_queue &queue)
+{
+    typedef typename std::iterator_traits<OutputIterator>::difference_type difference_type;
+
+    scratch_vector<uint_> offsets(count + 1, queue);
+    scratch_vector<uint_> sources(from_search ? count : 1, queue);
+
+    fill_batch last_offset;
+    last_offset.add(offsets.end() - 1, offsets.end(), 0);
+    last_offset.enqueue(queue);
+
+    meta_kernel search_kernel("set_search");
+    search_kernel << "const uint i = get_global_id(0);\n";
+    set_search_match(search_kernel, first, search_first, search_count);
+    search_kernel
+        << offsets.begin()[search_kernel.var<const uint_>("i")] << " = "
+        << (matched ? "has_match" : "!has_match") << ";\n";
+    if(from_search){
+        search_kernel
+            << sources.begin()[search_kernel.var<const uint_>("i")]
+            << " = match_index;\n";
+    }
+    search_kernel.exec_1d(queue, 0, count);
+
+    exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), queue);
+
+    meta_kernel copy_kernel("set_search_copy");
+    copy_kernel
+        << "const uint i = get_global_id(0);\n"
+        << "const uint index = " << offsets.begin()[copy_kernel.var<const uint_>("i")] << ";\n"
+        << "if(index != " << offsets.begin()[copy_kernel.expr<const uint_>("i+1")] << "){\n";
+    if(from_search){
+        copy_kernel
+            << "    const uint source = " << sources.begin()[copy_kernel.var<const uint_>("i")] << ";\n"
+            << "    " << result[copy_kernel.var<const uint_>("index")] << " = "
+            <<            search_first[copy_kernel.var<const uint_>("source")] << ";\n";
+    }
+    else {
+        copy_kernel
+            << "    " << result[copy_kernel.var<const uint_>("index")] << " = "
+            <<            first[copy_kernel.var<const uint_>("i")] << ";\n";
+    }
+    copy_kernel << "}\n";
+    copy_kernel.exec_1d(queue, 0, count);
+
+    const uint_ total =
+        read_single_value<uint_>(offsets.get_buffer(), count, queue);
+
+    return result + static_cast<difference_type>(total);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_SET_SEARCH_HPP
@@ -0,0 +1,248 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_SINGLE_PASS_SCAN_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_SINGLE_PASS_SCAN_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/sub_group.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// number of values scanned by each work-item of the single-pass scan
+static const size_t single_pass_scan_items_per_thread = 4;
+
+// default minimum size for the single-pass scan. smaller inputs only need
+// a few levels of the multi-pass scan and do not benefit from it.
+static const size_t single_pass_scan_default_threshold = 1 << 18;
+
+// returns true if the single-pass scan should be used for count values
+// of type T on the queue's device.
+//
+// the single-pass scan relies on the OpenCL 2.0 memory model to pass
+// the prefix of each block to the next one with acquire/release atomics,
+// so it is restricted to GPUs whose compiler supports them (see
+// memory_model_options()). other devices use the multi-pass scan. the
+// threshold can be changed with the "single_pass_threshold" parameter of
+// the "__boost_scan_<type>" object in the parameter cache (zero disables
+// the single-pass scan).
+template<class T>
+inline bool use_single_pass_scan(size_t count, command_queue &queue)
+{
+    const device &device = queue.get_device();
+
+    if(!device_profile::get(device)->has_local_memory() ||
+       memory_model_options(device).empty()){
+        return false;
+    }
+
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(device);
+
+    const uint_ threshold = parameters->get(
+        std::string("__boost_scan_") + type_name<T>(),
+        "single_pass_threshold",
+        static_cast<uint_>(single_pass_scan_default_threshold)
+    );
+
+    return threshold != 0 && count >= threshold;
+}
+
+// single-pass scan with decoupled look-back.
+//
+// each work-group takes the next tile of the input (in the order the
+// work-groups start running, from an atomic counter, so all preceding
+// tiles are guaranteed to be in progress) and reduces it. it then
+// publishes the aggregate of its tile and walks back over the preceding
+// tiles, summing their aggregates until it finds one whose inclusive
+// prefix is already known. finally it publishes its own inclusive prefix
+// and writes the scanned tile. every value is read and written only once.
+//
+// the state of each tile is 0 (not ready), 1 (aggregate available) or 2
+// (inclusive prefix available). state[0] is the tile counter.
+template<class InputIterator, class OutputIterator>
+inline OutputIterator single_pass_scan(InputIterator first,
+                                       InputIterator last,
+                                       OutputIterator result,
+                                       bool exclusive,
+                                       command_queue &queue)
+{
+    typedef typename
+        std::iterator_traits<InputIterator>::value_type
+        value_type;
+    typedef typename
+        std::iterator_traits<OutputIterator>::difference_type
+        difference_type;
+
+    const context &context = queue.get_context();
+    const size_t count = iterator_range_size(first, last);
+
+    size_t work_group_size = (std::min)(
+        size_t(256), device_profile::get(queue.get_device())->max_work_group_size()
+    );
+    size_t power = 1;
+    while(power * 2 <= work_group_size){
+        power *= 2;
+    }
+    work_group_size = power;
+
+    const uint_ items_per_thread = single_pass_scan_items_per_thread;
+    const size_t tile_size = work_group_size * items_per_thread;
+    const size_t tile_count = (count + tile_size - 1) / tile_size;
+
+    scratch_vector<uint_> state(tile_count + 1, queue);
+    scratch_vector<value_type> aggregates(tile_count, queue);
+    scratch_vector<value_type> prefixes(tile_count, queue);
+
+    ::boost::compute::fill(state.begin(), state.end(), uint_(0), queue);
+
+    meta_kernel k("single_pass_scan");
+    size_t state_arg = k.add_arg<uint_ *>(memory_object::global_memory, "state");
+    size_t aggregates_arg =
+        k.add_arg<value_type *>(memory_object::global_memory, "aggregates");
+    size_t prefixes_arg =
+        k.add_arg<value_type *>(memory_object::global_memory, "prefixes");
+    size_t scratch_arg =
+        k.add_arg<value_type *>(memory_object::local_memory, "scratch");
+    size_t count_arg = k.add_arg<const uint_>("count");
+
+    k <<
+        "__local uint tile_id;\n" <<
+        "__local " << k.type<value_type>() << " tile_prefix;\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint wg_size = get_local_size(0);\n" <<
+
+        // take the next tile
+        "if(lid == 0){\n" <<
+        "    tile_id = atomic_fetch_add_explicit(\n" <<
+        "        (volatile __global atomic_uint *) &state[0], 1u,\n" <<
+        "        memory_order_relaxed, memory_scope_device);\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "const uint tile = tile_id;\n" <<
+        "const uint start = (tile * wg_size + lid) * " << items_per_thread << ";\n" <<
+
+        // load and reduce the values of the work-item
+        k.type<value_type>() << " items[" << items_per_thread << "];\n" <<
+        k.decl<value_type>("sum") << " = 0;\n" <<
+        "for(uint j = 0; j < " << items_per_thread << "; j++){\n" <<
+        "    const uint idx = start + j;\n" <<
+        "    if(idx < count){\n" <<
+        "        items[j] = " << first[k.var<const uint_>("idx")] << ";\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        items[j] = 0;\n" <<
+        "    }\n" <<
+        "    sum = sum + items[j];\n" <<
+        "}\n" <<
+
+        // inclusive scan of the work-item sums
+        "scratch[lid] = sum;\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(uint i = 1; i < wg_size; i <<= 1){\n" <<
+        "    " << k.decl<const value_type>("x") << " = lid >= i ? scratch[lid-i] : 0;\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    if(lid >= i){\n" <<
+        "        scratch[lid] = scratch[lid] + x;\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n" <<
+
+        // publish the tile's aggregate and look back for its prefix
+        "if(lid == 0){\n" <<
+        "    " << k.decl<const value_type>("aggregate") << " = scratch[wg_size-1];\n" <<
+        "    " << k.decl<value_type>("prefix") << " = 0;\n" <<
+        "    if(tile == 0){\n" <<
+        "        prefixes[0] = aggregate;\n" <<
+        "        atomic_store_explicit((volatile __global atomic_uint *) &state[1], 2u,\n" <<
+        "                              memory_order_release, memory_scope_device);\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        aggregates[tile] = aggregate;\n" <<
+        "        atomic_store_explicit((volatile __global atomic_uint *) &state[tile+1], 1u,\n" <<
+        "                              memory_order_release, memory_scope_device);\n" <<
+        "        uint j = tile;\n" <<
+        "        while(j > 0){\n" <<
+        "            const uint status = atomic_load_explicit(\n" <<
+        "                (volatile __global atomic_uint *) &state[j],\n" <<
+        "                memory_order_acquire, memory_scope_device);\n" <<
+        "            if(status == 2){\n" <<
+        "                prefix = prefixes[j-1] + prefix;\n" <<
+        "                break;\n" <<
+        "            }\n" <<
+        "            else if(status == 1){\n" <<
+        "                prefix = aggregates[j-1] + prefix;\n" <<
+        "                j--;\n" <<
+        "            }\n" <<
+        "        }\n" <<
+        "        prefixes[tile] = prefix + aggregate;\n" <<
+        "        atomic_store_explicit((volatile __global atomic_uint *) &state[tile+1], 2u,\n" <<
+        "                              memory_order_release, memory_scope_device);\n" <<
+        "    }\n" <<
+        "    tile_prefix = prefix;\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+
+        // write the scanned values
+        k.decl<value_type>("running") << " = lid > 0 ? tile_prefix + scratch[lid-1] : tile_prefix;\n" <<
+        "for(uint j = 0; j < " << items_per_thread << "; j++){\n" <<
+        "    const uint idx = start + j;\n" <<
+        "    if(idx < count){\n";
+    if(exclusive){
+        k <<
+        "        " << result[k.var<const uint_>("idx")] << " = running;\n" <<
+        "        running = running + items[j];\n";
+    }
+    else {
+        k <<
+        "        running = running + items[j];\n" <<
+        "        " << result[k.var<const uint_>("idx")] << " = running;\n";
+    }
+    k <<
+        "    }\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(context, memory_model_options(queue.get_device()));
+    kernel.set_arg(state_arg, state.get_buffer());
+    kernel.set_arg(aggregates_arg, aggregates.get_buffer());
+    kernel.set_arg(prefixes_arg, prefixes.get_buffer());
+    kernel.set_arg(scratch_arg, local_buffer<value_type>(work_group_size));
+    kernel.set_arg(count_arg, static_cast<uint_>(count));
+
+    queue.enqueue_1d_range_kernel(
+        kernel, 0, tile_count * work_group_size, work_group_size
+    );
+
+    return result + static_cast<difference_type>(count);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_SINGLE_PASS_SCAN_HPP
@@ -0,0 +1,196 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_STABLE_PARTITION_COPY_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_STABLE_PARTITION_COPY_HPP
+
+#include <algorithm>
+#include <iterator>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// copies the values of [first, first + count) for which predicate returns
+// true to first_true and the others to first_false, both in their original
+// order, and returns the number of true values. if falses_follow_trues is
+// set the false values are written to first_true right after the true
+// values instead (first_false is then only used for its type).
+//
+// like stream_compact() the input is split into one chunk per work-group
+// whose true values are counted by a first kernel and scanned to get the
+// offset of each chunk. the position of both kinds of values follows from
+// that one scan: the value with index i is preceded by t true values and
+// thus by i - t false values. the input is read once by each kernel and
+// only the per-chunk counts are stored in global memory.
+template<class InputIterator,
+         class OutputIterator1,
+         class OutputIterator2,
+         class UnaryPredicate>
+inline size_t stable_partition_copy(InputIterator first,
+                                    size_t count,
+                                    OutputIterator1 first_true,
+                                    OutputIterator2 first_false,
+                                    UnaryPredicate predicate,
+                                    bool falses_follow_trues,
+                                    command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    if(count == 0){
+        return 0;
+    }
+
+    const device &device = queue.get_device();
+    const context &context = queue.get_context();
+
+    const size_t work_group_size = stream_compact_work_group_size(queue);
+
+    const size_t max_work_group_count = (std::max)(size_t(1), size_t(device.compute_units() * 4));
+    const size_t work_group_count = (std::min)(
+        max_work_group_count,
+        (count + 4 * work_group_size - 1) / (4 * work_group_size)
+    );
+
+    const size_t tiles = (count + work_group_size - 1) / work_group_size;
+    const size_t chunk =
+        ((tiles + work_group_count - 1) / work_group_count) * work_group_size;
+
+    // one extra value for the total number of true values
+    scratch_vector<uint_> offsets(work_group_count + 1, queue);
+
+    // count the true values in each chunk
+    meta_kernel k1("stable_partition_copy_count");
+    size_t count_arg1 = k1.add_arg<const uint_>("count");
+    size_t chunk_arg1 = k1.add_arg<const uint_>("chunk");
+
+    k1 <<
+        "__local uint scratch[" << work_group_size << "];\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint start = get_group_id(0) * chunk;\n" <<
+        "const uint end = min(start + chunk, count);\n" <<
+        "uint n = 0;\n" <<
+        "for(uint i = start + lid; i < end; i += get_local_size(0)){\n" <<
+        "    if(" << predicate(first[k1.var<uint_>("i")]) << "){\n" <<
+        "        n++;\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "scratch[lid] = n;\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(uint offset = get_local_size(0) / 2; offset > 0; offset >>= 1){\n" <<
+        "    if(lid < offset){\n" <<
+        "        scratch[lid] += scratch[lid + offset];\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n" <<
+        "if(lid == 0){\n" <<
+        "    " << offsets.begin()[k1.var<uint_>("get_group_id(0)")] << " = scratch[0];\n" <<
+        "}\n" <<
+        "if(get_global_id(0) == 0){\n" <<
+        "    " << offsets.begin()[k1.var<uint_>("get_num_groups(0)")] << " = 0;\n" <<
+        "}\n";
+
+    kernel kernel1 = k1.compile(context);
+    kernel1.set_arg(count_arg1, static_cast<uint_>(count));
+    kernel1.set_arg(chunk_arg1, static_cast<uint_>(chunk));
+    queue.enqueue_1d_range_kernel(
+        kernel1, 0, work_group_count * work_group_size, work_group_size
+    );
+
+    ::boost::compute::exclusive_scan(
+        offsets.begin(), offsets.end(), offsets.begin(), queue
+    );
+
+    // write the values of each chunk to both outputs
+    meta_kernel k2("stable_partition_copy_write");
+    size_t count_arg2 = k2.add_arg<const uint_>("count");
+    size_t chunk_arg2 = k2.add_arg<const uint_>("chunk");
+
+    k2 <<
+        "__local uint scratch[" << work_group_size << "];\n" <<
+        "__local uint base;\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint wg_size = get_local_size(0);\n" <<
+        "const uint start = get_group_id(0) * chunk;\n" <<
+        "const uint end = min(start + chunk, count);\n" <<
+        "const uint false_base = ";
+    if(falses_follow_trues){
+        k2 << offsets.begin()[k2.var<uint_>("get_num_groups(0)")] << ";\n";
+    }
+    else {
+        k2 << "0;\n";
+    }
+    k2 <<
+        "if(lid == 0){\n" <<
+        "    base = " << offsets.begin()[k2.var<uint_>("get_group_id(0)")] << ";\n" <<
+        "}\n" <<
+        "for(uint tile = start; tile < end; tile += wg_size){\n" <<
+        "    const uint i = tile + lid;\n" <<
+        "    " << k2.decl<value_type>("value") << ";\n" <<
+        "    uint flag = 0;\n" <<
+        "    if(i < end){\n" <<
+        "        value = " << first[k2.var<uint_>("i")] << ";\n" <<
+        "        flag = " << predicate(k2.var<value_type>("value")) << " ? 1 : 0;\n" <<
+        "    }\n" <<
+
+        // inclusive prefix sum of the flags of the tile
+        "    scratch[lid] = flag;\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    for(uint offset = 1; offset < wg_size; offset <<= 1){\n" <<
+        "        const uint x = lid >= offset ? scratch[lid - offset] : 0;\n" <<
+        "        barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "        scratch[lid] += x;\n" <<
+        "        barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    }\n" <<
+        "    const uint trues_before = base + scratch[lid] - flag;\n" <<
+        "    if(flag){\n" <<
+        "        " << first_true[k2.var<uint_>("trues_before")] << " = value;\n" <<
+        "    }\n" <<
+        "    else if(i < end){\n" <<
+        "        ";
+    if(falses_follow_trues){
+        k2 << first_true[k2.var<uint_>("false_base + i - trues_before")];
+    }
+    else {
+        k2 << first_false[k2.var<uint_>("false_base + i - trues_before")];
+    }
+    k2 << " = value;\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    if(lid == wg_size - 1){\n" <<
+        "        base += scratch[lid];\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n";
+
+    kernel kernel2 = k2.compile(context);
+    kernel2.set_arg(count_arg2, static_cast<uint_>(count));
+    kernel2.set_arg(chunk_arg2, static_cast<uint_>(chunk));
+    queue.enqueue_1d_range_kernel(
+        kernel2, 0, work_group_count * work_group_size, work_group_size
+    );
+
+    return read_single_value<uint_>(offsets.get_buffer(), work_group_count, queue);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_STABLE_PARTITION_COPY_HPP
@@ -0,0 +1,649 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_STREAM_COMPACT_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_STREAM_COMPACT_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/detail/adjacent_tile.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/sub_group.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/detail/work_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// selects the values for which predicate returns true (copy_if)
+template<class InputIterator, class Predicate>
+struct stream_compact_if
+{
+    stream_compact_if(InputIterator first_, Predicate predicate_)
+        : first(first_),
+          predicate(predicate_)
+    {
+    }
+
+    // writes the condition for selecting the value with index i
+    void select(meta_kernel &k) const
+    {
+        k << predicate(first[k.var<uint_>("i")]);
+    }
+
+    InputIterator first;
+    Predicate predicate;
+};
+
+// selects the first value and each value for which op returns false
+// when compared with the previous value (unique_copy)
+template<class InputIterator, class BinaryPredicate>
+struct stream_compact_unique
+{
+    stream_compact_unique(InputIterator first_, BinaryPredicate op_)
+        : first(first_),
+          op(op_)
+    {
+    }
+
+    void select(meta_kernel &k) const
+    {
+        k << "i == 0 || !(" <<
+             op(first[k.var<uint_>("i-1")], first[k.var<uint_>("i")]) << ")";
+    }
+
+    InputIterator first;
+    BinaryPredicate op;
+};
+
+// selects the values for which predicate returns true and stores the
+// result of op for them instead of the values (transform_if)
+template<class InputIterator, class UnaryFunction, class Predicate>
+struct stream_compact_transform_if
+{
+    stream_compact_transform_if(InputIterator first_,
+                                UnaryFunction op_,
+                                Predicate predicate_)
+        : first(first_),
+          op(op_),
+          predicate(predicate_)
+    {
+    }
+
+    void select(meta_kernel &k) const
+    {
+        k << predicate(first[k.var<uint_>("i")]);
+    }
+
+    InputIterator first;
+    UnaryFunction op;
+    Predicate predicate;
+};
+
+// writes code loading the values needed by selector for the tile of the
+// single-pass stream compaction into local memory. selectors only looking
+// at the value itself do not need to load anything.
+template<class Selector>
+inline void stream_compact_load_tile(meta_kernel &, const Selector &, size_t)
+{
+}
+
+// writes the condition for selecting the value with index i of the tile
+template<class Selector>
+inline void stream_compact_select_in_tile(meta_kernel &k, const Selector &selector)
+{
+    selector.select(k);
+}
+
+// unique_copy() compares each value with its predecessor, both are loaded
+// to local memory once per tile instead of reading each value twice
+template<class InputIterator, class BinaryPredicate>
+inline void
+stream_compact_load_tile(meta_kernel &k,
+                         const stream_compact_unique<InputIterator, BinaryPredicate> &selector,
+                         size_t work_group_size)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    k << "__local " << k.type<value_type>() << " tile[" << uint_(work_group_size + 1) << "];\n";
+    load_adjacent_tile(k, selector.first, "tile");
+}
+
+template<class InputIterator, class BinaryPredicate>
+inline void
+stream_compact_select_in_tile(meta_kernel &k,
+                              const stream_compact_unique<InputIterator, BinaryPredicate> &selector)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    k << "i == 0 || !(" <<
+         selector.op(k.var<value_type>("tile[lid]"), k.var<value_type>("tile[lid+1]")) << ")";
+}
+
+// writes the value stored for the selected value with index i (or the
+// index itself if copy_index is true)
+template<class InputIterator, class Selector>
+inline void stream_compact_write_value(meta_kernel &k,
+                                       InputIterator first,
+                                       const Selector &,
+                                       bool copy_index)
+{
+    if(copy_index){
+        k << "i";
+    }
+    else {
+        k << first[k.var<uint_>("i")];
+    }
+}
+
+// transform_if() stores the transformed value
+template<class InputIterator, class UnaryFunction, class Predicate>
+inline void
+stream_compact_write_value(meta_kernel &k,
+                           InputIterator first,
+                           const stream_compact_transform_if<InputIterator, UnaryFunction, Predicate> &selector,
+                           bool copy_index)
+{
+    (void) first;
+    (void) copy_index;
+
+    k << selector.op(selector.first[k.var<uint_>("i")]);
+}
+
+// returns the work-group size for the stream compaction kernels
+inline size_t stream_compact_work_group_size(command_queue &queue)
+{
+    const boost::shared_ptr<device_profile> profile =
+        device_profile::get(queue.get_device());
+
+    size_t work_group_size = (std::min)(size_t(256), profile->max_work_group_size());
+    work_group_size = (std::min)(
+        work_group_size,
+        static_cast<size_t>(profile->local_memory_size() / sizeof(uint_))
+    );
+
+    // round down to a power of two
+    size_t power = 1;
+    while(power * 2 <= work_group_size){
+        power *= 2;
+    }
+
+    return power;
+}
+
+// default minimum size for the single-pass stream compaction
+static const size_t single_pass_stream_compact_default_threshold = 1 << 16;
+
+// returns true if the single-pass stream compaction should be used for
+// count values on the queue's device. like the single-pass scan it needs
+// the atomics of the opencl 2.0 memory model for the look-back between
+// work-groups (see memory_model_options()), other devices use the
+// two-pass stream compaction. the
+// threshold can be changed with the "single_pass_threshold" parameter of
+// the "__boost_stream_compact" object in the parameter cache (zero
+// disables the single-pass stream compaction).
+inline bool use_single_pass_stream_compact(size_t count, command_queue &queue)
+{
+    const device &device = queue.get_device();
+
+    if(!device_profile::get(device)->has_local_memory() ||
+       memory_model_options(device).empty()){
+        return false;
+    }
+
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(device);
+
+    const uint_ threshold = parameters->get(
+        "__boost_stream_compact",
+        "single_pass_threshold",
+        static_cast<uint_>(single_pass_stream_compact_default_threshold)
+    );
+
+    return threshold != 0 && count >= threshold;
+}
+
+// builds the kernel of the single-pass stream compaction for work-groups
+// of work_group_size work-items with the memory model build options. its
+// arguments are the tile states, the aggregates and the inclusive prefixes
+// of the tiles and the input size.
+template<class InputIterator, class OutputIterator, class Selector>
+inline kernel single_pass_stream_compact_kernel(InputIterator first,
+                                                OutputIterator result,
+                                                const Selector &selector,
+                                                bool copy_index,
+                                                size_t work_group_size,
+                                                const context &context,
+                                                const std::string &options)
+{
+    meta_kernel k("single_pass_stream_compact");
+    k.add_arg<uint_ *>(memory_object::global_memory, "state");
+    k.add_arg<uint_ *>(memory_object::global_memory, "aggregates");
+    k.add_arg<uint_ *>(memory_object::global_memory, "prefixes");
+    k.add_arg<const uint_>("count");
+
+    k <<
+        "__local uint tile_id;\n" <<
+        "__local uint tile_prefix;\n" <<
+        "__local uint scratch[" << uint_(work_group_size) << "];\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint wg_size = get_local_size(0);\n" <<
+
+        // take the next tile
+        "if(lid == 0){\n" <<
+        "    tile_id = atomic_fetch_add_explicit(\n" <<
+        "        (volatile __global atomic_uint *) &state[0], 1u,\n" <<
+        "        memory_order_relaxed, memory_scope_device);\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "const uint tile = tile_id;\n" <<
+        "const uint tile_start = tile * wg_size;\n" <<
+        "const uint i = tile_start + lid;\n";
+    stream_compact_load_tile(k, selector, work_group_size);
+    k <<
+        "uint flag = 0;\n" <<
+        "if(i < count && (";
+    stream_compact_select_in_tile(k, selector);
+    k << ")){\n" <<
+        "    flag = 1;\n" <<
+        "}\n" <<
+
+        // inclusive prefix sum of the flags of the tile
+        "scratch[lid] = flag;\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(uint offset = 1; offset < wg_size; offset <<= 1){\n" <<
+        "    const uint x = lid >= offset ? scratch[lid - offset] : 0;\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    scratch[lid] += x;\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n" <<
+
+        // publish the number of selected values in the tile and look back
+        // for the number selected before it
+        "if(lid == 0){\n" <<
+        "    const uint aggregate = scratch[wg_size-1];\n" <<
+        "    uint prefix = 0;\n" <<
+        "    if(tile == 0){\n" <<
+        "        prefixes[0] = aggregate;\n" <<
+        "        atomic_store_explicit((volatile __global atomic_uint *) &state[1], 2u,\n" <<
+        "                              memory_order_release, memory_scope_device);\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        aggregates[tile] = aggregate;\n" <<
+        "        atomic_store_explicit((volatile __global atomic_uint *) &state[tile+1], 1u,\n" <<
+        "                              memory_order_release, memory_scope_device);\n" <<
+        "        uint j = tile;\n" <<
+        "        while(j > 0){\n" <<
+        "            const uint status = atomic_load_explicit(\n" <<
+        "                (volatile __global atomic_uint *) &state[j],\n" <<
+        "                memory_order_acquire, memory_scope_device);\n" <<
+        "            if(status == 2){\n" <<
+        "                prefix += prefixes[j-1];\n" <<
+        "                break;\n" <<
+        "            }\n" <<
+        "            else if(status == 1){\n" <<
+        "                prefix += aggregates[j-1];\n" <<
+        "                j--;\n" <<
+        "            }\n" <<
+        "        }\n" <<
+        "        prefixes[tile] = prefix + aggregate;\n" <<
+        "        atomic_store_explicit((volatile __global atomic_uint *) &state[tile+1], 2u,\n" <<
+        "                              memory_order_release, memory_scope_device);\n" <<
+        "    }\n" <<
+        "    tile_prefix = prefix;\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+
+        // write the selected values
+        "if(flag){\n" <<
+        "    " << result[k.var<uint_>("tile_prefix + scratch[lid] - 1")] << " = ";
+    stream_compact_write_value(k, first, selector, copy_index);
+    k << ";\n" <<
+        "}\n";
+
+    return k.compile(context, options);
+}
+
+// single-pass stream compaction, which selects the values, scans the
+// selection flags and writes the selected values in one kernel.
+//
+// each work-group takes the next tile of the input from an atomic counter,
+// lets the selector load what it needs into local memory (e.g. the
+// neighbouring values for unique_copy()), scans the flags of the tile in
+// local memory and finds the output offset of the tile with the same
+// decoupled look-back over the counts of the preceding tiles as
+// single_pass_scan(). the input is read once and no per-value flags or
+// indices are stored in global memory.
+template<class InputIterator, class OutputIterator, class Selector>
+inline OutputIterator single_pass_stream_compact(InputIterator first,
+                                                 size_t count,
+                                                 OutputIterator result,
+                                                 const Selector &selector,
+                                                 bool copy_index,
+                                                 command_queue &queue)
+{
+    typedef typename
+        std::iterator_traits<OutputIterator>::difference_type
+        difference_type;
+
+    const context &context = queue.get_context();
+    const std::string options = memory_model_options(queue.get_device());
+
+    // the local memory of the kernel is sized for the work-group size, so
+    // the kernel is rebuilt with a smaller size if its registers or private
+    // memory do not allow work-groups of that size
+    size_t work_group_size = stream_compact_work_group_size(queue);
+    kernel kernel = single_pass_stream_compact_kernel(
+        first, result, selector, copy_index, work_group_size, context, options
+    );
+    const size_t limit =
+        kernel_work_group_size(kernel, queue.get_device(), work_group_size);
+    if(limit < work_group_size){
+        work_group_size = limit;
+        kernel = single_pass_stream_compact_kernel(
+            first, result, selector, copy_index, work_group_size, context, options
+        );
+    }
+
+    const size_t tile_count = (count + work_group_size - 1) / work_group_size;
+
+    scratch_vector<uint_> state(tile_count + 1, queue);
+    scratch_vector<uint_> aggregates(tile_count, queue);
+    scratch_vector<uint_> prefixes(tile_count, queue);
+
+    ::boost::compute::fill(state.begin(), state.end(), uint_(0), queue);
+
+    kernel.set_arg(0, state.get_buffer());
+    kernel.set_arg(1, aggregates.get_buffer());
+    kernel.set_arg(2, prefixes.get_buffer());
+    kernel.set_arg(3, static_cast<uint_>(count));
+
+    queue.enqueue_1d_range_kernel(
+        kernel, 0, tile_count * work_group_size, work_group_size
+    );
+
+    const uint_ selected =
+        read_single_value<uint_>(prefixes.get_buffer(), tile_count - 1, queue);
+
+    return result + static_cast<difference_type>(selected);
+}
+
+// stream compaction for cpu devices. each work-item counts the selected
+// values of a contiguous chunk of the input, the counts are scanned and
+// each work-item then writes the selected values of its chunk serially,
+// without local memory or barriers.
+template<class InputIterator, class OutputIterator, class Selector>
+inline OutputIterator stream_compact_on_cpu(InputIterator first,
+                                            size_t count,
+                                            OutputIterator result,
+                                            const Selector &selector,
+                                            bool copy_index,
+                                            command_queue &queue)
+{
+    typedef typename
+        std::iterator_traits<OutputIterator>::difference_type
+        difference_type;
+
+    if(count == 0){
+        return result;
+    }
+
+    const context &context = queue.get_context();
+
+    const size_t work_items =
+        cpu_work_item_count(count, 4096, queue.get_device());
+    const size_t chunk = (count + work_items - 1) / work_items;
+
+    // one extra value for the total number of selected values
+    scratch_vector<uint_> offsets(work_items + 1, queue);
+
+    // count the selected values in each chunk
+    meta_kernel k1("stream_compact_on_cpu_count");
+    size_t count_arg1 = k1.add_arg<const uint_>("count");
+    size_t chunk_arg1 = k1.add_arg<const uint_>("chunk");
+
+    k1 <<
+        "const uint start = get_global_id(0) * chunk;\n" <<
+        "const uint end = min(start + chunk, count);\n" <<
+        "uint n = 0;\n" <<
+        "for(uint i = start; i < end; i++){\n" <<
+        "    if(";
+    selector.select(k1);
+    k1 << "){\n" <<
+        "        n++;\n" <<
+        "    }\n" <<
+        "}\n" <<
+        offsets.begin()[k1.var<uint_>("get_global_id(0)")] << " = n;\n" <<
+        "if(get_global_id(0) == 0){\n" <<
+        "    " << offsets.begin()[k1.var<uint_>("get_global_size(0)")] << " = 0;\n" <<
+        "}\n";
+
+    kernel kernel1 = k1.compile(context);
+    kernel1.set_arg(count_arg1, static_cast<uint_>(count));
+    kernel1.set_arg(chunk_arg1, static_cast<uint_>(chunk));
+    queue.enqueue_1d_range_kernel(kernel1, 0, work_items, 1);
+
+    // offset of each chunk in the output
+    ::boost::compute::exclusive_scan(
+        offsets.begin(), offsets.end(), offsets.begin(), queue
+    );
+
+    // write the selected values of each chunk
+    meta_kernel k2("stream_compact_on_cpu_write");
+    size_t count_arg2 = k2.add_arg<const uint_>("count");
+    size_t chunk_arg2 = k2.add_arg<const uint_>("chunk");
+
+    k2 <<
+        "const uint start = get_global_id(0) * chunk;\n" <<
+        "const uint end = min(start + chunk, count);\n" <<
+        "uint out = " << offsets.begin()[k2.var<uint_>("get_global_id(0)")] << ";\n" <<
+        "for(uint i = start; i < end; i++){\n" <<
+        "    if(";
+    selector.select(k2);
+    k2 << "){\n" <<
+        "        " << result[k2.var<uint_>("out++")] << " = ";
+    stream_compact_write_value(k2, first, selector, copy_index);
+    k2 << ";\n" <<
+        "    }\n" <<
+        "}\n";
+
+    kernel kernel2 = k2.compile(context);
+    kernel2.set_arg(count_arg2, static_cast<uint_>(count));
+    kernel2.set_arg(chunk_arg2, static_cast<uint_>(chunk));
+    queue.enqueue_1d_range_kernel(kernel2, 0, work_items, 1);
+
+    const uint_ selected =
+        read_single_value<uint_>(offsets.get_buffer(), work_items, queue);
+
+    return result + static_cast<difference_type>(selected);
+}
+
+// copies the values of [first, first + count) chosen by selector (or
+// their indices if copy_index is true) to result in their original order.
+//
+// the input is split into one contiguous chunk per work-group. the first
+// kernel counts the selected values in each chunk, the counts are then
+// scanned to get the offset of each chunk in the output and the second
+// kernel walks over its chunk tile by tile, computing the position of each
+// selected value with a prefix sum in local memory. apart from the output
+// only two values per work-group are stored in global memory.
+template<class InputIterator, class OutputIterator, class Selector>
+inline OutputIterator stream_compact(InputIterator first,
+                                     size_t count,
+                                     OutputIterator result,
+                                     const Selector &selector,
+                                     bool copy_index,
+                                     command_queue &queue)
+{
+    typedef typename
+        std::iterator_traits<OutputIterator>::difference_type
+        difference_type;
+
+    if(count == 0){
+        return result;
+    }
+
+    if(is_cpu_device(queue.get_device())){
+        return stream_compact_on_cpu(
+            first, count, result, selector, copy_index, queue
+        );
+    }
+
+    if(use_single_pass_stream_compact(count, queue)){
+        return single_pass_stream_compact(
+            first, count, result, selector, copy_index, queue
+        );
+    }
+
+    const device &device = queue.get_device();
+    const context &context = queue.get_context();
+
+    const size_t work_group_size = stream_compact_work_group_size(queue);
+
+    // enough work-groups to fill the device, each work-item checks at
+    // least a few values
+    const size_t max_work_group_count =
+        (std::max)(size_t(1), size_t(device_profile::get(device)->compute_units() * 4));
+    const size_t work_group_count = (std::min)(
+        max_work_group_count,
+        (count + 4 * work_group_size - 1) / (4 * work_group_size)
+    );
+
+    // number of values checked by each work-group (a multiple of the
+    // work-group size)
+    const size_t tiles = (count + work_group_size - 1) / work_group_size;
+    const size_t chunk =
+        ((tiles + work_group_count - 1) / work_group_count) * work_group_size;
+
+    // one extra value for the total number of selected values
+    scratch_vector<uint_> offsets(work_group_count + 1, queue);
+
+    // count the selected values in each chunk
+    meta_kernel k1("stream_compact_count");
+    size_t count_arg1 = k1.add_arg<const uint_>("count");
+    size_t chunk_arg1 = k1.add_arg<const uint_>("chunk");
+
+    k1 <<
+        "__local uint scratch[" << work_group_size << "];\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint start = get_group_id(0) * chunk;\n" <<
+        "const uint end = min(start + chunk, count);\n" <<
+        "uint n = 0;\n" <<
+        "for(uint i = start + lid; i < end; i += get_local_size(0)){\n" <<
+        "    if(";
+    selector.select(k1);
+    k1 << "){\n" <<
+        "        n++;\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "scratch[lid] = n;\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(uint offset = get_local_size(0) / 2; offset > 0; offset >>= 1){\n" <<
+        "    if(lid < offset){\n" <<
+        "        scratch[lid] += scratch[lid + offset];\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n" <<
+        "if(lid == 0){\n" <<
+        "    " << offsets.begin()[k1.var<uint_>("get_group_id(0)")] << " = scratch[0];\n" <<
+        "}\n" <<
+        // the last value is the start of the (empty) chunk after the input
+        "if(get_global_id(0) == 0){\n" <<
+        "    " << offsets.begin()[k1.var<uint_>("get_num_groups(0)")] << " = 0;\n" <<
+        "}\n";
+
+    kernel kernel1 = k1.compile(context);
+    kernel1.set_arg(count_arg1, static_cast<uint_>(count));
+    kernel1.set_arg(chunk_arg1, static_cast<uint_>(chunk));
+    queue.enqueue_1d_range_kernel(
+        kernel1, 0, work_group_count * work_group_size, work_group_size
+    );
+
+    // offset of each chunk in the output
+    ::boost::compute::exclusive_scan(
+        offsets.begin(), offsets.end(), offsets.begin(), queue
+    );
+
+    // write the selected values of each chunk
+    meta_kernel k2("stream_compact_write");
+    size_t count_arg2 = k2.add_arg<const uint_>("count");
+    size_t chunk_arg2 = k2.add_arg<const uint_>("chunk");
+
+    k2 <<
+        "__local uint scratch[" << work_group_size << "];\n" <<
+        "__local uint base;\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint wg_size = get_local_size(0);\n" <<
+        "const uint start = get_group_id(0) * chunk;\n" <<
+        "const uint end = min(start + chunk, count);\n" <<
+        "if(lid == 0){\n" <<
+        "    base = " << offsets.begin()[k2.var<uint_>("get_group_id(0)")] << ";\n" <<
+        "}\n" <<
+        "for(uint tile = start; tile < end; tile += wg_size){\n" <<
+        "    const uint i = tile + lid;\n" <<
+        "    uint flag = 0;\n" <<
+        "    if(i < end && (";
+    selector.select(k2);
+    k2 << ")){\n" <<
+        "        flag = 1;\n" <<
+        "    }\n" <<
+
+        // inclusive prefix sum of the flags of the tile
+        "    scratch[lid] = flag;\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    for(uint offset = 1; offset < wg_size; offset <<= 1){\n" <<
+        "        const uint x = lid >= offset ? scratch[lid - offset] : 0;\n" <<
+        "        barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "        scratch[lid] += x;\n" <<
+        "        barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    }\n" <<
+        "    if(flag){\n" <<
+        "        " << result[k2.var<uint_>("base + scratch[lid] - 1")] << " = ";
+    stream_compact_write_value(k2, first, selector, copy_index);
+    k2 << ";\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    if(lid == wg_size - 1){\n" <<
+        "        base += scratch[lid];\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n";
+
+    kernel kernel2 = k2.compile(context);
+    kernel2.set_arg(count_arg2, static_cast<uint_>(count));
+    kernel2.set_arg(chunk_arg2, static_cast<uint_>(chunk));
+    queue.enqueue_1d_range_kernel(
+        kernel2, 0, work_group_count * work_group_size, work_group_size
+    );
+
+    const uint_ selected =
+        read_single_value<uint_>(offsets.get_buffer(), work_group_count, queue);
+
+    return result + static_cast<difference_type>(selected);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_STREAM_COMPACT_HPP
@@ -0,0 +1,181 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_VECTORIZED_BINARY_SEARCH_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_VECTORIZED_BINARY_SEARCH_HPP
+
+#include <algorithm>
+#include <iterator>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// results computed by vectorized_binary_search()
+enum vectorized_binary_search_kind {
+    vectorized_search_lower_bound,
+    vectorized_search_upper_bound,
+    vectorized_search_contains,
+    vectorized_search_find
+};
+
+// searches the sorted range [first, first + count) for each of the values
+// in [values_first, values_last) with one work-item per value and writes
+// the index of its lower or upper bound, whether it was found or the index
+// of the value (count if it was not found) to result.
+//
+// each work-group first loads evenly spaced samples of the sorted range
+// into local memory, which hold the top levels of the binary search. each
+// work-item finds the interval of its value between two samples in local
+// memory and only searches that interval in global memory.
+template<class InputIterator, class ValueIterator, class OutputIterator>
+inline OutputIterator vectorized_binary_search(InputIterator first,
+                                               InputIterator last,
+                                               ValueIterator values_first,
+                                               ValueIterator values_last,
+                                               OutputIterator result,
+                                               vectorized_binary_search_kind kind,
+                                               command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename std::iterator_traits<ValueIterator>::value_type query_type;
+    typedef typename std::iterator_traits<OutputIterator>::difference_type difference_type;
+
+    const size_t count = iterator_range_size(first, last);
+    const size_t values_count = iterator_range_size(values_first, values_last);
+    if(values_count == 0){
+        return result;
+    }
+    if(count == 0){
+        // every bound is the (empty) start of the range, which is also the
+        // end of the range returned when a value is not found
+        ::boost::compute::fill_n(result, values_count, 0, queue);
+        return result + static_cast<difference_type>(values_count);
+    }
+
+    const device &device = queue.get_device();
+
+    size_t work_group_size = (std::min)(size_t(256), device.max_work_group_size());
+    work_group_size = (std::min)(
+        work_group_size,
+        static_cast<size_t>(device.local_memory_size() / sizeof(value_type))
+    );
+    size_t power = 1;
+    while(power * 2 <= work_group_size){
+        power *= 2;
+    }
+    work_group_size = power;
+
+    // no more samples than elements in the sorted range
+    const size_t sample_count = (std::min)(work_group_size, count);
+
+    meta_kernel k("vectorized_binary_search");
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t values_count_arg = k.add_arg<const uint_>("values_count");
+
+    // the condition for the lower bound is (x < value) and for the upper
+    // bound !(value < x). the bound is the first index where it is false.
+    const std::string x = "x";
+    k <<
+        "__local " << k.type<value_type>() << " lsamples[" << sample_count << "];\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint gid = get_global_id(0);\n" <<
+
+        // load the samples, sample j is the value at j * count / samples
+        "for(uint j = lid; j < " << sample_count << "; j += get_local_size(0)){\n" <<
+        "    const uint p = (uint)(((ulong) j * count) / " << sample_count << ");\n" <<
+        "    lsamples[j] = " << first[k.var<uint_>("p")] << ";\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+
+        "if(gid < values_count){\n" <<
+        "    " << k.decl<const query_type>("value") << " = " <<
+                      values_first[k.var<uint_>("gid")] << ";\n";
+
+    const char *condition = kind == vectorized_search_upper_bound ? "!(value < x)"
+                                                           : "x < value";
+
+    k <<
+        // find the number of samples for which the condition holds
+        "    uint lo = 0;\n" <<
+        "    uint hi = " << sample_count << ";\n" <<
+        "    while(lo < hi){\n" <<
+        "        const uint mid = lo + (hi - lo) / 2;\n" <<
+        "        " << k.decl<const value_type>(x) << " = lsamples[mid];\n" <<
+        "        if(" << condition << "){\n" <<
+        "            lo = mid + 1;\n" <<
+        "        }\n" <<
+        "        else {\n" <<
+        "            hi = mid;\n" <<
+        "        }\n" <<
+        "    }\n" <<
+
+        // search the interval between the two samples
+        "    if(lo == 0){\n" <<
+        "        hi = 0;\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        hi = lo < " << sample_count << " ?\n" <<
+        "            (uint)(((ulong) lo * count) / " << sample_count << ") : count;\n" <<
+        "        lo = (uint)(((ulong) (lo - 1) * count) / " << sample_count << ") + 1;\n" <<
+        "    }\n" <<
+        "    while(lo < hi){\n" <<
+        "        const uint mid = lo + (hi - lo) / 2;\n" <<
+        "        " << k.decl<const value_type>(x) << " = " << first[k.var<uint_>("mid")] << ";\n" <<
+        "        if(" << condition << "){\n" <<
+        "            lo = mid + 1;\n" <<
+        "        }\n" <<
+        "        else {\n" <<
+        "            hi = mid;\n" <<
+        "        }\n" <<
+        "    }\n";
+
+    if(kind == vectorized_search_contains){
+        k <<
+        "    " << result[k.var<uint_>("gid")] << " = lo < count && !(value < " <<
+                  first[k.var<uint_>("lo")] << ");\n";
+    }
+    else if(kind == vectorized_search_find){
+        k <<
+        "    " << result[k.var<uint_>("gid")] << " = lo < count && !(value < " <<
+                  first[k.var<uint_>("lo")] << ") ? lo : count;\n";
+    }
+    else {
+        k <<
+        "    " << result[k.var<uint_>("gid")] << " = lo;\n";
+    }
+    k <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(count_arg, static_cast<uint_>(count));
+    kernel.set_arg(values_count_arg, static_cast<uint_>(values_count));
+
+    const size_t work_group_count =
+        (values_count + work_group_size - 1) / work_group_size;
+    queue.enqueue_1d_range_kernel(
+        kernel, 0, work_group_count * work_group_size, work_group_size
+    );
+
+    return result + static_cast<difference_type>(values_count);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_VECTORIZED_BINARY_SEARCH_HPP
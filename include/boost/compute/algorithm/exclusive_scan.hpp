@@ -11,9 +11,15 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_EXCLUSIVE_SCAN_HPP
 #define BOOST_COMPUTE_ALGORITHM_EXCLUSIVE_SCAN_HPP
 
+#include <boost/static_assert.hpp>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/detail/scan.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/detail/device_future.hpp>
+#include <boost/compute/detail/enqueue_wait_list.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
 
 namespace boost {
 namespace compute {
@@ -41,9 +47,65 @@ exclusive_scan(InputIterator first,
                OutputIterator result,
                command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("exclusive_scan")
+
     return detail::scan(first, last, result, true, queue);
 }
 
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline OutputIterator
+exclusive_scan(InputIterator first,
+               InputIterator last,
+               OutputIterator result,
+               command_queue &queue,
+               const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::exclusive_scan(first, last, result, queue);
+}
+
+/// Asynchronous version of exclusive_scan() for device iterators. The
+/// returned future is ready when the scan is complete.
+///
+/// \return a future for the end of the result range
+///
+/// \see exclusive_scan(), inclusive_scan_async()
+template<class InputIterator, class OutputIterator>
+inline future<OutputIterator>
+exclusive_scan_async(InputIterator first,
+                     InputIterator last,
+                     OutputIterator result,
+                     command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("exclusive_scan_async")
+
+    BOOST_STATIC_ASSERT_MSG(
+        is_device_iterator<InputIterator>::value &&
+        is_device_iterator<OutputIterator>::value,
+        "exclusive_scan_async() is only supported for device iterators"
+    );
+
+    OutputIterator end = detail::scan(first, last, result, true, queue);
+
+    return detail::make_marker_future(end, queue);
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline future<OutputIterator>
+exclusive_scan_async(InputIterator first,
+                     InputIterator last,
+                     OutputIterator result,
+                     command_queue &queue,
+                     const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::exclusive_scan_async(first, last, result, queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -0,0 +1,204 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_EXCLUSIVE_SCAN_BY_KEY_HPP
+#define BOOST_COMPUTE_ALGORITHM_EXCLUSIVE_SCAN_BY_KEY_HPP
+
+#include <iterator>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/segmented_scan.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// shifts the inclusive segmented scan by one element within each segment
+// and combines it with init
+template<class T, class OutputIterator, class BinaryFunction>
+inline void exclusive_scan_by_key_shift(buffer_iterator<uint_> segments_first,
+                                        buffer_iterator<T> scanned_values,
+                                        size_t count,
+                                        OutputIterator result,
+                                        const T &init,
+                                        BinaryFunction function,
+                                        command_queue &queue)
+{
+    meta_kernel k("exclusive_scan_by_key_shift");
+    size_t init_arg = k.add_arg<const T>("init");
+
+    k <<
+        "const uint i = get_global_id(0);\n" <<
+        "if(i == 0 || " << segments_first[k.var<const uint_>("i")] << " != " <<
+                           segments_first[k.expr<uint_>("i - 1")] << "){\n" <<
+        "    " << result[k.var<const uint_>("i")] << " = init;\n" <<
+        "}\n" <<
+        "else {\n" <<
+        "    " << result[k.var<const uint_>("i")] << " = " <<
+                  function(k.var<const T>("init"),
+                           scanned_values[k.expr<uint_>("i - 1")]) << ";\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(init_arg, init);
+
+    queue.enqueue_1d_range_kernel(kernel, 0, count, 0);
+}
+
+} // end detail namespace
+
+/// Performs an exclusive scan of the values beginning at \p values_first
+/// within each group of consecutive equal keys in the range
+/// [\p keys_first, \p keys_last) and stores the results in the range
+/// beginning at \p result.
+///
+/// The first output value of each group is \p init and each following
+/// value is the result of applying \p function to \p init and the
+/// previous values in the group. Two consecutive keys belong to the same
+/// group if \p predicate returns \c true for them. If no predicate is
+/// given, \c equal_to is used. If no function is given, \c plus is used.
+/// If no initial value is given, zero is used.
+///
+/// All of the groups are scanned together, which makes this suitable for
+/// e.g. computing the offsets of each row of a matrix in CSR format with
+/// a single call.
+///
+/// \param keys_first first key in the range
+/// \param keys_last last key in the range
+/// \param values_first first value in the range to scan
+/// \param result first element in the result range
+/// \param init initial value of each group
+/// \param function binary scan function
+/// \param predicate binary predicate comparing consecutive keys
+/// \param queue command queue to perform the operation
+///
+/// \return \c OutputIterator to the end of the result range
+///
+/// \snippet test/test_scan_by_key.cpp exclusive_scan_by_key_int
+///
+/// \see inclusive_scan_by_key(), exclusive_scan()
+template<class InputKeyIterator,
+         class InputValueIterator,
+         class OutputIterator,
+         class T,
+         class BinaryFunction,
+         class BinaryPredicate>
+inline OutputIterator
+exclusive_scan_by_key(InputKeyIterator keys_first,
+                      InputKeyIterator keys_last,
+                      InputValueIterator values_first,
+                      OutputIterator result,
+                      T init,
+                      BinaryFunction function,
+                      BinaryPredicate predicate,
+                      command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<OutputIterator>::value_type value_type;
+    typedef typename std::iterator_traits<OutputIterator>::difference_type difference_type;
+
+    const size_t count = detail::iterator_range_size(keys_first, keys_last);
+    if(count == 0){
+        return result;
+    }
+
+    detail::scratch_vector<uint_> segments(count, queue);
+    detail::segment_ids(keys_first, count, segments.begin(), predicate, queue);
+
+    // scan into temporary storage so that values_first may equal result
+    detail::scratch_vector<value_type> scanned_values(count, queue);
+    detail::segmented_inclusive_scan(
+        segments.begin(), count, values_first, scanned_values.begin(), function, queue
+    );
+
+    detail::exclusive_scan_by_key_shift(
+        segments.begin(),
+        scanned_values.begin(),
+        count,
+        result,
+        static_cast<value_type>(init),
+        function,
+        queue
+    );
+
+    return result + static_cast<difference_type>(count);
+}
+
+/// \overload
+template<class InputKeyIterator,
+         class InputValueIterator,
+         class OutputIterator,
+         class T,
+         class BinaryFunction>
+inline OutputIterator
+exclusive_scan_by_key(InputKeyIterator keys_first,
+                      InputKeyIterator keys_last,
+                      InputValueIterator values_first,
+                      OutputIterator result,
+                      T init,
+                      BinaryFunction function,
+                      command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputKeyIterator>::value_type key_type;
+
+    return ::boost::compute::exclusive_scan_by_key(
+        keys_first, keys_last, values_first, result,
+        init, function, equal_to<key_type>(), queue
+    );
+}
+
+/// \overload
+template<class InputKeyIterator,
+         class InputValueIterator,
+         class OutputIterator,
+         class T>
+inline OutputIterator
+exclusive_scan_by_key(InputKeyIterator keys_first,
+                      InputKeyIterator keys_last,
+                      InputValueIterator values_first,
+                      OutputIterator result,
+                      T init,
+                      command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputKeyIterator>::value_type key_type;
+    typedef typename std::iterator_traits<OutputIterator>::value_type value_type;
+
+    return ::boost::compute::exclusive_scan_by_key(
+        keys_first, keys_last, values_first, result,
+        init, plus<value_type>(), equal_to<key_type>(), queue
+    );
+}
+
+/// \overload
+template<class InputKeyIterator,
+         class InputValueIterator,
+         class OutputIterator>
+inline OutputIterator
+exclusive_scan_by_key(InputKeyIterator keys_first,
+                      InputKeyIterator keys_last,
+                      InputValueIterator values_first,
+                      OutputIterator result,
+                      command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<OutputIterator>::value_type value_type;
+
+    return ::boost::compute::exclusive_scan_by_key(
+        keys_first, keys_last, values_first, result, value_type(0), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_EXCLUSIVE_SCAN_BY_KEY_HPP
@@ -0,0 +1,92 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_EXPAND_HPP
+#define BOOST_COMPUTE_ALGORITHM_EXPAND_HPP
+
+#include <iterator>
+#include <utility>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/load_balanced_search.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Expands each input in the range [\p counts_first, \p counts_last) into
+/// the number of outputs given by its count. For each output the index of
+/// its input is stored in the range beginning at \p sources and its rank
+/// within the outputs of the input in the range beginning at \p ranks.
+/// Returns the ends of the two output ranges.
+///
+/// The outputs of each input are consecutive and in the order of the
+/// inputs, so the sources and ranks can be used to gather the values of
+/// the outputs (e.g. the neighbors of the vertices of a graph in CSR
+/// format or the values of a run-length encoding). Both output ranges
+/// must have room for the sum of the counts.
+///
+/// This computes the offsets of the outputs with exclusive_scan() and
+/// then calls load_balanced_search(), so skewed counts do not leave most
+/// work-items idle.
+///
+/// For example, the counts \c { 3, 0, 1, 2 } give the sources
+/// \c { 0, 0, 0, 2, 3, 3 } and the ranks \c { 0, 1, 2, 0, 0, 1 }.
+///
+/// \see load_balanced_search()
+template<class InputIterator, class OutputIterator1, class OutputIterator2>
+inline std::pair<OutputIterator1, OutputIterator2>
+expand(InputIterator counts_first,
+       InputIterator counts_last,
+       OutputIterator1 sources,
+       OutputIterator2 ranks,
+       command_queue &queue = system::default_queue())
+{
+    typedef typename
+        std::iterator_traits<OutputIterator1>::difference_type difference_type1;
+    typedef typename
+        std::iterator_traits<OutputIterator2>::difference_type difference_type2;
+
+    const size_t count = detail::iterator_range_size(counts_first, counts_last);
+    if(count == 0){
+        return std::make_pair(sources, ranks);
+    }
+
+    // the offsets of the outputs of each input followed by their total
+    detail::scratch_vector<uint_> offsets(count + 1, queue);
+    ::boost::compute::copy(counts_first, counts_last, offsets.begin(), queue);
+    detail::write_single_value<uint_>(0, offsets.get_buffer(), count, queue);
+    ::boost::compute::exclusive_scan(
+        offsets.begin(), offsets.end(), offsets.begin(), queue
+    );
+
+    const size_t total =
+        detail::read_single_value<uint_>(offsets.get_buffer(), count, queue);
+
+    OutputIterator1 sources_last = sources + static_cast<difference_type1>(total);
+    ::boost::compute::load_balanced_search(
+        offsets.begin(), offsets.begin() + count, sources, sources_last, ranks, queue
+    );
+
+    return std::make_pair(
+        sources_last, ranks + static_cast<difference_type2>(total)
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_EXPAND_HPP
@@ -25,6 +25,9 @@
 #include <boost/compute/async/future.hpp>
 #include <boost/compute/iterator/constant_iterator.hpp>
 #include <boost/compute/iterator/discard_iterator.hpp>
+#include <boost/compute/detail/broadcast_value.hpp>
+#include <boost/compute/detail/buffer_value.hpp>
+#include <boost/compute/detail/enqueue_wait_list.hpp>
 #include <boost/compute/detail/is_buffer_iterator.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 
@@ -253,6 +256,45 @@ inline future<void> dispatch_fill_async(BufferIterator first,
 }
 #endif // !defined(CL_VERSION_1_2)
 
+// fills the range with a value stored on the device (e.g. an element of a
+// vector) which is read by the kernel instead of being copied to the host
+template<class BufferIterator, class T>
+inline void dispatch_fill(BufferIterator first,
+                          size_t count,
+                          const buffer_value<T> &value,
+                          command_queue &queue)
+{
+    if(!value.get_buffer().get()){
+        dispatch_fill(first, count, static_cast<T>(value), queue);
+        return;
+    }
+
+    ::boost::compute::copy(
+        make_broadcast_iterator(value, 0),
+        make_broadcast_iterator(value, count),
+        first,
+        queue
+    );
+}
+
+template<class BufferIterator, class T>
+inline future<void> dispatch_fill_async(BufferIterator first,
+                                        size_t count,
+                                        const buffer_value<T> &value,
+                                        command_queue &queue)
+{
+    if(!value.get_buffer().get()){
+        return dispatch_fill_async(first, count, static_cast<T>(value), queue);
+    }
+
+    return ::boost::compute::copy_async(
+        make_broadcast_iterator(value, 0),
+        make_broadcast_iterator(value, count),
+        first,
+        queue
+    );
+}
+
 } // end detail namespace
 
 /// Fills the range [\p first, \p last) with \p value.
@@ -271,6 +313,10 @@ inline future<void> dispatch_fill_async(BufferIterator first,
 /// boost::compute::fill(vec.begin(), vec.end(), 7, queue);
 /// \endcode
 ///
+/// The value can also be an element of a device container (e.g.
+/// \c vec[0] or the result of reduce() stored in a vector). In that case it
+/// is read by the kernel on the device and never copied to the host.
+///
 /// \see boost::compute::fill_n()
 template<class BufferIterator, class T>
 inline void fill(BufferIterator first,
@@ -278,6 +324,8 @@ inline void fill(BufferIterator first,
                  const T &value,
                  command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("fill")
+
     size_t count = detail::iterator_range_size(first, last);
     if(count == 0){
         return;
@@ -286,12 +334,27 @@ inline void fill(BufferIterator first,
     detail::dispatch_fill(first, count, value, queue);
 }
 
+/// \overload
+template<class BufferIterator, class T>
+inline void fill(BufferIterator first,
+                 BufferIterator last,
+                 const T &value,
+                 command_queue &queue,
+                 const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    ::boost::compute::fill(first, last, value, queue);
+}
+
 template<class BufferIterator, class T>
 inline future<void> fill_async(BufferIterator first,
                                BufferIterator last,
                                const T &value,
                                command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("fill_async")
+
     size_t count = detail::iterator_range_size(first, last);
     if(count == 0){
         return future<void>();
@@ -300,6 +363,19 @@ inline future<void> fill_async(BufferIterator first,
     return detail::dispatch_fill_async(first, count, value, queue);
 }
 
+/// \overload
+template<class BufferIterator, class T>
+inline future<void> fill_async(BufferIterator first,
+                               BufferIterator last,
+                               const T &value,
+                               command_queue &queue,
+                               const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::fill_async(first, last, value, queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -14,6 +14,7 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/detail/enqueue_wait_list.hpp>
 
 namespace boost {
 namespace compute {
@@ -27,9 +28,24 @@ inline void fill_n(BufferIterator first,
                    const T &value,
                    command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("fill_n")
+
     ::boost::compute::fill(first, first + count, value, queue);
 }
 
+/// \overload
+template<class BufferIterator, class Size, class T>
+inline void fill_n(BufferIterator first,
+                   Size count,
+                   const T &value,
+                   command_queue &queue,
+                   const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    ::boost::compute::fill_n(first, count, value, queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -14,6 +14,9 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/detail/find_if_with_atomics.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/types/fundamental.hpp>
 
 namespace boost {
 namespace compute {
@@ -26,9 +29,33 @@ inline InputIterator find_if(InputIterator first,
                              UnaryPredicate predicate,
                              command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("find_if")
+
     return detail::find_if_with_atomics(first, last, predicate, queue);
 }
 
+/// \overload
+///
+/// Stores the index of the first element in the range [\p first, \p last)
+/// for which \p predicate returns \c true (or the size of the range if
+/// there is none) to \p result on the device. The index is never read on
+/// the host.
+template<class InputIterator, class UnaryPredicate>
+inline buffer_iterator<uint_> find_if(InputIterator first,
+                                      InputIterator last,
+                                      UnaryPredicate predicate,
+                                      buffer_iterator<uint_> result,
+                                      command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("find_if")
+
+    detail::find_if_with_atomics(
+        first, detail::iterator_range_size(first, last), predicate, result, queue
+    );
+
+    return result + 1;
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -13,8 +13,11 @@
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/enqueue_wait_list.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/nd_range.hpp>
+#include <boost/compute/utility/extents.hpp>
 
 namespace boost {
 namespace compute {
@@ -52,6 +55,8 @@ inline UnaryFunction for_each(InputIterator first,
                               UnaryFunction function,
                               command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("for_each")
+
     detail::for_each_kernel<InputIterator, UnaryFunction> kernel(first, last, function);
 
     kernel.exec(queue);
@@ -59,6 +64,48 @@ inline UnaryFunction for_each(InputIterator first,
     return function;
 }
 
+/// \overload
+template<class InputIterator, class UnaryFunction>
+inline UnaryFunction for_each(InputIterator first,
+                              InputIterator last,
+                              UnaryFunction function,
+                              command_queue &queue,
+                              const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::for_each(first, last, function, queue);
+}
+
+/// \overload
+///
+/// Calls \p function on each element of the \p size.linear() elements
+/// beginning at \p first, which hold a row-major array of \p size (e.g.
+/// an image of \c dim(width, height)). The kernel is run over an
+/// nd-range of \p size in work-groups tiling it, so it does not need to
+/// divide positions to find the coordinates of the elements.
+template<class InputIterator, size_t N, class UnaryFunction>
+inline UnaryFunction for_each(InputIterator first,
+                              const extents<N> &size,
+                              UnaryFunction function,
+                              command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("for_each")
+
+    if(size.linear() == 0){
+        return function;
+    }
+
+    detail::meta_kernel k("for_each_nd");
+    detail::nd_range_index_begin(k, size);
+    k << function(first[k.var<uint_>("index")]) << ";\n";
+    detail::nd_range_index_end(k);
+
+    detail::exec_nd_range(k, size, queue);
+
+    return function;
+}
+
 } // end compute namespace
 } // end boost namespace
 
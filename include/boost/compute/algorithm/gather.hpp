@@ -11,60 +11,28 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_GATHER_HPP
 #define BOOST_COMPUTE_ALGORITHM_GATHER_HPP
 
+#include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/gather_columns.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
-#include <boost/compute/exception.hpp>
-#include <boost/compute/iterator/buffer_iterator.hpp>
-#include <boost/compute/system.hpp>
-#include <boost/compute/type_traits/type_name.hpp>
 
 namespace boost {
 namespace compute {
-namespace detail {
-
-template<class InputIterator, class MapIterator, class OutputIterator>
-class gather_kernel : public meta_kernel
-{
-public:
-    gather_kernel() : meta_kernel("gather")
-    {}
-
-    void set_range(MapIterator first,
-                   MapIterator last,
-                   InputIterator input,
-                   OutputIterator result)
-    {
-        m_count = iterator_range_size(first, last);
-        m_offset = first.get_index();
-
-        *this <<
-            "const uint i = get_global_id(0);\n" <<
-            result[expr<uint_>("i")] << "=" << 
-                input[first[expr<uint_>("i")]] << ";\n";
-    }
-
-    event exec(command_queue &queue)
-    {
-        if(m_count == 0) {
-            return event();
-        }
-
-        return exec_1d(queue, m_offset, m_count);
-    }
-
-private:
-    size_t m_count;
-    size_t m_offset;
-};
-
-} // end detail namespace
 
 /// Copies the elements using the indices from the range [\p first, \p last)
 /// to the range beginning at \p result using the input values from the range
 /// beginning at \p input.
 ///
-/// \see scatter()
+/// The input and output may be zip_iterator's, in which case each column
+/// of the input is gathered to the corresponding column of the output by
+/// a single kernel reading each index once (e.g. for the output columns of
+/// a join).
+///
+/// Structs whose size is a multiple of four bytes are copied with the
+/// widest (up to 16 byte) words dividing their size.
+///
+/// \see scatter(), apply_permutation()
 template<class InputIterator, class MapIterator, class OutputIterator>
 inline void gather(MapIterator first,
                    MapIterator last,
@@ -72,10 +40,19 @@ inline void gather(MapIterator first,
                    OutputIterator result,
                    command_queue &queue = system::default_queue())
 {
-    detail::gather_kernel<InputIterator, MapIterator, OutputIterator> kernel;
-    
-    kernel.set_range(first, last, input, result);
-    kernel.exec(queue);
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("gather")
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    detail::meta_kernel k("gather");
+    k << "const uint i = get_global_id(0);\n" <<
+         "const uint p = " << first[k.var<uint_>("i")] << ";\n";
+    detail::gather_columns(k, input, result);
+
+    k.exec_1d(queue, 0, count);
 }
 
 } // end compute namespace
@@ -0,0 +1,89 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_GATHER_IF_HPP
+#define BOOST_COMPUTE_ALGORITHM_GATHER_IF_HPP
+
+#include <iterator>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/functional/identity.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Copies the elements of the range beginning at \p input using the
+/// indices from the range [\p first, \p last) to the range beginning at
+/// \p result, for each index for which \p predicate returns \c true for the
+/// corresponding element of the range beginning at \p stencil, i.e.
+/// \c result[i] is set to \c input[first[i]] if \c predicate(stencil[i]).
+/// The other elements of the output range are not modified and the
+/// indices are only read for the selected elements.
+///
+/// If no predicate is specified, the elements with a non-zero stencil
+/// value are copied.
+///
+/// \see gather(), scatter_if()
+template<class MapIterator,
+         class StencilIterator,
+         class InputIterator,
+         class OutputIterator,
+         class Predicate>
+inline void gather_if(MapIterator first,
+                      MapIterator last,
+                      StencilIterator stencil,
+                      InputIterator input,
+                      OutputIterator result,
+                      Predicate predicate,
+                      command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("gather_if")
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    detail::meta_kernel k("gather_if");
+    k << "const uint i = get_global_id(0);\n" <<
+         "if(" << predicate(stencil[k.var<uint_>("i")]) << "){\n" <<
+         "    " << result[k.var<uint_>("i")] << " = " <<
+                   input[first[k.var<uint_>("i")]] << ";\n" <<
+         "}\n";
+
+    k.exec_1d(queue, 0, count);
+}
+
+/// \overload
+template<class MapIterator,
+         class StencilIterator,
+         class InputIterator,
+         class OutputIterator>
+inline void gather_if(MapIterator first,
+                      MapIterator last,
+                      StencilIterator stencil,
+                      InputIterator input,
+                      OutputIterator result,
+                      command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<StencilIterator>::value_type stencil_type;
+
+    ::boost::compute::gather_if(
+        first, last, stencil, input, result, identity<stencil_type>(), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_GATHER_IF_HPP
@@ -0,0 +1,364 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_HISTOGRAM_HPP
+#define BOOST_COMPUTE_ALGORITHM_HISTOGRAM_HPP
+
+#include <string>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_floating_point.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/detail/local_histogram.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// computes the bin of "value" for bins of equal width in [lower, upper),
+// values outside of the range are given a bin of -1
+template<class T>
+struct histogram_even_bins
+{
+    histogram_even_bins(const T &lower_, const T &upper_, size_t bin_count_)
+        : lower(lower_),
+          upper(upper_),
+          bin_count(bin_count_)
+    {
+    }
+
+    void operator()(meta_kernel &k) const
+    {
+        k.add_set_arg<T>("lower", lower);
+        k.add_set_arg<T>("upper", upper);
+
+        k << "bin = -1;\n"
+          << "if(value >= lower && value < upper){\n";
+        if(boost::is_floating_point<T>::value){
+            k.add_set_arg<T>("scale", static_cast<T>(bin_count) / (upper - lower));
+            k << "    bin = min((int)((value - lower) * scale), (int)bin_count - 1);\n";
+        }
+        else {
+            // exact integer arithmetic, (value - lower) may not fit in T
+            k << "    bin = (int)(((ulong)((long)value - (long)lower) * bin_count) /\n"
+              << "                (ulong)((long)upper - (long)lower));\n";
+        }
+        k << "}\n";
+    }
+
+    T lower;
+    T upper;
+    size_t bin_count;
+};
+
+// computes the bin of "value" with a binary search in the sorted bin
+// boundaries, bin i holds the values in [boundaries[i], boundaries[i+1])
+template<class BoundaryIterator>
+struct histogram_custom_bins
+{
+    histogram_custom_bins(BoundaryIterator first_, size_t boundary_count_)
+        : first(first_),
+          boundary_count(boundary_count_)
+    {
+    }
+
+    void operator()(meta_kernel &k) const
+    {
+        k.add_set_arg<uint_>("boundary_count", static_cast<uint_>(boundary_count));
+
+        k << "bin = -1;\n"
+          << "uint lo = 0;\n"
+          << "uint hi = boundary_count - 1;\n"
+          << "if(value >= " << first[k.var<uint_>("lo")] << " && "
+          <<    "value < " << first[k.var<uint_>("hi")] << "){\n"
+          << "    while(hi - lo > 1){\n"
+          << "        const uint mid = (lo + hi) / 2;\n"
+          << "        if(value < " << first[k.var<uint_>("mid")] << ") hi = mid;\n"
+          << "        else lo = mid;\n"
+          << "    }\n"
+          << "    bin = (int) lo;\n"
+          << "}\n";
+    }
+
+    BoundaryIterator first;
+    size_t boundary_count;
+};
+
+// returns the largest number of bins counted in local memory by
+// histogram() on the queue's device. histograms with more bins are
+// computed by sorting the bin of each value.
+//
+// the default can be overridden through the global parameter_cache for
+// the device with the object name "__boost_histogram" and the parameter
+// "max_local_bins".
+inline size_t histogram_max_local_bins(command_queue &queue)
+{
+    const device &device = queue.get_device();
+    const boost::shared_ptr<device_profile> profile = device_profile::get(device);
+
+    // leave room for a second work-group on the compute unit
+    uint_ max_local_bins =
+        static_cast<uint_>(profile->local_memory_size() / (2 * sizeof(uint_)));
+
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(device);
+
+    return parameters->get("__boost_histogram", "max_local_bins", max_local_bins);
+}
+
+// counts the values in each bin with bins privatized in local memory for
+// each work-group, which are then merged into the global bins with atomics
+template<class InputIterator, class BinFunction>
+inline void histogram_with_local_atomics(InputIterator first,
+                                         size_t count,
+                                         const BinFunction &bin_function,
+                                         const buffer &bins,
+                                         size_t bins_offset,
+                                         size_t bin_count,
+                                         command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    const device &device = queue.get_device();
+
+    meta_kernel k("histogram_with_local_atomics");
+    k.add_function("local_histogram", local_histogram_source);
+    k.add_set_arg<uint_>("count", static_cast<uint_>(count));
+    k.add_set_arg<uint_>("bin_count", static_cast<uint_>(bin_count));
+    size_t local_bins_arg = k.add_arg<uint_ *>(memory_object::local_memory, "local_bins");
+
+    k << "local_histogram_clear(local_bins, bin_count);\n"
+      << "for(uint i = get_global_id(0); i < count; i += get_global_size(0)){\n"
+      << k.decl<const value_type>("value") << " = "
+      <<     first[k.var<uint_>("i")] << ";\n"
+      << "int bin;\n";
+    bin_function(k);
+    k << "if(bin >= 0){\n"
+      << "    local_histogram_add(local_bins, (uint) bin);\n"
+      << "}\n"
+      << "}\n"
+      << "local_histogram_merge(local_bins, (__global uint *)("
+      <<     k.get_buffer_identifier<uint_>(bins) << " + " << uint_(bins_offset)
+      <<     "), bin_count);\n";
+
+    k.set_arg(local_bins_arg, local_buffer<uint_>(bin_count));
+
+    // enough work-groups to fill the device, each work-item counts
+    // several values so the merge is amortized
+    const size_t work_group_size = k.work_group_size(queue, 256);
+    const size_t work_groups =
+        (std::min)((count + work_group_size - 1) / work_group_size,
+                   size_t(device.compute_units()) * 4);
+
+    k.exec_1d(queue, 0, work_groups * work_group_size, work_group_size);
+}
+
+// counts the values in each bin by sorting the bin of each value, for
+// histograms with too many bins to fit in local memory
+template<class InputIterator, class BinFunction>
+inline void histogram_with_sort(InputIterator first,
+                                size_t count,
+                                const BinFunction &bin_function,
+                                const buffer &bins,
+                                size_t bins_offset,
+                                size_t bin_count,
+                                command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    // values outside of the bins sort after the last bin
+    scratch_vector<uint_> value_bins(count, queue);
+
+    meta_kernel k1("histogram_find_bins");
+    k1.add_set_arg<uint_>("bin_count", static_cast<uint_>(bin_count));
+    k1 << "const uint i = get_global_id(0);\n"
+       << k1.decl<const value_type>("value") << " = "
+       <<     first[k1.var<uint_>("i")] << ";\n"
+       << "int bin;\n";
+    bin_function(k1);
+    k1 << value_bins.begin()[k1.var<uint_>("i")] << " = "
+       <<     "bin >= 0 ? (uint) bin : bin_count;\n";
+    k1.exec_1d(queue, 0, count);
+
+    ::boost::compute::sort(value_bins.begin(), value_bins.end(), queue);
+
+    // the count of each bin is the distance between the first values of
+    // the bin and of the next bin
+    meta_kernel k2("histogram_count_sorted_bins");
+    k2.add_set_arg<uint_>("count", static_cast<uint_>(count));
+    k2 << "const uint b = get_global_id(0);\n"
+       << "uint start = 0;\n"
+       << "uint end = 0;\n"
+       << "for(uint n = 0; n < 2; n++){\n"
+       << "    uint lo = 0;\n"
+       << "    uint hi = count;\n"
+       << "    while(lo < hi){\n"
+       << "        const uint mid = (lo + hi) / 2;\n"
+       << "        if(" << value_bins.begin()[k2.var<uint_>("mid")] << " < b + n) lo = mid + 1;\n"
+       << "        else hi = mid;\n"
+       << "    }\n"
+       << "    if(n == 0) start = lo; else end = lo;\n"
+       << "}\n"
+       << buffer_iterator<uint_>(bins, bins_offset)[k2.var<uint_>("b")]
+       <<     " = end - start;\n";
+    k2.exec_1d(queue, 0, bin_count);
+}
+
+template<class InputIterator, class BinFunction, class OutputIterator>
+inline OutputIterator dispatch_histogram(InputIterator first,
+                                         InputIterator last,
+                                         const BinFunction &bin_function,
+                                         OutputIterator bins,
+                                         size_t bin_count,
+                                         command_queue &queue)
+{
+    typedef typename std::iterator_traits<OutputIterator>::value_type count_type;
+
+    // the bins are counted with atomics on 32-bit integers
+    BOOST_STATIC_ASSERT(boost::is_integral<count_type>::value);
+    BOOST_STATIC_ASSERT(sizeof(count_type) == sizeof(uint_));
+
+    if(bin_count == 0){
+        return bins;
+    }
+
+    const size_t count = iterator_range_size(first, last);
+    if(count == 0){
+        ::boost::compute::fill(bins, bins + bin_count, count_type(0), queue);
+    }
+    else if(bin_count <= histogram_max_local_bins(queue)){
+        ::boost::compute::fill(bins, bins + bin_count, count_type(0), queue);
+        histogram_with_local_atomics(
+            first, count, bin_function,
+            bins.get_buffer(), bins.get_index(), bin_count, queue
+        );
+    }
+    else {
+        histogram_with_sort(
+            first, count, bin_function,
+            bins.get_buffer(), bins.get_index(), bin_count, queue
+        );
+    }
+
+    return bins + bin_count;
+}
+
+} // end detail namespace
+
+/// Counts the values in the range [\p first, \p last) falling into each of
+/// \p bin_count bins of equal width covering [\p lower, \p upper) and
+/// stores the counts to the range beginning at \p bins. Values outside of
+/// [\p lower, \p upper) are not counted.
+///
+/// Each work-group counts its values in a private copy of the bins in
+/// local memory and merges them into the result with atomics. Histograms
+/// with more bins than fit in local memory are computed by sorting the bin
+/// of each value instead.
+///
+/// The bins must be a range of \c uint_ (or \c int_) on the device.
+///
+/// For example, to compute a histogram of the pixel values of an 8-bit
+/// image:
+/// \code
+/// boost::compute::vector<boost::compute::uint_> bins(256, context);
+/// boost::compute::histogram(
+///     pixels.begin(), pixels.end(), bins.begin(), 256, 0, 256, queue
+/// );
+/// \endcode
+///
+/// \return an iterator one past the last bin
+///
+/// \see count()
+template<class InputIterator, class OutputIterator, class T>
+inline OutputIterator histogram(InputIterator first,
+                                InputIterator last,
+                                OutputIterator bins,
+                                size_t bin_count,
+                                const T &lower,
+                                const T &upper,
+                                command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("histogram")
+
+    BOOST_ASSERT(lower < upper);
+
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    // the bounds of integer values may not be representable by the values
+    // themselves, e.g. an upper bound of 256 for uchar_ pixels
+    typedef typename boost::mpl::if_<
+        boost::is_floating_point<value_type>, value_type, T
+    >::type bound_type;
+
+    return detail::dispatch_histogram(
+        first,
+        last,
+        detail::histogram_even_bins<bound_type>(
+            static_cast<bound_type>(lower), static_cast<bound_type>(upper), bin_count
+        ),
+        bins,
+        bin_count,
+        queue
+    );
+}
+
+/// Counts the values in the range [\p first, \p last) falling into each of
+/// the bins defined by the sorted boundaries in the range
+/// [\p boundaries_first, \p boundaries_last) and stores the counts to the
+/// range beginning at \p bins. Bin \c i holds the values in
+/// <tt>[boundaries[i], boundaries[i+1])</tt>, so \c n boundaries define
+/// <tt>n - 1</tt> bins.
+///
+/// \return an iterator one past the last bin
+template<class InputIterator, class BoundaryIterator, class OutputIterator>
+inline OutputIterator histogram(InputIterator first,
+                                InputIterator last,
+                                BoundaryIterator boundaries_first,
+                                BoundaryIterator boundaries_last,
+                                OutputIterator bins,
+                                command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("histogram")
+
+    const size_t boundary_count =
+        detail::iterator_range_size(boundaries_first, boundaries_last);
+    if(boundary_count < 2){
+        return bins;
+    }
+
+    return detail::dispatch_histogram(
+        first,
+        last,
+        detail::histogram_custom_bins<BoundaryIterator>(boundaries_first, boundary_count),
+        bins,
+        boundary_count - 1,
+        queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_HISTOGRAM_HPP
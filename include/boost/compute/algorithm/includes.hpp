@@ -14,6 +14,7 @@
 #include <iterator>
 
 #include <boost/compute/algorithm/detail/balanced_path.hpp>
+#include <boost/compute/algorithm/detail/set_search.hpp>
 #include <boost/compute/algorithm/fill_n.hpp>
 #include <boost/compute/algorithm/find.hpp>
 #include <boost/compute/container/vector.hpp>
@@ -105,6 +106,10 @@ private:
 ///
 /// \return True, if [first1, last1) includes [first2, last2). False otherwise.
 ///
+/// When [first2, last2) is much smaller than [first1, last1) each of its
+/// values is searched for in [first1, last1) with a binary search (stopping
+/// at the first value which is missing) instead of merging both ranges.
+///
 /// \param first1 Iterator pointing to start of first set
 /// \param last1 Iterator pointing to end of first set
 /// \param first2 Iterator pointing to start of second set
@@ -120,9 +125,22 @@ inline bool includes(InputIterator1 first1,
 {
     int tile_size = 1024;
 
+    typedef typename std::iterator_traits<InputIterator1>::value_type value_type;
+
     int count1 = detail::iterator_range_size(first1, last1);
     int count2 = detail::iterator_range_size(first2, last2);
 
+    if(count2 == 0){
+        return true;
+    }
+    if(count2 > count1){
+        return false;
+    }
+
+    if(detail::set_operation_use_search<value_type>(count2, count1, queue)){
+        return detail::set_search_includes(first2, count2, first1, count1, queue);
+    }
+
     vector<uint_> tile_a((count1+count2+tile_size-1)/tile_size+1, queue.get_context());
     vector<uint_> tile_b((count1+count2+tile_size-1)/tile_size+1, queue.get_context());
 
@@ -154,4 +172,4 @@ inline bool includes(InputIterator1 first1,
 } //end compute namespace
 } //end boost namespace
 
-#endif // BOOST_COMPUTE_ALGORITHM_SET_UNION_HPP
+#endif // BOOST_COMPUTE_ALGORITHM_INCLUDES_HPP
@@ -0,0 +1,127 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_INCLUSIVE_SCAN_BY_KEY_HPP
+#define BOOST_COMPUTE_ALGORITHM_INCLUSIVE_SCAN_BY_KEY_HPP
+
+#include <iterator>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/segmented_scan.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Performs an inclusive scan of the values beginning at \p values_first
+/// within each group of consecutive equal keys in the range
+/// [\p keys_first, \p keys_last) and stores the results in the range
+/// beginning at \p result.
+///
+/// Two consecutive keys belong to the same group if \p predicate returns
+/// \c true for them. If no predicate is given, \c equal_to is used. If no
+/// function is given, \c plus is used.
+///
+/// All of the groups are scanned together, so scanning many small groups
+/// costs the same number of kernel launches as a single scan of the same
+/// total size.
+///
+/// \param keys_first first key in the range
+/// \param keys_last last key in the range
+/// \param values_first first value in the range to scan
+/// \param result first element in the result range
+/// \param function binary scan function
+/// \param predicate binary predicate comparing consecutive keys
+/// \param queue command queue to perform the operation
+///
+/// \return \c OutputIterator to the end of the result range
+///
+/// \snippet test/test_scan_by_key.cpp inclusive_scan_by_key_int
+///
+/// \see exclusive_scan_by_key(), inclusive_scan()
+template<class InputKeyIterator,
+         class InputValueIterator,
+         class OutputIterator,
+         class BinaryFunction,
+         class BinaryPredicate>
+inline OutputIterator
+inclusive_scan_by_key(InputKeyIterator keys_first,
+                      InputKeyIterator keys_last,
+                      InputValueIterator values_first,
+                      OutputIterator result,
+                      BinaryFunction function,
+                      BinaryPredicate predicate,
+                      command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<OutputIterator>::difference_type difference_type;
+
+    const size_t count = detail::iterator_range_size(keys_first, keys_last);
+    if(count == 0){
+        return result;
+    }
+
+    detail::scratch_vector<uint_> segments(count, queue);
+    detail::segment_ids(keys_first, count, segments.begin(), predicate, queue);
+
+    detail::segmented_inclusive_scan(
+        segments.begin(), count, values_first, result, function, queue
+    );
+
+    return result + static_cast<difference_type>(count);
+}
+
+/// \overload
+template<class InputKeyIterator,
+         class InputValueIterator,
+         class OutputIterator,
+         class BinaryFunction>
+inline OutputIterator
+inclusive_scan_by_key(InputKeyIterator keys_first,
+                      InputKeyIterator keys_last,
+                      InputValueIterator values_first,
+                      OutputIterator result,
+                      BinaryFunction function,
+                      command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputKeyIterator>::value_type key_type;
+
+    return ::boost::compute::inclusive_scan_by_key(
+        keys_first, keys_last, values_first, result,
+        function, equal_to<key_type>(), queue
+    );
+}
+
+/// \overload
+template<class InputKeyIterator,
+         class InputValueIterator,
+         class OutputIterator>
+inline OutputIterator
+inclusive_scan_by_key(InputKeyIterator keys_first,
+                      InputKeyIterator keys_last,
+                      InputValueIterator values_first,
+                      OutputIterator result,
+                      command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputKeyIterator>::value_type key_type;
+    typedef typename std::iterator_traits<OutputIterator>::value_type value_type;
+
+    return ::boost::compute::inclusive_scan_by_key(
+        keys_first, keys_last, values_first, result,
+        plus<value_type>(), equal_to<key_type>(), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_INCLUSIVE_SCAN_BY_KEY_HPP
@@ -15,46 +15,100 @@
 #include <boost/compute/functional.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/accumulate.hpp>
-#include <boost/compute/container/vector.hpp>
+#include <boost/compute/algorithm/detail/fused_transform_reduce.hpp>
 #include <boost/compute/iterator/transform_iterator.hpp>
 #include <boost/compute/iterator/zip_iterator.hpp>
 #include <boost/compute/functional/detail/unpack.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
 
 namespace boost {
 namespace compute {
+namespace detail {
 
-/// Returns the inner product of the elements in the range
-/// [\p first1, \p last1) with the elements in the range beginning
-/// at \p first2.
-template<class InputIterator1, class InputIterator2, class T>
-inline T inner_product(InputIterator1 first1,
-                       InputIterator1 last1,
-                       InputIterator2 first2,
-                       T init,
-                       command_queue &queue = system::default_queue())
+template<class InputIterator1,
+         class InputIterator2,
+         class T,
+         class BinaryAccumulateFunction,
+         class BinaryTransformFunction>
+inline T dispatch_inner_product(InputIterator1 first1,
+                                InputIterator1 last1,
+                                InputIterator2 first2,
+                                T init,
+                                BinaryAccumulateFunction accumulate_function,
+                                BinaryTransformFunction transform_function,
+                                command_queue &queue)
 {
-    typedef typename std::iterator_traits<InputIterator1>::value_type input_type;
+    typedef typename std::iterator_traits<InputIterator1>::difference_type difference_type;
+
+    const size_t count = iterator_range_size(first1, last1);
+    if(count == 0){
+        return init;
+    }
+
+    // reduce the products in parallel if possible
+    if(can_accumulate_with_reduce(init, accumulate_function)){
+        scratch_vector<T> result(1, queue);
+        fused_transform_reduce(first1,
+                               first2,
+                               count,
+                               transform_function,
+                               accumulate_function,
+                               result.begin(),
+                               queue);
 
-    ptrdiff_t n = std::distance(first1, last1);
+        return read_single_value<T>(result.get_buffer(), 0, queue);
+    }
 
-    return ::boost::compute::accumulate(
+    // accumulate the products in order
+    return generic_accumulate(
         ::boost::compute::make_transform_iterator(
             ::boost::compute::make_zip_iterator(
                 boost::make_tuple(first1, first2)
             ),
-            detail::unpack(multiplies<input_type>())
+            unpack(transform_function)
         ),
         ::boost::compute::make_transform_iterator(
             ::boost::compute::make_zip_iterator(
-                boost::make_tuple(last1, first2 + n)
+                boost::make_tuple(last1, first2 + static_cast<difference_type>(count))
             ),
-            detail::unpack(multiplies<input_type>())
+            unpack(transform_function)
         ),
         init,
+        accumulate_function,
         queue
     );
 }
 
+} // end detail namespace
+
+/// Returns the inner product of the elements in the range
+/// [\p first1, \p last1) with the elements in the range beginning
+/// at \p first2.
+///
+/// The products are computed while loading the input of the reduction and
+/// are never stored in memory. As with \c accumulate(), the values are
+/// only reduced in parallel when the reduction is known to be associative
+/// (such as \c plus<int>) and \p init is its identity value.
+template<class InputIterator1, class InputIterator2, class T>
+inline T inner_product(InputIterator1 first1,
+                       InputIterator1 last1,
+                       InputIterator2 first2,
+                       T init,
+                       command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator1>::value_type input_type;
+
+    return detail::dispatch_inner_product(first1,
+                                          last1,
+                                          first2,
+                                          init,
+                                          plus<input_type>(),
+                                          multiplies<input_type>(),
+                                          queue);
+}
+
 /// \overload
 template<class InputIterator1,
          class InputIterator2,
@@ -69,22 +123,13 @@ inline T inner_product(InputIterator1 first1,
                        BinaryTransformFunction transform_function,
                        command_queue &queue = system::default_queue())
 {
-    typedef typename std::iterator_traits<InputIterator1>::value_type value_type;
-
-    size_t count = detail::iterator_range_size(first1, last1);
-    vector<value_type> result(count, queue.get_context());
-    transform(first1,
-              last1,
-              first2,
-              result.begin(),
-              transform_function,
-              queue);
-
-    return ::boost::compute::accumulate(result.begin(),
-                                        result.end(),
-                                        init,
-                                        accumulate_function,
-                                        queue);
+    return detail::dispatch_inner_product(first1,
+                                          last1,
+                                          first2,
+                                          init,
+                                          accumulate_function,
+                                          transform_function,
+                                          queue);
 }
 
 } // end compute namespace
@@ -15,14 +15,21 @@
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
-#include <boost/compute/algorithm/merge.hpp>
-#include <boost/compute/container/vector.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/detail/merge_sort_on_gpu.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
 
 namespace boost {
 namespace compute {
 
 /// Merges the sorted values in the range [\p first, \p middle) with
 /// the sorted values in the range [\p middle, \p last) in-place.
+///
+/// The values are merged by a single kernel (the merge step of
+/// stable_sort()) into one temporary buffer of the size of the range,
+/// which is then copied back to the range.
 template<class Iterator>
 inline void inplace_merge(Iterator first,
                           Iterator middle,
@@ -33,25 +40,25 @@ inline void inplace_merge(Iterator first,
 
     typedef typename std::iterator_traits<Iterator>::value_type T;
 
-    const context &context = queue.get_context();
+    const size_t left_size = detail::iterator_range_size(first, middle);
+    const size_t count = detail::iterator_range_size(first, last);
 
-    ptrdiff_t left_size = std::distance(first, middle);
-    ptrdiff_t right_size = std::distance(middle, last);
+    detail::scratch_vector<T> merged(count, queue);
 
-    vector<T> left(left_size, context);
-    vector<T> right(right_size, context);
-
-    copy(first, middle, left.begin(), queue);
-    copy(middle, last, right.begin(), queue);
-
-    ::boost::compute::merge(
-        left.begin(),
-        left.end(),
-        right.begin(),
-        right.end(),
+    detail::merge_sort_merge_pass(
         first,
+        first,
+        merged.begin(),
+        merged.begin(),
+        less<T>(),
+        count,
+        left_size,
+        count,
+        false,
         queue
     );
+
+    copy(merged.begin(), merged.end(), first, queue);
 }
 
 } // end compute namespace
@@ -11,17 +11,273 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_IS_PERMUTATION_HPP
 #define BOOST_COMPUTE_ALGORITHM_IS_PERMUTATION_HPP
 
+#include <vector>
 #include <iterator>
+#include <algorithm>
+
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
-#include <boost/compute/container/vector.hpp>
-#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/equal.hpp>
+#include <boost/compute/algorithm/find_if.hpp>
 #include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/scratch_size.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_memory.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/utility/buffer_pool.hpp>
+#include <boost/compute/utility/fill_batch.hpp>
 
 namespace boost {
 namespace compute {
+namespace detail {
+
+// true if the values of both ranges are integers of (at most) 32 bits
+// which can be counted by their bits in a hash table
+template<class T1, class T2>
+struct is_permutation_countable
+    : public boost::integral_constant<
+          bool,
+          boost::is_same<T1, T2>::value &&
+          boost::is_integral<T1>::value &&
+          sizeof(T1) <= sizeof(uint_)
+      > {};
+
+// sorts copies of both ranges and compares them
+template<class InputIterator1, class InputIterator2>
+inline bool dispatch_is_permutation(InputIterator1 first1,
+                                    InputIterator1 last1,
+                                    InputIterator2 first2,
+                                    size_t count,
+                                    command_queue &queue,
+                                    boost::false_type)
+{
+    typedef typename std::iterator_traits<InputIterator1>::value_type value_type1;
+    typedef typename std::iterator_traits<InputIterator2>::value_type value_type2;
+
+    scratch_vector<value_type1> temp1(count, queue);
+    scratch_vector<value_type2> temp2(count, queue);
+
+    copy(first1, last1, temp1.begin(), queue);
+    copy(first2, first2 + count, temp2.begin(), queue);
+
+    sort(temp1.begin(), temp1.end(), queue);
+    sort(temp2.begin(), temp2.end(), queue);
+
+    return equal(temp1.begin(), temp1.end(),
+                 temp2.begin(), queue);
+}
+
+// counts the occurrences of each value with an open addressing hash table
+// (+1 for the first range and -1 for the second range) in one kernel and
+// checks that all of the counts are zero.
+//
+// the table has at least twice as many slots as there are values in one
+// range, more than the distinct values of a permutation. if a value finds
+// no slot the ranges have more distinct values and are no permutation.
+// the value used to mark empty slots is counted in an extra slot.
+template<class InputIterator1, class InputIterator2>
+inline bool dispatch_is_permutation(InputIterator1 first1,
+                                    InputIterator1 last1,
+                                    InputIterator2 first2,
+                                    size_t count,
+                                    command_queue &queue,
+                                    boost::true_type)
+{
+    (void) last1;
+
+    size_t slots = 1;
+    while(slots < 2 * count){
+        slots *= 2;
+    }
+
+    // the extra slots count the empty key and record a full table
+    scratch_vector<uint_> keys(slots, queue);
+    scratch_vector<int_> counts(slots + 2, queue);
+
+    fill_batch clear;
+    clear.add(keys.begin(), keys.end(), 0xFFFFFFFF);
+    clear.add(counts.begin(), counts.end(), 0);
+    clear.enqueue(queue);
+
+    meta_kernel k("is_permutation_count");
+    size_t keys_arg = k.add_arg<uint_ *>(memory_object::global_memory, "keys");
+    size_t counts_arg = k.add_arg<int_ *>(memory_object::global_memory, "counts");
+    size_t mask_arg = k.add_arg<const uint_>("mask");
+    size_t count_arg = k.add_arg<const uint_>("count");
+
+    k << "const uint gid = get_global_id(0);\n"
+      << "uint key;\n"
+      << "int delta;\n"
+      << "if(gid < count){\n"
+      << "    key = (uint)(" << first1[k.var<const uint_>("gid")] << ");\n"
+      << "    delta = 1;\n"
+      << "}\n"
+      << "else {\n"
+      << "    key = (uint)(" << first2[k.expr<const uint_>("gid - count")] << ");\n"
+      << "    delta = -1;\n"
+      << "}\n"
+      << "if(key == 0xFFFFFFFFu){\n"
+      << "    atomic_add(counts + mask + 1, delta);\n"
+      << "    return;\n"
+      << "}\n"
+      // murmur3 finalizer
+      << "uint h = key;\n"
+      << "h ^= h >> 16;\n"
+      << "h *= 0x85ebca6bu;\n"
+      << "h ^= h >> 13;\n"
+      << "h *= 0xc2b2ae35u;\n"
+      << "h ^= h >> 16;\n"
+      << "h &= mask;\n"
+      << "for(uint probe = 0; probe <= mask; probe++){\n"
+      << "    const uint old = atomic_cmpxchg(keys + h, 0xFFFFFFFFu, key);\n"
+      << "    if(old == 0xFFFFFFFFu || old == key){\n"
+      << "        atomic_add(counts + h, delta);\n"
+      << "        return;\n"
+      << "    }\n"
+      << "    h = (h + 1) & mask;\n"
+      << "}\n"
+      << "counts[mask + 2] = 1;\n";
+
+    k.set_arg(keys_arg, keys.get_buffer());
+    k.set_arg(counts_arg, counts.get_buffer());
+    k.set_arg(mask_arg, static_cast<uint_>(slots - 1));
+    k.set_arg(count_arg, static_cast<uint_>(count));
+
+    k.exec_1d(queue, 0, 2 * count);
+
+    using ::boost::compute::lambda::_1;
+
+    return ::boost::compute::find_if(
+        counts.begin(), counts.end(), _1 != 0, queue
+    ) == counts.end();
+}
+
+// true if both ranges have the same arithmetic value type, which can be
+// sorted and compared on the host
+template<class T1, class T2>
+struct is_permutation_host_comparable
+    : public boost::integral_constant<
+          bool,
+          boost::is_same<T1, T2>::value &&
+          boost::is_arithmetic<T1>::value
+      > {};
+
+// returns the size in bytes of the temporary buffers of the sort-based
+// dispatch_is_permutation() and of its largest buffer in largest
+template<class T>
+inline size_t is_permutation_scratch_size(size_t count,
+                                          size_t &largest,
+                                          command_queue &queue,
+                                          boost::false_type)
+{
+    largest = count * sizeof(T);
+    return ::boost::compute::is_permutation_scratch_size<T>(count, queue);
+}
+
+// returns the size in bytes of the hash table of dispatch_is_permutation()
+// and of its largest buffer in largest
+template<class T>
+inline size_t is_permutation_scratch_size(size_t count,
+                                          size_t &largest,
+                                          command_queue &queue,
+                                          boost::true_type)
+{
+    (void) queue;
+
+    size_t slots = 1;
+    while(slots < 2 * count){
+        slots *= 2;
+    }
+
+    largest = (slots + 2) * sizeof(int_);
+    return buffer_pool::size_class(slots * sizeof(uint_)) +
+           buffer_pool::size_class(largest);
+}
+
+// sorts host copies of both ranges and compares them
+template<class InputIterator1, class InputIterator2>
+inline bool is_permutation_on_host(InputIterator1 first1,
+                                   InputIterator1 last1,
+                                   InputIterator2 first2,
+                                   size_t count,
+                                   command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator1>::value_type value_type;
+
+    std::vector<value_type> values1(count);
+    std::vector<value_type> values2(count);
+    ::boost::compute::copy(first1, last1, values1.begin(), queue);
+    ::boost::compute::copy(first2, first2 + count, values2.begin(), queue);
+
+    std::sort(values1.begin(), values1.end());
+    std::sort(values2.begin(), values2.end());
+
+    return std::equal(values1.begin(), values1.end(), values2.begin());
+}
+
+template<class InputIterator1, class InputIterator2>
+inline bool is_permutation_with_fallback(InputIterator1 first1,
+                                         InputIterator1 last1,
+                                         InputIterator2 first2,
+                                         size_t count,
+                                         command_queue &queue,
+                                         boost::false_type)
+{
+    typedef typename std::iterator_traits<InputIterator1>::value_type value_type1;
+    typedef typename std::iterator_traits<InputIterator2>::value_type value_type2;
+
+    return dispatch_is_permutation(
+        first1, last1, first2, count, queue,
+        typename is_permutation_countable<value_type1, value_type2>::type()
+    );
+}
+
+// compares the ranges on the host if the temporary buffers of the device
+// comparison do not fit into the available device memory or could not be
+// allocated
+template<class InputIterator1, class InputIterator2>
+inline bool is_permutation_with_fallback(InputIterator1 first1,
+                                         InputIterator1 last1,
+                                         InputIterator2 first2,
+                                         size_t count,
+                                         command_queue &queue,
+                                         boost::true_type)
+{
+    typedef typename std::iterator_traits<InputIterator1>::value_type value_type1;
+    typedef typename std::iterator_traits<InputIterator2>::value_type value_type2;
+    typedef typename is_permutation_countable<value_type1, value_type2>::type countable;
+
+    size_t largest = 0;
+    const size_t bytes = is_permutation_scratch_size<value_type1>(
+        count, largest, queue, countable()
+    );
+    if(fits_scratch_memory(bytes, largest, queue)){
+        try {
+            return dispatch_is_permutation(
+                first1, last1, first2, count, queue, countable()
+            );
+        }
+        catch(const opencl_error &e){
+            if(!is_allocation_failure(e)){
+                throw;
+            }
+        }
+    }
+
+    BOOST_COMPUTE_DETAIL_TRACE_STRATEGY("is_permutation", "host")
+    return is_permutation_on_host(first1, last1, first2, count, queue);
+}
+
+} // end detail namespace
 
 ///
 /// \brief Permutation checking algorithm
@@ -30,6 +286,12 @@ namespace compute {
 /// range [first2, last2)
 /// \return True, if it can be permuted. False, otherwise.
 ///
+/// Ranges of integers of up to 32 bits are compared by counting their
+/// values in a hash table on the device, other value types by sorting
+/// copies of both ranges. Ranges of arithmetic values for which there is
+/// not enough device memory for these temporaries are sorted and compared
+/// on the host instead.
+///
 /// \param first1 Iterator pointing to start of first range
 /// \param last1 Iterator pointing to end of first range
 /// \param first2 Iterator pointing to start of second range
@@ -46,19 +308,18 @@ inline bool is_permutation(InputIterator1 first1,
     typedef typename std::iterator_traits<InputIterator1>::value_type value_type1;
     typedef typename std::iterator_traits<InputIterator2>::value_type value_type2;
 
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("is_permutation")
+
     size_t count1 = detail::iterator_range_size(first1, last1);
     size_t count2 = detail::iterator_range_size(first2, last2);
 
     if(count1 != count2) return false;
+    if(count1 == 0) return true;
 
-    vector<value_type1> temp1(first1, last1, queue);
-    vector<value_type2> temp2(first2, last2, queue);
-
-    sort(temp1.begin(), temp1.end(), queue);
-    sort(temp2.begin(), temp2.end(), queue);
-
-    return equal(temp1.begin(), temp1.end(),
-                 temp2.begin(), queue);
+    return detail::is_permutation_with_fallback(
+        first1, last1, first2, count1, queue,
+        typename detail::is_permutation_host_comparable<value_type1, value_type2>::type()
+    );
 }
 
 } // end compute namespace
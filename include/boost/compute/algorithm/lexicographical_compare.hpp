@@ -8,101 +8,62 @@
 // See http://kylelutz.github.com/compute for more information.
 //---------------------------------------------------------------------------//
 
+#ifndef BOOST_COMPUTE_ALGORITHM_LEXICOGRAPHICAL_COMPARE_HPP
+#define BOOST_COMPUTE_ALGORITHM_LEXICOGRAPHICAL_COMPARE_HPP
+
+#include <algorithm>
+#include <iterator>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/context.hpp>
 #include <boost/compute/command_queue.hpp>
-#include <boost/compute/algorithm/any_of.hpp>
-#include <boost/compute/container/vector.hpp>
-#include <boost/compute/utility/program_cache.hpp>
+#include <boost/compute/algorithm/detail/find_with_early_exit.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
 
 namespace boost {
 namespace compute {
-
 namespace detail {
 
-const char lexicographical_compare_source[] =
-"__kernel void lexicographical_compare(const uint size1,\n"
-"                                      const uint size2,\n"
-"                                      __global const T1 *range1,\n"
-"                                      __global const T2 *range2,\n"
-"                                      __global bool *result_buf)\n"
-"{\n"
-"   const uint i = get_global_id(0);\n"
-"   if((i != size1) && (i != size2)){\n"
-        //Individual elements are compared and results are stored in parallel.
-        //0 is true
-"       if(range1[i] < range2[i])\n"
-"           result_buf[i] = 0;\n"
-"       else\n"
-"           result_buf[i] = 1;\n"
-"   }\n"
-"   else\n"
-"       result_buf[i] = !((i == size1) && (i != size2));\n"
-"}\n";
-
+// emits code which sets "match" to true if the values at position "i" of
+// the two ranges differ (i.e. neither is less than the other)
 template<class InputIterator1, class InputIterator2>
-inline bool dispatch_lexicographical_compare(InputIterator1 first1,
-                                     InputIterator1 last1,
-                                     InputIterator2 first2,
-                                     InputIterator2 last2,
-                                     command_queue &queue)
+class lexicographical_mismatch_matcher
 {
-    const boost::compute::context &context = queue.get_context();
-
-    boost::shared_ptr<program_cache> cache =
-        program_cache::get_global_cache(context);
-
-    size_t iterator_size1 = iterator_range_size(first1, last1);
-    size_t iterator_size2 = iterator_range_size(first2, last2);
-    size_t max_size = (std::max)(iterator_size1, iterator_size2);
-
-    if(max_size == 0){
-        return false;
-    }
-
-    boost::compute::vector<bool> result_vector(max_size, context);
-
-
+public:
     typedef typename std::iterator_traits<InputIterator1>::value_type value_type1;
     typedef typename std::iterator_traits<InputIterator2>::value_type value_type2;
 
-    // load (or create) lexicographical compare program
-    std::string cache_key =
-            std::string("__boost_lexicographical_compare")
-            + type_name<value_type1>() + type_name<value_type2>();
-
-    std::stringstream options;
-    options << " -DT1=" << type_name<value_type1>();
-    options << " -DT2=" << type_name<value_type2>();
-
-    program lexicographical_compare_program = cache->get_or_build(
-        cache_key, options.str(), lexicographical_compare_source, context
-    );
-
-    kernel lexicographical_compare_kernel(lexicographical_compare_program,
-                                          "lexicographical_compare");
-
-    lexicographical_compare_kernel.set_arg<uint_>(0, iterator_size1);
-    lexicographical_compare_kernel.set_arg<uint_>(1, iterator_size2);
-    lexicographical_compare_kernel.set_arg(2, first1.get_buffer());
-    lexicographical_compare_kernel.set_arg(3, first2.get_buffer());
-    lexicographical_compare_kernel.set_arg(4, result_vector.get_buffer());
+    lexicographical_mismatch_matcher(InputIterator1 first1,
+                                     InputIterator2 first2)
+        : m_first1(first1),
+          m_first2(first2)
+    {
+    }
 
-    queue.enqueue_1d_range_kernel(lexicographical_compare_kernel,
-                                  0,
-                                  max_size,
-                                  0);
+    void operator()(meta_kernel &k) const
+    {
+        k << k.decl<const value_type1>("a") << " = "
+          <<     m_first1[k.var<const uint_>("i")] << ";\n"
+          << k.decl<const value_type2>("b") << " = "
+          <<     m_first2[k.var<const uint_>("i")] << ";\n"
+          << "match = (a < b) || (b < a);\n";
+    }
 
-    return boost::compute::any_of(result_vector.begin(),
-                                  result_vector.end(),
-                                  _1 == 0,
-                                  queue);
-}
+private:
+    InputIterator1 m_first1;
+    InputIterator2 m_first2;
+};
 
 } // end detail namespace
 
 /// Checks if the first range [first1, last1) is lexicographically
 /// less than the second range [first2, last2).
+///
+/// The first position where the ranges differ is searched for with early
+/// exit, so the work done is bounded by that position rather than by the
+/// size of the ranges.
 template<class InputIterator1, class InputIterator2>
 inline bool lexicographical_compare(InputIterator1 first1,
                                     InputIterator1 last1,
@@ -110,8 +71,53 @@ inline bool lexicographical_compare(InputIterator1 first1,
                                     InputIterator2 last2,
                                     command_queue &queue = system::default_queue())
 {
-    return detail::dispatch_lexicographical_compare(first1, last1, first2, last2, queue);
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("lexicographical_compare")
+
+    const size_t count1 = detail::iterator_range_size(first1, last1);
+    const size_t count2 = detail::iterator_range_size(first2, last2);
+    const size_t count = (std::min)(count1, count2);
+    if(count == 0){
+        return count1 < count2;
+    }
+
+    // find the first position where the ranges differ
+    detail::scalar<uint_> index(queue.get_context());
+    detail::find_with_early_exit(
+        count,
+        detail::lexicographical_mismatch_matcher<
+            InputIterator1, InputIterator2
+        >(first1, first2),
+        false,
+        buffer_iterator<uint_>(index.get_buffer(), 0),
+        queue
+    );
+
+    // compare the values at that position (or the sizes if there is none)
+    // on the device so that only the result is read
+    detail::meta_kernel k("lexicographical_compare");
+    size_t index_arg = k.add_arg<uint_ *>(memory_object::global_memory, "index");
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t shorter_arg = k.add_arg<const uint_>("shorter");
+
+    k << "const uint i = *index;\n"
+      << "if(i == count){\n"
+      << "    *index = shorter;\n"
+      << "}\n"
+      << "else {\n"
+      << "    *index = " << first1[k.var<const uint_>("i")] << " < "
+      <<                    first2[k.var<const uint_>("i")] << ";\n"
+      << "}\n";
+
+    k.set_arg(index_arg, index.get_buffer());
+    k.set_arg(count_arg, static_cast<uint_>(count));
+    k.set_arg(shorter_arg, static_cast<uint_>(count1 < count2 ? 1 : 0));
+
+    k.exec_1d(queue, 0, 1, 1);
+
+    return index.read(queue) != 0;
 }
 
 } // end compute namespace
-} // end boost namespac
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_LEXICOGRAPHICAL_COMPARE_HPP
@@ -0,0 +1,121 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_LOAD_BALANCED_SEARCH_HPP
+#define BOOST_COMPUTE_ALGORITHM_LOAD_BALANCED_SEARCH_HPP
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// number of values (of both the offsets and the outputs) processed by
+// each work-item of load_balanced_search()
+static const size_t load_balanced_search_chunk = 8;
+
+} // end detail namespace
+
+/// For each output in the range [\p sources_first, \p sources_last),
+/// stores the index of the input it belongs to and, in the range
+/// beginning at \p ranks, its rank within the outputs of that input, given
+/// the sorted offsets of the outputs of each input in the range
+/// [\p offsets_first, \p offsets_last) (i.e. the exclusive scan of the
+/// number of outputs of each input, beginning with zero).
+///
+/// The source of output \c j is the last input whose offset is not
+/// greater than \c j (one less than the upper bound of \c j in the
+/// offsets) and its rank is \c j minus that offset. Inputs without outputs
+/// are skipped.
+///
+/// The searches are balanced along the merge path of the offsets and the
+/// output indices: each work-item processes the same number of offsets and
+/// outputs combined with a single binary search, regardless of how the
+/// outputs are distributed over the inputs.
+///
+/// For example, the offsets \c { 0, 3, 3, 4 } (from the counts
+/// \c { 3, 0, 1, 2 }) give the sources \c { 0, 0, 0, 2, 3, 3 } and the ranks
+/// \c { 0, 1, 2, 0, 0, 1 }.
+///
+/// \see expand()
+template<class InputIterator, class OutputIterator1, class OutputIterator2>
+inline void load_balanced_search(InputIterator offsets_first,
+                                 InputIterator offsets_last,
+                                 OutputIterator1 sources_first,
+                                 OutputIterator1 sources_last,
+                                 OutputIterator2 ranks,
+                                 command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("load_balanced_search")
+
+    const size_t count = detail::iterator_range_size(offsets_first, offsets_last);
+    const size_t outputs = detail::iterator_range_size(sources_first, sources_last);
+    if(count == 0 || outputs == 0){
+        return;
+    }
+
+    const size_t chunk = detail::load_balanced_search_chunk;
+    const size_t total = count + outputs;
+
+    detail::meta_kernel k("load_balanced_search");
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t outputs_arg = k.add_arg<const uint_>("outputs");
+    size_t total_arg = k.add_arg<const uint_>("total");
+
+    k <<
+        "const uint diag = min((uint) get_global_id(0) * " << uint_(chunk) << ", total);\n" <<
+        "const uint diag_end = min(diag + " << uint_(chunk) << ", total);\n" <<
+
+        // the number of offsets preceding diag on the merge path, where
+        // each offset precedes the outputs it is not greater than
+        "uint lo = diag > outputs ? diag - outputs : 0;\n" <<
+        "uint hi = min(diag, count);\n" <<
+        "while(lo < hi){\n" <<
+        "    const uint mid = (lo + hi) / 2;\n" <<
+        "    if(" << offsets_first[k.var<uint_>("mid")] << " <= diag - 1 - mid){\n" <<
+        "        lo = mid + 1;\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        hi = mid;\n" <<
+        "    }\n" <<
+        "}\n" <<
+
+        "uint i = lo;\n" <<
+        "uint j = diag - lo;\n" <<
+        "uint offset = i > 0 ? " << offsets_first[k.expr<uint_>("i - 1")] << " : 0;\n" <<
+        "for(uint d = diag; d < diag_end; d++){\n" <<
+        "    if(i < count && (j >= outputs || " <<
+                 offsets_first[k.var<uint_>("i")] << " <= j)){\n" <<
+        "        offset = " << offsets_first[k.var<uint_>("i")] << ";\n" <<
+        "        i++;\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        " << sources_first[k.var<uint_>("j")] << " = i - 1;\n" <<
+        "        " << ranks[k.var<uint_>("j")] << " = j - offset;\n" <<
+        "        j++;\n" <<
+        "    }\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(count_arg, static_cast<uint_>(count));
+    kernel.set_arg(outputs_arg, static_cast<uint_>(outputs));
+    kernel.set_arg(total_arg, static_cast<uint_>(total));
+
+    queue.enqueue_1d_range_kernel(kernel, 0, (total + chunk - 1) / chunk, 0);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_LOAD_BALANCED_SEARCH_HPP
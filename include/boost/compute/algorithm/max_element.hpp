@@ -28,6 +28,8 @@ max_element(InputIterator first,
             InputIterator last,
             command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("max_element")
+
     return detail::find_extrema(first, last, '>', queue);
 }
 
@@ -48,6 +48,8 @@ inline OutputIterator merge(InputIterator1 first1,
                             Compare comp,
                             command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("merge")
+
     return detail::merge_with_merge_path(first1, last1, first2, last2, result, comp, queue);
 }
 
@@ -0,0 +1,277 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_MERGE_RUNS_HPP
+#define BOOST_COMPUTE_ALGORITHM_MERGE_RUNS_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// maximum number of runs merged together by each pass of merge_runs()
+static const uint_ merge_runs_fan_in = 32;
+
+// merges each group of merge_runs_fan_in consecutive runs of the input
+// (the runs being given by their offsets) into the output, at the same
+// position as in the input.
+//
+// each value is written to its final position, which is its index in its
+// run plus the number of values of each of the other runs of its group
+// ordered before it (found by a binary search, values of earlier runs
+// being ordered before equal values). work-groups process tiles of
+// consecutive values of a run and first search the bounds of the tile in
+// each other run so that the search of each value is limited to the
+// values between them.
+template<class InputIterator, class OutputIterator, class Compare>
+inline void merge_runs_pass(InputIterator input,
+                            OutputIterator result,
+                            const buffer_iterator<uint_> offsets,
+                            const std::vector<uint_> &host_offsets,
+                            Compare compare,
+                            command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    const uint_ run_count = static_cast<uint_>(host_offsets.size() - 1);
+    const size_t work_group_size =
+        (std::min)(size_t(256), queue.get_device().max_work_group_size());
+
+    // the run and first value of each tile
+    std::vector<uint_> host_tiles;
+    for(uint_ run = 0; run < run_count; run++){
+        for(uint_ i = host_offsets[run]; i < host_offsets[run + 1]; i += work_group_size){
+            host_tiles.push_back(run);
+            host_tiles.push_back(i);
+        }
+    }
+    if(host_tiles.empty()){
+        return;
+    }
+
+    scratch_vector<uint_> tiles(host_tiles.size(), queue);
+    ::boost::compute::copy(host_tiles.begin(), host_tiles.end(), tiles.begin(), queue);
+
+    meta_kernel k("merge_runs");
+    size_t run_count_arg = k.add_arg<const uint_>("run_count");
+
+    k <<
+        "__local uint lo[" << merge_runs_fan_in << "];\n" <<
+        "__local uint hi[" << merge_runs_fan_in << "];\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint run = " << tiles.begin()[k.var<uint_>("2 * get_group_id(0)")] << ";\n" <<
+        "const uint start = " << tiles.begin()[k.var<uint_>("2 * get_group_id(0) + 1")] << ";\n" <<
+        "const uint run_start = " << offsets[k.var<uint_>("run")] << ";\n" <<
+        "const uint end = min(start + (uint) get_local_size(0), " <<
+            offsets[k.var<uint_>("run + 1")] << ");\n" <<
+        "const uint first_run = run - run % " << merge_runs_fan_in << ";\n" <<
+        "const uint last_run = min(first_run + " << merge_runs_fan_in << ", run_count);\n" <<
+
+        // bounds of the tile in the other runs
+        "for(uint r = first_run + lid; r < last_run; r += get_local_size(0)){\n" <<
+        "    for(uint e = 0; e < 2; e++){\n" <<
+        "        " << k.decl<const value_type>("x") << " = " <<
+                     input[k.var<uint_>("e == 0 ? start : end - 1")] << ";\n" <<
+        "        uint a = " << offsets[k.var<uint_>("r")] << ";\n" <<
+        "        uint b = " << offsets[k.var<uint_>("r + 1")] << ";\n" <<
+        "        while(a < b){\n" <<
+        "            const uint m = (a + b) / 2;\n" <<
+        "            " << k.decl<const value_type>("y") << " = " <<
+                         input[k.var<uint_>("m")] << ";\n" <<
+        "            const bool before = r < run ? " <<
+                         "!(" << compare(k.var<value_type>("x"), k.var<value_type>("y")) << ") : " <<
+                         compare(k.var<value_type>("y"), k.var<value_type>("x")) << ";\n" <<
+        "            if(before){\n" <<
+        "                a = m + 1;\n" <<
+        "            }\n" <<
+        "            else {\n" <<
+        "                b = m;\n" <<
+        "            }\n" <<
+        "        }\n" <<
+        "        if(e == 0){\n" <<
+        "            lo[r - first_run] = a;\n" <<
+        "        }\n" <<
+        "        else {\n" <<
+        "            hi[r - first_run] = a;\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+
+        "const uint i = start + lid;\n" <<
+        "if(i < end){\n" <<
+        "    " << k.decl<const value_type>("x") << " = " << input[k.var<uint_>("i")] << ";\n" <<
+        "    uint position = " << offsets[k.var<uint_>("first_run")] << " + i - run_start;\n" <<
+        "    for(uint r = first_run; r < last_run; r++){\n" <<
+        "        if(r == run){\n" <<
+        "            continue;\n" <<
+        "        }\n" <<
+        "        uint a = lo[r - first_run];\n" <<
+        "        uint b = hi[r - first_run];\n" <<
+        "        while(a < b){\n" <<
+        "            const uint m = (a + b) / 2;\n" <<
+        "            " << k.decl<const value_type>("y") << " = " <<
+                         input[k.var<uint_>("m")] << ";\n" <<
+        "            const bool before = r < run ? " <<
+                         "!(" << compare(k.var<value_type>("x"), k.var<value_type>("y")) << ") : " <<
+                         compare(k.var<value_type>("y"), k.var<value_type>("x")) << ";\n" <<
+        "            if(before){\n" <<
+        "                a = m + 1;\n" <<
+        "            }\n" <<
+        "            else {\n" <<
+        "                b = m;\n" <<
+        "            }\n" <<
+        "        }\n" <<
+        "        position += a - " << offsets[k.var<uint_>("r")] << ";\n" <<
+        "    }\n" <<
+        "    " << result[k.var<uint_>("position")] << " = x;\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(run_count_arg, run_count);
+
+    const size_t tile_count = host_tiles.size() / 2;
+    queue.enqueue_1d_range_kernel(
+        kernel, 0, tile_count * work_group_size, work_group_size
+    );
+}
+
+} // end detail namespace
+
+/// Merges the sorted runs of the range beginning at \p first into the range
+/// beginning at \p result. The range [\p offsets_first, \p offsets_last)
+/// contains the offset of the first value of each run followed by the
+/// offset of the end of the last one. Values are compared using
+/// \p compare (\c less by default) and equal values keep the order of
+/// their runs.
+///
+/// Instead of merging pairs of runs in log2(k) passes (as with merge()),
+/// up to 32 runs are merged by each pass, which writes each value directly
+/// to its final position. Merging up to 32 runs thus only needs a single
+/// kernel and no temporary values (1024 runs need two passes).
+///
+/// The output range must not overlap with the input range.
+///
+/// \see merge()
+template<class InputIterator,
+         class OffsetIterator,
+         class OutputIterator,
+         class Compare>
+inline OutputIterator merge_runs(InputIterator first,
+                                 OffsetIterator offsets_first,
+                                 OffsetIterator offsets_last,
+                                 OutputIterator result,
+                                 Compare compare,
+                                 command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("merge_runs")
+
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    const size_t offset_count = detail::iterator_range_size(offsets_first, offsets_last);
+    if(offset_count < 2){
+        return result;
+    }
+
+    std::vector<uint_> host_offsets(offset_count);
+    ::boost::compute::copy(offsets_first, offsets_last, host_offsets.begin(), queue);
+
+    // offsets relative to the first value
+    const uint_ base = host_offsets[0];
+    for(size_t i = 0; i < offset_count; i++){
+        host_offsets[i] -= base;
+    }
+    first += base;
+
+    const size_t count = host_offsets.back();
+    if(offset_count == 2){
+        return ::boost::compute::copy(first, first + count, result, queue);
+    }
+
+    size_t passes = 0;
+    for(size_t runs = offset_count - 1; runs > 1; runs = (runs + detail::merge_runs_fan_in - 1) / detail::merge_runs_fan_in){
+        passes++;
+    }
+
+    detail::scratch_vector<value_type> temp1(passes > 1 ? count : 0, queue);
+    detail::scratch_vector<value_type> temp2(passes > 2 ? count : 0, queue);
+
+    for(size_t pass = 0; pass < passes; pass++){
+        detail::scratch_vector<uint_> offsets(host_offsets.size(), queue);
+        ::boost::compute::copy(
+            host_offsets.begin(), host_offsets.end(), offsets.begin(), queue
+        );
+
+        const detail::scratch_vector<value_type> &input = pass % 2 ? temp1 : temp2;
+        const detail::scratch_vector<value_type> &output = pass % 2 ? temp2 : temp1;
+
+        if(pass == 0 && passes == 1){
+            detail::merge_runs_pass(
+                first, result, offsets.begin(), host_offsets, compare, queue
+            );
+        }
+        else if(pass == 0){
+            detail::merge_runs_pass(
+                first, output.begin(), offsets.begin(), host_offsets, compare, queue
+            );
+        }
+        else if(pass == passes - 1){
+            detail::merge_runs_pass(
+                input.begin(), result, offsets.begin(), host_offsets, compare, queue
+            );
+        }
+        else {
+            detail::merge_runs_pass(
+                input.begin(), output.begin(), offsets.begin(), host_offsets, compare, queue
+            );
+        }
+
+        // each group of runs is now a single run
+        std::vector<uint_> merged_offsets;
+        for(size_t i = 0; i + 1 < host_offsets.size(); i += detail::merge_runs_fan_in){
+            merged_offsets.push_back(host_offsets[i]);
+        }
+        merged_offsets.push_back(host_offsets.back());
+        host_offsets.swap(merged_offsets);
+    }
+
+    return result + count;
+}
+
+/// \overload
+template<class InputIterator, class OffsetIterator, class OutputIterator>
+inline OutputIterator merge_runs(InputIterator first,
+                                 OffsetIterator offsets_first,
+                                 OffsetIterator offsets_last,
+                                 OutputIterator result,
+                                 command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    return ::boost::compute::merge_runs(
+        first, offsets_first, offsets_last, result, less<value_type>(), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_MERGE_RUNS_HPP
@@ -28,6 +28,8 @@ min_element(InputIterator first,
             InputIterator last,
             command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("min_element")
+
     return detail::find_extrema(first, last, '<', queue);
 }
 
@@ -15,8 +15,7 @@
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
-#include <boost/compute/algorithm/max_element.hpp>
-#include <boost/compute/algorithm/min_element.hpp>
+#include <boost/compute/algorithm/detail/find_extrema.hpp>
 
 namespace boost {
 namespace compute {
@@ -25,6 +24,9 @@ namespace compute {
 /// element and the second pointing to the maximum element in the range
 /// [\p first, \p last).
 ///
+/// For large inputs both elements are found in a single pass over the
+/// range.
+///
 /// \see max_element(), min_element()
 template<class InputIterator>
 inline std::pair<InputIterator, InputIterator>
@@ -37,8 +39,7 @@ minmax_element(InputIterator first,
         return std::make_pair(first, first);
     }
 
-    return std::make_pair(min_element(first, last, queue),
-                          max_element(first, last, queue));
+    return detail::find_minmax(first, last, queue);
 }
 
 } // end compute namespace
@@ -11,18 +11,26 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_NTH_ELEMENT_HPP
 #define BOOST_COMPUTE_ALGORITHM_NTH_ELEMENT_HPP
 
+#include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
-#include <boost/compute/algorithm/fill_n.hpp>
-#include <boost/compute/algorithm/find.hpp>
-#include <boost/compute/algorithm/partition.hpp>
 #include <boost/compute/algorithm/sort.hpp>
-#include <boost/compute/functional/bind.hpp>
+#include <boost/compute/algorithm/detail/sample_select.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
 
 /// Rearranges the elements in the range [\p first, \p last) such that
 /// the \p nth element would be in that position in a sorted sequence.
+///
+/// All of the elements before \p nth are not greater than it and all of
+/// the elements after it are not less than it.
+///
+/// Large ranges are narrowed down to the few values around \p nth on the
+/// device with a sample-based selection, which only needs to read back a
+/// pair of counts from each pass. Small ranges are sorted.
+///
+/// \see partial_sort()
 template<class Iterator, class Compare>
 inline void nth_element(Iterator first,
                         Iterator nth,
@@ -32,37 +40,15 @@ inline void nth_element(Iterator first,
 {
     if(nth == last) return;
 
-    typedef typename std::iterator_traits<Iterator>::value_type value_type;
-
-    while(1)
-    {
-        value_type value = nth.read(queue);
-
-        using boost::compute::placeholders::_1;
-        Iterator new_nth = partition(
-            first, last, ::boost::compute::bind(compare, _1, value), queue
-        );
-
-        Iterator old_nth = find(new_nth, last, value, queue);
-
-        value_type new_value = new_nth.read(queue);
-
-        fill_n(new_nth, 1, value, queue);
-        fill_n(old_nth, 1, new_value, queue);
-
-        new_value = nth.read(queue);
-
-        if(value == new_value) break;
-
-        if(std::distance(first, nth) < std::distance(first, new_nth))
-        {
-            last = new_nth;
-        }
-        else
-        {
-            first = new_nth;
-        }
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count <= detail::sample_select_sort_threshold){
+        ::boost::compute::sort(first, last, compare, queue);
+        return;
     }
+
+    detail::sample_select(
+        first, detail::iterator_range_size(first, nth), last, compare, queue
+    );
 }
 
 /// \overload
@@ -0,0 +1,68 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_PARTIAL_SORT_HPP
+#define BOOST_COMPUTE_ALGORITHM_PARTIAL_SORT_HPP
+
+#include <iterator>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/nth_element.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/functional/operator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Rearranges the elements in the range [\p first, \p last) such that the
+/// range [\p first, \p middle) contains the smallest elements (according to
+/// \p compare) in sorted order. The order of the elements in the range
+/// [\p middle, \p last) is unspecified.
+///
+/// For example, to find the ten largest values of a vector:
+/// \code
+/// boost::compute::partial_sort(
+///     vec.begin(), vec.begin() + 10, vec.end(), greater<float>(), queue
+/// );
+/// \endcode
+///
+/// \see nth_element(), sort()
+template<class Iterator, class Compare>
+inline void partial_sort(Iterator first,
+                         Iterator middle,
+                         Iterator last,
+                         Compare compare,
+                         command_queue &queue = system::default_queue())
+{
+    if(first == middle) return;
+
+    ::boost::compute::nth_element(first, middle, last, compare, queue);
+    ::boost::compute::sort(first, middle, compare, queue);
+}
+
+/// \overload
+template<class Iterator>
+inline void partial_sort(Iterator first,
+                         Iterator middle,
+                         Iterator last,
+                         command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    ::boost::compute::partial_sort(
+        first, middle, last, ::boost::compute::less<value_type>(), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_PARTIAL_SORT_HPP
@@ -30,6 +30,8 @@ inline Iterator partition(Iterator first,
                           UnaryPredicate predicate,
                           command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("partition")
+
     return stable_partition(first, last, predicate, queue);
 }
 
@@ -11,10 +11,12 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_PARTITION_COPY_HPP
 #define BOOST_COMPUTE_ALGORITHM_PARTITION_COPY_HPP
 
+#include <utility>
+
 #include <boost/compute/system.hpp>
-#include <boost/compute/functional.hpp>
 #include <boost/compute/command_queue.hpp>
-#include <boost/compute/algorithm/copy_if.hpp>
+#include <boost/compute/algorithm/detail/stable_partition_copy.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
@@ -22,7 +24,11 @@ namespace compute {
 /// Copies all of the elements in the range [\p first, \p last) for which
 /// \p predicate returns \c true to the range beginning at \p first_true
 /// and all of the elements for which \p predicate returns \c false to
-/// the range beginning at \p first_false.
+/// the range beginning at \p first_false. The order of the elements is
+/// preserved in both ranges.
+///
+/// Both ranges are written by a single kernel, the predicate being
+/// evaluated once for each element of that pass.
 ///
 /// \see partition()
 template<class InputIterator,
@@ -37,24 +43,23 @@ partition_copy(InputIterator first,
                UnaryPredicate predicate,
                command_queue &queue = system::default_queue())
 {
-    // copy true values
-    OutputIterator1 last_true =
-        ::boost::compute::copy_if(first,
-                                  last,
-                                  first_true,
-                                  predicate,
-                                  queue);
-
-    // copy false values
-    OutputIterator2 last_false =
-        ::boost::compute::copy_if(first,
-                                  last,
-                                  first_false,
-                                  not1(predicate),
-                                  queue);
+    typedef typename
+        std::iterator_traits<OutputIterator1>::difference_type
+        difference_type1;
+    typedef typename
+        std::iterator_traits<OutputIterator2>::difference_type
+        difference_type2;
+
+    const size_t count = detail::iterator_range_size(first, last);
+    const size_t true_count = detail::stable_partition_copy(
+        first, count, first_true, first_false, predicate, false, queue
+    );
 
     // return iterators to the end of the true and the false ranges
-    return std::make_pair(last_true, last_false);
+    return std::make_pair(
+        first_true + static_cast<difference_type1>(true_count),
+        first_false + static_cast<difference_type2>(count - true_count)
+    );
 }
 
 } // end compute namespace
@@ -11,62 +11,62 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_RANDOM_SHUFFLE_HPP
 #define BOOST_COMPUTE_ALGORITHM_RANDOM_SHUFFLE_HPP
 
-#include <vector>
-#include <algorithm>
-
-#include <boost/range/algorithm_ext/iota.hpp>
+#include <cstdlib>
+#include <iterator>
 
 #include <boost/compute/system.hpp>
-#include <boost/compute/functional.hpp>
 #include <boost/compute/command_queue.hpp>
-#include <boost/compute/container/vector.hpp>
-#include <boost/compute/algorithm/scatter.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/random/default_random_engine.hpp>
 
 namespace boost {
 namespace compute {
 
-/// Randomly shuffles the elements in the range [\p first, \p last).
+/// Randomly shuffles the elements in the range [\p first, \p last) using
+/// the random numbers produced by \p generator.
 ///
-/// \see scatter()
-template<class Iterator>
+/// The values are shuffled on the device by sorting them with a random
+/// key each. Using a generator with a given seed produces the same
+/// permutation each time.
+///
+/// \see sort_by_key()
+template<class Iterator, class Generator>
 inline void random_shuffle(Iterator first,
                            Iterator last,
+                           Generator &generator,
                            command_queue &queue = system::default_queue())
 {
-    typedef typename std::iterator_traits<Iterator>::value_type value_type;
-
     size_t count = detail::iterator_range_size(first, last);
-    if(count == 0){
+    if(count < 2){
         return;
     }
 
-    // generate shuffled indices on the host
-    std::vector<cl_uint> random_indices(count);
-    boost::iota(random_indices, 0);
-    std::random_shuffle(random_indices.begin(), random_indices.end());
+    // generate a random key for each value and sort the values by their
+    // keys
+    detail::scratch_vector<uint_> keys(count, queue);
+    generator.generate(keys.begin(), keys.end(), queue);
 
-    // copy random indices to the device
-    const context &context = queue.get_context();
-    vector<cl_uint> indices(count, context);
-    ::boost::compute::copy(random_indices.begin(),
-                           random_indices.end(),
-                           indices.begin(),
-                           queue);
+    ::boost::compute::sort_by_key(keys.begin(), keys.end(), first, queue);
+}
 
-    // make a copy of the values on the device
-    vector<value_type> tmp(count, context);
-    ::boost::compute::copy(first,
-                           last,
-                           tmp.begin(),
-                           queue);
+/// Randomly shuffles the elements in the range [\p first, \p last).
+///
+/// The random keys are generated with a default_random_engine seeded
+/// with \c std::rand().
+///
+/// \see sort_by_key()
+template<class Iterator>
+inline void random_shuffle(Iterator first,
+                           Iterator last,
+                           command_queue &queue = system::default_queue())
+{
+    default_random_engine generator(
+        queue, static_cast<default_random_engine::result_type>(std::rand())
+    );
 
-    // write values to their new locations
-    ::boost::compute::scatter(tmp.begin(),
-                              tmp.end(),
-                              indices.begin(),
-                              first,
-                              queue);
+    ::boost::compute::random_shuffle(first, last, generator, queue);
 }
 
 } // end compute namespace
@@ -13,19 +13,40 @@
 
 #include <iterator>
 
+#include <boost/static_assert.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/preprocessor/repetition.hpp>
+#include <boost/type_traits/is_floating_point.hpp>
+#include <boost/utility/enable_if.hpp>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
+#include <boost/compute/detail/enqueue_wait_list.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/container/array.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/detail/fused_transform_reduce.hpp>
 #include <boost/compute/algorithm/detail/inplace_reduce.hpp>
+#include <boost/compute/algorithm/detail/multi_reduce.hpp>
 #include <boost/compute/algorithm/detail/reduce_on_gpu.hpp>
+#include <boost/compute/algorithm/detail/reproducible_reduce.hpp>
 #include <boost/compute/algorithm/detail/serial_reduce.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/detail/device_future.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/work_size.hpp>
 #include <boost/compute/memory/local_buffer.hpp>
 #include <boost/compute/type_traits/result_of.hpp>
+#include <boost/compute/type_traits/scalar_type.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/types/half.hpp>
 
 namespace boost {
 namespace compute {
@@ -48,8 +69,7 @@ size_t reduce(InputIterator first,
 
     const context &context = queue.get_context();
     size_t block_count = count / 2 / block_size;
-    size_t total_block_count =
-        static_cast<size_t>(std::ceil(float(count) / 2.f / float(block_size)));
+    size_t total_block_count = calculate_work_size(count, 2 * block_size, 1);
 
     if(block_count != 0){
         meta_kernel k("block_reduce");
@@ -80,6 +100,7 @@ size_t reduce(InputIterator first,
             "if(lid == 0)\n" <<
             "    output[get_group_id(0)] = block[0];\n";
 
+        k.set_reqd_work_group_size(block_size);
         kernel kernel = k.compile(context);
         kernel.set_arg(output_arg, result.get_buffer());
         kernel.set_arg(block_arg, local_buffer<input_type>(block_size));
@@ -121,38 +142,6 @@ size_t reduce(InputIterator first,
     return total_block_count;
 }
 
-template<class InputIterator, class BinaryFunction>
-inline vector<
-    typename boost::compute::result_of<
-        BinaryFunction(
-            typename std::iterator_traits<InputIterator>::value_type,
-            typename std::iterator_traits<InputIterator>::value_type
-        )
-    >::type
->
-block_reduce(InputIterator first,
-             size_t count,
-             size_t block_size,
-             BinaryFunction function,
-             command_queue &queue)
-{
-    typedef typename
-        std::iterator_traits<InputIterator>::value_type
-        input_type;
-    typedef typename
-        boost::compute::result_of<BinaryFunction(input_type, input_type)>::type
-        result_type;
-
-    const context &context = queue.get_context();
-    size_t total_block_count =
-        static_cast<size_t>(std::ceil(float(count) / 2.f / float(block_size)));
-    vector<result_type> result_vector(total_block_count, context);
-
-    reduce(first, count, result_vector.begin(), block_size, function, queue);
-
-    return result_vector;
-}
-
 template<class InputIterator, class OutputIterator, class BinaryFunction>
 inline void generic_reduce(InputIterator first,
                            InputIterator last,
@@ -168,24 +157,30 @@ inline void generic_reduce(InputIterator first,
         result_type;
 
     const device &device = queue.get_device();
-    const context &context = queue.get_context();
 
     size_t count = detail::iterator_range_size(first, last);
 
-    if(device.type() & device::cpu){
-        boost::compute::vector<result_type> value(1, context);
+    // small inputs (and devices without parallelism) are reduced by a
+    // single work-item
+    if(count < device_profile::get(device)->serial_threshold()){
+        scratch_vector<result_type> value(1, queue);
         detail::serial_reduce(first, last, value.begin(), function, queue);
         boost::compute::copy_n(value.begin(), 1, result, queue);
     }
     else {
-        size_t block_size = 256;
+        // the block size can be tuned with the "block_size" parameter of
+        // "__boost_reduce_<type>" in the parameter cache
+        size_t block_size = detail::get_work_group_size_parameter(
+            device,
+            std::string("__boost_reduce_") + type_name<result_type>(),
+            "block_size",
+            256
+        );
+        size_t block_count = calculate_work_size(count, 2 * block_size, 1);
 
         // first pass
-        vector<result_type> results = detail::block_reduce(first,
-                                                           count,
-                                                           block_size,
-                                                           function,
-                                                           queue);
+        scratch_vector<result_type> results(block_count, queue);
+        detail::reduce(first, count, results.begin(), block_size, function, queue);
 
         if(results.size() > 1){
             detail::inplace_reduce(results.begin(),
@@ -205,6 +200,18 @@ inline void dispatch_reduce(InputIterator first,
                             const plus<T> &function,
                             command_queue &queue)
 {
+    // buffers of scalar values are loaded with vectors of the width
+    // preferred by the device
+    if(fused_transform_reduce_vector_width(first, queue.get_device()) > 1){
+        fused_transform_reduce(first,
+                               iterator_range_size(first, last),
+                               identity<T>(),
+                               function,
+                               result,
+                               queue);
+        return;
+    }
+
     reduce_on_gpu(first, last, result, function, queue);
 }
 
@@ -235,6 +242,79 @@ inline void dispatch_reduce(InputIterator first,
     generic_reduce(first, last, result, function, queue);
 }
 
+// stores the reduced value to a device result (converting it for half_
+// and bfloat16_ results)
+template<class OutputIterator>
+inline void store_reduced_float(const buffer_iterator<float> value,
+                                OutputIterator result,
+                                command_queue &queue,
+                                typename boost::enable_if<
+                                    is_device_iterator<OutputIterator>
+                                >::type* = 0)
+{
+    copy_n(value, 1, result, queue);
+}
+
+template<class OutputIterator>
+inline void store_reduced_float(const buffer_iterator<float> value,
+                                OutputIterator result,
+                                command_queue &queue,
+                                typename boost::disable_if<
+                                    is_device_iterator<OutputIterator>
+                                >::type* = 0)
+{
+    *result = read_single_value<float>(value.get_buffer(), value.get_index(), queue);
+}
+
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void dispatch_reduce_values(InputIterator first,
+                                   InputIterator last,
+                                   OutputIterator result,
+                                   BinaryFunction function,
+                                   command_queue &queue)
+{
+#ifdef BOOST_COMPUTE_REPRODUCIBLE_REDUCTIONS
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        boost::compute::result_of<BinaryFunction(value_type, value_type)>::type
+        result_type;
+
+    // floating-point results only depend on the order of the operations,
+    // which the reproducible reduction fixes
+    if(boost::is_floating_point<typename scalar_type<result_type>::type>::value){
+        scratch_vector<result_type> value(1, queue);
+        reproducible_reduce(
+            first, iterator_range_size(first, last), value.begin(), function, queue
+        );
+        copy_n(value.begin(), 1, result, queue);
+        return;
+    }
+#endif // BOOST_COMPUTE_REPRODUCIBLE_REDUCTIONS
+
+    dispatch_reduce(first, last, result, function, queue);
+}
+
+// half_ and bfloat16_ values are read as floats and accumulated in float
+// with function
+template<class T, class OutputIterator, class BinaryFunction>
+inline typename boost::enable_if<is_half_type<T> >::type
+dispatch_reduce_values(buffer_iterator<T> first,
+                       buffer_iterator<T> last,
+                       OutputIterator result,
+                       BinaryFunction function,
+                       command_queue &queue)
+{
+    scratch_vector<float> value(1, queue);
+    fused_transform_reduce(first,
+                           iterator_range_size(first, last),
+                           identity<float>(),
+                           function,
+                           value.begin(),
+                           queue);
+
+    store_reduced_float(value.begin(), result, queue);
+}
+
 } // end detail namespace
 
 /// Returns the result of applying \p function to the elements in the
@@ -253,6 +333,12 @@ inline void dispatch_reduce(InputIterator first,
 /// be non-deterministic and vary in precision. Notably this affects the
 /// \c plus<float>() function as floating-point addition is not associative
 /// and may produce slightly different results than a serial algorithm.
+/// The partitioning of the reduction depends on the device, use
+/// \c reproducible_reduce() (or define \c BOOST_COMPUTE_REPRODUCIBLE_REDUCTIONS)
+/// for results which only depend on the input.
+///
+/// Ranges of \c half_ and \c bfloat16_ values are reduced in \c float
+/// (\p function is applied to the converted values).
 ///
 /// This algorithm supports both host and device iterators for the
 /// result argument. This allows for values to be reduced and copied
@@ -268,7 +354,7 @@ inline void dispatch_reduce(InputIterator first,
 /// efficient on parallel hardware. For more information, see the documentation
 /// on the \c accumulate() algorithm.
 ///
-/// \see accumulate()
+/// \see accumulate(), reproducible_reduce()
 template<class InputIterator, class OutputIterator, class BinaryFunction>
 inline void reduce(InputIterator first,
                    InputIterator last,
@@ -276,11 +362,27 @@ inline void reduce(InputIterator first,
                    BinaryFunction function,
                    command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("reduce")
+
     if(first == last){
         return;
     }
 
-    detail::dispatch_reduce(first, last, result, function, queue);
+    detail::dispatch_reduce_values(first, last, result, function, queue);
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void reduce(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   BinaryFunction function,
+                   command_queue &queue,
+                   const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    ::boost::compute::reduce(first, last, result, function, queue);
 }
 
 /// \overload
@@ -290,13 +392,155 @@ inline void reduce(InputIterator first,
                    OutputIterator result,
                    command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("reduce")
+
     typedef typename std::iterator_traits<InputIterator>::value_type T;
 
     if(first == last){
         return;
     }
 
-    detail::dispatch_reduce(first, last, result, plus<T>(), queue);
+    detail::dispatch_reduce_values(first, last, result, plus<T>(), queue);
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline void reduce(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   command_queue &queue,
+                   const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    ::boost::compute::reduce(first, last, result, queue);
+}
+
+/// \fn reduce(InputIterator first, InputIterator last, OutputIterator result, const boost::tuple<BinaryFunction0, ...> &functions, command_queue &queue = system::default_queue())
+///
+/// Reduces the values in the range [\p first, \p last) with each of the
+/// binary \p functions at once and stores the results to the tuple
+/// pointed to by \p result, the j-th field being the reduction with the
+/// j-th function.
+///
+/// The range is read a single time, each work-item keeps the tuple of its
+/// partial results which are then reduced in local memory field by field.
+/// This is faster than calling \c reduce() once for each function when the
+/// reductions are bound by the memory bandwidth.
+///
+/// For example, to compute the sum, the minimum and the maximum of a vector
+/// of floats:
+/// \code
+/// boost::tuple<float, float, float> stats;
+/// boost::compute::reduce(
+///     vector.begin(), vector.end(), &stats,
+///     boost::make_tuple(plus<float>(), min<float>(), max<float>()),
+///     queue
+/// );
+/// \endcode
+///
+/// The result types of the functions must be the value type of the range
+/// and the functions must be associative and commutative.
+///
+/// \see transform_reduce()
+#define BOOST_COMPUTE_DETAIL_REDUCE_IDENTITY(z, n, T) ::boost::compute::identity<T>
+
+#define BOOST_COMPUTE_DETAIL_DEFINE_MULTI_REDUCE(z, n, unused)                 \
+template<class InputIterator,                                                  \
+         class OutputIterator,                                                 \
+         BOOST_PP_ENUM_PARAMS(n, class BinaryFunction)>                        \
+inline void reduce(InputIterator first,                                        \
+                   InputIterator last,                                         \
+                   OutputIterator result,                                      \
+                   const boost::tuple<                                         \
+                       BOOST_PP_ENUM_PARAMS(n, BinaryFunction)                 \
+                   > &functions,                                               \
+                   command_queue &queue = system::default_queue())             \
+{                                                                              \
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("reduce")                             \
+                                                                               \
+    typedef typename std::iterator_traits<InputIterator>::value_type T;        \
+    typedef boost::tuple<                                                      \
+        BOOST_PP_ENUM(n, BOOST_COMPUTE_DETAIL_REDUCE_IDENTITY, T)              \
+    > transforms_type;                                                         \
+                                                                               \
+    detail::multi_transform_reduce(                                            \
+        first, last, result, transforms_type(), functions, queue               \
+    );                                                                         \
+}
+
+BOOST_PP_REPEAT_FROM_TO(1, BOOST_COMPUTE_MAX_ARITY, BOOST_COMPUTE_DETAIL_DEFINE_MULTI_REDUCE, ~)
+
+#undef BOOST_COMPUTE_DETAIL_DEFINE_MULTI_REDUCE
+#undef BOOST_COMPUTE_DETAIL_REDUCE_IDENTITY
+
+/// Asynchronous version of reduce(). The result is written to the device
+/// iterator \p result and the host is never blocked, the returned future
+/// is ready when the reduction is complete.
+///
+/// \return a future for the iterator past the result
+///
+/// \see reduce(), accumulate_async()
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline future<OutputIterator>
+reduce_async(InputIterator first,
+             InputIterator last,
+             OutputIterator result,
+             BinaryFunction function,
+             command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT_MSG(
+        is_device_iterator<OutputIterator>::value,
+        "reduce_async() requires a device iterator for the result"
+    );
+
+    if(first != last){
+        detail::dispatch_reduce_values(first, last, result, function, queue);
+    }
+
+    return detail::make_marker_future(result + 1, queue);
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline future<OutputIterator>
+reduce_async(InputIterator first,
+             InputIterator last,
+             OutputIterator result,
+             BinaryFunction function,
+             command_queue &queue,
+             const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::reduce_async(first, last, result, function, queue);
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline future<OutputIterator>
+reduce_async(InputIterator first,
+             InputIterator last,
+             OutputIterator result,
+             command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    return ::boost::compute::reduce_async(first, last, result, plus<T>(), queue);
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline future<OutputIterator>
+reduce_async(InputIterator first,
+             InputIterator last,
+             OutputIterator result,
+             command_queue &queue,
+             const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::reduce_async(first, last, result, queue);
 }
 
 } // end compute namespace
@@ -0,0 +1,195 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_REDUCE_BY_KEY_HPP
+#define BOOST_COMPUTE_ALGORITHM_REDUCE_BY_KEY_HPP
+
+#include <iterator>
+#include <utility>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/segmented_scan.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// writes the key of each segment, which is the key of its first element,
+// and the reduced value, which is the scanned value of its last element,
+// to the output
+template<class InputKeyIterator, class T, class OutputKeyIterator, class OutputValueIterator>
+inline void reduce_by_key_write_segments(InputKeyIterator keys_first,
+                                         buffer_iterator<uint_> segments_first,
+                                         buffer_iterator<T> scanned_values,
+                                         size_t count,
+                                         OutputKeyIterator keys_result,
+                                         OutputValueIterator values_result,
+                                         command_queue &queue)
+{
+    meta_kernel k("reduce_by_key_write_segments");
+    size_t count_arg = k.add_arg<const uint_>("count");
+
+    k <<
+        "const uint i = get_global_id(0);\n" <<
+        "const uint segment = " << segments_first[k.var<const uint_>("i")] << ";\n" <<
+        "if(i == 0 || segment != " <<
+            segments_first[k.expr<uint_>("i - 1")] << "){\n" <<
+        "    " << keys_result[k.var<const uint_>("segment")] << " = " <<
+                  keys_first[k.var<const uint_>("i")] << ";\n" <<
+        "}\n" <<
+        "if(i == count - 1 || segment != " <<
+            segments_first[k.expr<uint_>("i + 1")] << "){\n" <<
+        "    " << values_result[k.var<const uint_>("segment")] << " = " <<
+                  scanned_values[k.var<const uint_>("i")] << ";\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(count_arg, static_cast<uint_>(count));
+
+    queue.enqueue_1d_range_kernel(kernel, 0, count, 0);
+}
+
+} // end detail namespace
+
+/// Reduces each group of consecutive equal keys in the range
+/// [\p keys_first, \p keys_last) and their corresponding values beginning
+/// at \p values_first with \p function. The first key of each group is
+/// written to \p keys_result and the reduced value to \p values_result.
+///
+/// Two consecutive keys belong to the same group if \p predicate returns
+/// \c true for them. If no predicate is given, \c equal_to is used. If no
+/// function is given, \c plus is used.
+///
+/// \param keys_first first key in the input range
+/// \param keys_last last key in the input range
+/// \param values_first first value in the input range
+/// \param keys_result iterator to the output keys
+/// \param values_result iterator to the output values
+/// \param function binary reduction function
+/// \param predicate binary predicate comparing consecutive keys
+/// \param queue command queue to perform the operation
+///
+/// \return \c std::pair of iterators to the end of the output keys and
+/// the end of the output values
+///
+/// As with \c reduce(), \p function is assumed to be associative.
+///
+/// For example, to sum the values for each key:
+///
+/// \snippet test/test_reduce_by_key.cpp reduce_by_key_int
+///
+/// \see reduce()
+template<class InputKeyIterator,
+         class InputValueIterator,
+         class OutputKeyIterator,
+         class OutputValueIterator,
+         class BinaryFunction,
+         class BinaryPredicate>
+inline std::pair<OutputKeyIterator, OutputValueIterator>
+reduce_by_key(InputKeyIterator keys_first,
+              InputKeyIterator keys_last,
+              InputValueIterator values_first,
+              OutputKeyIterator keys_result,
+              OutputValueIterator values_result,
+              BinaryFunction function,
+              BinaryPredicate predicate,
+              command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("reduce_by_key")
+
+    typedef typename std::iterator_traits<OutputValueIterator>::value_type value_type;
+
+    const size_t count = detail::iterator_range_size(keys_first, keys_last);
+    if(count == 0){
+        return std::make_pair(keys_result, values_result);
+    }
+
+    // assign a segment index to each key
+    detail::scratch_vector<uint_> segments(count, queue);
+    detail::segment_ids(keys_first, count, segments.begin(), predicate, queue);
+
+    // scan the values within each segment
+    detail::scratch_vector<value_type> scanned_values(count, queue);
+    detail::segmented_inclusive_scan(
+        segments.begin(), count, values_first, scanned_values.begin(), function, queue
+    );
+
+    // write the last scanned value of each segment
+    detail::reduce_by_key_write_segments(
+        keys_first,
+        segments.begin(),
+        scanned_values.begin(),
+        count,
+        keys_result,
+        values_result,
+        queue
+    );
+
+    const size_t segment_count =
+        detail::read_single_value<uint_>(segments.get_buffer(), count - 1, queue) + 1;
+
+    return std::make_pair(keys_result + segment_count, values_result + segment_count);
+}
+
+/// \overload
+template<class InputKeyIterator,
+         class InputValueIterator,
+         class OutputKeyIterator,
+         class OutputValueIterator,
+         class BinaryFunction>
+inline std::pair<OutputKeyIterator, OutputValueIterator>
+reduce_by_key(InputKeyIterator keys_first,
+              InputKeyIterator keys_last,
+              InputValueIterator values_first,
+              OutputKeyIterator keys_result,
+              OutputValueIterator values_result,
+              BinaryFunction function,
+              command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputKeyIterator>::value_type key_type;
+
+    return ::boost::compute::reduce_by_key(
+        keys_first, keys_last, values_first, keys_result, values_result,
+        function, equal_to<key_type>(), queue
+    );
+}
+
+/// \overload
+template<class InputKeyIterator,
+         class InputValueIterator,
+         class OutputKeyIterator,
+         class OutputValueIterator>
+inline std::pair<OutputKeyIterator, OutputValueIterator>
+reduce_by_key(InputKeyIterator keys_first,
+              InputKeyIterator keys_last,
+              InputValueIterator values_first,
+              OutputKeyIterator keys_result,
+              OutputValueIterator values_result,
+              command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputKeyIterator>::value_type key_type;
+    typedef typename std::iterator_traits<OutputValueIterator>::value_type value_type;
+
+    return ::boost::compute::reduce_by_key(
+        keys_first, keys_last, values_first, keys_result, values_result,
+        plus<value_type>(), equal_to<key_type>(), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_REDUCE_BY_KEY_HPP
@@ -0,0 +1,135 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_REDUCE_COLUMNS_HPP
+#define BOOST_COMPUTE_ALGORITHM_REDUCE_COLUMNS_HPP
+
+#include <iterator>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/reduce_matrix.hpp>
+#include <boost/compute/container/array_view.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Reduces each column of the \p rows x \p columns row-major matrix
+/// starting at \p first with \p function and stores the result of column
+/// \c j to \c result[j]. Returns an iterator to the end of the results.
+///
+/// Work-groups reduce tiles of consecutive columns so that the values of
+/// each row of a tile are read together. When there are few columns the
+/// rows are also split between work-groups and their partial results are
+/// reduced by a second kernel.
+///
+/// For example, to find the largest value of each column of a 1000 x 640
+/// matrix:
+/// \code
+/// boost::compute::vector<float> maximums(640, context);
+/// boost::compute::reduce_columns(
+///     matrix.begin(), 1000, 640, maximums.begin(), max<float>(), queue
+/// );
+/// \endcode
+///
+/// As with \c reduce(), \p function is assumed to be associative and
+/// commutative.
+///
+/// \see reduce_rows(), reduce()
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline OutputIterator reduce_columns(InputIterator first,
+                                  size_t rows,
+                                  size_t columns,
+                                  OutputIterator result,
+                                  BinaryFunction function,
+                                  command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("reduce_columns")
+
+    if(rows == 0 || columns == 0){
+        return result;
+    }
+
+    detail::reduce_matrix_columns(
+        first, rows, columns, columns, 1, result, function, queue
+    );
+
+    return result + static_cast<std::ptrdiff_t>(columns);
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline OutputIterator reduce_columns(InputIterator first,
+                                  size_t rows,
+                                  size_t columns,
+                                  OutputIterator result,
+                                  command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    return ::boost::compute::reduce_columns(
+        first, rows, columns, result, plus<T>(), queue
+    );
+}
+
+/// Reduces each column of the two-dimensional \p view with \p function
+/// and stores the result of column \c j to \c result[j]. Returns an
+/// iterator to the end of the results.
+///
+/// The view may have any strides. The columns of a transposed view (whose
+/// columns are rows in memory) are reduced like the rows of the
+/// untransposed one.
+///
+/// \see reduce_rows()
+template<class T, class OutputIterator, class BinaryFunction>
+inline OutputIterator reduce_columns(const array_view<T, 2> &view,
+                                  OutputIterator result,
+                                  BinaryFunction function,
+                                  command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("reduce_columns")
+
+    const size_t rows = view.extent(0);
+    const size_t columns = view.extent(1);
+    if(rows == 0 || columns == 0){
+        return result;
+    }
+
+    const buffer_iterator<T> first(view.get_buffer(), view.offset());
+    if(view.stride(1) != 1 && view.stride(0) == 1){
+        detail::reduce_matrix_rows(
+            first, columns, rows, view.stride(1), 1, result, function, queue
+        );
+    }
+    else {
+        detail::reduce_matrix_columns(
+            first, rows, columns, view.stride(0), view.stride(1),
+            result, function, queue
+        );
+    }
+
+    return result + static_cast<std::ptrdiff_t>(columns);
+}
+
+/// \overload
+template<class T, class OutputIterator>
+inline OutputIterator reduce_columns(const array_view<T, 2> &view,
+                                  OutputIterator result,
+                                  command_queue &queue = system::default_queue())
+{
+    return ::boost::compute::reduce_columns(view, result, plus<T>(), queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_REDUCE_COLUMNS_HPP
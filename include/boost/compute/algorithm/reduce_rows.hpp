@@ -0,0 +1,132 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_REDUCE_ROWS_HPP
+#define BOOST_COMPUTE_ALGORITHM_REDUCE_ROWS_HPP
+
+#include <iterator>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/reduce_matrix.hpp>
+#include <boost/compute/container/array_view.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Reduces each row of the \p rows x \p columns row-major matrix starting
+/// at \p first with \p function and stores the result of row \c i to
+/// \c result[i]. Returns an iterator to the end of the results.
+///
+/// Each row is reduced by a work-group in a single kernel for all of the
+/// rows, contiguous rows of scalars are read with vector loads.
+///
+/// For example, to sum each of the rows of a 1000 x 640 matrix:
+/// \code
+/// boost::compute::vector<float> sums(1000, context);
+/// boost::compute::reduce_rows(
+///     matrix.begin(), 1000, 640, sums.begin(), plus<float>(), queue
+/// );
+/// \endcode
+///
+/// As with \c reduce(), \p function is assumed to be associative and
+/// commutative.
+///
+/// \see reduce_columns(), reduce()
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline OutputIterator reduce_rows(InputIterator first,
+                                  size_t rows,
+                                  size_t columns,
+                                  OutputIterator result,
+                                  BinaryFunction function,
+                                  command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("reduce_rows")
+
+    if(rows == 0 || columns == 0){
+        return result;
+    }
+
+    detail::reduce_matrix_rows(
+        first, rows, columns, columns, 1, result, function, queue
+    );
+
+    return result + static_cast<std::ptrdiff_t>(rows);
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline OutputIterator reduce_rows(InputIterator first,
+                                  size_t rows,
+                                  size_t columns,
+                                  OutputIterator result,
+                                  command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    return ::boost::compute::reduce_rows(
+        first, rows, columns, result, plus<T>(), queue
+    );
+}
+
+/// Reduces each row of the two-dimensional \p view with \p function and
+/// stores the result of row \c i to \c result[i]. Returns an iterator to
+/// the end of the results.
+///
+/// The view may have any strides. The rows of a transposed view (whose
+/// rows are columns in memory) are reduced like the columns of the
+/// untransposed one, with coalesced reads.
+///
+/// \see reduce_columns()
+template<class T, class OutputIterator, class BinaryFunction>
+inline OutputIterator reduce_rows(const array_view<T, 2> &view,
+                                  OutputIterator result,
+                                  BinaryFunction function,
+                                  command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("reduce_rows")
+
+    const size_t rows = view.extent(0);
+    const size_t columns = view.extent(1);
+    if(rows == 0 || columns == 0){
+        return result;
+    }
+
+    const buffer_iterator<T> first(view.get_buffer(), view.offset());
+    if(view.stride(1) != 1 && view.stride(0) == 1){
+        detail::reduce_matrix_columns(
+            first, columns, rows, view.stride(1), 1, result, function, queue
+        );
+    }
+    else {
+        detail::reduce_matrix_rows(
+            first, rows, columns, view.stride(0), view.stride(1),
+            result, function, queue
+        );
+    }
+
+    return result + static_cast<std::ptrdiff_t>(rows);
+}
+
+/// \overload
+template<class T, class OutputIterator>
+inline OutputIterator reduce_rows(const array_view<T, 2> &view,
+                                  OutputIterator result,
+                                  command_queue &queue = system::default_queue())
+{
+    return ::boost::compute::reduce_rows(view, result, plus<T>(), queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_REDUCE_ROWS_HPP
@@ -29,6 +29,8 @@ inline Iterator remove_if(Iterator first,
                           Predicate predicate,
                           command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("remove_if")
+
     typedef typename std::iterator_traits<Iterator>::value_type value_type;
 
     // temporary storage for the input data
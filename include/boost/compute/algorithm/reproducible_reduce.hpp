@@ -0,0 +1,93 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_REPRODUCIBLE_REDUCE_HPP
+#define BOOST_COMPUTE_ALGORITHM_REPRODUCIBLE_REDUCE_HPP
+
+#include <iterator>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/detail/reproducible_reduce.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Reduces the values in the range [\p first, \p last) with \p function
+/// like \c reduce(), but in an order which only depends on the number of
+/// values. The result, including its floating-point rounding, is the same
+/// for every run and on every device.
+///
+/// The range is split in blocks of 1024 values. Each of the 32 lanes of a
+/// block reduces every 32nd value of the block in order, and the results of
+/// the lanes are reduced the same way until at most 1024 values remain,
+/// which are then reduced in order. The partitioning doesn't depend on the
+/// work-group sizes of the device. The kernels are built with floating-point
+/// contraction disabled so that no multiply-add is fused.
+///
+/// This is slower than \c reduce(), which partitions the range for the
+/// device and may combine the values in a different order. Defining
+/// \c BOOST_COMPUTE_REPRODUCIBLE_REDUCTIONS makes \c reduce() of
+/// floating-point values use this algorithm.
+///
+/// For example, to compute an auditable sum:
+/// \code
+/// float sum = 0;
+/// boost::compute::reproducible_reduce(
+///     values.begin(), values.end(), &sum, plus<float>(), queue
+/// );
+/// \endcode
+///
+/// \see reduce()
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void reproducible_reduce(InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                BinaryFunction function,
+                                command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("reproducible_reduce")
+
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        boost::compute::result_of<BinaryFunction(value_type, value_type)>::type
+        result_type;
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    detail::scratch_vector<result_type> value(1, queue);
+    detail::reproducible_reduce(first, count, value.begin(), function, queue);
+    ::boost::compute::copy_n(value.begin(), 1, result, queue);
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline void reproducible_reduce(InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    ::boost::compute::reproducible_reduce(first, last, result, plus<T>(), queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_REPRODUCIBLE_REDUCE_HPP
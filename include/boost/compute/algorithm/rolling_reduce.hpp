@@ -0,0 +1,308 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_ROLLING_REDUCE_HPP
+#define BOOST_COMPUTE_ALGORITHM_ROLLING_REDUCE_HPP
+
+#include <string>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/inclusive_scan.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// reduces each window directly from a tile of the input in local memory.
+// each work-item reduces the window starting at its position so the work
+// is O(window) per output, which is the cheapest for short windows.
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void rolling_reduce_tiled(InputIterator first,
+                                 size_t count,
+                                 size_t window,
+                                 OutputIterator result,
+                                 BinaryFunction function,
+                                 command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        boost::compute::result_of<BinaryFunction(value_type, value_type)>::type T;
+
+    const size_t output_count = count - window + 1;
+
+    meta_kernel k("rolling_reduce_tiled");
+    size_t tile_arg = k.add_arg<value_type *>(memory_object::local_memory, "tile");
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t window_arg = k.add_arg<const uint_>("window");
+
+    k <<
+        "const uint gid = get_global_id(0);\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint group_start = get_group_id(0) * get_local_size(0);\n" <<
+        "const uint span = min((uint) get_local_size(0) + window - 1, count - group_start);\n" <<
+        "for(uint j = lid; j < span; j += get_local_size(0)){\n" <<
+        "    tile[j] = " << first[k.var<uint_>("group_start + j")] << ";\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "if(gid + window <= count){\n" <<
+        "    " << k.decl<T>("sum") << " = tile[lid];\n" <<
+        "    for(uint j = 1; j < window; j++){\n" <<
+        "        sum = " << function(k.var<T>("sum"), k.var<value_type>("tile[lid + j]")) << ";\n" <<
+        "    }\n" <<
+        "    " << result[k.var<uint_>("gid")] << " = sum;\n" <<
+        "}\n";
+
+    const device &device = queue.get_device();
+    size_t work_group_size = k.work_group_size(queue, 256);
+    while(work_group_size > 1 &&
+          (work_group_size + window - 1) * sizeof(value_type) > device.local_memory_size() / 2){
+        work_group_size /= 2;
+    }
+
+    k.set_arg(tile_arg, local_buffer<value_type>(work_group_size + window - 1));
+    k.set_arg(count_arg, static_cast<uint_>(count));
+    k.set_arg(window_arg, static_cast<uint_>(window));
+
+    const size_t work_groups = (output_count + work_group_size - 1) / work_group_size;
+    k.exec_1d(queue, 0, work_groups * work_group_size, work_group_size);
+}
+
+// van Herk/Gil-Werman algorithm. the input is split into blocks of window
+// values and the prefix and suffix reductions of each block are computed.
+// a window then covers the end of one block and the start of the next and
+// its reduction is the suffix at its first value combined with the prefix
+// at its last value, which is O(1) work per output for any window size
+// (and any associative function, e.g. min and max).
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void rolling_reduce_van_herk(InputIterator first,
+                                    size_t count,
+                                    size_t window,
+                                    OutputIterator result,
+                                    BinaryFunction function,
+                                    command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        boost::compute::result_of<BinaryFunction(value_type, value_type)>::type T;
+
+    const size_t output_count = count - window + 1;
+    const size_t blocks = (count + window - 1) / window;
+
+    scratch_vector<T> prefix(count, queue);
+    scratch_vector<T> suffix(count, queue);
+
+    // one work-item per block computes its prefix and suffix
+    meta_kernel block_kernel("rolling_reduce_blocks");
+    size_t block_count_arg = block_kernel.add_arg<const uint_>("count");
+    size_t block_window_arg = block_kernel.add_arg<const uint_>("window");
+    block_kernel <<
+        "const uint start = get_global_id(0) * window;\n" <<
+        "const uint end = min(start + window, count);\n" <<
+        block_kernel.decl<T>("value") << " = " <<
+            first[block_kernel.var<uint_>("start")] << ";\n" <<
+        prefix.begin()[block_kernel.var<uint_>("start")] << " = value;\n" <<
+        "for(uint i = start + 1; i < end; i++){\n" <<
+        "    value = " << function(block_kernel.var<T>("value"),
+                                   first[block_kernel.var<uint_>("i")]) << ";\n" <<
+        "    " << prefix.begin()[block_kernel.var<uint_>("i")] << " = value;\n" <<
+        "}\n" <<
+        "value = " << first[block_kernel.var<uint_>("end - 1")] << ";\n" <<
+        suffix.begin()[block_kernel.var<uint_>("end - 1")] << " = value;\n" <<
+        "for(uint i = end - 1; i > start; i--){\n" <<
+        "    value = " << function(first[block_kernel.var<uint_>("i - 1")],
+                                   block_kernel.var<T>("value")) << ";\n" <<
+        "    " << suffix.begin()[block_kernel.var<uint_>("i - 1")] << " = value;\n" <<
+        "}\n";
+    block_kernel.set_arg(block_count_arg, static_cast<uint_>(count));
+    block_kernel.set_arg(block_window_arg, static_cast<uint_>(window));
+    block_kernel.exec_1d(queue, 0, blocks);
+
+    // a window starting at a block start is that block
+    meta_kernel combine_kernel("rolling_reduce_combine");
+    size_t combine_window_arg = combine_kernel.add_arg<const uint_>("window");
+    combine_kernel <<
+        "const uint i = get_global_id(0);\n" <<
+        "if(i % window == 0){\n" <<
+        "    " << result[combine_kernel.var<uint_>("i")] << " = " <<
+                  suffix.begin()[combine_kernel.var<uint_>("i")] << ";\n" <<
+        "}\n" <<
+        "else {\n" <<
+        "    " << result[combine_kernel.var<uint_>("i")] << " = " <<
+                  function(suffix.begin()[combine_kernel.var<uint_>("i")],
+                           prefix.begin()[combine_kernel.var<uint_>("i + window - 1")]) << ";\n" <<
+        "}\n";
+    combine_kernel.set_arg(combine_window_arg, static_cast<uint_>(window));
+    combine_kernel.exec_1d(queue, 0, output_count);
+}
+
+// sums of integers are differences of the inclusive scan, which is exact
+// and needs one temporary instead of two
+template<class InputIterator, class OutputIterator>
+inline void rolling_reduce_scan_difference(InputIterator first,
+                                           size_t count,
+                                           size_t window,
+                                           OutputIterator result,
+                                           command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    scratch_vector<T> sums(count, queue);
+    ::boost::compute::inclusive_scan(
+        first, first + static_cast<std::ptrdiff_t>(count), sums.begin(), queue
+    );
+
+    meta_kernel k("rolling_reduce_difference");
+    size_t window_arg = k.add_arg<const uint_>("window");
+    k <<
+        "const uint i = get_global_id(0);\n" <<
+        result[k.var<uint_>("i")] << " = " <<
+            sums.begin()[k.var<uint_>("i + window - 1")] << " - (i == 0 ? 0 : " <<
+            sums.begin()[k.var<uint_>("i == 0 ? 0 : i - 1")] << ");\n";
+    k.set_arg(window_arg, static_cast<uint_>(window));
+    k.exec_1d(queue, 0, count - window + 1);
+}
+
+// returns the largest window reduced directly by rolling_reduce_tiled().
+// it can be tuned with the "tiled_window" parameter of the
+// "__boost_rolling_reduce_<type>" object in the parameter cache.
+template<class T>
+inline size_t rolling_reduce_tiled_window(command_queue &queue)
+{
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(queue.get_device());
+
+    return parameters->get(
+        std::string("__boost_rolling_reduce_") + type_name<T>(), "tiled_window", 16
+    );
+}
+
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void dispatch_rolling_reduce(InputIterator first,
+                                    size_t count,
+                                    size_t window,
+                                    OutputIterator result,
+                                    BinaryFunction function,
+                                    command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    if(window <= rolling_reduce_tiled_window<value_type>(queue)){
+        rolling_reduce_tiled(first, count, window, result, function, queue);
+    }
+    else {
+        rolling_reduce_van_herk(first, count, window, result, function, queue);
+    }
+}
+
+template<class InputIterator, class OutputIterator, class T>
+inline void dispatch_rolling_reduce(InputIterator first,
+                                    size_t count,
+                                    size_t window,
+                                    OutputIterator result,
+                                    plus<T> function,
+                                    command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    if(window <= rolling_reduce_tiled_window<value_type>(queue)){
+        rolling_reduce_tiled(first, count, window, result, function, queue);
+    }
+    else if(boost::is_integral<T>::value &&
+            boost::is_same<T, value_type>::value){
+        rolling_reduce_scan_difference(first, count, window, result, queue);
+    }
+    else {
+        // differences of floating-point prefix sums lose the precision of
+        // the values which are small relative to the sum
+        rolling_reduce_van_herk(first, count, window, result, function, queue);
+    }
+}
+
+} // end detail namespace
+
+/// Reduces each window of \p window consecutive values in the range
+/// [\p first, \p last) with \p function and stores the result for the
+/// window starting at \c first[i] at \c result[i]. Returns an iterator to
+/// the end of the \c (last - first - window + 1) results (or \p result if
+/// the range is shorter than the window).
+///
+/// This computes rolling sums, minimums and maximums (e.g. for moving
+/// averages or price channels) without reducing each window separately.
+/// Short windows are reduced directly from a tile of the input in local
+/// memory, without temporaries. Longer windows of integer sums are the
+/// differences of an inclusive scan of the input, while other long windows
+/// use the van Herk/Gil-Werman algorithm which combines the prefix and
+/// suffix reductions of blocks of \p window values with O(1) work per
+/// window for any associative \p function.
+///
+/// For example, the rolling maximum of the last 20 prices:
+/// \code
+/// boost::compute::rolling_reduce(
+///     prices.begin(), prices.end(), highs.begin(), 20,
+///     boost::compute::max<float>(), queue
+/// );
+/// \endcode
+///
+/// \see reduce(), inclusive_scan()
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline OutputIterator rolling_reduce(InputIterator first,
+                                     InputIterator last,
+                                     OutputIterator result,
+                                     size_t window,
+                                     BinaryFunction function,
+                                     command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<OutputIterator>::difference_type difference_type;
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(window == 0 || count < window){
+        return result;
+    }
+
+    detail::dispatch_rolling_reduce(first, count, window, result, function, queue);
+
+    return result + static_cast<difference_type>(count - window + 1);
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline OutputIterator rolling_reduce(InputIterator first,
+                                     InputIterator last,
+                                     OutputIterator result,
+                                     size_t window,
+                                     command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    return ::boost::compute::rolling_reduce(
+        first, last, result, window, plus<T>(), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_ROLLING_REDUCE_HPP
@@ -12,16 +12,20 @@
 #define BOOST_COMPUTE_ALGORITHM_ROTATE_HPP
 
 #include <boost/compute/system.hpp>
-#include <boost/compute/algorithm/copy.hpp>
-#include <boost/compute/container/vector.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/reverse.hpp>
 
 namespace boost {
 namespace compute {
 
-/// Performs left rotation such that element at \p n_first comes to the
-/// beginning.
+/// Rotates the elements in the range [\p first, \p last) so that
+/// \p n_first becomes the first element.
 ///
-/// \see rotate_copy()
+/// The rotation is done in place by reversing [\p first, \p n_first) and
+/// [\p n_first, \p last) and then the whole range, without allocating a
+/// temporary copy of the range.
+///
+/// \see rotate_copy(), reverse()
 template<class InputIterator>
 inline void rotate(InputIterator first,
                    InputIterator n_first,
@@ -34,18 +38,9 @@ inline void rotate(InputIterator first,
         return;
     }
 
-    //Handle others
-    typedef typename std::iterator_traits<InputIterator>::value_type T;
-
-    size_t count = detail::iterator_range_size(first, n_first);
-    size_t count2 = detail::iterator_range_size(first, last);
-
-    const context &context = queue.get_context();
-    vector<T> temp(count2, context);
-    ::boost::compute::copy(first, last, temp.begin(), queue);
-
-    ::boost::compute::copy(temp.begin()+count, temp.end(), first, queue);
-    ::boost::compute::copy(temp.begin(), temp.begin()+count, last-count, queue);
+    ::boost::compute::reverse(first, n_first, queue);
+    ::boost::compute::reverse(n_first, last, queue);
+    ::boost::compute::reverse(first, last, queue);
 }
 
 } //end compute namespace
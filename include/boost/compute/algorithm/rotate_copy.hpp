@@ -12,13 +12,18 @@
 #define BOOST_COMPUTE_ALGORITHM_ROTATE_COPY_HPP
 
 #include <boost/compute/system.hpp>
-#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
 
-/// Performs left rotation such that element at n_first comes to the
-/// beginning and the output is stored in range starting at result.
+/// Copies the elements in the range [\p first, \p last) rotated so that
+/// \p n_first is the first element copied to \p result.
+///
+/// Both parts of the range are copied by a single kernel computing the
+/// source index of each element of the result.
 ///
 /// \see rotate()
 template<class InputIterator, class OutputIterator>
@@ -30,9 +35,21 @@ inline void rotate_copy(InputIterator first,
 {
     size_t count = detail::iterator_range_size(first, n_first);
     size_t count2 = detail::iterator_range_size(n_first, last);
+    if(count + count2 == 0){
+        return;
+    }
+
+    detail::meta_kernel k("rotate_copy");
+    k.add_set_arg<const uint_>("count", static_cast<uint_>(count));
+    k.add_set_arg<const uint_>("count2", static_cast<uint_>(count2));
+
+    k <<
+        "const uint i = get_global_id(0);\n" <<
+        "const uint j = i < count2 ? count + i : i - count2;\n" <<
+        result[k.var<const uint_>("i")] << " = " <<
+            first[k.var<const uint_>("j")] << ";\n";
 
-    ::boost::compute::copy(first+count, last, result, queue);
-    ::boost::compute::copy(first, first+count, result+count2, queue);
+    k.exec_1d(queue, 0, count + count2);
 }
 
 } //end compute namespace
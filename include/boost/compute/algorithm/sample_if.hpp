@@ -0,0 +1,112 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SAMPLE_IF_HPP
+#define BOOST_COMPUTE_ALGORITHM_SAMPLE_IF_HPP
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// selects the value with index i if the i-th random number of the
+// generator is below threshold (sample_if)
+template<class Generator>
+struct stream_compact_sample
+{
+    stream_compact_sample(const Generator &generator_, ulong_ threshold_)
+        : generator(generator_),
+          threshold(threshold_)
+    {
+    }
+
+    void select(meta_kernel &k) const
+    {
+        k << "(ulong) ";
+        generator.random_number(k, "i");
+        k << " < ";
+        k.insert_capture(threshold);
+    }
+
+    const Generator &generator;
+    ulong_ threshold;
+};
+
+} // end detail namespace
+
+/// Copies each element of the range [\p first, \p last) with probability
+/// \p p to the range beginning at \p result, keeping their order, and
+/// returns an iterator to the end of the output range.
+///
+/// This gives the same result as generating a bernoulli_distribution mask
+/// and calling copy_if() with it, but the random numbers are drawn by the
+/// kernels of copy_if() themselves, so no mask is stored in memory. The
+/// i-th value is selected if the i-th random number of \p generator is
+/// below <tt>p * 2^32</tt>, the generator is then advanced past the
+/// numbers drawn for the range.
+///
+/// The generator has to compute any of its random numbers directly, which
+/// is the case for philox_engine (the default_random_engine) and
+/// linear_congruential_engine.
+///
+/// For example, to keep each of the activations with probability 0.9:
+/// \code
+/// boost::compute::default_random_engine engine(queue);
+/// vector<float>::iterator end = boost::compute::sample_if(
+///     activations.begin(), activations.end(), kept.begin(), 0.9f, engine, queue
+/// );
+/// \endcode
+///
+/// \see copy_if(), bernoulli_distribution
+template<class InputIterator, class OutputIterator, class Generator>
+inline OutputIterator sample_if(InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                float p,
+                                Generator &generator,
+                                command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("sample_if")
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return result;
+    }
+
+    // values are selected if their random number is below p * 2^32
+    const double scaled = std::floor((std::min)((std::max)(double(p), 0.0), 1.0) * 4294967296.0);
+    const ulong_ threshold = static_cast<ulong_>(scaled);
+
+    OutputIterator end = detail::stream_compact(
+        first,
+        count,
+        result,
+        detail::stream_compact_sample<Generator>(generator, threshold),
+        false,
+        queue
+    );
+
+    generator.discard(count, queue);
+
+    return end;
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SAMPLE_IF_HPP
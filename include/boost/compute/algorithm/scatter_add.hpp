@@ -0,0 +1,51 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SCATTER_ADD_HPP
+#define BOOST_COMPUTE_ALGORITHM_SCATTER_ADD_HPP
+
+#include <iterator>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/functional/atomic.hpp>
+#include <boost/compute/algorithm/scatter_reduce.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Atomically adds each element of the range [\p first, \p last) to the
+/// element of the range beginning at \p result given by the corresponding
+/// index in the range beginning at \p map, i.e. \c result[map[i]] \c +=
+/// \c first[i]. Indices may repeat.
+///
+/// \c float and \c double values are supported (e.g. for histograms of
+/// weights). The order of additions to the same element is unspecified so
+/// the sums of floating-point values may differ between runs.
+///
+/// \see scatter_reduce(), atomic_add
+template<class InputIterator, class MapIterator, class OutputIterator>
+inline void scatter_add(InputIterator first,
+                        InputIterator last,
+                        MapIterator map,
+                        OutputIterator result,
+                        command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<OutputIterator>::value_type value_type;
+
+    ::boost::compute::scatter_reduce(
+        first, last, map, result, atomic_add<value_type>(), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SCATTER_ADD_HPP
@@ -0,0 +1,87 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SCATTER_IF_HPP
+#define BOOST_COMPUTE_ALGORITHM_SCATTER_IF_HPP
+
+#include <iterator>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/functional/identity.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Copies each element of the range [\p first, \p last) for which
+/// \p predicate returns \c true for the corresponding element of the
+/// range beginning at \p stencil to the range beginning at \p result using
+/// the output indices from the range beginning at \p map, i.e.
+/// \c result[map[i]] is set to \c first[i] if \c predicate(stencil[i]).
+///
+/// If no predicate is specified, the elements with a non-zero stencil
+/// value are copied.
+///
+/// \see scatter(), gather_if()
+template<class InputIterator,
+         class MapIterator,
+         class StencilIterator,
+         class OutputIterator,
+         class Predicate>
+inline void scatter_if(InputIterator first,
+                       InputIterator last,
+                       MapIterator map,
+                       StencilIterator stencil,
+                       OutputIterator result,
+                       Predicate predicate,
+                       command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("scatter_if")
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    detail::meta_kernel k("scatter_if");
+    k << "const uint i = get_global_id(0);\n" <<
+         "if(" << predicate(stencil[k.var<uint_>("i")]) << "){\n" <<
+         "    " << result[map[k.var<uint_>("i")]] << " = " <<
+                   first[k.var<uint_>("i")] << ";\n" <<
+         "}\n";
+
+    k.exec_1d(queue, 0, count);
+}
+
+/// \overload
+template<class InputIterator,
+         class MapIterator,
+         class StencilIterator,
+         class OutputIterator>
+inline void scatter_if(InputIterator first,
+                       InputIterator last,
+                       MapIterator map,
+                       StencilIterator stencil,
+                       OutputIterator result,
+                       command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<StencilIterator>::value_type stencil_type;
+
+    ::boost::compute::scatter_if(
+        first, last, map, stencil, result, identity<stencil_type>(), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SCATTER_IF_HPP
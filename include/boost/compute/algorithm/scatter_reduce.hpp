@@ -0,0 +1,85 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SCATTER_REDUCE_HPP
+#define BOOST_COMPUTE_ALGORITHM_SCATTER_REDUCE_HPP
+
+#include <iterator>
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/detail/is_buffer_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Combines each element of the range [\p first, \p last) with the element
+/// of the range beginning at \p result given by the corresponding index in
+/// the range beginning at \p map, i.e. \c atomic_function(&result[map[i]],
+/// first[i]) is called for each \c i.
+///
+/// Unlike scatter(), indices may repeat: \p atomic_function must update
+/// the value atomically (e.g. atomic_add, atomic_min or atomic_max, which
+/// also support \c float and \c double values). The order in which the
+/// values of repeated indices are combined is unspecified.
+///
+/// \p result must be a buffer iterator.
+///
+/// For example, to accumulate the points of each cluster:
+/// \code
+/// boost::compute::scatter_reduce(
+///     weights.begin(), weights.end(), cluster.begin(), totals.begin(),
+///     boost::compute::atomic_add<float>(), queue
+/// );
+/// \endcode
+///
+/// \see scatter_add(), scatter()
+template<class InputIterator,
+         class MapIterator,
+         class OutputIterator,
+         class AtomicFunction>
+inline void scatter_reduce(InputIterator first,
+                           InputIterator last,
+                           MapIterator map,
+                           OutputIterator result,
+                           AtomicFunction atomic_function,
+                           command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(detail::is_buffer_iterator<OutputIterator>::value);
+
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("scatter_reduce")
+
+    typedef typename std::iterator_traits<OutputIterator>::value_type value_type;
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    detail::meta_kernel k("scatter_reduce");
+    k << "const uint i = get_global_id(0);\n" <<
+         "__global " << type_name<value_type>() << " *p = &" <<
+             result[map[k.var<uint_>("i")]] << ";\n" <<
+         atomic_function(
+             k.var<value_type *>("p"), first[k.var<uint_>("i")]
+         ) << ";\n";
+
+    k.exec_1d(queue, 0, count);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SCATTER_REDUCE_HPP
@@ -0,0 +1,131 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SCRATCH_SIZE_HPP
+#define BOOST_COMPUTE_ALGORITHM_SCRATCH_SIZE_HPP
+
+#include <boost/mpl/bool.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/merge_sort_on_gpu.hpp>
+#include <boost/compute/algorithm/detail/radix_sort.hpp>
+#include <boost/compute/algorithm/detail/set_operation.hpp>
+#include <boost/compute/utility/buffer_pool.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+template<class Key, class Value>
+inline size_t sort_scratch_size(size_t count,
+                                bool sort_by_key,
+                                command_queue &queue,
+                                boost::mpl::true_)
+{
+    return radix_sort_scratch_size<Key, Value>(count, sort_by_key, queue);
+}
+
+template<class Key, class Value>
+inline size_t sort_scratch_size(size_t count,
+                                bool sort_by_key,
+                                command_queue &queue,
+                                boost::mpl::false_)
+{
+    return merge_sort_on_gpu_scratch_size<Key, Value>(count, sort_by_key, queue);
+}
+
+} // end detail namespace
+
+/// Returns the number of bytes of temporary device memory used by sort()
+/// for \p count values of type \c T (with the default comparison
+/// function).
+///
+/// The scratch size functions return the total size of the temporary
+/// buffers an algorithm allocates (rounded up to the size classes of the
+/// buffer_pool). A few bytes of per-work-group bookkeeping of nested
+/// algorithms (e.g. the block sums of scans) are not included. They can be
+/// used to check whether a job fits into the available memory before
+/// running it, or to size a scratch_space.
+///
+/// \see scratch_space, memory_usage
+template<class T>
+inline size_t sort_scratch_size(size_t count,
+                                command_queue &queue = system::default_queue())
+{
+    if(count <= 32){
+        return 0;
+    }
+
+    return detail::sort_scratch_size<T, T>(
+        count, false, queue, typename detail::is_radix_sortable<T>::type()
+    );
+}
+
+/// Returns the number of bytes of temporary device memory used by
+/// sort_by_key() for \p count keys of type \c Key and values of type
+/// \c Value (with the default comparison function).
+///
+/// \see sort_scratch_size()
+template<class Key, class Value>
+inline size_t sort_by_key_scratch_size(size_t count,
+                                       command_queue &queue = system::default_queue())
+{
+    if(count < 32){
+        return 0;
+    }
+
+    return detail::sort_scratch_size<Key, Value>(
+        count, true, queue, typename detail::is_radix_sortable<Key>::type()
+    );
+}
+
+/// Returns the number of bytes of temporary device memory used by
+/// is_permutation() for two ranges of \p count values of type \c T.
+///
+/// \see sort_scratch_size()
+template<class T>
+inline size_t is_permutation_scratch_size(size_t count,
+                                          command_queue &queue = system::default_queue())
+{
+    // both ranges are copied and sorted one after the other
+    return 2 * buffer_pool::size_class(count * sizeof(T)) +
+           sort_scratch_size<T>(count, queue);
+}
+
+/// Returns the number of bytes of temporary device memory used by
+/// inplace_merge() for sorted ranges of \p count1 and \p count2 values of
+/// type \c T.
+///
+/// \see sort_scratch_size()
+template<class T>
+inline size_t inplace_merge_scratch_size(size_t count1, size_t count2)
+{
+    return buffer_pool::size_class((count1 + count2) * sizeof(T));
+}
+
+/// Returns the number of bytes of temporary device memory used by
+/// set_union(), set_intersection(), set_difference() and
+/// set_symmetric_difference() for sorted ranges of \p count1 and \p count2
+/// values of type \c T.
+///
+/// \see sort_scratch_size()
+template<class T>
+inline size_t set_operation_scratch_size(size_t count1,
+                                         size_t count2,
+                                         command_queue &queue = system::default_queue())
+{
+    return detail::set_operation_scratch_size<T>(count1, count2, queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SCRATCH_SIZE_HPP
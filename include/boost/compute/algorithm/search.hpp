@@ -11,11 +11,9 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_SEARCH_HPP
 #define BOOST_COMPUTE_ALGORITHM_SEARCH_HPP
 
+#include <iterator>
+
 #include <boost/compute/algorithm/detail/search_all.hpp>
-#include <boost/compute/algorithm/find.hpp>
-#include <boost/compute/container/vector.hpp>
-#include <boost/compute/detail/iterator_range_size.hpp>
-#include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/system.hpp>
 
 namespace boost {
@@ -34,6 +32,10 @@ namespace compute {
 /// \param p_last Iterator pointing to end of pattern
 /// \param queue Queue on which to execute
 ///
+/// The candidate positions are checked in chunks and the search stops
+/// once a match has been found, so the cost grows with the position of
+/// the first match rather than with the size of the text.
+///
 template<class TextIterator, class PatternIterator>
 inline TextIterator search(TextIterator t_first,
                            TextIterator t_last,
@@ -41,21 +43,12 @@ inline TextIterator search(TextIterator t_first,
                            PatternIterator p_last,
                            command_queue &queue = system::default_queue())
 {
-    vector<uint_> matching_indices(detail::iterator_range_size(t_first, t_last),
-                                    queue.get_context());
-
-    detail::search_kernel<PatternIterator,
-                          TextIterator,
-                          vector<uint_>::iterator> kernel;
-
-    kernel.set_range(p_first, p_last, t_first, t_last, matching_indices.begin());
-    kernel.exec(queue);
+    typedef typename std::iterator_traits<TextIterator>::difference_type difference_type;
 
-    vector<uint_>::iterator index = ::boost::compute::find(
-        matching_indices.begin(), matching_indices.end(), uint_(1), queue
-    );
+    const size_t position =
+        detail::search_position(t_first, t_last, p_first, p_last, false, queue);
 
-    return t_first + detail::iterator_range_size(matching_indices.begin(), index);
+    return t_first + static_cast<difference_type>(position);
 }
 
 } //end compute namespace
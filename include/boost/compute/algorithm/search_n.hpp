@@ -13,8 +13,8 @@
 
 #include <iterator>
 
-#include <boost/compute/algorithm/find.hpp>
-#include <boost/compute/container/vector.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/find_with_early_exit.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/system.hpp>
@@ -23,68 +23,37 @@ namespace boost {
 namespace compute {
 namespace detail {
 
-///
-/// \brief Search kernel class
-///
-/// Subclass of meta_kernel which is capable of performing search_n
-///
-template<class TextIterator, class OutputIterator>
-class search_n_kernel : public meta_kernel
+// emits code which sets "match" to true if the n values starting at
+// position "i" of the text all equal value (for find_with_early_exit())
+template<class TextIterator>
+class search_n_matcher
 {
 public:
     typedef typename std::iterator_traits<TextIterator>::value_type value_type;
 
-    search_n_kernel() : meta_kernel("search_n")
-    {}
-
-    void set_range(TextIterator t_first,
-                   TextIterator t_last,
-                   value_type value,
-                   size_t n,
-                   OutputIterator result)
+    search_n_matcher(TextIterator t_first, size_t n, const value_type &value)
+        : m_t_first(t_first),
+          m_n(n),
+          m_value(value)
     {
-        m_n = n;
-        m_n_arg = add_arg<uint_>("n");
-
-        m_value = value;
-        m_value_arg = add_arg<value_type>("value");
-
-        m_count = iterator_range_size(t_first, t_last);
-        m_count = m_count + 1 - m_n;
-
-        *this <<
-            "uint i = get_global_id(0);\n" <<
-            "uint i1 = i;\n" <<
-            "uint j;\n" <<
-            "for(j = 0; j<n; j++,i++)\n" <<
-            "{\n" <<
-            "   if(value != " << t_first[expr<uint_>("i")] << ")\n" <<
-            "       j = n + 1;\n" <<
-            "}\n" <<
-            "if(j == n)\n" <<
-            result[expr<uint_>("i1")] << " = 1;\n" <<
-            "else\n" <<
-            result[expr<uint_>("i1")] << " = 0;\n";
     }
 
-    event exec(command_queue &queue)
+    void operator()(meta_kernel &k) const
     {
-        if(m_count == 0) {
-            return event();
-        }
-
-        set_arg(m_n_arg, uint_(m_n));
-        set_arg(m_value_arg, m_value);
-
-        return exec_1d(queue, 0, m_count);
+        k.add_set_arg<uint_>("n", static_cast<uint_>(m_n));
+        k.add_set_arg<value_type>("value", m_value);
+
+        k << "uint j = 0;\n"
+          << "while(j < n && value == " << m_t_first[k.expr<uint_>("i + j")] << "){\n"
+          << "    j++;\n"
+          << "}\n"
+          << "match = j == n;\n";
     }
 
 private:
+    TextIterator m_t_first;
     size_t m_n;
-    size_t m_n_arg;
-    size_t m_count;
     value_type m_value;
-    size_t m_value_arg;
 };
 
 } //end detail namespace
@@ -109,20 +78,33 @@ inline TextIterator search_n(TextIterator t_first,
                              ValueType value,
                              command_queue &queue = system::default_queue())
 {
-    vector<uint_> matching_indices(detail::iterator_range_size(t_first, t_last),
-                                    queue.get_context());
+    typedef typename std::iterator_traits<TextIterator>::value_type value_type;
+    typedef typename std::iterator_traits<TextIterator>::difference_type difference_type;
 
-    detail::search_n_kernel<TextIterator,
-                            vector<uint_>::iterator> kernel;
+    const size_t t_count = detail::iterator_range_size(t_first, t_last);
+    if(n == 0){
+        return t_first;
+    }
+    if(n > t_count){
+        return t_last;
+    }
 
-    kernel.set_range(t_first, t_last, value, n, matching_indices.begin());
-    kernel.exec(queue);
+    // candidate positions for the start of the run
+    const size_t count = t_count + 1 - n;
 
-    vector<uint_>::iterator index = ::boost::compute::find(
-        matching_indices.begin(), matching_indices.end(), uint_(1), queue
+    const size_t position = detail::find_with_early_exit(
+        count,
+        detail::search_n_matcher<TextIterator>(
+            t_first, n, static_cast<value_type>(value)
+        ),
+        false,
+        queue
     );
 
-    return t_first + detail::iterator_range_size(matching_indices.begin(), index);
+    if(position == count){
+        return t_last;
+    }
+    return t_first + static_cast<difference_type>(position);
 }
 
 } //end compute namespace
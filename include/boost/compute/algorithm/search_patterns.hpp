@@ -0,0 +1,277 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SEARCH_PATTERNS_HPP
+#define BOOST_COMPUTE_ALGORITHM_SEARCH_PATTERNS_HPP
+
+#include <string>
+#include <algorithm>
+
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/utility/pattern_set.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns the number of characters scanned by each work-item. every
+// work-item also rescans the max_pattern_length() - 1 characters before
+// its segment to find the matches which start there, so segments are
+// kept at least four times as long as the longest pattern.
+inline size_t search_patterns_segment_size(const pattern_set &patterns,
+                                           command_queue &queue)
+{
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(queue.get_device());
+
+    const size_t segment =
+        parameters->get("__boost_search_patterns", "segment", uint_(256));
+
+    return (std::max)(segment, 4 * patterns.max_pattern_length());
+}
+
+// adds one to the count of the pattern for each match (count_patterns)
+struct search_patterns_count_each
+{
+    search_patterns_count_each(const buffer_iterator<uint_> &counts_)
+        : counts(counts_)
+    {
+    }
+
+    void operator()(meta_kernel &k) const
+    {
+        k << "atomic_inc(" << k.get_buffer_identifier<uint_>(counts.get_buffer())
+          << " + " << uint_(counts.get_index()) << " + id);\n";
+    }
+
+    buffer_iterator<uint_> counts;
+};
+
+// counts the matches of the work-item in "n"
+struct search_patterns_count_all
+{
+    void operator()(meta_kernel &k) const
+    {
+        k << "n++;\n";
+    }
+};
+
+// writes the position and the pattern id of each match to the output
+// index "out"
+template<class PositionIterator, class IdIterator>
+struct search_patterns_write
+{
+    search_patterns_write(PositionIterator positions_,
+                          IdIterator ids_,
+                          const buffer &lengths_)
+        : positions(positions_),
+          ids(ids_),
+          lengths(lengths_)
+    {
+    }
+
+    void operator()(meta_kernel &k) const
+    {
+        k << positions[k.var<uint_>("out")] << " = i + 1 - "
+          << k.get_buffer_identifier<uint_>(lengths) << "[id];\n"
+          << ids[k.var<uint_>("out")] << " = id;\n"
+          << "out++;\n";
+    }
+
+    PositionIterator positions;
+    IdIterator ids;
+    buffer lengths;
+};
+
+// emits a loop running the automaton of patterns over the segment of the
+// text scanned by the current work-item. for each match (ending at
+// position "i" with the pattern id in "id") the code written by on_match(k)
+// is executed.
+template<class InputIterator, class MatchFunction>
+inline void search_patterns_loop(meta_kernel &k,
+                                 InputIterator first,
+                                 const pattern_set &patterns,
+                                 const MatchFunction &on_match)
+{
+    const std::string transitions =
+        k.get_buffer_identifier<uint_>(patterns.transitions().get_buffer());
+    const std::string match_ids =
+        k.get_buffer_identifier<uint_>(patterns.match_ids().get_buffer());
+    const std::string next_matches =
+        k.get_buffer_identifier<uint_>(patterns.next_matches().get_buffer());
+
+    k << "const uint start = get_global_id(0) * segment;\n"
+      << "const uint end = min(start + segment, count);\n"
+      << "uint state = 0;\n"
+      << "for(uint i = start > overlap ? start - overlap : 0; i < end; i++){\n"
+      << "    const uchar c = (uchar)(" << first[k.var<uint_>("i")] << ");\n"
+      << "    state = " << transitions << "[state * 256 + c];\n"
+      << "    if(i < start){\n"
+      << "        continue;\n"
+      << "    }\n"
+      // walk the chain of states at which a pattern ends here
+      << "    for(uint s = state; s != 0; s = " << next_matches << "[s]){\n"
+      << "        const uint id = " << match_ids << "[s];\n"
+      // pattern_set::no_match
+      << "        if(id != 0xffffffff){\n";
+    on_match(k);
+    k << "        }\n"
+      << "    }\n"
+      << "}\n";
+}
+
+} // end detail namespace
+
+/// Counts the occurrences of each pattern of \p patterns in the text
+/// [\p first, \p last) and adds them to the range beginning at \p counts
+/// (which has one value for each pattern). Overlapping occurrences are
+/// all counted.
+///
+/// The text is split into segments which are scanned in parallel with the
+/// Aho-Corasick automaton of the pattern set, so the cost grows with the
+/// size of the text but not with the number of patterns. The value type
+/// of the text must be a single-byte character type.
+///
+/// \see pattern_set, search_patterns()
+template<class InputIterator>
+inline void count_patterns(InputIterator first,
+                           InputIterator last,
+                           const pattern_set &patterns,
+                           buffer_iterator<uint_> counts,
+                           command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("count_patterns")
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    const size_t segment = detail::search_patterns_segment_size(patterns, queue);
+    const size_t segments = (count + segment - 1) / segment;
+
+    detail::meta_kernel k("count_patterns");
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t segment_arg = k.add_arg<const uint_>("segment");
+    size_t overlap_arg = k.add_arg<const uint_>("overlap");
+
+    detail::search_patterns_loop(
+        k, first, patterns, detail::search_patterns_count_each(counts)
+    );
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(count_arg, static_cast<uint_>(count));
+    kernel.set_arg(segment_arg, static_cast<uint_>(segment));
+    kernel.set_arg(overlap_arg, static_cast<uint_>(patterns.max_pattern_length() - 1));
+
+    queue.enqueue_1d_range_kernel(kernel, 0, segments, 0);
+}
+
+/// Finds all occurrences of the patterns of \p patterns in the text
+/// [\p first, \p last). For each occurrence the position of its first
+/// character is written to the range beginning at \p positions and the
+/// id of the pattern to the range beginning at \p ids. Returns the number
+/// of occurrences.
+///
+/// The occurrences are written in the order of their last character;
+/// occurrences ending at the same character are written from the longest
+/// pattern to the shortest. The output ranges must be large enough for
+/// all occurrences, their number can be determined with count_patterns().
+///
+/// \see pattern_set, count_patterns()
+template<class InputIterator, class PositionIterator, class IdIterator>
+inline size_t search_patterns(InputIterator first,
+                              InputIterator last,
+                              const pattern_set &patterns,
+                              PositionIterator positions,
+                              IdIterator ids,
+                              command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("search_patterns")
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return 0;
+    }
+
+    const context &context = queue.get_context();
+    const size_t segment = detail::search_patterns_segment_size(patterns, queue);
+    const size_t segments = (count + segment - 1) / segment;
+    const uint_ overlap = static_cast<uint_>(patterns.max_pattern_length() - 1);
+
+    // one extra value for the total number of occurrences
+    detail::scratch_vector<uint_> offsets(segments + 1, queue);
+
+    // count the occurrences in each segment
+    detail::meta_kernel k1("search_patterns_count");
+    size_t count_arg1 = k1.add_arg<const uint_>("count");
+    size_t segment_arg1 = k1.add_arg<const uint_>("segment");
+    size_t overlap_arg1 = k1.add_arg<const uint_>("overlap");
+
+    k1 << "uint n = 0;\n";
+    detail::search_patterns_loop(
+        k1, first, patterns, detail::search_patterns_count_all()
+    );
+    k1 << offsets.begin()[k1.var<uint_>("get_global_id(0)")] << " = n;\n"
+       << "if(get_global_id(0) == 0){\n"
+       << "    " << offsets.begin()[k1.var<uint_>("get_global_size(0)")] << " = 0;\n"
+       << "}\n";
+
+    kernel kernel1 = k1.compile(context);
+    kernel1.set_arg(count_arg1, static_cast<uint_>(count));
+    kernel1.set_arg(segment_arg1, static_cast<uint_>(segment));
+    kernel1.set_arg(overlap_arg1, overlap);
+    queue.enqueue_1d_range_kernel(kernel1, 0, segments, 0);
+
+    // offset of each segment in the output
+    ::boost::compute::exclusive_scan(
+        offsets.begin(), offsets.end(), offsets.begin(), queue
+    );
+
+    // write the occurrences of each segment
+    detail::meta_kernel k2("search_patterns_write");
+    size_t count_arg2 = k2.add_arg<const uint_>("count");
+    size_t segment_arg2 = k2.add_arg<const uint_>("segment");
+    size_t overlap_arg2 = k2.add_arg<const uint_>("overlap");
+
+    k2 << "uint out = " << offsets.begin()[k2.var<uint_>("get_global_id(0)")] << ";\n";
+    detail::search_patterns_loop(
+        k2, first, patterns,
+        detail::search_patterns_write<PositionIterator, IdIterator>(
+            positions, ids, patterns.lengths().get_buffer()
+        )
+    );
+
+    kernel kernel2 = k2.compile(context);
+    kernel2.set_arg(count_arg2, static_cast<uint_>(count));
+    kernel2.set_arg(segment_arg2, static_cast<uint_>(segment));
+    kernel2.set_arg(overlap_arg2, overlap);
+    queue.enqueue_1d_range_kernel(kernel2, 0, segments, 0);
+
+    return static_cast<size_t>(
+        detail::read_single_value<uint_>(offsets.get_buffer(), segments, queue)
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SEARCH_PATTERNS_HPP
@@ -0,0 +1,223 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SEGMENTED_SORT_HPP
+#define BOOST_COMPUTE_ALGORITHM_SEGMENTED_SORT_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns the largest power of two number of values of type T which are
+// sorted in the local memory of a work-group by segmented_sort() (each
+// value also uses one byte to mark padding values)
+template<class T>
+inline size_t segmented_sort_local_capacity(const device &device)
+{
+    const size_t local_memory = static_cast<size_t>(device.local_memory_size()) / 2;
+
+    size_t capacity = 4096;
+    while(capacity > 1 && capacity * (sizeof(T) + 1) > local_memory){
+        capacity /= 2;
+    }
+
+    return capacity;
+}
+
+// sorts each of the segments in [segments_first, segments_last) with one
+// work-group per segment. the values of each segment are padded to a power
+// of two and sorted in local memory by a bitonic sorting network, the
+// padding values being ordered after all of the others.
+template<class Iterator, class OffsetIterator, class Compare>
+inline void segmented_sort_in_local_memory(Iterator first,
+                                           OffsetIterator offsets_first,
+                                           buffer_iterator<uint_> segments_first,
+                                           buffer_iterator<uint_> segments_last,
+                                           size_t max_segment_size,
+                                           size_t capacity,
+                                           Compare compare,
+                                           command_queue &queue)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    const size_t segment_count =
+        detail::iterator_range_size(segments_first, segments_last);
+
+    size_t padded_size = 1;
+    while(padded_size < max_segment_size){
+        padded_size *= 2;
+    }
+
+    meta_kernel k("segmented_sort_in_local_memory");
+    k <<
+        "__local " << type_name<value_type>() << " values[" << capacity << "];\n" <<
+        "__local uchar valid[" << capacity << "];\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint wg_size = get_local_size(0);\n" <<
+        "const uint segment = " << segments_first[k.var<uint_>("get_group_id(0)")] << ";\n" <<
+        "const uint start = " << offsets_first[k.var<uint_>("segment")] << ";\n" <<
+        "const uint n = " << offsets_first[k.var<uint_>("segment + 1")] << " - start;\n" <<
+        "uint size = 1;\n" <<
+        "while(size < n){\n" <<
+        "    size <<= 1;\n" <<
+        "}\n" <<
+        "for(uint i = lid; i < size; i += wg_size){\n" <<
+        "    valid[i] = i < n;\n" <<
+        "    if(i < n){\n" <<
+        "        values[i] = " << first[k.var<uint_>("start + i")] << ";\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(uint block = 2; block <= size; block <<= 1){\n" <<
+        "    for(uint j = block >> 1; j > 0; j >>= 1){\n" <<
+        "        for(uint i = lid; i < size; i += wg_size){\n" <<
+        "            const uint l = i ^ j;\n" <<
+        "            if(l > i){\n" <<
+        "                const uint lo = (i & block) == 0 ? i : l;\n" <<
+        "                const uint hi = (i & block) == 0 ? l : i;\n" <<
+        "                " << k.decl<value_type>("a") << " = values[lo];\n" <<
+        "                " << k.decl<value_type>("b") << " = values[hi];\n" <<
+        // swap if a must be ordered after b (padding after every value)
+        "                const bool exchange = !valid[lo] ? valid[hi] : " <<
+                             "(valid[hi] && " <<
+                             compare(k.var<value_type>("b"), k.var<value_type>("a")) << ");\n" <<
+        "                if(exchange){\n" <<
+        "                    values[lo] = b;\n" <<
+        "                    values[hi] = a;\n" <<
+        "                    const uchar v = valid[lo];\n" <<
+        "                    valid[lo] = valid[hi];\n" <<
+        "                    valid[hi] = v;\n" <<
+        "                }\n" <<
+        "            }\n" <<
+        "        }\n" <<
+        "        barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "for(uint i = lid; i < n; i += wg_size){\n" <<
+        "    " << first[k.var<uint_>("start + i")] << " = values[i];\n" <<
+        "}\n";
+
+    const size_t work_group_size =
+        k.work_group_size(queue, (std::max)(size_t(1), (std::min)(size_t(256), padded_size / 2)));
+
+    k.exec_1d(queue, 0, segment_count * work_group_size, work_group_size);
+}
+
+} // end detail namespace
+
+/// Sorts each of the segments of the range beginning at \p first using
+/// \p compare. The range [\p offsets_first, \p offsets_last) contains the
+/// offset of the first value of each segment followed by the offset of
+/// the end of the last one (i.e. one more offset than there are
+/// segments).
+///
+/// All of the segments which fit into the local memory of a work-group are
+/// sorted by a single kernel, with one work-group per segment. Larger
+/// segments are sorted one after the other by sort(). This is much faster
+/// than calling sort() for each segment when sorting many small segments.
+///
+/// If no compare function is specified, \c less is used.
+///
+/// Like sort(), the sort is not stable.
+///
+/// \see sort()
+template<class Iterator, class OffsetIterator, class Compare>
+inline void segmented_sort(Iterator first,
+                           OffsetIterator offsets_first,
+                           OffsetIterator offsets_last,
+                           Compare compare,
+                           command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("segmented_sort")
+
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+    typedef typename std::iterator_traits<OffsetIterator>::value_type offset_type;
+
+    const size_t offset_count = detail::iterator_range_size(offsets_first, offsets_last);
+    if(offset_count < 2){
+        return;
+    }
+
+    std::vector<offset_type> offsets(offset_count);
+    ::boost::compute::copy(offsets_first, offsets_last, offsets.begin(), queue);
+
+    const size_t capacity =
+        detail::segmented_sort_local_capacity<value_type>(queue.get_device());
+
+    // split the segments between the local memory and global sorts
+    std::vector<uint_> small_segments;
+    size_t max_small_segment_size = 0;
+    for(size_t i = 0; i + 1 < offset_count; i++){
+        const size_t size = static_cast<size_t>(offsets[i + 1] - offsets[i]);
+
+        if(size < 2){
+            continue;
+        }
+        else if(size <= capacity){
+            small_segments.push_back(static_cast<uint_>(i));
+            max_small_segment_size = (std::max)(max_small_segment_size, size);
+        }
+        else {
+            ::boost::compute::sort(
+                first + offsets[i], first + offsets[i + 1], compare, queue
+            );
+        }
+    }
+
+    if(!small_segments.empty()){
+        detail::scratch_vector<uint_> segments(small_segments.size(), queue);
+        ::boost::compute::copy(
+            small_segments.begin(), small_segments.end(), segments.begin(), queue
+        );
+
+        detail::segmented_sort_in_local_memory(
+            first,
+            offsets_first,
+            segments.begin(),
+            segments.end(),
+            max_small_segment_size,
+            capacity,
+            compare,
+            queue
+        );
+    }
+}
+
+/// \overload
+template<class Iterator, class OffsetIterator>
+inline void segmented_sort(Iterator first,
+                           OffsetIterator offsets_first,
+                           OffsetIterator offsets_last,
+                           command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    ::boost::compute::segmented_sort(
+        first, offsets_first, offsets_last, less<value_type>(), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SEGMENTED_SORT_HPP
@@ -11,19 +11,36 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_SORT_HPP
 #define BOOST_COMPUTE_ALGORITHM_SORT_HPP
 
+#include <string>
 #include <iterator>
+#include <functional>
 
+#include <boost/shared_ptr.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_floating_point.hpp>
 #include <boost/utility/enable_if.hpp>
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/detail/radix_sort.hpp>
 #include <boost/compute/algorithm/detail/insertion_sort.hpp>
+#include <boost/compute/algorithm/detail/lexicographic_radix_sort.hpp>
+#include <boost/compute/algorithm/detail/merge_sort_on_cpu.hpp>
+#include <boost/compute/algorithm/detail/merge_sort_on_gpu.hpp>
+#include <boost/compute/algorithm/detail/parallel_host_sort.hpp>
 #include <boost/compute/algorithm/reverse.hpp>
+#include <boost/compute/async/future.hpp>
 #include <boost/compute/container/mapped_view.hpp>
+#include <boost/compute/detail/device_future.hpp>
+#include <boost/compute/detail/enqueue_wait_list.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/work_size.hpp>
+#include <boost/compute/functional/operator.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
 
 namespace boost {
 namespace compute {
@@ -32,7 +49,7 @@ namespace detail {
 template<class T>
 inline void dispatch_device_sort(buffer_iterator<T> first,
                                  buffer_iterator<T> last,
-                                 less<T>,
+                                 less<T> compare,
                                  command_queue &queue,
                                  typename boost::enable_if_c<
                                      is_radix_sortable<T>::value
@@ -40,13 +57,19 @@ inline void dispatch_device_sort(buffer_iterator<T> first,
 {
     size_t count = detail::iterator_range_size(first, last);
 
+    // half-precision values can only be compared after converting them,
+    // which the radix sort (working on their bits) does not need
     if(count < 2){
         // nothing to do
         return;
     }
-    else if(count <= 32){
+    else if(count <= 32 && !is_half_type<T>::value){
         ::boost::compute::detail::serial_insertion_sort(first, last, queue);
     }
+    else if(is_cpu_device(queue.get_device()) && !is_half_type<T>::value){
+        // the radix sort passes rely on local memory
+        ::boost::compute::detail::merge_sort_on_cpu(first, last, compare, queue);
+    }
     else {
         ::boost::compute::detail::radix_sort(first, last, queue);
     }
@@ -67,20 +90,71 @@ inline void dispatch_device_sort(buffer_iterator<T> first,
         // nothing to do
         return;
     }
-    else if(count <= 32){
+    else if(count <= 32 && !is_half_type<T>::value){
         ::boost::compute::detail::serial_insertion_sort(
             first, last, compare, queue
         );
     }
+    else if(is_cpu_device(queue.get_device()) && !is_half_type<T>::value){
+        ::boost::compute::detail::merge_sort_on_cpu(first, last, compare, queue);
+    }
     else {
         // radix sort in ascending order
         ::boost::compute::detail::radix_sort(first, last, queue);
 
         // reverse range to descending order
-        ::boost::compute::reverse(first, last, queue);
+        ::boost::compute::detail::radix_sort_reverse(first, last, queue);
     }
 }
 
+template<class T, class Compare>
+inline void dispatch_device_sort(buffer_iterator<T> first,
+                                 buffer_iterator<T> last,
+                                 Compare compare,
+                                 command_queue &queue)
+{
+    size_t count = detail::iterator_range_size(first, last);
+
+    if(count < 2){
+        // nothing to do
+        return;
+    }
+    else if(count <= 32){
+        ::boost::compute::detail::serial_insertion_sort(
+            first, last, compare, queue
+        );
+    }
+    else if(is_cpu_device(queue.get_device())){
+        ::boost::compute::detail::merge_sort_on_cpu(
+            first, last, compare, queue
+        );
+    }
+    else {
+        ::boost::compute::detail::merge_sort_on_gpu(
+            first, last, compare, queue
+        );
+    }
+}
+
+// sorts the rows of the columns of a zip_iterator lexicographically
+template<class IteratorTuple>
+inline void dispatch_device_sort(zip_iterator<IteratorTuple> first,
+                                 zip_iterator<IteratorTuple> last,
+                                 less<
+                                     typename std::iterator_traits<
+                                         zip_iterator<IteratorTuple>
+                                     >::value_type
+                                 > compare,
+                                 command_queue &queue,
+                                 typename boost::enable_if<
+                                     is_lexicographic_radix_sortable<IteratorTuple>
+                                 >::type* = 0)
+{
+    (void) compare;
+
+    ::boost::compute::detail::lexicographic_radix_sort(first, last, queue);
+}
+
 template<class Iterator, class Compare>
 inline void dispatch_device_sort(Iterator first,
                                  Iterator last,
@@ -92,6 +166,56 @@ inline void dispatch_device_sort(Iterator first,
     );
 }
 
+// sort_async() for device iterators. the radix sort does not wait for
+// the bits of the keys which differ (see radix_sort_all_bits()).
+template<class T>
+inline void dispatch_device_sort_async(buffer_iterator<T> first,
+                                       buffer_iterator<T> last,
+                                       less<T> compare,
+                                       command_queue &queue,
+                                       typename boost::enable_if_c<
+                                           is_radix_sortable<T>::value
+                                       >::type* = 0)
+{
+    const size_t count = detail::iterator_range_size(first, last);
+
+    if(count > 32 && !is_cpu_device(queue.get_device())){
+        ::boost::compute::detail::radix_sort(first, last, queue, false);
+    }
+    else {
+        dispatch_device_sort(first, last, compare, queue);
+    }
+}
+
+template<class T>
+inline void dispatch_device_sort_async(buffer_iterator<T> first,
+                                       buffer_iterator<T> last,
+                                       greater<T> compare,
+                                       command_queue &queue,
+                                       typename boost::enable_if_c<
+                                           is_radix_sortable<T>::value
+                                       >::type* = 0)
+{
+    const size_t count = detail::iterator_range_size(first, last);
+
+    if(count > 32 && !is_cpu_device(queue.get_device())){
+        ::boost::compute::detail::radix_sort(first, last, queue, false);
+        ::boost::compute::detail::radix_sort_reverse(first, last, queue);
+    }
+    else {
+        dispatch_device_sort(first, last, compare, queue);
+    }
+}
+
+template<class Iterator, class Compare>
+inline void dispatch_device_sort_async(Iterator first,
+                                       Iterator last,
+                                       Compare compare,
+                                       command_queue &queue)
+{
+    dispatch_device_sort(first, last, compare, queue);
+}
+
 // sort() for device iterators
 template<class Iterator, class Compare>
 inline void dispatch_sort(Iterator first,
@@ -105,6 +229,92 @@ inline void dispatch_sort(Iterator first,
     dispatch_device_sort(first, last, compare, queue);
 }
 
+// returns the size below which host ranges of T are sorted on the host
+// instead of on the device of queue. the crossover can be measured with
+// experimental::autotuner::tune_host_sort().
+template<class T>
+inline size_t host_sort_threshold(command_queue &queue)
+{
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(queue.get_device());
+
+    return parameters->get(
+        std::string("__boost_host_sort_") + type_name<T>(), "threshold", 1 << 15
+    );
+}
+
+// the host comparisons used by try_host_sort(). floating-point values are
+// ordered by their bits like the radix sort orders them on the device, so
+// NaNs (which std::less does not order) give a valid ordering too.
+template<class T, class Enable = void>
+struct host_sort_less : std::less<T>
+{
+};
+
+template<class T>
+struct host_sort_less<
+    T, typename boost::enable_if<boost::is_floating_point<T> >::type
+> : radix_sort_host_less<T>
+{
+};
+
+template<class T>
+struct host_sort_greater
+{
+    bool operator()(const T &a, const T &b) const
+    {
+        return host_sort_less<T>()(b, a);
+    }
+};
+
+// sorts [first, last) with the host function compare if it is smaller
+// than the host sort threshold, otherwise returns false
+template<class T, class Iterator, class HostCompare>
+inline bool host_sort_if_small(Iterator first,
+                               Iterator last,
+                               HostCompare compare,
+                               command_queue &queue)
+{
+    if(static_cast<size_t>(std::distance(first, last)) >= host_sort_threshold<T>(queue)){
+        return false;
+    }
+
+    parallel_host_sort(first, last, compare);
+    return true;
+}
+
+// sorts small host ranges on the host if compare has a host equivalent,
+// otherwise nothing is sorted and false is returned
+template<class Iterator, class Compare>
+inline bool try_host_sort(Iterator, Iterator, Compare, command_queue &)
+{
+    return false;
+}
+
+template<class Iterator, class T>
+inline bool try_host_sort(Iterator first,
+                          Iterator last,
+                          less<T>,
+                          command_queue &queue,
+                          typename boost::enable_if<
+                              boost::is_arithmetic<T>
+                          >::type* = 0)
+{
+    return host_sort_if_small<T>(first, last, host_sort_less<T>(), queue);
+}
+
+template<class Iterator, class T>
+inline bool try_host_sort(Iterator first,
+                          Iterator last,
+                          greater<T>,
+                          command_queue &queue,
+                          typename boost::enable_if<
+                              boost::is_arithmetic<T>
+                          >::type* = 0)
+{
+    return host_sort_if_small<T>(first, last, host_sort_greater<T>(), queue);
+}
+
 // sort() for host iterators
 template<class Iterator, class Compare>
 inline void dispatch_sort(Iterator first,
@@ -117,6 +327,12 @@ inline void dispatch_sort(Iterator first,
 {
     typedef typename std::iterator_traits<Iterator>::value_type T;
 
+    // small ranges are sorted faster on the host than the device can be
+    // launched
+    if(try_host_sort(first, last, compare, queue)){
+        return;
+    }
+
     size_t size = static_cast<size_t>(std::distance(first, last));
 
     // create mapped buffer
@@ -127,8 +343,10 @@ inline void dispatch_sort(Iterator first,
     // sort mapped buffer
     dispatch_device_sort(view.begin(), view.end(), compare, queue);
 
-    // return results to host
-    view.map(queue);
+    // return results to host, the host pointer is valid once mapped and
+    // the buffer is released after the unmap completed
+    view.map(CL_MAP_READ, queue);
+    view.unmap(queue);
 }
 
 } // end detail namespace
@@ -160,6 +378,27 @@ inline void dispatch_sort(Iterator first,
 /// boost::compute::sort(data.begin(), data.end(), queue);
 /// \endcode
 ///
+/// Host ranges smaller than the crossover of the device (32768 values
+/// unless tuned with experimental::autotuner::tune_host_sort()) are sorted
+/// on the host instead when \p compare is \c less or \c greater. When
+/// \c BOOST_COMPUTE_THREAD_SAFE is defined the host sort runs on one
+/// thread per hardware thread.
+///
+/// A zip_iterator range of radix-sortable columns sorted with \c less is
+/// sorted lexicographically by its columns (the first column being the
+/// most significant) with one stable radix sort pass per column:
+/// \code
+/// boost::compute::sort(
+///     boost::compute::make_zip_iterator(
+///         boost::make_tuple(a.begin(), b.begin(), c.begin())
+///     ),
+///     boost::compute::make_zip_iterator(
+///         boost::make_tuple(a.end(), b.end(), c.end())
+///     ),
+///     queue
+/// );
+/// \endcode
+///
 /// \see is_sorted()
 template<class Iterator, class Compare>
 inline void sort(Iterator first,
@@ -167,9 +406,24 @@ inline void sort(Iterator first,
                  Compare compare,
                  command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("sort")
+
     ::boost::compute::detail::dispatch_sort(first, last, compare, queue);
 }
 
+/// \overload
+template<class Iterator, class Compare>
+inline void sort(Iterator first,
+                 Iterator last,
+                 Compare compare,
+                 command_queue &queue,
+                 const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    ::boost::compute::sort(first, last, compare, queue);
+}
+
 /// \overload
 template<class Iterator>
 inline void sort(Iterator first,
@@ -183,6 +437,122 @@ inline void sort(Iterator first,
     );
 }
 
+/// \overload
+template<class Iterator>
+inline void sort(Iterator first,
+                 Iterator last,
+                 command_queue &queue,
+                 const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    ::boost::compute::sort(first, last, queue);
+}
+
+/// Asynchronous version of sort() for device iterators. The returned future
+/// is ready when the values are sorted.
+///
+/// \see sort()
+template<class Iterator, class Compare>
+inline future<void> sort_async(Iterator first,
+                               Iterator last,
+                               Compare compare,
+                               command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("sort_async")
+
+    BOOST_STATIC_ASSERT_MSG(
+        is_device_iterator<Iterator>::value,
+        "sort_async() is only supported for device iterators"
+    );
+
+    ::boost::compute::detail::dispatch_device_sort_async(first, last, compare, queue);
+
+    return ::boost::compute::detail::make_marker_future(queue);
+}
+
+/// \overload
+template<class Iterator, class Compare>
+inline future<void> sort_async(Iterator first,
+                               Iterator last,
+                               Compare compare,
+                               command_queue &queue,
+                               const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::sort_async(first, last, compare, queue);
+}
+
+/// \overload
+template<class Iterator>
+inline future<void> sort_async(Iterator first,
+                               Iterator last,
+                               command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    return ::boost::compute::sort_async(
+        first, last, ::boost::compute::less<value_type>(), queue
+    );
+}
+
+/// \overload
+template<class Iterator>
+inline future<void> sort_async(Iterator first,
+                               Iterator last,
+                               command_queue &queue,
+                               const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::sort_async(first, last, queue);
+}
+
+/// Sorts the values in the range [\p first, \p last) in ascending order
+/// considering only the bits [\p begin_bit, \p end_bit) of each value.
+///
+/// This is useful when the values are known to fit in fewer bits than
+/// their type (e.g. 20-bit integer ids stored in a \c uint_) as only the
+/// radix sort passes for the given bits are performed. Values which only
+/// differ in bits below \p begin_bit keep their relative order, the bits
+/// at and above \p end_bit must be the same for all values. For signed
+/// and floating-point types the bits refer to the value with its sign bit
+/// flipped (and, for negative floating-point values, all other bits
+/// inverted) such that it is ordered as an unsigned integer.
+///
+/// For example, to sort ids which are smaller than \c 2^20:
+/// \code
+/// boost::compute::sort(ids.begin(), ids.end(), 0, 20, queue);
+/// \endcode
+///
+/// \see sort_by_key()
+template<class T>
+inline typename boost::enable_if_c<detail::is_radix_sortable<T>::value>::type
+sort(buffer_iterator<T> first,
+     buffer_iterator<T> last,
+     uint_ begin_bit,
+     uint_ end_bit,
+     command_queue &queue = system::default_queue())
+{
+    ::boost::compute::detail::radix_sort(first, last, begin_bit, end_bit, queue);
+}
+
+/// \overload
+template<class T>
+inline typename boost::enable_if_c<detail::is_radix_sortable<T>::value>::type
+sort(buffer_iterator<T> first,
+     buffer_iterator<T> last,
+     uint_ begin_bit,
+     uint_ end_bit,
+     command_queue &queue,
+     const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::sort(first, last, begin_bit, end_bit, queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -13,24 +13,37 @@
 
 #include <iterator>
 
+#include <boost/tuple/tuple.hpp>
+#include <boost/utility/enable_if.hpp>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/detail/insertion_sort.hpp>
+#include <boost/compute/algorithm/detail/merge_sort_on_gpu.hpp>
 #include <boost/compute/algorithm/detail/radix_sort.hpp>
+#include <boost/compute/algorithm/apply_permutation.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
 #include <boost/compute/algorithm/reverse.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
 
 namespace boost {
 namespace compute {
 
 namespace detail {
 
-template<class KeyIterator, class ValueIterator>
-inline void dispatch_sort_by_key(KeyIterator keys_first,
-                        KeyIterator keys_last,
-                        ValueIterator values_first,
-                        less<typename std::iterator_traits<KeyIterator>::value_type> compare,
-                        command_queue &queue)
+template<class Key, class Value>
+inline void dispatch_sort_by_key(buffer_iterator<Key> keys_first,
+                        buffer_iterator<Key> keys_last,
+                        buffer_iterator<Value> values_first,
+                        less<Key> compare,
+                        command_queue &queue,
+                        typename boost::enable_if_c<
+                            is_radix_sortable<Key>::value
+                        >::type* = 0)
 {
     size_t count = detail::iterator_range_size(keys_first, keys_last);
 
@@ -46,12 +59,15 @@ inline void dispatch_sort_by_key(KeyIterator keys_first,
     }
 }
 
-template<class KeyIterator, class ValueIterator>
-inline void dispatch_sort_by_key(KeyIterator keys_first,
-                        KeyIterator keys_last,
-                        ValueIterator values_first,
-                        greater<typename std::iterator_traits<KeyIterator>::value_type> compare,
-                        command_queue &queue)
+template<class Key, class Value>
+inline void dispatch_sort_by_key(buffer_iterator<Key> keys_first,
+                        buffer_iterator<Key> keys_last,
+                        buffer_iterator<Value> values_first,
+                        greater<Key> compare,
+                        command_queue &queue,
+                        typename boost::enable_if_c<
+                            is_radix_sortable<Key>::value
+                        >::type* = 0)
 {
     size_t count = detail::iterator_range_size(keys_first, keys_last);
 
@@ -73,6 +89,145 @@ inline void dispatch_sort_by_key(KeyIterator keys_first,
     }
 }
 
+template<class Key, class Value, class Compare>
+inline void dispatch_sort_by_key(buffer_iterator<Key> keys_first,
+                        buffer_iterator<Key> keys_last,
+                        buffer_iterator<Value> values_first,
+                        Compare compare,
+                        command_queue &queue)
+{
+    size_t count = detail::iterator_range_size(keys_first, keys_last);
+
+    if(count < 32){
+        detail::serial_insertion_sort_by_key(
+            keys_first, keys_last, values_first, compare, queue
+            );
+    }
+    else {
+        detail::merge_sort_by_key_on_gpu(
+            keys_first, keys_last, values_first, compare, queue
+            );
+    }
+}
+
+// sorts the keys and writes the permutation applied to them to indices
+template<class Key>
+inline void sort_keys_with_indices(buffer_iterator<Key> keys_first,
+                                   buffer_iterator<Key> keys_last,
+                                   buffer_iterator<uint_> indices,
+                                   less<Key> compare,
+                                   command_queue &queue,
+                                   typename boost::enable_if_c<
+                                       is_radix_sortable<Key>::value
+                                   >::type* = 0)
+{
+    size_t count = detail::iterator_range_size(keys_first, keys_last);
+
+    if(count < 32){
+        ::boost::compute::iota(indices, indices + count, uint_(0), queue);
+        detail::serial_insertion_sort_by_key(
+            keys_first, keys_last, indices, compare, queue
+        );
+    }
+    else {
+        detail::radix_sort_indices(keys_first, keys_last, indices, queue);
+    }
+}
+
+template<class Key>
+inline void sort_keys_with_indices(buffer_iterator<Key> keys_first,
+                                   buffer_iterator<Key> keys_last,
+                                   buffer_iterator<uint_> indices,
+                                   greater<Key> compare,
+                                   command_queue &queue,
+                                   typename boost::enable_if_c<
+                                       is_radix_sortable<Key>::value
+                                   >::type* = 0)
+{
+    size_t count = detail::iterator_range_size(keys_first, keys_last);
+
+    if(count < 32){
+        ::boost::compute::iota(indices, indices + count, uint_(0), queue);
+        detail::serial_insertion_sort_by_key(
+            keys_first, keys_last, indices, compare, queue
+        );
+    }
+    else {
+        // radix sorts in ascending order
+        detail::radix_sort_indices(keys_first, keys_last, indices, queue);
+
+        detail::radix_sort_reverse(keys_first, keys_last, queue);
+        ::boost::compute::reverse(indices, indices + count, queue);
+    }
+}
+
+template<class Key, class Compare>
+inline void sort_keys_with_indices(buffer_iterator<Key> keys_first,
+                                   buffer_iterator<Key> keys_last,
+                                   buffer_iterator<uint_> indices,
+                                   Compare compare,
+                                   command_queue &queue)
+{
+    size_t count = detail::iterator_range_size(keys_first, keys_last);
+
+    ::boost::compute::iota(indices, indices + count, uint_(0), queue);
+    dispatch_sort_by_key(keys_first, keys_last, indices, compare, queue);
+}
+
+// last column, all of the columns are permuted by a single kernel
+inline void permute_value_columns(meta_kernel &k,
+                                  const boost::tuples::null_type &columns,
+                                  size_t count,
+                                  command_queue &queue)
+{
+    (void) columns;
+
+    k.exec_1d(queue, 0, count);
+}
+
+// copies the column to a temporary buffer (kept until the kernel is
+// enqueued by the last call) and permutes it back into the column
+template<class Head, class Tail>
+inline void permute_value_columns(meta_kernel &k,
+                                  const boost::tuples::cons<Head, Tail> &columns,
+                                  size_t count,
+                                  command_queue &queue)
+{
+    typedef typename std::iterator_traits<Head>::value_type value_type;
+
+    const Head &column = columns.get_head();
+
+    scratch_vector<value_type> values(count, queue);
+    ::boost::compute::copy(column, column + count, values.begin(), queue);
+    gather_columns(k, values.begin(), column);
+
+    permute_value_columns(k, columns.get_tail(), count, queue);
+}
+
+// sort by key with several value columns. instead of moving every column
+// in each pass of the sort, the keys are sorted with their indices as the
+// values, which are then used to permute all of the columns in one kernel.
+template<class Key, class ValueTuple, class Compare>
+inline void dispatch_sort_by_key(buffer_iterator<Key> keys_first,
+                                 buffer_iterator<Key> keys_last,
+                                 zip_iterator<ValueTuple> values_first,
+                                 Compare compare,
+                                 command_queue &queue)
+{
+    size_t count = detail::iterator_range_size(keys_first, keys_last);
+    if(count < 2){
+        return;
+    }
+
+    scratch_vector<uint_> indices(count, queue);
+    sort_keys_with_indices(keys_first, keys_last, indices.begin(), compare, queue);
+
+    meta_kernel k("sort_by_key_permute_values");
+    k << "const uint i = get_global_id(0);\n" <<
+         "const uint p = " << indices.begin()[k.var<uint_>("i")] << ";\n";
+    permute_value_columns(k, values_first.get_iterator_tuple(), count, queue);
+}
+
 template<class KeyIterator, class ValueIterator, class Compare>
 inline void dispatch_sort_by_key(KeyIterator keys_first,
                         KeyIterator keys_last,
@@ -98,6 +253,22 @@ inline void dispatch_sort_by_key(KeyIterator keys_first,
 ///
 /// If no compare function is specified, \c less is used.
 ///
+/// The values may be a zip_iterator of buffer iterators to sort several
+/// ranges by the same keys, e.g.:
+/// \code
+/// boost::compute::sort_by_key(
+///     keys.begin(),
+///     keys.end(),
+///     boost::compute::make_zip_iterator(
+///         boost::make_tuple(a.begin(), b.begin(), c.begin())
+///     ),
+///     queue
+/// );
+/// \endcode
+/// The keys are then sorted once with their indices and each range is
+/// permuted afterwards (all by one kernel) instead of being moved by each
+/// pass of the sort.
+///
 /// \see sort()
 
 template<class KeyIterator, class ValueIterator, class Compare>
@@ -107,6 +278,8 @@ inline void sort_by_key(KeyIterator keys_first,
                         Compare compare,
                         command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("sort_by_key")
+
     ::boost::compute::detail::dispatch_sort_by_key(
         keys_first,
         keys_last,
@@ -122,20 +295,33 @@ inline void sort_by_key(KeyIterator keys_first,
                         ValueIterator values_first,
                         command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("sort_by_key")
+
     typedef typename std::iterator_traits<KeyIterator>::value_type key_type;
 
-    size_t count = detail::iterator_range_size(keys_first, keys_last);
+    ::boost::compute::detail::dispatch_sort_by_key(
+        keys_first, keys_last, values_first, less<key_type>(), queue
+    );
+}
 
-    if(count < 32){
-        detail::serial_insertion_sort_by_key(
-            keys_first, keys_last, values_first, less<key_type>(), queue
-        );
-    }
-    else {
-        detail::radix_sort_by_key(
-            keys_first, keys_last, values_first, queue
-        );
-    }
+/// Performs a key-value sort on the values in the range [\p values_first,
+/// \p values_first \c + (\p keys_last \c - \p keys_first)) considering only
+/// the bits [\p begin_bit, \p end_bit) of the keys in the range
+/// [\p keys_first, \p keys_last).
+///
+/// \see sort()
+template<class Key, class Value>
+inline typename boost::enable_if_c<detail::is_radix_sortable<Key>::value>::type
+sort_by_key(buffer_iterator<Key> keys_first,
+            buffer_iterator<Key> keys_last,
+            buffer_iterator<Value> values_first,
+            uint_ begin_bit,
+            uint_ end_bit,
+            command_queue &queue = system::default_queue())
+{
+    detail::radix_sort_by_key(
+        keys_first, keys_last, values_first, begin_bit, end_bit, queue
+    );
 }
 
 } // end compute namespace
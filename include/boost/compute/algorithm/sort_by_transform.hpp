@@ -0,0 +1,141 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SORT_BY_TRANSFORM_HPP
+#define BOOST_COMPUTE_ALGORITHM_SORT_BY_TRANSFORM_HPP
+
+#include <iterator>
+
+#include <boost/utility/enable_if.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/apply_permutation.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/algorithm/detail/radix_sort.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// values larger than an index are not moved by each pass of the radix
+// sort: the keys are sorted with the indices of the values and the values
+// are then gathered once in that order
+template<class T, class Key>
+inline void dispatch_sort_by_transform(buffer_iterator<T> first,
+                                       buffer_iterator<T> last,
+                                       buffer_iterator<Key> keys_first,
+                                       less<Key> compare,
+                                       command_queue &queue,
+                                       typename boost::enable_if_c<
+                                           is_radix_sortable<Key>::value &&
+                                           (sizeof(T) > sizeof(uint_))
+                                       >::type* = 0)
+{
+    (void) compare;
+
+    const size_t count = detail::iterator_range_size(first, last);
+
+    scratch_vector<uint_> indices(count, queue);
+    radix_sort_indices(keys_first, keys_first + count, indices.begin(), queue);
+
+    scratch_vector<T> values(count, queue);
+    ::boost::compute::copy(first, last, values.begin(), queue);
+    ::boost::compute::apply_permutation(
+        indices.begin(), indices.end(), values.begin(), first, queue
+    );
+}
+
+template<class Iterator, class KeyIterator, class Compare>
+inline void dispatch_sort_by_transform(Iterator first,
+                                       Iterator last,
+                                       KeyIterator keys_first,
+                                       Compare compare,
+                                       command_queue &queue)
+{
+    const size_t count = detail::iterator_range_size(first, last);
+
+    ::boost::compute::sort_by_key(
+        keys_first, keys_first + count, first, compare, queue
+    );
+}
+
+} // end detail namespace
+
+/// Sorts the values in the range [\p first, \p last) by the result of
+/// \p transform for each of them compared with \p compare.
+///
+/// \p transform is invoked once for each value, its results being stored
+/// in a temporary buffer which is then sorted by key with the values. When
+/// the results are sorted by a radix sort (\c less and a radix-sortable
+/// key type) and the values are larger than 32-bit indices, the radix sort
+/// moves the indices of the values instead and the values are then moved
+/// once to their sorted position.
+///
+/// If no compare function is specified, \c less is used.
+///
+/// For example, to sort vectors by their length:
+/// \code
+/// boost::compute::sort_by_transform(
+///     vectors.begin(), vectors.end(), boost::compute::length<float4_>(), queue
+/// );
+/// \endcode
+///
+/// \see sort_by_key(), sort_indices()
+template<class Iterator, class Transform, class Compare>
+inline void sort_by_transform(Iterator first,
+                              Iterator last,
+                              Transform transform,
+                              Compare compare,
+                              command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("sort_by_transform")
+
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+    typedef typename ::boost::compute::result_of<Transform(value_type)>::type key_type;
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count < 2){
+        return;
+    }
+
+    detail::scratch_vector<key_type> keys(count, queue);
+    ::boost::compute::transform(first, last, keys.begin(), transform, queue);
+
+    detail::dispatch_sort_by_transform(
+        first, last, keys.begin(), compare, queue
+    );
+}
+
+/// \overload
+template<class Iterator, class Transform>
+inline void sort_by_transform(Iterator first,
+                              Iterator last,
+                              Transform transform,
+                              command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+    typedef typename ::boost::compute::result_of<Transform(value_type)>::type key_type;
+
+    ::boost::compute::sort_by_transform(
+        first, last, transform, less<key_type>(), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SORT_BY_TRANSFORM_HPP
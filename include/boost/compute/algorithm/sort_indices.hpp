@@ -0,0 +1,190 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SORT_INDICES_HPP
+#define BOOST_COMPUTE_ALGORITHM_SORT_INDICES_HPP
+
+#include <iterator>
+
+#include <boost/utility/enable_if.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/reverse.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/algorithm/detail/lexicographic_radix_sort.hpp>
+#include <boost/compute/algorithm/detail/radix_sort.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+template<class T>
+inline void dispatch_sort_indices(buffer_iterator<T> first,
+                                  buffer_iterator<T> last,
+                                  buffer_iterator<uint_> indices,
+                                  less<T> compare,
+                                  command_queue &queue,
+                                  typename boost::enable_if_c<
+                                      is_radix_sortable<T>::value
+                                  >::type* = 0)
+{
+    (void) compare;
+
+    const size_t count = detail::iterator_range_size(first, last);
+
+    scratch_vector<T> keys(count, queue);
+    ::boost::compute::copy(first, last, keys.begin(), queue);
+
+    radix_sort_indices(keys.begin(), keys.end(), indices, queue);
+}
+
+template<class T>
+inline void dispatch_sort_indices(buffer_iterator<T> first,
+                                  buffer_iterator<T> last,
+                                  buffer_iterator<uint_> indices,
+                                  greater<T> compare,
+                                  command_queue &queue,
+                                  typename boost::enable_if_c<
+                                      is_radix_sortable<T>::value
+                                  >::type* = 0)
+{
+    (void) compare;
+
+    const size_t count = detail::iterator_range_size(first, last);
+
+    scratch_vector<T> keys(count, queue);
+    ::boost::compute::copy(first, last, keys.begin(), queue);
+
+    // radix sorts in ascending order
+    radix_sort_indices(keys.begin(), keys.end(), indices, queue);
+    ::boost::compute::reverse(indices, indices + count, queue);
+}
+
+template<class IteratorTuple>
+inline void dispatch_sort_indices(zip_iterator<IteratorTuple> first,
+                                  zip_iterator<IteratorTuple> last,
+                                  buffer_iterator<uint_> indices,
+                                  less<
+                                      typename std::iterator_traits<
+                                          zip_iterator<IteratorTuple>
+                                      >::value_type
+                                  > compare,
+                                  command_queue &queue,
+                                  typename boost::enable_if<
+                                      is_lexicographic_radix_sortable<IteratorTuple>
+                                  >::type* = 0)
+{
+    (void) compare;
+
+    lexicographic_radix_sort_indices(first, last, indices, queue);
+}
+
+template<class Iterator, class IndexIterator, class Compare>
+inline void dispatch_sort_indices(Iterator first,
+                                  Iterator last,
+                                  IndexIterator indices,
+                                  Compare compare,
+                                  command_queue &queue)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+    typedef typename std::iterator_traits<IndexIterator>::value_type index_type;
+
+    const size_t count = detail::iterator_range_size(first, last);
+
+    scratch_vector<value_type> keys(count, queue);
+    ::boost::compute::copy(first, last, keys.begin(), queue);
+
+    ::boost::compute::iota(indices, indices + count, index_type(0), queue);
+    ::boost::compute::sort_by_key(
+        keys.begin(), keys.end(), indices, compare, queue
+    );
+}
+
+} // end detail namespace
+
+/// Writes to the range beginning at \p indices the permutation which sorts
+/// the values in the range [\p first, \p last) using \p compare, i.e. the
+/// index of the smallest value followed by the index of the next one and
+/// so on. The input range is not modified.
+///
+/// The permutation can then be applied to the range and to any other
+/// ranges of the same size with apply_permutation(). This is faster than
+/// sorting the values by key with an iota() range of indices: for
+/// \c uint_ indices and radix-sortable values sorted with \c less or
+/// \c greater, the indices are generated by the first pass of the radix
+/// sort instead of being read.
+///
+/// If no compare function is specified, \c less is used.
+///
+/// For a zip_iterator range of radix-sortable columns sorted with \c less
+/// the rows are ordered lexicographically by the columns (the first column
+/// being the most significant), with one stable radix sort pass per column
+/// reordering the same indices.
+///
+/// For example, to sort two columns by the values of the first one:
+/// \code
+/// boost::compute::vector<uint_> indices(keys.size(), context);
+/// boost::compute::sort_indices(keys.begin(), keys.end(), indices.begin(), queue);
+/// boost::compute::apply_permutation(
+///     indices.begin(),
+///     indices.end(),
+///     boost::compute::make_zip_iterator(
+///         boost::make_tuple(keys.begin(), values.begin())
+///     ),
+///     boost::compute::make_zip_iterator(
+///         boost::make_tuple(sorted_keys.begin(), sorted_values.begin())
+///     ),
+///     queue
+/// );
+/// \endcode
+///
+/// \see sort_by_key(), apply_permutation()
+template<class Iterator, class IndexIterator, class Compare>
+inline void sort_indices(Iterator first,
+                         Iterator last,
+                         IndexIterator indices,
+                         Compare compare,
+                         command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("sort_indices")
+
+    if(first == last){
+        return;
+    }
+
+    ::boost::compute::detail::dispatch_sort_indices(
+        first, last, indices, compare, queue
+    );
+}
+
+/// \overload
+template<class Iterator, class IndexIterator>
+inline void sort_indices(Iterator first,
+                         Iterator last,
+                         IndexIterator indices,
+                         command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    ::boost::compute::sort_indices(
+        first, last, indices, less<value_type>(), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SORT_INDICES_HPP
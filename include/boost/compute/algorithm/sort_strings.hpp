@@ -0,0 +1,219 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SORT_STRINGS_HPP
+#define BOOST_COMPUTE_ALGORITHM_SORT_STRINGS_HPP
+
+#include <boost/tuple/tuple.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/inclusive_scan.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
+#include <boost/compute/utility/fill_batch.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// writes to keys the eight characters starting at depth of the strings
+// given by indices, packed with the first character in the high byte (so
+// that comparing the keys compares the characters) and padded with zeros
+template<class CharIterator, class OffsetIterator>
+inline void sort_strings_load_keys(CharIterator chars_first,
+                                   OffsetIterator offsets_first,
+                                   const buffer_iterator<uint_> indices,
+                                   const buffer_iterator<ulong_> keys,
+                                   size_t count,
+                                   uint_ depth,
+                                   command_queue &queue)
+{
+    meta_kernel k("sort_strings_load_keys");
+    size_t depth_arg = k.add_arg<const uint_>("depth");
+
+    k <<
+        "const uint i = get_global_id(0);\n" <<
+        "const uint s = " << indices[k.var<uint_>("i")] << ";\n" <<
+        "const uint start = " << offsets_first[k.var<uint_>("s")] << ";\n" <<
+        "const uint length = " << offsets_first[k.var<uint_>("s + 1")] << " - start;\n" <<
+        "ulong key = 0;\n" <<
+        "for(uint c = depth; c < depth + 8; c++){\n" <<
+        "    key <<= 8;\n" <<
+        "    if(c < length){\n" <<
+        "        key |= (uchar)(" << chars_first[k.var<uint_>("start + c")] << ");\n" <<
+        "    }\n" <<
+        "}\n" <<
+        keys[k.var<uint_>("i")] << " = key;\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(depth_arg, depth);
+    queue.enqueue_1d_range_kernel(kernel, 0, count, 0);
+}
+
+// marks the first string of each group of strings with the same group and
+// key and sets unfinished to one if a group of more than one string has a
+// string longer than end_depth (their order is then not known yet)
+template<class OffsetIterator>
+inline void sort_strings_mark_groups(OffsetIterator offsets_first,
+                                     const buffer_iterator<uint_> indices,
+                                     const buffer_iterator<ulong_> keys,
+                                     const buffer_iterator<uint_> groups,
+                                     const buffer_iterator<uint_> heads,
+                                     const buffer_iterator<uint_> unfinished,
+                                     size_t count,
+                                     uint_ end_depth,
+                                     command_queue &queue)
+{
+    meta_kernel k("sort_strings_mark_groups");
+    size_t end_depth_arg = k.add_arg<const uint_>("end_depth");
+
+    k <<
+        "const uint i = get_global_id(0);\n" <<
+        "const uint head = i == 0 || " <<
+            groups[k.var<uint_>("i")] << " != " << groups[k.var<uint_>("i - 1")] << " || " <<
+            keys[k.var<uint_>("i")] << " != " << keys[k.var<uint_>("i - 1")] << ";\n" <<
+        heads[k.var<uint_>("i")] << " = head;\n" <<
+        "if(!head){\n" <<
+        "    const uint s = " << indices[k.var<uint_>("i")] << ";\n" <<
+        "    const uint t = " << indices[k.var<uint_>("i - 1")] << ";\n" <<
+        "    if(" << offsets_first[k.var<uint_>("s + 1")] << " - " <<
+                     offsets_first[k.var<uint_>("s")] << " > end_depth ||\n" <<
+        "       " << offsets_first[k.var<uint_>("t + 1")] << " - " <<
+                     offsets_first[k.var<uint_>("t")] << " > end_depth){\n" <<
+        "        " << unfinished[k.var<uint_>("0")] << " = 1;\n" <<
+        "    }\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(end_depth_arg, end_depth);
+    queue.enqueue_1d_range_kernel(kernel, 0, count, 0);
+}
+
+} // end detail namespace
+
+/// Writes to the range beginning at \p indices the permutation which sorts
+/// the strings whose characters are in the range beginning at
+/// \p chars_first in lexicographical order (comparing the characters as
+/// unsigned values). The string \c i is made of the characters in
+/// [\p chars_first \c + \c offsets[i], \p chars_first \c + \c offsets[i+1])
+/// where \c offsets is the range [\p offsets_first, \p offsets_last),
+/// which contains one more offset than there are strings.
+///
+/// The strings are sorted (most significant digits first) by their first
+/// eight characters packed into 64-bit keys, with a radix sort. The
+/// strings are then sorted by their next eight characters within each
+/// group of strings with equal prefixes, until each of the groups only
+/// holds equal strings. Strings must not contain
+/// \c '\\0' characters, which are used to pad the keys.
+///
+/// For example, to sort two strings stored in the same buffer:
+/// \code
+/// // "compute" and "boost"
+/// boost::compute::vector<char> chars(...);
+/// boost::compute::vector<uint_> offsets(...); // { 0, 7, 12 }
+///
+/// boost::compute::vector<uint_> indices(2, context);
+/// boost::compute::sort_strings(
+///     chars.begin(), offsets.begin(), offsets.end(), indices.begin(), queue
+/// );
+/// // indices = { 1, 0 }
+/// \endcode
+///
+/// \see sort_indices(), apply_permutation()
+template<class CharIterator, class OffsetIterator>
+inline void sort_strings(CharIterator chars_first,
+                         OffsetIterator offsets_first,
+                         OffsetIterator offsets_last,
+                         buffer_iterator<uint_> indices,
+                         command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("sort_strings")
+
+    const size_t offset_count = detail::iterator_range_size(offsets_first, offsets_last);
+    if(offset_count < 2){
+        return;
+    }
+    const size_t count = offset_count - 1;
+
+    ::boost::compute::iota(indices, indices + count, uint_(0), queue);
+    if(count == 1){
+        return;
+    }
+
+    detail::scratch_vector<ulong_> keys(count, queue);
+    detail::scratch_vector<uint_> groups(count, queue);
+    detail::scratch_vector<uint_> heads(count, queue);
+    detail::scratch_vector<uint_> unfinished(1, queue);
+
+    for(uint_ depth = 0; ; depth += 8){
+        detail::sort_strings_load_keys(
+            chars_first, offsets_first, indices, keys.begin(), count, depth, queue
+        );
+
+        if(depth == 0){
+            ::boost::compute::sort_by_key(
+                keys.begin(), keys.end(), indices, queue
+            );
+        }
+        else {
+            // the radix sort is stable, sorting by the keys and then by
+            // the groups sorts by both
+            ::boost::compute::sort_by_key(
+                keys.begin(),
+                keys.end(),
+                make_zip_iterator(boost::make_tuple(indices, groups.begin())),
+                queue
+            );
+            ::boost::compute::sort_by_key(
+                groups.begin(),
+                groups.end(),
+                make_zip_iterator(boost::make_tuple(keys.begin(), indices)),
+                queue
+            );
+        }
+
+        fill_batch clear;
+        if(depth == 0){
+            clear.add(groups.begin(), groups.end(), uint_(0));
+        }
+        clear.add(unfinished.begin(), unfinished.end(), uint_(0));
+        clear.enqueue(queue);
+        detail::sort_strings_mark_groups(
+            offsets_first,
+            indices,
+            keys.begin(),
+            groups.begin(),
+            heads.begin(),
+            unfinished.begin(),
+            count,
+            depth + 8,
+            queue
+        );
+
+        if(detail::read_single_value<uint_>(unfinished.get_buffer(), 0, queue) == 0){
+            break;
+        }
+
+        ::boost::compute::inclusive_scan(
+            heads.begin(), heads.end(), groups.begin(), queue
+        );
+    }
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SORT_STRINGS_HPP
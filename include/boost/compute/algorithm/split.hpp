@@ -0,0 +1,157 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SPLIT_HPP
+#define BOOST_COMPUTE_ALGORITHM_SPLIT_HPP
+
+#include <iterator>
+#include <utility>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// selects the positions at which a token starts: a character which is not
+// a delimiter following a delimiter (or the start of the text)
+template<class InputIterator, class Predicate>
+struct split_token_begin
+{
+    split_token_begin(InputIterator first_, Predicate is_delimiter_)
+        : first(first_),
+          is_delimiter(is_delimiter_)
+    {
+    }
+
+    void select(meta_kernel &k) const
+    {
+        k << "!(" << is_delimiter(first[k.var<uint_>("i")]) << ") && "
+          << "(i == 0 || " << is_delimiter(first[k.var<uint_>("i-1")]) << ")";
+    }
+
+    InputIterator first;
+    Predicate is_delimiter;
+};
+
+// selects the positions one past the end of a token: a delimiter (or the
+// end of the text) following a character which is not a delimiter. the
+// positions checked include the end of the text.
+template<class InputIterator, class Predicate>
+struct split_token_end
+{
+    split_token_end(InputIterator first_, Predicate is_delimiter_)
+        : first(first_),
+          is_delimiter(is_delimiter_)
+    {
+    }
+
+    void select(meta_kernel &k) const
+    {
+        k << "i > 0 && !(" << is_delimiter(first[k.var<uint_>("i-1")]) << ") && "
+          << "(i + 1 == count || " << is_delimiter(first[k.var<uint_>("i")]) << ")";
+    }
+
+    InputIterator first;
+    Predicate is_delimiter;
+};
+
+} // end detail namespace
+
+/// Splits the text [\p first, \p last) into tokens separated by the
+/// characters for which \p is_delimiter returns \c true. The offset of the
+/// first character of each token is written to the range beginning at
+/// \p token_first and the offset one past its last character to the range
+/// beginning at \p token_last (both relative to \p first). Consecutive
+/// delimiters do not produce empty tokens.
+///
+/// Returns a pair with the ends of both output ranges. A text of \c n
+/// characters has at most <tt>(n + 1) / 2</tt> tokens.
+///
+/// For example, to split a string at spaces and tabs:
+/// \code
+/// using boost::compute::lambda::_1;
+///
+/// boost::compute::split_if(
+///     text.begin(), text.end(), starts.begin(), ends.begin(),
+///     _1 == ' ' || _1 == '\t', queue
+/// );
+/// \endcode
+///
+/// \see split()
+template<class InputIterator,
+         class OutputIterator1,
+         class OutputIterator2,
+         class Predicate>
+inline std::pair<OutputIterator1, OutputIterator2>
+split_if(InputIterator first,
+         InputIterator last,
+         OutputIterator1 token_first,
+         OutputIterator2 token_last,
+         Predicate is_delimiter,
+         command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("split_if")
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return std::make_pair(token_first, token_last);
+    }
+
+    OutputIterator1 token_first_end = detail::stream_compact(
+        first,
+        count,
+        token_first,
+        detail::split_token_begin<InputIterator, Predicate>(first, is_delimiter),
+        true,
+        queue
+    );
+
+    OutputIterator2 token_last_end = detail::stream_compact(
+        first,
+        count + 1,
+        token_last,
+        detail::split_token_end<InputIterator, Predicate>(first, is_delimiter),
+        true,
+        queue
+    );
+
+    return std::make_pair(token_first_end, token_last_end);
+}
+
+/// Splits the text [\p first, \p last) into tokens separated by
+/// \p delimiter.
+///
+/// \see split_if()
+template<class InputIterator, class OutputIterator1, class OutputIterator2>
+inline std::pair<OutputIterator1, OutputIterator2>
+split(InputIterator first,
+      InputIterator last,
+      OutputIterator1 token_first,
+      OutputIterator2 token_last,
+      typename std::iterator_traits<InputIterator>::value_type delimiter,
+      command_queue &queue = system::default_queue())
+{
+    using ::boost::compute::_1;
+
+    return ::boost::compute::split_if(
+        first, last, token_first, token_last, _1 == delimiter, queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SPLIT_HPP
@@ -12,20 +12,98 @@
 #define BOOST_COMPUTE_ALGORITHM_STABLE_PARTITION_HPP
 
 #include <boost/compute/system.hpp>
-#include <boost/compute/context.hpp>
-#include <boost/compute/functional.hpp>
 #include <boost/compute/command_queue.hpp>
-#include <boost/compute/algorithm/copy_if.hpp>
-#include <boost/compute/container/vector.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/rotate.hpp>
+#include <boost/compute/algorithm/detail/stable_partition_copy.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/scratch_memory.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
 
 namespace boost {
 namespace compute {
+namespace detail {
+
+// partitions [first, first + count) back into the range from one temporary
+// copy and returns the number of true values
+template<class Iterator, class UnaryPredicate>
+inline size_t stable_partition_copied(Iterator first,
+                                      size_t count,
+                                      UnaryPredicate predicate,
+                                      command_queue &queue)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    scratch_vector<value_type> tmp(count, queue);
+    ::boost::compute::copy(first, first + count, tmp.begin(), queue);
+
+    return stable_partition_copy(
+        tmp.begin(), count, first, first, predicate, true, queue
+    );
+}
+
+// partitions [first, first + count) with temporary copies of only chunk
+// values. each chunk is partitioned in place and its true values are
+// rotated in front of the false values of the chunks before it, so the
+// values are moved more than once and this is slower than copying the
+// whole range.
+template<class Iterator, class UnaryPredicate>
+inline size_t stable_partition_chunked(Iterator first,
+                                       size_t count,
+                                       size_t chunk,
+                                       UnaryPredicate predicate,
+                                       command_queue &queue)
+{
+    typedef typename std::iterator_traits<Iterator>::difference_type difference_type;
+
+    size_t true_count = 0;
+    for(size_t start = 0; start < count; start += chunk){
+        const size_t n = (std::min)(chunk, count - start);
+        const Iterator chunk_first = first + static_cast<difference_type>(start);
+        const size_t chunk_trues =
+            stable_partition_copied(chunk_first, n, predicate, queue);
+
+        ::boost::compute::rotate(
+            first + static_cast<difference_type>(true_count),
+            chunk_first,
+            chunk_first + static_cast<difference_type>(chunk_trues),
+            queue
+        );
+        true_count += chunk_trues;
+    }
+
+    return true_count;
+}
+
+// returns the number of values of type T for which stable_partition()
+// allocates its temporary copy with the available device memory
+template<class T>
+inline size_t stable_partition_chunk_size(size_t count, command_queue &queue)
+{
+    size_t chunk = count;
+    while(chunk > 1 && !fits_scratch_memory(chunk * sizeof(T), chunk * sizeof(T), queue)){
+        chunk /= 2;
+    }
+
+    return chunk;
+}
+
+} // end detail namespace
 
 ///
 /// \brief Partitioning algorithm
 ///
 /// Partitions the elements in the range [\p first, \p last) according to
 /// \p predicate. The order of the elements is preserved.
+///
+/// The range is copied to a temporary buffer once and the true and false
+/// values are written back by the same kernel, their positions being
+/// computed from a single scan of the predicate results. If there is not
+/// enough device memory for the copy the range is partitioned in chunks
+/// which fit, moving the true values of each chunk in front of the false
+/// values before it with rotate().
+///
 /// \return Iterator pointing to end of true values
 ///
 /// \param first Iterator pointing to start of range
@@ -42,28 +120,39 @@ inline Iterator stable_partition(Iterator first,
                                  command_queue &queue = system::default_queue())
 {
     typedef typename std::iterator_traits<Iterator>::value_type value_type;
+    typedef typename std::iterator_traits<Iterator>::difference_type difference_type;
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return first;
+    }
 
-    // make temporary copy of the input
-    ::boost::compute::vector<value_type> tmp(first, last, queue);
-
-    // copy true values
-    Iterator last_true =
-        ::boost::compute::copy_if(tmp.begin(),
-                                  tmp.end(),
-                                  first,
-                                  predicate,
-                                  queue);
-
-    // copy false values
-    Iterator last_false =
-        ::boost::compute::copy_if(tmp.begin(),
-                                  tmp.end(),
-                                  last_true,
-                                  not1(predicate),
-                                  queue);
+    // the values are read from a temporary copy and partitioned back into
+    // the range by a single pass, the false values following the true ones.
+    // the range is not changed before the temporaries are allocated, so it
+    // can still be partitioned in chunks if the allocation fails.
+    size_t chunk = detail::stable_partition_chunk_size<value_type>(count, queue);
+    size_t true_count = 0;
+    if(chunk == count){
+        try {
+            true_count = detail::stable_partition_copied(first, count, predicate, queue);
+        }
+        catch(const opencl_error &e){
+            if(!detail::is_allocation_failure(e) || count == 1){
+                throw;
+            }
+            chunk = count / 2;
+        }
+    }
+    if(chunk != count){
+        BOOST_COMPUTE_DETAIL_TRACE_STRATEGY("stable_partition", "chunked")
+        true_count = detail::stable_partition_chunked(
+            first, count, chunk, predicate, queue
+        );
+    }
 
     // return iterator pointing to the last true value
-    return last_true;
+    return first + static_cast<difference_type>(true_count);
 }
 
 } // end compute namespace
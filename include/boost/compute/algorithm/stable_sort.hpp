@@ -17,7 +17,11 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/detail/radix_sort.hpp>
 #include <boost/compute/algorithm/detail/insertion_sort.hpp>
+#include <boost/compute/algorithm/detail/merge_sort_on_cpu.hpp>
+#include <boost/compute/algorithm/detail/merge_sort_on_gpu.hpp>
 #include <boost/compute/algorithm/reverse.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/work_size.hpp>
 #include <boost/compute/functional/operator.hpp>
 
 namespace boost {
@@ -35,6 +39,31 @@ inline void dispatch_stable_sort(Iterator first,
     );
 }
 
+template<class T, class Compare>
+inline void dispatch_stable_sort(buffer_iterator<T> first,
+                                 buffer_iterator<T> last,
+                                 Compare compare,
+                                 command_queue &queue)
+{
+    size_t count = detail::iterator_range_size(first, last);
+
+    if(count <= 32){
+        ::boost::compute::detail::serial_insertion_sort(
+            first, last, compare, queue
+        );
+    }
+    else if(is_cpu_device(queue.get_device())){
+        ::boost::compute::detail::merge_sort_on_cpu(
+            first, last, compare, queue
+        );
+    }
+    else {
+        ::boost::compute::detail::merge_sort_on_gpu(
+            first, last, compare, queue
+        );
+    }
+}
+
 template<class T>
 inline typename boost::enable_if_c<is_radix_sortable<T>::value>::type
 dispatch_stable_sort(buffer_iterator<T> first,
@@ -56,7 +85,7 @@ dispatch_stable_sort(buffer_iterator<T> first,
     ::boost::compute::detail::radix_sort(first, last, queue);
 
     // reverse range to descending order
-    ::boost::compute::reverse(first, last, queue);
+    ::boost::compute::detail::radix_sort_reverse(first, last, queue);
 }
 
 } // end detail namespace
@@ -71,6 +100,8 @@ inline void stable_sort(Iterator first,
                         Compare compare,
                         command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("stable_sort")
+
     ::boost::compute::detail::dispatch_stable_sort(
         first, last, compare, queue
     );
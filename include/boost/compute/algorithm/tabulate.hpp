@@ -0,0 +1,61 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_TABULATE_HPP
+#define BOOST_COMPUTE_ALGORITHM_TABULATE_HPP
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Stores the result of \p function for the index of each element in the
+/// range [\p first, \p last), i.e. \c function(i) is stored to
+/// \c first[i]. The index is passed as an \c int.
+///
+/// For example, to fill a vector with the squares of their indices:
+/// \code
+/// BOOST_COMPUTE_FUNCTION(int, square, (int x),
+/// {
+///     return x * x;
+/// });
+///
+/// boost::compute::tabulate(vector.begin(), vector.end(), square, queue);
+/// \endcode
+///
+/// \see iota(), generate()
+template<class Iterator, class UnaryFunction>
+inline void tabulate(Iterator first,
+                     Iterator last,
+                     UnaryFunction function,
+                     command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("tabulate")
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    detail::meta_kernel k("tabulate");
+    k << "const uint i = get_global_id(0);\n" <<
+         first[k.var<uint_>("i")] << " = " <<
+             function(k.var<int_>("(int) i")) << ";\n";
+
+    k.exec_1d(queue, 0, count);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_TABULATE_HPP
@@ -14,9 +14,17 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/iterator/constant_iterator.hpp>
 #include <boost/compute/iterator/transform_iterator.hpp>
 #include <boost/compute/iterator/zip_iterator.hpp>
 #include <boost/compute/functional/detail/unpack.hpp>
+#include <boost/compute/detail/broadcast_value.hpp>
+#include <boost/compute/detail/buffer_value.hpp>
+#include <boost/compute/detail/enqueue_wait_list.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/nd_range.hpp>
+#include <boost/compute/utility/extents.hpp>
 
 namespace boost {
 namespace compute {
@@ -37,6 +45,8 @@ inline OutputIterator transform(InputIterator first,
                                 UnaryOperator op,
                                 command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("transform")
+
     return copy(
                ::boost::compute::make_transform_iterator(first, op),
                ::boost::compute::make_transform_iterator(last, op),
@@ -45,6 +55,50 @@ inline OutputIterator transform(InputIterator first,
            );
 }
 
+/// \overload
+template<class InputIterator, class OutputIterator, class UnaryOperator>
+inline OutputIterator transform(InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                UnaryOperator op,
+                                command_queue &queue,
+                                const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::transform(first, last, result, op, queue);
+}
+
+/// \overload
+///
+/// Transforms the \p size.linear() elements beginning at \p first,
+/// which hold a row-major array of \p size (e.g. an image of
+/// \c dim(width, height)), to the range beginning at \p result. The
+/// kernel is run over an nd-range of \p size in work-groups tiling it.
+template<class InputIterator, size_t N, class OutputIterator, class UnaryOperator>
+inline OutputIterator transform(InputIterator first,
+                                const extents<N> &size,
+                                OutputIterator result,
+                                UnaryOperator op,
+                                command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("transform")
+
+    if(size.linear() == 0){
+        return result;
+    }
+
+    detail::meta_kernel k("transform_nd");
+    detail::nd_range_index_begin(k, size);
+    k << result[k.var<uint_>("index")] << " = "
+      << op(first[k.var<uint_>("index")]) << ";\n";
+    detail::nd_range_index_end(k);
+
+    detail::exec_nd_range(k, size, queue);
+
+    return result + size.linear();
+}
+
 /// \overload
 template<class InputIterator1,
          class InputIterator2,
@@ -70,6 +124,167 @@ inline OutputIterator transform(InputIterator1 first1,
            );
 }
 
+/// \overload
+template<class InputIterator1,
+         class InputIterator2,
+         class OutputIterator,
+         class BinaryOperator>
+inline OutputIterator transform(InputIterator1 first1,
+                                InputIterator1 last1,
+                                InputIterator2 first2,
+                                OutputIterator result,
+                                BinaryOperator op,
+                                command_queue &queue,
+                                const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::transform(first1, last1, first2, result, op, queue);
+}
+
+/// \overload
+///
+/// Transforms each element in the range [\p first1, \p last1) together with
+/// \p value, a scalar stored on the device (e.g. an element of a vector
+/// holding the result of reduce()), using \p op. The value is read by the
+/// kernel so it is never copied to the host.
+///
+/// For example, to normalize a vector by its sum:
+/// \code
+/// boost::compute::vector<float> sum(1, context);
+/// boost::compute::reduce(vec.begin(), vec.end(), sum.begin(), queue);
+/// boost::compute::transform(
+///     vec.begin(), vec.end(), sum[0], vec.begin(), divides<float>(), queue
+/// );
+/// \endcode
+template<class InputIterator,
+         class T,
+         class OutputIterator,
+         class BinaryOperator>
+inline OutputIterator transform(InputIterator first1,
+                                InputIterator last1,
+                                const detail::buffer_value<T> &value,
+                                OutputIterator result,
+                                BinaryOperator op,
+                                command_queue &queue = system::default_queue())
+{
+    if(!value.get_buffer().get()){
+        return transform(
+                   first1,
+                   last1,
+                   ::boost::compute::make_constant_iterator(static_cast<T>(value)),
+                   result,
+                   op,
+                   queue
+               );
+    }
+
+    return transform(
+               first1, last1, detail::make_broadcast_iterator(value), result, op, queue
+           );
+}
+
+/// \overload
+template<class InputIterator,
+         class T,
+         class OutputIterator,
+         class BinaryOperator>
+inline OutputIterator transform(InputIterator first1,
+                                InputIterator last1,
+                                const detail::buffer_value<T> &value,
+                                OutputIterator result,
+                                BinaryOperator op,
+                                command_queue &queue,
+                                const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::transform(first1, last1, value, result, op, queue);
+}
+
+/// Asynchronous version of transform(). The values are transformed into
+/// the device range beginning at \p result without waiting for the
+/// kernel to complete.
+///
+/// \return a future for the end of the result range
+///
+/// \see transform(), copy_async()
+template<class InputIterator, class OutputIterator, class UnaryOperator>
+inline future<OutputIterator>
+transform_async(InputIterator first,
+                InputIterator last,
+                OutputIterator result,
+                UnaryOperator op,
+                command_queue &queue = system::default_queue())
+{
+    return copy_async(
+               ::boost::compute::make_transform_iterator(first, op),
+               ::boost::compute::make_transform_iterator(last, op),
+               result,
+               queue
+           );
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator, class UnaryOperator>
+inline future<OutputIterator>
+transform_async(InputIterator first,
+                InputIterator last,
+                OutputIterator result,
+                UnaryOperator op,
+                command_queue &queue,
+                const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::transform_async(first, last, result, op, queue);
+}
+
+/// \overload
+template<class InputIterator1,
+         class InputIterator2,
+         class OutputIterator,
+         class BinaryOperator>
+inline future<OutputIterator>
+transform_async(InputIterator1 first1,
+                InputIterator1 last1,
+                InputIterator2 first2,
+                OutputIterator result,
+                BinaryOperator op,
+                command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator1>::difference_type difference_type;
+
+    difference_type n = std::distance(first1, last1);
+
+    return transform_async(
+               make_zip_iterator(boost::make_tuple(first1, first2)),
+               make_zip_iterator(boost::make_tuple(last1, first2 + n)),
+               result,
+               detail::unpack(op),
+               queue
+           );
+}
+
+/// \overload
+template<class InputIterator1,
+         class InputIterator2,
+         class OutputIterator,
+         class BinaryOperator>
+inline future<OutputIterator>
+transform_async(InputIterator1 first1,
+                InputIterator1 last1,
+                InputIterator2 first2,
+                OutputIterator result,
+                BinaryOperator op,
+                command_queue &queue,
+                const wait_list &events)
+{
+    detail::enqueue_wait_list(queue, events);
+
+    return ::boost::compute::transform_async(first1, last1, first2, result, op, queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -0,0 +1,74 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_TRANSFORM_IF_HPP
+#define BOOST_COMPUTE_ALGORITHM_TRANSFORM_IF_HPP
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Copies the result of \p op for each element in the range
+/// [\p first, \p last) for which \p predicate returns \c true to the range
+/// beginning at \p result, keeping their order (like copy_if() followed by
+/// transform()). Returns an iterator to the end of the output range.
+///
+/// The values are selected, scanned and transformed by the same kernels as
+/// copy_if(), without storing the selected values or their positions in
+/// temporary buffers. \p op is only invoked for the selected values.
+///
+/// For example, to copy the square roots of the positive values:
+/// \code
+/// using boost::compute::lambda::_1;
+///
+/// boost::compute::transform_if(
+///     input.begin(), input.end(), output.begin(),
+///     boost::compute::sqrt<float>(), _1 > 0.f, queue
+/// );
+/// \endcode
+///
+/// Unlike \c experimental::transform_if(), which writes the transformed
+/// values at the index of the input values and leaves the others
+/// untouched, the output range is compacted.
+///
+/// \see copy_if(), transform()
+template<class InputIterator,
+         class OutputIterator,
+         class UnaryFunction,
+         class Predicate>
+inline OutputIterator transform_if(InputIterator first,
+                                   InputIterator last,
+                                   OutputIterator result,
+                                   UnaryFunction op,
+                                   Predicate predicate,
+                                   command_queue &queue = system::default_queue())
+{
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("transform_if")
+
+    return detail::stream_compact(
+        first,
+        detail::iterator_range_size(first, last),
+        result,
+        detail::stream_compact_transform_if<
+            InputIterator, UnaryFunction, Predicate
+        >(first, op, predicate),
+        false,
+        queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_TRANSFORM_IF_HPP
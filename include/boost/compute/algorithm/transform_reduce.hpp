@@ -11,12 +11,18 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_TRANSFORM_REDUCE_HPP
 #define BOOST_COMPUTE_ALGORITHM_TRANSFORM_REDUCE_HPP
 
+#include <boost/tuple/tuple.hpp>
+#include <boost/preprocessor/repetition.hpp>
+
 #include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
 #include <boost/compute/algorithm/reduce.hpp>
-#include <boost/compute/iterator/transform_iterator.hpp>
-#include <boost/compute/iterator/zip_iterator.hpp>
-#include <boost/compute/functional/detail/unpack.hpp>
+#include <boost/compute/algorithm/detail/fused_transform_reduce.hpp>
+#include <boost/compute/algorithm/detail/multi_reduce.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
 
 namespace boost {
 namespace compute {
@@ -30,6 +36,10 @@ namespace compute {
 ///
 /// \snippet test/test_transform_reduce.cpp sum_abs_int
 ///
+/// The transformed values are computed while loading the input of the
+/// reduction and are never stored in memory. As with \c reduce(),
+/// \p reduce_function is assumed to be associative.
+///
 /// \see reduce(), inner_product()
 template<class InputIterator,
          class OutputIterator,
@@ -42,13 +52,26 @@ inline void transform_reduce(InputIterator first,
                              BinaryReduceFunction reduce_function,
                              command_queue &queue = system::default_queue())
 {
-    ::boost::compute::reduce(
-        ::boost::compute::make_transform_iterator(first, transform_function),
-        ::boost::compute::make_transform_iterator(last, transform_function),
-        result,
-        reduce_function,
-        queue
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("transform_reduce")
+
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        boost::compute::result_of<UnaryTransformFunction(value_type)>::type
+        transform_type;
+    typedef typename
+        boost::compute::result_of<BinaryReduceFunction(transform_type, transform_type)>::type
+        result_type;
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    detail::scratch_vector<result_type> value(1, queue);
+    detail::fused_transform_reduce(
+        first, count, transform_function, reduce_function, value.begin(), queue
     );
+    ::boost::compute::copy_n(value.begin(), 1, result, queue);
 }
 
 /// \overload
@@ -65,24 +88,79 @@ inline void transform_reduce(InputIterator1 first1,
                              BinaryReduceFunction reduce_function,
                              command_queue &queue = system::default_queue())
 {
-    typedef typename std::iterator_traits<InputIterator1>::difference_type difference_type;
-
-    difference_type n = std::distance(first1, last1);
-
-    ::boost::compute::transform_reduce(
-        ::boost::compute::make_zip_iterator(
-            boost::make_tuple(first1, first2)
-        ),
-        ::boost::compute::make_zip_iterator(
-            boost::make_tuple(last1, first2 + n)
-        ),
-        result,
-        detail::unpack(transform_function),
-        reduce_function,
-        queue
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("transform_reduce")
+
+    typedef typename std::iterator_traits<InputIterator1>::value_type value_type1;
+    typedef typename std::iterator_traits<InputIterator2>::value_type value_type2;
+    typedef typename
+        boost::compute::result_of<BinaryTransformFunction(value_type1, value_type2)>::type
+        transform_type;
+    typedef typename
+        boost::compute::result_of<BinaryReduceFunction(transform_type, transform_type)>::type
+        result_type;
+
+    const size_t count = detail::iterator_range_size(first1, last1);
+    if(count == 0){
+        return;
+    }
+
+    detail::scratch_vector<result_type> value(1, queue);
+    detail::fused_transform_reduce(
+        first1, first2, count, transform_function, reduce_function, value.begin(), queue
     );
+    ::boost::compute::copy_n(value.begin(), 1, result, queue);
 }
 
+/// \fn transform_reduce(InputIterator first, InputIterator last, OutputIterator result, const boost::tuple<UnaryTransformFunction0, ...> &transform_functions, const boost::tuple<BinaryReduceFunction0, ...> &reduce_functions, command_queue &queue = system::default_queue())
+///
+/// Computes several transformed reductions of the range [\p first,
+/// \p last) at once. The j-th field of the tuple pointed to by \p result
+/// is the reduction with the j-th function of \p reduce_functions of the
+/// values transformed with the j-th function of \p transform_functions.
+///
+/// The range is read a single time. For example, to compute the sum and the
+/// sum of the squares of a vector of floats (from which its mean and its
+/// variance follow):
+/// \code
+/// using boost::compute::lambda::_1;
+///
+/// boost::tuple<float, float> sums;
+/// boost::compute::transform_reduce(
+///     vector.begin(), vector.end(), &sums,
+///     boost::make_tuple(identity<float>(), _1 * _1),
+///     boost::make_tuple(plus<float>(), plus<float>()),
+///     queue
+/// );
+/// \endcode
+///
+/// \see reduce()
+#define BOOST_COMPUTE_DETAIL_DEFINE_MULTI_TRANSFORM_REDUCE(z, n, unused)       \
+template<class InputIterator,                                                  \
+         class OutputIterator,                                                 \
+         BOOST_PP_ENUM_PARAMS(n, class UnaryTransformFunction),                \
+         BOOST_PP_ENUM_PARAMS(n, class BinaryReduceFunction)>                  \
+inline void transform_reduce(InputIterator first,                              \
+                             InputIterator last,                               \
+                             OutputIterator result,                            \
+                             const boost::tuple<                               \
+                                 BOOST_PP_ENUM_PARAMS(n, UnaryTransformFunction) \
+                             > &transform_functions,                           \
+                             const boost::tuple<                               \
+                                 BOOST_PP_ENUM_PARAMS(n, BinaryReduceFunction) \
+                             > &reduce_functions,                              \
+                             command_queue &queue = system::default_queue())   \
+{                                                                              \
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("transform_reduce")                   \
+                                                                               \
+    detail::multi_transform_reduce(                                            \
+        first, last, result, transform_functions, reduce_functions, queue      \
+    );                                                                         \
+}
+
+BOOST_PP_REPEAT_FROM_TO(1, BOOST_COMPUTE_MAX_ARITY, BOOST_COMPUTE_DETAIL_DEFINE_MULTI_TRANSFORM_REDUCE, ~)
+
+#undef BOOST_COMPUTE_DETAIL_DEFINE_MULTI_TRANSFORM_REDUCE
+
 } // end compute namespace
 } // end boost namespace
 
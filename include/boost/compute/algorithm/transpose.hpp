@@ -0,0 +1,135 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_TRANSPOSE_HPP
+#define BOOST_COMPUTE_ALGORITHM_TRANSPOSE_HPP
+
+#include <algorithm>
+#include <iterator>
+
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns the width of the square tiles transposed by each work-group on
+// the queue's device. work-groups are tile x block_rows work-items, each
+// of them moving tile / block_rows values.
+//
+// the defaults can be overridden through the global parameter_cache for
+// the device with the object name "__boost_transpose" and the parameters
+// "tile_size" and "block_rows".
+inline void transpose_tile_size(command_queue &queue,
+                                size_t value_size,
+                                uint_ &tile,
+                                uint_ &block_rows)
+{
+    const device &device = queue.get_device();
+    const ulong_ local_memory = device_profile::get(device)->local_memory_size();
+
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(device);
+
+    // cpus have no local memory banks, smaller tiles stay in the l1 cache
+    const uint_ default_tile = device.type() & device::cpu ? 16 : 32;
+
+    tile = parameters->get("__boost_transpose", "tile_size", default_tile);
+    block_rows = parameters->get("__boost_transpose", "block_rows", uint_(8));
+
+    tile = (std::max)(tile, uint_(1));
+    while(tile > 1 &&
+          (tile * block_rows > device.max_work_group_size() ||
+           tile * (tile + 1) * value_size > local_memory)){
+        tile /= 2;
+    }
+    block_rows = (std::max)(uint_(1), (std::min)(block_rows, tile));
+}
+
+} // end detail namespace
+
+/// Transposes the \p rows x \p columns row-major matrix starting at
+/// \p first and stores the \p columns x \p rows result at \p result.
+/// Returns an iterator to the end of the result.
+///
+/// Each work-group loads a square tile in local memory with coalesced
+/// reads and writes it back transposed with coalesced writes. The tiles
+/// are padded by one column to avoid local memory bank conflicts and their
+/// size depends on the device (see the \c "__boost_transpose" parameters).
+///
+/// The input and output ranges must not overlap.
+///
+/// \see copy_rect()
+template<class InputIterator, class OutputIterator>
+inline OutputIterator transpose(InputIterator first,
+                                size_t rows,
+                                size_t columns,
+                                OutputIterator result,
+                                command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    if(rows == 0 || columns == 0){
+        return result;
+    }
+
+    uint_ tile = 0;
+    uint_ block_rows = 0;
+    detail::transpose_tile_size(queue, sizeof(value_type), tile, block_rows);
+
+    detail::meta_kernel k("transpose");
+    k.add_set_arg<uint_>("rows", static_cast<uint_>(rows));
+    k.add_set_arg<uint_>("columns", static_cast<uint_>(columns));
+
+    k <<
+        "__local " << k.type<value_type>() <<
+            " tile[" << tile << "][" << tile + 1 << "];\n" <<
+        "const uint lx = get_local_id(0);\n" <<
+        "const uint ly = get_local_id(1);\n" <<
+        "uint x = get_group_id(0) * " << tile << " + lx;\n" <<
+        "uint y = get_group_id(1) * " << tile << " + ly;\n" <<
+        "for(uint i = 0; ly + i < " << tile << "; i += " << block_rows << "){\n" <<
+        "    if(x < columns && y + i < rows){\n" <<
+        "        tile[ly + i][lx] = " <<
+                first[k.var<uint_>("(y + i) * columns + x")] << ";\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "x = get_group_id(1) * " << tile << " + lx;\n" <<
+        "y = get_group_id(0) * " << tile << " + ly;\n" <<
+        "for(uint i = 0; ly + i < " << tile << "; i += " << block_rows << "){\n" <<
+        "    if(x < rows && y + i < columns){\n" <<
+        "        " << result[k.var<uint_>("(y + i) * rows + x")] <<
+                " = tile[lx][ly + i];\n" <<
+        "    }\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+
+    const size_t global_size[] = {
+        (columns + tile - 1) / tile * tile,
+        (rows + tile - 1) / tile * block_rows
+    };
+    const size_t local_size[] = { tile, block_rows };
+    queue.enqueue_nd_range_kernel(kernel, 2, 0, global_size, local_size);
+
+    return result + static_cast<std::ptrdiff_t>(rows * columns);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_TRANSPOSE_HPP
@@ -38,6 +38,8 @@ inline InputIterator unique(InputIterator first,
                             BinaryPredicate op,
                             command_queue &queue = system::default_queue())
 {
+    BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM("unique")
+
     typedef typename std::iterator_traits<InputIterator>::value_type value_type;
 
     vector<value_type> temp(first, last, queue);
@@ -17,6 +17,7 @@
 #include <boost/compute/algorithm/copy_if.hpp>
 #include <boost/compute/algorithm/transform.hpp>
 #include <boost/compute/algorithm/gather.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
@@ -84,33 +85,16 @@ inline OutputIterator unique_copy(InputIterator first,
         return result;
     }
 
-    const context &context = queue.get_context();
-    size_t count = detail::iterator_range_size(first, last);
-
-    // flags marking unique elements
-    vector<uint_> flags(count, context);
-
-    // find each unique element and mark it with a one
-    transform(
-        first, last - 1, first + 1, flags.begin() + 1, not2(op), queue
-    );
-
-    // first element is always unique
-    fill_n(flags.begin(), 1, 1, queue);
-
-    // storage for desination indices
-    vector<uint_> indices(count, context);
-
-    // copy indices for each unique element
-    vector<uint_>::iterator last_index = detail::copy_index_if(
-        flags.begin(), flags.end(), indices.begin(), lambda::_1 == 1, queue
+    // copy the first value and each value which differs from the
+    // previous one
+    return stream_compact(
+        first,
+        detail::iterator_range_size(first, last),
+        result,
+        stream_compact_unique<InputIterator, BinaryPredicate>(first, op),
+        false,
+        queue
     );
-
-    // copy unique values from input to output using the computed indices
-    gather(indices.begin(), last_index, first, result, queue);
-
-    // return an iterator to the end of the unique output range
-    return result + std::distance(indices.begin(), last_index);
 }
 
 } // end detail namespace
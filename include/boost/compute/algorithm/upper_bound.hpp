@@ -15,6 +15,7 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/detail/binary_find.hpp>
+#include <boost/compute/algorithm/detail/vectorized_binary_search.hpp>
 
 namespace boost {
 namespace compute {
@@ -37,6 +38,37 @@ upper_bound(InputIterator first,
     return position;
 }
 
+/// For each value in the range [\p values_first, \p values_last),
+/// stores the index of the first element in the sorted range [\p first,
+/// \p last) that is greater than the value in the range beginning at
+/// \p result.
+///
+/// Each of the values is searched for by its own work-item, so all of the
+/// values are searched for with a single kernel launch.
+///
+/// \param first first element in the sorted range
+/// \param last last element in the sorted range
+/// \param values_first first value to search for
+/// \param values_last last value to search for
+/// \param result first element in the result range
+/// \param queue command queue to perform the operation
+///
+/// \return \c OutputIterator to the end of the result range
+template<class InputIterator, class ValueIterator, class OutputIterator>
+inline OutputIterator
+upper_bound(InputIterator first,
+            InputIterator last,
+            ValueIterator values_first,
+            ValueIterator values_last,
+            OutputIterator result,
+            command_queue &queue = system::default_queue())
+{
+    return detail::vectorized_binary_search(
+        first, last, values_first, values_last, result,
+        detail::vectorized_search_upper_bound, queue
+    );
+}
+
 } // end compute namespace
 } // end boost namespace
 
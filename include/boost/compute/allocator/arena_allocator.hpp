@@ -0,0 +1,127 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALLOCATOR_ARENA_ALLOCATOR_HPP
+#define BOOST_COMPUTE_ALLOCATOR_ARENA_ALLOCATOR_HPP
+
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/allocator/buffer_allocator.hpp>
+#include <boost/compute/utility/buffer_arena.hpp>
+#include <boost/compute/utility/memory_usage.hpp>
+
+namespace boost {
+namespace compute {
+
+#if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+/// \class arena_allocator
+/// \brief The arena_allocator class allocates memory from a \ref buffer_arena
+///
+/// The arena_allocator carves the memory of containers out of the large
+/// blocks of a buffer arena (as sub-buffers) instead of creating a memory
+/// object for each of them. This is much faster for programs creating
+/// many small containers.
+///
+/// Memory is handed out again as soon as it is deallocated, so containers
+/// using this allocator must only be destroyed once the commands using
+/// them have completed.
+///
+/// For example, to create a vector using the global arena of its context:
+/// \code
+/// boost::compute::vector<int, boost::compute::arena_allocator<int> >
+///     vec(16, context);
+/// \endcode
+///
+/// \opencl_version_warning{1,1}
+///
+/// \see buffer_allocator, buffer_arena
+template<class T>
+class arena_allocator : public buffer_allocator<T>
+{
+public:
+    typedef typename buffer_allocator<T>::pointer pointer;
+    typedef typename buffer_allocator<T>::size_type size_type;
+
+    /// Creates an allocator using the global arena of \p context.
+    explicit arena_allocator(const context &context)
+        : buffer_allocator<T>(context),
+          m_arena(buffer_arena::get_global_arena(context))
+    {
+    }
+
+    /// Creates an allocator using \p arena.
+    explicit arena_allocator(const boost::shared_ptr<buffer_arena> &arena)
+        : buffer_allocator<T>(arena->get_context()),
+          m_arena(arena)
+    {
+    }
+
+    arena_allocator(const arena_allocator<T> &other)
+        : buffer_allocator<T>(other),
+          m_arena(other.m_arena)
+    {
+    }
+
+    arena_allocator<T>& operator=(const arena_allocator<T> &other)
+    {
+        if(this != &other){
+            buffer_allocator<T>::operator=(other);
+            m_arena = other.m_arena;
+        }
+
+        return *this;
+    }
+
+    ~arena_allocator()
+    {
+    }
+
+    pointer allocate(size_type n)
+    {
+        buffer buf = m_arena->allocate(n * sizeof(T));
+        clRetainMemObject(buf.get());
+
+        memory_usage::get_global_usage(this->get_context())->allocated(
+            memory_usage::containers, n * sizeof(T)
+        );
+        return detail::device_ptr<T>(buf);
+    }
+
+    void deallocate(pointer p, size_type n)
+    {
+        BOOST_ASSERT(p.get_buffer().get_context() == this->get_context());
+
+        memory_usage::get_global_usage(this->get_context())->deallocated(
+            memory_usage::containers, n * sizeof(T)
+        );
+
+        // take ownership of the reference retained in allocate()
+        buffer buf(p.get_buffer().get(), false);
+        m_arena->release(buf);
+    }
+
+    /// Returns the buffer arena used by the allocator.
+    const boost::shared_ptr<buffer_arena>& get_arena() const
+    {
+        return m_arena;
+    }
+
+private:
+    boost::shared_ptr<buffer_arena> m_arena;
+};
+#endif // CL_VERSION_1_1
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALLOCATOR_ARENA_ALLOCATOR_HPP
@@ -15,6 +15,7 @@
 #include <boost/compute/config.hpp>
 #include <boost/compute/context.hpp>
 #include <boost/compute/detail/device_ptr.hpp>
+#include <boost/compute/utility/memory_usage.hpp>
 
 namespace boost {
 namespace compute {
@@ -79,6 +80,10 @@ public:
     {
         buffer buf(m_context, n * sizeof(T), m_mem_flags);
         clRetainMemObject(buf.get());
+
+        memory_usage::get_global_usage(m_context)->allocated(
+            memory_usage::containers, n * sizeof(T)
+        );
         return detail::device_ptr<T>(buf);
     }
 
@@ -86,7 +91,9 @@ public:
     {
         BOOST_ASSERT(p.get_buffer().get_context() == m_context);
 
-        (void) n;
+        memory_usage::get_global_usage(m_context)->deallocated(
+            memory_usage::containers, n * sizeof(T)
+        );
 
         clReleaseMemObject(p.get_buffer().get());
     }
@@ -0,0 +1,107 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALLOCATOR_POOLED_ALLOCATOR_HPP
+#define BOOST_COMPUTE_ALLOCATOR_POOLED_ALLOCATOR_HPP
+
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/allocator/buffer_allocator.hpp>
+#include <boost/compute/utility/buffer_pool.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class pooled_allocator
+/// \brief The pooled_allocator class allocates memory from a \ref buffer_pool
+///
+/// The pooled_allocator recycles the buffers it deallocates through the
+/// global buffer pool for its context instead of releasing them. This
+/// avoids the cost of creating new memory objects for containers which
+/// are frequently created and destroyed.
+///
+/// Memory is handed out again as soon as it is deallocated, so containers
+/// using this allocator must only be destroyed once the commands using
+/// them have completed (e.g. after calling command_queue::finish()).
+///
+/// For example, to create a vector using the pooled allocator:
+/// \code
+/// boost::compute::vector<int, boost::compute::pooled_allocator<int> >
+///     vec(1024, context);
+/// \endcode
+///
+/// \see buffer_allocator, buffer_pool
+template<class T>
+class pooled_allocator : public buffer_allocator<T>
+{
+public:
+    typedef typename buffer_allocator<T>::pointer pointer;
+    typedef typename buffer_allocator<T>::size_type size_type;
+
+    explicit pooled_allocator(const context &context)
+        : buffer_allocator<T>(context),
+          m_pool(buffer_pool::get_global_pool(context))
+    {
+    }
+
+    pooled_allocator(const pooled_allocator<T> &other)
+        : buffer_allocator<T>(other),
+          m_pool(other.m_pool)
+    {
+    }
+
+    pooled_allocator<T>& operator=(const pooled_allocator<T> &other)
+    {
+        if(this != &other){
+            buffer_allocator<T>::operator=(other);
+            m_pool = other.m_pool;
+        }
+
+        return *this;
+    }
+
+    ~pooled_allocator()
+    {
+    }
+
+    pointer allocate(size_type n)
+    {
+        buffer buf = m_pool->allocate(n * sizeof(T));
+        clRetainMemObject(buf.get());
+        return detail::device_ptr<T>(buf);
+    }
+
+    void deallocate(pointer p, size_type n)
+    {
+        BOOST_ASSERT(p.get_buffer().get_context() == this->get_context());
+
+        (void) n;
+
+        // take ownership of the reference retained in allocate()
+        buffer buf(p.get_buffer().get(), false);
+        m_pool->release(buf);
+    }
+
+    /// Returns the buffer pool used by the allocator.
+    const boost::shared_ptr<buffer_pool>& get_pool() const
+    {
+        return m_pool;
+    }
+
+private:
+    boost::shared_ptr<buffer_pool> m_pool;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALLOCATOR_POOLED_ALLOCATOR_HPP
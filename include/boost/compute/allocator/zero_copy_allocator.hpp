@@ -0,0 +1,75 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALLOCATOR_ZERO_COPY_ALLOCATOR_HPP
+#define BOOST_COMPUTE_ALLOCATOR_ZERO_COPY_ALLOCATOR_HPP
+
+#include <boost/compute/allocator/buffer_allocator.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class zero_copy_allocator
+/// \brief An allocator for buffers which the host can access directly.
+///
+/// On devices which share their memory with the host (CPUs, integrated
+/// GPUs and APUs, see \c CL_DEVICE_HOST_UNIFIED_MEMORY) the
+/// zero_copy_allocator allocates buffers with \c CL_MEM_ALLOC_HOST_PTR.
+/// copy() between the host and such buffers maps the buffer and copies the
+/// values directly instead of enqueuing a transfer. On other devices it
+/// allocates regular buffers.
+///
+/// For example, to create a vector which uses zero-copy transfers when
+/// possible:
+/// \code
+/// boost::compute::vector<
+///     float, boost::compute::zero_copy_allocator<float>
+/// > vector(size, context);
+/// \endcode
+///
+/// \see buffer_allocator, pinned_allocator
+template<class T>
+class zero_copy_allocator : public buffer_allocator<T>
+{
+public:
+    explicit zero_copy_allocator(const context &context)
+        : buffer_allocator<T>(context)
+    {
+        if(detail::device_profile::get(context.get_device())->host_unified_memory()){
+            buffer_allocator<T>::set_mem_flags(
+                buffer::read_write | buffer::alloc_host_ptr
+            );
+        }
+    }
+
+    zero_copy_allocator(const zero_copy_allocator<T> &other)
+        : buffer_allocator<T>(other)
+    {
+    }
+
+    zero_copy_allocator<T>& operator=(const zero_copy_allocator<T> &other)
+    {
+        if(this != &other){
+            buffer_allocator<T>::operator=(other);
+        }
+
+        return *this;
+    }
+
+    ~zero_copy_allocator()
+    {
+    }
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALLOCATOR_ZERO_COPY_ALLOCATOR_HPP
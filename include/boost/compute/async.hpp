@@ -15,7 +15,11 @@
 ///
 /// Meta-header to include all Boost.Compute async headers.
 
+#include <boost/compute/async/coroutine.hpp>
 #include <boost/compute/async/future.hpp>
+#include <boost/compute/async/thread_pool.hpp>
 #include <boost/compute/async/wait_guard.hpp>
+#include <boost/compute/async/when_all.hpp>
+#include <boost/compute/async/when_any.hpp>
 
 #endif // BOOST_COMPUTE_ASYNC_HPP
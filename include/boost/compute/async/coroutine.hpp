@@ -0,0 +1,171 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ASYNC_COROUTINE_HPP
+#define BOOST_COMPUTE_ASYNC_COROUTINE_HPP
+
+#include <boost/compute/config.hpp>
+
+#if !defined(BOOST_COMPUTE_DETAIL_NO_COROUTINES) && defined(CL_VERSION_1_1)
+
+#include <coroutine>
+
+#include <boost/compute/event.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/async/thread_pool.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// suspends the awaiting coroutine until event is complete and resumes it
+// with executor (from the callback of the event)
+template<class Executor>
+class event_awaiter
+{
+public:
+    event_awaiter(const event &event, Executor &executor)
+        : m_event(event),
+          m_executor(&executor)
+    {
+    }
+
+    bool await_ready() const
+    {
+        return !m_event.get() || m_event.status() == event::complete;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        Executor *executor = m_executor;
+
+        // the coroutine (and this awaiter) may be destroyed by another
+        // thread as soon as the callback is registered
+        const event event_ = m_event;
+        event_.set_callback([executor, handle](){
+            executor->post([handle](){ handle.resume(); });
+        });
+    }
+
+    void await_resume() const
+    {
+        if(!m_event.get()){
+            return;
+        }
+
+        // commands terminated abnormally have a negative status
+        const cl_int status = m_event.get_info<cl_int>(CL_EVENT_COMMAND_EXECUTION_STATUS);
+        if(status < 0){
+            BOOST_THROW_EXCEPTION(opencl_error(status));
+        }
+    }
+
+protected:
+    event m_event;
+    Executor *m_executor;
+};
+
+// like event_awaiter but returns the result of future
+template<class T, class Executor>
+class future_awaiter : public event_awaiter<Executor>
+{
+public:
+    future_awaiter(const future<T> &future, Executor &executor)
+        : event_awaiter<Executor>(future.get_event(), executor),
+          m_future(future)
+    {
+    }
+
+    T await_resume()
+    {
+        return m_future.get();
+    }
+
+private:
+    future<T> m_future;
+};
+
+} // end detail namespace
+
+/// Suspends the awaiting coroutine until \p event is complete. The
+/// coroutine is resumed by a thread of the global thread_pool (or by the
+/// thread of the event callback if \c BOOST_COMPUTE_THREAD_SAFE is not
+/// defined, see resume_on() to use another executor). No host thread
+/// waits for the event.
+///
+/// Throws an opencl_error if the command of the event terminated
+/// abnormally.
+///
+/// For example, to wait for a copy in a coroutine:
+/// \code
+/// co_await queue.enqueue_write_buffer_async(buffer, 0, size, data);
+/// \endcode
+///
+/// Only available with a compiler supporting C++20 coroutines.
+///
+/// \opencl_version_warning{1,1}
+///
+/// \see future::then()
+inline detail::event_awaiter<detail::default_executor_type>
+operator co_await(const event &event)
+{
+    return detail::event_awaiter<detail::default_executor_type>(
+        event, detail::default_executor()
+    );
+}
+
+/// Suspends the awaiting coroutine until \p future is complete and
+/// returns its result.
+///
+/// For example, to use the result of an asynchronous reduction:
+/// \code
+/// int sum = co_await boost::compute::reduce_async(...);
+/// \endcode
+///
+/// Only available with a compiler supporting C++20 coroutines.
+///
+/// \opencl_version_warning{1,1}
+template<class T>
+inline detail::future_awaiter<T, detail::default_executor_type>
+operator co_await(const future<T> &future)
+{
+    return detail::future_awaiter<T, detail::default_executor_type>(
+        future, detail::default_executor()
+    );
+}
+
+/// Returns an awaitable for \p event which resumes the awaiting coroutine
+/// with \p executor.
+///
+/// \code
+/// co_await boost::compute::resume_on(my_executor, event);
+/// \endcode
+template<class Executor>
+inline detail::event_awaiter<Executor>
+resume_on(Executor &executor, const event &event)
+{
+    return detail::event_awaiter<Executor>(event, executor);
+}
+
+/// \overload
+template<class Executor, class T>
+inline detail::future_awaiter<T, Executor>
+resume_on(Executor &executor, const future<T> &future)
+{
+    return detail::future_awaiter<T, Executor>(future, executor);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_NO_COROUTINES
+
+#endif // BOOST_COMPUTE_ASYNC_COROUTINE_HPP
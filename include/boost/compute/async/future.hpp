@@ -11,15 +11,141 @@
 #ifndef BOOST_COMPUTE_ASYNC_FUTURE_HPP
 #define BOOST_COMPUTE_ASYNC_FUTURE_HPP
 
+#include <boost/assert.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/utility/result_of.hpp>
+
+#include <boost/compute/cl.hpp>
 #include <boost/compute/event.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/async/thread_pool.hpp>
 
 namespace boost {
 namespace compute {
 
+template<class T> class future;
+
+namespace detail {
+
+// a result value which is still stored on the device, it is read by the
+// future after the computation is complete
+template<class T>
+class future_value
+{
+public:
+    virtual ~future_value()
+    {
+    }
+
+    virtual T read() = 0;
+};
+
+// the result of a continuation (or the exception it threw), set by the
+// thread running it before the event of its future is completed
+template<class T>
+class continuation_value : public future_value<T>
+{
+public:
+    T read()
+    {
+        if(m_error){
+            boost::rethrow_exception(m_error);
+        }
+
+        return m_value;
+    }
+
+    void set_value(const T &value)
+    {
+        m_value = value;
+    }
+
+    void set_exception(const boost::exception_ptr &error)
+    {
+        m_error = error;
+    }
+
+private:
+    T m_value;
+    boost::exception_ptr m_error;
+};
+
+template<>
+class continuation_value<void> : public future_value<void>
+{
+public:
+    void read()
+    {
+        if(m_error){
+            boost::rethrow_exception(m_error);
+        }
+    }
+
+    void set_value()
+    {
+    }
+
+    void set_exception(const boost::exception_ptr &error)
+    {
+        m_error = error;
+    }
+
+private:
+    boost::exception_ptr m_error;
+};
+
+// the future returned by then() for a continuation returning R. futures
+// returned by continuations are unwrapped.
+template<class R>
+struct continuation_future
+{
+    typedef R value_type;
+    typedef future<R> type;
+};
+
+template<class U>
+struct continuation_future<future<U> >
+{
+    typedef U value_type;
+    typedef future<U> type;
+};
+
+template<class Future, class Function>
+struct then_result
+{
+    typedef typename continuation_future<
+        typename boost::result_of<Function(Future)>::type
+    >::type type;
+};
+
+#if defined(CL_VERSION_1_1)
+template<class Future, class Executor, class Function>
+inline typename then_result<Future, Function>::type
+make_continuation(const Future &input, Executor &executor, Function function);
+#endif // CL_VERSION_1_1
+
+} // end detail namespace
+
 /// \class future
 /// \brief Holds the result of an asynchronous computation.
 ///
-/// \see event, wait_list
+/// Instead of blocking in get() until the result is ready, a continuation
+/// can be attached to the future with then(). It is run by an executor
+/// (the global thread_pool by default) once the computation is complete,
+/// without a host thread waiting for it. Futures can also be combined
+/// with when_all() and when_any().
+///
+/// For example, to process the result of a reduction once it is ready:
+/// \code
+/// boost::compute::future<int> sum = boost::compute::reduce_async(...);
+///
+/// boost::compute::future<void> done = sum.then(print_result);
+/// \endcode
+///
+/// \see event, wait_list, thread_pool
 template<class T>
 class future
 {
@@ -35,9 +161,21 @@ public:
     {
     }
 
+    /// \internal_
+    ///
+    /// Creates a future for a result which is read from the device by
+    /// \c get() once \p event is complete.
+    future(const boost::shared_ptr<detail::future_value<T> > &value,
+           const event &event)
+        : m_event(event),
+          m_value(value)
+    {
+    }
+
     future(const future<T> &other)
         : m_result(other.m_result),
-          m_event(other.m_event)
+          m_event(other.m_event),
+          m_value(other.m_value)
     {
     }
 
@@ -46,6 +184,7 @@ public:
         if(this != &other){
             m_result = other.m_result;
             m_event = other.m_event;
+            m_value = other.m_value;
         }
 
         return *this;
@@ -61,6 +200,11 @@ public:
     {
         wait();
 
+        if(m_value){
+            m_result = m_value->read();
+            m_value.reset();
+        }
+
         return m_result;
     }
 
@@ -76,15 +220,58 @@ public:
         const_cast<event &>(m_event).wait();
     }
 
+    /// Blocks until the computation is complete, polling its status as
+    /// described by \p strategy.
+    void wait(const wait_strategy &strategy) const
+    {
+        m_event.wait(strategy);
+    }
+
     /// Returns the underlying event object.
     event get_event() const
     {
         return m_event;
     }
 
+    #if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+    /// Returns a future for the result of \p function, which is invoked
+    /// with this future on a thread of the global thread_pool once the
+    /// computation is complete (or on the thread of the event callback if
+    /// \c BOOST_COMPUTE_THREAD_SAFE is not defined).
+    ///
+    /// If \p function returns a future (e.g. after enqueuing more device
+    /// work) the returned future is for the result of that future. If
+    /// \p function throws, the exception is rethrown by get() on the
+    /// returned future.
+    ///
+    /// The future must be valid().
+    ///
+    /// \opencl_version_warning{1,1}
+    template<class Function>
+    typename detail::then_result<future<T>, Function>::type
+    then(Function function) const
+    {
+        return detail::make_continuation(
+            *this, detail::default_executor(), function
+        );
+    }
+
+    /// \overload
+    ///
+    /// Runs \p function with \p executor, which must stay valid until
+    /// it is run.
+    template<class Executor, class Function>
+    typename detail::then_result<future<T>, Function>::type
+    then(Executor &executor, Function function) const
+    {
+        return detail::make_continuation(*this, executor, function);
+    }
+    #endif // CL_VERSION_1_1
+
 private:
     T m_result;
     event m_event;
+    boost::shared_ptr<detail::future_value<T> > m_value;
 };
 
 /// \internal_
@@ -108,10 +295,19 @@ public:
     {
     }
 
+    /// \internal_
+    future(const boost::shared_ptr<detail::future_value<void> > &value,
+           const event &event)
+        : m_event(event),
+          m_value(value)
+    {
+    }
+
     template<class T>
     future<void> &operator=(const future<T> &other)
     {
         m_event = other.get_event();
+        m_value.reset();
 
         return *this;
     }
@@ -120,6 +316,7 @@ public:
     {
         if(this != &other){
             m_event = other.m_event;
+            m_value = other.m_value;
         }
 
         return *this;
@@ -132,6 +329,10 @@ public:
     void get()
     {
         wait();
+
+        if(m_value){
+            m_value->read();
+        }
     }
 
     bool valid() const
@@ -144,13 +345,37 @@ public:
         const_cast<event &>(m_event).wait();
     }
 
+    void wait(const wait_strategy &strategy) const
+    {
+        m_event.wait(strategy);
+    }
+
     event get_event() const
     {
         return m_event;
     }
 
+    #if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+    template<class Function>
+    typename detail::then_result<future<void>, Function>::type
+    then(Function function) const
+    {
+        return detail::make_continuation(
+            *this, detail::default_executor(), function
+        );
+    }
+
+    template<class Executor, class Function>
+    typename detail::then_result<future<void>, Function>::type
+    then(Executor &executor, Function function) const
+    {
+        return detail::make_continuation(*this, executor, function);
+    }
+    #endif // CL_VERSION_1_1
+
 private:
     event m_event;
+    boost::shared_ptr<detail::future_value<void> > m_value;
 };
 
 /// \internal_
@@ -160,6 +385,172 @@ inline future<Result> make_future(const Result &result, const event &event)
     return future<Result>(result, event);
 }
 
+#if defined(CL_VERSION_1_1)
+namespace detail {
+
+// posts task to executor, invoked by the callback of an event
+template<class Executor, class Task>
+struct post_task
+{
+    post_task(Executor &executor_, const Task &task_)
+        : executor(&executor_),
+          task(task_)
+    {
+    }
+
+    void operator()() const
+    {
+        executor->post(boost::function<void()>(task));
+    }
+
+    Executor *executor;
+    Task task;
+};
+
+// completes the future of a continuation with the result of the future
+// returned by the continuation
+template<class U>
+struct unwrap_task
+{
+    unwrap_task(const future<U> &inner_,
+                const boost::shared_ptr<continuation_value<U> > &value_,
+                const user_event &done_)
+        : inner(inner_),
+          value(value_),
+          done(done_)
+    {
+    }
+
+    void operator()()
+    {
+        try {
+            set_value(static_cast<U *>(0));
+        }
+        catch(...){
+            value->set_exception(boost::current_exception());
+        }
+
+        done.set_status(CL_COMPLETE);
+    }
+
+    template<class V>
+    void set_value(V *)
+    {
+        value->set_value(inner.get());
+    }
+
+    void set_value(void *)
+    {
+        inner.get();
+    }
+
+    future<U> inner;
+    boost::shared_ptr<continuation_value<U> > value;
+    user_event done;
+};
+
+// invokes the function of a continuation and completes its future
+template<class Future, class Executor, class Function>
+struct continuation_task
+{
+    typedef typename boost::result_of<Function(Future)>::type result_type;
+    typedef typename continuation_future<result_type>::value_type value_type;
+
+    continuation_task(const Future &input_,
+                      Executor &executor_,
+                      Function function_,
+                      const boost::shared_ptr<continuation_value<value_type> > &value_,
+                      const user_event &done_)
+        : input(input_),
+          executor(&executor_),
+          function(function_),
+          value(value_),
+          done(done_)
+    {
+    }
+
+    void operator()()
+    {
+        try {
+            if(!invoke(static_cast<result_type *>(0))){
+                // completed by the future returned by the function
+                return;
+            }
+        }
+        catch(...){
+            value->set_exception(boost::current_exception());
+        }
+
+        done.set_status(CL_COMPLETE);
+    }
+
+    // each returns true if the continuation is complete
+    template<class R>
+    bool invoke(R *)
+    {
+        value->set_value(function(input));
+        return true;
+    }
+
+    bool invoke(void *)
+    {
+        function(input);
+        return true;
+    }
+
+    template<class U>
+    bool invoke(future<U> *)
+    {
+        const future<U> inner = function(input);
+        if(!inner.valid()){
+            unwrap_task<U> task(inner, value, done);
+            task();
+            return false;
+        }
+
+        inner.get_event().set_callback(
+            post_task<Executor, unwrap_task<U> >(
+                *executor, unwrap_task<U>(inner, value, done)
+            )
+        );
+        return false;
+    }
+
+    Future input;
+    Executor *executor;
+    Function function;
+    boost::shared_ptr<continuation_value<value_type> > value;
+    user_event done;
+};
+
+template<class Future, class Executor, class Function>
+inline typename then_result<Future, Function>::type
+make_continuation(const Future &input, Executor &executor, Function function)
+{
+    typedef continuation_task<Future, Executor, Function> task_type;
+    typedef typename task_type::value_type value_type;
+
+    BOOST_ASSERT(input.valid());
+
+    const event input_event = input.get_event();
+    const context context(input_event.get_info<cl_context>(CL_EVENT_CONTEXT));
+
+    const user_event done(context);
+    const boost::shared_ptr<continuation_value<value_type> > value =
+        boost::make_shared<continuation_value<value_type> >();
+
+    input_event.set_callback(
+        post_task<Executor, task_type>(
+            executor, task_type(input, executor, function, value, done)
+        )
+    );
+
+    return future<value_type>(value, done);
+}
+
+} // end detail namespace
+#endif // CL_VERSION_1_1
+
 } // end compute namespace
 } // end boost namespace
 
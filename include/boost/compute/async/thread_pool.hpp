@@ -0,0 +1,222 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ASYNC_THREAD_POOL_HPP
+#define BOOST_COMPUTE_ASYNC_THREAD_POOL_HPP
+
+#include <deque>
+#include <vector>
+#include <algorithm>
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/exception_ptr.hpp>
+
+#include <boost/compute/config.hpp>
+#include <boost/compute/detail/mutex.hpp>
+
+namespace boost {
+namespace compute {
+
+#if defined(BOOST_COMPUTE_THREAD_SAFE) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+/// \class thread_pool
+/// \brief Runs tasks on a fixed set of host threads.
+///
+/// The thread_pool is the executor running the continuations of futures
+/// (see future::then()). Event callbacks are invoked on a thread of the
+/// OpenCL implementation which must not be blocked, so continuations are
+/// posted to a thread pool instead of being run by the callback.
+///
+/// Any class with a \c post() function taking a \c boost::function<void()>
+/// can be used as an executor in place of the thread pool.
+///
+/// The thread pool is only available when \c BOOST_COMPUTE_THREAD_SAFE is
+/// defined.
+///
+/// \see future
+class thread_pool : boost::noncopyable
+{
+public:
+    /// Creates a new thread pool with \p threads threads. If \p threads is
+    /// zero, one thread is created per hardware thread.
+    explicit thread_pool(size_t threads = 0)
+        : m_stop(false)
+    {
+        if(threads == 0){
+            threads = (std::max)(size_t(1), size_t(detail::thread::hardware_concurrency()));
+        }
+
+        for(size_t i = 0; i < threads; i++){
+            m_threads.push_back(
+                boost::shared_ptr<detail::thread>(
+                    new detail::thread(boost::bind(&thread_pool::run, this))
+                )
+            );
+        }
+    }
+
+    /// Runs the remaining tasks and destroys the thread pool.
+    ~thread_pool()
+    {
+        {
+            detail::scoped_lock lock(m_mutex);
+            m_stop = true;
+        }
+        m_condition.notify_all();
+
+        for(size_t i = 0; i < m_threads.size(); i++){
+            m_threads[i]->join();
+        }
+    }
+
+    /// Returns the number of threads of the pool.
+    size_t size() const
+    {
+        return m_threads.size();
+    }
+
+    /// Runs \p task on one of the threads of the pool.
+    void post(const boost::function<void()> &task)
+    {
+        {
+            detail::scoped_lock lock(m_mutex);
+            m_tasks.push_back(task);
+        }
+        m_condition.notify_one();
+    }
+
+    /// Returns the global thread pool, which runs the continuations of
+    /// futures when no other executor is given.
+    static thread_pool& default_pool()
+    {
+        static thread_pool pool;
+
+        return pool;
+    }
+
+private:
+    void run()
+    {
+        for(;;){
+            boost::function<void()> task;
+
+            {
+                detail::scoped_lock lock(m_mutex);
+                while(m_tasks.empty() && !m_stop){
+                    m_condition.wait(lock);
+                }
+                if(m_tasks.empty()){
+                    return;
+                }
+
+                task = m_tasks.front();
+                m_tasks.pop_front();
+            }
+
+            task();
+        }
+    }
+
+private:
+    detail::mutex m_mutex;
+    detail::condition_variable m_condition;
+    std::deque<boost::function<void()> > m_tasks;
+    std::vector<boost::shared_ptr<detail::thread> > m_threads;
+    bool m_stop;
+};
+#endif // BOOST_COMPUTE_THREAD_SAFE
+
+namespace detail {
+
+// runs tasks immediately on the calling thread
+struct inline_executor
+{
+    void post(const boost::function<void()> &task)
+    {
+        task();
+    }
+};
+
+#ifdef BOOST_COMPUTE_THREAD_SAFE
+typedef thread_pool default_executor_type;
+
+inline default_executor_type& default_executor()
+{
+    return thread_pool::default_pool();
+}
+#else
+// without thread-safety continuations run on the callback thread
+typedef inline_executor default_executor_type;
+
+inline default_executor_type& default_executor()
+{
+    static inline_executor executor;
+
+    return executor;
+}
+#endif // BOOST_COMPUTE_THREAD_SAFE
+
+// runs task and stores the exception it throws (if any) to error
+inline void invoke_storing_exception(const boost::function<void()> &task,
+                                     boost::exception_ptr *error)
+{
+    try {
+        task();
+    }
+    catch(...){
+        *error = boost::current_exception();
+    }
+}
+
+// runs the independent tasks and waits for them. when thread-safety is
+// enabled they run concurrently on up to threads host threads (one per
+// hardware thread if zero), otherwise one after the other. the first
+// exception thrown by a task is rethrown when they have all completed.
+inline void invoke_concurrently(const std::vector<boost::function<void()> > &tasks,
+                                size_t threads = 0)
+{
+    std::vector<boost::exception_ptr> errors(tasks.size());
+
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+    if(threads == 0){
+        threads = (std::max)(size_t(1), size_t(thread::hardware_concurrency()));
+    }
+
+    if(tasks.size() > 1 && threads > 1){
+        // the pool runs the remaining tasks when destroyed
+        thread_pool pool((std::min)(threads, tasks.size()));
+        for(size_t i = 0; i < tasks.size(); i++){
+            pool.post(boost::bind(&invoke_storing_exception, tasks[i], &errors[i]));
+        }
+    }
+    else
+    #endif // BOOST_COMPUTE_THREAD_SAFE
+    {
+        (void) threads;
+
+        for(size_t i = 0; i < tasks.size(); i++){
+            invoke_storing_exception(tasks[i], &errors[i]);
+        }
+    }
+
+    for(size_t i = 0; i < errors.size(); i++){
+        if(errors[i]){
+            boost::rethrow_exception(errors[i]);
+        }
+    }
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ASYNC_THREAD_POOL_HPP
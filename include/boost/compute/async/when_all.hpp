@@ -0,0 +1,133 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ASYNC_WHEN_ALL_HPP
+#define BOOST_COMPUTE_ASYNC_WHEN_ALL_HPP
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/detail/mutex.hpp>
+
+namespace boost {
+namespace compute {
+
+#if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+namespace detail {
+
+struct when_all_state : boost::noncopyable
+{
+    when_all_state(size_t count, const context &context)
+        : remaining(count),
+          done(context)
+    {
+    }
+
+    mutex lock;
+    size_t remaining;
+    user_event done;
+};
+
+// invoked once each of the futures is complete, the last one completes
+// the future returned by when_all()
+struct when_all_callback
+{
+    when_all_callback(const boost::shared_ptr<when_all_state> &state_)
+        : state(state_)
+    {
+    }
+
+    void operator()() const
+    {
+        bool last = false;
+        {
+            scoped_lock lock(state->lock);
+            last = --state->remaining == 0;
+        }
+
+        if(last){
+            state->done.set_status(CL_COMPLETE);
+        }
+    }
+
+    boost::shared_ptr<when_all_state> state;
+};
+
+} // end detail namespace
+
+/// Returns a future which is complete once each of the futures in the
+/// range [\p first, \p last) is complete. No host thread waits for the
+/// futures: the returned future is completed by the callbacks of their
+/// events.
+///
+/// The results of the futures are then read with their own get()
+/// functions. A continuation can be attached to the returned future with
+/// future::then().
+///
+/// For example, to run a continuation once two copies are complete:
+/// \code
+/// std::vector<boost::compute::future<void> > copies;
+/// copies.push_back(boost::compute::copy_async(...));
+/// copies.push_back(boost::compute::copy_async(...));
+///
+/// boost::compute::when_all(copies.begin(), copies.end()).then(on_copied);
+/// \endcode
+///
+/// \opencl_version_warning{1,1}
+///
+/// \see when_any(), wait_for_all()
+template<class InputIterator>
+inline future<void> when_all(InputIterator first, InputIterator last)
+{
+    if(first == last){
+        user_event done(system::default_context());
+        done.set_status(CL_COMPLETE);
+        return future<void>(done);
+    }
+
+    const context context(
+        first->get_event().template get_info<cl_context>(CL_EVENT_CONTEXT)
+    );
+
+    // one extra count released below, so that the futures completing
+    // while the callbacks are registered cannot complete the result
+    size_t count = 1;
+    for(InputIterator i = first; i != last; ++i){
+        count++;
+    }
+
+    boost::shared_ptr<detail::when_all_state> state(
+        new detail::when_all_state(count, context)
+    );
+    const detail::when_all_callback callback(state);
+
+    for(InputIterator i = first; i != last; ++i){
+        if(i->valid()){
+            i->get_event().set_callback(callback);
+        }
+        else {
+            callback();
+        }
+    }
+    callback();
+
+    return future<void>(state->done);
+}
+#endif // CL_VERSION_1_1
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ASYNC_WHEN_ALL_HPP
@@ -0,0 +1,117 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ASYNC_WHEN_ANY_HPP
+#define BOOST_COMPUTE_ASYNC_WHEN_ANY_HPP
+
+#include <boost/assert.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/detail/mutex.hpp>
+
+namespace boost {
+namespace compute {
+
+#if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+namespace detail {
+
+struct when_any_state : boost::noncopyable
+{
+    explicit when_any_state(const context &context)
+        : complete(false),
+          value(boost::make_shared<continuation_value<size_t> >()),
+          done(context)
+    {
+    }
+
+    mutex lock;
+    bool complete;
+    boost::shared_ptr<continuation_value<size_t> > value;
+    user_event done;
+};
+
+// invoked once the future with index is complete, the first one
+// completes the future returned by when_any()
+struct when_any_callback
+{
+    when_any_callback(const boost::shared_ptr<when_any_state> &state_,
+                      size_t index_)
+        : state(state_),
+          index(index_)
+    {
+    }
+
+    void operator()() const
+    {
+        {
+            scoped_lock lock(state->lock);
+            if(state->complete){
+                return;
+            }
+            state->complete = true;
+            state->value->set_value(index);
+        }
+
+        state->done.set_status(CL_COMPLETE);
+    }
+
+    boost::shared_ptr<when_any_state> state;
+    size_t index;
+};
+
+} // end detail namespace
+
+/// Returns a future for the index (in the range [\p first, \p last)) of
+/// the first of the futures to complete. No host thread waits for the
+/// futures: the returned future is completed by the callbacks of their
+/// events.
+///
+/// The range must not be empty.
+///
+/// \opencl_version_warning{1,1}
+///
+/// \see when_all()
+template<class InputIterator>
+inline future<size_t> when_any(InputIterator first, InputIterator last)
+{
+    BOOST_ASSERT(first != last);
+
+    const context context(
+        first->get_event().template get_info<cl_context>(CL_EVENT_CONTEXT)
+    );
+
+    boost::shared_ptr<detail::when_any_state> state(
+        new detail::when_any_state(context)
+    );
+
+    size_t index = 0;
+    for(InputIterator i = first; i != last; ++i, ++index){
+        if(i->valid()){
+            i->get_event().set_callback(detail::when_any_callback(state, index));
+        }
+        else {
+            detail::when_any_callback(state, index)();
+        }
+    }
+
+    return future<size_t>(state->value, state->done);
+}
+#endif // CL_VERSION_1_1
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ASYNC_WHEN_ANY_HPP
@@ -286,13 +286,22 @@ make_closure_impl(const char *name,
                   const char *arguments,
                   const CaptureTuple &capture,
                   const char *capture_string,
-                  const std::string &source)
+                  const char *source)
 {
+    typedef macro_source_cache<closure<Signature, CaptureTuple> > cache_type;
+
+    const typename cache_type::key_type key(name, arguments, capture_string, source);
+    if(const std::string *cached = cache_type::find(key)){
+        return closure<Signature, CaptureTuple>(name, capture, *cached);
+    }
+
     std::stringstream s;
     s << make_closure_declaration<Signature>(name, arguments, capture, capture_string);
     s << source;
 
-    return closure<Signature, CaptureTuple>(name, capture, s.str());
+    return closure<Signature, CaptureTuple>(
+        name, capture, cache_type::insert(key, s.str())
+    );
 }
 
 } // end detail namespace
@@ -329,6 +338,15 @@ make_closure_impl(const char *name,
 /// );
 /// \endcode
 ///
+/// Captured scalar and vector values (e.g. \c float or \c float4_) are
+/// passed to the kernel as arguments and captured containers (e.g.
+/// vector<T>) as buffer arguments, so the generated source does not depend
+/// on the values of the captured variables. The compiled program of an
+/// algorithm using the closure is found by the closure's name, arguments,
+/// capture list and source alone. Changing a captured value between calls
+/// (e.g. a threshold updated in a loop) reuses the program, while changing
+/// the type of a captured variable builds a new one.
+///
 /// \see BOOST_COMPUTE_FUNCTION()
 #ifdef BOOST_COMPUTE_DOXYGEN_INVOKED
 #define BOOST_COMPUTE_CLOSURE(return_type, name, arguments, capture, source)
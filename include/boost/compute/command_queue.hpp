@@ -12,12 +12,14 @@
 #define BOOST_COMPUTE_COMMAND_QUEUE_HPP
 
 #include <cstddef>
+#include <utility>
 #include <algorithm>
 
 #include <boost/config.hpp>
 #include <boost/assert.hpp>
 
 #include <boost/compute/config.hpp>
+#include <boost/compute/cl_ext.hpp>
 #include <boost/compute/event.hpp>
 #include <boost/compute/user_event.hpp>
 #include <boost/compute/buffer.hpp>
@@ -29,13 +31,20 @@
 #include <boost/compute/image/image2d.hpp>
 #include <boost/compute/image/image3d.hpp>
 #include <boost/compute/image/image_object.hpp>
+#include <boost/compute/utility/trace.hpp>
+#include <boost/compute/utility/transfer_counters.hpp>
 #include <boost/compute/utility/wait_list.hpp>
+#include <boost/compute/wait_strategy.hpp>
+#include <boost/compute/detail/command_recording.hpp>
 #include <boost/compute/detail/get_object_info.hpp>
 #include <boost/compute/detail/assert_cl_success.hpp>
 #include <boost/compute/utility/extents.hpp>
 
 namespace boost {
 namespace compute {
+
+class command_sequence;
+
 namespace detail {
 
 inline void BOOST_COMPUTE_CL_CALLBACK
@@ -46,6 +55,13 @@ nullary_native_kernel_trampoline(void *user_func_ptr)
     user_func();
 }
 
+// returns the number of bytes in region of image
+inline size_t image_region_size(const image_object &image, const size_t *region)
+{
+    return image.get_image_info<size_t>(CL_IMAGE_ELEMENT_SIZE) *
+           region[0] * region[1] * region[2];
+}
+
 } // end detail namespace
 
 /// \class command_queue
@@ -84,6 +100,24 @@ public:
         enable_out_of_order_execution = CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE
     };
 
+    /// Priority hints of the \c cl_khr_priority_hints extension (see
+    /// the command_queue constructor taking hints).
+    enum priority_hint {
+        priority_default,
+        priority_high,
+        priority_medium,
+        priority_low
+    };
+
+    /// Throttle hints of the \c cl_khr_throttle_hints extension (see
+    /// the command_queue constructor taking hints).
+    enum throttle_hint {
+        throttle_default,
+        throttle_high,
+        throttle_medium,
+        throttle_low
+    };
+
     enum map_flags {
         map_read = CL_MAP_READ,
         map_write = CL_MAP_WRITE
@@ -102,8 +136,13 @@ public:
     explicit command_queue(cl_command_queue queue, bool retain = true)
         : m_queue(queue), m_version(0)
     {
-        if(m_queue && retain){
-            clRetainCommandQueue(m_queue);
+        if(m_queue){
+            if(retain){
+                clRetainCommandQueue(m_queue);
+            }
+
+            m_device = device(get_info<cl_device_id>(CL_QUEUE_DEVICE));
+            m_context = context(get_info<cl_context>(CL_QUEUE_CONTEXT));
         }
     }
 
@@ -114,45 +153,50 @@ public:
     command_queue(const context &context,
                   const device &device,
                   cl_command_queue_properties properties = 0)
+        : m_device(device),
+          m_context(context)
     {
-        BOOST_ASSERT(device.id() != 0);
-
-        cl_int error = 0;
-        m_version = device.get_version();
-
-        #ifdef CL_VERSION_2_0
-        if (get_version() >= 200)
-        {
-            std::vector<cl_queue_properties> queue_properties;
-            if(properties){
-                queue_properties.push_back(CL_QUEUE_PROPERTIES);
-                queue_properties.push_back(cl_queue_properties(properties));
-                queue_properties.push_back(cl_queue_properties(0));
-            }
-
-            const cl_queue_properties *queue_properties_ptr =
-                queue_properties.empty() ? 0 : &queue_properties[0];
-
-            m_queue = clCreateCommandQueueWithProperties(
-                context, device.id(), queue_properties_ptr, &error
-            );
-        }
-        else
-        #endif
-        {
-            m_queue = clCreateCommandQueue(
-                context, device.id(), properties, &error
-            );
-        }
+        create(properties, priority_default, throttle_default);
+    }
 
-        if(!m_queue){
-            BOOST_THROW_EXCEPTION(opencl_error(error));
-        }
+    /// Creates a command queue in \p context for \p device with
+    /// \p properties and the \p priority and \p throttle hints.
+    ///
+    /// The hints are passed to \c clCreateCommandQueueWithProperties() as
+    /// the \c CL_QUEUE_PRIORITY_KHR and \c CL_QUEUE_THROTTLE_KHR
+    /// properties. As they are only hints they are ignored (and a queue
+    /// without them is created) if the device does not support the
+    /// \c cl_khr_priority_hints or \c cl_khr_throttle_hints extension or
+    /// OpenCL 2.0. For example, to give latency-critical kernels a
+    /// high-priority queue next to the queue of the batch work:
+    /// \code
+    /// boost::compute::command_queue latency_queue(
+    ///     context, device, 0, boost::compute::command_queue::priority_high
+    /// );
+    /// boost::compute::command_queue batch_queue(
+    ///     context, device, 0, boost::compute::command_queue::priority_low,
+    ///     boost::compute::command_queue::throttle_low
+    /// );
+    /// \endcode
+    ///
+    /// \see_opencl2_ref{clCreateCommandQueueWithProperties}
+    command_queue(const context &context,
+                  const device &device,
+                  cl_command_queue_properties properties,
+                  priority_hint priority,
+                  throttle_hint throttle = throttle_default)
+        : m_device(device),
+          m_context(context)
+    {
+        create(properties, priority, throttle);
     }
 
     /// Creates a new command queue object as a copy of \p other.
     command_queue(const command_queue &other)
-        : m_queue(other.m_queue), m_version(other.m_version)
+        : m_queue(other.m_queue),
+          m_version(other.m_version),
+          m_device(other.m_device),
+          m_context(other.m_context)
     {
         if(m_queue){
             clRetainCommandQueue(m_queue);
@@ -169,6 +213,8 @@ public:
 
             m_queue = other.m_queue;
             m_version = other.m_version;
+            m_device = other.m_device;
+            m_context = other.m_context;
 
             if(m_queue){
                 clRetainCommandQueue(m_queue);
@@ -181,7 +227,10 @@ public:
     #ifndef BOOST_COMPUTE_NO_RVALUE_REFERENCES
     /// Move-constructs a new command queue object from \p other.
     command_queue(command_queue&& other) BOOST_NOEXCEPT
-        : m_queue(other.m_queue), m_version(other.m_version)
+        : m_queue(other.m_queue),
+          m_version(other.m_version),
+          m_device(std::move(other.m_device)),
+          m_context(std::move(other.m_context))
     {
         other.m_queue = 0;
         other.m_version = 0;
@@ -196,6 +245,8 @@ public:
 
         m_queue = other.m_queue;
         m_version = other.m_version;
+        m_device = std::move(other.m_device);
+        m_context = std::move(other.m_context);
         other.m_queue = 0;
 
         return *this;
@@ -221,22 +272,25 @@ public:
     }
 
     /// Returns the device that the command queue issues commands to.
-    device get_device() const
+    ///
+    /// The device and the context of the command queue are stored when the
+    /// command queue object is created, so this does not query OpenCL.
+    const device& get_device() const
     {
-        return device(get_info<cl_device_id>(CL_QUEUE_DEVICE));
+        return m_device;
     }
 
     /// Returns the context for the command queue.
-    context get_context() const
+    const context& get_context() const
     {
-        return context(get_info<cl_context>(CL_QUEUE_CONTEXT));
+        return m_context;
     }
 
     /// Returns the numeric version: major * 100 + minor.
     uint_ get_version() const
     {
         if (m_version == 0)
-            m_version = get_device().get_version(); // The version of the first device
+            m_version = m_device.get_version(); // The version of the first device
         return m_version;
     }
 
@@ -277,10 +331,21 @@ public:
         BOOST_ASSERT(buffer.get_context() == this->get_context());
         BOOST_ASSERT(host_ptr != 0);
 
+        // blocking commands wait with the default strategy when it polls
+        event wait_event;
+        const bool poll = !event_ && !wait_strategy::get_default().is_blocking();
+        if(poll){
+            event_ = &wait_event;
+        }
+
+        const cl_bool blocking = event_ ? CL_FALSE : CL_TRUE;
+        BOOST_COMPUTE_DETAIL_TRACE_EVENT(event_)
+        BOOST_COMPUTE_DETAIL_TRANSFER_EVENT(m_queue, event_)
+
         cl_int ret = clEnqueueReadBuffer(
             m_queue,
             buffer.get(),
-            event_ ? CL_FALSE : CL_TRUE,
+            blocking,
             offset,
             size,
             host_ptr,
@@ -292,6 +357,23 @@ public:
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
+
+        BOOST_COMPUTE_DETAIL_TRACE_COMMAND(
+            m_queue, CL_COMMAND_READ_BUFFER, std::string(), size, event_
+        )
+        BOOST_COMPUTE_DETAIL_COUNT_TRANSFER(
+            m_queue, device_to_host_transfer, size, event_
+        )
+
+        // blocking reads return values to the host once, they are not
+        // recorded (see begin_recording())
+        if(!poll && !blocking && detail::is_recording_commands(m_queue)){
+            detail::record_read_buffer(m_queue, buffer, offset, size, host_ptr);
+        }
+
+        if(poll){
+            wait_event.wait();
+        }
     }
 
     /// Enqueues a command to read data from \p buffer to host memory. The
@@ -344,10 +426,13 @@ public:
         if (get_version() < 110)
             BOOST_THROW_EXCEPTION(opencl_error(CL_INVALID_DEVICE));
 
+        const cl_bool blocking = event_ ? CL_FALSE : CL_TRUE;
+        BOOST_COMPUTE_DETAIL_TRANSFER_EVENT(m_queue, event_)
+
         cl_int ret = clEnqueueReadBufferRect(
             m_queue,
             buffer.get(),
-            event_ ? CL_FALSE : CL_TRUE,
+            blocking,
             buffer_origin,
             host_origin,
             region,
@@ -364,6 +449,10 @@ public:
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
+
+        BOOST_COMPUTE_DETAIL_COUNT_TRANSFER(
+            m_queue, device_to_host_transfer, region[0] * region[1] * region[2], event_
+        )
     }
     #endif // CL_VERSION_1_1
 
@@ -384,10 +473,21 @@ public:
         BOOST_ASSERT(buffer.get_context() == this->get_context());
         BOOST_ASSERT(host_ptr != 0);
 
+        // blocking commands wait with the default strategy when it polls
+        event wait_event;
+        const bool poll = !event_ && !wait_strategy::get_default().is_blocking();
+        if(poll){
+            event_ = &wait_event;
+        }
+
+        const cl_bool blocking = event_ ? CL_FALSE : CL_TRUE;
+        BOOST_COMPUTE_DETAIL_TRACE_EVENT(event_)
+        BOOST_COMPUTE_DETAIL_TRANSFER_EVENT(m_queue, event_)
+
         cl_int ret = clEnqueueWriteBuffer(
             m_queue,
             buffer.get(),
-            event_ ? CL_FALSE : CL_TRUE,
+            blocking,
             offset,
             size,
             host_ptr,
@@ -399,6 +499,23 @@ public:
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
+
+        BOOST_COMPUTE_DETAIL_TRACE_COMMAND(
+            m_queue, CL_COMMAND_WRITE_BUFFER, std::string(), size, event_
+        )
+        BOOST_COMPUTE_DETAIL_COUNT_TRANSFER(
+            m_queue, host_to_device_transfer, size, event_
+        )
+
+        if(detail::is_recording_commands(m_queue)){
+            detail::record_write_buffer(
+                m_queue, buffer, offset, size, host_ptr, poll || blocking
+            );
+        }
+
+        if(poll){
+            wait_event.wait();
+        }
     }
 
     /// Enqueues a command to write data from host memory to \p buffer.
@@ -451,10 +568,13 @@ public:
         if (get_version() < 110)
             BOOST_THROW_EXCEPTION(opencl_error(CL_INVALID_DEVICE));
 
+        const cl_bool blocking = event_ ? CL_FALSE : CL_TRUE;
+        BOOST_COMPUTE_DETAIL_TRANSFER_EVENT(m_queue, event_)
+
         cl_int ret = clEnqueueWriteBufferRect(
             m_queue,
             buffer.get(),
-            event_ ? CL_FALSE : CL_TRUE,
+            blocking,
             buffer_origin,
             host_origin,
             region,
@@ -471,6 +591,10 @@ public:
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
+
+        BOOST_COMPUTE_DETAIL_COUNT_TRANSFER(
+            m_queue, host_to_device_transfer, region[0] * region[1] * region[2], event_
+        )
     }
     #endif // CL_VERSION_1_1
 
@@ -494,6 +618,9 @@ public:
         BOOST_ASSERT(src_buffer.get_context() == this->get_context());
         BOOST_ASSERT(dst_buffer.get_context() == this->get_context());
 
+        BOOST_COMPUTE_DETAIL_TRACE_EVENT(event_)
+        BOOST_COMPUTE_DETAIL_TRANSFER_EVENT(m_queue, event_)
+
         cl_int ret = clEnqueueCopyBuffer(
             m_queue,
             src_buffer.get(),
@@ -509,6 +636,19 @@ public:
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
+
+        BOOST_COMPUTE_DETAIL_TRACE_COMMAND(
+            m_queue, CL_COMMAND_COPY_BUFFER, std::string(), size, event_
+        )
+        BOOST_COMPUTE_DETAIL_COUNT_TRANSFER(
+            m_queue, device_to_device_transfer, size, event_
+        )
+
+        if(detail::is_recording_commands(m_queue)){
+            detail::record_copy_buffer(
+                m_queue, src_buffer, dst_buffer, src_offset, dst_offset, size
+            );
+        }
     }
 
 	event enqueue_copy_buffer_async(const buffer &src_buffer,
@@ -557,6 +697,8 @@ public:
         if (get_version() < 110)
             BOOST_THROW_EXCEPTION(opencl_error(CL_INVALID_DEVICE));
 
+        BOOST_COMPUTE_DETAIL_TRANSFER_EVENT(m_queue, event_)
+
         cl_int ret = clEnqueueCopyBufferRect(
             m_queue,
             src_buffer.get(),
@@ -576,6 +718,10 @@ public:
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
+
+        BOOST_COMPUTE_DETAIL_COUNT_TRANSFER(
+            m_queue, device_to_device_transfer, region[0] * region[1] * region[2], event_
+        )
     }
     #endif // CL_VERSION_1_1
 
@@ -602,6 +748,8 @@ public:
         if (get_version() < 120)
             BOOST_THROW_EXCEPTION(opencl_error(CL_INVALID_DEVICE));
 
+        BOOST_COMPUTE_DETAIL_TRACE_EVENT(event_)
+
         cl_int ret = clEnqueueFillBuffer(
             m_queue,
             buffer.get(),
@@ -617,6 +765,16 @@ public:
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
+
+        BOOST_COMPUTE_DETAIL_TRACE_COMMAND(
+            m_queue, CL_COMMAND_FILL_BUFFER, std::string(), size, event_
+        )
+
+        if(detail::is_recording_commands(m_queue)){
+            detail::record_fill_buffer(
+                m_queue, buffer, pattern, pattern_size, offset, size
+            );
+        }
     }
 
 	event enqueue_fill_buffer_async(const buffer &buffer,
@@ -654,11 +812,14 @@ public:
         BOOST_ASSERT(offset + size <= buffer_.size());
         BOOST_ASSERT(buffer_.get_context() == this->get_context());
 
+        const cl_bool blocking = event_ ? CL_FALSE : CL_TRUE;
+        BOOST_COMPUTE_DETAIL_TRANSFER_EVENT(m_queue, event_)
+
         cl_int ret = 0;
         void *pointer = clEnqueueMapBuffer(
             m_queue,
             buffer_.get(),
-            event_ ? CL_FALSE : CL_TRUE,
+            blocking,
             flags,
             offset,
             size,
@@ -672,9 +833,37 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        if(flags & CL_MAP_READ){
+            BOOST_COMPUTE_DETAIL_COUNT_TRANSFER(
+                m_queue, device_to_host_transfer, size, event_
+            )
+        }
+        if(flags & CL_MAP_WRITE){
+            BOOST_COMPUTE_DETAIL_COUNT_TRANSFER(
+                m_queue, host_to_device_transfer, size, event_
+            )
+        }
+
         return pointer;
     }
 
+    /// Enqueues a command to map \p buffer into the host address space.
+    /// The map will be performed asynchronously, the returned pointer may
+    /// only be accessed after \p map_buffer_event completed.
+    ///
+    /// \see_opencl_ref{clEnqueueMapBuffer}
+    void* enqueue_map_buffer_async(const buffer &buffer_,
+                                   cl_map_flags flags,
+                                   size_t offset,
+                                   size_t size,
+                                   event &map_buffer_event,
+                                   const wait_list &events = wait_list())
+    {
+        return enqueue_map_buffer(
+            buffer_, flags, offset, size, events, &map_buffer_event
+        );
+    }
+
     /// Enqueues a command to map \p image into the host address space.
     ///
     /// \see_opencl_ref{clEnqueueMapImage}
@@ -752,6 +941,21 @@ public:
         enqueue_unmap_mem_object(mem_object.get(), mapped_ptr, events, event_);
     }
 
+    /// Enqueues a command to unmap \p buffer from the host memory space
+    /// and returns an event which completes once it is unmapped.
+    ///
+    /// \see_opencl_ref{clEnqueueUnmapMemObject}
+    event enqueue_unmap_buffer_async(const memory_object &mem_object,
+                                     void *mapped_ptr,
+                                     const wait_list &events = wait_list())
+    {
+        event event_;
+
+        enqueue_unmap_buffer(mem_object, mapped_ptr, events, &event_);
+
+        return event_;
+    }
+
     /// Enqueues a command to unmap \p mem from the host memory space.
     ///
     /// \see_opencl_ref{clEnqueueUnmapMemObject}
@@ -790,10 +994,13 @@ public:
     {
         BOOST_ASSERT(m_queue != 0);
 
+        const cl_bool blocking = event_ ? CL_FALSE : CL_TRUE;
+        BOOST_COMPUTE_DETAIL_TRANSFER_EVENT(m_queue, event_)
+
         cl_int ret = clEnqueueReadImage(
             m_queue,
             image.get(),
-            event_ ? CL_FALSE : CL_TRUE,
+            blocking,
             origin,
             region,
             row_pitch,
@@ -807,6 +1014,10 @@ public:
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
+
+        BOOST_COMPUTE_DETAIL_COUNT_TRANSFER(
+            m_queue, device_to_host_transfer, detail::image_region_size(image, region), event_
+        )
     }
 
     /// \overload
@@ -848,10 +1059,13 @@ public:
     {
         BOOST_ASSERT(m_queue != 0);
 
+        const cl_bool blocking = event_ ? CL_FALSE : CL_TRUE;
+        BOOST_COMPUTE_DETAIL_TRANSFER_EVENT(m_queue, event_)
+
         cl_int ret = clEnqueueWriteImage(
             m_queue,
             image.get(),
-            event_ ? CL_FALSE : CL_TRUE,
+            blocking,
             origin,
             region,
             input_row_pitch,
@@ -865,6 +1079,10 @@ public:
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
+
+        BOOST_COMPUTE_DETAIL_COUNT_TRANSFER(
+            m_queue, host_to_device_transfer, detail::image_region_size(image, region), event_
+        )
     }
 
     /// \overload
@@ -905,6 +1123,8 @@ public:
     {
         BOOST_ASSERT(m_queue != 0);
 
+        BOOST_COMPUTE_DETAIL_TRANSFER_EVENT(m_queue, event_)
+
         cl_int ret = clEnqueueCopyImage(
             m_queue,
             src_image.get(),
@@ -920,6 +1140,10 @@ public:
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
+
+        BOOST_COMPUTE_DETAIL_COUNT_TRANSFER(
+            m_queue, device_to_device_transfer, detail::image_region_size(src_image, region), event_
+        )
     }
 
     /// \overload
@@ -964,6 +1188,8 @@ public:
     {
         BOOST_ASSERT(m_queue != 0);
 
+        BOOST_COMPUTE_DETAIL_TRANSFER_EVENT(m_queue, event_)
+
         cl_int ret = clEnqueueCopyImageToBuffer(
             m_queue,
             src_image.get(),
@@ -979,6 +1205,10 @@ public:
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
+
+        BOOST_COMPUTE_DETAIL_COUNT_TRANSFER(
+            m_queue, device_to_device_transfer, detail::image_region_size(src_image, region), event_
+        )
     }
 
     /// Enqueues a command to copy data from \p src_buffer to \p dst_image.
@@ -994,6 +1224,8 @@ public:
     {
         BOOST_ASSERT(m_queue != 0);
 
+        BOOST_COMPUTE_DETAIL_TRANSFER_EVENT(m_queue, event_)
+
         cl_int ret = clEnqueueCopyBufferToImage(
             m_queue,
             src_buffer.get(),
@@ -1009,6 +1241,10 @@ public:
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
+
+        BOOST_COMPUTE_DETAIL_COUNT_TRANSFER(
+            m_queue, device_to_device_transfer, detail::image_region_size(dst_image, region), event_
+        )
     }
 
 
@@ -1048,11 +1284,11 @@ public:
         {
             // Walks all the image elements
             char * pImage2D = m_pImage3D;
-            for(size_t d = m_origin3[2]; d < m_region3[2]; ++d) {
+            for(size_t d = m_origin3[2]; d < m_origin3[2] + m_region3[2]; ++d) {
                  char * pImage1D = pImage2D;
-                for(size_t h = m_origin3[1]; h < m_region3[1]; ++h) {
+                for(size_t h = m_origin3[1]; h < m_origin3[1] + m_region3[1]; ++h) {
                     char *pElem = pImage1D;
-                    for(size_t w = m_origin3[0]; w < m_region3[0]; ++w) {
+                    for(size_t w = m_origin3[0]; w < m_origin3[0] + m_region3[0]; ++w) {
                         m_walk_elemets((void *)pElem, w, h, d);
                         pElem += m_element_size;
                     }
@@ -1070,6 +1306,10 @@ public:
     /// The function specified by \p walk_elemets must be invokable with arguments
     /// (void *pElem, size_t x, size_t y, size_t z),
     /// like std::function<void(void *, size_t, size_t, size_t)>.
+    ///
+    /// The image is mapped and \p walk_elemets is called on the host for each
+    /// element, see walk_image() in \c <boost/compute/image/walk_image.hpp>
+    /// for writing the elements with a kernel on the device instead.
     template<class Function>
     void enqueue_walk_image(const image_object& image,
                             Function walk_elemets,
@@ -1129,11 +1369,11 @@ public:
         {
             // Walks all the image elements
             char * pImage2D = pImage3D;
-            for(size_t d = origin3[2]; d < region3[2]; ++d) {
+            for(size_t d = origin3[2]; d < origin3[2] + region3[2]; ++d) {
                  char * pImage1D = pImage2D;
-                for(size_t h = origin3[1]; h < region3[1]; ++h) {
+                for(size_t h = origin3[1]; h < origin3[1] + region3[1]; ++h) {
                     char *pElem = pImage1D;
-                    for(size_t w = origin3[0]; w < region3[0]; ++w) {
+                    for(size_t w = origin3[0]; w < origin3[0] + region3[0]; ++w) {
                         walk_elemets((void *)pElem, w, h, d);
                         pElem += element_size;
                     }
@@ -1327,6 +1567,8 @@ public:
         BOOST_ASSERT(work_dim > 0);
         BOOST_ASSERT(kernel.get_context() == this->get_context());
 
+        BOOST_COMPUTE_DETAIL_TRACE_EVENT(event_)
+
         cl_int ret = clEnqueueNDRangeKernel(
             m_queue,
             kernel,
@@ -1342,6 +1584,21 @@ public:
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
+
+        BOOST_COMPUTE_DETAIL_TRACE_COMMAND(
+            m_queue, CL_COMMAND_NDRANGE_KERNEL, kernel.name(), 0, event_
+        )
+
+        if(detail::is_recording_commands(m_queue)){
+            detail::record_nd_range_kernel(
+                m_queue,
+                kernel,
+                work_dim,
+                global_work_offset,
+                global_work_size,
+                local_work_size
+            );
+        }
     }
 
     /// \overload
@@ -1404,7 +1661,7 @@ public:
             global_work_size.data(),
             (local_work_size[0] == 0) ? NULL : local_work_size.data(),
             events,
-            &event_.get()
+            &event_
         );
 
         return event_;
@@ -1481,6 +1738,11 @@ public:
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
+
+        if(detail::is_recording_commands(m_queue)){
+            const size_t one = 1;
+            detail::record_nd_range_kernel(m_queue, kernel, 1, 0, &one, &one);
+        }
     }
 
     /// Enqueues a function to execute on the host.
@@ -1542,12 +1804,94 @@ public:
 
     /// Blocks until all outstanding commands in the queue have finished.
     ///
+    /// The default wait_strategy is used (which blocks in \c clFinish()
+    /// unless a spin time is set).
+    ///
     /// \see_opencl_ref{clFinish}
     void finish()
+    {
+        finish(wait_strategy::get_default());
+    }
+
+    /// Blocks until all outstanding commands in the queue have finished,
+    /// polling the status of a marker enqueued after them as described by
+    /// \p strategy.
+    void finish(const wait_strategy &strategy)
+    {
+        BOOST_ASSERT(m_queue != 0);
+
+        if(strategy.is_blocking()){
+            clFinish(m_queue);
+        }
+        else {
+            event marker;
+            enqueue_marker(&marker);
+            marker.wait(strategy);
+        }
+    }
+
+    /// Starts recording the commands enqueued to the queue.
+    ///
+    /// The commands are executed as usual and are also recorded (including
+    /// those enqueued by the algorithms) until end_recording() is called.
+    /// The returned command_sequence can then be replayed with little host
+    /// work.
+    ///
+    /// A queue can only record one sequence at a time.
+    ///
+    /// \see command_sequence
+    void begin_recording()
+    {
+        BOOST_ASSERT(m_queue != 0);
+
+        detail::command_recording_registry::get().begin(m_queue);
+    }
+
+    /// Stops recording and returns the commands enqueued since
+    /// begin_recording().
+    ///
+    /// Defined in <boost/compute/command_sequence.hpp>.
+    command_sequence end_recording();
+
+    /// Returns \c true if the queue is recording its commands.
+    bool is_recording() const
+    {
+        return detail::is_recording_commands(m_queue);
+    }
+
+    /// Starts counting the bytes and commands of the transfers enqueued to
+    /// the queue (including those of the algorithms). If \p measure_time
+    /// is \c true and the queue has profiling enabled, the execution times
+    /// of the transfers are also added up.
+    ///
+    /// The counters are shared by all copies of the queue object and
+    /// should be disabled before the queue is released.
+    ///
+    /// \see transfer_counters
+    void enable_transfer_counters(bool measure_time = false)
     {
         BOOST_ASSERT(m_queue != 0);
 
-        clFinish(m_queue);
+        detail::transfer_counter_registry::get().enable(m_queue, measure_time);
+    }
+
+    /// Stops counting the transfers and discards the counters.
+    void disable_transfer_counters()
+    {
+        detail::transfer_counter_registry::get().disable(m_queue);
+    }
+
+    /// Returns the transfer counters of the queue, all of the counters are
+    /// zero if they are not enabled.
+    transfer_counters get_transfer_counters() const
+    {
+        return detail::transfer_counter_registry::get().counters(m_queue);
+    }
+
+    /// Sets the transfer counters of the queue to zero.
+    void reset_transfer_counters()
+    {
+        detail::transfer_counter_registry::get().reset(m_queue);
     }
 
     /// Enqueues a barrier in the queue.
@@ -1819,8 +2163,100 @@ public:
     }
 
 private:
+    /// \internal_
+    void create(cl_command_queue_properties properties,
+                priority_hint priority,
+                throttle_hint throttle)
+    {
+        BOOST_ASSERT(m_device.id() != 0);
+
+        cl_int error = 0;
+        m_version = m_device.get_version();
+
+        #ifdef CL_VERSION_2_0
+        if (get_version() >= 200)
+        {
+            std::vector<cl_queue_properties> queue_properties;
+            if(properties){
+                queue_properties.push_back(CL_QUEUE_PROPERTIES);
+                queue_properties.push_back(cl_queue_properties(properties));
+            }
+            append_hint_properties(queue_properties, priority, throttle);
+            if(!queue_properties.empty()){
+                queue_properties.push_back(cl_queue_properties(0));
+            }
+
+            const cl_queue_properties *queue_properties_ptr =
+                queue_properties.empty() ? 0 : &queue_properties[0];
+
+            m_queue = clCreateCommandQueueWithProperties(
+                m_context, m_device.id(), queue_properties_ptr, &error
+            );
+        }
+        else
+        #endif
+        {
+            (void) priority;
+            (void) throttle;
+
+            m_queue = clCreateCommandQueue(
+                m_context, m_device.id(), properties, &error
+            );
+        }
+
+        if(!m_queue){
+            BOOST_THROW_EXCEPTION(opencl_error(error));
+        }
+    }
+
+    #ifdef CL_VERSION_2_0
+    /// \internal_
+    void append_hint_properties(std::vector<cl_queue_properties> &queue_properties,
+                                priority_hint priority,
+                                throttle_hint throttle) const
+    {
+        #ifdef cl_khr_priority_hints
+        if(priority != priority_default &&
+           m_device.supports_extension("cl_khr_priority_hints")){
+            static const cl_queue_properties priorities[] = {
+                0,
+                CL_QUEUE_PRIORITY_HIGH_KHR,
+                CL_QUEUE_PRIORITY_MED_KHR,
+                CL_QUEUE_PRIORITY_LOW_KHR
+            };
+
+            queue_properties.push_back(CL_QUEUE_PRIORITY_KHR);
+            queue_properties.push_back(priorities[priority]);
+        }
+        #else
+        (void) priority;
+        #endif
+
+        #ifdef cl_khr_throttle_hints
+        if(throttle != throttle_default &&
+           m_device.supports_extension("cl_khr_throttle_hints")){
+            static const cl_queue_properties throttles[] = {
+                0,
+                CL_QUEUE_THROTTLE_HIGH_KHR,
+                CL_QUEUE_THROTTLE_MED_KHR,
+                CL_QUEUE_THROTTLE_LOW_KHR
+            };
+
+            queue_properties.push_back(CL_QUEUE_THROTTLE_KHR);
+            queue_properties.push_back(throttles[throttle]);
+        }
+        #else
+        (void) throttle;
+        #endif
+
+        (void) queue_properties;
+    }
+    #endif // CL_VERSION_2_0
+
     cl_command_queue m_queue;
     mutable uint_ m_version;
+    device m_device;
+    context m_context;
 };
 
 inline buffer buffer::clone(command_queue &queue) const
@@ -0,0 +1,472 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_COMMAND_SEQUENCE_HPP
+#define BOOST_COMPUTE_COMMAND_SEQUENCE_HPP
+
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/cl_ext.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/platform.hpp>
+#include <boost/compute/exception.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/utility/wait_list.hpp>
+#include <boost/compute/detail/mutex.hpp>
+#include <boost/compute/detail/command_recording.hpp>
+
+// the command buffer commands got their final signatures (with a
+// properties argument) in version 0.9.5 of the provisional extension
+#if defined(cl_khr_command_buffer) && \
+    defined(CL_KHR_COMMAND_BUFFER_EXTENSION_VERSION) && \
+    defined(CL_VERSION_3_0)
+#  if CL_KHR_COMMAND_BUFFER_EXTENSION_VERSION >= CL_MAKE_VERSION(0, 9, 5)
+#    define BOOST_COMPUTE_DETAIL_KHR_COMMAND_BUFFER
+#  endif
+#endif
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+#ifdef BOOST_COMPUTE_DETAIL_KHR_COMMAND_BUFFER
+// a cl_khr_command_buffer holding the commands of a sequence
+class khr_command_buffer : boost::noncopyable
+{
+public:
+    khr_command_buffer()
+        : m_buffer(0)
+    {
+    }
+
+    ~khr_command_buffer()
+    {
+        if(m_buffer){
+            m_release(m_buffer);
+        }
+    }
+
+    // records commands for queue, returns false if the device does not
+    // support the extension or one of the commands
+    bool create(const command_queue &queue,
+                const recorded_command_list &commands)
+    {
+        const device device_ = queue.get_device();
+        if(!supports_command_buffers(device_)){
+            return false;
+        }
+
+        const platform platform_ = device_.platform();
+        if(!load(platform_, "clCreateCommandBufferKHR", m_create) ||
+           !load(platform_, "clFinalizeCommandBufferKHR", m_finalize) ||
+           !load(platform_, "clReleaseCommandBufferKHR", m_release) ||
+           !load(platform_, "clEnqueueCommandBufferKHR", m_enqueue) ||
+           !load(platform_, "clCommandNDRangeKernelKHR", m_nd_range_kernel) ||
+           !load(platform_, "clCommandCopyBufferKHR", m_copy_buffer) ||
+           !load(platform_, "clCommandFillBufferKHR", m_fill_buffer)){
+            return false;
+        }
+
+        const cl_command_queue queue_ = queue.get();
+        cl_int ret = CL_SUCCESS;
+        m_buffer = m_create(1, &queue_, 0, &ret);
+        if(!m_buffer){
+            // e.g. the queue lacks properties required by the device
+            return false;
+        }
+
+        // each command waits for the previous one as on an in-order queue
+        cl_sync_point_khr previous = 0;
+        for(size_t i = 0; i < commands.size(); i++){
+            const recorded_command &c = commands[i];
+            const cl_uint wait_count = i == 0 ? 0 : 1;
+            cl_sync_point_khr sync_point = 0;
+
+            if(c.type == recorded_command::nd_range_kernel){
+                ret = m_nd_range_kernel(
+                    m_buffer, 0, 0, c.kernel_.get(),
+                    static_cast<cl_uint>(c.global_work_size.size()),
+                    c.global_work_offset.empty() ? 0 : &c.global_work_offset[0],
+                    &c.global_work_size[0],
+                    c.local_work_size.empty() ? 0 : &c.local_work_size[0],
+                    wait_count, &previous, &sync_point, 0
+                );
+            }
+            else if(c.type == recorded_command::copy_buffer){
+                ret = m_copy_buffer(
+                    m_buffer, 0, 0, c.src.get(), c.dst.get(),
+                    c.src_offset, c.dst_offset, c.size,
+                    wait_count, &previous, &sync_point, 0
+                );
+            }
+            else if(c.type == recorded_command::fill_buffer){
+                ret = m_fill_buffer(
+                    m_buffer, 0, 0, c.dst.get(), &c.data[0], c.data.size(),
+                    c.dst_offset, c.size,
+                    wait_count, &previous, &sync_point, 0
+                );
+            }
+            else {
+                // host transfers cannot be recorded in a command buffer
+                return false;
+            }
+
+            if(ret != CL_SUCCESS){
+                return false;
+            }
+            previous = sync_point;
+        }
+
+        return m_finalize(m_buffer) == CL_SUCCESS;
+    }
+
+    // enqueues the command buffer to the queue it was created for, returns
+    // false if it cannot be enqueued (e.g. it is still pending and does
+    // not allow simultaneous use)
+    bool enqueue(const wait_list &events, event &event_)
+    {
+        cl_int ret = m_enqueue(
+            0, 0, m_buffer, events.size(), events.get_event_ptr(), &event_.get()
+        );
+
+        return ret == CL_SUCCESS;
+    }
+
+private:
+    // returns true if device supports a version of the extension with the
+    // signatures declared in the headers
+    static bool supports_command_buffers(const device &device_)
+    {
+        if(device_.get_version() < 300 ||
+           !device_.supports_extension("cl_khr_command_buffer")){
+            return false;
+        }
+
+        size_t size = 0;
+        cl_int ret = clGetDeviceInfo(
+            device_.id(), CL_DEVICE_EXTENSIONS_WITH_VERSION, 0, 0, &size
+        );
+        if(ret != CL_SUCCESS || size == 0){
+            return false;
+        }
+
+        std::vector<cl_name_version> extensions(size / sizeof(cl_name_version));
+        ret = clGetDeviceInfo(
+            device_.id(), CL_DEVICE_EXTENSIONS_WITH_VERSION,
+            extensions.size() * sizeof(cl_name_version), &extensions[0], 0
+        );
+        if(ret != CL_SUCCESS){
+            return false;
+        }
+
+        for(size_t i = 0; i < extensions.size(); i++){
+            if(std::string(extensions[i].name) == "cl_khr_command_buffer"){
+                return extensions[i].version >= CL_MAKE_VERSION(0, 9, 5);
+            }
+        }
+
+        return false;
+    }
+
+    template<class Function>
+    static bool load(const platform &platform_, const char *name, Function &function)
+    {
+        function = reinterpret_cast<Function>(
+            platform_.get_extension_function_address(name)
+        );
+
+        return function != 0;
+    }
+
+private:
+    cl_command_buffer_khr m_buffer;
+    clCreateCommandBufferKHR_fn m_create;
+    clFinalizeCommandBufferKHR_fn m_finalize;
+    clReleaseCommandBufferKHR_fn m_release;
+    clEnqueueCommandBufferKHR_fn m_enqueue;
+    clCommandNDRangeKernelKHR_fn m_nd_range_kernel;
+    clCommandCopyBufferKHR_fn m_copy_buffer;
+    clCommandFillBufferKHR_fn m_fill_buffer;
+};
+#endif // BOOST_COMPUTE_DETAIL_KHR_COMMAND_BUFFER
+
+} // end detail namespace
+
+/// \class command_sequence
+/// \brief A sequence of recorded commands which can be replayed.
+///
+/// A command_sequence holds the commands enqueued to a command queue
+/// between command_queue::begin_recording() and
+/// command_queue::end_recording(), including those enqueued by the
+/// algorithms. replay() enqueues the same commands again with very little
+/// host work: the kernels were cloned with their arguments when they were
+/// recorded, so no arguments are set, no programs are looked up and no
+/// work sizes are computed.
+///
+/// For example, to record the commands of each frame once and then replay
+/// them:
+/// \code
+/// queue.begin_recording();
+/// boost::compute::fill(buffer.begin(), buffer.end(), 0, queue);
+/// boost::compute::transform(
+///     input.begin(), input.end(), buffer.begin(), output.begin(),
+///     boost::compute::plus<float>(), queue
+/// );
+/// boost::compute::command_sequence frame = queue.end_recording();
+///
+/// for(;;){
+///     frame.replay(queue);
+///     ...
+/// }
+/// \endcode
+///
+/// When the device supports the \c cl_khr_command_buffer extension (with
+/// the signatures of version 0.9.5 or later), sequences of kernels, copies
+/// and fills replayed on the queue which recorded them are submitted as a
+/// single command buffer. Otherwise each command is enqueued again.
+///
+/// Replays use the values the commands had when they were recorded, except
+/// for the host memory of non-blocking reads and writes (e.g. from
+/// copy_async()) which are replayed with the same host pointers. The data
+/// of blocking writes is copied when they are recorded. Blocking reads
+/// (e.g. the results of reduce() or accumulate() returned to the host) are
+/// not recorded. The buffers used by the commands are retained by the
+/// sequence, including the temporary buffers allocated by the algorithms.
+///
+/// Commands are replayed in order. The sequence must not be destroyed
+/// before its replays complete.
+///
+/// \see command_queue::begin_recording()
+class command_sequence
+{
+public:
+    /// Creates an empty command sequence.
+    command_sequence()
+        : m_impl(boost::make_shared<impl>())
+    {
+    }
+
+    /// Returns the number of recorded commands.
+    size_t size() const
+    {
+        return m_impl->commands.size();
+    }
+
+    /// Returns \c true if no commands were recorded.
+    bool empty() const
+    {
+        return m_impl->commands.empty();
+    }
+
+    /// Enqueues the recorded commands to \p queue after \p events and
+    /// returns an event for the last one (or a null event if the sequence
+    /// is empty).
+    event replay(command_queue &queue, const wait_list &events = wait_list()) const
+    {
+        BOOST_ASSERT(queue.get() != 0);
+
+        event event_;
+        const detail::recorded_command_list &commands = m_impl->commands;
+        if(commands.empty()){
+            return event_;
+        }
+
+        #ifdef BOOST_COMPUTE_DETAIL_KHR_COMMAND_BUFFER
+        if(detail::khr_command_buffer *buffer = m_impl->get_command_buffer(queue)){
+            if(buffer->enqueue(events, event_)){
+                return event_;
+            }
+        }
+        #endif // BOOST_COMPUTE_DETAIL_KHR_COMMAND_BUFFER
+
+        // chain the commands with events on out-of-order queues
+        const bool in_order =
+            (queue.get_properties() & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE) == 0;
+
+        event previous;
+        for(size_t i = 0; i < commands.size(); i++){
+            const bool last = i + 1 == commands.size();
+
+            wait_list wait;
+            if(i == 0){
+                wait = events;
+            }
+            else if(!in_order){
+                wait.insert(previous);
+            }
+
+            event current;
+            enqueue(queue, commands[i], wait, (last || !in_order) ? &current : 0);
+            previous = current;
+        }
+
+        return previous;
+    }
+
+private:
+    friend class command_queue;
+
+    struct impl
+    {
+        impl()
+            : recorded_queue(0)
+        #ifdef BOOST_COMPUTE_DETAIL_KHR_COMMAND_BUFFER
+            , command_buffer_created(false)
+        #endif
+        {
+        }
+
+        detail::recorded_command_list commands;
+        cl_command_queue recorded_queue;
+
+        #ifdef BOOST_COMPUTE_DETAIL_KHR_COMMAND_BUFFER
+        // returns the command buffer of the sequence if it can be used with
+        // queue, it is created on the first replay
+        detail::khr_command_buffer* get_command_buffer(const command_queue &queue)
+        {
+            if(queue.get() != recorded_queue){
+                return 0;
+            }
+
+            detail::scoped_lock lock(command_buffer_mutex);
+
+            if(!command_buffer_created){
+                command_buffer_created = true;
+
+                command_buffer = boost::make_shared<detail::khr_command_buffer>();
+                if(!command_buffer->create(queue, commands)){
+                    command_buffer.reset();
+                }
+            }
+
+            return command_buffer.get();
+        }
+
+        detail::mutex command_buffer_mutex;
+        bool command_buffer_created;
+        boost::shared_ptr<detail::khr_command_buffer> command_buffer;
+        #endif // BOOST_COMPUTE_DETAIL_KHR_COMMAND_BUFFER
+    };
+
+    command_sequence(cl_command_queue queue,
+                     detail::recorded_command_list &commands)
+        : m_impl(boost::make_shared<impl>())
+    {
+        m_impl->commands.swap(commands);
+        m_impl->recorded_queue = queue;
+    }
+
+    static void enqueue(command_queue &queue,
+                        const detail::recorded_command &command,
+                        const wait_list &events,
+                        event *event_)
+    {
+        cl_int ret = CL_SUCCESS;
+
+        switch(command.type){
+        case detail::recorded_command::nd_range_kernel:
+            ret = clEnqueueNDRangeKernel(
+                queue.get(),
+                command.kernel_.get(),
+                static_cast<cl_uint>(command.global_work_size.size()),
+                command.global_work_offset.empty() ? 0 : &command.global_work_offset[0],
+                &command.global_work_size[0],
+                command.local_work_size.empty() ? 0 : &command.local_work_size[0],
+                events.size(),
+                events.get_event_ptr(),
+                event_ ? &event_->get() : 0
+            );
+            break;
+        case detail::recorded_command::copy_buffer:
+            ret = clEnqueueCopyBuffer(
+                queue.get(),
+                command.src.get(),
+                command.dst.get(),
+                command.src_offset,
+                command.dst_offset,
+                command.size,
+                events.size(),
+                events.get_event_ptr(),
+                event_ ? &event_->get() : 0
+            );
+            break;
+        case detail::recorded_command::fill_buffer:
+            #ifdef CL_VERSION_1_2
+            ret = clEnqueueFillBuffer(
+                queue.get(),
+                command.dst.get(),
+                &command.data[0],
+                command.data.size(),
+                command.dst_offset,
+                command.size,
+                events.size(),
+                events.get_event_ptr(),
+                event_ ? &event_->get() : 0
+            );
+            #endif // CL_VERSION_1_2
+            break;
+        case detail::recorded_command::write_buffer:
+            ret = clEnqueueWriteBuffer(
+                queue.get(),
+                command.dst.get(),
+                CL_FALSE,
+                command.dst_offset,
+                command.size,
+                command.host_ptr ? command.host_ptr : &command.data[0],
+                events.size(),
+                events.get_event_ptr(),
+                event_ ? &event_->get() : 0
+            );
+            break;
+        case detail::recorded_command::read_buffer:
+            ret = clEnqueueReadBuffer(
+                queue.get(),
+                command.dst.get(),
+                CL_FALSE,
+                command.dst_offset,
+                command.size,
+                command.host_ptr,
+                events.size(),
+                events.get_event_ptr(),
+                event_ ? &event_->get() : 0
+            );
+            break;
+        }
+
+        if(ret != CL_SUCCESS){
+            BOOST_THROW_EXCEPTION(opencl_error(ret));
+        }
+    }
+
+private:
+    boost::shared_ptr<impl> m_impl;
+};
+
+inline command_sequence command_queue::end_recording()
+{
+    BOOST_ASSERT(m_queue != 0);
+
+    boost::shared_ptr<detail::recorded_command_list> commands =
+        detail::command_recording_registry::get().end(m_queue);
+
+    return command_sequence(m_queue, *commands);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_COMMAND_SEQUENCE_HPP
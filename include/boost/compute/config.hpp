@@ -36,6 +36,14 @@
   #define BOOST_COMPUTE_DETAIL_NO_STD_TUPLE
 #endif
 
+// the BOOST_COMPUTE_DETAIL_NO_COROUTINES macro is defined if the
+// compiler/stdlib does not support c++20 coroutines
+#if !defined(__cpp_impl_coroutine) || !defined(__has_include)
+  #define BOOST_COMPUTE_DETAIL_NO_COROUTINES
+#elif !__has_include(<coroutine>)
+  #define BOOST_COMPUTE_DETAIL_NO_COROUTINES
+#endif
+
 // defines BOOST_COMPUTE_CL_CALLBACK to the value of CL_CALLBACK
 // if it is defined (it was added in OpenCL 1.1). this is used to
 // annotate certain callback functions registered with OpenCL
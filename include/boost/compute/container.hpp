@@ -16,12 +16,21 @@
 /// Meta-header to include all Boost.Compute container headers.
 
 #include <boost/compute/container/array.hpp>
+#include <boost/compute/container/array_view.hpp>
 #include <boost/compute/container/basic_string.hpp>
+#include <boost/compute/container/bloom_filter.hpp>
+#include <boost/compute/container/constant_table.hpp>
 #include <boost/compute/container/dynamic_bitset.hpp>
 #include <boost/compute/container/flat_map.hpp>
 #include <boost/compute/container/flat_set.hpp>
+#include <boost/compute/container/mapped_double_buffer.hpp>
 #include <boost/compute/container/mapped_view.hpp>
+#include <boost/compute/container/pinned_host_vector.hpp>
+#include <boost/compute/container/soa_vector.hpp>
 #include <boost/compute/container/string.hpp>
+#include <boost/compute/container/svm_vector.hpp>
+#include <boost/compute/container/unordered_map.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/work_queue.hpp>
 
 #endif // BOOST_COMPUTE_CONTAINER_HPP
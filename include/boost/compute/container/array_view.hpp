@@ -0,0 +1,352 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_ARRAY_VIEW_HPP
+#define BOOST_COMPUTE_CONTAINER_ARRAY_VIEW_HPP
+
+#include <cstddef>
+#include <algorithm>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/strided_iterator.hpp>
+#include <boost/compute/utility/extents.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// the linear index of a two-dimensional position in an array_view
+template<class IndexExpr0, class IndexExpr1>
+struct array_view_index_expr2
+{
+    array_view_index_expr2(const IndexExpr0 &i0, size_t s0,
+                           const IndexExpr1 &i1, size_t s1)
+        : m_i0(i0, s0),
+          m_i1(i1, s1)
+    {
+    }
+
+    strided_index_expr<IndexExpr0> m_i0;
+    strided_index_expr<IndexExpr1> m_i1;
+};
+
+template<class IndexExpr0, class IndexExpr1>
+inline meta_kernel& operator<<(meta_kernel &kernel,
+                               const array_view_index_expr2<IndexExpr0,
+                                                            IndexExpr1> &expr)
+{
+    return kernel << expr.m_i0 << "+" << expr.m_i1;
+}
+
+// the linear index of a three-dimensional position in an array_view
+template<class IndexExpr0, class IndexExpr1, class IndexExpr2>
+struct array_view_index_expr3
+{
+    array_view_index_expr3(const IndexExpr0 &i0, size_t s0,
+                           const IndexExpr1 &i1, size_t s1,
+                           const IndexExpr2 &i2, size_t s2)
+        : m_i0(i0, s0),
+          m_i1(i1, s1),
+          m_i2(i2, s2)
+    {
+    }
+
+    strided_index_expr<IndexExpr0> m_i0;
+    strided_index_expr<IndexExpr1> m_i1;
+    strided_index_expr<IndexExpr2> m_i2;
+};
+
+template<class IndexExpr0, class IndexExpr1, class IndexExpr2>
+inline meta_kernel& operator<<(meta_kernel &kernel,
+                               const array_view_index_expr3<IndexExpr0,
+                                                            IndexExpr1,
+                                                            IndexExpr2> &expr)
+{
+    return kernel << expr.m_i0 << "+" << expr.m_i1 << "+" << expr.m_i2;
+}
+
+} // end detail namespace
+
+/// \class array_view
+/// \brief A non-owning N-dimensional view of the values in a buffer.
+///
+/// The array_view class describes an N-dimensional array of values of type
+/// \c T stored in a buffer with a shape (the extent of each dimension), a
+/// stride (in values) for each dimension and the offset of its first
+/// value. Views are created in row-major order by default, and slicing,
+/// taking sub-sections or transposing a view only changes its shape,
+/// strides and offset, the values themselves are never copied.
+///
+/// For example, to copy a column of a row-major matrix to the host:
+/// \code
+/// // a 480x640 matrix
+/// boost::compute::vector<float> matrix(480 * 640, context);
+/// boost::compute::array_view<float, 2> view(
+///     matrix.begin(), boost::compute::dim(480, 640)
+/// );
+///
+/// // the fifth column (a one-dimensional view with a stride of 640)
+/// boost::compute::array_view<float, 1> column = view.slice(1, 4);
+///
+/// std::vector<float> host_column(480);
+/// boost::compute::copy(column.begin(), column.end(), host_column.begin(), queue);
+/// \endcode
+///
+/// Inside custom kernels built with meta_kernel, the values of a view are
+/// accessed with \c operator() which generates the linear index inline:
+/// \code
+/// k << view(k.var<uint_>("i"), k.var<uint_>("j")) << " = 0;\n";
+/// \endcode
+///
+/// \see strided_iterator, \ref extents "extents<N>"
+template<class T, size_t N>
+class array_view
+{
+public:
+    typedef T value_type;
+    typedef strided_iterator<buffer_iterator<T> > iterator;
+
+    /// Creates a row-major view with \p shape of the values starting at
+    /// \p first.
+    array_view(const buffer_iterator<T> &first, const extents<N> &shape)
+        : m_buffer(first.get_buffer()),
+          m_offset(first.get_index()),
+          m_shape(shape)
+    {
+        size_t stride = 1;
+        for(size_t i = N; i > 0; i--){
+            m_strides[i - 1] = stride;
+            stride *= shape[i - 1];
+        }
+    }
+
+    /// Creates a view with \p shape and \p strides (in values) of the
+    /// values starting at \p first.
+    array_view(const buffer_iterator<T> &first,
+               const extents<N> &shape,
+               const extents<N> &strides)
+        : m_buffer(first.get_buffer()),
+          m_offset(first.get_index()),
+          m_shape(shape),
+          m_strides(strides)
+    {
+    }
+
+    /// Creates a view with \p shape and \p strides of the values of
+    /// \p buffer starting at \p offset.
+    array_view(const buffer &buffer,
+               size_t offset,
+               const extents<N> &shape,
+               const extents<N> &strides)
+        : m_buffer(buffer),
+          m_offset(offset),
+          m_shape(shape),
+          m_strides(strides)
+    {
+    }
+
+    /// Returns the buffer of the view.
+    const buffer& get_buffer() const
+    {
+        return m_buffer;
+    }
+
+    /// Returns the index of the first value of the view in its buffer.
+    size_t offset() const
+    {
+        return m_offset;
+    }
+
+    /// Returns the extent of each dimension.
+    const extents<N>& shape() const
+    {
+        return m_shape;
+    }
+
+    /// Returns the stride (in values) of each dimension.
+    const extents<N>& strides() const
+    {
+        return m_strides;
+    }
+
+    /// Returns the extent of dimension \p dim.
+    size_t extent(size_t dim) const
+    {
+        return m_shape[dim];
+    }
+
+    /// Returns the stride (in values) of dimension \p dim.
+    size_t stride(size_t dim) const
+    {
+        return m_strides[dim];
+    }
+
+    /// Returns the number of values in the view.
+    size_t size() const
+    {
+        return m_shape.linear();
+    }
+
+    /// Returns \c true if the values of the view are stored contiguously
+    /// in row-major order.
+    bool is_contiguous() const
+    {
+        size_t stride = 1;
+        for(size_t i = N; i > 0; i--){
+            if(m_shape[i - 1] != 1 && m_strides[i - 1] != stride){
+                return false;
+            }
+            stride *= m_shape[i - 1];
+        }
+        return true;
+    }
+
+    /// Returns the (N-1)-dimensional view of the values with index
+    /// \p index in dimension \p dim.
+    ///
+    /// For example, \c slice(0, i) returns row \c i and \c slice(1, j)
+    /// returns column \c j of a two-dimensional view.
+    array_view<T, N - 1> slice(size_t dim, size_t index) const
+    {
+        BOOST_STATIC_ASSERT(N > 1);
+        BOOST_ASSERT(dim < N && index < m_shape[dim]);
+
+        extents<N - 1> shape;
+        extents<N - 1> strides;
+        for(size_t i = 0, j = 0; i < N; i++){
+            if(i != dim){
+                shape[j] = m_shape[i];
+                strides[j] = m_strides[i];
+                j++;
+            }
+        }
+
+        return array_view<T, N - 1>(
+            m_buffer, m_offset + index * m_strides[dim], shape, strides
+        );
+    }
+
+    /// Returns the view of the values in the box starting at \p origin
+    /// with \p shape.
+    array_view<T, N> section(const extents<N> &origin, const extents<N> &shape) const
+    {
+        size_t offset = m_offset;
+        for(size_t i = 0; i < N; i++){
+            BOOST_ASSERT(origin[i] + shape[i] <= m_shape[i]);
+            offset += origin[i] * m_strides[i];
+        }
+
+        return array_view<T, N>(m_buffer, offset, shape, m_strides);
+    }
+
+    /// Returns the view with dimensions \p a and \p b swapped.
+    array_view<T, N> transpose(size_t a = 0, size_t b = 1) const
+    {
+        BOOST_ASSERT(a < N && b < N);
+
+        extents<N> shape = m_shape;
+        extents<N> strides = m_strides;
+        std::swap(shape[a], shape[b]);
+        std::swap(strides[a], strides[b]);
+
+        return array_view<T, N>(m_buffer, m_offset, shape, strides);
+    }
+
+    /// Returns an iterator to the first value of a one-dimensional view.
+    iterator begin() const
+    {
+        BOOST_STATIC_ASSERT(N == 1);
+
+        return iterator(buffer_iterator<T>(m_buffer, m_offset), m_strides[0]);
+    }
+
+    /// Returns an iterator one past the last value of a one-dimensional
+    /// view.
+    iterator end() const
+    {
+        BOOST_STATIC_ASSERT(N == 1);
+
+        return begin() + static_cast<std::ptrdiff_t>(m_shape[0]);
+    }
+
+    /// \internal_
+    template<class IndexExpr0>
+    detail::buffer_iterator_index_expr<T, detail::strided_index_expr<IndexExpr0> >
+    operator()(const IndexExpr0 &i0) const
+    {
+        BOOST_STATIC_ASSERT(N == 1);
+
+        return detail::buffer_iterator_index_expr<
+                   T, detail::strided_index_expr<IndexExpr0>
+               >(m_buffer,
+                 m_offset,
+                 memory_object::global_memory,
+                 detail::strided_index_expr<IndexExpr0>(i0, m_strides[0]));
+    }
+
+    /// \internal_
+    template<class IndexExpr0, class IndexExpr1>
+    detail::buffer_iterator_index_expr<
+        T, detail::array_view_index_expr2<IndexExpr0, IndexExpr1>
+    >
+    operator()(const IndexExpr0 &i0, const IndexExpr1 &i1) const
+    {
+        BOOST_STATIC_ASSERT(N == 2);
+
+        typedef detail::array_view_index_expr2<IndexExpr0, IndexExpr1> index_expr;
+
+        return detail::buffer_iterator_index_expr<T, index_expr>(
+            m_buffer,
+            m_offset,
+            memory_object::global_memory,
+            index_expr(i0, m_strides[0], i1, m_strides[1])
+        );
+    }
+
+    /// \internal_
+    template<class IndexExpr0, class IndexExpr1, class IndexExpr2>
+    detail::buffer_iterator_index_expr<
+        T, detail::array_view_index_expr3<IndexExpr0, IndexExpr1, IndexExpr2>
+    >
+    operator()(const IndexExpr0 &i0,
+               const IndexExpr1 &i1,
+               const IndexExpr2 &i2) const
+    {
+        BOOST_STATIC_ASSERT(N == 3);
+
+        typedef detail::array_view_index_expr3<
+            IndexExpr0, IndexExpr1, IndexExpr2
+        > index_expr;
+
+        return detail::buffer_iterator_index_expr<T, index_expr>(
+            m_buffer,
+            m_offset,
+            memory_object::global_memory,
+            index_expr(i0, m_strides[0], i1, m_strides[1], i2, m_strides[2])
+        );
+    }
+
+private:
+    buffer m_buffer;
+    size_t m_offset;
+    extents<N> m_shape;
+    extents<N> m_strides;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_ARRAY_VIEW_HPP
@@ -0,0 +1,366 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_BLOOM_FILTER_HPP
+#define BOOST_COMPUTE_CONTAINER_BLOOM_FILTER_HPP
+
+#include <cmath>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/assert.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/container/dynamic_bitset.hpp>
+#include <boost/compute/functional/hash.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// number of bits in each block of a bloom filter (one 64 byte cache line)
+static const uint_ bloom_filter_block_bits = 512;
+
+// the hash of a key is mixed (with the 64-bit murmur3 finalizer), its upper
+// half selects the block of the key and the bit positions in the block are
+// derived from its lower half by double hashing. all bits of a key are in
+// the same cache line.
+inline std::string bloom_filter_functions_source()
+{
+    return
+        "inline ulong boost_bloom_filter_mix(ulong h)\n"
+        "{\n"
+        "    h ^= h >> 33;\n"
+        "    h *= 0xff51afd7ed558ccdUL;\n"
+        "    h ^= h >> 33;\n"
+        "    h *= 0xc4ceb9fe1a85ec53UL;\n"
+        "    h ^= h >> 33;\n"
+        "    return h;\n"
+        "}\n"
+        "inline bool boost_bloom_filter_contains(__global const uint *bits,\n"
+        "                                        const uint blocks,\n"
+        "                                        const uint hashes,\n"
+        "                                        ulong h)\n"
+        "{\n"
+        "    h = boost_bloom_filter_mix(h);\n"
+        "    __global const uint *block = bits + ((uint)(h >> 32) % blocks) * 16;\n"
+        "    const uint a = (uint) h;\n"
+        "    const uint b = rotate(a, 16u) | 1;\n"
+        "    for(uint i = 0; i < hashes; i++){\n"
+        "        const uint bit = (a + i * b) & 511;\n"
+        "        if((block[bit >> 5] & (1u << (bit & 31))) == 0){\n"
+        "            return false;\n"
+        "        }\n"
+        "    }\n"
+        "    return true;\n"
+        "}\n"
+        "inline void boost_bloom_filter_insert(__global uint *bits,\n"
+        "                                      const uint blocks,\n"
+        "                                      const uint hashes,\n"
+        "                                      ulong h)\n"
+        "{\n"
+        "    h = boost_bloom_filter_mix(h);\n"
+        "    __global uint *block = bits + ((uint)(h >> 32) % blocks) * 16;\n"
+        "    const uint a = (uint) h;\n"
+        "    const uint b = rotate(a, 16u) | 1;\n"
+        "    for(uint i = 0; i < hashes; i++){\n"
+        "        const uint bit = (a + i * b) & 511;\n"
+        "        atomic_or(&block[bit >> 5], 1u << (bit & 31));\n"
+        "    }\n"
+        "}\n";
+}
+
+// the membership test of arg with a bloom filter
+template<class Key, class Arg>
+struct invoked_bloom_filter_contains
+{
+    invoked_bloom_filter_contains(const buffer &bits_,
+                                  uint_ blocks_,
+                                  uint_ hashes_,
+                                  const Arg &arg_)
+        : bits(bits_),
+          blocks(blocks_),
+          hashes(hashes_),
+          arg(arg_)
+    {
+    }
+
+    buffer bits;
+    uint_ blocks;
+    uint_ hashes;
+    Arg arg;
+};
+
+template<class Key, class Arg>
+inline meta_kernel& operator<<(meta_kernel &k,
+                               const invoked_bloom_filter_contains<Key, Arg> &expr)
+{
+    k.add_function("boost_bloom_filter_contains", bloom_filter_functions_source());
+
+    return k << "boost_bloom_filter_contains(" <<
+                k.get_buffer_identifier<uint_>(expr.bits) << ", " <<
+                expr.blocks << ", " <<
+                expr.hashes << ", " <<
+                hash<Key>()(expr.arg) << ")";
+}
+
+// tests keys with a bloom filter in algorithms
+template<class Key>
+struct bloom_filter_predicate
+{
+    typedef bool result_type;
+
+    bloom_filter_predicate(const buffer &bits_, uint_ blocks_, uint_ hashes_)
+        : bits(bits_),
+          blocks(blocks_),
+          hashes(hashes_)
+    {
+    }
+
+    template<class Arg>
+    invoked_bloom_filter_contains<Key, Arg> operator()(const Arg &arg) const
+    {
+        return invoked_bloom_filter_contains<Key, Arg>(bits, blocks, hashes, arg);
+    }
+
+    buffer bits;
+    uint_ blocks;
+    uint_ hashes;
+};
+
+} // end detail namespace
+
+/// \class bloom_filter
+/// \brief A probabilistic set of keys on the device.
+///
+/// A bloom filter tests whether keys may be part of a set. Keys which were
+/// inserted are always reported as contained, other keys are reported as
+/// contained with a small probability (see false_positive_rate()). This
+/// allows, for example, filtering out most of the rows of a join which
+/// have no match before the join itself:
+/// \code
+/// boost::compute::bloom_filter<int> filter(
+///     boost::compute::bloom_filter<int>::recommended_bits(build_keys.size(), 0.01),
+///     7,
+///     queue
+/// );
+/// filter.insert(build_keys.begin(), build_keys.end(), queue);
+///
+/// boost::compute::copy_if(
+///     probe_keys.begin(), probe_keys.end(), candidates.begin(), filter.predicate(), queue
+/// );
+/// \endcode
+///
+/// The bits are split into cache line sized blocks of 512 bits. Each key
+/// sets (and is tested against) \c hash_count() bits in a single block,
+/// which are derived from \c hash<Key> by double hashing. The bits are
+/// stored in a \c dynamic_bitset<uint_>.
+///
+/// The \c Key type must be supported by \ref hash "hash<Key>".
+///
+/// \see dynamic_bitset
+template<class Key>
+class bloom_filter
+{
+public:
+    typedef Key key_type;
+    typedef dynamic_bitset<uint_> bitset_type;
+    typedef typename bitset_type::size_type size_type;
+
+    /// Creates an empty bloom filter with at least \p bit_count bits (the
+    /// count is rounded up to a multiple of 512) which sets \p hash_count
+    /// bits for each key.
+    bloom_filter(size_type bit_count, size_type hash_count, command_queue &queue)
+        : m_bits(_block_count(bit_count) * detail::bloom_filter_block_bits, queue),
+          m_hash_count(hash_count)
+    {
+        BOOST_ASSERT(hash_count > 0 && hash_count <= detail::bloom_filter_block_bits);
+    }
+
+    /// Returns the number of bits in the filter.
+    size_type bit_count() const
+    {
+        return m_bits.size();
+    }
+
+    /// Returns the number of bits set for each key.
+    size_type hash_count() const
+    {
+        return m_hash_count;
+    }
+
+    /// Inserts the keys in the range [\p first, \p last).
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last, command_queue &queue)
+    {
+        const size_t count = detail::iterator_range_size(first, last);
+        if(count == 0){
+            return;
+        }
+
+        detail::meta_kernel k("bloom_filter_insert");
+        k.add_function("boost_bloom_filter_contains",
+                       detail::bloom_filter_functions_source());
+        k <<
+            "const uint i = get_global_id(0);\n" <<
+            "boost_bloom_filter_insert(" <<
+                k.get_buffer_identifier<uint_>(m_bits.get_buffer()) << ", " <<
+                _block_count() << ", " << uint_(m_hash_count) << ", " <<
+                hash<Key>()(first[k.var<uint_>("i")]) << ");\n";
+
+        k.exec_1d(queue, 0, count);
+    }
+
+    /// Tests the keys in the range [\p first, \p last) and stores \c 1 in
+    /// the range beginning at \p result for each key which may be
+    /// contained and \c 0 for every other key.
+    template<class InputIterator, class OutputIterator>
+    OutputIterator contains(InputIterator first,
+                            InputIterator last,
+                            OutputIterator result,
+                            command_queue &queue) const
+    {
+        typedef typename std::iterator_traits<OutputIterator>::value_type result_type;
+
+        const size_t count = detail::iterator_range_size(first, last);
+        if(count == 0){
+            return result;
+        }
+
+        detail::meta_kernel k("bloom_filter_contains");
+        k <<
+            "const uint i = get_global_id(0);\n" <<
+            result[k.var<uint_>("i")] << " = (" << type_name<result_type>() << ")(" <<
+                predicate()(first[k.var<uint_>("i")]) << " ? 1 : 0);\n";
+
+        k.exec_1d(queue, 0, count);
+
+        return result + static_cast<typename std::iterator_traits<OutputIterator>::difference_type>(count);
+    }
+
+    /// Tests the keys in the range [\p first, \p last) and sets the bit of
+    /// each key which may be contained in \p mask (which is resized to the
+    /// size of the range).
+    ///
+    /// The mask can be used as a stencil for \c copy_if().
+    template<class InputIterator, class Block, class Alloc>
+    void contains(InputIterator first,
+                  InputIterator last,
+                  dynamic_bitset<Block, Alloc> &mask,
+                  command_queue &queue) const
+    {
+        mask.assign(first, last, predicate(), queue);
+    }
+
+    /// Returns a predicate function testing whether a key may be contained
+    /// which can be passed to algorithms (e.g. \c copy_if() or
+    /// \c count_if()).
+    ///
+    /// The predicate refers to the bits of the filter, keys inserted after
+    /// it was created are seen by later calls of the algorithms.
+    detail::bloom_filter_predicate<Key> predicate() const
+    {
+        return detail::bloom_filter_predicate<Key>(
+            m_bits.get_buffer(), _block_count(), static_cast<uint_>(m_hash_count)
+        );
+    }
+
+    /// Sets each bit to one if it is set in \c *this or in \p other, which
+    /// makes \c *this contain the keys of both filters. Both filters must
+    /// have the same number of bits and hashes.
+    void merge(const bloom_filter &other, command_queue &queue)
+    {
+        BOOST_ASSERT(other.bit_count() == bit_count());
+        BOOST_ASSERT(other.hash_count() == hash_count());
+
+        m_bits.bit_or(other.m_bits, queue);
+    }
+
+    /// Estimates the probability that a key which was not inserted is
+    /// reported as contained from the number of set bits.
+    double false_positive_rate(command_queue &queue) const
+    {
+        const double fill =
+            static_cast<double>(m_bits.count(queue)) / static_cast<double>(bit_count());
+
+        return std::pow(fill, static_cast<double>(m_hash_count));
+    }
+
+    /// Removes all keys from the filter.
+    void clear(command_queue &queue)
+    {
+        m_bits.reset(queue);
+    }
+
+    /// Returns the bits of the filter.
+    const bitset_type& bits() const
+    {
+        return m_bits;
+    }
+
+    /// Returns the number of bits for a filter of \p key_count keys with a
+    /// false positive rate of \p rate (using the optimal number of hashes
+    /// returned by recommended_hashes()).
+    static size_type recommended_bits(size_type key_count, double rate)
+    {
+        BOOST_ASSERT(rate > 0 && rate < 1);
+
+        const double ln2 = std::log(2.0);
+
+        return static_cast<size_type>(std::ceil(
+            -static_cast<double>(key_count) * std::log(rate) / (ln2 * ln2)
+        ));
+    }
+
+    /// Returns the number of hashes with the lowest false positive rate
+    /// for \p key_count keys in \p bit_count bits.
+    static size_type recommended_hashes(size_type key_count, size_type bit_count)
+    {
+        if(key_count == 0){
+            return 1;
+        }
+
+        const double hashes = std::floor(
+            static_cast<double>(bit_count) / static_cast<double>(key_count) * std::log(2.0) + 0.5
+        );
+
+        return (std::max)(size_type(1), static_cast<size_type>(hashes));
+    }
+
+private:
+    /// \internal_
+    static size_type _block_count(size_type bit_count)
+    {
+        return (std::max)(
+            size_type(1),
+            (bit_count + detail::bloom_filter_block_bits - 1) / detail::bloom_filter_block_bits
+        );
+    }
+
+    /// \internal_
+    uint_ _block_count() const
+    {
+        return static_cast<uint_>(m_bits.size() / detail::bloom_filter_block_bits);
+    }
+
+private:
+    bitset_type m_bits;
+    size_type m_hash_count;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_BLOOM_FILTER_HPP
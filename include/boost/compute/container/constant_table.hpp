@@ -0,0 +1,175 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_CONSTANT_TABLE_HPP
+#define BOOST_COMPUTE_CONTAINER_CONSTANT_TABLE_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/throw_exception.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/iterator/constant_buffer_iterator.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/type_traits/detail/capture_traits.hpp>
+#include <boost/compute/detail/constant_memory.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class constant_table
+/// \brief A read-only table of values in the \c __constant memory space.
+///
+/// The constant_table class stores a small table of values (e.g.
+/// coefficients or a lookup table) which kernels read from the
+/// \c __constant memory space. Devices cache constant memory, so reading
+/// the same values from many work-items is faster than from \c __global
+/// memory. The table must fit in the \c CL_DEVICE_MAX_CONSTANT_BUFFER_SIZE
+/// of the devices of its context.
+///
+/// Tables can be captured by closures and used with constant_buffer_iterator
+/// in algorithms. For example, to evaluate a polynomial with coefficients in
+/// constant memory:
+/// \code
+/// float coefficients[] = { 1.0f, 0.5f, 0.25f };
+/// boost::compute::constant_table<float> table(coefficients, coefficients + 3, context);
+/// const boost::compute::uint_ n = 3;
+///
+/// BOOST_COMPUTE_CLOSURE(float, polynomial, (float x), (table, n),
+/// {
+///     float y = 0;
+///     for(uint i = n; i > 0; i--){
+///         y = y * x + table[i - 1];
+///     }
+///     return y;
+/// });
+/// \endcode
+///
+/// \see constant_buffer_iterator
+template<class T>
+class constant_table
+{
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef constant_buffer_iterator<T> const_iterator;
+
+    /// Creates a table with the values in the host range [\p first,
+    /// \p last) in \p context.
+    ///
+    /// Throws \c std::length_error if the table does not fit in the
+    /// constant memory of the devices of \p context.
+    template<class InputIterator>
+    constant_table(InputIterator first,
+                   InputIterator last,
+                   const context &context = system::default_context())
+    {
+        std::vector<T> values(first, last);
+        m_size = values.size();
+        check_size(context);
+
+        // buffers can not be empty
+        values.resize((std::max)(m_size, size_t(1)));
+        m_buffer = buffer(
+            context,
+            values.size() * sizeof(T),
+            buffer::read_only | buffer::copy_host_ptr,
+            &values[0]
+        );
+    }
+
+    /// Creates a table of the first \p size values of \p buffer, which
+    /// may have been computed by kernels. The values are not copied.
+    ///
+    /// Throws \c std::length_error if the table does not fit in the
+    /// constant memory of the devices of the context of \p buffer.
+    constant_table(const buffer &buffer, size_t size)
+        : m_buffer(buffer),
+          m_size(size)
+    {
+        check_size(buffer.get_context());
+    }
+
+    /// Returns the number of values in the table.
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /// Returns \c true if the table is empty.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// Returns an iterator to the first value of the table.
+    const_iterator begin() const
+    {
+        return const_iterator(m_buffer, 0);
+    }
+
+    /// Returns an iterator one past the last value of the table.
+    const_iterator end() const
+    {
+        return const_iterator(m_buffer, m_size);
+    }
+
+    /// Returns the underlying buffer.
+    const buffer& get_buffer() const
+    {
+        return m_buffer;
+    }
+
+private:
+    void check_size(const context &context) const
+    {
+        if(!detail::fits_in_constant_memory(m_size * sizeof(T), context)){
+            BOOST_THROW_EXCEPTION(
+                std::length_error("table does not fit in constant memory")
+            );
+        }
+    }
+
+private:
+    buffer m_buffer;
+    size_t m_size;
+};
+
+namespace detail {
+
+// for capturing constant_table<T> with BOOST_COMPUTE_CLOSURE()
+template<class T>
+struct capture_traits<constant_table<T> >
+{
+    static std::string type_name()
+    {
+        return std::string("__constant ") + ::boost::compute::type_name<T>() + "*";
+    }
+};
+
+// meta_kernel streaming operator for constant_table<T>
+template<class T>
+meta_kernel& operator<<(meta_kernel &k, const constant_table<T> &table)
+{
+  return k << k.get_buffer_identifier<T>(table.get_buffer(), memory_object::constant_memory);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_CONSTANT_TABLE_HPP
@@ -0,0 +1,419 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_DETAIL_VALARRAY_EXPRESSION_HPP
+#define BOOST_COMPUTE_CONTAINER_DETAIL_VALARRAY_EXPRESSION_HPP
+
+#include <algorithm>
+#include <string>
+
+#include <boost/assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/functional/integer.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/algorithm/detail/fused_transform_reduce.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+
+namespace boost {
+namespace compute {
+
+template<class T> class valarray;
+
+namespace detail {
+
+// valarray expressions are trees of the operations applied to valarrays
+// and scalars which are only evaluated when assigned to a valarray (or
+// reduced), the whole expression being computed by a single kernel.
+//
+// each node provides size() (zero for scalars) and emit() (see
+// valarray_emit() for the valarrays themselves), writing the
+// expression of the value at index to the kernel. path is unique to each
+// node of the tree and names the kernel arguments of the scalars (which
+// are passed as arguments so that changing them does not change the
+// source of the kernel).
+template<class Derived, class T>
+class valarray_expression;
+
+// writes the value of expr at index to the kernel
+template<class Expr>
+inline void valarray_emit(meta_kernel &k,
+                          const Expr &expr,
+                          const std::string &index,
+                          const std::string &path)
+{
+    expr.emit(k, index, path);
+}
+
+template<class T>
+inline void valarray_emit(meta_kernel &k,
+                          const valarray<T> &array,
+                          const std::string &index,
+                          const std::string &path)
+{
+    (void) path;
+
+    k << k.get_buffer_identifier<T>(array.get_buffer()) << "[" << index << "]";
+}
+
+// streams the value of expr at index to a meta_kernel, used to pass the
+// operands of apply() to functions
+template<class Expr>
+struct valarray_expression_value
+{
+    valarray_expression_value(const Expr &expr,
+                              const std::string &index,
+                              const std::string &path)
+        : m_expr(expr),
+          m_index(index),
+          m_path(path)
+    {
+    }
+
+    const Expr &m_expr;
+    std::string m_index;
+    std::string m_path;
+};
+
+template<class Expr>
+inline meta_kernel& operator<<(meta_kernel &k,
+                               const valarray_expression_value<Expr> &value)
+{
+    valarray_emit(k, value.m_expr, value.m_index, value.m_path);
+    return k;
+}
+
+// valarrays are stored by reference in the expression trees, the other
+// nodes (which are temporaries) by value
+template<class Expr>
+struct valarray_expression_storage
+{
+    typedef const Expr type;
+};
+
+template<class T>
+struct valarray_expression_storage<valarray<T> >
+{
+    typedef const valarray<T> &type;
+};
+
+// a scalar operand
+template<class T>
+class valarray_scalar : public valarray_expression<valarray_scalar<T>, T>
+{
+public:
+    explicit valarray_scalar(const T &value)
+        : m_value(value)
+    {
+    }
+
+    size_t size() const
+    {
+        return 0;
+    }
+
+    void emit(meta_kernel &k,
+              const std::string &index,
+              const std::string &path) const
+    {
+        (void) index;
+
+        const std::string name = "_scalar" + path;
+        k.add_set_arg<T>(name, m_value);
+        k << name;
+    }
+
+private:
+    T m_value;
+};
+
+// an operator applied to two operands
+template<class Left, class Right, class T>
+class valarray_binary_expression
+    : public valarray_expression<valarray_binary_expression<Left, Right, T>, T>
+{
+public:
+    valarray_binary_expression(const Left &left,
+                               const char *op,
+                               const Right &right)
+        : m_left(left),
+          m_op(op),
+          m_right(right)
+    {
+        BOOST_ASSERT(left.size() == 0 ||
+                     right.size() == 0 ||
+                     left.size() == right.size());
+    }
+
+    size_t size() const
+    {
+        return (std::max)(m_left.size(), m_right.size());
+    }
+
+    void emit(meta_kernel &k,
+              const std::string &index,
+              const std::string &path) const
+    {
+        k << "(";
+        valarray_emit(k, m_left, index, path + "_0");
+        k << " " << m_op << " ";
+        valarray_emit(k, m_right, index, path + "_1");
+        k << ")";
+    }
+
+private:
+    typename valarray_expression_storage<Left>::type m_left;
+    const char *m_op;
+    typename valarray_expression_storage<Right>::type m_right;
+};
+
+// a function applied to each value of an operand
+template<class Expr, class Function, class T>
+class valarray_function_expression
+    : public valarray_expression<valarray_function_expression<Expr, Function, T>, T>
+{
+public:
+    valarray_function_expression(const Expr &expr, Function function)
+        : m_expr(expr),
+          m_function(function)
+    {
+    }
+
+    size_t size() const
+    {
+        return m_expr.size();
+    }
+
+    void emit(meta_kernel &k,
+              const std::string &index,
+              const std::string &path) const
+    {
+        k << m_function(
+            valarray_expression_value<Expr>(m_expr, index, path + "_0")
+        );
+    }
+
+private:
+    typename valarray_expression_storage<Expr>::type m_expr;
+    Function m_function;
+};
+
+// input of the fused reduction for the values of an expression
+template<class Expr>
+class valarray_expression_input
+{
+public:
+    explicit valarray_expression_input(const Expr &expr)
+        : m_expr(expr)
+    {
+    }
+
+    uint_ vector_width(const device &device) const
+    {
+        (void) device;
+
+        return 1;
+    }
+
+    void load(meta_kernel &k, const std::string &index)
+    {
+        valarray_emit(k, m_expr, index, std::string());
+    }
+
+    // the values are always loaded one by one
+    void load_vector(meta_kernel &k, uint_ width, const std::string &index)
+    {
+        (void) k;
+        (void) width;
+        (void) index;
+    }
+
+    void load_component(meta_kernel &k, const std::string &component)
+    {
+        (void) k;
+        (void) component;
+    }
+
+    void begin_select(meta_kernel &k, const std::string &index)
+    {
+        (void) k;
+        (void) index;
+    }
+
+    void begin_select_component(meta_kernel &k, const std::string &component)
+    {
+        (void) k;
+        (void) component;
+    }
+
+    void end_select(meta_kernel &k)
+    {
+        (void) k;
+    }
+
+private:
+    const Expr &m_expr;
+};
+
+// base class of valarray and of the nodes of valarray expressions
+template<class Derived, class T>
+class valarray_expression
+{
+public:
+    typedef T value_type;
+
+    const Derived& derived() const
+    {
+        return static_cast<const Derived &>(*this);
+    }
+
+    /// Returns the sum of the values of the expression, computed by a
+    /// single reduction without storing the values.
+    T sum() const
+    {
+        if(derived().size() == 0){
+            return T(0);
+        }
+
+        return reduce(plus<T>());
+    }
+
+    /// Returns the smallest value of the expression.
+    T (min)() const
+    {
+        BOOST_ASSERT(derived().size() > 0);
+
+        return reduce(::boost::compute::min<T>());
+    }
+
+    /// Returns the largest value of the expression.
+    T (max)() const
+    {
+        BOOST_ASSERT(derived().size() > 0);
+
+        return reduce(::boost::compute::max<T>());
+    }
+
+    /// Returns an expression applying \p function to each value of the
+    /// expression.
+    template<class UnaryFunction>
+    valarray_function_expression<
+        Derived,
+        UnaryFunction,
+        typename boost::compute::result_of<UnaryFunction(T)>::type
+    >
+    apply(UnaryFunction function) const
+    {
+        return valarray_function_expression<
+            Derived,
+            UnaryFunction,
+            typename boost::compute::result_of<UnaryFunction(T)>::type
+        >(derived(), function);
+    }
+
+private:
+    template<class BinaryFunction>
+    T reduce(BinaryFunction function) const
+    {
+        command_queue &queue = system::default_queue();
+
+        valarray_expression_input<Derived> input(derived());
+        scratch_vector<T> result(1, queue);
+        dispatch_fused_transform_reduce(
+            input, derived().size(), function, result.begin(), queue
+        );
+
+        return read_single_value<T>(result.get_buffer(), 0, queue);
+    }
+};
+
+// evaluates expr into buffer (which may also be used by expr since each
+// value only depends on the values at the same index)
+template<class T, class Expr>
+inline void valarray_evaluate(const Expr &expr,
+                              const buffer &buffer,
+                              command_queue &queue)
+{
+    const size_t size = expr.size();
+    if(size == 0){
+        return;
+    }
+
+    meta_kernel k("valarray_evaluate");
+    k << "const uint i = get_global_id(0);\n" <<
+         k.get_buffer_identifier<T>(buffer) << "[i] = ";
+    valarray_emit(k, expr, "i", std::string());
+    k << ";\n";
+
+    k.exec_1d(queue, 0, size);
+}
+
+} // end detail namespace
+
+#define BOOST_COMPUTE_DETAIL_VALARRAY_OPERATOR(op) \
+    template<class Left, class Right, class T> \
+    inline detail::valarray_binary_expression<Left, Right, T> \
+    operator op(const detail::valarray_expression<Left, T> &left, \
+                const detail::valarray_expression<Right, T> &right) \
+    { \
+        return detail::valarray_binary_expression<Left, Right, T>( \
+            left.derived(), #op, right.derived() \
+        ); \
+    } \
+    \
+    template<class Left, class T> \
+    inline detail::valarray_binary_expression< \
+        Left, detail::valarray_scalar<T>, T \
+    > \
+    operator op(const detail::valarray_expression<Left, T> &left, \
+                const typename Left::value_type &right) \
+    { \
+        return detail::valarray_binary_expression< \
+            Left, detail::valarray_scalar<T>, T \
+        >(left.derived(), #op, detail::valarray_scalar<T>(right)); \
+    } \
+    \
+    template<class Right, class T> \
+    inline detail::valarray_binary_expression< \
+        detail::valarray_scalar<T>, Right, T \
+    > \
+    operator op(const typename Right::value_type &left, \
+                const detail::valarray_expression<Right, T> &right) \
+    { \
+        return detail::valarray_binary_expression< \
+            detail::valarray_scalar<T>, Right, T \
+        >(detail::valarray_scalar<T>(left), #op, right.derived()); \
+    }
+
+BOOST_COMPUTE_DETAIL_VALARRAY_OPERATOR(+)
+BOOST_COMPUTE_DETAIL_VALARRAY_OPERATOR(-)
+BOOST_COMPUTE_DETAIL_VALARRAY_OPERATOR(*)
+BOOST_COMPUTE_DETAIL_VALARRAY_OPERATOR(/)
+
+#undef BOOST_COMPUTE_DETAIL_VALARRAY_OPERATOR
+
+/// Returns an expression negating each value of \p expr.
+template<class Expr, class T>
+inline detail::valarray_binary_expression<detail::valarray_scalar<T>, Expr, T>
+operator-(const detail::valarray_expression<Expr, T> &expr)
+{
+    return detail::valarray_binary_expression<detail::valarray_scalar<T>, Expr, T>(
+        detail::valarray_scalar<T>(T(0)), "-", expr.derived()
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_DETAIL_VALARRAY_EXPRESSION_HPP
@@ -11,16 +11,52 @@
 #ifndef BOOST_COMPUTE_CONTAINER_DYNAMIC_BITSET_HPP
 #define BOOST_COMPUTE_CONTAINER_DYNAMIC_BITSET_HPP
 
+#include <climits>
+#include <iterator>
+#include <string>
+
+#include <boost/assert.hpp>
+#include <boost/lexical_cast.hpp>
+
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/algorithm/any_of.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
 #include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/transform.hpp>
 #include <boost/compute/algorithm/transform_reduce.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/functional/integer.hpp>
 #include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
+namespace detail {
+
+// selects the values whose bit is set in a bitset (for using a
+// dynamic_bitset as a stencil)
+template<class Block>
+struct dynamic_bitset_selector
+{
+    dynamic_bitset_selector(buffer_iterator<Block> blocks_)
+        : blocks(blocks_)
+    {
+    }
+
+    void select(meta_kernel &k) const
+    {
+        const size_t bits_per_block = sizeof(Block) * CHAR_BIT;
+
+        k << "((" << blocks[k.expr<uint_>("(i) / " + boost::lexical_cast<std::string>(bits_per_block))] <<
+             " >> ((i) % " << bits_per_block << ")) & 1)";
+    }
+
+    buffer_iterator<Block> blocks;
+};
+
+} // end detail namespace
 
 /// \class dynamic_bitset
 /// \brief The dynamic_bitset class contains a resizable bit array.
@@ -50,8 +86,10 @@ public:
     /// Creates a new dynamic bitset with storage for \p size bits. Initializes
     /// all bits to zero.
     dynamic_bitset(size_type size, command_queue &queue)
-        : m_bits(size / sizeof(block_type), queue.get_context()),
-          m_size(size)
+        : m_bits(_block_count(size), queue.get_context()),
+          m_size(size),
+          m_ranks(queue.get_context()),
+          m_ranks_valid(false)
     {
         // initialize all bits to zero
         reset(queue);
@@ -60,7 +98,9 @@ public:
     /// Creates a new dynamic bitset as a copy of \p other.
     dynamic_bitset(const dynamic_bitset &other)
         : m_bits(other.m_bits),
-          m_size(other.m_size)
+          m_size(other.m_size),
+          m_ranks(other.m_bits.get_buffer().get_context()),
+          m_ranks_valid(false)
     {
     }
 
@@ -70,6 +110,7 @@ public:
         if(this != &other){
             m_bits = other.m_bits;
             m_size = other.m_size;
+            m_ranks_valid = false;
         }
 
         return *this;
@@ -125,7 +166,7 @@ public:
     {
         // resize bits
         const size_type current_block_count = m_bits.size();
-        m_bits.resize(num_bits * bits_per_block, queue);
+        m_bits.resize(_block_count(num_bits), queue);
 
         // fill new block with zeros (if new blocks were added)
         const size_type new_block_count = m_bits.size();
@@ -140,6 +181,53 @@ public:
 
         // store new size
         m_size = num_bits;
+        m_ranks_valid = false;
+
+        // clear the bits past the end when shrinking
+        _clear_unused_bits(queue);
+    }
+
+    /// Resizes the bitset to the size of the range [\p first, \p last) and
+    /// sets each bit to the result of \p predicate for the value at its
+    /// position.
+    ///
+    /// Each work-item evaluates the predicate for the values of one block,
+    /// so masks are stored with one bit per value instead of one byte or
+    /// int. For example, to mark the positive values of a vector:
+    /// \code
+    /// boost::compute::dynamic_bitset<> mask(0, queue);
+    /// mask.assign(vec.begin(), vec.end(), _1 > 0, queue);
+    /// \endcode
+    template<class InputIterator, class Predicate>
+    void assign(InputIterator first,
+                InputIterator last,
+                Predicate predicate,
+                command_queue &queue)
+    {
+        const size_type count = detail::iterator_range_size(first, last);
+
+        m_bits.resize_uninitialized(_block_count(count));
+        m_size = count;
+        m_ranks_valid = false;
+        if(count == 0){
+            return;
+        }
+
+        detail::meta_kernel k("dynamic_bitset_assign");
+        k.add_set_arg<const uint_>("count", static_cast<uint_>(count));
+        k <<
+            "const uint block = get_global_id(0);\n" <<
+            "const uint begin = block * " << bits_per_block << ";\n" <<
+            "const uint end = min(begin + " << bits_per_block << ", count);\n" <<
+            k.decl<block_type>("bits") << " = 0;\n" <<
+            "for(uint i = begin; i < end; i++){\n" <<
+            "    if(" << predicate(first[k.var<uint_>("i")]) << "){\n" <<
+            "        bits |= ((" << k.type<block_type>() << ") 1) << (i - begin);\n" <<
+            "    }\n" <<
+            "}\n" <<
+            m_bits.begin()[k.var<uint_>("block")] << " = bits;\n";
+
+        k.exec_1d(queue, 0, m_bits.size());
     }
 
     /// Sets the bit at position \p n to \c true.
@@ -168,6 +256,8 @@ public:
 
         // store new block
         copy_n(&block_value, 1, m_bits.begin() + block, queue);
+
+        m_ranks_valid = false;
     }
 
     /// Returns \c true if the bit at position \p n is set (i.e. '1').
@@ -202,10 +292,141 @@ public:
         return !any(queue);
     }
 
+    /// Flips the value of every bit in the bitset.
+    void flip(command_queue &queue)
+    {
+        _apply("~a", 0, queue);
+        _clear_unused_bits(queue);
+    }
+
+    /// Sets each bit to the bitwise and of itself and the bit of \p other.
+    ///
+    /// Both bitsets must have the same size. The blocks are combined with
+    /// one work-item each.
+    void bit_and(const dynamic_bitset &other, command_queue &queue)
+    {
+        _apply("a & b", &other, queue);
+    }
+
+    /// Sets each bit to the bitwise or of itself and the bit of \p other.
+    void bit_or(const dynamic_bitset &other, command_queue &queue)
+    {
+        _apply("a | b", &other, queue);
+    }
+
+    /// Sets each bit to the bitwise xor of itself and the bit of \p other.
+    void bit_xor(const dynamic_bitset &other, command_queue &queue)
+    {
+        _apply("a ^ b", &other, queue);
+    }
+
+    /// For each position in the range [\p first, \p last) stores the
+    /// number of set bits before the position (its rank) in the range
+    /// beginning at \p result.
+    ///
+    /// The ranks are computed from the number of set bits before each block
+    /// which is built when needed and kept until the bitset is modified.
+    /// Positions must be in [0, \c size()].
+    template<class InputIterator, class OutputIterator>
+    OutputIterator rank(InputIterator first,
+                        InputIterator last,
+                        OutputIterator result,
+                        command_queue &queue) const
+    {
+        const size_type count = detail::iterator_range_size(first, last);
+        if(count == 0){
+            return result;
+        }
+
+        _build_ranks(queue);
+
+        detail::meta_kernel k("dynamic_bitset_rank");
+        k <<
+            "const uint i = get_global_id(0);\n" <<
+            "const uint position = " << first[k.var<uint_>("i")] << ";\n" <<
+            "const uint block = position / " << bits_per_block << ";\n" <<
+            "const uint bit = position % " << bits_per_block << ";\n" <<
+            "uint rank = " << m_ranks.begin()[k.var<uint_>("block")] << ";\n" <<
+            "if(bit != 0){\n" <<
+            "    " << k.decl<const block_type>("mask") << " = " <<
+                       "(((" << k.type<block_type>() << ") 1) << bit) - 1;\n" <<
+            "    rank += popcount(" << m_bits.begin()[k.var<uint_>("block")] << " & mask);\n" <<
+            "}\n" <<
+            result[k.var<uint_>("i")] << " = rank;\n";
+
+        k.exec_1d(queue, 0, count);
+
+        return result + static_cast<typename std::iterator_traits<OutputIterator>::difference_type>(count);
+    }
+
+    /// For each index n in the range [\p first, \p last) stores the
+    /// position of the n-th set bit (counting from zero) in the range
+    /// beginning at \p result, or \c size() if fewer bits are set.
+    ///
+    /// Each work-item finds the block of its bit with a binary search over
+    /// the number of set bits before each block.
+    ///
+    /// \see rank()
+    template<class InputIterator, class OutputIterator>
+    OutputIterator select(InputIterator first,
+                          InputIterator last,
+                          OutputIterator result,
+                          command_queue &queue) const
+    {
+        const size_type count = detail::iterator_range_size(first, last);
+        if(count == 0){
+            return result;
+        }
+
+        _build_ranks(queue);
+
+        detail::meta_kernel k("dynamic_bitset_select");
+        k.add_set_arg<const uint_>("blocks", static_cast<uint_>(num_blocks()));
+        k.add_set_arg<const uint_>("size", static_cast<uint_>(m_size));
+        k <<
+            "const uint i = get_global_id(0);\n" <<
+            "uint n = " << first[k.var<uint_>("i")] << ";\n" <<
+            "uint position = size;\n" <<
+            "if(n < " << m_ranks.begin()[k.var<uint_>("blocks")] << "){\n" <<
+            // find the last block with fewer than n + 1 set bits before it
+            "    uint lo = 0;\n" <<
+            "    uint hi = blocks;\n" <<
+            "    while(hi - lo > 1){\n" <<
+            "        const uint mid = lo + (hi - lo) / 2;\n" <<
+            "        if(" << m_ranks.begin()[k.var<uint_>("mid")] << " <= n){\n" <<
+            "            lo = mid;\n" <<
+            "        }\n" <<
+            "        else {\n" <<
+            "            hi = mid;\n" <<
+            "        }\n" <<
+            "    }\n" <<
+            "    n -= " << m_ranks.begin()[k.var<uint_>("lo")] << ";\n" <<
+            // clear the lower set bits of the block
+            "    " << k.decl<block_type>("x") << " = " << m_bits.begin()[k.var<uint_>("lo")] << ";\n" <<
+            "    for(uint j = 0; j < n; j++){\n" <<
+            "        x &= x - 1;\n" <<
+            "    }\n" <<
+            "    position = lo * " << bits_per_block << " + popcount((x & (~x + 1)) - 1);\n" <<
+            "}\n" <<
+            result[k.var<uint_>("i")] << " = position;\n";
+
+        k.exec_1d(queue, 0, count);
+
+        return result + static_cast<typename std::iterator_traits<OutputIterator>::difference_type>(count);
+    }
+
+    /// Returns the underlying memory buffer holding the blocks.
+    const buffer& get_buffer() const
+    {
+        return m_bits.get_buffer();
+    }
+
     /// Sets all of the bits in the bitset to zero.
     void reset(command_queue &queue)
     {
         fill(m_bits.begin(), m_bits.end(), block_type(0), queue);
+
+        m_ranks_valid = false;
     }
 
     /// Sets the bit at position \p n to zero.
@@ -218,6 +439,8 @@ public:
     void clear()
     {
         m_bits.clear();
+        m_size = 0;
+        m_ranks_valid = false;
     }
 
     /// Returns the allocator used to allocate storage for the bitset.
@@ -226,11 +449,115 @@ public:
         return m_bits.get_allocator();
     }
 
+    /// \internal_
+    detail::dynamic_bitset_selector<block_type> _selector() const
+    {
+        return detail::dynamic_bitset_selector<block_type>(m_bits.begin());
+    }
+
+private:
+    /// \internal_
+    static size_type _block_count(size_type num_bits)
+    {
+        return (num_bits + bits_per_block - 1) / bits_per_block;
+    }
+
+    /// \internal_
+    ///
+    /// Sets each block a to the result of expression (of a and the block b
+    /// of other) with one work-item per block.
+    void _apply(const char *expression,
+                const dynamic_bitset *other,
+                command_queue &queue)
+    {
+        BOOST_ASSERT(other == 0 || other->size() == size());
+
+        if(m_bits.empty()){
+            return;
+        }
+
+        detail::meta_kernel k("dynamic_bitset_apply");
+        k <<
+            "const uint i = get_global_id(0);\n" <<
+            k.decl<const block_type>("a") << " = " << m_bits.begin()[k.var<uint_>("i")] << ";\n";
+        if(other){
+            k <<
+            k.decl<const block_type>("b") << " = " << other->m_bits.begin()[k.var<uint_>("i")] << ";\n";
+        }
+        k <<
+            m_bits.begin()[k.var<uint_>("i")] << " = " << expression << ";\n";
+
+        k.exec_1d(queue, 0, m_bits.size());
+
+        m_ranks_valid = false;
+    }
+
+    /// \internal_
+    ///
+    /// Sets the bits of the last block past the end of the bitset to zero.
+    void _clear_unused_bits(command_queue &queue)
+    {
+        const size_type used_bits = m_size % bits_per_block;
+        if(used_bits == 0 || m_bits.empty()){
+            return;
+        }
+
+        block_type block_value;
+        copy_n(m_bits.end() - 1, 1, &block_value, queue);
+        block_value &= static_cast<block_type>((block_type(1) << used_bits) - 1);
+        copy_n(&block_value, 1, m_bits.end() - 1, queue);
+    }
+
+    /// \internal_
+    ///
+    /// Stores the number of set bits before each block (and the total at
+    /// the end) in m_ranks.
+    void _build_ranks(command_queue &queue) const
+    {
+        if(m_ranks_valid){
+            return;
+        }
+
+        m_ranks.resize_uninitialized(m_bits.size() + 1);
+        fill_n(m_ranks.end() - 1, 1, uint_(0), queue);
+        transform(
+            m_bits.begin(), m_bits.end(), m_ranks.begin(), popcount<block_type>(), queue
+        );
+        exclusive_scan(m_ranks.begin(), m_ranks.end(), m_ranks.begin(), queue);
+
+        m_ranks_valid = true;
+    }
+
 private:
     container_type m_bits;
     size_type m_size;
+    mutable vector<uint_> m_ranks;
+    mutable bool m_ranks_valid;
 };
 
+/// Copies the values in the range [\p first, \p last) whose bit in
+/// \p stencil is set to the range beginning at \p result.
+///
+/// \see copy_if()
+template<class InputIterator, class Block, class Alloc, class OutputIterator>
+inline OutputIterator copy_if(InputIterator first,
+                              InputIterator last,
+                              const dynamic_bitset<Block, Alloc> &stencil,
+                              OutputIterator result,
+                              command_queue &queue = system::default_queue())
+{
+    BOOST_ASSERT(detail::iterator_range_size(first, last) <= stencil.size());
+
+    return detail::stream_compact(
+        first,
+        detail::iterator_range_size(first, last),
+        result,
+        stencil._selector(),
+        false,
+        queue
+    );
+}
+
 } // end compute namespace
 } // end boost namespace
 
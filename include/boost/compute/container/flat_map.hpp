@@ -12,6 +12,7 @@
 #define BOOST_COMPUTE_CONTAINER_FLAT_MAP_HPP
 
 #include <cstddef>
+#include <iterator>
 #include <utility>
 #include <exception>
 
@@ -19,14 +20,20 @@
 #include <boost/throw_exception.hpp>
 
 #include <boost/compute/exception.hpp>
-#include <boost/compute/algorithm/find.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
 #include <boost/compute/algorithm/lower_bound.hpp>
+#include <boost/compute/algorithm/merge.hpp>
+#include <boost/compute/algorithm/stable_sort.hpp>
+#include <boost/compute/algorithm/unique_copy.hpp>
 #include <boost/compute/algorithm/upper_bound.hpp>
+#include <boost/compute/algorithm/detail/vectorized_binary_search.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/functional/get.hpp>
 #include <boost/compute/iterator/transform_iterator.hpp>
+#include <boost/compute/lambda.hpp>
 #include <boost/compute/types/pair.hpp>
 #include <boost/compute/detail/buffer_value.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
@@ -200,6 +207,57 @@ public:
         return result;
     }
 
+    /// Inserts the key-value pairs in the range [\p first, \p last).
+    ///
+    /// The new key-value pairs are sorted and then merged with the key-value pairs of the
+    /// container, so inserting many key-value pairs at once moves every stored
+    /// value only once. When keys are equal the value of the first pair with a key is kept.
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last, command_queue &queue)
+    {
+        using ::boost::compute::lambda::_1;
+        using ::boost::compute::lambda::_2;
+        using ::boost::compute::lambda::get;
+
+        const size_type count = detail::iterator_range_size(first, last);
+        if(count == 0){
+            return;
+        }
+
+        const context &context = m_vector.get_allocator().get_context();
+
+        // sort the new values, keeping the order of equal keys
+        vector_type batch(first, last, queue);
+        ::boost::compute::stable_sort(
+            batch.begin(), batch.end(), get<0>(_1) < get<0>(_2), queue
+        );
+
+        // merge them after the stored values with equal keys
+        vector_type merged(size() + count, context);
+        ::boost::compute::merge(
+            begin(), end(), batch.begin(), batch.end(), merged.begin(),
+            get<0>(_1) < get<0>(_2), queue
+        );
+
+        // keep the first value for each key (the stored values are in
+        // merged, so they need not be preserved)
+        m_vector.resize_uninitialized(merged.size());
+        iterator new_end = ::boost::compute::unique_copy(
+            merged.begin(), merged.end(), m_vector.begin(),
+            get<0>(_1) == get<0>(_2), queue
+        );
+        m_vector.resize(static_cast<size_type>(std::distance(begin(), new_end)), queue);
+    }
+
+    /// \overload
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        command_queue queue = m_vector.default_queue();
+        insert(first, last, queue);
+        queue.finish();
+    }
+
     iterator erase(const const_iterator &position, command_queue &queue)
     {
         return erase(position, position + 1, queue);
@@ -243,14 +301,17 @@ public:
 
     iterator find(const key_type &value, command_queue &queue)
     {
-        ::boost::compute::get<0> get_key;
+        iterator position = lower_bound(value, queue);
 
-        return ::boost::compute::find(
-                   ::boost::compute::make_transform_iterator(begin(), get_key),
-                   ::boost::compute::make_transform_iterator(end(), get_key),
-                   value,
-                   queue
-               ).base();
+        if(position != end()){
+            value_type current_value;
+            ::boost::compute::copy_n(position, 1, &current_value, queue);
+            if(current_value.first == value){
+                return position;
+            }
+        }
+
+        return end();
     }
 
     iterator find(const key_type &value)
@@ -263,14 +324,17 @@ public:
 
     const_iterator find(const key_type &value, command_queue &queue) const
     {
-        ::boost::compute::get<0> get_key;
+        const_iterator position = lower_bound(value, queue);
 
-        return ::boost::compute::find(
-                   ::boost::compute::make_transform_iterator(begin(), get_key),
-                   ::boost::compute::make_transform_iterator(end(), get_key),
-                   value,
-                   queue
-               ).base();
+        if(position != end()){
+            value_type current_value;
+            ::boost::compute::copy_n(position, 1, &current_value, queue);
+            if(current_value.first == value){
+                return position;
+            }
+        }
+
+        return end();
     }
 
     const_iterator find(const key_type &value) const
@@ -281,6 +345,44 @@ public:
         return iter;
     }
 
+    /// Finds each of the keys in the range [\p keys_first, \p keys_last)
+    /// and stores the index of its element (or \c size() if the key is not
+    /// found) in the range beginning at \p result.
+    ///
+    /// All of the keys are searched for with a single kernel launch.
+    ///
+    /// \return \c OutputIterator to the end of the result range
+    template<class KeyIterator, class OutputIterator>
+    OutputIterator find(KeyIterator keys_first,
+                        KeyIterator keys_last,
+                        OutputIterator result,
+                        command_queue &queue) const
+    {
+        ::boost::compute::get<0> get_key;
+
+        return detail::vectorized_binary_search(
+            ::boost::compute::make_transform_iterator(begin(), get_key),
+            ::boost::compute::make_transform_iterator(end(), get_key),
+            keys_first,
+            keys_last,
+            result,
+            detail::vectorized_search_find,
+            queue
+        );
+    }
+
+    /// \overload
+    template<class KeyIterator, class OutputIterator>
+    OutputIterator find(KeyIterator keys_first,
+                        KeyIterator keys_last,
+                        OutputIterator result) const
+    {
+        command_queue queue = m_vector.default_queue();
+        OutputIterator end = find(keys_first, keys_last, result, queue);
+        queue.finish();
+        return end;
+    }
+
     size_type count(const key_type &value, command_queue &queue) const
     {
         return find(value, queue) != end() ? 1 : 0;
@@ -12,12 +12,19 @@
 #define BOOST_COMPUTE_CONTAINER_FLAT_SET_HPP
 
 #include <cstddef>
+#include <iterator>
 #include <utility>
 
-#include <boost/compute/algorithm/find.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
 #include <boost/compute/algorithm/lower_bound.hpp>
+#include <boost/compute/algorithm/merge.hpp>
+#include <boost/compute/algorithm/stable_sort.hpp>
+#include <boost/compute/algorithm/unique_copy.hpp>
 #include <boost/compute/algorithm/upper_bound.hpp>
+#include <boost/compute/algorithm/detail/vectorized_binary_search.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
@@ -189,6 +196,53 @@ public:
         return result;
     }
 
+    /// Inserts the values in the range [\p first, \p last).
+    ///
+    /// The new values are sorted and then merged with the values of the
+    /// container, so inserting many values at once moves every stored
+    /// value only once. When keys are equal values already in the set are kept.
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last, command_queue &queue)
+    {
+        const size_type count = detail::iterator_range_size(first, last);
+        if(count == 0){
+            return;
+        }
+
+        const context &context = m_vector.get_allocator().get_context();
+
+        // sort the new values, keeping the order of equal keys
+        vector<T> batch(first, last, queue);
+        ::boost::compute::stable_sort(
+            batch.begin(), batch.end(), ::boost::compute::less<value_type>(), queue
+        );
+
+        // merge them after the stored values with equal keys
+        vector<T> merged(size() + count, context);
+        ::boost::compute::merge(
+            begin(), end(), batch.begin(), batch.end(), merged.begin(),
+            ::boost::compute::less<value_type>(), queue
+        );
+
+        // keep the first value for each key (the stored values are in
+        // merged, so they need not be preserved)
+        m_vector.resize_uninitialized(merged.size());
+        iterator new_end = ::boost::compute::unique_copy(
+            merged.begin(), merged.end(), m_vector.begin(),
+            ::boost::compute::equal_to<value_type>(), queue
+        );
+        m_vector.resize(static_cast<size_type>(std::distance(begin(), new_end)), queue);
+    }
+
+    /// \overload
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        command_queue queue = m_vector.default_queue();
+        insert(first, last, queue);
+        queue.finish();
+    }
+
     iterator erase(const const_iterator &position, command_queue &queue)
     {
         return erase(position, position + 1, queue);
@@ -240,7 +294,17 @@ public:
 
     iterator find(const key_type &value, command_queue &queue)
     {
-        return ::boost::compute::find(begin(), end(), value, queue);
+        iterator position = lower_bound(value, queue);
+
+        if(position != end()){
+            value_type current_value;
+            ::boost::compute::copy_n(position, 1, &current_value, queue);
+            if(current_value == value){
+                return position;
+            }
+        }
+
+        return end();
     }
 
     iterator find(const key_type &value)
@@ -253,7 +317,17 @@ public:
 
     const_iterator find(const key_type &value, command_queue &queue) const
     {
-        return ::boost::compute::find(begin(), end(), value, queue);
+        const_iterator position = lower_bound(value, queue);
+
+        if(position != end()){
+            value_type current_value;
+            ::boost::compute::copy_n(position, 1, &current_value, queue);
+            if(current_value == value){
+                return position;
+            }
+        }
+
+        return end();
     }
 
     const_iterator find(const key_type &value) const
@@ -264,6 +338,42 @@ public:
         return iter;
     }
 
+    /// Finds each of the keys in the range [\p keys_first, \p keys_last)
+    /// and stores the index of its element (or \c size() if the key is not
+    /// found) in the range beginning at \p result.
+    ///
+    /// All of the keys are searched for with a single kernel launch.
+    ///
+    /// \return \c OutputIterator to the end of the result range
+    template<class KeyIterator, class OutputIterator>
+    OutputIterator find(KeyIterator keys_first,
+                        KeyIterator keys_last,
+                        OutputIterator result,
+                        command_queue &queue) const
+    {
+        return detail::vectorized_binary_search(
+            begin(),
+            end(),
+            keys_first,
+            keys_last,
+            result,
+            detail::vectorized_search_find,
+            queue
+        );
+    }
+
+    /// \overload
+    template<class KeyIterator, class OutputIterator>
+    OutputIterator find(KeyIterator keys_first,
+                        KeyIterator keys_last,
+                        OutputIterator result) const
+    {
+        command_queue queue = m_vector.default_queue();
+        OutputIterator end = find(keys_first, keys_last, result, queue);
+        queue.finish();
+        return end;
+    }
+
     size_type count(const key_type &value, command_queue &queue) const
     {
         return find(value, queue) != end() ? 1 : 0;
@@ -0,0 +1,177 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_MAPPED_DOUBLE_BUFFER_HPP
+#define BOOST_COMPUTE_CONTAINER_MAPPED_DOUBLE_BUFFER_HPP
+
+#include <cstddef>
+
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class mapped_double_buffer
+/// \brief Two mapped staging buffers for overlapping host and device work.
+///
+/// The mapped_double_buffer class holds two buffers of \c size() values
+/// allocated with \c buffer::alloc_host_ptr, which are accessed without
+/// copies on devices sharing memory with the host (e.g. integrated GPUs
+/// and CPUs). At any time one of the buffers (the front buffer) is mapped
+/// for the host at \c host_data() and the other one (the back buffer) is
+/// used by the device in the range [\c begin(), \c end()).
+///
+/// swap() hands the front buffer to the device and maps the back buffer
+/// for the host once the commands using it finished. This way the host
+/// processes one chunk while the device processes the chunk before:
+/// \code
+/// boost::compute::mapped_double_buffer<float> staging(chunk_size, CL_MAP_WRITE, queue);
+///
+/// for(size_t chunk = 0; chunk < chunks; chunk++){
+///     // fill the chunk on the host
+///     read_chunk(chunk, staging.host_data());
+///
+///     // process the chunk on the device while the next one is read
+///     boost::compute::future<void> mapped = staging.swap();
+///     boost::compute::transform(staging.begin(), staging.end(), result.begin(), op, queue);
+///     mapped.wait();
+/// }
+/// \endcode
+///
+/// Results of the device are read in the same way by mapping the buffers
+/// with \c CL_MAP_READ and writing them on the device before each swap().
+///
+/// All commands using the buffers must be enqueued to the in-order queue
+/// of the double buffer.
+///
+/// \see mapped_view
+template<class T>
+class mapped_double_buffer : boost::noncopyable
+{
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef buffer_iterator<T> iterator;
+
+    /// Creates two buffers of \p size values and maps the front buffer
+    /// with \p flags for the host.
+    mapped_double_buffer(size_type size, cl_map_flags flags, command_queue &queue)
+        : m_queue(queue),
+          m_size(size),
+          m_flags(flags),
+          m_front(0)
+    {
+        BOOST_ASSERT(size > 0);
+
+        for(size_t i = 0; i < 2; i++){
+            m_buffers[i] = buffer(
+                queue.get_context(),
+                size * sizeof(T),
+                buffer::read_write | buffer::alloc_host_ptr
+            );
+            m_host_ptrs[i] = 0;
+        }
+
+        m_host_ptrs[m_front] =
+            m_queue.enqueue_map_buffer(m_buffers[m_front], m_flags, 0, size * sizeof(T));
+    }
+
+    /// Unmaps the front buffer and destroys the buffers.
+    ~mapped_double_buffer()
+    {
+        if(m_host_ptrs[m_front]){
+            m_queue.enqueue_unmap_buffer(m_buffers[m_front], m_host_ptrs[m_front]);
+        }
+    }
+
+    /// Returns the number of values in each buffer.
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /// Returns the host pointer of the front buffer.
+    ///
+    /// After swap() the pointer may only be accessed once the returned
+    /// future is ready.
+    T* host_data()
+    {
+        return static_cast<T *>(m_host_ptrs[m_front]);
+    }
+
+    /// \overload
+    const T* host_data() const
+    {
+        return static_cast<const T *>(m_host_ptrs[m_front]);
+    }
+
+    /// Returns an iterator to the first value of the back buffer.
+    iterator begin() const
+    {
+        return make_buffer_iterator<T>(m_buffers[1 - m_front], 0);
+    }
+
+    /// Returns an iterator to one past the last value of the back buffer.
+    iterator end() const
+    {
+        return make_buffer_iterator<T>(m_buffers[1 - m_front], m_size);
+    }
+
+    /// Returns the back buffer.
+    const buffer& get_buffer() const
+    {
+        return m_buffers[1 - m_front];
+    }
+
+    /// Exchanges the front and back buffers without blocking.
+    ///
+    /// The back buffer is mapped for the host after the commands enqueued
+    /// so far (which may use it) and the front buffer is unmapped, so
+    /// commands enqueued afterwards can use it through begin() and end().
+    /// The returned future is ready once host_data() can be accessed.
+    future<void> swap()
+    {
+        const size_t back = 1 - m_front;
+
+        // the map is enqueued before the commands using the unmapped
+        // buffer, so the host does not wait for them
+        event map_event;
+        m_host_ptrs[back] = m_queue.enqueue_map_buffer_async(
+            m_buffers[back], m_flags, 0, m_size * sizeof(T), map_event
+        );
+
+        m_queue.enqueue_unmap_buffer(m_buffers[m_front], m_host_ptrs[m_front]);
+        m_host_ptrs[m_front] = 0;
+
+        m_front = back;
+
+        return future<void>(map_event);
+    }
+
+private:
+    command_queue m_queue;
+    size_type m_size;
+    cl_map_flags m_flags;
+    size_t m_front;
+    buffer m_buffers[2];
+    void *m_host_ptrs[2];
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_MAPPED_DOUBLE_BUFFER_HPP
@@ -21,6 +21,7 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/context.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/future.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
 
 namespace boost {
@@ -212,6 +213,56 @@ public:
         m_mapped_ptr = 0;
     }
 
+    /// Enqueues a command to map the buffer into the host address space
+    /// without waiting for it. The host data may only be accessed once the
+    /// returned future is ready.
+    ///
+    /// Other host work can be done while the commands enqueued before the
+    /// map (e.g. the kernels writing the buffer) finish.
+    ///
+    /// \see_opencl_ref{clEnqueueMapBuffer}
+    future<void> map_async(cl_map_flags flags, command_queue &queue)
+    {
+        BOOST_ASSERT(m_mapped_ptr == 0);
+
+        event map_event;
+        m_mapped_ptr = queue.enqueue_map_buffer_async(
+            m_buffer, flags, 0, m_buffer.size(), map_event
+        );
+
+        return future<void>(map_event);
+    }
+
+    /// Enqueues a command to map the buffer into the host address space
+    /// for reading and writing without waiting for it.
+    future<void> map_async(command_queue &queue)
+    {
+        return map_async(CL_MAP_READ | CL_MAP_WRITE, queue);
+    }
+
+    /// Enqueues a command to unmap the buffer from the host address space
+    /// and returns a future which is ready once the data is available to
+    /// the device. Commands enqueued afterwards on \p queue may use the
+    /// buffer without waiting for the future.
+    ///
+    /// \see_opencl_ref{clEnqueueUnmapMemObject}
+    future<void> unmap_async(command_queue &queue)
+    {
+        BOOST_ASSERT(m_mapped_ptr != 0);
+
+        event unmap_event = queue.enqueue_unmap_buffer_async(m_buffer, m_mapped_ptr);
+
+        m_mapped_ptr = 0;
+
+        return future<void>(unmap_event);
+    }
+
+    /// Returns \c true if the buffer is mapped into the host address space.
+    bool is_mapped() const
+    {
+        return m_mapped_ptr != 0;
+    }
+
 private:
     /// \internal_
     static buffer _make_mapped_buffer(T *host_ptr,
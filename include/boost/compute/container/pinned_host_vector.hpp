@@ -0,0 +1,350 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_PINNED_HOST_VECTOR_HPP
+#define BOOST_COMPUTE_CONTAINER_PINNED_HOST_VECTOR_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/assert.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/detail/pinned_host_pool.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class pinned_host_vector
+/// \brief A resizable array of values in pinned host memory.
+///
+/// The pinned_host_vector<T> class stores its values in the host memory of
+/// a buffer allocated with \c CL_MEM_ALLOC_HOST_PTR, which stays mapped for
+/// the lifetime of the vector. The values are accessed directly through
+/// plain pointers (its iterators are \c T*).
+///
+/// Pinned (page-locked) memory can be transferred to and from the device
+/// by DMA. copy() and copy_async() recognize ranges of a
+/// pinned_host_vector and pass them to the driver directly, instead of
+/// staging large copies through a pinned buffer as for pageable memory
+/// (e.g. \c std::vector).
+///
+/// Pinning memory is expensive, so the memory of destroyed vectors is kept
+/// mapped in a pool for the context and reused by the next vectors.
+///
+/// For example, to read the results of each frame into the same pinned
+/// memory:
+/// \code
+/// boost::compute::pinned_host_vector<float> host(device_vector.size(), context);
+///
+/// boost::compute::copy(
+///     device_vector.begin(), device_vector.end(), host.begin(), queue
+/// );
+/// \endcode
+///
+/// The value type must be trivially copyable.
+///
+/// \see vector, copy(), copy_async()
+template<class T>
+class pinned_host_vector
+{
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    /// Creates an empty vector in \p context.
+    explicit pinned_host_vector(const context &context = system::default_context())
+        : m_pool(detail::pinned_host_pool::get_global_pool(context)),
+          m_size(0)
+    {
+    }
+
+    /// Creates a vector with space for \p count (uninitialized) values in
+    /// \p context.
+    explicit pinned_host_vector(size_type count,
+                                const context &context = system::default_context())
+        : m_pool(detail::pinned_host_pool::get_global_pool(context)),
+          m_size(0)
+    {
+        resize(count);
+    }
+
+    /// Creates a vector with \p count copies of \p value in \p context.
+    pinned_host_vector(size_type count,
+                       const T &value,
+                       const context &context = system::default_context())
+        : m_pool(detail::pinned_host_pool::get_global_pool(context)),
+          m_size(0)
+    {
+        resize(count, value);
+    }
+
+    /// Creates a vector with the values in the host range [\p first,
+    /// \p last) in \p context.
+    template<class InputIterator>
+    pinned_host_vector(InputIterator first,
+                       InputIterator last,
+                       const context &context = system::default_context(),
+                       typename boost::disable_if<
+                           boost::is_integral<InputIterator>
+                       >::type* = 0)
+        : m_pool(detail::pinned_host_pool::get_global_pool(context)),
+          m_size(0)
+    {
+        assign(first, last);
+    }
+
+    /// Creates a new vector as a copy of \p other.
+    pinned_host_vector(const pinned_host_vector<T> &other)
+        : m_pool(other.m_pool),
+          m_size(0)
+    {
+        assign(other.begin(), other.end());
+    }
+
+    /// Copies the values of \p other to \c *this.
+    pinned_host_vector<T>& operator=(const pinned_host_vector<T> &other)
+    {
+        if(this != &other){
+            assign(other.begin(), other.end());
+        }
+
+        return *this;
+    }
+
+    /// Destroys the vector, its memory is returned to the pool.
+    ~pinned_host_vector()
+    {
+        if(m_block.ptr){
+            m_pool->release(m_block);
+        }
+    }
+
+    /// Replaces the values of the vector with the values in [\p first,
+    /// \p last).
+    template<class InputIterator>
+    void assign(InputIterator first, InputIterator last)
+    {
+        const size_type count =
+            static_cast<size_type>(std::distance(first, last));
+
+        reserve(count);
+        std::copy(first, last, data());
+        m_size = count;
+    }
+
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// Returns the number of values the vector can hold without
+    /// allocating more memory.
+    size_type capacity() const
+    {
+        return m_block.size / sizeof(T);
+    }
+
+    /// Returns a pointer to the values of the vector.
+    T* data()
+    {
+        return static_cast<T *>(m_block.ptr);
+    }
+
+    /// \overload
+    const T* data() const
+    {
+        return static_cast<const T *>(m_block.ptr);
+    }
+
+    iterator begin()
+    {
+        return data();
+    }
+
+    const_iterator begin() const
+    {
+        return data();
+    }
+
+    const_iterator cbegin() const
+    {
+        return data();
+    }
+
+    iterator end()
+    {
+        return data() + m_size;
+    }
+
+    const_iterator end() const
+    {
+        return data() + m_size;
+    }
+
+    const_iterator cend() const
+    {
+        return data() + m_size;
+    }
+
+    reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    reference operator[](size_type index)
+    {
+        BOOST_ASSERT(index < m_size);
+
+        return data()[index];
+    }
+
+    const_reference operator[](size_type index) const
+    {
+        BOOST_ASSERT(index < m_size);
+
+        return data()[index];
+    }
+
+    reference front()
+    {
+        return (*this)[0];
+    }
+
+    const_reference front() const
+    {
+        return (*this)[0];
+    }
+
+    reference back()
+    {
+        return (*this)[m_size - 1];
+    }
+
+    const_reference back() const
+    {
+        return (*this)[m_size - 1];
+    }
+
+    /// Allocates memory for at least \p count values.
+    void reserve(size_type count)
+    {
+        if(count <= capacity()){
+            return;
+        }
+
+        detail::pinned_host_pool::block block = m_pool->allocate(count * sizeof(T));
+        if(m_block.ptr){
+            std::memcpy(block.ptr, m_block.ptr, m_size * sizeof(T));
+            m_pool->release(m_block);
+        }
+        m_block = block;
+    }
+
+    /// Resizes the vector to \p count values. New values are left
+    /// uninitialized.
+    void resize(size_type count)
+    {
+        reserve(count);
+        m_size = count;
+    }
+
+    /// Resizes the vector to \p count values, new values are set to
+    /// \p value.
+    void resize(size_type count, const T &value)
+    {
+        reserve(count);
+        if(count > m_size){
+            std::fill(data() + m_size, data() + count, value);
+        }
+        m_size = count;
+    }
+
+    void push_back(const T &value)
+    {
+        if(m_size == capacity()){
+            reserve((std::max)(size_type(2) * m_size, size_type(16)));
+        }
+
+        data()[m_size++] = value;
+    }
+
+    void pop_back()
+    {
+        BOOST_ASSERT(m_size > 0);
+
+        m_size--;
+    }
+
+    void clear()
+    {
+        m_size = 0;
+    }
+
+    void swap(pinned_host_vector<T> &other)
+    {
+        std::swap(m_pool, other.m_pool);
+        std::swap(m_block, other.m_block);
+        std::swap(m_size, other.m_size);
+    }
+
+    /// Returns the pinned buffer whose mapped memory holds the values (a
+    /// null buffer if no memory is allocated).
+    const buffer& get_buffer() const
+    {
+        return m_block.buf;
+    }
+
+private:
+    boost::shared_ptr<detail::pinned_host_pool> m_pool;
+    detail::pinned_host_pool::block m_block;
+    size_type m_size;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_PINNED_HOST_VECTOR_HPP
@@ -0,0 +1,439 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_SOA_VECTOR_HPP
+#define BOOST_COMPUTE_CONTAINER_SOA_VECTOR_HPP
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/throw_exception.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/soa_iterator.hpp>
+#include <boost/compute/types/struct.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// collects the size of each member of a struct
+template<class T>
+struct soa_member_sizes
+{
+    template<class Member>
+    void operator()(Member T::*, const char *)
+    {
+        sizes.push_back(sizeof(Member));
+    }
+
+    std::vector<size_t> sizes;
+};
+
+// finds the index of a member of a struct. index is the number of members
+// if member is not one of them.
+template<class T, class Member>
+struct soa_member_index
+{
+    soa_member_index(Member T::*member_)
+        : member(member_),
+          index(adapted_struct_members<T>::count),
+          n(0)
+    {
+    }
+
+    template<class Other>
+    void operator()(Other T::*, const char *)
+    {
+        n++;
+    }
+
+    void operator()(Member T::*other, const char *)
+    {
+        if(other == member && index == adapted_struct_members<T>::count){
+            index = n;
+        }
+        n++;
+    }
+
+    Member T::*member;
+    size_t index;
+    size_t n;
+};
+
+// stores each member of the struct "value" to its buffer at index "i"
+template<class T>
+struct soa_store_members
+{
+    soa_store_members(meta_kernel &k_, const buffer *members_, size_t index_)
+        : k(k_),
+          members(members_),
+          index(index_),
+          n(0)
+    {
+    }
+
+    template<class Member>
+    void operator()(Member T::*, const char *name)
+    {
+        k << buffer_iterator<Member>(members[n], index)[k.var<uint_>("i")]
+          << " = value." << name << ";\n";
+        n++;
+    }
+
+    meta_kernel &k;
+    const buffer *members;
+    size_t index;
+    size_t n;
+};
+
+} // end detail namespace
+
+/// \class soa_vector
+/// \brief A resizable array of structs stored as a structure-of-arrays.
+///
+/// The soa_vector<T> class stores each member of the struct \c T in its
+/// own buffer (instead of storing the structs one after the other as
+/// \ref vector "vector<T>" does). Kernels which only use some members of
+/// the structs then only load those members from memory. The struct type
+/// must be adapted with BOOST_COMPUTE_ADAPT_STRUCT().
+///
+/// The iterators of a soa_vector yield struct values to the algorithms:
+/// \code
+/// // struct particle { float x, y, dx, dy; };
+/// // BOOST_COMPUTE_ADAPT_STRUCT(particle, particle, (x, y, dx, dy))
+///
+/// boost::compute::soa_vector<particle> particles(
+///     host_particles.begin(), host_particles.end(), queue
+/// );
+///
+/// // sort the particles by their x-coordinate
+/// boost::compute::vector<particle> sorted(particles.size(), context);
+/// boost::compute::copy(particles.begin(), particles.end(), sorted.begin(), queue);
+/// \endcode
+///
+/// Each member can also be used as a range of its own with member_begin()
+/// and member_end():
+/// \code
+/// // move all particles to the right
+/// boost::compute::transform(
+///     particles.member_begin(&particle::x),
+///     particles.member_end(&particle::x),
+///     particles.member_begin(&particle::x),
+///     _1 + 1.0f,
+///     queue
+/// );
+/// \endcode
+///
+/// The structs of a soa_vector can be read by the algorithms but not
+/// written to. Use assign() to store the results of an algorithm or copy()
+/// to write structs from the host.
+///
+/// \see vector, soa_iterator
+template<class T>
+class soa_vector
+{
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef soa_iterator<T> iterator;
+    typedef soa_iterator<T> const_iterator;
+
+    /// Creates an empty soa_vector in \p context.
+    explicit soa_vector(const context &context = system::default_context())
+        : m_context(context),
+          m_size(0)
+    {
+        allocate_members(0);
+    }
+
+    /// Creates a soa_vector with space for \p count structs in \p context.
+    explicit soa_vector(size_type count,
+                        const context &context = system::default_context())
+        : m_context(context),
+          m_size(0)
+    {
+        allocate_members(count);
+        m_size = count;
+    }
+
+    /// Creates a soa_vector with the structs in the range [\p first,
+    /// \p last) (on the host or the device).
+    template<class InputIterator>
+    soa_vector(InputIterator first,
+               InputIterator last,
+               command_queue &queue = system::default_queue())
+        : m_context(queue.get_context()),
+          m_size(0)
+    {
+        allocate_members(0);
+        assign(first, last, queue);
+    }
+
+    /// Creates a new soa_vector and copies the structs from \p other.
+    soa_vector(const soa_vector<T> &other)
+        : m_context(other.m_context),
+          m_size(0)
+    {
+        allocate_members(other.m_size);
+        m_size = other.m_size;
+
+        if(m_size > 0){
+            command_queue queue = default_queue();
+            copy_members(other.m_members, m_size, queue);
+            queue.finish();
+        }
+    }
+
+    /// Copies the structs from \p other.
+    soa_vector<T>& operator=(const soa_vector<T> &other)
+    {
+        if(this != &other){
+            command_queue queue = default_queue();
+            resize(other.m_size, queue);
+            copy_members(other.m_members, m_size, queue);
+            queue.finish();
+        }
+
+        return *this;
+    }
+
+    /// Destroys the soa_vector.
+    ~soa_vector()
+    {
+    }
+
+    /// Returns the number of structs in the soa_vector.
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /// Returns \c true if the soa_vector is empty.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// Returns the number of structs the soa_vector can hold without
+    /// allocating new buffers.
+    size_type capacity() const
+    {
+        return m_capacity;
+    }
+
+    /// Returns the context of the soa_vector.
+    const context& get_context() const
+    {
+        return m_context;
+    }
+
+    iterator begin() const
+    {
+        return iterator(&m_members[0], 0);
+    }
+
+    iterator end() const
+    {
+        return iterator(&m_members[0], m_size);
+    }
+
+    /// Returns the number of members of \c T (and buffers of the
+    /// soa_vector).
+    size_type member_count() const
+    {
+        return m_members.size();
+    }
+
+    /// Returns the buffer storing member \p n of the structs.
+    const buffer& get_member_buffer(size_type n) const
+    {
+        return m_members[n];
+    }
+
+    /// Returns an iterator to the first value of \p member.
+    ///
+    /// Throws \c std::invalid_argument if \p member is not one of the
+    /// adapted members of \c T.
+    template<class Member>
+    buffer_iterator<Member> member_begin(Member T::*member) const
+    {
+        detail::soa_member_index<T, Member> finder(member);
+        detail::adapted_struct_members<T>::for_each(finder);
+        if(finder.index == detail::adapted_struct_members<T>::count){
+            BOOST_THROW_EXCEPTION(
+                std::invalid_argument("member is not an adapted member of the struct")
+            );
+        }
+
+        return buffer_iterator<Member>(m_members[finder.index], 0);
+    }
+
+    /// Returns an iterator one past the last value of \p member.
+    template<class Member>
+    buffer_iterator<Member> member_end(Member T::*member) const
+    {
+        return member_begin(member) + static_cast<difference_type>(m_size);
+    }
+
+    /// Replaces the structs in the soa_vector with the structs in the
+    /// range [\p first, \p last). Structs on the device are split into
+    /// their members with a kernel.
+    template<class InputIterator>
+    void assign(InputIterator first,
+                InputIterator last,
+                command_queue &queue,
+                typename boost::enable_if<
+                    is_device_iterator<InputIterator>
+                >::type* = 0)
+    {
+        const size_type count = detail::iterator_range_size(first, last);
+        resize(count, queue);
+        if(count == 0){
+            return;
+        }
+
+        detail::meta_kernel k("soa_vector_assign");
+        k.inject_type<T>();
+        k << "const uint i = get_global_id(0);\n"
+          << "const " << type_name<T>() << " value = "
+          << first[k.var<uint_>("i")] << ";\n";
+
+        detail::soa_store_members<T> store(k, &m_members[0], 0);
+        detail::adapted_struct_members<T>::for_each(store);
+
+        k.exec_1d(queue, 0, count);
+    }
+
+    /// \overload
+    template<class InputIterator>
+    void assign(InputIterator first,
+                InputIterator last,
+                command_queue &queue,
+                typename boost::disable_if<
+                    is_device_iterator<InputIterator>
+                >::type* = 0)
+    {
+        resize(detail::iterator_range_size(first, last), queue);
+        ::boost::compute::copy(first, last, begin(), queue);
+    }
+
+    /// \overload
+    template<class InputIterator>
+    void assign(InputIterator first, InputIterator last)
+    {
+        command_queue queue = default_queue();
+        assign(first, last, queue);
+        queue.finish();
+    }
+
+    /// Resizes the soa_vector to \p size. The existing structs are kept
+    /// if the buffers have to be reallocated.
+    void resize(size_type size, command_queue &queue)
+    {
+        if(size > m_capacity){
+            std::vector<buffer> old_members;
+            old_members.swap(m_members);
+
+            allocate_members((std::max)(size, 2 * m_capacity));
+            if(m_size > 0){
+                copy_members(old_members, m_size, queue);
+                queue.finish();
+            }
+        }
+
+        m_size = size;
+    }
+
+    /// \overload
+    void resize(size_type size)
+    {
+        command_queue queue = default_queue();
+        resize(size, queue);
+        queue.finish();
+    }
+
+    /// Removes all structs from the soa_vector. The buffers are kept.
+    void clear()
+    {
+        m_size = 0;
+    }
+
+private:
+    /// \internal_
+    void allocate_members(size_type capacity)
+    {
+        detail::soa_member_sizes<T> sizes;
+        detail::adapted_struct_members<T>::for_each(sizes);
+
+        // empty buffers are not allowed, keep room for at least one struct
+        const size_type count = (std::max)(capacity, size_type(1));
+
+        m_members.clear();
+        m_members.reserve(sizes.sizes.size());
+        for(size_t n = 0; n < sizes.sizes.size(); n++){
+            m_members.push_back(
+                buffer(m_context, count * sizes.sizes[n], buffer::read_write)
+            );
+        }
+        m_capacity = capacity;
+    }
+
+    /// \internal_
+    void copy_members(const std::vector<buffer> &members,
+                      size_type count,
+                      command_queue &queue)
+    {
+        if(count == 0){
+            return;
+        }
+
+        detail::soa_member_sizes<T> sizes;
+        detail::adapted_struct_members<T>::for_each(sizes);
+
+        for(size_t n = 0; n < m_members.size(); n++){
+            queue.enqueue_copy_buffer(
+                members[n], m_members[n], 0, 0, count * sizes.sizes[n]
+            );
+        }
+    }
+
+    /// \internal_
+    command_queue default_queue() const
+    {
+        const context &context = m_context;
+        command_queue queue(context, context.get_device());
+        return queue;
+    }
+
+private:
+    context m_context;
+    size_type m_size;
+    size_type m_capacity;
+    std::vector<buffer> m_members;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_SOA_VECTOR_HPP
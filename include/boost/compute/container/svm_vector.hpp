@@ -0,0 +1,191 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_SVM_VECTOR_HPP
+#define BOOST_COMPUTE_CONTAINER_SVM_VECTOR_HPP
+
+#include <cstddef>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/svm.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/memory/svm_ptr.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+// svm_vector requires opencl 2.0
+#if defined(CL_VERSION_2_0) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+
+namespace boost {
+namespace compute {
+
+/// \class svm_vector
+/// \brief A fixed-size array of values in shared virtual memory (SVM).
+///
+/// The svm_vector class stores its values in memory allocated with
+/// svm_alloc(). On devices supporting fine-grained buffer SVM the memory is
+/// allocated with \c CL_MEM_SVM_FINE_GRAIN_BUFFER and the host can access
+/// the values through data() without mapping them, otherwise coarse-grained
+/// SVM is used and the values must be mapped with map() first.
+///
+/// The iterators of an svm_vector are \ref svm_ptr "svm_ptr<T>" which are
+/// passed to the kernels of the algorithms as pointers, so data structures
+/// containing pointers into the vector can be shared between the host and
+/// the device.
+///
+/// \code
+/// boost::compute::svm_vector<int> vector(1024, context);
+/// boost::compute::iota(vector.begin(), vector.end(), 0, queue);
+///
+/// vector.map(queue, CL_MAP_READ);
+/// int first = vector.data()[0];
+/// vector.unmap(queue);
+/// \endcode
+///
+/// \opencl_version_warning{2,0}
+///
+/// \see svm_ptr, svm_alloc(), vector
+template<class T>
+class svm_vector : boost::noncopyable
+{
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef svm_ptr<T> iterator;
+    typedef svm_ptr<T> const_iterator;
+
+    /// Creates an svm_vector with space for \p count values in \p context.
+    explicit svm_vector(size_type count,
+                        const context &context = system::default_context())
+        : m_context(context),
+          m_size(count)
+    {
+        allocate();
+    }
+
+    /// Creates an svm_vector with the values in the range [\p first,
+    /// \p last).
+    template<class InputIterator>
+    svm_vector(InputIterator first,
+               InputIterator last,
+               command_queue &queue = system::default_queue())
+        : m_context(queue.get_context()),
+          m_size(detail::iterator_range_size(first, last))
+    {
+        allocate();
+        ::boost::compute::copy(first, last, begin(), queue);
+    }
+
+    /// Destroys the svm_vector and frees its memory.
+    ~svm_vector()
+    {
+        svm_free(m_context, m_ptr);
+    }
+
+    /// Returns the number of values in the svm_vector.
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /// Returns \c true if the svm_vector is empty.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// Returns the context of the svm_vector.
+    const context& get_context() const
+    {
+        return m_context;
+    }
+
+    iterator begin() const
+    {
+        return m_ptr;
+    }
+
+    iterator end() const
+    {
+        return m_ptr + static_cast<difference_type>(m_size);
+    }
+
+    /// Returns a host pointer to the values. With coarse-grained SVM the
+    /// values may only be accessed between map() and unmap().
+    T* data() const
+    {
+        return static_cast<T *>(m_ptr.get());
+    }
+
+    /// Returns \c true if the values are stored in fine-grained SVM.
+    bool is_fine_grained() const
+    {
+        return m_fine_grained;
+    }
+
+    /// Makes the values accessible to the host through data() after the
+    /// commands enqueued to \p queue have finished. With fine-grained SVM
+    /// the memory is already shared so the values are not mapped.
+    void map(command_queue &queue, cl_map_flags flags = CL_MAP_READ | CL_MAP_WRITE)
+    {
+        if(m_fine_grained){
+            queue.finish();
+        }
+        else {
+            queue.enqueue_svm_map(m_ptr.get(), m_size * sizeof(T), flags);
+        }
+    }
+
+    /// Ends the host access started with map().
+    void unmap(command_queue &queue)
+    {
+        if(!m_fine_grained){
+            queue.enqueue_svm_unmap(m_ptr.get());
+        }
+    }
+
+private:
+    /// \internal_
+    void allocate()
+    {
+        const cl_device_svm_capabilities capabilities =
+            m_context.get_device().get_info<cl_device_svm_capabilities>(
+                CL_DEVICE_SVM_CAPABILITIES
+            );
+
+        m_fine_grained = (capabilities & CL_DEVICE_SVM_FINE_GRAIN_BUFFER) != 0;
+
+        cl_svm_mem_flags flags = CL_MEM_READ_WRITE;
+        if(m_fine_grained){
+            flags |= CL_MEM_SVM_FINE_GRAIN_BUFFER;
+        }
+
+        // svm_alloc() fails for empty allocations
+        m_ptr = svm_alloc<T>(m_context, m_size > 0 ? m_size : 1, flags);
+    }
+
+private:
+    context m_context;
+    size_type m_size;
+    bool m_fine_grained;
+    svm_ptr<T> m_ptr;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // CL_VERSION_2_0
+
+#endif // BOOST_COMPUTE_CONTAINER_SVM_VECTOR_HPP
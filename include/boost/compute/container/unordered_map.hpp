@@ -0,0 +1,616 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_UNORDERED_MAP_HPP
+#define BOOST_COMPUTE_CONTAINER_UNORDERED_MAP_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/hash.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// bit patterns of the keys marking empty and erased slots. the values for
+// int and uint are the ones least likely to be used as keys and the
+// values for float are NaNs.
+template<class Key>
+struct unordered_map_sentinels
+{
+    static uint_ empty() { return 0xFFFFFFFF; }
+    static uint_ erased() { return 0xFFFFFFFE; }
+};
+
+template<>
+struct unordered_map_sentinels<int_>
+{
+    static uint_ empty() { return 0x80000000; }
+    static uint_ erased() { return 0x80000001; }
+};
+
+// selects the slots of an unordered map which hold a value
+template<class Key>
+struct unordered_map_used_slot
+{
+    unordered_map_used_slot(buffer_iterator<Key> keys_)
+        : keys(keys_)
+    {
+    }
+
+    void select(meta_kernel &k) const
+    {
+        k << "as_uint(" << keys[k.var<uint_>("i")] << ") != " <<
+                 unordered_map_sentinels<Key>::empty() << "u && " <<
+             "as_uint(" << keys[k.var<uint_>("i")] << ") != " <<
+                 unordered_map_sentinels<Key>::erased() << "u";
+    }
+
+    buffer_iterator<Key> keys;
+};
+
+} // end detail namespace
+
+/// \class unordered_map
+/// \brief A hash table stored on the device.
+///
+/// The unordered_map class stores key-value pairs in an open addressing
+/// hash table with linear probing. Keys are hashed with hash<Key> and must
+/// be 32-bit types (\c int_, \c uint_ or \c float_).
+///
+/// All of the operations work on device ranges of keys (and values) with
+/// one kernel launch each, where each work-item handles one key. This makes
+/// the container suitable for joins and removing duplicates on the device.
+///
+/// Two key values are reserved to mark empty and erased slots: \c 0xFFFFFFFF
+/// and \c 0xFFFFFFFE for \c uint_, \c INT_MIN and \c INT_MIN+1 for \c int_
+/// and the NaNs with these bit patterns for \c float_.
+///
+/// When the table would exceed its maximum load factor it is rehashed to
+/// a larger table on the device.
+///
+/// \see flat_map, hash
+template<class Key, class T>
+class unordered_map
+{
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef size_t size_type;
+
+    BOOST_STATIC_ASSERT_MSG(
+        sizeof(Key) == sizeof(uint_),
+        "unordered_map keys must be 32-bit types"
+    );
+
+    /// Creates a new, empty unordered map in \p context.
+    explicit unordered_map(const context &context = system::default_context())
+        : m_keys(context),
+          m_values(context),
+          m_size(0),
+          m_erased(0),
+          m_max_load_factor(0.5f)
+    {
+    }
+
+    /// Creates a new unordered map as a copy of \p other.
+    unordered_map(const unordered_map<Key, T> &other)
+        : m_keys(other.m_keys),
+          m_values(other.m_values),
+          m_size(other.m_size),
+          m_erased(other.m_erased),
+          m_max_load_factor(other.m_max_load_factor)
+    {
+    }
+
+    /// Copies \p other to \c *this.
+    unordered_map<Key, T>& operator=(const unordered_map<Key, T> &other)
+    {
+        if(this != &other){
+            m_keys = other.m_keys;
+            m_values = other.m_values;
+            m_size = other.m_size;
+            m_erased = other.m_erased;
+            m_max_load_factor = other.m_max_load_factor;
+        }
+
+        return *this;
+    }
+
+    /// Destroys the unordered map.
+    ~unordered_map()
+    {
+    }
+
+    /// Returns the number of key-value pairs in the map.
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /// Returns \c true if the map is empty.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// Returns the number of slots in the hash table.
+    size_type bucket_count() const
+    {
+        return m_keys.size();
+    }
+
+    /// Returns the ratio of the number of key-value pairs to the number of
+    /// slots.
+    float load_factor() const
+    {
+        return bucket_count() ? static_cast<float>(m_size) / bucket_count() : 0.f;
+    }
+
+    /// Returns the maximum load factor.
+    float max_load_factor() const
+    {
+        return m_max_load_factor;
+    }
+
+    /// Sets the maximum load factor to \p value (which must be in (0, 1)).
+    void max_load_factor(float value)
+    {
+        m_max_load_factor = value;
+    }
+
+    /// Removes all key-value pairs from the map.
+    void clear(command_queue &queue)
+    {
+        _clear_slots(queue);
+
+        m_size = 0;
+        m_erased = 0;
+    }
+
+    /// \overload
+    void clear()
+    {
+        command_queue queue = m_keys.default_queue();
+        clear(queue);
+        queue.finish();
+    }
+
+    /// Rehashes the map into a table with at least \p count slots (and
+    /// room for its values with the maximum load factor).
+    void rehash(size_type count, command_queue &queue)
+    {
+        const size_type required = static_cast<size_type>(
+            std::ceil(static_cast<float>(m_size) / m_max_load_factor)
+        );
+
+        // the number of slots is a power of two
+        size_type slots = 16;
+        while(slots < count || slots < required){
+            slots *= 2;
+        }
+
+        const context &context = m_keys.get_allocator().get_context();
+
+        vector<Key> keys(slots, context);
+        vector<T> values(slots, context);
+        keys.swap(m_keys);
+        values.swap(m_values);
+
+        _clear_slots(queue);
+
+        // insert the stored values into the new table, which counts them
+        // again
+        m_size = 0;
+        m_erased = 0;
+        if(!keys.empty()){
+            _insert(keys.begin(), keys.size(), values.begin(), true, queue);
+        }
+    }
+
+    /// \overload
+    void rehash(size_type count)
+    {
+        command_queue queue = m_keys.default_queue();
+        rehash(count, queue);
+        queue.finish();
+    }
+
+    /// Makes room for \p count key-value pairs without exceeding the
+    /// maximum load factor.
+    void reserve(size_type count, command_queue &queue)
+    {
+        const size_type slots = static_cast<size_type>(
+            std::ceil(static_cast<float>(count) / m_max_load_factor)
+        );
+
+        if(slots > bucket_count()){
+            rehash(slots, queue);
+        }
+    }
+
+    /// \overload
+    void reserve(size_type count)
+    {
+        command_queue queue = m_keys.default_queue();
+        reserve(count, queue);
+        queue.finish();
+    }
+
+    /// Inserts the keys in the range [\p keys_first, \p keys_last) with
+    /// the values in the range beginning at \p values_first.
+    ///
+    /// Keys which are already in the map keep their value. When a key
+    /// appears more than once in the range one of its values is stored.
+    template<class KeyIterator, class ValueIterator>
+    void insert(KeyIterator keys_first,
+                KeyIterator keys_last,
+                ValueIterator values_first,
+                command_queue &queue)
+    {
+        const size_type count = detail::iterator_range_size(keys_first, keys_last);
+        if(count == 0){
+            return;
+        }
+
+        // erased slots are only reused after rehashing
+        const size_type used = m_size + m_erased + count;
+        if(used > static_cast<size_type>(m_max_load_factor * bucket_count())){
+            rehash(
+                static_cast<size_type>(
+                    std::ceil(static_cast<float>(m_size + count) / m_max_load_factor)
+                ),
+                queue
+            );
+        }
+
+        _insert(keys_first, count, values_first, false, queue);
+    }
+
+    /// \overload
+    template<class KeyIterator, class ValueIterator>
+    void insert(KeyIterator keys_first,
+                KeyIterator keys_last,
+                ValueIterator values_first)
+    {
+        command_queue queue = m_keys.default_queue();
+        insert(keys_first, keys_last, values_first, queue);
+        queue.finish();
+    }
+
+    /// For each key in the range [\p keys_first, \p keys_last) stores its
+    /// value (or \p default_value if the key is not in the map) in the
+    /// range beginning at \p result.
+    ///
+    /// \return \c OutputIterator to the end of the result range
+    template<class KeyIterator, class OutputIterator>
+    OutputIterator find(KeyIterator keys_first,
+                        KeyIterator keys_last,
+                        OutputIterator result,
+                        const T &default_value,
+                        command_queue &queue) const
+    {
+        const size_type count = detail::iterator_range_size(keys_first, keys_last);
+        if(count == 0){
+            return result;
+        }
+
+        detail::meta_kernel k("unordered_map_find");
+        size_t default_arg = k.add_arg<const T>("default_value");
+
+        const size_t mask_arg = _lookup_kernel(k, keys_first);
+        k <<
+            "if(found){\n" <<
+            "    " << result[k.var<uint_>("i")] << " = " <<
+                      m_values.begin()[k.var<uint_>("slot")] << ";\n" <<
+            "}\n" <<
+            "else {\n" <<
+            "    " << result[k.var<uint_>("i")] << " = default_value;\n" <<
+            "}\n";
+
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(default_arg, default_value);
+        _set_lookup_args(kernel, mask_arg);
+        queue.enqueue_1d_range_kernel(kernel, 0, count, 0);
+
+        return result + static_cast<typename std::iterator_traits<OutputIterator>::difference_type>(count);
+    }
+
+    /// \overload
+    template<class KeyIterator, class OutputIterator>
+    OutputIterator find(KeyIterator keys_first,
+                        KeyIterator keys_last,
+                        OutputIterator result,
+                        const T &default_value = T()) const
+    {
+        command_queue queue = m_keys.default_queue();
+        OutputIterator end = find(keys_first, keys_last, result, default_value, queue);
+        queue.finish();
+        return end;
+    }
+
+    /// For each key in the range [\p keys_first, \p keys_last) stores
+    /// \c 1 if it is in the map and \c 0 otherwise in the range beginning
+    /// at \p result.
+    ///
+    /// \return \c OutputIterator to the end of the result range
+    template<class KeyIterator, class OutputIterator>
+    OutputIterator count(KeyIterator keys_first,
+                         KeyIterator keys_last,
+                         OutputIterator result,
+                         command_queue &queue) const
+    {
+        const size_type count = detail::iterator_range_size(keys_first, keys_last);
+        if(count == 0){
+            return result;
+        }
+
+        detail::meta_kernel k("unordered_map_count");
+        const size_t mask_arg = _lookup_kernel(k, keys_first);
+        k << result[k.var<uint_>("i")] << " = found;\n";
+
+        kernel kernel = k.compile(queue.get_context());
+        _set_lookup_args(kernel, mask_arg);
+        queue.enqueue_1d_range_kernel(kernel, 0, count, 0);
+
+        return result + static_cast<typename std::iterator_traits<OutputIterator>::difference_type>(count);
+    }
+
+    /// \overload
+    template<class KeyIterator, class OutputIterator>
+    OutputIterator count(KeyIterator keys_first,
+                         KeyIterator keys_last,
+                         OutputIterator result) const
+    {
+        command_queue queue = m_keys.default_queue();
+        OutputIterator end = count(keys_first, keys_last, result, queue);
+        queue.finish();
+        return end;
+    }
+
+    /// Removes the keys in the range [\p keys_first, \p keys_last) (and
+    /// their values) from the map.
+    ///
+    /// \return the number of removed key-value pairs
+    template<class KeyIterator>
+    size_type erase(KeyIterator keys_first,
+                    KeyIterator keys_last,
+                    command_queue &queue)
+    {
+        const size_type count = detail::iterator_range_size(keys_first, keys_last);
+        if(count == 0 || m_size == 0){
+            return 0;
+        }
+
+        vector<uint_> counter(1, queue.get_context());
+        ::boost::compute::fill(counter.begin(), counter.end(), uint_(0), queue);
+
+        detail::meta_kernel k("unordered_map_erase");
+        const size_t mask_arg = _lookup_kernel(k, keys_first);
+        k <<
+            "if(found && " <<
+                "atomic_cmpxchg((volatile __global uint *) &" << m_keys << "[slot], " <<
+                    "bits, " << _erased_bits() << "u) == bits){\n" <<
+            "    atomic_inc(" << counter << ");\n" <<
+            "}\n";
+
+        kernel kernel = k.compile(queue.get_context());
+        _set_lookup_args(kernel, mask_arg);
+        queue.enqueue_1d_range_kernel(kernel, 0, count, 0);
+
+        const size_type erased =
+            detail::read_single_value<uint_>(counter.get_buffer(), 0, queue);
+        m_size -= erased;
+        m_erased += erased;
+
+        return erased;
+    }
+
+    /// \overload
+    template<class KeyIterator>
+    size_type erase(KeyIterator keys_first, KeyIterator keys_last)
+    {
+        command_queue queue = m_keys.default_queue();
+        size_type erased = erase(keys_first, keys_last, queue);
+        queue.finish();
+        return erased;
+    }
+
+    /// Copies the keys of the map to the range beginning at \p result.
+    ///
+    /// The keys are in the order of their slots, which is the same order
+    /// used by copy_values().
+    ///
+    /// \return \c OutputIterator to the end of the result range
+    template<class OutputIterator>
+    OutputIterator copy_keys(OutputIterator result, command_queue &queue) const
+    {
+        return detail::stream_compact(
+            m_keys.begin(),
+            m_keys.size(),
+            result,
+            _used_slot(),
+            false,
+            queue
+        );
+    }
+
+    /// Copies the values of the map to the range beginning at \p result.
+    ///
+    /// \return \c OutputIterator to the end of the result range
+    ///
+    /// \see copy_keys()
+    template<class OutputIterator>
+    OutputIterator copy_values(OutputIterator result, command_queue &queue) const
+    {
+        return detail::stream_compact(
+            m_values.begin(),
+            m_values.size(),
+            result,
+            _used_slot(),
+            false,
+            queue
+        );
+    }
+
+private:
+    /// \internal_
+    ///
+    /// Marks all slots as empty. The keys are written as uint bit patterns
+    /// (the empty float key is a NaN).
+    void _clear_slots(command_queue &queue)
+    {
+        ::boost::compute::fill(
+            make_buffer_iterator<uint_>(m_keys.get_buffer(), 0),
+            make_buffer_iterator<uint_>(m_keys.get_buffer(), m_keys.size()),
+            _empty_bits(),
+            queue
+        );
+    }
+
+    /// \internal_
+    static uint_ _empty_bits()
+    {
+        return detail::unordered_map_sentinels<Key>::empty();
+    }
+
+    /// \internal_
+    static uint_ _erased_bits()
+    {
+        return detail::unordered_map_sentinels<Key>::erased();
+    }
+
+    /// \internal_
+    detail::unordered_map_used_slot<Key> _used_slot() const
+    {
+        return detail::unordered_map_used_slot<Key>(m_keys.begin());
+    }
+
+    /// \internal_
+    ///
+    /// Inserts count keys and values into the table with one work-item per
+    /// key. If skip_unused is true the keys marking empty or erased slots
+    /// are skipped (used when rehashing).
+    template<class KeyIterator, class ValueIterator>
+    void _insert(KeyIterator keys_first,
+                 size_type count,
+                 ValueIterator values_first,
+                 bool skip_unused,
+                 command_queue &queue)
+    {
+        vector<uint_> counter(1, queue.get_context());
+        ::boost::compute::fill(counter.begin(), counter.end(), uint_(0), queue);
+
+        detail::meta_kernel k("unordered_map_insert");
+        size_t mask_arg = k.add_arg<const uint_>("mask");
+
+        k <<
+            "const uint i = get_global_id(0);\n" <<
+            k.decl<const Key>("key") << " = " << keys_first[k.var<uint_>("i")] << ";\n" <<
+            "const uint bits = as_uint(key);\n";
+        if(skip_unused){
+            k <<
+            "if(bits == " << _empty_bits() << "u || bits == " << _erased_bits() << "u){\n" <<
+            "    return;\n" <<
+            "}\n";
+        }
+        k <<
+            "uint slot = ((uint) " << hash<Key>()(k.var<const Key>("key")) << ") & mask;\n" <<
+            "for(uint probe = 0; probe <= mask; probe++){\n" <<
+            "    const uint old = atomic_cmpxchg(\n" <<
+            "        (volatile __global uint *) &" << m_keys << "[slot], " <<
+                     _empty_bits() << "u, bits\n" <<
+            "    );\n" <<
+            "    if(old == " << _empty_bits() << "u){\n" <<
+            "        " << m_values.begin()[k.var<uint_>("slot")] << " = " <<
+                          values_first[k.var<uint_>("i")] << ";\n" <<
+            "        atomic_inc(" << counter << ");\n" <<
+            "        break;\n" <<
+            "    }\n" <<
+            "    if(old == bits){\n" <<
+            "        break;\n" <<
+            "    }\n" <<
+            "    slot = (slot + 1) & mask;\n" <<
+            "}\n";
+
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(mask_arg, static_cast<uint_>(bucket_count() - 1));
+        queue.enqueue_1d_range_kernel(kernel, 0, count, 0);
+
+        m_size += detail::read_single_value<uint_>(counter.get_buffer(), 0, queue);
+    }
+
+    /// \internal_
+    ///
+    /// Writes the code looking up the key of work-item i. Afterwards found
+    /// is set and slot is the slot holding the key.
+    /// Returns the index of the argument to set with _set_lookup_args().
+    template<class KeyIterator>
+    size_t _lookup_kernel(detail::meta_kernel &k, KeyIterator keys_first) const
+    {
+        const size_t mask_arg = k.add_arg<const uint_>("mask");
+
+        k <<
+            "const uint i = get_global_id(0);\n" <<
+            k.decl<const Key>("key") << " = " << keys_first[k.var<uint_>("i")] << ";\n" <<
+            "const uint bits = as_uint(key);\n" <<
+            "uint slot = ((uint) " << hash<Key>()(k.var<const Key>("key")) << ") & mask;\n" <<
+            "uint found = 0;\n" <<
+            "if(mask != 0xFFFFFFFF){\n" <<
+            "    for(uint probe = 0; probe <= mask; probe++){\n" <<
+            "        const uint current = as_uint(" << m_keys << "[slot]);\n" <<
+            "        if(current == bits){\n" <<
+            "            found = 1;\n" <<
+            "            break;\n" <<
+            "        }\n" <<
+            "        if(current == " << _empty_bits() << "u){\n" <<
+            "            break;\n" <<
+            "        }\n" <<
+            "        slot = (slot + 1) & mask;\n" <<
+            "    }\n" <<
+            "}\n";
+
+        return mask_arg;
+    }
+
+    /// \internal_
+    void _set_lookup_args(kernel &kernel, size_t mask_arg) const
+    {
+        // an empty table has no slots to probe (mask is then ~0)
+        kernel.set_arg(mask_arg, static_cast<uint_>(bucket_count() - 1));
+    }
+
+private:
+    vector<Key> m_keys;
+    vector<T> m_values;
+    size_type m_size;
+    size_type m_erased;
+    float m_max_load_factor;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_UNORDERED_MAP_HPP
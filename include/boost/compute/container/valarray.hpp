@@ -22,14 +22,30 @@
 #include <boost/compute/algorithm/min_element.hpp>
 #include <boost/compute/algorithm/transform.hpp>
 #include <boost/compute/algorithm/accumulate.hpp>
+#include <boost/compute/container/detail/valarray_expression.hpp>
 #include <boost/compute/detail/buffer_value.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
 
 namespace boost {
 namespace compute {
 
+/// \class valarray
+/// \brief A valarray-like container stored on the device.
+///
+/// The arithmetic operators and apply() applied to valarrays (and scalars)
+/// are not evaluated immediately but build an expression which is
+/// computed by a single kernel when assigned to a valarray, without any
+/// temporary array. For example:
+///
+/// \code
+/// boost::compute::valarray<float> r = a * b + c * d;
+/// \endcode
+///
+/// computes \c r with one kernel reading \c a, \c b, \c c and \c d once.
+/// The sum(), min() and max() of an expression are computed by a single
+/// reduction without storing its values.
 template<class T>
-class valarray
+class valarray : public detail::valarray_expression<valarray<T>, T>
 {
 public:
     explicit valarray(const context &context = system::default_context())
@@ -60,8 +76,22 @@ public:
     }
 
     valarray(const valarray<T> &other)
-        : m_buffer(other.m_buffer.get_context(), other.size() * sizeof(T))
+        : detail::valarray_expression<valarray<T>, T>(),
+          m_buffer(other.m_buffer.get_context(), other.size() * sizeof(T))
     {
+        copy(other.begin(), other.end(), begin());
+    }
+
+    /// Creates a valarray holding the values of the expression \p expr,
+    /// computed by a single kernel.
+    template<class Expr, class U>
+    valarray(const detail::valarray_expression<Expr, U> &expr,
+             const context &context = system::default_context())
+        : m_buffer(context, expr.derived().size() * sizeof(T))
+    {
+        detail::valarray_evaluate<T>(
+            expr.derived(), m_buffer, system::default_queue()
+        );
     }
 
     valarray(const std::valarray<T> &valarray,
@@ -85,6 +115,33 @@ public:
     {
         resize(valarray.size());
         copy(&valarray[0], &valarray[valarray.size()], begin());
+
+        return *this;
+    }
+
+    /// Assigns the values of the expression \p expr, which may use this
+    /// valarray (e.g. \c a \c = \c a \c * \c b).
+    template<class Expr, class U>
+    valarray<T>& operator=(const detail::valarray_expression<Expr, U> &expr)
+    {
+        const size_t size = expr.derived().size();
+        if(size != this->size()){
+            // the expression cannot use this valarray
+            m_buffer = buffer(m_buffer.get_context(), size * sizeof(T));
+        }
+        detail::valarray_evaluate<T>(
+            expr.derived(), m_buffer, system::default_queue()
+        );
+
+        return *this;
+    }
+
+    /// Assigns \p value to each element.
+    valarray<T>& operator=(const T &value)
+    {
+        fill(begin(), end(), value);
+
+        return *this;
     }
 
     ~valarray()
@@ -127,14 +184,25 @@ public:
         return boost::compute::accumulate(begin(), end(), T(0));
     }
 
-    template<class UnaryFunction>
-    valarray<T> apply(UnaryFunction function) const
-    {
-        valarray<T> result(size());
-        transform(begin(), end(), result.begin(), function);
-        return result;
+    #define BOOST_COMPUTE_DETAIL_VALARRAY_COMPOUND_ASSIGNMENT(op) \
+    template<class Expr, class U> \
+    valarray<T>& operator op##=(const detail::valarray_expression<Expr, U> &expr) \
+    { \
+        return *this = *this op expr; \
+    } \
+    \
+    valarray<T>& operator op##=(const T &value) \
+    { \
+        return *this = *this op value; \
     }
 
+    BOOST_COMPUTE_DETAIL_VALARRAY_COMPOUND_ASSIGNMENT(+)
+    BOOST_COMPUTE_DETAIL_VALARRAY_COMPOUND_ASSIGNMENT(-)
+    BOOST_COMPUTE_DETAIL_VALARRAY_COMPOUND_ASSIGNMENT(*)
+    BOOST_COMPUTE_DETAIL_VALARRAY_COMPOUND_ASSIGNMENT(/)
+
+    #undef BOOST_COMPUTE_DETAIL_VALARRAY_COMPOUND_ASSIGNMENT
+
     const buffer& get_buffer() const
     {
         return m_buffer;
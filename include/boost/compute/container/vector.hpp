@@ -13,6 +13,7 @@
 
 #include <vector>
 #include <cstddef>
+#include <algorithm>
 #include <iterator>
 #include <exception>
 
@@ -37,6 +38,7 @@
 #include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/type_traits/detail/capture_traits.hpp>
 #include <boost/compute/detail/buffer_value.hpp>
+#include <boost/compute/detail/is_contiguous_iterator.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
@@ -356,30 +358,20 @@ public:
     }
 
     /// Resizes the vector to \p size.
+    ///
+    /// When the capacity is exceeded it is grown geometrically, so that
+    /// repeatedly appending values takes amortized constant time.
     void resize(size_type size, command_queue &queue)
     {
-        if(size < capacity()){
-            m_size = size;
-        }
-        else {
-            // allocate new buffer
-            pointer new_data =
-                m_allocator.allocate(
-                    static_cast<size_type>(
-                        static_cast<float>(size) * _growth_factor()
-                    )
-                );
-
-            // copy old values to the new buffer
-            ::boost::compute::copy(m_data, m_data + m_size, new_data, queue);
+        if(size > capacity()){
+            const size_type grown_capacity = static_cast<size_type>(
+                static_cast<float>(capacity()) * _growth_factor()
+            );
 
-            // free old memory
-            m_allocator.deallocate(m_data, m_size);
-
-            // set new data and size
-            m_data = new_data;
-            m_size = size;
+            _reallocate((std::max)(size, grown_capacity), queue);
         }
+
+        m_size = size;
     }
 
     /// \overload
@@ -390,6 +382,25 @@ public:
         queue.finish();
     }
 
+    /// Resizes the vector to \p size without preserving its values.
+    ///
+    /// Unlike resize(), the values are not copied to the new buffer when the
+    /// capacity is exceeded, so the contents of the vector are undefined
+    /// afterwards. This avoids a device copy when all of the values will be
+    /// overwritten.
+    void resize_uninitialized(size_type size)
+    {
+        if(size > capacity()){
+            const size_type grown_capacity = static_cast<size_type>(
+                static_cast<float>(capacity()) * _growth_factor()
+            );
+
+            _reallocate_discard((std::max)(size, grown_capacity));
+        }
+
+        m_size = size;
+    }
+
     /// Returns \c true if the vector is empty.
     bool empty() const
     {
@@ -402,10 +413,13 @@ public:
         return m_data.get_buffer().size() / sizeof(T);
     }
 
+    /// Increases the capacity of the vector to at least \p size without
+    /// changing its size.
     void reserve(size_type size, command_queue &queue)
     {
-        (void) size;
-        (void) queue;
+        if(size > capacity()){
+            _reallocate(size, queue);
+        }
     }
 
     void reserve(size_type size)
@@ -415,9 +429,25 @@ public:
         queue.finish();
     }
 
+    /// Increases the capacity of the vector to at least \p size without
+    /// changing its size or preserving its values.
+    ///
+    /// \see resize_uninitialized()
+    void reserve_discard(size_type size)
+    {
+        if(size > capacity()){
+            _reallocate_discard(size);
+        }
+    }
+
+    /// Reduces the capacity of the vector to its size.
     void shrink_to_fit(command_queue &queue)
     {
-        (void) queue;
+        const size_type new_capacity = (std::max)(m_size, _minimum_capacity());
+
+        if(new_capacity < capacity()){
+            _reallocate(new_capacity, queue);
+        }
     }
 
     void shrink_to_fit()
@@ -628,6 +658,52 @@ public:
         queue.finish();
     }
 
+    /// Appends the values in the host range [\p first, \p last) to the
+    /// end of the vector.
+    ///
+    /// Values from non-contiguous host ranges are written directly into a
+    /// pinned staging buffer which is then copied to the vector, instead
+    /// of into a temporary \c std::vector.
+    template<class HostIterator>
+    void append(HostIterator first, HostIterator last, command_queue &queue)
+    {
+        const size_type count = detail::iterator_range_size(first, last);
+        if(count == 0){
+            return;
+        }
+
+        const size_type offset = m_size;
+        resize(m_size + count, queue);
+
+        if(detail::is_contiguous_iterator<HostIterator>::value){
+            ::boost::compute::copy(first, last, begin() + offset, queue);
+            return;
+        }
+
+        const context &context = m_allocator.get_context();
+        const size_t bytes = count * sizeof(T);
+
+        buffer staging(context, bytes, buffer::read_only | buffer::alloc_host_ptr);
+        T *staging_ptr = static_cast<T *>(
+            queue.enqueue_map_buffer(staging, command_queue::map_write, 0, bytes)
+        );
+        std::copy(first, last, staging_ptr);
+        queue.enqueue_unmap_buffer(staging, staging_ptr);
+
+        queue.enqueue_copy_buffer(
+            staging, m_data.get_buffer(), 0, offset * sizeof(T), bytes
+        );
+    }
+
+    /// \overload
+    template<class HostIterator>
+    void append(HostIterator first, HostIterator last)
+    {
+        command_queue queue = default_queue();
+        append(first, last, queue);
+        queue.finish();
+    }
+
     iterator erase(iterator position, command_queue &queue)
     {
         return erase(position, position + 1, queue);
@@ -700,6 +776,33 @@ public:
     }
 
 private:
+    /// \internal_
+    ///
+    /// Moves the values to a new buffer with \p new_capacity values.
+    void _reallocate(size_type new_capacity, command_queue &queue)
+    {
+        pointer new_data = m_allocator.allocate(new_capacity);
+
+        if(m_size){
+            ::boost::compute::copy(m_data, m_data + m_size, new_data, queue);
+        }
+
+        m_allocator.deallocate(m_data, capacity());
+        m_data = new_data;
+    }
+
+    /// \internal_
+    ///
+    /// Replaces the buffer with one of \p new_capacity values without
+    /// copying them.
+    void _reallocate_discard(size_type new_capacity)
+    {
+        pointer new_data = m_allocator.allocate(new_capacity);
+
+        m_allocator.deallocate(m_data, capacity());
+        m_data = new_data;
+    }
+
     /// \internal_
     BOOST_CONSTEXPR size_type _minimum_capacity() const { return 4; }
 
@@ -0,0 +1,359 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_WORK_QUEUE_HPP
+#define BOOST_COMPUTE_CONTAINER_WORK_QUEUE_HPP
+
+#include <string>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// the state of a work queue is the number of pushed values (which keeps
+// growing past the capacity when values are dropped) and the capacity.
+// adds the function pushing a value of type T to k and returns its name.
+template<class T>
+inline std::string work_queue_push_function(meta_kernel &k)
+{
+    const std::string type = k.type<T>();
+    const std::string name = std::string("boost_work_queue_push_") + type_name<T>();
+
+    std::stringstream source;
+    source <<
+        "inline void " << name << "(__global " << type << " *values,\n" <<
+        "    __global uint *state,\n" <<
+        "    const " << type << " value)\n" <<
+        "{\n" <<
+        "    const uint index = atomic_inc(&state[0]);\n" <<
+        "    if(index < state[1]){\n" <<
+        "        values[index] = value;\n" <<
+        "    }\n" <<
+        "}\n";
+    k.add_function(name, source.str());
+
+    return name;
+}
+
+// the push of arg to a work queue in a kernel
+template<class T, class Arg>
+struct invoked_work_queue_push
+{
+    invoked_work_queue_push(const buffer &values_,
+                            const buffer &state_,
+                            const Arg &arg_)
+        : values(values_),
+          state(state_),
+          arg(arg_)
+    {
+    }
+
+    buffer values;
+    buffer state;
+    Arg arg;
+};
+
+template<class T, class Arg>
+inline meta_kernel& operator<<(meta_kernel &k,
+                               const invoked_work_queue_push<T, Arg> &expr)
+{
+    const std::string name = work_queue_push_function<T>(k);
+
+    return k << name << "(" <<
+                k.get_buffer_identifier<T>(expr.values) << ", " <<
+                k.get_buffer_identifier<uint_>(expr.state) << ", " <<
+                expr.arg << ")";
+}
+
+// pushes values to a work queue in algorithms (see work_queue::pusher())
+template<class T>
+struct work_queue_pusher
+{
+    typedef void result_type;
+
+    work_queue_pusher(const buffer &values_, const buffer &state_)
+        : values(values_),
+          state(state_)
+    {
+    }
+
+    template<class Arg>
+    invoked_work_queue_push<T, Arg> operator()(const Arg &arg) const
+    {
+        return invoked_work_queue_push<T, Arg>(values, state, arg);
+    }
+
+    buffer values;
+    buffer state;
+};
+
+// selects every value pushed by work_queue::push()
+struct work_queue_select_all
+{
+    void select(meta_kernel &k) const
+    {
+        k << "true";
+    }
+};
+
+} // end detail namespace
+
+/// \class work_queue
+/// \brief A bounded queue of values which kernels push to concurrently.
+///
+/// The work_queue stores up to \c capacity() values in a preallocated
+/// buffer. Values are appended to it by kernels, each push reserving its
+/// slot with an atomic increment of the number of values. This allows
+/// work-list algorithms (e.g. breadth-first search or adaptive refinement)
+/// to collect the work of the next pass on the device and run it over the
+/// range [\c begin(), \c end()) without copying it to the host.
+///
+/// Values are pushed from the algorithms with the function returned by
+/// pusher(), or in bulk with push() and push_if(), which reserve the slots
+/// for all values selected by a work-group with one atomic operation:
+/// \code
+/// boost::compute::work_queue<int> next(nodes.size(), queue);
+///
+/// // push the neighbors of the current frontier
+/// boost::compute::for_each(first, last, next.pusher(), queue);
+///
+/// // run the next pass over the pushed values
+/// boost::compute::transform(next.begin(), next.end(queue), ..., queue);
+/// \endcode
+///
+/// The values within one kernel are pushed in an unspecified order.
+/// Values pushed when the queue is full are dropped and overflowed()
+/// returns \c true until the queue is cleared.
+///
+/// \see stack
+template<class T>
+class work_queue : boost::noncopyable
+{
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef buffer_iterator<T> iterator;
+
+    /// Creates an empty work queue which stores up to \p capacity values.
+    explicit work_queue(size_type capacity,
+                        command_queue &queue = system::default_queue())
+        : m_values((std::max)(capacity, size_type(1)), queue.get_context()),
+          m_state(2, queue.get_context()),
+          m_capacity(capacity)
+    {
+        const uint_ state[] = { 0, static_cast<uint_>(capacity) };
+        ::boost::compute::copy_n(state, 2, m_state.begin(), queue);
+    }
+
+    /// Returns the maximum number of values in the queue.
+    size_type capacity() const
+    {
+        return m_capacity;
+    }
+
+    /// Returns the number of values in the queue.
+    size_type size(command_queue &queue) const
+    {
+        return (std::min)(_pushed(queue), m_capacity);
+    }
+
+    /// Returns \c true if the queue is empty.
+    bool empty(command_queue &queue) const
+    {
+        return size(queue) == 0;
+    }
+
+    /// Returns \c true if values were dropped because the queue was full.
+    bool overflowed(command_queue &queue) const
+    {
+        return _pushed(queue) > m_capacity;
+    }
+
+    /// Returns an iterator to the first value in the queue.
+    iterator begin() const
+    {
+        return m_values.begin();
+    }
+
+    /// Returns an iterator to the end of the values in the queue.
+    iterator end(command_queue &queue) const
+    {
+        return m_values.begin() + static_cast<std::ptrdiff_t>(size(queue));
+    }
+
+    /// Pushes the values in the range [\p first, \p last).
+    template<class InputIterator>
+    void push(InputIterator first, InputIterator last, command_queue &queue)
+    {
+        _push(first, last, detail::work_queue_select_all(), queue);
+    }
+
+    /// Pushes the values in the range [\p first, \p last) for which
+    /// \p predicate returns \c true, keeping the order of the values
+    /// selected within each work-group.
+    template<class InputIterator, class Predicate>
+    void push_if(InputIterator first,
+                 InputIterator last,
+                 Predicate predicate,
+                 command_queue &queue)
+    {
+        _push(
+            first,
+            last,
+            detail::stream_compact_if<InputIterator, Predicate>(first, predicate),
+            queue
+        );
+    }
+
+    /// Returns a function pushing its argument to the queue, which can be
+    /// passed to the algorithms (e.g. \c for_each()) or streamed to a
+    /// meta-kernel.
+    detail::work_queue_pusher<T> pusher() const
+    {
+        return detail::work_queue_pusher<T>(
+            m_values.get_buffer(), m_state.get_buffer()
+        );
+    }
+
+    /// Copies the values in the queue to the range beginning at \p result,
+    /// clears the queue and returns an iterator to the end of the copied
+    /// values.
+    template<class OutputIterator>
+    OutputIterator drain(OutputIterator result, command_queue &queue)
+    {
+        result = ::boost::compute::copy(begin(), end(queue), result, queue);
+        clear(queue);
+
+        return result;
+    }
+
+    /// Removes all values from the queue.
+    void clear(command_queue &queue)
+    {
+        ::boost::compute::fill_n(m_state.begin(), 1, uint_(0), queue);
+    }
+
+    /// Swaps the values of the queue with \p other, e.g. to exchange the
+    /// current and next work lists of a pass.
+    void swap(work_queue<T> &other)
+    {
+        m_values.swap(other.m_values);
+        m_state.swap(other.m_state);
+        std::swap(m_capacity, other.m_capacity);
+    }
+
+    /// Returns the buffer storing the values.
+    const buffer& get_buffer() const
+    {
+        return m_values.get_buffer();
+    }
+
+private:
+    /// \internal_
+    size_type _pushed(command_queue &queue) const
+    {
+        uint_ pushed = 0;
+        ::boost::compute::copy_n(m_state.begin(), 1, &pushed, queue);
+
+        return static_cast<size_type>(pushed);
+    }
+
+    /// \internal_
+    ///
+    /// each work-group scans the flags of the values it selects in local
+    /// memory and reserves their slots with a single atomic_add()
+    template<class InputIterator, class Selector>
+    void _push(InputIterator first,
+               InputIterator last,
+               const Selector &selector,
+               command_queue &queue)
+    {
+        const size_t count = detail::iterator_range_size(first, last);
+        if(count == 0){
+            return;
+        }
+
+        const size_t work_group_size =
+            detail::stream_compact_work_group_size(queue);
+
+        detail::meta_kernel k("work_queue_push");
+        size_t count_arg = k.add_arg<const uint_>("count");
+        const std::string state =
+            k.get_buffer_identifier<uint_>(m_state.get_buffer());
+
+        k <<
+            "__local uint scratch[" << uint_(work_group_size) << "];\n" <<
+            "__local uint base;\n" <<
+            "const uint lid = get_local_id(0);\n" <<
+            "const uint wg_size = get_local_size(0);\n" <<
+            "const uint i = get_global_id(0);\n" <<
+            "uint flag = 0;\n" <<
+            "if(i < count && (";
+        selector.select(k);
+        k << ")){\n" <<
+            "    flag = 1;\n" <<
+            "}\n" <<
+
+            // inclusive prefix sum of the flags of the work-group
+            "scratch[lid] = flag;\n" <<
+            "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+            "for(uint offset = 1; offset < wg_size; offset <<= 1){\n" <<
+            "    const uint x = lid >= offset ? scratch[lid - offset] : 0;\n" <<
+            "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+            "    scratch[lid] += x;\n" <<
+            "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+            "}\n" <<
+            "if(lid == wg_size - 1){\n" <<
+            "    base = atomic_add(&" << state << "[0], scratch[lid]);\n" <<
+            "}\n" <<
+            "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+            "const uint index = base + scratch[lid] - 1;\n" <<
+            "if(flag && index < " << state << "[1]){\n" <<
+            "    " << m_values.begin()[k.var<uint_>("index")] << " = " <<
+                      first[k.var<uint_>("i")] << ";\n" <<
+            "}\n";
+
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(count_arg, static_cast<uint_>(count));
+
+        const size_t global_size =
+            ((count + work_group_size - 1) / work_group_size) * work_group_size;
+        queue.enqueue_1d_range_kernel(kernel, 0, global_size, work_group_size);
+    }
+
+private:
+    vector<T> m_values;
+    vector<uint_> m_state;
+    size_type m_capacity;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_WORK_QUEUE_HPP
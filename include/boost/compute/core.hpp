@@ -17,6 +17,7 @@
 
 #include <boost/compute/buffer.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/command_sequence.hpp>
 #include <boost/compute/config.hpp>
 #include <boost/compute/context.hpp>
 #include <boost/compute/device.hpp>
@@ -28,5 +29,6 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/user_event.hpp>
 #include <boost/compute/version.hpp>
+#include <boost/compute/wait_strategy.hpp>
 
 #endif // BOOST_COMPUTE_CORE_HPP
@@ -0,0 +1,51 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_BROADCAST_VALUE_HPP
+#define BOOST_COMPUTE_DETAIL_BROADCAST_VALUE_HPP
+
+#include <cstddef>
+
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/buffer_value.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/constant_iterator.hpp>
+#include <boost/compute/iterator/permutation_iterator.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+template<class T>
+struct broadcast_iterator
+{
+    typedef permutation_iterator<
+        buffer_iterator<T>, constant_iterator<uint_>
+    > type;
+};
+
+// returns an iterator which yields the value referenced by value (which is
+// stored on the device) at every position. kernels read the value directly
+// from its buffer so it is never copied to the host.
+template<class T>
+inline typename broadcast_iterator<T>::type
+make_broadcast_iterator(const buffer_value<T> &value, size_t index = 0)
+{
+    return make_permutation_iterator(
+        buffer_iterator<T>(value.get_buffer(), value.get_offset() / sizeof(T)),
+        make_constant_iterator<uint_>(0, index)
+    );
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_BROADCAST_VALUE_HPP
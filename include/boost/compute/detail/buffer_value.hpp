@@ -139,6 +139,18 @@ public:
         return operator=(T(value));
     }
 
+    // returns the buffer holding the value (null for values on the host)
+    const buffer& get_buffer() const
+    {
+        return m_buffer;
+    }
+
+    // returns the offset of the value in its buffer (in bytes)
+    size_t get_offset() const
+    {
+        return m_index;
+    }
+
     detail::device_ptr<T> operator&() const
     {
         return detail::device_ptr<T>(m_buffer, m_index);
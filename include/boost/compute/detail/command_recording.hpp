@@ -0,0 +1,300 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_COMMAND_RECORDING_HPP
+#define BOOST_COMPUTE_DETAIL_COMMAND_RECORDING_HPP
+
+#include <map>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/exception.hpp>
+#include <boost/compute/detail/mutex.hpp>
+
+#ifdef BOOST_COMPUTE_THREAD_SAFE
+#  ifndef BOOST_NO_CXX11_HDR_ATOMIC
+#    include <atomic>
+#  else
+#    include <boost/atomic.hpp>
+#  endif
+#endif
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// a command enqueued to a queue while it was recording. kernels are
+// cloned with their arguments and the memory objects they use are
+// retained so that the command can be enqueued again later.
+struct recorded_command
+{
+    enum command_type {
+        nd_range_kernel,
+        copy_buffer,
+        fill_buffer,
+        write_buffer,
+        read_buffer
+    };
+
+    explicit recorded_command(command_type type_)
+        : type(type_),
+          src_offset(0),
+          dst_offset(0),
+          size(0),
+          host_ptr(0)
+    {
+    }
+
+    command_type type;
+
+    // nd_range_kernel (empty offset or local sizes are passed as null)
+    kernel kernel_;
+    std::vector<size_t> global_work_offset;
+    std::vector<size_t> global_work_size;
+    std::vector<size_t> local_work_size;
+    std::vector<buffer> memory_objects;
+
+    // copy_buffer reads src, the other transfers use dst
+    buffer src;
+    buffer dst;
+    size_t src_offset;
+    size_t dst_offset;
+    size_t size;
+
+    // the fill pattern or the bytes of a blocking write
+    std::vector<unsigned char> data;
+
+    // the host memory of non-blocking reads and writes
+    void *host_ptr;
+};
+
+typedef std::vector<recorded_command> recorded_command_list;
+
+// the number of recording queues, read by each command without locking
+#ifdef BOOST_COMPUTE_THREAD_SAFE
+#  ifndef BOOST_NO_CXX11_HDR_ATOMIC
+typedef std::atomic<size_t> command_recording_count;
+#  else
+typedef boost::atomic<size_t> command_recording_count;
+#  endif
+#else
+typedef size_t command_recording_count;
+#endif
+
+// the command queues which are currently recording (see
+// command_queue::begin_recording()) and their commands
+class command_recording_registry : boost::noncopyable
+{
+public:
+    command_recording_registry()
+        : m_count(0)
+    {
+    }
+
+    void begin(cl_command_queue queue)
+    {
+        scoped_lock lock(m_mutex);
+
+        if(m_lists.count(queue)){
+            BOOST_THROW_EXCEPTION(opencl_error(CL_INVALID_OPERATION));
+        }
+
+        m_lists[queue] = boost::make_shared<recorded_command_list>();
+        m_count = m_lists.size();
+    }
+
+    boost::shared_ptr<recorded_command_list> end(cl_command_queue queue)
+    {
+        scoped_lock lock(m_mutex);
+
+        list_map::iterator i = m_lists.find(queue);
+        if(i == m_lists.end()){
+            BOOST_THROW_EXCEPTION(opencl_error(CL_INVALID_OPERATION));
+        }
+
+        boost::shared_ptr<recorded_command_list> list = i->second;
+        m_lists.erase(i);
+        m_count = m_lists.size();
+
+        return list;
+    }
+
+    // returns true if any queue is recording. this is checked (with an
+    // atomic load instead of the lock) before each command so that it
+    // costs nothing otherwise.
+    bool active() const
+    {
+        return m_count != 0;
+    }
+
+    bool is_recording(cl_command_queue queue)
+    {
+        scoped_lock lock(m_mutex);
+
+        return m_lists.count(queue) != 0;
+    }
+
+    void append(cl_command_queue queue, const recorded_command &command)
+    {
+        scoped_lock lock(m_mutex);
+
+        list_map::iterator i = m_lists.find(queue);
+        if(i != m_lists.end()){
+            i->second->push_back(command);
+        }
+    }
+
+    // the registry is shared by all threads
+    static command_recording_registry& get()
+    {
+        static command_recording_registry registry;
+
+        return registry;
+    }
+
+private:
+    typedef std::map<
+        cl_command_queue, boost::shared_ptr<recorded_command_list>
+    > list_map;
+
+    mutex m_mutex;
+    list_map m_lists;
+    command_recording_count m_count;
+};
+
+// returns true if queue is recording its commands
+inline bool is_recording_commands(cl_command_queue queue)
+{
+    command_recording_registry &registry = command_recording_registry::get();
+
+    return registry.active() && registry.is_recording(queue);
+}
+
+inline void record_nd_range_kernel(cl_command_queue queue,
+                                   const kernel &kernel_,
+                                   size_t work_dim,
+                                   const size_t *global_work_offset,
+                                   const size_t *global_work_size,
+                                   const size_t *local_work_size)
+{
+    recorded_command command(recorded_command::nd_range_kernel);
+
+    // the kernel object is shared with later launches (e.g. through the
+    // kernel cache) which set other arguments
+    command.kernel_ = kernel_.clone();
+
+    if(global_work_offset){
+        command.global_work_offset.assign(
+            global_work_offset, global_work_offset + work_dim
+        );
+    }
+    command.global_work_size.assign(
+        global_work_size, global_work_size + work_dim
+    );
+    if(local_work_size){
+        command.local_work_size.assign(
+            local_work_size, local_work_size + work_dim
+        );
+    }
+
+    // keep the (possibly temporary) buffers of the kernel alive
+    const std::vector<cl_mem> objects = kernel_.get_memory_object_args();
+    for(size_t i = 0; i < objects.size(); i++){
+        command.memory_objects.push_back(buffer(objects[i]));
+    }
+
+    command_recording_registry::get().append(queue, command);
+}
+
+inline void record_copy_buffer(cl_command_queue queue,
+                               const buffer &src,
+                               const buffer &dst,
+                               size_t src_offset,
+                               size_t dst_offset,
+                               size_t size)
+{
+    recorded_command command(recorded_command::copy_buffer);
+    command.src = src;
+    command.dst = dst;
+    command.src_offset = src_offset;
+    command.dst_offset = dst_offset;
+    command.size = size;
+
+    command_recording_registry::get().append(queue, command);
+}
+
+inline void record_fill_buffer(cl_command_queue queue,
+                               const buffer &dst,
+                               const void *pattern,
+                               size_t pattern_size,
+                               size_t offset,
+                               size_t size)
+{
+    const unsigned char *bytes = static_cast<const unsigned char *>(pattern);
+
+    recorded_command command(recorded_command::fill_buffer);
+    command.dst = dst;
+    command.dst_offset = offset;
+    command.size = size;
+    command.data.assign(bytes, bytes + pattern_size);
+
+    command_recording_registry::get().append(queue, command);
+}
+
+// blocking writes are recorded with a copy of their data, non-blocking
+// writes with their host pointer
+inline void record_write_buffer(cl_command_queue queue,
+                                const buffer &dst,
+                                size_t offset,
+                                size_t size,
+                                const void *host_ptr,
+                                bool blocking)
+{
+    recorded_command command(recorded_command::write_buffer);
+    command.dst = dst;
+    command.dst_offset = offset;
+    command.size = size;
+    if(blocking){
+        const unsigned char *bytes = static_cast<const unsigned char *>(host_ptr);
+        command.data.assign(bytes, bytes + size);
+    }
+    else {
+        command.host_ptr = const_cast<void *>(host_ptr);
+    }
+
+    command_recording_registry::get().append(queue, command);
+}
+
+inline void record_read_buffer(cl_command_queue queue,
+                               const buffer &src,
+                               size_t offset,
+                               size_t size,
+                               void *host_ptr)
+{
+    recorded_command command(recorded_command::read_buffer);
+    command.dst = src;
+    command.dst_offset = offset;
+    command.size = size;
+    command.host_ptr = host_ptr;
+
+    command_recording_registry::get().append(queue, command);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_COMMAND_RECORDING_HPP
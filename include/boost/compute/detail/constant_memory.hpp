@@ -0,0 +1,65 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_CONSTANT_MEMORY_HPP
+#define BOOST_COMPUTE_DETAIL_CONSTANT_MEMORY_HPP
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/context.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// the __constant memory available to the kernels of a context, i.e. the
+// smallest limits of its devices
+struct constant_memory_limits
+{
+    explicit constant_memory_limits(const context &context)
+        : size((std::numeric_limits<ulong_>::max)()),
+          args((std::numeric_limits<uint_>::max)())
+    {
+        const std::vector<device> devices = context.get_devices();
+        for(size_t i = 0; i < devices.size(); i++){
+            const boost::shared_ptr<device_profile> profile =
+                device_profile::get(devices[i]);
+
+            size = (std::min)(size, profile->max_constant_buffer_size());
+            args = (std::min)(args, profile->max_constant_args());
+        }
+    }
+
+    // the size in bytes of the largest __constant argument
+    ulong_ size;
+
+    // the number of __constant arguments of a kernel
+    uint_ args;
+};
+
+// returns true if a buffer of size bytes can be a __constant argument of
+// the kernels of context
+inline bool fits_in_constant_memory(size_t size, const context &context)
+{
+    return size <= constant_memory_limits(context).size;
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_CONSTANT_MEMORY_HPP
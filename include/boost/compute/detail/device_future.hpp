@@ -0,0 +1,105 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_DEVICE_FUTURE_HPP
+#define BOOST_COMPUTE_DETAIL_DEVICE_FUTURE_HPP
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/event.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/utility/buffer_pool.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// storage on the device for the scalar result of an asynchronous
+// algorithm. the value is stored as Stored and converted to T when it is
+// read. the buffer is drawn from the global buffer pool and returned to it
+// when the last future holding the value is destroyed.
+template<class T, class Stored = T>
+class device_future_value : public future_value<T>, boost::noncopyable
+{
+public:
+    explicit device_future_value(const command_queue &queue)
+        : m_queue(queue),
+          m_pool(buffer_pool::get_global_pool(queue.get_context()))
+    {
+        m_buffer = m_pool->allocate(sizeof(Stored), queue);
+    }
+
+    ~device_future_value()
+    {
+        m_pool->release(m_buffer, m_queue);
+    }
+
+    // iterator for the algorithm to write the result to
+    buffer_iterator<Stored> begin() const
+    {
+        return buffer_iterator<Stored>(m_buffer, 0);
+    }
+
+    T read()
+    {
+        return static_cast<T>(read_single_value<Stored>(m_buffer, 0, m_queue));
+    }
+
+private:
+    command_queue m_queue;
+    boost::shared_ptr<buffer_pool> m_pool;
+    buffer m_buffer;
+};
+
+// returns a future which reads value after all of the commands currently
+// enqueued to queue are complete
+template<class T, class Stored>
+inline future<T>
+make_device_future(const boost::shared_ptr<device_future_value<T, Stored> > &value,
+                   command_queue &queue)
+{
+    event event_;
+    queue.enqueue_marker(&event_);
+
+    return future<T>(value, event_);
+}
+
+// returns a future holding result which is ready after all of the commands
+// currently enqueued to queue are complete
+template<class Result>
+inline future<Result> make_marker_future(const Result &result,
+                                         command_queue &queue)
+{
+    event event_;
+    queue.enqueue_marker(&event_);
+
+    return future<Result>(result, event_);
+}
+
+// future<void> version of make_marker_future()
+inline future<void> make_marker_future(command_queue &queue)
+{
+    event event_;
+    queue.enqueue_marker(&event_);
+
+    return future<void>(event_);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_DEVICE_FUTURE_HPP
@@ -0,0 +1,343 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_DEVICE_PROFILE_HPP
+#define BOOST_COMPUTE_DETAIL_DEVICE_PROFILE_HPP
+
+#include <map>
+#include <set>
+#include <limits>
+#include <string>
+#include <vector>
+#include <sstream>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/platform.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/mutex.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/vector_width.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// describes the characteristics of a device which the algorithms use to
+// choose between their serial and parallel strategies (instead of checking
+// the device type).
+//
+// the hardware characteristics are queried once per device, so the
+// algorithms read them from the profile instead of calling clGetDeviceInfo()
+// on each invocation. the launch latency and the time a single work-item
+// needs per element are estimated and can be replaced with measured values
+// (in nanoseconds) through the
+// "launch_latency" and "serial_element_time" parameters of the
+// "__boost_device_profile" object in the parameter cache (see
+// experimental::autotuner::tune_device_profile()).
+class device_profile
+{
+public:
+    explicit device_profile(const device &device)
+        : m_device(device),
+          m_type(device.type()),
+          m_version(device.get_version()),
+          m_vendor(device.vendor()),
+          m_platform_vendor(device.platform().vendor()),
+          m_compute_units((std::max)(device.compute_units(), uint_(1))),
+          m_max_work_group_size(device.max_work_group_size()),
+          m_local_memory_size(device.local_memory_size()),
+          m_global_memory_size(device.global_memory_size()),
+          m_max_memory_alloc_size(device.max_memory_alloc_size()),
+          m_max_constant_buffer_size(
+              device.get_info<ulong_>(CL_DEVICE_MAX_CONSTANT_BUFFER_SIZE)
+          ),
+          m_max_constant_args(device.get_info<uint_>(CL_DEVICE_MAX_CONSTANT_ARGS)),
+          m_local_memory(
+              device.get_info<cl_device_local_mem_type>(CL_DEVICE_LOCAL_MEM_TYPE) == CL_LOCAL
+          ),
+          m_host_unified_memory(false),
+          m_opencl_c_version(100),
+          m_atomic_memory_capabilities(0),
+          m_vector_width_int(preferred_vector_width<int_>(device)),
+          m_vector_width_float(preferred_vector_width<float_>(device))
+    {
+    #ifdef CL_VERSION_1_1
+        m_host_unified_memory = device.get_info<bool>(CL_DEVICE_HOST_UNIFIED_MEMORY);
+        if(m_version >= 110){
+            m_opencl_c_version = parse_opencl_c_version(
+                device.get_info<std::string>(CL_DEVICE_OPENCL_C_VERSION)
+            );
+        }
+    #endif
+    #ifdef CL_VERSION_3_0
+        if(m_version >= 300){
+            query_opencl_c_versions(device);
+            m_atomic_memory_capabilities = device.get_info<cl_device_atomic_capabilities>(
+                CL_DEVICE_ATOMIC_MEMORY_CAPABILITIES
+            );
+        }
+    #endif
+
+        const std::vector<std::string> extensions = device.extensions();
+        m_extensions.insert(extensions.begin(), extensions.end());
+    }
+
+    cl_device_type type() const
+    {
+        return m_type;
+    }
+
+    // returns the numeric version (major * 100 + minor)
+    uint_ version() const
+    {
+        return m_version;
+    }
+
+    const std::string& vendor() const
+    {
+        return m_vendor;
+    }
+
+    const std::string& platform_vendor() const
+    {
+        return m_platform_vendor;
+    }
+
+    bool supports_extension(const std::string &name) const
+    {
+        return m_extensions.count(name) != 0;
+    }
+
+    // returns true if the compiler of the device supports the OpenCL C
+    // version (major * 100 + minor * 10). this is not implied by the
+    // device version, OpenCL 3.0 devices may only support OpenCL C 1.2
+    // and 3.0 with the OpenCL C 2.0 features being optional.
+    bool supports_opencl_c(uint_ version) const
+    {
+        return version <= m_opencl_c_version || m_opencl_c_versions.count(version) != 0;
+    }
+
+    // returns the CL_DEVICE_ATOMIC_MEMORY_CAPABILITIES of the device (zero
+    // before OpenCL 3.0)
+    ulong_ atomic_memory_capabilities() const
+    {
+        return m_atomic_memory_capabilities;
+    }
+
+    uint_ compute_units() const
+    {
+        return m_compute_units;
+    }
+
+    size_t max_work_group_size() const
+    {
+        return m_max_work_group_size;
+    }
+
+    ulong_ local_memory_size() const
+    {
+        return m_local_memory_size;
+    }
+
+    ulong_ global_memory_size() const
+    {
+        return m_global_memory_size;
+    }
+
+    // returns the size in bytes of the largest buffer
+    ulong_ max_memory_alloc_size() const
+    {
+        return m_max_memory_alloc_size;
+    }
+
+    // returns the size in bytes of the largest __constant buffer argument
+    ulong_ max_constant_buffer_size() const
+    {
+        return m_max_constant_buffer_size;
+    }
+
+    // returns the number of __constant arguments a kernel may have
+    uint_ max_constant_args() const
+    {
+        return m_max_constant_args;
+    }
+
+    // returns true if the device has dedicated local memory. devices where
+    // local memory is emulated in global memory (CPUs) are faster with one
+    // long-running work-item per compute unit than with work-group
+    // reductions in local memory.
+    bool has_local_memory() const
+    {
+        return m_local_memory;
+    }
+
+    // returns true if the device shares its memory with the host
+    // (integrated GPUs, APUs and CPUs)
+    bool host_unified_memory() const
+    {
+        return m_host_unified_memory;
+    }
+
+    uint_ preferred_vector_width_int() const
+    {
+        return m_vector_width_int;
+    }
+
+    uint_ preferred_vector_width_float() const
+    {
+        return m_vector_width_float;
+    }
+
+    // returns the number of work-items which execute concurrently
+    size_t parallelism() const
+    {
+        if(m_local_memory){
+            return size_t(m_compute_units) * m_max_work_group_size;
+        }
+
+        return m_compute_units;
+    }
+
+    // returns the time in nanoseconds to launch a kernel
+    double launch_latency() const
+    {
+        return get_parameter("launch_latency", m_local_memory ? 2048 : 1024);
+    }
+
+    // returns the time in nanoseconds a single work-item needs to process
+    // one element
+    double serial_element_time() const
+    {
+        return get_parameter("serial_element_time", m_local_memory ? 64 : 1);
+    }
+
+    // returns the number of elements below which a single work-item is
+    // faster than a parallel algorithm.
+    //
+    // with n elements, the serial algorithm takes n * t and the parallel
+    // one L + n * t / p (for the launch latency L, the serial element time
+    // t and the parallelism p) so the parallel algorithm pays off for
+    // n > L / (t * (1 - 1 / p)).
+    size_t serial_threshold() const
+    {
+        const double p = static_cast<double>(parallelism());
+        if(p <= 1){
+            return (std::numeric_limits<size_t>::max)();
+        }
+
+        const double threshold =
+            launch_latency() / (serial_element_time() * (1.0 - 1.0 / p));
+
+        return static_cast<size_t>(threshold);
+    }
+
+    // returns the global profile for device
+    static boost::shared_ptr<device_profile> get(const device &device)
+    {
+        typedef std::map<cl_device_id, boost::shared_ptr<device_profile> > profile_map;
+
+        static mutex profiles_mutex;
+        static profile_map profiles;
+
+        scoped_lock lock(profiles_mutex);
+
+        boost::shared_ptr<device_profile> &profile = profiles[device.id()];
+        if(!profile){
+            profile = boost::make_shared<device_profile>(device);
+        }
+
+        return profile;
+    }
+
+private:
+    // parses an "OpenCL C <major>.<minor> <vendor-specific>" string
+    static uint_ parse_opencl_c_version(const std::string &string)
+    {
+        std::stringstream stream(string);
+        stream.ignore(9); // 'OpenCL C '
+
+        uint_ major = 1, minor = 0;
+        char dot = 0;
+        stream >> major >> dot >> minor;
+
+        return major * 100 + minor * 10;
+    }
+
+    #ifdef CL_VERSION_3_0
+    // adds the versions in CL_DEVICE_OPENCL_C_ALL_VERSIONS
+    void query_opencl_c_versions(const device &device)
+    {
+        size_t size = 0;
+        cl_int ret = clGetDeviceInfo(
+            device.id(), CL_DEVICE_OPENCL_C_ALL_VERSIONS, 0, 0, &size
+        );
+        if(ret != CL_SUCCESS || size == 0){
+            return;
+        }
+
+        std::vector<cl_name_version> versions(size / sizeof(cl_name_version));
+        ret = clGetDeviceInfo(
+            device.id(), CL_DEVICE_OPENCL_C_ALL_VERSIONS,
+            versions.size() * sizeof(cl_name_version), &versions[0], 0
+        );
+        if(ret != CL_SUCCESS){
+            return;
+        }
+
+        for(size_t i = 0; i < versions.size(); i++){
+            m_opencl_c_versions.insert(
+                static_cast<uint_>(CL_VERSION_MAJOR(versions[i].version) * 100 +
+                                   CL_VERSION_MINOR(versions[i].version) * 10)
+            );
+        }
+    }
+    #endif // CL_VERSION_3_0
+
+    double get_parameter(const char *parameter, uint_ default_value) const
+    {
+        const uint_ value = parameter_cache::get_global_cache(m_device)->get(
+            "__boost_device_profile", parameter, default_value
+        );
+
+        return static_cast<double>((std::max)(value, uint_(1)));
+    }
+
+private:
+    device m_device;
+    cl_device_type m_type;
+    uint_ m_version;
+    std::string m_vendor;
+    std::string m_platform_vendor;
+    std::set<std::string> m_extensions;
+    uint_ m_compute_units;
+    size_t m_max_work_group_size;
+    ulong_ m_local_memory_size;
+    ulong_ m_global_memory_size;
+    ulong_ m_max_memory_alloc_size;
+    ulong_ m_max_constant_buffer_size;
+    uint_ m_max_constant_args;
+    bool m_local_memory;
+    bool m_host_unified_memory;
+    uint_ m_opencl_c_version;
+    std::set<uint_> m_opencl_c_versions;
+    ulong_ m_atomic_memory_capabilities;
+    uint_ m_vector_width_int;
+    uint_ m_vector_width_float;
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_DEVICE_PROFILE_HPP
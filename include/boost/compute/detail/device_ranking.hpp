@@ -0,0 +1,245 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_DEVICE_RANKING_HPP
+#define BOOST_COMPUTE_DETAIL_DEVICE_RANKING_HPP
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/platform.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+
+#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+#include <fstream>
+#include <boost/filesystem.hpp>
+#include <boost/compute/detail/offline_cache.hpp>
+#endif
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// estimates the peak single precision flops of device from the number and
+// clock of its compute units and the lanes of each compute unit
+inline double device_peak_flops(const device &device)
+{
+    double lanes = 32;
+    if(device.type() & device::cpu){
+        lanes = device.get_info<uint_>(CL_DEVICE_NATIVE_VECTOR_WIDTH_FLOAT);
+    }
+    else {
+        const std::string vendor = device.vendor();
+        if(vendor.find("NVIDIA") != std::string::npos){
+            // streaming multiprocessors
+            lanes = 128;
+        }
+        else if(vendor.find("Advanced Micro Devices") != std::string::npos ||
+                vendor.find("AMD") != std::string::npos){
+            lanes = 64;
+        }
+        else if(vendor.find("Intel") != std::string::npos){
+            // execution units
+            lanes = 8;
+        }
+    }
+
+    // each lane completes one fused multiply-add per clock
+    return 2.0 * lanes * device.compute_units() * device.clock_frequency() * 1e6;
+}
+
+// measures the bandwidth (in bytes per second) of copies between two
+// buffers on device, returns zero if they could not be run
+inline double device_copy_bandwidth(const device &device)
+{
+    try {
+        const context context(device);
+        command_queue queue(context, device, command_queue::enable_profiling);
+
+        const size_t size = static_cast<size_t>(
+            (std::min)(ulong_(32) << 20, device.max_memory_alloc_size() / 4)
+        );
+        const buffer a(context, size);
+        const buffer b(context, size);
+
+        // the first copy also allocates the buffers on the device
+        queue.enqueue_copy_buffer_async(a, b, 0, 0, size).wait();
+
+        ulong_ best = 0;
+        for(size_t i = 0; i < 3; i++){
+            event copy = queue.enqueue_copy_buffer_async(a, b, 0, 0, size);
+            copy.wait();
+
+            const ulong_ time =
+                copy.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_END) -
+                copy.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_START);
+            if(i == 0 || time < best){
+                best = time;
+            }
+        }
+
+        // each byte is read and written once
+        return best ? 2.0 * size / (best * 1e-9) : 0.0;
+    }
+    catch(const opencl_error&){
+        return 0.0;
+    }
+}
+
+// returns the rank of device for the selection mode ("score" or
+// "benchmark"), devices with higher ranks are faster
+inline double device_rank(const device &device, const std::string &mode)
+{
+    const double flops = device_peak_flops(device);
+
+    if(mode == "benchmark"){
+        const double bandwidth = device_copy_bandwidth(device);
+        if(bandwidth == 0.0){
+            return 0.0;
+        }
+
+        // inverse of the time of a workload doing eight operations for
+        // each byte of memory traffic
+        return 1.0 / (1.0 / bandwidth + 8.0 / flops);
+    }
+
+    // gpus sharing the memory of the host also share its bandwidth
+    if((device.type() & device::gpu) &&
+       device.get_info<cl_bool>(CL_DEVICE_HOST_UNIFIED_MEMORY)){
+        return flops / 2;
+    }
+
+    return flops;
+}
+
+#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+// the device selected for mode is stored in the offline cache with the
+// versions of its platform and driver, so it is selected again without
+// ranking (or enumerating the devices of other platforms) until a driver
+// is updated
+inline std::string ranked_device_file_name()
+{
+    boost::filesystem::path path(offline_cache::get_global_cache().path());
+    path /= "default_device.txt";
+
+    return path.string();
+}
+
+inline bool read_ranked_device(const std::vector<platform> &platforms,
+                               const std::string &mode,
+                               device &result)
+{
+    std::ifstream file(ranked_device_file_name().c_str());
+
+    std::string mode_;
+    std::string platform_name;
+    std::string platform_version;
+    std::string device_name;
+    std::string driver_version;
+    if(!std::getline(file, mode_) ||
+       !std::getline(file, platform_name) ||
+       !std::getline(file, platform_version) ||
+       !std::getline(file, device_name) ||
+       !std::getline(file, driver_version) ||
+       mode_ != mode){
+        return false;
+    }
+
+    for(size_t i = 0; i < platforms.size(); i++){
+        const platform &platform_ = platforms[i];
+        if(platform_.name() != platform_name ||
+           platform_.version() != platform_version){
+            continue;
+        }
+
+        const std::vector<device> devices = platform_.devices();
+        for(size_t j = 0; j < devices.size(); j++){
+            if(devices[j].name() == device_name &&
+               devices[j].driver_version() == driver_version){
+                result = devices[j];
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+inline void write_ranked_device(const std::string &mode, const device &device)
+{
+    const boost::filesystem::path path(ranked_device_file_name());
+
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(path.parent_path(), ec);
+    if(ec){
+        return;
+    }
+
+    const platform platform_ = device.platform();
+
+    std::ofstream file(path.string().c_str());
+    file << mode << "\n"
+         << platform_.name() << "\n"
+         << platform_.version() << "\n"
+         << device.name() << "\n"
+         << device.driver_version() << "\n";
+}
+#endif // BOOST_COMPUTE_USE_OFFLINE_CACHE
+
+// returns the device of platforms with the highest rank for mode, or a
+// null device if there are no devices
+inline device select_ranked_device(const std::vector<platform> &platforms,
+                                   const std::string &mode)
+{
+    device selected;
+
+#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+    if(read_ranked_device(platforms, mode, selected)){
+        return selected;
+    }
+#endif
+
+    double selected_rank = -1;
+    for(size_t i = 0; i < platforms.size(); i++){
+        const std::vector<device> devices = platforms[i].devices();
+        for(size_t j = 0; j < devices.size(); j++){
+            const double rank = device_rank(devices[j], mode);
+            if(rank > selected_rank){
+                selected = devices[j];
+                selected_rank = rank;
+            }
+        }
+    }
+
+#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+    if(selected.id()){
+        try {
+            write_ranked_device(mode, selected);
+        }
+        catch(...){
+        }
+    }
+#endif
+
+    return selected;
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_DEVICE_RANKING_HPP
@@ -0,0 +1,45 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_ENQUEUE_WAIT_LIST_HPP
+#define BOOST_COMPUTE_DETAIL_ENQUEUE_WAIT_LIST_HPP
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/utility/wait_list.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// makes the commands enqueued to queue after this call wait for the events
+// in events. with OpenCL 1.2 this enqueues a barrier so the host does not
+// block, otherwise the host waits for the events.
+inline void enqueue_wait_list(command_queue &queue, const wait_list &events)
+{
+    if(events.empty()){
+        return;
+    }
+
+    #ifdef CL_VERSION_1_2
+    if(queue.get_version() >= 120){
+        queue.enqueue_barrier(events);
+        return;
+    }
+    #endif
+
+    wait_list(events).wait();
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_ENQUEUE_WAIT_LIST_HPP
@@ -20,13 +20,14 @@
        thread_local type name ctor;
 #  else
       // use thread_specific_ptr from boost.thread
+#     include <boost/preprocessor/cat.hpp>
 #     include <boost/thread/tss.hpp>
 #     define BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(type, name, ctor) \
         static ::boost::thread_specific_ptr< type > BOOST_PP_CAT(name, _tls_ptr_); \
         if(!BOOST_PP_CAT(name, _tls_ptr_).get()){ \
             BOOST_PP_CAT(name, _tls_ptr_).reset(new type ctor); \
         } \
-        static type &name = *BOOST_PP_CAT(name, _tls_ptr_);
+        type &name = *BOOST_PP_CAT(name, _tls_ptr_);
 #  endif
 #else
    // no thread-safety, just use static
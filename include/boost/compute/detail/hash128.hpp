@@ -0,0 +1,292 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_HASH128_HPP
+#define BOOST_COMPUTE_DETAIL_HASH128_HPP
+
+#include <cstring>
+#include <string>
+#include <ostream>
+#include <streambuf>
+#include <algorithm>
+
+#include <boost/cstdint.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// a 128-bit hash value
+struct hash128_digest
+{
+    hash128_digest()
+        : low(0), high(0)
+    {
+    }
+
+    bool operator==(const hash128_digest &other) const
+    {
+        return low == other.low && high == other.high;
+    }
+
+    bool operator!=(const hash128_digest &other) const
+    {
+        return !(*this == other);
+    }
+
+    // returns the digest as a string of 32 hex digits
+    std::string str() const
+    {
+        static const char digits[] = "0123456789abcdef";
+
+        std::string result(32, '0');
+        for(int i = 0; i < 16; i++){
+            result[15 - i] = digits[(high >> (4 * i)) & 0xf];
+            result[31 - i] = digits[(low >> (4 * i)) & 0xf];
+        }
+        return result;
+    }
+
+    boost::uint64_t low;
+    boost::uint64_t high;
+};
+
+// incremental 128-bit MurmurHash3 (x64 variant).
+//
+// this is a fast non-cryptographic hash used for the in-memory cache keys
+// of generated kernel sources. the same bytes produce the same digest no
+// matter how they are split across calls to process_bytes(). the digest
+// depends on the byte order of the host so it must not be stored (the
+// offline cache uses sha1() instead).
+class hash128
+{
+public:
+    hash128()
+        : m_h1(0),
+          m_h2(0),
+          m_length(0),
+          m_tail_size(0)
+    {
+    }
+
+    void process_bytes(const void *data, size_t size)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        m_length += size;
+
+        // complete a partial block from a previous call
+        if(m_tail_size){
+            const size_t n = (std::min)(size, size_t(16) - m_tail_size);
+            std::memcpy(m_tail + m_tail_size, bytes, n);
+            m_tail_size += n;
+            bytes += n;
+            size -= n;
+
+            if(m_tail_size < 16){
+                return;
+            }
+            process_block(m_tail);
+            m_tail_size = 0;
+        }
+
+        for(; size >= 16; bytes += 16, size -= 16){
+            process_block(bytes);
+        }
+
+        std::memcpy(m_tail, bytes, size);
+        m_tail_size = size;
+    }
+
+    void process_string(const std::string &string)
+    {
+        process_bytes(string.data(), string.size());
+    }
+
+    hash128_digest digest() const
+    {
+        boost::uint64_t h1 = m_h1;
+        boost::uint64_t h2 = m_h2;
+        boost::uint64_t k1 = 0;
+        boost::uint64_t k2 = 0;
+
+        for(size_t i = m_tail_size; i > 8; i--){
+            k2 ^= boost::uint64_t(m_tail[i - 1]) << ((i - 9) * 8);
+        }
+        if(m_tail_size > 8){
+            k2 *= c2(); k2 = rotl(k2, 33); k2 *= c1(); h2 ^= k2;
+        }
+
+        for(size_t i = (std::min)(m_tail_size, size_t(8)); i > 0; i--){
+            k1 ^= boost::uint64_t(m_tail[i - 1]) << ((i - 1) * 8);
+        }
+        if(m_tail_size > 0){
+            k1 *= c1(); k1 = rotl(k1, 31); k1 *= c2(); h1 ^= k1;
+        }
+
+        h1 ^= boost::uint64_t(m_length);
+        h2 ^= boost::uint64_t(m_length);
+        h1 += h2;
+        h2 += h1;
+        h1 = fmix(h1);
+        h2 = fmix(h2);
+        h1 += h2;
+        h2 += h1;
+
+        hash128_digest result;
+        result.low = h1;
+        result.high = h2;
+        return result;
+    }
+
+private:
+    static boost::uint64_t c1() { return UINT64_C(0x87c37b91114253d5); }
+    static boost::uint64_t c2() { return UINT64_C(0x4cf5ad432745937f); }
+
+    static boost::uint64_t rotl(boost::uint64_t x, int r)
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    static boost::uint64_t fmix(boost::uint64_t k)
+    {
+        k ^= k >> 33;
+        k *= UINT64_C(0xff51afd7ed558ccd);
+        k ^= k >> 33;
+        k *= UINT64_C(0xc4ceb9fe1a85ec53);
+        k ^= k >> 33;
+        return k;
+    }
+
+    void process_block(const unsigned char *block)
+    {
+        boost::uint64_t k1;
+        boost::uint64_t k2;
+        std::memcpy(&k1, block, 8);
+        std::memcpy(&k2, block + 8, 8);
+
+        k1 *= c1(); k1 = rotl(k1, 31); k1 *= c2(); m_h1 ^= k1;
+        m_h1 = rotl(m_h1, 27); m_h1 += m_h2; m_h1 = m_h1 * 5 + 0x52dce729;
+
+        k2 *= c2(); k2 = rotl(k2, 33); k2 *= c1(); m_h2 ^= k2;
+        m_h2 = rotl(m_h2, 31); m_h2 += m_h1; m_h2 = m_h2 * 5 + 0x38495ab5;
+    }
+
+private:
+    boost::uint64_t m_h1;
+    boost::uint64_t m_h2;
+    size_t m_length;
+    unsigned char m_tail[16];
+    size_t m_tail_size;
+};
+
+// a stream buffer which stores the characters written to it in a string
+// and hashes them with hash128 as they are written
+class hashing_stringbuf : public std::streambuf
+{
+public:
+    hashing_stringbuf()
+    {
+        setp(m_buffer, m_buffer + sizeof(m_buffer));
+    }
+
+    // returns the characters written so far
+    const std::string& str() const
+    {
+        const_cast<hashing_stringbuf *>(this)->flush_buffer();
+        return m_string;
+    }
+
+    // replaces the contents with string
+    void str(const std::string &string)
+    {
+        setp(m_buffer, m_buffer + sizeof(m_buffer));
+        m_string.clear();
+        m_hash = hash128();
+        append(string.data(), string.size());
+    }
+
+    // returns the hash of the characters written so far
+    hash128_digest digest() const
+    {
+        const_cast<hashing_stringbuf *>(this)->flush_buffer();
+        return m_hash.digest();
+    }
+
+protected:
+    int_type overflow(int_type c)
+    {
+        flush_buffer();
+        if(!traits_type::eq_int_type(c, traits_type::eof())){
+            const char ch = traits_type::to_char_type(c);
+            append(&ch, 1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char *s, std::streamsize n)
+    {
+        flush_buffer();
+        append(s, static_cast<size_t>(n));
+        return n;
+    }
+
+private:
+    void flush_buffer()
+    {
+        append(pbase(), static_cast<size_t>(pptr() - pbase()));
+        setp(m_buffer, m_buffer + sizeof(m_buffer));
+    }
+
+    void append(const char *s, size_t n)
+    {
+        m_string.append(s, n);
+        m_hash.process_bytes(s, n);
+    }
+
+private:
+    char m_buffer[256];
+    std::string m_string;
+    hash128 m_hash;
+};
+
+// an output string stream which also hashes its contents
+class hashing_stringstream : public std::ostream
+{
+public:
+    hashing_stringstream()
+        : std::ostream(0)
+    {
+        rdbuf(&m_buffer);
+    }
+
+    const std::string& str() const
+    {
+        return m_buffer.str();
+    }
+
+    void str(const std::string &string)
+    {
+        m_buffer.str(string);
+    }
+
+    hash128_digest digest() const
+    {
+        return m_buffer.digest();
+    }
+
+private:
+    hashing_stringbuf m_buffer;
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_HASH128_HPP
@@ -0,0 +1,40 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_INDEX_TYPE_HPP
+#define BOOST_COMPUTE_DETAIL_INDEX_TYPE_HPP
+
+#include <cstddef>
+
+#include <boost/compute/types/fundamental.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns true if the index end (one past the last index used by a kernel)
+// does not fit in a 32-bit uint. kernels use uint indices unless this is
+// true as 64-bit arithmetic is slower on most devices.
+inline bool requires_64bit_indices(size_t end)
+{
+    return static_cast<ulong_>(end) > static_cast<ulong_>(~uint_(0));
+}
+
+// returns the name of the OpenCL type for indices up to end
+inline const char* index_type_name(size_t end)
+{
+    return requires_64bit_indices(end) ? "ulong" : "uint";
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_INDEX_TYPE_HPP
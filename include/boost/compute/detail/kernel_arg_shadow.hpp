@@ -0,0 +1,149 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_KERNEL_ARG_SHADOW_HPP
+#define BOOST_COMPUTE_DETAIL_KERNEL_ARG_SHADOW_HPP
+
+#include <cstring>
+#include <vector>
+
+#include <boost/compute/cl.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// copy of the arguments last set on a cl_kernel, which lets kernel::set_arg()
+// skip clSetKernelArg() when an argument is set again to the same bytes
+// (e.g. by each pass of a multi-pass algorithm).
+//
+// arguments set with a null value (local memory) are recorded by their size
+// only. memory objects and samplers (see mark_memory_object() and
+// mark_sampler()) are recorded but never match, they are always set again.
+// a released object's handle may be reused by a new object, and retaining
+// them instead would keep the objects alive as long as the kernel (e.g. in
+// the kernel cache).
+class kernel_arg_shadow
+{
+public:
+    struct arg
+    {
+        arg()
+            : valid(false),
+              local(false),
+              memory_object(false),
+              sampler(false),
+              size(0)
+        {
+        }
+
+        bool valid;
+        bool local;
+        bool memory_object;
+        bool sampler;
+        size_t size;
+        std::vector<unsigned char> bytes;
+    };
+
+    // returns true if the argument at index is known to be set to size
+    // bytes of value
+    bool contains(size_t index, size_t size, const void *value) const
+    {
+        if(index >= m_args.size()){
+            return false;
+        }
+
+        const arg &a = m_args[index];
+        if(!a.valid || a.memory_object || a.sampler ||
+           a.size != size || a.local != (value == 0)){
+            return false;
+        }
+
+        return value == 0 || size == 0 ||
+               std::memcmp(&a.bytes[0], value, size) == 0;
+    }
+
+    // records that the argument at index was set to size bytes of value
+    void insert(size_t index, size_t size, const void *value)
+    {
+        if(index >= m_args.size()){
+            m_args.resize(index + 1);
+        }
+
+        arg &a = m_args[index];
+        a.valid = true;
+        a.local = value == 0;
+        a.memory_object = false;
+        a.sampler = false;
+        a.size = size;
+        if(value){
+            const unsigned char *bytes = static_cast<const unsigned char *>(value);
+            a.bytes.assign(bytes, bytes + size);
+        }
+        else {
+            a.bytes.clear();
+        }
+    }
+
+    // forgets the value of the argument at index
+    void erase(size_t index)
+    {
+        if(index < m_args.size()){
+            m_args[index].valid = false;
+        }
+    }
+
+    // records that the argument at index is a cl_mem handle
+    void mark_memory_object(size_t index)
+    {
+        if(index < m_args.size() && m_args[index].valid){
+            m_args[index].memory_object = true;
+        }
+    }
+
+    // records that the argument at index is a cl_sampler handle
+    void mark_sampler(size_t index)
+    {
+        if(index < m_args.size() && m_args[index].valid){
+            m_args[index].sampler = true;
+        }
+    }
+
+    // returns the argument at index or 0 if its value is unknown
+    const arg* find(size_t index) const
+    {
+        if(index >= m_args.size() || !m_args[index].valid){
+            return 0;
+        }
+
+        return &m_args[index];
+    }
+
+    // returns one past the highest index of the recorded arguments
+    size_t size() const
+    {
+        return m_args.size();
+    }
+
+    // forgets the values of all arguments
+    void clear()
+    {
+        m_args.clear();
+    }
+
+private:
+    std::vector<arg> m_args;
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_KERNEL_ARG_SHADOW_HPP
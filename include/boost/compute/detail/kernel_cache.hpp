@@ -0,0 +1,211 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_KERNEL_CACHE_HPP
+#define BOOST_COMPUTE_DETAIL_KERNEL_CACHE_HPP
+
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/functional/hash.hpp>
+
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/program.hpp>
+#include <boost/compute/detail/lru_cache.hpp>
+#include <boost/compute/detail/global_static.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// caches kernel objects so that repeated algorithm launches do not call
+// clCreateKernel() each time.
+//
+// kernel arguments are state stored in the cl_kernel object, so a cached
+// kernel is only handed out while it is not checked out already. the
+// kernel objects returned by get() share a checkout handle whose
+// destructor returns the kernel to the cache once the last copy is gone
+// (the CL_KERNEL_REFERENCE_COUNT reported by the driver is not reliable
+// enough for this). when all kernels are checked out an additional one is
+// created, up to max_kernels_per_key of which are kept for each program
+// and kernel name.
+//
+// the global cache returned by get_global_cache() is thread-local when
+// BOOST_COMPUTE_THREAD_SAFE is defined, so kernels are never shared
+// between threads.
+class kernel_cache : boost::noncopyable
+{
+public:
+    static const size_t max_kernels_per_key = 8;
+
+    kernel_cache(size_t capacity)
+        : m_cache(capacity)
+    {
+    }
+
+    size_t size() const
+    {
+        return m_cache.size();
+    }
+
+    void clear()
+    {
+        m_cache.clear();
+    }
+
+    // returns a kernel object for the kernel with name in program which
+    // is not checked out by any other kernel object
+    kernel get(const program &program, const std::string &name)
+    {
+        const key_ref ref = { program.get(), name };
+
+        boost::optional<boost::shared_ptr<kernels_type> > kernels =
+            m_cache.get(ref, key_hash(), key_equal());
+
+        if(!kernels){
+            kernels = boost::make_shared<kernels_type>();
+
+            m_cache.insert(key_type(program.get(), name), *kernels);
+        }
+
+        for(size_t i = 0; i < (*kernels)->size(); i++){
+            const boost::shared_ptr<entry> &e = (**kernels)[i];
+
+            if(!e->checked_out){
+                return check_out(e);
+            }
+        }
+
+        kernel k(program, name);
+        if((*kernels)->size() < max_kernels_per_key){
+            boost::shared_ptr<entry> e = boost::make_shared<entry>(k);
+            (*kernels)->push_back(e);
+
+            return check_out(e);
+        }
+
+        return k;
+    }
+
+    // returns the global kernel cache (for the current thread)
+    static kernel_cache& get_global_cache()
+    {
+        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(kernel_cache, cache, (128));
+
+        return cache;
+    }
+
+private:
+    struct entry
+    {
+        explicit entry(const kernel &k)
+            : object(k),
+              checked_out(false)
+        {
+        }
+
+        kernel object;
+        bool checked_out;
+    };
+
+    // shared by the copies of a checked out kernel (through their argument
+    // shadow) and keeps the entry alive if it is evicted in the meantime
+    struct checkout : boost::noncopyable
+    {
+        explicit checkout(const boost::shared_ptr<entry> &e)
+            : m_entry(e)
+        {
+            m_entry->checked_out = true;
+        }
+
+        ~checkout()
+        {
+            m_entry->checked_out = false;
+        }
+
+        boost::shared_ptr<entry> m_entry;
+    };
+
+    static kernel check_out(const boost::shared_ptr<entry> &e)
+    {
+        boost::shared_ptr<checkout> handle = boost::make_shared<checkout>(e);
+
+        kernel k = e->object;
+        k.m_args = boost::shared_ptr<kernel_arg_shadow>(handle, e->object.m_args.get());
+        return k;
+    }
+
+    typedef std::pair<cl_program, std::string> key_type;
+    typedef std::vector<boost::shared_ptr<entry> > kernels_type;
+
+    struct key_ref
+    {
+        cl_program program;
+        const std::string &name;
+    };
+
+    struct key_hash
+    {
+        size_t operator()(const key_type &k) const
+        {
+            return hash(k.first, k.second);
+        }
+
+        size_t operator()(const key_ref &k) const
+        {
+            return hash(k.program, k.name);
+        }
+
+        static size_t hash(cl_program program, const std::string &name)
+        {
+            size_t seed = 0;
+            boost::hash_combine(seed, program);
+            boost::hash_combine(seed, name);
+            return seed;
+        }
+    };
+
+    struct key_equal
+    {
+        bool operator()(const key_type &a, const key_type &b) const
+        {
+            return a == b;
+        }
+
+        bool operator()(const key_ref &a, const key_type &b) const
+        {
+            return a.program == b.first && a.name == b.second;
+        }
+
+        bool operator()(const key_type &a, const key_ref &b) const
+        {
+            return (*this)(b, a);
+        }
+    };
+
+    lru_cache<key_type, boost::shared_ptr<kernels_type>, key_hash, key_equal> m_cache;
+};
+
+// returns a kernel object for the kernel with name in program from the
+// global kernel cache
+inline kernel get_cached_kernel(const program &program, const std::string &name)
+{
+    return kernel_cache::get_global_cache().get(program, name);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_KERNEL_CACHE_HPP
@@ -11,27 +11,41 @@
 #ifndef BOOST_COMPUTE_DETAIL_LRU_CACHE_HPP
 #define BOOST_COMPUTE_DETAIL_LRU_CACHE_HPP
 
-#include <map>
 #include <list>
 #include <utility>
+#include <functional>
 
 #include <boost/optional.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
 
 namespace boost {
 namespace compute {
 namespace detail {
 
-// a cache which evicts the least recently used item when it is full
-template<class Key, class Value>
+// a cache which evicts the least recently used item when it is full.
+//
+// items are stored in a list ordered from most to least recently used
+// and indexed by a hash map, so lookups, insertions and evictions are
+// all O(1). looking up an item only relinks its list node and does not
+// allocate. the get() overload taking a compatible key, hash and
+// predicate allows lookups without constructing a key_type object.
+template<class Key,
+         class Value,
+         class Hash = boost::hash<Key>,
+         class Pred = std::equal_to<Key> >
 class lru_cache
 {
 public:
     typedef Key key_type;
     typedef Value value_type;
-    typedef std::list<key_type> list_type;
-    typedef std::map<
+    typedef std::list<std::pair<key_type, value_type> > list_type;
+    typedef typename list_type::const_iterator const_iterator;
+    typedef boost::unordered_map<
                 key_type,
-                std::pair<value_type, typename list_type::iterator>
+                typename list_type::iterator,
+                Hash,
+                Pred
             > map_type;
 
     lru_cache(size_t capacity)
@@ -53,6 +67,28 @@ public:
         return m_capacity;
     }
 
+    // sets the capacity, evicting the least recently used items which do
+    // not fit anymore
+    void set_capacity(size_t capacity)
+    {
+        m_capacity = capacity;
+
+        while(size() > m_capacity){
+            evict();
+        }
+    }
+
+    // iterates over the items from the most to the least recently used
+    const_iterator begin() const
+    {
+        return m_list.begin();
+    }
+
+    const_iterator end() const
+    {
+        return m_list.end();
+    }
+
     bool empty() const
     {
         return m_map.empty();
@@ -74,40 +110,32 @@ public:
             }
 
             // insert the new item
-            m_list.push_front(key);
-            m_map[key] = std::make_pair(value, m_list.begin());
+            m_list.push_front(std::make_pair(key, value));
+            m_map.insert(std::make_pair(key, m_list.begin()));
         }
     }
 
     boost::optional<value_type> get(const key_type &key)
     {
-        // lookup value in the cache
-        typename map_type::iterator i = m_map.find(key);
-        if(i == m_map.end()){
-            // value not in cache
-            return boost::none;
-        }
-
-        // return the value, but first update its place in the most
-        // recently used list
-        typename list_type::iterator j = i->second.second;
-        if(j != m_list.begin()){
-            // move item to the front of the most recently used list
-            m_list.erase(j);
-            m_list.push_front(key);
+        return lookup(m_map.find(key));
+    }
 
-            // update iterator in map
-            j = m_list.begin();
-            const value_type &value = i->second.first;
-            m_map[key] = std::make_pair(value, j);
+    // looks up the item with a key equal to key according to hash and
+    // eq. both must be consistent with the cache's Hash and Pred.
+    template<class CompatibleKey, class CompatibleHash, class CompatiblePred>
+    boost::optional<value_type> get(const CompatibleKey &key,
+                                    const CompatibleHash &hash,
+                                    const CompatiblePred &eq)
+    {
+        return lookup(m_map.find(key, hash, eq));
+    }
 
-            // return the value
-            return value;
-        }
-        else {
-            // the item is already at the front of the most recently
-            // used list so just return it
-            return i->second.first;
+    void erase(const key_type &key)
+    {
+        typename map_type::iterator i = m_map.find(key);
+        if(i != m_map.end()){
+            m_list.erase(i->second);
+            m_map.erase(i);
         }
     }
 
@@ -118,11 +146,27 @@ public:
     }
 
 private:
+    boost::optional<value_type> lookup(typename map_type::iterator i)
+    {
+        if(i == m_map.end()){
+            // value not in cache
+            return boost::none;
+        }
+
+        // move item to the front of the most recently used list
+        typename list_type::iterator j = i->second;
+        if(j != m_list.begin()){
+            m_list.splice(m_list.begin(), m_list, j);
+        }
+
+        return j->second;
+    }
+
     void evict()
     {
         // evict item from the end of most recently used list
         typename list_type::iterator i = --m_list.end();
-        m_map.erase(*i);
+        m_map.erase(i->first);
         m_list.erase(i);
     }
 
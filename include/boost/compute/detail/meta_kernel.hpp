@@ -12,6 +12,8 @@
 #define BOOST_COMPUTE_DETAIL_META_KERNEL_HPP
 
 #include <set>
+#include <cctype>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <iomanip>
@@ -21,6 +23,7 @@
 #include <boost/tuple/tuple.hpp>
 #include <boost/type_traits.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/assert.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/algorithm/string/find.hpp>
 #include <boost/preprocessor/repetition.hpp>
@@ -29,14 +32,23 @@
 #include <boost/compute/closure.hpp>
 #include <boost/compute/function.hpp>
 #include <boost/compute/functional.hpp>
+#include <boost/compute/functional/math_precision.hpp>
 #include <boost/compute/type_traits.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/image/image2d.hpp>
+#include <boost/compute/image/image3d.hpp>
 #include <boost/compute/image/image_sampler.hpp>
 #include <boost/compute/memory_object.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/detail/constant_memory.hpp>
 #include <boost/compute/detail/device_ptr.hpp>
-#include <boost/compute/detail/sha1.hpp>
+#include <boost/compute/detail/hash128.hpp>
+#include <boost/compute/utility/build_options.hpp>
+#include <boost/compute/utility/extents.hpp>
 #include <boost/compute/utility/program_cache.hpp>
+#include <boost/compute/detail/kernel_cache.hpp>
+#include <boost/compute/detail/program_source_cache.hpp>
+#include <boost/compute/detail/work_size.hpp>
 
 namespace boost {
 namespace compute {
@@ -118,6 +130,38 @@ private:
     T m_value;
 };
 
+// a value which may change between launches of a kernel (e.g. a terminal
+// of a lambda expression). it is inserted as a literal unless
+// BOOST_COMPUTE_VALUES_AS_KERNEL_ARGUMENTS is defined, in which case
+// values of the types allowed for kernel arguments are passed as
+// arguments so that the source of the kernel is the same for all values.
+template<class T>
+class meta_kernel_value
+{
+public:
+    typedef T result_type;
+
+    meta_kernel_value(const T &value)
+        : m_value(value)
+    {
+    }
+
+    const T& value() const
+    {
+        return m_value;
+    }
+
+private:
+    T m_value;
+};
+
+// true if values of type T can be passed as kernel arguments (bool cannot)
+template<class T>
+struct is_value_argument_type : ::boost::compute::is_fundamental<T> {};
+
+template<>
+struct is_value_argument_type<bool> : boost::false_type {};
+
 struct meta_kernel_stored_arg
 {
     meta_kernel_stored_arg()
@@ -203,6 +247,20 @@ struct meta_kernel_buffer_info
     size_t index;
 };
 
+struct meta_kernel_svm_info
+{
+    meta_kernel_svm_info(void *ptr, const std::string &id, size_t i)
+      : m_ptr(ptr),
+        identifier(id),
+        index(i)
+    {
+    }
+
+    void *m_ptr;
+    std::string identifier;
+    size_t index;
+};
+
 class meta_kernel;
 
 template<class Type>
@@ -273,11 +331,15 @@ public:
     };
 
     explicit meta_kernel(const std::string &name)
-        : m_name(name)
+        : m_name(name),
+          m_bind_values(true),
+          m_restrict_buffers(false)
     {
     }
 
     meta_kernel(const meta_kernel &other)
+        : m_bind_values(other.m_bind_values),
+          m_restrict_buffers(other.m_restrict_buffers)
     {
         m_source.str(other.m_source.str());
     }
@@ -322,31 +384,78 @@ public:
         stream << m_external_function_source.str() << "\n";
 
         // add kernel source
-        stream << "__kernel void " << m_name
-               << "(" << boost::join(m_args, ", ") << ")\n"
+        stream << "__kernel " << m_attributes << "void " << m_name
+               << "(" << boost::join(argument_declarations(), ", ") << ")\n"
                << "{\n" << m_source.str() << "\n}\n";
 
         return stream.str();
     }
 
-    kernel compile(const context &context, const std::string &options = std::string())
+    // returns a hash of the program source. the parts of the source are
+    // hashed while they are written so this does not hash the source again.
+    hash128_digest source_hash() const
     {
-        // generate the program source
-        std::string source = this->source();
+        hash128 hash;
 
-        // generate cache key
-        std::string cache_key = "__boost_meta_kernel_" + detail::sha1(source);
+        hash.process_string(m_pragmas);
+        hash.process_bytes("", 1);
+        hash.process_string(m_name);
+        hash.process_bytes("", 1);
+        hash.process_string(m_attributes);
+        hash.process_bytes(&m_restrict_buffers, sizeof(m_restrict_buffers));
+        for(size_t i = 0; i < m_args.size(); i++){
+            hash.process_string(m_args[i]);
+            hash.process_bytes("", 1);
+        }
+
+        const hash128_digest parts[] = {
+            m_type_declaration_source.digest(),
+            m_external_function_source.digest(),
+            m_source.digest()
+        };
+        hash.process_bytes(parts, sizeof(parts));
+
+        return hash.digest();
+    }
+
+    // builds the kernel with options following the current build options
+    // (see build_options)
+    kernel compile(const context &context, const std::string &kernel_options = std::string())
+    {
+        const std::string options = detail::algorithm_build_options(kernel_options);
+        const hash128_digest hash = source_hash();
+
+        // look up recently launched kernels by the hash of their source
+        // first, which avoids generating the source on repeated launches
+        program_source_cache &source_cache =
+            program_source_cache::get_global_cache();
 
-        // load program cache
-        boost::shared_ptr<program_cache> cache =
-            program_cache::get_global_cache(context);
+        ::boost::compute::program program;
+        if(boost::optional< ::boost::compute::program > cached =
+               source_cache.get(context, hash, options)){
+            program = *cached;
 
-        // load (or build) program from cache
-        ::boost::compute::program program =
-            cache->get_or_build(cache_key, options, source, context);
+            BOOST_COMPUTE_DETAIL_TRACE_PROGRAM_CACHE("__boost_meta_kernel_" + m_name, true)
+        }
+        else {
+            // generate the program source
+            std::string source = this->source();
+
+            // generate cache key
+            std::string cache_key = "__boost_meta_kernel_" + hash.str();
+
+            // load program cache
+            boost::shared_ptr<program_cache> cache =
+                program_cache::get_global_cache(context);
 
-        // create kernel
-        ::boost::compute::kernel kernel = program.create_kernel(name());
+            // load (or build) program from cache
+            program = cache->get_or_build(cache_key, options, source, context);
+
+            source_cache.insert(context, hash, options, program);
+        }
+
+        // load (or create) kernel
+        ::boost::compute::kernel kernel = detail::get_cached_kernel(program, name());
 
         // bind stored args
         for(size_t i = 0; i < m_stored_args.size(); i++){
@@ -364,6 +473,13 @@ public:
             kernel.set_arg(bi.index, bi.m_mem);
         }
 
+        // bind svm pointer args
+        for(size_t i = 0; i < m_stored_svm_ptrs.size(); i++){
+            const detail::meta_kernel_svm_info &si = m_stored_svm_ptrs[i];
+
+            kernel.set_arg(si.index, svm_ptr<char>(si.m_ptr));
+        }
+
         return kernel;
     }
 
@@ -397,6 +513,17 @@ public:
         m_stored_args[index] = detail::meta_kernel_stored_arg(value);
     }
 
+    // local memory arguments are stored with their size and no value
+    template<class T>
+    void set_arg(size_t index, const local_buffer<T> &buffer)
+    {
+        if(index >= m_stored_args.size()){
+            m_stored_args.resize(index + 1);
+        }
+
+        m_stored_args[index].set_value(buffer.size() * sizeof(T), 0);
+    }
+
     void set_arg(size_t index, const memory_object &mem)
     {
         set_arg<cl_mem>(index, mem.get());
@@ -427,6 +554,52 @@ public:
         return const_cast<meta_kernel *>(this)->add_extension_pragma(extension, value);
     }
 
+    // declares that the kernel is always launched with work-groups of
+    // x * y * z work-items (with the reqd_work_group_size attribute)
+    void set_reqd_work_group_size(size_t x, size_t y = 1, size_t z = 1)
+    {
+        std::stringstream stream;
+        stream << "__attribute__((reqd_work_group_size("
+               << x << ", " << y << ", " << z << "))) ";
+        m_attributes = stream.str();
+    }
+
+    // declares that the buffers of the kernel do not overlap (distinct
+    // buffer objects share no memory and a buffer used twice is a single
+    // argument), so that their arguments are restrict pointers
+    void set_restrict_buffers(bool restrict_buffers)
+    {
+        m_restrict_buffers = restrict_buffers;
+    }
+
+    // adds the "#pragma OPENCL <pragma>" line to the program (once), e.g.
+    // "FP_CONTRACT OFF"
+    void add_opencl_pragma(const std::string &pragma) const
+    {
+        const std::string line = "#pragma OPENCL " + pragma + "\n";
+
+        std::string &pragmas = const_cast<meta_kernel *>(this)->m_pragmas;
+        if(pragmas.find(line) == std::string::npos){
+            pragmas += line;
+        }
+    }
+
+    // enables extension only if the compiler supports it (that is, if it
+    // defines the macro named after the extension), for kernels which also
+    // work without it
+    void add_optional_extension_pragma(const std::string &extension) const
+    {
+        const std::string pragma =
+            "#ifdef " + extension + "\n" +
+            "#pragma OPENCL EXTENSION " + extension + " : enable\n" +
+            "#endif\n";
+
+        std::string &pragmas = const_cast<meta_kernel *>(this)->m_pragmas;
+        if(pragmas.find(pragma) == std::string::npos){
+            pragmas += pragma;
+        }
+    }
+
     template<class T>
     std::string type() const
     {
@@ -586,6 +759,21 @@ public:
         return *this << uint_(literal.value());
     }
 
+    // define stream operator for values (see meta_kernel_value)
+    template<class T>
+    meta_kernel& operator<<(const meta_kernel_value<T> &value)
+    {
+        #ifdef BOOST_COMPUTE_VALUES_AS_KERNEL_ARGUMENTS
+        if(m_bind_values){
+            return insert_value_argument(
+                value.value(), typename is_value_argument_type<T>::type()
+            );
+        }
+        #endif // BOOST_COMPUTE_VALUES_AS_KERNEL_ARGUMENTS
+
+        return *this << lit(value.value());
+    }
+
     // define stream operators for strings
     meta_kernel& operator<<(char ch)
     {
@@ -617,6 +805,12 @@ public:
         return detail::meta_kernel_literal<T>(value);
     }
 
+    template<class T>
+    static detail::meta_kernel_value<T> make_value(const T &value)
+    {
+        return detail::meta_kernel_value<T>(value);
+    }
+
     template<class T>
     static detail::meta_kernel_variable<T> make_expr(const std::string &expr)
     {
@@ -661,6 +855,62 @@ public:
                );
     }
 
+    // compiles the kernel and returns the largest power of two work-group
+    // size not above max_size it can be launched with on the device of
+    // queue (see kernel_work_group_size())
+    size_t work_group_size(command_queue &queue, size_t max_size)
+    {
+        const ::boost::compute::kernel kernel = compile(queue.get_context());
+
+        return kernel_work_group_size(kernel, queue.get_device(), max_size);
+    }
+
+    // compiles the kernel and returns the resources it uses on the device
+    // of queue. the local memory includes the local memory arguments
+    // which are already set.
+    kernel_resource_usage resource_usage(command_queue &queue)
+    {
+        const ::boost::compute::kernel kernel = compile(queue.get_context());
+
+        return kernel.get_resource_usage(queue.get_device());
+    }
+
+    // compiles and runs the kernel over a two-dimensional range of
+    // global_work_size work-items in work-groups of local_work_size (or
+    // of a size chosen by the implementation if its extents are zero).
+    event exec_2d(command_queue &queue,
+                  const extents<2> &global_work_size,
+                  const extents<2> &local_work_size = extents<2>())
+    {
+        return exec_nd(queue, global_work_size, local_work_size);
+    }
+
+    // compiles and runs the kernel over a three-dimensional range (see
+    // exec_2d()).
+    event exec_3d(command_queue &queue,
+                  const extents<3> &global_work_size,
+                  const extents<3> &local_work_size = extents<3>())
+    {
+        return exec_nd(queue, global_work_size, local_work_size);
+    }
+
+    template<size_t N>
+    event exec_nd(command_queue &queue,
+                  const extents<N> &global_work_size,
+                  const extents<N> &local_work_size)
+    {
+        const context &context = queue.get_context();
+
+        ::boost::compute::kernel kernel = compile(context);
+
+        return queue.enqueue_nd_range_kernel_async(
+                   kernel,
+                   extents<N>(),
+                   global_work_size,
+                   local_work_size
+               );
+    }
+
     template<class T>
     std::string get_buffer_identifier(const buffer &buffer,
                                       const memory_object::address_space address_space =
@@ -688,26 +938,157 @@ public:
         return identifier;
     }
 
-    std::string get_image_identifier(const char *qualifiers, const image2d &image)
+    // returns the identifier of a buffer which the kernel only reads by
+    // subscript (e.g. a lookup table). the buffer is passed in __constant
+    // memory if it fits in the constant memory of the devices of its
+    // context together with the other __constant buffers of the kernel,
+    // and in __global memory otherwise.
+    template<class T>
+    std::string get_table_identifier(const buffer &buffer)
+    {
+        size_t constant_size = 0;
+        size_t constant_args = 0;
+        for(size_t i = 0; i < m_stored_buffers.size(); i++){
+            const detail::meta_kernel_buffer_info &bi = m_stored_buffers[i];
+            if(bi.address_space != memory_object::constant_memory){
+                continue;
+            }
+            else if(bi.m_mem == buffer.get()){
+                return bi.identifier;
+            }
+
+            constant_size += ::boost::compute::buffer(bi.m_mem).size();
+            constant_args++;
+        }
+
+        const constant_memory_limits limits(buffer.get_context());
+        if(constant_args < limits.args &&
+           constant_size + buffer.size() <= limits.size){
+            return get_buffer_identifier<T>(buffer, memory_object::constant_memory);
+        }
+
+        return get_buffer_identifier<T>(buffer);
+    }
+
+    // returns the index of the kernel argument of the buffer mem in
+    // global memory
+    size_t get_buffer_argument_index(const cl_mem mem) const
+    {
+        for(size_t i = 0; i < m_stored_buffers.size(); i++){
+            const detail::meta_kernel_buffer_info &bi = m_stored_buffers[i];
+
+            if(bi.m_mem == mem &&
+               bi.address_space == memory_object::global_memory){
+                return bi.index;
+            }
+        }
+
+        BOOST_ASSERT_MSG(false, "buffer is not an argument of the kernel");
+        return 0;
+    }
+
+    // returns the identifier of the kernel argument for the shared virtual
+    // memory pointed to by ptr
+    template<class T>
+    std::string get_svm_identifier(void *ptr)
+    {
+        // check if we've already seen the pointer
+        for(size_t i = 0; i < m_stored_svm_ptrs.size(); i++){
+            const detail::meta_kernel_svm_info &si = m_stored_svm_ptrs[i];
+
+            if(si.m_ptr == ptr){
+                return si.identifier;
+            }
+        }
+
+        // create a new binding
+        std::string identifier =
+            "_svm" + lexical_cast<std::string>(m_stored_svm_ptrs.size());
+        size_t index = add_arg<T *>(memory_object::global_memory, identifier);
+
+        m_stored_svm_ptrs.push_back(
+            detail::meta_kernel_svm_info(ptr, identifier, index));
+
+        return identifier;
+    }
+
+    // returns an expression loading the vector with the given index of
+    // width values of type T from buffer starting at offset (in values)
+    template<class T>
+    std::string vload(uint_ width,
+                      const std::string &index,
+                      const buffer &buffer,
+                      size_t offset = 0)
+    {
+        std::stringstream stream;
+        stream << "vload" << width << "(" << index << ", "
+               << "(" << get_buffer_identifier<T>(buffer) << " + " << offset << "))";
+        return stream.str();
+    }
+
+    // returns a statement storing value to the vector with the given index
+    // of width values of type T in buffer starting at offset (in values)
+    template<class T>
+    std::string vstore(uint_ width,
+                       const std::string &value,
+                       const std::string &index,
+                       const buffer &buffer,
+                       size_t offset = 0)
+    {
+        std::stringstream stream;
+        stream << "vstore" << width << "(" << value << ", " << index << ", "
+               << "(" << get_buffer_identifier<T>(buffer) << " + " << offset << "))";
+        return stream.str();
+    }
+
+    std::string get_image_identifier(const char *qualifiers,
+                                     const image2d &image,
+                                     const std::string &name = "image")
     {
-        size_t index = add_arg_with_qualifiers<image2d>(qualifiers, "image");
+        size_t index = add_arg_with_qualifiers<image2d>(qualifiers, name);
 
         set_arg(index, image);
 
-        return "image";
+        return name;
     }
 
+    std::string get_image_identifier(const char *qualifiers,
+                                     const image3d &image,
+                                     const std::string &name = "image")
+    {
+        size_t index = add_arg_with_qualifiers<image3d>(qualifiers, name);
+
+        set_arg(index, image);
+
+        return name;
+    }
+
+    // declares a program-scope sampler constant with the given properties
+    // and returns its name
     std::string get_sampler_identifier(bool normalized_coords,
                                        cl_addressing_mode addressing_mode,
                                        cl_filter_mode filter_mode)
     {
-        (void) normalized_coords;
-        (void) addressing_mode;
-        (void) filter_mode;
+        std::stringstream stream;
+        stream << "const sampler_t sampler = "
+               << (normalized_coords ? "CLK_NORMALIZED_COORDS_TRUE"
+                                     : "CLK_NORMALIZED_COORDS_FALSE")
+               << " |\n                          ";
+        switch(addressing_mode){
+        case CL_ADDRESS_CLAMP_TO_EDGE: stream << "CLK_ADDRESS_CLAMP_TO_EDGE"; break;
+        case CL_ADDRESS_CLAMP: stream << "CLK_ADDRESS_CLAMP"; break;
+        case CL_ADDRESS_REPEAT: stream << "CLK_ADDRESS_REPEAT"; break;
+        #ifdef CL_ADDRESS_MIRRORED_REPEAT
+        case CL_ADDRESS_MIRRORED_REPEAT: stream << "CLK_ADDRESS_MIRRORED_REPEAT"; break;
+        #endif
+        default: stream << "CLK_ADDRESS_NONE"; break;
+        }
+        stream << " |\n                          "
+               << (filter_mode == CL_FILTER_LINEAR ? "CLK_FILTER_LINEAR"
+                                                   : "CLK_FILTER_NEAREST")
+               << ";\n";
 
-        m_pragmas += "const sampler_t sampler = CLK_NORMALIZED_COORDS_FALSE |\n"
-                     "                          CLK_ADDRESS_NONE |\n"
-                     "                          CLK_FILTER_NEAREST;\n";
+        m_pragmas += stream.str();
 
         return "sampler";
     }
@@ -715,7 +1096,10 @@ public:
     template<class Expr>
     static std::string expr_to_string(const Expr &expr)
     {
+        // the arguments of the temporary kernel are lost so values are
+        // always inserted as literals
         meta_kernel tmp((std::string()));
+        tmp.m_bind_values = false;
         tmp << expr;
         return tmp.m_source.str();
     }
@@ -845,6 +1229,17 @@ public:
     #undef BOOST_COMPUTE_META_KERNEL_STREAM_FUNCTION_ARG
     #undef BOOST_COMPUTE_META_KERNEL_INSERT_FUNCTION_ARGS
 
+    // inserts a captured value of a closure (see is_capture_kernel_argument)
+    template<class T>
+    meta_kernel& insert_capture(const T &value)
+    {
+        inject_type<T>();
+
+        return insert_capture(
+            value, typename is_capture_kernel_argument<T>::type()
+        );
+    }
+
     static const char* address_space_prefix(const memory_object::address_space value)
     {
         switch(value){
@@ -858,6 +1253,121 @@ public:
     }
 
 private:
+    // returns the declarations of the kernel arguments. buffers in global
+    // memory which the kernel only reads are declared const, and restrict
+    // if set_restrict_buffers() was called.
+    std::vector<std::string> argument_declarations() const
+    {
+        std::vector<std::string> args = m_args;
+
+        const std::string source =
+            m_external_function_source.str() + m_source.str();
+
+        for(size_t i = 0; i < m_stored_buffers.size(); i++){
+            const detail::meta_kernel_buffer_info &bi = m_stored_buffers[i];
+            if(bi.address_space != memory_object::global_memory){
+                continue;
+            }
+
+            // "__global T* name"
+            std::string &arg = args[bi.index];
+            if(m_restrict_buffers){
+                arg.insert(arg.rfind(' '), " restrict");
+            }
+            if(is_read_only(source, bi.identifier)){
+                arg.insert(arg.find(' ') + 1, "const ");
+            }
+        }
+
+        return args;
+    }
+
+    static bool is_identifier_char(char c)
+    {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    }
+
+    static size_t skip_spaces(const std::string &source, size_t i)
+    {
+        while(i < source.size() && std::isspace(static_cast<unsigned char>(source[i]))){
+            i++;
+        }
+
+        return i;
+    }
+
+    // returns true if the buffer named identifier is only read in source.
+    // this is conservative: each use must be an element (identifier[...])
+    // which is neither assigned, incremented, accessed by member nor has
+    // its address taken.
+    static bool is_read_only(const std::string &source, const std::string &identifier)
+    {
+        for(size_t i = source.find(identifier);
+            i != std::string::npos;
+            i = source.find(identifier, i + 1)){
+            size_t end = i + identifier.size();
+
+            // skip longer identifiers (e.g. _buf10 for _buf1)
+            if((i > 0 && is_identifier_char(source[i - 1])) ||
+               (end < source.size() && is_identifier_char(source[end]))){
+                continue;
+            }
+
+            // the preceding operator must not take the address of or
+            // increment the element
+            size_t before = i;
+            while(before > 0 && std::isspace(static_cast<unsigned char>(source[before - 1]))){
+                before--;
+            }
+            if(before > 0 && source[before - 1] == '&' &&
+               (before < 2 || source[before - 2] != '&')){
+                return false;
+            }
+            if(before > 1 &&
+               (source.compare(before - 2, 2, "++") == 0 ||
+                source.compare(before - 2, 2, "--") == 0)){
+                return false;
+            }
+
+            // find the end of the subscript
+            end = skip_spaces(source, end);
+            if(end == source.size() || source[end] != '['){
+                return false;
+            }
+            size_t depth = 0;
+            for(; end < source.size(); end++){
+                if(source[end] == '['){
+                    depth++;
+                }
+                else if(source[end] == ']' && --depth == 0){
+                    break;
+                }
+            }
+            if(end == source.size()){
+                return false;
+            }
+
+            // the following operator must not write the element
+            end = skip_spaces(source, end + 1);
+            if(end < source.size()){
+                const char c = source[end];
+                const char next = end + 1 < source.size() ? source[end + 1] : '\0';
+                const char third = end + 2 < source.size() ? source[end + 2] : '\0';
+
+                if(c == '.' || c == '[' ||
+                   (c == '=' && next != '=') ||
+                   (c == '+' && (next == '+' || next == '=')) ||
+                   (c == '-' && (next == '-' || next == '=' || next == '>')) ||
+                   (std::strchr("*/%&|^", c) && next == '=') ||
+                   ((c == '<' || c == '>') && next == c && third == '=')){
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
     template<class T>
     size_t add_arg_with_qualifiers(const char *qualifiers, const std::string &name)
     {
@@ -871,16 +1381,71 @@ private:
         return index;
     }
 
+private:
+    template<class T>
+    meta_kernel& insert_capture(const T &value, boost::true_type)
+    {
+        if(!m_bind_values){
+            return *this << value;
+        }
+
+        const std::string name =
+            "_capture" + boost::lexical_cast<std::string>(m_args.size());
+        add_set_arg<const T>(name, value);
+
+        return *this << name;
+    }
+
+    // bool is not a valid kernel argument type
+    meta_kernel& insert_capture(const bool &value, boost::true_type)
+    {
+        if(!m_bind_values){
+            return *this << lit(value);
+        }
+
+        const std::string name =
+            "_capture" + boost::lexical_cast<std::string>(m_args.size());
+        add_set_arg<const uint_>(name, value ? 1 : 0);
+
+        return *this << name;
+    }
+
+    template<class T>
+    meta_kernel& insert_capture(const T &value, boost::false_type)
+    {
+        return *this << value;
+    }
+
+    template<class T>
+    meta_kernel& insert_value_argument(const T &value, boost::true_type)
+    {
+        const std::string name =
+            "_value" + boost::lexical_cast<std::string>(m_args.size());
+        add_set_arg<const T>(name, value);
+
+        return *this << name;
+    }
+
+    template<class T>
+    meta_kernel& insert_value_argument(const T &value, boost::false_type)
+    {
+        return *this << lit(value);
+    }
+
 private:
     std::string m_name;
-    std::stringstream m_source;
-    std::stringstream m_external_function_source;
-    std::stringstream m_type_declaration_source;
+    bool m_bind_values;
+    hashing_stringstream m_source;
+    hashing_stringstream m_external_function_source;
+    hashing_stringstream m_type_declaration_source;
     std::set<std::string> m_external_function_names;
     std::vector<std::string> m_args;
     std::string m_pragmas;
+    std::string m_attributes;
+    bool m_restrict_buffers;
     std::vector<detail::meta_kernel_stored_arg> m_stored_args;
     std::vector<detail::meta_kernel_buffer_info> m_stored_buffers;
+    std::vector<detail::meta_kernel_svm_info> m_stored_svm_ptrs;
 };
 
 template<class ResultType, class ArgTuple>
@@ -889,13 +1454,44 @@ operator<<(meta_kernel &kernel, const invoked_function<ResultType, ArgTuple> &ex
 {
     if(!expr.source().empty()){
         kernel.add_function(expr.name(), expr.source(), expr.definitions());
+        kernel.insert_function_call(expr.name(), expr.args());
+    }
+    else {
+        // built-in functions are called with the variant for the active
+        // math precision (see scoped_math_precision)
+        kernel.insert_function_call(
+            math_function_name(
+                expr.name(), is_reduced_precision_math_type<ResultType>::value
+            ),
+            expr.args()
+        );
     }
-
-    kernel.insert_function_call(expr.name(), expr.args());
 
     return kernel;
 }
 
+// inserts the captured values of a closure call separated by commas
+struct closure_capture_inserter
+{
+    closure_capture_inserter(meta_kernel &kernel_)
+        : kernel(kernel_),
+          n(0)
+    {
+    }
+
+    template<class T>
+    void operator()(const T &value) const
+    {
+        if(n++ != 0){
+            kernel << ", ";
+        }
+        kernel.insert_capture(value);
+    }
+
+    meta_kernel &kernel;
+    mutable size_t n;
+};
+
 template<class ResultType, class ArgTuple, class CaptureTuple>
 inline meta_kernel&
 operator<<(meta_kernel &kernel,
@@ -908,7 +1504,7 @@ operator<<(meta_kernel &kernel,
     kernel << expr.name() << '(';
     kernel.insert_function_call_args(expr.args());
     kernel << ", ";
-    kernel.insert_function_call_args(expr.capture());
+    fusion::for_each(expr.capture(), closure_capture_inserter(kernel));
     kernel << ')';
 
     return kernel;
@@ -941,6 +1537,15 @@ inline meta_kernel& operator<<(meta_kernel &kernel,
     }
 }
 
+template<class T, class IndexExpr>
+inline meta_kernel& operator<<(meta_kernel &kernel,
+                               const detail::svm_ptr_index_expr<T, IndexExpr> &expr)
+{
+    return kernel <<
+               kernel.get_svm_identifier<T>(expr.m_ptr) <<
+               '[' << expr.m_expr << ']';
+}
+
 template<class T1, class T2, class IndexExpr>
 inline meta_kernel& operator<<(meta_kernel &kernel,
                                const detail::device_ptr_index_expr<std::pair<T1, T2>, IndexExpr> &expr)
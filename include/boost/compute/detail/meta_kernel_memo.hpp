@@ -0,0 +1,299 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_META_KERNEL_MEMO_HPP
+#define BOOST_COMPUTE_DETAIL_META_KERNEL_MEMO_HPP
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/optional.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/program.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/functional/as.hpp>
+#include <boost/compute/functional/convert.hpp>
+#include <boost/compute/functional/identity.hpp>
+#include <boost/compute/functional/math_precision.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/transform_iterator.hpp>
+#include <boost/compute/utility/build_options.hpp>
+#include <boost/compute/detail/hash128.hpp>
+#include <boost/compute/detail/lru_cache.hpp>
+#include <boost/compute/detail/global_static.hpp>
+#include <boost/compute/detail/kernel_cache.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/program_source_cache.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// the key of a memoized kernel (see meta_kernel_memo). the values an
+// algorithm generates its kernel from are appended to the key, which stays
+// valid if the source they generate only depends on their type and on what
+// they appended. otherwise the kernel is generated each time (e.g. for
+// lambda expressions, which print their constants in the source, and for
+// closures). the buffers which are arguments of the kernel are collected
+// to be set again when the memoized kernel is used.
+class meta_kernel_memo_key
+{
+public:
+    // tag is the address of a static object of the algorithm, i.e. an
+    // identifier of its template instantiation
+    explicit meta_kernel_memo_key(const void *tag)
+        : m_valid(true)
+    {
+        append_bytes(&tag, sizeof(tag));
+    }
+
+    template<class T>
+    void append(const T &value);
+
+    void append_bytes(const void *data, size_t size)
+    {
+        m_hash.process_bytes(data, size);
+    }
+
+    void append_string(const std::string &string)
+    {
+        m_hash.process_string(string);
+        m_hash.process_bytes("", 1);
+    }
+
+    // appends a buffer argument of the kernel. the buffer itself is not
+    // part of the source but whether it is the same as a previous buffer
+    // (in which case both share a kernel argument) is.
+    void append_buffer(const buffer &buffer)
+    {
+        const size_t n = std::find(m_buffers.begin(), m_buffers.end(), buffer.get()) -
+                         m_buffers.begin();
+        append_bytes(&n, sizeof(n));
+
+        m_buffers.push_back(buffer.get());
+    }
+
+    void invalidate()
+    {
+        m_valid = false;
+    }
+
+    bool valid() const
+    {
+        return m_valid;
+    }
+
+    hash128_digest digest() const
+    {
+        return m_hash.digest();
+    }
+
+    const std::vector<cl_mem>& buffers() const
+    {
+        return m_buffers;
+    }
+
+private:
+    bool m_valid;
+    hash128 m_hash;
+    std::vector<cl_mem> m_buffers;
+};
+
+// appends value to key. the overloads take a pointer to the value so that
+// the ones for base classes (e.g. function<Signature> for the built-in
+// functions) are preferred over the default one.
+inline void append_meta_kernel_memo_key(meta_kernel_memo_key &key, const void *value)
+{
+    (void) value;
+
+    key.invalidate();
+}
+
+template<class T>
+inline void meta_kernel_memo_key::append(const T &value)
+{
+    append_meta_kernel_memo_key(*this, &value);
+}
+
+// the offset of buffer iterators is a literal of the source
+template<class T>
+inline void append_meta_kernel_memo_key(meta_kernel_memo_key &key,
+                                        const buffer_iterator<T> *value)
+{
+    const size_t index = value->get_index();
+
+    key.append_buffer(value->get_buffer());
+    key.append_bytes(&index, sizeof(index));
+}
+
+template<class InputIterator, class UnaryFunction>
+inline void append_meta_kernel_memo_key(meta_kernel_memo_key &key,
+                                        const transform_iterator<InputIterator, UnaryFunction> *value)
+{
+    key.append(value->base());
+    key.append(value->functor());
+}
+
+// functions are given by their name, source and definitions and the
+// built-in functions also by the active math precision
+template<class Signature>
+inline void append_meta_kernel_memo_key(meta_kernel_memo_key &key,
+                                        const function<Signature> *value)
+{
+    typedef std::map<std::string, std::string>::const_iterator iterator;
+
+    key.append_string(value->name());
+    key.append_string(value->source());
+    if(value->source().empty()){
+        const int precision = static_cast<int>(active_math_precision());
+        key.append_bytes(&precision, sizeof(precision));
+    }
+
+    const std::map<std::string, std::string> &definitions = value->definitions();
+    for(iterator i = definitions.begin(); i != definitions.end(); ++i){
+        key.append_string(i->first);
+        key.append_string(i->second);
+    }
+}
+
+template<class T>
+inline void append_meta_kernel_memo_key(meta_kernel_memo_key&, const identity<T>*)
+{
+}
+
+template<class T>
+inline void append_meta_kernel_memo_key(meta_kernel_memo_key&, const as<T>*)
+{
+}
+
+template<class T>
+inline void append_meta_kernel_memo_key(meta_kernel_memo_key&, const convert<T>*)
+{
+}
+
+// memoizes the kernels generated by algorithms by a key which determines
+// their source, so that an algorithm called again with the same iterator
+// and function types (and the same offsets and functions) skips generating
+// the source of its kernel. the source hash stored for a key is looked up
+// in the program_source_cache, the memo itself holds no program.
+//
+// the global memo returned by get_global_cache() is thread-local when
+// BOOST_COMPUTE_THREAD_SAFE is defined.
+class meta_kernel_memo : boost::noncopyable
+{
+public:
+    meta_kernel_memo(size_t capacity)
+        : m_cache(capacity)
+    {
+    }
+
+    size_t size() const
+    {
+        return m_cache.size();
+    }
+
+    void clear()
+    {
+        m_cache.clear();
+    }
+
+    // returns the kernel memoized for key with its buffer arguments set
+    // to the buffers of key, or none if the kernel has to be generated
+    // (because it was not memoized or its program was evicted from the
+    // program_source_cache).
+    boost::optional<kernel> get(const meta_kernel_memo_key &key,
+                                const context &context)
+    {
+        BOOST_ASSERT(key.valid());
+
+        boost::optional<entry> memoized = m_cache.get(key.digest());
+        if(!memoized){
+            return boost::none;
+        }
+
+        boost::optional<program> program =
+            program_source_cache::get_global_cache().get(
+                context,
+                memoized->source_hash,
+                algorithm_build_options(std::string())
+            );
+        if(!program){
+            return boost::none;
+        }
+
+        kernel kernel = get_cached_kernel(*program, memoized->name);
+
+        const std::vector<cl_mem> &buffers = key.buffers();
+        for(size_t i = 0; i < buffers.size(); i++){
+            kernel.set_arg(memoized->buffer_args[i], buffers[i]);
+        }
+
+        return kernel;
+    }
+
+    // memoizes the kernel generated in k (which must have been compiled
+    // without options other than the current build options) for key. the other arguments than the buffers of
+    // key are set by the algorithm.
+    void insert(const meta_kernel_memo_key &key, const meta_kernel &k)
+    {
+        BOOST_ASSERT(key.valid());
+
+        const std::vector<cl_mem> &buffers = key.buffers();
+
+        entry memoized;
+        memoized.source_hash = k.source_hash();
+        memoized.name = k.name();
+        for(size_t i = 0; i < buffers.size(); i++){
+            memoized.buffer_args.push_back(k.get_buffer_argument_index(buffers[i]));
+        }
+
+        m_cache.insert(key.digest(), memoized);
+    }
+
+    // returns the global meta kernel memo (for the current thread)
+    static meta_kernel_memo& get_global_cache()
+    {
+        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(meta_kernel_memo, cache, (64));
+
+        return cache;
+    }
+
+private:
+    struct entry
+    {
+        hash128_digest source_hash;
+        std::string name;
+        std::vector<size_t> buffer_args;
+    };
+
+    struct key_hash
+    {
+        size_t operator()(const hash128_digest &digest) const
+        {
+            return static_cast<size_t>(digest.low);
+        }
+    };
+
+    lru_cache<hash128_digest, entry, key_hash> m_cache;
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_META_KERNEL_MEMO_HPP
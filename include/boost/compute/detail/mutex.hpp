@@ -0,0 +1,73 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_MUTEX_HPP
+#define BOOST_COMPUTE_DETAIL_MUTEX_HPP
+
+#include <boost/compute/config.hpp>
+
+#ifdef BOOST_COMPUTE_THREAD_SAFE
+#  if !defined(BOOST_NO_CXX11_HDR_MUTEX) && \
+      !defined(BOOST_NO_CXX11_HDR_CONDITION_VARIABLE)
+     // use c++11 mutexes
+#    include <mutex>
+#    include <thread>
+#    include <condition_variable>
+#    define BOOST_COMPUTE_DETAIL_MUTEX_NAMESPACE std
+#  else
+     // use mutexes from boost.thread
+#    include <boost/thread/mutex.hpp>
+#    include <boost/thread/locks.hpp>
+#    include <boost/thread/thread.hpp>
+#    include <boost/thread/condition_variable.hpp>
+#    define BOOST_COMPUTE_DETAIL_MUTEX_NAMESPACE boost
+#  endif
+#endif
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+#ifdef BOOST_COMPUTE_THREAD_SAFE
+typedef BOOST_COMPUTE_DETAIL_MUTEX_NAMESPACE::mutex mutex;
+typedef BOOST_COMPUTE_DETAIL_MUTEX_NAMESPACE::unique_lock<mutex> scoped_lock;
+typedef BOOST_COMPUTE_DETAIL_MUTEX_NAMESPACE::condition_variable condition_variable;
+typedef BOOST_COMPUTE_DETAIL_MUTEX_NAMESPACE::thread thread;
+#else
+// no thread-safety, locking is a no-op
+class mutex
+{
+public:
+    void lock() { }
+    void unlock() { }
+};
+
+class scoped_lock
+{
+public:
+    explicit scoped_lock(mutex &) { }
+    void lock() { }
+    void unlock() { }
+};
+
+class condition_variable
+{
+public:
+    void wait(scoped_lock &) { }
+    void notify_one() { }
+    void notify_all() { }
+};
+#endif // BOOST_COMPUTE_THREAD_SAFE
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_MUTEX_HPP
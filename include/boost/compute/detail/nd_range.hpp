@@ -0,0 +1,165 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_ND_RANGE_HPP
+#define BOOST_COMPUTE_DETAIL_ND_RANGE_HPP
+
+#include <string>
+#include <sstream>
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/utility/extents.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/index_type.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns the work-group size for an nd-range of global_work_size on
+// device. GPUs use square (or cubic) tiles, CPUs rows of work-items along
+// the first dimension which their compilers vectorize.
+//
+// the sizes can be tuned with the "local_0", "local_1" and "local_2"
+// parameters of "__boost_nd_range_2d" (or "__boost_nd_range_3d") in the
+// parameter cache. they are halved until the work-group fits on the
+// device and while they are at least twice the global size.
+template<size_t N>
+inline extents<N> calculate_local_work_size(const device &device,
+                                            const extents<N> &global_work_size)
+{
+    BOOST_STATIC_ASSERT(N > 0 && N <= 3);
+
+    const boost::shared_ptr<device_profile> profile = device_profile::get(device);
+    const bool gpu = profile->has_local_memory();
+
+    static const size_t gpu_defaults[3][3] = {
+        { 256, 1, 1 }, { 32, 8, 1 }, { 8, 8, 4 }
+    };
+    static const size_t cpu_defaults[3][3] = {
+        { 64, 1, 1 }, { 64, 1, 1 }, { 64, 1, 1 }
+    };
+
+    std::stringstream object;
+    object << "__boost_nd_range_" << N << "d";
+
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(device);
+
+    extents<N> local;
+    for(size_t i = 0; i < N; i++){
+        std::stringstream parameter;
+        parameter << "local_" << i;
+
+        const size_t default_value =
+            gpu ? gpu_defaults[N - 1][i] : cpu_defaults[N - 1][i];
+
+        local[i] = (std::max)(
+            size_t(parameters->get(object.str(), parameter.str(), uint_(default_value))),
+            size_t(1)
+        );
+
+        while(local[i] > 1 && local[i] / 2 >= global_work_size[i]){
+            local[i] /= 2;
+        }
+    }
+
+    while(local.linear() > profile->max_work_group_size()){
+        size_t largest = 0;
+        for(size_t i = 1; i < N; i++){
+            if(local[i] > local[largest]){
+                largest = i;
+            }
+        }
+        local[largest] = (std::max)(local[largest] / 2, size_t(1));
+    }
+
+    return local;
+}
+
+// returns global_work_size rounded up to a multiple of local_work_size in
+// each dimension
+template<size_t N>
+inline extents<N> round_up_work_size(const extents<N> &global_work_size,
+                                     const extents<N> &local_work_size)
+{
+    extents<N> global;
+    for(size_t i = 0; i < N; i++){
+        const size_t local = local_work_size[i];
+        global[i] = (global_work_size[i] + local - 1) / local * local;
+    }
+
+    return global;
+}
+
+// emits the coordinates of the work-item in an nd-range over size (in the
+// uint variables "x0", "x1" and "x2"), a check skipping the work-items
+// past size in the rounded-up range and the row-major position of the
+// work-item (in the variable "index"). the code emitted after it must be
+// closed with nd_range_index_end().
+template<size_t N>
+inline void nd_range_index_begin(meta_kernel &k, const extents<N> &size)
+{
+    const char *index_type = index_type_name(size.linear());
+
+    for(size_t i = 0; i < N; i++){
+        std::stringstream name;
+        name << "size_" << i;
+
+        k.add_set_arg<const uint_>(name.str(), static_cast<uint_>(size[i]));
+        k << "const uint x" << i << " = get_global_id(" << i << ");\n";
+    }
+
+    k << "if(x0 < size_0";
+    for(size_t i = 1; i < N; i++){
+        k << " && x" << i << " < size_" << i;
+    }
+    k << "){\n";
+
+    // x0 + size_0 * (x1 + size_1 * x2)
+    std::stringstream index;
+    index << "x" << (N - 1);
+    for(size_t i = N - 1; i > 0; i--){
+        std::stringstream outer;
+        outer << "x" << (i - 1) << " + (" << index_type << ") size_" << (i - 1)
+              << " * (" << index.str() << ")";
+        index.str(outer.str());
+    }
+    k << "const " << index_type << " index = " << index.str() << ";\n";
+}
+
+inline void nd_range_index_end(meta_kernel &k)
+{
+    k << "}\n";
+}
+
+// runs k over size with the work-group size for the device of queue
+template<size_t N>
+inline event exec_nd_range(meta_kernel &k,
+                           const extents<N> &size,
+                           command_queue &queue)
+{
+    const extents<N> local = calculate_local_work_size(queue.get_device(), size);
+
+    return k.exec_nd(queue, round_up_work_size(size, local), local);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_ND_RANGE_HPP
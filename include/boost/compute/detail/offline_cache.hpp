@@ -0,0 +1,373 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_OFFLINE_CACHE_HPP
+#define BOOST_COMPUTE_DETAIL_OFFLINE_CACHE_HPP
+
+#include <ctime>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <algorithm>
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <boost/compute/detail/mutex.hpp>
+#include <boost/compute/detail/getenv.hpp>
+
+// version of the on-disk layout, caches with a different
+// version are stored in separate directories and ignored
+#define BOOST_COMPUTE_DETAIL_OFFLINE_CACHE_VERSION 2
+
+// default size limit for the offline cache (in bytes)
+#ifndef BOOST_COMPUTE_OFFLINE_CACHE_SIZE
+#  define BOOST_COMPUTE_OFFLINE_CACHE_SIZE (256 * 1024 * 1024)
+#endif
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// stores program binaries on disk, indexed by a hash string.
+//
+// the cache is located in $HOME/.boost_compute on UNIX-like systems and
+// in %APPDATA%/boost_compute on Windows. this can be changed by setting
+// the BOOST_COMPUTE_OFFLINE_CACHE_DIR environment variable. the size
+// limit defaults to BOOST_COMPUTE_OFFLINE_CACHE_SIZE bytes and can be
+// changed with the BOOST_COMPUTE_OFFLINE_CACHE_SIZE environment variable.
+//
+// binaries are written to a temporary file which is then renamed into
+// place, so concurrent readers and writers (including other processes)
+// never observe partially written binaries.
+//
+// each binary is listed in an append-only index file. looking up a hash
+// which is not in the index does not touch the file system (other than
+// reading entries appended to the index since it was last read). when
+// the total size exceeds the limit, the least recently used binaries are
+// removed and the index is rewritten.
+class offline_cache : boost::noncopyable
+{
+public:
+    offline_cache(const std::string &path, boost::uintmax_t max_size)
+        : m_path(path),
+          m_max_size(max_size),
+          m_total_size(0),
+          m_index_offset(0)
+    {
+    }
+
+    // returns the directory containing the cache
+    const std::string& path() const
+    {
+        return m_path;
+    }
+
+    // returns the maximum size of the binaries stored in the cache
+    boost::uintmax_t max_size() const
+    {
+        return m_max_size;
+    }
+
+    // loads the binary stored with hash. returns false if not found.
+    bool load(const std::string &hash, std::vector<unsigned char> &binary)
+    {
+        scoped_lock lock(m_mutex);
+
+        if(!m_index.count(hash)){
+            refresh_index();
+
+            if(!m_index.count(hash)){
+                return false;
+            }
+        }
+
+        const boost::filesystem::path file = binary_path(hash);
+
+        std::ifstream stream(file.string().c_str(), std::ios::in | std::ios::binary);
+        if(!stream){
+            // removed by another process
+            m_total_size -= m_index[hash];
+            m_index.erase(hash);
+            return false;
+        }
+
+        binary.assign(
+            (std::istreambuf_iterator<char>(stream)),
+            std::istreambuf_iterator<char>()
+        );
+
+        // mark as recently used
+        boost::system::error_code ec;
+        boost::filesystem::last_write_time(file, std::time(0), ec);
+
+        return !binary.empty();
+    }
+
+    // stores binary with hash
+    void store(const std::string &hash, const std::vector<unsigned char> &binary)
+    {
+        scoped_lock lock(m_mutex);
+
+        if(binary.empty() || binary.size() > m_max_size){
+            return;
+        }
+
+        const boost::filesystem::path file = binary_path(hash);
+
+        boost::system::error_code ec;
+        boost::filesystem::create_directories(file.parent_path(), ec);
+        if(ec){
+            return;
+        }
+
+        // write to a uniquely named file and then atomically move it
+        // into place so that readers never see incomplete binaries
+        const boost::filesystem::path temp =
+            file.parent_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%.tmp");
+        {
+            std::ofstream stream(temp.string().c_str(), std::ios::out | std::ios::binary);
+            if(!stream){
+                return;
+            }
+
+            stream.write(reinterpret_cast<const char *>(&binary[0]),
+                        static_cast<std::streamsize>(binary.size()));
+            if(!stream){
+                stream.close();
+                boost::filesystem::remove(temp, ec);
+                return;
+            }
+        }
+
+        boost::filesystem::rename(temp, file, ec);
+        if(ec){
+            // the binary could not be moved into place (e.g. on windows
+            // if another process has already stored the same binary)
+            boost::filesystem::remove(temp, ec);
+            return;
+        }
+
+        // append entry to the index
+        {
+            std::ofstream index(index_path().string().c_str(),
+                                std::ios::out | std::ios::app | std::ios::binary);
+            index << hash << " " << binary.size() << "\n";
+        }
+
+        if(!m_index.count(hash)){
+            m_index[hash] = binary.size();
+            m_total_size += binary.size();
+        }
+
+        if(m_total_size > m_max_size){
+            evict();
+        }
+    }
+
+    // removes all binaries from the cache
+    void clear()
+    {
+        scoped_lock lock(m_mutex);
+
+        boost::system::error_code ec;
+        boost::filesystem::remove_all(version_path(), ec);
+
+        m_index.clear();
+        m_total_size = 0;
+        m_index_offset = 0;
+    }
+
+    // returns the global offline cache
+    static offline_cache& get_global_cache()
+    {
+        static offline_cache cache(default_path(), default_max_size());
+
+        return cache;
+    }
+
+private:
+    static std::string default_path()
+    {
+        if(const char *path = getenv("BOOST_COMPUTE_OFFLINE_CACHE_DIR")){
+            return path;
+        }
+
+        #ifdef WIN32
+        const char *appdata = getenv("APPDATA");
+        return (boost::filesystem::path(appdata ? appdata : ".") / "boost_compute").string();
+        #else
+        const char *home = getenv("HOME");
+        return (boost::filesystem::path(home ? home : ".") / ".boost_compute").string();
+        #endif
+    }
+
+    static boost::uintmax_t default_max_size()
+    {
+        if(const char *size = getenv("BOOST_COMPUTE_OFFLINE_CACHE_SIZE")){
+            try {
+                return boost::lexical_cast<boost::uintmax_t>(size);
+            }
+            catch(boost::bad_lexical_cast&){
+            }
+        }
+
+        return BOOST_COMPUTE_OFFLINE_CACHE_SIZE;
+    }
+
+    boost::filesystem::path version_path() const
+    {
+        return boost::filesystem::path(m_path) /
+            ("v" + boost::lexical_cast<std::string>(
+                       BOOST_COMPUTE_DETAIL_OFFLINE_CACHE_VERSION));
+    }
+
+    boost::filesystem::path index_path() const
+    {
+        return version_path() / "index";
+    }
+
+    boost::filesystem::path binary_path(const std::string &hash) const
+    {
+        return version_path() / hash.substr(0, 2) / (hash.substr(2) + ".bin");
+    }
+
+    // reads index entries appended since the index was last read
+    void refresh_index()
+    {
+        const boost::filesystem::path path = index_path();
+
+        boost::system::error_code ec;
+        const boost::uintmax_t size = boost::filesystem::file_size(path, ec);
+        if(ec){
+            return;
+        }
+        else if(size == m_index_offset){
+            // nothing new
+            return;
+        }
+        else if(size < m_index_offset){
+            // the index was rewritten, read it again from the start
+            m_index.clear();
+            m_total_size = 0;
+            m_index_offset = 0;
+        }
+
+        std::ifstream index(path.string().c_str(), std::ios::in | std::ios::binary);
+        index.seekg(static_cast<std::streamoff>(m_index_offset));
+
+        std::string line;
+        while(std::getline(index, line)){
+            if(index.eof()){
+                // incomplete line being written by another process
+                break;
+            }
+
+            m_index_offset += line.size() + 1;
+
+            std::istringstream entry(line);
+            std::string hash;
+            boost::uintmax_t binary_size = 0;
+            if(entry >> hash >> binary_size && !m_index.count(hash)){
+                m_index[hash] = binary_size;
+                m_total_size += binary_size;
+            }
+        }
+    }
+
+    // removes the least recently used binaries until the cache is at
+    // three quarters of its size limit and rewrites the index
+    void evict()
+    {
+        typedef std::pair<std::time_t, boost::filesystem::path> file_entry;
+
+        std::vector<file_entry> files;
+        boost::uintmax_t total_size = 0;
+
+        // the file system (rather than the index) is authoritative as
+        // other processes may have added or removed binaries
+        boost::system::error_code ec;
+        boost::filesystem::recursive_directory_iterator i(version_path(), ec), end;
+        for(; !ec && i != end; i.increment(ec)){
+            const boost::filesystem::path &file = i->path();
+            if(file.extension() != ".bin"){
+                continue;
+            }
+
+            boost::system::error_code file_ec;
+            const boost::uintmax_t size = boost::filesystem::file_size(file, file_ec);
+            const std::time_t time = boost::filesystem::last_write_time(file, file_ec);
+            if(!file_ec){
+                total_size += size;
+                files.push_back(file_entry(time, file));
+            }
+        }
+
+        std::sort(files.begin(), files.end());
+
+        const boost::uintmax_t target_size = m_max_size / 4 * 3;
+
+        size_t first = 0;
+        for(; first < files.size() && total_size > target_size; first++){
+            total_size -= boost::filesystem::file_size(files[first].second, ec);
+            boost::filesystem::remove(files[first].second, ec);
+        }
+
+        // write the new index and atomically replace the old one
+        m_index.clear();
+        m_total_size = 0;
+
+        const boost::filesystem::path temp =
+            version_path() / boost::filesystem::unique_path("index-%%%%-%%%%.tmp");
+        {
+            std::ofstream index(temp.string().c_str(), std::ios::out | std::ios::binary);
+            for(size_t j = first; j < files.size(); j++){
+                const boost::filesystem::path &file = files[j].second;
+                const std::string hash =
+                    file.parent_path().filename().string() + file.stem().string();
+                const boost::uintmax_t size = boost::filesystem::file_size(file, ec);
+
+                index << hash << " " << size << "\n";
+
+                m_index[hash] = size;
+                m_total_size += size;
+            }
+        }
+
+        boost::filesystem::rename(temp, index_path(), ec);
+        if(ec){
+            boost::filesystem::remove(temp, ec);
+        }
+
+        m_index_offset = boost::filesystem::file_size(index_path(), ec);
+        if(ec){
+            m_index_offset = 0;
+        }
+    }
+
+private:
+    std::string m_path;
+    boost::uintmax_t m_max_size;
+    boost::uintmax_t m_total_size;
+    boost::uintmax_t m_index_offset;
+    boost::unordered_map<std::string, boost::uintmax_t> m_index;
+    mutex m_mutex;
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_OFFLINE_CACHE_HPP
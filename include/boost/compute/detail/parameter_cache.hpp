@@ -0,0 +1,233 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_PARAMETER_CACHE_HPP
+#define BOOST_COMPUTE_DETAIL_PARAMETER_CACHE_HPP
+
+#include <map>
+#include <string>
+#include <utility>
+#include <algorithm>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/detail/mutex.hpp>
+
+#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+#include <fstream>
+#include <sstream>
+#include <boost/filesystem.hpp>
+#include <boost/compute/detail/offline_cache.hpp>
+#endif
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// stores tuning parameters for algorithms (e.g. the number of bits per
+// radix sort pass) for a device. algorithms query the cache with their
+// object name (e.g. "__boost_radix_sort_uint") and the name of the
+// parameter and fall back to their own heuristic value if the parameter
+// has not been set.
+//
+// parameters can be overridden by calling set() on the global cache for
+// a device. when BOOST_COMPUTE_USE_OFFLINE_CACHE is defined the values are
+// loaded from and stored in the "tune" directory of the offline cache so
+// that tuned parameters persist between runs.
+class parameter_cache : boost::noncopyable
+{
+public:
+    explicit parameter_cache(const device &device)
+        : m_dirty(false)
+    {
+    #ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+        m_file_name = make_file_name(device);
+
+        read_from_disk();
+    #else
+        (void) device;
+    #endif
+    }
+
+    ~parameter_cache()
+    {
+    #ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+        try {
+            write_to_disk();
+        }
+        catch(...){
+        }
+    #endif
+    }
+
+    // sets parameter for object to value
+    void set(const std::string &object, const std::string &parameter, uint_ value)
+    {
+        scoped_lock lock(m_mutex);
+
+        m_cache[std::make_pair(object, parameter)] = value;
+        m_dirty = true;
+    }
+
+    // returns the value of parameter for object or default_value if it
+    // has not been set
+    uint_ get(const std::string &object, const std::string &parameter, uint_ default_value) const
+    {
+        scoped_lock lock(m_mutex);
+
+        map_type::const_iterator i = m_cache.find(std::make_pair(object, parameter));
+        if(i == m_cache.end()){
+            return default_value;
+        }
+
+        return i->second;
+    }
+
+    // removes all parameters for object
+    void reset(const std::string &object)
+    {
+        scoped_lock lock(m_mutex);
+
+        map_type::iterator i = m_cache.lower_bound(std::make_pair(object, std::string()));
+        while(i != m_cache.end() && i->first.first == object){
+            m_cache.erase(i++);
+            m_dirty = true;
+        }
+    }
+
+    // writes the parameters to the offline cache if they have changed
+    void flush()
+    {
+    #ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+        scoped_lock lock(m_mutex);
+
+        write_to_disk();
+    #endif
+    }
+
+    // returns the global parameter cache for device
+    static boost::shared_ptr<parameter_cache> get_global_cache(const device &device)
+    {
+        typedef std::map<cl_device_id, boost::shared_ptr<parameter_cache> > cache_map;
+
+        static mutex caches_mutex;
+        static cache_map caches;
+
+        scoped_lock lock(caches_mutex);
+
+        boost::shared_ptr<parameter_cache> &cache = caches[device.id()];
+        if(!cache){
+            cache = boost::make_shared<parameter_cache>(device);
+        }
+
+        return cache;
+    }
+
+private:
+#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+    static std::string make_file_name(const device &device)
+    {
+        // use the device name with any characters which are not portable
+        // in file names replaced
+        std::string name = device.name() + "_" + device.driver_version();
+        for(size_t i = 0; i < name.size(); i++){
+            const char c = name[i];
+            if(!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                 (c >= '0' && c <= '9') || c == '.' || c == '-')){
+                name[i] = '_';
+            }
+        }
+
+        boost::filesystem::path path(offline_cache::get_global_cache().path());
+        path /= "tune";
+        path /= name + ".txt";
+
+        return path.string();
+    }
+
+    void read_from_disk()
+    {
+        std::ifstream file(m_file_name.c_str());
+
+        std::string line;
+        while(std::getline(file, line)){
+            std::istringstream entry(line);
+            std::string object;
+            std::string parameter;
+            uint_ value = 0;
+            if(entry >> object >> parameter >> value){
+                m_cache[std::make_pair(object, parameter)] = value;
+            }
+        }
+    }
+
+    void write_to_disk()
+    {
+        if(!m_dirty){
+            return;
+        }
+
+        const boost::filesystem::path path(m_file_name);
+
+        boost::system::error_code ec;
+        boost::filesystem::create_directories(path.parent_path(), ec);
+        if(ec){
+            return;
+        }
+
+        std::ofstream file(m_file_name.c_str());
+        for(map_type::const_iterator i = m_cache.begin(); i != m_cache.end(); ++i){
+            file << i->first.first << " " << i->first.second << " " << i->second << "\n";
+        }
+
+        m_dirty = false;
+    }
+#endif // BOOST_COMPUTE_USE_OFFLINE_CACHE
+
+private:
+    typedef std::map<std::pair<std::string, std::string>, uint_> map_type;
+
+    bool m_dirty;
+    std::string m_file_name;
+    map_type m_cache;
+    mutable mutex m_mutex;
+};
+
+// returns the work-group size for parameter of object from the global
+// parameter cache of device, or default_value if it has not been set. the
+// size is rounded down to a power of two and limited to the maximum
+// work-group size of the device.
+inline size_t get_work_group_size_parameter(const device &device,
+                                            const std::string &object,
+                                            const std::string &parameter,
+                                            size_t default_value)
+{
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(device);
+
+    size_t value = parameters->get(object, parameter, static_cast<uint_>(default_value));
+    value = (std::min)(value, device.max_work_group_size());
+
+    size_t size = 1;
+    while(size * 2 <= value){
+        size *= 2;
+    }
+
+    return size;
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_PARAMETER_CACHE_HPP
@@ -0,0 +1,194 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_PINNED_HOST_POOL_HPP
+#define BOOST_COMPUTE_DETAIL_PINNED_HOST_POOL_HPP
+
+#include <list>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/utility/buffer_pool.hpp>
+#include <boost/compute/detail/lru_cache.hpp>
+#include <boost/compute/detail/global_static.hpp>
+#include <boost/compute/detail/mutex.hpp>
+#include <boost/compute/detail/pinned_host_registry.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// pool of pinned (alloc_host_ptr) buffers of a context which stay mapped
+// into the host address space.
+//
+// pinning and mapping memory is much slower than allocating pageable
+// memory, so the blocks released by pinned_host_vector's are kept mapped
+// for reuse. block sizes are rounded to the size classes of buffer_pool.
+// at most limit() bytes of idle blocks are kept, the least recently
+// released ones are unmapped and freed first.
+class pinned_host_pool : boost::noncopyable
+{
+public:
+    struct block
+    {
+        block()
+            : ptr(0),
+              size(0)
+        {
+        }
+
+        buffer buf;
+        void *ptr;
+        size_t size;
+    };
+
+    explicit pinned_host_pool(const context &context)
+        : m_context(context),
+          m_queue(context, context.get_device()),
+          m_limit(default_limit()),
+          m_idle_size(0)
+    {
+    }
+
+    ~pinned_host_pool()
+    {
+        scoped_lock lock(m_mutex);
+
+        while(!m_idle.empty()){
+            free_block(m_idle.front());
+            m_idle.pop_front();
+        }
+    }
+
+    // returns a mapped block of at least size bytes
+    block allocate(size_t size)
+    {
+        const size_t block_size = buffer_pool::size_class(size);
+
+        {
+            scoped_lock lock(m_mutex);
+
+            for(block_list::iterator i = m_idle.begin(); i != m_idle.end(); ++i){
+                if(i->size == block_size){
+                    block b = *i;
+                    m_idle.erase(i);
+                    m_idle_size -= b.size;
+                    return b;
+                }
+            }
+        }
+
+        block b;
+        b.buf = buffer(m_context, block_size, buffer::read_write | buffer::alloc_host_ptr);
+        b.ptr = m_queue.enqueue_map_buffer(
+            b.buf, CL_MAP_READ | CL_MAP_WRITE, 0, block_size
+        );
+        b.size = block_size;
+
+        pinned_host_registry::get().insert(b.ptr, b.size);
+
+        return b;
+    }
+
+    // returns b to the pool, it stays mapped
+    void release(const block &b)
+    {
+        scoped_lock lock(m_mutex);
+
+        m_idle.push_back(b);
+        m_idle_size += b.size;
+
+        while(m_idle_size > m_limit){
+            m_idle_size -= m_idle.front().size;
+            free_block(m_idle.front());
+            m_idle.pop_front();
+        }
+    }
+
+    // returns the maximum size (in bytes) of the idle blocks
+    size_t limit() const
+    {
+        return m_limit;
+    }
+
+    // unmaps and frees all of the idle blocks
+    void trim()
+    {
+        scoped_lock lock(m_mutex);
+
+        while(!m_idle.empty()){
+            free_block(m_idle.front());
+            m_idle.pop_front();
+        }
+        m_idle_size = 0;
+    }
+
+    // returns the number of bytes in idle blocks
+    size_t idle_size() const
+    {
+        return m_idle_size;
+    }
+
+    // returns the global pinned host pool for context
+    static boost::shared_ptr<pinned_host_pool> get_global_pool(const context &context)
+    {
+        typedef lru_cache<cl_context, boost::shared_ptr<pinned_host_pool> > pool_map;
+
+        // construct the registry first so that it outlives the pools
+        pinned_host_registry::get();
+
+        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(pool_map, pools, (8));
+
+        boost::optional<boost::shared_ptr<pinned_host_pool> > pool = pools.get(context.get());
+        if(!pool){
+            pool = boost::make_shared<pinned_host_pool>(context);
+
+            pools.insert(context.get(), *pool);
+        }
+
+        return *pool;
+    }
+
+private:
+    typedef std::list<block> block_list;
+
+    static size_t default_limit()
+    {
+        return size_t(64) << 20;
+    }
+
+    void free_block(const block &b)
+    {
+        pinned_host_registry::get().erase(b.ptr);
+
+        // called from the destructor, errors are ignored
+        clEnqueueUnmapMemObject(m_queue.get(), b.buf.get(), b.ptr, 0, 0, 0);
+    }
+
+private:
+    context m_context;
+    command_queue m_queue;
+    size_t m_limit;
+    size_t m_idle_size;
+    block_list m_idle;
+    mutex m_mutex;
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_PINNED_HOST_POOL_HPP
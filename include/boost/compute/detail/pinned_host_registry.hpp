@@ -0,0 +1,90 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_PINNED_HOST_REGISTRY_HPP
+#define BOOST_COMPUTE_DETAIL_PINNED_HOST_REGISTRY_HPP
+
+#include <map>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/detail/mutex.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// address ranges of the host memory mapped by all of the pinned host pools
+// of the process. copy() looks up host ranges here to pass pinned memory
+// directly to the driver instead of staging it.
+class pinned_host_registry : boost::noncopyable
+{
+public:
+    void insert(const void *ptr, size_t size)
+    {
+        scoped_lock lock(m_mutex);
+
+        m_ranges[static_cast<const char *>(ptr)] = size;
+    }
+
+    void erase(const void *ptr)
+    {
+        scoped_lock lock(m_mutex);
+
+        m_ranges.erase(static_cast<const char *>(ptr));
+    }
+
+    // returns true if [ptr, ptr + size) is inside a single pinned range
+    bool contains(const void *ptr, size_t size)
+    {
+        const char *first = static_cast<const char *>(ptr);
+
+        scoped_lock lock(m_mutex);
+
+        if(m_ranges.empty()){
+            return false;
+        }
+
+        range_map::const_iterator i = m_ranges.upper_bound(first);
+        if(i == m_ranges.begin()){
+            return false;
+        }
+        --i;
+
+        return first + size <= i->first + i->second;
+    }
+
+    // the registry is shared by all threads
+    static pinned_host_registry& get()
+    {
+        static pinned_host_registry registry;
+
+        return registry;
+    }
+
+private:
+    typedef std::map<const char *, size_t> range_map;
+
+    mutex m_mutex;
+    range_map m_ranges;
+};
+
+// returns true if size bytes at ptr are host memory mapped from a pinned
+// buffer (see pinned_host_vector)
+inline bool is_pinned_host_memory(const void *ptr, size_t size)
+{
+    return pinned_host_registry::get().contains(ptr, size);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_PINNED_HOST_REGISTRY_HPP
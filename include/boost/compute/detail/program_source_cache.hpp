@@ -0,0 +1,161 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_PROGRAM_SOURCE_CACHE_HPP
+#define BOOST_COMPUTE_DETAIL_PROGRAM_SOURCE_CACHE_HPP
+
+#include <string>
+
+#include <boost/optional.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/functional/hash.hpp>
+
+#include <boost/compute/context.hpp>
+#include <boost/compute/program.hpp>
+#include <boost/compute/detail/hash128.hpp>
+#include <boost/compute/detail/lru_cache.hpp>
+#include <boost/compute/detail/global_static.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// caches the programs of recently launched meta kernels by the hash of
+// their source (see hash128) and build options.
+//
+// this cache is consulted before the global program_cache so that
+// repeated launches of the same kernel (e.g. an algorithm called in a
+// loop) skip assembling the full source and the program_cache lookup.
+//
+// the global cache returned by get_global_cache() is thread-local when
+// BOOST_COMPUTE_THREAD_SAFE is defined.
+class program_source_cache : boost::noncopyable
+{
+public:
+    program_source_cache(size_t capacity)
+        : m_cache(capacity)
+    {
+    }
+
+    size_t size() const
+    {
+        return m_cache.size();
+    }
+
+    void clear()
+    {
+        m_cache.clear();
+    }
+
+    // returns the program built from the source with hash and options
+    // for context
+    boost::optional<program> get(const context &context,
+                                 const hash128_digest &hash,
+                                 const std::string &options)
+    {
+        const key_ref ref = { context.get(), hash, options };
+
+        return m_cache.get(ref, key_hash(), key_equal());
+    }
+
+    void insert(const context &context,
+                const hash128_digest &hash,
+                const std::string &options,
+                const program &program)
+    {
+        key_type key;
+        key.context = context.get();
+        key.hash = hash;
+        key.options = options;
+
+        m_cache.insert(key, program);
+    }
+
+    // returns the global program source cache (for the current thread)
+    static program_source_cache& get_global_cache()
+    {
+        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(program_source_cache, cache, (64));
+
+        return cache;
+    }
+
+private:
+    struct key_type
+    {
+        cl_context context;
+        hash128_digest hash;
+        std::string options;
+
+        bool operator==(const key_type &other) const
+        {
+            return context == other.context &&
+                   hash == other.hash &&
+                   options == other.options;
+        }
+    };
+
+    struct key_ref
+    {
+        cl_context context;
+        const hash128_digest &hash;
+        const std::string &options;
+    };
+
+    struct key_hash
+    {
+        size_t operator()(const key_type &k) const
+        {
+            return hash(k.context, k.hash, k.options);
+        }
+
+        size_t operator()(const key_ref &k) const
+        {
+            return hash(k.context, k.hash, k.options);
+        }
+
+        static size_t hash(cl_context context,
+                           const hash128_digest &digest,
+                           const std::string &options)
+        {
+            size_t seed = static_cast<size_t>(digest.low);
+            boost::hash_combine(seed, context);
+            boost::hash_combine(seed, options);
+            return seed;
+        }
+    };
+
+    struct key_equal
+    {
+        bool operator()(const key_type &a, const key_type &b) const
+        {
+            return a == b;
+        }
+
+        bool operator()(const key_ref &a, const key_type &b) const
+        {
+            return a.context == b.context &&
+                   a.hash == b.hash &&
+                   a.options == b.options;
+        }
+
+        bool operator()(const key_type &a, const key_ref &b) const
+        {
+            return (*this)(b, a);
+        }
+    };
+
+    lru_cache<key_type, program, key_hash, key_equal> m_cache;
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_PROGRAM_SOURCE_CACHE_HPP
@@ -0,0 +1,87 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_SCRATCH_MEMORY_HPP
+#define BOOST_COMPUTE_DETAIL_SCRATCH_MEMORY_HPP
+
+#include <algorithm>
+
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/utility/memory_usage.hpp>
+#include <boost/compute/utility/scratch_space.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns the number of bytes of device memory available for the temporary
+// buffers of the algorithms running on queue. this is the free space of the
+// active scratch space if it has no fallback, otherwise the global memory
+// of the device not held by the containers and temporaries of Boost.Compute
+// (idle buffers cached by the buffer_pool are not counted as they can be
+// freed). memory allocated by other means is not known.
+inline size_t available_scratch_memory(command_queue &queue)
+{
+    const context &context = queue.get_context();
+
+    #ifdef CL_VERSION_1_1
+    if(scratch_space *space = get_active_scratch_space(context)){
+        if(!space->fallback()){
+            return space->size() - (std::min)(space->used(), space->size());
+        }
+    }
+    #endif // CL_VERSION_1_1
+
+    boost::shared_ptr<memory_usage> usage = memory_usage::get_global_usage(context);
+    const ulong_ used =
+        usage->current(memory_usage::containers) +
+        usage->current(memory_usage::temporaries);
+    const ulong_ total = device_profile::get(queue.get_device())->global_memory_size();
+
+    return static_cast<size_t>(
+        (std::min)(total - (std::min)(used, total), ulong_(~size_t(0)))
+    );
+}
+
+// returns true if temporary buffers of bytes in total, the largest of
+// which has largest bytes, fit into the available memory. a reserve is
+// kept for the few bytes of bookkeeping of nested algorithms (e.g. the
+// block sums of scans) which the scratch size functions do not include.
+inline bool fits_scratch_memory(size_t bytes, size_t largest, command_queue &queue)
+{
+    if(largest > device_profile::get(queue.get_device())->max_memory_alloc_size()){
+        return false;
+    }
+
+    const size_t reserve = bytes / 16 + 4096;
+    const size_t available = available_scratch_memory(queue);
+
+    return available >= reserve && bytes <= available - reserve;
+}
+
+// returns true if e reports that device memory could not be allocated
+inline bool is_allocation_failure(const opencl_error &e)
+{
+    return e.error_code() == CL_MEM_OBJECT_ALLOCATION_FAILURE ||
+           e.error_code() == CL_OUT_OF_RESOURCES ||
+           e.error_code() == CL_INVALID_BUFFER_SIZE;
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_SCRATCH_MEMORY_HPP
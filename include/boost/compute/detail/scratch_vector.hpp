@@ -0,0 +1,127 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_SCRATCH_VECTOR_HPP
+#define BOOST_COMPUTE_DETAIL_SCRATCH_VECTOR_HPP
+
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/utility/buffer_pool.hpp>
+#include <boost/compute/utility/scratch_space.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// fixed-size temporary storage for algorithms. the memory is drawn from
+// the scratch_space made active for the queue's context (if any) or from
+// the global buffer pool and returned to it on destruction (while commands
+// using it may still be pending on queue)
+template<class T>
+class scratch_vector : boost::noncopyable
+{
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef buffer_iterator<T> iterator;
+    typedef buffer_iterator<T> const_iterator;
+
+    scratch_vector(size_t size, command_queue &queue)
+        : m_size(size),
+          m_queue(queue)
+    {
+        #ifdef CL_VERSION_1_1
+        m_space = get_active_scratch_space(queue.get_context());
+        if(m_space){
+            m_buffer = m_space->allocate(size * sizeof(T));
+            if(m_buffer.get()){
+                return;
+            }
+            else if(!m_space->fallback()){
+                BOOST_THROW_EXCEPTION(opencl_error(CL_MEM_OBJECT_ALLOCATION_FAILURE));
+            }
+
+            // the temporary does not fit into the scratch space
+            m_space = 0;
+        }
+        #endif // CL_VERSION_1_1
+
+        m_pool = buffer_pool::get_global_pool(queue.get_context());
+        m_buffer = m_pool->allocate(size * sizeof(T), queue);
+    }
+
+    ~scratch_vector()
+    {
+        #ifdef CL_VERSION_1_1
+        if(m_space){
+            m_space->release(m_buffer);
+            return;
+        }
+        #endif // CL_VERSION_1_1
+
+        m_pool->release(m_buffer, m_queue);
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    iterator begin() const
+    {
+        return buffer_iterator<T>(m_buffer, 0);
+    }
+
+    iterator end() const
+    {
+        return buffer_iterator<T>(m_buffer, m_size);
+    }
+
+    const buffer& get_buffer() const
+    {
+        return m_buffer;
+    }
+
+private:
+    size_t m_size;
+    command_queue m_queue;
+    boost::shared_ptr<buffer_pool> m_pool;
+    #ifdef CL_VERSION_1_1
+    scratch_space *m_space;
+    #endif
+    buffer m_buffer;
+};
+
+// set_kernel_arg specialization for scratch_vector<T>
+template<class T>
+struct set_kernel_arg<scratch_vector<T> >
+{
+    void operator()(kernel &kernel_, size_t index, const scratch_vector<T> &vector)
+    {
+        kernel_.set_arg(index, vector.get_buffer());
+    }
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_SCRATCH_VECTOR_HPP
@@ -0,0 +1,279 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_STAGING_RING_HPP
+#define BOOST_COMPUTE_DETAIL_STAGING_RING_HPP
+
+#include <list>
+#include <limits>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/allocator/pinned_allocator.hpp>
+#include <boost/compute/detail/mutex.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// ring of pinned (page-locked) host buffers used to stage copies between
+// pageable host memory and the device.
+//
+// each slot is allocated with the pinned_allocator and stays mapped for
+// the lifetime of the ring, so transfers from and to the mapped pointers
+// run at full DMA speed. copies are split into chunks of one slot each.
+// while the transfer of one chunk is in flight the host copies the next
+// chunk into (or the previous chunk out of) another slot. the event of the
+// last transfer of each slot is awaited before the slot is reused.
+//
+// the slots are unmapped and freed by release() (or the destructor). the
+// global rings are never destroyed by a static destructor, they are torn
+// down explicitly with release_global_rings() or left to the process exit.
+class staging_ring : boost::noncopyable
+{
+public:
+    // size of each slot in bytes
+    static size_t default_chunk_size()
+    {
+        return size_t(1) << 20;
+    }
+
+    // number of slots in the ring
+    static size_t default_slot_count()
+    {
+        return 2;
+    }
+
+    // copies of contiguous host ranges at least this large (in bytes) are
+    // staged, smaller ones are passed to the driver directly. the threshold
+    // is read from the "__boost_staging_ring" "threshold" parameter of the
+    // device, a value of zero disables staging of contiguous ranges. it
+    // defaults to two chunks, or zero for devices sharing the host memory
+    // where the driver transfers pageable memory without a copy.
+    static size_t threshold(const command_queue &queue)
+    {
+        const device device = queue.get_device();
+
+        const uint_ default_threshold =
+            device_profile::get(device)->host_unified_memory() ?
+                uint_(0) : static_cast<uint_>(2 * default_chunk_size());
+
+        const uint_ value = parameter_cache::get_global_cache(device)->get(
+            "__boost_staging_ring", "threshold", default_threshold
+        );
+
+        if(value == 0){
+            return (std::numeric_limits<size_t>::max)();
+        }
+
+        return static_cast<size_t>(value);
+    }
+
+    explicit staging_ring(const command_queue &queue,
+                          size_t chunk_size = default_chunk_size(),
+                          size_t slot_count = default_slot_count())
+        : m_queue(queue),
+          m_chunk_size(chunk_size),
+          m_allocator(queue.get_context()),
+          m_events(slot_count)
+    {
+        m_slots.reserve(slot_count);
+        m_pointers.reserve(slot_count);
+
+        for(size_t i = 0; i < slot_count; i++){
+            m_slots.push_back(m_allocator.allocate(chunk_size));
+            m_pointers.push_back(
+                m_queue.enqueue_map_buffer(
+                    m_slots.back().get_buffer(),
+                    CL_MAP_READ | CL_MAP_WRITE,
+                    0,
+                    chunk_size
+                )
+            );
+        }
+    }
+
+    ~staging_ring()
+    {
+        release();
+    }
+
+    // waits for the transfers of all slots, then unmaps and frees them. the
+    // ring cannot be used afterwards. calling release() again is a no-op.
+    void release()
+    {
+        if(m_slots.empty()){
+            return;
+        }
+
+        wait();
+
+        for(size_t i = 0; i < m_slots.size(); i++){
+            clEnqueueUnmapMemObject(
+                m_queue.get(), m_slots[i].get_buffer().get(), m_pointers[i], 0, 0, 0
+            );
+        }
+
+        for(size_t i = 0; i < m_slots.size(); i++){
+            m_allocator.deallocate(m_slots[i], m_chunk_size);
+        }
+
+        m_slots.clear();
+        m_pointers.clear();
+        m_events.clear();
+    }
+
+    size_t chunk_size() const
+    {
+        return m_chunk_size;
+    }
+
+    size_t slot_count() const
+    {
+        return m_slots.size();
+    }
+
+    // waits for the last transfer using slot and returns its host pointer
+    void* acquire(size_t slot)
+    {
+        if(m_events[slot].get()){
+            m_events[slot].wait();
+            m_events[slot] = event();
+        }
+
+        return m_pointers[slot];
+    }
+
+    // records event as the last transfer using slot
+    void release(size_t slot, const event &event_)
+    {
+        m_events[slot] = event_;
+    }
+
+    // waits for the transfers of all slots
+    void wait()
+    {
+        for(size_t i = 0; i < m_events.size(); i++){
+            acquire(i);
+        }
+    }
+
+    // the mutex held while a copy uses the ring
+    mutex& get_mutex()
+    {
+        return m_mutex;
+    }
+
+    // returns the global staging ring for queue
+    static boost::shared_ptr<staging_ring> get_global_ring(command_queue &queue)
+    {
+        registry &rings = global_registry();
+        scoped_lock lock(rings.mutex_);
+
+        // the queues are retained by the entries so their handles cannot be
+        // reused by another queue while they are registered
+        for(registry::iterator i = rings.entries.begin(); i != rings.entries.end(); ++i){
+            if(i->queue == queue){
+                rings.entries.splice(rings.entries.begin(), rings.entries, i);
+                return rings.entries.front().ring;
+            }
+        }
+
+        registry_entry entry;
+        entry.queue = queue;
+        entry.ring = boost::make_shared<staging_ring>(queue);
+        rings.entries.push_front(entry);
+
+        // the evicted rings are released once their last copy is done
+        while(rings.entries.size() > global_ring_count()){
+            rings.entries.pop_back();
+        }
+
+        return entry.ring;
+    }
+
+    // releases the global staging ring of queue
+    static void release_global_ring(const command_queue &queue)
+    {
+        registry &rings = global_registry();
+        scoped_lock lock(rings.mutex_);
+
+        for(registry::iterator i = rings.entries.begin(); i != rings.entries.end(); ++i){
+            if(i->queue == queue){
+                rings.entries.erase(i);
+                return;
+            }
+        }
+    }
+
+    // releases the global staging rings of all queues. this should be
+    // called before the opencl runtime is unloaded, the rings are not torn
+    // down by static destructors.
+    static void release_global_rings()
+    {
+        registry &rings = global_registry();
+        scoped_lock lock(rings.mutex_);
+
+        rings.entries.clear();
+    }
+
+private:
+    struct registry_entry
+    {
+        command_queue queue;
+        boost::shared_ptr<staging_ring> ring;
+    };
+
+    struct registry
+    {
+        typedef std::list<registry_entry>::iterator iterator;
+
+        mutex mutex_;
+        std::list<registry_entry> entries;
+    };
+
+    // maximum number of queues with a global ring
+    static size_t global_ring_count()
+    {
+        return 8;
+    }
+
+    // the registry is intentionally never destroyed, unmapping the slots
+    // from a static destructor may run after the driver has been unloaded
+    static registry& global_registry()
+    {
+        static registry *rings = new registry;
+
+        return *rings;
+    }
+
+private:
+    command_queue m_queue;
+    size_t m_chunk_size;
+    pinned_allocator<unsigned char> m_allocator;
+    std::vector<device_ptr<unsigned char> > m_slots;
+    std::vector<void *> m_pointers;
+    std::vector<event> m_events;
+    mutex m_mutex;
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_STAGING_RING_HPP
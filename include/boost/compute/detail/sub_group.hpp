@@ -0,0 +1,259 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_SUB_GROUP_HPP
+#define BOOST_COMPUTE_DETAIL_SUB_GROUP_HPP
+
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// the kind of collective functions available on a device
+enum sub_group_backend {
+    sub_group_backend_none,
+    // sub_group_*() functions from cl_khr_subgroups (or OpenCL 2.1)
+    sub_group_backend_khr,
+    // sub_group_*() functions from cl_intel_subgroups
+    sub_group_backend_intel,
+    // work_group_*() functions from OpenCL 2.0
+    sub_group_backend_work_group
+};
+
+// true if T is supported by the sub-group reduce, scan and broadcast
+// functions (half and double also are, but require extensions)
+template<class T>
+struct is_sub_group_type : boost::false_type {};
+
+template<> struct is_sub_group_type<int_> : boost::true_type {};
+template<> struct is_sub_group_type<uint_> : boost::true_type {};
+template<> struct is_sub_group_type<long_> : boost::true_type {};
+template<> struct is_sub_group_type<ulong_> : boost::true_type {};
+template<> struct is_sub_group_type<float_> : boost::true_type {};
+
+// generates calls to the collective functions of a device for use in
+// meta_kernel source. the functions operate on a "group" of work-items
+// which is a sub-group when the device supports them and the whole
+// work-group when only the OpenCL 2.0 work-group functions are available.
+//
+// all work-items of a group must call the functions (that is, the calls
+// must not be inside divergent control flow).
+//
+// for example, to sum x over each group:
+//
+//     sub_group_functions sub_groups(device);
+//     if(sub_groups.supports<int_>()){
+//         sub_groups.enable(k);
+//         k << "const int sum = " << sub_groups.reduce("add", "x") << ";\n";
+//         ...
+//         k.compile(context, sub_groups.options());
+//     }
+class sub_group_functions
+{
+public:
+    explicit sub_group_functions(const device &device)
+        : m_backend(get_backend(device)),
+          m_version(device.get_version())
+    {
+    }
+
+    sub_group_backend backend() const
+    {
+        return m_backend;
+    }
+
+    // returns true if the device supports collective functions
+    bool supported() const
+    {
+        return m_backend != sub_group_backend_none;
+    }
+
+    // returns true if the functions support values of type T
+    template<class T>
+    bool supports() const
+    {
+        return supported() && is_sub_group_type<T>::value;
+    }
+
+    // returns true if groups span the whole work-group
+    bool is_work_group() const
+    {
+        return m_backend == sub_group_backend_work_group;
+    }
+
+    // enables the extension providing the functions in the kernel
+    void enable(meta_kernel &k) const
+    {
+        if(m_backend == sub_group_backend_khr){
+            k.add_extension_pragma("cl_khr_subgroups");
+        }
+        else if(m_backend == sub_group_backend_intel){
+            k.add_extension_pragma("cl_intel_subgroups");
+        }
+    }
+
+    // returns the build options required by the functions
+    std::string options() const
+    {
+        if(m_backend == sub_group_backend_khr ||
+           m_backend == sub_group_backend_work_group){
+            return m_version >= 300 ? "-cl-std=CL3.0" : "-cl-std=CL2.0";
+        }
+
+        return std::string();
+    }
+
+    // returns the id of the work-item in its group
+    std::string local_id() const
+    {
+        return is_work_group() ? "get_local_id(0)" : "get_sub_group_local_id()";
+    }
+
+    // returns the number of work-items in the work-item's group
+    std::string size() const
+    {
+        return is_work_group() ? "get_local_size(0)" : "get_sub_group_size()";
+    }
+
+    // returns the id of the work-item's group in the work-group
+    std::string group_id() const
+    {
+        return is_work_group() ? "0" : "get_sub_group_id()";
+    }
+
+    // returns the number of groups in the work-group
+    std::string group_count() const
+    {
+        return is_work_group() ? "1" : "get_num_sub_groups()";
+    }
+
+    // returns op ("add", "min" or "max") applied to x of each work-item
+    std::string reduce(const std::string &op, const std::string &x) const
+    {
+        return call("_reduce_" + op, x);
+    }
+
+    // returns op applied to x of the work-items up to and including
+    // the current one
+    std::string scan_inclusive(const std::string &op, const std::string &x) const
+    {
+        return call("_scan_inclusive_" + op, x);
+    }
+
+    // returns op applied to x of the work-items preceding the current one
+    std::string scan_exclusive(const std::string &op, const std::string &x) const
+    {
+        return call("_scan_exclusive_" + op, x);
+    }
+
+    // returns x of the work-item with the given local id
+    std::string broadcast(const std::string &x, const std::string &id) const
+    {
+        return call("_broadcast", x + ", " + id);
+    }
+
+    // returns true if x is true for any work-item
+    std::string any(const std::string &x) const
+    {
+        return call("_any", x);
+    }
+
+    // returns true if x is true for all work-items
+    std::string all(const std::string &x) const
+    {
+        return call("_all", x);
+    }
+
+    // returns a mask with a bit set for each work-item for which x is true.
+    // only valid for groups of at most 32 work-items.
+    std::string ballot(const std::string &x) const
+    {
+        return reduce("add", "((" + x + ") ? (1u << " + local_id() + ") : 0u)");
+    }
+
+    // returns the number of work-items for which x is true
+    std::string count(const std::string &x) const
+    {
+        return reduce("add", "((" + x + ") ? 1u : 0u)");
+    }
+
+private:
+    std::string call(const std::string &function, const std::string &args) const
+    {
+        return std::string(is_work_group() ? "work_group" : "sub_group") +
+               function + "(" + args + ")";
+    }
+
+    static sub_group_backend get_backend(const device &device)
+    {
+        // the sub-group and work-group functions are core in OpenCL 2.1
+        // and 2.0 respectively but optional in OpenCL 3.0
+        const boost::shared_ptr<device_profile> profile = device_profile::get(device);
+        const uint_ version = profile->version();
+
+        if(version >= 200 && profile->supports_extension("cl_khr_subgroups")){
+            return sub_group_backend_khr;
+        }
+        else if(version >= 210 && version < 300){
+            return sub_group_backend_khr;
+        }
+        else if(profile->supports_extension("cl_intel_subgroups")){
+            return sub_group_backend_intel;
+        }
+        else if(version >= 200 && version < 300){
+            return sub_group_backend_work_group;
+        }
+
+        return sub_group_backend_none;
+    }
+
+private:
+    sub_group_backend m_backend;
+    uint_ m_version;
+};
+
+// returns the build options for kernels using the atomics of the OpenCL
+// 2.0 memory model (atomic_uint with acquire/release order and device
+// scope), or an empty string if the compiler of the device does not
+// support them. they are core in OpenCL C 2.0 and optional in OpenCL C
+// 3.0, where CL_DEVICE_ATOMIC_MEMORY_CAPABILITIES reports them.
+inline std::string memory_model_options(const device &device)
+{
+    const boost::shared_ptr<device_profile> profile = device_profile::get(device);
+
+    if(profile->supports_opencl_c(200)){
+        return "-cl-std=CL2.0";
+    }
+
+#ifdef CL_VERSION_3_0
+    const ulong_ required = CL_DEVICE_ATOMIC_ORDER_ACQ_REL | CL_DEVICE_ATOMIC_SCOPE_DEVICE;
+    if(profile->supports_opencl_c(300) &&
+       (profile->atomic_memory_capabilities() & required) == required){
+        return "-cl-std=CL3.0";
+    }
+#endif // CL_VERSION_3_0
+
+    return std::string();
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_SUB_GROUP_HPP
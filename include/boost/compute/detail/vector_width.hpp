@@ -0,0 +1,87 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_VECTOR_WIDTH_HPP
+#define BOOST_COMPUTE_DETAIL_VECTOR_WIDTH_HPP
+
+#include <string>
+
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/not.hpp>
+#include <boost/type_traits/is_floating_point.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/type_traits/is_fundamental.hpp>
+#include <boost/compute/type_traits/is_vector_type.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// meta-function returning true if values of type T can be loaded and
+// stored with vloadn() and vstoren() (that is, T is a scalar type)
+template<class T>
+struct is_vector_access_type :
+    public boost::mpl::and_<
+        typename ::boost::compute::is_fundamental<T>::type,
+        typename boost::mpl::not_<typename is_vector_type<T>::type>::type
+    >::type { };
+
+// returns the vector width preferred by the device for loading and
+// storing values of type T. returns one if values of type T should be
+// accessed one by one.
+template<class T>
+inline uint_ preferred_vector_width(const device &device)
+{
+    if(!is_vector_access_type<T>::value){
+        return 1;
+    }
+
+    uint_ width = 0;
+    if(boost::is_floating_point<T>::value){
+        width = device.get_info<uint_>(
+            sizeof(T) == sizeof(float_) ? CL_DEVICE_PREFERRED_VECTOR_WIDTH_FLOAT
+                                        : CL_DEVICE_PREFERRED_VECTOR_WIDTH_DOUBLE
+        );
+    }
+    else if(sizeof(T) == 1){
+        width = device.get_info<uint_>(CL_DEVICE_PREFERRED_VECTOR_WIDTH_CHAR);
+    }
+    else if(sizeof(T) == 2){
+        width = device.get_info<uint_>(CL_DEVICE_PREFERRED_VECTOR_WIDTH_SHORT);
+    }
+    else if(sizeof(T) == 4){
+        width = device.get_info<uint_>(CL_DEVICE_PREFERRED_VECTOR_WIDTH_INT);
+    }
+    else if(sizeof(T) == 8){
+        width = device.get_info<uint_>(CL_DEVICE_PREFERRED_VECTOR_WIDTH_LONG);
+    }
+
+    // only widths of vector types are valid
+    if(width == 2 || width == 4 || width == 8 || width == 16){
+        return width;
+    }
+    return 1;
+}
+
+// returns the name of the component with index i of a vector
+inline std::string vector_component(uint_ i)
+{
+    static const char components[] = "0123456789abcdef";
+
+    return std::string("s") + components[i];
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_VECTOR_WIDTH_HPP
@@ -13,6 +13,7 @@
 
 #include <boost/compute/device.hpp>
 #include <boost/compute/platform.hpp>
+#include <boost/compute/detail/device_profile.hpp>
 
 namespace boost {
 namespace compute {
@@ -21,13 +22,13 @@ namespace detail {
 // returns true if the device is an nvidia gpu
 inline bool is_nvidia_device(const device &device)
 {
-    return device.vendor() == "NVIDIA Corporation";
+    return device_profile::get(device)->vendor() == "NVIDIA Corporation";
 }
 
 // returns true if the device is an amd cpu or gpu
 inline bool is_amd_device(const device &device)
 {
-    return device.platform().vendor() == "Advanced Micro Devices, Inc.";
+    return device_profile::get(device)->platform_vendor() == "Advanced Micro Devices, Inc.";
 }
 
 } // end detail namespace
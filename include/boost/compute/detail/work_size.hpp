@@ -11,7 +11,10 @@
 #ifndef BOOST_COMPUTE_DETAIL_WORK_SIZE_HPP
 #define BOOST_COMPUTE_DETAIL_WORK_SIZE_HPP
 
-#include <cmath>
+#include <algorithm>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/kernel.hpp>
 
 namespace boost {
 namespace compute {
@@ -21,15 +24,60 @@ namespace detail {
 // process per thread (vtp), and a number of threads to execute per
 // block (tpb), this function returns the global work size to be
 // passed to clEnqueueNDRangeKernel() for a 1D algorithm.
+//
+// integer arithmetic is used as float rounds counts above 2^24.
 inline size_t calculate_work_size(size_t count, size_t vpt, size_t tpb)
 {
-    size_t work_size = static_cast<size_t>(std::ceil(float(count) / vpt));
+    size_t work_size = count / vpt + (count % vpt != 0 ? 1 : 0);
     if(work_size % tpb != 0){
         work_size += tpb - work_size % tpb;
     }
     return work_size;
 }
 
+// returns the largest power of two work-group size not above max_size
+// (and the device limit) with which kernel can be launched on device. the
+// kernel limit accounts for the registers and private memory it uses, and
+// power of two sizes at or above the preferred work-group size multiple
+// are multiples of it.
+inline size_t kernel_work_group_size(const kernel &kernel,
+                                     const device &device,
+                                     size_t max_size)
+{
+    const size_t limit = (std::min)(
+        (std::min)(max_size, device.max_work_group_size()),
+        kernel.get_work_group_info<size_t>(device, CL_KERNEL_WORK_GROUP_SIZE)
+    );
+
+    size_t size = 1;
+    while(size * 2 <= limit){
+        size *= 2;
+    }
+
+    return size;
+}
+
+// returns true if the algorithms should use their variants for cpu
+// devices, which process large contiguous chunks of values in each
+// work-item instead of one value per work-item
+inline bool is_cpu_device(const device &device)
+{
+    return (device.type() & device::cpu) != 0;
+}
+
+// returns the number of work-items processing count values in contiguous
+// chunks of at least min_chunk values on a cpu device. a few work-items
+// per compute unit balance the load when some of them finish early.
+inline size_t cpu_work_item_count(size_t count,
+                                  size_t min_chunk,
+                                  const device &device)
+{
+    const size_t max_count =
+        (std::max)(size_t(device.compute_units()), size_t(1)) * 4;
+
+    return (std::max)((std::min)(max_count, count / min_chunk), size_t(1));
+}
+
 } // end detail namespace
 } // end compute namespace
 } // end boost namespace
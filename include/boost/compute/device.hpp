@@ -416,6 +416,19 @@ public:
 
         return partition(properties);
     }
+
+    /// Returns \c true if the device can be partitioned by the affinity
+    /// \p domain (e.g. \c CL_DEVICE_AFFINITY_DOMAIN_NUMA).
+    ///
+    /// \opencl_version_warning{1,2}
+    bool supports_affinity_domain(cl_device_affinity_domain domain) const
+    {
+        if (get_version() < 120)
+            return false;
+
+        return (get_info<cl_device_affinity_domain>(
+                    CL_DEVICE_PARTITION_AFFINITY_DOMAIN) & domain) != 0;
+    }
     #endif // CL_VERSION_1_2
 
     /// Returns \c true if the device is the same at \p other.
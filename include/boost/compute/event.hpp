@@ -15,6 +15,7 @@
 
 #include <boost/compute/config.hpp>
 #include <boost/compute/exception.hpp>
+#include <boost/compute/wait_strategy.hpp>
 #include <boost/compute/detail/duration.hpp>
 #include <boost/compute/detail/get_object_info.hpp>
 #include <boost/compute/detail/assert_cl_success.hpp>
@@ -210,12 +211,19 @@ public:
 
     /// Blocks until the actions corresponding to the event have
     /// completed.
+    ///
+    /// The default wait_strategy is used (which blocks in
+    /// \c clWaitForEvents() unless a spin time is set).
     void wait() const
     {
-        cl_int ret = clWaitForEvents(1, &m_event);
-        if(ret != CL_SUCCESS){
-            BOOST_THROW_EXCEPTION(opencl_error(ret));
-        }
+        wait_strategy::get_default().wait(m_event);
+    }
+
+    /// Blocks until the actions corresponding to the event have
+    /// completed, polling their status as described by \p strategy.
+    void wait(const wait_strategy &strategy) const
+    {
+        strategy.wait(m_event);
     }
 
     #if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
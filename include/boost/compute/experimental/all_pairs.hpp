@@ -0,0 +1,129 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_ALL_PAIRS_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_ALL_PAIRS_HPP
+
+#include <iterator>
+#include <algorithm>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+
+/// Stores at \c result[i] the sum of \p init and of \p interaction(\c x,
+/// \c y) for the value \c x at position \c i of the range [\p first,
+/// \p last) and each value \c y at another position of the range, and
+/// returns the end of the result range.
+///
+/// This computes all of the pairwise interactions of the values (e.g. the
+/// forces between the particles of an n-body simulation) in O(n^2) work.
+/// The values are staged in local memory one tile (of one value per
+/// work-item of a work-group) at a time, so each value is read from global
+/// memory once per work-group instead of once per work-item.
+///
+/// For example, to compute the gravitational accelerations of particles
+/// whose masses are stored in the \c w component of their positions:
+/// \code
+/// BOOST_COMPUTE_FUNCTION(float4_, gravity, (float4_ p, float4_ q),
+/// {
+///     float4 r = (float4)(q.xyz - p.xyz, 0);
+///     float d2 = dot(r, r) + 0.001f;
+///     return r * (q.w * rsqrt(d2 * d2 * d2));
+/// });
+///
+/// experimental::all_pairs_reduce(
+///     positions.begin(), positions.end(), accelerations.begin(),
+///     float4_(0, 0, 0, 0), gravity, queue
+/// );
+/// \endcode
+///
+/// \see uniform_grid
+template<class InputIterator, class OutputIterator, class T, class Function>
+inline OutputIterator all_pairs_reduce(InputIterator first,
+                                       InputIterator last,
+                                       OutputIterator result,
+                                       const T &init,
+                                       Function interaction,
+                                       command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        boost::compute::result_of<Function(value_type, value_type)>::type result_type;
+    typedef typename std::iterator_traits<OutputIterator>::difference_type difference_type;
+
+    const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+    if(count == 0){
+        return result;
+    }
+
+    ::boost::compute::detail::meta_kernel k("all_pairs_reduce");
+    size_t tile_arg = k.add_arg<value_type *>(memory_object::local_memory, "tile");
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t init_arg = k.add_arg<const result_type>("init");
+
+    k <<
+        "const uint i = get_global_id(0);\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint tile_size = get_local_size(0);\n" <<
+        "const bool active = i < count;\n" <<
+        k.decl<value_type>("self") << " = " <<
+            first[k.expr<uint_>("active ? i : 0")] << ";\n" <<
+        k.decl<result_type>("sum") << " = init;\n" <<
+        "for(uint tile_start = 0; tile_start < count; tile_start += tile_size){\n" <<
+        "    if(tile_start + lid < count){\n" <<
+        "        tile[lid] = " << first[k.var<uint_>("tile_start + lid")] << ";\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    if(active){\n" <<
+        "        const uint tile_end = min(tile_size, count - tile_start);\n" <<
+        "        for(uint t = 0; t < tile_end; t++){\n" <<
+        "            if(tile_start + t != i){\n" <<
+        "                sum += " << interaction(k.var<value_type>("self"),
+                                                 k.var<value_type>("tile[t]")) << ";\n" <<
+        "            }\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n" <<
+        "if(active){\n" <<
+        "    " << result[k.var<uint_>("i")] << " = sum;\n" <<
+        "}\n";
+
+    const device &device = queue.get_device();
+    size_t work_group_size = k.work_group_size(queue, 256);
+    while(work_group_size > 1 &&
+          work_group_size * sizeof(value_type) > device.local_memory_size() / 2){
+        work_group_size /= 2;
+    }
+
+    k.set_arg(tile_arg, local_buffer<value_type>(work_group_size));
+    k.set_arg(count_arg, static_cast<uint_>(count));
+    k.set_arg(init_arg, static_cast<result_type>(init));
+
+    const size_t work_groups = (count + work_group_size - 1) / work_group_size;
+    k.exec_1d(queue, 0, work_groups * work_group_size, work_group_size);
+
+    return result + static_cast<difference_type>(count);
+}
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_ALL_PAIRS_HPP
@@ -0,0 +1,608 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_AUTOTUNER_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_AUTOTUNER_HPP
+
+#include <ctime>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/shared_ptr.hpp>
+
+#if !defined(BOOST_NO_CXX11_HDR_CHRONO) && !defined(BOOST_NO_0X_HDR_CHRONO)
+#include <chrono>
+#endif
+
+#include <boost/compute/event.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/program.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/count_if.hpp>
+#include <boost/compute/algorithm/find_if.hpp>
+#include <boost/compute/algorithm/inclusive_scan.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/detail/binary_find.hpp>
+#include <boost/compute/algorithm/detail/radix_sort.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+namespace detail {
+
+struct autotune_reduce
+{
+    template<class Vector>
+    void operator()(Vector &input, command_queue &queue) const
+    {
+        typedef typename Vector::value_type T;
+
+        T result;
+        ::boost::compute::reduce(
+            input.begin(), input.end(), &result, max<T>(), queue
+        );
+    }
+};
+
+struct autotune_scan
+{
+    template<class Vector>
+    void operator()(Vector &input, command_queue &queue) const
+    {
+        ::boost::compute::inclusive_scan(
+            input.begin(), input.end(), input.begin(), queue
+        );
+    }
+};
+
+struct autotune_count_if
+{
+    template<class Vector>
+    void operator()(Vector &input, command_queue &queue) const
+    {
+        typedef typename Vector::value_type T;
+
+        using ::boost::compute::_1;
+
+        ::boost::compute::count_if(input.begin(), input.end(), _1 < T(1), queue);
+    }
+};
+
+struct autotune_binary_find
+{
+    template<class Vector>
+    void operator()(Vector &input, command_queue &queue) const
+    {
+        typedef typename Vector::value_type T;
+
+        using ::boost::compute::_1;
+
+        // input is sorted so binary_find() can be used
+        const T value = static_cast<T>(input.size() / 3);
+        ::boost::compute::detail::binary_find(
+            input.begin(), input.end(), _1 >= value, queue
+        );
+    }
+};
+
+struct autotune_task
+{
+    autotune_task(const kernel &kernel_)
+        : kernel(kernel_)
+    {
+    }
+
+    void operator()(command_queue &queue) const
+    {
+        queue.enqueue_task(kernel);
+    }
+
+    ::boost::compute::kernel kernel;
+};
+
+struct autotune_radix_sort
+{
+    template<class Vector>
+    void operator()(Vector &input, command_queue &queue) const
+    {
+        ::boost::compute::detail::radix_sort(input.begin(), input.end(), queue);
+    }
+};
+
+// sorts a copy of a host vector with sort()
+template<class T>
+struct autotune_host_sort
+{
+    autotune_host_sort(const std::vector<T> &input_, std::vector<T> &values_)
+        : input(&input_), values(&values_)
+    {
+    }
+
+    void operator()(command_queue &queue) const
+    {
+        *values = *input;
+        ::boost::compute::sort(values->begin(), values->end(), queue);
+    }
+
+    const std::vector<T> *input;
+    std::vector<T> *values;
+};
+
+} // end detail namespace
+
+/// \class autotuner
+/// \brief Tunes the parameters of the algorithms for a device.
+///
+/// Several algorithms pick work-group sizes and thresholds with
+/// heuristics. At dispatch time they look the values up in the parameter
+/// cache of the device and only fall back to the heuristics if no value
+/// was stored. The autotuner benchmarks candidate values for a parameter
+/// and stores the fastest one in the parameter cache.
+///
+/// When \c BOOST_COMPUTE_USE_OFFLINE_CACHE is defined the parameter cache
+/// is stored in the \c tune directory of the offline cache (one file per
+/// device and driver version) so the tuned values are loaded again by
+/// later runs.
+///
+/// \code
+/// boost::compute::experimental::autotuner tuner(queue);
+/// tuner.tune_all<int>(1 << 22);
+/// tuner.tune_all<float>(1 << 22);
+/// \endcode
+///
+/// The tuned parameters are:
+/// \li \c block_size of \c __boost_reduce_<type> (reduce() with functions
+///     other than \c plus)
+/// \li \c block_size of \c __boost_scan_<type> (largest scan work-group)
+/// \li \c serial_threshold of \c __boost_count_if (smallest range counted
+///     in parallel)
+/// \li \c threads of \c __boost_binary_find (work-items per search step of
+///     partition_point(), lower_bound() and upper_bound())
+/// \li \c k and \c block_size of \c __boost_radix_sort_<type>
+/// \li \c threshold of \c __boost_host_sort_<type> (largest host range
+///     sorted on the host by sort())
+/// \li \c launch_latency and \c serial_element_time of
+///     \c __boost_device_profile (used to choose between the serial and
+///     parallel versions of the algorithms)
+class autotuner
+{
+public:
+    /// Creates an autotuner which runs the benchmarks on \p queue. Each
+    /// candidate is timed \p trials times after one warmup run (which
+    /// compiles the programs) and scored with the median time.
+    explicit autotuner(const command_queue &queue, size_t trials = 5)
+        : m_queue(queue.get_context(),
+                  queue.get_device(),
+                  command_queue::enable_profiling),
+          m_trials(trials)
+    {
+        BOOST_ASSERT(trials > 0);
+    }
+
+    /// Destroys the autotuner.
+    ~autotuner()
+    {
+    }
+
+    /// Returns the command queue the benchmarks run on.
+    command_queue& get_queue()
+    {
+        return m_queue;
+    }
+
+    /// Sets \p parameter of \p object to each of the \p candidates, times
+    /// \p function (called with the command queue) and stores the fastest
+    /// candidate in the parameter cache.
+    ///
+    /// \return the fastest candidate
+    template<class Function>
+    uint_ tune(const std::string &object,
+               const std::string &parameter,
+               const std::vector<uint_> &candidates,
+               Function function)
+    {
+        BOOST_ASSERT(!candidates.empty());
+
+        boost::shared_ptr< ::boost::compute::detail::parameter_cache> parameters =
+            ::boost::compute::detail::parameter_cache::get_global_cache(
+                m_queue.get_device()
+            );
+
+        uint_ best = candidates.front();
+        double best_time = 0;
+        for(size_t i = 0; i < candidates.size(); i++){
+            parameters->set(object, parameter, candidates[i]);
+
+            const double time = measure(function);
+            if(i == 0 || time < best_time){
+                best = candidates[i];
+                best_time = time;
+            }
+        }
+
+        parameters->set(object, parameter, best);
+        parameters->flush();
+
+        return best;
+    }
+
+    /// Tunes the block size of reduce() for values of type \c T.
+    template<class T>
+    uint_ tune_reduce(size_t size)
+    {
+        return tune_with_input<T>(
+            std::string("__boost_reduce_") + type_name<T>(),
+            "block_size",
+            work_group_sizes(),
+            detail::autotune_reduce(),
+            size
+        );
+    }
+
+    /// Tunes the largest block size of the scan algorithms for values of
+    /// type \c T.
+    template<class T>
+    uint_ tune_scan(size_t size)
+    {
+        return tune_with_input<T>(
+            std::string("__boost_scan_") + type_name<T>(),
+            "block_size",
+            work_group_sizes(),
+            detail::autotune_scan(),
+            size
+        );
+    }
+
+    /// Tunes the threshold below which count_if() counts serially.
+    template<class T>
+    uint_ tune_count_if()
+    {
+        std::vector<uint_> candidates;
+        for(uint_ threshold = 16; threshold <= 4096; threshold *= 2){
+            candidates.push_back(threshold);
+        }
+
+        // time ranges just above each candidate threshold
+        boost::shared_ptr< ::boost::compute::detail::parameter_cache> parameters =
+            ::boost::compute::detail::parameter_cache::get_global_cache(
+                m_queue.get_device()
+            );
+
+        uint_ best = candidates.back();
+        for(size_t i = 0; i < candidates.size(); i++){
+            vector<T> input(candidates[i], m_queue.get_context());
+            ::boost::compute::iota(input.begin(), input.end(), T(0), m_queue);
+
+            // serial (threshold above the size) versus parallel
+            parameters->set("__boost_count_if", "serial_threshold", candidates[i] + 1);
+            const double serial = measure(bind_input(detail::autotune_count_if(), input));
+            parameters->set("__boost_count_if", "serial_threshold", 0);
+            const double parallel = measure(bind_input(detail::autotune_count_if(), input));
+
+            if(parallel < serial){
+                best = candidates[i];
+                break;
+            }
+        }
+
+        parameters->set("__boost_count_if", "serial_threshold", best);
+        parameters->flush();
+
+        return best;
+    }
+
+    /// Tunes the number of work-items per step of the binary search used
+    /// by partition_point(), lower_bound() and upper_bound().
+    template<class T>
+    uint_ tune_binary_find(size_t size)
+    {
+        std::vector<uint_> candidates;
+        for(uint_ threads = 32; threads <= 4096; threads *= 2){
+            candidates.push_back(threads);
+        }
+
+        vector<T> input(size, m_queue.get_context());
+        ::boost::compute::iota(input.begin(), input.end(), T(0), m_queue);
+
+        return tune(
+            "__boost_binary_find",
+            "threads",
+            candidates,
+            bind_input(detail::autotune_binary_find(), input)
+        );
+    }
+
+    /// Tunes the digit width and block size of radix sort for values of
+    /// type \c T.
+    template<class T>
+    void tune_radix_sort(size_t size)
+    {
+        const std::string object =
+            std::string("__boost_radix_sort_") + type_name<T>();
+
+        std::vector<uint_> digits;
+        digits.push_back(4);
+        digits.push_back(8);
+
+        tune_with_input<T>(object, "k", digits, detail::autotune_radix_sort(), size);
+        tune_with_input<T>(
+            object, "block_size", work_group_sizes(), detail::autotune_radix_sort(), size
+        );
+    }
+
+    /// Tunes the size below which sort() sorts host ranges of type \c T on
+    /// the host instead of the device. Both are timed on the host for
+    /// sizes from 2^10 to 2^22 values, the threshold is the first size
+    /// sorted faster by the device.
+    template<class T>
+    uint_ tune_host_sort()
+    {
+        const std::string object =
+            std::string("__boost_host_sort_") + type_name<T>();
+
+        boost::shared_ptr< ::boost::compute::detail::parameter_cache> parameters =
+            ::boost::compute::detail::parameter_cache::get_global_cache(
+                m_queue.get_device()
+            );
+
+        const uint_ max_size = 1 << 22;
+
+        uint_ best = max_size;
+        for(uint_ size = 1 << 10; size <= max_size; size *= 2){
+            std::vector<T> input(size);
+            for(size_t i = 0; i < input.size(); i++){
+                input[i] = static_cast<T>(std::rand());
+            }
+            std::vector<T> values;
+
+            parameters->set(object, "threshold", size + 1);
+            const double host =
+                measure_host(detail::autotune_host_sort<T>(input, values));
+            parameters->set(object, "threshold", 0);
+            const double device =
+                measure_host(detail::autotune_host_sort<T>(input, values));
+
+            if(device < host){
+                best = size;
+                break;
+            }
+        }
+
+        parameters->set(object, "threshold", best);
+        parameters->flush();
+
+        return best;
+    }
+
+    /// Measures the kernel launch latency and the time a single work-item
+    /// needs per element, which the algorithms use to decide whether small
+    /// inputs are processed serially.
+    void tune_device_profile()
+    {
+        const char source[] =
+            "__kernel void noop()\n"
+            "{\n"
+            "}\n"
+            "__kernel void serial_sum(__global const uint *input,\n"
+            "                         const uint n,\n"
+            "                         __global uint *result)\n"
+            "{\n"
+            "    uint sum = 0;\n"
+            "    for(uint i = 0; i < n; i++){\n"
+            "        sum += input[i];\n"
+            "    }\n"
+            "    *result = sum;\n"
+            "}\n";
+
+        program program =
+            program::create_with_source(source, m_queue.get_context());
+        program.build();
+
+        const uint_ n = 1 << 16;
+        vector<uint_> input(n, m_queue.get_context());
+        vector<uint_> result(1, m_queue.get_context());
+        ::boost::compute::iota(input.begin(), input.end(), uint_(0), m_queue);
+
+        kernel serial_sum = program.create_kernel("serial_sum");
+        serial_sum.set_arg(0, input.get_buffer());
+        serial_sum.set_arg(1, n);
+        serial_sum.set_arg(2, result.get_buffer());
+
+        const double latency =
+            measure(detail::autotune_task(program.create_kernel("noop")));
+        const double serial = measure(detail::autotune_task(serial_sum));
+        const double element_time = (serial - latency) / n;
+
+        boost::shared_ptr< ::boost::compute::detail::parameter_cache> parameters =
+            ::boost::compute::detail::parameter_cache::get_global_cache(
+                m_queue.get_device()
+            );
+
+        parameters->set(
+            "__boost_device_profile",
+            "launch_latency",
+            static_cast<uint_>((std::max)(latency, 1.0))
+        );
+        parameters->set(
+            "__boost_device_profile",
+            "serial_element_time",
+            static_cast<uint_>((std::max)(element_time + 0.5, 1.0))
+        );
+        parameters->flush();
+    }
+
+    /// Tunes all of the parameters for values of type \c T with inputs of
+    /// \p size values.
+    template<class T>
+    void tune_all(size_t size)
+    {
+        tune_device_profile();
+        tune_reduce<T>(size);
+        tune_scan<T>(size);
+        tune_count_if<T>();
+        tune_binary_find<T>(size);
+        tune_radix_sort<T>(size);
+        tune_host_sort<T>();
+    }
+
+private:
+    // calls a benchmark with a fixed input vector
+    template<class Function, class Vector>
+    struct input_binder
+    {
+        input_binder(Function function_, Vector &input_)
+            : function(function_), input(&input_)
+        {
+        }
+
+        void operator()(command_queue &queue) const
+        {
+            function(*input, queue);
+        }
+
+        Function function;
+        Vector *input;
+    };
+
+    template<class Function, class Vector>
+    static input_binder<Function, Vector> bind_input(Function function, Vector &input)
+    {
+        return input_binder<Function, Vector>(function, input);
+    }
+
+    template<class T, class Function>
+    uint_ tune_with_input(const std::string &object,
+                          const std::string &parameter,
+                          const std::vector<uint_> &candidates,
+                          Function function,
+                          size_t size)
+    {
+        vector<T> input(size, m_queue.get_context());
+        ::boost::compute::iota(input.begin(), input.end(), T(0), m_queue);
+
+        return tune(object, parameter, candidates, bind_input(function, input));
+    }
+
+    // powers of two from 32 up to the maximum work-group size
+    std::vector<uint_> work_group_sizes() const
+    {
+        const size_t max_size = m_queue.get_device().max_work_group_size();
+
+        std::vector<uint_> sizes;
+        for(size_t size = 32; size <= max_size && size <= 1024; size *= 2){
+            sizes.push_back(static_cast<uint_>(size));
+        }
+        if(sizes.empty()){
+            sizes.push_back(static_cast<uint_>(max_size));
+        }
+
+        return sizes;
+    }
+
+    // returns the median time in nanoseconds of the trials of function
+    // after a warmup run
+    template<class Function>
+    double measure(Function function)
+    {
+        function(m_queue);
+        m_queue.finish();
+
+        std::vector<double> times;
+        for(size_t trial = 0; trial < m_trials; trial++){
+            event start;
+            event end;
+
+            const std::clock_t host_start = std::clock();
+            m_queue.enqueue_marker(&start);
+            function(m_queue);
+            m_queue.enqueue_marker(&end);
+            m_queue.finish();
+            const std::clock_t host_end = std::clock();
+
+            const ulong_ device_start =
+                start.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_END);
+            const ulong_ device_end =
+                end.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_START);
+
+            if(device_start != 0 && device_end > device_start){
+                times.push_back(static_cast<double>(device_end - device_start));
+            }
+            else {
+                // some platforms do not time markers
+                times.push_back(
+                    static_cast<double>(host_end - host_start) * 1e9 / CLOCKS_PER_SEC
+                );
+            }
+        }
+
+        std::sort(times.begin(), times.end());
+
+        return times[times.size() / 2];
+    }
+
+    // returns the median wall-clock time in nanoseconds of the trials of
+    // function (including its work on the host) after a warmup run
+    template<class Function>
+    double measure_host(Function function)
+    {
+        function(m_queue);
+        m_queue.finish();
+
+        std::vector<double> times;
+        for(size_t trial = 0; trial < m_trials; trial++){
+            const double start = host_time();
+            function(m_queue);
+            m_queue.finish();
+            times.push_back(host_time() - start);
+        }
+
+        std::sort(times.begin(), times.end());
+
+        return times[times.size() / 2];
+    }
+
+    // returns the current host time in nanoseconds (the processor time
+    // without std::chrono)
+    static double host_time()
+    {
+    #if !defined(BOOST_NO_CXX11_HDR_CHRONO) && !defined(BOOST_NO_0X_HDR_CHRONO)
+        return static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+            ).count()
+        );
+    #else
+        return static_cast<double>(std::clock()) * 1e9 / CLOCKS_PER_SEC;
+    #endif
+    }
+
+private:
+    command_queue m_queue;
+    size_t m_trials;
+};
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_AUTOTUNER_HPP
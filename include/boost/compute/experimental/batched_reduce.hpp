@@ -0,0 +1,142 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_BATCHED_REDUCE_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_BATCHED_REDUCE_HPP
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+
+/// Reduces each of the segments of the range beginning at \p first with
+/// \p function in a single kernel launch and stores the result of segment
+/// \c i at \c result[i].
+///
+/// The segments are given by the host range of offsets [\p offsets_first,
+/// \p offsets_last): segment \c i is [\c first + \c offsets[i], \c first +
+/// \c offsets[i+1]). The result of an empty segment is not written.
+///
+/// This replaces many calls to reduce() for small ranges, each of which
+/// launches at least one kernel and reads back its result, with one
+/// launch using one work-group per segment. As with reduce(), \p function
+/// is assumed to be associative and commutative.
+///
+/// For example, to sum three rows of different lengths:
+/// \code
+/// uint_ offsets[] = { 0, 4, 5, 9 };
+/// experimental::batched_reduce(
+///     values.begin(), offsets, offsets + 4, sums.begin(), plus<int>(), queue
+/// );
+/// \endcode
+///
+/// \see reduce(), reduce_by_key()
+template<class InputIterator,
+         class OffsetIterator,
+         class OutputIterator,
+         class BinaryFunction>
+inline void batched_reduce(InputIterator first,
+                           OffsetIterator offsets_first,
+                           OffsetIterator offsets_last,
+                           OutputIterator result,
+                           BinaryFunction function,
+                           command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        boost::compute::result_of<BinaryFunction(value_type, value_type)>::type T;
+
+    const std::vector<uint_> offsets(offsets_first, offsets_last);
+    if(offsets.size() < 2){
+        return;
+    }
+    const size_t segments = offsets.size() - 1;
+
+    ::boost::compute::detail::scratch_vector<uint_> device_offsets(offsets.size(), queue);
+    queue.enqueue_write_buffer(
+        device_offsets.get_buffer(), 0, offsets.size() * sizeof(uint_), &offsets[0]
+    );
+
+    const size_t work_group_size =
+        (std::min)(size_t(128), queue.get_device().max_work_group_size());
+
+    ::boost::compute::detail::meta_kernel k("batched_reduce");
+    buffer_iterator<uint_> segment_offsets = device_offsets.begin();
+    k <<
+        "__local " << k.type<T>() << " scratch[" << work_group_size << "];\n" <<
+        "const uint segment = get_group_id(0);\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint begin = " << segment_offsets[k.var<uint_>("segment")] << ";\n" <<
+        "const uint end = " << segment_offsets[k.var<uint_>("segment + 1")] << ";\n" <<
+        "if(begin == end){\n" <<
+        "    return;\n" <<
+        "}\n" <<
+        "const uint active = min(end - begin, (uint) get_local_size(0));\n" <<
+
+        // each work-item reduces every local_size-th value of the segment
+        "if(lid < active){\n" <<
+        "    " << k.decl<T>("sum") << " = " << first[k.var<uint_>("begin + lid")] << ";\n" <<
+        "    for(uint i = begin + lid + get_local_size(0); i < end; i += get_local_size(0)){\n" <<
+        "        sum = " << function(k.var<T>("sum"), first[k.var<uint_>("i")]) << ";\n" <<
+        "    }\n" <<
+        "    scratch[lid] = sum;\n" <<
+        "}\n" <<
+
+        // reduce the sums of the work-items in local memory
+        "for(uint offset = 1; offset < active; offset <<= 1){\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    if((lid & ((offset << 1) - 1)) == 0 && lid + offset < active){\n" <<
+        "        scratch[lid] = " << function(k.var<T>("scratch[lid]"),
+                                              k.var<T>("scratch[lid+offset]")) << ";\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "if(lid == 0){\n" <<
+        "    " << result[k.var<uint_>("segment")] << " = scratch[0];\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    queue.enqueue_1d_range_kernel(
+        kernel, 0, segments * work_group_size, work_group_size
+    );
+}
+
+/// \overload
+template<class InputIterator, class OffsetIterator, class OutputIterator>
+inline void batched_reduce(InputIterator first,
+                           OffsetIterator offsets_first,
+                           OffsetIterator offsets_last,
+                           OutputIterator result,
+                           command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    ::boost::compute::experimental::batched_reduce(
+        first, offsets_first, offsets_last, result, plus<T>(), queue
+    );
+}
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_BATCHED_REDUCE_HPP
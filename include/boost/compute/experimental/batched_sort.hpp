@@ -0,0 +1,185 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_BATCHED_SORT_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_BATCHED_SORT_HPP
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+
+/// Sorts each of the segments of the range beginning at \p first according
+/// to \p compare.
+///
+/// The segments are given by the host range of offsets [\p offsets_first,
+/// \p offsets_last): segment \c i is [\c first + \c offsets[i], \c first +
+/// \c offsets[i+1]).
+///
+/// All of the segments which fit into local memory are sorted with one
+/// kernel launch using one work-group per segment (a bitonic sort in local
+/// memory). This replaces many calls to sort() for small ranges, each of
+/// which launches several kernels. Larger segments are sorted separately
+/// with sort().
+///
+/// \see sort()
+template<class Iterator, class OffsetIterator, class Compare>
+inline void batched_sort(Iterator first,
+                         OffsetIterator offsets_first,
+                         OffsetIterator offsets_last,
+                         Compare compare,
+                         command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+
+    const std::vector<uint_> offsets(offsets_first, offsets_last);
+    if(offsets.size() < 2){
+        return;
+    }
+    const size_t segments = offsets.size() - 1;
+
+    const device &device = queue.get_device();
+
+    // the largest power of two segment (with values and validity flags)
+    // which fits into local memory
+    const size_t local_capacity =
+        static_cast<size_t>(device.local_memory_size()) / (sizeof(T) + 1);
+    size_t max_local_size = 1;
+    while(max_local_size * 2 <= local_capacity){
+        max_local_size *= 2;
+    }
+
+    size_t largest = 0;
+    for(size_t i = 0; i < segments; i++){
+        const size_t size = offsets[i+1] - offsets[i];
+        if(size <= max_local_size){
+            largest = (std::max)(largest, size);
+        }
+    }
+
+    // padded size of the segments sorted in local memory
+    size_t padded = 1;
+    while(padded < largest){
+        padded *= 2;
+    }
+
+    if(largest > 1){
+        ::boost::compute::detail::scratch_vector<uint_> device_offsets(offsets.size(), queue);
+        queue.enqueue_write_buffer(
+            device_offsets.get_buffer(), 0, offsets.size() * sizeof(uint_), &offsets[0]
+        );
+        buffer_iterator<uint_> segment_offsets = device_offsets.begin();
+
+        const size_t work_group_size =
+            (std::min)(padded / 2, (std::min)(size_t(256), device.max_work_group_size()));
+
+        ::boost::compute::detail::meta_kernel k("batched_sort");
+        k <<
+            "__local " << k.type<T>() << " keys[" << padded << "];\n" <<
+            "__local uchar valid[" << padded << "];\n" <<
+            "const uint segment = get_group_id(0);\n" <<
+            "const uint lid = get_local_id(0);\n" <<
+            "const uint begin = " << segment_offsets[k.var<uint_>("segment")] << ";\n" <<
+            "const uint n = " << segment_offsets[k.var<uint_>("segment + 1")] << " - begin;\n" <<
+            "if(n < 2 || n > " << padded << "){\n" <<
+            "    return;\n" <<
+            "}\n" <<
+
+            // load the segment, the padding compares greater than any value
+            "for(uint i = lid; i < " << padded << "; i += get_local_size(0)){\n" <<
+            "    valid[i] = i < n;\n" <<
+            "    if(i < n){\n" <<
+            "        keys[i] = " << first[k.var<uint_>("begin + i")] << ";\n" <<
+            "    }\n" <<
+            "}\n" <<
+            "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+
+            "for(uint size = 2; size <= " << padded << "; size <<= 1){\n" <<
+            "    for(uint stride = size >> 1; stride > 0; stride >>= 1){\n" <<
+            "        for(uint i = lid; i < " << padded << "; i += get_local_size(0)){\n" <<
+            "            const uint j = i ^ stride;\n" <<
+            "            if(j > i){\n" <<
+            "                const bool vi = valid[i];\n" <<
+            "                const bool vj = valid[j];\n" <<
+            "                const bool ascending = (i & size) == 0;\n" <<
+            "                bool swap;\n" <<
+            "                if(vi && vj){\n" <<
+            "                    swap = ascending ?\n" <<
+            "                        " << compare(k.var<T>("keys[j]"), k.var<T>("keys[i]")) << " :\n" <<
+            "                        " << compare(k.var<T>("keys[i]"), k.var<T>("keys[j]")) << ";\n" <<
+            "                }\n" <<
+            "                else {\n" <<
+            "                    swap = ascending ? (!vi && vj) : (vi && !vj);\n" <<
+            "                }\n" <<
+            "                if(swap){\n" <<
+            "                    " << k.decl<T>("key") << " = keys[i];\n" <<
+            "                    keys[i] = keys[j];\n" <<
+            "                    keys[j] = key;\n" <<
+            "                    valid[i] = vj;\n" <<
+            "                    valid[j] = vi;\n" <<
+            "                }\n" <<
+            "            }\n" <<
+            "        }\n" <<
+            "        barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+            "    }\n" <<
+            "}\n" <<
+
+            "for(uint i = lid; i < n; i += get_local_size(0)){\n" <<
+            "    " << first[k.var<uint_>("begin + i")] << " = keys[i];\n" <<
+            "}\n";
+
+        kernel kernel = k.compile(queue.get_context());
+        queue.enqueue_1d_range_kernel(
+            kernel, 0, segments * work_group_size, work_group_size
+        );
+    }
+
+    // sort the segments which do not fit into local memory
+    for(size_t i = 0; i < segments; i++){
+        if(offsets[i+1] - offsets[i] > max_local_size){
+            ::boost::compute::sort(
+                first + offsets[i], first + offsets[i+1], compare, queue
+            );
+        }
+    }
+}
+
+/// \overload
+template<class Iterator, class OffsetIterator>
+inline void batched_sort(Iterator first,
+                         OffsetIterator offsets_first,
+                         OffsetIterator offsets_last,
+                         command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+
+    ::boost::compute::experimental::batched_sort(
+        first, offsets_first, offsets_last, less<T>(), queue
+    );
+}
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_BATCHED_SORT_HPP
@@ -0,0 +1,359 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_BREADTH_FIRST_SEARCH_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_BREADTH_FIRST_SEARCH_HPP
+
+#include <algorithm>
+
+#include <boost/assert.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/container/dynamic_bitset.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/work_queue.hpp>
+#include <boost/compute/iterator/counting_iterator.hpp>
+#include <boost/compute/linear_algebra/csr_matrix.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+
+/// The distance stored by breadth_first_search() for the vertices which
+/// are not reachable from the source.
+const uint_ bfs_unreached = 0xFFFFFFFF;
+
+/// The strategies for the levels of breadth_first_search().
+enum bfs_direction {
+    /// Every level expands the edges of the frontier.
+    bfs_top_down,
+    /// Levels with a large frontier are searched bottom-up from the
+    /// unvisited vertices. Requires a symmetric (undirected) graph.
+    bfs_direction_optimizing
+};
+
+namespace detail {
+
+using ::boost::compute::detail::meta_kernel;
+
+// the test whether a vertex was reached at a level, used to compact the
+// frontier after a bottom-up level
+template<class Arg>
+struct invoked_bfs_reached_at_level
+{
+    invoked_bfs_reached_at_level(const buffer &distances_,
+                                 uint_ level_,
+                                 const Arg &vertex_)
+        : distances(distances_),
+          level(level_),
+          vertex(vertex_)
+    {
+    }
+
+    buffer distances;
+    uint_ level;
+    Arg vertex;
+};
+
+template<class Arg>
+inline meta_kernel& operator<<(meta_kernel &k,
+                               const invoked_bfs_reached_at_level<Arg> &expr)
+{
+    return k << "(" << k.get_buffer_identifier<uint_>(expr.distances) <<
+                "[" << expr.vertex << "] == " << expr.level << ")";
+}
+
+struct bfs_reached_at_level
+{
+    typedef bool result_type;
+
+    bfs_reached_at_level(const buffer &distances_, uint_ level_)
+        : distances(distances_),
+          level(level_)
+    {
+    }
+
+    template<class Arg>
+    invoked_bfs_reached_at_level<Arg> operator()(const Arg &arg) const
+    {
+        return invoked_bfs_reached_at_level<Arg>(distances, level, arg);
+    }
+
+    buffer distances;
+    uint_ level;
+};
+
+// the number of edges of vertex
+template<class T>
+inline uint_ bfs_degree(const csr_matrix<T> &graph,
+                        uint_ vertex,
+                        command_queue &queue)
+{
+    const buffer &offsets = graph.row_offsets().get_buffer();
+
+    return ::boost::compute::detail::read_single_value<uint_>(offsets, vertex + 1, queue) -
+           ::boost::compute::detail::read_single_value<uint_>(offsets, vertex, queue);
+}
+
+// expands the frontier top-down with one work-item per frontier vertex.
+// each unvisited neighbor is claimed with an atomic_or() on its block of
+// the visited set, so the work-item setting the bit is the only one
+// pushing it to next. if distances is not null the claimed neighbors are
+// at level + 1 and if edges is not null the number of their edges is
+// added to it.
+template<class T>
+inline void bfs_expand_top_down(const csr_matrix<T> &graph,
+                                const work_queue<uint_> &frontier,
+                                size_t frontier_size,
+                                dynamic_bitset<uint_> &visited,
+                                vector<uint_> *distances,
+                                uint_ level,
+                                const buffer *edges,
+                                work_queue<uint_> &next,
+                                command_queue &queue)
+{
+    if(frontier_size == 0){
+        return;
+    }
+
+    const vector<uint_> &offsets = graph.row_offsets();
+    const vector<uint_> &columns = graph.columns();
+
+    meta_kernel k("bfs_expand_top_down");
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t level_arg = k.add_arg<const uint_>("level");
+    const std::string visited_blocks =
+        k.get_buffer_identifier<uint_>(visited.get_buffer());
+
+    k <<
+        "const uint i = get_global_id(0);\n" <<
+        "if(i >= count){\n" <<
+        "    return;\n" <<
+        "}\n" <<
+        "const uint v = " << frontier.begin()[k.var<uint_>("i")] << ";\n" <<
+        "const uint end = " << offsets.begin()[k.expr<uint_>("v + 1")] << ";\n" <<
+        "for(uint e = " << offsets.begin()[k.var<uint_>("v")] << "; e < end; e++){\n" <<
+        "    const uint u = " << columns.begin()[k.var<uint_>("e")] << ";\n" <<
+        "    const uint mask = 1u << (u & 31);\n" <<
+        "    __global uint *block = " << visited_blocks << " + (u >> 5);\n" <<
+        "    if((*block & mask) == 0 && (atomic_or(block, mask) & mask) == 0){\n";
+    if(distances){
+        k <<
+        "        " << distances->begin()[k.var<uint_>("u")] << " = level + 1;\n";
+    }
+    if(edges){
+        k <<
+        "        atomic_add(" << k.get_buffer_identifier<uint_>(*edges) << ", " <<
+                     offsets.begin()[k.expr<uint_>("u + 1")] << " - " <<
+                     offsets.begin()[k.var<uint_>("u")] << ");\n";
+    }
+    k <<
+        "        " << next.pusher()(k.var<uint_>("u")) << ";\n" <<
+        "    }\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(count_arg, static_cast<uint_>(frontier_size));
+    kernel.set_arg(level_arg, level);
+
+    queue.enqueue_1d_range_kernel(kernel, 0, frontier_size, 0);
+}
+
+// searches level + 1 bottom-up with one work-item per vertex. each
+// unvisited vertex scans its edges for a parent at level and stops at the
+// first one, so a vertex is only written by its own work-item.
+template<class T>
+inline void bfs_expand_bottom_up(const csr_matrix<T> &graph,
+                                 dynamic_bitset<uint_> &visited,
+                                 vector<uint_> &distances,
+                                 uint_ level,
+                                 command_queue &queue)
+{
+    const vector<uint_> &offsets = graph.row_offsets();
+    const vector<uint_> &columns = graph.columns();
+
+    meta_kernel k("bfs_expand_bottom_up");
+    size_t level_arg = k.add_arg<const uint_>("level");
+    const std::string visited_blocks =
+        k.get_buffer_identifier<uint_>(visited.get_buffer());
+
+    k <<
+        "const uint v = get_global_id(0);\n" <<
+        "const uint mask = 1u << (v & 31);\n" <<
+        "if((" << visited_blocks << "[v >> 5] & mask) != 0){\n" <<
+        "    return;\n" <<
+        "}\n" <<
+        "const uint end = " << offsets.begin()[k.expr<uint_>("v + 1")] << ";\n" <<
+        "for(uint e = " << offsets.begin()[k.var<uint_>("v")] << "; e < end; e++){\n" <<
+        "    const uint u = " << columns.begin()[k.var<uint_>("e")] << ";\n" <<
+        "    if(" << distances.begin()[k.var<uint_>("u")] << " == level){\n" <<
+        "        " << distances.begin()[k.var<uint_>("v")] << " = level + 1;\n" <<
+        "        atomic_or(&" << visited_blocks << "[v >> 5], mask);\n" <<
+        "        break;\n" <<
+        "    }\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(level_arg, level);
+
+    queue.enqueue_1d_range_kernel(kernel, 0, graph.rows(), 0);
+}
+
+} // end detail namespace
+
+/// Expands the \p frontier of a traversal of \p graph (an adjacency matrix
+/// in CSR format) by one level. Each neighbor of a vertex in \p frontier
+/// which is not set in \p visited is set in it and pushed once to
+/// \p next. The values of \p graph are not used.
+///
+/// \p visited must have a bit for each vertex and \p next must have room
+/// for the unvisited vertices (e.g. a capacity of \c graph.rows()).
+///
+/// \see breadth_first_search()
+template<class T>
+inline void expand_frontier(const csr_matrix<T> &graph,
+                            const work_queue<uint_> &frontier,
+                            dynamic_bitset<uint_> &visited,
+                            work_queue<uint_> &next,
+                            command_queue &queue = system::default_queue())
+{
+    BOOST_ASSERT(visited.size() >= graph.rows());
+
+    detail::bfs_expand_top_down(
+        graph, frontier, frontier.size(queue), visited, 0, 0, 0, next, queue
+    );
+}
+
+/// Computes the number of edges on the shortest path from \p source to
+/// each vertex of \p graph (an adjacency matrix in CSR format) with a
+/// breadth-first search, and stores them in \p distances. Vertices which
+/// are not reachable from \p source are set to \c bfs_unreached. Returns
+/// the number of levels of the search (one more than the largest
+/// distance).
+///
+/// The frontier of each level is kept in a work_queue and the visited
+/// vertices in a dynamic_bitset on the device, so each level only reads
+/// the size of the next frontier (and the number of its edges) back to
+/// the host.
+///
+/// With \c bfs_direction_optimizing the search switches to a bottom-up
+/// search, in which the unvisited vertices look for a parent in the
+/// frontier, once the edges of the frontier exceed a fraction of the
+/// unexplored edges, and back to the top-down search once the frontier
+/// becomes small again. This skips most edges of the levels reaching
+/// most of the graph, but requires \p graph to be symmetric.
+///
+/// \see expand_frontier()
+template<class T>
+inline size_t breadth_first_search(const csr_matrix<T> &graph,
+                                   uint_ source,
+                                   vector<uint_> &distances,
+                                   bfs_direction direction,
+                                   command_queue &queue = system::default_queue())
+{
+    const size_t n = graph.rows();
+    distances.resize(n, queue);
+    if(n == 0){
+        return 0;
+    }
+    BOOST_ASSERT(source < n);
+
+    ::boost::compute::fill(distances.begin(), distances.end(), bfs_unreached, queue);
+    ::boost::compute::detail::write_single_value<uint_>(
+        0, distances.get_buffer(), source, queue
+    );
+
+    dynamic_bitset<uint_> visited(n, queue);
+    visited.set(source, queue);
+
+    work_queue<uint_> frontier(n, queue);
+    work_queue<uint_> next(n, queue);
+    frontier.push(
+        counting_iterator<uint_>(source), counting_iterator<uint_>(source + 1), queue
+    );
+
+    // the edges of the frontier found by the top-down levels
+    vector<uint_> edges(1, queue.get_context());
+
+    // the switching thresholds of the direction-optimizing search
+    const size_t edge_ratio = 14;
+    const size_t vertex_ratio = 24;
+
+    size_t frontier_size = 1;
+    size_t frontier_edges = detail::bfs_degree(graph, source, queue);
+    size_t unexplored_edges = graph.nonzeros();
+    bool bottom_up = false;
+    bool may_switch = direction == bfs_direction_optimizing;
+
+    uint_ level = 0;
+    while(frontier_size > 0){
+        if(may_switch && !bottom_up &&
+           frontier_edges > unexplored_edges / edge_ratio){
+            bottom_up = true;
+        }
+        else if(bottom_up && frontier_size < n / vertex_ratio){
+            bottom_up = false;
+            may_switch = false;
+        }
+
+        next.clear(queue);
+        if(bottom_up){
+            detail::bfs_expand_bottom_up(graph, visited, distances, level, queue);
+
+            next.push_if(
+                counting_iterator<uint_>(0),
+                counting_iterator<uint_>(static_cast<uint_>(n)),
+                detail::bfs_reached_at_level(distances.get_buffer(), level + 1),
+                queue
+            );
+        }
+        else {
+            ::boost::compute::fill(edges.begin(), edges.end(), uint_(0), queue);
+
+            detail::bfs_expand_top_down(
+                graph, frontier, frontier_size, visited, &distances, level,
+                &edges.get_buffer(), next, queue
+            );
+
+            unexplored_edges -= (std::min)(frontier_edges, unexplored_edges);
+            frontier_edges = ::boost::compute::detail::read_single_value<uint_>(
+                edges.get_buffer(), queue
+            );
+        }
+
+        frontier.swap(next);
+        frontier_size = frontier.size(queue);
+        level++;
+    }
+
+    return level;
+}
+
+/// \overload
+template<class T>
+inline size_t breadth_first_search(const csr_matrix<T> &graph,
+                                   uint_ source,
+                                   vector<uint_> &distances,
+                                   command_queue &queue = system::default_queue())
+{
+    return breadth_first_search(graph, source, distances, bfs_top_down, queue);
+}
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_BREADTH_FIRST_SEARCH_HPP
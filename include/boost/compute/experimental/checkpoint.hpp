@@ -0,0 +1,614 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_CHECKPOINT_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_CHECKPOINT_HPP
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/mpl/bool.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/utility/wait_list.hpp>
+#include <boost/compute/utility/mapped_file.hpp>
+#include <boost/compute/experimental/compression.hpp>
+#include <boost/compute/detail/staging_ring.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+#if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+
+namespace boost {
+namespace compute {
+namespace experimental {
+
+/// Options of checkpoint_writer::save().
+enum checkpoint_flags {
+    /// The values are copied to a snapshot buffer on the compute queue and
+    /// stored as is.
+    checkpoint_default = 0,
+    /// The values are read from the range itself, which must not be
+    /// modified until the checkpoint is written.
+    checkpoint_no_snapshot = 1,
+    /// The values of 32-bit integer ranges are stored delta encoded and
+    /// bit packed (see delta_encode() and bit_pack()). Other ranges are
+    /// stored as is.
+    checkpoint_compress = 2
+};
+
+namespace detail {
+
+// the fixed-size header at the start of each checkpoint file
+struct checkpoint_header
+{
+    char magic[8];
+    uint_ version;
+    uint_ value_size;
+    ulong_ count;
+    uint_ encoding;
+    uint_ bits;
+};
+
+enum checkpoint_encoding {
+    checkpoint_raw = 0,
+    checkpoint_delta_packed = 1
+};
+
+// meta-function returning true if ranges of T can be stored compressed
+template<class T>
+struct is_checkpoint_compressible
+    : public boost::mpl::bool_<
+          boost::is_integral<T>::value && sizeof(T) == sizeof(uint_)
+      > {};
+
+inline checkpoint_header make_checkpoint_header(size_t value_size,
+                                                size_t count,
+                                                uint_ encoding,
+                                                size_t bits)
+{
+    checkpoint_header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "BCCKPT", 7);
+    header.version = 1;
+    header.value_size = static_cast<uint_>(value_size);
+    header.count = count;
+    header.encoding = encoding;
+    header.bits = static_cast<uint_>(bits);
+    return header;
+}
+
+// reads and validates the header of the checkpoint file at path
+inline checkpoint_header read_checkpoint_header(const mapped_file<unsigned char> &file,
+                                                const std::string &path)
+{
+    checkpoint_header header;
+    if(file.size() < sizeof(header)){
+        BOOST_THROW_EXCEPTION(std::runtime_error(path + " is not a checkpoint"));
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if(std::memcmp(header.magic, "BCCKPT", 7) != 0 || header.version != 1){
+        BOOST_THROW_EXCEPTION(std::runtime_error(path + " is not a checkpoint"));
+    }
+
+    // the deltas are packed in at most 32 bits each
+    if(header.encoding != checkpoint_raw &&
+       (header.encoding != checkpoint_delta_packed || header.bits > 32)){
+        BOOST_THROW_EXCEPTION(std::runtime_error(path + " is not a checkpoint"));
+    }
+
+    const ulong_ bytes = header.encoding == checkpoint_raw ?
+        header.count * header.value_size :
+        ulong_(packed_size(static_cast<size_t>(header.count), header.bits)) * sizeof(uint_);
+    if(file.size() - sizeof(header) < bytes){
+        BOOST_THROW_EXCEPTION(std::runtime_error(path + " is truncated"));
+    }
+
+    return header;
+}
+
+// the file and source buffer of a checkpoint being written. the state is
+// shared by the callbacks of the chunks, the last one to finish destroys
+// it, which unmaps the file and completes the checkpoint.
+class checkpoint_state : boost::noncopyable
+{
+public:
+    checkpoint_state(const std::string &path,
+                     size_t size,
+                     const buffer &source,
+                     const user_event &done)
+        : m_file(new mapped_file<unsigned char>(path, size)),
+          m_source(source),
+          m_done(done)
+    {
+    }
+
+    ~checkpoint_state()
+    {
+        m_file.reset();
+        m_done.set_status(CL_COMPLETE);
+    }
+
+    unsigned char* data() const
+    {
+        return m_file->data();
+    }
+
+private:
+    boost::scoped_ptr<mapped_file<unsigned char> > m_file;
+    buffer m_source;
+    user_event m_done;
+};
+
+// copies a chunk read into a staging slot to its place in the file. the
+// chunks are written at their own offsets so the order in which the
+// callbacks run does not matter.
+struct checkpoint_chunk_copy
+{
+    checkpoint_chunk_copy(const boost::shared_ptr<checkpoint_state> &state_,
+                          const void *slot_,
+                          size_t offset_,
+                          size_t size_,
+                          const user_event &written_)
+        : state(state_),
+          slot(slot_),
+          offset(offset_),
+          size(size_),
+          written(written_)
+    {
+    }
+
+    void operator()() const
+    {
+        std::memcpy(state->data() + offset, slot, size);
+        written.set_status(CL_COMPLETE);
+    }
+
+    boost::shared_ptr<checkpoint_state> state;
+    const void *slot;
+    size_t offset;
+    size_t size;
+    user_event written;
+};
+
+// returns true if the checkpoint completed by done is written
+inline bool checkpoint_saved(const event &done)
+{
+    return done.status() == CL_COMPLETE;
+}
+
+} // end detail namespace
+
+/// \class checkpoint_writer
+/// \brief Stores device ranges to files (and restores them) without
+///        stalling the compute queue.
+///
+/// save() enqueues a snapshot of the range on the compute queue and
+/// returns immediately. The snapshot is read back in chunks through a ring
+/// of pinned staging buffers on a second queue (of the same device) and
+/// each chunk is copied to the file from an event callback while the next
+/// chunks are transferred. Kernels enqueued to the compute queue after
+/// save() run while the checkpoint is written: only the snapshot copy is
+/// ordered with them.
+///
+/// \code
+/// boost::compute::experimental::checkpoint_writer writer(queue);
+///
+/// for(size_t step = 0; step < steps; step++){
+///     simulate(state, queue);
+///
+///     if(step % 1000 == 0){
+///         writer.save(state.begin(), state.end(), "state.bin");
+///     }
+/// }
+/// writer.wait();
+/// \endcode
+///
+/// restore() reads the file in chunks into the staging buffers and
+/// uploads each chunk while the next one is read. The commands enqueued to
+/// the compute queue after restore() see the restored values.
+///
+/// With \ref checkpoint_compress the values of 32-bit integer ranges are
+/// delta encoded and bit packed on the device before they are read back,
+/// which reads the width of the deltas back to the host first.
+///
+/// A checkpoint_writer may not be used by several threads at once.
+///
+/// \see mapped_file, delta_encode(), bit_pack()
+class checkpoint_writer : boost::noncopyable
+{
+public:
+    /// Creates a checkpoint writer for the ranges used by \p queue. The
+    /// files are transferred in chunks of \p chunk_size bytes through
+    /// \p slot_count pinned staging buffers.
+    explicit checkpoint_writer(command_queue &queue = system::default_queue(),
+                               size_t chunk_size = default_chunk_size(),
+                               size_t slot_count = default_slot_count())
+        : m_queue(queue),
+          m_transfer_queue(queue.get_context(), queue.get_device()),
+          m_ring(m_transfer_queue, chunk_size, slot_count),
+          m_slot_events(slot_count),
+          m_next_slot(0)
+    {
+        for(size_t i = 0; i < slot_count; i++){
+            m_pointers.push_back(m_ring.acquire(i));
+        }
+    }
+
+    /// Waits for the checkpoints being written and destroys the writer.
+    ~checkpoint_writer()
+    {
+        wait();
+    }
+
+    /// Returns the default size of the chunks (4 MB).
+    static size_t default_chunk_size()
+    {
+        return size_t(4) << 20;
+    }
+
+    /// Returns the default number of staging buffers.
+    static size_t default_slot_count()
+    {
+        return 4;
+    }
+
+    /// Returns the compute queue.
+    const command_queue& get_queue() const
+    {
+        return m_queue;
+    }
+
+    /// Returns the queue transferring the checkpoints.
+    const command_queue& get_transfer_queue() const
+    {
+        return m_transfer_queue;
+    }
+
+    /// Enqueues a checkpoint of the values in the range [\p first,
+    /// \p last) to the file at \p path (which is replaced) and returns a
+    /// future which is ready when the file is written.
+    ///
+    /// Throws \c std::runtime_error if the file can not be created.
+    ///
+    /// \see checkpoint_flags
+    template<class T>
+    future<void> save(const buffer_iterator<T> &first,
+                      const buffer_iterator<T> &last,
+                      const std::string &path,
+                      int flags = checkpoint_default)
+    {
+        const size_t count =
+            ::boost::compute::detail::iterator_range_size(first, last);
+
+        return save(
+            first, count, path, flags, detail::is_checkpoint_compressible<T>()
+        );
+    }
+
+    /// Restores the values stored with save() in the file at \p path to
+    /// the range beginning at \p result, which must hold
+    /// checkpoint_size(\p path) values. Returns a future for the last
+    /// command of the restore.
+    ///
+    /// Throws \c std::runtime_error if the file can not be opened or is
+    /// not a checkpoint of values of the size of \c T.
+    template<class T>
+    future<void> restore(const std::string &path, const buffer_iterator<T> &result)
+    {
+        mapped_file<unsigned char> file(path);
+        const detail::checkpoint_header header =
+            detail::read_checkpoint_header(file, path);
+        if(header.value_size != sizeof(T)){
+            BOOST_THROW_EXCEPTION(
+                std::runtime_error(path + " stores values of a different size")
+            );
+        }
+
+        const size_t count = static_cast<size_t>(header.count);
+        if(count == 0){
+            return future<void>();
+        }
+
+        const unsigned char *values = file.data() + sizeof(header);
+        if(header.encoding == detail::checkpoint_raw){
+            const event uploaded = upload(
+                values,
+                count * sizeof(T),
+                result.get_buffer(),
+                result.get_index() * sizeof(T)
+            );
+            wait_for_transfer(uploaded);
+
+            return future<void>(uploaded);
+        }
+
+        return restore_packed(
+            header, values, result, detail::is_checkpoint_compressible<T>(), path
+        );
+    }
+
+    /// Waits for the checkpoints being written (until their files are
+    /// complete and closed) and the restores being uploaded.
+    void wait()
+    {
+        for(size_t i = 0; i < m_slot_events.size(); i++){
+            if(m_slot_events[i].get()){
+                m_slot_events[i].wait();
+                m_slot_events[i] = event();
+            }
+        }
+        m_transfer_queue.finish();
+
+        // the last chunk of a checkpoint completes it after its copy
+        for(size_t i = 0; i < m_saves.size(); i++){
+            m_saves[i].wait();
+        }
+        m_saves.clear();
+    }
+
+private:
+    template<class T>
+    future<void> save(const buffer_iterator<T> &first,
+                      size_t count,
+                      const std::string &path,
+                      int flags,
+                      boost::mpl::true_)
+    {
+        if(!(flags & checkpoint_compress) || count == 0){
+            return save(first, count, path, flags, boost::mpl::false_());
+        }
+
+        const context &context = m_queue.get_context();
+
+        ::boost::compute::detail::scratch_vector<uint_> deltas(count, m_queue);
+        delta_encode(first, first + count, deltas.begin(), m_queue);
+
+        const size_t bits = bit_width(deltas.begin(), deltas.end(), m_queue);
+        const size_t words = packed_size(count, bits);
+
+        buffer packed(context, words * sizeof(uint_));
+        bit_pack(
+            deltas.begin(), deltas.end(), bits,
+            make_buffer_iterator<uint_>(packed), m_queue
+        );
+
+        return write_chunks(
+            detail::make_checkpoint_header(
+                sizeof(T), count, detail::checkpoint_delta_packed, bits
+            ),
+            packed, 0, words * sizeof(uint_), path
+        );
+    }
+
+    template<class T>
+    future<void> save(const buffer_iterator<T> &first,
+                      size_t count,
+                      const std::string &path,
+                      int flags,
+                      boost::mpl::false_)
+    {
+        const size_t bytes = count * sizeof(T);
+
+        buffer source = first.get_buffer();
+        size_t offset = first.get_index() * sizeof(T);
+        if(!(flags & checkpoint_no_snapshot) && bytes > 0){
+            buffer snapshot(m_queue.get_context(), bytes);
+            m_queue.enqueue_copy_buffer(source, snapshot, offset, 0, bytes);
+            source = snapshot;
+            offset = 0;
+        }
+
+        return write_chunks(
+            detail::make_checkpoint_header(sizeof(T), count, detail::checkpoint_raw, 0),
+            source, offset, bytes, path
+        );
+    }
+
+    // creates the file and enqueues the reads of the bytes at offset in
+    // source after the commands already enqueued to the compute queue
+    future<void> write_chunks(const detail::checkpoint_header &header,
+                              const buffer &source,
+                              size_t offset,
+                              size_t bytes,
+                              const std::string &path)
+    {
+        const context &context = m_queue.get_context();
+
+        // forget the checkpoints completed already
+        std::vector<event>::iterator completed = std::remove_if(
+            m_saves.begin(), m_saves.end(), detail::checkpoint_saved
+        );
+        m_saves.erase(completed, m_saves.end());
+
+        user_event done(context);
+        m_saves.push_back(done);
+        boost::shared_ptr<detail::checkpoint_state> state =
+            boost::make_shared<detail::checkpoint_state>(
+                path, sizeof(header) + bytes, source, done
+            );
+        std::memcpy(state->data(), &header, sizeof(header));
+
+        event ready;
+        if(bytes > 0){
+            m_queue.enqueue_marker(&ready);
+            m_queue.flush();
+        }
+
+        const size_t chunk_size = m_ring.chunk_size();
+        for(size_t i = 0; i < bytes; i += chunk_size){
+            const size_t n = (std::min)(chunk_size, bytes - i);
+            const size_t slot = next_slot();
+
+            // the slot is reused once its previous chunk was copied out
+            wait_list events(ready);
+            if(m_slot_events[slot].get()){
+                events.insert(m_slot_events[slot]);
+            }
+
+            event read = m_transfer_queue.enqueue_read_buffer_async(
+                source, offset + i, n, m_pointers[slot], events
+            );
+
+            user_event written(context);
+            read.set_callback(
+                detail::checkpoint_chunk_copy(
+                    state, m_pointers[slot], sizeof(header) + i, n, written
+                )
+            );
+            m_slot_events[slot] = written;
+        }
+        m_transfer_queue.flush();
+
+        // completes the checkpoint now if it has no chunks
+        state.reset();
+
+        return future<void>(done);
+    }
+
+    // uploads the bytes at values to offset in result in chunks after the
+    // commands already enqueued to the compute queue, each chunk is copied
+    // to a staging slot while the previous ones are transferred
+    event upload(const unsigned char *values,
+                 size_t bytes,
+                 const buffer &result,
+                 size_t offset)
+    {
+        event ready;
+        m_queue.enqueue_marker(&ready);
+        m_queue.flush();
+
+        event last;
+
+        const size_t chunk_size = m_ring.chunk_size();
+        for(size_t i = 0; i < bytes; i += chunk_size){
+            const size_t n = (std::min)(chunk_size, bytes - i);
+            const size_t slot = next_slot();
+
+            if(m_slot_events[slot].get()){
+                m_slot_events[slot].wait();
+            }
+            std::memcpy(m_pointers[slot], values + i, n);
+
+            last = m_transfer_queue.enqueue_write_buffer_async(
+                result, offset + i, n, m_pointers[slot], wait_list(ready)
+            );
+            m_transfer_queue.flush();
+            m_slot_events[slot] = last;
+        }
+
+        return last;
+    }
+
+    template<class T>
+    future<void> restore_packed(const detail::checkpoint_header &header,
+                                const unsigned char *values,
+                                const buffer_iterator<T> &result,
+                                boost::mpl::true_,
+                                const std::string &)
+    {
+        const size_t count = static_cast<size_t>(header.count);
+        const size_t words = packed_size(count, header.bits);
+
+        ::boost::compute::detail::scratch_vector<uint_> packed(words, m_queue);
+        wait_for_transfer(
+            upload(values, words * sizeof(uint_), packed.get_buffer(), 0)
+        );
+
+        ::boost::compute::detail::scratch_vector<uint_> deltas(count, m_queue);
+        bit_unpack(packed.begin(), count, header.bits, deltas.begin(), m_queue);
+        delta_decode(deltas.begin(), deltas.end(), result, m_queue);
+
+        event decoded;
+        m_queue.enqueue_marker(&decoded);
+        return future<void>(decoded);
+    }
+
+    template<class T>
+    future<void> restore_packed(const detail::checkpoint_header &,
+                                const unsigned char *,
+                                const buffer_iterator<T> &,
+                                boost::mpl::false_,
+                                const std::string &path)
+    {
+        BOOST_THROW_EXCEPTION(
+            std::runtime_error(path + " stores compressed integer values")
+        );
+        return future<void>();
+    }
+
+    // orders the commands enqueued to the compute queue after the transfer
+    void wait_for_transfer(const event &transfer)
+    {
+        #ifdef CL_VERSION_1_2
+        if(m_queue.get_version() >= 120){
+            m_queue.enqueue_barrier(wait_list(transfer));
+            return;
+        }
+        #endif // CL_VERSION_1_2
+
+        transfer.wait();
+    }
+
+    size_t next_slot()
+    {
+        const size_t slot = m_next_slot;
+        m_next_slot = (m_next_slot + 1) % m_pointers.size();
+        return slot;
+    }
+
+private:
+    command_queue m_queue;
+    command_queue m_transfer_queue;
+    ::boost::compute::detail::staging_ring m_ring;
+    std::vector<void *> m_pointers;
+    std::vector<event> m_slot_events;
+    std::vector<event> m_saves;
+    size_t m_next_slot;
+};
+
+/// Returns the number of values stored in the checkpoint file at \p path.
+///
+/// Throws \c std::runtime_error if the file can not be opened or is not a
+/// checkpoint.
+inline size_t checkpoint_size(const std::string &path)
+{
+    mapped_file<unsigned char> file(path);
+
+    return static_cast<size_t>(
+        detail::read_checkpoint_header(file, path).count
+    );
+}
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // CL_VERSION_1_1
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_CHECKPOINT_HPP
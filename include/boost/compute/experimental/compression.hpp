@@ -0,0 +1,544 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_COMPRESSION_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_COMPRESSION_HPP
+
+#include <vector>
+#include <iterator>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/gather.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/scatter.hpp>
+#include <boost/compute/algorithm/inclusive_scan.hpp>
+#include <boost/compute/algorithm/reduce_by_key.hpp>
+#include <boost/compute/iterator/constant_iterator.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+namespace detail {
+
+// the mask of the low "bits" bits of a word
+inline uint_ bit_mask(size_t bits)
+{
+    return bits >= 32 ? ~uint_(0) : (uint_(1) << bits) - 1;
+}
+
+// the number of bits needed to store "value"
+inline size_t bit_width(uint_ value)
+{
+    size_t bits = 1;
+    while(bits < 32 && (value >> bits) != 0){
+        bits++;
+    }
+    return bits;
+}
+
+// the number of words needed to store "count" values of "bits" bits
+inline size_t packed_size(size_t count, size_t bits)
+{
+    return (static_cast<ulong_>(count) * bits + 31) / 32;
+}
+
+// zig-zag encodes the difference to the previous value on the host so
+// small negative differences also have few significant bits
+template<class InputIterator>
+inline uint_ host_delta_encode(InputIterator first,
+                               InputIterator last,
+                               std::vector<uint_> &result)
+{
+    uint_ previous = 0;
+    uint_ bits = 0;
+    for(; first != last; ++first){
+        const uint_ value = static_cast<uint_>(*first);
+        const uint_ delta = value - previous;
+        const uint_ sign = (delta >> 31) != 0 ? ~uint_(0) : uint_(0);
+        const uint_ zigzag = (delta << 1) ^ sign;
+
+        result.push_back(zigzag);
+        bits |= zigzag;
+        previous = value;
+    }
+
+    return bits;
+}
+
+// same layout as the bit_pack() kernel: value i is stored in bits
+// [i * bits, (i + 1) * bits) of the packed stream
+inline void host_bit_pack(const std::vector<uint_> &values,
+                          size_t bits,
+                          std::vector<uint_> &result)
+{
+    const uint_ mask = bit_mask(bits);
+
+    result.assign(packed_size(values.size(), bits), 0);
+    for(size_t i = 0; i < values.size(); i++){
+        const ulong_ bit = static_cast<ulong_>(i) * bits;
+        const size_t word = static_cast<size_t>(bit >> 5);
+        const size_t shift = static_cast<size_t>(bit & 31);
+        const uint_ value = values[i] & mask;
+
+        result[word] |= value << shift;
+        if(shift + bits > 32){
+            result[word + 1] |= value >> (32 - shift);
+        }
+    }
+}
+
+} // end detail namespace
+
+/// Stores the zig-zag encoded difference between each value in the range
+/// [\p first, \p last) and its predecessor (the first value is stored as
+/// is) to the range beginning at \p result. The values must be 32-bit
+/// integers and the result is a range of \c uint_.
+///
+/// Sorted or slowly changing columns become small values which bit_pack()
+/// stores in a few bits each. The values are restored with
+/// delta_decode().
+///
+/// \see delta_decode(), bit_pack()
+template<class InputIterator, class OutputIterator>
+inline OutputIterator delta_encode(InputIterator first,
+                                   InputIterator last,
+                                   OutputIterator result,
+                                   command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    BOOST_STATIC_ASSERT(boost::is_integral<value_type>::value);
+    BOOST_STATIC_ASSERT(sizeof(value_type) == sizeof(uint_));
+
+    const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+    if(count == 0){
+        return result;
+    }
+
+    ::boost::compute::detail::meta_kernel k("delta_encode");
+    k << "const uint i = get_global_id(0);\n"
+      << "const uint j = i > 0 ? i - 1 : 0;\n"
+      << "const uint value = (uint)" << first[k.var<uint_>("i")] << ";\n"
+      << "const uint previous = i > 0 ? (uint)" << first[k.var<uint_>("j")] << " : 0;\n"
+      << "const uint delta = value - previous;\n"
+      << result[k.var<uint_>("i")] << " = "
+      << "(delta << 1) ^ ((delta >> 31) ? 0xffffffffu : 0u);\n";
+
+    k.exec_1d(queue, 0, count);
+
+    return result + count;
+}
+
+/// Restores the values stored with delta_encode() from the range
+/// [\p first, \p last) to the range beginning at \p result. The result
+/// may be the same range as the input.
+///
+/// \see delta_encode()
+template<class InputIterator, class OutputIterator>
+inline OutputIterator delta_decode(InputIterator first,
+                                   InputIterator last,
+                                   OutputIterator result,
+                                   command_queue &queue = system::default_queue())
+{
+    const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+    if(count == 0){
+        return result;
+    }
+
+    // undo the zig-zag encoding, the prefix sum of the differences are the
+    // original values
+    ::boost::compute::detail::scratch_vector<uint_> deltas(count, queue);
+
+    ::boost::compute::detail::meta_kernel k("delta_decode");
+    k << "const uint i = get_global_id(0);\n"
+      << "const uint zigzag = " << first[k.var<uint_>("i")] << ";\n"
+      << deltas.begin()[k.var<uint_>("i")] << " = "
+      << "(zigzag >> 1) ^ (0u - (zigzag & 1u));\n";
+    k.exec_1d(queue, 0, count);
+
+    return ::boost::compute::inclusive_scan(
+        deltas.begin(), deltas.end(), result, queue
+    );
+}
+
+/// Returns the number of bits needed to store each of the unsigned values
+/// in the range [\p first, \p last) with bit_pack().
+template<class InputIterator>
+inline size_t bit_width(InputIterator first,
+                        InputIterator last,
+                        command_queue &queue = system::default_queue())
+{
+    if(first == last){
+        return 1;
+    }
+
+    uint_ bits = 0;
+    ::boost::compute::reduce(first, last, &bits, bit_or<uint_>(), queue);
+
+    return detail::bit_width(bits);
+}
+
+/// Packs the low \p bits bits of each value in the range [\p first,
+/// \p last) into consecutive \c uint_ words starting at \p result. Value
+/// \c i is stored in bits <tt>[i * bits, (i + 1) * bits)</tt> of the
+/// packed stream. Returns an iterator one past the last word written.
+///
+/// For example, to store the values of a column sorted in ascending order
+/// in as few words as possible:
+/// \code
+/// vector<uint_> deltas(column.size(), context);
+/// delta_encode(column.begin(), column.end(), deltas.begin(), queue);
+///
+/// size_t bits = bit_width(deltas.begin(), deltas.end(), queue);
+/// vector<uint_> packed(packed_size(column.size(), bits), context);
+/// bit_pack(deltas.begin(), deltas.end(), bits, packed.begin(), queue);
+/// \endcode
+///
+/// \see bit_unpack(), bit_width(), packed_size()
+template<class InputIterator, class OutputIterator>
+inline OutputIterator bit_pack(InputIterator first,
+                               InputIterator last,
+                               size_t bits,
+                               OutputIterator result,
+                               command_queue &queue = system::default_queue())
+{
+    BOOST_ASSERT(bits > 0 && bits <= 32);
+
+    const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+    const size_t words = detail::packed_size(count, bits);
+    if(words == 0){
+        return result;
+    }
+
+    // each work-item assembles one word from the values overlapping it
+    ::boost::compute::detail::meta_kernel k("bit_pack");
+    size_t count_arg = k.add_arg<uint_>("count");
+    size_t bits_arg = k.add_arg<uint_>("bits");
+    size_t mask_arg = k.add_arg<uint_>("mask");
+
+    k << "const uint w = get_global_id(0);\n"
+      << "const ulong lo = (ulong)w * 32;\n"
+      << "const uint end = (uint) min((ulong) count, (lo + 32 + bits - 1) / bits);\n"
+      << "uint word = 0;\n"
+      << "for(uint i = (uint)(lo / bits); i < end; i++){\n"
+      << "    const uint value = ((uint)" << first[k.var<uint_>("i")] << ") & mask;\n"
+      << "    const long shift = (long)((ulong)i * bits) - (long)lo;\n"
+      << "    word |= shift >= 0 ? value << (uint)shift : value >> (uint)-shift;\n"
+      << "}\n"
+      << result[k.var<uint_>("w")] << " = word;\n";
+
+    k.set_arg(count_arg, static_cast<uint_>(count));
+    k.set_arg(bits_arg, static_cast<uint_>(bits));
+    k.set_arg(mask_arg, detail::bit_mask(bits));
+
+    k.exec_1d(queue, 0, words);
+
+    return result + words;
+}
+
+/// Unpacks \p count values of \p bits bits stored with bit_pack() from the
+/// words starting at \p first to the range beginning at \p result.
+///
+/// \see bit_pack()
+template<class InputIterator, class OutputIterator>
+inline OutputIterator bit_unpack(InputIterator first,
+                                 size_t count,
+                                 size_t bits,
+                                 OutputIterator result,
+                                 command_queue &queue = system::default_queue())
+{
+    BOOST_ASSERT(bits > 0 && bits <= 32);
+
+    if(count == 0){
+        return result;
+    }
+
+    typedef typename std::iterator_traits<OutputIterator>::value_type value_type;
+
+    ::boost::compute::detail::meta_kernel k("bit_unpack");
+    size_t bits_arg = k.add_arg<uint_>("bits");
+    size_t mask_arg = k.add_arg<uint_>("mask");
+
+    k << "const uint i = get_global_id(0);\n"
+      << "const ulong bit = (ulong)i * bits;\n"
+      << "const uint w = (uint)(bit >> 5);\n"
+      << "const uint n = w + 1;\n"
+      << "const uint shift = (uint)(bit & 31);\n"
+      << "uint value = " << first[k.var<uint_>("w")] << " >> shift;\n"
+      << "if(shift + bits > 32){\n"
+      << "    value |= " << first[k.var<uint_>("n")] << " << (32 - shift);\n"
+      << "}\n"
+      << result[k.var<uint_>("i")] << " = "
+      << "(" << type_name<value_type>() << ")(value & mask);\n";
+
+    k.set_arg(bits_arg, static_cast<uint_>(bits));
+    k.set_arg(mask_arg, detail::bit_mask(bits));
+
+    k.exec_1d(queue, 0, count);
+
+    return result + count;
+}
+
+/// Returns the number of \c uint_ words needed to store \p count values of
+/// \p bits bits with bit_pack().
+inline size_t packed_size(size_t count, size_t bits)
+{
+    return detail::packed_size(count, bits);
+}
+
+/// Stores each run of equal consecutive values in the range [\p first,
+/// \p last) as its value (to the range beginning at \p values_result) and
+/// its length (to the range beginning at \p lengths_result). Returns the
+/// number of runs.
+///
+/// The runs are found with reduce_by_key() and are restored with
+/// run_length_decode().
+///
+/// \see run_length_decode()
+template<class InputIterator, class ValueIterator, class LengthIterator>
+inline size_t run_length_encode(InputIterator first,
+                                InputIterator last,
+                                ValueIterator values_result,
+                                LengthIterator lengths_result,
+                                command_queue &queue = system::default_queue())
+{
+    if(first == last){
+        return 0;
+    }
+
+    return static_cast<size_t>(std::distance(
+        values_result,
+        ::boost::compute::reduce_by_key(
+            first,
+            last,
+            ::boost::compute::make_constant_iterator<uint_>(1),
+            values_result,
+            lengths_result,
+            queue
+        ).first
+    ));
+}
+
+/// Expands the runs with values in the range [\p values_first,
+/// \p values_last) and lengths in the range beginning at \p lengths_first
+/// to the range beginning at \p result. Each run must have a length of at
+/// least one. Returns an iterator one past the last value written.
+///
+/// The start of each run is marked with scatter() and the run of each
+/// value (the prefix sum of the marks) selects its value with gather().
+///
+/// \see run_length_encode()
+template<class ValueIterator, class LengthIterator, class OutputIterator>
+inline OutputIterator run_length_decode(ValueIterator values_first,
+                                        ValueIterator values_last,
+                                        LengthIterator lengths_first,
+                                        OutputIterator result,
+                                        command_queue &queue = system::default_queue())
+{
+    const size_t runs =
+        ::boost::compute::detail::iterator_range_size(values_first, values_last);
+    if(runs == 0){
+        return result;
+    }
+
+    // the end of each run is the start of the next one
+    ::boost::compute::detail::scratch_vector<uint_> ends(runs, queue);
+    ::boost::compute::inclusive_scan(
+        lengths_first, lengths_first + runs, ends.begin(), queue
+    );
+
+    const size_t count =
+        ::boost::compute::detail::read_single_value<uint_>(
+            ends.get_buffer(), runs - 1, queue
+        );
+    if(count == 0){
+        return result;
+    }
+
+    ::boost::compute::detail::scratch_vector<uint_> run_index(count, queue);
+    ::boost::compute::fill(run_index.begin(), run_index.end(), uint_(0), queue);
+    ::boost::compute::scatter(
+        ::boost::compute::make_constant_iterator<uint_>(1, 0),
+        ::boost::compute::make_constant_iterator<uint_>(1, runs - 1),
+        ends.begin(),
+        run_index.begin(),
+        queue
+    );
+    ::boost::compute::inclusive_scan(
+        run_index.begin(), run_index.end(), run_index.begin(), queue
+    );
+
+    ::boost::compute::gather(
+        run_index.begin(), run_index.end(), values_first, result, queue
+    );
+
+    return result + count;
+}
+
+/// Replaces each index in the range [\p first, \p last) with the value at
+/// that index in the dictionary beginning at \p dictionary and stores it
+/// to the range beginning at \p result.
+///
+/// This is gather() with the dictionary as its input.
+template<class IndexIterator, class DictionaryIterator, class OutputIterator>
+inline OutputIterator dictionary_decode(IndexIterator first,
+                                        IndexIterator last,
+                                        DictionaryIterator dictionary,
+                                        OutputIterator result,
+                                        command_queue &queue = system::default_queue())
+{
+    ::boost::compute::gather(first, last, dictionary, result, queue);
+
+    return result + std::distance(first, last);
+}
+
+/// Copies the 32-bit integers in the host range [\p first, \p last) to
+/// the range beginning at \p result on the device. The values are delta
+/// encoded and bit-packed on the host, transferred in their packed form
+/// and expanded on the device with bit_unpack() and delta_decode().
+///
+/// This reduces the amount of data transferred for sorted or slowly
+/// changing columns, for example a column of timestamps or of ids.
+///
+/// \see delta_encode(), bit_pack()
+template<class InputIterator, class OutputIterator>
+inline OutputIterator copy_delta_packed(InputIterator first,
+                                        InputIterator last,
+                                        OutputIterator result,
+                                        command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    BOOST_STATIC_ASSERT(boost::is_integral<value_type>::value);
+    BOOST_STATIC_ASSERT(sizeof(value_type) == sizeof(uint_));
+
+    std::vector<uint_> deltas;
+    const size_t bits = detail::bit_width(detail::host_delta_encode(first, last, deltas));
+    if(deltas.empty()){
+        return result;
+    }
+
+    std::vector<uint_> packed;
+    detail::host_bit_pack(deltas, bits, packed);
+
+    const size_t count = deltas.size();
+    ::boost::compute::detail::scratch_vector<uint_> device_packed(packed.size(), queue);
+    ::boost::compute::detail::scratch_vector<uint_> device_deltas(count, queue);
+
+    ::boost::compute::copy(
+        packed.begin(), packed.end(), device_packed.begin(), queue
+    );
+    bit_unpack(device_packed.begin(), count, bits, device_deltas.begin(), queue);
+
+    return delta_decode(device_deltas.begin(), device_deltas.end(), result, queue);
+}
+
+/// Copies the values in the host range [\p first, \p last) to the range
+/// beginning at \p result on the device. The runs of equal values are
+/// found on the host, transferred as values and lengths and expanded on
+/// the device with run_length_decode().
+///
+/// \see run_length_decode()
+template<class InputIterator, class OutputIterator>
+inline OutputIterator copy_run_length(InputIterator first,
+                                      InputIterator last,
+                                      OutputIterator result,
+                                      command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    std::vector<value_type> values;
+    std::vector<uint_> lengths;
+    for(; first != last; ++first){
+        if(values.empty() || !(values.back() == *first)){
+            values.push_back(*first);
+            lengths.push_back(0);
+        }
+        lengths.back()++;
+    }
+    if(values.empty()){
+        return result;
+    }
+
+    ::boost::compute::detail::scratch_vector<value_type> device_values(values.size(), queue);
+    ::boost::compute::detail::scratch_vector<uint_> device_lengths(lengths.size(), queue);
+
+    ::boost::compute::copy(
+        values.begin(), values.end(), device_values.begin(), queue
+    );
+    ::boost::compute::copy(
+        lengths.begin(), lengths.end(), device_lengths.begin(), queue
+    );
+
+    return run_length_decode(
+        device_values.begin(),
+        device_values.end(),
+        device_lengths.begin(),
+        result,
+        queue
+    );
+}
+
+/// Copies a dictionary encoded column from the host to the range beginning
+/// at \p result on the device. Only the indices in the range [\p first,
+/// \p last) and the dictionary [\p dictionary_first, \p dictionary_last)
+/// are transferred, the values are looked up on the device with
+/// dictionary_decode().
+///
+/// \see dictionary_decode()
+template<class IndexIterator, class DictionaryIterator, class OutputIterator>
+inline OutputIterator copy_dictionary_encoded(IndexIterator first,
+                                              IndexIterator last,
+                                              DictionaryIterator dictionary_first,
+                                              DictionaryIterator dictionary_last,
+                                              OutputIterator result,
+                                              command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<IndexIterator>::value_type index_type;
+    typedef typename std::iterator_traits<DictionaryIterator>::value_type value_type;
+
+    const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+    const size_t dictionary_size =
+        ::boost::compute::detail::iterator_range_size(dictionary_first, dictionary_last);
+    if(count == 0 || dictionary_size == 0){
+        return result;
+    }
+
+    ::boost::compute::detail::scratch_vector<index_type> indices(count, queue);
+    ::boost::compute::detail::scratch_vector<value_type> dictionary(dictionary_size, queue);
+
+    ::boost::compute::copy(first, last, indices.begin(), queue);
+    ::boost::compute::copy(
+        dictionary_first, dictionary_last, dictionary.begin(), queue
+    );
+
+    return dictionary_decode(
+        indices.begin(), indices.end(), dictionary.begin(), result, queue
+    );
+}
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_COMPRESSION_HPP
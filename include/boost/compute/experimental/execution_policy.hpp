@@ -0,0 +1,746 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_EXECUTION_POLICY_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_EXECUTION_POLICY_HPP
+
+#include <vector>
+#include <iterator>
+
+#include <boost/ref.hpp>
+#include <boost/optional.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/utility/in_place_factory.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/for_each.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/algorithm/inclusive_scan.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/detail/insertion_sort.hpp>
+#include <boost/compute/algorithm/detail/merge_sort_on_cpu.hpp>
+#include <boost/compute/algorithm/detail/merge_sort_on_gpu.hpp>
+#include <boost/compute/algorithm/detail/radix_sort.hpp>
+#include <boost/compute/algorithm/detail/scan.hpp>
+#include <boost/compute/algorithm/detail/scan_on_cpu.hpp>
+#include <boost/compute/algorithm/detail/scan_on_gpu.hpp>
+#include <boost/compute/algorithm/detail/serial_reduce.hpp>
+#include <boost/compute/experimental/load_balancer.hpp>
+#include <boost/compute/functional/identity.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+#include <boost/compute/utility/scratch_space.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+
+/// \struct tuning
+/// \brief The tuning parameters of an execution_policy.
+///
+/// Ranges with fewer than \p SerialThreshold values are processed by a
+/// single work-item whatever the target of the policy (zero leaves the
+/// choice to the algorithms, which use the threshold measured for the
+/// device). The hybrid policy hands out chunks of at least \p MinChunkSize
+/// values to its queues.
+template<size_t SerialThreshold = 0, size_t MinChunkSize = 65536>
+struct tuning
+{
+    static const size_t serial_threshold = SerialThreshold;
+    static const size_t min_chunk_size = MinChunkSize;
+};
+
+/// The target of the policies running the parallel GPU algorithms.
+struct gpu_target {};
+/// The target of the policies running the algorithms for CPU devices,
+/// where each work-item processes a contiguous chunk of values.
+struct cpu_target {};
+/// The target of the policies running the algorithms with a single
+/// work-item.
+struct sequential_target {};
+/// The target of the policies splitting the algorithms between several
+/// queues with a load_balancer.
+struct hybrid_target {};
+
+/// \class execution_policy
+/// \brief Selects the strategy of the algorithms at compile time and
+///        carries their queue and scratch space.
+///
+/// The algorithms of Boost.Compute choose their strategy at run-time, from
+/// the type of the device and the size of the range, so every strategy of
+/// an algorithm is instantiated at each call site. The versions of
+/// for_each(), transform(), reduce(), inclusive_scan(), exclusive_scan()
+/// and sort() taking an execution policy as their first argument select
+/// the strategy from the \c Target of the policy instead, and only
+/// instantiate that one:
+///
+/// - \ref par_gpu runs the parallel GPU algorithms (e.g. the radix sort
+///   or the work-group scan) on any device.
+/// - \ref par_cpu runs the algorithms written for CPU devices (e.g. the
+///   merge sort of long contiguous runs).
+/// - \ref seq_device runs each algorithm as a single work-item.
+/// - \ref hybrid splits for_each(), transform() and reduce() between
+///   several queues with a load_balancer. Its other algorithms run on
+///   its first queue with their run-time dispatch.
+///
+/// The policy objects are bound to a queue with on() (otherwise the
+/// default queue is used) and to a scratch_space with with(), which is
+/// made active while an algorithm runs:
+/// \code
+/// using namespace boost::compute::experimental;
+///
+/// sort(par_gpu.on(queue), keys.begin(), keys.end());
+///
+/// execution_policy<gpu_target> policy = par_gpu.on(queue).with(scratch);
+/// inclusive_scan(policy, a.begin(), a.end(), b.begin());
+/// \endcode
+///
+/// The tuning parameters are template parameters of the policy:
+/// \code
+/// // ranges of fewer than 4096 values are sorted by one work-item
+/// execution_policy<gpu_target, tuning<4096> > policy(queue);
+/// sort(policy, keys.begin(), keys.end());
+/// \endcode
+///
+/// The algorithms only accept device iterators.
+///
+/// \see tuning, load_balancer, scratch_space
+template<class Target, class Tuning = tuning<> >
+class execution_policy
+{
+public:
+    typedef Target target_type;
+    typedef Tuning tuning_type;
+
+    /// Creates a policy using the default queue.
+    execution_policy()
+    {
+        #ifdef CL_VERSION_1_1
+        m_scratch_space = 0;
+        #endif
+    }
+
+    /// Creates a policy using \p queue.
+    explicit execution_policy(const command_queue &queue)
+        : m_queue(queue)
+    {
+        #ifdef CL_VERSION_1_1
+        m_scratch_space = 0;
+        #endif
+    }
+
+    /// Returns a copy of the policy using \p queue.
+    execution_policy on(const command_queue &queue) const
+    {
+        execution_policy policy(*this);
+        policy.m_queue = queue;
+        return policy;
+    }
+
+    /// Returns a copy of the policy splitting its algorithms between
+    /// \p queues. Only available for the \ref hybrid_target.
+    execution_policy on(const std::vector<command_queue> &queues) const
+    {
+        BOOST_STATIC_ASSERT((boost::is_same<Target, hybrid_target>::value));
+
+        execution_policy policy(*this);
+        policy.m_queue = queues.front();
+        policy.m_balancer =
+            boost::make_shared<load_balancer>(queues, Tuning::min_chunk_size);
+        return policy;
+    }
+
+    /// Returns the queue of the policy (the first queue of a hybrid
+    /// policy), or the default queue if it has none.
+    command_queue get_queue() const
+    {
+        return m_queue.get() ? m_queue : system::default_queue();
+    }
+
+    /// Returns the load balancer of a hybrid policy, or null if it was
+    /// not bound to several queues.
+    const boost::shared_ptr<load_balancer>& get_load_balancer() const
+    {
+        return m_balancer;
+    }
+
+    #if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+    /// Returns a copy of the policy drawing the temporary buffers of its
+    /// algorithms from \p space.
+    ///
+    /// \opencl_version_warning{1,1}
+    execution_policy with(scratch_space &space) const
+    {
+        execution_policy policy(*this);
+        policy.m_scratch_space = &space;
+        return policy;
+    }
+
+    /// Returns the scratch space of the policy, or null if it has none.
+    ///
+    /// \opencl_version_warning{1,1}
+    scratch_space* get_scratch_space() const
+    {
+        return m_scratch_space;
+    }
+    #endif // CL_VERSION_1_1
+
+private:
+    command_queue m_queue;
+    boost::shared_ptr<load_balancer> m_balancer;
+    #ifdef CL_VERSION_1_1
+    scratch_space *m_scratch_space;
+    #endif
+};
+
+/// Runs the parallel GPU algorithms.
+execution_policy<gpu_target> const par_gpu;
+
+/// Runs the algorithms written for CPU devices.
+execution_policy<cpu_target> const par_cpu;
+
+/// Runs each algorithm as a single work-item of the device.
+execution_policy<sequential_target> const seq_device;
+
+/// Splits the algorithms between the queues given to on().
+execution_policy<hybrid_target> const hybrid;
+
+namespace detail {
+
+using ::boost::compute::detail::meta_kernel;
+
+// makes the scratch space of a policy active while an algorithm runs
+class scoped_policy_scratch_space : boost::noncopyable
+{
+public:
+    template<class Target, class Tuning>
+    explicit scoped_policy_scratch_space(const execution_policy<Target, Tuning> &policy)
+    {
+        #ifdef CL_VERSION_1_1
+        if(scratch_space *space = policy.get_scratch_space()){
+            m_scope = boost::in_place(boost::ref(*space));
+        }
+        #else
+        (void) policy;
+        #endif
+    }
+
+private:
+    #ifdef CL_VERSION_1_1
+    boost::optional<scoped_scratch_space> m_scope;
+    #endif
+};
+
+// returns true if count values are processed by a single work-item with
+// the tuning of the policy
+template<class Tuning>
+inline bool is_below_serial_threshold(size_t count)
+{
+    return count < Tuning::serial_threshold;
+}
+
+// for_each() and transform() with a single work-item
+template<class InputIterator, class UnaryFunction>
+inline void serial_for_each(InputIterator first,
+                            InputIterator last,
+                            UnaryFunction function,
+                            command_queue &queue)
+{
+    const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    meta_kernel k("serial_for_each");
+    size_t count_arg = k.add_arg<uint_>("count");
+    k << "for(uint i = 0; i < count; i++){\n"
+      << "    " << function(first[k.var<uint_>("i")]) << ";\n"
+      << "}\n";
+
+    k.set_arg(count_arg, static_cast<uint_>(count));
+    k.exec_1d(queue, 0, 1, 1);
+}
+
+template<class InputIterator, class OutputIterator, class UnaryOperator>
+inline OutputIterator serial_transform(InputIterator first,
+                                       InputIterator last,
+                                       OutputIterator result,
+                                       UnaryOperator op,
+                                       command_queue &queue)
+{
+    const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+    if(count == 0){
+        return result;
+    }
+
+    meta_kernel k("serial_transform");
+    size_t count_arg = k.add_arg<uint_>("count");
+    k << "for(uint i = 0; i < count; i++){\n"
+      << "    " << result[k.var<uint_>("i")] << " = "
+      << op(first[k.var<uint_>("i")]) << ";\n"
+      << "}\n";
+
+    k.set_arg(count_arg, static_cast<uint_>(count));
+    k.exec_1d(queue, 0, 1, 1);
+
+    return result + count;
+}
+
+// for_each()
+template<class Policy, class InputIterator, class UnaryFunction>
+inline void policy_for_each(const Policy &policy,
+                            InputIterator first,
+                            InputIterator last,
+                            UnaryFunction function,
+                            sequential_target)
+{
+    command_queue queue = policy.get_queue();
+    serial_for_each(first, last, function, queue);
+}
+
+template<class Policy, class InputIterator, class UnaryFunction, class Target>
+inline void policy_for_each(const Policy &policy,
+                            InputIterator first,
+                            InputIterator last,
+                            UnaryFunction function,
+                            Target)
+{
+    command_queue queue = policy.get_queue();
+    if(is_below_serial_threshold<typename Policy::tuning_type>(
+           ::boost::compute::detail::iterator_range_size(first, last))){
+        serial_for_each(first, last, function, queue);
+    }
+    else {
+        ::boost::compute::for_each(first, last, function, queue);
+    }
+}
+
+template<class Policy, class InputIterator, class UnaryFunction>
+inline void policy_for_each(const Policy &policy,
+                            InputIterator first,
+                            InputIterator last,
+                            UnaryFunction function,
+                            hybrid_target)
+{
+    if(!policy.get_load_balancer()){
+        policy_for_each(policy, first, last, function, gpu_target());
+        return;
+    }
+
+    ::boost::compute::experimental::for_each(
+        first, last, function, *policy.get_load_balancer()
+    );
+}
+
+// transform()
+template<class Policy, class InputIterator, class OutputIterator, class UnaryOperator>
+inline OutputIterator policy_transform(const Policy &policy,
+                                       InputIterator first,
+                                       InputIterator last,
+                                       OutputIterator result,
+                                       UnaryOperator op,
+                                       sequential_target)
+{
+    command_queue queue = policy.get_queue();
+    return serial_transform(first, last, result, op, queue);
+}
+
+template<class Policy,
+         class InputIterator,
+         class OutputIterator,
+         class UnaryOperator,
+         class Target>
+inline OutputIterator policy_transform(const Policy &policy,
+                                       InputIterator first,
+                                       InputIterator last,
+                                       OutputIterator result,
+                                       UnaryOperator op,
+                                       Target)
+{
+    command_queue queue = policy.get_queue();
+    if(is_below_serial_threshold<typename Policy::tuning_type>(
+           ::boost::compute::detail::iterator_range_size(first, last))){
+        return serial_transform(first, last, result, op, queue);
+    }
+
+    return ::boost::compute::transform(first, last, result, op, queue);
+}
+
+template<class Policy, class InputIterator, class OutputIterator, class UnaryOperator>
+inline OutputIterator policy_transform(const Policy &policy,
+                                       InputIterator first,
+                                       InputIterator last,
+                                       OutputIterator result,
+                                       UnaryOperator op,
+                                       hybrid_target)
+{
+    if(!policy.get_load_balancer()){
+        return policy_transform(policy, first, last, result, op, gpu_target());
+    }
+
+    return ::boost::compute::experimental::transform(
+        first, last, result, op, *policy.get_load_balancer()
+    );
+}
+
+// reduce()
+template<class Policy, class InputIterator, class OutputIterator, class BinaryFunction>
+inline void policy_reduce(const Policy &policy,
+                          InputIterator first,
+                          InputIterator last,
+                          OutputIterator result,
+                          BinaryFunction function,
+                          sequential_target)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        ::boost::compute::result_of<BinaryFunction(value_type, value_type)>::type
+        result_type;
+
+    command_queue queue = policy.get_queue();
+
+    ::boost::compute::detail::scratch_vector<result_type> value(1, queue);
+    ::boost::compute::detail::serial_reduce(first, last, value.begin(), function, queue);
+    ::boost::compute::copy_n(value.begin(), 1, result, queue);
+}
+
+template<class Policy,
+         class InputIterator,
+         class OutputIterator,
+         class BinaryFunction,
+         class Target>
+inline void policy_reduce(const Policy &policy,
+                          InputIterator first,
+                          InputIterator last,
+                          OutputIterator result,
+                          BinaryFunction function,
+                          Target)
+{
+    if(is_below_serial_threshold<typename Policy::tuning_type>(
+           ::boost::compute::detail::iterator_range_size(first, last))){
+        policy_reduce(policy, first, last, result, function, sequential_target());
+        return;
+    }
+
+    command_queue queue = policy.get_queue();
+    ::boost::compute::reduce(first, last, result, function, queue);
+}
+
+template<class Policy, class InputIterator, class OutputIterator, class BinaryFunction>
+inline void policy_reduce(const Policy &policy,
+                          InputIterator first,
+                          InputIterator last,
+                          OutputIterator result,
+                          BinaryFunction function,
+                          hybrid_target)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    if(!policy.get_load_balancer()){
+        policy_reduce(policy, first, last, result, function, gpu_target());
+        return;
+    }
+
+    ::boost::compute::experimental::transform_reduce(
+        first, last, result, identity<value_type>(), function,
+        *policy.get_load_balancer()
+    );
+}
+
+// inclusive_scan() and exclusive_scan()
+template<class Policy, class InputIterator, class OutputIterator>
+inline OutputIterator policy_scan(const Policy &policy,
+                                  InputIterator first,
+                                  InputIterator last,
+                                  OutputIterator result,
+                                  bool exclusive,
+                                  sequential_target)
+{
+    command_queue queue = policy.get_queue();
+    return ::boost::compute::detail::scan_on_cpu(first, last, result, exclusive, queue);
+}
+
+template<class Policy, class InputIterator, class OutputIterator>
+inline OutputIterator policy_scan(const Policy &policy,
+                                  InputIterator first,
+                                  InputIterator last,
+                                  OutputIterator result,
+                                  bool exclusive,
+                                  gpu_target)
+{
+    if(is_below_serial_threshold<typename Policy::tuning_type>(
+           ::boost::compute::detail::iterator_range_size(first, last))){
+        return policy_scan(policy, first, last, result, exclusive, sequential_target());
+    }
+
+    command_queue queue = policy.get_queue();
+    return ::boost::compute::detail::scan_on_gpu(first, last, result, exclusive, queue);
+}
+
+// the cpu scan (and the scan on the first queue of a hybrid policy) has
+// the run-time threshold of the device between the single work-item and
+// the work-group scan
+template<class Policy, class InputIterator, class OutputIterator, class Target>
+inline OutputIterator policy_scan(const Policy &policy,
+                                  InputIterator first,
+                                  InputIterator last,
+                                  OutputIterator result,
+                                  bool exclusive,
+                                  Target)
+{
+    if(is_below_serial_threshold<typename Policy::tuning_type>(
+           ::boost::compute::detail::iterator_range_size(first, last))){
+        return policy_scan(policy, first, last, result, exclusive, sequential_target());
+    }
+
+    command_queue queue = policy.get_queue();
+    return ::boost::compute::detail::scan(first, last, result, exclusive, queue);
+}
+
+// sort()
+template<class T, class Compare>
+inline void policy_sort_on_gpu(buffer_iterator<T> first,
+                               buffer_iterator<T> last,
+                               Compare,
+                               command_queue &queue,
+                               boost::mpl::true_)
+{
+    ::boost::compute::detail::radix_sort(first, last, queue);
+}
+
+template<class T, class Compare>
+inline void policy_sort_on_gpu(buffer_iterator<T> first,
+                               buffer_iterator<T> last,
+                               Compare compare,
+                               command_queue &queue,
+                               boost::mpl::false_)
+{
+    ::boost::compute::detail::merge_sort_on_gpu(first, last, compare, queue);
+}
+
+// host ranges are sorted by sort() (on the host if they are small)
+template<class Iterator, class Compare>
+inline void policy_sort(Iterator first,
+                        Iterator last,
+                        Compare compare,
+                        command_queue &queue,
+                        sequential_target,
+                        typename boost::enable_if<
+                            is_device_iterator<Iterator>
+                        >::type* = 0)
+{
+    ::boost::compute::detail::serial_insertion_sort(first, last, compare, queue);
+}
+
+template<class T, class Compare>
+inline void policy_sort(buffer_iterator<T> first,
+                        buffer_iterator<T> last,
+                        Compare compare,
+                        command_queue &queue,
+                        gpu_target)
+{
+    policy_sort_on_gpu(
+        first, last, compare, queue,
+        boost::mpl::bool_<
+            ::boost::compute::detail::is_radix_sortable<T>::value &&
+            boost::is_same<Compare, less<T> >::value
+        >()
+    );
+}
+
+template<class T, class Compare>
+inline void policy_sort(buffer_iterator<T> first,
+                        buffer_iterator<T> last,
+                        Compare compare,
+                        command_queue &queue,
+                        cpu_target)
+{
+    ::boost::compute::detail::merge_sort_on_cpu(first, last, compare, queue);
+}
+
+// other iterators (and the hybrid policies) are sorted with the run-time
+// dispatch of sort()
+template<class Iterator, class Compare, class Target>
+inline void policy_sort(Iterator first,
+                        Iterator last,
+                        Compare compare,
+                        command_queue &queue,
+                        Target)
+{
+    ::boost::compute::sort(first, last, compare, queue);
+}
+
+} // end detail namespace
+
+/// Calls \p function on each value in the range [\p first, \p last) with
+/// the strategy of \p policy.
+///
+/// \see execution_policy, boost::compute::for_each()
+template<class Target, class Tuning, class InputIterator, class UnaryFunction>
+inline UnaryFunction for_each(const execution_policy<Target, Tuning> &policy,
+                              InputIterator first,
+                              InputIterator last,
+                              UnaryFunction function)
+{
+    detail::scoped_policy_scratch_space scratch(policy);
+    detail::policy_for_each(policy, first, last, function, Target());
+
+    return function;
+}
+
+/// Transforms the values in the range [\p first, \p last) with \p op to
+/// the range beginning at \p result with the strategy of \p policy.
+///
+/// \see execution_policy, boost::compute::transform()
+template<class Target,
+         class Tuning,
+         class InputIterator,
+         class OutputIterator,
+         class UnaryOperator>
+inline OutputIterator transform(const execution_policy<Target, Tuning> &policy,
+                                InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                UnaryOperator op)
+{
+    detail::scoped_policy_scratch_space scratch(policy);
+    return detail::policy_transform(policy, first, last, result, op, Target());
+}
+
+/// Reduces the values in the range [\p first, \p last) with \p function
+/// to \p result (a host or device iterator) with the strategy of
+/// \p policy.
+///
+/// \see execution_policy, boost::compute::reduce()
+template<class Target,
+         class Tuning,
+         class InputIterator,
+         class OutputIterator,
+         class BinaryFunction>
+inline void reduce(const execution_policy<Target, Tuning> &policy,
+                   InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   BinaryFunction function)
+{
+    if(first == last){
+        return;
+    }
+
+    detail::scoped_policy_scratch_space scratch(policy);
+    detail::policy_reduce(policy, first, last, result, function, Target());
+}
+
+/// \overload
+template<class Target, class Tuning, class InputIterator, class OutputIterator>
+inline void reduce(const execution_policy<Target, Tuning> &policy,
+                   InputIterator first,
+                   InputIterator last,
+                   OutputIterator result)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    ::boost::compute::experimental::reduce(policy, first, last, result, plus<T>());
+}
+
+/// Stores the inclusive prefix sums of the values in the range
+/// [\p first, \p last) to the range beginning at \p result with the
+/// strategy of \p policy.
+///
+/// \see execution_policy, boost::compute::inclusive_scan()
+template<class Target, class Tuning, class InputIterator, class OutputIterator>
+inline OutputIterator inclusive_scan(const execution_policy<Target, Tuning> &policy,
+                                     InputIterator first,
+                                     InputIterator last,
+                                     OutputIterator result)
+{
+    if(first == last){
+        return result;
+    }
+
+    detail::scoped_policy_scratch_space scratch(policy);
+    return detail::policy_scan(policy, first, last, result, false, Target());
+}
+
+/// Stores the exclusive prefix sums of the values in the range
+/// [\p first, \p last) to the range beginning at \p result with the
+/// strategy of \p policy.
+///
+/// \see execution_policy, boost::compute::exclusive_scan()
+template<class Target, class Tuning, class InputIterator, class OutputIterator>
+inline OutputIterator exclusive_scan(const execution_policy<Target, Tuning> &policy,
+                                     InputIterator first,
+                                     InputIterator last,
+                                     OutputIterator result)
+{
+    if(first == last){
+        return result;
+    }
+
+    detail::scoped_policy_scratch_space scratch(policy);
+    return detail::policy_scan(policy, first, last, result, true, Target());
+}
+
+/// Sorts the values in the range [\p first, \p last) according to
+/// \p compare with the strategy of \p policy.
+///
+/// \see execution_policy, boost::compute::sort()
+template<class Target, class Tuning, class Iterator, class Compare>
+inline void sort(const execution_policy<Target, Tuning> &policy,
+                 Iterator first,
+                 Iterator last,
+                 Compare compare)
+{
+    const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+    if(count < 2){
+        return;
+    }
+
+    detail::scoped_policy_scratch_space scratch(policy);
+    command_queue queue = policy.get_queue();
+    if(detail::is_below_serial_threshold<Tuning>(count)){
+        detail::policy_sort(first, last, compare, queue, sequential_target());
+    }
+    else {
+        detail::policy_sort(first, last, compare, queue, Target());
+    }
+}
+
+/// \overload
+template<class Target, class Tuning, class Iterator>
+inline void sort(const execution_policy<Target, Tuning> &policy,
+                 Iterator first,
+                 Iterator last)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+
+    ::boost::compute::experimental::sort(policy, first, last, less<T>());
+}
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_EXECUTION_POLICY_HPP
@@ -0,0 +1,295 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_EXTERNAL_SORT_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_EXTERNAL_SORT_HPP
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/event.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/detail/merge_with_merge_path.hpp>
+#include <boost/compute/algorithm/detail/radix_sort.hpp>
+#include <boost/compute/experimental/streaming_executor.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/utility/wait_list.hpp>
+#include <boost/compute/detail/enqueue_wait_list.hpp>
+#include <boost/compute/detail/is_contiguous_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+namespace detail {
+
+// stage which sorts a chunk into a sorted run
+struct external_sort_run_stage
+{
+    template<class InputIterator, class OutputIterator>
+    void operator()(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result,
+                    command_queue &queue) const
+    {
+        ::boost::compute::detail::radix_sort(first, last, queue);
+        ::boost::compute::copy(first, last, result, queue);
+    }
+};
+
+// merges the sorted segments of input given by the offsets in bounds with
+// a tree of pairwise merges, ping-ponging between input and temp. returns
+// true if the merged values end up in temp.
+template<class T>
+inline bool external_sort_merge_segments(buffer_iterator<T> input,
+                                         buffer_iterator<T> temp,
+                                         std::vector<size_t> bounds,
+                                         command_queue &queue)
+{
+    bool in_temp = false;
+
+    while(bounds.size() > 2){
+        buffer_iterator<T> source = in_temp ? temp : input;
+        buffer_iterator<T> target = in_temp ? input : temp;
+
+        std::vector<size_t> merged(1, 0);
+        for(size_t i = 0; i + 1 < bounds.size(); i += 2){
+            if(i + 2 < bounds.size()){
+                ::boost::compute::detail::merge_with_merge_path(
+                    source + bounds[i], source + bounds[i+1],
+                    source + bounds[i+1], source + bounds[i+2],
+                    target + bounds[i],
+                    less<T>(),
+                    queue
+                );
+                merged.push_back(bounds[i+2]);
+            }
+            else {
+                ::boost::compute::copy(
+                    source + bounds[i], source + bounds[i+1], target + bounds[i], queue
+                );
+                merged.push_back(bounds[i+1]);
+            }
+        }
+
+        bounds.swap(merged);
+        in_temp = !in_temp;
+    }
+
+    return in_temp;
+}
+
+// merges the sorted runs of run_size values in [runs, runs + count) into
+// result in one pass.
+//
+// each step takes a block of values from the front of every run, finds the
+// smallest of the last values of the blocks (the pivot) and merges all of
+// the values of the blocks up to the pivot on the device. every value left
+// in the runs is not less than the pivot so the merged values are the next
+// values of the result. uploads, merges and downloads of two steps are in
+// flight at the same time on separate queues.
+template<class T>
+inline void external_sort_merge_runs(const T *runs,
+                                     size_t count,
+                                     size_t run_size,
+                                     T *result,
+                                     size_t capacity,
+                                     command_queue &queue)
+{
+    const size_t run_count = (count + run_size - 1) / run_size;
+    capacity = (std::max)(capacity, run_count);
+    const size_t block = capacity / run_count;
+
+    std::vector<size_t> positions(run_count);
+    std::vector<size_t> ends(run_count);
+    for(size_t r = 0; r < run_count; r++){
+        positions[r] = r * run_size;
+        ends[r] = (std::min)(positions[r] + run_size, count);
+    }
+
+    const context &context = queue.get_context();
+    command_queue upload_queue(context, queue.get_device());
+    command_queue download_queue(context, queue.get_device());
+
+    const size_t slots = 2;
+    std::vector<buffer> inputs;
+    std::vector<buffer> temps;
+    for(size_t i = 0; i < slots; i++){
+        inputs.push_back(buffer(context, capacity * sizeof(T)));
+        temps.push_back(buffer(context, capacity * sizeof(T)));
+    }
+    std::vector<event> downloaded(slots);
+
+    size_t written = 0;
+    for(size_t step = 0; written < count; step++){
+        const size_t slot = step % slots;
+
+        // find the pivot
+        bool found = false;
+        T pivot = T();
+        for(size_t r = 0; r < run_count; r++){
+            if(positions[r] < ends[r]){
+                const size_t last = (std::min)(positions[r] + block, ends[r]) - 1;
+                if(!found || runs[last] < pivot){
+                    pivot = runs[last];
+                    found = true;
+                }
+            }
+        }
+
+        // upload the values of each run up to the pivot once the previous
+        // results in the buffers of the slot are downloaded
+        wait_list upload_events;
+        if(downloaded[slot].get()){
+            upload_events.insert(downloaded[slot]);
+        }
+
+        std::vector<size_t> bounds(1, 0);
+        event uploaded;
+        for(size_t r = 0; r < run_count; r++){
+            const T *begin = runs + positions[r];
+            const T *end = std::upper_bound(
+                begin, runs + (std::min)(positions[r] + block, ends[r]), pivot
+            );
+            const size_t size = static_cast<size_t>(end - begin);
+            if(size == 0){
+                continue;
+            }
+
+            uploaded = upload_queue.enqueue_write_buffer_async(
+                inputs[slot],
+                bounds.back() * sizeof(T),
+                size * sizeof(T),
+                begin,
+                upload_events
+            );
+            bounds.push_back(bounds.back() + size);
+            positions[r] += size;
+        }
+        upload_queue.flush();
+
+        // merge the segments once they are uploaded (the upload queue is
+        // in-order so the last upload completes after the others)
+        ::boost::compute::detail::enqueue_wait_list(queue, wait_list(uploaded));
+        const bool in_temp = external_sort_merge_segments(
+            make_buffer_iterator<T>(inputs[slot]),
+            make_buffer_iterator<T>(temps[slot]),
+            bounds,
+            queue
+        );
+        event merged;
+        queue.enqueue_marker(&merged);
+        queue.flush();
+
+        // download the merged values
+        const size_t size = bounds.back();
+        downloaded[slot] = download_queue.enqueue_read_buffer_async(
+            in_temp ? temps[slot] : inputs[slot],
+            0,
+            size * sizeof(T),
+            result + written,
+            wait_list(merged)
+        );
+        download_queue.flush();
+
+        written += size;
+    }
+
+    download_queue.finish();
+    queue.finish();
+}
+
+} // end detail namespace
+
+/// Sorts the values in the host range [\p first, \p last), which may be
+/// larger than the memory of the device.
+///
+/// The range is sorted in chunks of \p chunk_size values with radix_sort()
+/// on the device. The sorted runs are stored in the host range beginning at
+/// \p scratch and then merged back into [\p first, \p last) with a
+/// multi-way merge on the device in a single pass. Transfers overlap with
+/// the sorting and merging on the device (see streaming_executor).
+///
+/// The scratch range must hold as many values as the input. It can point
+/// to a memory-mapped file to spill the runs to disk instead of memory.
+///
+/// Both ranges must be contiguous. The device needs memory for about
+/// five times \p chunk_size values: four for the chunks in flight in the
+/// streaming_executor and about one more for the temporaries of
+/// radix_sort().
+///
+/// \see sort(), merge()
+template<class Iterator, class ScratchIterator>
+inline void external_sort(Iterator first,
+                          Iterator last,
+                          ScratchIterator scratch,
+                          size_t chunk_size,
+                          command_queue &queue)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+
+    BOOST_STATIC_ASSERT_MSG(
+        ::boost::compute::detail::is_radix_sortable<T>::value,
+        "external_sort() requires a radix sortable value type"
+    );
+    BOOST_STATIC_ASSERT_MSG(
+        ::boost::compute::detail::is_contiguous_iterator<ScratchIterator>::value,
+        "external_sort() requires a contiguous scratch range"
+    );
+
+    const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+    if(count < 2){
+        return;
+    }
+
+    streaming_executor executor(queue, chunk_size);
+    if(count <= chunk_size){
+        executor.run(first, last, first, detail::external_sort_run_stage());
+        return;
+    }
+
+    // sort the runs into the scratch range
+    executor.run(first, last, scratch, detail::external_sort_run_stage());
+
+    // merge the runs back
+    detail::external_sort_merge_runs(
+        static_cast<const T *>(&*scratch), count, chunk_size, &*first, chunk_size / 4, queue
+    );
+}
+
+/// \overload
+///
+/// The runs are stored in a temporary host vector.
+template<class Iterator>
+inline void external_sort(Iterator first,
+                          Iterator last,
+                          size_t chunk_size,
+                          command_queue &queue)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+
+    std::vector<T> scratch(::boost::compute::detail::iterator_range_size(first, last));
+
+    ::boost::compute::experimental::external_sort(
+        first, last, scratch.begin(), chunk_size, queue
+    );
+}
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_EXTERNAL_SORT_HPP
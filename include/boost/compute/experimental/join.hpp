@@ -0,0 +1,357 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_JOIN_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_JOIN_HPP
+
+#include <iterator>
+#include <utility>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/load_balanced_search.hpp>
+#include <boost/compute/algorithm/lower_bound.hpp>
+#include <boost/compute/algorithm/reduce_by_key.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/algorithm/upper_bound.hpp>
+#include <boost/compute/container/unordered_map.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/iterator/constant_iterator.hpp>
+#include <boost/compute/iterator/counting_iterator.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+
+/// The right index stored by left_join() and hash_left_join() for left
+/// keys without a matching right key.
+const uint_ join_no_match = 0xFFFFFFFF;
+
+namespace detail {
+
+using ::boost::compute::detail::meta_kernel;
+
+// writes the pairs of indices of a join given the matches of each left
+// row, which are the counts[i] right rows beginning at starts[i] in the
+// order of right_order. the pairs of each left row are placed at the
+// exclusive scan of the counts and found with load_balanced_search(), so
+// the output is balanced regardless of how the matches are distributed.
+// with keep_unmatched left rows without a match are paired with
+// join_no_match.
+template<class RightOrderIterator>
+inline size_t expand_join(const vector<uint_> &starts,
+                          const vector<uint_> &counts,
+                          RightOrderIterator right_order,
+                          bool keep_unmatched,
+                          vector<uint_> &left_indices,
+                          vector<uint_> &right_indices,
+                          command_queue &queue)
+{
+    const size_t count = starts.size();
+
+    // the number of pairs of each left row (and zero past the last row,
+    // which becomes the total)
+    vector<uint_> offsets(count + 1, queue.get_context());
+    meta_kernel pairs_kernel("join_pair_counts");
+    pairs_kernel.add_set_arg<const uint_>("count", static_cast<uint_>(count));
+    pairs_kernel <<
+        "const uint i = get_global_id(0);\n" <<
+        "uint n = 0;\n" <<
+        "if(i < count){\n" <<
+        "    n = " << counts.begin()[pairs_kernel.var<uint_>("i")] << ";\n" <<
+        (keep_unmatched ? "    n = max(n, 1u);\n" : "") <<
+        "}\n" <<
+        offsets.begin()[pairs_kernel.var<uint_>("i")] << " = n;\n";
+    pairs_kernel.exec_1d(queue, 0, count + 1);
+
+    ::boost::compute::exclusive_scan(
+        offsets.begin(), offsets.end(), offsets.begin(), queue
+    );
+
+    const size_t total = ::boost::compute::detail::read_single_value<uint_>(
+        offsets.get_buffer(), count, queue
+    );
+
+    left_indices.resize_uninitialized(total);
+    right_indices.resize_uninitialized(total);
+    if(total == 0){
+        return 0;
+    }
+
+    // the left row of each pair and its rank among the pairs of the row,
+    // which is replaced by the right row
+    ::boost::compute::load_balanced_search(
+        offsets.begin(), offsets.begin() + count,
+        left_indices.begin(), left_indices.end(), right_indices.begin(), queue
+    );
+
+    meta_kernel k("expand_join");
+    k <<
+        "const uint j = get_global_id(0);\n" <<
+        "const uint lo = " << left_indices.begin()[k.var<uint_>("j")] << ";\n" <<
+        "const uint n = " << right_indices.begin()[k.var<uint_>("j")] << ";\n" <<
+        "const uint start = " << starts.begin()[k.var<uint_>("lo")] << ";\n" <<
+        "if(n < " << counts.begin()[k.var<uint_>("lo")] << "){\n" <<
+        "    " << right_indices.begin()[k.var<uint_>("j")] << " = " <<
+                  right_order[k.expr<uint_>("start + n")] << ";\n" <<
+        "}\n" <<
+        "else {\n" <<
+        "    " << right_indices.begin()[k.var<uint_>("j")] << " = " <<
+                  join_no_match << "u;\n" <<
+        "}\n";
+
+    k.exec_1d(queue, 0, total);
+
+    return total;
+}
+
+// joins the sorted keys with binary searches of the right keys for the
+// first and last match of each left key
+template<class InputIterator1, class InputIterator2>
+inline size_t sort_merge_join(InputIterator1 left_first,
+                              InputIterator1 left_last,
+                              InputIterator2 right_first,
+                              InputIterator2 right_last,
+                              bool keep_unmatched,
+                              vector<uint_> &left_indices,
+                              vector<uint_> &right_indices,
+                              command_queue &queue)
+{
+    const context &context = queue.get_context();
+    const size_t count =
+        ::boost::compute::detail::iterator_range_size(left_first, left_last);
+
+    vector<uint_> starts(count, context);
+    vector<uint_> counts(count, context);
+    ::boost::compute::lower_bound(
+        right_first, right_last, left_first, left_last, starts.begin(), queue
+    );
+    ::boost::compute::upper_bound(
+        right_first, right_last, left_first, left_last, counts.begin(), queue
+    );
+    ::boost::compute::transform(
+        counts.begin(), counts.end(), starts.begin(), counts.begin(),
+        minus<uint_>(), queue
+    );
+
+    return expand_join(
+        starts, counts, counting_iterator<uint_>(0), keep_unmatched,
+        left_indices, right_indices, queue
+    );
+}
+
+// builds a hash table from each distinct right key to its rows (which are
+// consecutive after sorting the right keys) and probes it with the left
+// keys
+template<class InputIterator1, class InputIterator2>
+inline size_t hash_join(InputIterator1 left_first,
+                        InputIterator1 left_last,
+                        InputIterator2 right_first,
+                        InputIterator2 right_last,
+                        bool keep_unmatched,
+                        vector<uint_> &left_indices,
+                        vector<uint_> &right_indices,
+                        command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator2>::value_type key_type;
+
+    const context &context = queue.get_context();
+    const size_t count =
+        ::boost::compute::detail::iterator_range_size(left_first, left_last);
+    const size_t right_count =
+        ::boost::compute::detail::iterator_range_size(right_first, right_last);
+
+    // sort the right rows by key
+    vector<key_type> keys(right_first, right_last, queue);
+    vector<uint_> order(right_count, context);
+    ::boost::compute::iota(order.begin(), order.end(), uint_(0), queue);
+    ::boost::compute::sort_by_key(keys.begin(), keys.end(), order.begin(), queue);
+
+    // the number of rows and the first row of each distinct key
+    vector<key_type> distinct_keys(right_count, context);
+    vector<uint_> run_counts(right_count, context);
+    size_t runs = 0;
+    if(right_count > 0){
+        runs = static_cast<size_t>(
+            ::boost::compute::reduce_by_key(
+                keys.begin(), keys.end(), constant_iterator<uint_>(1),
+                distinct_keys.begin(), run_counts.begin(), queue
+            ).first - distinct_keys.begin()
+        );
+    }
+    vector<uint_> run_starts(runs, context);
+    ::boost::compute::exclusive_scan(
+        run_counts.begin(), run_counts.begin() + runs, run_starts.begin(), queue
+    );
+
+    // build: map each distinct key to its run
+    unordered_map<key_type, uint_> table(context);
+    table.reserve(runs, queue);
+    table.insert(
+        distinct_keys.begin(), distinct_keys.begin() + runs,
+        counting_iterator<uint_>(0), queue
+    );
+
+    // probe: find the run of each left key
+    vector<uint_> starts(count, context);
+    vector<uint_> counts(count, context);
+    table.find(left_first, left_last, starts.begin(), join_no_match, queue);
+
+    meta_kernel k("hash_join_runs");
+    k <<
+        "const uint i = get_global_id(0);\n" <<
+        "const uint run = " << starts.begin()[k.var<uint_>("i")] << ";\n" <<
+        "if(run == " << join_no_match << "u){\n" <<
+        "    " << starts.begin()[k.var<uint_>("i")] << " = 0;\n" <<
+        "    " << counts.begin()[k.var<uint_>("i")] << " = 0;\n" <<
+        "}\n" <<
+        "else {\n" <<
+        "    " << starts.begin()[k.var<uint_>("i")] << " = " <<
+                  run_starts.begin()[k.var<uint_>("run")] << ";\n" <<
+        "    " << counts.begin()[k.var<uint_>("i")] << " = " <<
+                  run_counts.begin()[k.var<uint_>("run")] << ";\n" <<
+        "}\n";
+    if(count > 0){
+        k.exec_1d(queue, 0, count);
+    }
+
+    return expand_join(
+        starts, counts, order.begin(), keep_unmatched,
+        left_indices, right_indices, queue
+    );
+}
+
+} // end detail namespace
+
+/// Joins the sorted keys in [\p left_first, \p left_last) with the sorted
+/// keys in [\p right_first, \p right_last) and stores the index of the
+/// left and right key of each pair of equal keys in \p left_indices and
+/// \p right_indices (which are resized to the number of pairs).
+///
+/// The pairs are ordered by their left and then their right index. Each
+/// left key is looked up in the right keys with a binary search and the
+/// pairs are written at the prefix sum of the number of matches of each
+/// left key, so both steps take a single kernel launch regardless of how
+/// many pairs each key has.
+///
+/// For example, to join the rows of two tables by their sorted keys and
+/// gather the values of the joined rows:
+/// \code
+/// vector<uint_> left_rows(context);
+/// vector<uint_> right_rows(context);
+/// size_t count = experimental::inner_join(
+///     left_keys.begin(), left_keys.end(),
+///     right_keys.begin(), right_keys.end(),
+///     left_rows, right_rows, queue
+/// );
+/// gather(right_rows.begin(), right_rows.end(), right_values.begin(), joined.begin(), queue);
+/// \endcode
+///
+/// \return the number of pairs
+///
+/// \see left_join(), hash_inner_join()
+template<class InputIterator1, class InputIterator2>
+inline size_t inner_join(InputIterator1 left_first,
+                         InputIterator1 left_last,
+                         InputIterator2 right_first,
+                         InputIterator2 right_last,
+                         vector<uint_> &left_indices,
+                         vector<uint_> &right_indices,
+                         command_queue &queue = system::default_queue())
+{
+    return detail::sort_merge_join(
+        left_first, left_last, right_first, right_last, false,
+        left_indices, right_indices, queue
+    );
+}
+
+/// Joins the sorted keys like inner_join() but also stores a pair for each
+/// left key without an equal right key, with \c join_no_match as its right
+/// index.
+///
+/// \return the number of pairs
+///
+/// \see inner_join(), hash_left_join()
+template<class InputIterator1, class InputIterator2>
+inline size_t left_join(InputIterator1 left_first,
+                        InputIterator1 left_last,
+                        InputIterator2 right_first,
+                        InputIterator2 right_last,
+                        vector<uint_> &left_indices,
+                        vector<uint_> &right_indices,
+                        command_queue &queue = system::default_queue())
+{
+    return detail::sort_merge_join(
+        left_first, left_last, right_first, right_last, true,
+        left_indices, right_indices, queue
+    );
+}
+
+/// Joins the keys in [\p left_first, \p left_last) with the keys in
+/// [\p right_first, \p right_last) like inner_join() without requiring
+/// them to be sorted.
+///
+/// The distinct right keys are inserted into a hash table (see
+/// unordered_map) which is then probed with each left key, so the keys
+/// must be 32-bit types. The pairs are ordered by their left index.
+///
+/// \return the number of pairs
+///
+/// \see inner_join(), hash_left_join()
+template<class InputIterator1, class InputIterator2>
+inline size_t hash_inner_join(InputIterator1 left_first,
+                              InputIterator1 left_last,
+                              InputIterator2 right_first,
+                              InputIterator2 right_last,
+                              vector<uint_> &left_indices,
+                              vector<uint_> &right_indices,
+                              command_queue &queue = system::default_queue())
+{
+    return detail::hash_join(
+        left_first, left_last, right_first, right_last, false,
+        left_indices, right_indices, queue
+    );
+}
+
+/// Joins the keys like hash_inner_join() but also stores a pair for each
+/// left key without an equal right key, with \c join_no_match as its right
+/// index.
+///
+/// \return the number of pairs
+///
+/// \see left_join(), hash_inner_join()
+template<class InputIterator1, class InputIterator2>
+inline size_t hash_left_join(InputIterator1 left_first,
+                             InputIterator1 left_last,
+                             InputIterator2 right_first,
+                             InputIterator2 right_last,
+                             vector<uint_> &left_indices,
+                             vector<uint_> &right_indices,
+                             command_queue &queue = system::default_queue())
+{
+    return detail::hash_join(
+        left_first, left_last, right_first, right_last, true,
+        left_indices, right_indices, queue
+    );
+}
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_JOIN_HPP
@@ -0,0 +1,358 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_K_MEANS_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_K_MEANS_HPP
+
+#include <string>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/functional/atomic.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/type_traits/scalar_type.hpp>
+#include <boost/compute/type_traits/vector_size.hpp>
+#include <boost/compute/utility/fill_batch.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+namespace detail {
+
+// returns the code for component j of the point variable named name
+inline std::string k_means_component(const std::string &name,
+                                     size_t j,
+                                     size_t dimensions)
+{
+    if(dimensions == 1){
+        return name;
+    }
+
+    return name + ".s" + "0123456789abcdef"[j];
+}
+
+// words of the k-means state buffer. the labels changed by the assignment
+// of each iteration are counted in one of three rotating counters. the
+// assignment of iteration t does nothing if the counter of iteration t-1
+// is within the tolerance and neither does the update if the counter of
+// iteration t is. the update also resets the counter of iteration t+1,
+// which no kernel of iteration t reads.
+enum k_means_state_word {
+    k_means_state_iterations = 3,
+    k_means_state_size = 4
+};
+
+} // end detail namespace
+
+/// Clusters the points in the range [\p first, \p last) into the
+/// clusters given by the initial centroids in [\p centroids_first,
+/// \p centroids_last) with Lloyd's algorithm and returns the number of
+/// iterations performed.
+///
+/// Each iteration assigns each point to its nearest centroid (by
+/// Euclidean distance), storing the index of the cluster at \c labels[i],
+/// and moves each centroid to the mean of its points. The iterations stop
+/// after an assignment which changes no more than \p tolerance labels
+/// (whose centroids are kept, so each label is the nearest centroid) or
+/// after \p max_iterations iterations. A centroid without points is left
+/// where it is.
+///
+/// Each iteration runs two kernels. The first assigns the points and sums
+/// them per cluster, with the sums and counts of each work-group first
+/// accumulated in local memory (when the \c k clusters fit) and then added
+/// to global memory with float atomics. The second computes the new
+/// centroids. The convergence check stays on the device: all iterations
+/// are enqueued at once and the kernels of the iterations after the
+/// convergence return immediately, so only the number of iterations is
+/// read on the host at the end.
+///
+/// The points must be \c float_, \c float2_, \c float3_ or \c float4_
+/// values. Iterations of the same \c k (and point type) reuse the same
+/// programs.
+///
+/// For example, to cluster points starting from the first \c k of them:
+/// \code
+/// copy_n(points.begin(), k, centroids.begin(), queue);
+/// size_t iterations = experimental::k_means(
+///     points.begin(), points.end(), centroids.begin(), centroids.end(),
+///     labels.begin(), 100, 0, queue
+/// );
+/// \endcode
+template<class InputIterator, class CentroidIterator>
+inline size_t k_means(InputIterator first,
+                      InputIterator last,
+                      CentroidIterator centroids_first,
+                      CentroidIterator centroids_last,
+                      buffer_iterator<uint_> labels,
+                      size_t max_iterations,
+                      size_t tolerance = 0,
+                      command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type point_type;
+    typedef typename scalar_type<point_type>::type scalar_type;
+
+    BOOST_STATIC_ASSERT((boost::is_same<scalar_type, float_>::value));
+    BOOST_STATIC_ASSERT(vector_size<point_type>::value <= 4);
+
+    const size_t dimensions = vector_size<point_type>::value;
+    const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+    const size_t clusters =
+        ::boost::compute::detail::iterator_range_size(centroids_first, centroids_last);
+    if(count == 0 || clusters == 0 || max_iterations == 0){
+        return 0;
+    }
+
+    const context &context = queue.get_context();
+    const device &device = queue.get_device();
+
+    ::boost::compute::detail::scratch_vector<float_> sums(clusters * dimensions, queue);
+    ::boost::compute::detail::scratch_vector<uint_> counts(clusters, queue);
+    ::boost::compute::detail::scratch_vector<uint_> state(detail::k_means_state_size, queue);
+
+    // every label changes in the first iteration, whose previous counter
+    // is larger than any tolerance
+    fill_batch clear;
+    clear.add(labels, labels + count, uint_(-1));
+    clear.add(sums.begin(), sums.end(), 0);
+    clear.add(counts.begin(), counts.end(), 0);
+    clear.add(state.begin(), state.begin() + 2, 0);
+    clear.add(state.begin() + 2, state.begin() + 3, uint_(-1));
+    clear.add(state.begin() + 3, state.end(), 0);
+    clear.enqueue(queue);
+
+    const size_t work_group_size =
+        (std::min)(size_t(256), device.max_work_group_size());
+
+    // the sums and counts of a work-group are privatized in local memory
+    // if they fit with the centroids
+    const size_t local_size =
+        clusters * (sizeof(point_type) + dimensions * sizeof(float_) + sizeof(uint_)) +
+        sizeof(uint_);
+    const bool privatize = local_size <= device.local_memory_size() / 2;
+
+    const std::string local_atomic_add = "boost_k_means_atomic_add_local";
+    atomic_add<float_> global_atomic_add;
+
+    // assign each point to the nearest centroid and accumulate its cluster
+    ::boost::compute::detail::meta_kernel assign_kernel("k_means_assign");
+    size_t assign_count_arg = assign_kernel.add_arg<const uint_>("count");
+    size_t assign_sums_arg =
+        assign_kernel.add_arg<float_ *>(memory_object::global_memory, "sums");
+    size_t assign_counts_arg =
+        assign_kernel.add_arg<uint_ *>(memory_object::global_memory, "counts");
+    size_t assign_state_arg =
+        assign_kernel.add_arg<uint_ *>(memory_object::global_memory, "state");
+    size_t assign_previous_arg = assign_kernel.add_arg<const uint_>("previous");
+    size_t assign_current_arg = assign_kernel.add_arg<const uint_>("current");
+    size_t assign_tolerance_arg = assign_kernel.add_arg<const uint_>("tolerance");
+
+    if(privatize){
+        assign_kernel.add_function(
+            local_atomic_add,
+            ::boost::compute::detail::make_atomic_float_function_source<float_>(
+                local_atomic_add, "add", "__local"
+            )
+        );
+
+        assign_kernel <<
+            "__local " << assign_kernel.type<point_type>() << " lcentroids[" << clusters << "];\n" <<
+            "__local float lsums[" << clusters * dimensions << "];\n" <<
+            "__local uint lcounts[" << clusters << "];\n" <<
+            "__local uint lchanged;\n";
+    }
+
+    assign_kernel <<
+        // converged in a previous iteration
+        "if(state[previous] <= tolerance){\n" <<
+        "    return;\n" <<
+        "}\n" <<
+        "const uint lid = get_local_id(0);\n";
+
+    if(privatize){
+        assign_kernel <<
+            "for(uint j = lid; j < " << clusters << "; j += get_local_size(0)){\n" <<
+            "    lcentroids[j] = " << centroids_first[assign_kernel.var<uint_>("j")] << ";\n" <<
+            "    lcounts[j] = 0;\n" <<
+            "}\n" <<
+            "for(uint j = lid; j < " << clusters * dimensions << "; j += get_local_size(0)){\n" <<
+            "    lsums[j] = 0;\n" <<
+            "}\n" <<
+            "if(lid == 0){\n" <<
+            "    lchanged = 0;\n" <<
+            "}\n" <<
+            "barrier(CLK_LOCAL_MEM_FENCE);\n";
+    }
+
+    assign_kernel <<
+        "for(uint i = get_global_id(0); i < count; i += get_global_size(0)){\n" <<
+        "    " << assign_kernel.decl<const point_type>("point") << " = " <<
+                  first[assign_kernel.var<uint_>("i")] << ";\n" <<
+        "    uint best = 0;\n" <<
+        "    float best_distance = 0;\n" <<
+        "    for(uint c = 0; c < " << clusters << "; c++){\n" <<
+        "        " << assign_kernel.decl<const point_type>("diff") << " = point - ";
+    if(privatize){
+        assign_kernel << "lcentroids[c]";
+    }
+    else {
+        assign_kernel << centroids_first[assign_kernel.var<uint_>("c")];
+    }
+    assign_kernel << ";\n" <<
+        "        const float distance = dot(diff, diff);\n" <<
+        "        if(c == 0 || distance < best_distance){\n" <<
+        "            best = c;\n" <<
+        "            best_distance = distance;\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "    if(" << labels[assign_kernel.var<uint_>("i")] << " != best){\n" <<
+        "        " << labels[assign_kernel.var<uint_>("i")] << " = best;\n" <<
+        "        " << (privatize ? "atomic_inc(&lchanged);\n" : "atomic_inc(state + current);\n") <<
+        "    }\n";
+    for(size_t j = 0; j < dimensions; j++){
+        const std::string component = detail::k_means_component("point", j, dimensions);
+        if(privatize){
+            assign_kernel <<
+        "    " << local_atomic_add << "(lsums + best * " << dimensions << " + " << j << ", " <<
+                  component << ");\n";
+        }
+        else {
+            assign_kernel <<
+        "    " << global_atomic_add(
+                      assign_kernel.var<float_ *>(
+                          std::string("sums + best * ") + char('0' + dimensions) +
+                          " + " + char('0' + j)
+                      ),
+                      assign_kernel.var<float_>(component)
+                  ) << ";\n";
+        }
+    }
+    assign_kernel <<
+        "    " << (privatize ? "atomic_inc(lcounts + best);\n" : "atomic_inc(counts + best);\n") <<
+        "}\n";
+
+    if(privatize){
+        // add the sums and counts of the work-group to global memory
+        assign_kernel <<
+            "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+            "for(uint j = lid; j < " << clusters * dimensions << "; j += get_local_size(0)){\n" <<
+            "    if(lsums[j] != 0){\n" <<
+            "        " << global_atomic_add(assign_kernel.var<float_ *>("sums + j"),
+                                            assign_kernel.var<float_>("lsums[j]")) << ";\n" <<
+            "    }\n" <<
+            "}\n" <<
+            "for(uint j = lid; j < " << clusters << "; j += get_local_size(0)){\n" <<
+            "    if(lcounts[j] != 0){\n" <<
+            "        atomic_add(counts + j, lcounts[j]);\n" <<
+            "    }\n" <<
+            "}\n" <<
+            "if(lid == 0 && lchanged != 0){\n" <<
+            "    atomic_add(state + current, lchanged);\n" <<
+            "}\n";
+    }
+
+    // move each centroid to the mean of its points and clear its sums
+    ::boost::compute::detail::meta_kernel update_kernel("k_means_update");
+    size_t update_sums_arg =
+        update_kernel.add_arg<float_ *>(memory_object::global_memory, "sums");
+    size_t update_counts_arg =
+        update_kernel.add_arg<uint_ *>(memory_object::global_memory, "counts");
+    size_t update_state_arg =
+        update_kernel.add_arg<uint_ *>(memory_object::global_memory, "state");
+    size_t update_previous_arg = update_kernel.add_arg<const uint_>("previous");
+    size_t update_current_arg = update_kernel.add_arg<const uint_>("current");
+    size_t update_next_arg = update_kernel.add_arg<const uint_>("next");
+    size_t update_tolerance_arg = update_kernel.add_arg<const uint_>("tolerance");
+
+    update_kernel <<
+        "const uint c = get_global_id(0);\n" <<
+        "if(c == 0){\n" <<
+        "    state[next] = 0;\n" <<
+        "    if(state[previous] > tolerance){\n" <<
+        "        state[" << uint_(detail::k_means_state_iterations) << "]++;\n" <<
+        "    }\n" <<
+        "}\n" <<
+        // the assignment converged, keep the centroids of its labels
+        "if(state[current] <= tolerance){\n" <<
+        "    return;\n" <<
+        "}\n" <<
+        "const uint n = counts[c];\n" <<
+        "if(n != 0){\n" <<
+        "    " << centroids_first[update_kernel.var<uint_>("c")] << " = ";
+    if(dimensions == 1){
+        update_kernel << "sums[c] / n;\n";
+    }
+    else {
+        update_kernel << "vload" << dimensions << "(c, sums) / (float) n;\n";
+    }
+    update_kernel <<
+        "}\n" <<
+        "for(uint j = 0; j < " << dimensions << "; j++){\n" <<
+        "    sums[c * " << dimensions << " + j] = 0;\n" <<
+        "}\n" <<
+        "counts[c] = 0;\n";
+
+    kernel assign = assign_kernel.compile(context);
+    assign.set_arg(assign_count_arg, static_cast<uint_>(count));
+    assign.set_arg(assign_sums_arg, sums.get_buffer());
+    assign.set_arg(assign_counts_arg, counts.get_buffer());
+    assign.set_arg(assign_state_arg, state.get_buffer());
+    assign.set_arg(assign_tolerance_arg, static_cast<uint_>(tolerance));
+
+    kernel update = update_kernel.compile(context);
+    update.set_arg(update_sums_arg, sums.get_buffer());
+    update.set_arg(update_counts_arg, counts.get_buffer());
+    update.set_arg(update_state_arg, state.get_buffer());
+    update.set_arg(update_tolerance_arg, static_cast<uint_>(tolerance));
+
+    // a few work-groups per compute unit loop over the points to amortize
+    // the privatized accumulation
+    const size_t work_groups = (std::min)(
+        (count + work_group_size - 1) / work_group_size,
+        size_t(device.compute_units()) * 16
+    );
+
+    for(size_t t = 0; t < max_iterations; t++){
+        const uint_ previous = static_cast<uint_>((t + 2) % 3);
+        const uint_ current = static_cast<uint_>(t % 3);
+        const uint_ next = static_cast<uint_>((t + 1) % 3);
+
+        assign.set_arg(assign_previous_arg, previous);
+        assign.set_arg(assign_current_arg, current);
+        queue.enqueue_1d_range_kernel(
+            assign, 0, work_groups * work_group_size, work_group_size
+        );
+
+        update.set_arg(update_previous_arg, previous);
+        update.set_arg(update_current_arg, current);
+        update.set_arg(update_next_arg, next);
+        queue.enqueue_1d_range_kernel(update, 0, clusters, 0);
+    }
+
+    return ::boost::compute::detail::read_single_value<uint_>(
+        state.get_buffer(), detail::k_means_state_iterations, queue
+    );
+}
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_K_MEANS_HPP
@@ -0,0 +1,418 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_LOAD_BALANCER_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_LOAD_BALANCER_HPP
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/assert.hpp>
+
+#include <boost/compute/event.hpp>
+#include <boost/compute/types.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/for_each.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/algorithm/detail/fused_transform_reduce.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+
+/// \class load_balancer
+/// \brief Splits algorithms dynamically between the devices of several
+///        command queues.
+///
+/// Unlike multi_queue, which gives each queue an equal part of the range,
+/// the load_balancer versions of for_each(), transform() and
+/// transform_reduce() hand out the range in chunks. Whenever a queue
+/// completes its chunk it takes the next one from the remaining elements,
+/// so a fast device (e.g. a GPU) processes more chunks than a slow one
+/// (e.g. the CPU) and neither sits idle.
+///
+/// For queues created with the \c CL_QUEUE_PROFILING_ENABLE property the
+/// throughput of each device is measured with the profiling information of
+/// the events around its chunks. Each chunk is then sized by the share of
+/// the device in the total throughput, taking half of that share of the
+/// remaining elements so the chunks get smaller towards the end of the
+/// range. The measured throughputs are kept between algorithms.
+///
+/// For example, to use both the CPU and the GPU of a system:
+/// \code
+/// std::vector<command_queue> queues;
+/// queues.push_back(command_queue(context, gpu, command_queue::enable_profiling));
+/// queues.push_back(command_queue(context, cpu, command_queue::enable_profiling));
+///
+/// experimental::load_balancer balancer(queues);
+/// experimental::transform(a.begin(), a.end(), b.begin(), sqrt<float>(), balancer);
+/// \endcode
+///
+/// \see multi_queue
+class load_balancer
+{
+public:
+    /// Creates a load balancer for \p queues. Chunks (except for the last
+    /// one) have at least \p min_chunk_size elements.
+    explicit load_balancer(const std::vector<command_queue> &queues,
+                           size_t min_chunk_size = 65536)
+        : m_queues(queues),
+          m_throughputs(queues.size(), 0.0),
+          m_min_chunk_size((std::max)(min_chunk_size, size_t(1)))
+    {
+        BOOST_ASSERT(!m_queues.empty());
+    }
+
+    /// Destroys the load balancer.
+    ~load_balancer()
+    {
+    }
+
+    /// Returns the number of queues.
+    size_t size() const
+    {
+        return m_queues.size();
+    }
+
+    /// Returns the \p n-th queue.
+    command_queue& operator[](size_t n)
+    {
+        BOOST_ASSERT(n < m_queues.size());
+
+        return m_queues[n];
+    }
+
+    /// Returns the measured throughput of the \p n-th queue in elements
+    /// per nanosecond, or zero if it was not measured yet.
+    double throughput(size_t n) const
+    {
+        BOOST_ASSERT(n < m_queues.size());
+
+        return m_throughputs[n];
+    }
+
+    /// Returns the minimum number of elements in a chunk.
+    size_t min_chunk_size() const
+    {
+        return m_min_chunk_size;
+    }
+
+    /// Returns the maximum number of chunks run() splits \p count elements
+    /// into.
+    size_t max_chunk_count(size_t count) const
+    {
+        return (count + m_min_chunk_size - 1) / m_min_chunk_size;
+    }
+
+    /// Calls \p task with a queue, the range of a chunk [begin, end) and
+    /// the index of the chunk until all \p count elements are processed
+    /// and then waits for all of the chunks. The task enqueues the work
+    /// for the chunk to the queue.
+    ///
+    /// \return the number of chunks
+    template<class Task>
+    size_t run(size_t count, Task task)
+    {
+        std::vector<event> starts(m_queues.size());
+        std::vector<event> ends(m_queues.size());
+        std::vector<size_t> sizes(m_queues.size(), 0);
+
+        size_t next = 0;
+        size_t chunks = 0;
+        size_t busy = 0;
+
+        while(next < count || busy > 0){
+            for(size_t i = 0; i < m_queues.size(); i++){
+                if(sizes[i] != 0){
+                    if(ends[i].status() != event::complete){
+                        continue;
+                    }
+
+                    update_throughput(i, starts[i], ends[i], sizes[i]);
+                    sizes[i] = 0;
+                    busy--;
+                }
+
+                if(next == count){
+                    continue;
+                }
+
+                command_queue &queue = m_queues[i];
+                const size_t size = chunk_size(i, count - next);
+
+                if(is_profiled(i)){
+                    queue.enqueue_marker(&starts[i]);
+                }
+                task(queue, next, next + size, chunks);
+                queue.enqueue_marker(&ends[i]);
+                queue.flush();
+
+                sizes[i] = size;
+                next += size;
+                chunks++;
+                busy++;
+            }
+        }
+
+        return chunks;
+    }
+
+private:
+    /// \internal_
+    bool is_profiled(size_t n) const
+    {
+        return (m_queues[n].get_properties() & command_queue::enable_profiling) != 0;
+    }
+
+    /// \internal_
+    size_t chunk_size(size_t n, size_t remaining) const
+    {
+        double total = 0;
+        size_t measured = 0;
+        for(size_t i = 0; i < m_throughputs.size(); i++){
+            if(m_throughputs[i] > 0){
+                total += m_throughputs[i];
+                measured++;
+            }
+        }
+
+        double share = 1.0 / m_queues.size();
+        if(m_throughputs[n] > 0){
+            // devices which are not measured yet count as average ones
+            total += (total / measured) * (m_queues.size() - measured);
+            share = m_throughputs[n] / total;
+        }
+        else if(is_profiled(n)){
+            // small first chunk to measure the throughput
+            return (std::min)(m_min_chunk_size, remaining);
+        }
+
+        const size_t size = static_cast<size_t>(remaining * share / 2);
+
+        return (std::min)((std::max)(size, m_min_chunk_size), remaining);
+    }
+
+    /// \internal_
+    void update_throughput(size_t n,
+                           const event &start,
+                           const event &end,
+                           size_t size)
+    {
+        if(!start.get()){
+            return;
+        }
+
+        const ulong_ begin = start.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_START);
+        const ulong_ finish = end.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_END);
+        if(finish <= begin){
+            return;
+        }
+
+        const double throughput = double(size) / double(finish - begin);
+        if(m_throughputs[n] > 0){
+            m_throughputs[n] = 0.5 * (m_throughputs[n] + throughput);
+        }
+        else {
+            m_throughputs[n] = throughput;
+        }
+    }
+
+private:
+    std::vector<command_queue> m_queues;
+    std::vector<double> m_throughputs;
+    size_t m_min_chunk_size;
+};
+
+namespace detail {
+
+template<class InputIterator, class UnaryFunction>
+struct load_balanced_for_each
+{
+    load_balanced_for_each(InputIterator first_, UnaryFunction function_)
+        : first(first_), function(function_)
+    {
+    }
+
+    void operator()(command_queue &queue, size_t begin, size_t end, size_t) const
+    {
+        ::boost::compute::for_each(first + begin, first + end, function, queue);
+    }
+
+    InputIterator first;
+    UnaryFunction function;
+};
+
+template<class InputIterator, class OutputIterator, class UnaryOperator>
+struct load_balanced_transform
+{
+    load_balanced_transform(InputIterator first_,
+                            OutputIterator result_,
+                            UnaryOperator op_)
+        : first(first_), result(result_), op(op_)
+    {
+    }
+
+    void operator()(command_queue &queue, size_t begin, size_t end, size_t) const
+    {
+        ::boost::compute::transform(
+            first + begin, first + end, result + begin, op, queue
+        );
+    }
+
+    InputIterator first;
+    OutputIterator result;
+    UnaryOperator op;
+};
+
+template<class InputIterator,
+         class UnaryTransformFunction,
+         class BinaryReduceFunction,
+         class T>
+struct load_balanced_transform_reduce
+{
+    load_balanced_transform_reduce(InputIterator first_,
+                                   UnaryTransformFunction transform_function_,
+                                   BinaryReduceFunction reduce_function_,
+                                   buffer_iterator<T> partials_)
+        : first(first_),
+          transform_function(transform_function_),
+          reduce_function(reduce_function_),
+          partials(partials_)
+    {
+    }
+
+    void operator()(command_queue &queue,
+                    size_t begin,
+                    size_t end,
+                    size_t chunk) const
+    {
+        ::boost::compute::detail::fused_transform_reduce(
+            first + begin,
+            end - begin,
+            transform_function,
+            reduce_function,
+            partials + chunk,
+            queue
+        );
+    }
+
+    InputIterator first;
+    UnaryTransformFunction transform_function;
+    BinaryReduceFunction reduce_function;
+    buffer_iterator<T> partials;
+};
+
+} // end detail namespace
+
+/// Calls \p function on each element in the range [\p first, \p last),
+/// splitting the range between the queues of \p balancer.
+///
+/// \see boost::compute::for_each()
+template<class InputIterator, class UnaryFunction>
+inline UnaryFunction for_each(InputIterator first,
+                              InputIterator last,
+                              UnaryFunction function,
+                              load_balancer &balancer)
+{
+    const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+
+    balancer.run(
+        count,
+        detail::load_balanced_for_each<InputIterator, UnaryFunction>(first, function)
+    );
+
+    return function;
+}
+
+/// Transforms the elements in the range [\p first, \p last) using \p op
+/// and stores the results in the range beginning at \p result, splitting
+/// the range between the queues of \p balancer.
+///
+/// \see boost::compute::transform()
+template<class InputIterator, class OutputIterator, class UnaryOperator>
+inline OutputIterator transform(InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                UnaryOperator op,
+                                load_balancer &balancer)
+{
+    const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+
+    balancer.run(
+        count,
+        detail::load_balanced_transform<
+            InputIterator, OutputIterator, UnaryOperator
+        >(first, result, op)
+    );
+
+    return result + count;
+}
+
+/// Transforms each value in the range [\p first, \p last) with
+/// \p transform_function and then reduces the transformed values with
+/// \p reduce_function, splitting the range between the queues of
+/// \p balancer. The result of each chunk is stored on the device and the
+/// results of the chunks are reduced with the first queue.
+///
+/// \see boost::compute::transform_reduce()
+template<class InputIterator,
+         class OutputIterator,
+         class UnaryTransformFunction,
+         class BinaryReduceFunction>
+inline void transform_reduce(InputIterator first,
+                             InputIterator last,
+                             OutputIterator result,
+                             UnaryTransformFunction transform_function,
+                             BinaryReduceFunction reduce_function,
+                             load_balancer &balancer)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        boost::compute::result_of<UnaryTransformFunction(value_type)>::type
+        transform_type;
+    typedef typename
+        boost::compute::result_of<BinaryReduceFunction(transform_type, transform_type)>::type
+        result_type;
+
+    const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    command_queue &queue = balancer[0];
+    ::boost::compute::vector<result_type> partials(
+        balancer.max_chunk_count(count), queue.get_context()
+    );
+
+    const size_t chunks = balancer.run(
+        count,
+        detail::load_balanced_transform_reduce<
+            InputIterator,
+            UnaryTransformFunction,
+            BinaryReduceFunction,
+            result_type
+        >(first, transform_function, reduce_function, partials.begin())
+    );
+
+    ::boost::compute::reduce(
+        partials.begin(), partials.begin() + chunks, result, reduce_function, queue
+    );
+}
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_LOAD_BALANCER_HPP
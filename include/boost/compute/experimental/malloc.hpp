@@ -15,6 +15,7 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/context.hpp>
 #include <boost/compute/detail/device_ptr.hpp>
+#include <boost/compute/utility/buffer_arena.hpp>
 
 namespace boost {
 namespace compute {
@@ -23,11 +24,17 @@ namespace experimental {
 // bring device_ptr into the experimental namespace
 using detail::device_ptr;
 
+// small allocations are carved out of the global buffer_arena of the
+// context instead of creating a memory object for each of them
 template<class T>
 inline device_ptr<T>
 malloc(std::size_t size, const context &context = system::default_context())
 {
+#ifdef CL_VERSION_1_1
+    buffer buf = buffer_arena::get_global_arena(context)->allocate(size * sizeof(T));
+#else
     buffer buf(context, size * sizeof(T));
+#endif
     clRetainMemObject(buf.get());
     return device_ptr<T>(buf);
 }
@@ -41,7 +48,13 @@ malloc(std::size_t size, const context &context = system::default_context())
 template<class T>
 inline void free(device_ptr<T> &ptr)
 {
+#ifdef CL_VERSION_1_1
+    // take ownership of the reference retained in malloc()
+    buffer buf(ptr.get_buffer().get(), false);
+    buffer_arena::get_global_arena(buf.get_context())->release(buf);
+#else
     clReleaseMemObject(ptr.get_buffer().get());
+#endif
 }
 
 } // end experimental namespace
@@ -0,0 +1,402 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_MULTI_QUEUE_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_MULTI_QUEUE_HPP
+
+#include <vector>
+#include <iterator>
+
+#include <boost/assert.hpp>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/merge.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/utility/prefetch.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+
+/// \class multi_queue
+/// \brief A set of command queues which algorithms are split across.
+///
+/// The multi_queue versions of copy(), transform(), reduce() and sort()
+/// split their range into one contiguous part per queue, run the algorithm
+/// on each part with its queue and then combine the results (e.g. the sums
+/// of the parts are reduced again and the sorted parts are merged). This
+/// lets one algorithm use all of the devices in a context. With OpenCL 1.2,
+/// transform(), reduce() and sort() migrate the buffer of their input to
+/// every device (see prefetch()) before launching the parts.
+///
+/// All of the queues must belong to the same context so that the buffers
+/// can be used by all of them. The algorithms block until every queue is
+/// done.
+///
+/// For example, to sort a vector with all of the GPUs in a context:
+/// \code
+/// boost::compute::experimental::multi_queue queues(context);
+///
+/// boost::compute::experimental::sort(vec.begin(), vec.end(), queues);
+/// \endcode
+class multi_queue
+{
+public:
+    /// Creates a multi-queue with one in-order queue for each device in
+    /// \p context.
+    explicit multi_queue(const context &context)
+    {
+        const std::vector<device> devices = context.get_devices();
+        for(size_t i = 0; i < devices.size(); i++){
+            m_queues.push_back(command_queue(context, devices[i]));
+        }
+    }
+
+    /// Creates a multi-queue for \p queues.
+    explicit multi_queue(const std::vector<command_queue> &queues)
+        : m_queues(queues)
+    {
+        BOOST_ASSERT(!m_queues.empty());
+    }
+
+    /// Destroys the multi-queue.
+    ~multi_queue()
+    {
+    }
+
+    /// Returns the number of queues.
+    size_t size() const
+    {
+        return m_queues.size();
+    }
+
+    /// Returns the \p n-th queue.
+    command_queue& operator[](size_t n)
+    {
+        BOOST_ASSERT(n < m_queues.size());
+
+        return m_queues[n];
+    }
+
+    /// Returns the offset of the \p n-th of the parts \p count elements are
+    /// split into. The part of queue \c n is [\c offset(n), \c offset(n+1)).
+    size_t offset(size_t count, size_t n) const
+    {
+        const size_t parts = m_queues.size();
+
+        return (count / parts) * n + (std::min)(n, count % parts);
+    }
+
+    /// Blocks until all of the commands in all of the queues are complete.
+    void finish()
+    {
+        for(size_t i = 0; i < m_queues.size(); i++){
+            m_queues[i].finish();
+        }
+    }
+
+private:
+    std::vector<command_queue> m_queues;
+};
+
+namespace detail {
+
+// migrates the buffer of [first, last) to the device of each queue before
+// the parts of an algorithm are launched, so that the first kernel of each
+// device does not stall while the buffer is moved. the migrations are
+// ordered before the kernels by the (in-order) queues themselves, so the
+// host does not wait for them.
+template<class T>
+inline void multi_queue_prefetch(buffer_iterator<T> first,
+                                 buffer_iterator<T> last,
+                                 multi_queue &queues)
+{
+    #ifdef CL_VERSION_1_2
+    if(queues.size() < 2){
+        return;
+    }
+
+    for(size_t i = 0; i < queues.size(); i++){
+        ::boost::compute::prefetch(first, last, queues[i]);
+    }
+    #else
+    (void) first;
+    (void) last;
+    (void) queues;
+    #endif
+}
+
+// other iterators do not refer to a single buffer
+template<class Iterator>
+inline void multi_queue_prefetch(Iterator first,
+                                 Iterator last,
+                                 multi_queue &queues)
+{
+    (void) first;
+    (void) last;
+    (void) queues;
+}
+
+// merges each pair of adjacent sorted runs of input (given by the offsets
+// in bounds) into output and updates bounds to the merged runs. the pairs
+// are merged on different queues.
+template<class InputIterator, class OutputIterator, class Compare>
+inline void multi_queue_merge_pass(InputIterator input,
+                                   OutputIterator output,
+                                   std::vector<size_t> &bounds,
+                                   Compare compare,
+                                   multi_queue &queues)
+{
+    std::vector<size_t> merged;
+    merged.push_back(0);
+
+    size_t pair = 0;
+    for(size_t i = 0; i + 1 < bounds.size(); i += 2, pair++){
+        command_queue &queue = queues[pair % queues.size()];
+
+        if(i + 2 < bounds.size()){
+            ::boost::compute::merge(
+                input + bounds[i], input + bounds[i+1],
+                input + bounds[i+1], input + bounds[i+2],
+                output + bounds[i],
+                compare,
+                queue
+            );
+            merged.push_back(bounds[i+2]);
+        }
+        else {
+            // odd run without a partner
+            ::boost::compute::copy(
+                input + bounds[i], input + bounds[i+1], output + bounds[i], queue
+            );
+            merged.push_back(bounds[i+1]);
+        }
+    }
+
+    queues.finish();
+    bounds.swap(merged);
+}
+
+} // end detail namespace
+
+/// Copies the values in the range [\p first, \p last) to the range
+/// beginning at \p result with one copy_async() per queue in \p queues.
+///
+/// The iterators must be supported by copy_async().
+///
+/// \see boost::compute::copy()
+template<class InputIterator, class OutputIterator>
+inline OutputIterator copy(InputIterator first,
+                           InputIterator last,
+                           OutputIterator result,
+                           multi_queue &queues)
+{
+    const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+
+    std::vector<future<OutputIterator> > futures;
+    for(size_t i = 0; i < queues.size(); i++){
+        const size_t begin = queues.offset(count, i);
+        const size_t end = queues.offset(count, i + 1);
+        if(begin == end){
+            continue;
+        }
+
+        futures.push_back(
+            ::boost::compute::copy_async(
+                first + begin, first + end, result + begin, queues[i]
+            )
+        );
+    }
+    for(size_t i = 0; i < futures.size(); i++){
+        futures[i].wait();
+    }
+
+    return result + count;
+}
+
+/// Transforms the elements in the range [\p first, \p last) using \p op
+/// and stores the results in the range beginning at \p result. Each queue
+/// in \p queues transforms one part of the range.
+///
+/// \see boost::compute::transform()
+template<class InputIterator, class OutputIterator, class UnaryOperator>
+inline OutputIterator transform(InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                UnaryOperator op,
+                                multi_queue &queues)
+{
+    const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+
+    detail::multi_queue_prefetch(first, last, queues);
+
+    for(size_t i = 0; i < queues.size(); i++){
+        const size_t begin = queues.offset(count, i);
+        const size_t end = queues.offset(count, i + 1);
+        if(begin == end){
+            continue;
+        }
+
+        ::boost::compute::transform(
+            first + begin, first + end, result + begin, op, queues[i]
+        );
+    }
+    queues.finish();
+
+    return result + count;
+}
+
+/// Reduces the elements in the range [\p first, \p last) with \p function
+/// and stores the result in \p result. Each queue in \p queues reduces one
+/// part of the range on the device and the results of the parts are then
+/// reduced with the first queue.
+///
+/// \see boost::compute::reduce()
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void reduce(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   BinaryFunction function,
+                   multi_queue &queues)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    ::boost::compute::vector<T> partials(queues.size(), queues[0].get_context());
+
+    detail::multi_queue_prefetch(first, last, queues);
+
+    size_t parts = 0;
+    for(size_t i = 0; i < queues.size(); i++){
+        const size_t begin = queues.offset(count, i);
+        const size_t end = queues.offset(count, i + 1);
+        if(begin == end){
+            continue;
+        }
+
+        ::boost::compute::reduce_async(
+            first + begin, first + end, partials.begin() + parts, function, queues[i]
+        );
+        parts++;
+    }
+    queues.finish();
+
+    ::boost::compute::reduce(
+        partials.begin(), partials.begin() + parts, result, function, queues[0]
+    );
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline void reduce(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   multi_queue &queues)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    ::boost::compute::experimental::reduce(first, last, result, plus<T>(), queues);
+}
+
+/// Sorts the values in the range [\p first, \p last) according to
+/// \p compare. Each queue in \p queues sorts one part of the range and the
+/// sorted parts are then merged pairwise, again spread over the queues.
+///
+/// The merges need a temporary buffer of the size of the range.
+///
+/// \see boost::compute::sort()
+template<class Iterator, class Compare>
+inline void sort(Iterator first,
+                 Iterator last,
+                 Compare compare,
+                 multi_queue &queues)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+
+    const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+    if(count < 2){
+        return;
+    }
+
+    detail::multi_queue_prefetch(first, last, queues);
+
+    std::vector<size_t> bounds;
+    bounds.push_back(0);
+    for(size_t i = 0; i < queues.size(); i++){
+        const size_t begin = queues.offset(count, i);
+        const size_t end = queues.offset(count, i + 1);
+        if(begin == end){
+            continue;
+        }
+
+        ::boost::compute::sort_async(
+            first + begin, first + end, compare, queues[i]
+        );
+        bounds.push_back(end);
+    }
+    queues.finish();
+
+    if(bounds.size() <= 2){
+        return;
+    }
+
+    // merge the sorted parts back and forth between the range and the
+    // temporary buffer until only one run is left
+    ::boost::compute::vector<T> temp(count, queues[0].get_context());
+
+    bool in_temp = false;
+    while(bounds.size() > 2){
+        if(in_temp){
+            detail::multi_queue_merge_pass(
+                temp.begin(), first, bounds, compare, queues
+            );
+        }
+        else {
+            detail::multi_queue_merge_pass(
+                first, temp.begin(), bounds, compare, queues
+            );
+        }
+        in_temp = !in_temp;
+    }
+
+    if(in_temp){
+        ::boost::compute::copy(temp.begin(), temp.end(), first, queues[0]);
+        queues[0].finish();
+    }
+}
+
+/// \overload
+template<class Iterator>
+inline void sort(Iterator first, Iterator last, multi_queue &queues)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+
+    ::boost::compute::experimental::sort(first, last, less<T>(), queues);
+}
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_MULTI_QUEUE_HPP
@@ -0,0 +1,151 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_NUMA_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_NUMA_HPP
+
+#include <vector>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/types.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/allocator/buffer_allocator.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/experimental/multi_queue.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/constant_iterator.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+
+/// Returns one sub-device of \p device for each of its NUMA nodes.
+///
+/// If the device can not be partitioned by NUMA node (e.g. it is a GPU, or
+/// a CPU with a single node, or the platform is older than OpenCL 1.2) a
+/// vector with only \p device is returned.
+///
+/// \see device::partition_by_affinity_domain()
+inline std::vector<device> numa_nodes(const device &device)
+{
+    #ifdef CL_VERSION_1_2
+    if(device.supports_affinity_domain(CL_DEVICE_AFFINITY_DOMAIN_NUMA)){
+        std::vector<boost::compute::device> nodes =
+            device.partition_by_affinity_domain(CL_DEVICE_AFFINITY_DOMAIN_NUMA);
+        if(!nodes.empty()){
+            return nodes;
+        }
+    }
+    #endif // CL_VERSION_1_2
+
+    return std::vector<boost::compute::device>(1, device);
+}
+
+/// Returns a context for the NUMA nodes of \p device (see numa_nodes()).
+///
+/// A multi_queue created from this context has one queue for each node, so
+/// the multi_queue algorithms run the part of a range of each node on the
+/// cores of that node. Together with numa_allocator, which places the
+/// memory of each part on the same node, the kernels only read local
+/// memory:
+/// \code
+/// context numa = experimental::numa_context(cpu);
+/// experimental::multi_queue queues(numa);
+///
+/// vector<float, experimental::numa_allocator<float> > a(n, numa);
+/// vector<float, experimental::numa_allocator<float> > b(n, numa);
+/// experimental::transform(a.begin(), a.end(), b.begin(), sqrt<float>(), queues);
+/// \endcode
+inline context numa_context(const device &device)
+{
+    return context(numa_nodes(device));
+}
+
+/// \class numa_allocator
+/// \brief An allocator which places the memory of each part of a buffer on
+///        the NUMA node which processes it.
+///
+/// The allocated buffer is split into one part for each device of the
+/// context in the same way as the multi_queue algorithms split their
+/// ranges (see multi_queue::offset()). Each part is then written once
+/// with a kernel running on its device. CPU OpenCL implementations place
+/// pages on the node which touches them first, so each part ends up in
+/// the memory of the node whose cores later run the kernels for it.
+///
+/// The context should be created with numa_context().
+///
+/// \see numa_context(), multi_queue
+template<class T>
+class numa_allocator : public buffer_allocator<T>
+{
+public:
+    typedef typename buffer_allocator<T>::pointer pointer;
+    typedef typename buffer_allocator<T>::size_type size_type;
+
+    explicit numa_allocator(const context &context)
+        : buffer_allocator<T>(context),
+          m_queues(context)
+    {
+    }
+
+    numa_allocator(const numa_allocator<T> &other)
+        : buffer_allocator<T>(other),
+          m_queues(other.m_queues)
+    {
+    }
+
+    numa_allocator<T>& operator=(const numa_allocator<T> &other)
+    {
+        if(this != &other){
+            buffer_allocator<T>::operator=(other);
+            m_queues = other.m_queues;
+        }
+
+        return *this;
+    }
+
+    ~numa_allocator()
+    {
+    }
+
+    pointer allocate(size_type n)
+    {
+        pointer ptr = buffer_allocator<T>::allocate(n);
+
+        // first touch of each part on its node
+        for(size_t i = 0; i < m_queues.size(); i++){
+            const size_t begin = m_queues.offset(n, i) * sizeof(T);
+            const size_t end = m_queues.offset(n, i + 1) * sizeof(T);
+            if(begin == end){
+                continue;
+            }
+
+            ::boost::compute::copy_n(
+                make_constant_iterator<uchar_>(0),
+                end - begin,
+                make_buffer_iterator<uchar_>(ptr.get_buffer(), begin),
+                m_queues[i]
+            );
+        }
+        m_queues.finish();
+
+        return ptr;
+    }
+
+private:
+    multi_queue m_queues;
+};
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_NUMA_HPP
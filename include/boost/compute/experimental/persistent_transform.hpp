@@ -0,0 +1,348 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_PERSISTENT_TRANSFORM_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_PERSISTENT_TRANSFORM_HPP
+
+#include <boost/config.hpp>
+
+#include <boost/compute/cl.hpp>
+
+// persistent kernels require opencl 2.0 svm atomics on the device and
+// c++11 atomics on the host
+#if defined(CL_VERSION_2_0) && !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+
+#include <new>
+#include <atomic>
+#include <thread>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/compute/svm.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/memory/svm_ptr.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+
+/// \class persistent_transform
+/// \brief Transforms batches of values with a kernel which keeps running.
+///
+/// Launching kernels for each batch of a continuous stream of small
+/// batches (e.g. every few hundred microseconds) can cost more than the
+/// work itself. The persistent_transform class instead launches a single
+/// kernel which waits for batches in a ring of \c slot_count() slots in
+/// fine-grained shared virtual memory (SVM). The host copies each batch to
+/// a slot with push() and signals the kernel with an SVM atomic, the
+/// kernel transforms the batch into the output values of the slot and
+/// signals the host, which reads them with pop(). No commands are enqueued
+/// while the kernel runs.
+///
+/// \code
+/// boost::compute::experimental::persistent_transform<float, float>
+///     processor(boost::compute::lambda::_1 * 2.0f, 4096, 4, queue);
+///
+/// processor.push(ticks.begin(), ticks.end());
+/// processor.pop(results.begin());
+/// \endcode
+///
+/// The kernel runs one work-group per compute unit, which must all be
+/// resident on the device at once. The device must support fine-grained
+/// buffer SVM with atomics (see is_supported()), the kernel is stopped
+/// (after processing the batches pushed so far) by stop() or the
+/// destructor.
+///
+/// \opencl_version_warning{2,0}
+///
+/// \see svm_ptr, streaming_executor
+template<class T, class Result>
+class persistent_transform : boost::noncopyable
+{
+    BOOST_STATIC_ASSERT(sizeof(std::atomic<uint_>) == sizeof(uint_));
+
+    // indices of the values of the control block
+    enum {
+        published_index,  // batches pushed by the host
+        consumed_index,   // batches transformed by the kernel
+        stop_index,       // non-zero once the host stopped the kernel
+        finished_index,   // work-groups finished with their batch
+        control_size
+    };
+
+public:
+    /// Launches a kernel on \p queue which transforms the batches of up
+    /// to \p batch_capacity values pushed to one of \p slot_count slots
+    /// with \p function.
+    ///
+    /// Throws \c std::runtime_error if the device of \p queue does not
+    /// support fine-grained buffer SVM with atomics.
+    template<class Function>
+    persistent_transform(Function function,
+                         size_t batch_capacity,
+                         size_t slot_count,
+                         command_queue &queue)
+        : m_queue(queue),
+          m_capacity(batch_capacity),
+          m_slot_count(slot_count),
+          m_pushed(0),
+          m_popped(0),
+          m_running(false)
+    {
+        BOOST_ASSERT(batch_capacity > 0);
+        BOOST_ASSERT(slot_count > 0);
+
+        const context &context = queue.get_context();
+        const device &device = queue.get_device();
+
+        if(!is_supported(device)){
+            BOOST_THROW_EXCEPTION(
+                std::runtime_error("device does not support svm atomics")
+            );
+        }
+
+        const cl_svm_mem_flags flags =
+            CL_MEM_READ_WRITE | CL_MEM_SVM_FINE_GRAIN_BUFFER | CL_MEM_SVM_ATOMICS;
+
+        m_input = svm_alloc<T>(context, m_capacity * m_slot_count, flags);
+        m_output = svm_alloc<Result>(context, m_capacity * m_slot_count, flags);
+        m_sizes = svm_alloc<uint_>(context, m_slot_count, flags);
+        m_control = svm_alloc<uint_>(context, control_size, flags);
+
+        for(size_t i = 0; i < control_size; i++){
+            new (control(i)) std::atomic<uint_>(0);
+        }
+
+        launch(function);
+    }
+
+    /// Stops the kernel and frees the ring.
+    ~persistent_transform()
+    {
+        stop();
+
+        const context &context = m_queue.get_context();
+        svm_free(context, m_input);
+        svm_free(context, m_output);
+        svm_free(context, m_sizes);
+        svm_free(context, m_control);
+    }
+
+    /// Returns the maximum number of values in a batch.
+    size_t batch_capacity() const
+    {
+        return m_capacity;
+    }
+
+    /// Returns the number of slots in the ring.
+    size_t slot_count() const
+    {
+        return m_slot_count;
+    }
+
+    /// Copies the values in [\p first, \p last) to the next slot and
+    /// signals the kernel to transform them.
+    ///
+    /// A slot is reused once its results have been popped, so at most
+    /// \c slot_count() batches may be pending.
+    template<class InputIterator>
+    void push(InputIterator first, InputIterator last)
+    {
+        const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+        BOOST_ASSERT(count <= m_capacity);
+        BOOST_ASSERT(m_running);
+
+        // every slot holds a batch whose results have not been popped yet
+        BOOST_ASSERT(m_pushed - m_popped < m_slot_count);
+
+        const size_t slot = m_pushed % m_slot_count;
+        std::copy(first, last, static_cast<T *>(m_input.get()) + slot * m_capacity);
+        sizes()[slot] = static_cast<uint_>(count);
+
+        m_pushed++;
+        control(published_index)->store(
+            static_cast<uint_>(m_pushed), std::memory_order_release
+        );
+    }
+
+    /// Waits until the oldest batch which has not been popped is
+    /// transformed and copies its results to \p result.
+    template<class OutputIterator>
+    OutputIterator pop(OutputIterator result)
+    {
+        BOOST_ASSERT(m_popped < m_pushed);
+
+        const uint_ batch = static_cast<uint_>(m_popped + 1);
+        while(static_cast<int_>(
+                  control(consumed_index)->load(std::memory_order_acquire) - batch) < 0){
+            std::this_thread::yield();
+        }
+
+        const size_t slot = m_popped % m_slot_count;
+        const Result *values = static_cast<Result *>(m_output.get()) + slot * m_capacity;
+
+        m_popped++;
+
+        return std::copy(values, values + sizes()[slot], result);
+    }
+
+    /// Returns the number of batches pushed which have not been popped.
+    size_t pending() const
+    {
+        return m_pushed - m_popped;
+    }
+
+    /// Stops the kernel after it transformed the batches pushed so far and
+    /// waits for it to finish.
+    void stop()
+    {
+        if(!m_running){
+            return;
+        }
+
+        control(stop_index)->store(1, std::memory_order_release);
+        m_event.wait();
+        m_running = false;
+    }
+
+    /// Returns \c true if \p device supports the fine-grained buffer SVM
+    /// with atomics persistent kernels require.
+    static bool is_supported(const device &device)
+    {
+        if(device.check_version(2, 0) == false){
+            return false;
+        }
+
+        const cl_device_svm_capabilities capabilities =
+            device.get_info<cl_device_svm_capabilities>(CL_DEVICE_SVM_CAPABILITIES);
+
+        return (capabilities & CL_DEVICE_SVM_FINE_GRAIN_BUFFER) != 0 &&
+               (capabilities & CL_DEVICE_SVM_ATOMICS) != 0;
+    }
+
+private:
+    std::atomic<uint_>* control(size_t index) const
+    {
+        return reinterpret_cast<std::atomic<uint_> *>(
+            static_cast<uint_ *>(m_control.get()) + index
+        );
+    }
+
+    uint_* sizes() const
+    {
+        return static_cast<uint_ *>(m_sizes.get());
+    }
+
+    template<class Function>
+    void launch(Function function)
+    {
+        const device &device = m_queue.get_device();
+
+        const size_t work_group_size =
+            ::boost::compute::detail::get_work_group_size_parameter(
+                device, "__boost_persistent_transform", "wgs", 256
+            );
+        const size_t groups = (std::max)(device.compute_units(), uint_(1));
+
+        ::boost::compute::detail::meta_kernel k("persistent_transform");
+        size_t input_arg = k.add_arg<const T *>(memory_object::global_memory, "input");
+        size_t output_arg = k.add_arg<Result *>(memory_object::global_memory, "output");
+        size_t sizes_arg = k.add_arg<const uint_ *>(memory_object::global_memory, "sizes");
+        size_t control_arg = k.add_arg<uint_ *>(memory_object::global_memory, "control_values");
+        k.add_set_arg<const uint_>("capacity", static_cast<uint_>(m_capacity));
+        k.add_set_arg<const uint_>("slots", static_cast<uint_>(m_slot_count));
+
+        k <<
+            "__global atomic_uint *control = (__global atomic_uint *) control_values;\n" <<
+            "__local uint published;\n" <<
+            "const uint groups = get_num_groups(0);\n" <<
+            "uint consumed = 0;\n" <<
+            "for(;;){\n" <<
+            // the first work-item waits for a batch or for the host to stop
+            // the kernel (after the batches pushed before have been done)
+            "    if(get_local_id(0) == 0){\n" <<
+            "        uint p;\n" <<
+            "        while((p = atomic_load_explicit(&control[" << int(published_index) << "],\n" <<
+            "                   memory_order_acquire, memory_scope_all_svm_devices)) == consumed &&\n" <<
+            "              atomic_load_explicit(&control[" << int(stop_index) << "],\n" <<
+            "                   memory_order_acquire, memory_scope_all_svm_devices) == 0){\n" <<
+            "        }\n" <<
+            "        published = p;\n" <<
+            "    }\n" <<
+            "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+            "    if(published == consumed){\n" <<
+            "        break;\n" <<
+            "    }\n" <<
+            "    const uint slot = consumed % slots;\n" <<
+            "    const uint count = sizes[slot];\n" <<
+            "    for(uint i = get_global_id(0); i < count; i += get_global_size(0)){\n" <<
+            "        const uint j = slot * capacity + i;\n" <<
+            "        output[j] = " << function(k.var<const T>("input[j]")) << ";\n" <<
+            "    }\n" <<
+            "    barrier(CLK_GLOBAL_MEM_FENCE | CLK_LOCAL_MEM_FENCE);\n" <<
+            "    consumed++;\n" <<
+            // the last work-group to finish the batch signals the host
+            "    if(get_local_id(0) == 0){\n" <<
+            "        const uint finished = atomic_fetch_add_explicit(&control[" << int(finished_index) << "], 1u,\n" <<
+            "                                  memory_order_acq_rel, memory_scope_all_svm_devices) + 1;\n" <<
+            "        if(finished == consumed * groups){\n" <<
+            "            atomic_store_explicit(&control[" << int(consumed_index) << "], consumed,\n" <<
+            "                                  memory_order_release, memory_scope_all_svm_devices);\n" <<
+            "        }\n" <<
+            "    }\n" <<
+            "}\n";
+
+        kernel kernel = k.compile(m_queue.get_context(), "-cl-std=CL2.0");
+        kernel.set_arg(input_arg, m_input);
+        kernel.set_arg(output_arg, m_output);
+        kernel.set_arg(sizes_arg, m_sizes);
+        kernel.set_arg(control_arg, m_control);
+
+        m_event = m_queue.enqueue_1d_range_kernel_async(
+            kernel, 0, groups * work_group_size, work_group_size
+        );
+        m_queue.flush();
+        m_running = true;
+    }
+
+private:
+    command_queue m_queue;
+    size_t m_capacity;
+    size_t m_slot_count;
+    size_t m_pushed;
+    size_t m_popped;
+    bool m_running;
+    svm_ptr<T> m_input;
+    svm_ptr<Result> m_output;
+    svm_ptr<uint_> m_sizes;
+    svm_ptr<uint_> m_control;
+    event m_event;
+};
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // CL_VERSION_2_0 && !BOOST_NO_CXX11_HDR_ATOMIC
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_PERSISTENT_TRANSFORM_HPP
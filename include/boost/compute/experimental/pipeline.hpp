@@ -0,0 +1,288 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_PIPELINE_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_PIPELINE_HPP
+
+#include <iterator>
+
+#include <boost/tuple/tuple.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/copy_if.hpp>
+#include <boost/compute/algorithm/count_if.hpp>
+#include <boost/compute/algorithm/transform_reduce.hpp>
+#include <boost/compute/algorithm/detail/fused_transform_reduce.hpp>
+#include <boost/compute/functional/detail/unpack.hpp>
+#include <boost/compute/iterator/transform_iterator.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+
+template<class Iterator, class Predicate>
+class filtered_pipeline;
+
+/// \class pipeline
+/// \brief A lazily evaluated sequence of element-wise operations.
+///
+/// Each stage added to a pipeline (e.g. with transform()) only wraps the
+/// iterators of the previous stage, no kernel is executed until one of the
+/// terminal algorithms (copy(), reduce(), etc.) is called. All stages are
+/// then fused into the kernel of the terminal algorithm and every value of
+/// the input is read once without storing any of the intermediate values.
+///
+/// For example, to sum the squares of the absolute differences of two
+/// vectors:
+/// \code
+/// using boost::compute::lambda::_1;
+///
+/// float sum = 0;
+/// make_pipeline(a.begin(), a.end())
+///     .transform(b.begin(), minus<float>())
+///     .transform(fabs<float>())
+///     .transform(_1 * _1)
+///     .reduce(&sum, queue);
+/// \endcode
+///
+/// \see make_pipeline(), filtered_pipeline
+template<class Iterator>
+class pipeline
+{
+public:
+    typedef Iterator iterator;
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    /// Creates a new pipeline for the values in the range
+    /// [\p first, \p last).
+    pipeline(Iterator first, Iterator last)
+        : m_first(first),
+          m_last(last)
+    {
+    }
+
+    /// Returns an iterator to the first value of the pipeline.
+    Iterator begin() const
+    {
+        return m_first;
+    }
+
+    /// Returns an iterator one past the last value of the pipeline.
+    Iterator end() const
+    {
+        return m_last;
+    }
+
+    /// Returns the number of values in the pipeline.
+    size_t size() const
+    {
+        return detail::iterator_range_size(m_first, m_last);
+    }
+
+    /// Returns a new pipeline applying \p function to each value.
+    template<class UnaryFunction>
+    pipeline<transform_iterator<Iterator, UnaryFunction> >
+    transform(UnaryFunction function) const
+    {
+        return pipeline<transform_iterator<Iterator, UnaryFunction> >(
+            ::boost::compute::make_transform_iterator(m_first, function),
+            ::boost::compute::make_transform_iterator(m_last, function)
+        );
+    }
+
+    /// Returns a new pipeline applying \p function to each value and the
+    /// corresponding value in the range beginning at \p first2.
+    template<class InputIterator, class BinaryFunction>
+    pipeline<
+        transform_iterator<
+            zip_iterator<boost::tuple<Iterator, InputIterator> >,
+            detail::unpacked<BinaryFunction>
+        >
+    >
+    transform(InputIterator first2, BinaryFunction function) const
+    {
+        typedef typename
+            std::iterator_traits<InputIterator>::difference_type difference_type;
+
+        const difference_type n = static_cast<difference_type>(size());
+
+        return pipeline<
+                   transform_iterator<
+                       zip_iterator<boost::tuple<Iterator, InputIterator> >,
+                       detail::unpacked<BinaryFunction>
+                   >
+               >(
+                   ::boost::compute::make_transform_iterator(
+                       ::boost::compute::make_zip_iterator(
+                           boost::make_tuple(m_first, first2)
+                       ),
+                       detail::unpack(function)
+                   ),
+                   ::boost::compute::make_transform_iterator(
+                       ::boost::compute::make_zip_iterator(
+                           boost::make_tuple(m_last, first2 + n)
+                       ),
+                       detail::unpack(function)
+                   )
+               );
+    }
+
+    /// Returns a new pipeline with the values for which \p predicate
+    /// returns \c true.
+    template<class Predicate>
+    filtered_pipeline<Iterator, Predicate> filter(Predicate predicate) const
+    {
+        return filtered_pipeline<Iterator, Predicate>(m_first, m_last, predicate);
+    }
+
+    /// Evaluates the pipeline and stores the values in the range beginning
+    /// at \p result.
+    template<class OutputIterator>
+    OutputIterator copy(OutputIterator result,
+                        command_queue &queue = system::default_queue()) const
+    {
+        return ::boost::compute::copy(m_first, m_last, result, queue);
+    }
+
+    /// Evaluates the pipeline and reduces the values with \p function to
+    /// \p result.
+    ///
+    /// As with \c reduce(), \p function is assumed to be associative.
+    template<class OutputIterator, class BinaryFunction>
+    void reduce(OutputIterator result,
+                BinaryFunction function,
+                command_queue &queue = system::default_queue()) const
+    {
+        ::boost::compute::transform_reduce(
+            m_first, m_last, result, identity<value_type>(), function, queue
+        );
+    }
+
+    /// \overload
+    template<class OutputIterator>
+    void reduce(OutputIterator result,
+                command_queue &queue = system::default_queue()) const
+    {
+        reduce(result, plus<value_type>(), queue);
+    }
+
+    /// Evaluates the pipeline and returns the number of values for which
+    /// \p predicate returns \c true.
+    template<class Predicate>
+    size_t count_if(Predicate predicate,
+                    command_queue &queue = system::default_queue()) const
+    {
+        return ::boost::compute::count_if(m_first, m_last, predicate, queue);
+    }
+
+private:
+    Iterator m_first;
+    Iterator m_last;
+};
+
+/// \class filtered_pipeline
+/// \brief The values of a pipeline selected by a predicate.
+///
+/// The terminal algorithms of a filtered pipeline evaluate the predicate
+/// along with the stages of the pipeline in a single pass over the input.
+///
+/// \see pipeline::filter()
+template<class Iterator, class Predicate>
+class filtered_pipeline
+{
+public:
+    typedef Iterator iterator;
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    /// Creates a new filtered pipeline for the values in the range
+    /// [\p first, \p last) for which \p predicate returns \c true.
+    filtered_pipeline(Iterator first, Iterator last, Predicate predicate)
+        : m_first(first),
+          m_last(last),
+          m_predicate(predicate)
+    {
+    }
+
+    /// Evaluates the pipeline and stores the selected values in the range
+    /// beginning at \p result. Returns an iterator to the end of the
+    /// stored values.
+    template<class OutputIterator>
+    OutputIterator copy(OutputIterator result,
+                        command_queue &queue = system::default_queue()) const
+    {
+        return ::boost::compute::copy_if(
+            m_first, m_last, result, m_predicate, queue
+        );
+    }
+
+    /// Evaluates the pipeline and returns the result of reducing \p init
+    /// and the selected values with \p function.
+    ///
+    /// Unlike \c accumulate(), the values are reduced in parallel and in
+    /// an unspecified order, so \p function must be associative and
+    /// commutative.
+    template<class T, class BinaryFunction>
+    T accumulate(T init,
+                 BinaryFunction function,
+                 command_queue &queue = system::default_queue()) const
+    {
+        detail::scratch_vector<T> result(1, queue);
+        detail::fused_transform_reduce_if(m_first,
+                                          detail::iterator_range_size(m_first, m_last),
+                                          identity<value_type>(),
+                                          m_predicate,
+                                          function,
+                                          init,
+                                          result.begin(),
+                                          queue);
+
+        return detail::read_single_value<T>(result.get_buffer(), 0, queue);
+    }
+
+    /// \overload
+    template<class T>
+    T accumulate(T init, command_queue &queue = system::default_queue()) const
+    {
+        return accumulate(init, plus<T>(), queue);
+    }
+
+    /// Evaluates the pipeline and returns the number of selected values.
+    size_t count(command_queue &queue = system::default_queue()) const
+    {
+        return ::boost::compute::count_if(m_first, m_last, m_predicate, queue);
+    }
+
+private:
+    Iterator m_first;
+    Iterator m_last;
+    Predicate m_predicate;
+};
+
+/// Returns a pipeline for the values in the range [\p first, \p last).
+///
+/// \see pipeline
+template<class Iterator>
+inline pipeline<Iterator> make_pipeline(Iterator first, Iterator last)
+{
+    return pipeline<Iterator>(first, last);
+}
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_PIPELINE_HPP
@@ -0,0 +1,254 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_STREAMING_EXECUTOR_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_STREAMING_EXECUTOR_HPP
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/event.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/utility/wait_list.hpp>
+#include <boost/compute/detail/enqueue_wait_list.hpp>
+#include <boost/compute/detail/is_contiguous_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+
+namespace detail {
+
+// stage which transforms each value of the chunk with function
+template<class Function>
+struct streaming_transform_stage
+{
+    streaming_transform_stage(Function function_)
+        : function(function_)
+    {
+    }
+
+    template<class InputIterator, class OutputIterator>
+    void operator()(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result,
+                    command_queue &queue) const
+    {
+        ::boost::compute::transform(first, last, result, function, queue);
+    }
+
+    Function function;
+};
+
+} // end detail namespace
+
+/// \class streaming_executor
+/// \brief Runs a device stage over host data larger than device memory.
+///
+/// The host input is processed in chunks of \c chunk_size() elements. Each
+/// chunk is uploaded into one of \c depth() device buffers, processed by
+/// the stage and the results are downloaded back to the host. Uploads,
+/// stages and downloads run on three separate queues and are ordered with
+/// events only, so while one chunk is processed the next chunk is uploaded
+/// and the results of the previous one are downloaded. A depth of two
+/// gives double-buffering, three gives triple-buffering.
+///
+/// The stage is called with device iterators for the input and output
+/// values of the chunk and the compute queue:
+/// \code
+/// struct sort_stage
+/// {
+///     template<class InputIterator, class OutputIterator>
+///     void operator()(InputIterator first, InputIterator last,
+///                     OutputIterator result, command_queue &queue) const
+///     {
+///         boost::compute::sort(first, last, queue);
+///         boost::compute::copy(first, last, result, queue);
+///     }
+/// };
+///
+/// streaming_executor executor(queue, 1 << 24);
+/// executor.run(host.begin(), host.end(), host.begin(), sort_stage());
+/// \endcode
+///
+/// The host ranges must be contiguous and must not be modified until run()
+/// returns.
+class streaming_executor
+{
+public:
+    /// Creates a streaming executor which processes chunks of
+    /// \p chunk_size elements with \p depth device buffers. The stages run
+    /// on \p queue, the transfers on two new queues for the same device.
+    streaming_executor(const command_queue &queue,
+                       size_t chunk_size,
+                       size_t depth = 2)
+        : m_compute_queue(queue),
+          m_upload_queue(queue.get_context(), queue.get_device()),
+          m_download_queue(queue.get_context(), queue.get_device()),
+          m_chunk_size(chunk_size),
+          m_depth(depth)
+    {
+        BOOST_ASSERT(chunk_size > 0);
+        BOOST_ASSERT(depth > 0);
+    }
+
+    /// Destroys the streaming executor.
+    ~streaming_executor()
+    {
+    }
+
+    /// Returns the number of elements in each chunk.
+    size_t chunk_size() const
+    {
+        return m_chunk_size;
+    }
+
+    /// Returns the number of chunks in flight.
+    size_t depth() const
+    {
+        return m_depth;
+    }
+
+    /// Runs \p stage on the values in the host range [\p first, \p last)
+    /// and stores the values it produces in the host range beginning at
+    /// \p result. The stage produces one value for each input value.
+    ///
+    /// \return an iterator to the end of the results
+    template<class InputIterator, class OutputIterator, class Stage>
+    OutputIterator run(InputIterator first,
+                       InputIterator last,
+                       OutputIterator result,
+                       Stage stage)
+    {
+        typedef typename std::iterator_traits<InputIterator>::value_type input_type;
+        typedef typename std::iterator_traits<OutputIterator>::value_type output_type;
+
+        BOOST_STATIC_ASSERT_MSG(
+            ::boost::compute::detail::is_contiguous_iterator<InputIterator>::value &&
+            ::boost::compute::detail::is_contiguous_iterator<OutputIterator>::value,
+            "streaming_executor is only supported for contiguous host iterators"
+        );
+
+        const size_t count = ::boost::compute::detail::iterator_range_size(first, last);
+        if(count == 0){
+            return result;
+        }
+
+        const context &context = m_compute_queue.get_context();
+        const size_t chunk_count = (count + m_chunk_size - 1) / m_chunk_size;
+        const size_t depth = (std::min)(m_depth, chunk_count);
+
+        std::vector<buffer> inputs;
+        std::vector<buffer> outputs;
+        for(size_t i = 0; i < depth; i++){
+            inputs.push_back(buffer(context, m_chunk_size * sizeof(input_type)));
+            outputs.push_back(buffer(context, m_chunk_size * sizeof(output_type)));
+        }
+
+        const input_type *host_input = &*first;
+        output_type *host_output = &*result;
+
+        // events of the last upload, stage and download of each buffer
+        std::vector<event> uploaded(depth);
+        std::vector<event> computed(depth);
+        std::vector<event> downloaded(depth);
+
+        for(size_t chunk = 0; chunk < chunk_count; chunk++){
+            const size_t slot = chunk % depth;
+            const size_t offset = chunk * m_chunk_size;
+            const size_t size = (std::min)(m_chunk_size, count - offset);
+
+            // upload once the stage of the previous chunk in the buffer is done
+            wait_list upload_events;
+            if(computed[slot].get()){
+                upload_events.insert(computed[slot]);
+            }
+            uploaded[slot] = m_upload_queue.enqueue_write_buffer_async(
+                inputs[slot],
+                0,
+                size * sizeof(input_type),
+                host_input + offset,
+                upload_events
+            );
+            m_upload_queue.flush();
+
+            // run the stage once the chunk is uploaded and the results of
+            // the previous chunk in the buffer are downloaded
+            wait_list stage_events;
+            stage_events.insert(uploaded[slot]);
+            if(downloaded[slot].get()){
+                stage_events.insert(downloaded[slot]);
+            }
+            ::boost::compute::detail::enqueue_wait_list(m_compute_queue, stage_events);
+
+            buffer_iterator<input_type> input = make_buffer_iterator<input_type>(inputs[slot]);
+            stage(
+                input,
+                input + size,
+                make_buffer_iterator<output_type>(outputs[slot]),
+                m_compute_queue
+            );
+            m_compute_queue.enqueue_marker(&computed[slot]);
+            m_compute_queue.flush();
+
+            // download the results once the stage is done
+            downloaded[slot] = m_download_queue.enqueue_read_buffer_async(
+                outputs[slot],
+                0,
+                size * sizeof(output_type),
+                host_output + offset,
+                wait_list(computed[slot])
+            );
+            m_download_queue.flush();
+        }
+
+        m_download_queue.finish();
+        m_compute_queue.finish();
+
+        return result + count;
+    }
+
+    /// Transforms the values in the host range [\p first, \p last) with
+    /// \p function on the device and stores the results in the host range
+    /// beginning at \p result.
+    ///
+    /// \return an iterator to the end of the results
+    template<class InputIterator, class OutputIterator, class Function>
+    OutputIterator transform(InputIterator first,
+                             InputIterator last,
+                             OutputIterator result,
+                             Function function)
+    {
+        return run(
+            first, last, result, detail::streaming_transform_stage<Function>(function)
+        );
+    }
+
+private:
+    command_queue m_compute_queue;
+    command_queue m_upload_queue;
+    command_queue m_download_queue;
+    size_t m_chunk_size;
+    size_t m_depth;
+};
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_STREAMING_EXECUTOR_HPP
@@ -11,31 +11,14 @@
 #ifndef BOOST_COMPUTE_EXPERIMENTAL_TABULATE_HPP
 #define BOOST_COMPUTE_EXPERIMENTAL_TABULATE_HPP
 
-#include <iterator>
-
-#include <boost/compute/algorithm/transform.hpp>
-#include <boost/compute/iterator/counting_iterator.hpp>
+#include <boost/compute/algorithm/tabulate.hpp>
 
 namespace boost {
 namespace compute {
 namespace experimental {
 
-template<class Iterator, class UnaryFunction>
-inline void tabulate(Iterator first,
-                     Iterator last,
-                     UnaryFunction function,
-                     command_queue &queue)
-{
-    size_t n = detail::iterator_range_size(first, last);
-
-    ::boost::compute::transform(
-        ::boost::compute::make_counting_iterator<int>(0),
-        ::boost::compute::make_counting_iterator<int>(n),
-        first,
-        function,
-        queue
-    );
-}
+// tabulate() is now a supported algorithm
+using ::boost::compute::tabulate;
 
 } // end experimental namespace
 } // end compute namespace
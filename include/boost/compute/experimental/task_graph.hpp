@@ -0,0 +1,332 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_TASK_GRAPH_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_TASK_GRAPH_HPP
+
+#include <vector>
+#include <algorithm>
+
+#include <boost/assert.hpp>
+#include <boost/function.hpp>
+
+#include <boost/compute/event.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/utility/wait_list.hpp>
+#include <boost/compute/detail/enqueue_wait_list.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+
+/// \class task_graph
+/// \brief A graph of dependent tasks scheduled onto several command queues.
+///
+/// Each task (an algorithm call, a kernel launch, a copy, ...) is added to
+/// the graph along with the tasks it depends on. When the graph is run the
+/// tasks are enqueued in the order they were added, which is always a
+/// valid order as the dependencies of a task must be added before it.
+///
+/// Tasks of the same depth in the graph are independent of each other and
+/// are spread over the queues of the graph so that they can execute
+/// concurrently. A task which only has one dependency is placed on the
+/// queue of that dependency if possible, so chains of tasks stay in order
+/// on one queue. The events of the dependencies of each task are passed to
+/// it in a wait_list, which also allows using out-of-order queues.
+///
+/// For example, to compute two independent transforms of an input on two
+/// queues and then combine their results:
+/// \code
+/// task_graph graph(queues);
+///
+/// task_graph::node a = graph.add_algorithm(
+///     boost::bind(transform_a, _1)
+/// );
+/// task_graph::node b = graph.add_algorithm(
+///     boost::bind(transform_b, _1)
+/// );
+/// graph.add_algorithm(boost::bind(combine, _1), a, b);
+///
+/// graph.run();
+/// graph.wait();
+/// \endcode
+///
+/// The queues can also be given priority classes (e.g. a high-priority
+/// queue created with the \c command_queue::priority_high hint next to
+/// low-priority ones). A task given a priority with set_priority() is then
+/// only scheduled on the queues of its class (or on any queue if the graph
+/// has none of that class), so latency-critical tasks are not queued up
+/// behind batch work:
+/// \code
+/// std::vector<command_queue::priority_hint> priorities;
+/// priorities.push_back(command_queue::priority_high);
+/// priorities.push_back(command_queue::priority_low);
+///
+/// task_graph graph(queues, priorities);
+/// task_graph::node n = graph.add_algorithm(boost::bind(inference, _1));
+/// graph.set_priority(n, command_queue::priority_high);
+/// \endcode
+///
+/// \see command_queue, wait_list
+class task_graph
+{
+public:
+    /// Handle of a task in the graph.
+    typedef size_t node;
+
+    /// A task enqueues its commands to the queue after the events in the
+    /// wait list and returns an event for its completion.
+    typedef boost::function<event(command_queue &, const wait_list &)> task_function;
+
+    /// An algorithm task only enqueues commands to the queue (e.g. by
+    /// calling an algorithm with it).
+    typedef boost::function<void(command_queue &)> algorithm_function;
+
+    /// Creates a new task graph which schedules its tasks onto \p queues.
+    explicit task_graph(const std::vector<command_queue> &queues)
+        : m_queues(queues),
+          m_priorities(queues.size(), command_queue::priority_default)
+    {
+        BOOST_ASSERT(!m_queues.empty());
+    }
+
+    /// Creates a new task graph which schedules its tasks onto \p queues
+    /// where the priority class of each queue is given by \p priorities.
+    task_graph(const std::vector<command_queue> &queues,
+               const std::vector<command_queue::priority_hint> &priorities)
+        : m_queues(queues),
+          m_priorities(priorities)
+    {
+        BOOST_ASSERT(!m_queues.empty());
+        BOOST_ASSERT(m_queues.size() == m_priorities.size());
+    }
+
+    /// Creates a new task graph which schedules its tasks onto \p queue.
+    explicit task_graph(const command_queue &queue)
+        : m_queues(1, queue),
+          m_priorities(1, command_queue::priority_default)
+    {
+    }
+
+    /// Destroys the task graph.
+    ~task_graph()
+    {
+    }
+
+    /// Returns the number of tasks in the graph.
+    size_t size() const
+    {
+        return m_nodes.size();
+    }
+
+    /// Adds \p task to the graph which runs after the tasks in
+    /// \p dependencies and returns its node.
+    node add_task(const task_function &task,
+                  const std::vector<node> &dependencies = std::vector<node>())
+    {
+        node_data data;
+        data.task = task;
+        data.dependencies = dependencies;
+        data.depth = 0;
+        data.queue = 0;
+        data.priority = command_queue::priority_default;
+
+        for(size_t i = 0; i < dependencies.size(); i++){
+            BOOST_ASSERT(dependencies[i] < m_nodes.size());
+
+            data.depth = (std::max)(data.depth, m_nodes[dependencies[i]].depth + 1);
+        }
+
+        m_nodes.push_back(data);
+
+        return m_nodes.size() - 1;
+    }
+
+    /// \overload
+    node add_task(const task_function &task, node dependency)
+    {
+        return add_task(task, std::vector<node>(1, dependency));
+    }
+
+    /// \overload
+    node add_task(const task_function &task, node dependency1, node dependency2)
+    {
+        std::vector<node> dependencies;
+        dependencies.push_back(dependency1);
+        dependencies.push_back(dependency2);
+
+        return add_task(task, dependencies);
+    }
+
+    /// Adds an algorithm task to the graph which runs after the tasks in
+    /// \p dependencies and returns its node.
+    ///
+    /// A barrier for the events of the dependencies is enqueued before the
+    /// commands of \p algorithm (on devices without OpenCL 1.2 the host
+    /// waits for them instead) and a marker after them.
+    node add_algorithm(const algorithm_function &algorithm,
+                       const std::vector<node> &dependencies = std::vector<node>())
+    {
+        return add_task(algorithm_task(algorithm), dependencies);
+    }
+
+    /// \overload
+    node add_algorithm(const algorithm_function &algorithm, node dependency)
+    {
+        return add_algorithm(algorithm, std::vector<node>(1, dependency));
+    }
+
+    /// \overload
+    node add_algorithm(const algorithm_function &algorithm,
+                       node dependency1,
+                       node dependency2)
+    {
+        std::vector<node> dependencies;
+        dependencies.push_back(dependency1);
+        dependencies.push_back(dependency2);
+
+        return add_algorithm(algorithm, dependencies);
+    }
+
+    /// Sets the priority class of the task \p n to \p priority. The task
+    /// is scheduled on the queues of that class (if the graph has any).
+    void set_priority(node n, command_queue::priority_hint priority)
+    {
+        BOOST_ASSERT(n < m_nodes.size());
+
+        m_nodes[n].priority = priority;
+    }
+
+    /// Enqueues all of the tasks in the graph. This does not wait for the
+    /// tasks to complete.
+    void run()
+    {
+        // number of tasks assigned to each queue per depth
+        std::vector<std::vector<size_t> > load;
+
+        for(size_t i = 0; i < m_nodes.size(); i++){
+            node_data &data = m_nodes[i];
+
+            if(load.size() <= data.depth){
+                load.resize(data.depth + 1, std::vector<size_t>(m_queues.size(), 0));
+            }
+            std::vector<size_t> &depth_load = load[data.depth];
+
+            // the queues of the priority class of the task, or all of the
+            // queues if there are none of that class
+            const bool has_class =
+                std::find(m_priorities.begin(), m_priorities.end(), data.priority) !=
+                m_priorities.end();
+
+            // continue on the queue of the dependency if no other task of
+            // this depth uses it yet, otherwise take the least loaded queue
+            size_t queue = m_queues.size();
+            for(size_t j = 0; j < m_queues.size(); j++){
+                if(has_class && m_priorities[j] != data.priority){
+                    continue;
+                }
+                if(queue == m_queues.size() || depth_load[j] < depth_load[queue]){
+                    queue = j;
+                }
+            }
+            if(data.dependencies.size() == 1){
+                const size_t previous = m_nodes[data.dependencies[0]].queue;
+                if(depth_load[previous] == 0 &&
+                   (!has_class || m_priorities[previous] == data.priority)){
+                    queue = previous;
+                }
+            }
+            depth_load[queue]++;
+            data.queue = queue;
+
+            wait_list events;
+            for(size_t j = 0; j < data.dependencies.size(); j++){
+                const event &dependency = m_nodes[data.dependencies[j]].event_;
+                if(dependency.get()){
+                    events.insert(dependency);
+                }
+            }
+
+            data.event_ = data.task(m_queues[queue], events);
+        }
+    }
+
+    /// Blocks until all of the tasks are complete.
+    void wait() const
+    {
+        for(size_t i = 0; i < m_nodes.size(); i++){
+            if(m_nodes[i].event_.get()){
+                m_nodes[i].event_.wait();
+            }
+        }
+    }
+
+    /// Returns the event for the completion of the task \p n (after the
+    /// graph was run).
+    event get_event(node n) const
+    {
+        BOOST_ASSERT(n < m_nodes.size());
+
+        return m_nodes[n].event_;
+    }
+
+    /// Returns the queue the task \p n was scheduled on (after the graph
+    /// was run).
+    const command_queue& get_queue(node n) const
+    {
+        BOOST_ASSERT(n < m_nodes.size());
+
+        return m_queues[m_nodes[n].queue];
+    }
+
+private:
+    /// \internal_
+    struct node_data
+    {
+        task_function task;
+        std::vector<node> dependencies;
+        size_t depth;
+        size_t queue;
+        command_queue::priority_hint priority;
+        event event_;
+    };
+
+    /// \internal_
+    struct algorithm_task
+    {
+        algorithm_task(const algorithm_function &algorithm_)
+            : algorithm(algorithm_)
+        {
+        }
+
+        event operator()(command_queue &queue, const wait_list &events) const
+        {
+            detail::enqueue_wait_list(queue, events);
+
+            algorithm(queue);
+
+            event event_;
+            queue.enqueue_marker(&event_);
+            return event_;
+        }
+
+        algorithm_function algorithm;
+    };
+
+    std::vector<command_queue> m_queues;
+    std::vector<command_queue::priority_hint> m_priorities;
+    std::vector<node_data> m_nodes;
+};
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_TASK_GRAPH_HPP
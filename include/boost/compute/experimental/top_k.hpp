@@ -0,0 +1,229 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_TOP_K_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_TOP_K_HPP
+
+#include <algorithm>
+#include <iterator>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/nth_element.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+namespace detail {
+
+using ::boost::compute::detail::meta_kernel;
+
+// selects the values ordered before the threshold (the current k-th
+// value), which is read by the kernel so that the same program is used
+// for every batch
+template<class InputIterator, class Compare>
+struct top_k_select_before
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    top_k_select_before(InputIterator first_,
+                        Compare compare_,
+                        buffer_iterator<value_type> threshold_)
+        : first(first_),
+          compare(compare_),
+          threshold(threshold_)
+    {
+    }
+
+    void select(meta_kernel &k) const
+    {
+        k << compare(first[k.var<uint_>("i")], threshold[k.var<uint_>("0")]);
+    }
+
+    InputIterator first;
+    Compare compare;
+    buffer_iterator<value_type> threshold;
+};
+
+} // end detail namespace
+
+/// \class top_k_accumulator
+/// \brief Keeps the first \c k values (according to \c Compare) of a
+///        stream of batches on the device.
+///
+/// Each batch pushed with push() is merged into the current values with a
+/// single selection pass: the values of the batch ordered before the
+/// current k-th value are compacted next to the current values, narrowed
+/// down to at most \c k with nth_element() and sorted together with the
+/// current values. No value of the batch is read back to the host and the
+/// union of the batches is never sorted.
+///
+/// With the default \c greater<T> compare the largest values are kept:
+/// \code
+/// boost::compute::experimental::top_k_accumulator<float> top(1000, queue);
+///
+/// for(size_t i = 0; i < batches; i++){
+///     top.push(batch[i].begin(), batch[i].end(), queue);
+/// }
+///
+/// // the 1000 largest values in descending order
+/// boost::compute::copy(top.begin(), top.end(), result.begin(), queue);
+/// \endcode
+///
+/// Values equal to the current k-th value are only kept while fewer than
+/// \c k values have been pushed.
+///
+/// \see nth_element(), partial_sort()
+template<class T, class Compare = greater<T> >
+class top_k_accumulator : boost::noncopyable
+{
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef buffer_iterator<T> iterator;
+
+    /// Creates an empty accumulator keeping the first \p k values
+    /// according to \p compare.
+    explicit top_k_accumulator(size_type k,
+                               command_queue &queue = system::default_queue(),
+                               Compare compare = Compare())
+        : m_k(k),
+          m_size(0),
+          m_values((std::max)(k, size_type(1)), queue.get_context()),
+          m_candidates(queue.get_context()),
+          m_compare(compare)
+    {
+    }
+
+    /// Returns the maximum number of values kept.
+    size_type k() const
+    {
+        return m_k;
+    }
+
+    /// Returns the number of values kept, which is \c k() once at least
+    /// \c k() values were pushed.
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /// Returns \c true if no values are kept.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// Returns an iterator to the first value kept. The values are sorted
+    /// according to \c Compare.
+    iterator begin() const
+    {
+        return m_values.begin();
+    }
+
+    /// Returns an iterator to the end of the values kept.
+    iterator end() const
+    {
+        return m_values.begin() + static_cast<std::ptrdiff_t>(m_size);
+    }
+
+    /// Merges the values in the range [\p first, \p last) into the values
+    /// kept.
+    template<class InputIterator>
+    void push(InputIterator first, InputIterator last, command_queue &queue)
+    {
+        const size_t count =
+            ::boost::compute::detail::iterator_range_size(first, last);
+        if(count == 0 || m_k == 0){
+            return;
+        }
+
+        // the current values followed by the candidates of the batch
+        m_candidates.resize_uninitialized(m_size + count);
+        ::boost::compute::copy(
+            m_values.begin(), end(), m_candidates.begin(), queue
+        );
+        const iterator candidates = m_candidates.begin() + m_size;
+
+        size_t selected = count;
+        if(m_size < m_k){
+            ::boost::compute::copy(first, last, candidates, queue);
+        }
+        else {
+            const iterator candidates_end = ::boost::compute::detail::stream_compact(
+                first,
+                count,
+                candidates,
+                detail::top_k_select_before<InputIterator, Compare>(
+                    first, m_compare, m_values.begin() + (m_k - 1)
+                ),
+                false,
+                queue
+            );
+            selected = ::boost::compute::detail::iterator_range_size(
+                candidates, candidates_end
+            );
+            if(selected == 0){
+                return;
+            }
+        }
+
+        // at most k of the candidates are kept
+        if(selected > m_k){
+            ::boost::compute::nth_element(
+                candidates,
+                candidates + (m_k - 1),
+                candidates + selected,
+                m_compare,
+                queue
+            );
+            selected = m_k;
+        }
+
+        const size_t total = m_size + selected;
+        ::boost::compute::sort(
+            m_candidates.begin(), m_candidates.begin() + total, m_compare, queue
+        );
+
+        m_size = (std::min)(total, m_k);
+        ::boost::compute::copy(
+            m_candidates.begin(), m_candidates.begin() + m_size, m_values.begin(), queue
+        );
+    }
+
+    /// Removes all values.
+    void clear()
+    {
+        m_size = 0;
+    }
+
+private:
+    size_type m_k;
+    size_type m_size;
+    vector<T> m_values;
+    vector<T> m_candidates;
+    Compare m_compare;
+};
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_TOP_K_HPP
@@ -15,6 +15,7 @@
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/algorithm/detail/copy_on_device.hpp>
+#include <boost/compute/container/dynamic_bitset.hpp>
 
 namespace boost {
 namespace compute {
@@ -56,6 +57,51 @@ inline OutputIterator transform_if(InputIterator first,
     return result + count;
 }
 
+/// \overload
+///
+/// Transforms the values whose bit in \p stencil is set. The stencil is
+/// read one bit per value instead of evaluating a predicate.
+template<class InputIterator,
+         class Block,
+         class Alloc,
+         class OutputIterator,
+         class UnaryOperator>
+inline OutputIterator transform_if(InputIterator first,
+                                   InputIterator last,
+                                   const dynamic_bitset<Block, Alloc> &stencil,
+                                   OutputIterator result,
+                                   UnaryOperator op,
+                                   command_queue &queue)
+{
+    typedef typename
+        std::iterator_traits<InputIterator>::difference_type difference_type;
+
+    difference_type count = std::distance(first, last);
+    if(count < 1){
+        return result;
+    }
+
+    BOOST_ASSERT(static_cast<size_t>(count) <= stencil.size());
+
+    detail::meta_kernel k("transform_if_stencil");
+
+    k << "const uint i = get_global_id(0);\n" <<
+         "if(";
+    stencil._selector().select(k);
+    k << "){\n" <<
+            result[k.var<uint_>("i")] << '=' <<
+                op(first[k.var<uint_>("i")]) << ";\n"
+        "}\n";
+
+    const device &device = queue.get_device();
+    const size_t work_group_size =
+        detail::pick_copy_work_group_size(count, device);
+
+    k.exec_1d(queue, 0, count, work_group_size);
+
+    return result + count;
+}
+
 } // end experimental namespace
 } // end compute namespace
 } // end boost namespace
@@ -0,0 +1,303 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_EXPERIMENTAL_UNIFORM_GRID_HPP
+#define BOOST_COMPUTE_EXPERIMENTAL_UNIFORM_GRID_HPP
+
+#include <iterator>
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+#include <boost/compute/type_traits/scalar_type.hpp>
+#include <boost/compute/type_traits/vector_size.hpp>
+#include <boost/compute/utility/fill_batch.hpp>
+
+namespace boost {
+namespace compute {
+namespace experimental {
+
+/// \class uniform_grid
+/// \brief A uniform grid of cells for finding the neighbors of points.
+///
+/// The uniform_grid class sorts the indices of a range of points by the
+/// cell of the grid containing them so that the points near a point can
+/// be found by visiting only its cell and the adjacent cells. With cells
+/// at least as large as the interaction radius this gives O(n) neighbor
+/// queries (e.g. for smoothed-particle hydrodynamics or collision
+/// detection) instead of the O(n^2) of all_pairs_reduce().
+///
+/// The points are \c float2_ values for a two-dimensional grid or
+/// \c float3_ or \c float4_ values (of which only \c x, \c y and \c z are
+/// used) for a three-dimensional grid. Points outside of the grid are
+/// placed in the nearest cell at its border.
+///
+/// For example, to sum the densities contributed by the particles within
+/// the smoothing radius \c h of each particle:
+/// \code
+/// experimental::uniform_grid<float4_> grid(
+///     float4_(0, 0, 0, 0), h, 64, 64, 64, context
+/// );
+/// grid.build(positions.begin(), positions.end(), queue);
+/// grid.neighbor_reduce(
+///     positions.begin(), positions.end(), densities.begin(),
+///     0.0f, density_contribution, queue
+/// );
+/// \endcode
+///
+/// \see all_pairs_reduce()
+template<class T>
+class uniform_grid
+{
+public:
+    typedef T point_type;
+
+    BOOST_STATIC_ASSERT((boost::is_same<typename scalar_type<T>::type, float_>::value));
+    BOOST_STATIC_ASSERT(vector_size<T>::value >= 2 && vector_size<T>::value <= 4);
+
+    /// Creates a grid of \p cells_x by \p cells_y (by \p cells_z) cells of
+    /// size \p cell_size whose first cell starts at \p origin.
+    uniform_grid(const T &origin,
+                 float_ cell_size,
+                 uint_ cells_x,
+                 uint_ cells_y,
+                 uint_ cells_z,
+                 const context &context = system::default_context())
+        : m_origin(origin),
+          m_cell_size(cell_size),
+          m_cells_x(cells_x),
+          m_cells_y(cells_y),
+          m_cells_z(dimensions() == 2 ? 1 : cells_z),
+          m_cell_starts(size_t(m_cells_x) * m_cells_y * m_cells_z, context),
+          m_cell_ends(size_t(m_cells_x) * m_cells_y * m_cells_z, context),
+          m_cells(context),
+          m_indices(context)
+    {
+    }
+
+    /// Returns the number of dimensions of the grid.
+    static size_t dimensions()
+    {
+        return vector_size<T>::value == 2 ? 2 : 3;
+    }
+
+    /// Returns the number of cells of the grid.
+    size_t cell_count() const
+    {
+        return m_cell_starts.size();
+    }
+
+    /// Sorts the points in the range [\p first, \p last) into the cells of
+    /// the grid.
+    ///
+    /// The cell of each point is computed and the indices of the points
+    /// are sorted by their cells (with a radix sort of only the bits of the
+    /// cell indices). The start and end of the range of each cell in the
+    /// sorted indices are then found where the cell changes.
+    template<class InputIterator>
+    void build(InputIterator first,
+               InputIterator last,
+               command_queue &queue = system::default_queue())
+    {
+        const size_t count =
+            ::boost::compute::detail::iterator_range_size(first, last);
+
+        m_cells.resize_uninitialized(count);
+        m_indices.resize_uninitialized(count);
+
+        fill_batch clear;
+        clear.add(m_cell_starts.begin(), m_cell_starts.end(), 0);
+        clear.add(m_cell_ends.begin(), m_cell_ends.end(), 0);
+        clear.enqueue(queue);
+
+        if(count == 0){
+            return;
+        }
+
+        ::boost::compute::detail::meta_kernel cell_kernel("uniform_grid_cells");
+        add_grid_args(cell_kernel);
+        cell_kernel <<
+            "const uint i = get_global_id(0);\n" <<
+            cell_kernel.decl<const T>("point") << " = " <<
+                first[cell_kernel.var<uint_>("i")] << ";\n";
+        emit_cell_coordinates(cell_kernel);
+        cell_kernel <<
+            m_cells.begin()[cell_kernel.var<uint_>("i")] << " = " <<
+                "(cz * cells_y + cy) * cells_x + cx;\n" <<
+            m_indices.begin()[cell_kernel.var<uint_>("i")] << " = i;\n";
+        cell_kernel.exec_1d(queue, 0, count);
+
+        uint_ bits = 0;
+        while(bits < 32 && (size_t(1) << bits) < cell_count()){
+            bits++;
+        }
+        ::boost::compute::sort_by_key(
+            m_cells.begin(), m_cells.end(), m_indices.begin(), 0, bits, queue
+        );
+
+        ::boost::compute::detail::meta_kernel range_kernel("uniform_grid_ranges");
+        size_t count_arg = range_kernel.add_arg<const uint_>("count");
+        range_kernel <<
+            "const uint i = get_global_id(0);\n" <<
+            "const uint cell = " << m_cells.begin()[range_kernel.var<uint_>("i")] << ";\n" <<
+            "if(i == 0 || " << m_cells.begin()[range_kernel.var<uint_>("i-1")] << " != cell){\n" <<
+            "    " << m_cell_starts.begin()[range_kernel.var<uint_>("cell")] << " = i;\n" <<
+            "}\n" <<
+            "if(i == count - 1 || " << m_cells.begin()[range_kernel.var<uint_>("i+1")] << " != cell){\n" <<
+            "    " << m_cell_ends.begin()[range_kernel.var<uint_>("cell")] << " = i + 1;\n" <<
+            "}\n";
+        range_kernel.set_arg(count_arg, static_cast<uint_>(count));
+        range_kernel.exec_1d(queue, 0, count);
+    }
+
+    /// Stores at \c result[i] the sum of \p init and of \p interaction(\c x,
+    /// \c y) for the point \c x at position \c i of [\p first, \p last) and
+    /// each other point \c y of the range in the same or an adjacent cell,
+    /// and returns the end of the result range.
+    ///
+    /// The points must be those the grid was built with. \p interaction
+    /// is called for the points within one cell of each other and must
+    /// return zero for those beyond the interaction radius.
+    template<class InputIterator, class OutputIterator, class Result, class Function>
+    OutputIterator neighbor_reduce(InputIterator first,
+                                   InputIterator last,
+                                   OutputIterator result,
+                                   const Result &init,
+                                   Function interaction,
+                                   command_queue &queue = system::default_queue()) const
+    {
+        typedef typename
+            boost::compute::result_of<Function(T, T)>::type result_type;
+        typedef typename
+            std::iterator_traits<OutputIterator>::difference_type difference_type;
+
+        const size_t count =
+            ::boost::compute::detail::iterator_range_size(first, last);
+        if(count == 0){
+            return result;
+        }
+
+        ::boost::compute::detail::meta_kernel k("uniform_grid_neighbor_reduce");
+        add_grid_args(k);
+        size_t init_arg = k.add_arg<const result_type>("init");
+
+        k <<
+            "const uint i = get_global_id(0);\n" <<
+            k.decl<const T>("point") << " = " << first[k.var<uint_>("i")] << ";\n";
+        emit_cell_coordinates(k);
+        k <<
+            k.decl<result_type>("sum") << " = init;\n" <<
+            "const int z_first = max((int) cz - 1, 0);\n" <<
+            "const int z_last = min((int) cz + 1, (int) cells_z - 1);\n" <<
+            "const int y_first = max((int) cy - 1, 0);\n" <<
+            "const int y_last = min((int) cy + 1, (int) cells_y - 1);\n" <<
+            "const int x_first = max((int) cx - 1, 0);\n" <<
+            "const int x_last = min((int) cx + 1, (int) cells_x - 1);\n" <<
+            "for(int z = z_first; z <= z_last; z++){\n" <<
+            "    for(int y = y_first; y <= y_last; y++){\n" <<
+            "        for(int x = x_first; x <= x_last; x++){\n" <<
+            "            const uint cell = (z * cells_y + y) * cells_x + x;\n" <<
+            "            const uint end = " << m_cell_ends.begin()[k.var<uint_>("cell")] << ";\n" <<
+            "            for(uint n = " << m_cell_starts.begin()[k.var<uint_>("cell")] << "; n < end; n++){\n" <<
+            "                const uint j = " << m_indices.begin()[k.var<uint_>("n")] << ";\n" <<
+            "                if(j != i){\n" <<
+            "                    sum += " << interaction(k.var<T>("point"),
+                                                         first[k.var<uint_>("j")]) << ";\n" <<
+            "                }\n" <<
+            "            }\n" <<
+            "        }\n" <<
+            "    }\n" <<
+            "}\n" <<
+            result[k.var<uint_>("i")] << " = sum;\n";
+
+        k.set_arg(init_arg, static_cast<result_type>(init));
+        k.exec_1d(queue, 0, count);
+
+        return result + static_cast<difference_type>(count);
+    }
+
+    /// Returns the start of the range of each cell in indices().
+    const vector<uint_>& cell_starts() const
+    {
+        return m_cell_starts;
+    }
+
+    /// Returns the end of the range of each cell in indices().
+    const vector<uint_>& cell_ends() const
+    {
+        return m_cell_ends;
+    }
+
+    /// Returns the cells of the points in sorted order.
+    const vector<uint_>& cells() const
+    {
+        return m_cells;
+    }
+
+    /// Returns the indices of the points sorted by their cells.
+    const vector<uint_>& indices() const
+    {
+        return m_indices;
+    }
+
+private:
+    void add_grid_args(::boost::compute::detail::meta_kernel &k) const
+    {
+        k.add_set_arg<const T>("origin", m_origin);
+        k.add_set_arg<const float_>("cell_size", m_cell_size);
+        k.add_set_arg<const uint_>("cells_x", m_cells_x);
+        k.add_set_arg<const uint_>("cells_y", m_cells_y);
+        k.add_set_arg<const uint_>("cells_z", m_cells_z);
+    }
+
+    // emits code computing the cell coordinates (cx, cy, cz) of "point"
+    void emit_cell_coordinates(::boost::compute::detail::meta_kernel &k) const
+    {
+        k <<
+            "const uint cx = (uint) clamp((int) floor((point.x - origin.x) / cell_size),\n"
+            "                             0, (int) cells_x - 1);\n" <<
+            "const uint cy = (uint) clamp((int) floor((point.y - origin.y) / cell_size),\n"
+            "                             0, (int) cells_y - 1);\n";
+        if(dimensions() == 2){
+            k << "const uint cz = 0;\n";
+        }
+        else {
+            k <<
+            "const uint cz = (uint) clamp((int) floor((point.z - origin.z) / cell_size),\n"
+            "                             0, (int) cells_z - 1);\n";
+        }
+    }
+
+private:
+    T m_origin;
+    float_ m_cell_size;
+    uint_ m_cells_x;
+    uint_ m_cells_y;
+    uint_ m_cells_z;
+    vector<uint_> m_cell_starts;
+    vector<uint_> m_cell_ends;
+    vector<uint_> m_cells;
+    vector<uint_> m_indices;
+};
+
+} // end experimental namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_EXPERIMENTAL_UNIFORM_GRID_HPP
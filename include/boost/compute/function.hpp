@@ -11,6 +11,7 @@
 #ifndef BOOST_COMPUTE_FUNCTION_HPP
 #define BOOST_COMPUTE_FUNCTION_HPP
 
+#include <functional>
 #include <map>
 #include <string>
 #include <sstream>
@@ -31,6 +32,7 @@
 #include <boost/compute/cl.hpp>
 #include <boost/compute/config.hpp>
 #include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/detail/global_static.hpp>
 
 namespace boost {
 namespace compute {
@@ -158,6 +160,12 @@ public:
         return m_source;
     }
 
+    /// \internal_
+    const std::map<std::string, std::string>& definitions() const
+    {
+        return m_definitions;
+    }
+
     /// \internal_
     void define(std::string name, std::string value = std::string())
     {
@@ -393,17 +401,96 @@ inline std::string generate_argument_list(const char first = 'a')
     return s.str();
 }
 
+// the source of the functions created by the BOOST_COMPUTE_FUNCTION() and
+// BOOST_COMPUTE_CLOSURE() macros only depends on their string literals
+// (name, arguments, captures and body) and on the types of their
+// signature (the Tag). it is generated once for each use of the macros
+// and then looked up by the addresses of the literals, so creating the
+// function objects again (e.g. on each call of a function using the
+// macros) does not parse the arguments and format the declaration again.
+template<class Tag>
+class macro_source_cache
+{
+public:
+    struct key_type
+    {
+        key_type(const char *name_,
+                 const char *arguments_,
+                 const char *captures_,
+                 const char *body_)
+            : name(name_),
+              arguments(arguments_),
+              captures(captures_),
+              body(body_)
+        {
+        }
+
+        bool operator<(const key_type &other) const
+        {
+            if(name != other.name){
+                return std::less<const char *>()(name, other.name);
+            }
+            if(arguments != other.arguments){
+                return std::less<const char *>()(arguments, other.arguments);
+            }
+            if(captures != other.captures){
+                return std::less<const char *>()(captures, other.captures);
+            }
+            return std::less<const char *>()(body, other.body);
+        }
+
+        const char *name;
+        const char *arguments;
+        const char *captures;
+        const char *body;
+    };
+
+    typedef std::map<key_type, std::string> map_type;
+
+    // returns the cached source for key, or null if it was not generated
+    static const std::string* find(const key_type &key)
+    {
+        map_type &sources = get_sources();
+        typename map_type::const_iterator i = sources.find(key);
+
+        return i == sources.end() ? 0 : &i->second;
+    }
+
+    static const std::string& insert(const key_type &key,
+                                     const std::string &source)
+    {
+        return get_sources()[key] = source;
+    }
+
+private:
+    static map_type& get_sources()
+    {
+        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(map_type, sources, );
+
+        return sources;
+    }
+};
+
 // used by the BOOST_COMPUTE_FUNCTION() macro to create a function
 // with the given signature, name, arguments, and source.
 template<class Signature>
 inline function<Signature>
 make_function_impl(const char *name, const char *arguments, const char *source)
 {
+    typedef macro_source_cache<Signature> cache_type;
+
+    const typename cache_type::key_type key(name, arguments, 0, source);
+    if(const std::string *cached = cache_type::find(key)){
+        return make_function_from_source<Signature>(name, *cached);
+    }
+
     std::stringstream s;
     s << make_function_declaration<Signature>(name, arguments);
     s << source;
 
-    return make_function_from_source<Signature>(name, s.str());
+    return make_function_from_source<Signature>(
+        name, cache_type::insert(key, s.str())
+    );
 }
 
 } // end detail namespace
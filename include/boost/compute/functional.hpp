@@ -16,6 +16,7 @@
 /// Meta-header to include all Boost.Compute functional headers.
 
 #include <boost/compute/functional/as.hpp>
+#include <boost/compute/functional/associative.hpp>
 #include <boost/compute/functional/atomic.hpp>
 #include <boost/compute/functional/common.hpp>
 #include <boost/compute/functional/convert.hpp>
@@ -27,6 +28,7 @@
 #include <boost/compute/functional/integer.hpp>
 #include <boost/compute/functional/logical.hpp>
 #include <boost/compute/functional/math.hpp>
+#include <boost/compute/functional/math_precision.hpp>
 #include <boost/compute/functional/operator.hpp>
 #include <boost/compute/functional/popcount.hpp>
 #include <boost/compute/functional/relational.hpp>
@@ -0,0 +1,80 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_FUNCTIONAL_ASSOCIATIVE_HPP
+#define BOOST_COMPUTE_FUNCTIONAL_ASSOCIATIVE_HPP
+
+#include <boost/type_traits/integral_constant.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class associative_function
+/// \brief Binary function declared to be associative.
+///
+/// The associative_function class wraps a binary function whose arguments
+/// and result have the same type and for which \c f(f(a,b),c) equals
+/// \c f(a,f(b,c)). It is invoked as the wrapped function, but lets
+/// algorithms such as \c accumulate() combine the values in parallel
+/// instead of with a single work-item. The function need not be
+/// commutative, the order of the values is preserved.
+///
+/// Instances should be created with make_associative().
+///
+/// \see make_associative(), is_associative
+template<class Function>
+class associative_function : public Function
+{
+public:
+    associative_function(const Function &function)
+        : Function(function)
+    {
+    }
+};
+
+/// Returns an associative_function wrapping \p function.
+///
+/// For example, to take the last non-zero value of a range with a parallel
+/// reduction:
+/// \code
+/// BOOST_COMPUTE_FUNCTION(int, last_non_zero, (int x, int y),
+/// {
+///     return y != 0 ? y : x;
+/// });
+///
+/// int last = boost::compute::accumulate(
+///     vec.begin(), vec.end(), 0, make_associative(last_non_zero), queue
+/// );
+/// \endcode
+///
+/// \see associative_function
+template<class Function>
+inline associative_function<Function> make_associative(const Function &function)
+{
+    return associative_function<Function>(function);
+}
+
+/// Meta-function returning \c true if \c Function is declared to be
+/// associative (i.e. is an associative_function).
+template<class Function>
+struct is_associative : boost::false_type
+{
+};
+
+/// \internal_
+template<class Function>
+struct is_associative<associative_function<Function> > : boost::true_type
+{
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_FUNCTIONAL_ASSOCIATIVE_HPP
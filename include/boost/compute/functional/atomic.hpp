@@ -11,8 +11,12 @@
 #ifndef BOOST_COMPUTE_FUNCTIONAL_ATOMIC_HPP
 #define BOOST_COMPUTE_FUNCTIONAL_ATOMIC_HPP
 
+#include <string>
+#include <sstream>
+
 #include <boost/compute/cl.hpp>
 #include <boost/compute/function.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
 
 #ifndef BOOST_COMPUTE_DOXYGEN_INVOKED
 #ifdef CL_VERSION_1_1
@@ -24,7 +28,82 @@
 
 namespace boost {
 namespace compute {
-
+namespace detail {
+
+// returns the source of the function which atomically replaces the float
+// or double value at p with the result of op ("add", "min" or "max") and
+// returns the old value. the native functions of cl_ext_float_atomics are
+// used when the device supports them, otherwise the value is updated with
+// a compare-and-swap loop on its bits (64-bit values require the
+// cl_khr_int64_base_atomics extension). address_space is the address space
+// of p ("__global" or "__local").
+template<class T>
+inline std::string make_atomic_float_function_source(const std::string &name,
+                                                     const std::string &op,
+                                                     const std::string &address_space = "__global")
+{
+    const bool is_local = address_space == "__local";
+    const bool is_double = sizeof(T) == 8;
+    const std::string type = type_name<T>();
+    const std::string bits_type = is_double ? "ulong" : "uint";
+    const std::string cmpxchg = is_double ? "atom_cmpxchg" : "atomic_cmpxchg";
+
+    std::stringstream s;
+    if(is_double){
+        s << "#pragma OPENCL EXTENSION cl_khr_fp64 : enable\n"
+          << "#pragma OPENCL EXTENSION cl_khr_int64_base_atomics : enable\n";
+    }
+    s << "inline " << type << " " << name
+      << "(volatile " << address_space << " " << type << " *p, const " << type << " value)\n"
+      << "{\n"
+      << "#ifdef __opencl_c_ext_fp" << (is_double ? "64" : "32")
+      << (is_local ? "_local_atomic_" : "_global_atomic_")
+      << (op == "add" ? "add" : "min_max") << "\n"
+      << "    return atomic_fetch_" << op << "_explicit(\n"
+      << "        (volatile " << address_space << " atomic_" << type << " *) p, value,\n"
+      << "        memory_order_relaxed, "
+      << (is_local ? "memory_scope_work_group" : "memory_scope_device") << "\n"
+      << "    );\n"
+      << "#else\n"
+      << "    " << type << " old = *p;\n"
+      << "    for(;;){\n";
+    if(op == "add"){
+        s << "        const " << type << " next = old + value;\n";
+    }
+    else {
+        // nothing to store if the value is not smaller (or larger)
+        s << "        if(!(value " << (op == "min" ? "<" : ">") << " old)){\n"
+          << "            return old;\n"
+          << "        }\n"
+          << "        const " << type << " next = value;\n";
+    }
+    s << "        const " << bits_type << " expected = as_" << bits_type << "(old);\n"
+      << "        const " << bits_type << " actual = " << cmpxchg << "(\n"
+      << "            (volatile " << address_space << " " << bits_type << " *) p, expected,"
+      << " as_" << bits_type << "(next)\n"
+      << "        );\n"
+      << "        if(actual == expected){\n"
+      << "            return old;\n"
+      << "        }\n"
+      << "        old = as_" << type << "(actual);\n"
+      << "    }\n"
+      << "#endif\n"
+      << "}\n";
+
+    return s.str();
+}
+
+} // end detail namespace
+
+/// Atomically adds \p value to the value at \p p and returns the old value.
+///
+/// For \c float and \c double values (in global memory) the native atomic
+/// functions of the \c cl_ext_float_atomics extension are used when they
+/// are supported, otherwise the value is updated with a compare-and-swap
+/// loop. Atomics on \c double values require the
+/// \c cl_khr_int64_base_atomics extension.
+///
+/// \see scatter_add()
 template<class T>
 class atomic_add : public function<T (T*, T)>
 {
@@ -85,6 +164,9 @@ public:
     }
 };
 
+/// Atomically replaces the value at \p p with the maximum of it and
+/// \p value and returns the old value. \c float and \c double values are
+/// supported as for atomic_add.
 template<class T>
 class atomic_max : public function<T (T*, T)>
 {
@@ -95,6 +177,9 @@ public:
     }
 };
 
+/// Atomically replaces the value at \p p with the minimum of it and
+/// \p value and returns the old value. \c float and \c double values are
+/// supported as for atomic_add.
 template<class T>
 class atomic_min : public function<T (T*, T)>
 {
@@ -135,6 +220,32 @@ public:
     }
 };
 
+/// \internal_
+#define BOOST_COMPUTE_DETAIL_DECLARE_ATOMIC_FLOAT_FUNCTION(op, type) \
+    template<> \
+    class atomic_ ## op<type> : public function<type (type*, type)> \
+    { \
+    public: \
+        atomic_ ## op() \
+            : function<type (type*, type)>("boost_atomic_" #op "_" #type) \
+        { \
+            this->set_source( \
+                detail::make_atomic_float_function_source<type>( \
+                    "boost_atomic_" #op "_" #type, #op \
+                ) \
+            ); \
+        } \
+    };
+
+BOOST_COMPUTE_DETAIL_DECLARE_ATOMIC_FLOAT_FUNCTION(add, float)
+BOOST_COMPUTE_DETAIL_DECLARE_ATOMIC_FLOAT_FUNCTION(add, double)
+BOOST_COMPUTE_DETAIL_DECLARE_ATOMIC_FLOAT_FUNCTION(min, float)
+BOOST_COMPUTE_DETAIL_DECLARE_ATOMIC_FLOAT_FUNCTION(min, double)
+BOOST_COMPUTE_DETAIL_DECLARE_ATOMIC_FLOAT_FUNCTION(max, float)
+BOOST_COMPUTE_DETAIL_DECLARE_ATOMIC_FLOAT_FUNCTION(max, double)
+
+#undef BOOST_COMPUTE_DETAIL_DECLARE_ATOMIC_FLOAT_FUNCTION
+
 } // end compute namespace
 } // end boost namespace
 
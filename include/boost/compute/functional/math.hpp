@@ -74,6 +74,38 @@ BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(tanpi, T (T), class T)
 BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(tgamma, T (T), class T)
 BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(trunc, T (T), class T)
 
+// the native_ and half_ variants of the math functions for float values,
+// see also scoped_math_precision
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(half_cos, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(half_divide, T (T, T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(half_exp, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(half_exp2, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(half_exp10, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(half_log, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(half_log2, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(half_log10, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(half_powr, T (T, T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(half_recip, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(half_rsqrt, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(half_sin, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(half_sqrt, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(half_tan, T (T), class T)
+
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(native_cos, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(native_divide, T (T, T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(native_exp, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(native_exp2, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(native_exp10, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(native_log, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(native_log2, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(native_log10, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(native_powr, T (T, T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(native_recip, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(native_rsqrt, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(native_sin, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(native_sqrt, T (T), class T)
+BOOST_COMPUTE_DECLARE_BUILTIN_FUNCTION(native_tan, T (T), class T)
+
 } // end compute namespace
 } // end boost namespace
 
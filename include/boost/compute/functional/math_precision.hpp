@@ -0,0 +1,141 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_FUNCTIONAL_MATH_PRECISION_HPP
+#define BOOST_COMPUTE_FUNCTIONAL_MATH_PRECISION_HPP
+
+#include <string>
+#include <algorithm>
+
+#include <boost/noncopyable.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/type_traits/scalar_type.hpp>
+#include <boost/compute/detail/global_static.hpp>
+
+namespace boost {
+namespace compute {
+
+/// The precisions of the built-in math functions in the generated kernels
+/// (see scoped_math_precision).
+enum math_precision {
+    /// The full-precision functions (e.g. \c sin).
+    math_precision_full,
+    /// The \c native_ functions (e.g. \c native_sin), whose accuracy and
+    /// input range are implementation-defined.
+    math_precision_native,
+    /// The \c half_ functions (e.g. \c half_sin), which have at least
+    /// 10 bits of accuracy.
+    math_precision_half
+};
+
+namespace detail {
+
+// the math precision made active with scoped_math_precision on this thread
+inline math_precision& active_math_precision()
+{
+    BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(
+        math_precision, precision, (math_precision_full)
+    );
+
+    return precision;
+}
+
+// meta-function returning true if the native_ and half_ math functions
+// are defined for T (float and the float vector types)
+template<class T>
+struct is_reduced_precision_math_type
+    : public boost::is_same<typename scalar_type<T>::type, float_> {};
+
+// returns the name of the variant of the built-in math function name for
+// the active precision, or name if the function has no such variant or
+// is not called with float values
+inline std::string math_function_name(const std::string &name, bool float_values)
+{
+    const math_precision precision = active_math_precision();
+    if(precision == math_precision_full || !float_values){
+        return name;
+    }
+
+    // sorted for the binary search
+    static const char *names[] = {
+        "cos", "divide", "exp", "exp10", "exp2", "log", "log10", "log2",
+        "powr", "recip", "rsqrt", "sin", "sqrt", "tan"
+    };
+    const char **names_end = names + sizeof(names) / sizeof(names[0]);
+    if(!std::binary_search(names, names_end, name)){
+        return name;
+    }
+
+    return (precision == math_precision_native ? "native_" : "half_") + name;
+}
+
+} // end detail namespace
+
+/// \class scoped_math_precision
+/// \brief Selects the precision of the built-in math functions for the
+///        current scope.
+///
+/// While the scoped_math_precision exists the built-in math functions of
+/// the kernels generated on this thread (the function objects in
+/// \c <boost/compute/functional/math.hpp>, such as \c sin<float>(), and
+/// the lambda functions, such as \c lambda::sin()) which have a
+/// \c native_ or \c half_ variant (\c cos, \c divide, \c exp, \c exp2,
+/// \c exp10, \c log, \c log2, \c log10, \c powr, \c recip, \c rsqrt,
+/// \c sin, \c sqrt and \c tan) call that variant instead when they are
+/// called with \c float values. Functions of other types and the source
+/// of user-defined functions are not changed.
+///
+/// The native functions are often several times faster than the
+/// full-precision ones. For example:
+/// \code
+/// {
+///     boost::compute::scoped_math_precision precision(
+///         boost::compute::math_precision_native
+///     );
+///
+///     // calls native_exp()
+///     boost::compute::transform(
+///         x.begin(), x.end(), y.begin(), boost::compute::exp<float>(), queue
+///     );
+/// }
+/// \endcode
+///
+/// The variants can also be called explicitly with the function objects
+/// such as \c native_sin<float>() and \c half_sin<float>().
+///
+/// Kernels are only generated with the active precision: a kernel built
+/// (and cached) at one precision is not rebuilt at another one for calls
+/// that do not generate their source again.
+class scoped_math_precision : boost::noncopyable
+{
+public:
+    /// Makes \p precision active until the object is destroyed.
+    explicit scoped_math_precision(math_precision precision)
+        : m_previous(detail::active_math_precision())
+    {
+        detail::active_math_precision() = precision;
+    }
+
+    /// Restores the previous precision.
+    ~scoped_math_precision()
+    {
+        detail::active_math_precision() = m_previous;
+    }
+
+private:
+    math_precision m_previous;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_FUNCTIONAL_MATH_PRECISION_HPP
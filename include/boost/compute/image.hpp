@@ -15,11 +15,15 @@
 ///
 /// Meta-header to include all Boost.Compute image headers.
 
+#include <boost/compute/image/convolve_image.hpp>
 #include <boost/compute/image/image1d.hpp>
 #include <boost/compute/image/image2d.hpp>
 #include <boost/compute/image/image3d.hpp>
 #include <boost/compute/image/image_format.hpp>
 #include <boost/compute/image/image_object.hpp>
 #include <boost/compute/image/image_sampler.hpp>
+#include <boost/compute/image/reduce_image.hpp>
+#include <boost/compute/image/transform_image.hpp>
+#include <boost/compute/image/walk_image.hpp>
 
 #endif // BOOST_COMPUTE_IMAGE_HPP
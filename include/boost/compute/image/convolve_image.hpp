@@ -0,0 +1,258 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_IMAGE_CONVOLVE_IMAGE_HPP
+#define BOOST_COMPUTE_IMAGE_CONVOLVE_IMAGE_HPP
+
+#include <cmath>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/image/image2d.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns the width of the square work-groups (and tiles) used to convolve
+// with a filter of radius on the queue's device. each work-group stores
+// (tile + 2 * radius) * tile texels in local memory.
+inline size_t convolve_image_tile_size(size_t radius, command_queue &queue)
+{
+    const device &device = queue.get_device();
+    const ulong_ local_memory =
+        device_profile::get(device)->local_memory_size();
+
+    for(size_t tile = 16; tile >= 4; tile /= 2){
+        const size_t tile_bytes = (tile + 2 * radius) * tile * sizeof(float4_);
+        if(tile * tile <= device.max_work_group_size() &&
+           tile_bytes <= local_memory){
+            return tile;
+        }
+    }
+
+    BOOST_THROW_EXCEPTION(opencl_error(CL_OUT_OF_RESOURCES));
+}
+
+// convolves the rows of input with weights and stores the result in the
+// float4 buffer output. each work-group loads its tile, extended by radius
+// texels on the left and right, into local memory once.
+inline void convolve_image_rows(const image2d &input,
+                                const buffer &output,
+                                const buffer &weights,
+                                size_t radius,
+                                size_t tile,
+                                command_queue &queue)
+{
+    const extents<2> size = input.size();
+    const size_t tile_width = tile + 2 * radius;
+
+    meta_kernel k("convolve_image_rows");
+    k.add_set_arg<int_>("width", static_cast<int_>(size[0]));
+    k.add_set_arg<int_>("height", static_cast<int_>(size[1]));
+    const std::string input_name =
+        k.get_image_identifier("__read_only", input, "input");
+    const std::string sampler = k.get_sampler_identifier(
+        false, CL_ADDRESS_CLAMP_TO_EDGE, CL_FILTER_NEAREST
+    );
+
+    k <<
+        "__local float4 tile[" << int_(tile) << "][" << int_(tile_width) << "];\n" <<
+        "const int lx = get_local_id(0);\n" <<
+        "const int ly = get_local_id(1);\n" <<
+        "const int x = get_global_id(0);\n" <<
+        "const int y = get_global_id(1);\n" <<
+        "const int x0 = (int) get_group_id(0) * " << int_(tile) <<
+            " - " << int_(radius) << ";\n" <<
+        "for(int i = lx; i < " << int_(tile_width) << "; i += " << int_(tile) << "){\n" <<
+        "    tile[ly][i] = read_imagef(" << input_name << ", " << sampler <<
+                ", (int2)(x0 + i, y));\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "if(x < width && y < height){\n" <<
+        "    float4 sum = (float4)(0.0f);\n" <<
+        "    for(int i = 0; i < " << int_(2 * radius + 1) << "; i++){\n" <<
+        "        sum += " <<
+                k.get_buffer_identifier<float>(weights, memory_object::constant_memory) <<
+                "[i] * tile[ly][lx + i];\n" <<
+        "    }\n" <<
+        "    " << k.get_buffer_identifier<float4_>(output) << "[y * width + x] = sum;\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+
+    const size_t global_size[] = {
+        (size[0] + tile - 1) / tile * tile, (size[1] + tile - 1) / tile * tile
+    };
+    const size_t local_size[] = { tile, tile };
+    queue.enqueue_nd_range_kernel(kernel, 2, 0, global_size, local_size);
+}
+
+// convolves the columns of the float4 buffer input with weights and writes
+// the result to output, tiles are extended by radius rows above and below
+inline void convolve_image_columns(const buffer &input,
+                                   image2d &output,
+                                   const buffer &weights,
+                                   size_t radius,
+                                   size_t tile,
+                                   command_queue &queue)
+{
+    const extents<2> size = output.size();
+    const size_t tile_height = tile + 2 * radius;
+
+    meta_kernel k("convolve_image_columns");
+    k.add_set_arg<int_>("width", static_cast<int_>(size[0]));
+    k.add_set_arg<int_>("height", static_cast<int_>(size[1]));
+    const std::string output_name =
+        k.get_image_identifier("__write_only", output, "output");
+
+    k <<
+        "__local float4 tile[" << int_(tile_height) << "][" << int_(tile) << "];\n" <<
+        "const int lx = get_local_id(0);\n" <<
+        "const int ly = get_local_id(1);\n" <<
+        "const int x = get_global_id(0);\n" <<
+        "const int y = get_global_id(1);\n" <<
+        "const int y0 = (int) get_group_id(1) * " << int_(tile) <<
+            " - " << int_(radius) << ";\n" <<
+        "const int column = min(x, width - 1);\n" <<
+        "for(int i = ly; i < " << int_(tile_height) << "; i += " << int_(tile) << "){\n" <<
+        "    const int row = clamp(y0 + i, 0, height - 1);\n" <<
+        "    tile[i][lx] = " <<
+                k.get_buffer_identifier<float4_>(input) << "[row * width + column];\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "if(x < width && y < height){\n" <<
+        "    float4 sum = (float4)(0.0f);\n" <<
+        "    for(int i = 0; i < " << int_(2 * radius + 1) << "; i++){\n" <<
+        "        sum += " <<
+                k.get_buffer_identifier<float>(weights, memory_object::constant_memory) <<
+                "[i] * tile[ly + i][lx];\n" <<
+        "    }\n" <<
+        "    write_imagef(" << output_name << ", (int2)(x, y), sum);\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+
+    const size_t global_size[] = {
+        (size[0] + tile - 1) / tile * tile, (size[1] + tile - 1) / tile * tile
+    };
+    const size_t local_size[] = { tile, tile };
+    queue.enqueue_nd_range_kernel(kernel, 2, 0, global_size, local_size);
+}
+
+} // end detail namespace
+
+/// Convolves \p input with the separable filter given by \p row_weights
+/// and \p column_weights and writes the result to \p output.
+///
+/// Both weight vectors must have the same odd size (2 * radius + 1) and
+/// the images must have the same size and formats read and written as
+/// \c float4_ (normalized or floating-point channels). Texels outside of
+/// \p input are clamped to its edges.
+///
+/// The rows are convolved first into a temporary buffer and then the
+/// columns, each pass loads the tile of its work-group (with the borders
+/// needed by the filter) into local memory once.
+///
+/// \see box_blur(), gaussian_blur()
+inline void convolve_image(const image2d &input,
+                           image2d &output,
+                           const std::vector<float> &row_weights,
+                           const std::vector<float> &column_weights,
+                           command_queue &queue)
+{
+    BOOST_ASSERT(row_weights.size() % 2 == 1);
+    BOOST_ASSERT(row_weights.size() == column_weights.size());
+    BOOST_ASSERT(input.size() == output.size());
+
+    const extents<2> size = input.size();
+    if(size[0] == 0 || size[1] == 0){
+        return;
+    }
+
+    const context &context = queue.get_context();
+    const size_t radius = row_weights.size() / 2;
+    const size_t tile = detail::convolve_image_tile_size(radius, queue);
+
+    buffer rows(context, row_weights.size() * sizeof(float), buffer::read_only);
+    buffer columns(context, column_weights.size() * sizeof(float), buffer::read_only);
+    queue.enqueue_write_buffer(rows, 0, rows.size(), &row_weights[0]);
+    queue.enqueue_write_buffer(columns, 0, columns.size(), &column_weights[0]);
+
+    buffer temporary(context, size[0] * size[1] * sizeof(float4_));
+
+    detail::convolve_image_rows(input, temporary, rows, radius, tile, queue);
+    detail::convolve_image_columns(temporary, output, columns, radius, tile, queue);
+}
+
+/// \overload
+///
+/// Uses \p weights for both the rows and the columns.
+inline void convolve_image(const image2d &input,
+                           image2d &output,
+                           const std::vector<float> &weights,
+                           command_queue &queue)
+{
+    convolve_image(input, output, weights, weights, queue);
+}
+
+/// Writes the average of the (2 * \p radius + 1)^2 texels around each
+/// texel of \p input to \p output.
+///
+/// \see convolve_image()
+inline void box_blur(const image2d &input,
+                     image2d &output,
+                     size_t radius,
+                     command_queue &queue)
+{
+    const std::vector<float> weights(2 * radius + 1, 1.0f / (2 * radius + 1));
+
+    convolve_image(input, output, weights, queue);
+}
+
+/// Blurs \p input with a gaussian filter of standard deviation \p sigma
+/// (truncated at 3 * \p sigma) and writes the result to \p output.
+///
+/// \see convolve_image()
+inline void gaussian_blur(const image2d &input,
+                          image2d &output,
+                          float sigma,
+                          command_queue &queue)
+{
+    BOOST_ASSERT(sigma > 0.0f);
+
+    const size_t radius = static_cast<size_t>(std::ceil(3.0f * sigma));
+
+    std::vector<float> weights(2 * radius + 1);
+    float sum = 0.0f;
+    for(size_t i = 0; i < weights.size(); i++){
+        const float x = static_cast<float>(i) - static_cast<float>(radius);
+        weights[i] = std::exp(-(x * x) / (2.0f * sigma * sigma));
+        sum += weights[i];
+    }
+    for(size_t i = 0; i < weights.size(); i++){
+        weights[i] /= sum;
+    }
+
+    convolve_image(input, output, weights, queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_IMAGE_CONVOLVE_IMAGE_HPP
@@ -0,0 +1,57 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_IMAGE_DETAIL_TEXEL_FUNCTIONS_HPP
+#define BOOST_COMPUTE_IMAGE_DETAIL_TEXEL_FUNCTIONS_HPP
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/types/fundamental.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// names of the opencl functions reading and writing texels of type T,
+// which must be float4_, int4_ or uint4_ (matching the channel data type
+// of the image format: normalized and floating-point formats are read and
+// written as float4)
+template<class T>
+struct texel_functions
+{
+    BOOST_STATIC_ASSERT(sizeof(T) == 0);
+};
+
+template<>
+struct texel_functions<float4_>
+{
+    static const char* read() { return "read_imagef"; }
+    static const char* write() { return "write_imagef"; }
+};
+
+template<>
+struct texel_functions<int4_>
+{
+    static const char* read() { return "read_imagei"; }
+    static const char* write() { return "write_imagei"; }
+};
+
+template<>
+struct texel_functions<uint4_>
+{
+    static const char* read() { return "read_imageui"; }
+    static const char* write() { return "write_imageui"; }
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_IMAGE_DETAIL_TEXEL_FUNCTIONS_HPP
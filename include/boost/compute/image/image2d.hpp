@@ -157,6 +157,13 @@ public:
         }
     }
 
+    /// Creates a new image2d object for \p mem. If \p retain is \c true,
+    /// the reference count for \p mem will be incremented.
+    explicit image2d(cl_mem mem, bool retain = true)
+        : image_object(mem, retain)
+    {
+    }
+
     /// Creates a new image2d as a copy of \p other.
     image2d(const image2d &other)
       : image_object(other)
@@ -0,0 +1,214 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_IMAGE_REDUCE_IMAGE_HPP
+#define BOOST_COMPUTE_IMAGE_REDUCE_IMAGE_HPP
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include <boost/assert.hpp>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/histogram.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/detail/local_histogram.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/image/image2d.hpp>
+#include <boost/compute/image/detail/texel_functions.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// number of consecutive texels of a row reduced by each work-item in the
+// first pass of reduce_image()
+const size_t reduce_image_texels_per_thread = 32;
+
+} // end detail namespace
+
+/// Returns the result of reducing all the texels of \p image with
+/// \p function, each channel being reduced separately.
+///
+/// The texel type (\c float4_, \c int4_ or \c uint4_) is the result type
+/// of \p function and must match the channel data type of the image
+/// format. \p function must be associative and commutative.
+///
+/// Each work-item first reduces a run of texels of a row (read through the
+/// texture cache), the partial results are then reduced with reduce().
+///
+/// For example, to sum the channels of an image:
+///
+/// \code
+/// float4_ sum = boost::compute::reduce_image(
+///     image, boost::compute::plus<float4_>(), queue
+/// );
+/// \endcode
+template<class BinaryFunction>
+inline typename BinaryFunction::result_type
+reduce_image(const image2d &image,
+             BinaryFunction function,
+             command_queue &queue)
+{
+    typedef typename BinaryFunction::result_type texel_type;
+
+    const extents<2> size = image.size();
+    BOOST_ASSERT(size[0] > 0 && size[1] > 0);
+
+    const size_t texels_per_thread = detail::reduce_image_texels_per_thread;
+    const size_t columns =
+        (size[0] + texels_per_thread - 1) / texels_per_thread;
+
+    vector<texel_type> partials(columns * size[1], queue.get_context());
+
+    detail::meta_kernel k("reduce_image");
+    k.add_set_arg<int_>("width", static_cast<int_>(size[0]));
+    const std::string image_name =
+        k.get_image_identifier("__read_only", image, "image");
+    const std::string sampler = k.get_sampler_identifier(
+        false, CL_ADDRESS_CLAMP_TO_EDGE, CL_FILTER_NEAREST
+    );
+
+    k <<
+        "const int column = get_global_id(0);\n" <<
+        "const int y = get_global_id(1);\n" <<
+        "const int x0 = column * " << int_(texels_per_thread) << ";\n" <<
+        "const int x1 = min(x0 + " << int_(texels_per_thread) << ", width);\n" <<
+        k.decl<texel_type>("result") << " = " <<
+            detail::texel_functions<texel_type>::read() << "(" <<
+            image_name << ", " << sampler << ", (int2)(x0, y));\n" <<
+        "for(int x = x0 + 1; x < x1; x++){\n" <<
+        "    " << k.decl<const texel_type>("texel") << " = " <<
+                detail::texel_functions<texel_type>::read() << "(" <<
+                image_name << ", " << sampler << ", (int2)(x, y));\n" <<
+        "    result = " << function(k.var<texel_type>("result"),
+                                     k.var<texel_type>("texel")) << ";\n" <<
+        "}\n" <<
+        partials.begin()[k.var<uint_>("y * get_global_size(0) + column")] <<
+            " = result;\n";
+
+    kernel kernel = k.compile(queue.get_context());
+
+    const size_t global_size[] = { columns, size[1] };
+    queue.enqueue_nd_range_kernel(kernel, 2, 0, global_size, 0);
+
+    texel_type result;
+    ::boost::compute::reduce(
+        partials.begin(), partials.end(), &result, function, queue
+    );
+    return result;
+}
+
+/// Computes the histogram of each channel of \p image in \p bin_count
+/// bins of equal width over [0, 1] and stores it in \p bins, which must
+/// hold 4 * \p bin_count counts of type \c uint_ (the histogram of the
+/// channel \c c being stored at \p bins + \c c * \p bin_count).
+///
+/// The texels are read as \c float4_ so the image must have a normalized
+/// or floating-point channel data type (for example the histograms of an
+/// \c CL_UNORM_INT8 image with 256 bins count each 8-bit value). Values
+/// outside of [0, 1] are not counted.
+///
+/// When the bins fit in local memory each work-group counts its texels in
+/// private bins merged into \p bins at the end, see histogram().
+///
+/// \see histogram()
+template<class OutputIterator>
+inline OutputIterator image_histogram(const image2d &image,
+                                      OutputIterator bins,
+                                      size_t bin_count,
+                                      command_queue &queue)
+{
+    const extents<2> size = image.size();
+    const size_t total_bins = 4 * bin_count;
+
+    ::boost::compute::fill_n(bins, total_bins, uint_(0), queue);
+    if(size[0] == 0 || size[1] == 0 || bin_count == 0){
+        return bins + total_bins;
+    }
+
+    const bool local_bins = total_bins <= detail::histogram_max_local_bins(queue);
+
+    detail::meta_kernel k("image_histogram");
+    k.add_function("local_histogram", detail::local_histogram_source);
+    k.add_set_arg<int_>("width", static_cast<int_>(size[0]));
+    k.add_set_arg<int_>("height", static_cast<int_>(size[1]));
+    k.add_set_arg<uint_>("bin_count", static_cast<uint_>(bin_count));
+    k.add_set_arg<uint_>("total_bins", static_cast<uint_>(total_bins));
+    const std::string image_name =
+        k.get_image_identifier("__read_only", image, "image");
+    const std::string sampler = k.get_sampler_identifier(
+        false, CL_ADDRESS_CLAMP_TO_EDGE, CL_FILTER_NEAREST
+    );
+
+    std::stringstream output_stream;
+    output_stream << "(__global uint *)("
+                  << k.get_buffer_identifier<uint_>(bins.get_buffer())
+                  << " + " << bins.get_index() << ")";
+    const std::string output = output_stream.str();
+
+    size_t local_bins_arg = 0;
+    if(local_bins){
+        local_bins_arg =
+            k.add_arg<uint_ *>(memory_object::local_memory, "local_bins");
+        k << "local_histogram_clear(local_bins, total_bins);\n";
+    }
+
+    k <<
+        "const int x = get_global_id(0);\n" <<
+        "const int y = get_global_id(1);\n" <<
+        "if(x < width && y < height){\n" <<
+        "    const float4 texel = read_imagef(" << image_name << ", " <<
+                sampler << ", (int2)(x, y));\n" <<
+        "    const float channels[] = { texel.x, texel.y, texel.z, texel.w };\n" <<
+        "    for(uint c = 0; c < 4; c++){\n" <<
+        "        const float v = channels[c];\n" <<
+        "        if(v >= 0.0f && v <= 1.0f){\n" <<
+        "            const uint bin = min((uint)(v * bin_count), bin_count - 1);\n";
+    if(local_bins){
+        k << "            local_histogram_add(local_bins, c * bin_count + bin);\n";
+    }
+    else {
+        k << "            atomic_inc(" << output << " + c * bin_count + bin);\n";
+    }
+    k <<
+        "        }\n" <<
+        "    }\n" <<
+        "}\n";
+    if(local_bins){
+        k << "local_histogram_merge(local_bins, " << output << ", total_bins);\n";
+        k.set_arg(local_bins_arg, local_buffer<uint_>(total_bins));
+    }
+
+    kernel kernel = k.compile(queue.get_context());
+
+    const size_t tile = 16;
+    const size_t global_size[] = {
+        (size[0] + tile - 1) / tile * tile, (size[1] + tile - 1) / tile * tile
+    };
+    const size_t local_size[] = { tile, tile };
+    queue.enqueue_nd_range_kernel(
+        kernel, 2, 0, global_size,
+        queue.get_device().max_work_group_size() >= tile * tile ? local_size : 0
+    );
+
+    return bins + total_bins;
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_IMAGE_REDUCE_IMAGE_HPP
@@ -0,0 +1,141 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_IMAGE_TRANSFORM_IMAGE_HPP
+#define BOOST_COMPUTE_IMAGE_TRANSFORM_IMAGE_HPP
+
+#include <boost/type_traits/function_traits.hpp>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/image/image2d.hpp>
+#include <boost/compute/image/image_sampler.hpp>
+#include <boost/compute/image/detail/texel_functions.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+template<class UnaryFunction>
+inline void dispatch_transform_image(const image2d &input,
+                                     image2d &output,
+                                     UnaryFunction function,
+                                     const image_sampler *sampler,
+                                     command_queue &queue)
+{
+    typedef typename boost::function_traits<
+        typename UnaryFunction::signature
+    >::arg1_type input_texel_type;
+    typedef typename UnaryFunction::result_type output_texel_type;
+
+    const extents<2> input_size = input.size();
+    const extents<2> output_size = output.size();
+    if(output_size[0] == 0 || output_size[1] == 0){
+        return;
+    }
+
+    meta_kernel k("transform_image");
+
+    const std::string input_name =
+        k.get_image_identifier("__read_only", input, "input");
+    const std::string output_name =
+        k.get_image_identifier("__write_only", output, "output");
+
+    std::string sampler_name;
+    if(sampler){
+        sampler_name = "sampler";
+        k.add_set_arg<image_sampler>(sampler_name, *sampler);
+    }
+    else {
+        sampler_name = k.get_sampler_identifier(
+            false, CL_ADDRESS_CLAMP_TO_EDGE, CL_FILTER_NEAREST
+        );
+    }
+
+    // ratio of the input and output sizes, texels are read at the center
+    // of the output texel mapped to the input image
+    k.add_set_arg<float2_>(
+        "scale",
+        float2_(static_cast<float>(input_size[0]) / output_size[0],
+                static_cast<float>(input_size[1]) / output_size[1])
+    );
+
+    k <<
+        "const int2 coord = (int2)(get_global_id(0), get_global_id(1));\n" <<
+        "const float2 source = ((float2)(coord.x, coord.y) + 0.5f) * scale;\n" <<
+        k.decl<const input_texel_type>("texel") << " = " <<
+            texel_functions<input_texel_type>::read() << "(" <<
+            input_name << ", " << sampler_name << ", source);\n" <<
+        texel_functions<output_texel_type>::write() << "(" <<
+            output_name << ", coord, " <<
+            function(k.var<input_texel_type>("texel")) << ");\n";
+
+    kernel kernel = k.compile(queue.get_context());
+
+    queue.enqueue_nd_range_kernel(
+        kernel, extents<2>(0), output_size, extents<2>(0)
+    );
+}
+
+} // end detail namespace
+
+/// Writes the result of \p function applied to each texel of \p input to
+/// the corresponding texel of \p output.
+///
+/// \p function takes and returns \c float4_, \c int4_ or \c uint4_ texels
+/// matching the channel data types of the image formats (normalized and
+/// floating-point formats are read and written as \c float4_).
+///
+/// The texels are read through the texture cache with \p sampler, which
+/// must use unnormalized coordinates. When the images have different sizes
+/// each output texel is mapped to the corresponding position in \p input,
+/// so a sampler with linear filtering resizes the image.
+///
+/// For example, to convert an RGBA image to grayscale:
+///
+/// \code
+/// BOOST_COMPUTE_FUNCTION(float4_, luminance, (float4_ color),
+/// {
+///     const float y = dot(color.xyz, (float3)(0.299f, 0.587f, 0.114f));
+///     return (float4)(y, y, y, color.w);
+/// });
+///
+/// boost::compute::transform_image(input, output, luminance, queue);
+/// \endcode
+///
+/// \see walk_image()
+template<class UnaryFunction>
+inline void transform_image(const image2d &input,
+                            image2d &output,
+                            UnaryFunction function,
+                            const image_sampler &sampler,
+                            command_queue &queue)
+{
+    detail::dispatch_transform_image(input, output, function, &sampler, queue);
+}
+
+/// \overload
+///
+/// The texels are read with nearest filtering and clamped to the edges of
+/// \p input.
+template<class UnaryFunction>
+inline void transform_image(const image2d &input,
+                            image2d &output,
+                            UnaryFunction function,
+                            command_queue &queue)
+{
+    detail::dispatch_transform_image(input, output, function, 0, queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_IMAGE_TRANSFORM_IMAGE_HPP
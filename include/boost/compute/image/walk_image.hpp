@@ -0,0 +1,246 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_IMAGE_WALK_IMAGE_HPP
+#define BOOST_COMPUTE_IMAGE_WALK_IMAGE_HPP
+
+#include <algorithm>
+#include <cstring>
+
+#include <boost/static_assert.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/exception/unsupported_extension_error.hpp>
+#include <boost/compute/image/image2d.hpp>
+#include <boost/compute/image/image3d.hpp>
+#include <boost/compute/image/detail/texel_functions.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/utility/extents.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+template<class Image, class Coord, class Function, size_t N>
+inline void dispatch_walk_image(Image &image,
+                                const char *coord,
+                                const extents<N> &origin,
+                                const extents<N> &region,
+                                Function function,
+                                meta_kernel &k,
+                                command_queue &queue)
+{
+    typedef typename Function::result_type texel_type;
+
+    for(size_t i = 0; i < N; i++){
+        if(region[i] == 0){
+            return;
+        }
+    }
+
+    const std::string image_name =
+        k.get_image_identifier("__write_only", image);
+
+    k <<
+        k.decl<const Coord>("coord") << " = " << coord << ";\n" <<
+        texel_functions<texel_type>::write() << "(" <<
+            image_name << ", coord, " << function(k.var<Coord>("coord")) <<
+        ");\n";
+
+    kernel kernel = k.compile(queue.get_context());
+
+    queue.enqueue_nd_range_kernel(kernel, origin, region, extents<N>(0));
+}
+
+template<class T>
+inline void rawfill_image_pattern(const buffer &pattern,
+                                  size_t count,
+                                  const void *fill_color,
+                                  command_queue &queue)
+{
+    T value;
+    std::memcpy(&value, fill_color, sizeof(T));
+
+    ::boost::compute::fill(
+        make_buffer_iterator<T>(pattern, 0),
+        make_buffer_iterator<T>(pattern, count),
+        value,
+        queue
+    );
+}
+
+} // end detail namespace
+
+/// Writes the texels of \p image in the rectangle starting at \p origin of
+/// size \p region with the values returned by \p function for their
+/// coordinates.
+///
+/// \p function is called on the device for each texel with its coordinate
+/// (as \c int2_) and must return a \c float4_, \c int4_ or \c uint4_ texel
+/// matching the channel type of the image format. This is the device-side
+/// counterpart of command_queue::enqueue_walk_image() for writing images.
+///
+/// For example, to draw a horizontal gradient:
+///
+/// \code
+/// BOOST_COMPUTE_FUNCTION(float4_, gradient, (int2_ coord),
+/// {
+///     return (float4)(coord.x / 1024.0f, 0.0f, 0.0f, 1.0f);
+/// });
+///
+/// boost::compute::walk_image(image, gradient, queue);
+/// \endcode
+///
+/// \see rawfill_image()
+template<class Function>
+inline void walk_image(image2d &image,
+                       const extents<2> &origin,
+                       const extents<2> &region,
+                       Function function,
+                       command_queue &queue)
+{
+    detail::meta_kernel k("walk_image2d");
+
+    detail::dispatch_walk_image<image2d, int2_>(
+        image,
+        "(int2)(get_global_id(0), get_global_id(1))",
+        origin,
+        region,
+        function,
+        k,
+        queue
+    );
+}
+
+/// \overload
+template<class Function>
+inline void walk_image(image2d &image,
+                       Function function,
+                       command_queue &queue)
+{
+    walk_image(image, image.origin(), image.size(), function, queue);
+}
+
+/// Writes the texels of the 3D \p image in the box starting at \p origin of
+/// size \p region with the values returned by \p function for their
+/// coordinates (as \c int4_ with a \c w component of zero).
+///
+/// Throws unsupported_extension_error if the device does not support the
+/// \c cl_khr_3d_image_writes extension.
+template<class Function>
+inline void walk_image(image3d &image,
+                       const extents<3> &origin,
+                       const extents<3> &region,
+                       Function function,
+                       command_queue &queue)
+{
+    const char extension[] = "cl_khr_3d_image_writes";
+    if(!queue.get_device().supports_extension(extension)){
+        BOOST_THROW_EXCEPTION(unsupported_extension_error(extension));
+    }
+
+    detail::meta_kernel k("walk_image3d");
+    k.add_extension_pragma(extension);
+
+    detail::dispatch_walk_image<image3d, int4_>(
+        image,
+        "(int4)(get_global_id(0), get_global_id(1), get_global_id(2), 0)",
+        origin,
+        region,
+        function,
+        k,
+        queue
+    );
+}
+
+/// \overload
+template<class Function>
+inline void walk_image(image3d &image,
+                       Function function,
+                       command_queue &queue)
+{
+    walk_image(image, image.origin(), image.size(), function, queue);
+}
+
+/// Fills the rectangle of \p image starting at \p origin of size \p region
+/// with the raw texel pointed to by \p fill_color (which must be
+/// \c CL_IMAGE_ELEMENT_SIZE bytes long).
+///
+/// Unlike command_queue::enqueue_rawfill_image_walking() the image is not
+/// mapped on the host, the texels are expanded into a temporary buffer on
+/// the device which is then copied to the image. This works on all OpenCL
+/// versions.
+inline void rawfill_image(image_object &image,
+                          const void *fill_color,
+                          const size_t *origin,
+                          const size_t *region,
+                          command_queue &queue)
+{
+    const size_t element_size =
+        image.get_image_info<size_t>(CL_IMAGE_ELEMENT_SIZE);
+    const size_t count = region[0] * region[1] * region[2];
+    if(count == 0){
+        return;
+    }
+
+    buffer pattern(queue.get_context(), count * element_size);
+
+    switch(element_size){
+    case 1:
+        detail::rawfill_image_pattern<uchar_>(pattern, count, fill_color, queue);
+        break;
+    case 2:
+        detail::rawfill_image_pattern<ushort_>(pattern, count, fill_color, queue);
+        break;
+    case 4:
+        detail::rawfill_image_pattern<uint_>(pattern, count, fill_color, queue);
+        break;
+    case 8:
+        detail::rawfill_image_pattern<uint2_>(pattern, count, fill_color, queue);
+        break;
+    case 16:
+        detail::rawfill_image_pattern<uint4_>(pattern, count, fill_color, queue);
+        break;
+    default:
+        BOOST_THROW_EXCEPTION(opencl_error(CL_IMAGE_FORMAT_NOT_SUPPORTED));
+    }
+
+    queue.enqueue_copy_buffer_to_image(pattern, image, 0, origin, region);
+}
+
+/// \overload
+template<size_t N>
+inline void rawfill_image(image_object &image,
+                          const void *fill_color,
+                          const extents<N> &origin,
+                          const extents<N> &region,
+                          command_queue &queue)
+{
+    BOOST_STATIC_ASSERT(N <= 3);
+
+    size_t origin3[3] = { 0, 0, 0 };
+    size_t region3[3] = { 1, 1, 1 };
+
+    std::copy(origin.data(), origin.data() + N, origin3);
+    std::copy(region.data(), region.data() + N, region3);
+
+    rawfill_image(image, fill_color, origin3, region3, queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_IMAGE_WALK_IMAGE_HPP
@@ -12,5 +12,6 @@
 #define BOOST_COMPUTE_INTEROP_EIGEN_HPP
 
 #include <boost/compute/interop/eigen/core.hpp>
+#include <boost/compute/interop/eigen/matrix.hpp>
 
 #endif // BOOST_COMPUTE_INTEROP_EIGEN_HPP
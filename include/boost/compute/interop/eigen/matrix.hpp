@@ -0,0 +1,381 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_INTEROP_EIGEN_MATRIX_HPP
+#define BOOST_COMPUTE_INTEROP_EIGEN_MATRIX_HPP
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include <Eigen/Core>
+
+#include <boost/assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/linear_algebra/gemm.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class eigen_device_matrix
+/// \brief A batch of dense matrices stored on the device.
+///
+/// The matrices are stored with the same layout as Eigen matrices: in
+/// column-major (the Eigen default) or row-major order, with a leading
+/// dimension (the distance between two columns, or two rows for row-major
+/// matrices) which may be larger than the number of rows (or columns).
+///
+/// A device matrix may hold a batch of matrices of the same size stored
+/// one after the other, which are multiplied in a single kernel by
+/// eigen_gemm().
+///
+/// \see eigen_copy_matrix_to_device_async(), eigen_gemm(), eigen_gemv()
+template<class T>
+class eigen_device_matrix
+{
+public:
+    typedef T scalar_type;
+    typedef buffer_iterator<T> iterator;
+
+    /// Creates a batch of \p batch_size \p rows x \p cols matrices in
+    /// \p context with the storage order \p options (\c Eigen::ColMajor or
+    /// \c Eigen::RowMajor). If \p leading_dimension is zero the columns (or
+    /// rows) are packed.
+    eigen_device_matrix(size_t rows,
+                        size_t cols,
+                        const context &context = system::default_context(),
+                        int options = Eigen::ColMajor,
+                        size_t leading_dimension = 0,
+                        size_t batch_size = 1)
+        : m_rows(rows),
+          m_cols(cols),
+          m_row_major((options & Eigen::RowMajor) != 0),
+          m_leading_dimension(leading_dimension),
+          m_batch_size(batch_size)
+    {
+        if(m_leading_dimension == 0){
+            m_leading_dimension = m_row_major ? cols : rows;
+        }
+        BOOST_ASSERT(m_leading_dimension >= (m_row_major ? cols : rows));
+
+        m_data = vector<T>((std::max)(size(), size_t(1)), context);
+    }
+
+    /// Returns the number of rows of each matrix.
+    size_t rows() const
+    {
+        return m_rows;
+    }
+
+    /// Returns the number of columns of each matrix.
+    size_t cols() const
+    {
+        return m_cols;
+    }
+
+    /// Returns \c true if the matrices are stored in row-major order.
+    bool is_row_major() const
+    {
+        return m_row_major;
+    }
+
+    /// Returns the leading dimension of the matrices.
+    size_t leading_dimension() const
+    {
+        return m_leading_dimension;
+    }
+
+    /// Returns the number of matrices in the batch.
+    size_t batch_size() const
+    {
+        return m_batch_size;
+    }
+
+    /// Returns the number of values between two matrices of the batch.
+    size_t stride() const
+    {
+        return m_leading_dimension * (m_row_major ? m_rows : m_cols);
+    }
+
+    /// Returns the number of values stored for the batch.
+    size_t size() const
+    {
+        return stride() * m_batch_size;
+    }
+
+    /// Returns an iterator to the first value of the matrix \p index of the
+    /// batch.
+    iterator begin(size_t index = 0)
+    {
+        return m_data.begin() + static_cast<std::ptrdiff_t>(index * stride());
+    }
+
+    /// Returns an iterator to the end of the matrix \p index of the batch.
+    iterator end(size_t index = 0)
+    {
+        return begin(index) + static_cast<std::ptrdiff_t>(stride());
+    }
+
+    /// Returns the buffer storing the matrices.
+    const buffer& get_buffer() const
+    {
+        return m_data.get_buffer();
+    }
+
+    /// Returns an opencl expression for the offset of the element at
+    /// (\p row, \p col) of the matrix \p index in the buffer.
+    std::string offset_expression(const std::string &index,
+                                  const std::string &row,
+                                  const std::string &col) const
+    {
+        std::stringstream stream;
+        stream << "(" << index << ") * " << stride() << " + ";
+        if(m_row_major){
+            stream << "(" << row << ") * " << m_leading_dimension << " + (" << col << ")";
+        }
+        else {
+            stream << "(" << col << ") * " << m_leading_dimension << " + (" << row << ")";
+        }
+        return stream.str();
+    }
+
+private:
+    size_t m_rows;
+    size_t m_cols;
+    bool m_row_major;
+    size_t m_leading_dimension;
+    size_t m_batch_size;
+    vector<T> m_data;
+};
+
+/// Enqueues an asynchronous copy of \p matrix to the matrix \p index of
+/// the batch \p result, which must have the same size and storage order
+/// as \p matrix and packed columns (or rows).
+///
+/// The data of \p matrix must not be modified until the returned future
+/// is complete.
+template<class Derived>
+inline future<buffer_iterator<typename Derived::Scalar> >
+eigen_copy_matrix_to_device_async(const Eigen::PlainObjectBase<Derived> &matrix,
+                                  eigen_device_matrix<typename Derived::Scalar> &result,
+                                  size_t index,
+                                  command_queue &queue = system::default_queue())
+{
+    BOOST_ASSERT(size_t(matrix.rows()) == result.rows());
+    BOOST_ASSERT(size_t(matrix.cols()) == result.cols());
+    BOOST_ASSERT(bool(Derived::IsRowMajor) == result.is_row_major());
+    BOOST_ASSERT(result.stride() == size_t(matrix.size()));
+
+    return ::boost::compute::copy_async(
+        matrix.data(), matrix.data() + matrix.size(), result.begin(index), queue
+    );
+}
+
+/// Enqueues an asynchronous copy of the matrix \p index of the batch
+/// \p matrix to \p result, which must have the same size and storage
+/// order.
+template<class Derived>
+inline future<typename Derived::Scalar *>
+eigen_copy_device_to_matrix_async(eigen_device_matrix<typename Derived::Scalar> &matrix,
+                                  size_t index,
+                                  Eigen::PlainObjectBase<Derived> &result,
+                                  command_queue &queue = system::default_queue())
+{
+    BOOST_ASSERT(size_t(result.rows()) == matrix.rows());
+    BOOST_ASSERT(size_t(result.cols()) == matrix.cols());
+    BOOST_ASSERT(bool(Derived::IsRowMajor) == matrix.is_row_major());
+    BOOST_ASSERT(matrix.stride() == size_t(result.size()));
+
+    return ::boost::compute::copy_async(
+        matrix.begin(index), matrix.end(index), result.data(), queue
+    );
+}
+
+/// Computes C = \p alpha * A * B + \p beta * C for each matrix of the
+/// batches \p a, \p b and \p c (which must all hold the same number of
+/// matrices, or one matrix for \p a or \p b which is then used for the
+/// whole batch).
+///
+/// Each work-group computes a square block of C, loading the blocks of A
+/// and B it needs in local memory so that each value is read from global
+/// memory once per work-group. The kernel is the one of gemm() (with the
+/// same \c "__boost_gemm" block size) adapted to the storage orders. All
+/// storage orders are supported.
+template<class T>
+inline void eigen_gemm(const eigen_device_matrix<T> &a,
+                       const eigen_device_matrix<T> &b,
+                       eigen_device_matrix<T> &c,
+                       T alpha,
+                       T beta,
+                       command_queue &queue = system::default_queue())
+{
+    BOOST_ASSERT(a.cols() == b.rows());
+    BOOST_ASSERT(a.rows() == c.rows() && b.cols() == c.cols());
+    BOOST_ASSERT(a.batch_size() == c.batch_size() || a.batch_size() == 1);
+    BOOST_ASSERT(b.batch_size() == c.batch_size() || b.batch_size() == 1);
+
+    const size_t m = c.rows();
+    const size_t n = c.cols();
+    const size_t depth = a.cols();
+    if(m == 0 || n == 0 || c.batch_size() == 0){
+        return;
+    }
+
+    const uint_ tile = detail::gemm_tile_size(queue, sizeof(T));
+
+    detail::meta_kernel k("eigen_gemm");
+    k.add_set_arg<uint_>("m", static_cast<uint_>(m));
+    k.add_set_arg<uint_>("n", static_cast<uint_>(n));
+    k.add_set_arg<uint_>("depth", static_cast<uint_>(depth));
+    k.add_set_arg<T>("alpha", alpha);
+    k.add_set_arg<T>("beta", beta);
+
+    const std::string a_data = k.get_buffer_identifier<T>(a.get_buffer());
+    const std::string b_data = k.get_buffer_identifier<T>(b.get_buffer());
+    const std::string c_data = k.get_buffer_identifier<T>(c.get_buffer());
+    const char *a_index = a.batch_size() == 1 ? "0" : "batch";
+    const char *b_index = b.batch_size() == 1 ? "0" : "batch";
+
+    // the tiled body of gemm() with the offsets of the storage orders, the
+    // matrices of the batch are selected by the third dimension
+    k << "const uint batch = get_global_id(2);\n";
+    detail::gemm_tiled_body<T>(
+        k,
+        tile,
+        a_data + "[" + a.offset_expression(a_index, "row", "t + lx") + "]",
+        b_data + "[" + b.offset_expression(b_index, "t + ly", "col") + "]",
+        c_data + "[" + c.offset_expression("batch", "row", "col") + "]",
+        beta != T(0)
+    );
+
+    kernel kernel = k.compile(queue.get_context());
+
+    const size_t global_size[] = {
+        (n + tile - 1) / tile * tile, (m + tile - 1) / tile * tile, c.batch_size()
+    };
+    const size_t local_size[] = { tile, tile, 1 };
+    queue.enqueue_nd_range_kernel(kernel, 3, 0, global_size, local_size);
+}
+
+/// Computes y = \p alpha * A * x + \p beta * y for each matrix of the
+/// batch \p a, where \p x and \p y are batches of column vectors.
+///
+/// For row-major matrices each row is reduced by a work-group reading the
+/// row with coalesced accesses, for column-major matrices each work-item
+/// computes a row (consecutive work-items reading consecutive values).
+template<class T>
+inline void eigen_gemv(const eigen_device_matrix<T> &a,
+                       const eigen_device_matrix<T> &x,
+                       eigen_device_matrix<T> &y,
+                       T alpha,
+                       T beta,
+                       command_queue &queue = system::default_queue())
+{
+    BOOST_ASSERT(x.cols() == 1 && y.cols() == 1);
+    BOOST_ASSERT(a.cols() == x.rows() && a.rows() == y.rows());
+    BOOST_ASSERT(a.batch_size() == y.batch_size() || a.batch_size() == 1);
+    BOOST_ASSERT(x.batch_size() == y.batch_size() || x.batch_size() == 1);
+
+    const size_t m = a.rows();
+    const size_t depth = a.cols();
+    if(m == 0 || y.batch_size() == 0){
+        return;
+    }
+
+    // the work-group size must be a power of two for the reduction
+    size_t work_group_size = 64;
+    while(work_group_size > queue.get_device().max_work_group_size()){
+        work_group_size /= 2;
+    }
+
+    detail::meta_kernel k("eigen_gemv");
+    k.add_set_arg<uint_>("m", static_cast<uint_>(m));
+    k.add_set_arg<uint_>("depth", static_cast<uint_>(depth));
+    k.add_set_arg<T>("alpha", alpha);
+    k.add_set_arg<T>("beta", beta);
+
+    const std::string a_data = k.get_buffer_identifier<T>(a.get_buffer());
+    const std::string x_data = k.get_buffer_identifier<T>(x.get_buffer());
+    const std::string y_data = k.get_buffer_identifier<T>(y.get_buffer());
+    const char *a_index = a.batch_size() == 1 ? "0" : "batch";
+    const char *x_index = x.batch_size() == 1 ? "0" : "batch";
+
+    std::string result;
+    if(a.is_row_major()){
+        k <<
+            "__local " << k.type<T>() << " partial[" << uint_(work_group_size) << "];\n" <<
+            "const uint row = get_group_id(0);\n" <<
+            "const uint batch = get_global_id(1);\n" <<
+            "const uint lid = get_local_id(0);\n" <<
+            k.decl<T>("sum") << " = 0;\n" <<
+            "for(uint j = lid; j < depth; j += " << uint_(work_group_size) << "){\n" <<
+            "    sum += " << a_data << "[" << a.offset_expression(a_index, "row", "j") << "] * " <<
+                    x_data << "[" << x.offset_expression(x_index, "j", "0") << "];\n" <<
+            "}\n" <<
+            "partial[lid] = sum;\n" <<
+            "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+            "for(uint s = " << uint_(work_group_size / 2) << "; s > 0; s >>= 1){\n" <<
+            "    if(lid < s){\n" <<
+            "        partial[lid] += partial[lid + s];\n" <<
+            "    }\n" <<
+            "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+            "}\n" <<
+            "if(lid == 0){\n";
+        result = "partial[0]";
+    }
+    else {
+        k <<
+            "const uint row = get_global_id(0);\n" <<
+            "const uint batch = get_global_id(1);\n" <<
+            k.decl<T>("sum") << " = 0;\n" <<
+            "for(uint j = 0; j < depth; j++){\n" <<
+            "    sum += " << a_data << "[" << a.offset_expression(a_index, "row", "j") << "] * " <<
+                    x_data << "[" << x.offset_expression(x_index, "j", "0") << "];\n" <<
+            "}\n" <<
+            "if(row < m){\n";
+        result = "sum";
+    }
+
+    k << "    const uint index = " << y.offset_expression("batch", "row", "0") << ";\n";
+    // y is not read when beta is zero so that it may be uninitialized
+    if(beta == T(0)){
+        k << "    " << y_data << "[index] = alpha * " << result << ";\n";
+    }
+    else {
+        k << "    " << y_data << "[index] = alpha * " << result <<
+             " + beta * " << y_data << "[index];\n";
+    }
+    k << "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+
+    if(a.is_row_major()){
+        const size_t global_size[] = { m * work_group_size, y.batch_size() };
+        const size_t local_size[] = { work_group_size, 1 };
+        queue.enqueue_nd_range_kernel(kernel, 2, 0, global_size, local_size);
+    }
+    else {
+        const size_t global_size[] = { m, y.batch_size() };
+        queue.enqueue_nd_range_kernel(kernel, 2, 0, global_size, 0);
+    }
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_INTEROP_EIGEN_MATRIX_HPP
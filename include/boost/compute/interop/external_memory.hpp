@@ -0,0 +1,25 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_HPP
+#define BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_HPP
+
+/// \file
+///
+/// Meta-header to include all Boost.Compute external memory (Vulkan and
+/// Direct3D 12) interop headers.
+
+#include <boost/compute/interop/external_memory/acquire.hpp>
+#include <boost/compute/interop/external_memory/extension.hpp>
+#include <boost/compute/interop/external_memory/external_buffer.hpp>
+#include <boost/compute/interop/external_memory/external_image2d.hpp>
+#include <boost/compute/interop/external_memory/external_semaphore.hpp>
+
+#endif // BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_HPP
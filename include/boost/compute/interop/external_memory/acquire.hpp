@@ -0,0 +1,260 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_ACQUIRE_HPP
+#define BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_ACQUIRE_HPP
+
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/interop/external_memory/extension.hpp>
+#include <boost/compute/interop/external_memory/external_semaphore.hpp>
+#include <boost/compute/utility/wait_list.hpp>
+
+#ifdef BOOST_COMPUTE_HAVE_EXTERNAL_MEMORY
+
+namespace boost {
+namespace compute {
+
+/// Enqueues a command to acquire the specified external memory objects
+/// (external_buffer or external_image2d objects) for use by OpenCL.
+///
+/// \see_opencl_ref{clEnqueueAcquireExternalMemObjectsKHR}
+inline event external_enqueue_acquire_mem_objects(size_t num_objects,
+                                                  const cl_mem *mem_objects,
+                                                  command_queue &queue,
+                                                  const wait_list &events = wait_list())
+{
+    BOOST_ASSERT(queue != 0);
+
+    const detail::external_memory_functions functions(queue.get_device().platform());
+
+    event event_;
+
+    cl_int ret = functions.acquire_mem_objects(queue.get(),
+                                               static_cast<cl_uint>(num_objects),
+                                               mem_objects,
+                                               events.size(),
+                                               events.get_event_ptr(),
+                                               &event_.get());
+    if(ret != CL_SUCCESS){
+        BOOST_THROW_EXCEPTION(opencl_error(ret));
+    }
+
+    return event_;
+}
+
+/// Enqueues a command to release the specified external memory objects
+/// for use by the API they were imported from.
+///
+/// \see_opencl_ref{clEnqueueReleaseExternalMemObjectsKHR}
+inline event external_enqueue_release_mem_objects(size_t num_objects,
+                                                  const cl_mem *mem_objects,
+                                                  command_queue &queue,
+                                                  const wait_list &events = wait_list())
+{
+    BOOST_ASSERT(queue != 0);
+
+    const detail::external_memory_functions functions(queue.get_device().platform());
+
+    event event_;
+
+    cl_int ret = functions.release_mem_objects(queue.get(),
+                                               static_cast<cl_uint>(num_objects),
+                                               mem_objects,
+                                               events.size(),
+                                               events.get_event_ptr(),
+                                               &event_.get());
+    if(ret != CL_SUCCESS){
+        BOOST_THROW_EXCEPTION(opencl_error(ret));
+    }
+
+    return event_;
+}
+
+/// Enqueues a command which waits for \p semaphore to be signaled (e.g.
+/// by the Vulkan queue rendering into the imported memory) before the
+/// commands enqueued afterwards on \p queue run.
+///
+/// \see_opencl_ref{clEnqueueWaitSemaphoresKHR}
+inline event external_enqueue_wait_semaphore(const external_semaphore &semaphore,
+                                             command_queue &queue,
+                                             const wait_list &events = wait_list())
+{
+    BOOST_ASSERT(queue != 0);
+    BOOST_ASSERT(!semaphore.is_null());
+
+    event event_;
+
+    cl_int ret = semaphore.get_functions().wait_semaphores(queue.get(),
+                                                           1,
+                                                           &semaphore.get(),
+                                                           0,
+                                                           events.size(),
+                                                           events.get_event_ptr(),
+                                                           &event_.get());
+    if(ret != CL_SUCCESS){
+        BOOST_THROW_EXCEPTION(opencl_error(ret));
+    }
+
+    return event_;
+}
+
+/// Enqueues a command which signals \p semaphore once the commands
+/// enqueued before on \p queue finished, for the other API to wait on.
+///
+/// \see_opencl_ref{clEnqueueSignalSemaphoresKHR}
+inline event external_enqueue_signal_semaphore(const external_semaphore &semaphore,
+                                               command_queue &queue,
+                                               const wait_list &events = wait_list())
+{
+    BOOST_ASSERT(queue != 0);
+    BOOST_ASSERT(!semaphore.is_null());
+
+    event event_;
+
+    cl_int ret = semaphore.get_functions().signal_semaphores(queue.get(),
+                                                             1,
+                                                             &semaphore.get(),
+                                                             0,
+                                                             events.size(),
+                                                             events.get_event_ptr(),
+                                                             &event_.get());
+    if(ret != CL_SUCCESS){
+        BOOST_THROW_EXCEPTION(opencl_error(ret));
+    }
+
+    return event_;
+}
+
+/// \class external_scoped_acquire
+/// \brief Acquires external memory objects for a scope.
+///
+/// Waits for an optional semaphore signaled by the other API, acquires all
+/// the external buffers and images in a range with a single command and,
+/// when release() is called or the object is destroyed, releases them and
+/// signals an optional semaphore for the other API. All synchronization
+/// happens on the device so the host never waits.
+///
+/// For example, in a Vulkan render loop:
+///
+/// \code
+/// {
+///     boost::compute::external_scoped_acquire acquire(
+///         objects.begin(), objects.end(), queue, rendered, computed
+///     );
+///
+///     // run kernels using the objects
+/// }
+///
+/// // submit Vulkan commands waiting on the computed semaphore
+/// \endcode
+class external_scoped_acquire : boost::noncopyable
+{
+public:
+    /// Acquires the memory objects in [\p first, \p last) on \p queue
+    /// after \p wait_semaphore (if not null) and \p events. The release
+    /// signals \p signal_semaphore (if not null).
+    template<class MemoryObjectIterator>
+    external_scoped_acquire(MemoryObjectIterator first,
+                            MemoryObjectIterator last,
+                            command_queue &queue,
+                            const external_semaphore &wait_semaphore = external_semaphore(),
+                            const external_semaphore &signal_semaphore = external_semaphore(),
+                            const wait_list &events = wait_list())
+        : m_queue(queue),
+          m_signal_semaphore(signal_semaphore),
+          m_acquired(false)
+    {
+        for(; first != last; ++first){
+            BOOST_ASSERT(first->get_context() == queue.get_context());
+            m_objects.push_back(first->get());
+        }
+
+        if(m_objects.empty()){
+            return;
+        }
+
+        wait_list acquire_events = events;
+        if(!wait_semaphore.is_null()){
+            acquire_events.insert(
+                external_enqueue_wait_semaphore(wait_semaphore, m_queue, events)
+            );
+        }
+
+        m_acquire_event = external_enqueue_acquire_mem_objects(
+            m_objects.size(), &m_objects[0], m_queue, acquire_events
+        );
+        m_acquired = true;
+    }
+
+    /// Releases the objects if they have not been released with release().
+    ~external_scoped_acquire()
+    {
+        if(m_acquired){
+            try {
+                release();
+            }
+            catch(...){
+            }
+        }
+    }
+
+    /// Returns the event of the acquire command.
+    const event& get_acquire_event() const
+    {
+        return m_acquire_event;
+    }
+
+    /// Releases the objects after \p events, signals the semaphore and
+    /// returns the event of the last command.
+    event release(const wait_list &events = wait_list())
+    {
+        BOOST_ASSERT(m_acquired);
+
+        m_acquired = false;
+
+        event release_event = external_enqueue_release_mem_objects(
+            m_objects.size(), &m_objects[0], m_queue, events
+        );
+
+        if(!m_signal_semaphore.is_null()){
+            release_event = external_enqueue_signal_semaphore(
+                m_signal_semaphore, m_queue, release_event
+            );
+        }
+
+        // submit the commands so the other api does not wait for them
+        // until the next flush of the queue
+        m_queue.flush();
+
+        return release_event;
+    }
+
+private:
+    command_queue m_queue;
+    external_semaphore m_signal_semaphore;
+    std::vector<cl_mem> m_objects;
+    bool m_acquired;
+    event m_acquire_event;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_HAVE_EXTERNAL_MEMORY
+
+#endif // BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_ACQUIRE_HPP
@@ -0,0 +1,118 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_EXTENSION_HPP
+#define BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_EXTENSION_HPP
+
+#include <vector>
+
+#include <boost/throw_exception.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/cl_ext.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/platform.hpp>
+#include <boost/compute/exception/unsupported_extension_error.hpp>
+
+// the external memory interop needs the cl_khr_external_memory and
+// cl_khr_external_semaphore declarations of the OpenCL 3.0 headers
+#if (defined(cl_khr_external_memory) && \
+     defined(cl_khr_external_semaphore) && \
+     defined(CL_VERSION_3_0)) || \
+    defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+#  define BOOST_COMPUTE_HAVE_EXTERNAL_MEMORY
+#endif
+
+#ifdef BOOST_COMPUTE_HAVE_EXTERNAL_MEMORY
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// the functions of the external memory and semaphore extensions of a
+// platform, they are not exported by the ICD loader
+struct external_memory_functions
+{
+    explicit external_memory_functions(const platform &platform_)
+    {
+        const char *memory = "cl_khr_external_memory";
+        const char *semaphore = "cl_khr_external_semaphore";
+
+        load(platform_, "clEnqueueAcquireExternalMemObjectsKHR", memory, acquire_mem_objects);
+        load(platform_, "clEnqueueReleaseExternalMemObjectsKHR", memory, release_mem_objects);
+        load(platform_, "clCreateSemaphoreWithPropertiesKHR", semaphore, create_semaphore);
+        load(platform_, "clRetainSemaphoreKHR", semaphore, retain_semaphore);
+        load(platform_, "clReleaseSemaphoreKHR", semaphore, release_semaphore);
+        load(platform_, "clEnqueueWaitSemaphoresKHR", semaphore, wait_semaphores);
+        load(platform_, "clEnqueueSignalSemaphoresKHR", semaphore, signal_semaphores);
+    }
+
+    template<class Function>
+    static void load(const platform &platform_,
+                     const char *name,
+                     const char *extension,
+                     Function &function)
+    {
+        function = reinterpret_cast<Function>(
+            platform_.get_extension_function_address(name)
+        );
+        if(!function){
+            BOOST_THROW_EXCEPTION(unsupported_extension_error(extension));
+        }
+    }
+
+    clEnqueueAcquireExternalMemObjectsKHR_fn acquire_mem_objects;
+    clEnqueueReleaseExternalMemObjectsKHR_fn release_mem_objects;
+    clCreateSemaphoreWithPropertiesKHR_fn create_semaphore;
+    clRetainSemaphoreKHR_fn retain_semaphore;
+    clReleaseSemaphoreKHR_fn release_semaphore;
+    clEnqueueWaitSemaphoresKHR_fn wait_semaphores;
+    clEnqueueSignalSemaphoresKHR_fn signal_semaphores;
+};
+
+} // end detail namespace
+
+/// Returns \c true if \p device supports importing memory objects and
+/// semaphores from other APIs (e.g. Vulkan or Direct3D 12) with the
+/// \c cl_khr_external_memory and \c cl_khr_external_semaphore extensions.
+///
+/// \see external_memory_import_handle_types()
+inline bool external_memory_supported(const device &device)
+{
+    return device.supports_extension("cl_khr_external_memory") &&
+           device.supports_extension("cl_khr_external_semaphore");
+}
+
+/// Returns the handle types (e.g. \c CL_EXTERNAL_MEMORY_HANDLE_OPAQUE_FD_KHR)
+/// of the memory which \p device can import.
+inline std::vector<cl_external_memory_handle_type_khr>
+external_memory_import_handle_types(const device &device)
+{
+    return device.get_info<std::vector<cl_external_memory_handle_type_khr> >(
+        CL_DEVICE_EXTERNAL_MEMORY_IMPORT_HANDLE_TYPES_KHR
+    );
+}
+
+/// Returns the handle types (e.g. \c CL_SEMAPHORE_HANDLE_OPAQUE_FD_KHR) of
+/// the semaphores which \p device can import.
+inline std::vector<cl_external_semaphore_handle_type_khr>
+external_semaphore_import_handle_types(const device &device)
+{
+    return device.get_info<std::vector<cl_external_semaphore_handle_type_khr> >(
+        CL_DEVICE_SEMAPHORE_IMPORT_HANDLE_TYPES_KHR
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_HAVE_EXTERNAL_MEMORY
+
+#endif // BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_EXTENSION_HPP
@@ -0,0 +1,120 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_EXTERNAL_BUFFER_HPP
+#define BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_EXTERNAL_BUFFER_HPP
+
+#include <boost/throw_exception.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/interop/external_memory/extension.hpp>
+
+#ifdef BOOST_COMPUTE_HAVE_EXTERNAL_MEMORY
+
+namespace boost {
+namespace compute {
+
+/// \class external_buffer
+///
+/// A OpenCL buffer for accessing memory exported by another API (e.g. a
+/// Vulkan \c VkDeviceMemory exported with \c vkGetMemoryFdKHR()) without
+/// copies.
+///
+/// The buffer must be acquired with external_enqueue_acquire_mem_objects()
+/// (or external_scoped_acquire) before it is used by OpenCL commands.
+///
+/// \see external_image2d, external_semaphore
+class external_buffer : public buffer
+{
+public:
+    /// Creates a null external buffer object.
+    external_buffer()
+        : buffer()
+    {
+    }
+
+    /// Creates a new external buffer object for \p mem.
+    explicit external_buffer(cl_mem mem, bool retain = true)
+        : buffer(mem, retain)
+    {
+    }
+
+    /// Creates a new buffer object in \p context for the first \p size
+    /// bytes of the external memory \p handle of \p handle_type with
+    /// \p flags.
+    ///
+    /// For example, to import Vulkan memory exported as a file descriptor:
+    /// \code
+    /// boost::compute::external_buffer vertices(
+    ///     context, size, CL_EXTERNAL_MEMORY_HANDLE_OPAQUE_FD_KHR, fd
+    /// );
+    /// \endcode
+    ///
+    /// Windows handles (e.g. shared Direct3D 12 resources with
+    /// \c CL_EXTERNAL_MEMORY_HANDLE_OPAQUE_WIN32_KHR) are passed as
+    /// \c reinterpret_cast<cl_mem_properties>(handle).
+    ///
+    /// \see_opencl_ref{clCreateBufferWithProperties}
+    external_buffer(const context &context,
+                    size_t size,
+                    cl_external_memory_handle_type_khr handle_type,
+                    cl_mem_properties handle,
+                    cl_mem_flags flags = read_write)
+    {
+        const cl_mem_properties properties[] = {
+            static_cast<cl_mem_properties>(handle_type), handle, 0
+        };
+
+        cl_int error = 0;
+        m_mem = clCreateBufferWithProperties(
+            context, properties, flags, size, 0, &error
+        );
+        if(!m_mem){
+            BOOST_THROW_EXCEPTION(opencl_error(error));
+        }
+    }
+
+    /// Creates a new external buffer object as a copy of \p other.
+    external_buffer(const external_buffer &other)
+        : buffer(other)
+    {
+    }
+
+    /// Copies the external buffer object from \p other.
+    external_buffer& operator=(const external_buffer &other)
+    {
+        if(this != &other){
+            buffer::operator=(other);
+        }
+
+        return *this;
+    }
+
+    /// Destroys the external buffer object.
+    ~external_buffer()
+    {
+    }
+};
+
+namespace detail {
+
+// set_kernel_arg specialization for external_buffer
+template<>
+struct set_kernel_arg<external_buffer> : set_kernel_arg<memory_object> { };
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_HAVE_EXTERNAL_MEMORY
+
+#endif // BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_EXTERNAL_BUFFER_HPP
@@ -0,0 +1,132 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_EXTERNAL_IMAGE2D_HPP
+#define BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_EXTERNAL_IMAGE2D_HPP
+
+#include <boost/throw_exception.hpp>
+
+#include <boost/compute/context.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/image/image2d.hpp>
+#include <boost/compute/image/image_format.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/interop/external_memory/extension.hpp>
+
+#ifdef BOOST_COMPUTE_HAVE_EXTERNAL_MEMORY
+
+namespace boost {
+namespace compute {
+
+/// \class external_image2d
+///
+/// A OpenCL image2d for accessing an image exported by another API (e.g.
+/// a Vulkan \c VkImage or a Direct3D 12 texture) without copies.
+///
+/// The image must be acquired with external_enqueue_acquire_mem_objects()
+/// (or external_scoped_acquire) before it is used by OpenCL commands.
+///
+/// \see external_buffer, external_semaphore
+class external_image2d : public image2d
+{
+public:
+    /// Creates a null external image object.
+    external_image2d()
+        : image2d()
+    {
+    }
+
+    /// Creates a new external image object for \p mem.
+    explicit external_image2d(cl_mem mem, bool retain = true)
+        : image2d(mem, retain)
+    {
+    }
+
+    /// Creates a new image object in \p context with \p width x \p height
+    /// pixels of \p format for the external memory \p handle of
+    /// \p handle_type with \p flags.
+    ///
+    /// The format and the row pitch must match the layout of the exported
+    /// image, which for Vulkan images means a linear tiling (or a device
+    /// reporting the handle type in
+    /// \c CL_DEVICE_EXTERNAL_MEMORY_IMPORT_ASSUME_LINEAR_IMAGES_HANDLE_TYPES_KHR).
+    ///
+    /// \see_opencl_ref{clCreateImageWithProperties}
+    external_image2d(const context &context,
+                     size_t width,
+                     size_t height,
+                     const image_format &format,
+                     cl_external_memory_handle_type_khr handle_type,
+                     cl_mem_properties handle,
+                     cl_mem_flags flags = read_write,
+                     size_t row_pitch = 0)
+    {
+        const cl_mem_properties properties[] = {
+            static_cast<cl_mem_properties>(handle_type), handle, 0
+        };
+
+        cl_image_desc desc;
+        desc.image_type = CL_MEM_OBJECT_IMAGE2D;
+        desc.image_width = width;
+        desc.image_height = height;
+        desc.image_depth = 1;
+        desc.image_array_size = 0;
+        desc.image_row_pitch = row_pitch;
+        desc.image_slice_pitch = 0;
+        desc.num_mip_levels = 0;
+        desc.num_samples = 0;
+        desc.mem_object = 0;
+
+        cl_int error = 0;
+        m_mem = clCreateImageWithProperties(
+            context, properties, flags, format.get_format_ptr(), &desc, 0, &error
+        );
+        if(!m_mem){
+            BOOST_THROW_EXCEPTION(opencl_error(error));
+        }
+    }
+
+    /// Creates a new external image object as a copy of \p other.
+    external_image2d(const external_image2d &other)
+        : image2d(other)
+    {
+    }
+
+    /// Copies the external image object from \p other.
+    external_image2d& operator=(const external_image2d &other)
+    {
+        if(this != &other){
+            image2d::operator=(other);
+        }
+
+        return *this;
+    }
+
+    /// Destroys the external image object.
+    ~external_image2d()
+    {
+    }
+};
+
+namespace detail {
+
+// set_kernel_arg specialization for external_image2d
+template<>
+struct set_kernel_arg<external_image2d> : set_kernel_arg<image_object> { };
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+BOOST_COMPUTE_TYPE_NAME(boost::compute::external_image2d, image2d_t)
+
+#endif // BOOST_COMPUTE_HAVE_EXTERNAL_MEMORY
+
+#endif // BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_EXTERNAL_IMAGE2D_HPP
@@ -0,0 +1,147 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_EXTERNAL_SEMAPHORE_HPP
+#define BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_EXTERNAL_SEMAPHORE_HPP
+
+#include <boost/shared_ptr.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/compute/context.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/detail/assert_cl_success.hpp>
+#include <boost/compute/interop/external_memory/extension.hpp>
+
+#ifdef BOOST_COMPUTE_HAVE_EXTERNAL_MEMORY
+
+namespace boost {
+namespace compute {
+
+/// \class external_semaphore
+/// \brief A binary semaphore shared with another API.
+///
+/// The external_semaphore class imports a semaphore exported by another
+/// API (e.g. a Vulkan \c VkSemaphore exported with \c vkGetSemaphoreFdKHR()
+/// or a shared Direct3D 12 fence) in order to order OpenCL commands and the
+/// commands of the other API on the device, without waiting on the host.
+///
+/// \see external_enqueue_wait_semaphore(), external_enqueue_signal_semaphore(),
+///      external_scoped_acquire
+class external_semaphore
+{
+public:
+    /// Creates a null semaphore object.
+    external_semaphore()
+        : m_semaphore(0)
+    {
+    }
+
+    /// Imports the semaphore \p handle of \p handle_type (e.g.
+    /// \c CL_SEMAPHORE_HANDLE_OPAQUE_FD_KHR) in \p context.
+    ///
+    /// Windows handles are passed as
+    /// \c reinterpret_cast<cl_semaphore_properties_khr>(handle).
+    ///
+    /// \see_opencl_ref{clCreateSemaphoreWithPropertiesKHR}
+    external_semaphore(const context &context,
+                       cl_external_semaphore_handle_type_khr handle_type,
+                       cl_semaphore_properties_khr handle)
+        : m_functions(new detail::external_memory_functions(
+              context.get_device().platform()
+          ))
+    {
+        const cl_semaphore_properties_khr properties[] = {
+            static_cast<cl_semaphore_properties_khr>(CL_SEMAPHORE_TYPE_KHR),
+            static_cast<cl_semaphore_properties_khr>(CL_SEMAPHORE_TYPE_BINARY_KHR),
+            static_cast<cl_semaphore_properties_khr>(handle_type),
+            handle,
+            0
+        };
+
+        cl_int error = 0;
+        m_semaphore = m_functions->create_semaphore(context, properties, &error);
+        if(!m_semaphore){
+            BOOST_THROW_EXCEPTION(opencl_error(error));
+        }
+    }
+
+    /// Creates a new semaphore object as a copy of \p other.
+    external_semaphore(const external_semaphore &other)
+        : m_semaphore(other.m_semaphore),
+          m_functions(other.m_functions)
+    {
+        if(m_semaphore){
+            BOOST_COMPUTE_ASSERT_CL_SUCCESS(
+                m_functions->retain_semaphore(m_semaphore)
+            );
+        }
+    }
+
+    /// Copies the semaphore object from \p other.
+    external_semaphore& operator=(const external_semaphore &other)
+    {
+        if(this != &other){
+            if(other.m_semaphore){
+                BOOST_COMPUTE_ASSERT_CL_SUCCESS(
+                    other.m_functions->retain_semaphore(other.m_semaphore)
+                );
+            }
+            if(m_semaphore){
+                BOOST_COMPUTE_ASSERT_CL_SUCCESS(
+                    m_functions->release_semaphore(m_semaphore)
+                );
+            }
+
+            m_semaphore = other.m_semaphore;
+            m_functions = other.m_functions;
+        }
+
+        return *this;
+    }
+
+    /// Destroys the semaphore object.
+    ~external_semaphore()
+    {
+        if(m_semaphore){
+            BOOST_COMPUTE_ASSERT_CL_SUCCESS(
+                m_functions->release_semaphore(m_semaphore)
+            );
+        }
+    }
+
+    /// Returns the underlying OpenCL semaphore.
+    const cl_semaphore_khr& get() const
+    {
+        return m_semaphore;
+    }
+
+    /// \internal_
+    const detail::external_memory_functions& get_functions() const
+    {
+        return *m_functions;
+    }
+
+    /// Returns \c true if the semaphore is null.
+    bool is_null() const
+    {
+        return m_semaphore == 0;
+    }
+
+private:
+    cl_semaphore_khr m_semaphore;
+    boost::shared_ptr<detail::external_memory_functions> m_functions;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_HAVE_EXTERNAL_MEMORY
+
+#endif // BOOST_COMPUTE_INTEROP_EXTERNAL_MEMORY_EXTERNAL_SEMAPHORE_HPP
@@ -0,0 +1,197 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_INTEROP_OPENCV_UMAT_HPP
+#define BOOST_COMPUTE_INTEROP_OPENCV_UMAT_HPP
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/core/ocl.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/exception/unsupported_extension_error.hpp>
+#include <boost/compute/image/image2d.hpp>
+#include <boost/compute/image/image_format.hpp>
+#include <boost/compute/interop/opencv/core.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Returns the OpenCL context used by OpenCV's transparent API (cv::UMat),
+/// or a null context if OpenCV is not using OpenCL.
+inline context opencv_umat_get_context()
+{
+    void *ocl_context = cv::ocl::Context::getDefault(false).ptr();
+    if(!ocl_context){
+        return context();
+    }
+
+    return context(static_cast<cl_context>(ocl_context));
+}
+
+/// Returns the OpenCL command queue used by OpenCV's transparent API, or a
+/// null command queue if OpenCV is not using OpenCL.
+///
+/// Boost.Compute algorithms enqueued on this queue are ordered with the
+/// OpenCV operations on cv::UMat objects, so no synchronization is needed
+/// when alternating between the two libraries.
+inline command_queue opencv_umat_get_command_queue()
+{
+    void *ocl_queue = cv::ocl::Queue::getDefault().ptr();
+    if(!ocl_queue){
+        return command_queue();
+    }
+
+    return command_queue(static_cast<cl_command_queue>(ocl_queue));
+}
+
+/// Makes OpenCV's transparent API use the context and device of \p queue,
+/// so that cv::UMat objects are allocated in the same context as the
+/// Boost.Compute objects.
+inline void opencv_umat_attach_context(const command_queue &queue)
+{
+    const device device = queue.get_device();
+    const platform platform = device.platform();
+
+    cv::ocl::attachContext(
+        platform.name(), platform.id(), queue.get_context().get(), device.id()
+    );
+}
+
+/// Returns the OpenCL buffer holding the data of \p mat. The buffer aliases
+/// the memory of \p mat (no copy is made) and keeps it alive.
+///
+/// OpenCV may reallocate the data of \p mat (e.g. when it is resized or
+/// assigned), after which the returned buffer no longer refers to it.
+///
+/// \see opencv_umat_begin()
+inline buffer opencv_umat_get_buffer(const cv::UMat &mat,
+                                     int access_flags = cv::ACCESS_RW)
+{
+    return buffer(static_cast<cl_mem>(mat.handle(access_flags)));
+}
+
+/// Returns a buffer iterator to the first element of \p mat, accounting for
+/// the offset of \p mat in its buffer (for sub-matrices).
+///
+/// \p mat must be continuous to be accessed as a range of
+/// \c mat.rows * \c mat.cols * \c mat.channels() values of type \c T.
+template<class T>
+inline buffer_iterator<T> opencv_umat_begin(const cv::UMat &mat,
+                                            int access_flags = cv::ACCESS_RW)
+{
+    BOOST_ASSERT(mat.offset % sizeof(T) == 0);
+
+    return make_buffer_iterator<T>(
+        opencv_umat_get_buffer(mat, access_flags), mat.offset / sizeof(T)
+    );
+}
+
+/// Returns a buffer iterator to the end of the continuous \p mat.
+template<class T>
+inline buffer_iterator<T> opencv_umat_end(const cv::UMat &mat,
+                                          int access_flags = cv::ACCESS_RW)
+{
+    BOOST_ASSERT(mat.isContinuous());
+
+    return opencv_umat_begin<T>(mat, access_flags) +
+        static_cast<std::ptrdiff_t>(mat.total() * mat.channels());
+}
+
+/// Returns an image2d sharing the memory of \p mat (no copy is made).
+///
+/// The image is created from the buffer of \p mat with the format returned
+/// by opencv_get_mat_image_format(), which requires the
+/// \c cl_khr_image2d_from_buffer extension (core in OpenCL 2.0) and a row
+/// pitch of \p mat satisfying the device's image pitch alignment.
+inline image2d opencv_umat_get_image2d(const cv::UMat &mat,
+                                       cl_mem_flags flags = image2d::read_write,
+                                       int access_flags = cv::ACCESS_RW)
+{
+    BOOST_ASSERT(mat.offset == 0);
+
+    const context context = opencv_umat_get_context();
+    const device device = context.get_device();
+
+    const char extension[] = "cl_khr_image2d_from_buffer";
+    if(!device.check_version(2, 0) && !device.supports_extension(extension)){
+        BOOST_THROW_EXCEPTION(unsupported_extension_error(extension));
+    }
+
+#if defined(CL_VERSION_1_2)
+    // the format only depends on the type, avoid mapping the data of mat
+    const image_format format =
+        opencv_get_mat_image_format(cv::Mat(1, 1, mat.type()));
+
+    cl_image_desc desc;
+    desc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    desc.image_width = mat.cols;
+    desc.image_height = mat.rows;
+    desc.image_depth = 1;
+    desc.image_array_size = 0;
+    desc.image_row_pitch = mat.step;
+    desc.image_slice_pitch = 0;
+    desc.num_mip_levels = 0;
+    desc.num_samples = 0;
+    #ifdef CL_VERSION_2_0
+    desc.mem_object = static_cast<cl_mem>(mat.handle(access_flags));
+    #else
+    desc.buffer = static_cast<cl_mem>(mat.handle(access_flags));
+    #endif
+
+    cl_int error = 0;
+    cl_mem mem = clCreateImage(
+        context, flags, format.get_format_ptr(), &desc, 0, &error
+    );
+    if(!mem){
+        BOOST_THROW_EXCEPTION(opencl_error(error));
+    }
+
+    return image2d(mem, false);
+#else
+    (void) flags;
+    (void) access_flags;
+    BOOST_THROW_EXCEPTION(unsupported_extension_error(extension));
+#endif
+}
+
+/// Returns a cv::UMat of \p rows x \p cols elements of OpenCV \p type
+/// sharing the memory of \p buffer (no copy is made), with rows \p step
+/// bytes apart (by default the rows are packed).
+///
+/// \p buffer must have been created in the context of OpenCV's transparent
+/// API (see opencv_umat_attach_context()).
+inline cv::UMat opencv_umat_from_buffer(const buffer &buffer,
+                                        int rows,
+                                        int cols,
+                                        int type,
+                                        size_t step = 0)
+{
+    if(step == 0){
+        step = cols * CV_ELEM_SIZE(type);
+    }
+    BOOST_ASSERT(step * rows <= buffer.size());
+
+    cv::UMat mat;
+    cv::ocl::convertFromBuffer(buffer.get(), step, rows, cols, type, mat);
+    return mat;
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_INTEROP_OPENCV_UMAT_HPP
@@ -11,8 +11,20 @@
 #ifndef BOOST_COMPUTE_INTEROP_OPENGL_ACQUIRE_HPP
 #define BOOST_COMPUTE_INTEROP_OPENGL_ACQUIRE_HPP
 
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/throw_exception.hpp>
+
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/memory_object.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/exception/unsupported_extension_error.hpp>
+#include <boost/compute/interop/opengl/gl.hpp>
 #include <boost/compute/interop/opengl/cl_gl.hpp>
+#include <boost/compute/interop/opengl/cl_gl_ext.hpp>
 #include <boost/compute/interop/opengl/opengl_buffer.hpp>
 #include <boost/compute/utility/wait_list.hpp>
 
@@ -93,6 +105,163 @@ inline event opengl_enqueue_release_buffer(const opengl_buffer &buffer,
     return opengl_enqueue_release_gl_objects(1, &buffer.get(), queue, events);
 }
 
+/// Returns \c true if \p device supports the \c cl_khr_gl_event extension,
+/// in which case acquiring and releasing OpenGL objects implicitly
+/// synchronizes with the OpenGL context current in the calling thread
+/// (glFinish() and clFinish() are not needed around them).
+inline bool opengl_supports_implicit_sync(const device &device)
+{
+    return device.supports_extension("cl_khr_gl_event");
+}
+
+/// Returns an event which completes when the OpenGL fence \p sync
+/// (created with glFenceSync()) is signaled. The event can be passed to
+/// the wait list of an acquire to wait for OpenGL commands issued in
+/// another thread or context without calling glFinish().
+///
+/// \see_opencl_ref{clCreateEventFromGLsyncKHR}
+inline event opengl_create_event_from_gl_sync(cl_GLsync sync,
+                                              const context &context)
+{
+    typedef cl_event (*CreateEventFromGLsyncKHRFunction)(
+        cl_context, cl_GLsync, cl_int *
+    );
+
+    const device device = context.get_device();
+    if(!opengl_supports_implicit_sync(device)){
+        BOOST_THROW_EXCEPTION(unsupported_extension_error("cl_khr_gl_event"));
+    }
+
+    CreateEventFromGLsyncKHRFunction CreateEventFromGLsyncKHR =
+        reinterpret_cast<CreateEventFromGLsyncKHRFunction>(
+            reinterpret_cast<size_t>(
+                device.platform().get_extension_function_address(
+                    "clCreateEventFromGLsyncKHR"
+                )
+            )
+        );
+    if(!CreateEventFromGLsyncKHR){
+        BOOST_THROW_EXCEPTION(unsupported_extension_error("cl_khr_gl_event"));
+    }
+
+    cl_int error = 0;
+    cl_event event_ = CreateEventFromGLsyncKHR(context.get(), sync, &error);
+    if(!event_){
+        BOOST_THROW_EXCEPTION(opencl_error(error));
+    }
+
+    return event(event_, false);
+}
+
+/// \class opengl_scoped_acquire
+/// \brief Acquires OpenGL objects for a scope.
+///
+/// Acquires all the OpenGL buffers, textures and renderbuffers in a range
+/// with a single call to \c clEnqueueAcquireGLObjects() and releases them
+/// together when release() is called or the object is destroyed.
+///
+/// When the device supports \c cl_khr_gl_event the acquire and release
+/// synchronize implicitly with OpenGL and the release just flushes the
+/// queue, so OpenCL and OpenGL work can overlap. Otherwise glFinish() is
+/// called before the acquire and the release waits for its completion, as
+/// required by the OpenCL specification.
+///
+/// For example, in a render loop:
+///
+/// \code
+/// {
+///     boost::compute::opengl_scoped_acquire acquire(
+///         objects.begin(), objects.end(), queue
+///     );
+///
+///     // run kernels using the objects
+/// }
+///
+/// // draw with the objects
+/// \endcode
+///
+/// \see opengl_create_event_from_gl_sync()
+class opengl_scoped_acquire : boost::noncopyable
+{
+public:
+    /// Acquires the memory objects in [\p first, \p last) on \p queue
+    /// after \p events.
+    template<class MemoryObjectIterator>
+    opengl_scoped_acquire(MemoryObjectIterator first,
+                          MemoryObjectIterator last,
+                          command_queue &queue,
+                          const wait_list &events = wait_list())
+        : m_queue(queue),
+          m_implicit_sync(opengl_supports_implicit_sync(queue.get_device())),
+          m_acquired(false)
+    {
+        for(; first != last; ++first){
+            BOOST_ASSERT(first->get_context() == queue.get_context());
+            m_objects.push_back(first->get());
+        }
+
+        if(m_objects.empty()){
+            return;
+        }
+
+        if(!m_implicit_sync){
+            glFinish();
+        }
+
+        m_acquire_event = opengl_enqueue_acquire_gl_objects(
+            m_objects.size(), &m_objects[0], m_queue, events
+        );
+        m_acquired = true;
+    }
+
+    /// Releases the objects if they have not been released with release().
+    ~opengl_scoped_acquire()
+    {
+        if(m_acquired){
+            try {
+                release();
+            }
+            catch(...){
+            }
+        }
+    }
+
+    /// Returns the event of the acquire command.
+    const event& get_acquire_event() const
+    {
+        return m_acquire_event;
+    }
+
+    /// Releases the objects after \p events and returns the event of the
+    /// release command.
+    event release(const wait_list &events = wait_list())
+    {
+        BOOST_ASSERT(m_acquired);
+
+        m_acquired = false;
+
+        event release_event = opengl_enqueue_release_gl_objects(
+            m_objects.size(), &m_objects[0], m_queue, events
+        );
+
+        if(m_implicit_sync){
+            m_queue.flush();
+        }
+        else {
+            release_event.wait();
+        }
+
+        return release_event;
+    }
+
+private:
+    command_queue m_queue;
+    std::vector<cl_mem> m_objects;
+    bool m_implicit_sync;
+    bool m_acquired;
+    event m_acquire_event;
+};
+
 } // end compute namespace
 } // end boost namespace
 
@@ -13,7 +13,10 @@
 
 #include <boost/throw_exception.hpp>
 
+#include <boost/compute/context.hpp>
+#include <boost/compute/event.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/future.hpp>
 #include <boost/compute/exception/opencl_error.hpp>
 #include <boost/compute/image/image2d.hpp>
 #include <boost/compute/image/image_format.hpp>
@@ -63,6 +66,66 @@ inline void qt_copy_image2d_to_qimage(const image2d &image,
     );
 }
 
+/// Creates an image which uses the pixels of \p qimage as its storage
+/// (with \c CL_MEM_USE_HOST_PTR) instead of copying them.
+///
+/// On devices sharing memory with the host (CPUs and integrated GPUs) the
+/// image is used without copies. The pixels of \p qimage may only be
+/// accessed by the host after qt_sync_image2d_to_qimage_async() completed
+/// and must outlive the image.
+///
+/// \see qt_copy_qimage_to_image2d()
+inline image2d qt_qimage_create_image2d(QImage &qimage,
+                                        const context &context,
+                                        cl_mem_flags flags = image2d::read_write)
+{
+    return image2d(
+        context,
+        qimage.width(),
+        qimage.height(),
+        qt_qimage_get_format(qimage),
+        flags | image2d::use_host_ptr,
+        qimage.bits(),
+        qimage.bytesPerLine()
+    );
+}
+
+/// Creates a read-only image which uses the pixels of \p qimage as its
+/// storage.
+inline image2d qt_qimage_create_image2d(const QImage &qimage,
+                                        const context &context)
+{
+    return image2d(
+        context,
+        qimage.width(),
+        qimage.height(),
+        qt_qimage_get_format(qimage),
+        image2d::read_only | image2d::use_host_ptr,
+        const_cast<uchar *>(qimage.constBits()),
+        qimage.bytesPerLine()
+    );
+}
+
+/// Makes the pixels of \p image, which was created with
+/// qt_qimage_create_image2d(), available in its QImage after the commands
+/// enqueued before. The QImage may be accessed once the returned future
+/// is ready.
+///
+/// The image is mapped for reading (which updates the host memory if the
+/// device keeps a copy) and unmapped without blocking.
+inline future<void> qt_sync_image2d_to_qimage_async(const image2d &image,
+                                                    command_queue &queue)
+{
+    size_t row_pitch = 0;
+    event map_event;
+    void *pixels = queue.enqueue_map_image(
+        image, CL_MAP_READ, image.origin(), image.size(), &row_pitch, 0,
+        wait_list(), &map_event
+    );
+
+    return future<void>(queue.enqueue_unmap_buffer_async(image, pixels));
+}
+
 } // end compute namespace
 } // end boost namespace
 
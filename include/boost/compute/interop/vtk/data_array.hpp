@@ -15,9 +15,12 @@
 #include <vtkDataArrayTemplate.h>
 
 #include <boost/compute/system.hpp>
+#include <boost/compute/context.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/container/mapped_view.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
 
 namespace boost {
@@ -59,6 +62,41 @@ inline void vtk_copy_buffer_to_data_array(buffer_iterator<T> first,
     ::boost::compute::copy(first, last, data_ptr, queue);
 }
 
+/// Returns a mapped_view which uses the values in \p data as its storage
+/// instead of copying them to a buffer.
+///
+/// On devices sharing memory with the host (CPUs and integrated GPUs) the
+/// view is used without copies. The values in \p data may only be
+/// accessed by the host after vtk_sync_mapped_view_to_data_array_async()
+/// completed and must outlive the view.
+///
+/// \see vtk_copy_data_array_to_buffer()
+template<class T>
+inline mapped_view<T>
+vtk_make_mapped_view(vtkDataArrayTemplate<T> *data,
+                     const context &context = system::default_context())
+{
+    T *data_ptr = static_cast<T *>(data->GetVoidPointer(0));
+    size_t data_size = data->GetNumberOfComponents() * data->GetNumberOfTuples();
+
+    return mapped_view<T>(data_ptr, data_size, context);
+}
+
+/// Makes the values of \p view, which was returned by
+/// vtk_make_mapped_view(), available in its data array after the commands
+/// enqueued before. The data array may be accessed once the returned
+/// future is ready.
+template<class T>
+inline future<void>
+vtk_sync_mapped_view_to_data_array_async(mapped_view<T> &view,
+                                         command_queue &queue = system::default_queue())
+{
+    // mapping updates the host memory if the device keeps a copy
+    view.map_async(CL_MAP_READ, queue);
+
+    return view.unmap_async(queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -15,6 +15,7 @@
 ///
 /// Meta-header to include all Boost.Compute iterator headers.
 
+#include <boost/compute/iterator/append_iterator.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/iterator/constant_iterator.hpp>
 #include <boost/compute/iterator/constant_buffer_iterator.hpp>
@@ -22,6 +23,8 @@
 #include <boost/compute/iterator/discard_iterator.hpp>
 #include <boost/compute/iterator/function_input_iterator.hpp>
 #include <boost/compute/iterator/permutation_iterator.hpp>
+#include <boost/compute/iterator/soa_iterator.hpp>
+#include <boost/compute/iterator/strided_iterator.hpp>
 #include <boost/compute/iterator/transform_iterator.hpp>
 #include <boost/compute/iterator/zip_iterator.hpp>
 
@@ -0,0 +1,224 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ITERATOR_APPEND_ITERATOR_HPP
+#define BOOST_COMPUTE_ITERATOR_APPEND_ITERATOR_HPP
+
+#include <cstddef>
+#include <iterator>
+
+#include <boost/config.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+// forward declaration for append_iterator
+template<class T> class append_iterator;
+
+namespace detail {
+
+// helper class which defines the iterator_facade super-class
+// type for append_iterator
+template<class T>
+struct append_iterator_base
+{
+    typedef ::boost::iterator_facade<
+        ::boost::compute::append_iterator<T>,
+        T,
+        ::std::random_access_iterator_tag,
+        void *
+    > type;
+};
+
+template<class T>
+struct append_iterator_index_expr
+{
+    typedef T result_type;
+
+    append_iterator_index_expr(const buffer &values, const buffer &counter)
+        : m_values(values),
+          m_counter(counter)
+    {
+    }
+
+    buffer m_values;
+    buffer m_counter;
+};
+
+// the index of the written value is ignored, each value is stored at the
+// index given by atomically incrementing the counter
+template<class T>
+inline meta_kernel& operator<<(meta_kernel &kernel,
+                               const append_iterator_index_expr<T> &expr)
+{
+    return kernel <<
+        kernel.get_buffer_identifier<T>(expr.m_values) << "[" <<
+        "atomic_inc(" << kernel.get_buffer_identifier<uint_>(expr.m_counter) << ")" <<
+        "]";
+}
+
+} // end detail namespace
+
+/// \class append_iterator
+/// \brief An output iterator which appends the values written to it to a
+///        buffer in kernels.
+///
+/// Each value written to an append_iterator is stored at the index given
+/// by the counter (a \c uint stored in a buffer) which is then incremented
+/// atomically. This allows kernels which produce a variable number of
+/// values to write them contiguously without knowing their positions in
+/// advance. The order of the values is not specified.
+///
+/// The buffer must have room for all of the appended values. After the
+/// kernels are done the counter holds the index past the last value.
+///
+/// \see make_append_iterator(), discard_iterator
+template<class T>
+class append_iterator : public detail::append_iterator_base<T>::type
+{
+public:
+    typedef typename detail::append_iterator_base<T>::type super_type;
+    typedef typename super_type::reference reference;
+    typedef typename super_type::difference_type difference_type;
+
+    append_iterator(const buffer &values, const buffer &counter, size_t index = 0)
+        : m_values(values),
+          m_counter(counter),
+          m_index(index)
+    {
+    }
+
+    append_iterator(const append_iterator<T> &other)
+        : m_values(other.m_values),
+          m_counter(other.m_counter),
+          m_index(other.m_index)
+    {
+    }
+
+    append_iterator<T>& operator=(const append_iterator<T> &other)
+    {
+        if(this != &other){
+            m_values = other.m_values;
+            m_counter = other.m_counter;
+            m_index = other.m_index;
+        }
+
+        return *this;
+    }
+
+    ~append_iterator()
+    {
+    }
+
+    /// Returns the buffer the values are appended to.
+    const buffer& get_buffer() const
+    {
+        return m_values;
+    }
+
+    /// Returns the buffer holding the counter.
+    const buffer& get_counter() const
+    {
+        return m_counter;
+    }
+
+    /// \internal_
+    template<class Expr>
+    detail::append_iterator_index_expr<T>
+    operator[](const Expr &expr) const
+    {
+        (void) expr;
+
+        return detail::append_iterator_index_expr<T>(m_values, m_counter);
+    }
+
+private:
+    friend class ::boost::iterator_core_access;
+
+    /// \internal_
+    reference dereference() const
+    {
+        return 0;
+    }
+
+    /// \internal_
+    bool equal(const append_iterator<T> &other) const
+    {
+        return m_values.get() == other.m_values.get() &&
+               m_index == other.m_index;
+    }
+
+    /// \internal_
+    void increment()
+    {
+        m_index++;
+    }
+
+    /// \internal_
+    void decrement()
+    {
+        m_index--;
+    }
+
+    /// \internal_
+    void advance(difference_type n)
+    {
+        m_index = static_cast<size_t>(static_cast<difference_type>(m_index) + n);
+    }
+
+    /// \internal_
+    difference_type distance_to(const append_iterator<T> &other) const
+    {
+        return static_cast<difference_type>(other.m_index - m_index);
+    }
+
+private:
+    buffer m_values;
+    buffer m_counter;
+    size_t m_index;
+};
+
+/// Returns a new append_iterator which appends values of type \c T to
+/// \p values at the index stored in \p counter.
+///
+/// For example, to append values to a vector with enough capacity:
+/// \code
+/// vec.reserve(vec.size() + n, queue);
+/// buffer counter(context, sizeof(uint_));
+/// // ... write vec.size() to counter ...
+/// copy(first, last, make_append_iterator<int>(vec.get_buffer(), counter), queue);
+/// // ... read the counter and resize vec to its value ...
+/// \endcode
+///
+/// \param values the buffer to append the values to
+/// \param counter the buffer holding the index of the next value
+///
+/// \return a \c append_iterator for \p values and \p counter
+template<class T>
+inline append_iterator<T> make_append_iterator(const buffer &values,
+                                               const buffer &counter)
+{
+    return append_iterator<T>(values, counter);
+}
+
+/// \internal_ (is_device_iterator specialization for append_iterator)
+template<class T>
+struct is_device_iterator<append_iterator<T> > : boost::true_type {};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ITERATOR_APPEND_ITERATOR_HPP
@@ -97,11 +97,11 @@ public:
 
     /// \internal_
     template<class Expr>
-    detail::meta_kernel_literal<T> operator[](const Expr &expr) const
+    detail::meta_kernel_value<T> operator[](const Expr &expr) const
     {
         (void) expr;
 
-        return detail::meta_kernel::make_lit<T>(m_value);
+        return detail::meta_kernel::make_value<T>(m_value);
     }
 
 private:
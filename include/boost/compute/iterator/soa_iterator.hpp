@@ -0,0 +1,232 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ITERATOR_SOA_ITERATOR_HPP
+#define BOOST_COMPUTE_ITERATOR_SOA_ITERATOR_HPP
+
+#include <cstddef>
+#include <iterator>
+
+#include <boost/config.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/types/struct.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+
+// forward declaration for soa_iterator
+template<class T>
+class soa_iterator;
+
+namespace detail {
+
+// helper class which defines the iterator_facade super-class
+// type for soa_iterator
+template<class T>
+class soa_iterator_base
+{
+public:
+    typedef ::boost::iterator_facade<
+        ::boost::compute::soa_iterator<T>,
+        T,
+        ::std::random_access_iterator_tag,
+        T
+    > type;
+};
+
+template<class T, class IndexExpr>
+struct soa_iterator_index_expr
+{
+    typedef T result_type;
+
+    soa_iterator_index_expr(const buffer *fields,
+                            size_t index,
+                            const IndexExpr &expr)
+        : m_fields(fields),
+          m_index(index),
+          m_expr(expr)
+    {
+    }
+
+    const buffer *m_fields;
+    size_t m_index;
+    IndexExpr m_expr;
+};
+
+// streams the value of each member at the index of expr, separated by
+// commas
+template<class T, class IndexExpr>
+struct soa_member_printer
+{
+    soa_member_printer(meta_kernel &kernel_,
+                       const soa_iterator_index_expr<T, IndexExpr> &expr_)
+        : kernel(kernel_),
+          expr(expr_),
+          n(0)
+    {
+    }
+
+    template<class Member>
+    void operator()(Member T::*, const char *)
+    {
+        if(n > 0){
+            kernel << ", ";
+        }
+        kernel << buffer_iterator<Member>(expr.m_fields[n], expr.m_index)[expr.m_expr];
+        n++;
+    }
+
+    meta_kernel &kernel;
+    const soa_iterator_index_expr<T, IndexExpr> &expr;
+    size_t n;
+};
+
+template<class T, class IndexExpr>
+inline meta_kernel& operator<<(meta_kernel &kernel,
+                               const soa_iterator_index_expr<T, IndexExpr> &expr)
+{
+    kernel.inject_type<T>();
+    kernel << "((" << type_name<T>() << "){ ";
+
+    soa_member_printer<T, IndexExpr> printer(kernel, expr);
+    adapted_struct_members<T>::for_each(printer);
+
+    return kernel << " })";
+}
+
+} // end detail namespace
+
+/// \class soa_iterator
+/// \brief An iterator over the values of a structure-of-arrays.
+///
+/// The soa_iterator class iterates over structs whose members are stored in
+/// separate buffers (one for each member of the struct), for example the
+/// values of a \ref soa_vector "soa_vector<T>". The struct type \c T must
+/// be adapted with BOOST_COMPUTE_ADAPT_STRUCT().
+///
+/// When used with an algorithm the struct values are assembled from their
+/// members in the kernel. Like zip_iterator, soa_iterator is an input
+/// iterator for algorithms running on the device.
+///
+/// \see soa_vector
+template<class T>
+class soa_iterator : public detail::soa_iterator_base<T>::type
+{
+public:
+    typedef typename detail::soa_iterator_base<T>::type super_type;
+    typedef typename super_type::value_type value_type;
+    typedef typename super_type::reference reference;
+    typedef typename super_type::difference_type difference_type;
+
+    soa_iterator()
+        : m_fields(0),
+          m_index(0)
+    {
+    }
+
+    /// Creates an iterator for the structs at \p index of the member
+    /// buffers \p fields (one for each member of \c T).
+    soa_iterator(const buffer *fields, size_t index)
+        : m_fields(fields),
+          m_index(index)
+    {
+    }
+
+    soa_iterator(const soa_iterator<T> &other)
+        : m_fields(other.m_fields),
+          m_index(other.m_index)
+    {
+    }
+
+    soa_iterator<T>& operator=(const soa_iterator<T> &other)
+    {
+        if(this != &other){
+            m_fields = other.m_fields;
+            m_index = other.m_index;
+        }
+
+        return *this;
+    }
+
+    ~soa_iterator()
+    {
+    }
+
+    size_t get_index() const
+    {
+        return m_index;
+    }
+
+    /// Returns the buffer storing member \p n of the structs.
+    const buffer& get_member_buffer(size_t n) const
+    {
+        return m_fields[n];
+    }
+
+    /// \internal_
+    template<class Expr>
+    detail::soa_iterator_index_expr<T, Expr>
+    operator[](const Expr &expr) const
+    {
+        return detail::soa_iterator_index_expr<T, Expr>(m_fields, m_index, expr);
+    }
+
+private:
+    friend class ::boost::iterator_core_access;
+
+    reference dereference() const
+    {
+        return reference();
+    }
+
+    bool equal(const soa_iterator<T> &other) const
+    {
+        return m_fields == other.m_fields && m_index == other.m_index;
+    }
+
+    void increment()
+    {
+        m_index++;
+    }
+
+    void decrement()
+    {
+        m_index--;
+    }
+
+    void advance(difference_type n)
+    {
+        m_index = static_cast<size_t>(static_cast<difference_type>(m_index) + n);
+    }
+
+    difference_type distance_to(const soa_iterator<T> &other) const
+    {
+        return static_cast<difference_type>(other.m_index - m_index);
+    }
+
+private:
+    const buffer *m_fields;
+    size_t m_index;
+};
+
+/// \internal_ (is_device_iterator specialization for soa_iterator)
+template<class T>
+struct is_device_iterator<soa_iterator<T> > : boost::true_type {};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ITERATOR_SOA_ITERATOR_HPP
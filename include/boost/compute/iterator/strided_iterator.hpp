@@ -0,0 +1,244 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ITERATOR_STRIDED_ITERATOR_HPP
+#define BOOST_COMPUTE_ITERATOR_STRIDED_ITERATOR_HPP
+
+#include <cstddef>
+#include <iterator>
+
+#include <boost/config.hpp>
+#include <boost/iterator/iterator_adaptor.hpp>
+
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/iterator/detail/get_base_iterator_buffer.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+// forward declaration for strided_iterator
+template<class Iterator>
+class strided_iterator;
+
+namespace detail {
+
+// helper class which defines the iterator_adaptor super-class
+// type for strided_iterator
+template<class Iterator>
+class strided_iterator_base
+{
+public:
+    typedef ::boost::iterator_adaptor<
+        ::boost::compute::strided_iterator<Iterator>,
+        Iterator,
+        typename std::iterator_traits<Iterator>::value_type,
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<Iterator>::reference
+    > type;
+};
+
+// an index expression multiplied by a stride
+template<class IndexExpr>
+struct strided_index_expr
+{
+    strided_index_expr(const IndexExpr &expr, size_t stride)
+        : m_expr(expr),
+          m_stride(stride)
+    {
+    }
+
+    IndexExpr m_expr;
+    size_t m_stride;
+};
+
+template<class IndexExpr>
+inline meta_kernel& operator<<(meta_kernel &kernel,
+                               const strided_index_expr<IndexExpr> &expr)
+{
+    if(expr.m_stride == 1){
+        return kernel << expr.m_expr;
+    }
+
+    return kernel << "(" << expr.m_expr << ")*" << uint_(expr.m_stride);
+}
+
+template<class Iterator, class IndexExpr>
+struct strided_iterator_index_expr
+{
+    typedef typename std::iterator_traits<Iterator>::value_type result_type;
+
+    strided_iterator_index_expr(const Iterator &iterator,
+                                const IndexExpr &expr,
+                                size_t stride)
+        : m_iterator(iterator),
+          m_expr(expr, stride)
+    {
+    }
+
+    Iterator m_iterator;
+    strided_index_expr<IndexExpr> m_expr;
+};
+
+template<class Iterator, class IndexExpr>
+inline meta_kernel& operator<<(meta_kernel &kernel,
+                               const strided_iterator_index_expr<Iterator, IndexExpr> &expr)
+{
+    return kernel << expr.m_iterator[expr.m_expr];
+}
+
+} // end detail namespace
+
+/// \class strided_iterator
+/// \brief An iterator adaptor which skips over elements of its base range.
+///
+/// The strided_iterator adaptor visits every \c stride -th element of the
+/// underlying (random-access) iterator. Incrementing a strided iterator
+/// advances the base iterator by \c stride elements.
+///
+/// Strided iterators allow for zero-copy access to slices of a buffer,
+/// for example a column of a row-major matrix, without gathering the
+/// values into a temporary or storing an index map for a
+/// permutation_iterator. The stride is inlined into the index expressions
+/// generated for the kernels using the iterator.
+///
+/// For example, to copy the second column of a matrix with \c 8 columns
+/// stored in row-major order:
+/// \code
+/// boost::compute::copy(
+///     boost::compute::make_strided_iterator(matrix.begin() + 1, 8),
+///     boost::compute::make_strided_iterator(matrix.begin() + 1, 8) + rows,
+///     column.begin(),
+///     queue
+/// );
+/// \endcode
+///
+/// \see make_strided_iterator(), array_view
+template<class Iterator>
+class strided_iterator :
+    public detail::strided_iterator_base<Iterator>::type
+{
+public:
+    typedef typename detail::strided_iterator_base<Iterator>::type super_type;
+    typedef typename super_type::value_type value_type;
+    typedef typename super_type::reference reference;
+    typedef typename super_type::base_type base_type;
+    typedef typename super_type::difference_type difference_type;
+
+    strided_iterator(Iterator iterator, size_t stride)
+        : super_type(iterator),
+          m_stride(stride)
+    {
+        BOOST_ASSERT(stride > 0);
+    }
+
+    strided_iterator(const strided_iterator<Iterator> &other)
+        : super_type(other.base()),
+          m_stride(other.m_stride)
+    {
+    }
+
+    strided_iterator<Iterator>& operator=(const strided_iterator<Iterator> &other)
+    {
+        if(this != &other){
+            super_type::operator=(other);
+
+            m_stride = other.m_stride;
+        }
+
+        return *this;
+    }
+
+    ~strided_iterator()
+    {
+    }
+
+    /// Returns the number of base elements between two consecutive
+    /// elements of the strided range.
+    size_t stride() const
+    {
+        return m_stride;
+    }
+
+    size_t get_index() const
+    {
+        return super_type::base().get_index();
+    }
+
+    const buffer& get_buffer() const
+    {
+        return detail::get_base_iterator_buffer(*this);
+    }
+
+    template<class IndexExpression>
+    detail::strided_iterator_index_expr<Iterator, IndexExpression>
+    operator[](const IndexExpression &expr) const
+    {
+        return detail::strided_iterator_index_expr<Iterator, IndexExpression>(
+            super_type::base(), expr, m_stride
+        );
+    }
+
+private:
+    friend class ::boost::iterator_core_access;
+
+    reference dereference() const
+    {
+        return *super_type::base();
+    }
+
+    void increment()
+    {
+        super_type::base_reference() += static_cast<difference_type>(m_stride);
+    }
+
+    void decrement()
+    {
+        super_type::base_reference() -= static_cast<difference_type>(m_stride);
+    }
+
+    void advance(difference_type n)
+    {
+        super_type::base_reference() += n * static_cast<difference_type>(m_stride);
+    }
+
+    difference_type distance_to(const strided_iterator<Iterator> &other) const
+    {
+        return std::distance(super_type::base(), other.base()) /
+               static_cast<difference_type>(m_stride);
+    }
+
+private:
+    size_t m_stride;
+};
+
+/// Returns a strided_iterator for \p iterator which advances by
+/// \p stride elements of the base range at a time.
+///
+/// \param iterator the underlying iterator
+/// \param stride the number of base elements per step
+///
+/// \return a \c strided_iterator for \p iterator with \p stride
+template<class Iterator>
+inline strided_iterator<Iterator>
+make_strided_iterator(Iterator iterator, size_t stride)
+{
+    return strided_iterator<Iterator>(iterator, stride);
+}
+
+/// \internal_ (is_device_iterator specialization for strided_iterator)
+template<class Iterator>
+struct is_device_iterator<strided_iterator<Iterator> > : boost::true_type {};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ITERATOR_STRIDED_ITERATOR_HPP
@@ -158,6 +158,12 @@ public:
         return detail::get_base_iterator_buffer(*this);
     }
 
+    /// \internal_
+    const UnaryFunction& functor() const
+    {
+        return m_transform;
+    }
+
     template<class IndexExpression>
     detail::transform_iterator_index_expr<InputIterator, UnaryFunction, IndexExpression>
     operator[](const IndexExpression &expr) const
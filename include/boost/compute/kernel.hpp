@@ -11,9 +11,14 @@
 #ifndef BOOST_COMPUTE_KERNEL_HPP
 #define BOOST_COMPUTE_KERNEL_HPP
 
+#include <cstring>
 #include <string>
+#include <vector>
+#include <utility>
 
 #include <boost/assert.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/utility/enable_if.hpp>
 
 #include <boost/compute/config.hpp>
@@ -22,6 +27,7 @@
 #include <boost/compute/type_traits/is_fundamental.hpp>
 #include <boost/compute/detail/get_object_info.hpp>
 #include <boost/compute/detail/assert_cl_success.hpp>
+#include <boost/compute/detail/kernel_arg_shadow.hpp>
 #include <boost/compute/memory/svm_ptr.hpp>
 
 namespace boost {
@@ -29,9 +35,38 @@ namespace compute {
 namespace detail {
 
 template<class T> struct set_kernel_arg;
+class kernel_cache;
 
 } // end detail namespace
 
+/// \struct kernel_resource_usage
+/// \brief The resources used by a kernel on a device.
+///
+/// \see kernel::get_resource_usage()
+struct kernel_resource_usage
+{
+    /// The maximum work-group size the kernel can be launched with
+    /// (\c CL_KERNEL_WORK_GROUP_SIZE).
+    size_t work_group_size;
+
+    /// The multiple of the work-group size which performs best
+    /// (\c CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE, or one before
+    /// OpenCL 1.1).
+    size_t preferred_work_group_size_multiple;
+
+    /// The work-group size required with the \c reqd_work_group_size
+    /// attribute, or zeros (\c CL_KERNEL_COMPILE_WORK_GROUP_SIZE).
+    size_t compile_work_group_size[3];
+
+    /// The local memory used by a work-group in bytes, including the local
+    /// memory arguments set so far (\c CL_KERNEL_LOCAL_MEM_SIZE).
+    cl_ulong local_memory_size;
+
+    /// The private memory used by each work-item in bytes
+    /// (\c CL_KERNEL_PRIVATE_MEM_SIZE, or zero before OpenCL 1.1).
+    cl_ulong private_memory_size;
+};
+
 /// \class kernel
 /// \brief A compute kernel.
 ///
@@ -47,11 +82,18 @@ public:
 
     /// Creates a new kernel object for \p kernel. If \p retain is
     /// \c true, the reference count for \p kernel will be incremented.
+    ///
+    /// The new object does not know the arguments already set on
+    /// \p kernel (see set_arg()).
     explicit kernel(cl_kernel kernel, bool retain = true)
         : m_kernel(kernel)
     {
-        if(m_kernel && retain){
-            clRetainKernel(m_kernel);
+        if(m_kernel){
+            if(retain){
+                clRetainKernel(m_kernel);
+            }
+
+            m_args = boost::make_shared<detail::kernel_arg_shadow>();
         }
     }
 
@@ -64,11 +106,14 @@ public:
         if(!m_kernel){
             BOOST_THROW_EXCEPTION(opencl_error(error));
         }
+
+        m_args = boost::make_shared<detail::kernel_arg_shadow>();
     }
 
     /// Creates a new kernel object as a copy of \p other.
     kernel(const kernel &other)
-        : m_kernel(other.m_kernel)
+        : m_kernel(other.m_kernel),
+          m_args(other.m_args)
     {
         if(m_kernel){
             clRetainKernel(m_kernel);
@@ -84,6 +129,7 @@ public:
             }
 
             m_kernel = other.m_kernel;
+            m_args = other.m_args;
 
             if(m_kernel){
                 clRetainKernel(m_kernel);
@@ -96,7 +142,8 @@ public:
     #ifndef BOOST_COMPUTE_NO_RVALUE_REFERENCES
     /// Move-constructs a new kernel object from \p other.
     kernel(kernel&& other) BOOST_NOEXCEPT
-        : m_kernel(other.m_kernel)
+        : m_kernel(other.m_kernel),
+          m_args(std::move(other.m_args))
     {
         other.m_kernel = 0;
     }
@@ -109,6 +156,7 @@ public:
         }
 
         m_kernel = other.m_kernel;
+        m_args = std::move(other.m_args);
         other.m_kernel = 0;
 
         return *this;
@@ -197,25 +245,90 @@ public:
     ///
     /// \see_opencl_ref{clGetKernelWorkGroupInfo}
     template<class T>
-    T get_work_group_info(const device &device, cl_kernel_work_group_info info)
+    T get_work_group_info(const device &device, cl_kernel_work_group_info info) const
     {
         return detail::get_object_info<T>(clGetKernelWorkGroupInfo, m_kernel, info, device.id());
     }
 
+    /// Returns the resources used by the kernel on \p device.
+    ///
+    /// For example, to launch the kernel with the largest work-group size
+    /// it supports:
+    /// \code
+    /// boost::compute::kernel_resource_usage usage = kernel.get_resource_usage(device);
+    /// queue.enqueue_1d_range_kernel(kernel, 0, n, usage.work_group_size);
+    /// \endcode
+    ///
+    /// \see_opencl_ref{clGetKernelWorkGroupInfo}
+    kernel_resource_usage get_resource_usage(const device &device) const
+    {
+        BOOST_ASSERT(m_kernel != 0);
+
+        kernel_resource_usage usage;
+        usage.work_group_size =
+            get_work_group_info<size_t>(device, CL_KERNEL_WORK_GROUP_SIZE);
+        usage.local_memory_size =
+            get_work_group_info<cl_ulong>(device, CL_KERNEL_LOCAL_MEM_SIZE);
+
+        cl_int ret = clGetKernelWorkGroupInfo(
+            m_kernel,
+            device.id(),
+            CL_KERNEL_COMPILE_WORK_GROUP_SIZE,
+            sizeof(usage.compile_work_group_size),
+            usage.compile_work_group_size,
+            0
+        );
+        if(ret != CL_SUCCESS){
+            BOOST_THROW_EXCEPTION(opencl_error(ret));
+        }
+
+        #ifdef CL_VERSION_1_1
+        usage.preferred_work_group_size_multiple = get_work_group_info<size_t>(
+            device, CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE
+        );
+        usage.private_memory_size =
+            get_work_group_info<cl_ulong>(device, CL_KERNEL_PRIVATE_MEM_SIZE);
+        #else
+        usage.preferred_work_group_size_multiple = 1;
+        usage.private_memory_size = 0;
+        #endif // CL_VERSION_1_1
+
+        return usage;
+    }
+
     /// Sets the argument at \p index to \p value with \p size.
     ///
+    /// The arguments last set are remembered (and shared by the copies of
+    /// the kernel object) and \c clSetKernelArg() is not called when the
+    /// argument is already set to the same value. Memory objects and
+    /// samplers set with the typed overloads are always set again, as the
+    /// handle of a released object may be reused by a new one. They are
+    /// not retained by the kernel. Handles passed here as raw bytes are
+    /// compared like other values and should be set with the typed
+    /// overloads instead. If arguments of the
+    /// underlying \c cl_kernel are set by other means, reset_args() must
+    /// be called before setting them again with set_arg().
+    ///
     /// \see_opencl_ref{clSetKernelArg}
     void set_arg(size_t index, size_t size, const void *value)
     {
+        BOOST_ASSERT(m_kernel != 0);
         BOOST_ASSERT(index < arity());
 
+        if(m_args->contains(index, size, value)){
+            return;
+        }
+
         cl_int ret = clSetKernelArg(m_kernel,
                                     static_cast<cl_uint>(index),
                                     size,
                                     value);
         if(ret != CL_SUCCESS){
+            m_args->erase(index);
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
+
+        m_args->insert(index, size, value);
     }
 
     /// Sets the argument at \p index to \p value.
@@ -248,13 +361,17 @@ public:
     /// \internal_
     void set_arg(size_t index, const cl_mem mem)
     {
+        m_args->erase(index);
         set_arg(index, sizeof(cl_mem), static_cast<const void *>(&mem));
+        m_args->mark_memory_object(index);
     }
 
     /// \internal_
     void set_arg(size_t index, const cl_sampler sampler)
     {
+        m_args->erase(index);
         set_arg(index, sizeof(cl_sampler), static_cast<const void *>(&sampler));
+        m_args->mark_sampler(index);
     }
 
     /// \internal_
@@ -262,6 +379,8 @@ public:
     void set_arg(size_t index, const svm_ptr<T> ptr)
     {
         #ifdef CL_VERSION_2_0
+        m_args->erase(index);
+
         cl_int ret = clSetKernelArgSVMPointer(m_kernel, index, ptr.get());
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
@@ -271,6 +390,58 @@ public:
         #endif
     }
 
+    /// Forgets the arguments last set with set_arg() so that the next
+    /// calls to set_arg() always call \c clSetKernelArg().
+    void reset_args()
+    {
+        if(m_args){
+            m_args->clear();
+        }
+    }
+
+    /// \internal_
+    ///
+    /// Returns a new kernel object for the same function with the
+    /// arguments last set with set_arg(). Throws an opencl_error with
+    /// \c CL_INVALID_KERNEL_ARGS if the value of an argument is unknown
+    /// (e.g. an SVM pointer).
+    kernel clone() const
+    {
+        BOOST_ASSERT(m_kernel != 0);
+
+        const size_t count = arity();
+        kernel copy(get_program(), name());
+        for(size_t i = 0; i < count; i++){
+            const detail::kernel_arg_shadow::arg *a = m_args->find(i);
+            if(!a){
+                BOOST_THROW_EXCEPTION(opencl_error(CL_INVALID_KERNEL_ARGS));
+            }
+
+            copy.set_arg(i, a->size, a->local ? 0 : &a->bytes[0]);
+        }
+        *copy.m_args = *m_args;
+
+        return copy;
+    }
+
+    /// \internal_
+    ///
+    /// Returns the memory objects last set as arguments with set_arg().
+    std::vector<cl_mem> get_memory_object_args() const
+    {
+        std::vector<cl_mem> objects;
+        for(size_t i = 0; i < m_args->size(); i++){
+            const detail::kernel_arg_shadow::arg *a = m_args->find(i);
+            if(a && a->memory_object){
+                cl_mem mem;
+                std::memcpy(&mem, &a->bytes[0], sizeof(cl_mem));
+                objects.push_back(mem);
+            }
+        }
+
+        return objects;
+    }
+
     #ifndef BOOST_NO_VARIADIC_TEMPLATES
     /// Sets the arguments for the kernel to \p args.
     template<class... T>
@@ -341,7 +512,10 @@ private:
     #endif // BOOST_NO_VARIADIC_TEMPLATES
 
 private:
+    friend class detail::kernel_cache;
+
     cl_kernel m_kernel;
+    boost::shared_ptr<detail::kernel_arg_shadow> m_args;
 };
 
 inline kernel program::create_kernel(const std::string &name) const
@@ -74,8 +74,9 @@ struct context : proto::callable_context<context<Args> >
     template<class T>
     void operator()(proto::tag::terminal, const T &x)
     {
-        // terminal values in lambda expressions are always literals
-        stream << stream.lit(x);
+        // terminal values are inserted as literals, or as kernel arguments
+        // with BOOST_COMPUTE_VALUES_AS_KERNEL_ARGUMENTS
+        stream << boost::compute::detail::meta_kernel::make_value(x);
     }
 
     // handle placeholders
@@ -19,6 +19,7 @@
 #include <boost/preprocessor/stringize.hpp>
 
 #include <boost/compute/functional/get.hpp>
+#include <boost/compute/functional/math_precision.hpp>
 #include <boost/compute/lambda/result_of.hpp>
 #include <boost/compute/lambda/placeholder.hpp>
 
@@ -60,7 +61,8 @@ namespace proto = boost::proto;
         ); \
     }
 
-// wraps a unary function who's return type is the same as the argument type
+// wraps a unary function who's return type is the same as the argument type,
+// calling its native_ or half_ variant for the active math precision
 #define BOOST_COMPUTE_LAMBDA_WRAP_UNARY_FUNCTION_T(name) \
     namespace detail { \
         struct BOOST_PP_CAT(name, _func) \
@@ -75,7 +77,15 @@ namespace proto = boost::proto;
             template<class Context, class Arg> \
             static void apply(Context &ctx, const Arg &arg) \
             { \
-                ctx.stream << #name << "("; \
+                typedef typename ::boost::compute::lambda::result_of< \
+                    Arg, typename Context::args_tuple \
+                >::type result_type; \
+                ctx.stream << ::boost::compute::detail::math_function_name( \
+                    #name, \
+                    ::boost::compute::detail::is_reduced_precision_math_type< \
+                        result_type \
+                    >::value \
+                ) << "("; \
                 proto::eval(arg, ctx); \
                 ctx.stream << ")"; \
             } \
@@ -0,0 +1,28 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_LINEAR_ALGEBRA_HPP
+#define BOOST_COMPUTE_LINEAR_ALGEBRA_HPP
+
+/// \file
+///
+/// Meta-header to include all Boost.Compute linear algebra headers.
+
+#include <boost/compute/linear_algebra/axpy.hpp>
+#include <boost/compute/linear_algebra/batched_matrix.hpp>
+#include <boost/compute/linear_algebra/csr_matrix.hpp>
+#include <boost/compute/linear_algebra/dot_product.hpp>
+#include <boost/compute/linear_algebra/ell_matrix.hpp>
+#include <boost/compute/linear_algebra/gemm.hpp>
+#include <boost/compute/linear_algebra/gemv.hpp>
+#include <boost/compute/linear_algebra/hyb_matrix.hpp>
+#include <boost/compute/linear_algebra/spmv.hpp>
+
+#endif // BOOST_COMPUTE_LINEAR_ALGEBRA_HPP
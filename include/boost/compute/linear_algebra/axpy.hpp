@@ -0,0 +1,79 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_LINEAR_ALGEBRA_AXPY_HPP
+#define BOOST_COMPUTE_LINEAR_ALGEBRA_AXPY_HPP
+
+#include <iterator>
+
+#include <boost/assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/container/valarray.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Computes y = \p alpha * x + y for the vectors x = [\p first, \p last)
+/// and y starting at \p result. Returns an iterator to the end of y.
+///
+/// \see dot_product(), gemv()
+template<class InputIterator, class OutputIterator, class T>
+inline OutputIterator axpy(const T &alpha,
+                           InputIterator first,
+                           InputIterator last,
+                           OutputIterator result,
+                           command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<OutputIterator>::value_type value_type;
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return result;
+    }
+
+    detail::meta_kernel k("axpy");
+    k.add_set_arg<value_type>("alpha", static_cast<value_type>(alpha));
+    k <<
+        k.decl<const uint_>("i") << " = get_global_id(0);\n" <<
+        result[k.var<uint_>("i")] << " = alpha * " << first[k.var<uint_>("i")] <<
+            " + " << result[k.var<uint_>("i")] << ";\n";
+
+    k.exec_1d(queue, 0, count);
+
+    return result + static_cast<std::ptrdiff_t>(count);
+}
+
+/// \overload
+template<class T>
+inline void axpy(const T &alpha,
+                 const valarray<T> &x,
+                 valarray<T> &y,
+                 command_queue &queue = system::default_queue())
+{
+    BOOST_ASSERT(x.size() == y.size());
+
+    ::boost::compute::axpy(
+        alpha,
+        make_buffer_iterator<T>(x.get_buffer(), 0),
+        make_buffer_iterator<T>(x.get_buffer(), x.size()),
+        make_buffer_iterator<T>(y.get_buffer(), 0),
+        queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_LINEAR_ALGEBRA_AXPY_HPP
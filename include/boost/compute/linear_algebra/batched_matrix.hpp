@@ -0,0 +1,316 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_LINEAR_ALGEBRA_BATCHED_MATRIX_HPP
+#define BOOST_COMPUTE_LINEAR_ALGEBRA_BATCHED_MATRIX_HPP
+
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/type_traits/is_vector_type.hpp>
+#include <boost/compute/type_traits/scalar_type.hpp>
+#include <boost/compute/type_traits/vector_size.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns the index of the j-th scalar of the matrix of the current
+// work-item in a batch of n x n matrices stored as consecutive scalars
+inline std::string batched_matrix_index(size_t n)
+{
+    std::stringstream stream;
+    stream << "gid * " << n * n << " + j";
+    return stream.str();
+}
+
+// emits the statements copying the matrix of the current work-item from
+// the batch at first to the private array. the matrices are either stored
+// as n * n consecutive scalars or as one vector each (e.g. float16)
+template<class Iterator>
+inline void batched_matrix_load(meta_kernel &k,
+                                Iterator first,
+                                size_t n,
+                                const char *array)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    if(is_vector_type<value_type>::value){
+        k << "vstore" << uint_(vector_size<value_type>::value) << "(" <<
+                first[k.var<uint_>("gid")] << ", 0, " << array << ");\n";
+    }
+    else {
+        k << "for(uint j = 0; j < " << uint_(n * n) << "; j++){\n" <<
+             "    " << array << "[j] = " <<
+                first[k.var<uint_>(batched_matrix_index(n))] << ";\n" <<
+             "}\n";
+    }
+}
+
+// emits the statements copying the private array to the matrix of the
+// current work-item in the batch at result
+template<class Iterator>
+inline void batched_matrix_store(meta_kernel &k,
+                                 Iterator result,
+                                 size_t n,
+                                 const char *array)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    if(is_vector_type<value_type>::value){
+        k << result[k.var<uint_>("gid")] << " = vload" <<
+                uint_(vector_size<value_type>::value) << "(0, " << array << ");\n";
+    }
+    else {
+        k << "for(uint j = 0; j < " << uint_(n * n) << "; j++){\n" <<
+             "    " << result[k.var<uint_>(batched_matrix_index(n))] <<
+                " = " << array << "[j];\n" <<
+             "}\n";
+    }
+}
+
+// returns the order of the square matrices stored as one vector of type T
+template<class T>
+inline size_t batched_matrix_vector_order()
+{
+    BOOST_STATIC_ASSERT((vector_size<T>::value == 4 || vector_size<T>::value == 16));
+
+    return vector_size<T>::value == 4 ? 2 : 4;
+}
+
+template<class InputIterator1, class InputIterator2, class OutputIterator>
+inline void dispatch_batched_matrix_multiply(InputIterator1 first_a,
+                                             InputIterator2 first_b,
+                                             OutputIterator result,
+                                             size_t count,
+                                             size_t n,
+                                             command_queue &queue)
+{
+    typedef typename std::iterator_traits<OutputIterator>::value_type value_type;
+    typedef typename scalar_type<value_type>::type scalar_type;
+
+    if(count == 0){
+        return;
+    }
+
+    meta_kernel k("batched_matrix_multiply");
+    k <<
+        "const uint gid = get_global_id(0);\n" <<
+        k.type<scalar_type>() << " a[" << uint_(n * n) << "];\n" <<
+        k.type<scalar_type>() << " b[" << uint_(n * n) << "];\n" <<
+        k.type<scalar_type>() << " c[" << uint_(n * n) << "];\n";
+    batched_matrix_load(k, first_a, n, "a");
+    batched_matrix_load(k, first_b, n, "b");
+    k <<
+        "for(uint i = 0; i < " << uint_(n) << "; i++){\n" <<
+        "    for(uint j = 0; j < " << uint_(n) << "; j++){\n" <<
+        "        " << k.decl<scalar_type>("sum") << " = 0;\n" <<
+        "        for(uint l = 0; l < " << uint_(n) << "; l++){\n" <<
+        "            sum += a[i * " << uint_(n) << " + l] * b[l * " << uint_(n) << " + j];\n" <<
+        "        }\n" <<
+        "        c[i * " << uint_(n) << " + j] = sum;\n" <<
+        "    }\n" <<
+        "}\n";
+    batched_matrix_store(k, result, n, "c");
+
+    k.exec_1d(queue, 0, count);
+}
+
+template<class InputIterator, class OutputIterator>
+inline void dispatch_batched_matrix_inverse(InputIterator first,
+                                            OutputIterator result,
+                                            size_t count,
+                                            size_t n,
+                                            command_queue &queue)
+{
+    typedef typename std::iterator_traits<OutputIterator>::value_type value_type;
+    typedef typename scalar_type<value_type>::type scalar_type;
+
+    if(count == 0){
+        return;
+    }
+
+    const uint_ order = static_cast<uint_>(n);
+
+    // gauss-jordan elimination with partial pivoting, the row operations
+    // reducing m to the identity are applied to r
+    meta_kernel k("batched_matrix_inverse");
+    k <<
+        "const uint gid = get_global_id(0);\n" <<
+        k.type<scalar_type>() << " m[" << order * order << "];\n" <<
+        k.type<scalar_type>() << " r[" << order * order << "];\n";
+    batched_matrix_load(k, first, n, "m");
+    k <<
+        "for(uint j = 0; j < " << order * order << "; j++){\n" <<
+        "    r[j] = j % " << order + 1 << " == 0 ? 1 : 0;\n" <<
+        "}\n" <<
+        "for(uint col = 0; col < " << order << "; col++){\n" <<
+        "    uint pivot = col;\n" <<
+        "    " << k.decl<scalar_type>("best") << " = fabs(m[col * " << order << " + col]);\n" <<
+        "    for(uint i = col + 1; i < " << order << "; i++){\n" <<
+        "        " << k.decl<const scalar_type>("v") << " = fabs(m[i * " << order << " + col]);\n" <<
+        "        if(v > best){\n" <<
+        "            best = v;\n" <<
+        "            pivot = i;\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "    if(pivot != col){\n" <<
+        "        for(uint j = 0; j < " << order << "; j++){\n" <<
+        "            " << k.decl<scalar_type>("t") << " = m[col * " << order << " + j];\n" <<
+        "            m[col * " << order << " + j] = m[pivot * " << order << " + j];\n" <<
+        "            m[pivot * " << order << " + j] = t;\n" <<
+        "            t = r[col * " << order << " + j];\n" <<
+        "            r[col * " << order << " + j] = r[pivot * " << order << " + j];\n" <<
+        "            r[pivot * " << order << " + j] = t;\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "    " << k.decl<const scalar_type>("inv") << " = 1 / m[col * " << order << " + col];\n" <<
+        "    for(uint j = 0; j < " << order << "; j++){\n" <<
+        "        m[col * " << order << " + j] *= inv;\n" <<
+        "        r[col * " << order << " + j] *= inv;\n" <<
+        "    }\n" <<
+        "    for(uint i = 0; i < " << order << "; i++){\n" <<
+        "        if(i != col){\n" <<
+        "            " << k.decl<const scalar_type>("f") << " = m[i * " << order << " + col];\n" <<
+        "            for(uint j = 0; j < " << order << "; j++){\n" <<
+        "                m[i * " << order << " + j] -= f * m[col * " << order << " + j];\n" <<
+        "                r[i * " << order << " + j] -= f * r[col * " << order << " + j];\n" <<
+        "            }\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "}\n";
+    batched_matrix_store(k, result, n, "r");
+
+    k.exec_1d(queue, 0, count);
+}
+
+} // end detail namespace
+
+/// Computes the products A * B of the pairs of small square matrices of
+/// the batches [\p first_a, \p last_a) and \p first_b and stores them at
+/// \p result. Returns an iterator to the end of the result.
+///
+/// Each matrix is stored as one vector in row-major order, a \c float16_
+/// (or \c double16_) holding a 4x4 matrix and a \c float4_ a 2x2 matrix.
+/// Each work-item multiplies one pair of matrices in private memory.
+///
+/// Note that \c eigen_matrix4f_to_float16() stores the matrix in Eigen's
+/// column-major order, which is its transpose in row-major order. The
+/// product A * B of such matrices is thus computed by passing B as
+/// \p first_a and A as \p first_b.
+///
+/// \see batched_matrix_inverse(), gemm()
+template<class InputIterator1, class InputIterator2, class OutputIterator>
+inline OutputIterator
+batched_matrix_multiply(InputIterator1 first_a,
+                        InputIterator1 last_a,
+                        InputIterator2 first_b,
+                        OutputIterator result,
+                        command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator1>::value_type value_type;
+
+    const size_t count = detail::iterator_range_size(first_a, last_a);
+    detail::dispatch_batched_matrix_multiply(
+        first_a, first_b, result, count,
+        detail::batched_matrix_vector_order<value_type>(), queue
+    );
+
+    return result + static_cast<std::ptrdiff_t>(count);
+}
+
+/// \overload
+///
+/// The matrices are \p n x \p n matrices each stored as \p n * \p n
+/// consecutive scalars in row-major order (for example 3x3 matrices as 9
+/// floats).
+template<class InputIterator1, class InputIterator2, class OutputIterator>
+inline OutputIterator
+batched_matrix_multiply(size_t n,
+                        InputIterator1 first_a,
+                        InputIterator1 last_a,
+                        InputIterator2 first_b,
+                        OutputIterator result,
+                        command_queue &queue = system::default_queue())
+{
+    BOOST_ASSERT(n > 0);
+    BOOST_ASSERT(detail::iterator_range_size(first_a, last_a) % (n * n) == 0);
+
+    const size_t size = detail::iterator_range_size(first_a, last_a);
+    detail::dispatch_batched_matrix_multiply(
+        first_a, first_b, result, size / (n * n), n, queue
+    );
+
+    return result + static_cast<std::ptrdiff_t>(size);
+}
+
+/// Computes the inverses of the small square matrices [\p first, \p last)
+/// and stores them at \p result. Returns an iterator to the end of the
+/// result.
+///
+/// The matrices are stored as vectors like for batched_matrix_multiply().
+/// Each work-item inverts one matrix by Gauss-Jordan elimination with
+/// partial pivoting in private memory. The inverses of singular matrices
+/// contain infinite or NaN values.
+///
+/// \see batched_matrix_multiply()
+template<class InputIterator, class OutputIterator>
+inline OutputIterator
+batched_matrix_inverse(InputIterator first,
+                       InputIterator last,
+                       OutputIterator result,
+                       command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    const size_t count = detail::iterator_range_size(first, last);
+    detail::dispatch_batched_matrix_inverse(
+        first, result, count,
+        detail::batched_matrix_vector_order<value_type>(), queue
+    );
+
+    return result + static_cast<std::ptrdiff_t>(count);
+}
+
+/// \overload
+///
+/// The matrices are \p n x \p n matrices each stored as \p n * \p n
+/// consecutive scalars in row-major order.
+template<class InputIterator, class OutputIterator>
+inline OutputIterator
+batched_matrix_inverse(size_t n,
+                       InputIterator first,
+                       InputIterator last,
+                       OutputIterator result,
+                       command_queue &queue = system::default_queue())
+{
+    BOOST_ASSERT(n > 0);
+    BOOST_ASSERT(detail::iterator_range_size(first, last) % (n * n) == 0);
+
+    const size_t size = detail::iterator_range_size(first, last);
+    detail::dispatch_batched_matrix_inverse(
+        first, result, size / (n * n), n, queue
+    );
+
+    return result + static_cast<std::ptrdiff_t>(size);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_LINEAR_ALGEBRA_BATCHED_MATRIX_HPP
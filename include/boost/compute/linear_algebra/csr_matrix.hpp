@@ -0,0 +1,260 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_LINEAR_ALGEBRA_CSR_MATRIX_HPP
+#define BOOST_COMPUTE_LINEAR_ALGEBRA_CSR_MATRIX_HPP
+
+#include <cstddef>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/adjacent_difference.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/gather.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/max_element.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class csr_matrix
+/// \brief A sparse matrix in compressed sparse row (CSR) format.
+///
+/// The non-zero values of each row are stored consecutively, along with
+/// their column indices, and the values of row \c i are at the indices
+/// [\c row_offsets[i], \c row_offsets[i+1]) of columns() and values().
+///
+/// The matrix also keeps the statistics of its row lengths used by spmv()
+/// to choose between computing each row with one work-item or with a
+/// work-group.
+///
+/// For example, to build a matrix from its coordinate (COO) format:
+///
+/// \code
+/// boost::compute::csr_matrix<float> matrix(
+///     rows, cols,
+///     row_indices.begin(), row_indices.end(),
+///     column_indices.begin(),
+///     values.begin(),
+///     queue
+/// );
+/// \endcode
+///
+/// \see ell_matrix, hyb_matrix, spmv()
+template<class T>
+class csr_matrix
+{
+public:
+    typedef T value_type;
+
+    /// Creates an empty matrix in \p context.
+    explicit csr_matrix(const context &context = system::default_context())
+        : m_rows(0),
+          m_cols(0),
+          m_max_row_length(0),
+          m_row_offsets(1, context),
+          m_columns(context),
+          m_values(context)
+    {
+    }
+
+    /// Creates a \p rows x \p cols matrix from its coordinate (COO) format
+    /// where the value \c values_first[i] is at row \c rows_first[i] and
+    /// column \c columns_first[i]. The entries may be in any order and
+    /// duplicated entries are kept (their values are summed by spmv()).
+    ///
+    /// The entries are sorted by row with sort_by_key() and the row offsets
+    /// computed from the row lengths with exclusive_scan().
+    template<class RowIterator, class ColumnIterator, class ValueIterator>
+    csr_matrix(size_t rows,
+               size_t cols,
+               RowIterator rows_first,
+               RowIterator rows_last,
+               ColumnIterator columns_first,
+               ValueIterator values_first,
+               command_queue &queue = system::default_queue())
+        : m_rows(rows),
+          m_cols(cols),
+          m_max_row_length(0),
+          m_row_offsets(rows + 1, queue.get_context()),
+          m_columns(queue.get_context()),
+          m_values(queue.get_context())
+    {
+        const context &context = queue.get_context();
+        const size_t nonzeros = detail::iterator_range_size(rows_first, rows_last);
+
+        ::boost::compute::fill(
+            m_row_offsets.begin(), m_row_offsets.end(), uint_(0), queue
+        );
+        if(nonzeros == 0){
+            return;
+        }
+
+        vector<uint_> row_indices(rows_first, rows_last, queue);
+        vector<uint_> columns(nonzeros, context);
+        vector<T> values(nonzeros, context);
+        ::boost::compute::copy_n(columns_first, nonzeros, columns.begin(), queue);
+        ::boost::compute::copy_n(values_first, nonzeros, values.begin(), queue);
+
+        // sort the entries by row
+        vector<uint_> permutation(nonzeros, context);
+        ::boost::compute::iota(
+            permutation.begin(), permutation.end(), uint_(0), queue
+        );
+        ::boost::compute::sort_by_key(
+            row_indices.begin(), row_indices.end(), permutation.begin(), queue
+        );
+
+        m_columns.resize_uninitialized(nonzeros);
+        m_values.resize_uninitialized(nonzeros);
+        ::boost::compute::gather(
+            permutation.begin(), permutation.end(),
+            columns.begin(), m_columns.begin(), queue
+        );
+        ::boost::compute::gather(
+            permutation.begin(), permutation.end(),
+            values.begin(), m_values.begin(), queue
+        );
+
+        // count the entries of each row and scan the counts to the offsets
+        vector<uint_> counts(rows + 1, uint_(0), queue);
+        detail::meta_kernel k("csr_matrix_count_rows");
+        k << "atomic_inc(" <<
+                k.get_buffer_identifier<uint_>(counts.get_buffer()) << " + " <<
+                k.get_buffer_identifier<uint_>(row_indices.get_buffer()) <<
+                "[get_global_id(0)]);\n";
+        k.exec_1d(queue, 0, nonzeros);
+
+        ::boost::compute::exclusive_scan(
+            counts.begin(), counts.end(), m_row_offsets.begin(), queue
+        );
+
+        update_statistics(queue);
+    }
+
+    /// Creates a \p rows x \p cols matrix with \p nonzeros values from its
+    /// CSR arrays, the \p rows + 1 row offsets at \p row_offsets_first and
+    /// the column indices and values at \p columns_first and
+    /// \p values_first.
+    template<class OffsetIterator, class ColumnIterator, class ValueIterator>
+    csr_matrix(size_t rows,
+               size_t cols,
+               size_t nonzeros,
+               OffsetIterator row_offsets_first,
+               ColumnIterator columns_first,
+               ValueIterator values_first,
+               command_queue &queue = system::default_queue())
+        : m_rows(rows),
+          m_cols(cols),
+          m_max_row_length(0),
+          m_row_offsets(rows + 1, queue.get_context()),
+          m_columns(nonzeros, queue.get_context()),
+          m_values(nonzeros, queue.get_context())
+    {
+        ::boost::compute::copy_n(
+            row_offsets_first, rows + 1, m_row_offsets.begin(), queue
+        );
+        ::boost::compute::copy_n(columns_first, nonzeros, m_columns.begin(), queue);
+        ::boost::compute::copy_n(values_first, nonzeros, m_values.begin(), queue);
+
+        update_statistics(queue);
+    }
+
+    /// Returns the number of rows.
+    size_t rows() const
+    {
+        return m_rows;
+    }
+
+    /// Returns the number of columns.
+    size_t cols() const
+    {
+        return m_cols;
+    }
+
+    /// Returns the number of stored (non-zero) values.
+    size_t nonzeros() const
+    {
+        return m_values.size();
+    }
+
+    /// Returns the number of values of the longest row.
+    size_t max_row_length() const
+    {
+        return m_max_row_length;
+    }
+
+    /// Returns the average number of values per row.
+    double mean_row_length() const
+    {
+        return m_rows ? double(nonzeros()) / double(m_rows) : 0.0;
+    }
+
+    /// Returns the \c rows() + 1 row offsets.
+    const vector<uint_>& row_offsets() const
+    {
+        return m_row_offsets;
+    }
+
+    /// Returns the column indices of the values.
+    const vector<uint_>& columns() const
+    {
+        return m_columns;
+    }
+
+    /// Returns the values.
+    const vector<T>& values() const
+    {
+        return m_values;
+    }
+
+private:
+    void update_statistics(command_queue &queue)
+    {
+        if(m_rows == 0){
+            return;
+        }
+
+        // lengths[i + 1] is the length of the row i
+        vector<uint_> lengths(m_rows + 1, queue.get_context());
+        ::boost::compute::adjacent_difference(
+            m_row_offsets.begin(), m_row_offsets.end(), lengths.begin(), queue
+        );
+
+        vector<uint_>::iterator longest = ::boost::compute::max_element(
+            lengths.begin() + 1, lengths.end(), queue
+        );
+        m_max_row_length = detail::read_single_value<uint_>(
+            lengths.get_buffer(), longest.get_index(), queue
+        );
+    }
+
+private:
+    size_t m_rows;
+    size_t m_cols;
+    size_t m_max_row_length;
+    vector<uint_> m_row_offsets;
+    vector<uint_> m_columns;
+    vector<T> m_values;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_LINEAR_ALGEBRA_CSR_MATRIX_HPP
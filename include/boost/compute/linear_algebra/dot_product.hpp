@@ -0,0 +1,107 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_LINEAR_ALGEBRA_DOT_PRODUCT_HPP
+#define BOOST_COMPUTE_LINEAR_ALGEBRA_DOT_PRODUCT_HPP
+
+#include <iterator>
+
+#include <boost/assert.hpp>
+#include <boost/iterator/iterator_traits.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
+#include <boost/compute/algorithm/detail/fused_transform_reduce.hpp>
+#include <boost/compute/container/valarray.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/detail/scratch_vector.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Stores the dot product of the vectors [\p first1, \p last1) and
+/// [\p first2, \p first2 + (\p last1 - \p first1)) at \p result on the
+/// device, without reading it back to the host.
+///
+/// The products are summed as they are loaded by a single fused
+/// reduction, so the result can be used by following kernels (e.g. the
+/// step length of an iterative solver) without synchronizing with the
+/// host.
+///
+/// \see inner_product()
+template<class InputIterator1, class InputIterator2, class T>
+inline void dot_product(InputIterator1 first1,
+                        InputIterator1 last1,
+                        InputIterator2 first2,
+                        buffer_iterator<T> result,
+                        command_queue &queue = system::default_queue())
+{
+    const size_t count = detail::iterator_range_size(first1, last1);
+    if(count == 0){
+        ::boost::compute::fill_n(result, 1, T(0), queue);
+        return;
+    }
+
+    detail::fused_transform_reduce(
+        first1, first2, count, multiplies<T>(), plus<T>(), result, queue
+    );
+}
+
+/// Returns the dot product of the vectors [\p first1, \p last1) and
+/// [\p first2, \p first2 + (\p last1 - \p first1)).
+///
+/// For example, with two \c vector<float>:
+///
+/// \code
+/// float d = boost::compute::dot_product(x.begin(), x.end(), y.begin(), queue);
+/// \endcode
+template<class InputIterator1, class InputIterator2>
+inline typename boost::lazy_enable_if<
+    is_device_iterator<InputIterator1>,
+    boost::iterator_value<InputIterator1>
+>::type
+dot_product(InputIterator1 first1,
+            InputIterator1 last1,
+            InputIterator2 first2,
+            command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator1>::value_type T;
+
+    detail::scratch_vector<T> result(1, queue);
+    ::boost::compute::dot_product(first1, last1, first2, result.begin(), queue);
+    return detail::read_single_value<T>(result.get_buffer(), 0, queue);
+}
+
+/// \overload
+template<class T>
+inline T dot_product(const valarray<T> &x,
+                     const valarray<T> &y,
+                     command_queue &queue = system::default_queue())
+{
+    BOOST_ASSERT(x.size() == y.size());
+
+    return ::boost::compute::dot_product(
+        make_buffer_iterator<T>(x.get_buffer(), 0),
+        make_buffer_iterator<T>(x.get_buffer(), x.size()),
+        make_buffer_iterator<T>(y.get_buffer(), 0),
+        queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_LINEAR_ALGEBRA_DOT_PRODUCT_HPP
@@ -0,0 +1,165 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_LINEAR_ALGEBRA_ELL_MATRIX_HPP
+#define BOOST_COMPUTE_LINEAR_ALGEBRA_ELL_MATRIX_HPP
+
+#include <cstddef>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/linear_algebra/csr_matrix.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+
+template<class T> class hyb_matrix;
+
+namespace detail {
+
+// stores the first width values of each row of the csr matrix in the ell
+// arrays columns and values (of rows * width values each, stored column
+// by column). rows shorter than width are padded with padding_column.
+template<class T>
+inline void csr_to_ell(const csr_matrix<T> &matrix,
+                       size_t width,
+                       uint_ padding_column,
+                       vector<uint_> &columns,
+                       vector<T> &values,
+                       command_queue &queue)
+{
+    const size_t rows = matrix.rows();
+    if(rows == 0 || width == 0){
+        return;
+    }
+
+    meta_kernel k("csr_to_ell");
+    k <<
+        "const uint row = get_global_id(0);\n" <<
+        "const uint begin = " << matrix.row_offsets().begin()[k.var<uint_>("row")] << ";\n" <<
+        "const uint end = " << matrix.row_offsets().begin()[k.var<uint_>("row + 1")] << ";\n" <<
+        "for(uint j = 0; j < " << uint_(width) << "; j++){\n" <<
+        "    const uint i = begin + j;\n" <<
+        "    const uint e = j * " << uint_(rows) << " + row;\n" <<
+        "    if(i < end){\n" <<
+        "        " << columns.begin()[k.var<uint_>("e")] << " = " <<
+                    matrix.columns().begin()[k.var<uint_>("i")] << ";\n" <<
+        "        " << values.begin()[k.var<uint_>("e")] << " = " <<
+                    matrix.values().begin()[k.var<uint_>("i")] << ";\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        " << columns.begin()[k.var<uint_>("e")] << " = " << padding_column << ";\n" <<
+        "        " << values.begin()[k.var<uint_>("e")] << " = 0;\n" <<
+        "    }\n" <<
+        "}\n";
+
+    k.exec_1d(queue, 0, rows);
+}
+
+} // end detail namespace
+
+/// \class ell_matrix
+/// \brief A sparse matrix in ELLPACK (ELL) format.
+///
+/// Every row stores the same number of values, width(), the rows shorter
+/// than the longest one being padded. The values are stored column by
+/// column (the j-th value of row \c i is at index \c j * rows() + \c i) so
+/// that the work-items computing consecutive rows in spmv() read
+/// consecutive values.
+///
+/// The ELL format is efficient for matrices whose rows have similar
+/// lengths, see hyb_matrix for matrices with a few long rows.
+///
+/// \see csr_matrix, hyb_matrix, spmv()
+template<class T>
+class ell_matrix
+{
+public:
+    typedef T value_type;
+
+    /// The column index of the padding values.
+    static const uint_ padding_column = ~uint_(0);
+
+    /// Creates an empty matrix in \p context.
+    explicit ell_matrix(const context &context = system::default_context())
+        : m_rows(0),
+          m_cols(0),
+          m_width(0),
+          m_columns(context),
+          m_values(context)
+    {
+    }
+
+    /// Creates a matrix holding the values of the csr matrix \p matrix.
+    explicit ell_matrix(const csr_matrix<T> &matrix,
+                        command_queue &queue = system::default_queue())
+        : m_rows(matrix.rows()),
+          m_cols(matrix.cols()),
+          m_width(matrix.max_row_length()),
+          m_columns(matrix.rows() * matrix.max_row_length(), queue.get_context()),
+          m_values(matrix.rows() * matrix.max_row_length(), queue.get_context())
+    {
+        detail::csr_to_ell(
+            matrix, m_width, padding_column, m_columns, m_values, queue
+        );
+    }
+
+    /// Returns the number of rows.
+    size_t rows() const
+    {
+        return m_rows;
+    }
+
+    /// Returns the number of columns.
+    size_t cols() const
+    {
+        return m_cols;
+    }
+
+    /// Returns the number of values stored for each row.
+    size_t width() const
+    {
+        return m_width;
+    }
+
+    /// Returns the column indices of the values, \c padding_column for the
+    /// padding values.
+    const vector<uint_>& columns() const
+    {
+        return m_columns;
+    }
+
+    /// Returns the values.
+    const vector<T>& values() const
+    {
+        return m_values;
+    }
+
+private:
+    friend class hyb_matrix<T>;
+
+private:
+    size_t m_rows;
+    size_t m_cols;
+    size_t m_width;
+    vector<uint_> m_columns;
+    vector<T> m_values;
+};
+
+template<class T>
+const uint_ ell_matrix<T>::padding_column;
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_LINEAR_ALGEBRA_ELL_MATRIX_HPP
@@ -0,0 +1,180 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_LINEAR_ALGEBRA_GEMM_HPP
+#define BOOST_COMPUTE_LINEAR_ALGEBRA_GEMM_HPP
+
+#include <algorithm>
+#include <iterator>
+
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns the width of the square blocks of the result computed by each
+// work-group of gemm() on the queue's device (one work-item per value).
+//
+// the default can be overridden through the global parameter_cache for
+// the device with the object name "__boost_gemm" and the parameter
+// "tile_size".
+inline uint_ gemm_tile_size(command_queue &queue, size_t value_size)
+{
+    const device &device = queue.get_device();
+    const ulong_ local_memory = device_profile::get(device)->local_memory_size();
+
+    // cpus have no local memory, smaller tiles stay in the l1 cache
+    const uint_ default_tile = device.type() & device::cpu ? 8 : 16;
+
+    uint_ tile = parameter_cache::get_global_cache(device)->get(
+        "__boost_gemm", "tile_size", default_tile
+    );
+
+    tile = (std::max)(tile, uint_(1));
+    while(tile > 1 &&
+          (tile * tile > device.max_work_group_size() ||
+           2 * tile * (tile + 1) * value_size > local_memory)){
+        tile /= 2;
+    }
+    return tile;
+}
+
+// writes the body of a gemm kernel in which each work-group of tile x
+// tile work-items computes a block of C = alpha * A * B + beta * C. the
+// kernel has the arguments m, n, depth, alpha and beta. a_value and
+// b_value are the values of A at (row, t + lx) and of B at (t + ly, col)
+// and c_value is the value of C at (row, col). C is only read if read_c
+// is true, so it may be uninitialized when beta is zero. eigen_gemm()
+// uses the same body with the offsets of its storage orders.
+template<class T, class AValue, class BValue, class CValue>
+inline void gemm_tiled_body(meta_kernel &k,
+                            uint_ tile,
+                            const AValue &a_value,
+                            const BValue &b_value,
+                            const CValue &c_value,
+                            bool read_c)
+{
+    k <<
+        "__local " << k.type<T>() << " a_tile[" << tile << "][" << tile + 1 << "];\n" <<
+        "__local " << k.type<T>() << " b_tile[" << tile << "][" << tile + 1 << "];\n" <<
+        "const uint col = get_global_id(0);\n" <<
+        "const uint row = get_global_id(1);\n" <<
+        "const uint lx = get_local_id(0);\n" <<
+        "const uint ly = get_local_id(1);\n" <<
+        k.decl<T>("sum") << " = 0;\n" <<
+        "for(uint t = 0; t < depth; t += " << tile << "){\n" <<
+        "    if(row < m && t + lx < depth){\n" <<
+        "        a_tile[ly][lx] = " << a_value << ";\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        a_tile[ly][lx] = 0;\n" <<
+        "    }\n" <<
+        "    if(t + ly < depth && col < n){\n" <<
+        "        b_tile[ly][lx] = " << b_value << ";\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        b_tile[ly][lx] = 0;\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    for(uint i = 0; i < " << tile << "; i++){\n" <<
+        "        sum += a_tile[ly][i] * b_tile[i][lx];\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n" <<
+        "if(row < m && col < n){\n";
+    if(read_c){
+        k << "    " << c_value << " = alpha * sum + beta * " << c_value << ";\n";
+    }
+    else {
+        k << "    " << c_value << " = alpha * sum;\n";
+    }
+    k << "}\n";
+}
+
+} // end detail namespace
+
+/// Computes C = \p alpha * A * B + \p beta * C where A is the \p m x
+/// \p depth matrix at \p a, B the \p depth x \p n matrix at \p b and C the
+/// \p m x \p n matrix at \p c. The matrices are stored in row-major order.
+///
+/// Each work-group computes a square block of C, loading the blocks of A
+/// and B it needs in local memory so each value is read from global memory
+/// once per work-group instead of once per work-item. The block size
+/// depends on the device (see the \c "__boost_gemm" parameters). C is not
+/// read when \p beta is zero.
+///
+/// For example, the squared euclidean distances between the rows of two
+/// point sets can be computed as |x|^2 + |y|^2 - 2 * X * Y^T:
+///
+/// \code
+/// boost::compute::gemm(
+///     x_count, y_count, dimension,
+///     -2.0f, x.begin(), y_transposed.begin(),
+///     0.0f, distances.begin(),
+///     queue
+/// );
+/// \endcode
+///
+/// \see gemv(), transpose(), eigen_gemm()
+template<class InputIterator1, class InputIterator2, class OutputIterator, class T>
+inline void gemm(size_t m,
+                 size_t n,
+                 size_t depth,
+                 const T &alpha,
+                 InputIterator1 a,
+                 InputIterator2 b,
+                 const T &beta,
+                 OutputIterator c,
+                 command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<OutputIterator>::value_type value_type;
+
+    if(m == 0 || n == 0){
+        return;
+    }
+
+    const uint_ tile = detail::gemm_tile_size(queue, sizeof(value_type));
+
+    detail::meta_kernel k("gemm");
+    k.add_set_arg<uint_>("m", static_cast<uint_>(m));
+    k.add_set_arg<uint_>("n", static_cast<uint_>(n));
+    k.add_set_arg<uint_>("depth", static_cast<uint_>(depth));
+    k.add_set_arg<value_type>("alpha", static_cast<value_type>(alpha));
+    k.add_set_arg<value_type>("beta", static_cast<value_type>(beta));
+
+    detail::gemm_tiled_body<value_type>(
+        k,
+        tile,
+        a[k.var<uint_>("row * depth + t + lx")],
+        b[k.var<uint_>("(t + ly) * n + col")],
+        c[k.var<uint_>("row * n + col")],
+        beta != T(0)
+    );
+
+    kernel kernel = k.compile(queue.get_context());
+
+    const size_t global_size[] = {
+        (n + tile - 1) / tile * tile, (m + tile - 1) / tile * tile
+    };
+    const size_t local_size[] = { tile, tile };
+    queue.enqueue_nd_range_kernel(kernel, 2, 0, global_size, local_size);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_LINEAR_ALGEBRA_GEMM_HPP
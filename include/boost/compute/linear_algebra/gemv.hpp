@@ -0,0 +1,123 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_LINEAR_ALGEBRA_GEMV_HPP
+#define BOOST_COMPUTE_LINEAR_ALGEBRA_GEMV_HPP
+
+#include <algorithm>
+#include <iterator>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns the number of work-items reducing each row in gemv(), a power
+// of two no larger than needed for rows of the given length.
+//
+// the maximum can be overridden through the global parameter_cache for
+// the device with the object name "__boost_gemv" and the parameter
+// "work_group_size".
+inline size_t gemv_work_group_size(command_queue &queue,
+                                   size_t columns,
+                                   size_t value_size)
+{
+    const device &device = queue.get_device();
+    const ulong_ local_memory = device_profile::get(device)->local_memory_size();
+
+    const size_t max_size = (std::min)(
+        static_cast<size_t>(parameter_cache::get_global_cache(device)->get(
+            "__boost_gemv", "work_group_size", uint_(128)
+        )),
+        (std::min)(device.max_work_group_size(),
+                   static_cast<size_t>(local_memory / value_size))
+    );
+
+    size_t work_group_size = 1;
+    while(work_group_size * 2 <= max_size && work_group_size < columns){
+        work_group_size *= 2;
+    }
+    return work_group_size;
+}
+
+} // end detail namespace
+
+/// Computes y = \p alpha * A * x + \p beta * y where A is the \p rows x
+/// \p columns row-major matrix at \p a, x the vector of \p columns values
+/// at \p x and y the vector of \p rows values at \p y.
+///
+/// Each row is reduced by a work-group whose work-items read consecutive
+/// values of the row, y is not read when \p beta is zero.
+///
+/// \see gemm(), dot_product()
+template<class InputIterator1, class InputIterator2, class OutputIterator, class T>
+inline void gemv(size_t rows,
+                 size_t columns,
+                 const T &alpha,
+                 InputIterator1 a,
+                 InputIterator2 x,
+                 const T &beta,
+                 OutputIterator y,
+                 command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<OutputIterator>::value_type value_type;
+
+    if(rows == 0){
+        return;
+    }
+
+    const size_t work_group_size =
+        detail::gemv_work_group_size(queue, columns, sizeof(value_type));
+
+    detail::meta_kernel k("gemv");
+    k.add_set_arg<uint_>("columns", static_cast<uint_>(columns));
+    k.add_set_arg<value_type>("alpha", static_cast<value_type>(alpha));
+    k.add_set_arg<value_type>("beta", static_cast<value_type>(beta));
+
+    k <<
+        "__local " << k.type<value_type>() <<
+            " partial[" << uint_(work_group_size) << "];\n" <<
+        "const uint row = get_group_id(0);\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        k.decl<value_type>("sum") << " = 0;\n" <<
+        "for(uint j = lid; j < columns; j += " << uint_(work_group_size) << "){\n" <<
+        "    sum += " << a[k.var<uint_>("row * columns + j")] << " * " <<
+                x[k.var<uint_>("j")] << ";\n" <<
+        "}\n" <<
+        "partial[lid] = sum;\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(uint s = " << uint_(work_group_size / 2) << "; s > 0; s >>= 1){\n" <<
+        "    if(lid < s){\n" <<
+        "        partial[lid] += partial[lid + s];\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n" <<
+        "if(lid == 0){\n";
+    if(beta == T(0)){
+        k << "    " << y[k.var<uint_>("row")] << " = alpha * partial[0];\n";
+    }
+    else {
+        k << "    " << y[k.var<uint_>("row")] << " = alpha * partial[0] + beta * " <<
+                y[k.var<uint_>("row")] << ";\n";
+    }
+    k << "}\n";
+
+    k.exec_1d(queue, 0, rows * work_group_size, work_group_size);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_LINEAR_ALGEBRA_GEMV_HPP
@@ -0,0 +1,206 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_LINEAR_ALGEBRA_HYB_MATRIX_HPP
+#define BOOST_COMPUTE_LINEAR_ALGEBRA_HYB_MATRIX_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/linear_algebra/csr_matrix.hpp>
+#include <boost/compute/linear_algebra/ell_matrix.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns the smallest ell width for which at most a third of the rows of
+// matrix are longer (bell and garland's heuristic for the hybrid format)
+template<class T>
+inline size_t hyb_matrix_ell_width(const csr_matrix<T> &matrix,
+                                   command_queue &queue)
+{
+    const size_t rows = matrix.rows();
+    if(rows == 0){
+        return 0;
+    }
+
+    std::vector<uint_> offsets(rows + 1);
+    ::boost::compute::copy(
+        matrix.row_offsets().begin(), matrix.row_offsets().end(),
+        offsets.begin(), queue
+    );
+
+    // number of rows of each length
+    std::vector<size_t> row_counts(matrix.max_row_length() + 1, 0);
+    for(size_t i = 0; i < rows; i++){
+        row_counts[offsets[i + 1] - offsets[i]]++;
+    }
+
+    size_t longer_rows = rows;
+    for(size_t width = 0; width < row_counts.size(); width++){
+        longer_rows -= row_counts[width];
+        if(3 * longer_rows <= rows){
+            return width;
+        }
+    }
+    return matrix.max_row_length();
+}
+
+} // end detail namespace
+
+/// \class hyb_matrix
+/// \brief A sparse matrix in hybrid (ELL + CSR) format.
+///
+/// The first \c ell_width() values of each row are stored in an ell_matrix
+/// and the values of the longer rows following them in a csr_matrix, so a
+/// few long rows do not pad all the ell rows to their length.
+///
+/// \see csr_matrix, ell_matrix, spmv()
+template<class T>
+class hyb_matrix
+{
+public:
+    typedef T value_type;
+
+    /// Creates an empty matrix in \p context.
+    explicit hyb_matrix(const context &context = system::default_context())
+        : m_ell(context),
+          m_csr(context)
+    {
+    }
+
+    /// Creates a matrix holding the values of the csr matrix \p matrix.
+    ///
+    /// If \p ell_width is zero, the width of the ell part is chosen such
+    /// that at most a third of the rows have values in the csr part.
+    explicit hyb_matrix(const csr_matrix<T> &matrix,
+                        command_queue &queue = system::default_queue(),
+                        size_t ell_width = 0)
+        : m_ell(queue.get_context()),
+          m_csr(queue.get_context())
+    {
+        const context &context = queue.get_context();
+        const size_t rows = matrix.rows();
+
+        if(ell_width == 0){
+            ell_width = detail::hyb_matrix_ell_width(matrix, queue);
+        }
+        ell_width = (std::min)(ell_width, matrix.max_row_length());
+
+        m_ell.m_rows = rows;
+        m_ell.m_cols = matrix.cols();
+        m_ell.m_width = ell_width;
+        m_ell.m_columns.resize_uninitialized(rows * ell_width);
+        m_ell.m_values.resize_uninitialized(rows * ell_width);
+        detail::csr_to_ell(
+            matrix, ell_width, ell_matrix<T>::padding_column,
+            m_ell.m_columns, m_ell.m_values, queue
+        );
+
+        if(rows == 0){
+            return;
+        }
+
+        // the lengths of the rows past the ell width, scanned to the row
+        // offsets of the csr part
+        vector<uint_> counts(rows + 1, context);
+        detail::meta_kernel count_kernel("hyb_matrix_count_rows");
+        count_kernel <<
+            "const uint row = get_global_id(0);\n" <<
+            "uint length = 0;\n" <<
+            "if(row < " << uint_(rows) << "){\n" <<
+            "    length = " << matrix.row_offsets().begin()[count_kernel.var<uint_>("row + 1")] <<
+                    " - " << matrix.row_offsets().begin()[count_kernel.var<uint_>("row")] << ";\n" <<
+            "}\n" <<
+            counts.begin()[count_kernel.var<uint_>("row")] << " = " <<
+                "length > " << uint_(ell_width) << " ? length - " << uint_(ell_width) << " : 0;\n";
+        count_kernel.exec_1d(queue, 0, rows + 1);
+
+        vector<uint_> offsets(rows + 1, context);
+        ::boost::compute::exclusive_scan(
+            counts.begin(), counts.end(), offsets.begin(), queue
+        );
+        const size_t nonzeros =
+            detail::read_single_value<uint_>(offsets.get_buffer(), rows, queue);
+
+        vector<uint_> columns((std::max)(nonzeros, size_t(1)), context);
+        vector<T> values((std::max)(nonzeros, size_t(1)), context);
+        if(nonzeros > 0){
+            detail::meta_kernel k("hyb_matrix_copy_rows");
+            k <<
+                "const uint row = get_global_id(0);\n" <<
+                "const uint begin = " << matrix.row_offsets().begin()[k.var<uint_>("row")] <<
+                    " + " << uint_(ell_width) << ";\n" <<
+                "const uint end = " << matrix.row_offsets().begin()[k.var<uint_>("row + 1")] << ";\n" <<
+                "uint output = " << offsets.begin()[k.var<uint_>("row")] << ";\n" <<
+                "for(uint i = begin; i < end; i++, output++){\n" <<
+                "    " << columns.begin()[k.var<uint_>("output")] << " = " <<
+                        matrix.columns().begin()[k.var<uint_>("i")] << ";\n" <<
+                "    " << values.begin()[k.var<uint_>("output")] << " = " <<
+                        matrix.values().begin()[k.var<uint_>("i")] << ";\n" <<
+                "}\n";
+            k.exec_1d(queue, 0, rows);
+        }
+
+        m_csr = csr_matrix<T>(
+            rows, matrix.cols(), nonzeros,
+            offsets.begin(), columns.begin(), values.begin(), queue
+        );
+    }
+
+    /// Returns the number of rows.
+    size_t rows() const
+    {
+        return m_ell.rows();
+    }
+
+    /// Returns the number of columns.
+    size_t cols() const
+    {
+        return m_ell.cols();
+    }
+
+    /// Returns the number of values of each row stored in the ell part.
+    size_t ell_width() const
+    {
+        return m_ell.width();
+    }
+
+    /// Returns the ell part of the matrix.
+    const ell_matrix<T>& ell() const
+    {
+        return m_ell;
+    }
+
+    /// Returns the csr part of the matrix, holding the values of the rows
+    /// longer than ell_width().
+    const csr_matrix<T>& csr() const
+    {
+        return m_csr;
+    }
+
+private:
+    ell_matrix<T> m_ell;
+    csr_matrix<T> m_csr;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_LINEAR_ALGEBRA_HYB_MATRIX_HPP
@@ -0,0 +1,280 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_LINEAR_ALGEBRA_SPMV_HPP
+#define BOOST_COMPUTE_LINEAR_ALGEBRA_SPMV_HPP
+
+#include <algorithm>
+#include <iterator>
+
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/linear_algebra/csr_matrix.hpp>
+#include <boost/compute/linear_algebra/ell_matrix.hpp>
+#include <boost/compute/linear_algebra/hyb_matrix.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// emits the statement storing y[row] = alpha * sum + beta * y[row], y is
+// not read when beta is zero
+template<class OutputIterator, class T>
+inline void spmv_store(meta_kernel &k,
+                       OutputIterator y,
+                       const T &beta,
+                       const char *sum)
+{
+    if(beta == T(0)){
+        k << y[k.var<uint_>("row")] << " = alpha * " << sum << ";\n";
+    }
+    else {
+        k << y[k.var<uint_>("row")] << " = alpha * " << sum << " + beta * " <<
+                y[k.var<uint_>("row")] << ";\n";
+    }
+}
+
+// y = alpha * A * x + beta * y with one work-item per row of the csr
+// matrix, efficient for short rows
+template<class T, class InputIterator, class OutputIterator>
+inline void csr_spmv_scalar(size_t rows,
+                            const vector<uint_> &row_offsets,
+                            const vector<uint_> &columns,
+                            const vector<T> &values,
+                            const T &alpha,
+                            InputIterator x,
+                            const T &beta,
+                            OutputIterator y,
+                            command_queue &queue)
+{
+    meta_kernel k("csr_spmv_scalar");
+    k.add_set_arg<T>("alpha", alpha);
+    k.add_set_arg<T>("beta", beta);
+    k <<
+        "const uint row = get_global_id(0);\n" <<
+        "const uint end = " << row_offsets.begin()[k.var<uint_>("row + 1")] << ";\n" <<
+        k.decl<T>("sum") << " = 0;\n" <<
+        "for(uint i = " << row_offsets.begin()[k.var<uint_>("row")] << "; i < end; i++){\n" <<
+        "    sum += " << values.begin()[k.var<uint_>("i")] << " * " <<
+                x[columns.begin()[k.var<uint_>("i")]] << ";\n" <<
+        "}\n";
+    spmv_store(k, y, beta, "sum");
+
+    k.exec_1d(queue, 0, rows);
+}
+
+// y = alpha * A * x + beta * y with one work-group per row of the csr
+// matrix, its work-items reading consecutive values of the row
+template<class T, class InputIterator, class OutputIterator>
+inline void csr_spmv_vector(size_t rows,
+                            const vector<uint_> &row_offsets,
+                            const vector<uint_> &columns,
+                            const vector<T> &values,
+                            const T &alpha,
+                            InputIterator x,
+                            const T &beta,
+                            OutputIterator y,
+                            size_t work_group_size,
+                            command_queue &queue)
+{
+    meta_kernel k("csr_spmv_vector");
+    k.add_set_arg<T>("alpha", alpha);
+    k.add_set_arg<T>("beta", beta);
+    k <<
+        "__local " << k.type<T>() << " partial[" << uint_(work_group_size) << "];\n" <<
+        "const uint row = get_group_id(0);\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint end = " << row_offsets.begin()[k.var<uint_>("row + 1")] << ";\n" <<
+        k.decl<T>("sum") << " = 0;\n" <<
+        "for(uint i = " << row_offsets.begin()[k.var<uint_>("row")] << " + lid; " <<
+                "i < end; i += " << uint_(work_group_size) << "){\n" <<
+        "    sum += " << values.begin()[k.var<uint_>("i")] << " * " <<
+                x[columns.begin()[k.var<uint_>("i")]] << ";\n" <<
+        "}\n" <<
+        "partial[lid] = sum;\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(uint s = " << uint_(work_group_size / 2) << "; s > 0; s >>= 1){\n" <<
+        "    if(lid < s){\n" <<
+        "        partial[lid] += partial[lid + s];\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n" <<
+        "if(lid == 0){\n";
+    spmv_store(k, y, beta, "partial[0]");
+    k << "}\n";
+
+    k.exec_1d(queue, 0, rows * work_group_size, work_group_size);
+}
+
+// y = alpha * A * x + beta * y with one work-item per row of the ell
+// matrix (stored column by column so that consecutive work-items read
+// consecutive values)
+template<class T, class InputIterator, class OutputIterator>
+inline void ell_spmv(size_t rows,
+                     size_t width,
+                     const vector<uint_> &columns,
+                     const vector<T> &values,
+                     const T &alpha,
+                     InputIterator x,
+                     const T &beta,
+                     OutputIterator y,
+                     command_queue &queue)
+{
+    meta_kernel k("ell_spmv");
+    k.add_set_arg<T>("alpha", alpha);
+    k.add_set_arg<T>("beta", beta);
+    k <<
+        "const uint row = get_global_id(0);\n" <<
+        k.decl<T>("sum") << " = 0;\n" <<
+        "for(uint j = 0; j < " << uint_(width) << "; j++){\n" <<
+        "    const uint i = j * " << uint_(rows) << " + row;\n" <<
+        "    const uint column = " << columns.begin()[k.var<uint_>("i")] << ";\n" <<
+        "    if(column != " << ell_matrix<T>::padding_column << "){\n" <<
+        "        sum += " << values.begin()[k.var<uint_>("i")] << " * " <<
+                    x[k.var<uint_>("column")] << ";\n" <<
+        "    }\n" <<
+        "}\n";
+    spmv_store(k, y, beta, "sum");
+
+    k.exec_1d(queue, 0, rows);
+}
+
+// returns the number of work-items computing each row of a csr matrix,
+// or zero if each row should be computed by a single work-item.
+//
+// the vector kernel is used when the average row length reaches the
+// "vector_row_length" parameter and its work-group size is bounded by the
+// "work_group_size" parameter, both of which can be overridden through
+// the global parameter_cache for the device with the object name
+// "__boost_spmv".
+template<class T>
+inline size_t csr_spmv_work_group_size(const csr_matrix<T> &matrix,
+                                       command_queue &queue)
+{
+    const device &device = queue.get_device();
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(device);
+
+    // cpus gain nothing from splitting the rows between work-items
+    const uint_ default_row_length = device.type() & device::cpu ? 1024 : 8;
+    const uint_ vector_row_length = parameters->get(
+        "__boost_spmv", "vector_row_length", default_row_length
+    );
+    if(matrix.mean_row_length() < double(vector_row_length)){
+        return 0;
+    }
+
+    const ulong_ local_memory = device_profile::get(device)->local_memory_size();
+    const size_t max_size = (std::min)(
+        static_cast<size_t>(parameters->get("__boost_spmv", "work_group_size", uint_(32))),
+        (std::min)(device.max_work_group_size(),
+                   static_cast<size_t>(local_memory / sizeof(T)))
+    );
+
+    // smallest power of two covering the average row length
+    size_t work_group_size = 1;
+    while(work_group_size * 2 <= max_size &&
+          double(work_group_size) < matrix.mean_row_length()){
+        work_group_size *= 2;
+    }
+    return work_group_size;
+}
+
+} // end detail namespace
+
+/// Computes y = \p alpha * A * x + \p beta * y for the sparse matrix
+/// \p matrix, x starting at \p x and y starting at \p y. y is not read
+/// when \p beta is zero.
+///
+/// Rows are computed by one work-item each when they are short on average
+/// and by a work-group each (reading the row with coalesced accesses)
+/// otherwise, see the \c "__boost_spmv" parameters.
+///
+/// For example, the step of an iterative solver computing r = b - A * x:
+///
+/// \code
+/// boost::compute::copy(b.begin(), b.end(), r.begin(), queue);
+/// boost::compute::spmv(-1.0f, matrix, x.begin(), 1.0f, r.begin(), queue);
+/// \endcode
+///
+/// \see csr_matrix, ell_matrix, hyb_matrix, gemv()
+template<class T, class InputIterator, class OutputIterator>
+inline void spmv(const T &alpha,
+                 const csr_matrix<T> &matrix,
+                 InputIterator x,
+                 const T &beta,
+                 OutputIterator y,
+                 command_queue &queue = system::default_queue())
+{
+    if(matrix.rows() == 0){
+        return;
+    }
+
+    const size_t work_group_size = detail::csr_spmv_work_group_size(matrix, queue);
+    if(work_group_size == 0){
+        detail::csr_spmv_scalar(
+            matrix.rows(), matrix.row_offsets(), matrix.columns(), matrix.values(),
+            alpha, x, beta, y, queue
+        );
+    }
+    else {
+        detail::csr_spmv_vector(
+            matrix.rows(), matrix.row_offsets(), matrix.columns(), matrix.values(),
+            alpha, x, beta, y, work_group_size, queue
+        );
+    }
+}
+
+/// \overload
+template<class T, class InputIterator, class OutputIterator>
+inline void spmv(const T &alpha,
+                 const ell_matrix<T> &matrix,
+                 InputIterator x,
+                 const T &beta,
+                 OutputIterator y,
+                 command_queue &queue = system::default_queue())
+{
+    if(matrix.rows() == 0){
+        return;
+    }
+
+    detail::ell_spmv(
+        matrix.rows(), matrix.width(), matrix.columns(), matrix.values(),
+        alpha, x, beta, y, queue
+    );
+}
+
+/// \overload
+///
+/// The ell part of \p matrix is computed first, the values of the rows
+/// longer than its width are then added from the csr part.
+template<class T, class InputIterator, class OutputIterator>
+inline void spmv(const T &alpha,
+                 const hyb_matrix<T> &matrix,
+                 InputIterator x,
+                 const T &beta,
+                 OutputIterator y,
+                 command_queue &queue = system::default_queue())
+{
+    ::boost::compute::spmv(alpha, matrix.ell(), x, beta, y, queue);
+    if(matrix.csr().nonzeros() > 0){
+        ::boost::compute::spmv(alpha, matrix.csr(), x, T(1), y, queue);
+    }
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_LINEAR_ALGEBRA_SPMV_HPP
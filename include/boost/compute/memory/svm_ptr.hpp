@@ -11,12 +11,44 @@
 #ifndef BOOST_COMPUTE_MEMORY_SVM_PTR_HPP
 #define BOOST_COMPUTE_MEMORY_SVM_PTR_HPP
 
+#include <cstddef>
+#include <iterator>
+
 #include <boost/compute/cl.hpp>
 #include <boost/compute/type_traits/is_device_iterator.hpp>
 
 namespace boost {
 namespace compute {
+namespace detail {
+
+template<class T, class IndexExpr>
+struct svm_ptr_index_expr
+{
+    typedef T result_type;
+
+    svm_ptr_index_expr(void *ptr, const IndexExpr &expr)
+        : m_ptr(ptr),
+          m_expr(expr)
+    {
+    }
 
+    void *m_ptr;
+    IndexExpr m_expr;
+};
+
+} // end detail namespace
+
+/// \class svm_ptr
+/// \brief A pointer to values in shared virtual memory (SVM).
+///
+/// The svm_ptr class points to memory allocated with svm_alloc() (or
+/// svm_vector). It can be used as a random-access device iterator with the
+/// algorithms, the pointer is passed to the kernels directly with
+/// \c clSetKernelArgSVMPointer().
+///
+/// \opencl_version_warning{2,0}
+///
+/// \see svm_alloc(), svm_vector
 template<class T>
 class svm_ptr
 {
@@ -42,9 +74,11 @@ public:
     {
     }
 
-    svm_ptr& operator=(const svm_ptr<T> &other)
+    svm_ptr<T>& operator=(const svm_ptr<T> &other)
     {
         m_ptr = other.m_ptr;
+
+        return *this;
     }
 
     ~svm_ptr()
@@ -56,16 +90,86 @@ public:
         return m_ptr;
     }
 
-    svm_ptr<T> operator+(difference_type n)
+    svm_ptr<T> operator+(difference_type n) const
     {
         return svm_ptr<T>(m_ptr + n);
     }
 
-    difference_type operator-(svm_ptr<T> other)
+    svm_ptr<T> operator-(difference_type n) const
+    {
+        return svm_ptr<T>(m_ptr - n);
+    }
+
+    difference_type operator-(const svm_ptr<T> &other) const
     {
         return m_ptr - other.m_ptr;
     }
 
+    svm_ptr<T>& operator+=(difference_type n)
+    {
+        m_ptr += n;
+
+        return *this;
+    }
+
+    svm_ptr<T>& operator-=(difference_type n)
+    {
+        m_ptr -= n;
+
+        return *this;
+    }
+
+    svm_ptr<T>& operator++()
+    {
+        ++m_ptr;
+
+        return *this;
+    }
+
+    svm_ptr<T> operator++(int)
+    {
+        svm_ptr<T> copy(*this);
+        ++m_ptr;
+        return copy;
+    }
+
+    svm_ptr<T>& operator--()
+    {
+        --m_ptr;
+
+        return *this;
+    }
+
+    svm_ptr<T> operator--(int)
+    {
+        svm_ptr<T> copy(*this);
+        --m_ptr;
+        return copy;
+    }
+
+    bool operator==(const svm_ptr<T> &other) const
+    {
+        return m_ptr == other.m_ptr;
+    }
+
+    bool operator!=(const svm_ptr<T> &other) const
+    {
+        return m_ptr != other.m_ptr;
+    }
+
+    bool operator<(const svm_ptr<T> &other) const
+    {
+        return m_ptr < other.m_ptr;
+    }
+
+    /// \internal_
+    template<class Expr>
+    detail::svm_ptr_index_expr<T, Expr>
+    operator[](const Expr &expr) const
+    {
+        return detail::svm_ptr_index_expr<T, Expr>(m_ptr, expr);
+    }
+
 private:
     T *m_ptr;
 };
@@ -23,14 +23,22 @@
 #include <boost/compute/config.hpp>
 #include <boost/compute/context.hpp>
 #include <boost/compute/exception.hpp>
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/async/future.hpp>
 #include <boost/compute/detail/assert_cl_success.hpp>
 
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+#include <atomic>
+#else
+#include <boost/atomic.hpp>
+#endif
+
 #ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
 #include <sstream>
 #include <boost/optional.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/compute/platform.hpp>
-#include <boost/compute/detail/getenv.hpp>
+#include <boost/compute/detail/offline_cache.hpp>
 #include <boost/compute/detail/sha1.hpp>
 #endif
 
@@ -272,6 +280,74 @@ public:
         }
     }
 
+    #if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+    /// Starts building the program with \p options and returns a future
+    /// which becomes ready when the build completes.
+    ///
+    /// The build is notified through the \c pfn_notify callback of
+    /// clBuildProgram() which allows the calling thread to perform other
+    /// work (e.g. enqueuing other kernels) while the program compiles.
+    /// Calling get() or wait() on the returned future blocks until the
+    /// build has finished and throws an opencl_error if it failed (the
+    /// build log is then available from build_log()).
+    ///
+    /// The returned future's event can also be used as a dependency for
+    /// other operations, for example:
+    /// \code
+    /// boost::compute::future<program> f = program.build_async();
+    ///
+    /// // ... do other work ...
+    ///
+    /// boost::compute::kernel kernel(f.get(), "foo");
+    /// \endcode
+    ///
+    /// Note that some implementations build the program synchronously
+    /// before clBuildProgram() returns.
+    ///
+    /// \opencl_version_warning{1,1}
+    ///
+    /// \see_opencl_ref{clBuildProgram}
+    future<program> build_async(const std::string &options = std::string())
+    {
+        const char *options_string = 0;
+
+        if(!options.empty()){
+            options_string = options.c_str();
+        }
+
+        user_event event(get_context());
+
+        // the state is shared by this function and the callback, whichever
+        // of them finishes last releases it
+        build_callback_state *state = new build_callback_state(event.get());
+
+        cl_int ret = clBuildProgram(
+            m_program, 0, 0, options_string, build_callback, state
+        );
+
+        if(ret == CL_BUILD_PROGRAM_FAILURE){
+            // the build was done synchronously and failed. the callback may
+            // have run already or run later (then setting the status again
+            // fails). if it never runs its share of the state is leaked
+            // rather than released twice
+            clSetUserEventStatus(event.get(), CL_BUILD_PROGRAM_FAILURE);
+            state->release();
+        }
+        else if(ret != CL_SUCCESS){
+            // the build did not start and the callback will not be called
+            state->release();
+            state->release();
+
+            BOOST_THROW_EXCEPTION(opencl_error(ret));
+        }
+        else {
+            state->release();
+        }
+
+        return make_future(*this, event);
+    }
+    #endif // CL_VERSION_1_1
+
     #if defined(CL_VERSION_1_2) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
     /// Compiles the program with \p options.
     ///
@@ -490,12 +566,88 @@ public:
     }
     #endif // CL_VERSION_1_2
 
+    #if defined(CL_VERSION_2_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+    /// Creates a new program with \p il_binary (e.g. a SPIR-V binary) of
+    /// \p il_size bytes in \p context.
+    ///
+    /// \opencl_version_warning{2,1}
+    ///
+    /// \see_opencl21_ref{clCreateProgramWithIL}
+    static program create_with_il(const void *il_binary,
+                                  size_t il_size,
+                                  const context &context)
+    {
+        cl_int error = 0;
+
+        cl_program program_ = clCreateProgramWithIL(
+            context.get(), il_binary, il_size, &error
+        );
+
+        if(!program_){
+            BOOST_THROW_EXCEPTION(opencl_error(error));
+        }
+
+        return program(program_, false);
+    }
+
+    /// Creates a new program with \p il_binary in \p context.
+    ///
+    /// \opencl_version_warning{2,1}
+    ///
+    /// \see_opencl21_ref{clCreateProgramWithIL}
+    static program create_with_il(const std::vector<unsigned char> &il_binary,
+                                  const context &context)
+    {
+        return create_with_il(&il_binary[0], il_binary.size(), context);
+    }
+
+    /// Creates a new program with \p il_binary in \p context and builds it
+    /// with \p options.
+    ///
+    /// In case BOOST_COMPUTE_USE_OFFLINE_CACHE macro is defined, the device
+    /// binary is stored in the offline cache (see build_with_source()) so
+    /// that later runs do not need to compile the IL again.
+    ///
+    /// \opencl_version_warning{2,1}
+    static program build_with_il(const std::vector<unsigned char> &il_binary,
+                                 const context &context,
+                                 const std::string &options = std::string())
+    {
+#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+        const std::string hash = offline_cache_hash(
+            std::string(il_binary.begin(), il_binary.end()), context, options
+        );
+
+        try {
+            boost::optional<program> prog = load_program_binary(hash, context);
+
+            if (prog) {
+                prog->build(options);
+                return *prog;
+            }
+        } catch (...) {
+            // Fallback to normal compilation.
+        }
+#endif
+        program prog = create_with_il(il_binary, context);
+        prog.build(options);
+
+#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+        save_program_binary(hash, prog);
+#endif
+
+        return prog;
+    }
+    #endif // CL_VERSION_2_1
+
     /// Create a new program with \p source in \p context and builds it with \p options.
     /**
      * In case BOOST_COMPUTE_USE_OFFLINE_CACHE macro is defined,
      * the compiled binary is stored for reuse in the offline cache located in
      * $HOME/.boost_compute on UNIX-like systems and in %APPDATA%/boost_compute
-     * on Windows.
+     * on Windows. The location can be changed with the
+     * BOOST_COMPUTE_OFFLINE_CACHE_DIR environment variable and the total size
+     * of the cache (in bytes) is limited by BOOST_COMPUTE_OFFLINE_CACHE_SIZE.
      */
     static program build_with_source(
             const std::string &source,
@@ -505,19 +657,7 @@ public:
     {
 #ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
         // Get hash string for the kernel.
-        std::string hash;
-        {
-            device   d(context.get_device());
-            platform p = d.platform();
-
-            std::ostringstream src;
-            src << "// " << p.name() << " v" << p.version() << "\n"
-                << "// " << context.get_device().name() << "\n"
-                << "// " << options << "\n\n"
-                << source;
-
-            hash = detail::sha1(src.str());
-        }
+        const std::string hash = offline_cache_hash(source, context, options);
 
         // Try to get cached program binaries:
         try {
@@ -557,50 +697,111 @@ public:
     }
 
 private:
-#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
-    // Path delimiter symbol for the current OS.
-    static const std::string& path_delim() {
-        static const std::string delim =
-            boost::filesystem::path("/").make_preferred().string();
-        return delim;
-    }
-
-    // Path to appdata folder.
-    static inline const std::string& appdata_path() {
-#ifdef WIN32
-        static const std::string appdata = detail::getenv("APPDATA")
-            + path_delim() + "boost_compute";
-#else
-        static const std::string appdata = detail::getenv("HOME")
-            + path_delim() + ".boost_compute";
-#endif
-        return appdata;
+    #ifdef CL_VERSION_1_1
+    // the user event of build_async(), shared by the caller and the build
+    // callback. each of them holds one share and the last one to release
+    // its share releases the event. the callback may run on another thread
+    // (even without BOOST_COMPUTE_THREAD_SAFE) so the count is atomic.
+    class build_callback_state
+    {
+    public:
+        explicit build_callback_state(cl_event event_)
+            : m_event(event_),
+              m_shares(2)
+        {
+            clRetainEvent(m_event);
+        }
+
+        cl_event event() const
+        {
+            return m_event;
+        }
+
+        void release()
+        {
+            if(--m_shares == 0){
+                clReleaseEvent(m_event);
+                delete this;
+            }
+        }
+
+    private:
+        cl_event m_event;
+        #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+        std::atomic<int> m_shares;
+        #else
+        boost::atomic<int> m_shares;
+        #endif
+    };
+
+    // completes the user event passed to build_async() with the build status
+    static void BOOST_COMPUTE_CL_CALLBACK
+    build_callback(cl_program program_, void *user_data)
+    {
+        build_callback_state *state = static_cast<build_callback_state *>(user_data);
+        cl_event event = state->event();
+
+        cl_int status = CL_COMPLETE;
+
+        // check the build status for each device
+        cl_uint num_devices = 0;
+        clGetProgramInfo(
+            program_, CL_PROGRAM_NUM_DEVICES, sizeof(cl_uint), &num_devices, 0
+        );
+
+        std::vector<cl_device_id> devices(num_devices);
+        if(num_devices > 0){
+            clGetProgramInfo(program_,
+                             CL_PROGRAM_DEVICES,
+                             num_devices * sizeof(cl_device_id),
+                             &devices[0],
+                             0);
+        }
+
+        for(size_t i = 0; i < devices.size(); i++){
+            cl_build_status build_status = CL_BUILD_ERROR;
+            clGetProgramBuildInfo(program_,
+                                  devices[i],
+                                  CL_PROGRAM_BUILD_STATUS,
+                                  sizeof(cl_build_status),
+                                  &build_status,
+                                  0);
+
+            if(build_status != CL_BUILD_SUCCESS){
+                status = CL_BUILD_PROGRAM_FAILURE;
+            }
+        }
+
+        // fails if build_async() already set the status of a synchronous
+        // build failure
+        clSetUserEventStatus(event, status);
+        state->release();
     }
+    #endif // CL_VERSION_1_1
 
-    // Path to cached binaries.
-    static std::string program_binary_path(const std::string &hash, bool create = false)
+#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+    // Returns the offline cache hash for a program built from source
+    // (or IL) with options for the device in context.
+    static std::string offline_cache_hash(const std::string &source,
+                                          const context &context,
+                                          const std::string &options)
     {
-        std::string dir = appdata_path()    + path_delim()
-                        + hash.substr(0, 2) + path_delim()
-                        + hash.substr(2);
+        const device d = context.get_device();
+        const platform p = d.platform();
 
-        if (create) boost::filesystem::create_directories(dir);
+        std::ostringstream src;
+        src << "// " << p.name() << " v" << p.version() << "\n"
+            << "// " << d.name() << " v" << d.driver_version() << "\n"
+            << "// " << options << "\n\n"
+            << source;
 
-        return dir + path_delim();
+        return detail::sha1(src.str());
     }
 
     // Saves program binaries for future reuse.
     static void save_program_binary(const std::string &hash, const program &prog)
     {
-        std::string fname = program_binary_path(hash, true) + "kernel";
-        std::ofstream bfile(fname.c_str(), std::ios::binary);
-        if (!bfile) return;
-
-        std::vector<unsigned char> binary = prog.binary();
-
-        size_t binary_size = binary.size();
-        bfile.write((char*)&binary_size, sizeof(size_t));
-        bfile.write((char*)binary.data(), binary_size);
+        detail::offline_cache::get_global_cache().store(hash, prog.binary());
     }
 
     // Tries to read program binaries from file cache.
@@ -608,21 +809,14 @@ private:
             const std::string &hash, const context &ctx
             )
     {
-        std::string fname = program_binary_path(hash) + "kernel";
-        std::ifstream bfile(fname.c_str(), std::ios::binary);
-        if (!bfile) return boost::optional<program>();
-
-        size_t binary_size;
         std::vector<unsigned char> binary;
-
-        bfile.read((char*)&binary_size, sizeof(size_t));
-
-        binary.resize(binary_size);
-        bfile.read((char*)binary.data(), binary_size);
+        if(!detail::offline_cache::get_global_cache().load(hash, binary)){
+            return boost::optional<program>();
+        }
 
         return boost::optional<program>(
                 program::create_with_binary(
-                    binary.data(), binary_size, ctx
+                    &binary[0], binary.size(), ctx
                     )
                 );
     }
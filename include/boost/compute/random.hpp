@@ -21,6 +21,8 @@
 #include <boost/compute/random/linear_congruential_engine.hpp>
 #include <boost/compute/random/mersenne_twister_engine.hpp>
 #include <boost/compute/random/normal_distribution.hpp>
+#include <boost/compute/random/philox_engine.hpp>
+#include <boost/compute/random/sobol_engine.hpp>
 #include <boost/compute/random/uniform_int_distribution.hpp>
 #include <boost/compute/random/uniform_real_distribution.hpp>
 
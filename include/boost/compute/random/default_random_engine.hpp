@@ -12,11 +12,17 @@
 #define BOOST_COMPUTE_RANDOM_DEFAULT_RANDOM_ENGINE_HPP
 
 #include <boost/compute/random/mersenne_twister_engine.hpp>
+#include <boost/compute/random/philox_engine.hpp>
 
 namespace boost {
 namespace compute {
 
-typedef mt19937 default_random_engine;
+/// The default random number engine.
+///
+/// The counter-based philox4x32 engine is used as it generates any number
+/// of random values with a single kernel. Use \c mt19937 for the sequence
+/// of the Mersenne twister.
+typedef philox4x32 default_random_engine;
 
 } // end compute namespace
 } // end boost namespace
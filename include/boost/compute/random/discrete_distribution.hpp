@@ -11,13 +11,26 @@
 #ifndef BOOST_COMPUTE_RANDOM_DISCRETE_DISTRIBUTION_HPP
 #define BOOST_COMPUTE_RANDOM_DISCRETE_DISTRIBUTION_HPP
 
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/compute/closure.hpp>
 #include <boost/compute/command_queue.hpp>
-#include <boost/compute/function.hpp>
 #include <boost/compute/algorithm/accumulate.hpp>
 #include <boost/compute/algorithm/copy.hpp>
-#include <boost/compute/algorithm/transform.hpp>
-#include <boost/compute/detail/literal.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/inclusive_scan.hpp>
+#include <boost/compute/container/constant_table.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/constant_memory.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
 #include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
 
 namespace boost {
 namespace compute {
@@ -32,6 +45,12 @@ namespace compute {
 ///
 /// \snippet test/test_discrete_distribution.cpp generate
 ///
+/// The values are sampled with Walker's alias method. Each random number
+/// picks one of \c n columns and chooses between the value of the column
+/// and its alias, so every sample takes constant time independent of
+/// \c n. The probability and alias tables are stored in device buffers
+/// and passed to the kernels as arguments, so distributions with
+/// different weights reuse the same compiled program.
 template<class IntType = uint_>
 class discrete_distribution
 {
@@ -42,20 +61,26 @@ public:
     /// the range [\p first, \p last)
     template<class InputIterator>
     discrete_distribution(InputIterator first, InputIterator last)
-        : m_n(std::distance(first, last)),
-          m_probabilities(std::distance(first, last))
+        : m_n(std::distance(first, last))
     {
-        double sum = 0;
-
-        for(InputIterator iter = first; iter!=last; iter++)
-        {
-            sum += *iter;
-        }
+        build_on_host(first, last);
+    }
 
-        for(size_t i=0; i<m_n; i++)
-        {
-            m_probabilities[i] = m_probabilities[i-1] + first[i]/sum;
-        }
+    /// Creates a new discrete distribution with weights given by the range
+    /// [\p first, \p last) and builds its tables with \p queue.
+    ///
+    /// The range can be on the host or on the device. The tables for
+    /// weights on the device, and for large numbers of weights on the
+    /// host, are built on the device.
+    template<class InputIterator>
+    discrete_distribution(InputIterator first,
+                          InputIterator last,
+                          command_queue &queue)
+        : m_n(::boost::compute::detail::iterator_range_size(first, last)),
+          m_prob(queue.get_context()),
+          m_alias(queue.get_context())
+    {
+        build(first, last, queue, is_device_iterator<InputIterator>());
     }
 
     /// Destroys the discrete_distribution object.
@@ -69,7 +94,8 @@ public:
         return m_n;
     }
 
-    /// Returns the probabilities
+    /// Returns the probability of each value. These are only available
+    /// for distributions created from weights on the host.
     ::std::vector<double> probabilities() const
     {
         return m_probabilities;
@@ -83,35 +109,278 @@ public:
                   Generator &generator,
                   command_queue &queue)
     {
-        std::string source = "inline uint scale_random(uint x)\n";
+        if(!m_host_prob.empty() &&
+           (m_prob.size() != m_n ||
+            m_prob.get_allocator().get_context() != queue.get_context())){
+            m_prob = vector<float_>(m_host_prob.begin(), m_host_prob.end(), queue);
+            m_alias = vector<uint_>(m_host_alias.begin(), m_host_alias.end(), queue);
+        }
+
+        // small tables are read from constant memory
+        if(detail::fits_in_constant_memory(2 * m_n * sizeof(uint_), queue.get_context())){
+            generate(first,
+                     last,
+                     generator,
+                     constant_table<float_>(m_prob.get_buffer(), m_n),
+                     constant_table<uint_>(m_alias.get_buffer(), m_n),
+                     queue);
+        }
+        else {
+            generate(first, last, generator, m_prob, m_alias, queue);
+        }
+    }
 
-        source = source +
-            "{\n" +
-            "float rno = convert_float(x) / UINT_MAX;\n";
-        for(size_t i=0; i<m_n; i++)
+private:
+    template<class OutputIterator, class Generator, class ProbTable, class AliasTable>
+    void generate(OutputIterator first,
+                  OutputIterator last,
+                  Generator &generator,
+                  const ProbTable &prob,
+                  const AliasTable &alias,
+                  command_queue &queue)
+    {
+        const uint_ n = static_cast<uint_>(m_n);
+
+        // the high bits of x * n select the column and the low bits are
+        // the uniform fraction compared with its probability
+        BOOST_COMPUTE_CLOSURE(IntType, scale_random, (const uint_ x), (n, prob, alias),
         {
-            source = source +
-                "if(rno <= " + detail::make_literal<float>(m_probabilities[i]) + ")\n" +
-                "   return " + detail::make_literal(i) + ";\n";
+            const uint column = mul_hi(x, n);
+            const float u = convert_float(x * n) * 2.3283064e-10f;
+            return u < prob[column] ? column : alias[column];
+        });
+
+        generator.generate(first, last, scale_random, queue);
+    }
+
+    template<class InputIterator>
+    void build(InputIterator first,
+               InputIterator last,
+               command_queue &queue,
+               boost::false_type /* host iterator */)
+    {
+        boost::shared_ptr<detail::parameter_cache> parameters =
+            detail::parameter_cache::get_global_cache(queue.get_device());
+
+        const size_t threshold = parameters->get(
+            "__boost_discrete_distribution", "device_build_threshold", 65536
+        );
+
+        if(m_n < threshold){
+            build_on_host(first, last);
+            m_prob = vector<float_>(m_host_prob.begin(), m_host_prob.end(), queue);
+            m_alias = vector<uint_>(m_host_alias.begin(), m_host_alias.end(), queue);
         }
+        else {
+            std::vector<float_> weights(first, last);
+            double sum = 0;
+            for(size_t i = 0; i < m_n; i++){
+                sum += weights[i];
+            }
+            m_probabilities.resize(m_n);
+            for(size_t i = 0; i < m_n; i++){
+                m_probabilities[i] = weights[i] / sum;
+            }
 
-        source = source +
-            "return " + detail::make_literal(m_n - 1) + ";\n" +
-            "}\n";
+            vector<float_> device_weights(weights.begin(), weights.end(), queue);
+            build_on_device(device_weights.begin(), device_weights.end(), queue);
+        }
+    }
 
-        BOOST_COMPUTE_FUNCTION(IntType, scale_random, (const uint_ x), {});
+    template<class InputIterator>
+    void build(InputIterator first,
+               InputIterator last,
+               command_queue &queue,
+               boost::true_type /* device iterator */)
+    {
+        build_on_device(first, last, queue);
+    }
 
-        scale_random.set_source(source);
+    // builds the tables with vose's variant of walker's method
+    template<class InputIterator>
+    void build_on_host(InputIterator first, InputIterator last)
+    {
+        m_probabilities.assign(first, last);
 
-        generator.generate(first, last, scale_random, queue);
+        double sum = 0;
+        for(size_t i = 0; i < m_n; i++){
+            sum += m_probabilities[i];
+        }
+
+        std::vector<double> scaled(m_n);
+        std::vector<uint_> small;
+        std::vector<uint_> large;
+        for(size_t i = 0; i < m_n; i++){
+            m_probabilities[i] /= sum;
+            scaled[i] = m_probabilities[i] * m_n;
+            if(scaled[i] < 1){
+                small.push_back(static_cast<uint_>(i));
+            }
+            else {
+                large.push_back(static_cast<uint_>(i));
+            }
+        }
+
+        m_host_prob.resize(m_n);
+        m_host_alias.resize(m_n);
+        while(!small.empty() && !large.empty()){
+            const uint_ s = small.back();
+            small.pop_back();
+            const uint_ l = large.back();
+
+            m_host_prob[s] = static_cast<float_>(scaled[s]);
+            m_host_alias[s] = l;
+
+            // the large value fills the rest of the column
+            scaled[l] -= 1 - scaled[s];
+            if(scaled[l] < 1){
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+
+        // the remaining columns are (up to rounding) full
+        for(size_t i = 0; i < small.size(); i++){
+            m_host_prob[small[i]] = 1;
+            m_host_alias[small[i]] = small[i];
+        }
+        for(size_t i = 0; i < large.size(); i++){
+            m_host_prob[large[i]] = 1;
+            m_host_alias[large[i]] = large[i];
+        }
+    }
+
+    // builds the tables with the parallel sweep of hubschle-schneider and
+    // sanders. the weights are scaled to an average of one and split into
+    // light (< 1) and heavy (>= 1) values. a light value is aliased to the
+    // first heavy value whose cumulative excess (w - 1) exceeds the
+    // cumulative deficit (1 - w) of the light values before it. a heavy
+    // value keeps what is left of its weight after the light values (and
+    // the heavy value before it) and is aliased to the next heavy value.
+    template<class InputIterator>
+    void build_on_device(InputIterator first,
+                         InputIterator last,
+                         command_queue &queue)
+    {
+        const context &context = queue.get_context();
+
+        m_host_prob.clear();
+        m_host_alias.clear();
+        m_prob.resize_uninitialized(m_n);
+        m_alias.resize_uninitialized(m_n);
+        if(m_n == 0){
+            return;
+        }
+
+        const float_ sum = ::boost::compute::accumulate(first, last, float_(0), queue);
+
+        vector<float_> deficit(m_n, context);
+        vector<float_> excess(m_n, context);
+        vector<uint_> heavy(m_n, context);
+
+        detail::meta_kernel classify_kernel("discrete_distribution_classify");
+        size_t scale_arg = classify_kernel.add_arg<const float_>("scale");
+        classify_kernel <<
+            "const uint i = get_global_id(0);\n" <<
+            "const float w = " << first[classify_kernel.var<uint_>("i")] << " * scale;\n" <<
+            m_prob.begin()[classify_kernel.var<uint_>("i")] << " = w;\n" <<
+            deficit.begin()[classify_kernel.var<uint_>("i")] << " = w < 1 ? 1 - w : 0;\n" <<
+            excess.begin()[classify_kernel.var<uint_>("i")] << " = w < 1 ? 0 : w - 1;\n" <<
+            heavy.begin()[classify_kernel.var<uint_>("i")] << " = w < 1 ? 0 : 1;\n";
+        classify_kernel.set_arg(scale_arg, static_cast<float_>(m_n / sum));
+        classify_kernel.exec_1d(queue, 0, m_n);
+
+        // the cumulative deficits before each value, the cumulative excess
+        // up to each value and the rank of each heavy value
+        vector<float_> deficit_before(m_n, context);
+        vector<float_> excess_through(m_n, context);
+        vector<uint_> heavy_rank(m_n, context);
+        ::boost::compute::exclusive_scan(
+            deficit.begin(), deficit.end(), deficit_before.begin(), queue
+        );
+        ::boost::compute::inclusive_scan(
+            excess.begin(), excess.end(), excess_through.begin(), queue
+        );
+        ::boost::compute::exclusive_scan(
+            heavy.begin(), heavy.end(), heavy_rank.begin(), queue
+        );
+
+        vector<uint_> heavy_index(m_n, context);
+        detail::meta_kernel scatter_kernel("discrete_distribution_scatter");
+        scatter_kernel <<
+            "const uint i = get_global_id(0);\n" <<
+            "if(" << heavy.begin()[scatter_kernel.var<uint_>("i")] << "){\n" <<
+            "    const uint rank = " << heavy_rank.begin()[scatter_kernel.var<uint_>("i")] << ";\n" <<
+            "    " << heavy_index.begin()[scatter_kernel.var<uint_>("rank")] << " = i;\n" <<
+            "}\n";
+        scatter_kernel.exec_1d(queue, 0, m_n);
+
+        detail::meta_kernel alias_kernel("discrete_distribution_alias");
+        size_t count_arg = alias_kernel.add_arg<const uint_>("count");
+        alias_kernel <<
+            "const uint i = get_global_id(0);\n" <<
+            "const uint heavy_count = " <<
+                heavy_rank.begin()[alias_kernel.var<uint_>("count-1")] << " + " <<
+                heavy.begin()[alias_kernel.var<uint_>("count-1")] << ";\n" <<
+            "uint lo = 0;\n" <<
+            "uint hi = count;\n" <<
+            "if(!" << heavy.begin()[alias_kernel.var<uint_>("i")] << "){\n" <<
+            "    const float before = " << deficit_before.begin()[alias_kernel.var<uint_>("i")] << ";\n" <<
+            "    while(lo < hi){\n" <<
+            "        const uint mid = (lo + hi) / 2;\n" <<
+            "        if(" << excess_through.begin()[alias_kernel.var<uint_>("mid")] << " > before){\n" <<
+            "            hi = mid;\n" <<
+            "        }\n" <<
+            "        else {\n" <<
+            "            lo = mid + 1;\n" <<
+            "        }\n" <<
+            "    }\n" <<
+            "    if(lo == count){\n" <<
+            "        lo = heavy_count ? " <<
+                         heavy_index.begin()[alias_kernel.var<uint_>("heavy_count-1")] << " : i;\n" <<
+            "    }\n" <<
+            "    " << m_alias.begin()[alias_kernel.var<uint_>("i")] << " = lo;\n" <<
+            "}\n" <<
+            "else {\n" <<
+            "    const float through = " << excess_through.begin()[alias_kernel.var<uint_>("i")] << ";\n" <<
+            "    while(lo < hi){\n" <<
+            "        const uint mid = (lo + hi) / 2;\n" <<
+            "        if(" << deficit_before.begin()[alias_kernel.var<uint_>("mid")] << " < through){\n" <<
+            "            lo = mid + 1;\n" <<
+            "        }\n" <<
+            "        else {\n" <<
+            "            hi = mid;\n" <<
+            "        }\n" <<
+            "    }\n" <<
+            "    const float served = lo == 0 ? 0 : " <<
+                     deficit_before.begin()[alias_kernel.var<uint_>("lo-1")] << " + " <<
+                     deficit.begin()[alias_kernel.var<uint_>("lo-1")] << ";\n" <<
+            "    const uint rank = " << heavy_rank.begin()[alias_kernel.var<uint_>("i")] << ";\n" <<
+            "    if(rank + 1 < heavy_count){\n" <<
+            "        " << m_prob.begin()[alias_kernel.var<uint_>("i")] << " = " <<
+                         "clamp(1 + through - served, 0.0f, 1.0f);\n" <<
+            "        " << m_alias.begin()[alias_kernel.var<uint_>("i")] << " = " <<
+                         heavy_index.begin()[alias_kernel.var<uint_>("rank+1")] << ";\n" <<
+            "    }\n" <<
+            "    else {\n" <<
+            "        " << m_prob.begin()[alias_kernel.var<uint_>("i")] << " = 1;\n" <<
+            "        " << m_alias.begin()[alias_kernel.var<uint_>("i")] << " = i;\n" <<
+            "    }\n" <<
+            "}\n";
+        alias_kernel.set_arg(count_arg, static_cast<uint_>(m_n));
+        alias_kernel.exec_1d(queue, 0, m_n);
     }
 
 private:
     size_t m_n;
     ::std::vector<double> m_probabilities;
+    ::std::vector<float_> m_host_prob;
+    ::std::vector<uint_> m_host_alias;
+    vector<float_> m_prob;
+    vector<uint_> m_alias;
 };
 
 } // end compute namespace
 } // end boost namespace
 
-#endif // BOOST_COMPUTE_RANDOM_UNIFORM_INT_DISTRIBUTION_HPP
+#endif // BOOST_COMPUTE_RANDOM_DISCRETE_DISTRIBUTION_HPP
@@ -11,6 +11,11 @@
 #ifndef BOOST_COMPUTE_RANDOM_LINEAR_CONGRUENTIAL_ENGINE_HPP
 #define BOOST_COMPUTE_RANDOM_LINEAR_CONGRUENTIAL_ENGINE_HPP
 
+#include <iterator>
+#include <string>
+
+#include <boost/lexical_cast.hpp>
+
 #include <boost/compute/types.hpp>
 #include <boost/compute/buffer.hpp>
 #include <boost/compute/kernel.hpp>
@@ -19,9 +24,11 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/transform.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/functional/identity.hpp>
 #include <boost/compute/iterator/discard_iterator.hpp>
-#include <boost/compute/utility/program_cache.hpp>
+#include <boost/compute/type_traits/make_vector_type.hpp>
 
 namespace boost {
 namespace compute {
@@ -42,29 +49,18 @@ public:
     typedef T result_type;
     static const T default_seed = 1;
     static const T a = 1099087573;
-    static const size_t threads = 1024;
 
     /// Creates a new linear_congruential_engine and seeds it with \p value.
     explicit linear_congruential_engine(command_queue &queue,
                                         result_type value = default_seed)
-        : m_context(queue.get_context()),
-          m_multiplicands(m_context, threads * sizeof(result_type))
     {
-        // setup program
-        load_program();
-
         // seed state
         seed(value, queue);
-
-        // generate multiplicands
-        generate_multiplicands(queue);
     }
 
     /// Creates a new linear_congruential_engine object as a copy of \p other.
     linear_congruential_engine(const linear_congruential_engine<T> &other)
-        : m_context(other.m_context),
-          m_seed(other.m_seed),
-          m_multiplicands(other.m_multiplicands)
+        : m_seed(other.m_seed)
     {
     }
 
@@ -73,7 +69,7 @@ public:
     operator=(const linear_congruential_engine<T> &other)
     {
         if(this != &other){
-            m_context = other.m_context;
+            m_seed = other.m_seed;
         }
 
         return *this;
@@ -100,41 +96,14 @@ public:
     /// \overload
     void seed(command_queue &queue)
     {
-        seed(default_seed);
+        seed(default_seed, queue);
     }
 
     /// Generates random numbers and stores them to the range [\p first, \p last).
     template<class OutputIterator>
     void generate(OutputIterator first, OutputIterator last, command_queue &queue)
     {
-        size_t size = detail::iterator_range_size(first, last);
-
-        kernel fill_kernel(m_program, "fill");
-        fill_kernel.set_arg(1, m_multiplicands);
-        fill_kernel.set_arg(2, first.get_buffer());
-
-        size_t offset = 0;
-
-        for(;;){
-            size_t count = 0;
-            if(size > threads){
-                count = threads;
-            }
-            else {
-                count = size;
-            }
-            fill_kernel.set_arg(0, static_cast<const uint_>(m_seed));
-            fill_kernel.set_arg(3, static_cast<const uint_>(offset));
-            queue.enqueue_1d_range_kernel(fill_kernel, 0, count, 0);
-
-            offset += count;
-
-            if(offset >= size){
-                break;
-            }
-
-            update_seed(queue);
-        }
+        generate(first, last, ::boost::compute::identity<T>(), queue);
     }
 
     /// \internal_
@@ -142,25 +111,37 @@ public:
     {
         (void) queue;
 
-        size_t size = detail::iterator_range_size(first, last);
-        uint_ max_mult =
-            detail::read_single_value<T>(m_multiplicands, threads-1, queue);
-        while(size >= threads) {
-            m_seed *= max_mult;
-            size -= threads;
-        }
-        m_seed *=
-            detail::read_single_value<T>(m_multiplicands, size-1, queue);
+        m_seed *= power(a, detail::iterator_range_size(first, last));
     }
 
     /// Generates random numbers, transforms them with \p op, and then stores
     /// them to the range [\p first, \p last).
+    ///
+    /// The random numbers are passed to \p op in the same kernel, so they
+    /// are never stored in memory.
     template<class OutputIterator, class Function>
     void generate(OutputIterator first, OutputIterator last, Function op, command_queue &queue)
     {
-        vector<T> tmp(std::distance(first, last), queue.get_context());
-        generate(tmp.begin(), tmp.end(), queue);
-        transform(tmp.begin(), tmp.end(), first, op, queue);
+        const size_t size = detail::iterator_range_size(first, last);
+        if(size == 0){
+            return;
+        }
+
+        // the i-th number is seed * a^(i+1)
+        detail::meta_kernel k("linear_congruential_generate");
+        add_power_function(k);
+        size_t seed_arg = k.add_arg<const uint_>("seed");
+
+        k <<
+            "const uint i = get_global_id(0);\n" <<
+            "const uint x = seed * boost_lcg_power(" << uint_(a) << "u, i + 1);\n" <<
+            first[k.var<uint_>("i")] << " = " << op(k.var<const T>("x")) << ";\n";
+
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(seed_arg, static_cast<uint_>(m_seed));
+        queue.enqueue_1d_range_kernel(kernel, 0, size, 0);
+
+        m_seed *= power(a, size);
     }
 
     /// Generates \p z random numbers and discards them.
@@ -169,61 +150,187 @@ public:
         generate(discard_iterator(0), discard_iterator(z), queue);
     }
 
-private:
-    /// \internal_
-    /// Generates the multiplicands for each thread
-    void generate_multiplicands(command_queue &queue)
+    /// Stores the states of independent streams of random numbers (e.g.
+    /// one for each work-item of a kernel) to the range [\p first,
+    /// \p last).
+    ///
+    /// Stream \c i starts at the <tt>(i * stride)</tt>-th number after the
+    /// current position of the engine, so streams which draw at most
+    /// \p stride numbers never overlap. The engine is advanced past all of
+    /// the streams. The numbers of a stream are then drawn inside of a
+    /// kernel with the \c boost_lcg_next() function of stream_source():
+    /// \code
+    /// __kernel void simulate(__global uint *states, __global float *results)
+    /// {
+    ///     uint state = states[get_global_id(0)];
+    ///     float sum = 0;
+    ///     for(uint i = 0; i < 1000; i++){
+    ///         sum += boost_lcg_next(&state) / (float) UINT_MAX;
+    ///     }
+    ///     results[get_global_id(0)] = sum;
+    ///     states[get_global_id(0)] = state;
+    /// }
+    /// \endcode
+    template<class OutputIterator>
+    void generate_streams(OutputIterator first,
+                          OutputIterator last,
+                          size_t stride,
+                          command_queue &queue)
     {
-        kernel multiplicand_kernel =
-            m_program.create_kernel("multiplicand");
-        multiplicand_kernel.set_arg(0, m_multiplicands);
+        const size_t size = detail::iterator_range_size(first, last);
+        if(size == 0){
+            return;
+        }
+
+        // the state of stream i is seed * (a^stride)^i
+        detail::meta_kernel k("linear_congruential_generate_streams");
+        add_power_function(k);
+        size_t seed_arg = k.add_arg<const uint_>("seed");
+        size_t multiplier_arg = k.add_arg<const uint_>("multiplier");
+
+        k <<
+            "const uint i = get_global_id(0);\n" <<
+            first[k.var<uint_>("i")] << " = seed * boost_lcg_power(multiplier, i);\n";
 
-        queue.enqueue_task(multiplicand_kernel);
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(seed_arg, static_cast<uint_>(m_seed));
+        kernel.set_arg(multiplier_arg, static_cast<uint_>(power(a, stride)));
+        queue.enqueue_1d_range_kernel(kernel, 0, size, 0);
+
+        m_seed *= power(power(a, stride), size);
+    }
+
+    /// Returns the OpenCL source of the functions for the streams of
+    /// generate_streams():
+    ///
+    /// \li <tt>uint boost_lcg_next(uint *state)</tt> advances the state and
+    /// returns the next random number of the stream.
+    /// \li <tt>void boost_lcg_discard(uint *state, uint n)</tt> skips the
+    /// next \p n random numbers of the stream.
+    ///
+    /// The source can be added to the source of program or of a function
+    /// calling the functions (e.g. with \c set_source()). It is guarded, so
+    /// it can be included more than once in the same program.
+    static std::string stream_source()
+    {
+        return
+            "#ifndef BOOST_COMPUTE_LCG_STREAM\n"
+            "#define BOOST_COMPUTE_LCG_STREAM\n"
+            "inline uint boost_lcg_next(uint *state)\n"
+            "{\n"
+            "    *state *= " + boost::lexical_cast<std::string>(uint_(a)) + "u;\n"
+            "    return *state;\n"
+            "}\n"
+            "inline void boost_lcg_discard(uint *state, uint n)\n"
+            "{\n"
+            "    uint x = " + boost::lexical_cast<std::string>(uint_(a)) + "u;\n"
+            "    while(n){\n"
+            "        if(n & 1){\n"
+            "            *state *= x;\n"
+            "        }\n"
+            "        x *= x;\n"
+            "        n >>= 1;\n"
+            "    }\n"
+            "}\n"
+            "#endif\n";
     }
 
     /// \internal_
-    void update_seed(command_queue &queue)
+    ///
+    /// Generates pairs of consecutive random numbers, transforms each of
+    /// them with \p op (which returns a two-component vector) and stores
+    /// the components of the results to the range [\p first, \p last).
+    template<class OutputIterator, class Function>
+    void generate_pairs(OutputIterator first,
+                        OutputIterator last,
+                        Function op,
+                        command_queue &queue)
     {
-        m_seed *=
-            detail::read_single_value<T>(m_multiplicands, threads-1, queue);
+        typedef typename std::iterator_traits<OutputIterator>::value_type value_type;
+        typedef typename make_vector_type<value_type, 2>::type value_type2;
+
+        const size_t size = detail::iterator_range_size(first, last);
+        if(size == 0){
+            return;
+        }
+        const size_t pairs = (size + 1) / 2;
+
+        detail::meta_kernel k("linear_congruential_generate_pairs");
+        add_power_function(k);
+        size_t seed_arg = k.add_arg<const uint_>("seed");
+        size_t size_arg = k.add_arg<const uint_>("size");
+
+        k <<
+            "const uint i = get_global_id(0) * 2;\n" <<
+            "const uint x0 = seed * boost_lcg_power(" << uint_(a) << "u, i + 1);\n" <<
+            "const uint2 x = (uint2)(x0, x0 * " << uint_(a) << "u);\n" <<
+            k.decl<const value_type2>("z") << " = " << op(k.var<const uint2_>("x")) << ";\n" <<
+            first[k.var<uint_>("i")] << " = z.x;\n" <<
+            "if(i + 1 < size){\n" <<
+            "    " << first[k.var<uint_>("i + 1")] << " = z.y;\n" <<
+            "}\n";
+
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(seed_arg, static_cast<uint_>(m_seed));
+        kernel.set_arg(size_arg, static_cast<uint_>(size));
+        queue.enqueue_1d_range_kernel(kernel, 0, pairs, 0);
+
+        m_seed *= power(a, 2 * pairs);
     }
 
     /// \internal_
-    void load_program()
+    ///
+    /// Writes an expression for the random number \p index (an expression
+    /// of the kernel) numbers after the current position of the engine.
+    /// Used by algorithms drawing random numbers inside of their own
+    /// kernels, which then discard() the numbers drawn.
+    void random_number(detail::meta_kernel &k, const std::string &index) const
     {
-        boost::shared_ptr<program_cache> cache =
-            program_cache::get_global_cache(m_context);
+        add_power_function(k);
 
-        std::string cache_key =
-            std::string("__boost_linear_congruential_engine_") + type_name<T>();
+        k << "(";
+        k.insert_capture(static_cast<uint_>(m_seed));
+        k << " * boost_lcg_power(" << uint_(a) << "u, (" << index << ") + 1))";
+    }
 
-        const char source[] =
-            "__kernel void multiplicand(__global uint *multiplicands)\n"
+private:
+    /// \internal_
+    /// Returns x^n (modulo 2^32).
+    static T power(T x, size_t n)
+    {
+        T result = 1;
+        while(n){
+            if(n & 1){
+                result *= x;
+            }
+            x *= x;
+            n >>= 1;
+        }
+        return result;
+    }
+
+    /// \internal_
+    static void add_power_function(detail::meta_kernel &k)
+    {
+        k.add_function(
+            "boost_lcg_power",
+            "inline uint boost_lcg_power(uint x, uint n)\n"
             "{\n"
-            "    uint a = 1099087573;\n"
-            "    multiplicands[0] = a;\n"
-            "    for(uint i = 1; i < 1024; i++){\n"
-            "        multiplicands[i] = a * multiplicands[i-1];\n"
+            "    uint result = 1;\n"
+            "    while(n){\n"
+            "        if(n & 1){\n"
+            "            result *= x;\n"
+            "        }\n"
+            "        x *= x;\n"
+            "        n >>= 1;\n"
             "    }\n"
+            "    return result;\n"
             "}\n"
-
-            "__kernel void fill(const uint seed,\n"
-            "                   __global uint *multiplicands,\n"
-            "                   __global uint *result,"
-            "                   const uint offset)\n"
-            "{\n"
-            "    const uint i = get_global_id(0);\n"
-            "    result[offset+i] = seed * multiplicands[i];\n"
-            "}\n";
-
-        m_program = cache->get_or_build(cache_key, std::string(), source, m_context);
+        );
     }
 
 private:
-    context m_context;
-    program m_program;
     T m_seed;
-    buffer m_multiplicands;
 };
 
 } // end compute namespace
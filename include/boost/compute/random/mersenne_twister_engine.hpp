@@ -20,6 +20,7 @@
 #include <boost/compute/algorithm/transform.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/kernel_cache.hpp>
 #include <boost/compute/iterator/discard_iterator.hpp>
 #include <boost/compute/utility/program_cache.hpp>
 
@@ -80,7 +81,7 @@ public:
     /// If no seed value is provided, \c default_seed is used.
     void seed(result_type value, command_queue &queue)
     {
-        kernel seed_kernel = m_program.create_kernel("seed");
+        kernel seed_kernel = detail::get_cached_kernel(m_program, "seed");
         seed_kernel.set_arg(0, value);
         seed_kernel.set_arg(1, m_state_buffer);
 
@@ -101,7 +102,7 @@ public:
     {
         const size_t size = detail::iterator_range_size(first, last);
 
-        kernel fill_kernel(m_program, "fill");
+        kernel fill_kernel = detail::get_cached_kernel(m_program, "fill");
         fill_kernel.set_arg(0, m_state_buffer);
         fill_kernel.set_arg(2, first.get_buffer());
 
@@ -168,7 +169,7 @@ private:
     void generate_state(command_queue &queue)
     {
         kernel generate_state_kernel =
-            m_program.create_kernel("generate_state");
+            detail::get_cached_kernel(m_program, "generate_state");
         generate_state_kernel.set_arg(0, m_state_buffer);
         queue.enqueue_task(generate_state_kernel);
     }
@@ -12,11 +12,19 @@
 #define BOOST_COMPUTE_RANDOM_NORMAL_DISTRIBUTION_HPP
 
 #include <limits>
+#include <string>
+
+#include <boost/lexical_cast.hpp>
 
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/function.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/random/linear_congruential_engine.hpp>
+#include <boost/compute/random/philox_engine.hpp>
 #include <boost/compute/types/fundamental.hpp>
 #include <boost/compute/type_traits/make_vector_type.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
 
 namespace boost {
 namespace compute {
@@ -81,20 +89,60 @@ public:
                   Generator &generator,
                   command_queue &queue)
     {
-        typedef typename make_vector_type<RealType, 2>::type RealType2;
-
         size_t count = detail::iterator_range_size(first, last);
 
         vector<uint_> tmp(count, queue.get_context());
         generator.generate(tmp.begin(), tmp.end(), queue);
 
+        transform(
+            make_buffer_iterator<uint2_>(tmp.get_buffer(), 0),
+            make_buffer_iterator<uint2_>(tmp.get_buffer(), count / 2),
+            make_buffer_iterator<RealType2>(first.get_buffer(), 0),
+            box_muller(),
+            queue
+        );
+    }
+
+    /// \internal_
+    ///
+    /// The random numbers of the philox engine are transformed in the
+    /// kernel which generates them.
+    template<class OutputIterator, class T>
+    void generate(OutputIterator first,
+                  OutputIterator last,
+                  philox_engine<T> &generator,
+                  command_queue &queue)
+    {
+        generator.generate_pairs(first, last, box_muller(), queue);
+    }
+
+    /// \internal_
+    template<class OutputIterator, class T>
+    void generate(OutputIterator first,
+                  OutputIterator last,
+                  linear_congruential_engine<T> &generator,
+                  command_queue &queue)
+    {
+        generator.generate_pairs(first, last, box_muller(), queue);
+    }
+
+private:
+    typedef typename make_vector_type<RealType, 2>::type RealType2;
+
+    /// \internal_
+    /// Returns the Box-Muller transform of a pair of random numbers to
+    /// a pair of normally-distributed numbers.
+    function<RealType2(uint2_)> box_muller() const
+    {
         BOOST_COMPUTE_FUNCTION(RealType2, box_muller, (const uint2_ x),
         {
-            const RealType x1 = x.x / (RealType) (UINT_MAX - 1);
-            const RealType x2 = x.y / (RealType) (UINT_MAX - 1);
+            // x1 is in (0, 1] so that its logarithm is finite
+            const RealType x1 = ((RealType) x.x + 1) / ((RealType) UINT_MAX + 1);
+            const RealType x2 = x.y / ((RealType) UINT_MAX + 1);
 
-            const RealType z1 = sqrt(-2.f * log2(x1)) * cos(2.f * M_PI_F * x2);
-            const RealType z2 = sqrt(-2.f * log2(x1)) * sin(2.f * M_PI_F * x2);
+            const RealType r = sqrt(-2 * log(x1));
+            const RealType z1 = r * cos(2 * M_PI_F * x2);
+            const RealType z2 = r * sin(2 * M_PI_F * x2);
 
             return (RealType2)(MEAN, MEAN) + (RealType2)(z1, z2) * (RealType2)(STDDEV, STDDEV);
         });
@@ -104,13 +152,7 @@ public:
         box_muller.define("RealType", type_name<RealType>());
         box_muller.define("RealType2", type_name<RealType2>());
 
-        transform(
-            make_buffer_iterator<uint2_>(tmp.get_buffer(), 0),
-            make_buffer_iterator<uint2_>(tmp.get_buffer(), count / 2),
-            make_buffer_iterator<RealType2>(first.get_buffer(), 0),
-            box_muller,
-            queue
-        );
+        return box_muller;
     }
 
 private:
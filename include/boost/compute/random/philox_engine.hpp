@@ -0,0 +1,394 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_RANDOM_PHILOX_ENGINE_HPP
+#define BOOST_COMPUTE_RANDOM_PHILOX_ENGINE_HPP
+
+#include <iterator>
+#include <string>
+
+#include <boost/lexical_cast.hpp>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/functional/identity.hpp>
+#include <boost/compute/iterator/discard_iterator.hpp>
+#include <boost/compute/type_traits/make_vector_type.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// source of the philox4x32-10 bijection over 4x32-bit counters. it is
+// guarded as it is also part of philox_engine::stream_source()
+inline const char* philox4x32_10_source()
+{
+    return
+        "#ifndef BOOST_COMPUTE_PHILOX4X32_10\n"
+        "#define BOOST_COMPUTE_PHILOX4X32_10\n"
+        "inline uint4 boost_philox4x32_10(uint4 ctr, uint2 key)\n"
+        "{\n"
+        "    for(uint r = 0; r < 10; r++){\n"
+        "        if(r > 0){\n"
+        "            key.x += 0x9E3779B9;\n"
+        "            key.y += 0xBB67AE85;\n"
+        "        }\n"
+        "        const uint hi0 = mul_hi(0xD2511F53u, ctr.x);\n"
+        "        const uint lo0 = 0xD2511F53u * ctr.x;\n"
+        "        const uint hi1 = mul_hi(0xCD9E8D57u, ctr.z);\n"
+        "        const uint lo1 = 0xCD9E8D57u * ctr.z;\n"
+        "        ctr = (uint4)(hi1 ^ ctr.y ^ key.x, lo1, hi0 ^ ctr.w ^ key.y, lo0);\n"
+        "    }\n"
+        "    return ctr;\n"
+        "}\n"
+        "#endif\n";
+}
+
+} // end detail namespace
+
+/// \class philox_engine
+/// \brief Counter-based Philox4x32-10 random number generator.
+///
+/// The philox engine computes the n-th random number directly from n and
+/// the seed (the key) with the Philox4x32-10 bijection of Salmon et al.
+/// ("Parallel Random Numbers: As Easy as 1, 2, 3"), which produces four
+/// random numbers for each counter value. No state is stored on the
+/// device, any range of random numbers is generated with a single kernel
+/// where each work-item computes four values independently and discard()
+/// only advances the counter.
+///
+/// \see default_random_engine, mersenne_twister_engine
+template<class T = uint_>
+class philox_engine
+{
+public:
+    typedef T result_type;
+    static const T default_seed = 0;
+
+    /// Creates a new philox_engine and seeds it with \p value.
+    explicit philox_engine(command_queue &queue,
+                           result_type value = default_seed)
+    {
+        seed(value, queue);
+    }
+
+    /// Creates a new philox_engine object as a copy of \p other.
+    philox_engine(const philox_engine<T> &other)
+        : m_key(other.m_key),
+          m_offset(other.m_offset),
+          m_streams(other.m_streams)
+    {
+    }
+
+    /// Copies \p other to \c *this.
+    philox_engine<T>& operator=(const philox_engine<T> &other)
+    {
+        if(this != &other){
+            m_key = other.m_key;
+            m_offset = other.m_offset;
+            m_streams = other.m_streams;
+        }
+
+        return *this;
+    }
+
+    /// Destroys the philox_engine object.
+    ~philox_engine()
+    {
+    }
+
+    /// Seeds the random number generator with \p value.
+    ///
+    /// \param value seed value for the random-number generator
+    /// \param queue command queue to perform the operation
+    ///
+    /// If no seed value is provided, \c default_seed is used.
+    void seed(result_type value, command_queue &queue)
+    {
+        (void) queue;
+
+        m_key = value;
+        m_offset = 0;
+        m_streams = 0;
+    }
+
+    /// \overload
+    void seed(command_queue &queue)
+    {
+        seed(default_seed, queue);
+    }
+
+    /// Generates random numbers and stores them to the range [\p first, \p last).
+    template<class OutputIterator>
+    void generate(OutputIterator first, OutputIterator last, command_queue &queue)
+    {
+        generate(first, last, ::boost::compute::identity<T>(), queue);
+    }
+
+    /// \internal_
+    void generate(discard_iterator first, discard_iterator last, command_queue &queue)
+    {
+        (void) queue;
+
+        m_offset += detail::iterator_range_size(first, last);
+    }
+
+    /// Generates random numbers, transforms them with \p op, and then stores
+    /// them to the range [\p first, \p last).
+    ///
+    /// The random numbers are passed to \p op in the same kernel, so they
+    /// are never stored in memory.
+    template<class OutputIterator, class Function>
+    void generate(OutputIterator first, OutputIterator last, Function op, command_queue &queue)
+    {
+        const size_t size = detail::iterator_range_size(first, last);
+        if(size == 0){
+            return;
+        }
+
+        // the first value is component (offset % 4) of counter (offset / 4)
+        const uint_ skip = static_cast<uint_>(m_offset % 4);
+
+        detail::meta_kernel k("philox_generate");
+        k.add_function("boost_philox4x32_10", detail::philox4x32_10_source());
+        size_t counter_arg = k.add_arg<const ulong_>("counter");
+        size_t key_arg = k.add_arg<const uint_>("key");
+        size_t skip_arg = k.add_arg<const uint_>("skip");
+        size_t size_arg = k.add_arg<const uint_>("size");
+
+        k <<
+            "const ulong c = counter + get_global_id(0);\n" <<
+            "const uint4 r = boost_philox4x32_10(\n" <<
+            "    (uint4)((uint) c, (uint)(c >> 32), 0, 0), (uint2)(key, 0)\n" <<
+            ");\n" <<
+            "const uint base = get_global_id(0) * 4;\n";
+
+        const char *components[] = { "r.x", "r.y", "r.z", "r.w" };
+        for(uint_ j = 0; j < 4; j++){
+            k <<
+            "if(base + " << j << " >= skip && base + " << j << " - skip < size){\n" <<
+            "    " << first[k.expr<uint_>("base + " + boost::lexical_cast<std::string>(j) + " - skip")] <<
+                " = " << op(k.var<const T>(components[j])) << ";\n" <<
+            "}\n";
+        }
+
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(counter_arg, static_cast<ulong_>(m_offset / 4));
+        kernel.set_arg(key_arg, static_cast<uint_>(m_key));
+        kernel.set_arg(skip_arg, skip);
+        kernel.set_arg(size_arg, static_cast<uint_>(size));
+
+        const size_t counters = (size + skip + 3) / 4;
+        queue.enqueue_1d_range_kernel(kernel, 0, counters, 0);
+
+        m_offset += size;
+    }
+
+    /// Generates \p z random numbers and discards them.
+    ///
+    /// This only advances the counter of the engine and takes constant
+    /// time.
+    void discard(size_t z, command_queue &queue)
+    {
+        generate(discard_iterator(0), discard_iterator(z), queue);
+    }
+
+    /// Stores the states of independent streams of random numbers (e.g.
+    /// one for each work-item of a kernel) to the range [\p first,
+    /// \p last) of \c uint4_ values.
+    ///
+    /// Each stream has its own third counter word (the engine itself uses
+    /// zero), so the streams never overlap each other, the numbers of
+    /// generate() or the streams of later calls. A state holds the lower
+    /// and upper words of the position in the stream, the stream number and
+    /// the key. The numbers of a stream are drawn inside of a kernel with
+    /// the \c boost_philox4x32_next() function of stream_source():
+    /// \code
+    /// __kernel void simulate(__global uint4 *states, __global float *results)
+    /// {
+    ///     uint4 state = states[get_global_id(0)];
+    ///     float sum = 0;
+    ///     for(uint i = 0; i < 250; i++){
+    ///         const float4 r = convert_float4(boost_philox4x32_next(&state));
+    ///         sum += (r.x + r.y + r.z + r.w) / (float) UINT_MAX;
+    ///     }
+    ///     results[get_global_id(0)] = sum;
+    ///     states[get_global_id(0)] = state;
+    /// }
+    /// \endcode
+    template<class OutputIterator>
+    void generate_streams(OutputIterator first,
+                          OutputIterator last,
+                          command_queue &queue)
+    {
+        const size_t size = detail::iterator_range_size(first, last);
+        if(size == 0){
+            return;
+        }
+
+        detail::meta_kernel k("philox_generate_streams");
+        size_t stream_arg = k.add_arg<const uint_>("stream");
+        size_t key_arg = k.add_arg<const uint_>("key");
+
+        k <<
+            "const uint i = get_global_id(0);\n" <<
+            first[k.var<uint_>("i")] << " = (uint4)(0, 0, stream + i, key);\n";
+
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(stream_arg, static_cast<uint_>(m_streams + 1));
+        kernel.set_arg(key_arg, static_cast<uint_>(m_key));
+        queue.enqueue_1d_range_kernel(kernel, 0, size, 0);
+
+        m_streams += static_cast<uint_>(size);
+    }
+
+    /// Returns the OpenCL source of the functions for the streams of
+    /// generate_streams():
+    ///
+    /// \li <tt>uint4 boost_philox4x32_next(uint4 *state)</tt> advances the
+    /// state and returns the next four random numbers of the stream.
+    /// \li <tt>void boost_philox4x32_discard(uint4 *state, ulong n)</tt>
+    /// skips the next \p n groups of four random numbers of the stream.
+    ///
+    /// The source can be added to the source of program or of a function
+    /// calling the functions (e.g. with \c set_source()). It is guarded, so
+    /// it can be included more than once in the same program.
+    static std::string stream_source()
+    {
+        return std::string(detail::philox4x32_10_source()) +
+            "#ifndef BOOST_COMPUTE_PHILOX4X32_STREAM\n"
+            "#define BOOST_COMPUTE_PHILOX4X32_STREAM\n"
+            "inline void boost_philox4x32_discard(uint4 *state, ulong n)\n"
+            "{\n"
+            "    const ulong position = ((ulong) (*state).y << 32 | (*state).x) + n;\n"
+            "    (*state).x = (uint) position;\n"
+            "    (*state).y = (uint) (position >> 32);\n"
+            "}\n"
+            "inline uint4 boost_philox4x32_next(uint4 *state)\n"
+            "{\n"
+            "    const uint4 r = boost_philox4x32_10(\n"
+            "        (uint4)((*state).x, (*state).y, (*state).z, 0), (uint2)((*state).w, 0)\n"
+            "    );\n"
+            "    boost_philox4x32_discard(state, 1);\n"
+            "    return r;\n"
+            "}\n"
+            "#endif\n";
+    }
+
+    /// \internal_
+    ///
+    /// Generates pairs of random numbers, transforms each of them with
+    /// \p op (which returns a two-component vector) and stores the
+    /// components of the results to the range [\p first, \p last).
+    ///
+    /// Each work-item transforms the two pairs of one counter value. The
+    /// counter is first advanced to the next counter value.
+    template<class OutputIterator, class Function>
+    void generate_pairs(OutputIterator first,
+                        OutputIterator last,
+                        Function op,
+                        command_queue &queue)
+    {
+        typedef typename std::iterator_traits<OutputIterator>::value_type value_type;
+        typedef typename make_vector_type<value_type, 2>::type value_type2;
+
+        const size_t size = detail::iterator_range_size(first, last);
+        if(size == 0){
+            return;
+        }
+
+        detail::meta_kernel k("philox_generate_pairs");
+        k.add_function("boost_philox4x32_10", detail::philox4x32_10_source());
+        size_t counter_arg = k.add_arg<const ulong_>("counter");
+        size_t key_arg = k.add_arg<const uint_>("key");
+        size_t size_arg = k.add_arg<const uint_>("size");
+
+        k <<
+            "const ulong c = counter + get_global_id(0);\n" <<
+            "const uint4 r = boost_philox4x32_10(\n" <<
+            "    (uint4)((uint) c, (uint)(c >> 32), 0, 0), (uint2)(key, 0)\n" <<
+            ");\n" <<
+            "const uint base = get_global_id(0) * 4;\n" <<
+            k.decl<const value_type2>("z0") << " = " << op(k.var<const uint2_>("r.xy")) << ";\n" <<
+            k.decl<const value_type2>("z1") << " = " << op(k.var<const uint2_>("r.zw")) << ";\n";
+
+        const char *components[] = { "z0.x", "z0.y", "z1.x", "z1.y" };
+        for(uint_ j = 0; j < 4; j++){
+            k <<
+            "if(base + " << j << " < size){\n" <<
+            "    " << first[k.expr<uint_>("base + " + boost::lexical_cast<std::string>(j))] <<
+                " = " << components[j] << ";\n" <<
+            "}\n";
+        }
+
+        const ulong_ counter = (m_offset + 3) / 4;
+
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(counter_arg, counter);
+        kernel.set_arg(key_arg, static_cast<uint_>(m_key));
+        kernel.set_arg(size_arg, static_cast<uint_>(size));
+
+        const size_t counters = (size + 3) / 4;
+        queue.enqueue_1d_range_kernel(kernel, 0, counters, 0);
+
+        m_offset = (counter + counters) * 4;
+    }
+
+    /// \internal_
+    ///
+    /// Writes an expression for the random number \p index (an expression
+    /// of the kernel) numbers after the current position of the engine.
+    /// Used by algorithms drawing random numbers inside of their own
+    /// kernels, which then discard() the numbers drawn.
+    void random_number(detail::meta_kernel &k, const std::string &index) const
+    {
+        k.add_function("boost_philox4x32_10", detail::philox4x32_10_source());
+        k.add_function(
+            "boost_philox4x32_at",
+            "inline uint boost_philox4x32_at(ulong n, uint key)\n"
+            "{\n"
+            "    const ulong c = n / 4;\n"
+            "    const uint4 r = boost_philox4x32_10(\n"
+            "        (uint4)((uint) c, (uint)(c >> 32), 0, 0), (uint2)(key, 0)\n"
+            "    );\n"
+            "    const uint j = n % 4;\n"
+            "    return j == 0 ? r.x : j == 1 ? r.y : j == 2 ? r.z : r.w;\n"
+            "}\n"
+        );
+
+        k << "boost_philox4x32_at(";
+        k.insert_capture(m_offset);
+        k << " + (" << index << "), ";
+        k.insert_capture(static_cast<uint_>(m_key));
+        k << ")";
+    }
+
+    /// \internal_ (deprecated)
+    template<class OutputIterator>
+    void fill(OutputIterator first, OutputIterator last, command_queue &queue)
+    {
+        generate(first, last, queue);
+    }
+
+private:
+    T m_key;
+    ulong_ m_offset;
+    uint_ m_streams;
+};
+
+typedef philox_engine<uint_> philox4x32;
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_RANDOM_PHILOX_ENGINE_HPP
@@ -0,0 +1,300 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_RANDOM_SOBOL_ENGINE_HPP
+#define BOOST_COMPUTE_RANDOM_SOBOL_ENGINE_HPP
+
+#include <iterator>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/functional/identity.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// computes the 32 direction numbers of each of the first dimensions of the
+// sobol sequence. the first dimension is the van der corput sequence and
+// the others use the primitive polynomials and initial direction numbers
+// of joe and kuo (new-joe-kuo-6.21201).
+inline std::vector<uint_> sobol_direction_numbers(size_t dimensions)
+{
+    // degree s, coefficients a and initial direction numbers m of the
+    // dimensions after the first
+    static const uint_ polynomials[][9] = {
+        { 1,  0, 1 },
+        { 2,  1, 1, 3 },
+        { 3,  1, 1, 3, 1 },
+        { 3,  2, 1, 1, 1 },
+        { 4,  1, 1, 1, 3, 3 },
+        { 4,  4, 1, 3, 5, 13 },
+        { 5,  2, 1, 1, 5, 5, 17 },
+        { 5,  4, 1, 1, 5, 5, 5 },
+        { 5,  7, 1, 1, 7, 11, 19 },
+        { 5, 11, 1, 1, 5, 1, 1 },
+        { 5, 13, 1, 1, 1, 3, 11 },
+        { 5, 14, 1, 3, 5, 5, 31 },
+        { 6,  1, 1, 3, 3, 9, 7, 49 },
+        { 6, 13, 1, 1, 1, 15, 21, 21 },
+        { 6, 16, 1, 3, 1, 13, 27, 49 },
+        { 6, 19, 1, 1, 1, 15, 7, 5 },
+        { 6, 22, 1, 3, 1, 15, 13, 25 },
+        { 6, 25, 1, 1, 5, 5, 19, 61 },
+        { 7,  1, 1, 3, 7, 11, 23, 15, 103 },
+        { 7,  4, 1, 3, 7, 13, 13, 15, 69 }
+    };
+
+    BOOST_ASSERT(dimensions <= 1 + sizeof(polynomials) / sizeof(polynomials[0]));
+
+    std::vector<uint_> directions(dimensions * 32);
+    for(uint_ k = 0; k < 32 && dimensions > 0; k++){
+        directions[k] = uint_(1) << (31 - k);
+    }
+
+    for(size_t d = 1; d < dimensions; d++){
+        const uint_ *polynomial = polynomials[d - 1];
+        const uint_ s = polynomial[0];
+        const uint_ a = polynomial[1];
+        uint_ *v = &directions[d * 32];
+
+        for(uint_ k = 0; k < s; k++){
+            v[k] = polynomial[2 + k] << (31 - k);
+        }
+        for(uint_ k = s; k < 32; k++){
+            v[k] = v[k - s] ^ (v[k - s] >> s);
+            for(uint_ i = 1; i < s; i++){
+                if((a >> (s - 1 - i)) & 1){
+                    v[k] ^= v[k - i];
+                }
+            }
+        }
+    }
+
+    return directions;
+}
+
+} // end detail namespace
+
+/// \class sobol_engine
+/// \brief Quasi-random Sobol sequence generator.
+///
+/// The sobol engine generates the points of the Sobol low-discrepancy
+/// sequence in the unit hypercube of \c dimensions() dimensions, each
+/// coordinate as a 32-bit fixed-point fraction. Monte Carlo integrals
+/// over these points converge close to O(1/n) instead of the O(1/sqrt(n))
+/// of pseudo-random numbers.
+///
+/// The points are produced in gray code order: point \c n is the XOR of
+/// the direction numbers selected by the bits of the gray code of \c n,
+/// and each following point differs from the previous one by a single
+/// direction number. Each work-item computes the first point of its block
+/// of points directly and the rest with one XOR per point, so any range
+/// of points is generated with a single kernel. The direction numbers are
+/// stored in a buffer.
+///
+/// For example, to estimate pi from the points of a two-dimensional
+/// sequence:
+/// \code
+/// sobol_engine engine(queue, 2);
+/// vector<float2_> points(count, context);
+/// uniform_real_distribution<float> distribution;
+/// distribution.generate(
+///     make_buffer_iterator<float>(points.get_buffer(), 0),
+///     make_buffer_iterator<float>(points.get_buffer(), count * 2),
+///     engine,
+///     queue
+/// );
+/// // transform_reduce(points.begin(), points.end(), ...)
+/// \endcode
+///
+/// \see philox_engine
+class sobol_engine
+{
+public:
+    typedef uint_ result_type;
+
+    /// The number of dimensions with built-in direction numbers.
+    static const size_t max_dimensions = 21;
+
+    /// Creates a new sobol_engine for points of \p dimensions dimensions
+    /// (at most \c max_dimensions).
+    explicit sobol_engine(command_queue &queue, size_t dimensions = 1)
+        : m_dimensions(dimensions),
+          m_directions(queue.get_context()),
+          m_point(0)
+    {
+        const std::vector<uint_> directions =
+            detail::sobol_direction_numbers(dimensions);
+        m_directions = vector<uint_>(directions.begin(), directions.end(), queue);
+    }
+
+    /// Creates a new sobol_engine with the direction numbers in the range
+    /// [\p first, \p last), which contains 32 direction numbers (for the
+    /// bits from the most significant one on) for each dimension.
+    template<class InputIterator>
+    sobol_engine(InputIterator first, InputIterator last, command_queue &queue)
+        : m_dimensions(std::distance(first, last) / 32),
+          m_directions(first, last, queue),
+          m_point(0)
+    {
+    }
+
+    /// Destroys the sobol_engine object.
+    ~sobol_engine()
+    {
+    }
+
+    /// Returns the number of dimensions of the points.
+    size_t dimensions() const
+    {
+        return m_dimensions;
+    }
+
+    /// Returns the direction numbers of the sequence.
+    const vector<uint_>& direction_numbers() const
+    {
+        return m_directions;
+    }
+
+    /// Restarts the sequence at its first point.
+    void seed(command_queue &queue)
+    {
+        (void) queue;
+
+        m_point = 0;
+    }
+
+    /// Generates the coordinates of the next points and stores them to
+    /// the range [\p first, \p last) with the coordinates of each point
+    /// next to each other. The size of the range must be a multiple of
+    /// dimensions().
+    template<class OutputIterator>
+    void generate(OutputIterator first, OutputIterator last, command_queue &queue)
+    {
+        generate(first, last, ::boost::compute::identity<uint_>(), queue);
+    }
+
+    /// Generates the coordinates of the next points, transforms them with
+    /// \p op, and then stores them to the range [\p first, \p last) with
+    /// the coordinates of each point next to each other.
+    template<class OutputIterator, class Function>
+    void generate(OutputIterator first, OutputIterator last, Function op, command_queue &queue)
+    {
+        generate_points(first, last, op, false, queue);
+    }
+
+    /// Generates the coordinates of the next points and stores them to the
+    /// range [\p first, \p last) with each dimension in a contiguous part
+    /// of the range (i.e. the first coordinates of all of the points, then
+    /// the second coordinates, and so on). The parts can then be read with
+    /// a zip_iterator.
+    template<class OutputIterator>
+    void generate_by_dimension(OutputIterator first,
+                               OutputIterator last,
+                               command_queue &queue)
+    {
+        generate_by_dimension(first, last, ::boost::compute::identity<uint_>(), queue);
+    }
+
+    /// \overload
+    template<class OutputIterator, class Function>
+    void generate_by_dimension(OutputIterator first,
+                               OutputIterator last,
+                               Function op,
+                               command_queue &queue)
+    {
+        generate_points(first, last, op, true, queue);
+    }
+
+    /// Skips the next \p z points.
+    void discard(size_t z, command_queue &queue)
+    {
+        (void) queue;
+
+        m_point += static_cast<uint_>(z);
+    }
+
+private:
+    template<class OutputIterator, class Function>
+    void generate_points(OutputIterator first,
+                         OutputIterator last,
+                         Function op,
+                         bool by_dimension,
+                         command_queue &queue)
+    {
+        const size_t size = detail::iterator_range_size(first, last);
+        BOOST_ASSERT(size % m_dimensions == 0);
+
+        const size_t count = size / m_dimensions;
+        if(count == 0){
+            return;
+        }
+
+        // the number of points of each work-item
+        const uint_ block_size = 64;
+
+        detail::meta_kernel k("sobol_generate");
+        size_t first_point_arg = k.add_arg<const uint_>("first_point");
+        size_t count_arg = k.add_arg<const uint_>("count");
+        size_t dimensions_arg = k.add_arg<const uint_>("dimensions");
+        size_t block_size_arg = k.add_arg<const uint_>("block_size");
+        const std::string directions =
+            k.get_table_identifier<uint_>(m_directions.get_buffer());
+
+        k <<
+            "const uint dim = get_global_id(0) % dimensions;\n" <<
+            "const uint begin = get_global_id(0) / dimensions * block_size;\n" <<
+            "const uint end = min(begin + block_size, count);\n" <<
+            "const uint v = dim * 32;\n" <<
+            "uint n = first_point + begin;\n" <<
+            "uint x = 0;\n" <<
+            "for(uint gray = n ^ (n >> 1), bit = 0; gray != 0; gray >>= 1, bit++){\n" <<
+            "    if(gray & 1){\n" <<
+            "        x ^= " << directions << "[v + bit];\n" <<
+            "    }\n" <<
+            "}\n" <<
+            "for(uint p = begin; p < end; p++){\n" <<
+            "    " << first[k.var<uint_>(by_dimension ? "dim * count + p" : "p * dimensions + dim")] <<
+                " = " << op(k.var<const uint_>("x")) << ";\n" <<
+            // the gray code of n + 1 differs in the lowest zero bit of n
+            "    if(p + 1 < end){\n" <<
+            "        x ^= " << directions << "[v + 31 - clz(~n & (n + 1))];\n" <<
+            "        n++;\n" <<
+            "    }\n" <<
+            "}\n";
+
+        k.set_arg(first_point_arg, m_point);
+        k.set_arg(count_arg, static_cast<uint_>(count));
+        k.set_arg(dimensions_arg, static_cast<uint_>(m_dimensions));
+        k.set_arg(block_size_arg, block_size);
+
+        const size_t blocks = (count + block_size - 1) / block_size;
+        k.exec_1d(queue, 0, blocks * m_dimensions);
+
+        m_point += static_cast<uint_>(count);
+    }
+
+private:
+    size_t m_dimensions;
+    vector<uint_> m_directions;
+    uint_ m_point;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_RANDOM_SOBOL_ENGINE_HPP
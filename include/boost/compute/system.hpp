@@ -23,7 +23,10 @@
 #include <boost/compute/context.hpp>
 #include <boost/compute/platform.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/device_ranking.hpp>
 #include <boost/compute/detail/getenv.hpp>
+#include <boost/compute/detail/global_static.hpp>
+#include <boost/compute/detail/mutex.hpp>
 #include <boost/compute/exception/no_device_found.hpp>
 
 namespace boost {
@@ -56,6 +59,16 @@ public:
     ///        name of the platform (e.g. "NVIDIA CUDA")
     /// \li \c BOOST_COMPUTE_DEFAULT_VENDOR -
     ///        name of the device vendor (e.g. "NVIDIA")
+    /// \li \c BOOST_COMPUTE_DEFAULT_DEVICE_SELECTION -
+    ///        \c "score" to select the device with the highest estimated
+    ///        peak performance or \c "benchmark" to select the device
+    ///        running a short bandwidth benchmark fastest, instead of the
+    ///        first GPU (ignored if one of the variables above is set)
+    ///
+    /// When compiled with \c BOOST_COMPUTE_USE_OFFLINE_CACHE defined the
+    /// ranked device is stored in the offline cache, so later runs select
+    /// it again without ranking the devices or enumerating the devices of
+    /// the other platforms (until its platform or driver is updated).
     ///
     /// The default device is determined once on the first time this function
     /// is called. Calling this function multiple times will always result in
@@ -155,15 +168,102 @@ public:
     }
 
     /// Returns the default command queue for the system.
+    ///
+    /// By default a single command queue is shared by all of the threads
+    /// of the program. With many host threads enqueuing work this
+    /// serializes all of their commands into one in-order queue. See
+    /// set_default_queue_count() to give each thread a queue of its own.
     static command_queue& default_queue()
     {
-        static command_queue queue(default_context(), default_device());
+        if(default_queue_count_value() == 1){
+            static command_queue queue(default_context(), default_device());
+
+            return queue;
+        }
+
+        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(command_queue, thread_queue, );
+        if(!thread_queue.get()){
+            thread_queue = next_default_queue();
+        }
+
+        return thread_queue;
+    }
+
+    /// Returns the default command queue for the \p priority class.
+    ///
+    /// With \c command_queue::priority_default this is default_queue().
+    /// Otherwise the queue is created for the default context and device
+    /// with the \p priority hint (see the command_queue constructor taking
+    /// hints) the first time it is requested. Each thread gets queues of
+    /// its own when \c BOOST_COMPUTE_THREAD_SAFE is defined.
+    ///
+    /// This lets latency-critical work bypass the batch work submitted to
+    /// the default queue:
+    /// \code
+    /// boost::compute::command_queue &queue =
+    ///     boost::compute::system::default_queue(
+    ///         boost::compute::command_queue::priority_high
+    ///     );
+    /// \endcode
+    static command_queue& default_queue(command_queue::priority_hint priority)
+    {
+        if(priority == command_queue::priority_default){
+            return default_queue();
+        }
+
+        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(
+            std::vector<command_queue>, priority_queues, (3)
+        );
+        command_queue &queue = priority_queues[priority - 1];
+        if(!queue.get()){
+            queue = command_queue(default_context(), default_device(), 0, priority);
+        }
 
         return queue;
     }
 
+    /// Sets the number of default command queues to \p count.
+    ///
+    /// \li \c 1 (the default) - all threads share the same queue
+    /// \li \c 0 - each thread gets a new queue the first time it calls
+    ///        default_queue()
+    /// \li \c n - a pool of \c n queues is created and each thread gets
+    ///        the next queue of the pool (in round-robin order) the first
+    ///        time it calls default_queue()
+    ///
+    /// All of the queues are created for the default context and device,
+    /// so memory objects and programs are shared by the threads. Threads
+    /// keep the queue they were given, so this should be called before
+    /// other threads start using the default queue. Queues of their own
+    /// require \c BOOST_COMPUTE_THREAD_SAFE to be defined (otherwise a
+    /// single queue is used by all threads, whatever the count).
+    ///
+    /// The initial count can also be set with the
+    /// \c BOOST_COMPUTE_DEFAULT_QUEUE_COUNT environment variable.
+    ///
+    /// For example, to give each thread of a server its own queue:
+    /// \code
+    /// boost::compute::system::set_default_queue_count(0);
+    /// \endcode
+    static void set_default_queue_count(size_t count)
+    {
+        detail::scoped_lock lock(default_queue_mutex());
+
+        default_queue_count_value() = count;
+        default_queue_pool().clear();
+    }
+
+    /// Returns the number of default command queues.
+    ///
+    /// \see set_default_queue_count()
+    static size_t default_queue_count()
+    {
+        return default_queue_count_value();
+    }
+
     /// Blocks until all outstanding computations on the default
-    /// command queue are complete.
+    /// command queue are complete (the queue of the calling thread when
+    /// there are several default queues).
     ///
     /// This is equivalent to:
     /// \code
@@ -211,18 +311,30 @@ private:
     /// \internal_
     static device find_default_device()
     {
-        // get a list of all devices on the system
-        const std::vector<device> devices_ = devices();
-        if(devices_.empty()){
-            BOOST_THROW_EXCEPTION(no_device_found());
-        }
-
         // check for device from environment variable
         const char *name     = detail::getenv("BOOST_COMPUTE_DEFAULT_DEVICE");
         const char *type     = detail::getenv("BOOST_COMPUTE_DEFAULT_DEVICE_TYPE");
         const char *platform = detail::getenv("BOOST_COMPUTE_DEFAULT_PLATFORM");
         const char *vendor   = detail::getenv("BOOST_COMPUTE_DEFAULT_VENDOR");
 
+        // rank the devices (or use the device ranked first before)
+        const char *selection = detail::getenv("BOOST_COMPUTE_DEFAULT_DEVICE_SELECTION");
+        if(selection && !(name || type || platform || vendor) &&
+           (matches(selection, "score") || matches(selection, "benchmark"))){
+            const device ranked = detail::select_ranked_device(
+                platforms(), matches(selection, "benchmark") ? "benchmark" : "score"
+            );
+            if(ranked.id()){
+                return ranked;
+            }
+        }
+
+        // get a list of all devices on the system
+        const std::vector<device> devices_ = devices();
+        if(devices_.empty()){
+            BOOST_THROW_EXCEPTION(no_device_found());
+        }
+
         if(name || type || platform || vendor){
             BOOST_FOREACH(const device &device, devices_){
                 if (name && !matches(device.name(), name))
@@ -264,6 +376,62 @@ private:
         return devices_[0];
     }
 
+    /// \internal_
+    static size_t& default_queue_count_value()
+    {
+        static size_t count = initial_default_queue_count();
+
+        return count;
+    }
+
+    /// \internal_
+    static size_t initial_default_queue_count()
+    {
+        const char *count = detail::getenv("BOOST_COMPUTE_DEFAULT_QUEUE_COUNT");
+        if(count){
+            return static_cast<size_t>(std::strtoul(count, 0, 10));
+        }
+
+        return 1;
+    }
+
+    /// \internal_
+    static detail::mutex& default_queue_mutex()
+    {
+        static detail::mutex mutex;
+
+        return mutex;
+    }
+
+    /// \internal_
+    static std::vector<command_queue>& default_queue_pool()
+    {
+        static std::vector<command_queue> pool;
+
+        return pool;
+    }
+
+    /// \internal_
+    static command_queue next_default_queue()
+    {
+        detail::scoped_lock lock(default_queue_mutex());
+
+        const size_t count = default_queue_count_value();
+        if(count == 0){
+            return command_queue(default_context(), default_device());
+        }
+
+        static size_t next = 0;
+
+        std::vector<command_queue> &pool = default_queue_pool();
+        if(pool.size() < count){
+            pool.push_back(command_queue(default_context(), default_device()));
+            return pool.back();
+        }
+
+        return pool[next++ % count];
+    }
+
     /// \internal_
     static bool matches(const std::string &str, const std::string &pattern)
     {
@@ -11,7 +11,10 @@
 #ifndef BOOST_COMPUTE_TYPE_TRAITS_DETAIL_CAPTURE_TRAITS_HPP
 #define BOOST_COMPUTE_TYPE_TRAITS_DETAIL_CAPTURE_TRAITS_HPP
 
+#include <boost/type_traits/integral_constant.hpp>
+
 #include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/type_traits/is_fundamental.hpp>
 
 namespace boost {
 namespace compute {
@@ -26,6 +29,17 @@ struct capture_traits
     }
 };
 
+// true if captured values of type T are passed to the kernel as (by value)
+// arguments. this is the case for scalar and vector types (and bool, which
+// is passed as a uint). other captures are streamed to the kernel and must
+// not write their value into the source either (e.g. vector<T> is passed
+// as a buffer argument).
+template<class T>
+struct is_capture_kernel_argument : ::boost::compute::is_fundamental<T> {};
+
+template<>
+struct is_capture_kernel_argument<bool> : boost::true_type {};
+
 } // end detail namespace
 } // end compute namespace
 } // end boost namespace
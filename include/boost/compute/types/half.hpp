@@ -0,0 +1,379 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_TYPES_HALF_HPP
+#define BOOST_COMPUTE_TYPES_HALF_HPP
+
+#include <cstring>
+#include <string>
+
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+inline uint_ float_bits(float value)
+{
+    uint_ bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline float float_from_bits(uint_ bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// converts value to the closest half-precision value (rounding ties to
+// even like vstore_half() with the default rounding mode)
+inline ushort_ float_to_half_bits(float value)
+{
+    const uint_ bits = float_bits(value);
+    const uint_ sign = (bits >> 16) & 0x8000;
+    const uint_ exponent = (bits >> 23) & 0xff;
+    uint_ mantissa = bits & 0x7fffff;
+
+    // infinity and nan (kept quiet)
+    if(exponent == 0xff){
+        return static_cast<ushort_>(
+            sign | 0x7c00 | (mantissa ? 0x200 | (mantissa >> 13) : 0)
+        );
+    }
+
+    const int half_exponent = static_cast<int>(exponent) - 127 + 15;
+    if(half_exponent >= 0x1f){
+        // overflow to infinity
+        return static_cast<ushort_>(sign | 0x7c00);
+    }
+    else if(half_exponent <= 0){
+        // denormal or zero
+        if(half_exponent < -10){
+            return static_cast<ushort_>(sign);
+        }
+
+        mantissa |= 0x800000;
+        const uint_ shift = static_cast<uint_>(14 - half_exponent);
+        uint_ half_mantissa = mantissa >> shift;
+        const uint_ remainder = mantissa & ((1u << shift) - 1);
+        const uint_ halfway = 1u << (shift - 1);
+        if(remainder > halfway || (remainder == halfway && (half_mantissa & 1))){
+            half_mantissa++;
+        }
+        return static_cast<ushort_>(sign | half_mantissa);
+    }
+
+    // rounding may carry into the exponent (up to infinity)
+    uint_ half_bits =
+        sign | (static_cast<uint_>(half_exponent) << 10) | (mantissa >> 13);
+    const uint_ remainder = mantissa & 0x1fff;
+    if(remainder > 0x1000 || (remainder == 0x1000 && (half_bits & 1))){
+        half_bits++;
+    }
+    return static_cast<ushort_>(half_bits);
+}
+
+inline float half_bits_to_float(ushort_ half_bits)
+{
+    const uint_ sign = static_cast<uint_>(half_bits & 0x8000) << 16;
+    int exponent = (half_bits >> 10) & 0x1f;
+    uint_ mantissa = half_bits & 0x3ff;
+
+    if(exponent == 0x1f){
+        return float_from_bits(sign | 0x7f800000 | (mantissa << 13));
+    }
+    else if(exponent == 0){
+        if(mantissa == 0){
+            return float_from_bits(sign);
+        }
+
+        // normalize the denormal value
+        exponent = 1;
+        while(!(mantissa & 0x400)){
+            mantissa <<= 1;
+            exponent--;
+        }
+        mantissa &= 0x3ff;
+    }
+
+    return float_from_bits(
+        sign | (static_cast<uint_>(exponent + 112) << 23) | (mantissa << 13)
+    );
+}
+
+// converts value to the closest bfloat16 value (its upper 16 bits, rounded
+// with ties to even)
+inline ushort_ float_to_bfloat16_bits(float value)
+{
+    const uint_ bits = float_bits(value);
+
+    if((bits & 0x7f800000) == 0x7f800000 && (bits & 0x7fffff)){
+        // keep nans quiet
+        return static_cast<ushort_>((bits >> 16) | 0x40);
+    }
+
+    return static_cast<ushort_>((bits + 0x7fff + ((bits >> 16) & 1)) >> 16);
+}
+
+inline float bfloat16_bits_to_float(ushort_ bits)
+{
+    return float_from_bits(static_cast<uint_>(bits) << 16);
+}
+
+} // end detail namespace
+
+/// \class half_
+/// \brief A half-precision (16-bit) floating-point value.
+///
+/// The half_ type stores values in the IEEE 754 binary16 format used by
+/// the OpenCL \c half type, halving the memory and bandwidth needed
+/// compared to \c float. On the host values are converted to and from
+/// \c float.
+///
+/// Buffers of half_ values are read and written by kernels with
+/// \c vload_half() and \c vstore_half() and computations are done in
+/// \c float, so devices do not need to support the \c cl_khr_fp16
+/// extension. The extension is enabled in kernels using half_ if the
+/// device supports it (like \c cl_khr_fp64 for double).
+///
+/// The copy() (between half_ and float ranges), transform() (to and from
+/// half_ ranges with functions of \c float), reduce() (accumulating in
+/// \c float) and sort() algorithms support ranges of half_ values.
+///
+/// \see bfloat16_
+class half_
+{
+public:
+    half_()
+        : m_bits(0)
+    {
+    }
+
+    half_(float value)
+        : m_bits(detail::float_to_half_bits(value))
+    {
+    }
+
+    operator float() const
+    {
+        return detail::half_bits_to_float(m_bits);
+    }
+
+    /// Returns the bits of the value.
+    ushort_ bits() const
+    {
+        return m_bits;
+    }
+
+    /// Returns the value with \p bits.
+    static half_ from_bits(ushort_ bits)
+    {
+        half_ value;
+        value.m_bits = bits;
+        return value;
+    }
+
+private:
+    ushort_ m_bits;
+};
+
+/// \class bfloat16_
+/// \brief A bfloat16 (16-bit "brain" floating-point) value.
+///
+/// bfloat16 values have the exponent range of \c float with an 8-bit
+/// mantissa, they are the upper 16 bits of the corresponding \c float.
+/// OpenCL has no bfloat16 type so the values are stored as \c ushort in
+/// kernels, which convert them to \c float when reading and round
+/// them (ties to even) when writing.
+///
+/// The same algorithms as for half_ support ranges of bfloat16_ values.
+///
+/// \see half_
+class bfloat16_
+{
+public:
+    bfloat16_()
+        : m_bits(0)
+    {
+    }
+
+    bfloat16_(float value)
+        : m_bits(detail::float_to_bfloat16_bits(value))
+    {
+    }
+
+    operator float() const
+    {
+        return detail::bfloat16_bits_to_float(m_bits);
+    }
+
+    /// Returns the bits of the value.
+    ushort_ bits() const
+    {
+        return m_bits;
+    }
+
+    /// Returns the value with \p bits.
+    static bfloat16_ from_bits(ushort_ bits)
+    {
+        bfloat16_ value;
+        value.m_bits = bits;
+        return value;
+    }
+
+private:
+    ushort_ m_bits;
+};
+
+namespace detail {
+
+// meta-function returning true for the 16-bit floating-point types which
+// kernels convert to float (half_ and bfloat16_)
+template<class T>
+struct is_half_type : boost::false_type {};
+
+template<>
+struct is_half_type<half_> : boost::true_type {};
+
+template<>
+struct is_half_type<bfloat16_> : boost::true_type {};
+
+template<>
+struct type_name_trait<half_>
+{
+    static const char* value()
+    {
+        return "half";
+    }
+};
+
+template<>
+struct type_name_trait<bfloat16_>
+{
+    static const char* value()
+    {
+        return "ushort";
+    }
+};
+
+template<>
+struct inject_type_impl<half_>
+{
+    void operator()(meta_kernel &kernel)
+    {
+        kernel.add_optional_extension_pragma("cl_khr_fp16");
+    }
+};
+
+// constants are written as float literals (converted when stored)
+inline meta_kernel& operator<<(meta_kernel &kernel, const half_ &x)
+{
+    return kernel << static_cast<float>(x);
+}
+
+inline meta_kernel& operator<<(meta_kernel &kernel, const bfloat16_ &x)
+{
+    return kernel << static_cast<float>(x);
+}
+
+// writes the index of a value of a buffer iterator, offset by the index
+// of the iterator
+template<class T, class IndexExpr>
+inline void half_buffer_index(meta_kernel &kernel,
+                              const buffer_iterator_index_expr<T, IndexExpr> &expr)
+{
+    if(expr.m_index == 0){
+        kernel << expr.m_expr;
+    }
+    else {
+        kernel << uint_(expr.m_index) << "+(" << expr.m_expr << ")";
+    }
+}
+
+// values read from buffers of half_ and bfloat16_ values are floats
+template<class IndexExpr>
+inline meta_kernel& operator<<(meta_kernel &kernel,
+                               const buffer_iterator_index_expr<half_, IndexExpr> &expr)
+{
+    kernel << "vload_half(";
+    half_buffer_index(kernel, expr);
+    return kernel << ", " <<
+        kernel.get_buffer_identifier<half_>(expr.m_buffer, expr.m_address_space) << ")";
+}
+
+template<class IndexExpr>
+inline meta_kernel& operator<<(meta_kernel &kernel,
+                               const buffer_iterator_index_expr<bfloat16_, IndexExpr> &expr)
+{
+    kernel << "as_float(((uint) " <<
+        kernel.get_buffer_identifier<bfloat16_>(expr.m_buffer, expr.m_address_space) << "[";
+    half_buffer_index(kernel, expr);
+    return kernel << "]) << 16)";
+}
+
+inline const char* float_to_bfloat16_source()
+{
+    return
+        "inline ushort boost_float_to_bfloat16(const float x)\n"
+        "{\n"
+        "    const uint bits = as_uint(x);\n"
+        "    if(isnan(x)){\n"
+        "        return (ushort)((bits >> 16) | 0x40);\n"
+        "    }\n"
+        "    return (ushort)((bits + 0x7fff + ((bits >> 16) & 1)) >> 16);\n"
+        "}\n";
+}
+
+// writes the statement storing the float value at index of a buffer of
+// half_ or bfloat16_ values
+template<class Expr>
+inline void half_store(meta_kernel &kernel,
+                       const buffer_iterator<half_> &result,
+                       const std::string &index,
+                       const Expr &value)
+{
+    kernel << "vstore_half(" << value << ", " <<
+        uint_(result.get_index()) << "+(" << index << "), " <<
+        kernel.get_buffer_identifier<half_>(result.get_buffer()) << ");\n";
+}
+
+template<class Expr>
+inline void half_store(meta_kernel &kernel,
+                       const buffer_iterator<bfloat16_> &result,
+                       const std::string &index,
+                       const Expr &value)
+{
+    kernel.add_function("boost_float_to_bfloat16", float_to_bfloat16_source());
+    kernel <<
+        kernel.get_buffer_identifier<bfloat16_>(result.get_buffer()) <<
+        "[" << uint_(result.get_index()) << "+(" << index << ")] = " <<
+        "boost_float_to_bfloat16(" << value << ");\n";
+}
+
+// returns an iterator to the bits of the values of a range of half_ or
+// bfloat16_ values, for moving the values without converting them
+template<class T>
+inline buffer_iterator<ushort_> half_bits_iterator(const buffer_iterator<T> &iterator)
+{
+    return buffer_iterator<ushort_>(iterator.get_buffer(), iterator.get_index());
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_TYPES_HALF_HPP
@@ -11,15 +11,24 @@
 #ifndef BOOST_COMPUTE_TYPES_STRUCT_HPP
 #define BOOST_COMPUTE_TYPES_STRUCT_HPP
 
+#include <cstddef>
 #include <sstream>
 
 #include <boost/static_assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
 
+#include <boost/preprocessor/dec.hpp>
+#include <boost/preprocessor/if.hpp>
 #include <boost/preprocessor/stringize.hpp>
+#include <boost/preprocessor/seq/elem.hpp>
 #include <boost/preprocessor/seq/for_each.hpp>
+#include <boost/preprocessor/seq/for_each_i.hpp>
 #include <boost/preprocessor/seq/fold_left.hpp>
+#include <boost/preprocessor/seq/size.hpp>
 #include <boost/preprocessor/seq/transform.hpp>
+#include <boost/preprocessor/tuple/elem.hpp>
 
+#include <boost/compute/type_traits/is_vector_type.hpp>
 #include <boost/compute/type_traits/type_definition.hpp>
 #include <boost/compute/type_traits/type_name.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
@@ -37,6 +46,38 @@ inline std::string adapt_struct_insert_member(T Struct::*, const char *name)
     return s.str();
 }
 
+// returns the alignment of T in device structs. vector types are aligned
+// to their size on the device, which is more than on the host.
+template<class T>
+struct device_alignment_of
+{
+    BOOST_STATIC_CONSTANT(
+        size_t,
+        value = (is_vector_type<T>::value ? sizeof(T) : boost::alignment_of<T>::value)
+    );
+};
+
+// the size of the returned array is the device alignment of the member,
+// for use in static assertions of the layout of adapted structs
+template<class Struct, class T>
+char (&adapt_struct_member_alignment(T Struct::*))[device_alignment_of<T>::value];
+
+template<class Struct, class T>
+inline std::string adapt_struct_insert_aligned_member(T Struct::*, const char *name)
+{
+    std::stringstream s;
+    s << "    " << type_name<T>() << " " << name
+      << " __attribute__((aligned(" << device_alignment_of<T>::value << ")));\n";
+    return s.str();
+}
+
+// describes the members of a struct adapted with BOOST_COMPUTE_ADAPT_STRUCT().
+// specializations define the number of members (count) and a static
+// for_each(f) function calling f(&type::member, "member") for each member
+// in the order of their declaration in the OpenCL struct.
+template<class Struct>
+struct adapted_struct_members;
+
 } // end detail namespace
 } // end compute namespace
 } // end boost namespace
@@ -47,6 +88,16 @@ inline std::string adapt_struct_insert_member(T Struct::*, const char *name)
            &type::member, BOOST_PP_STRINGIZE(member) \
        )
 
+/// \internal_
+#define BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_INSERT_ALIGNED_MEMBER(r, type, member) \
+    << ::boost::compute::detail::adapt_struct_insert_aligned_member( \
+           &type::member, BOOST_PP_STRINGIZE(member) \
+       )
+
+/// \internal_
+#define BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_VISIT_MEMBER(r, type, member) \
+    f(&type::member, BOOST_PP_STRINGIZE(member));
+
 /// \internal_
 #define BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_STREAM_MEMBER(r, data, i, elem) \
     BOOST_PP_EXPR_IF(i, << ", ") << data.elem
@@ -68,6 +119,56 @@ inline std::string adapt_struct_insert_member(T Struct::*, const char *name)
         ) \
     )
 
+/// \internal_
+#define BOOST_COMPUTE_DETAIL_STRUCT_MEMBER_ALIGNMENT(struct_, member_) \
+    sizeof(::boost::compute::detail::adapt_struct_member_alignment(&struct_::member_))
+
+/// \internal_
+#define BOOST_COMPUTE_DETAIL_STRUCT_ROUND_UP(x, alignment) \
+    (((x) + (alignment) - 1) / (alignment) * (alignment))
+
+/// \internal_
+#define BOOST_COMPUTE_DETAIL_STRUCT_MEMBER_END(struct_, member_) \
+    (offsetof(struct_, member_) + sizeof(((struct_ *)0)->member_))
+
+/// \internal_
+///
+/// Returns the offset of the member at index i of members_ in the device
+/// struct, which places it at the first multiple of its alignment after
+/// the previous member.
+#define BOOST_COMPUTE_DETAIL_STRUCT_DEVICE_OFFSET(struct_, members_, i) \
+    BOOST_PP_IF( \
+        i, \
+        BOOST_COMPUTE_DETAIL_STRUCT_ROUND_UP( \
+            BOOST_COMPUTE_DETAIL_STRUCT_MEMBER_END( \
+                struct_, BOOST_PP_SEQ_ELEM(BOOST_PP_DEC(i), members_) \
+            ), \
+            BOOST_COMPUTE_DETAIL_STRUCT_MEMBER_ALIGNMENT( \
+                struct_, BOOST_PP_SEQ_ELEM(i, members_) \
+            ) \
+        ), \
+        0 \
+    )
+
+/// \internal_
+#define BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_CHECK_MEMBER(r, data, i, member) \
+    BOOST_STATIC_ASSERT_MSG( \
+        offsetof(BOOST_PP_TUPLE_ELEM(2, 0, data), member) == \
+            BOOST_COMPUTE_DETAIL_STRUCT_DEVICE_OFFSET( \
+                BOOST_PP_TUPLE_ELEM(2, 0, data), BOOST_PP_TUPLE_ELEM(2, 1, data), i \
+            ), \
+        "BOOST_COMPUTE_ADAPT_STRUCT_ALIGNED() requires members at the offsets " \
+        "the device places them at." \
+    ); \
+    BOOST_STATIC_ASSERT_MSG( \
+        ::boost::alignment_of<BOOST_PP_TUPLE_ELEM(2, 0, data)>::value % \
+            BOOST_COMPUTE_DETAIL_STRUCT_MEMBER_ALIGNMENT( \
+                BOOST_PP_TUPLE_ELEM(2, 0, data), member \
+            ) == 0, \
+        "BOOST_COMPUTE_ADAPT_STRUCT_ALIGNED() requires structs aligned at least " \
+        "as their members are on the device." \
+    );
+
 /// \internal_
 ///
 /// Returns true if struct_ contains no internal padding bytes (i.e. it is
@@ -75,6 +176,42 @@ inline std::string adapt_struct_insert_member(T Struct::*, const char *name)
 #define BOOST_COMPUTE_DETAIL_STRUCT_IS_PACKED(struct_, members_) \
     (sizeof(struct_) == BOOST_COMPUTE_DETAIL_STRUCT_MEMBER_SIZE_SUM(struct_, members_))
 
+/// \internal_
+#define BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_TRAITS(type, name, members) \
+    template<> \
+    struct adapted_struct_members<type> \
+    { \
+        static const size_t count = \
+            BOOST_PP_SEQ_SIZE(BOOST_COMPUTE_PP_TUPLE_TO_SEQ(members)); \
+        template<class Function> \
+        static void for_each(Function &f) \
+        { \
+            BOOST_PP_SEQ_FOR_EACH( \
+                BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_VISIT_MEMBER, \
+                type, \
+                BOOST_COMPUTE_PP_TUPLE_TO_SEQ(members) \
+            ) \
+        } \
+    }; \
+    template<> \
+    struct inject_type_impl<type> \
+    { \
+        void operator()(meta_kernel &kernel) \
+        { \
+            kernel.add_type_declaration<type>(type_definition<type>()); \
+        } \
+    }; \
+    inline meta_kernel& operator<<(meta_kernel &k, type s) \
+    { \
+        return k << "(" << #name << "){" \
+               BOOST_PP_SEQ_FOR_EACH_I( \
+                   BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_STREAM_MEMBER, \
+                   s, \
+                   BOOST_COMPUTE_PP_TUPLE_TO_SEQ(members) \
+               ) \
+               << "}"; \
+    }
+
 /// The BOOST_COMPUTE_ADAPT_STRUCT() macro makes a C++ struct/class available
 /// to OpenCL kernels.
 ///
@@ -117,6 +254,8 @@ inline std::string adapt_struct_insert_member(T Struct::*, const char *name)
 /// Due to differences in struct padding between the host compiler and the
 /// device compiler, the \c BOOST_COMPUTE_ADAPT_STRUCT() macro requires that
 /// the adapted struct is packed (i.e. no padding bytes between members).
+/// Structs with padding can be adapted with
+/// BOOST_COMPUTE_ADAPT_STRUCT_ALIGNED().
 ///
 /// \see type_name()
 #define BOOST_COMPUTE_ADAPT_STRUCT(type, name, members) \
@@ -140,24 +279,75 @@ inline std::string adapt_struct_insert_member(T Struct::*, const char *name)
         return declaration.str(); \
     } \
     namespace detail { \
+    BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_TRAITS(type, name, members) \
+    }}}
+
+/// The BOOST_COMPUTE_ADAPT_STRUCT_ALIGNED() macro makes a C++ struct/class
+/// available to OpenCL kernels with the same layout as on the host,
+/// including the padding between its members.
+///
+/// \param type The C++ type.
+/// \param name The OpenCL name.
+/// \param members A tuple of the struct's members.
+///
+/// Unlike BOOST_COMPUTE_ADAPT_STRUCT(), the OpenCL struct is not packed.
+/// Each member and the struct itself are declared with the alignment they
+/// have on the host, so the device compiler can load them with aligned
+/// (and vectorized) memory accesses instead of byte by byte. For example:
+/// \code
+/// struct Point
+/// {
+///     char tag;
+///     float x, y, z;
+/// };
+///
+/// BOOST_COMPUTE_ADAPT_STRUCT_ALIGNED(Point, Point, (tag, x, y, z))
+/// \endcode
+///
+/// The offset of each member is checked at compile-time against where the
+/// device places it. Vector types are aligned to their size on the
+/// device, so structs with vector members must be aligned accordingly on
+/// the host (e.g. with \c alignas(16) for \c float4_).
+///
+/// \see BOOST_COMPUTE_ADAPT_STRUCT()
+#define BOOST_COMPUTE_ADAPT_STRUCT_ALIGNED(type, name, members) \
+    BOOST_PP_SEQ_FOR_EACH_I( \
+        BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_CHECK_MEMBER, \
+        (type, BOOST_COMPUTE_PP_TUPLE_TO_SEQ(members)), \
+        BOOST_COMPUTE_PP_TUPLE_TO_SEQ(members) \
+    ) \
+    BOOST_STATIC_ASSERT_MSG( \
+        sizeof(type) == BOOST_COMPUTE_DETAIL_STRUCT_ROUND_UP( \
+            BOOST_COMPUTE_DETAIL_STRUCT_MEMBER_END( \
+                type, \
+                BOOST_PP_SEQ_ELEM( \
+                    BOOST_PP_DEC(BOOST_PP_SEQ_SIZE(BOOST_COMPUTE_PP_TUPLE_TO_SEQ(members))), \
+                    BOOST_COMPUTE_PP_TUPLE_TO_SEQ(members) \
+                ) \
+            ), \
+            ::boost::alignment_of<type>::value \
+        ), \
+        "BOOST_COMPUTE_ADAPT_STRUCT_ALIGNED() requires all members of the struct to be adapted " \
+        "and no padding after them beyond the alignment of the struct." \
+    ); \
+    BOOST_COMPUTE_TYPE_NAME(type, name) \
+    namespace boost { namespace compute { \
     template<> \
-    struct inject_type_impl<type> \
-    { \
-        void operator()(meta_kernel &kernel) \
-        { \
-            kernel.add_type_declaration<type>(type_definition<type>()); \
-        } \
-    }; \
-    inline meta_kernel& operator<<(meta_kernel &k, type s) \
+    inline std::string type_definition<type>() \
     { \
-        return k << "(" << #name << "){" \
-               BOOST_PP_SEQ_FOR_EACH_I( \
-                   BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_STREAM_MEMBER, \
-                   s, \
-                   BOOST_COMPUTE_PP_TUPLE_TO_SEQ(members) \
-               ) \
-               << "}"; \
+        std::stringstream declaration; \
+        declaration << "typedef struct __attribute__((aligned(" \
+                    << ::boost::alignment_of<type>::value << "))) {\n" \
+                    BOOST_PP_SEQ_FOR_EACH( \
+                        BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_INSERT_ALIGNED_MEMBER, \
+                        type, \
+                        BOOST_COMPUTE_PP_TUPLE_TO_SEQ(members) \
+                    ) \
+                    << "} " << type_name<type>() << ";\n"; \
+        return declaration.str(); \
     } \
+    namespace detail { \
+    BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_TRAITS(type, name, members) \
     }}}
 
 #endif // BOOST_COMPUTE_TYPES_STRUCT_HPP
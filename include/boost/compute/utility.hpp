@@ -11,10 +11,26 @@
 #ifndef BOOST_COMPUTE_UTILITY_HPP
 #define BOOST_COMPUTE_UTILITY_HPP
 
+#include <boost/compute/utility/buffer_arena.hpp>
+#include <boost/compute/utility/buffer_pool.hpp>
+#include <boost/compute/utility/build_log.hpp>
+#include <boost/compute/utility/build_options.hpp>
+#include <boost/compute/utility/chrome_trace.hpp>
+#include <boost/compute/utility/copy_batch.hpp>
 #include <boost/compute/utility/dim.hpp>
+#include <boost/compute/utility/embedded_programs.hpp>
 #include <boost/compute/utility/extents.hpp>
+#include <boost/compute/utility/fill_batch.hpp>
+#include <boost/compute/utility/kernel_variants.hpp>
+#include <boost/compute/utility/memory_usage.hpp>
+#include <boost/compute/utility/pattern_set.hpp>
+#include <boost/compute/utility/prefetch.hpp>
 #include <boost/compute/utility/program_cache.hpp>
+#include <boost/compute/utility/scratch_space.hpp>
 #include <boost/compute/utility/source.hpp>
+#include <boost/compute/utility/trace.hpp>
+#include <boost/compute/utility/transfer_counters.hpp>
 #include <boost/compute/utility/wait_list.hpp>
+#include <boost/compute/utility/warmup.hpp>
 
 #endif // BOOST_COMPUTE_UTILITY_HPP
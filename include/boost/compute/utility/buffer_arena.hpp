@@ -0,0 +1,220 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_BUFFER_ARENA_HPP
+#define BOOST_COMPUTE_UTILITY_BUFFER_ARENA_HPP
+
+#include <map>
+#include <vector>
+#include <algorithm>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/detail/lru_cache.hpp>
+#include <boost/compute/detail/global_static.hpp>
+#include <boost/compute/detail/mutex.hpp>
+#include <boost/compute/utility/scratch_space.hpp>
+
+namespace boost {
+namespace compute {
+
+#if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+/// \class buffer_arena
+/// \brief Sub-allocates small buffers out of a few large memory objects.
+///
+/// Creating a memory object for each small allocation is slow and
+/// fragments the memory of the device. The buffer_arena creates large
+/// blocks of memory (16 MB by default) and hands out aligned regions of
+/// them as sub-buffers (see buffer::create_subbuffer()), respecting the
+/// \c CL_DEVICE_MEM_BASE_ADDR_ALIGN of the device. Each block is managed
+/// like a \ref scratch_space: the first free region which is large enough
+/// is used and released regions are merged with their free neighbours.
+///
+/// Requests larger than a quarter of the block size get a buffer of their
+/// own, as do all requests on OpenCL 1.0 devices (which do not support
+/// sub-buffers).
+///
+/// For example, to create many small vectors from the global arena of a
+/// context:
+/// \code
+/// typedef boost::compute::arena_allocator<float> allocator_type;
+///
+/// std::vector<boost::compute::vector<float, allocator_type> > vectors;
+/// for(size_t i = 0; i < 10000; i++){
+///     vectors.push_back(
+///         boost::compute::vector<float, allocator_type>(16, context)
+///     );
+/// }
+/// \endcode
+///
+/// Regions are handed out again as soon as they are released, so the
+/// commands using a region must have completed before it is released.
+/// Empty blocks are kept for reuse until trim() is called.
+///
+/// \opencl_version_warning{1,1}
+///
+/// \see arena_allocator, scratch_space, buffer_pool
+class buffer_arena : boost::noncopyable
+{
+public:
+    /// Creates a new buffer arena for \p context with blocks of
+    /// \p block_size bytes. If \p block_size is zero, the blocks are 16 MB
+    /// (or the maximum allocation size of the device if it is smaller).
+    explicit buffer_arena(const context &context, size_t block_size = 0)
+        : m_context(context),
+          m_block_size(block_size ? block_size : default_block_size(context)),
+          m_sub_buffers(context.get_device().check_version(1, 1))
+    {
+    }
+
+    /// Destroys the buffer arena.
+    ~buffer_arena()
+    {
+    }
+
+    /// Returns the context for the arena.
+    const context& get_context() const
+    {
+        return m_context;
+    }
+
+    /// Returns the size in bytes of the blocks of the arena.
+    size_t block_size() const
+    {
+        return m_block_size;
+    }
+
+    /// Returns a read-write buffer of at least \p size bytes.
+    buffer allocate(size_t size)
+    {
+        if(size > m_block_size / 4 || !m_sub_buffers){
+            return buffer(m_context, size, buffer::read_write);
+        }
+
+        detail::scoped_lock lock(m_mutex);
+
+        for(size_t i = 0; i < m_blocks.size(); i++){
+            buffer sub_buffer = m_blocks[i]->allocate(size);
+            if(sub_buffer.get()){
+                m_owners[sub_buffer.get()] = m_blocks[i].get();
+                return sub_buffer;
+            }
+        }
+
+        m_blocks.push_back(
+            boost::make_shared<scratch_space>(
+                buffer(m_context, m_block_size, buffer::read_write), false
+            )
+        );
+
+        buffer sub_buffer = m_blocks.back()->allocate(size);
+        m_owners[sub_buffer.get()] = m_blocks.back().get();
+
+        return sub_buffer;
+    }
+
+    /// Returns \p buf (which must have been allocated from this arena) to
+    /// the arena. No commands using \p buf may be pending.
+    void release(const buffer &buf)
+    {
+        detail::scoped_lock lock(m_mutex);
+
+        owner_map::iterator i = m_owners.find(buf.get());
+        if(i == m_owners.end()){
+            // buffers of their own are simply released
+            return;
+        }
+
+        i->second->release(buf);
+        m_owners.erase(i);
+    }
+
+    /// Releases the blocks which have no region in use.
+    void trim()
+    {
+        detail::scoped_lock lock(m_mutex);
+
+        std::vector<boost::shared_ptr<scratch_space> > blocks;
+        for(size_t i = 0; i < m_blocks.size(); i++){
+            if(m_blocks[i]->used() != 0){
+                blocks.push_back(m_blocks[i]);
+            }
+        }
+
+        m_blocks.swap(blocks);
+    }
+
+    /// Returns the number of blocks held by the arena.
+    size_t block_count() const
+    {
+        return m_blocks.size();
+    }
+
+    /// Returns the number of bytes currently handed out from the blocks.
+    size_t used() const
+    {
+        size_t used = 0;
+        for(size_t i = 0; i < m_blocks.size(); i++){
+            used += m_blocks[i]->used();
+        }
+
+        return used;
+    }
+
+    /// Returns the global buffer arena for \p context.
+    ///
+    /// This global arena is used by arena_allocator and by
+    /// \c experimental::malloc().
+    static boost::shared_ptr<buffer_arena> get_global_arena(const context &context)
+    {
+        typedef detail::lru_cache<cl_context, boost::shared_ptr<buffer_arena> > arena_map;
+
+        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(arena_map, arenas, (8));
+
+        boost::optional<boost::shared_ptr<buffer_arena> > arena = arenas.get(context.get());
+        if(!arena){
+            arena = boost::make_shared<buffer_arena>(context);
+
+            arenas.insert(context.get(), *arena);
+        }
+
+        return *arena;
+    }
+
+private:
+    typedef std::map<cl_mem, scratch_space *> owner_map;
+
+    static size_t default_block_size(const context &context)
+    {
+        return (std::min)(
+            size_t(16 * 1024 * 1024),
+            static_cast<size_t>(context.get_device().max_memory_alloc_size())
+        );
+    }
+
+private:
+    context m_context;
+    size_t m_block_size;
+    bool m_sub_buffers;
+    std::vector<boost::shared_ptr<scratch_space> > m_blocks;
+    owner_map m_owners;
+    detail::mutex m_mutex;
+};
+#endif // CL_VERSION_1_1
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_BUFFER_ARENA_HPP
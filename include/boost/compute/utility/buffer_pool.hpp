@@ -0,0 +1,378 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_BUFFER_POOL_HPP
+#define BOOST_COMPUTE_UTILITY_BUFFER_POOL_HPP
+
+#include <map>
+#include <list>
+#include <utility>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/event.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/lru_cache.hpp>
+#include <boost/compute/detail/global_static.hpp>
+#include <boost/compute/utility/memory_usage.hpp>
+
+namespace boost {
+namespace compute {
+
+/// The buffer_pool class caches released \ref buffer objects for reuse.
+///
+/// Creating and releasing OpenCL memory objects is relatively expensive.
+/// Algorithms which need temporary storage (e.g. \ref sort() and
+/// \ref reduce()) draw their buffers from the global pool for their
+/// context, so repeated calls with similar input sizes reuse the same
+/// memory instead of calling \c clCreateBuffer() each time.
+///
+/// Buffer sizes are rounded up to a size class (one of eight evenly
+/// spaced steps between consecutive powers of two) so that requests of
+/// similar size share cached buffers while wasting at most 12.5% of the
+/// allocated memory.
+///
+/// Buffers released with a command queue are only handed out again to
+/// that same (in-order) queue straight away. Other queues receive them
+/// once all commands previously enqueued on the releasing queue have
+/// completed.
+///
+/// The total size of the idle buffers held by the pool never exceeds its
+/// limit (see set_limit()). The least recently released buffers are freed
+/// first when the limit is reached.
+///
+/// For example, to trim the global pool for a context once a burst of
+/// work has finished:
+/// \code
+/// boost::compute::buffer_pool::get_global_pool(context)->trim();
+/// \endcode
+///
+/// The buffers handed out by the pool and its idle buffers are counted in
+/// the memory_usage of the context.
+///
+/// \see pooled_allocator, program_cache, memory_usage
+class buffer_pool : boost::noncopyable
+{
+public:
+    /// Creates a new buffer pool for \p context which holds at most
+    /// \p limit bytes of idle buffers.
+    buffer_pool(const context &context, size_t limit)
+        : m_context(context),
+          m_usage(memory_usage::get_global_usage(context)),
+          m_limit(limit),
+          m_cached_size(0),
+          m_hits(0),
+          m_misses(0)
+    {
+    }
+
+    /// Creates a new buffer pool for \p context. The limit defaults to one
+    /// eighth of the global memory size of the context's device.
+    explicit buffer_pool(const context &context)
+        : m_context(context),
+          m_usage(memory_usage::get_global_usage(context)),
+          m_limit(default_limit(context)),
+          m_cached_size(0),
+          m_hits(0),
+          m_misses(0)
+    {
+    }
+
+    /// Destroys the buffer pool and releases all of its idle buffers.
+    ~buffer_pool()
+    {
+        m_usage->deallocated(memory_usage::cached, m_cached_size);
+    }
+
+    /// Returns the context for the pool.
+    const context& get_context() const
+    {
+        return m_context;
+    }
+
+    /// Returns a read-write buffer with space for at least \p size bytes
+    /// which may be used with commands enqueued on \p queue.
+    buffer allocate(size_t size, const command_queue &queue)
+    {
+        return allocate_impl(size, &queue);
+    }
+
+    /// Returns a read-write buffer with space for at least \p size bytes
+    /// which is not used by any pending command.
+    buffer allocate(size_t size)
+    {
+        return allocate_impl(size, 0);
+    }
+
+    /// Returns \p buf to the pool. Commands using \p buf may still be
+    /// pending on \p queue.
+    void release(const buffer &buf, const command_queue &queue)
+    {
+        release_impl(buf, &queue);
+    }
+
+    /// Returns \p buf to the pool. No commands using \p buf may be pending
+    /// when it is released.
+    void release(const buffer &buf)
+    {
+        release_impl(buf, 0);
+    }
+
+    /// Returns the maximum number of bytes held in idle buffers.
+    size_t limit() const
+    {
+        return m_limit;
+    }
+
+    /// Sets the maximum number of bytes held in idle buffers to \p limit.
+    /// Idle buffers are released until the pool fits within the new limit.
+    void set_limit(size_t limit)
+    {
+        m_limit = limit;
+
+        trim(limit);
+    }
+
+    /// Releases all idle buffers.
+    void trim()
+    {
+        trim(0);
+    }
+
+    /// Releases the least recently used idle buffers until at most
+    /// \p size bytes are held by the pool.
+    void trim(size_t size)
+    {
+        while(m_cached_size > size && !m_list.empty()){
+            evict();
+        }
+    }
+
+    /// Returns the number of bytes currently held in idle buffers.
+    size_t cached_size() const
+    {
+        return m_cached_size;
+    }
+
+    /// Returns the number of idle buffers currently held by the pool.
+    size_t cached_count() const
+    {
+        return m_list.size();
+    }
+
+    /// Returns the number of allocations served from idle buffers.
+    size_t hits() const
+    {
+        return m_hits;
+    }
+
+    /// Returns the number of allocations which created a new buffer.
+    size_t misses() const
+    {
+        return m_misses;
+    }
+
+    /// Returns the size (in bytes) of the buffers the pool allocates for
+    /// requests of \p size bytes.
+    static size_t size_class(size_t size)
+    {
+        const size_t minimum_size = 256;
+
+        if(size <= minimum_size){
+            return minimum_size;
+        }
+
+        // find the largest power of two not greater than size
+        size_t power = minimum_size;
+        while(power <= size / 2){
+            power <<= 1;
+        }
+
+        // round up to the next multiple of one eighth of the power
+        const size_t step = power / 8;
+
+        return ((size + step - 1) / step) * step;
+    }
+
+    /// Returns the global buffer pool for \p context.
+    ///
+    /// This global pool is used internally by Boost.Compute to allocate
+    /// temporary buffers for its algorithms.
+    static boost::shared_ptr<buffer_pool> get_global_pool(const context &context)
+    {
+        typedef detail::lru_cache<cl_context, boost::shared_ptr<buffer_pool> > pool_map;
+
+        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(pool_map, pools, (8));
+
+        boost::optional<boost::shared_ptr<buffer_pool> > pool = pools.get(context.get());
+        if(!pool){
+            pool = boost::make_shared<buffer_pool>(context);
+
+            pools.insert(context.get(), *pool);
+        }
+
+        return *pool;
+    }
+
+private:
+    struct entry
+    {
+        entry(const buffer &buf_, const command_queue *queue_)
+            : buf(buf_)
+        {
+            if(queue_){
+                queue = *queue_;
+            }
+        }
+
+        buffer buf;
+        command_queue queue;
+        event marker;
+    };
+
+    typedef std::list<entry> list_type;
+    typedef std::multimap<size_t, list_type::iterator> map_type;
+
+    static size_t default_limit(const context &context)
+    {
+        return static_cast<size_t>(
+            context.get_device().global_memory_size() / 8
+        );
+    }
+
+    // returns true if the buffer in entry can be used by commands on queue
+    // without racing with commands enqueued before it was released
+    static bool is_reusable(entry &e, const command_queue *queue)
+    {
+        if(!e.queue.get()){
+            // released without a queue, nothing can be pending
+            return true;
+        }
+        else if(queue && queue->get() == e.queue.get() &&
+                !(e.queue.get_properties() &
+                  command_queue::enable_out_of_order_execution)){
+            // commands on the same in-order queue execute after any
+            // commands which used the buffer before it was released
+            return true;
+        }
+
+        if(!e.marker.get()){
+            // wait for the commands on the releasing queue to complete
+            e.queue.enqueue_marker(&e.marker);
+            e.queue.flush();
+        }
+
+        if(e.marker.status() == event::complete){
+            e.queue = command_queue();
+            e.marker = event();
+            return true;
+        }
+
+        return false;
+    }
+
+    buffer allocate_impl(size_t size, const command_queue *queue)
+    {
+        const size_t size_class_ = size_class(size);
+
+        std::pair<map_type::iterator, map_type::iterator> range =
+            m_map.equal_range(size_class_);
+
+        for(map_type::iterator i = range.first; i != range.second; ++i){
+            list_type::iterator j = i->second;
+
+            if(is_reusable(*j, queue)){
+                buffer buf = j->buf;
+
+                m_cached_size -= size_class_;
+                m_list.erase(j);
+                m_map.erase(i);
+                m_hits++;
+
+                m_usage->deallocated(memory_usage::cached, size_class_);
+                m_usage->allocated(memory_usage::temporaries, size_class_);
+
+                return buf;
+            }
+        }
+
+        m_misses++;
+
+        buffer buf(m_context, size_class_, buffer::read_write);
+        m_usage->allocated(memory_usage::temporaries, size_class_);
+
+        return buf;
+    }
+
+    void release_impl(const buffer &buf, const command_queue *queue)
+    {
+        if(!buf.get()){
+            return;
+        }
+
+        const size_t size = buf.size();
+
+        // buffers from the pool always have the size of a size class
+        if(size == size_class(size)){
+            m_usage->deallocated(memory_usage::temporaries, size);
+        }
+
+        if(size > m_limit || size != size_class(size)){
+            // buffer is not cacheable, let it be released
+            return;
+        }
+
+        // evict least recently released buffers until the buffer fits
+        trim(m_limit - size);
+
+        m_list.push_front(entry(buf, queue));
+        m_map.insert(std::make_pair(size, m_list.begin()));
+        m_cached_size += size;
+        m_usage->allocated(memory_usage::cached, size);
+    }
+
+    void evict()
+    {
+        list_type::iterator i = --m_list.end();
+        const size_t size = i->buf.size();
+
+        std::pair<map_type::iterator, map_type::iterator> range =
+            m_map.equal_range(size);
+        for(map_type::iterator j = range.first; j != range.second; ++j){
+            if(j->second == i){
+                m_map.erase(j);
+                break;
+            }
+        }
+
+        m_list.erase(i);
+        m_cached_size -= size;
+        m_usage->deallocated(memory_usage::cached, size);
+    }
+
+private:
+    context m_context;
+    boost::shared_ptr<memory_usage> m_usage;
+    size_t m_limit;
+    size_t m_cached_size;
+    size_t m_hits;
+    size_t m_misses;
+    list_type m_list;
+    map_type m_map;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_BUFFER_POOL_HPP
@@ -0,0 +1,299 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_BUILD_LOG_HPP
+#define BOOST_COMPUTE_UTILITY_BUILD_LOG_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/noncopyable.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/program.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/getenv.hpp>
+#include <boost/compute/detail/mutex.hpp>
+#include <boost/compute/detail/sha1.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \struct program_build_record
+/// \brief A program build recorded by the program_build_log.
+struct program_build_record
+{
+    /// The cache key of the program.
+    std::string key;
+    /// The build options of the program.
+    std::string options;
+    /// The hash of the source and build options of the program, as
+    /// returned by embedded_program_hash().
+    std::string source_hash;
+    /// The name of the first device of the program.
+    std::string device;
+    /// The time (in microseconds) taken by the build, zero for
+    /// asynchronous builds.
+    ulong_ build_time;
+    /// \c true if the program was built from a binary instead of its source.
+    bool from_binary;
+    /// The number of builds of the same source and options recorded so
+    /// far, including this one. Values above one are recompiles (e.g.
+    /// after the program was evicted from a cache or for another context).
+    size_t source_builds;
+    /// \c true if a program with the same key and options was built from
+    /// another source before (e.g. a literal in the source changed).
+    bool source_changed;
+};
+
+/// \class program_build_log
+/// \brief Records the programs built by the program caches.
+///
+/// The program_build_log records every program built by program_cache
+/// (including the programs of the Boost.Compute algorithms) to find
+/// accidental recompiles and the builds causing start-up latency. When
+/// enabled each build is appended to records() and, if an output is set,
+/// written to it as a line of tab-separated fields:
+/// \code
+/// <build time in us> <source|binary> <source hash> <builds of the source> <key> <options> [changed]
+/// \endcode
+///
+/// If a dump directory is set, the source of each program built from source
+/// is written to \c <source hash>.cl in it (preceded by comments with the
+/// key and build options) and its binary to \c <source hash>.bin. The
+/// directory must exist.
+///
+/// The global log is configured with the \c BOOST_COMPUTE_BUILD_LOG
+/// environment variable (a file name, or \c "-" for stderr) and the
+/// \c BOOST_COMPUTE_BUILD_DUMP_DIR environment variable. It is enabled when
+/// either of them is set. For example:
+/// \code
+/// $ BOOST_COMPUTE_BUILD_LOG=- BOOST_COMPUTE_BUILD_DUMP_DIR=/tmp/kernels ./my_app
+/// \endcode
+///
+/// \see program_cache
+class program_build_log : boost::noncopyable
+{
+public:
+    /// Creates a disabled build log.
+    program_build_log()
+        : m_enabled(false),
+          m_output(0)
+    {
+    }
+
+    /// Returns the global build log, configured from the environment.
+    static program_build_log& get_global_log()
+    {
+        static program_build_log log;
+        static const bool configured = log.load_environment();
+        (void) configured;
+
+        return log;
+    }
+
+    /// Enables (or disables) recording builds.
+    void set_enabled(bool enable)
+    {
+        detail::scoped_lock lock(m_mutex);
+        m_enabled = enable;
+    }
+
+    /// Returns \c true if builds are recorded.
+    bool enabled() const
+    {
+        detail::scoped_lock lock(m_mutex);
+        return m_enabled;
+    }
+
+    /// Writes the recorded builds to the file \p file_name (or stderr if
+    /// \p file_name is \c "-"). An empty \p file_name stops writing them.
+    ///
+    /// Throws \c std::runtime_error if the file cannot be opened.
+    void set_output(const std::string &file_name)
+    {
+        detail::scoped_lock lock(m_mutex);
+
+        m_file.close();
+        m_file.clear();
+        m_output = 0;
+
+        if(file_name == "-"){
+            m_output = &std::cerr;
+        }
+        else if(!file_name.empty()){
+            m_file.open(file_name.c_str());
+            if(!m_file){
+                BOOST_THROW_EXCEPTION(std::runtime_error("cannot open " + file_name));
+            }
+            m_output = &m_file;
+        }
+    }
+
+    /// Sets the directory the sources and binaries of the built programs
+    /// are written to. An empty \p path stops writing them.
+    void set_dump_directory(const std::string &path)
+    {
+        detail::scoped_lock lock(m_mutex);
+        m_dump_directory = path;
+    }
+
+    /// Returns the directory the sources and binaries are written to.
+    std::string dump_directory() const
+    {
+        detail::scoped_lock lock(m_mutex);
+        return m_dump_directory;
+    }
+
+    /// Returns the builds recorded so far.
+    std::vector<program_build_record> records() const
+    {
+        detail::scoped_lock lock(m_mutex);
+        return m_records;
+    }
+
+    /// Removes the recorded builds.
+    void clear()
+    {
+        detail::scoped_lock lock(m_mutex);
+        m_records.clear();
+        m_source_builds.clear();
+        m_key_sources.clear();
+    }
+
+    /// Records the build of \p program with \p key and \p options from
+    /// \p source (or its binary if \p from_binary is \c true) which took
+    /// \p build_time microseconds. Does nothing if the log is disabled.
+    void record(const std::string &key,
+                const std::string &options,
+                const std::string &source,
+                const program &program,
+                ulong_ build_time,
+                bool from_binary)
+    {
+        detail::scoped_lock lock(m_mutex);
+        if(!m_enabled){
+            return;
+        }
+
+        program_build_record record;
+        record.key = key;
+        record.options = options;
+        record.source_hash = detail::sha1(options + "\n" + source);
+        record.build_time = build_time;
+        record.from_binary = from_binary;
+        record.source_builds = ++m_source_builds[record.source_hash];
+
+        std::string &key_source = m_key_sources[key + "\n" + options];
+        record.source_changed =
+            !key_source.empty() && key_source != record.source_hash;
+        key_source = record.source_hash;
+
+        const std::vector<device> devices = program.get_devices();
+        if(!devices.empty()){
+            record.device = devices[0].name();
+        }
+
+        m_records.push_back(record);
+
+        if(m_output){
+            *m_output << record.build_time << "\t"
+                      << (record.from_binary ? "binary" : "source") << "\t"
+                      << record.source_hash << "\t"
+                      << record.source_builds << "\t"
+                      << record.key << "\t"
+                      << record.options
+                      << (record.source_changed ? "\tchanged" : "")
+                      << std::endl;
+        }
+
+        if(!m_dump_directory.empty() && !from_binary){
+            dump(record, source, program);
+        }
+    }
+
+private:
+    // configures the log from the environment variables
+    bool load_environment()
+    {
+        const char *output = detail::getenv("BOOST_COMPUTE_BUILD_LOG");
+        const char *directory = detail::getenv("BOOST_COMPUTE_BUILD_DUMP_DIR");
+        if(!output && !directory){
+            return false;
+        }
+
+        if(output){
+            try {
+                set_output(output);
+            }
+            catch(std::runtime_error&){
+                // keep recording the builds without writing them
+            }
+        }
+        if(directory){
+            set_dump_directory(directory);
+        }
+        set_enabled(true);
+
+        return true;
+    }
+
+    void dump(const program_build_record &record,
+              const std::string &source,
+              const program &program)
+    {
+        const std::string path = m_dump_directory + "/" + record.source_hash;
+
+        std::ofstream source_file((path + ".cl").c_str());
+        source_file << "// key: " << record.key << "\n"
+                    << "// options: " << record.options << "\n"
+                    << source;
+
+        if(program.get_devices().size() != 1){
+            return;
+        }
+
+        try {
+            const std::vector<unsigned char> binary = program.binary();
+            if(!binary.empty()){
+                std::ofstream binary_file(
+                    (path + ".bin").c_str(), std::ios::out | std::ios::binary
+                );
+                binary_file.write(
+                    reinterpret_cast<const char *>(&binary[0]),
+                    static_cast<std::streamsize>(binary.size())
+                );
+            }
+        }
+        catch(opencl_error&){
+            // the driver does not provide the binary
+        }
+    }
+
+private:
+    bool m_enabled;
+    std::ostream *m_output;
+    std::ofstream m_file;
+    std::string m_dump_directory;
+    std::vector<program_build_record> m_records;
+    std::map<std::string, size_t> m_source_builds;
+    std::map<std::string, std::string> m_key_sources;
+    mutable detail::mutex m_mutex;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_BUILD_LOG_HPP
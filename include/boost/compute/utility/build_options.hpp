@@ -0,0 +1,209 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_BUILD_OPTIONS_HPP
+#define BOOST_COMPUTE_UTILITY_BUILD_OPTIONS_HPP
+
+#include <string>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/detail/getenv.hpp>
+#include <boost/compute/detail/global_static.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class build_options
+/// \brief Options passed to the compiler when building algorithm kernels.
+///
+/// The kernels generated by the algorithms are built without options by
+/// default. Some kernels (notably the ones of \c transform() and
+/// \c transform_reduce() with math functions) can be significantly faster
+/// when they may relax the IEEE 754 semantics, e.g. with
+/// \c -cl-fast-relaxed-math. The build options of the algorithms are the
+/// default options (see set_default()) combined with the options of the
+/// innermost scoped_build_options on the calling thread.
+///
+/// For example, to run a single transform() with fast math:
+/// \code
+/// {
+///     boost::compute::scoped_build_options options(
+///         boost::compute::build_options::fast_relaxed_math()
+///     );
+///
+///     boost::compute::transform(
+///         input.begin(), input.end(), output.begin(), sqrt<float>(), queue
+///     );
+/// }
+/// \endcode
+///
+/// The options are part of the keys of the program caches, so kernels
+/// built with different options are cached separately.
+///
+/// \see scoped_build_options
+class build_options
+{
+public:
+    /// Creates build options with \p options (e.g. \c "-cl-mad-enable").
+    explicit build_options(const std::string &options = std::string())
+        : m_options(options)
+    {
+    }
+
+    /// Returns the \c -cl-fast-relaxed-math option.
+    static build_options fast_relaxed_math()
+    {
+        return build_options("-cl-fast-relaxed-math");
+    }
+
+    /// Returns the \c -cl-mad-enable option.
+    static build_options mad_enable()
+    {
+        return build_options("-cl-mad-enable");
+    }
+
+    /// Returns the \c -cl-no-signed-zeros option.
+    static build_options no_signed_zeros()
+    {
+        return build_options("-cl-no-signed-zeros");
+    }
+
+    /// Returns the options as passed to the compiler.
+    const std::string& str() const
+    {
+        return m_options;
+    }
+
+    /// Returns \c true if there are no options.
+    bool empty() const
+    {
+        return m_options.empty();
+    }
+
+    /// Returns these options followed by \p other.
+    build_options operator|(const build_options &other) const
+    {
+        if(empty()){
+            return other;
+        }
+        else if(other.empty()){
+            return *this;
+        }
+
+        return build_options(m_options + " " + other.m_options);
+    }
+
+    /// Returns \c true if the options are the same as \p other.
+    bool operator==(const build_options &other) const
+    {
+        return m_options == other.m_options;
+    }
+
+    /// Returns \c true if the options differ from \p other.
+    bool operator!=(const build_options &other) const
+    {
+        return m_options != other.m_options;
+    }
+
+    /// Returns the default build options. They are initialized from the
+    /// \c BOOST_COMPUTE_BUILD_OPTIONS environment variable.
+    static build_options get_default()
+    {
+        return default_options();
+    }
+
+    /// Sets the default build options to \p options.
+    ///
+    /// This should be called before other threads start running
+    /// algorithms.
+    static void set_default(const build_options &options)
+    {
+        default_options() = options;
+    }
+
+    /// Returns the build options of the algorithms called by the current
+    /// thread, i.e. the default options combined with the options of the
+    /// current scoped_build_options.
+    static build_options current()
+    {
+        return default_options() | scoped_options();
+    }
+
+private:
+    static build_options& default_options()
+    {
+        static build_options options(environment_options());
+
+        return options;
+    }
+
+    static std::string environment_options()
+    {
+        const char *options = detail::getenv("BOOST_COMPUTE_BUILD_OPTIONS");
+
+        return options ? std::string(options) : std::string();
+    }
+
+    // the options of the innermost scoped_build_options of the thread
+    static build_options& scoped_options()
+    {
+        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(build_options, options, );
+
+        return options;
+    }
+
+    friend class scoped_build_options;
+
+private:
+    std::string m_options;
+};
+
+/// \class scoped_build_options
+/// \brief Adds build options to the algorithms called in a scope.
+///
+/// The options are added to the ones of the enclosing scope on the
+/// calling thread for the lifetime of the object.
+///
+/// \see build_options
+class scoped_build_options : boost::noncopyable
+{
+public:
+    /// Adds \p options to the build options of the current thread.
+    explicit scoped_build_options(const build_options &options)
+        : m_previous(build_options::scoped_options())
+    {
+        build_options::scoped_options() = m_previous | options;
+    }
+
+    /// Restores the build options of the enclosing scope.
+    ~scoped_build_options()
+    {
+        build_options::scoped_options() = m_previous;
+    }
+
+private:
+    build_options m_previous;
+};
+
+namespace detail {
+
+// returns the options to build an algorithm kernel with, i.e. options
+// following the current build options
+inline std::string algorithm_build_options(const std::string &options)
+{
+    return (build_options::current() | build_options(options)).str();
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_BUILD_OPTIONS_HPP
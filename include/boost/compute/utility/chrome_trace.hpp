@@ -0,0 +1,325 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_CHROME_TRACE_HPP
+#define BOOST_COMPUTE_UTILITY_CHROME_TRACE_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <ostream>
+#include <iomanip>
+#include <algorithm>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/utility/trace.hpp>
+#include <boost/compute/detail/mutex.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+inline const char* chrome_trace_command_name(cl_command_type command)
+{
+    switch(command){
+    case CL_COMMAND_NDRANGE_KERNEL: return "kernel";
+    case CL_COMMAND_READ_BUFFER: return "read_buffer";
+    case CL_COMMAND_WRITE_BUFFER: return "write_buffer";
+    case CL_COMMAND_COPY_BUFFER: return "copy_buffer";
+    #ifdef CL_VERSION_1_2
+    case CL_COMMAND_FILL_BUFFER: return "fill_buffer";
+    #endif
+    default: return "command";
+    }
+}
+
+inline std::string chrome_trace_escape(const std::string &str)
+{
+    std::string escaped;
+    escaped.reserve(str.size());
+    for(size_t i = 0; i < str.size(); i++){
+        const char c = str[i];
+        if(c == '"' || c == '\\'){
+            escaped += '\\';
+            escaped += c;
+        }
+        else if(static_cast<unsigned char>(c) < 0x20){
+            escaped += ' ';
+        }
+        else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+} // end detail namespace
+
+/// \class chrome_trace
+/// \brief A trace listener which exports the traced commands as a Chrome
+///        trace.
+///
+/// The chrome_trace class records the commands enqueued by Boost.Compute
+/// (see trace_listener) and writes them in the Chrome trace event format,
+/// which can be loaded in \c chrome://tracing or the Perfetto UI.
+///
+/// Each command queue is shown as a process with two tracks. The \c host
+/// track shows each command from the time it was enqueued by the host until
+/// it was submitted to the device (\c CL_PROFILING_COMMAND_QUEUED to
+/// \c _SUBMIT), the \c device track shows its execution (\c _START to
+/// \c _END). Gaps on the device track are launch overhead, and transfers
+/// on one queue which do not overlap kernels on another show missing
+/// overlap. Every command is labeled with its kernel name (or transfer
+/// type), the algorithm which enqueued it and the number of bytes moved.
+///
+/// Tracing must be compiled in with \c BOOST_COMPUTE_ENABLE_TRACING and the
+/// command queues must be created with \c command_queue::enable_profiling.
+/// Commands from queues without profiling are ignored.
+///
+/// \code
+/// #define BOOST_COMPUTE_ENABLE_TRACING
+/// #include <boost/compute.hpp>
+///
+/// boost::compute::chrome_trace trace;
+/// boost::compute::set_trace_listener(&trace);
+///
+/// boost::compute::sort(vec.begin(), vec.end(), queue);
+///
+/// boost::compute::set_trace_listener(0);
+/// trace.save("sort.json");
+/// \endcode
+///
+/// The timestamps are taken from the device clock. Commands on queues for
+/// different devices may be offset against each other.
+///
+/// \see trace_listener, set_trace_listener()
+class chrome_trace : public trace_listener
+{
+public:
+    /// Creates a new chrome trace with no recorded commands.
+    chrome_trace()
+        : m_cache_hits(0),
+          m_cache_misses(0)
+    {
+    }
+
+    /// Destroys the chrome trace.
+    ~chrome_trace()
+    {
+    }
+
+    /// Records the command in \p record.
+    void on_enqueue(const trace_record &record)
+    {
+        detail::scoped_lock lock(m_mutex);
+        m_records.push_back(record);
+    }
+
+    /// Counts the program cache lookup.
+    void on_program_cache(const std::string &key, bool hit)
+    {
+        (void) key;
+
+        detail::scoped_lock lock(m_mutex);
+        if(hit){
+            m_cache_hits++;
+        }
+        else {
+            m_cache_misses++;
+        }
+    }
+
+    /// Returns the number of recorded commands.
+    size_t size() const
+    {
+        detail::scoped_lock lock(m_mutex);
+        return m_records.size();
+    }
+
+    /// Removes all recorded commands.
+    void clear()
+    {
+        detail::scoped_lock lock(m_mutex);
+        m_records.clear();
+        m_cache_hits = 0;
+        m_cache_misses = 0;
+    }
+
+    /// Writes the recorded commands as a Chrome trace JSON document to
+    /// \p stream.
+    ///
+    /// This waits for all of the recorded commands to complete.
+    void write(std::ostream &stream) const
+    {
+        detail::scoped_lock lock(m_mutex);
+
+        // queues in the order of their first command
+        std::vector<cl_command_queue> queues;
+        std::map<cl_command_queue, bool> profiled;
+        for(size_t i = 0; i < m_records.size(); i++){
+            const cl_command_queue queue = m_records[i].queue;
+            if(profiled.find(queue) == profiled.end()){
+                profiled[queue] =
+                    (command_queue(queue).get_properties() &
+                     command_queue::enable_profiling) != 0;
+                queues.push_back(queue);
+            }
+        }
+
+        // fetch the timestamps of the commands
+        std::vector<trace_record> records;
+        ulong_ origin = 0;
+        for(size_t i = 0; i < m_records.size(); i++){
+            trace_record record = m_records[i];
+            if(!profiled[record.queue] || !record.event_.get()){
+                continue;
+            }
+
+            record.event_.wait();
+            record.queued =
+                record.event_.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_QUEUED);
+            record.submitted =
+                record.event_.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_SUBMIT);
+            record.started =
+                record.event_.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_START);
+            record.ended =
+                record.event_.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_END);
+
+            if(records.empty() || record.queued < origin){
+                origin = record.queued;
+            }
+            records.push_back(record);
+        }
+
+        const std::ios_base::fmtflags flags = stream.flags();
+        const std::streamsize precision = stream.precision();
+
+        stream << "{\"traceEvents\":[";
+
+        // name the process and tracks of each queue
+        bool first = true;
+        for(size_t q = 0; q < queues.size(); q++){
+            if(!profiled[queues[q]]){
+                continue;
+            }
+
+            const size_t pid = q + 1;
+            command_queue queue(queues[q]);
+            write_separator(stream, first);
+            stream << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":" << pid
+                   << ",\"args\":{\"name\":\"command_queue " << q << " ("
+                   << detail::chrome_trace_escape(queue.get_device().name())
+                   << ")\"}}";
+            write_separator(stream, first);
+            stream << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << pid
+                   << ",\"tid\":1,\"args\":{\"name\":\"host\"}}";
+            write_separator(stream, first);
+            stream << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << pid
+                   << ",\"tid\":2,\"args\":{\"name\":\"device\"}}";
+        }
+
+        // write the host and device spans of each command
+        for(size_t i = 0; i < records.size(); i++){
+            const trace_record &record = records[i];
+            const size_t pid =
+                std::find(queues.begin(), queues.end(), record.queue) -
+                queues.begin() + 1;
+
+            write_separator(stream, first);
+            write_span(stream, record, pid, 1, record.queued, record.submitted, origin);
+            write_separator(stream, first);
+            write_span(stream, record, pid, 2, record.started, record.ended, origin);
+        }
+
+        stream << "],\"displayTimeUnit\":\"ns\",\"otherData\":{"
+               << "\"program_cache_hits\":" << m_cache_hits
+               << ",\"program_cache_misses\":" << m_cache_misses
+               << "}}\n";
+
+        stream.flags(flags);
+        stream.precision(precision);
+    }
+
+    /// Writes the recorded commands as a Chrome trace JSON document to the
+    /// file at \p path.
+    ///
+    /// \throws opencl_error if the file can not be written.
+    void save(const std::string &path) const
+    {
+        std::ofstream file(path.c_str());
+        if(file){
+            write(file);
+        }
+        if(!file){
+            BOOST_THROW_EXCEPTION(opencl_error(CL_INVALID_VALUE));
+        }
+    }
+
+private:
+    static void write_separator(std::ostream &stream, bool &first)
+    {
+        if(!first){
+            stream << ",\n";
+        }
+        first = false;
+    }
+
+    static void write_span(std::ostream &stream,
+                           const trace_record &record,
+                           size_t pid,
+                           size_t tid,
+                           ulong_ begin,
+                           ulong_ end,
+                           ulong_ origin)
+    {
+        const std::string name =
+            record.kernel.empty() ?
+                std::string(detail::chrome_trace_command_name(record.command)) :
+                record.kernel;
+
+        // chrome traces are in microseconds
+        const double ts = static_cast<double>(begin - origin) / 1000.0;
+        const double dur =
+            static_cast<double>(end > begin ? end - begin : 0) / 1000.0;
+
+        stream << "{\"ph\":\"X\",\"name\":\""
+               << detail::chrome_trace_escape(name)
+               << "\",\"cat\":\""
+               << (record.algorithm.empty() ?
+                      "api" : detail::chrome_trace_escape(record.algorithm))
+               << "\",\"pid\":" << pid
+               << ",\"tid\":" << tid
+               << std::fixed << std::setprecision(3)
+               << ",\"ts\":" << ts
+               << ",\"dur\":" << dur
+               << ",\"args\":{\"algorithm\":\""
+               << detail::chrome_trace_escape(record.algorithm)
+               << "\",\"command\":\""
+               << detail::chrome_trace_command_name(record.command)
+               << "\",\"bytes\":" << record.bytes
+               << "}}";
+    }
+
+private:
+    mutable detail::mutex m_mutex;
+    std::vector<trace_record> m_records;
+    size_t m_cache_hits;
+    size_t m_cache_misses;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_CHROME_TRACE_HPP
@@ -0,0 +1,376 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_COPY_BATCH_HPP
+#define BOOST_COMPUTE_UTILITY_COPY_BATCH_HPP
+
+#include <cstring>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include <boost/assert.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/utility/wait_list.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/pinned_host_pool.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class copy_batch
+/// \brief A list of host ranges to copy to the device with a single
+///        transfer.
+///
+/// Copying many small host arrays with copy() enqueues one write (and
+/// pays the driver overhead of one transfer) per array. A copy_batch
+/// collects the ranges and their destinations and, when enqueued, packs
+/// all of them into one pinned staging block, writes it to the device with
+/// one transfer and scatters it into the destinations with one kernel
+/// (or one kernel per max_buffers() distinct destination buffers).
+///
+/// \code
+/// boost::compute::copy_batch batch;
+/// for(size_t i = 0; i < requests.size(); i++){
+///     batch.add(requests[i].features, features.begin() + offsets[i]);
+/// }
+///
+/// boost::compute::future<void> uploaded = batch.enqueue(queue);
+/// \endcode
+///
+/// The host values are packed by enqueue(), so they only have to stay
+/// valid until it returns. The returned future completes with the last
+/// command of the batch, which is the last one to complete on an in-order
+/// queue.
+///
+/// Ranges whose (byte) offset and size are multiples of four are
+/// scattered by the kernel. Other ranges are copied from the staging
+/// buffer on the device with one command each.
+///
+/// \see fill_batch, copy_async()
+class copy_batch
+{
+public:
+    /// Creates an empty batch.
+    copy_batch()
+    {
+    }
+
+    /// Adds the \p size bytes at \p host_ptr, copied to \p offset in
+    /// \p buffer.
+    void add(const void *host_ptr, size_t size, const buffer &buffer, size_t offset)
+    {
+        BOOST_ASSERT(offset + size <= buffer.size());
+
+        if(size == 0){
+            return;
+        }
+
+        range r;
+        r.host_ptr = host_ptr;
+        r.size = size;
+        r.buf = buffer;
+        r.offset = offset;
+        m_ranges.push_back(r);
+    }
+
+    /// Adds the values in the host range [\p first, \p last), copied to
+    /// the range beginning at \p result.
+    template<class T>
+    void add(const T *first, const T *last, const buffer_iterator<T> &result)
+    {
+        add(
+            first,
+            static_cast<size_t>(last - first) * sizeof(T),
+            result.get_buffer(),
+            result.get_index() * sizeof(T)
+        );
+    }
+
+    /// Adds the values in \p values, copied to the range beginning at
+    /// \p result.
+    template<class T, class Alloc>
+    void add(const std::vector<T, Alloc> &values, const buffer_iterator<T> &result)
+    {
+        if(!values.empty()){
+            add(&values[0], &values[0] + values.size(), result);
+        }
+    }
+
+    /// Returns the number of ranges in the batch.
+    size_t size() const
+    {
+        return m_ranges.size();
+    }
+
+    /// Returns \c true if the batch has no ranges.
+    bool empty() const
+    {
+        return m_ranges.empty();
+    }
+
+    /// Returns the number of bytes copied by the batch.
+    size_t size_bytes() const
+    {
+        size_t bytes = 0;
+        for(size_t i = 0; i < m_ranges.size(); i++){
+            bytes += m_ranges[i].size;
+        }
+        return bytes;
+    }
+
+    /// Removes all of the ranges from the batch.
+    void clear()
+    {
+        m_ranges.clear();
+    }
+
+    /// Returns the number of distinct destination buffers scattered into
+    /// by each kernel launch.
+    static size_t max_buffers()
+    {
+        return 16;
+    }
+
+    /// Enqueues the copies to \p queue and returns a future for the last
+    /// command (or an invalid future if the batch is empty).
+    future<void> enqueue(command_queue &queue = system::default_queue()) const
+    {
+        if(m_ranges.empty()){
+            return future<void>();
+        }
+
+        // group the ranges of whole words by their destination buffers,
+        // each group is scattered by one kernel launch
+        std::vector<launch> launches;
+        std::vector<size_t> other_ranges;
+        for(size_t i = 0; i < m_ranges.size(); i++){
+            const range &r = m_ranges[i];
+            if(r.offset % 4 != 0 || r.size % 4 != 0){
+                other_ranges.push_back(i);
+                continue;
+            }
+
+            size_t slot = launches.empty() ? 0 : launches.back().buffers.size();
+            if(!launches.empty()){
+                const std::vector<buffer> &buffers = launches.back().buffers;
+                slot = std::find(buffers.begin(), buffers.end(), r.buf) - buffers.begin();
+            }
+            if(launches.empty() ||
+               (slot == launches.back().buffers.size() && slot == max_buffers())){
+                launches.push_back(launch());
+                slot = 0;
+            }
+            if(slot == launches.back().buffers.size()){
+                launches.back().buffers.push_back(r.buf);
+            }
+            launches.back().ranges.push_back(std::make_pair(i, slot));
+        }
+
+        // the staging block holds the range table of each launch (the
+        // cumulative end, destination slot, destination offset and source
+        // offset, in words, of each range) followed by the values of the
+        // ranges, each beginning on a word boundary
+        size_t table_words = 0;
+        for(size_t i = 0; i < launches.size(); i++){
+            table_words += 4 * launches[i].ranges.size();
+        }
+
+        size_t total = table_words * 4;
+        std::vector<size_t> source_offsets(m_ranges.size());
+        for(size_t i = 0; i < m_ranges.size(); i++){
+            source_offsets[i] = total;
+            total += (m_ranges[i].size + 3) / 4 * 4;
+        }
+        BOOST_ASSERT(total / 4 <= size_t(static_cast<uint_>(-1)));
+
+        const context &context = queue.get_context();
+        boost::shared_ptr<detail::pinned_host_pool> pool =
+            detail::pinned_host_pool::get_global_pool(context);
+        const detail::pinned_host_pool::block block = pool->allocate(total);
+
+        unsigned char *staging_ptr = static_cast<unsigned char *>(block.ptr);
+        uint_ *table = reinterpret_cast<uint_ *>(staging_ptr);
+        for(size_t i = 0; i < launches.size(); i++){
+            uint_ end = 0;
+            for(size_t j = 0; j < launches[i].ranges.size(); j++){
+                const range &r = m_ranges[launches[i].ranges[j].first];
+                end += static_cast<uint_>(r.size / 4);
+
+                *table++ = end;
+                *table++ = static_cast<uint_>(launches[i].ranges[j].second);
+                *table++ = static_cast<uint_>(r.offset / 4);
+                *table++ = static_cast<uint_>(
+                    source_offsets[launches[i].ranges[j].first] / 4
+                );
+            }
+            launches[i].words = end;
+        }
+        for(size_t i = 0; i < m_ranges.size(); i++){
+            std::memcpy(
+                staging_ptr + source_offsets[i], m_ranges[i].host_ptr, m_ranges[i].size
+            );
+        }
+
+        // the one transfer of the batch
+        buffer staging(context, total, buffer::read_only);
+        event write = queue.enqueue_write_buffer_async(staging, 0, total, block.ptr);
+
+        // the staging block is returned to the pool once it was transferred
+        #ifdef CL_VERSION_1_1
+        write.set_callback(release_block(pool, block));
+        #else
+        write.wait();
+        pool->release(block);
+        #endif
+
+        event event_ = write;
+        size_t table_offset = 0;
+        for(size_t i = 0; i < launches.size(); i++){
+            event_ = enqueue_kernel(launches[i], staging, table_offset, write, queue);
+            table_offset += 4 * launches[i].ranges.size();
+        }
+
+        for(size_t i = 0; i < other_ranges.size(); i++){
+            const range &r = m_ranges[other_ranges[i]];
+
+            queue.enqueue_copy_buffer(
+                staging, r.buf, source_offsets[other_ranges[i]], r.offset, r.size,
+                wait_list(write), &event_
+            );
+        }
+
+        return future<void>(event_);
+    }
+
+private:
+    struct range
+    {
+        const void *host_ptr;
+        size_t size;
+        buffer buf;
+        size_t offset;
+    };
+
+    struct launch
+    {
+        launch()
+            : words(0)
+        {
+        }
+
+        std::vector<buffer> buffers;
+        // the index of each range and the slot of its buffer
+        std::vector<std::pair<size_t, size_t> > ranges;
+        uint_ words;
+    };
+
+    #ifdef CL_VERSION_1_1
+    struct release_block
+    {
+        release_block(const boost::shared_ptr<detail::pinned_host_pool> &pool_,
+                      const detail::pinned_host_pool::block &block_)
+            : pool(pool_),
+              block(block_)
+        {
+        }
+
+        void operator()() const
+        {
+            pool->release(block);
+        }
+
+        boost::shared_ptr<detail::pinned_host_pool> pool;
+        detail::pinned_host_pool::block block;
+    };
+    #endif // CL_VERSION_1_1
+
+    // scatters the ranges of l with one kernel where each work-item copies
+    // one word, its range is found by a binary search of the range table
+    static event enqueue_kernel(const launch &l,
+                                const buffer &staging,
+                                size_t table_offset,
+                                const event &write,
+                                command_queue &queue)
+    {
+        detail::meta_kernel k("copy_batch");
+
+        const size_t staging_arg =
+            k.add_arg<uint_ *>(memory_object::global_memory, "staging");
+        const size_t table_arg = k.add_arg<const uint_>("table");
+        const size_t ranges_arg = k.add_arg<const uint_>("ranges");
+        std::vector<size_t> buffer_args(l.buffers.size());
+        for(size_t i = 0; i < l.buffers.size(); i++){
+            buffer_args[i] = k.add_arg<uint_ *>(
+                memory_object::global_memory, "buffer" + index_string(i)
+            );
+        }
+
+        k << "const uint i = get_global_id(0);\n"
+          << "uint lo = 0;\n"
+          << "uint hi = ranges;\n"
+          << "while(lo < hi){\n"
+          << "    const uint mid = (lo + hi) / 2;\n"
+          << "    if(staging[table + mid * 4] <= i){\n"
+          << "        lo = mid + 1;\n"
+          << "    }\n"
+          << "    else {\n"
+          << "        hi = mid;\n"
+          << "    }\n"
+          << "}\n"
+          << "const uint entry = table + lo * 4;\n"
+          << "const uint j = i - (lo > 0 ? staging[entry - 4] : 0);\n"
+          << "const uint value = staging[staging[entry + 3] + j];\n"
+          << "const uint output = staging[entry + 2] + j;\n"
+          << "switch(staging[entry + 1]){\n";
+        for(size_t i = 0; i < l.buffers.size(); i++){
+            k << "case " << uint_(i) << ": buffer" << i << "[output] = value; break;\n";
+        }
+        k << "}\n";
+
+        k.set_arg(staging_arg, staging);
+        k.set_arg(table_arg, static_cast<uint_>(table_offset));
+        k.set_arg(ranges_arg, static_cast<uint_>(l.ranges.size()));
+        for(size_t i = 0; i < l.buffers.size(); i++){
+            k.set_arg(buffer_args[i], l.buffers[i]);
+        }
+
+        ::boost::compute::kernel kernel = k.compile(queue.get_context());
+
+        event event_;
+        queue.enqueue_1d_range_kernel(kernel, 0, l.words, 0, wait_list(write), &event_);
+        return event_;
+    }
+
+    static std::string index_string(size_t i)
+    {
+        std::stringstream stream;
+        stream << i;
+        return stream.str();
+    }
+
+private:
+    std::vector<range> m_ranges;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_COPY_BATCH_HPP
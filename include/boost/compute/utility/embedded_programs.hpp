@@ -0,0 +1,300 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_EMBEDDED_PROGRAMS_HPP
+#define BOOST_COMPUTE_UTILITY_EMBEDDED_PROGRAMS_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <ostream>
+#include <utility>
+#include <stdexcept>
+
+#include <boost/optional.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/compute/context.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/program.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/detail/mutex.hpp>
+#include <boost/compute/detail/sha1.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \struct embedded_program
+/// \brief A program binary embedded in the executable.
+///
+/// Embedded programs are normally generated at build time with the
+/// \c boost_compute_embed_programs() CMake function (or
+/// write_embedded_programs()) and registered with
+/// register_embedded_programs(). The program caches create programs from
+/// a matching embedded binary instead of compiling their source.
+///
+/// \see embedded_program_registration
+struct embedded_program
+{
+    /// The hash of the source and build options of the program, as
+    /// returned by embedded_program_hash().
+    const char *hash;
+    /// The name of the device the binary was built for, or an empty string
+    /// for an intermediate language (SPIR-V) binary for any device.
+    const char *device;
+    /// The binary.
+    const unsigned char *binary;
+    /// The size of the binary in bytes.
+    size_t size;
+};
+
+/// Returns the hash identifying the program built from \p source with
+/// \p options in the embedded programs.
+inline std::string embedded_program_hash(const std::string &source,
+                                         const std::string &options)
+{
+    return detail::sha1(options + "\n" + source);
+}
+
+namespace detail {
+
+// the registered embedded programs and the binaries recorded for
+// write_embedded_programs()
+struct embedded_program_registry
+{
+    typedef std::pair<std::string, std::string> key_type;
+
+    struct recorded_program
+    {
+        std::string hash;
+        std::string device;
+        std::vector<unsigned char> binary;
+    };
+
+    embedded_program_registry()
+        : recording(false)
+    {
+    }
+
+    static embedded_program_registry& get()
+    {
+        static embedded_program_registry registry;
+
+        return registry;
+    }
+
+    mutex mutex_;
+    std::map<key_type, embedded_program> programs;
+    bool recording;
+    std::vector<recorded_program> recorded;
+};
+
+// returns the embedded program with hash for the device of context (or
+// for any device), unbuilt
+inline boost::optional<program>
+create_embedded_program(const std::string &hash, const context &context)
+{
+    embedded_program_registry &registry = embedded_program_registry::get();
+
+    boost::optional<embedded_program> binary;
+    boost::optional<embedded_program> il;
+    {
+        scoped_lock lock(registry.mutex_);
+
+        if(registry.programs.empty()){
+            return boost::none;
+        }
+
+        typedef std::map<embedded_program_registry::key_type, embedded_program> map_type;
+
+        map_type::const_iterator i = registry.programs.find(
+            std::make_pair(hash, context.get_device().name())
+        );
+        if(i != registry.programs.end()){
+            binary = i->second;
+        }
+
+        i = registry.programs.find(std::make_pair(hash, std::string()));
+        if(i != registry.programs.end()){
+            il = i->second;
+        }
+    }
+
+    try {
+        if(binary){
+            return program::create_with_binary(binary->binary, binary->size, context);
+        }
+        #ifdef CL_VERSION_2_1
+        if(il){
+            return program::create_with_il(il->binary, il->size, context);
+        }
+        #endif
+    }
+    catch(opencl_error&){
+        // the binary is not valid for the device (e.g. another driver)
+    }
+
+    return boost::none;
+}
+
+// records the binary of program built with hash if recording is enabled
+inline void record_embedded_program(const std::string &hash, const program &program)
+{
+    embedded_program_registry &registry = embedded_program_registry::get();
+
+    scoped_lock lock(registry.mutex_);
+    if(!registry.recording){
+        return;
+    }
+
+    embedded_program_registry::recorded_program recorded;
+    recorded.hash = hash;
+    recorded.device = program.get_devices()[0].name();
+    recorded.binary = program.binary();
+
+    for(size_t i = 0; i < registry.recorded.size(); i++){
+        if(registry.recorded[i].hash == recorded.hash &&
+           registry.recorded[i].device == recorded.device){
+            return;
+        }
+    }
+    registry.recorded.push_back(recorded);
+}
+
+} // end detail namespace
+
+/// Registers the \p count embedded programs in \p programs. The programs
+/// must stay valid until the end of the process (they are normally static
+/// arrays).
+///
+/// \see embedded_program_registration
+inline void register_embedded_programs(const embedded_program *programs, size_t count)
+{
+    detail::embedded_program_registry &registry =
+        detail::embedded_program_registry::get();
+
+    detail::scoped_lock lock(registry.mutex_);
+
+    for(size_t i = 0; i < count; i++){
+        registry.programs[std::make_pair(std::string(programs[i].hash),
+                                         std::string(programs[i].device))] = programs[i];
+    }
+}
+
+/// \class embedded_program_registration
+/// \brief Registers embedded programs during static initialization.
+///
+/// The sources generated by write_embedded_programs() define a static
+/// embedded_program_registration object so the programs are registered
+/// before main() runs.
+class embedded_program_registration
+{
+public:
+    /// Registers the \p count embedded programs in \p programs.
+    embedded_program_registration(const embedded_program *programs, size_t count)
+    {
+        register_embedded_programs(programs, count);
+    }
+};
+
+/// Enables (or disables) recording the binaries of the programs which the
+/// program caches build from source, for write_embedded_programs().
+///
+/// For example, to record the programs of the sort algorithm for \c int:
+/// \code
+/// boost::compute::record_embedded_programs(true);
+/// boost::compute::warmup<int>(boost::compute::warmup_sort, queue);
+/// boost::compute::write_embedded_programs("embedded_programs.cpp", "sort");
+/// \endcode
+inline void record_embedded_programs(bool enable)
+{
+    detail::embedded_program_registry &registry =
+        detail::embedded_program_registry::get();
+
+    detail::scoped_lock lock(registry.mutex_);
+    registry.recording = enable;
+}
+
+/// Writes the recorded program binaries to \p stream as a C++ source file
+/// which registers them as embedded programs when linked into an
+/// executable. \p name must be a valid C++ identifier, it prefixes the
+/// names of the arrays.
+inline void write_embedded_programs(std::ostream &stream, const std::string &name)
+{
+    detail::embedded_program_registry &registry =
+        detail::embedded_program_registry::get();
+
+    detail::scoped_lock lock(registry.mutex_);
+
+    const std::vector<detail::embedded_program_registry::recorded_program> &recorded =
+        registry.recorded;
+
+    stream << "// generated by boost::compute::write_embedded_programs()\n"
+           << "#include <boost/compute/utility/embedded_programs.hpp>\n\n"
+           << "namespace {\n\n";
+
+    static const char digits[] = "0123456789abcdef";
+    for(size_t i = 0; i < recorded.size(); i++){
+        const std::vector<unsigned char> &binary = recorded[i].binary;
+
+        stream << "const unsigned char " << name << "_binary_" << i << "[] = {";
+        for(size_t j = 0; j < binary.size(); j++){
+            stream << (j % 16 == 0 ? "\n    " : " ")
+                   << "0x" << digits[binary[j] >> 4] << digits[binary[j] & 0xf] << ",";
+        }
+        if(binary.empty()){
+            stream << " 0";
+        }
+        stream << "\n};\n\n";
+    }
+
+    stream << "const boost::compute::embedded_program " << name << "_programs[] = {\n";
+    for(size_t i = 0; i < recorded.size(); i++){
+        std::string device;
+        for(size_t j = 0; j < recorded[i].device.size(); j++){
+            const char c = recorded[i].device[j];
+            if(c == '"' || c == '\\'){
+                device += '\\';
+            }
+            device += c;
+        }
+
+        stream << "    { \"" << recorded[i].hash << "\", \"" << device << "\", "
+               << name << "_binary_" << i << ", "
+               << recorded[i].binary.size() << " },\n";
+    }
+    if(recorded.empty()){
+        stream << "    { \"\", \"\", 0, 0 },\n";
+    }
+    stream << "};\n\n"
+           << "const boost::compute::embedded_program_registration " << name << "_registration(\n"
+           << "    " << name << "_programs, " << recorded.size() << "\n"
+           << ");\n\n"
+           << "} // end anonymous namespace\n";
+}
+
+/// Writes the recorded program binaries to the file \p file_name.
+///
+/// \see write_embedded_programs(std::ostream&, const std::string&)
+inline void write_embedded_programs(const std::string &file_name, const std::string &name)
+{
+    std::ofstream stream(file_name.c_str());
+    if(!stream){
+        BOOST_THROW_EXCEPTION(std::runtime_error("cannot open " + file_name));
+    }
+
+    write_embedded_programs(stream, name);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_EMBEDDED_PROGRAMS_HPP
@@ -0,0 +1,273 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_FILL_BATCH_HPP
+#define BOOST_COMPUTE_UTILITY_FILL_BATCH_HPP
+
+#include <cstring>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class fill_batch
+/// \brief A list of buffer ranges to fill with a single kernel.
+///
+/// Filling many small buffers (e.g. clearing the counters of an
+/// iteration) with fill() or command_queue::enqueue_fill_buffer() enqueues
+/// one command per buffer. A fill_batch collects the ranges and their
+/// patterns and fills all of them with one kernel launch (or one launch
+/// per max_ranges() ranges).
+///
+/// The batch keeps its ranges after enqueue() so that the same fills can
+/// be repeated each iteration:
+/// \code
+/// boost::compute::fill_batch clear;
+/// clear.add(counts.begin(), counts.end(), 0);
+/// clear.add(histogram.begin(), histogram.end(), 0);
+///
+/// for(;;){
+///     clear.enqueue(queue);
+///     ...
+/// }
+/// \endcode
+///
+/// Ranges whose (byte) offset and size are multiples of four with a
+/// pattern of 1, 2, 4, 8 or 16 bytes are filled by the kernel. Other
+/// ranges are filled with one command each.
+///
+/// \see fill()
+class fill_batch
+{
+public:
+    /// Creates an empty batch.
+    fill_batch()
+    {
+    }
+
+    /// Adds the \p size bytes at \p offset in \p buffer, filled with
+    /// \p pattern. \p size must be a multiple of \c sizeof(T) (which is at
+    /// most 16 bytes).
+    template<class T>
+    void add(const buffer &buffer, size_t offset, size_t size, const T &pattern)
+    {
+        BOOST_STATIC_ASSERT(sizeof(T) <= 16);
+        BOOST_ASSERT(size % sizeof(T) == 0);
+        BOOST_ASSERT(offset + size <= buffer.size());
+
+        if(size == 0){
+            return;
+        }
+
+        range r;
+        r.buf = buffer;
+        r.offset = offset;
+        r.size = size;
+        r.pattern_size = sizeof(T);
+        std::memcpy(r.pattern, &pattern, sizeof(T));
+
+        // repeat the pattern over the 16 bytes loaded by the kernel
+        for(size_t i = sizeof(T); i < 16; i++){
+            r.pattern[i] = r.pattern[i % sizeof(T)];
+        }
+
+        if(is_power_of_two(sizeof(T)) && offset % 4 == 0 && size % 4 == 0){
+            m_ranges.push_back(r);
+        }
+        else {
+            m_other_ranges.push_back(r);
+        }
+    }
+
+    /// Adds the range [\p first, \p last) filled with \p value.
+    template<class T, class Value>
+    void add(const buffer_iterator<T> &first,
+             const buffer_iterator<T> &last,
+             const Value &value)
+    {
+        add(
+            first.get_buffer(),
+            first.get_index() * sizeof(T),
+            static_cast<size_t>(last - first) * sizeof(T),
+            static_cast<T>(value)
+        );
+    }
+
+    /// Returns the number of ranges in the batch.
+    size_t size() const
+    {
+        return m_ranges.size() + m_other_ranges.size();
+    }
+
+    /// Returns \c true if the batch has no ranges.
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /// Removes all of the ranges from the batch.
+    void clear()
+    {
+        m_ranges.clear();
+        m_other_ranges.clear();
+    }
+
+    /// Returns the number of ranges filled by each kernel launch.
+    static size_t max_ranges()
+    {
+        // four arguments per range, well below the minimum of 1024 bytes
+        // of kernel arguments
+        return 16;
+    }
+
+    /// Enqueues the fills to \p queue and returns an event for the last
+    /// command (or a null event if the batch is empty).
+    event enqueue(command_queue &queue = system::default_queue()) const
+    {
+        event event_;
+
+        for(size_t i = 0; i < m_ranges.size(); i += max_ranges()){
+            const size_t count = (std::min)(max_ranges(), m_ranges.size() - i);
+
+            event_ = enqueue_kernel(&m_ranges[i], count, queue);
+        }
+
+        for(size_t i = 0; i < m_other_ranges.size(); i++){
+            const range &r = m_other_ranges[i];
+
+            #ifdef CL_VERSION_1_2
+            if(queue.get_version() >= 120 &&
+               is_power_of_two(r.pattern_size) &&
+               r.offset % r.pattern_size == 0){
+                queue.enqueue_fill_buffer(
+                    r.buf, r.pattern, r.pattern_size, r.offset, r.size,
+                    wait_list(), &event_
+                );
+                continue;
+            }
+            #endif // CL_VERSION_1_2
+
+            std::vector<unsigned char> data(r.size);
+            for(size_t j = 0; j < r.size; j++){
+                data[j] = r.pattern[j % r.pattern_size];
+            }
+            queue.enqueue_write_buffer(r.buf, r.offset, r.size, &data[0]);
+
+            // the blocking write completed after the previous commands
+            event_ = event();
+        }
+
+        return event_;
+    }
+
+private:
+    struct range
+    {
+        buffer buf;
+        size_t offset;
+        size_t size;
+        size_t pattern_size;
+        unsigned char pattern[16];
+    };
+
+    // fills count ranges (of whole words) with one kernel where each
+    // work-item writes one word
+    static event enqueue_kernel(const range *ranges,
+                                size_t count,
+                                command_queue &queue)
+    {
+        detail::meta_kernel k("fill_batch");
+
+        std::vector<size_t> buffer_args(count);
+        std::vector<size_t> pattern_args(count);
+        std::vector<size_t> offset_args(count);
+        std::vector<size_t> end_args(count);
+        for(size_t i = 0; i < count; i++){
+            const std::string suffix = index_string(i);
+
+            buffer_args[i] = k.add_arg<uint_ *>(
+                memory_object::global_memory, "buffer" + suffix
+            );
+            offset_args[i] = k.add_arg<const uint_>("offset" + suffix);
+            end_args[i] = k.add_arg<const uint_>("end" + suffix);
+            pattern_args[i] = k.add_arg<const uint4_>("pattern" + suffix);
+        }
+
+        // find the range of the work-item from the (cumulative) ends
+        k << "const uint i = get_global_id(0);\n"
+          << "__global uint *output;\n"
+          << "uint4 pattern;\n"
+          << "uint j;\n";
+        for(size_t i = 0; i < count; i++){
+            k << (i == 0 ? "if" : "else if") << "(i < end" << i << "){\n"
+              << "    output = buffer" << i << " + offset" << i << ";\n"
+              << "    pattern = pattern" << i << ";\n"
+              << "    j = i" << (i == 0 ? std::string() : " - end" + index_string(i - 1)) << ";\n"
+              << "}\n";
+        }
+        k << "else\n"
+          << "    return;\n"
+          << "const uint k = j & 3;\n"
+          << "output[j] = k == 0 ? pattern.x : k == 1 ? pattern.y :\n"
+          << "            k == 2 ? pattern.z : pattern.w;\n";
+
+        size_t words = 0;
+        for(size_t i = 0; i < count; i++){
+            const range &r = ranges[i];
+            words += r.size / 4;
+            BOOST_ASSERT(words <= size_t(static_cast<uint_>(-1)));
+
+            uint4_ pattern;
+            std::memcpy(&pattern, r.pattern, sizeof(pattern));
+
+            k.set_arg(buffer_args[i], r.buf);
+            k.set_arg(offset_args[i], static_cast<uint_>(r.offset / 4));
+            k.set_arg(end_args[i], static_cast<uint_>(words));
+            k.set_arg(pattern_args[i], pattern);
+        }
+
+        return k.exec_1d(queue, 0, words);
+    }
+
+    static bool is_power_of_two(size_t n)
+    {
+        return (n & (n - 1)) == 0;
+    }
+
+    static std::string index_string(size_t i)
+    {
+        std::stringstream stream;
+        stream << i;
+        return stream.str();
+    }
+
+private:
+    std::vector<range> m_ranges;
+    std::vector<range> m_other_ranges;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_FILL_BATCH_HPP
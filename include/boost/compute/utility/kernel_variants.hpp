@@ -0,0 +1,368 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_KERNEL_VARIANTS_HPP
+#define BOOST_COMPUTE_UTILITY_KERNEL_VARIANTS_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/mutex.hpp>
+#include <boost/compute/detail/nvidia_compute_capability.hpp>
+#include <boost/compute/detail/sub_group.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class device_requirements
+/// \brief Describes the devices a kernel variant is suited for.
+///
+/// The requirements are built up by chaining calls to the member
+/// functions, a device matches if it meets all of them. For example, the
+/// requirements of a kernel tuned for NVIDIA GPUs of compute capability
+/// 3.0 or later with OpenCL 1.2:
+/// \code
+/// boost::compute::device_requirements()
+///     .vendor("NVIDIA")
+///     .type(boost::compute::device::gpu)
+///     .version(1, 2)
+///     .nvidia_compute_capability(3, 0)
+/// \endcode
+///
+/// \see kernel_variant_registry
+class device_requirements
+{
+public:
+    /// Creates requirements which every device meets.
+    device_requirements()
+        : m_type(0),
+          m_version(0),
+          m_local_memory(false),
+          m_sub_groups(false),
+          m_nvidia_major(0),
+          m_nvidia_minor(0)
+    {
+    }
+
+    /// Requires \p vendor to be part of the vendor name of the device or
+    /// of its platform (e.g. \c "NVIDIA", \c "Intel" or
+    /// \c "Advanced Micro Devices").
+    device_requirements& vendor(const std::string &vendor)
+    {
+        m_vendors.push_back(vendor);
+        return *this;
+    }
+
+    /// Requires the device type to be one of the types in \p type (e.g.
+    /// \c device::cpu or \c device::gpu).
+    device_requirements& type(cl_device_type type)
+    {
+        m_type = type;
+        return *this;
+    }
+
+    /// Requires at least OpenCL version \p major.\p minor.
+    device_requirements& version(uint_ major, uint_ minor)
+    {
+        m_version = major * 100 + minor;
+        return *this;
+    }
+
+    /// Requires support for the extension \p name.
+    device_requirements& extension(const std::string &name)
+    {
+        m_extensions.push_back(name);
+        return *this;
+    }
+
+    /// Requires dedicated local memory.
+    device_requirements& local_memory()
+    {
+        m_local_memory = true;
+        return *this;
+    }
+
+    /// Requires sub-group (or OpenCL 2.0 work-group) collective functions.
+    device_requirements& sub_groups()
+    {
+        m_sub_groups = true;
+        return *this;
+    }
+
+    /// Requires an NVIDIA device of compute capability \p major.\p minor
+    /// or later.
+    device_requirements& nvidia_compute_capability(int major, int minor)
+    {
+        m_nvidia_major = major;
+        m_nvidia_minor = minor;
+        return *this;
+    }
+
+    /// Requires \p predicate to return \c true for the device.
+    device_requirements& predicate(const boost::function<bool(const device &)> &predicate)
+    {
+        m_predicates.push_back(predicate);
+        return *this;
+    }
+
+    /// Returns \c true if \p device meets the requirements.
+    bool matches(const device &device) const
+    {
+        const boost::shared_ptr<detail::device_profile> profile =
+            detail::device_profile::get(device);
+
+        for(size_t i = 0; i < m_vendors.size(); i++){
+            if(profile->vendor().find(m_vendors[i]) == std::string::npos &&
+               profile->platform_vendor().find(m_vendors[i]) == std::string::npos){
+                return false;
+            }
+        }
+        if(m_type != 0 && (profile->type() & m_type) == 0){
+            return false;
+        }
+        if(profile->version() < m_version){
+            return false;
+        }
+        for(size_t i = 0; i < m_extensions.size(); i++){
+            if(!profile->supports_extension(m_extensions[i])){
+                return false;
+            }
+        }
+        if(m_local_memory && !profile->has_local_memory()){
+            return false;
+        }
+        if(m_sub_groups && !detail::sub_group_functions(device).supported()){
+            return false;
+        }
+        if((m_nvidia_major != 0 || m_nvidia_minor != 0) &&
+           !detail::check_nvidia_compute_capability(device, m_nvidia_major, m_nvidia_minor)){
+            return false;
+        }
+        for(size_t i = 0; i < m_predicates.size(); i++){
+            if(!m_predicates[i](device)){
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    std::vector<std::string> m_vendors;
+    cl_device_type m_type;
+    uint_ m_version;
+    std::vector<std::string> m_extensions;
+    bool m_local_memory;
+    bool m_sub_groups;
+    int m_nvidia_major;
+    int m_nvidia_minor;
+    std::vector<boost::function<bool(const device &)> > m_predicates;
+};
+
+/// \class kernel_variant_registry
+/// \brief Selects between the kernel variants of algorithms per device.
+///
+/// Algorithms with several implementations (e.g. one using sub-group
+/// functions and one using local memory reductions) register each of them
+/// as a named variant with the requirements on the device it runs on and
+/// a priority. On each call the algorithm runs the variant select()
+/// returns, which is the matching variant with the highest priority.
+///
+/// Applications can register further requirements for the variants of
+/// the algorithms (or raise their priority) in order to prefer a variant
+/// tuned for their devices:
+/// \code
+/// // count with sub-group ballots on Intel GPUs only
+/// boost::shared_ptr<boost::compute::kernel_variant_registry> registry =
+///     boost::compute::kernel_variant_registry::get_global_registry();
+///
+/// registry->insert(
+///     "count_if",
+///     "ballot",
+///     boost::compute::device_requirements().local_memory().sub_groups().vendor("Intel"),
+///     2
+/// );
+/// \endcode
+///
+/// Inserting a variant of the same name replaces it. Of variants with the
+/// same priority, the last inserted one is selected.
+///
+/// The variants of the algorithms are:
+/// - \c "count_if": \c "ballot" (sub-group ballots), \c "reduce" (local
+///   memory reduction) and \c "threads" (one work-item per compute unit,
+///   for devices without local memory).
+/// - \c "reduce": \c "warp_unrolled" (unsynchronized last steps of the
+///   reduction on NVIDIA GPUs) and \c "local_memory".
+///
+/// When compiled with \c BOOST_COMPUTE_THREAD_SAFE defined the registry
+/// may be used from multiple threads.
+class kernel_variant_registry : boost::noncopyable
+{
+public:
+    /// Creates a registry with the variants of the algorithms.
+    kernel_variant_registry()
+    {
+        insert("count_if", "threads", device_requirements(), 0);
+        insert("count_if", "reduce", device_requirements().local_memory(), 1);
+        insert("count_if", "ballot", device_requirements().local_memory().sub_groups(), 2);
+
+        insert("reduce", "local_memory", device_requirements(), 0);
+        insert("reduce", "warp_unrolled", device_requirements().vendor("NVIDIA"), 1);
+    }
+
+    /// Registers \p variant of \p algorithm for the devices meeting
+    /// \p requirements with \p priority.
+    void insert(const std::string &algorithm,
+                const std::string &variant,
+                const device_requirements &requirements,
+                int priority = 0)
+    {
+        detail::scoped_lock lock(m_mutex);
+
+        std::vector<entry> &entries = m_entries[algorithm];
+        erase_entry(entries, variant);
+        entries.push_back(entry(variant, requirements, priority));
+
+        m_selections.clear();
+    }
+
+    /// Removes \p variant of \p algorithm.
+    void erase(const std::string &algorithm, const std::string &variant)
+    {
+        detail::scoped_lock lock(m_mutex);
+
+        erase_entry(m_entries[algorithm], variant);
+
+        m_selections.clear();
+    }
+
+    /// Returns the names of the variants of \p algorithm.
+    std::vector<std::string> variants(const std::string &algorithm) const
+    {
+        detail::scoped_lock lock(m_mutex);
+
+        std::vector<std::string> names;
+
+        entry_map::const_iterator iter = m_entries.find(algorithm);
+        if(iter != m_entries.end()){
+            for(size_t i = 0; i < iter->second.size(); i++){
+                names.push_back(iter->second[i].name);
+            }
+        }
+
+        return names;
+    }
+
+    /// Returns the variant of \p algorithm with the highest priority whose
+    /// requirements \p device meets, or \p fallback if there is none.
+    ///
+    /// The selection is cached for each device until the variants of the
+    /// registry change.
+    std::string select(const std::string &algorithm,
+                       const device &device,
+                       const std::string &fallback = std::string()) const
+    {
+        detail::scoped_lock lock(m_mutex);
+
+        const selection_key key(algorithm, device.id());
+
+        selection_map::const_iterator cached = m_selections.find(key);
+        if(cached != m_selections.end()){
+            return cached->second.empty() ? fallback : cached->second;
+        }
+
+        std::string selected;
+        int selected_priority = 0;
+
+        entry_map::const_iterator iter = m_entries.find(algorithm);
+        if(iter != m_entries.end()){
+            const std::vector<entry> &entries = iter->second;
+            for(size_t i = 0; i < entries.size(); i++){
+                const entry &e = entries[i];
+                if((selected.empty() || e.priority >= selected_priority) &&
+                   e.requirements.matches(device)){
+                    selected = e.name;
+                    selected_priority = e.priority;
+                }
+            }
+        }
+
+        m_selections[key] = selected;
+
+        return selected.empty() ? fallback : selected;
+    }
+
+    /// Returns the global registry.
+    static boost::shared_ptr<kernel_variant_registry> get_global_registry()
+    {
+        static detail::mutex registry_mutex;
+        static boost::shared_ptr<kernel_variant_registry> registry;
+
+        detail::scoped_lock lock(registry_mutex);
+
+        if(!registry){
+            registry = boost::make_shared<kernel_variant_registry>();
+        }
+
+        return registry;
+    }
+
+private:
+    struct entry
+    {
+        entry(const std::string &name_,
+              const device_requirements &requirements_,
+              int priority_)
+            : name(name_),
+              requirements(requirements_),
+              priority(priority_)
+        {
+        }
+
+        std::string name;
+        device_requirements requirements;
+        int priority;
+    };
+
+    typedef std::map<std::string, std::vector<entry> > entry_map;
+    typedef std::pair<std::string, cl_device_id> selection_key;
+    typedef std::map<selection_key, std::string> selection_map;
+
+    static void erase_entry(std::vector<entry> &entries, const std::string &variant)
+    {
+        for(size_t i = 0; i < entries.size(); i++){
+            if(entries[i].name == variant){
+                entries.erase(entries.begin() + i);
+                return;
+            }
+        }
+    }
+
+private:
+    mutable detail::mutex m_mutex;
+    entry_map m_entries;
+    mutable selection_map m_selections;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_KERNEL_VARIANTS_HPP
@@ -0,0 +1,240 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_MAPPED_FILE_HPP
+#define BOOST_COMPUTE_UTILITY_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include <boost/version.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class mapped_file
+/// \brief A file of values of type \c T mapped into host memory.
+///
+/// The mapped_file class maps a binary file into the address space of the
+/// host so its values can be copied to and from the device without first
+/// reading the whole file into a host container. The pages of the file are
+/// only loaded (or written back) by the operating system while the values
+/// are copied.
+///
+/// Copies between a mapped_file and the device go through the pinned
+/// staging ring used by copy() for large host ranges: each chunk is copied
+/// from the mapped pages into a pinned buffer while the transfer of the
+/// previous chunk runs.
+///
+/// For example, to load a column of floats from a file:
+/// \code
+/// boost::compute::mapped_file<float> file("column.bin");
+///
+/// boost::compute::vector<float> column(file.size(), context);
+/// boost::compute::copy(file.begin(), file.end(), column.begin(), queue);
+/// \endcode
+///
+/// or to store the results of an algorithm in a new file:
+/// \code
+/// boost::compute::mapped_file<float> file("result.bin", result.size());
+/// boost::compute::copy(result.begin(), result.end(), file.begin(), queue);
+/// \endcode
+///
+/// Datasets larger than device memory can be streamed through a pipeline
+/// one part at a time:
+/// \code
+/// boost::compute::vector<float> part(part_size, context);
+/// float sum = 0;
+/// for(size_t i = 0; i < file.size(); i += part_size){
+///     size_t n = (std::min)(part_size, file.size() - i);
+///     boost::compute::copy(file.begin() + i, file.begin() + i + n, part.begin(), queue);
+///
+///     float part_sum = 0;
+///     make_pipeline(part.begin(), part.begin() + n)
+///         .transform(_1 * _1)
+///         .reduce(&part_sum, queue);
+///     sum += part_sum;
+/// }
+/// \endcode
+///
+/// Files are mapped with Boost.Interprocess.
+///
+/// \see copy_from_file(), copy_to_file()
+template<class T>
+class mapped_file : boost::noncopyable
+{
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    /// Maps the existing file at \p path for reading.
+    ///
+    /// Throws \c std::runtime_error if the file can not be opened or its
+    /// size is not a multiple of \c sizeof(T).
+    explicit mapped_file(const std::string &path)
+        : m_size(0)
+    {
+        std::ifstream stream(path.c_str(), std::ios::in | std::ios::binary);
+        if(!stream){
+            BOOST_THROW_EXCEPTION(std::runtime_error("failed to open " + path));
+        }
+        stream.seekg(0, std::ios::end);
+        const size_type bytes = static_cast<size_type>(stream.tellg());
+        stream.close();
+
+        if(bytes % sizeof(T) != 0){
+            BOOST_THROW_EXCEPTION(
+                std::runtime_error("size of " + path + " is not a multiple of the value size")
+            );
+        }
+
+        map(path, bytes / sizeof(T), boost::interprocess::read_only);
+    }
+
+    /// Creates (or replaces) the file at \p path with room for \p count
+    /// values and maps it for writing.
+    ///
+    /// Throws \c std::runtime_error if the file can not be created.
+    mapped_file(const std::string &path, size_type count)
+        : m_size(0)
+    {
+        std::filebuf file;
+        if(!file.open(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc)){
+            BOOST_THROW_EXCEPTION(std::runtime_error("failed to create " + path));
+        }
+        if(count > 0){
+            file.pubseekoff(static_cast<std::streamoff>(count * sizeof(T) - 1), std::ios::beg);
+            file.sputc(0);
+        }
+        file.close();
+
+        map(path, count, boost::interprocess::read_write);
+    }
+
+    /// Unmaps the file. Values written to a writable file are stored by
+    /// the operating system.
+    ~mapped_file()
+    {
+    }
+
+    /// Returns the number of values in the file.
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /// Returns \c true if the file contains no values.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// Returns a pointer to the first value. Files opened for reading must
+    /// not be written to.
+    T* data() const
+    {
+        return static_cast<T *>(m_region.get_address());
+    }
+
+    iterator begin() const
+    {
+        return data();
+    }
+
+    iterator end() const
+    {
+        return data() + m_size;
+    }
+
+    /// Writes the modified pages of the file to disk and waits for the
+    /// writes to complete.
+    void flush()
+    {
+        if(m_size > 0){
+            m_region.flush(0, 0, false);
+        }
+    }
+
+private:
+    /// \internal_
+    void map(const std::string &path,
+             size_type count,
+             boost::interprocess::mode_t mode)
+    {
+        // empty files can not be mapped
+        if(count == 0){
+            return;
+        }
+
+        boost::interprocess::file_mapping mapping(path.c_str(), mode);
+        boost::interprocess::mapped_region region(mapping, mode);
+        m_region.swap(region);
+        m_size = count;
+
+        #if BOOST_VERSION >= 105400
+        // the values are copied front to back
+        m_region.advise(boost::interprocess::mapped_region::advice_sequential);
+        #endif
+    }
+
+private:
+    size_type m_size;
+    boost::interprocess::mapped_region m_region;
+};
+
+/// Copies the values of type \c T stored in the file at \p path to the
+/// range beginning at \p result. Returns an iterator one past the last
+/// value copied.
+///
+/// \see mapped_file, copy_to_file()
+template<class T, class OutputIterator>
+inline OutputIterator copy_from_file(const std::string &path,
+                                     OutputIterator result,
+                                     command_queue &queue = system::default_queue())
+{
+    mapped_file<T> file(path);
+
+    return ::boost::compute::copy(file.begin(), file.end(), result, queue);
+}
+
+/// Stores the values in the range [\p first, \p last) in the file at
+/// \p path (which is created or replaced).
+///
+/// \see mapped_file, copy_from_file()
+template<class InputIterator>
+inline void copy_to_file(InputIterator first,
+                         InputIterator last,
+                         const std::string &path,
+                         command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    mapped_file<T> file(path, detail::iterator_range_size(first, last));
+    ::boost::compute::copy(first, last, file.begin(), queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_MAPPED_FILE_HPP
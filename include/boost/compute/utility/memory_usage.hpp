@@ -0,0 +1,208 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_MEMORY_USAGE_HPP
+#define BOOST_COMPUTE_UTILITY_MEMORY_USAGE_HPP
+
+#include <map>
+#include <algorithm>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/detail/mutex.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class memory_usage
+/// \brief Tracks the device memory allocated by Boost.Compute for a context.
+///
+/// The memory_usage class counts the bytes of the memory objects allocated
+/// by containers using buffer_allocator (or its derived allocators), of the
+/// temporary buffers drawn from the buffer_pool by algorithms and
+/// pooled_allocator, and of the idle buffers cached by the buffer_pool.
+/// Memory objects created directly (e.g. with the buffer constructor) are
+/// not counted.
+///
+/// For example, to find the peak memory used by a sort:
+/// \code
+/// boost::shared_ptr<boost::compute::memory_usage> usage =
+///     boost::compute::memory_usage::get_global_usage(context);
+/// usage->reset_peak();
+///
+/// boost::compute::sort(vec.begin(), vec.end(), queue);
+///
+/// std::cout << "peak: " << usage->peak() << " bytes" << std::endl;
+/// \endcode
+///
+/// \see buffer_pool, scratch_space
+class memory_usage : boost::noncopyable
+{
+public:
+    /// The kinds of allocations which are tracked.
+    enum category {
+        containers = 0,  ///< memory allocated with buffer_allocator
+        temporaries,     ///< buffers handed out by the buffer_pool
+        cached           ///< idle buffers held by the buffer_pool
+    };
+
+    /// Creates a new memory usage tracker with all counts at zero.
+    memory_usage()
+        : m_total_peak(0)
+    {
+        for(int i = 0; i < category_count; i++){
+            m_current[i] = 0;
+            m_peak[i] = 0;
+        }
+    }
+
+    /// Returns the number of bytes currently allocated.
+    size_t current() const
+    {
+        detail::scoped_lock lock(m_mutex);
+        return total();
+    }
+
+    /// Returns the number of bytes currently allocated for \p kind.
+    size_t current(category kind) const
+    {
+        detail::scoped_lock lock(m_mutex);
+        return m_current[kind];
+    }
+
+    /// Returns the largest number of bytes allocated at any time since
+    /// the creation of the tracker (or the last call to reset_peak()).
+    size_t peak() const
+    {
+        detail::scoped_lock lock(m_mutex);
+        return m_total_peak;
+    }
+
+    /// Returns the largest number of bytes allocated for \p kind at any
+    /// time.
+    size_t peak(category kind) const
+    {
+        detail::scoped_lock lock(m_mutex);
+        return m_peak[kind];
+    }
+
+    /// Sets the peak values to the current values.
+    void reset_peak()
+    {
+        detail::scoped_lock lock(m_mutex);
+        for(int i = 0; i < category_count; i++){
+            m_peak[i] = m_current[i];
+        }
+        m_total_peak = total();
+    }
+
+    /// \internal_
+    void allocated(category kind, size_t size)
+    {
+        detail::scoped_lock lock(m_mutex);
+
+        m_current[kind] += size;
+        if(m_current[kind] > m_peak[kind]){
+            m_peak[kind] = m_current[kind];
+        }
+
+        const size_t total_ = total();
+        if(total_ > m_total_peak){
+            m_total_peak = total_;
+        }
+    }
+
+    /// \internal_
+    void deallocated(category kind, size_t size)
+    {
+        detail::scoped_lock lock(m_mutex);
+
+        m_current[kind] -= (std::min)(size, m_current[kind]);
+    }
+
+    /// Returns the global memory usage tracker for \p context.
+    ///
+    /// The trackers hold a reference to their context so that its handle
+    /// is not reused by another context. The trackers of contexts which
+    /// are no longer used elsewhere (and have no memory allocated) are
+    /// released when the tracker of a new context is created.
+    static boost::shared_ptr<memory_usage> get_global_usage(const context &context)
+    {
+        typedef std::map<cl_context, usage_entry> usage_map;
+
+        static detail::mutex usages_mutex;
+        static usage_map usages;
+
+        detail::scoped_lock lock(usages_mutex);
+
+        usage_map::iterator i = usages.find(context.get());
+        if(i != usages.end()){
+            return i->second.usage;
+        }
+
+        for(usage_map::iterator j = usages.begin(); j != usages.end(); ){
+            if(j->second.released()){
+                usages.erase(j++);
+            }
+            else {
+                ++j;
+            }
+        }
+
+        usage_entry &entry = usages[context.get()];
+        entry.context_ = context;
+        entry.usage = boost::make_shared<memory_usage>();
+
+        return entry.usage;
+    }
+
+private:
+    static const int category_count = 3;
+
+    // a tracker of the global map and its (retained) context
+    struct usage_entry
+    {
+        // returns true if only the map refers to the context and the
+        // tracker, and no memory is allocated
+        bool released() const
+        {
+            return usage.unique() &&
+                   usage->current() == 0 &&
+                   context_.get_info<uint_>(CL_CONTEXT_REFERENCE_COUNT) == 1;
+        }
+
+        ::boost::compute::context context_;
+        boost::shared_ptr<memory_usage> usage;
+    };
+
+    size_t total() const
+    {
+        size_t sum = 0;
+        for(int i = 0; i < category_count; i++){
+            sum += m_current[i];
+        }
+        return sum;
+    }
+
+private:
+    size_t m_current[category_count];
+    size_t m_peak[category_count];
+    size_t m_total_peak;
+    mutable detail::mutex m_mutex;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_MEMORY_USAGE_HPP
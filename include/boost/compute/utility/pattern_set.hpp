@@ -0,0 +1,220 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_PATTERN_SET_HPP
+#define BOOST_COMPUTE_UTILITY_PATTERN_SET_HPP
+
+#include <deque>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+
+#include <boost/throw_exception.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/types/fundamental.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class pattern_set
+/// \brief A set of strings compiled for multi-pattern search on the device.
+///
+/// The pattern_set class builds an Aho-Corasick automaton for a set of
+/// patterns on the host and stores it in device memory. It is used by the
+/// search_patterns() and count_patterns() algorithms to find all
+/// occurrences of any of the patterns in a text with a single pass.
+///
+/// For example, to count the occurrences of a few keywords in a string:
+/// \code
+/// std::vector<std::string> keywords;
+/// keywords.push_back("error");
+/// keywords.push_back("warning");
+///
+/// boost::compute::pattern_set patterns(keywords, queue);
+///
+/// boost::compute::vector<boost::compute::uint_> counts(patterns.size(), context);
+/// boost::compute::count_patterns(
+///     text.begin(), text.end(), patterns, counts.begin(), queue
+/// );
+/// \endcode
+///
+/// The automaton is stored as a dense table with 256 transitions (one for
+/// each byte value) per state, so it uses 1 KB of device memory for each
+/// distinct prefix of the patterns.
+///
+/// \see search_patterns(), count_patterns()
+class pattern_set
+{
+public:
+    /// The value of match_ids() for states at which no pattern ends.
+    static const uint_ no_match = ~uint_(0);
+
+    /// Creates a pattern set for \p patterns. Pattern \c i is reported
+    /// with the id \c i (duplicate patterns are reported with the id of
+    /// their first occurrence).
+    ///
+    /// Throws \c std::invalid_argument if \p patterns is empty or contains
+    /// an empty string.
+    explicit pattern_set(const std::vector<std::string> &patterns,
+                         command_queue &queue = system::default_queue())
+        : m_context(queue.get_context()),
+          m_size(patterns.size()),
+          m_max_length(0),
+          m_transitions(m_context),
+          m_match(m_context),
+          m_next_match(m_context),
+          m_lengths(m_context)
+    {
+        if(patterns.empty()){
+            BOOST_THROW_EXCEPTION(std::invalid_argument("no patterns"));
+        }
+
+        std::vector<uint_> transitions(256, 0);
+        std::vector<uint_> match(1, uint_(no_match));
+        std::vector<uint_> lengths;
+        lengths.reserve(patterns.size());
+
+        // build the trie (zero is the root and marks missing children)
+        for(size_t id = 0; id < patterns.size(); id++){
+            const std::string &pattern = patterns[id];
+            if(pattern.empty()){
+                BOOST_THROW_EXCEPTION(std::invalid_argument("empty pattern"));
+            }
+
+            uint_ state = 0;
+            for(size_t i = 0; i < pattern.size(); i++){
+                const size_t index =
+                    size_t(state) * 256 + static_cast<unsigned char>(pattern[i]);
+                if(transitions[index] == 0){
+                    transitions[index] = static_cast<uint_>(match.size());
+                    transitions.resize(transitions.size() + 256, 0);
+                    match.push_back(uint_(no_match));
+                }
+                state = transitions[index];
+            }
+
+            if(match[state] == no_match){
+                match[state] = static_cast<uint_>(id);
+            }
+            lengths.push_back(static_cast<uint_>(pattern.size()));
+            m_max_length = (std::max)(m_max_length, pattern.size());
+        }
+
+        // compute the failure links breadth-first and replace the missing
+        // children with the transitions of the failure state. next_match
+        // links each state to the nearest state on its failure chain at
+        // which a pattern ends (or the root if there is none).
+        const size_t state_count = match.size();
+        std::vector<uint_> failure(state_count, 0);
+        std::vector<uint_> next_match(state_count, 0);
+        std::deque<uint_> queue_;
+
+        for(size_t c = 0; c < 256; c++){
+            if(transitions[c] != 0){
+                queue_.push_back(transitions[c]);
+            }
+        }
+
+        while(!queue_.empty()){
+            const uint_ state = queue_.front();
+            queue_.pop_front();
+
+            for(size_t c = 0; c < 256; c++){
+                uint_ &next = transitions[size_t(state) * 256 + c];
+                const uint_ fallback = transitions[size_t(failure[state]) * 256 + c];
+
+                if(next == 0){
+                    next = fallback;
+                    continue;
+                }
+
+                failure[next] = fallback;
+                next_match[next] =
+                    match[fallback] != no_match ? fallback : next_match[fallback];
+                queue_.push_back(next);
+            }
+        }
+
+        m_transitions.assign(transitions.begin(), transitions.end(), queue);
+        m_match.assign(match.begin(), match.end(), queue);
+        m_next_match.assign(next_match.begin(), next_match.end(), queue);
+        m_lengths.assign(lengths.begin(), lengths.end(), queue);
+    }
+
+    /// Returns the number of patterns.
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    /// Returns the length of the longest pattern.
+    size_t max_pattern_length() const
+    {
+        return m_max_length;
+    }
+
+    /// Returns the number of states of the automaton.
+    size_t state_count() const
+    {
+        return m_match.size();
+    }
+
+    /// Returns the context of the pattern set.
+    const context& get_context() const
+    {
+        return m_context;
+    }
+
+    /// Returns the transition table. The state after reading byte \c c in
+    /// state \c s is stored at index <tt>s * 256 + c</tt>. The initial
+    /// state is zero.
+    const vector<uint_>& transitions() const
+    {
+        return m_transitions;
+    }
+
+    /// Returns the id of the longest pattern ending at each state (or
+    /// \c no_match).
+    const vector<uint_>& match_ids() const
+    {
+        return m_match;
+    }
+
+    /// Returns for each state the next state at which a (shorter) pattern
+    /// ending at the same position ends, or zero if there is none.
+    const vector<uint_>& next_matches() const
+    {
+        return m_next_match;
+    }
+
+    /// Returns the length of each pattern.
+    const vector<uint_>& lengths() const
+    {
+        return m_lengths;
+    }
+
+private:
+    context m_context;
+    size_t m_size;
+    size_t m_max_length;
+    vector<uint_> m_transitions;
+    vector<uint_> m_match;
+    vector<uint_> m_next_match;
+    vector<uint_> m_lengths;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_PATTERN_SET_HPP
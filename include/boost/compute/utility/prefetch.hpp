@@ -0,0 +1,85 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_PREFETCH_HPP
+#define BOOST_COMPUTE_UTILITY_PREFETCH_HPP
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/utility/wait_list.hpp>
+
+namespace boost {
+namespace compute {
+
+#if defined(CL_VERSION_1_2) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+/// Enqueues a command to migrate \p buffer to the device of \p queue and
+/// returns an event for it.
+///
+/// In a context with several devices, buffers are otherwise moved to a
+/// device when the first kernel using them runs there, which stalls the
+/// kernel. Prefetching a buffer ahead of time (e.g. while the device still
+/// runs other commands) hides the transfer.
+///
+/// \p flags may contain \c CL_MIGRATE_MEM_OBJECT_CONTENT_UNDEFINED when
+/// the contents of the buffer will be overwritten on the device (e.g. an
+/// output buffer), in which case no data is copied.
+///
+/// For devices older than OpenCL 1.2 nothing is enqueued and a null event
+/// is returned.
+///
+/// For example, to move the input of a kernel to the device of \p queue:
+/// \code
+/// boost::compute::prefetch(input.get_buffer(), queue);
+/// \endcode
+///
+/// \see_opencl_ref{clEnqueueMigrateMemObjects}
+///
+/// \opencl_version_warning{1,2}
+inline event prefetch(const buffer &buffer,
+                      command_queue &queue = system::default_queue(),
+                      cl_mem_migration_flags flags = 0,
+                      const wait_list &events = wait_list())
+{
+    event event_;
+
+    if(queue.get_version() >= 120){
+        const cl_mem mem = buffer.get();
+        queue.enqueue_migrate_memory_objects(1, &mem, flags, events, &event_);
+    }
+
+    return event_;
+}
+
+/// \overload
+///
+/// Migrates the buffer of the range [\p first, \p last) (OpenCL migrates
+/// whole memory objects).
+template<class T>
+inline event prefetch(const buffer_iterator<T> &first,
+                      const buffer_iterator<T> &last,
+                      command_queue &queue = system::default_queue(),
+                      cl_mem_migration_flags flags = 0,
+                      const wait_list &events = wait_list())
+{
+    if(first == last){
+        return event();
+    }
+
+    return ::boost::compute::prefetch(first.get_buffer(), queue, flags, events);
+}
+#endif // CL_VERSION_1_2
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_PREFETCH_HPP
@@ -11,20 +11,96 @@
 #ifndef BOOST_COMPUTE_UTILITY_PROGRAM_CACHE_HPP
 #define BOOST_COMPUTE_UTILITY_PROGRAM_CACHE_HPP
 
+#include <set>
 #include <string>
+#include <vector>
 #include <utility>
+#include <algorithm>
 
+#include <boost/bind.hpp>
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/functional/hash.hpp>
 
+#if !defined(BOOST_NO_CXX11_HDR_CHRONO)
+#  include <chrono>
+#elif defined(BOOST_HAS_CLOCK_GETTIME)
+#  include <time.h>
+#endif
+
+#include <boost/compute/event.hpp>
 #include <boost/compute/context.hpp>
 #include <boost/compute/program.hpp>
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/async/thread_pool.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/utility/build_log.hpp>
+#include <boost/compute/utility/embedded_programs.hpp>
+#include <boost/compute/utility/trace.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/getenv.hpp>
+#include <boost/compute/detail/mutex.hpp>
 #include <boost/compute/detail/lru_cache.hpp>
-#include <boost/compute/detail/global_static.hpp>
+#include <boost/compute/detail/sha1.hpp>
+
+#ifndef BOOST_COMPUTE_PROGRAM_CACHE_SIZE
+#  define BOOST_COMPUTE_PROGRAM_CACHE_SIZE 64
+#endif
+
+#ifndef BOOST_COMPUTE_PROGRAM_CACHE_CONTEXTS
+#  define BOOST_COMPUTE_PROGRAM_CACHE_CONTEXTS 8
+#endif
+
+#ifndef BOOST_COMPUTE_PROGRAM_CACHE_BINARIES
+#  define BOOST_COMPUTE_PROGRAM_CACHE_BINARIES 256
+#endif
 
 namespace boost {
 namespace compute {
+namespace detail {
+
+// returns a monotonic time in microseconds to measure program builds, or
+// zero if no such clock is available
+inline ulong_ program_build_clock()
+{
+    #if !defined(BOOST_NO_CXX11_HDR_CHRONO)
+    return static_cast<ulong_>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count()
+    );
+    #elif defined(BOOST_HAS_CLOCK_GETTIME)
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<ulong_>(time.tv_sec) * 1000000 +
+           static_cast<ulong_>(time.tv_nsec) / 1000;
+    #else
+    return 0;
+    #endif
+}
+
+// returns the positive size in the environment variable name, or value
+inline size_t program_cache_size_from_environment(const char *name, size_t value)
+{
+    if(const char *size = getenv(name)){
+        try {
+            value = boost::lexical_cast<size_t>(size);
+        }
+        catch(boost::bad_lexical_cast&){
+        }
+    }
+
+    return (std::max)(value, size_t(1));
+}
+
+} // end detail namespace
 
 /// The program_cache class stores \ref program objects in a LRU cache.
 ///
@@ -48,15 +124,70 @@ namespace compute {
 /// }
 /// \endcode
 ///
+/// When compiled with \c BOOST_COMPUTE_THREAD_SAFE defined, program caches
+/// may be shared between threads. Concurrent calls to get_or_build() for
+/// the same key and options build the program only once while the other
+/// callers wait for the result.
+///
+/// Programs can also be built asynchronously with get_or_build_async(). The
+/// cache hands out pending builds to all callers, get() and get_or_build()
+/// wait for a pending build to complete before returning its program.
+///
+/// The number of hits, misses, evictions and builds of the cache and the
+/// time spent building programs are returned by get_statistics(), e.g. to
+/// check whether the global cache of a context is large enough:
+/// \code
+/// program_cache::statistics stats =
+///     program_cache::get_global_cache(context)->get_statistics();
+/// if(stats.evictions > 0){
+///     program_cache::set_global_cache_capacity(256);
+/// }
+/// \endcode
+///
 /// \see program
 class program_cache : boost::noncopyable
 {
 public:
+    /// The order in which programs are evicted when the cache is full.
+    enum eviction_policy {
+        /// Evicts the least recently used program.
+        least_recently_used,
+        /// Evicts the program which was the fastest to build among the
+        /// least recently used half of the cache. Programs inserted without
+        /// a build time are considered free to build.
+        cost_aware
+    };
+
+    /// Counters of the lookups and builds of a program cache.
+    struct statistics
+    {
+        /// Number of lookups which found the program.
+        size_t hits;
+        /// Number of lookups which did not find the program.
+        size_t misses;
+        /// Number of programs evicted to make room for others.
+        size_t evictions;
+        /// Number of programs built by get_or_build() and
+        /// get_or_build_async().
+        size_t builds;
+        /// Number of the builds which used an embedded program (see
+        /// register_embedded_programs()) or the binary of the program
+        /// built for the same device in another context instead of
+        /// compiling the source.
+        size_t binary_builds;
+        /// Total time (in microseconds) of the builds of get_or_build()
+        /// and of the build times given to insert(). The builds of
+        /// get_or_build_async() are not timed.
+        ulong_ build_time;
+    };
+
     /// Creates a new program cache with space for \p capacity number of
     /// program objects.
     program_cache(size_t capacity)
-        : m_cache(capacity)
+        : m_cache(capacity),
+          m_policy(least_recently_used)
     {
+        reset_statistics();
     }
 
     /// Destroys the program cache.
@@ -67,33 +198,106 @@ public:
     /// Returns the number of program objects currently stored in the cache.
     size_t size() const
     {
+        detail::scoped_lock lock(m_mutex);
+
         return m_cache.size();
     }
 
     /// Returns the total capacity of the cache.
     size_t capacity() const
     {
+        detail::scoped_lock lock(m_mutex);
+
         return m_cache.capacity();
     }
 
+    /// Sets the capacity of the cache to \p capacity programs. If the cache
+    /// holds more programs they are evicted according to the eviction
+    /// policy.
+    void set_capacity(size_t capacity)
+    {
+        BOOST_ASSERT(capacity > 0);
+
+        detail::scoped_lock lock(m_mutex);
+
+        while(m_cache.size() > capacity){
+            evict();
+        }
+        m_cache.set_capacity(capacity);
+    }
+
+    /// Returns the eviction policy of the cache.
+    eviction_policy get_eviction_policy() const
+    {
+        detail::scoped_lock lock(m_mutex);
+
+        return m_policy;
+    }
+
+    /// Sets the eviction policy of the cache (\c least_recently_used by
+    /// default).
+    void set_eviction_policy(eviction_policy policy)
+    {
+        detail::scoped_lock lock(m_mutex);
+
+        m_policy = policy;
+    }
+
+    /// Returns the statistics of the cache since its creation or the last
+    /// call to reset_statistics().
+    statistics get_statistics() const
+    {
+        detail::scoped_lock lock(m_mutex);
+
+        return m_statistics;
+    }
+
+    /// Resets the statistics of the cache.
+    void reset_statistics()
+    {
+        detail::scoped_lock lock(m_mutex);
+
+        m_statistics.hits = 0;
+        m_statistics.misses = 0;
+        m_statistics.evictions = 0;
+        m_statistics.builds = 0;
+        m_statistics.binary_builds = 0;
+        m_statistics.build_time = 0;
+    }
+
     /// Clears the program cache.
     void clear()
     {
+        detail::scoped_lock lock(m_mutex);
+
         m_cache.clear();
+        m_pending.clear();
     }
 
     /// Returns the program object with \p key. Returns a null optional if no
     /// program with \p key exists in the cache.
     boost::optional<program> get(const std::string &key)
     {
-        return m_cache.get(std::make_pair(key, std::string()));
+        return get(key, std::string());
     }
 
     /// Returns the program object with \p key and \p options. Returns a null
     /// optional if no program with \p key and \p options exists in the cache.
+    ///
+    /// If the program is being built asynchronously this waits for the build
+    /// to complete and throws an opencl_error if it failed.
     boost::optional<program> get(const std::string &key, const std::string &options)
     {
-        return m_cache.get(std::make_pair(key, options));
+        const key_ref ref = { key, options };
+
+        detail::scoped_lock lock(m_mutex);
+
+        boost::optional<program> p = lookup(ref);
+        if(p){
+            wait_for_pending_build(ref, lock);
+        }
+
+        return p;
     }
 
     /// Inserts \p program into the cache with \p key.
@@ -105,7 +309,21 @@ public:
     /// Inserts \p program into the cache with \p key and \p options.
     void insert(const std::string &key, const std::string &options, const program &program)
     {
-        m_cache.insert(std::make_pair(key, options), program);
+        insert(key, options, program, 0);
+    }
+
+    /// Inserts \p program, which took \p build_time microseconds to build,
+    /// into the cache with \p key and \p options. The build time is used by
+    /// the \c cost_aware eviction policy and added to the statistics.
+    void insert(const std::string &key,
+                const std::string &options,
+                const program &program,
+                ulong_ build_time)
+    {
+        detail::scoped_lock lock(m_mutex);
+
+        m_statistics.build_time += build_time;
+        store(key_type(key, options), program, build_time);
     }
 
     /// Loads the program with \p key from the cache if it exists. Otherwise
@@ -126,44 +344,628 @@ public:
     /// }
     /// return *p;
     /// \endcode
+    ///
+    /// The program is built without holding the cache's lock. If another
+    /// thread is already building the program with \p key and \p options,
+    /// this function waits for it to finish instead of building it again.
+    ///
+    /// If a program cache already built the same source and options for
+    /// the device of \p context (in another context with just this device)
+    /// the program is created from its binary instead of compiling the
+    /// source. Programs embedded in the executable with
+    /// register_embedded_programs() are used before those binaries.
+    ///
+    /// Each build is recorded in the global program_build_log.
     program get_or_build(const std::string &key,
                          const std::string &options,
                          const std::string &source,
                          const context &context)
     {
-        boost::optional<program> p = get(key, options);
-        if(!p){
-            p = program::build_with_source(source, context, options);
+        const key_ref ref = { key, options };
 
-            insert(key, options, *p);
+        detail::scoped_lock lock(m_mutex);
+
+        // look up the program without copying the key strings, a miss is
+        // counted once even if this thread waits for another one below
+        boost::optional<program> cached = lookup(ref);
+
+        for(;;){
+            if(cached){
+                wait_for_pending_build(ref, lock);
+                BOOST_COMPUTE_DETAIL_TRACE_PROGRAM_CACHE(key, true)
+
+                return *cached;
+            }
+            else if(m_building.empty() ||
+                    m_building.count(key_type(key, options)) == 0){
+                break;
+            }
+
+            // wait for the other thread building the program, if its build
+            // fails the loop will try to build the program itself
+            m_built.wait(lock);
+
+            boost::optional<entry> e = m_cache.get(ref, key_hash(), key_equal());
+            if(e){
+                cached = e->program;
+            }
+        }
+
+        const key_type cache_key(key, options);
+        m_building.insert(cache_key);
+        lock.unlock();
+        BOOST_COMPUTE_DETAIL_TRACE_PROGRAM_CACHE(key, false)
+
+        program p;
+        bool from_binary = false;
+        const ulong_ start = detail::program_build_clock();
+        try {
+            p = build_shared(source, options, context, from_binary);
+        }
+        catch(...){
+            lock.lock();
+            m_building.erase(cache_key);
+            m_built.notify_all();
+            throw;
+        }
+        const ulong_ build_time = detail::program_build_clock() - start;
+
+        program_build_log::get_global_log().record(
+            key, options, source, p, build_time, from_binary
+        );
+
+        lock.lock();
+        m_statistics.builds++;
+        m_statistics.binary_builds += from_binary ? 1 : 0;
+        m_statistics.build_time += build_time;
+        store(cache_key, p, build_time);
+        m_building.erase(cache_key);
+        m_built.notify_all();
+
+        return p;
+    }
+
+    /// Loads the programs with \p keys and \p options from the cache and
+    /// builds the missing ones from the sources with the same index in
+    /// \p sources. Returns the programs in the order of \p keys.
+    ///
+    /// Some OpenCL compilers build each program on a single thread, so when
+    /// \c BOOST_COMPUTE_THREAD_SAFE is defined the programs are built
+    /// concurrently on up to \p threads host threads (one per hardware
+    /// thread if zero). OpenCL allows distinct programs to be built from
+    /// different threads. Otherwise they are built one after the other.
+    ///
+    /// For example, to build the programs of a library at startup:
+    /// \code
+    /// std::vector<program> programs =
+    ///     cache.get_or_build_all(keys, "-cl-fast-relaxed-math", sources, context);
+    /// \endcode
+    ///
+    /// \see get_or_build()
+    std::vector<program> get_or_build_all(const std::vector<std::string> &keys,
+                                          const std::string &options,
+                                          const std::vector<std::string> &sources,
+                                          const context &context,
+                                          size_t threads = 0)
+    {
+        BOOST_ASSERT(keys.size() == sources.size());
+
+        std::vector<program> programs(keys.size());
+
+        std::vector<boost::function<void()> > tasks;
+        tasks.reserve(keys.size());
+        for(size_t i = 0; i < keys.size(); i++){
+            tasks.push_back(
+                boost::bind(&program_cache::get_or_build_to, this,
+                            boost::cref(keys[i]), boost::cref(options),
+                            boost::cref(sources[i]), boost::cref(context),
+                            &programs[i])
+            );
         }
-        return *p;
+        detail::invoke_concurrently(tasks, threads);
+
+        return programs;
     }
 
+    #if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+    /// Returns a future for the program with \p key and \p options. If the
+    /// program is not in the cache, starts building it from \p source with
+    /// program::build_async() and stores the pending program in the cache.
+    ///
+    /// Other callers requesting the same program while it is being built
+    /// receive the pending build instead of building it again. This allows
+    /// host work or other kernels to be enqueued while large programs
+    /// compile:
+    /// \code
+    /// boost::compute::future<program> f =
+    ///     cache.get_or_build_async("foo", options, source, context);
+    ///
+    /// // ... do other work ...
+    ///
+    /// boost::compute::kernel kernel(f.get(), "foo");
+    /// \endcode
+    ///
+    /// \opencl_version_warning{1,1}
+    ///
+    /// \see program::build_async()
+    future<program> get_or_build_async(const std::string &key,
+                                       const std::string &options,
+                                       const std::string &source,
+                                       const context &context)
+    {
+        const key_ref ref = { key, options };
+
+        detail::scoped_lock lock(m_mutex);
+
+        for(;;){
+            boost::optional<program> p = lookup(ref);
+            if(p){
+                pending_map::iterator i =
+                    m_pending.find(ref, key_hash(), key_equal());
+                BOOST_COMPUTE_DETAIL_TRACE_PROGRAM_CACHE(key, true)
+                if(i != m_pending.end()){
+                    return make_future(*p, i->second);
+                }
+
+                // already built, return a ready future
+                user_event ready(context);
+                ready.set_status(CL_COMPLETE);
+
+                return make_future(*p, event(ready));
+            }
+            else if(m_building.empty() ||
+                    m_building.count(key_type(key, options)) == 0){
+                break;
+            }
+
+            // wait for the other thread building the program
+            m_built.wait(lock);
+        }
+
+        const key_type cache_key(key, options);
+        m_building.insert(cache_key);
+        lock.unlock();
+        BOOST_COMPUTE_DETAIL_TRACE_PROGRAM_CACHE(key, false)
+
+        program p;
+        future<program> f;
+        boost::shared_ptr<const binary_type> binary;
+        boost::optional<program> embedded;
+        try {
+            const binary_key binary_key_ = make_binary_key(source, options, context);
+            if(binary_key_.first){
+                embedded = detail::create_embedded_program(binary_key_.second, context);
+                if(!embedded){
+                    binary = shared_binary(source, options, context);
+                }
+            }
+
+            if(embedded){
+                p = *embedded;
+            }
+            else if(binary){
+                p = program::create_with_binary(*binary, context);
+            }
+            else {
+                p = program::create_with_source(source, context);
+            }
+            f = p.build_async(options);
+        }
+        catch(...){
+            lock.lock();
+            m_building.erase(cache_key);
+            m_built.notify_all();
+            throw;
+        }
+
+        program_build_log::get_global_log().record(
+            key, options, source, p, 0, binary || embedded
+        );
+
+        lock.lock();
+        m_statistics.builds++;
+        m_statistics.binary_builds += (binary || embedded) ? 1 : 0;
+        store(cache_key, p, 0);
+        m_pending[cache_key] = f.get_event();
+        m_building.erase(cache_key);
+        m_built.notify_all();
+
+        return f;
+    }
+    #endif // CL_VERSION_1_1
+
     /// Returns the global program cache for \p context.
     ///
     /// This global cache is used internally by Boost.Compute to store compiled
     /// program objects used by its algorithms. All Boost.Compute programs are
     /// stored with a cache key beginning with \c "__boost". User programs
     /// should avoid using the same prefix in order to prevent collisions.
+    ///
+    /// The global caches are shared by all threads in the process, so each
+    /// program is only compiled once per context. The binaries of the
+    /// programs built by get_or_build() for contexts with a single device
+    /// are also kept, so the caches of other contexts for the same device
+    /// create their programs from the binaries instead of compiling the
+    /// sources again. The binaries of the \c BOOST_COMPUTE_PROGRAM_CACHE_BINARIES
+    /// (256 by default) most recently built programs are kept.
+    ///
+    /// Each global cache stores up to \c BOOST_COMPUTE_PROGRAM_CACHE_SIZE
+    /// programs (64 by default) and the caches of the
+    /// \c BOOST_COMPUTE_PROGRAM_CACHE_CONTEXTS most recently used contexts
+    /// (8 by default) are kept. Both can also be set with environment
+    /// variables of the same names, and the capacity of the caches with
+    /// set_global_cache_capacity().
     static boost::shared_ptr<program_cache> get_global_cache(const context &context)
     {
-        typedef detail::lru_cache<cl_context, boost::shared_ptr<program_cache> > cache_map;
+        global_caches &globals = get_global_caches();
 
-        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(cache_map, caches, (8));
+        detail::scoped_lock lock(globals.mutex);
 
-        boost::optional<boost::shared_ptr<program_cache> > cache = caches.get(context.get());
+        boost::optional<boost::shared_ptr<program_cache> > cache =
+            globals.caches.get(context.get());
         if(!cache){
-            cache = boost::make_shared<program_cache>(64);
+            cache = boost::make_shared<program_cache>(globals.capacity);
 
-            caches.insert(context.get(), *cache);
+            globals.caches.insert(context.get(), *cache);
         }
 
         return *cache;
     }
 
+    /// Returns the capacity of the global program caches.
+    static size_t global_cache_capacity()
+    {
+        global_caches &globals = get_global_caches();
+
+        detail::scoped_lock lock(globals.mutex);
+
+        return globals.capacity;
+    }
+
+    /// Sets the capacity of the global program caches of the current and
+    /// future contexts to \p capacity programs.
+    static void set_global_cache_capacity(size_t capacity)
+    {
+        BOOST_ASSERT(capacity > 0);
+
+        global_caches &globals = get_global_caches();
+
+        detail::scoped_lock lock(globals.mutex);
+
+        globals.capacity = capacity;
+
+        typedef global_caches::cache_map::const_iterator iterator;
+        for(iterator i = globals.caches.begin(); i != globals.caches.end(); ++i){
+            i->second->set_capacity(capacity);
+        }
+    }
+
 private:
-    detail::lru_cache<std::pair<std::string, std::string>, program> m_cache;
+    typedef std::pair<std::string, std::string> key_type;
+
+    struct entry
+    {
+        entry(const ::boost::compute::program &program_, ulong_ build_time_)
+            : program(program_),
+              build_time(build_time_)
+        {
+        }
+
+        ::boost::compute::program program;
+        ulong_ build_time;
+    };
+
+    // the global caches of the contexts and their capacity
+    struct global_caches
+    {
+        typedef detail::lru_cache<cl_context, boost::shared_ptr<program_cache> > cache_map;
+
+        global_caches()
+            : caches(detail::program_cache_size_from_environment(
+                         "BOOST_COMPUTE_PROGRAM_CACHE_CONTEXTS",
+                         BOOST_COMPUTE_PROGRAM_CACHE_CONTEXTS)),
+              capacity(detail::program_cache_size_from_environment(
+                           "BOOST_COMPUTE_PROGRAM_CACHE_SIZE",
+                           BOOST_COMPUTE_PROGRAM_CACHE_SIZE))
+        {
+        }
+
+        detail::mutex mutex;
+        cache_map caches;
+        size_t capacity;
+    };
+
+    static global_caches& get_global_caches()
+    {
+        static global_caches globals;
+
+        return globals;
+    }
+
+    // the binaries of the programs built for single device contexts, by
+    // device and hash of the source and options
+    typedef std::vector<unsigned char> binary_type;
+    typedef std::pair<cl_device_id, std::string> binary_key;
+
+    struct global_binaries
+    {
+        typedef detail::lru_cache<binary_key, boost::shared_ptr<const binary_type> > binary_map;
+
+        global_binaries()
+            : binaries(detail::program_cache_size_from_environment(
+                           "BOOST_COMPUTE_PROGRAM_CACHE_BINARIES",
+                           BOOST_COMPUTE_PROGRAM_CACHE_BINARIES))
+        {
+        }
+
+        detail::mutex mutex;
+        binary_map binaries;
+    };
+
+    static global_binaries& get_global_binaries()
+    {
+        static global_binaries globals;
+
+        return globals;
+    }
+
+    // returns the key of the binary of the program built from source with
+    // options for context, or a key with a null device if the context has
+    // several devices (programs store the binary of a single device)
+    static binary_key make_binary_key(const std::string &source,
+                                      const std::string &options,
+                                      const context &context)
+    {
+        if(context.get_devices().size() != 1){
+            return binary_key();
+        }
+
+        return binary_key(
+            context.get_device().id(), embedded_program_hash(source, options)
+        );
+    }
+
+    // returns the binary of the program built from source with options for
+    // the device of context in another context, if there is one
+    static boost::shared_ptr<const binary_type>
+    shared_binary(const std::string &source,
+                  const std::string &options,
+                  const context &context)
+    {
+        const binary_key key = make_binary_key(source, options, context);
+        if(!key.first){
+            return boost::shared_ptr<const binary_type>();
+        }
+
+        global_binaries &globals = get_global_binaries();
+        detail::scoped_lock lock(globals.mutex);
+
+        boost::optional<boost::shared_ptr<const binary_type> > binary =
+            globals.binaries.get(key);
+
+        return binary ? *binary : boost::shared_ptr<const binary_type>();
+    }
+
+    // builds the program from the shared binary for the device of context
+    // if there is one, or from source (and shares its binary)
+    static program build_shared(const std::string &source,
+                                const std::string &options,
+                                const context &context,
+                                bool &from_binary)
+    {
+        const binary_key key = make_binary_key(source, options, context);
+        if(!key.first){
+            from_binary = false;
+            return program::build_with_source(source, context, options);
+        }
+
+        // programs embedded in the executable are used first
+        boost::optional<program> embedded =
+            detail::create_embedded_program(key.second, context);
+        if(embedded){
+            try {
+                embedded->build(options);
+
+                from_binary = true;
+                return *embedded;
+            }
+            catch(opencl_error&){
+                // fall back to the other binaries or the source
+            }
+        }
+
+        global_binaries &globals = get_global_binaries();
+
+        boost::optional<boost::shared_ptr<const binary_type> > binary;
+        {
+            detail::scoped_lock lock(globals.mutex);
+            binary = globals.binaries.get(key);
+        }
+
+        if(binary){
+            try {
+                program p = program::create_with_binary(**binary, context);
+                p.build(options);
+
+                from_binary = true;
+                return p;
+            }
+            catch(opencl_error&){
+                // fall back to building the source
+            }
+        }
+
+        program p = program::build_with_source(source, context, options);
+        from_binary = false;
+
+        detail::record_embedded_program(key.second, p);
+
+        boost::shared_ptr<const binary_type> built =
+            boost::make_shared<binary_type>(p.binary());
+        if(!built->empty()){
+            detail::scoped_lock lock(globals.mutex);
+            globals.binaries.insert(key, built);
+        }
+
+        return p;
+    }
+
+    // refers to a key and options pair owned by the caller
+    struct key_ref
+    {
+        const std::string &key;
+        const std::string &options;
+    };
+
+    struct key_hash
+    {
+        size_t operator()(const key_type &k) const
+        {
+            return hash(k.first, k.second);
+        }
+
+        size_t operator()(const key_ref &k) const
+        {
+            return hash(k.key, k.options);
+        }
+
+        static size_t hash(const std::string &key, const std::string &options)
+        {
+            size_t seed = 0;
+            boost::hash_combine(seed, key);
+            boost::hash_combine(seed, options);
+            return seed;
+        }
+    };
+
+    struct key_equal
+    {
+        bool operator()(const key_type &a, const key_type &b) const
+        {
+            return a == b;
+        }
+
+        bool operator()(const key_ref &a, const key_type &b) const
+        {
+            return a.key == b.first && a.options == b.second;
+        }
+
+        bool operator()(const key_type &a, const key_ref &b) const
+        {
+            return (*this)(b, a);
+        }
+    };
+
+    typedef boost::unordered_map<key_type, event, key_hash, key_equal> pending_map;
+    typedef detail::lru_cache<key_type, entry, key_hash, key_equal> cache_type;
+
+    void get_or_build_to(const std::string &key,
+                         const std::string &options,
+                         const std::string &source,
+                         const context &context,
+                         program *result)
+    {
+        *result = get_or_build(key, options, source, context);
+    }
+
+    // looks up the program with ref and counts the hit or miss
+    boost::optional<program> lookup(const key_ref &ref)
+    {
+        boost::optional<entry> e = m_cache.get(ref, key_hash(), key_equal());
+        if(!e){
+            m_statistics.misses++;
+            return boost::none;
+        }
+
+        m_statistics.hits++;
+        return e->program;
+    }
+
+    // stores the program with key, evicting a program if the cache is full
+    void store(const key_type &key, const program &program, ulong_ build_time)
+    {
+        if(m_cache.size() >= m_cache.capacity() && !m_cache.contains(key)){
+            evict();
+        }
+
+        m_cache.insert(key, entry(program, build_time));
+    }
+
+    // evicts a program according to the eviction policy
+    void evict()
+    {
+        cache_type::const_iterator victim = --m_cache.end();
+
+        if(m_policy == cost_aware){
+            const size_t window = (std::max)(m_cache.capacity() / 2, size_t(1));
+
+            cache_type::const_iterator i = victim;
+            for(size_t n = 1; n < window && i != m_cache.begin(); n++){
+                --i;
+                if(i->second.build_time < victim->second.build_time){
+                    victim = i;
+                }
+            }
+        }
+
+        const key_type key = victim->first;
+        m_cache.erase(key);
+        m_statistics.evictions++;
+    }
+
+    // waits for the asynchronous build of the program with ref (if any) to
+    // complete. if the build failed the program is removed from the cache
+    // and the error is rethrown.
+    void wait_for_pending_build(const key_ref &ref, detail::scoped_lock &lock)
+    {
+        if(m_pending.empty()){
+            return;
+        }
+
+        pending_map::iterator i = m_pending.find(ref, key_hash(), key_equal());
+        if(i == m_pending.end()){
+            return;
+        }
+
+        const event build_event = i->second;
+        const key_type cache_key(ref.key, ref.options);
+
+        lock.unlock();
+        try {
+            build_event.wait();
+        }
+        catch(...){
+            lock.lock();
+            remove_pending_build(cache_key, build_event, true);
+            throw;
+        }
+        lock.lock();
+
+        remove_pending_build(cache_key, build_event, false);
+    }
+
+    // removes the pending build for key unless it has been replaced
+    void remove_pending_build(const key_type &key, const event &build_event, bool failed)
+    {
+        pending_map::iterator i = m_pending.find(key);
+        if(i == m_pending.end() || i->second != build_event){
+            return;
+        }
+
+        m_pending.erase(i);
+
+        if(failed){
+            m_cache.erase(key);
+        }
+    }
+
+    cache_type m_cache;
+    eviction_policy m_policy;
+    statistics m_statistics;
+    pending_map m_pending;
+    std::set<key_type> m_building;
+    mutable detail::mutex m_mutex;
+    detail::condition_variable m_built;
 };
 
 } // end compute namespace
@@ -0,0 +1,272 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_SCRATCH_SPACE_HPP
+#define BOOST_COMPUTE_UTILITY_SCRATCH_SPACE_HPP
+
+#include <map>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+#include <boost/compute/detail/global_static.hpp>
+
+namespace boost {
+namespace compute {
+
+#if defined(CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+/// \class scratch_space
+/// \brief Caller-provided memory for the temporary buffers of algorithms.
+///
+/// Algorithms normally draw their temporary buffers from the global
+/// buffer_pool of their context, which allocates new memory objects when
+/// no idle buffer fits. A scratch_space lets the caller provide the memory
+/// for these temporaries up front. While a scoped_scratch_space is active
+/// on the current thread, the temporaries of the algorithms running on its
+/// context are carved out of the scratch space's buffer (as sub-buffers)
+/// instead.
+///
+/// If a temporary does not fit into the remaining space it is drawn from
+/// the buffer_pool as usual, or, if the scratch space was created with
+/// \p fallback set to \c false, an opencl_error with
+/// \c CL_MEM_OBJECT_ALLOCATION_FAILURE is thrown so that jobs never
+/// allocate more device memory than was set aside for them.
+///
+/// \code
+/// // reserve 64 MB for the temporaries of the sort
+/// boost::compute::scratch_space scratch(
+///     boost::compute::buffer(context, 64 * 1024 * 1024), false
+/// );
+///
+/// {
+///     boost::compute::scoped_scratch_space use_scratch(scratch);
+///     boost::compute::sort(vec.begin(), vec.end(), queue);
+/// }
+/// \endcode
+///
+/// Parts of the space are handed out again as soon as the temporary using
+/// them is released, so the algorithms using a scratch space must run on
+/// a single in-order command queue.
+///
+/// The sort_scratch_size() function (and its equivalents for other
+/// algorithms) returns the amount of temporary memory an algorithm needs.
+///
+/// The radix sorts of sort() and sort_by_key(), stable_partition(),
+/// is_permutation() and the set operations (e.g. set_union()) check
+/// whether their temporaries fit into the free space of a scratch space
+/// without fallback (or otherwise into the device memory not allocated by
+/// Boost.Compute). If they do not, they run a lower-footprint strategy
+/// (e.g. processing the range in chunks or on the host) instead of
+/// throwing, which is reported to trace_listener::on_strategy().
+///
+/// \opencl_version_warning{1,1}
+///
+/// \see buffer_pool, memory_usage
+class scratch_space : boost::noncopyable
+{
+public:
+    /// Creates a new scratch space using the memory of \p buffer. If
+    /// \p fallback is \c true temporaries which do not fit into the space
+    /// are drawn from the buffer_pool, otherwise an exception is thrown.
+    explicit scratch_space(const buffer &buffer, bool fallback = true)
+        : m_buffer(buffer),
+          m_context(buffer.get_context()),
+          m_fallback(fallback),
+          m_used(0),
+          m_peak(0)
+    {
+        const uint_ align_bits =
+            m_context.get_device().get_info<uint_>(CL_DEVICE_MEM_BASE_ADDR_ALIGN);
+        m_alignment = (std::max)(size_t(align_bits / 8), size_t(1));
+
+        m_free[0] = buffer.size() - buffer.size() % m_alignment;
+    }
+
+    /// Destroys the scratch space.
+    ~scratch_space()
+    {
+    }
+
+    /// Returns the buffer holding the memory of the scratch space.
+    const buffer& get_buffer() const
+    {
+        return m_buffer;
+    }
+
+    /// Returns the context of the scratch space.
+    const context& get_context() const
+    {
+        return m_context;
+    }
+
+    /// Returns \c true if temporaries which do not fit into the space are
+    /// drawn from the buffer_pool.
+    bool fallback() const
+    {
+        return m_fallback;
+    }
+
+    /// Returns the size in bytes of the scratch space.
+    size_t size() const
+    {
+        return m_buffer.size();
+    }
+
+    /// Returns the number of bytes currently handed out.
+    size_t used() const
+    {
+        return m_used;
+    }
+
+    /// Returns the largest number of bytes handed out at any time.
+    size_t peak() const
+    {
+        return m_peak;
+    }
+
+    /// Returns a sub-buffer of at least \p size bytes, or a null buffer if
+    /// there is not enough contiguous free space.
+    buffer allocate(size_t size)
+    {
+        // round up to the alignment required for sub-buffers
+        size = (std::max)(size, size_t(1));
+        size = ((size + m_alignment - 1) / m_alignment) * m_alignment;
+
+        // first fit
+        for(free_map::iterator i = m_free.begin(); i != m_free.end(); ++i){
+            if(i->second < size){
+                continue;
+            }
+
+            const size_t offset = i->first;
+            const size_t remaining = i->second - size;
+            m_free.erase(i);
+            if(remaining){
+                m_free[offset + size] = remaining;
+            }
+
+            buffer sub_buffer =
+                m_buffer.create_subbuffer(buffer::read_write, offset, size);
+            m_allocated[sub_buffer.get()] = std::make_pair(offset, size);
+
+            m_used += size;
+            m_peak = (std::max)(m_peak, m_used);
+
+            return sub_buffer;
+        }
+
+        return buffer();
+    }
+
+    /// Returns \p sub_buffer (which must have been allocated from this
+    /// scratch space) to the free space.
+    void release(const buffer &sub_buffer)
+    {
+        allocated_map::iterator i = m_allocated.find(sub_buffer.get());
+        if(i == m_allocated.end()){
+            return;
+        }
+
+        size_t offset = i->second.first;
+        size_t size = i->second.second;
+        m_allocated.erase(i);
+        m_used -= size;
+
+        // merge with the following free range
+        free_map::iterator next = m_free.find(offset + size);
+        if(next != m_free.end()){
+            size += next->second;
+            m_free.erase(next);
+        }
+
+        // merge with the preceding free range
+        free_map::iterator prev = m_free.lower_bound(offset);
+        if(prev != m_free.begin()){
+            --prev;
+            if(prev->first + prev->second == offset){
+                prev->second += size;
+                return;
+            }
+        }
+
+        m_free[offset] = size;
+    }
+
+private:
+    typedef std::map<size_t, size_t> free_map;
+    typedef std::map<cl_mem, std::pair<size_t, size_t> > allocated_map;
+
+    buffer m_buffer;
+    context m_context;
+    bool m_fallback;
+    size_t m_alignment;
+    size_t m_used;
+    size_t m_peak;
+    free_map m_free;
+    allocated_map m_allocated;
+};
+
+namespace detail {
+
+// scratch spaces made active with scoped_scratch_space on this thread
+inline std::vector<scratch_space *>& active_scratch_spaces()
+{
+    BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(std::vector<scratch_space *>, spaces, );
+
+    return spaces;
+}
+
+// returns the most recently activated scratch space for context or null
+inline scratch_space* get_active_scratch_space(const context &context)
+{
+    const std::vector<scratch_space *> &spaces = active_scratch_spaces();
+    for(size_t i = spaces.size(); i > 0; i--){
+        if(spaces[i - 1]->get_context() == context){
+            return spaces[i - 1];
+        }
+    }
+
+    return 0;
+}
+
+} // end detail namespace
+
+/// \class scoped_scratch_space
+/// \brief Makes a scratch_space active for the current scope.
+///
+/// While the scoped_scratch_space exists the algorithms running on the
+/// context of the scratch space draw their temporary buffers from it.
+///
+/// \see scratch_space
+class scoped_scratch_space : boost::noncopyable
+{
+public:
+    explicit scoped_scratch_space(scratch_space &space)
+    {
+        detail::active_scratch_spaces().push_back(&space);
+    }
+
+    ~scoped_scratch_space()
+    {
+        detail::active_scratch_spaces().pop_back();
+    }
+};
+#endif // CL_VERSION_1_1
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_SCRATCH_SPACE_HPP
@@ -0,0 +1,370 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_TRACE_HPP
+#define BOOST_COMPUTE_UTILITY_TRACE_HPP
+
+#include <string>
+#include <vector>
+
+#include <boost/preprocessor/cat.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/config.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/global_static.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class trace_record
+/// \brief Describes a command enqueued by Boost.Compute.
+///
+/// A record holds a reference to its command queue, so that the queue
+/// handle stays valid (and is not reused for another queue) as long as
+/// the record or one of its copies exists.
+///
+/// \see trace_listener
+struct trace_record
+{
+    trace_record()
+        : command(0),
+          queue(0),
+          bytes(0),
+          queued(0),
+          submitted(0),
+          started(0),
+          ended(0)
+    {
+    }
+
+    trace_record(const trace_record &other)
+        : algorithm(other.algorithm),
+          kernel(other.kernel),
+          command(other.command),
+          queue(other.queue),
+          bytes(other.bytes),
+          event_(other.event_),
+          queued(other.queued),
+          submitted(other.submitted),
+          started(other.started),
+          ended(other.ended)
+    {
+        if(queue){
+            clRetainCommandQueue(queue);
+        }
+    }
+
+    trace_record& operator=(const trace_record &other)
+    {
+        if(this != &other){
+            if(other.queue){
+                clRetainCommandQueue(other.queue);
+            }
+            if(queue){
+                clReleaseCommandQueue(queue);
+            }
+
+            algorithm = other.algorithm;
+            kernel = other.kernel;
+            command = other.command;
+            queue = other.queue;
+            bytes = other.bytes;
+            event_ = other.event_;
+            queued = other.queued;
+            submitted = other.submitted;
+            started = other.started;
+            ended = other.ended;
+        }
+
+        return *this;
+    }
+
+    ~trace_record()
+    {
+        if(queue){
+            clReleaseCommandQueue(queue);
+        }
+    }
+
+    /// The name of the (outermost) algorithm which enqueued the command,
+    /// or an empty string for commands enqueued outside of algorithms.
+    std::string algorithm;
+
+    /// The name of the kernel for kernel launches.
+    std::string kernel;
+
+    /// The type of the command (e.g. \c CL_COMMAND_NDRANGE_KERNEL).
+    cl_command_type command;
+
+    /// The command queue the command was enqueued to (retained by the
+    /// record).
+    cl_command_queue queue;
+
+    /// The number of bytes moved by transfers, copies and fills.
+    size_t bytes;
+
+    /// The event of the command.
+    event event_;
+
+    /// The \c CL_PROFILING_COMMAND_QUEUED, \c _SUBMIT, \c _START and
+    /// \c _END timestamps of the command in nanoseconds. These are set in
+    /// trace_listener::on_complete() if the queue has profiling enabled
+    /// and are zero otherwise.
+    ulong_ queued;
+    ulong_ submitted;
+    ulong_ started;
+    ulong_ ended;
+};
+
+/// \class trace_listener
+/// \brief Receives the commands enqueued by Boost.Compute.
+///
+/// Tracing is only compiled in if the \c BOOST_COMPUTE_ENABLE_TRACING
+/// macro is defined and is then enabled at runtime by installing a
+/// listener with set_trace_listener(). Each command enqueued by a
+/// command_queue (including all of the internal kernels and copies of the
+/// algorithms) is then passed to on_enqueue() and, once complete, to
+/// on_complete() with its profiling timestamps. Lookups in the program
+/// cache are passed to on_program_cache() and the lower-footprint
+/// strategies chosen by algorithms whose temporary buffers do not fit into
+/// the available device memory to on_strategy().
+///
+/// on_complete() is called from an event callback which may run on a
+/// thread of the OpenCL implementation.
+///
+/// \see trace_record
+class trace_listener
+{
+public:
+    virtual ~trace_listener()
+    {
+    }
+
+    /// Called after a command was enqueued.
+    virtual void on_enqueue(const trace_record &record)
+    {
+        (void) record;
+    }
+
+    /// Called after a command completed.
+    virtual void on_complete(const trace_record &record)
+    {
+        (void) record;
+    }
+
+    /// Called when the program with \p key is requested from the program
+    /// cache. \p hit is \c true if the program was already in the cache.
+    virtual void on_program_cache(const std::string &key, bool hit)
+    {
+        (void) key;
+        (void) hit;
+    }
+
+    /// Called when \p algorithm runs with the lower-footprint
+    /// \p strategy (e.g. \c "chunked") instead of its default one because
+    /// there is not enough device memory for the temporary buffers of the
+    /// default one.
+    virtual void on_strategy(const std::string &algorithm,
+                             const std::string &strategy)
+    {
+        (void) algorithm;
+        (void) strategy;
+    }
+};
+
+namespace detail {
+
+inline trace_listener*& global_trace_listener()
+{
+    static trace_listener *listener = 0;
+
+    return listener;
+}
+
+// names of the algorithms currently executing on this thread
+inline std::vector<const char *>& trace_algorithm_stack()
+{
+    BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(std::vector<const char *>, stack, );
+
+    return stack;
+}
+
+inline bool trace_active()
+{
+    return global_trace_listener() != 0;
+}
+
+// records the name of an algorithm while it is executing
+class trace_scope
+{
+public:
+    explicit trace_scope(const char *name)
+        : m_active(trace_active())
+    {
+        if(m_active){
+            trace_algorithm_stack().push_back(name);
+        }
+    }
+
+    ~trace_scope()
+    {
+        if(m_active){
+            trace_algorithm_stack().pop_back();
+        }
+    }
+
+private:
+    bool m_active;
+};
+
+#ifdef CL_VERSION_1_1
+struct trace_completion
+{
+    trace_completion(const trace_record &record_, bool profiled_)
+        : record(record_), profiled(profiled_)
+    {
+    }
+
+    void operator()()
+    {
+        trace_listener *listener = global_trace_listener();
+        if(!listener){
+            return;
+        }
+
+        if(profiled){
+            record.queued =
+                record.event_.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_QUEUED);
+            record.submitted =
+                record.event_.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_SUBMIT);
+            record.started =
+                record.event_.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_START);
+            record.ended =
+                record.event_.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_END);
+        }
+
+        listener->on_complete(record);
+    }
+
+    trace_record record;
+    bool profiled;
+};
+#endif // CL_VERSION_1_1
+
+inline void trace_command(cl_command_queue queue,
+                          cl_command_type command,
+                          const std::string &kernel,
+                          size_t bytes,
+                          const event &event_)
+{
+    trace_listener *listener = global_trace_listener();
+    if(!listener){
+        return;
+    }
+
+    trace_record record;
+    const std::vector<const char *> &stack = trace_algorithm_stack();
+    if(!stack.empty()){
+        record.algorithm = stack.front();
+    }
+    record.kernel = kernel;
+    record.command = command;
+    record.queue = queue;
+    clRetainCommandQueue(queue);
+    record.bytes = bytes;
+    record.event_ = event_;
+
+    listener->on_enqueue(record);
+
+    #ifdef CL_VERSION_1_1
+    cl_command_queue_properties properties = 0;
+    clGetCommandQueueInfo(
+        queue, CL_QUEUE_PROPERTIES, sizeof(properties), &properties, 0
+    );
+    event_.set_callback(
+        trace_completion(record, (properties & CL_QUEUE_PROFILING_ENABLE) != 0)
+    );
+    #endif // CL_VERSION_1_1
+}
+
+inline void trace_program_cache(const std::string &key, bool hit)
+{
+    if(trace_listener *listener = global_trace_listener()){
+        listener->on_program_cache(key, hit);
+    }
+}
+
+inline void trace_strategy(const char *algorithm, const char *strategy)
+{
+    if(trace_listener *listener = global_trace_listener()){
+        listener->on_strategy(algorithm, strategy);
+    }
+}
+
+} // end detail namespace
+
+/// Installs \p listener to receive the commands enqueued by Boost.Compute
+/// (see trace_listener). Passing \c 0 disables tracing.
+///
+/// This has no effect unless \c BOOST_COMPUTE_ENABLE_TRACING is defined.
+inline void set_trace_listener(trace_listener *listener)
+{
+    detail::global_trace_listener() = listener;
+}
+
+/// Returns the installed trace listener or \c 0 if tracing is disabled.
+inline trace_listener* get_trace_listener()
+{
+    return detail::global_trace_listener();
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#ifdef BOOST_COMPUTE_ENABLE_TRACING
+// records the name of the enclosing algorithm for the traced commands
+#define BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM(name) \
+    ::boost::compute::detail::trace_scope \
+        BOOST_PP_CAT(boost_compute_trace_scope_, __LINE__)(name);
+
+// makes event_ (an event pointer) point to a local event if it is null so
+// that the traced command always has an event
+#define BOOST_COMPUTE_DETAIL_TRACE_EVENT(event_) \
+    ::boost::compute::event boost_compute_trace_event_; \
+    if(!event_ && ::boost::compute::detail::trace_active()){ \
+        event_ = &boost_compute_trace_event_; \
+    }
+
+// reports the command enqueued with event_ to the trace listener
+#define BOOST_COMPUTE_DETAIL_TRACE_COMMAND(queue, command, kernel, bytes, event_) \
+    if(event_ && ::boost::compute::detail::trace_active()){ \
+        ::boost::compute::detail::trace_command( \
+            queue, command, kernel, bytes, *event_ \
+        ); \
+    }
+
+// reports a lookup in the program cache to the trace listener
+#define BOOST_COMPUTE_DETAIL_TRACE_PROGRAM_CACHE(key, hit) \
+    ::boost::compute::detail::trace_program_cache(key, hit);
+
+// reports the lower-footprint strategy chosen by an algorithm
+#define BOOST_COMPUTE_DETAIL_TRACE_STRATEGY(algorithm, strategy) \
+    ::boost::compute::detail::trace_strategy(algorithm, strategy);
+#else
+#define BOOST_COMPUTE_DETAIL_TRACE_ALGORITHM(name)
+#define BOOST_COMPUTE_DETAIL_TRACE_EVENT(event_)
+#define BOOST_COMPUTE_DETAIL_TRACE_COMMAND(queue, command, kernel, bytes, event_)
+#define BOOST_COMPUTE_DETAIL_TRACE_PROGRAM_CACHE(key, hit)
+#define BOOST_COMPUTE_DETAIL_TRACE_STRATEGY(algorithm, strategy)
+#endif // BOOST_COMPUTE_ENABLE_TRACING
+
+#endif // BOOST_COMPUTE_UTILITY_TRACE_HPP
@@ -0,0 +1,355 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_TRANSFER_COUNTERS_HPP
+#define BOOST_COMPUTE_UTILITY_TRANSFER_COUNTERS_HPP
+
+#include <map>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/mutex.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \struct transfer_counters
+/// \brief The data moved by the commands of a command queue.
+///
+/// The counters of a queue are collected between
+/// command_queue::enable_transfer_counters() and
+/// command_queue::disable_transfer_counters() and returned by
+/// command_queue::get_transfer_counters(). They include the transfers of
+/// copy(), copy_async(), mapped_view and the values read back by the
+/// algorithms.
+///
+/// Reads, writes and copies of buffers and images are counted with the
+/// number of bytes they move. Maps of buffers are counted as reads (with
+/// \c CL_MAP_READ) and writes (with \c CL_MAP_WRITE) of the mapped range,
+/// though devices sharing memory with the host may not copy any data.
+///
+/// The times are the sums of the profiled execution times of the commands
+/// in nanoseconds. They are only measured if enabled and if the queue was
+/// created with \c command_queue::enable_profiling, and are added once the
+/// commands completed (which requires OpenCL 1.1).
+struct transfer_counters
+{
+    transfer_counters()
+        : host_to_device_bytes(0),
+          host_to_device_commands(0),
+          host_to_device_time(0),
+          device_to_host_bytes(0),
+          device_to_host_commands(0),
+          device_to_host_time(0),
+          device_to_device_bytes(0),
+          device_to_device_commands(0),
+          device_to_device_time(0)
+    {
+    }
+
+    /// Bytes written from host memory to the device.
+    ulong_ host_to_device_bytes;
+    /// Number of commands writing to the device.
+    ulong_ host_to_device_commands;
+    /// Execution time of the commands writing to the device.
+    ulong_ host_to_device_time;
+
+    /// Bytes read from the device to host memory.
+    ulong_ device_to_host_bytes;
+    /// Number of commands reading from the device.
+    ulong_ device_to_host_commands;
+    /// Execution time of the commands reading from the device.
+    ulong_ device_to_host_time;
+
+    /// Bytes copied between memory objects on the device.
+    ulong_ device_to_device_bytes;
+    /// Number of commands copying between memory objects.
+    ulong_ device_to_device_commands;
+    /// Execution time of the commands copying between memory objects.
+    ulong_ device_to_device_time;
+
+    /// Returns the bandwidth (in bytes per second) of the writes to the
+    /// device, or zero if their time was not measured.
+    double host_to_device_bandwidth() const
+    {
+        return bandwidth(host_to_device_bytes, host_to_device_time);
+    }
+
+    /// Returns the bandwidth (in bytes per second) of the reads from the
+    /// device, or zero if their time was not measured.
+    double device_to_host_bandwidth() const
+    {
+        return bandwidth(device_to_host_bytes, device_to_host_time);
+    }
+
+    /// Returns the bandwidth (in bytes per second) of the copies on the
+    /// device, or zero if their time was not measured.
+    double device_to_device_bandwidth() const
+    {
+        return bandwidth(device_to_device_bytes, device_to_device_time);
+    }
+
+private:
+    static double bandwidth(ulong_ bytes, ulong_ time)
+    {
+        return time ? static_cast<double>(bytes) / (time * 1e-9) : 0.0;
+    }
+};
+
+namespace detail {
+
+enum transfer_direction {
+    host_to_device_transfer,
+    device_to_host_transfer,
+    device_to_device_transfer
+};
+
+// the counters of the command queues counting their transfers (see
+// command_queue::enable_transfer_counters())
+class transfer_counter_registry : boost::noncopyable
+{
+public:
+    transfer_counter_registry()
+        : m_count(0)
+    {
+    }
+
+    void enable(cl_command_queue queue, bool measure_time)
+    {
+        scoped_lock lock(m_mutex);
+
+        entry &e = m_entries[queue];
+        e.measure_time = measure_time;
+        m_count = m_entries.size();
+    }
+
+    void disable(cl_command_queue queue)
+    {
+        scoped_lock lock(m_mutex);
+
+        m_entries.erase(queue);
+        m_count = m_entries.size();
+    }
+
+    // returns true if any queue is counting. this is checked (without
+    // locking) before each transfer so that it costs nothing otherwise.
+    bool active() const
+    {
+        return m_count != 0;
+    }
+
+    bool is_counting(cl_command_queue queue) const
+    {
+        scoped_lock lock(m_mutex);
+
+        return m_entries.count(queue) != 0;
+    }
+
+    bool is_timing(cl_command_queue queue) const
+    {
+        scoped_lock lock(m_mutex);
+
+        entry_map::const_iterator i = m_entries.find(queue);
+        return i != m_entries.end() && i->second.measure_time;
+    }
+
+    transfer_counters counters(cl_command_queue queue) const
+    {
+        scoped_lock lock(m_mutex);
+
+        entry_map::const_iterator i = m_entries.find(queue);
+        return i != m_entries.end() ? i->second.counters : transfer_counters();
+    }
+
+    void reset(cl_command_queue queue)
+    {
+        scoped_lock lock(m_mutex);
+
+        entry_map::iterator i = m_entries.find(queue);
+        if(i != m_entries.end()){
+            i->second.counters = transfer_counters();
+        }
+    }
+
+    // counts the transfer, returns true if its time should be measured
+    bool add(cl_command_queue queue, transfer_direction direction, size_t bytes)
+    {
+        scoped_lock lock(m_mutex);
+
+        entry_map::iterator i = m_entries.find(queue);
+        if(i == m_entries.end()){
+            return false;
+        }
+
+        transfer_counters &c = i->second.counters;
+        switch(direction){
+        case host_to_device_transfer:
+            c.host_to_device_bytes += bytes;
+            c.host_to_device_commands++;
+            break;
+        case device_to_host_transfer:
+            c.device_to_host_bytes += bytes;
+            c.device_to_host_commands++;
+            break;
+        case device_to_device_transfer:
+            c.device_to_device_bytes += bytes;
+            c.device_to_device_commands++;
+            break;
+        }
+
+        return i->second.measure_time;
+    }
+
+    void add_time(cl_command_queue queue, transfer_direction direction, ulong_ time)
+    {
+        scoped_lock lock(m_mutex);
+
+        entry_map::iterator i = m_entries.find(queue);
+        if(i == m_entries.end()){
+            return;
+        }
+
+        transfer_counters &c = i->second.counters;
+        switch(direction){
+        case host_to_device_transfer:
+            c.host_to_device_time += time;
+            break;
+        case device_to_host_transfer:
+            c.device_to_host_time += time;
+            break;
+        case device_to_device_transfer:
+            c.device_to_device_time += time;
+            break;
+        }
+    }
+
+    // the registry is shared by all threads
+    static transfer_counter_registry& get()
+    {
+        static transfer_counter_registry registry;
+
+        return registry;
+    }
+
+private:
+    struct entry
+    {
+        entry()
+            : measure_time(false)
+        {
+        }
+
+        bool measure_time;
+        transfer_counters counters;
+    };
+
+    typedef std::map<cl_command_queue, entry> entry_map;
+
+    mutable mutex m_mutex;
+    entry_map m_entries;
+    size_t m_count;
+};
+
+// returns true if queue is counting its transfers
+inline bool is_counting_transfers(cl_command_queue queue)
+{
+    transfer_counter_registry &registry = transfer_counter_registry::get();
+
+    return registry.active() && registry.is_counting(queue);
+}
+
+// returns true if queue measures the time of its transfers
+inline bool is_timing_transfers(cl_command_queue queue)
+{
+    transfer_counter_registry &registry = transfer_counter_registry::get();
+
+    return registry.active() && registry.is_timing(queue);
+}
+
+inline ulong_ transfer_time(const event &event_)
+{
+    return event_.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_END) -
+           event_.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_START);
+}
+
+#ifdef CL_VERSION_1_1
+struct transfer_completion
+{
+    transfer_completion(cl_command_queue queue_,
+                        transfer_direction direction_,
+                        const event &event__)
+        : queue(queue_), direction(direction_), event_(event__)
+    {
+    }
+
+    void operator()()
+    {
+        try {
+            transfer_counter_registry::get().add_time(
+                queue, direction, transfer_time(event_)
+            );
+        }
+        catch(...){
+            // the event has no profiling information
+        }
+    }
+
+    cl_command_queue queue;
+    transfer_direction direction;
+    event event_;
+};
+#endif // CL_VERSION_1_1
+
+// counts the transfer of bytes enqueued to queue with event_ (which may be
+// null) and measures its time if enabled
+inline void count_transfer(cl_command_queue queue,
+                           transfer_direction direction,
+                           size_t bytes,
+                           const event *event_)
+{
+    if(!transfer_counter_registry::get().add(queue, direction, bytes) || !event_){
+        return;
+    }
+
+    #ifdef CL_VERSION_1_1
+    cl_command_queue_properties properties = 0;
+    clGetCommandQueueInfo(
+        queue, CL_QUEUE_PROPERTIES, sizeof(properties), &properties, 0
+    );
+    if(properties & CL_QUEUE_PROFILING_ENABLE){
+        event_->set_callback(transfer_completion(queue, direction, *event_));
+    }
+    #endif // CL_VERSION_1_1
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+// makes event_ (an event pointer) point to a local event if it is null and
+// the transfers of queue are timed, so that the transfer has an event
+#define BOOST_COMPUTE_DETAIL_TRANSFER_EVENT(queue, event_) \
+    ::boost::compute::event boost_compute_transfer_event_; \
+    if(!event_ && ::boost::compute::detail::is_timing_transfers(queue)){ \
+        event_ = &boost_compute_transfer_event_; \
+    }
+
+// counts the transfer of bytes if queue is counting its transfers
+#define BOOST_COMPUTE_DETAIL_COUNT_TRANSFER(queue, direction, bytes, event_) \
+    if(::boost::compute::detail::transfer_counter_registry::get().active()){ \
+        ::boost::compute::detail::count_transfer( \
+            queue, ::boost::compute::detail::direction, bytes, event_ \
+        ); \
+    }
+
+#endif // BOOST_COMPUTE_UTILITY_TRANSFER_COUNTERS_HPP
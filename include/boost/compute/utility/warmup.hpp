@@ -0,0 +1,209 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_WARMUP_HPP
+#define BOOST_COMPUTE_UTILITY_WARMUP_HPP
+
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/function.hpp>
+#include <boost/mpl/for_each.hpp>
+#include <boost/mpl/is_sequence.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/thread_pool.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/min_element.hpp>
+#include <boost/compute/algorithm/max_element.hpp>
+#include <boost/compute/algorithm/stable_sort.hpp>
+#include <boost/compute/algorithm/inclusive_scan.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/container/vector.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Flags selecting the algorithms compiled by warmup().
+enum warmup_algorithm {
+    warmup_sort = 1 << 0,
+    warmup_reduce = 1 << 1,
+    warmup_scan = 1 << 2,
+    warmup_min_max = 1 << 3,
+    warmup_all = warmup_sort | warmup_reduce | warmup_scan | warmup_min_max
+};
+
+namespace detail {
+
+// sizes used to run the algorithms. most algorithms choose their
+// implementation based on the input size so both a small and a large
+// input are used in order to compile every code path.
+static const size_t warmup_small_size = 16;
+static const size_t warmup_large_size = 16384;
+
+template<class T>
+inline void warmup_size(size_t size, int algorithms, command_queue &queue)
+{
+    vector<T> input(size, queue.get_context());
+    vector<T> output(size, queue.get_context());
+
+    ::boost::compute::fill(input.begin(), input.end(), T(), queue);
+
+    if(algorithms & warmup_sort){
+        ::boost::compute::sort(input.begin(), input.end(), queue);
+        ::boost::compute::stable_sort(input.begin(), input.end(), queue);
+    }
+    if(algorithms & warmup_reduce){
+        ::boost::compute::reduce(input.begin(), input.end(), output.begin(), queue);
+    }
+    if(algorithms & warmup_scan){
+        ::boost::compute::inclusive_scan(
+            input.begin(), input.end(), output.begin(), queue
+        );
+        ::boost::compute::exclusive_scan(
+            input.begin(), input.end(), output.begin(), queue
+        );
+    }
+    if(algorithms & warmup_min_max){
+        ::boost::compute::min_element(input.begin(), input.end(), queue);
+        ::boost::compute::max_element(input.begin(), input.end(), queue);
+    }
+}
+
+template<class T>
+inline void warmup_type(int algorithms, command_queue &queue)
+{
+    warmup_size<T>(warmup_small_size, algorithms, queue);
+    warmup_size<T>(warmup_large_size, algorithms, queue);
+
+    queue.finish();
+}
+
+// warms up T with a command queue of its own for device, so that the
+// types of a sequence can be warmed up from different threads
+template<class T>
+inline void warmup_type_with_device(int algorithms,
+                                    const context &context,
+                                    const device &device)
+{
+    command_queue queue(context, device);
+
+    warmup_type<T>(algorithms, queue);
+}
+
+// adds the task warming up each type of a sequence to tasks
+struct warmup_functor
+{
+    warmup_functor(int algorithms,
+                   command_queue &queue,
+                   std::vector<boost::function<void()> > &tasks)
+        : m_algorithms(algorithms),
+          m_queue(queue),
+          m_tasks(tasks)
+    {
+    }
+
+    template<class T>
+    void operator()(T) const
+    {
+        #ifdef BOOST_COMPUTE_THREAD_SAFE
+        m_tasks.push_back(
+            boost::bind(&warmup_type_with_device<T>, m_algorithms,
+                        m_queue.get_context(), m_queue.get_device())
+        );
+        #else
+        m_tasks.push_back(
+            boost::bind(&warmup_type<T>, m_algorithms, boost::ref(m_queue))
+        );
+        #endif
+    }
+
+    int m_algorithms;
+    command_queue &m_queue;
+    std::vector<boost::function<void()> > &m_tasks;
+};
+
+template<class Types>
+inline void dispatch_warmup(int algorithms, command_queue &queue, boost::true_type)
+{
+    std::vector<boost::function<void()> > tasks;
+    boost::mpl::for_each<Types>(warmup_functor(algorithms, queue, tasks));
+
+    invoke_concurrently(tasks);
+}
+
+template<class T>
+inline void dispatch_warmup(int algorithms, command_queue &queue, boost::false_type)
+{
+    warmup_type<T>(algorithms, queue);
+}
+
+} // end detail namespace
+
+/// Compiles the programs used by the built-in \p algorithms for the value
+/// type \p T so that later calls with that type do not have to wait for
+/// the OpenCL compiler.
+///
+/// \p T may either be a single scalar type or a Boost.MPL sequence of
+/// scalar types. \p algorithms is a combination of \c warmup_algorithm
+/// flags (by default all of them).
+///
+/// The algorithms are executed on small inputs with \p queue which
+/// stores the compiled programs in the global \ref program_cache for the
+/// queue's context (and, if enabled, in the offline cache). Because the
+/// same code paths as normal calls are executed, exactly the programs
+/// needed for the queue's device are built. The programs of one type are
+/// built one after another as the algorithms are executed.
+///
+/// For example, to compile the sort and reduce programs for \c int and
+/// \c float at startup:
+/// \code
+/// boost::compute::warmup<boost::mpl::vector<int, float> >(
+///     boost::compute::warmup_sort | boost::compute::warmup_reduce, queue
+/// );
+/// \endcode
+///
+/// When \c BOOST_COMPUTE_THREAD_SAFE is defined the global program cache
+/// is shared between threads, so warmup() can be called from a separate
+/// thread (with its own command queue) while the application continues
+/// its initialization. The types of a sequence are then also warmed up
+/// concurrently (each with its own command queue for the queue's device),
+/// as some OpenCL compilers build each program on a single thread.
+///
+/// \see program_cache
+template<class T>
+inline void warmup(int algorithms = warmup_all,
+                   command_queue &queue = system::default_queue())
+{
+    typedef typename boost::mpl::is_sequence<T>::type is_sequence;
+
+    detail::dispatch_warmup<T>(
+        algorithms, queue, boost::integral_constant<bool, is_sequence::value>()
+    );
+}
+
+/// \overload
+template<class T>
+inline void warmup(command_queue &queue)
+{
+    warmup<T>(warmup_all, queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_WARMUP_HPP
@@ -0,0 +1,264 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_WAIT_STRATEGY_HPP
+#define BOOST_COMPUTE_WAIT_STRATEGY_HPP
+
+#include <cstdlib>
+
+#include <boost/config.hpp>
+
+#if !defined(BOOST_NO_CXX11_HDR_CHRONO) && !defined(BOOST_NO_CXX11_HDR_THREAD)
+#  include <chrono>
+#  include <thread>
+#  define BOOST_COMPUTE_DETAIL_STD_WAIT_CLOCK
+#else
+#  if defined(BOOST_HAS_CLOCK_GETTIME)
+#    include <time.h>
+#  endif
+#  if defined(BOOST_HAS_SCHED_YIELD)
+#    include <sched.h>
+#  endif
+#endif
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/exception.hpp>
+#include <boost/compute/detail/getenv.hpp>
+#include <boost/compute/types/fundamental.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// measures the time (in microseconds) spent polling an event. without a
+// monotonic clock each poll is counted as one microsecond.
+class wait_timer
+{
+public:
+    wait_timer()
+        : m_start(now()),
+          m_polls(0)
+    {
+    }
+
+    ulong_ elapsed()
+    {
+        m_polls++;
+
+        #if defined(BOOST_COMPUTE_DETAIL_STD_WAIT_CLOCK) || \
+            defined(BOOST_HAS_CLOCK_GETTIME)
+        return now() - m_start;
+        #else
+        return m_polls;
+        #endif
+    }
+
+    static void yield()
+    {
+        #if defined(BOOST_COMPUTE_DETAIL_STD_WAIT_CLOCK)
+        std::this_thread::yield();
+        #elif defined(BOOST_HAS_SCHED_YIELD)
+        sched_yield();
+        #endif
+    }
+
+private:
+    static ulong_ now()
+    {
+        #if defined(BOOST_COMPUTE_DETAIL_STD_WAIT_CLOCK)
+        return static_cast<ulong_>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+            ).count()
+        );
+        #elif defined(BOOST_HAS_CLOCK_GETTIME)
+        timespec time;
+        clock_gettime(CLOCK_MONOTONIC, &time);
+        return static_cast<ulong_>(time.tv_sec) * 1000000 +
+               static_cast<ulong_>(time.tv_nsec) / 1000;
+        #else
+        return 0;
+        #endif
+    }
+
+private:
+    ulong_ m_start;
+    ulong_ m_polls;
+};
+
+// returns the number of microseconds in the environment variable, or zero
+inline ulong_ wait_time_from_environment(const char *name)
+{
+    const char *value = detail::getenv(name);
+
+    return value ? static_cast<ulong_>(std::strtoul(value, 0, 10)) : 0;
+}
+
+} // end detail namespace
+
+/// \class wait_strategy
+/// \brief Describes how the host waits for commands to complete.
+///
+/// By default, waiting for an event (with event::wait(), future::wait() or
+/// command_queue::finish()) blocks in the OpenCL implementation, which
+/// usually puts the thread to sleep until the device signals completion.
+/// For very short commands the latency of waking the thread up can be much
+/// longer than the command itself.
+///
+/// A wait strategy with a spin time first polls the status of the event
+/// for up to \c spin_time() microseconds, then polls it while yielding the
+/// processor to other threads for up to \c yield_time() more microseconds,
+/// and only then blocks. This trades host processor time for latency.
+///
+/// The default strategy is used by the waiting methods without a
+/// wait_strategy argument and by blocking reads and writes (and thus by
+/// the algorithms which read their results back to the host). It can be
+/// changed with set_default() or with the \c BOOST_COMPUTE_WAIT_SPIN_TIME
+/// and \c BOOST_COMPUTE_WAIT_YIELD_TIME environment variables (in
+/// microseconds):
+/// \code
+/// // spin for up to 100us before blocking
+/// boost::compute::wait_strategy::set_default(
+///     boost::compute::wait_strategy(100)
+/// );
+/// \endcode
+///
+/// \see event::wait(), command_queue::finish()
+class wait_strategy
+{
+public:
+    /// Creates a wait strategy which polls for \p spin_time microseconds
+    /// and then yields for \p yield_time microseconds before blocking. The
+    /// default strategy blocks immediately.
+    explicit wait_strategy(ulong_ spin_time = 0, ulong_ yield_time = 0)
+        : m_spin_time(spin_time),
+          m_yield_time(yield_time)
+    {
+    }
+
+    /// Returns a wait strategy which blocks immediately.
+    static wait_strategy blocking()
+    {
+        return wait_strategy();
+    }
+
+    /// Returns the number of microseconds spent polling without yielding.
+    ulong_ spin_time() const
+    {
+        return m_spin_time;
+    }
+
+    /// Returns the number of microseconds spent polling while yielding.
+    ulong_ yield_time() const
+    {
+        return m_yield_time;
+    }
+
+    /// Returns \c true if the strategy blocks without polling.
+    bool is_blocking() const
+    {
+        return m_spin_time == 0 && m_yield_time == 0;
+    }
+
+    /// Returns the default wait strategy.
+    static wait_strategy get_default()
+    {
+        return default_strategy();
+    }
+
+    /// Sets the default wait strategy to \p strategy.
+    ///
+    /// This should be called before other threads start waiting.
+    static void set_default(const wait_strategy &strategy)
+    {
+        default_strategy() = strategy;
+    }
+
+    /// \internal_
+    ///
+    /// Waits for \p event to complete and throws an opencl_error if its
+    /// command failed.
+    void wait(cl_event event) const
+    {
+        if(!is_blocking() && poll(event)){
+            return;
+        }
+
+        cl_int ret = clWaitForEvents(1, &event);
+        if(ret != CL_SUCCESS){
+            BOOST_THROW_EXCEPTION(opencl_error(ret));
+        }
+    }
+
+private:
+    // polls the status of event and returns true if it completed before
+    // the end of the spin and yield times
+    bool poll(cl_event event) const
+    {
+        // the commands must be submitted to the device for their status to
+        // change (clWaitForEvents() flushes the queue itself)
+        cl_command_queue queue = 0;
+        cl_int ret = clGetEventInfo(
+            event, CL_EVENT_COMMAND_QUEUE, sizeof(queue), &queue, 0
+        );
+        if(ret != CL_SUCCESS){
+            BOOST_THROW_EXCEPTION(opencl_error(ret));
+        }
+        if(queue){
+            clFlush(queue);
+        }
+
+        detail::wait_timer timer;
+        for(;;){
+            cl_int status = CL_QUEUED;
+            ret = clGetEventInfo(
+                event, CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(status), &status, 0
+            );
+            if(ret != CL_SUCCESS){
+                BOOST_THROW_EXCEPTION(opencl_error(ret));
+            }
+
+            if(status == CL_COMPLETE){
+                return true;
+            }
+            else if(status < 0){
+                // the command failed, status is its error code
+                BOOST_THROW_EXCEPTION(opencl_error(status));
+            }
+
+            const ulong_ elapsed = timer.elapsed();
+            if(elapsed >= m_spin_time + m_yield_time){
+                return false;
+            }
+            else if(elapsed >= m_spin_time){
+                detail::wait_timer::yield();
+            }
+        }
+    }
+
+    static wait_strategy& default_strategy()
+    {
+        static wait_strategy strategy(
+            detail::wait_time_from_environment("BOOST_COMPUTE_WAIT_SPIN_TIME"),
+            detail::wait_time_from_environment("BOOST_COMPUTE_WAIT_YIELD_TIME")
+        );
+
+        return strategy;
+    }
+
+private:
+    ulong_ m_spin_time;
+    ulong_ m_yield_time;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_WAIT_STRATEGY_HPP
@@ -14,6 +14,8 @@
 // this header contains general purpose functions and variables used by
 // the boost.compute performance benchmarks.
 
+#include <cmath>
+#include <string>
 #include <vector>
 #include <cstdlib>
 #include <algorithm>
@@ -23,16 +25,38 @@
 
 static size_t PERF_N = 1024;
 static size_t PERF_TRIALS = 1;
+static size_t PERF_WARMUP = 1;
+static bool PERF_JSON = false;
+static std::string PERF_TYPE;
 
-// parses command line arguments and sets the corresponding perf variables
+// parses command line arguments and sets the corresponding perf variables.
+//
+// usage: perf_foo [size] [--trials N] [--warmup N] [--type T] [--json]
+//
+// the value type is only used by benchmarks which support several types.
 inline void perf_parse_args(int argc, char *argv[])
 {
-    if(argc >= 2){
-        PERF_N = boost::lexical_cast<size_t>(argv[1]);
-    }
-
-    // TODO: make this configurable from the command line
     PERF_TRIALS = 3;
+
+    for(int i = 1; i < argc; i++){
+        const std::string arg = argv[i];
+
+        if(arg == "--trials" && i + 1 < argc){
+            PERF_TRIALS = (std::max)(boost::lexical_cast<size_t>(argv[++i]), size_t(1));
+        }
+        else if(arg == "--warmup" && i + 1 < argc){
+            PERF_WARMUP = boost::lexical_cast<size_t>(argv[++i]);
+        }
+        else if(arg == "--type" && i + 1 < argc){
+            PERF_TYPE = argv[++i];
+        }
+        else if(arg == "--json"){
+            PERF_JSON = true;
+        }
+        else {
+            PERF_N = boost::lexical_cast<size_t>(arg);
+        }
+    }
 }
 
 // generates a vector of random numbers
@@ -95,4 +119,75 @@ public:
     std::vector<boost::timer::nanosecond_type> times;
 };
 
+// summary statistics of a set of time samples (in nanoseconds)
+struct perf_statistics
+{
+    perf_statistics()
+        : count(0), min(0), max(0), mean(0), stddev(0), median(0), p95(0), p99(0)
+    {
+    }
+
+    size_t count;
+    double min;
+    double max;
+    double mean;
+    double stddev;
+    double median;
+    double p95;
+    double p99;
+};
+
+// returns the value at percentile p (0 to 100) of the sorted samples using
+// linear interpolation between the closest ranks
+inline double perf_percentile(const std::vector<double> &sorted, double p)
+{
+    if(sorted.empty()){
+        return 0;
+    }
+
+    const double rank = p / 100.0 * (sorted.size() - 1);
+    const size_t lower = static_cast<size_t>(std::floor(rank));
+    const size_t upper = (std::min)(lower + 1, sorted.size() - 1);
+    const double fraction = rank - lower;
+
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * fraction;
+}
+
+template<class T>
+inline perf_statistics perf_compute_statistics(const std::vector<T> &samples)
+{
+    perf_statistics stats;
+    if(samples.empty()){
+        return stats;
+    }
+
+    std::vector<double> sorted(samples.begin(), samples.end());
+    std::sort(sorted.begin(), sorted.end());
+
+    double sum = 0;
+    for(size_t i = 0; i < sorted.size(); i++){
+        sum += sorted[i];
+    }
+
+    stats.count = sorted.size();
+    stats.min = sorted.front();
+    stats.max = sorted.back();
+    stats.mean = sum / sorted.size();
+
+    double variance = 0;
+    for(size_t i = 0; i < sorted.size(); i++){
+        variance += (sorted[i] - stats.mean) * (sorted[i] - stats.mean);
+    }
+    if(sorted.size() > 1){
+        variance /= (sorted.size() - 1);
+    }
+    stats.stddev = std::sqrt(variance);
+
+    stats.median = perf_percentile(sorted, 50);
+    stats.p95 = perf_percentile(sorted, 95);
+    stats.p99 = perf_percentile(sorted, 99);
+
+    return stats;
+}
+
 #endif // PERF_HPP
@@ -135,6 +135,7 @@ def run_benchmark(name, sizes, vs=[]):
         ],
         "stl": [
             "accumulate",
+            "adjacent_difference",
             "count",
             "find_end",
             "includes",
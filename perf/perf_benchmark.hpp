@@ -0,0 +1,213 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef PERF_BENCHMARK_HPP
+#define PERF_BENCHMARK_HPP
+
+// this header contains the perf_benchmark class which measures host and
+// device time of a boost.compute benchmark and reports the statistics of
+// the trials.
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <boost/compute/event.hpp>
+#include <boost/compute/command_queue.hpp>
+
+#include "perf.hpp"
+
+// measures the trials of a benchmark on a command queue.
+//
+// the first PERF_WARMUP trials are reported separately (they include the
+// compilation of the programs) and are excluded from the statistics of the
+// PERF_TRIALS steady-state trials. if the queue has profiling enabled the
+// time on the device between start() and stop() is measured with markers.
+//
+//   perf_benchmark benchmark("sort", PERF_N, PERF_N * sizeof(int), queue);
+//   for(size_t trial = 0; trial < benchmark.iterations(); trial++){
+//       // ... reset input ...
+//       benchmark.start();
+//       boost::compute::sort(vector.begin(), vector.end(), queue);
+//       benchmark.stop();
+//   }
+//   benchmark.report();
+class perf_benchmark
+{
+public:
+    perf_benchmark(const std::string &name,
+                   size_t elements,
+                   size_t bytes,
+                   boost::compute::command_queue &queue)
+        : m_name(name),
+          m_elements(elements),
+          m_bytes(bytes),
+          m_queue(queue),
+          m_profiling(
+              (queue.get_properties() &
+               boost::compute::command_queue::enable_profiling) != 0
+          )
+    {
+        m_timer.stop();
+    }
+
+    // sets the name of the value type reported in the results
+    void set_type(const std::string &type)
+    {
+        m_type = type;
+    }
+
+    // returns the total number of trials to run (warmup and steady-state)
+    size_t iterations() const
+    {
+        return PERF_WARMUP + PERF_TRIALS;
+    }
+
+    void start()
+    {
+        m_queue.finish();
+
+        if(m_profiling){
+            m_queue.enqueue_marker(&m_start_event);
+        }
+        m_timer.start();
+    }
+
+    void stop()
+    {
+        boost::compute::event stop_event;
+        if(m_profiling){
+            m_queue.enqueue_marker(&stop_event);
+        }
+        m_queue.finish();
+        m_timer.stop();
+
+        const double host_time = static_cast<double>(m_timer.elapsed().wall);
+        if(m_warmup_times.size() < PERF_WARMUP){
+            m_warmup_times.push_back(host_time);
+            return;
+        }
+        m_host_times.push_back(host_time);
+
+        if(m_profiling){
+            const cl_ulong begin =
+                m_start_event.get_profiling_info<cl_ulong>(CL_PROFILING_COMMAND_END);
+            const cl_ulong end =
+                stop_event.get_profiling_info<cl_ulong>(CL_PROFILING_COMMAND_START);
+
+            // some platforms do not time markers
+            if(begin != 0 && end >= begin){
+                m_device_times.push_back(static_cast<double>(end - begin));
+            }
+        }
+    }
+
+    perf_statistics host_statistics() const
+    {
+        return perf_compute_statistics(m_host_times);
+    }
+
+    perf_statistics device_statistics() const
+    {
+        return perf_compute_statistics(m_device_times);
+    }
+
+    // writes the results to stdout. the "time:" line (median host time in
+    // ms) is read by perf.py. with --json a json object is written too.
+    void report() const
+    {
+        const perf_statistics host = host_statistics();
+        const perf_statistics device = device_statistics();
+
+        for(size_t i = 0; i < m_warmup_times.size(); i++){
+            std::cout << "warmup: " << m_warmup_times[i] / 1e6 << " ms" << std::endl;
+        }
+        std::cout << "host: median " << host.median / 1e6
+                  << " ms, p95 " << host.p95 / 1e6
+                  << " ms, p99 " << host.p99 / 1e6
+                  << " ms, min " << host.min / 1e6
+                  << " ms (" << host.count << " trials)" << std::endl;
+        if(device.count){
+            std::cout << "device: median " << device.median / 1e6
+                      << " ms, p95 " << device.p95 / 1e6
+                      << " ms, p99 " << device.p99 / 1e6
+                      << " ms, min " << device.min / 1e6 << " ms" << std::endl;
+        }
+        if(host.median > 0){
+            const double time = device.count ? device.median : host.median;
+            std::cout << "throughput: " << m_bytes / time << " GB/s, "
+                      << m_elements / time * 1e3 << " Melements/s" << std::endl;
+        }
+        std::cout << "time: " << host.median / 1e6 << " ms" << std::endl;
+
+        if(PERF_JSON){
+            write_json(std::cout, host, device);
+        }
+    }
+
+private:
+    void write_json(std::ostream &stream,
+                    const perf_statistics &host,
+                    const perf_statistics &device) const
+    {
+        const double time = device.count ? device.median : host.median;
+
+        stream << "json: {\"name\":\"" << m_name << "\""
+               << ",\"type\":\"" << m_type << "\""
+               << ",\"device\":\"" << m_queue.get_device().name() << "\""
+               << ",\"size\":" << m_elements
+               << ",\"bytes\":" << m_bytes
+               << ",\"warmup_ns\":[";
+        for(size_t i = 0; i < m_warmup_times.size(); i++){
+            stream << (i ? "," : "") << m_warmup_times[i];
+        }
+        stream << "],\"host_ns\":";
+        write_json_statistics(stream, host);
+        stream << ",\"device_ns\":";
+        if(device.count){
+            write_json_statistics(stream, device);
+        }
+        else {
+            stream << "null";
+        }
+        stream << ",\"gb_per_s\":" << (time > 0 ? m_bytes / time : 0)
+               << ",\"elements_per_s\":" << (time > 0 ? m_elements / time * 1e9 : 0)
+               << "}" << std::endl;
+    }
+
+    static void write_json_statistics(std::ostream &stream,
+                                      const perf_statistics &stats)
+    {
+        stream << "{\"count\":" << stats.count
+               << ",\"min\":" << stats.min
+               << ",\"median\":" << stats.median
+               << ",\"p95\":" << stats.p95
+               << ",\"p99\":" << stats.p99
+               << ",\"max\":" << stats.max
+               << ",\"mean\":" << stats.mean
+               << ",\"stddev\":" << stats.stddev
+               << "}";
+    }
+
+private:
+    std::string m_name;
+    std::string m_type;
+    size_t m_elements;
+    size_t m_bytes;
+    boost::compute::command_queue &m_queue;
+    bool m_profiling;
+    boost::timer::cpu_timer m_timer;
+    boost::compute::event m_start_event;
+    std::vector<double> m_warmup_times;
+    std::vector<double> m_host_times;
+    std::vector<double> m_device_times;
+};
+
+#endif // PERF_BENCHMARK_HPP
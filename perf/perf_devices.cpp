@@ -0,0 +1,34 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+// lists the devices on the system for perf_runner.py, one per line as
+// tab-separated platform name, device name and driver version.
+
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/platform.hpp>
+#include <boost/compute/system.hpp>
+
+int main()
+{
+    std::vector<boost::compute::device> devices = boost::compute::system::devices();
+
+    for(size_t i = 0; i < devices.size(); i++){
+        const boost::compute::device &device = devices[i];
+
+        std::cout << device.platform().name() << "\t"
+                  << device.name() << "\t"
+                  << device.driver_version() << std::endl;
+    }
+
+    return 0;
+}
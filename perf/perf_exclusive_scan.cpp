@@ -6,6 +6,8 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/algorithm/exclusive_scan.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
 
 #include "perf.hpp"
 
@@ -40,27 +42,49 @@ int main(int argc, char *argv[])
         queue
     );
 
-    // sum vector
-    perf_timer t;
-    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
-        boost::compute::copy(
-            host_vector.begin(),
-            host_vector.end(),
-            device_vector.begin(),
-            queue
-        );
-
-        t.start();
-        boost::compute::exclusive_scan(
-            device_vector.begin(),
-            device_vector.end(),
-            device_res.begin(),
-            queue
-        );
-        queue.finish();
-        t.stop();
+    // the multi-pass scan is used when the single-pass threshold is zero
+    boost::shared_ptr<boost::compute::detail::parameter_cache> parameters =
+        boost::compute::detail::parameter_cache::get_global_cache(device);
+    const std::string object =
+        std::string("__boost_scan_") + boost::compute::type_name<int>();
+
+    const bool single_pass_supported =
+        (device.type() & boost::compute::device::gpu) && device.check_version(2, 0);
+
+    perf_timer::nanosecond_type times[2] = { 0, 0 };
+    for(int single_pass = 0; single_pass < (single_pass_supported ? 2 : 1); single_pass++){
+        parameters->set(object, "single_pass_threshold", single_pass);
+
+        // sum vector
+        perf_timer t;
+        for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+            boost::compute::copy(
+                host_vector.begin(),
+                host_vector.end(),
+                device_vector.begin(),
+                queue
+            );
+
+            t.start();
+            boost::compute::exclusive_scan(
+                device_vector.begin(),
+                device_vector.end(),
+                device_res.begin(),
+                queue
+            );
+            queue.finish();
+            t.stop();
+        }
+        times[single_pass] = t.min_time();
+        std::cout << (single_pass ? "single-pass" : "multi-pass")
+                  << " time: " << t.min_time() / 1e6 << " ms" << std::endl;
     }
-    std::cout << "time: " << t.min_time() / 1e6 << " ms" << std::endl;
+
+    // report the time of the path chosen by default
+    parameters->reset(object);
+    const bool single_pass =
+        boost::compute::detail::use_single_pass_scan<int>(PERF_N, queue);
+    std::cout << "time: " << times[single_pass ? 1 : 0] / 1e6 << " ms" << std::endl;
 
     // verify sum is correct
     std::partial_sum(
@@ -0,0 +1,90 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/image/image2d.hpp>
+#include <boost/compute/utility/dim.hpp>
+
+#include "perf_benchmark.hpp"
+
+// writes, copies and reads back a square RGBA8 image with about PERF_N
+// pixels
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+
+    // setup context and queue for the default device
+    boost::compute::device device = boost::compute::system::default_device();
+    boost::compute::context context(device);
+    boost::compute::command_queue queue(
+        context, device, boost::compute::command_queue::enable_profiling
+    );
+
+    boost::compute::image_format format(CL_RGBA, CL_UNSIGNED_INT8);
+    if(!device.get_info<bool>(CL_DEVICE_IMAGE_SUPPORT) ||
+       !boost::compute::image2d::is_supported_format(format, context)){
+        std::cout << "ERROR: images not supported by device" << std::endl;
+        return -1;
+    }
+
+    const size_t max_width = device.get_info<size_t>(CL_DEVICE_IMAGE2D_MAX_WIDTH);
+    const size_t width =
+        (std::min)(static_cast<size_t>(std::sqrt(double(PERF_N))) + 1, max_width);
+    const size_t pixels = width * width;
+
+    std::cout << "size: " << pixels << std::endl;
+    std::cout << "device: " << device.name() << std::endl;
+
+    std::vector<boost::compute::uint_> host_pixels(pixels);
+    std::generate(host_pixels.begin(), host_pixels.end(), rand);
+    std::vector<boost::compute::uint_> host_result(pixels);
+
+    boost::compute::image2d source(context, width, width, format);
+    boost::compute::image2d target(context, width, width, format);
+
+    const boost::compute::extents<2> origin = boost::compute::dim(0, 0);
+    const boost::compute::extents<2> region = boost::compute::dim(width, width);
+
+    perf_benchmark write("image_write", pixels, pixels * 4, queue);
+    for(size_t trial = 0; trial < write.iterations(); trial++){
+        write.start();
+        queue.enqueue_write_image(source, origin, region, &host_pixels[0]);
+        write.stop();
+    }
+    write.report();
+
+    perf_benchmark copy("image_copy", pixels, 2 * pixels * 4, queue);
+    for(size_t trial = 0; trial < copy.iterations(); trial++){
+        copy.start();
+        queue.enqueue_copy_image(source, target, origin, origin, region);
+        copy.stop();
+    }
+    copy.report();
+
+    perf_benchmark read("image_read", pixels, pixels * 4, queue);
+    for(size_t trial = 0; trial < read.iterations(); trial++){
+        read.start();
+        queue.enqueue_read_image(target, origin, region, &host_result[0]);
+        read.stop();
+    }
+    read.report();
+
+    if(host_result != host_pixels){
+        std::cout << "ERROR: image contents differ" << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/math.hpp>
+
+#include "perf_benchmark.hpp"
+
+// measures the per-call host overhead of algorithms on tiny inputs, where
+// the time is dominated by argument setup, program cache lookups, kernel
+// launches and synchronization rather than by the device. each trial
+// times PERF_N calls on 16 values, the host time per call is the time
+// reported divided by PERF_N.
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+
+    std::cout << "size: " << PERF_N << std::endl;
+
+    // setup context and queue for the default device
+    boost::compute::device device = boost::compute::system::default_device();
+    boost::compute::context context(device);
+    boost::compute::command_queue queue(
+        context, device, boost::compute::command_queue::enable_profiling
+    );
+    std::cout << "device: " << device.name() << std::endl;
+
+    const size_t count = 16;
+    std::vector<int> host_vector(count, 1);
+    boost::compute::vector<int> device_vector(count, context);
+    boost::compute::vector<int> device_result(count, context);
+
+    perf_benchmark copy("launch_overhead_copy", PERF_N, 0, queue);
+    for(size_t trial = 0; trial < copy.iterations(); trial++){
+        copy.start();
+        for(size_t i = 0; i < PERF_N; i++){
+            boost::compute::copy(
+                host_vector.begin(), host_vector.end(), device_vector.begin(), queue
+            );
+        }
+        copy.stop();
+    }
+    copy.report();
+
+    perf_benchmark fill("launch_overhead_fill", PERF_N, 0, queue);
+    for(size_t trial = 0; trial < fill.iterations(); trial++){
+        fill.start();
+        for(size_t i = 0; i < PERF_N; i++){
+            boost::compute::fill(device_vector.begin(), device_vector.end(), 2, queue);
+        }
+        fill.stop();
+    }
+    fill.report();
+
+    perf_benchmark transform("launch_overhead_transform", PERF_N, 0, queue);
+    for(size_t trial = 0; trial < transform.iterations(); trial++){
+        transform.start();
+        for(size_t i = 0; i < PERF_N; i++){
+            boost::compute::transform(
+                device_vector.begin(), device_vector.end(), device_result.begin(),
+                boost::compute::abs<int>(), queue
+            );
+        }
+        transform.stop();
+    }
+    transform.report();
+
+    perf_benchmark reduce("launch_overhead_reduce", PERF_N, 0, queue);
+    for(size_t trial = 0; trial < reduce.iterations(); trial++){
+        int sum = 0;
+        reduce.start();
+        for(size_t i = 0; i < PERF_N; i++){
+            boost::compute::reduce(
+                device_vector.begin(), device_vector.end(), &sum, queue
+            );
+        }
+        reduce.stop();
+    }
+    reduce.report();
+
+    perf_benchmark sort("launch_overhead_sort", PERF_N, 0, queue);
+    for(size_t trial = 0; trial < sort.iterations(); trial++){
+        sort.start();
+        for(size_t i = 0; i < PERF_N; i++){
+            boost::compute::sort(device_vector.begin(), device_vector.end(), queue);
+        }
+        sort.stop();
+    }
+    sort.report();
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/binary_search.hpp>
+#include <boost/compute/algorithm/lower_bound.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "perf_benchmark.hpp"
+
+// searches for PERF_N values in a sorted range of PERF_N values, with
+// one kernel launch for each batch of values (lower_bound() and
+// binary_search() with a value range)
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+
+    std::cout << "size: " << PERF_N << std::endl;
+
+    // setup context and queue for the default device
+    boost::compute::device device = boost::compute::system::default_device();
+    boost::compute::context context(device);
+    boost::compute::command_queue queue(
+        context, device, boost::compute::command_queue::enable_profiling
+    );
+    std::cout << "device: " << device.name() << std::endl;
+
+    std::vector<int> host_data(PERF_N);
+    std::generate(host_data.begin(), host_data.end(), rand);
+    std::sort(host_data.begin(), host_data.end());
+
+    std::vector<int> host_values(PERF_N);
+    std::generate(host_values.begin(), host_values.end(), rand);
+
+    boost::compute::vector<int> data(host_data.begin(), host_data.end(), queue);
+    boost::compute::vector<int> values(host_values.begin(), host_values.end(), queue);
+    boost::compute::vector<boost::compute::uint_> indices(PERF_N, context);
+    boost::compute::vector<boost::compute::uint_> found(PERF_N, context);
+
+    perf_benchmark lower_bound(
+        "lower_bound", PERF_N, PERF_N * (sizeof(int) + sizeof(boost::compute::uint_)), queue
+    );
+    for(size_t trial = 0; trial < lower_bound.iterations(); trial++){
+        lower_bound.start();
+        boost::compute::lower_bound(
+            data.begin(), data.end(), values.begin(), values.end(), indices.begin(), queue
+        );
+        lower_bound.stop();
+    }
+    lower_bound.report();
+
+    perf_benchmark binary_search(
+        "binary_search", PERF_N, PERF_N * (sizeof(int) + sizeof(boost::compute::uint_)), queue
+    );
+    for(size_t trial = 0; trial < binary_search.iterations(); trial++){
+        binary_search.start();
+        boost::compute::binary_search(
+            data.begin(), data.end(), values.begin(), values.end(), found.begin(), queue
+        );
+        binary_search.stop();
+    }
+    binary_search.report();
+
+    // verify the first index
+    boost::compute::uint_ index = 0;
+    boost::compute::copy_n(indices.begin(), 1, &index, queue);
+    const size_t expected =
+        std::lower_bound(host_data.begin(), host_data.end(), host_values[0]) -
+        host_data.begin();
+    if(index != expected){
+        std::cout << "ERROR: lower_bound() returned " << index
+                  << " instead of " << expected << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
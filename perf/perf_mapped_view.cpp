@@ -0,0 +1,60 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/mapped_view.hpp>
+#include <boost/compute/functional/math.hpp>
+
+#include "perf_benchmark.hpp"
+
+// transforms host memory in place through a mapped_view, including the
+// cost of mapping the results back to the host
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+
+    std::cout << "size: " << PERF_N << std::endl;
+
+    // setup context and queue for the default device
+    boost::compute::device device = boost::compute::system::default_device();
+    boost::compute::context context(device);
+    boost::compute::command_queue queue(
+        context, device, boost::compute::command_queue::enable_profiling
+    );
+    std::cout << "device: " << device.name() << std::endl;
+
+    std::vector<float> host_vector(PERF_N);
+    for(size_t i = 0; i < PERF_N; i++){
+        host_vector[i] = static_cast<float>(i);
+    }
+
+    boost::compute::mapped_view<float> view(&host_vector[0], PERF_N, context);
+
+    perf_benchmark benchmark(
+        "mapped_view", PERF_N, 2 * PERF_N * sizeof(float), queue
+    );
+    for(size_t trial = 0; trial < benchmark.iterations(); trial++){
+        benchmark.start();
+        boost::compute::transform(
+            view.begin(), view.end(), view.begin(), boost::compute::sqrt<float>(), queue
+        );
+        view.map(CL_MAP_READ, queue);
+        view.unmap(queue);
+        benchmark.stop();
+    }
+    benchmark.report();
+
+    return 0;
+}
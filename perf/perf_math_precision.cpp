@@ -0,0 +1,126 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/math_precision.hpp>
+
+#include "perf.hpp"
+
+namespace compute = boost::compute;
+
+float rand_float()
+{
+    return (float(rand()) / float(RAND_MAX)) + 0.001f;
+}
+
+float host_function(float x)
+{
+    return std::sin(x) * std::exp(x) + std::log(x) + std::sqrt(x);
+}
+
+// times the transform of the values with the built-in math functions at
+// the given precision and returns the largest absolute error
+float perf_precision(compute::math_precision precision,
+                     const char *name,
+                     const std::vector<float> &host_vector,
+                     const std::vector<float> &expected,
+                     compute::vector<float> &input,
+                     compute::vector<float> &output,
+                     compute::command_queue &queue)
+{
+    using compute::lambda::_1;
+
+    compute::scoped_math_precision scoped_precision(precision);
+
+    perf_timer t;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        compute::transform(
+            input.begin(),
+            input.end(),
+            output.begin(),
+            compute::lambda::sin(_1) * compute::lambda::exp(_1) +
+                compute::lambda::log(_1) + compute::lambda::sqrt(_1),
+            queue
+        );
+        queue.finish();
+        t.stop();
+    }
+
+    std::vector<float> result(host_vector.size());
+    compute::copy(output.begin(), output.end(), result.begin(), queue);
+
+    float error = 0;
+    for(size_t i = 0; i < result.size(); i++){
+        error = (std::max)(error, std::abs(result[i] - expected[i]));
+    }
+
+    std::cout << name << " time: " << t.min_time() / 1e6 << " ms"
+              << " (max error: " << error << ")" << std::endl;
+
+    return error;
+}
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+
+    std::cout << "size: " << PERF_N << std::endl;
+
+    // setup context and queue for the default device
+    compute::device device = compute::system::default_device();
+    compute::context context(device);
+    compute::command_queue queue(context, device);
+    std::cout << "device: " << device.name() << std::endl;
+
+    // create vector of random numbers on the host
+    std::vector<float> host_vector(PERF_N);
+    std::generate(host_vector.begin(), host_vector.end(), rand_float);
+
+    std::vector<float> expected(PERF_N);
+    std::transform(
+        host_vector.begin(), host_vector.end(), expected.begin(), host_function
+    );
+
+    // create vectors on the device and copy the data
+    compute::vector<float> input(host_vector.begin(), host_vector.end(), queue);
+    compute::vector<float> output(PERF_N, context);
+
+    const float full_error = perf_precision(
+        compute::math_precision_full, "full",
+        host_vector, expected, input, output, queue
+    );
+    perf_precision(
+        compute::math_precision_native, "native",
+        host_vector, expected, input, output, queue
+    );
+    perf_precision(
+        compute::math_precision_half, "half",
+        host_vector, expected, input, output, queue
+    );
+
+    if(full_error > 1e-3f){
+        std::cout << "ERROR: full precision error (" << full_error << ") "
+                  << "is greater than 1e-3" << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <iostream>
+#include <string>
+
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/utility/program_cache.hpp>
+
+#include "perf_benchmark.hpp"
+
+// measures the host cost of looking up a cached program and of compiling
+// a meta_kernel whose program is already cached (which every algorithm
+// call pays). PERF_N lookups are timed per trial.
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+
+    std::cout << "size: " << PERF_N << std::endl;
+
+    // setup context and queue for the default device
+    boost::compute::device device = boost::compute::system::default_device();
+    boost::compute::context context(device);
+    boost::compute::command_queue queue(context, device);
+    std::cout << "device: " << device.name() << std::endl;
+
+    boost::shared_ptr<boost::compute::program_cache> cache =
+        boost::compute::program_cache::get_global_cache(context);
+
+    const std::string source =
+        "__kernel void perf_program_cache(__global int *x) { x[0] = 1; }";
+
+    // build the program once so that every lookup is a hit
+    cache->get_or_build("perf_program_cache", std::string(), source, context);
+
+    perf_benchmark lookup("program_cache_lookup", PERF_N, 0, queue);
+    for(size_t trial = 0; trial < lookup.iterations(); trial++){
+        lookup.start();
+        for(size_t i = 0; i < PERF_N; i++){
+            cache->get_or_build("perf_program_cache", std::string(), source, context);
+        }
+        lookup.stop();
+    }
+    lookup.report();
+
+    perf_benchmark compile("meta_kernel_compile", PERF_N, 0, queue);
+    for(size_t trial = 0; trial < compile.iterations(); trial++){
+        compile.start();
+        for(size_t i = 0; i < PERF_N; i++){
+            boost::compute::detail::meta_kernel k("perf_meta_kernel_compile");
+            k.add_arg<int *>(boost::compute::memory_object::global_memory, "x");
+            k << "x[get_global_id(0)] = 1;\n";
+            k.compile(context);
+        }
+        compile.stop();
+    }
+    compile.report();
+
+    return 0;
+}
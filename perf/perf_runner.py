@@ -0,0 +1,209 @@
+#!/usr/bin/python
+
+# sweep runner for boost.compute benchmarks. runs benchmarks for a range of
+# sizes and value types on every device of the system, stores the results
+# as a baseline and compares them against a previous baseline.
+#
+# examples:
+#
+#   # record a baseline for the current driver
+#   perf_runner.py --benchmarks sort,accumulate --save baseline.json
+#
+#   # after a driver or library upgrade, flag anything 10% slower
+#   perf_runner.py --benchmarks sort,accumulate --compare baseline.json
+#
+# the benchmarks are run from ./perf (see --path). benchmarks using
+# perf_benchmark.hpp report their statistics with --json, the others are
+# run once per size and report their "time:" line. the exit status is 1 if
+# any regressions were found.
+
+import os
+import sys
+import json
+import argparse
+import subprocess
+
+def list_devices(path):
+    filename = os.path.join(path, "perf_devices")
+    if not os.path.isfile(filename):
+        print("Error: failed to find %s, running on the default device" % filename)
+        return [None]
+
+    output = subprocess.check_output([filename]).decode('utf8')
+
+    devices = []
+    for line in output.splitlines():
+        fields = line.split("\t")
+        if len(fields) >= 3:
+            devices.append({
+                "platform" : fields[0],
+                "name" : fields[1],
+                "driver" : fields[2]
+            })
+
+    return devices
+
+# runs a benchmark binary and returns a list with the result of each
+# measurement it reported
+def run_benchmark(path, name, size, value_type, device, trials):
+    filename = os.path.join(path, "perf_%s" % name)
+    if not os.path.isfile(filename):
+        print("Error: failed to find %s for running" % filename)
+        return []
+
+    args = [filename, str(int(size)), "--trials", str(trials), "--json"]
+    if value_type:
+        args += ["--type", value_type]
+
+    # select the device with the default device environment variables
+    env = dict(os.environ)
+    if device:
+        env["BOOST_COMPUTE_DEFAULT_PLATFORM"] = device["platform"]
+        env["BOOST_COMPUTE_DEFAULT_DEVICE"] = device["name"]
+
+    try:
+        output = subprocess.check_output(args, env=env).decode('utf8')
+    except (subprocess.CalledProcessError, OSError):
+        return []
+
+    results = []
+    time = None
+    for line in output.split("\n"):
+        if line.startswith("json:"):
+            results.append(json.loads(line[len("json:"):]))
+        elif line.startswith("time:"):
+            time = float(line.split(":")[1].split()[0])
+
+    if not results and time is not None:
+        # benchmark without perf_benchmark, only the time is known
+        results.append({ "name" : name, "type" : "", "size" : size,
+                         "host_ns" : { "median" : time * 1e6 }, "device_ns" : None })
+
+    return results
+
+def result_time(result):
+    # prefer the device time if the benchmark measured it
+    if result.get("device_ns"):
+        return result["device_ns"]["median"]
+    return result["host_ns"]["median"]
+
+def result_key(device, result):
+    device_name = device["name"] if device else "default"
+    return "%s|%s|%s|%d" % (device_name, result["name"], result["type"], result["size"])
+
+def parse_sizes(args):
+    if args.sizes:
+        return [int(s) for s in args.sizes.split(",")]
+
+    return [pow(2, x) for x in range(args.min_exp, args.max_exp + 1, args.step)]
+
+def main():
+    parser = argparse.ArgumentParser(description="boost.compute benchmark runner")
+    parser.add_argument("--benchmarks", default="sort",
+                        help="comma-separated list of benchmarks")
+    parser.add_argument("--types", default="",
+                        help="comma-separated list of value types (e.g. int,float)")
+    parser.add_argument("--sizes", default="",
+                        help="comma-separated list of sizes")
+    parser.add_argument("--min-exp", type=int, default=10,
+                        help="smallest size as a power of two")
+    parser.add_argument("--max-exp", type=int, default=24,
+                        help="largest size as a power of two")
+    parser.add_argument("--step", type=int, default=2,
+                        help="step between the size exponents")
+    parser.add_argument("--trials", type=int, default=10,
+                        help="steady-state trials per run")
+    parser.add_argument("--devices", default="",
+                        help="comma-separated device name substrings to run on (default: all)")
+    parser.add_argument("--path", default="./perf",
+                        help="directory containing the benchmark binaries")
+    parser.add_argument("--save", help="file to store the results in")
+    parser.add_argument("--compare", help="baseline file to compare against")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative slowdown reported as a regression")
+    args = parser.parse_args()
+
+    benchmarks = [b for b in args.benchmarks.split(",") if b]
+    types = [t for t in args.types.split(",") if t] or [""]
+    sizes = parse_sizes(args)
+
+    devices = list_devices(args.path)
+    if args.devices:
+        wanted = args.devices.split(",")
+        devices = [d for d in devices
+                   if d is None or any(w in d["name"] for w in wanted)]
+
+    results = {}
+    for device in devices:
+        if device:
+            print("=== %s (%s, driver %s) ===" %
+                  (device["name"], device["platform"], device["driver"]))
+
+        for name in benchmarks:
+            for value_type in types:
+                typed = False
+                for size in sizes:
+                    measurements = run_benchmark(
+                        args.path, name, size, value_type, device, args.trials
+                    )
+                    if not measurements:
+                        print("%s %s %d: failed" % (name, value_type, size))
+                        continue
+
+                    for result in measurements:
+                        typed = typed or bool(result["type"])
+                        result["device_info"] = device
+                        results[result_key(device, result)] = result
+                        print("%s %s %d: %.3f ms" %
+                              (result["name"], result["type"], result["size"],
+                               result_time(result) / 1e6))
+
+                # benchmarks without value types ignore --type, so they only
+                # need to run once
+                if not typed:
+                    break
+
+    if args.save:
+        with open(args.save, "w") as f:
+            json.dump(results, f, indent=1, sort_keys=True)
+        print("saved %d results to %s" % (len(results), args.save))
+
+    regressions = 0
+    if args.compare:
+        with open(args.compare) as f:
+            baseline = json.load(f)
+
+        print("=== comparison with %s (threshold %d%%) ===" %
+              (args.compare, args.threshold * 100))
+
+        for key in sorted(results.keys()):
+            if key not in baseline:
+                continue
+
+            old = result_time(baseline[key])
+            new = result_time(results[key])
+            if old <= 0:
+                continue
+
+            change = (new - old) / old
+            status = ""
+            if change > args.threshold:
+                status = "REGRESSION"
+                regressions += 1
+            elif change < -args.threshold:
+                status = "improvement"
+
+            print("%-60s %10.3f ms -> %10.3f ms (%+6.1f%%) %s" %
+                  (key, old / 1e6, new / 1e6, change * 100, status))
+
+            old_driver = (baseline[key].get("device_info") or {}).get("driver")
+            new_driver = (results[key].get("device_info") or {}).get("driver")
+            if status and old_driver != new_driver:
+                print("    driver changed: %s -> %s" % (old_driver, new_driver))
+
+        print("%d regressions" % regressions)
+
+    return 1 if regressions else 0
+
+if __name__ == '__main__':
+    sys.exit(main())
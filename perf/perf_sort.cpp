@@ -17,29 +17,25 @@
 #include <boost/compute/algorithm/is_sorted.hpp>
 #include <boost/compute/container/vector.hpp>
 
-#include "perf.hpp"
+#include "perf_benchmark.hpp"
 
-int main(int argc, char *argv[])
+template<class T>
+int perf_sort(const char *type, boost::compute::command_queue &queue)
 {
-    perf_parse_args(argc, argv);
-
-    std::cout << "size: " << PERF_N << std::endl;
-
-    // setup context and queue for the default device
-    boost::compute::device device = boost::compute::system::default_device();
-    boost::compute::context context(device);
-    boost::compute::command_queue queue(context, device);
-    std::cout << "device: " << device.name() << std::endl;
+    const boost::compute::context &context = queue.get_context();
 
     // create vector of random numbers on the host
-    std::vector<unsigned int> host_vector(PERF_N);
-    std::generate(host_vector.begin(), host_vector.end(), rand);
+    std::vector<T> host_vector(PERF_N);
+    for(size_t i = 0; i < host_vector.size(); i++){
+        host_vector[i] = static_cast<T>(rand());
+    }
 
     // create vector on the device and copy the data
-    boost::compute::vector<unsigned int> device_vector(PERF_N, context);
+    boost::compute::vector<T> device_vector(PERF_N, context);
 
-    perf_timer t;
-    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+    perf_benchmark benchmark("sort", PERF_N, PERF_N * sizeof(T), queue);
+    benchmark.set_type(type);
+    for(size_t trial = 0; trial < benchmark.iterations(); trial++){
         boost::compute::copy(
             host_vector.begin(),
             host_vector.end(),
@@ -47,17 +43,16 @@ int main(int argc, char *argv[])
             queue
         );
 
-        t.start();
+        benchmark.start();
         // sort vector
         boost::compute::sort(
             device_vector.begin(),
             device_vector.end(),
             queue
         );
-        queue.finish();
-        t.stop();
+        benchmark.stop();
     }
-    std::cout << "time: " << t.min_time() / 1e6 << " ms" << std::endl;
+    benchmark.report();
 
     // verify vector is sorted
     if(!boost::compute::is_sorted(device_vector.begin(),
@@ -69,3 +64,37 @@ int main(int argc, char *argv[])
 
     return 0;
 }
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+
+    std::cout << "size: " << PERF_N << std::endl;
+
+    // setup context and queue for the default device
+    boost::compute::device device = boost::compute::system::default_device();
+    boost::compute::context context(device);
+    boost::compute::command_queue queue(
+        context, device, boost::compute::command_queue::enable_profiling
+    );
+    std::cout << "device: " << device.name() << std::endl;
+
+    if(PERF_TYPE.empty() || PERF_TYPE == "uint"){
+        return perf_sort<boost::compute::uint_>("uint", queue);
+    }
+    else if(PERF_TYPE == "int"){
+        return perf_sort<boost::compute::int_>("int", queue);
+    }
+    else if(PERF_TYPE == "ulong"){
+        return perf_sort<boost::compute::ulong_>("ulong", queue);
+    }
+    else if(PERF_TYPE == "float"){
+        return perf_sort<boost::compute::float_>("float", queue);
+    }
+    else if(PERF_TYPE == "double" && device.supports_extension("cl_khr_fp64")){
+        return perf_sort<boost::compute::double_>("double", queue);
+    }
+
+    std::cout << "ERROR: unsupported type: " << PERF_TYPE << std::endl;
+    return -1;
+}
@@ -0,0 +1,86 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/types/struct.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/is_sorted.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "perf_benchmark.hpp"
+
+// a 16 byte value type, sort_by_key() has to move the whole struct for
+// each key
+struct particle
+{
+    float x;
+    float y;
+    float z;
+    int id;
+};
+
+BOOST_COMPUTE_ADAPT_STRUCT(particle, particle, (x, y, z, id))
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+
+    std::cout << "size: " << PERF_N << std::endl;
+
+    // setup context and queue for the default device
+    boost::compute::device device = boost::compute::system::default_device();
+    boost::compute::context context(device);
+    boost::compute::command_queue queue(
+        context, device, boost::compute::command_queue::enable_profiling
+    );
+    std::cout << "device: " << device.name() << std::endl;
+
+    // create vectors of random keys and values on the host
+    std::vector<boost::compute::uint_> host_keys(PERF_N);
+    std::vector<particle> host_values(PERF_N);
+    for(size_t i = 0; i < PERF_N; i++){
+        host_keys[i] = static_cast<boost::compute::uint_>(rand());
+
+        particle p = { float(i), float(i) * 2, float(i) * 3, int(i) };
+        host_values[i] = p;
+    }
+
+    boost::compute::vector<boost::compute::uint_> keys(PERF_N, context);
+    boost::compute::vector<particle> values(PERF_N, context);
+
+    perf_benchmark benchmark(
+        "sort_by_key_struct",
+        PERF_N,
+        PERF_N * (sizeof(boost::compute::uint_) + sizeof(particle)),
+        queue
+    );
+    for(size_t trial = 0; trial < benchmark.iterations(); trial++){
+        boost::compute::copy(host_keys.begin(), host_keys.end(), keys.begin(), queue);
+        boost::compute::copy(host_values.begin(), host_values.end(), values.begin(), queue);
+
+        benchmark.start();
+        boost::compute::sort_by_key(keys.begin(), keys.end(), values.begin(), queue);
+        benchmark.stop();
+    }
+    benchmark.report();
+
+    // verify keys are sorted
+    if(!boost::compute::is_sorted(keys.begin(), keys.end(), queue)){
+        std::cout << "ERROR: is_sorted() returned false" << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/is_sorted.hpp>
+#include <boost/compute/algorithm/stable_sort.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "perf_benchmark.hpp"
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+
+    std::cout << "size: " << PERF_N << std::endl;
+
+    // setup context and queue for the default device
+    boost::compute::device device = boost::compute::system::default_device();
+    boost::compute::context context(device);
+    boost::compute::command_queue queue(
+        context, device, boost::compute::command_queue::enable_profiling
+    );
+    std::cout << "device: " << device.name() << std::endl;
+
+    // a custom comparator can not use radix sort, this compares by the
+    // lowest byte only so that the stability is observable
+    BOOST_COMPUTE_FUNCTION(bool, compare_low_byte, (int a, int b),
+    {
+        return (a & 0xff) < (b & 0xff);
+    });
+
+    std::vector<int> host_vector(PERF_N);
+    std::generate(host_vector.begin(), host_vector.end(), rand);
+
+    boost::compute::vector<int> device_vector(PERF_N, context);
+
+    perf_benchmark benchmark(
+        "stable_sort_comparator", PERF_N, PERF_N * sizeof(int), queue
+    );
+    for(size_t trial = 0; trial < benchmark.iterations(); trial++){
+        boost::compute::copy(
+            host_vector.begin(), host_vector.end(), device_vector.begin(), queue
+        );
+
+        benchmark.start();
+        boost::compute::stable_sort(
+            device_vector.begin(), device_vector.end(), compare_low_byte, queue
+        );
+        benchmark.stop();
+    }
+    benchmark.report();
+
+    // verify vector is sorted
+    if(!boost::compute::is_sorted(device_vector.begin(),
+                                  device_vector.end(),
+                                  compare_low_byte,
+                                  queue)){
+        std::cout << "ERROR: is_sorted() returned false" << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,269 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/timer/timer.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/detail/mutex.hpp>
+
+#include "perf.hpp"
+
+#ifndef BOOST_COMPUTE_THREAD_SAFE
+#error perf_thread_scaling requires BOOST_COMPUTE_THREAD_SAFE
+#endif
+
+namespace compute = boost::compute;
+
+// the queues used by the threads of a run
+enum queue_mode {
+    // all threads enqueue to the same queue
+    shared_queue,
+    // each thread enqueues to a queue of its own in the shared context
+    per_thread_queue,
+    // each thread uses system::default_queue() with one queue per thread
+    default_queue_per_thread
+};
+
+const char* queue_mode_name(queue_mode mode)
+{
+    switch(mode){
+    case shared_queue: return "shared";
+    case per_thread_queue: return "per_thread";
+    case default_queue_per_thread: return "default_per_thread";
+    }
+    return "";
+}
+
+// releases the threads of a run at the same time once all of them are
+// set up
+class start_gate
+{
+public:
+    start_gate()
+        : m_ready(0),
+          m_open(false)
+    {
+    }
+
+    // called by each thread when it is set up, returns once the gate opens
+    void arrive()
+    {
+        compute::detail::scoped_lock lock(m_mutex);
+        m_ready++;
+        m_changed.notify_all();
+        while(!m_open){
+            m_changed.wait(lock);
+        }
+    }
+
+    // waits for threads threads to arrive and opens the gate
+    void open(size_t threads)
+    {
+        compute::detail::scoped_lock lock(m_mutex);
+        while(m_ready < threads){
+            m_changed.wait(lock);
+        }
+        m_open = true;
+        m_changed.notify_all();
+    }
+
+private:
+    size_t m_ready;
+    bool m_open;
+    compute::detail::mutex m_mutex;
+    compute::detail::condition_variable m_changed;
+};
+
+// runs ops algorithm calls (a transform followed by a reduce, which reads
+// its result back to the host) on size values and records their latency
+struct worker
+{
+    worker(queue_mode mode_,
+           compute::command_queue *queue_,
+           size_t size_,
+           size_t ops_,
+           start_gate *gate_,
+           std::vector<double> *latencies_)
+        : mode(mode_),
+          queue(queue_),
+          size(size_),
+          ops(ops_),
+          gate(gate_),
+          latencies(latencies_)
+    {
+    }
+
+    void operator()()
+    {
+        const compute::context context = compute::system::default_context();
+
+        compute::command_queue own_queue;
+        if(mode == per_thread_queue){
+            own_queue = compute::command_queue(context, context.get_device());
+        }
+        else if(mode == default_queue_per_thread){
+            own_queue = compute::system::default_queue();
+        }
+        compute::command_queue &q = mode == shared_queue ? *queue : own_queue;
+
+        compute::vector<int> input(size, context);
+        compute::vector<int> output(size, context);
+        compute::fill(input.begin(), input.end(), 1, q);
+
+        // builds the programs (or looks them up) before the timed run
+        run(q, input, output);
+        q.finish();
+
+        gate->arrive();
+
+        boost::timer::cpu_timer timer;
+        latencies->reserve(ops);
+        for(size_t i = 0; i < ops; i++){
+            timer.start();
+            run(q, input, output);
+            timer.stop();
+            latencies->push_back(static_cast<double>(timer.elapsed().wall));
+        }
+    }
+
+    static void run(compute::command_queue &q,
+                    compute::vector<int> &input,
+                    compute::vector<int> &output)
+    {
+        using compute::lambda::_1;
+
+        compute::transform(
+            input.begin(), input.end(), output.begin(), _1 * 2 + 1, q
+        );
+
+        int sum = 0;
+        compute::reduce(output.begin(), output.end(), &sum, q);
+    }
+
+    queue_mode mode;
+    compute::command_queue *queue;
+    size_t size;
+    size_t ops;
+    start_gate *gate;
+    std::vector<double> *latencies;
+};
+
+// runs the workers of threads threads and reports their throughput and
+// latency percentiles
+void run_threads(size_t threads, queue_mode mode, size_t size, size_t ops)
+{
+    compute::command_queue &queue = compute::system::default_queue();
+
+    start_gate gate;
+    std::vector<std::vector<double> > latencies(threads);
+    std::vector<boost::shared_ptr<compute::detail::thread> > workers;
+    for(size_t i = 0; i < threads; i++){
+        workers.push_back(
+            boost::shared_ptr<compute::detail::thread>(
+                new compute::detail::thread(
+                    worker(mode, &queue, size, ops, &gate, &latencies[i])
+                )
+            )
+        );
+    }
+
+    // the setup of the threads (allocating their vectors and building the
+    // programs) is not timed
+    gate.open(threads);
+
+    boost::timer::cpu_timer timer;
+    for(size_t i = 0; i < threads; i++){
+        workers[i]->join();
+    }
+    timer.stop();
+
+    std::vector<double> all;
+    for(size_t i = 0; i < threads; i++){
+        all.insert(all.end(), latencies[i].begin(), latencies[i].end());
+    }
+    const perf_statistics stats = perf_compute_statistics(all);
+    const double seconds = timer.elapsed().wall / 1e9;
+    const double ops_per_second = seconds > 0 ? all.size() / seconds : 0;
+
+    std::cout << "threads: " << threads
+              << ", queue: " << queue_mode_name(mode)
+              << ", size: " << size
+              << ", ops/s: " << ops_per_second
+              << ", latency: median " << stats.median / 1e6
+              << " ms, p95 " << stats.p95 / 1e6
+              << " ms, p99 " << stats.p99 / 1e6
+              << " ms" << std::endl;
+
+    if(PERF_JSON){
+        std::cout << "json: {\"name\":\"thread_scaling\""
+                  << ",\"threads\":" << threads
+                  << ",\"queue\":\"" << queue_mode_name(mode) << "\""
+                  << ",\"size\":" << size
+                  << ",\"ops_per_s\":" << ops_per_second
+                  << ",\"latency_ns\":{\"median\":" << stats.median
+                  << ",\"p95\":" << stats.p95
+                  << ",\"p99\":" << stats.p99
+                  << ",\"max\":" << stats.max
+                  << "}}" << std::endl;
+    }
+}
+
+// measures how the throughput of small and medium algorithm calls scales
+// with the number of host threads sharing the default context, with one
+// shared queue or a queue per thread. size is the number of values of the
+// small calls (the medium calls use 256 times more), each thread runs
+// PERF_TRIALS * 100 small (or PERF_TRIALS * 10 medium) calls.
+//
+// usage: perf_thread_scaling [size] [--trials N] [--json]
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+
+    const compute::device device = compute::system::default_device();
+    std::cout << "device: " << device.name() << std::endl;
+
+    size_t max_threads = compute::detail::thread::hardware_concurrency();
+    if(max_threads == 0){
+        max_threads = 4;
+    }
+
+    const size_t sizes[] = { PERF_N, PERF_N * 256 };
+    const size_t ops[] = { PERF_TRIALS * 100, PERF_TRIALS * 10 };
+    const queue_mode modes[] = {
+        shared_queue, per_thread_queue, default_queue_per_thread
+    };
+
+    for(size_t s = 0; s < 2; s++){
+        for(size_t m = 0; m < 3; m++){
+            compute::system::set_default_queue_count(
+                modes[m] == default_queue_per_thread ? 0 : 1
+            );
+
+            for(size_t threads = 1; threads <= max_threads; threads *= 2){
+                run_threads(threads, modes[m], sizes[s], ops[s]);
+            }
+        }
+    }
+
+    compute::system::set_default_queue_count(1);
+
+    return 0;
+}
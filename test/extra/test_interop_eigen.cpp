@@ -103,4 +103,57 @@ BOOST_AUTO_TEST_CASE(multiply_matrix4)
     BOOST_CHECK((matrix * host_vectors[3]) == host_results[3]);
 }
 
+BOOST_AUTO_TEST_CASE(eigen_device_gemm)
+{
+    typedef Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        RowMatrixXf;
+
+    Eigen::MatrixXf a = Eigen::MatrixXf::Random(37, 21);
+    RowMatrixXf b = RowMatrixXf::Random(21, 19);
+    Eigen::MatrixXf c = Eigen::MatrixXf::Random(37, 19);
+
+    bcl::eigen_device_matrix<float> device_a(37, 21, context);
+    bcl::eigen_device_matrix<float> device_b(21, 19, context, Eigen::RowMajor);
+    bcl::eigen_device_matrix<float> device_c(37, 19, context);
+
+    bcl::eigen_copy_matrix_to_device_async(a, device_a, 0, queue);
+    bcl::eigen_copy_matrix_to_device_async(b, device_b, 0, queue);
+    bcl::eigen_copy_matrix_to_device_async(c, device_c, 0, queue);
+
+    bcl::eigen_gemm(device_a, device_b, device_c, 2.0f, 0.5f, queue);
+
+    Eigen::MatrixXf result(37, 19);
+    bcl::eigen_copy_device_to_matrix_async(device_c, 0, result, queue).wait();
+
+    const Eigen::MatrixXf expected = 2.0f * a * b + 0.5f * c;
+    BOOST_CHECK(result.isApprox(expected, 1e-4f));
+}
+
+BOOST_AUTO_TEST_CASE(eigen_device_gemv_batched)
+{
+    typedef Eigen::Matrix<float, 4, 4, Eigen::RowMajor> RowMatrix4f;
+
+    RowMatrix4f matrices[3];
+    Eigen::Vector4f vectors[3];
+
+    bcl::eigen_device_matrix<float> device_a(4, 4, context, Eigen::RowMajor, 0, 3);
+    bcl::eigen_device_matrix<float> device_x(4, 1, context, Eigen::ColMajor, 0, 3);
+    bcl::eigen_device_matrix<float> device_y(4, 1, context, Eigen::ColMajor, 0, 3);
+    for(size_t i = 0; i < 3; i++){
+        matrices[i] = RowMatrix4f::Random();
+        vectors[i] = Eigen::Vector4f::Random();
+        bcl::eigen_copy_matrix_to_device_async(matrices[i], device_a, i, queue);
+        bcl::eigen_copy_matrix_to_device_async(vectors[i], device_x, i, queue);
+    }
+
+    // y is not read when beta is zero
+    bcl::eigen_gemv(device_a, device_x, device_y, 1.0f, 0.0f, queue);
+
+    for(size_t i = 0; i < 3; i++){
+        Eigen::Vector4f result;
+        bcl::eigen_copy_device_to_matrix_async(device_y, i, result, queue).wait();
+        BOOST_CHECK(result.isApprox(matrices[i] * vectors[i], 1e-4f));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -11,12 +11,20 @@
 #define BOOST_TEST_MODULE TestInteropOpenCV
 #include <boost/test/unit_test.hpp>
 
+#include <iostream>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/algorithm/reverse.hpp>
 #include <boost/compute/interop/opencv.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 
+#if CV_MAJOR_VERSION >= 3
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/interop/opencv/umat.hpp>
+#endif
+
 #include "check_macros.hpp"
 #include "context_setup.hpp"
 
@@ -102,4 +110,44 @@ BOOST_AUTO_TEST_CASE(opencv_float_mat_image2d)
     BOOST_CHECK_EQUAL(pixel[3], 255.0f);
 }
 
+#if CV_MAJOR_VERSION >= 3
+BOOST_AUTO_TEST_CASE(opencv_umat_zero_copy)
+{
+    if(!cv::ocl::haveOpenCL()){
+        std::cerr << "skipping opencv_umat_zero_copy, opencv has no opencl" << std::endl;
+        return;
+    }
+
+    // share the context of the test with opencv
+    bcl::opencv_umat_attach_context(queue);
+    cv::ocl::setUseOpenCL(true);
+    BOOST_CHECK(bcl::opencv_umat_get_context() == context);
+
+    cv::UMat umat(1, 8, CV_32S, cv::Scalar(0));
+
+    // write the umat in place with boost.compute on opencv's queue
+    bcl::command_queue umat_queue = bcl::opencv_umat_get_command_queue();
+    bcl::iota(
+        bcl::opencv_umat_begin<int>(umat), bcl::opencv_umat_end<int>(umat), 0, umat_queue
+    );
+    umat_queue.finish();
+
+    cv::Mat mat = umat.getMat(cv::ACCESS_READ);
+    for(int i = 0; i < 8; i++){
+        BOOST_CHECK_EQUAL(mat.at<int>(0, i), i);
+    }
+    mat.release();
+
+    // alias a boost.compute buffer as a umat
+    bcl::vector<float> vector(16, context);
+    bcl::fill(vector.begin(), vector.end(), 2.5f, queue);
+    queue.finish();
+
+    cv::UMat alias = bcl::opencv_umat_from_buffer(
+        vector.get_buffer(), 4, 4, CV_32F
+    );
+    BOOST_CHECK_EQUAL(cv::sum(alias)[0], 40.0);
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
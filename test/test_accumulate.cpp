@@ -12,6 +12,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <numeric>
+#include <vector>
 
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/accumulate.hpp>
@@ -252,6 +253,41 @@ BOOST_AUTO_TEST_CASE(min_max)
     BOOST_CHECK_EQUAL(max_value, 10.f);
 }
 
+BOOST_AUTO_TEST_CASE(associative_function)
+{
+    // returns its second argument unless it is zero. the function is
+    // associative but not commutative.
+    BOOST_COMPUTE_FUNCTION(int, last_non_zero, (int x, int y),
+    {
+        return y != 0 ? y : x;
+    });
+
+    std::vector<int> data(100000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = (i % 7 == 0) ? int(i) : 0;
+    }
+    boost::compute::vector<int> vector(data.begin(), data.end(), queue);
+
+    int result = boost::compute::accumulate(
+        vector.begin(), vector.end(), -1,
+        boost::compute::make_associative(last_non_zero), queue
+    );
+    BOOST_CHECK_EQUAL(result, 99995);
+
+    // the initial value is combined first
+    result = boost::compute::accumulate(
+        vector.begin(), vector.begin() + 1, -1,
+        boost::compute::make_associative(last_non_zero), queue
+    );
+    BOOST_CHECK_EQUAL(result, -1);
+
+    boost::compute::future<int> future = boost::compute::accumulate_async(
+        vector.begin(), vector.begin() + 50000, -1,
+        boost::compute::make_associative(last_non_zero), queue
+    );
+    BOOST_CHECK_EQUAL(future.get(), 49994);
+}
+
 template<class T>
 void ensure_std_accumulate_equality(const std::vector<T> &data,
                                     boost::compute::command_queue &queue)
@@ -11,6 +11,8 @@
 #define BOOST_TEST_MODULE TestAdjacentDifference
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/lambda.hpp>
@@ -69,4 +71,25 @@ BOOST_AUTO_TEST_CASE(all_same)
     );
 }
 
+BOOST_AUTO_TEST_CASE(adjacent_difference_across_tiles)
+{
+    // squares, the differences are the odd numbers
+    std::vector<int> data(10000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>(i * i);
+    }
+
+    compute::vector<int> input(data.begin(), data.end(), queue);
+    compute::vector<int> output(data.size(), context);
+    compute::adjacent_difference(input.begin(), input.end(), output.begin(), queue);
+
+    std::vector<int> result(data.size());
+    compute::copy(output.begin(), output.end(), result.begin(), queue);
+
+    BOOST_CHECK_EQUAL(result[0], 0);
+    for(size_t i = 1; i < result.size(); i++){
+        BOOST_CHECK_EQUAL(result[i], static_cast<int>(2 * i - 1));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
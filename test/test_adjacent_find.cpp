@@ -65,4 +65,17 @@ BOOST_AUTO_TEST_CASE(adjacent_find_fill)
     );
 }
 
+BOOST_AUTO_TEST_CASE(adjacent_find_last_pair)
+{
+    compute::vector<int> vec(100000, context);
+    compute::iota(vec.begin(), vec.end(), 0, queue);
+    compute::fill(vec.end() - 2, vec.end(), -1, queue);
+
+    // the search starts from an offset into the vector
+    BOOST_CHECK(
+        compute::adjacent_find(vec.begin() + 10, vec.end(), queue) ==
+            vec.end() - 2
+    );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,205 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestAggregateByKey
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+#include <boost/compute/algorithm/aggregate_by_key.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// checks the aggregates of the groups of keys and values against the
+// ones computed on the host
+static void check_aggregates(const std::vector<int> &keys,
+                             const std::vector<int> &values,
+                             compute::command_queue &queue)
+{
+    compute::context context = queue.get_context();
+    const size_t count = keys.size();
+
+    std::map<int, std::vector<int> > groups;
+    for(size_t i = 0; i < count; i++){
+        groups[keys[i]].push_back(values[i]);
+    }
+
+    compute::vector<int> device_keys(keys.begin(), keys.end(), queue);
+    compute::vector<int> device_values(values.begin(), values.end(), queue);
+
+    compute::vector<int> group_keys(count, context);
+    compute::vector<compute::uint_> counts(count, context);
+    compute::vector<int> sums(count, context);
+    compute::vector<int> minima(count, context);
+    compute::vector<int> maxima(count, context);
+
+    compute::aggregators<int> aggregates;
+    aggregates.count(counts.begin())
+              .sum(sums.begin())
+              .min(minima.begin())
+              .max(maxima.begin());
+
+    const size_t group_count = compute::aggregate_by_key(
+        device_keys.begin(), device_keys.end(), device_values.begin(),
+        group_keys.begin(), aggregates, queue
+    );
+    BOOST_REQUIRE_EQUAL(group_count, groups.size());
+
+    std::vector<int> host_keys(group_count);
+    std::vector<compute::uint_> host_counts(group_count);
+    std::vector<int> host_sums(group_count);
+    std::vector<int> host_minima(group_count);
+    std::vector<int> host_maxima(group_count);
+    compute::copy(group_keys.begin(), group_keys.begin() + group_count, host_keys.begin(), queue);
+    compute::copy(counts.begin(), counts.begin() + group_count, host_counts.begin(), queue);
+    compute::copy(sums.begin(), sums.begin() + group_count, host_sums.begin(), queue);
+    compute::copy(minima.begin(), minima.begin() + group_count, host_minima.begin(), queue);
+    compute::copy(maxima.begin(), maxima.begin() + group_count, host_maxima.begin(), queue);
+
+    size_t i = 0;
+    for(std::map<int, std::vector<int> >::const_iterator iter = groups.begin();
+        iter != groups.end(); ++iter, ++i){
+        const std::vector<int> &group = iter->second;
+
+        int sum = 0;
+        for(size_t j = 0; j < group.size(); j++){
+            sum += group[j];
+        }
+
+        BOOST_CHECK_EQUAL(host_keys[i], iter->first);
+        BOOST_CHECK_EQUAL(host_counts[i], compute::uint_(group.size()));
+        BOOST_CHECK_EQUAL(host_sums[i], sum);
+        BOOST_CHECK_EQUAL(host_minima[i], *std::min_element(group.begin(), group.end()));
+        BOOST_CHECK_EQUAL(host_maxima[i], *std::max_element(group.begin(), group.end()));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(aggregate_int)
+{
+    int keys[] = { 4, -3, 4, 0, -3, 4, 7, 0 };
+    int data[] = { 1, 5, -2, 8, 3, 6, 1, 0 };
+
+    compute::vector<int> keys_input(keys, keys + 8, queue);
+    compute::vector<int> values_input(data, data + 8, queue);
+
+    compute::vector<int> group_keys(8, context);
+    compute::vector<compute::uint_> counts(8, context);
+    compute::vector<int> sums(8, context);
+
+    compute::aggregators<int> aggregates;
+    aggregates.count(counts.begin()).sum(sums.begin());
+
+    size_t groups = compute::aggregate_by_key(
+        keys_input.begin(), keys_input.end(), values_input.begin(),
+        group_keys.begin(), aggregates, queue
+    );
+    BOOST_CHECK_EQUAL(groups, size_t(4));
+    CHECK_RANGE_EQUAL(int, 4, group_keys, (-3, 0, 4, 7));
+    CHECK_RANGE_EQUAL(compute::uint_, 4, counts, (2, 2, 3, 1));
+    CHECK_RANGE_EQUAL(int, 4, sums, (8, 8, 5, 1));
+}
+
+BOOST_AUTO_TEST_CASE(aggregate_float)
+{
+    compute::uint_ keys[] = { 2, 1, 2, 2, 1, 9 };
+    float data[] = { 1.5f, -1.0f, 0.5f, 4.0f, 2.0f, 3.0f };
+
+    compute::vector<compute::uint_> keys_input(keys, keys + 6, queue);
+    compute::vector<float> values_input(data, data + 6, queue);
+
+    compute::vector<compute::uint_> group_keys(6, context);
+    compute::vector<float> sums(6, context);
+    compute::vector<float> minima(6, context);
+    compute::vector<float> maxima(6, context);
+
+    compute::aggregators<float> aggregates;
+    aggregates.sum(sums.begin()).min(minima.begin()).max(maxima.begin());
+
+    size_t groups = compute::aggregate_by_key(
+        keys_input.begin(), keys_input.end(), values_input.begin(),
+        group_keys.begin(), aggregates, queue
+    );
+    BOOST_CHECK_EQUAL(groups, size_t(3));
+    CHECK_RANGE_EQUAL(compute::uint_, 3, group_keys, (1, 2, 9));
+    CHECK_RANGE_EQUAL(float, 3, sums, (1.0f, 6.0f, 3.0f));
+    CHECK_RANGE_EQUAL(float, 3, minima, (-1.0f, 0.5f, 3.0f));
+    CHECK_RANGE_EQUAL(float, 3, maxima, (2.0f, 4.0f, 3.0f));
+}
+
+BOOST_AUTO_TEST_CASE(few_groups)
+{
+    // aggregated in the hash table
+    std::vector<int> keys(100000);
+    std::vector<int> values(keys.size());
+    for(size_t i = 0; i < keys.size(); i++){
+        keys[i] = int((i * 7919) % 37) - 10;
+        values[i] = int(i % 101) - 50;
+    }
+
+    check_aggregates(keys, values, queue);
+}
+
+BOOST_AUTO_TEST_CASE(many_groups)
+{
+    // aggregated by sorting
+    std::vector<int> keys(50000);
+    std::vector<int> values(keys.size());
+    for(size_t i = 0; i < keys.size(); i++){
+        keys[i] = int((i * 7919) % 20000);
+        values[i] = int(i % 13);
+    }
+
+    check_aggregates(keys, values, queue);
+}
+
+BOOST_AUTO_TEST_CASE(reserved_keys)
+{
+    // INT_MIN and INT_MIN + 1 mark the empty and erased slots of the hash
+    // table, so keys equal to them are aggregated by sorting
+    std::vector<int> keys(10000);
+    std::vector<int> values(keys.size());
+    for(size_t i = 0; i < keys.size(); i++){
+        keys[i] = int(i % 4) - 2;
+        values[i] = int(i % 7);
+    }
+    keys[17] = (std::numeric_limits<int>::min)();
+    keys[5000] = (std::numeric_limits<int>::min)() + 1;
+
+    check_aggregates(keys, values, queue);
+}
+
+BOOST_AUTO_TEST_CASE(sort_only)
+{
+    boost::shared_ptr<compute::detail::parameter_cache> parameters =
+        compute::detail::parameter_cache::get_global_cache(device);
+    parameters->set("__boost_aggregate_by_key", "hash_threshold", 0);
+
+    std::vector<int> keys(10000);
+    std::vector<int> values(keys.size());
+    for(size_t i = 0; i < keys.size(); i++){
+        keys[i] = int(i % 5);
+        values[i] = int(i);
+    }
+
+    check_aggregates(keys, values, queue);
+
+    parameters->set("__boost_aggregate_by_key", "hash_threshold", 1024);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,99 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestAppendIterator
+#include <boost/test/unit_test.hpp>
+
+#include <boost/type_traits.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/copy_if.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/iterator/append_iterator.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(value_type)
+{
+    BOOST_STATIC_ASSERT((
+        boost::is_same<
+            bc::append_iterator<int>::value_type, int
+        >::value
+    ));
+    BOOST_STATIC_ASSERT((
+        bc::is_device_iterator<bc::append_iterator<int> >::value
+    ));
+}
+
+BOOST_AUTO_TEST_CASE(append_copy)
+{
+    bc::vector<int> input(5, context);
+    bc::iota(input.begin(), input.end(), 1, queue);
+
+    bc::vector<int> output(10, context);
+    bc::fill(output.begin(), output.end(), 0, queue);
+
+    // append after the two values already in the output
+    bc::vector<bc::uint_> counter(1, context);
+    bc::fill(counter.begin(), counter.end(), bc::uint_(2), queue);
+
+    bc::copy(
+        input.begin(),
+        input.end(),
+        bc::make_append_iterator<int>(output.get_buffer(), counter.get_buffer()),
+        queue
+    );
+    BOOST_CHECK_EQUAL(bc::uint_(counter[0]), bc::uint_(7));
+
+    bc::sort(output.begin() + 2, output.begin() + 7, queue);
+    CHECK_RANGE_EQUAL(int, 10, output, (0, 0, 1, 2, 3, 4, 5, 0, 0, 0));
+}
+
+BOOST_AUTO_TEST_CASE(append_copy_if)
+{
+    using bc::lambda::_1;
+
+    bc::vector<int> input(100, context);
+    bc::iota(input.begin(), input.end(), 0, queue);
+
+    bc::vector<int> output(context);
+    output.reserve(input.size(), queue);
+
+    bc::vector<bc::uint_> counter(1, context);
+    bc::fill(counter.begin(), counter.end(), bc::uint_(0), queue);
+
+    bc::copy_if(
+        input.begin(),
+        input.end(),
+        bc::make_append_iterator<int>(output.get_buffer(), counter.get_buffer()),
+        _1 % 10 == 0,
+        queue
+    );
+
+    // the values are already stored in the capacity of the vector
+    output.resize(bc::uint_(counter[0]), queue);
+    BOOST_CHECK_EQUAL(output.size(), size_t(10));
+
+    bc::sort(output.begin(), output.end(), queue);
+    CHECK_RANGE_EQUAL(
+        int, 10, output, (0, 10, 20, 30, 40, 50, 60, 70, 80, 90)
+    );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,101 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestArenaAllocator
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include <boost/compute/allocator/arena_allocator.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/buffer_arena.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+#include "opencl_version_check.hpp"
+
+namespace compute = boost::compute;
+
+#ifdef CL_VERSION_1_1
+BOOST_AUTO_TEST_CASE(sub_allocate_from_block)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    boost::shared_ptr<compute::buffer_arena> arena =
+        boost::make_shared<compute::buffer_arena>(context, 1024 * 1024);
+    compute::arena_allocator<int> allocator(arena);
+
+    typedef compute::arena_allocator<int>::pointer pointer;
+    pointer x = allocator.allocate(100);
+    pointer y = allocator.allocate(100);
+    BOOST_CHECK_EQUAL(arena->block_count(), size_t(1));
+
+    // both are regions of the same block
+    cl_mem x_parent = x.get_buffer().get_info<cl_mem>(CL_MEM_ASSOCIATED_MEMOBJECT);
+    cl_mem y_parent = y.get_buffer().get_info<cl_mem>(CL_MEM_ASSOCIATED_MEMOBJECT);
+    BOOST_CHECK(x_parent != 0);
+    BOOST_CHECK(x_parent == y_parent);
+
+    const size_t alignment =
+        device.get_info<CL_DEVICE_MEM_BASE_ADDR_ALIGN>() / 8;
+    const size_t x_offset = x.get_buffer().get_info<size_t>(CL_MEM_OFFSET);
+    const size_t y_offset = y.get_buffer().get_info<size_t>(CL_MEM_OFFSET);
+    BOOST_CHECK_EQUAL(x_offset % alignment, size_t(0));
+    BOOST_CHECK_EQUAL(y_offset % alignment, size_t(0));
+    BOOST_CHECK(x_offset + 100 * sizeof(int) <= y_offset);
+
+    // a released region is handed out again
+    allocator.deallocate(x, 100);
+    pointer z = allocator.allocate(50);
+    BOOST_CHECK_EQUAL(z.get_buffer().get_info<size_t>(CL_MEM_OFFSET), x_offset);
+
+    allocator.deallocate(y, 100);
+    allocator.deallocate(z, 50);
+    BOOST_CHECK_EQUAL(arena->used(), size_t(0));
+
+    arena->trim();
+    BOOST_CHECK_EQUAL(arena->block_count(), size_t(0));
+}
+
+BOOST_AUTO_TEST_CASE(large_allocation)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    boost::shared_ptr<compute::buffer_arena> arena =
+        boost::make_shared<compute::buffer_arena>(context, 4096);
+
+    // larger than a quarter of a block
+    compute::buffer buf = arena->allocate(2048);
+    BOOST_CHECK(buf.get_info<cl_mem>(CL_MEM_ASSOCIATED_MEMOBJECT) == 0);
+    BOOST_CHECK_EQUAL(arena->block_count(), size_t(0));
+    arena->release(buf);
+}
+
+BOOST_AUTO_TEST_CASE(many_small_vectors)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    typedef compute::vector<int, compute::arena_allocator<int> > vector_type;
+
+    std::vector<vector_type> vectors;
+    for(int i = 0; i < 100; i++){
+        vectors.push_back(vector_type(size_t(4), i, queue));
+    }
+    vectors[42].push_back(7, queue);
+
+    CHECK_RANGE_EQUAL(int, 4, vectors[0], (0, 0, 0, 0));
+    CHECK_RANGE_EQUAL(int, 5, vectors[42], (42, 42, 42, 42, 7));
+    CHECK_RANGE_EQUAL(int, 4, vectors[99], (99, 99, 99, 99));
+}
+#endif // CL_VERSION_1_1
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,106 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestArrayView
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/array_view.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/utility/dim.hpp>
+#include <boost/compute/utility/extents.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(shape_and_strides)
+{
+    bc::vector<float> data(24, context);
+    bc::array_view<float, 3> view(data.begin(), bc::dim(2, 3, 4));
+
+    BOOST_CHECK_EQUAL(view.size(), size_t(24));
+    BOOST_CHECK_EQUAL(view.extent(1), size_t(3));
+    BOOST_CHECK_EQUAL(view.stride(0), size_t(12));
+    BOOST_CHECK_EQUAL(view.stride(1), size_t(4));
+    BOOST_CHECK_EQUAL(view.stride(2), size_t(1));
+    BOOST_CHECK(view.is_contiguous());
+
+    bc::array_view<float, 3> transposed = view.transpose(0, 2);
+    BOOST_CHECK_EQUAL(transposed.extent(0), size_t(4));
+    BOOST_CHECK_EQUAL(transposed.stride(0), size_t(1));
+    BOOST_CHECK(!transposed.is_contiguous());
+}
+
+// a 4x3 matrix stored in row-major order
+//   0  1  2
+//   3  4  5
+//   6  7  8
+//   9 10 11
+BOOST_AUTO_TEST_CASE(slice_rows_and_columns)
+{
+    bc::vector<int> matrix(12, context);
+    bc::iota(matrix.begin(), matrix.end(), 0, queue);
+
+    bc::array_view<int, 2> view(matrix.begin(), bc::dim(4, 3));
+
+    bc::array_view<int, 1> row = view.slice(0, 2);
+    BOOST_CHECK_EQUAL(row.size(), size_t(3));
+    BOOST_CHECK(row.is_contiguous());
+    CHECK_RANGE_EQUAL(int, 3, row, (6, 7, 8));
+
+    bc::array_view<int, 1> column = view.slice(1, 1);
+    BOOST_CHECK_EQUAL(column.size(), size_t(4));
+    BOOST_CHECK(!column.is_contiguous());
+    CHECK_RANGE_EQUAL(int, 4, column, (1, 4, 7, 10));
+
+    // the second column of the transpose is the second row
+    CHECK_RANGE_EQUAL(int, 3, view.transpose().slice(1, 1), (3, 4, 5));
+}
+
+BOOST_AUTO_TEST_CASE(section)
+{
+    bc::vector<int> matrix(12, context);
+    bc::iota(matrix.begin(), matrix.end(), 0, queue);
+
+    bc::array_view<int, 2> view(matrix.begin(), bc::dim(4, 3));
+
+    // the lower-right 2x2 block
+    bc::array_view<int, 2> block = view.section(bc::dim(2, 1), bc::dim(2, 2));
+    BOOST_CHECK_EQUAL(block.offset(), size_t(7));
+    CHECK_RANGE_EQUAL(int, 2, block.slice(0, 0), (7, 8));
+    CHECK_RANGE_EQUAL(int, 2, block.slice(0, 1), (10, 11));
+}
+
+BOOST_AUTO_TEST_CASE(index_in_kernel)
+{
+    using bc::uint_;
+
+    bc::vector<int> matrix(12, context);
+    bc::iota(matrix.begin(), matrix.end(), 0, queue);
+
+    bc::array_view<int, 2> view(matrix.begin(), bc::dim(4, 3));
+    bc::vector<int> diagonal(3, context);
+
+    // gather the diagonal of the transposed matrix
+    bc::detail::meta_kernel k("diagonal");
+    k << diagonal.begin()[k.var<uint_>("get_global_id(0)")] << " = "
+      << view.transpose()(k.var<uint_>("get_global_id(0)"),
+                          k.var<uint_>("get_global_id(0)")) << ";\n";
+    k.exec_1d(queue, 0, 3);
+
+    CHECK_RANGE_EQUAL(int, 3, diagonal, (0, 4, 8));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
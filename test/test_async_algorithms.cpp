@@ -0,0 +1,174 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestAsyncAlgorithms
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/algorithm/accumulate.hpp>
+#include <boost/compute/algorithm/count.hpp>
+#include <boost/compute/algorithm/count_if.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/inclusive_scan.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/is_sorted.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/utility/wait_list.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(transform_async)
+{
+    int data[] = { -1, 2, -3, 4 };
+    compute::vector<int> vector(data, data + 4, queue);
+    compute::vector<int> result(4, context);
+
+    compute::future<compute::vector<int>::iterator> future =
+        compute::transform_async(
+            vector.begin(), vector.end(), result.begin(), compute::abs<int>(), queue
+        );
+    BOOST_CHECK(future.get() == result.end());
+    CHECK_RANGE_EQUAL(int, 4, result, (1, 2, 3, 4));
+
+    compute::transform_async(
+        vector.begin(), vector.end(), result.begin(), result.begin(),
+        compute::plus<int>(), queue
+    ).wait();
+    CHECK_RANGE_EQUAL(int, 4, result, (0, 4, 0, 8));
+}
+
+BOOST_AUTO_TEST_CASE(reduce_and_accumulate_async)
+{
+    compute::vector<int> vector(100, context);
+    compute::iota(vector.begin(), vector.end(), 1, queue);
+
+    compute::vector<int> sum(1, context);
+    compute::reduce_async(vector.begin(), vector.end(), sum.begin(), queue).wait();
+    CHECK_RANGE_EQUAL(int, 1, sum, (5050));
+
+    compute::future<int> total =
+        compute::accumulate_async(vector.begin(), vector.end(), 0, queue);
+    BOOST_CHECK_EQUAL(total.get(), 5050);
+
+    // not reducible, accumulated serially on the device
+    compute::future<int> offset_total =
+        compute::accumulate_async(vector.begin(), vector.end(), 10, queue);
+    BOOST_CHECK_EQUAL(offset_total.get(), 5060);
+
+    // empty range
+    compute::future<int> init =
+        compute::accumulate_async(vector.begin(), vector.begin(), 7, queue);
+    BOOST_CHECK_EQUAL(init.get(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(count_async)
+{
+    using compute::lambda::_1;
+
+    int data[] = { 1, 2, 1, 3, 1, 4, 5, 1 };
+    compute::vector<int> vector(data, data + 8, queue);
+
+    compute::future<size_t> ones = compute::count_async(
+        vector.begin(), vector.end(), 1, queue
+    );
+    compute::future<size_t> large = compute::count_if_async(
+        vector.begin(), vector.end(), _1 > 2, queue
+    );
+
+    BOOST_CHECK_EQUAL(ones.get(), size_t(4));
+    BOOST_CHECK_EQUAL(large.get(), size_t(3));
+}
+
+BOOST_AUTO_TEST_CASE(sort_async)
+{
+    int data[] = { 5, 3, 8, 1, 9, 2, 7, 4 };
+    compute::vector<int> vector(data, data + 8, queue);
+
+    compute::future<void> future =
+        compute::sort_async(vector.begin(), vector.end(), queue);
+    future.wait();
+    CHECK_RANGE_EQUAL(int, 8, vector, (1, 2, 3, 4, 5, 7, 8, 9));
+
+    compute::sort_async(
+        vector.begin(), vector.end(), compute::greater<int>(), queue
+    ).wait();
+    CHECK_RANGE_EQUAL(int, 8, vector, (9, 8, 7, 5, 4, 3, 2, 1));
+
+    // large enough for the constant digits to be found on the device
+    std::vector<int> host(100000);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = static_cast<int>((i * 7919) % 16);
+    }
+    compute::vector<int> large(host.begin(), host.end(), queue);
+    compute::sort_async(large.begin(), large.end(), queue).wait();
+    BOOST_CHECK(compute::is_sorted(large.begin(), large.end(), queue));
+}
+
+BOOST_AUTO_TEST_CASE(scan_async)
+{
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> vector(data, data + 4, queue);
+    compute::vector<int> result(4, context);
+
+    compute::future<compute::vector<int>::iterator> future =
+        compute::inclusive_scan_async(
+            vector.begin(), vector.end(), result.begin(), queue
+        );
+    BOOST_CHECK(future.get() == result.end());
+    CHECK_RANGE_EQUAL(int, 4, result, (1, 3, 6, 10));
+
+    compute::exclusive_scan_async(
+        vector.begin(), vector.end(), result.begin(), queue
+    ).wait();
+    CHECK_RANGE_EQUAL(int, 4, result, (0, 1, 3, 6));
+}
+
+BOOST_AUTO_TEST_CASE(wait_list_between_queues)
+{
+    compute::command_queue other_queue(context, device);
+
+    compute::vector<int> vector(8, context);
+    compute::vector<int> result(8, context);
+
+    // fill on the other queue and transform on queue after the fill
+    compute::future<void> fill = compute::fill_async(
+        vector.begin(), vector.end(), 3, other_queue
+    );
+
+    compute::wait_list events;
+    events.insert(fill);
+    compute::future<compute::vector<int>::iterator> transform =
+        compute::transform_async(
+            vector.begin(), vector.end(), result.begin(),
+            compute::abs<int>(), queue, events
+        );
+
+    // the completion event of the transform orders the sum after it
+    compute::wait_list transform_events;
+    transform_events.insert(transform);
+    int sum = 0;
+    compute::reduce(
+        result.begin(), result.end(), &sum, other_queue, transform_events
+    );
+    BOOST_CHECK_EQUAL(sum, 24);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,70 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestAsyncCoroutine
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/async/coroutine.hpp>
+#include <boost/compute/async/future.hpp>
+
+#include "context_setup.hpp"
+#include "opencl_version_check.hpp"
+
+namespace compute = boost::compute;
+
+#if !defined(BOOST_COMPUTE_DETAIL_NO_COROUTINES) && defined(CL_VERSION_1_1)
+#include <exception>
+
+// coroutine which starts immediately and is not awaited
+struct detached
+{
+    struct promise_type
+    {
+        detached get_return_object() { return detached(); }
+        std::suspend_never initial_suspend() { return std::suspend_never(); }
+        std::suspend_never final_suspend() noexcept { return std::suspend_never(); }
+        void return_void() { }
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+detached increment(compute::future<int> f,
+                   compute::event e,
+                   int *result,
+                   compute::user_event done)
+{
+    // wait for the event and then for the future
+    co_await e;
+    *result = co_await f + 1;
+
+    done.set_status(CL_COMPLETE);
+}
+
+BOOST_AUTO_TEST_CASE(co_await_event_and_future)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    compute::user_event event(context);
+    compute::user_event future_event(context);
+    compute::user_event done(context);
+    compute::future<int> future(41, future_event);
+
+    int result = 0;
+    increment(future, event, &result, done);
+
+    event.set_status(CL_COMPLETE);
+    future_event.set_status(CL_COMPLETE);
+    done.wait();
+    BOOST_CHECK_EQUAL(result, 42);
+}
+#endif // BOOST_COMPUTE_DETAIL_NO_COROUTINES
+
+BOOST_AUTO_TEST_SUITE_END()
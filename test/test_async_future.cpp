@@ -0,0 +1,129 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestAsyncFuture
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include <boost/throw_exception.hpp>
+
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/async/when_all.hpp>
+#include <boost/compute/async/when_any.hpp>
+
+#include "context_setup.hpp"
+#include "opencl_version_check.hpp"
+
+namespace compute = boost::compute;
+
+#ifdef CL_VERSION_1_1
+int twice(compute::future<int> f)
+{
+    return 2 * f.get();
+}
+
+void fail(compute::future<int> f)
+{
+    (void) f;
+
+    BOOST_THROW_EXCEPTION(std::runtime_error("continuation failed"));
+}
+
+// returns a future which is complete once event is
+struct delayed_increment
+{
+    typedef compute::future<int> result_type;
+
+    delayed_increment(const compute::user_event &event_)
+        : event(event_)
+    {
+    }
+
+    result_type operator()(compute::future<int> f) const
+    {
+        return compute::future<int>(f.get() + 1, event);
+    }
+
+    compute::user_event event;
+};
+
+BOOST_AUTO_TEST_CASE(then)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    compute::user_event event(context);
+    compute::future<int> f(21, event);
+
+    compute::future<int> g = f.then(twice);
+    compute::future<int> h = g.then(twice);
+
+    event.set_status(CL_COMPLETE);
+    BOOST_CHECK_EQUAL(h.get(), 84);
+    BOOST_CHECK_EQUAL(g.get(), 42);
+}
+
+BOOST_AUTO_TEST_CASE(then_exception)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    compute::user_event event(context);
+    compute::future<int> f(1, event);
+
+    compute::future<void> g = f.then(fail);
+
+    event.set_status(CL_COMPLETE);
+    BOOST_CHECK_THROW(g.get(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(then_returning_future)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    compute::user_event event(context);
+    compute::user_event inner_event(context);
+    compute::future<int> f(1, event);
+
+    // the future returned by the continuation is unwrapped
+    compute::future<int> g = f.then(delayed_increment(inner_event));
+
+    event.set_status(CL_COMPLETE);
+    inner_event.set_status(CL_COMPLETE);
+    BOOST_CHECK_EQUAL(g.get(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(when_all_and_when_any)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    std::vector<compute::user_event> events;
+    std::vector<compute::future<int> > futures;
+    for(int i = 0; i < 3; i++){
+        events.push_back(compute::user_event(context));
+        futures.push_back(compute::future<int>(i, events.back()));
+    }
+
+    compute::future<void> all = compute::when_all(futures.begin(), futures.end());
+    compute::future<size_t> any = compute::when_any(futures.begin(), futures.end());
+
+    events[1].set_status(CL_COMPLETE);
+    BOOST_CHECK_EQUAL(any.get(), size_t(1));
+    BOOST_CHECK(all.get_event().status() != CL_COMPLETE);
+
+    events[0].set_status(CL_COMPLETE);
+    events[2].set_status(CL_COMPLETE);
+    all.get();
+    BOOST_CHECK(all.get_event().status() == CL_COMPLETE);
+}
+#endif // CL_VERSION_1_1
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,144 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestAutotuner
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/algorithm/count_if.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/experimental/autotuner.hpp>
+
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(work_group_size_parameter)
+{
+    boost::shared_ptr<compute::detail::parameter_cache> parameters =
+        compute::detail::parameter_cache::get_global_cache(device);
+
+    // not set, default value
+    BOOST_CHECK_EQUAL(
+        compute::detail::get_work_group_size_parameter(
+            device, "__boost_test_autotuner", "block_size", 64
+        ),
+        size_t(64)
+    );
+
+    // rounded down to a power of two
+    parameters->set("__boost_test_autotuner", "block_size", 100);
+    BOOST_CHECK_EQUAL(
+        compute::detail::get_work_group_size_parameter(
+            device, "__boost_test_autotuner", "block_size", 64
+        ),
+        size_t(64)
+    );
+
+    // limited to the device
+    parameters->set("__boost_test_autotuner", "block_size", 1 << 30);
+    BOOST_CHECK(
+        compute::detail::get_work_group_size_parameter(
+            device, "__boost_test_autotuner", "block_size", 64
+        ) <= device.max_work_group_size()
+    );
+
+    parameters->reset("__boost_test_autotuner");
+}
+
+BOOST_AUTO_TEST_CASE(tune_reduce)
+{
+    compute::experimental::autotuner tuner(queue, 2);
+
+    const compute::uint_ block_size = tuner.tune_reduce<int>(10000);
+    BOOST_CHECK(block_size >= 32 || block_size == device.max_work_group_size());
+    BOOST_CHECK(block_size <= device.max_work_group_size());
+
+    boost::shared_ptr<compute::detail::parameter_cache> parameters =
+        compute::detail::parameter_cache::get_global_cache(device);
+    BOOST_CHECK_EQUAL(parameters->get("__boost_reduce_int", "block_size", 0), block_size);
+
+    // reduce() uses the tuned block size
+    compute::vector<int> vector(10000, context);
+    compute::iota(vector.begin(), vector.end(), 0, queue);
+
+    int max = 0;
+    compute::reduce(vector.begin(), vector.end(), &max, compute::max<int>(), queue);
+    BOOST_CHECK_EQUAL(max, 9999);
+
+    parameters->reset("__boost_reduce_int");
+}
+
+BOOST_AUTO_TEST_CASE(tune_count_if)
+{
+    compute::experimental::autotuner tuner(queue, 1);
+
+    const compute::uint_ threshold = tuner.tune_count_if<int>();
+    BOOST_CHECK(threshold >= 16 && threshold <= 4096);
+
+    using compute::_1;
+
+    compute::vector<int> vector(5000, context);
+    compute::iota(vector.begin(), vector.end(), 0, queue);
+    BOOST_CHECK_EQUAL(
+        compute::count_if(vector.begin(), vector.end(), _1 < 100, queue),
+        size_t(100)
+    );
+
+    compute::detail::parameter_cache::get_global_cache(device)->reset("__boost_count_if");
+}
+
+BOOST_AUTO_TEST_CASE(tune_host_sort)
+{
+    compute::experimental::autotuner tuner(queue, 1);
+
+    const compute::uint_ threshold = tuner.tune_host_sort<int>();
+    BOOST_CHECK(threshold >= 1024 && threshold <= (1 << 22));
+    BOOST_CHECK_EQUAL(
+        compute::detail::host_sort_threshold<int>(queue), size_t(threshold)
+    );
+
+    compute::detail::parameter_cache::get_global_cache(device)->reset("__boost_host_sort_int");
+}
+
+BOOST_AUTO_TEST_CASE(tune_device_profile)
+{
+    compute::experimental::autotuner tuner(queue, 1);
+    tuner.tune_device_profile();
+
+    boost::shared_ptr<compute::detail::device_profile> profile =
+        compute::detail::device_profile::get(device);
+    BOOST_CHECK(profile->launch_latency() >= 1);
+    BOOST_CHECK(profile->serial_element_time() >= 1);
+
+    // every algorithm still gives the same results with the measured
+    // thresholds, on both sides of them
+    const size_t threshold = (std::min)(profile->serial_threshold(), size_t(1 << 16));
+
+    int data[] = { 5, 1, 4, 2, 3 };
+    compute::vector<int> small(data, data + 5, queue);
+    int max = 0;
+    compute::reduce(small.begin(), small.end(), &max, compute::max<int>(), queue);
+    BOOST_CHECK_EQUAL(max, 5);
+
+    compute::vector<int> large(threshold + 100, context);
+    compute::iota(large.begin(), large.end(), 0, queue);
+    compute::reduce(large.begin(), large.end(), &max, compute::max<int>(), queue);
+    BOOST_CHECK_EQUAL(max, static_cast<int>(threshold + 99));
+
+    compute::detail::parameter_cache::get_global_cache(device)->reset("__boost_device_profile");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,115 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestBatchedAlgorithms
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/experimental/batched_reduce.hpp>
+#include <boost/compute/experimental/batched_sort.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(batched_reduce_int)
+{
+    int data[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    compute::vector<int> values(data, data + 9, queue);
+    compute::vector<int> sums(4, context);
+    compute::fill(sums.begin(), sums.end(), -1, queue);
+
+    // the third segment is empty and keeps its value
+    compute::uint_ offsets[] = { 0, 4, 5, 5, 9 };
+    compute::experimental::batched_reduce(
+        values.begin(), offsets, offsets + 5, sums.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, sums, (10, 5, -1, 30));
+
+    compute::experimental::batched_reduce(
+        values.begin(), offsets, offsets + 5, sums.begin(), compute::max<int>(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, sums, (4, 5, -1, 9));
+}
+
+BOOST_AUTO_TEST_CASE(batched_reduce_many_segments)
+{
+    // 1000 segments of up to 300 values, longer than a work-group
+    std::vector<compute::uint_> offsets(1, 0);
+    for(size_t i = 0; i < 1000; i++){
+        offsets.push_back(offsets.back() + compute::uint_((i * 7) % 301));
+    }
+
+    std::vector<int> host(offsets.back(), 1);
+    compute::vector<int> values(host.begin(), host.end(), queue);
+    compute::vector<int> sums(1000, context);
+    compute::experimental::batched_reduce(
+        values.begin(), offsets.begin(), offsets.end(), sums.begin(), queue
+    );
+
+    std::vector<int> result(1000);
+    compute::copy(sums.begin(), sums.end(), result.begin(), queue);
+    for(size_t i = 0; i < 1000; i++){
+        if(offsets[i+1] != offsets[i]){
+            BOOST_CHECK_EQUAL(result[i], int(offsets[i+1] - offsets[i]));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(batched_sort_int)
+{
+    int data[] = { 3, 1, 2, 9, 8, 7, 6, 5, 0, -1, 4 };
+    compute::vector<int> values(data, data + 11, queue);
+
+    compute::uint_ offsets[] = { 0, 3, 3, 4, 9, 11 };
+    compute::experimental::batched_sort(values.begin(), offsets, offsets + 6, queue);
+    CHECK_RANGE_EQUAL(int, 11, values, (1, 2, 3, 9, 0, 5, 6, 7, 8, -1, 4));
+
+    compute::experimental::batched_sort(
+        values.begin(), offsets, offsets + 6, compute::greater<int>(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 11, values, (3, 2, 1, 9, 8, 7, 6, 5, 0, 4, -1));
+}
+
+BOOST_AUTO_TEST_CASE(batched_sort_random)
+{
+    std::vector<compute::uint_> offsets(1, 0);
+    for(size_t i = 0; i < 200; i++){
+        offsets.push_back(offsets.back() + compute::uint_(std::rand() % 600));
+    }
+
+    std::vector<float> host(offsets.back());
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = float(std::rand()) / RAND_MAX;
+    }
+    compute::vector<float> values(host.begin(), host.end(), queue);
+
+    compute::experimental::batched_sort(
+        values.begin(), offsets.begin(), offsets.end(), queue
+    );
+
+    std::vector<float> sorted(host.size());
+    compute::copy(values.begin(), values.end(), sorted.begin(), queue);
+    for(size_t i = 0; i + 1 < offsets.size(); i++){
+        std::sort(host.begin() + offsets[i], host.begin() + offsets[i+1]);
+    }
+    BOOST_CHECK(sorted == host);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
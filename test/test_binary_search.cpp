@@ -11,14 +11,18 @@
 #define BOOST_TEST_MODULE TestBinarySearch
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
 #include <iterator>
+#include <vector>
 
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/binary_search.hpp>
 #include <boost/compute/algorithm/lower_bound.hpp>
 #include <boost/compute/algorithm/upper_bound.hpp>
 #include <boost/compute/container/vector.hpp>
 
+#include "check_macros.hpp"
 #include "context_setup.hpp"
 
 BOOST_AUTO_TEST_CASE(binary_search_int)
@@ -64,4 +68,62 @@ BOOST_AUTO_TEST_CASE(range_bounds_int)
     BOOST_CHECK(boost::compute::upper_bound(vector.begin(), vector.end(), int(6)) == vector.end());
 }
 
+BOOST_AUTO_TEST_CASE(range_bounds_int_batch)
+{
+    int data[] = { 1, 2, 2, 2, 3, 3, 4, 5 };
+    boost::compute::vector<int> vector(data, data + 8, queue);
+
+    int values[] = { 0, 1, 2, 3, 4, 5, 6 };
+    boost::compute::vector<int> queries(values, values + 7, queue);
+    boost::compute::vector<boost::compute::uint_> result(7, context);
+
+    boost::compute::lower_bound(
+        vector.begin(), vector.end(), queries.begin(), queries.end(),
+        result.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(boost::compute::uint_, 7, result, (0, 0, 1, 4, 6, 7, 8));
+
+    boost::compute::upper_bound(
+        vector.begin(), vector.end(), queries.begin(), queries.end(),
+        result.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(boost::compute::uint_, 7, result, (0, 1, 4, 6, 7, 8, 8));
+
+    boost::compute::binary_search(
+        vector.begin(), vector.end(), queries.begin(), queries.end(),
+        result.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(boost::compute::uint_, 7, result, (0, 1, 1, 1, 1, 1, 0));
+}
+
+BOOST_AUTO_TEST_CASE(lower_bound_batch_large)
+{
+    // more values than samples in local memory
+    std::vector<int> data(100000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>(i / 3) * 2;
+    }
+    boost::compute::vector<int> vector(data.begin(), data.end(), queue);
+
+    std::vector<int> values(5000);
+    for(size_t i = 0; i < values.size(); i++){
+        values[i] = static_cast<int>((i * 7919) % 70000) - 10;
+    }
+    boost::compute::vector<int> queries(values.begin(), values.end(), queue);
+    boost::compute::vector<boost::compute::uint_> result(values.size(), context);
+
+    boost::compute::lower_bound(
+        vector.begin(), vector.end(), queries.begin(), queries.end(),
+        result.begin(), queue
+    );
+
+    std::vector<boost::compute::uint_> host_result(values.size());
+    boost::compute::copy(result.begin(), result.end(), host_result.begin(), queue);
+    for(size_t i = 0; i < values.size(); i++){
+        const size_t expected =
+            std::lower_bound(data.begin(), data.end(), values[i]) - data.begin();
+        BOOST_CHECK_EQUAL(host_result[i], expected);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
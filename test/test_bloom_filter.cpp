@@ -0,0 +1,127 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestBloomFilter
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/copy_if.hpp>
+#include <boost/compute/algorithm/count.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/bloom_filter.hpp>
+#include <boost/compute/container/dynamic_bitset.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(insert_and_contains)
+{
+    compute::bloom_filter<int> filter(
+        compute::bloom_filter<int>::recommended_bits(1000, 0.01),
+        compute::bloom_filter<int>::recommended_hashes(1000, 9586),
+        queue
+    );
+    BOOST_CHECK_EQUAL(filter.bit_count() % 512, size_t(0));
+    BOOST_CHECK_EQUAL(filter.hash_count(), size_t(7));
+
+    compute::vector<int> keys(2000, context);
+    compute::iota(keys.begin(), keys.end(), 0, queue);
+
+    // nothing is contained in an empty filter
+    compute::vector<int> found(2000, context);
+    filter.contains(keys.begin(), keys.end(), found.begin(), queue);
+    BOOST_CHECK_EQUAL(compute::count(found.begin(), found.end(), 1, queue), size_t(0));
+
+    filter.insert(keys.begin(), keys.begin() + 1000, queue);
+
+    // all inserted keys are contained, few of the others
+    filter.contains(keys.begin(), keys.end(), found.begin(), queue);
+    BOOST_CHECK_EQUAL(
+        compute::count(found.begin(), found.begin() + 1000, 1, queue), size_t(1000)
+    );
+    BOOST_CHECK_LT(compute::count(found.begin() + 1000, found.end(), 1, queue), size_t(50));
+    BOOST_CHECK_LT(filter.false_positive_rate(queue), 0.05);
+
+    filter.clear(queue);
+    BOOST_CHECK_EQUAL(filter.bits().count(queue), size_t(0));
+}
+
+BOOST_AUTO_TEST_CASE(contains_mask)
+{
+    int data[] = { 3, 7, 11, 15, 19, 23, 27, 31 };
+    compute::vector<int> keys(data, data + 8, queue);
+
+    compute::bloom_filter<int> filter(4096, 4, queue);
+    filter.insert(keys.begin(), keys.begin() + 4, queue);
+
+    compute::dynamic_bitset<> mask(0, queue);
+    filter.contains(keys.begin(), keys.end(), mask, queue);
+    BOOST_CHECK_EQUAL(mask.size(), size_t(8));
+    for(size_t i = 0; i < 4; i++){
+        BOOST_CHECK(mask.test(i, queue));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(copy_if_predicate)
+{
+    compute::vector<compute::uint_> build(100, context);
+    compute::iota(build.begin(), build.end(), 1000, queue);
+
+    compute::bloom_filter<compute::uint_> filter(8192, 6, queue);
+    filter.insert(build.begin(), build.end(), queue);
+
+    compute::vector<compute::uint_> probe(2000, context);
+    compute::iota(probe.begin(), probe.end(), 0, queue);
+
+    compute::vector<compute::uint_> candidates(2000, context);
+    compute::vector<compute::uint_>::iterator end = compute::copy_if(
+        probe.begin(), probe.end(), candidates.begin(), filter.predicate(), queue
+    );
+
+    // every key of build passes the filter
+    const size_t count = static_cast<size_t>(end - candidates.begin());
+    BOOST_CHECK_GE(count, size_t(100));
+    BOOST_CHECK_LT(count, size_t(150));
+
+    std::vector<compute::uint_> host(count);
+    compute::copy(candidates.begin(), end, host.begin(), queue);
+
+    size_t matches = 0;
+    for(size_t i = 0; i < count; i++){
+        if(host[i] >= 1000 && host[i] < 1100){
+            matches++;
+        }
+    }
+    BOOST_CHECK_EQUAL(matches, size_t(100));
+}
+
+BOOST_AUTO_TEST_CASE(merge)
+{
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> keys(data, data + 4, queue);
+
+    compute::bloom_filter<int> a(1024, 3, queue);
+    compute::bloom_filter<int> b(1024, 3, queue);
+    a.insert(keys.begin(), keys.begin() + 2, queue);
+    b.insert(keys.begin() + 2, keys.end(), queue);
+
+    a.merge(b, queue);
+
+    compute::vector<int> found(4, context);
+    a.contains(keys.begin(), keys.end(), found.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 4, found, (1, 1, 1, 1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
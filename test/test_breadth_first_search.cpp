@@ -0,0 +1,150 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestBreadthFirstSearch
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/container/dynamic_bitset.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/work_queue.hpp>
+#include <boost/compute/experimental/breadth_first_search.hpp>
+#include <boost/compute/iterator/counting_iterator.hpp>
+#include <boost/compute/linear_algebra/csr_matrix.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+using compute::uint_;
+using compute::experimental::bfs_unreached;
+
+BOOST_AUTO_TEST_CASE(bfs_top_down)
+{
+    // 0 -> 1 -> 3 -> 4, 0 -> 2 -> 3, 5 -> 0 (5 is not reachable)
+    int rows[] = { 0, 0, 1, 2, 3, 5 };
+    int columns[] = { 1, 2, 3, 3, 4, 0 };
+    int values[] = { 1, 1, 1, 1, 1, 1 };
+    compute::csr_matrix<int> graph(6, 6, rows, rows + 6, columns, values, queue);
+
+    compute::vector<uint_> distances(context);
+    size_t levels =
+        compute::experimental::breadth_first_search(graph, 0, distances, queue);
+    BOOST_CHECK_EQUAL(levels, size_t(4));
+    CHECK_RANGE_EQUAL(
+        uint_, 6, distances, (0, 1, 1, 2, 3, bfs_unreached)
+    );
+
+    levels =
+        compute::experimental::breadth_first_search(graph, 4, distances, queue);
+    BOOST_CHECK_EQUAL(levels, size_t(1));
+    CHECK_RANGE_EQUAL(
+        uint_, 6, distances,
+        (bfs_unreached, bfs_unreached, bfs_unreached, bfs_unreached, 0, bfs_unreached)
+    );
+}
+
+BOOST_AUTO_TEST_CASE(bfs_direction_optimizing)
+{
+    // an undirected star of 1000 vertices around vertex 0 with a path of
+    // 100 vertices from vertex 999, so the search goes bottom-up for the
+    // leaves of the star and back to top-down along the path
+    const int star = 1000;
+    const int path = 100;
+    const int n = star + path + 1;
+
+    std::vector<int> rows;
+    std::vector<int> columns;
+    for(int v = 1; v < star; v++){
+        rows.push_back(0); columns.push_back(v);
+        rows.push_back(v); columns.push_back(0);
+    }
+    for(int v = star - 1; v < star + path; v++){
+        rows.push_back(v); columns.push_back(v + 1);
+        rows.push_back(v + 1); columns.push_back(v);
+    }
+    std::vector<int> values(rows.size(), 1);
+
+    compute::csr_matrix<int> graph(
+        n, n, rows.begin(), rows.end(), columns.begin(), values.begin(), queue
+    );
+
+    compute::vector<uint_> top_down(context);
+    size_t levels = compute::experimental::breadth_first_search(
+        graph, 0, top_down, compute::experimental::bfs_top_down, queue
+    );
+    BOOST_CHECK_EQUAL(levels, size_t(path + 3));
+
+    compute::vector<uint_> optimizing(context);
+    levels = compute::experimental::breadth_first_search(
+        graph, 0, optimizing, compute::experimental::bfs_direction_optimizing, queue
+    );
+    BOOST_CHECK_EQUAL(levels, size_t(path + 3));
+
+    std::vector<uint_> expected(n);
+    std::vector<uint_> host(n);
+    expected[0] = 0;
+    for(int v = 1; v < star; v++){
+        expected[v] = 1;
+    }
+    for(int v = star; v < n; v++){
+        expected[v] = static_cast<uint_>(v - star + 2);
+    }
+
+    compute::copy(top_down.begin(), top_down.end(), host.begin(), queue);
+    BOOST_CHECK(host == expected);
+    compute::copy(optimizing.begin(), optimizing.end(), host.begin(), queue);
+    BOOST_CHECK(host == expected);
+}
+
+BOOST_AUTO_TEST_CASE(expand_frontier)
+{
+    // 0 -> 1, 0 -> 2, 1 -> 2, 2 -> 3, 3 -> 0
+    int rows[] = { 0, 0, 1, 2, 3 };
+    int columns[] = { 1, 2, 2, 3, 0 };
+    int values[] = { 1, 1, 1, 1, 1 };
+    compute::csr_matrix<int> graph(4, 4, rows, rows + 5, columns, values, queue);
+
+    compute::dynamic_bitset<uint_> visited(4, queue);
+    visited.set(0, queue);
+    visited.set(1, queue);
+
+    compute::work_queue<uint_> frontier(4, queue);
+    compute::work_queue<uint_> next(4, queue);
+    frontier.push(
+        compute::counting_iterator<uint_>(0),
+        compute::counting_iterator<uint_>(2),
+        queue
+    );
+
+    // 2 is pushed once although both 0 and 1 reach it
+    compute::experimental::expand_frontier(graph, frontier, visited, next, queue);
+    BOOST_CHECK_EQUAL(next.size(queue), size_t(1));
+    CHECK_RANGE_EQUAL(uint_, 1, next, (2));
+    BOOST_CHECK(visited.test(2, queue));
+    BOOST_CHECK(!visited.test(3, queue));
+
+    // 3 is pushed, 0 was visited
+    frontier.swap(next);
+    next.clear(queue);
+    compute::experimental::expand_frontier(graph, frontier, visited, next, queue);
+    BOOST_CHECK_EQUAL(next.size(queue), size_t(1));
+    CHECK_RANGE_EQUAL(uint_, 1, next, (3));
+
+    frontier.swap(next);
+    next.clear(queue);
+    compute::experimental::expand_frontier(graph, frontier, visited, next, queue);
+    BOOST_CHECK(next.empty(queue));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
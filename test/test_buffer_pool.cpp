@@ -0,0 +1,129 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestBufferPool
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/buffer_pool.hpp>
+
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(size_class)
+{
+    BOOST_CHECK_EQUAL(compute::buffer_pool::size_class(0), size_t(256));
+    BOOST_CHECK_EQUAL(compute::buffer_pool::size_class(256), size_t(256));
+    BOOST_CHECK_EQUAL(compute::buffer_pool::size_class(257), size_t(288));
+    BOOST_CHECK_EQUAL(compute::buffer_pool::size_class(1024), size_t(1024));
+    BOOST_CHECK_EQUAL(compute::buffer_pool::size_class(1025), size_t(1152));
+    BOOST_CHECK_EQUAL(compute::buffer_pool::size_class(4000), size_t(4096));
+}
+
+BOOST_AUTO_TEST_CASE(allocate_and_release)
+{
+    compute::buffer_pool pool(context, 1024 * 1024);
+    BOOST_CHECK_EQUAL(pool.cached_count(), size_t(0));
+
+    compute::buffer a = pool.allocate(1000, queue);
+    BOOST_CHECK_EQUAL(a.size(), size_t(1024));
+    BOOST_CHECK_EQUAL(pool.misses(), size_t(1));
+
+    pool.release(a, queue);
+    BOOST_CHECK_EQUAL(pool.cached_count(), size_t(1));
+    BOOST_CHECK_EQUAL(pool.cached_size(), size_t(1024));
+
+    // same size class on the same queue reuses the buffer
+    compute::buffer b = pool.allocate(1020, queue);
+    BOOST_CHECK(b.get() == a.get());
+    BOOST_CHECK_EQUAL(pool.hits(), size_t(1));
+    BOOST_CHECK_EQUAL(pool.cached_count(), size_t(0));
+
+    // different size class creates a new buffer
+    compute::buffer c = pool.allocate(4000, queue);
+    BOOST_CHECK(c.get() != a.get());
+    BOOST_CHECK_EQUAL(pool.misses(), size_t(2));
+
+    pool.release(b, queue);
+    pool.release(c, queue);
+    BOOST_CHECK_EQUAL(pool.cached_size(), size_t(1024 + 4096));
+
+    pool.trim();
+    BOOST_CHECK_EQUAL(pool.cached_count(), size_t(0));
+    BOOST_CHECK_EQUAL(pool.cached_size(), size_t(0));
+}
+
+BOOST_AUTO_TEST_CASE(limit)
+{
+    compute::buffer_pool pool(context, 4096);
+
+    compute::buffer a = pool.allocate(2048);
+    compute::buffer b = pool.allocate(2048);
+    compute::buffer c = pool.allocate(2048);
+    pool.release(a);
+    pool.release(b);
+    pool.release(c);
+
+    // the least recently released buffer was evicted
+    BOOST_CHECK_EQUAL(pool.cached_size(), size_t(4096));
+    BOOST_CHECK_EQUAL(pool.cached_count(), size_t(2));
+
+    // buffers larger than the limit are never cached
+    compute::buffer d = pool.allocate(8192);
+    pool.release(d);
+    BOOST_CHECK_EQUAL(pool.cached_size(), size_t(4096));
+
+    pool.set_limit(2048);
+    BOOST_CHECK_EQUAL(pool.limit(), size_t(2048));
+    BOOST_CHECK_EQUAL(pool.cached_count(), size_t(1));
+}
+
+BOOST_AUTO_TEST_CASE(reuse_across_queues)
+{
+    compute::buffer_pool pool(context, 1024 * 1024);
+    compute::command_queue other_queue(context, device);
+
+    compute::buffer a = pool.allocate(1024, queue);
+    pool.release(a, queue);
+    queue.finish();
+
+    // the buffer can be used by another queue once the
+    // commands on the releasing queue have completed
+    compute::buffer b;
+    for(int i = 0; i < 100 && b.get() != a.get(); i++){
+        b = pool.allocate(1024, other_queue);
+        if(b.get() != a.get()){
+            pool.release(b, other_queue);
+        }
+    }
+    BOOST_CHECK(b.get() == a.get());
+}
+
+BOOST_AUTO_TEST_CASE(sort_uses_global_pool)
+{
+    boost::shared_ptr<compute::buffer_pool> pool =
+        compute::buffer_pool::get_global_pool(context);
+    pool->trim();
+
+    int data[] = { 5, 2, 7, 1, 9, 3, 8, 4, 6, 0 };
+    compute::vector<int> vector(data, data + 10, queue);
+
+    compute::sort(vector.begin(), vector.end(), queue);
+    size_t misses = pool->misses();
+    BOOST_CHECK(pool->cached_count() > 0);
+
+    // sorting again reuses the temporary buffers
+    compute::sort(vector.begin(), vector.end(), queue);
+    BOOST_CHECK_EQUAL(pool->misses(), misses);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,86 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestBuildLog
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+#include <boost/compute/utility/build_log.hpp>
+#include <boost/compute/utility/embedded_programs.hpp>
+#include <boost/compute/utility/program_cache.hpp>
+
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(record_builds)
+{
+    const char source1[] =
+        "__kernel void logged(__global int *a) { a[get_global_id(0)] = 1; }\n";
+    const char source2[] =
+        "__kernel void logged(__global int *a) { a[get_global_id(0)] = 2; }\n";
+
+    compute::program_build_log &log =
+        compute::program_build_log::get_global_log();
+    const bool enabled = log.enabled();
+    log.set_enabled(true);
+    log.clear();
+
+    compute::program_cache cache(4);
+    cache.get_or_build("logged", "-DLOGGED", source1, context);
+
+    // cache hits are not builds
+    cache.get_or_build("logged", "-DLOGGED", source1, context);
+
+    // a new cache rebuilds the same source
+    compute::program_cache other_cache(4);
+    other_cache.get_or_build("logged", "-DLOGGED", source1, context);
+
+    // the same key with another source
+    other_cache.clear();
+    other_cache.get_or_build("logged", "-DLOGGED", source2, context);
+
+    const std::vector<compute::program_build_record> records = log.records();
+    log.set_enabled(enabled);
+
+    BOOST_REQUIRE_EQUAL(records.size(), size_t(3));
+
+    BOOST_CHECK_EQUAL(records[0].key, std::string("logged"));
+    BOOST_CHECK_EQUAL(records[0].options, std::string("-DLOGGED"));
+    BOOST_CHECK_EQUAL(records[0].source_hash,
+                      compute::embedded_program_hash(source1, "-DLOGGED"));
+    BOOST_CHECK_EQUAL(records[0].device, device.name());
+    BOOST_CHECK_EQUAL(records[0].source_builds, size_t(1));
+    BOOST_CHECK(!records[0].source_changed);
+
+    BOOST_CHECK_EQUAL(records[1].source_builds, size_t(2));
+    BOOST_CHECK(!records[1].source_changed);
+
+    BOOST_CHECK_EQUAL(records[2].source_hash,
+                      compute::embedded_program_hash(source2, "-DLOGGED"));
+    BOOST_CHECK_EQUAL(records[2].source_builds, size_t(1));
+    BOOST_CHECK(records[2].source_changed);
+}
+
+BOOST_AUTO_TEST_CASE(disabled_log)
+{
+    compute::program_build_log log;
+    BOOST_CHECK(!log.enabled());
+
+    compute::program p = compute::program::create_with_source(
+        "__kernel void foo(int x) { }", context
+    );
+    log.record("foo", "", "__kernel void foo(int x) { }", p, 0, false);
+    BOOST_CHECK(log.records().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
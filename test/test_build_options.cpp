@@ -0,0 +1,99 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestBuildOptions
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/math.hpp>
+#include <boost/compute/utility/build_options.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(combine)
+{
+    compute::build_options options =
+        compute::build_options::mad_enable() |
+        compute::build_options::no_signed_zeros();
+    BOOST_CHECK_EQUAL(options.str(), "-cl-mad-enable -cl-no-signed-zeros");
+
+    BOOST_CHECK(compute::build_options().empty());
+    BOOST_CHECK(
+        (compute::build_options() | compute::build_options::mad_enable()) ==
+        compute::build_options::mad_enable()
+    );
+}
+
+BOOST_AUTO_TEST_CASE(scoped)
+{
+    const compute::build_options initial = compute::build_options::current();
+
+    {
+        compute::scoped_build_options outer(compute::build_options::mad_enable());
+        BOOST_CHECK(
+            compute::build_options::current() ==
+            (initial | compute::build_options::mad_enable())
+        );
+
+        {
+            compute::scoped_build_options inner(
+                compute::build_options::no_signed_zeros()
+            );
+            BOOST_CHECK(
+                compute::build_options::current() ==
+                (initial |
+                 compute::build_options::mad_enable() |
+                 compute::build_options::no_signed_zeros())
+            );
+        }
+
+        BOOST_CHECK(
+            compute::build_options::current() ==
+            (initial | compute::build_options::mad_enable())
+        );
+    }
+
+    BOOST_CHECK(compute::build_options::current() == initial);
+}
+
+BOOST_AUTO_TEST_CASE(transform_with_fast_math)
+{
+    float data[] = { 1.0f, 4.0f, 9.0f, 16.0f };
+    compute::vector<float> input(data, data + 4, queue);
+    compute::vector<float> output(4, context);
+
+    // the kernel is built (and cached) with and without the options
+    for(int i = 0; i < 2; i++){
+        compute::scoped_build_options options(
+            compute::build_options::fast_relaxed_math()
+        );
+
+        compute::transform(
+            input.begin(), input.end(), output.begin(), compute::sqrt<float>(), queue
+        );
+
+        float result[4];
+        compute::copy(output.begin(), output.end(), result, queue);
+        BOOST_CHECK_CLOSE(result[0], 1.0f, 1e-3f);
+        BOOST_CHECK_CLOSE(result[3], 4.0f, 1e-3f);
+    }
+
+    compute::transform(
+        input.begin(), input.end(), output.begin(), compute::sqrt<float>(), queue
+    );
+    CHECK_RANGE_EQUAL(float, 4, output, (1.0f, 2.0f, 3.0f, 4.0f));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,179 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestCheckpoint
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/equal.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/experimental/checkpoint.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+#ifdef CL_VERSION_1_1
+static size_t file_size(const char *path)
+{
+    std::ifstream stream(path, std::ios::in | std::ios::binary);
+    stream.seekg(0, std::ios::end);
+    return static_cast<size_t>(stream.tellg());
+}
+
+BOOST_AUTO_TEST_CASE(save_restore_float)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    const char *path = "test_checkpoint_float.bin";
+
+    // several chunks of 4 KB and a partial one
+    compute::vector<float> state(5000, context);
+    compute::iota(state.begin(), state.end(), 0.5f, queue);
+
+    {
+        compute::experimental::checkpoint_writer writer(queue, 4096, 2);
+        compute::future<void> saved =
+            writer.save(state.begin(), state.end(), path);
+
+        // the snapshot is taken before the values change
+        compute::fill(state.begin(), state.end(), 0.0f, queue);
+        saved.wait();
+
+        BOOST_CHECK_EQUAL(compute::experimental::checkpoint_size(path), size_t(5000));
+
+        compute::vector<float> restored(5000, context);
+        writer.restore(path, restored.begin());
+        CHECK_RANGE_EQUAL(float, 4, restored, (0.5f, 1.5f, 2.5f, 3.5f));
+
+        compute::vector<float> expected(5000, context);
+        compute::iota(expected.begin(), expected.end(), 0.5f, queue);
+        BOOST_CHECK(
+            compute::equal(restored.begin(), restored.end(), expected.begin(), queue)
+        );
+    }
+
+    std::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(save_restore_compressed)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    const char *path = "test_checkpoint_compressed.bin";
+
+    compute::vector<int> state(10000, context);
+    compute::iota(state.begin(), state.end(), -100, queue);
+
+    {
+        compute::experimental::checkpoint_writer writer(queue, 4096, 3);
+        writer.save(
+            state.begin(), state.end(), path,
+            compute::experimental::checkpoint_compress
+        ).wait();
+
+        // consecutive values are stored in a few bits each
+        BOOST_CHECK_LT(file_size(path), size_t(10000 * sizeof(int) / 8));
+
+        compute::vector<int> restored(10000, context);
+        writer.restore(path, restored.begin()).wait();
+        BOOST_CHECK(
+            compute::equal(restored.begin(), restored.end(), state.begin(), queue)
+        );
+    }
+
+    std::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(save_without_snapshot)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    const char *path = "test_checkpoint_no_snapshot.bin";
+
+    int data[] = { 4, 8, 15, 16, 23, 42 };
+    compute::vector<int> state(data, data + 6, queue);
+
+    {
+        compute::experimental::checkpoint_writer writer(queue);
+        writer.save(
+            state.begin() + 1, state.end(), path,
+            compute::experimental::checkpoint_no_snapshot
+        );
+        writer.wait();
+        BOOST_CHECK_EQUAL(compute::experimental::checkpoint_size(path), size_t(5));
+
+        compute::vector<int> restored(5, context);
+        writer.restore(path, restored.begin());
+        CHECK_RANGE_EQUAL(int, 5, restored, (8, 15, 16, 23, 42));
+    }
+
+    std::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(save_empty_range)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    const char *path = "test_checkpoint_empty.bin";
+
+    compute::vector<int> state(context);
+    compute::experimental::checkpoint_writer writer(queue);
+    writer.save(state.begin(), state.end(), path).wait();
+    BOOST_CHECK_EQUAL(compute::experimental::checkpoint_size(path), size_t(0));
+
+    std::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(restore_invalid_file)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    const char *path = "test_checkpoint_invalid.bin";
+    {
+        std::ofstream stream(path, std::ios::out | std::ios::binary);
+        stream << "not a checkpoint of device values";
+    }
+
+    compute::experimental::checkpoint_writer writer(queue);
+    compute::vector<int> restored(8, context);
+    BOOST_CHECK_THROW(writer.restore(path, restored.begin()), std::runtime_error);
+
+    // deltas wider than 32 bits
+    {
+        const compute::experimental::detail::checkpoint_header header =
+            compute::experimental::detail::make_checkpoint_header(
+                sizeof(int), 8, compute::experimental::detail::checkpoint_delta_packed, 40
+            );
+        std::vector<char> words(64);
+
+        std::ofstream stream(path, std::ios::out | std::ios::binary);
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        stream.write(&words[0], static_cast<std::streamsize>(words.size()));
+    }
+    BOOST_CHECK_THROW(writer.restore(path, restored.begin()), std::runtime_error);
+    BOOST_CHECK_THROW(
+        writer.restore("test_checkpoint_missing.bin", restored.begin()),
+        std::runtime_error
+    );
+
+    std::remove(path);
+}
+#endif // CL_VERSION_1_1
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,107 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestChromeTrace
+#include <boost/test/unit_test.hpp>
+
+#define BOOST_COMPUTE_ENABLE_TRACING
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/chrome_trace.hpp>
+
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+    compute::chrome_trace trace;
+    BOOST_CHECK_EQUAL(trace.size(), size_t(0));
+
+    std::stringstream stream;
+    trace.write(stream);
+    BOOST_CHECK_EQUAL(
+        stream.str(),
+        "{\"traceEvents\":[],\"displayTimeUnit\":\"ns\",\"otherData\":"
+        "{\"program_cache_hits\":0,\"program_cache_misses\":0}}\n"
+    );
+}
+
+BOOST_AUTO_TEST_CASE(sort_on_two_queues)
+{
+    compute::command_queue queue1(
+        context, device, compute::command_queue::enable_profiling
+    );
+    compute::command_queue queue2(
+        context, device, compute::command_queue::enable_profiling
+    );
+
+    std::vector<int> data(1024);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>(data.size() - i);
+    }
+    compute::vector<int> vector(data.size(), context);
+
+    compute::chrome_trace trace;
+    compute::set_trace_listener(&trace);
+
+    compute::copy(data.begin(), data.end(), vector.begin(), queue1);
+    compute::sort(vector.begin(), vector.end(), queue2);
+    queue2.finish();
+
+    compute::set_trace_listener(0);
+
+    BOOST_CHECK(trace.size() > 1);
+
+    std::stringstream stream;
+    trace.write(stream);
+    const std::string json = stream.str();
+
+    // one process with a host and a device track for each queue
+    BOOST_CHECK(json.find("\"name\":\"command_queue 0") != std::string::npos);
+    BOOST_CHECK(json.find("\"name\":\"command_queue 1") != std::string::npos);
+    BOOST_CHECK(json.find("\"pid\":2,\"tid\":1") != std::string::npos);
+    BOOST_CHECK(json.find("\"pid\":2,\"tid\":2") != std::string::npos);
+
+    // commands are labeled with their algorithm
+    BOOST_CHECK(json.find("\"name\":\"write_buffer\",\"cat\":\"copy\"") != std::string::npos);
+    BOOST_CHECK(json.find("\"cat\":\"sort\"") != std::string::npos);
+
+    trace.clear();
+    BOOST_CHECK_EQUAL(trace.size(), size_t(0));
+}
+
+BOOST_AUTO_TEST_CASE(ignore_queues_without_profiling)
+{
+    compute::command_queue queue1(context, device);
+
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> vector(4, context);
+
+    compute::chrome_trace trace;
+    compute::set_trace_listener(&trace);
+    compute::copy(data, data + 4, vector.begin(), queue1);
+    compute::set_trace_listener(0);
+
+    BOOST_CHECK_EQUAL(trace.size(), size_t(1));
+
+    std::stringstream stream;
+    trace.write(stream);
+    BOOST_CHECK(stream.str().find("write_buffer") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
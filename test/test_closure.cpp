@@ -20,6 +20,7 @@
 #include <boost/compute/container/array.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/iterator/counting_iterator.hpp>
+#include <boost/compute/detail/program_source_cache.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -95,6 +96,66 @@ BOOST_AUTO_TEST_CASE(add_y)
     CHECK_RANGE_EQUAL(int, 4, output, (5, 6, 7, 8));
 }
 
+BOOST_AUTO_TEST_CASE(capture_values_as_arguments)
+{
+    compute::detail::program_source_cache &cache =
+        compute::detail::program_source_cache::get_global_cache();
+
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> input(data, data + 4, queue);
+    compute::vector<int> output(4, context);
+
+    int threshold = 2;
+    bool negate = false;
+    BOOST_COMPUTE_CLOSURE(int, clamp_below, (int x), (threshold, negate),
+    {
+        const int y = x < threshold ? threshold : x;
+        return negate ? -y : y;
+    });
+
+    compute::transform(
+        input.begin(), input.end(), output.begin(), clamp_below, queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, output, (2, 2, 3, 4));
+    const size_t programs = cache.size();
+
+    // the captured values are kernel arguments so the program is reused
+    threshold = 3;
+    negate = true;
+    compute::transform(
+        input.begin(), input.end(), output.begin(), clamp_below, queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, output, (-3, -3, -3, -4));
+    BOOST_CHECK_EQUAL(cache.size(), programs);
+}
+
+BOOST_AUTO_TEST_CASE(capture_vector_type)
+{
+    using compute::float4_;
+
+    float4_ weights(1.0f, 2.0f, 3.0f, 4.0f);
+    BOOST_COMPUTE_CLOSURE(float, weighted_sum, (const float4_ x), (weights),
+    {
+        return dot(x, weights);
+    });
+
+    compute::vector<float4_> input(context);
+    input.push_back(float4_(1.0f, 1.0f, 1.0f, 1.0f), queue);
+    input.push_back(float4_(1.0f, 0.0f, 1.0f, 0.0f), queue);
+    compute::vector<float> output(2, context);
+
+    compute::transform(
+        input.begin(), input.end(), output.begin(), weighted_sum, queue
+    );
+    CHECK_RANGE_EQUAL(float, 2, output, (10.0f, 4.0f));
+
+    weights = float4_(0.5f, 0.5f, 0.5f, 0.5f);
+    compute::transform(
+        input.begin(), input.end(), output.begin(), weighted_sum, queue
+    );
+    CHECK_RANGE_EQUAL(float, 2, output, (2.0f, 1.0f));
+}
+
 BOOST_AUTO_TEST_CASE(scale_add_vec)
 {
     const int N = 10;
@@ -17,6 +17,7 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/program.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/fill.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/utility/dim.hpp>
@@ -157,6 +158,45 @@ BOOST_AUTO_TEST_CASE(construct_from_cl_command_queue)
     clReleaseCommandQueue(cl_queue);
 }
 
+BOOST_AUTO_TEST_CASE(cached_device_and_context)
+{
+    boost::compute::command_queue copy = queue;
+
+    BOOST_CHECK(copy.get_device() == queue.get_device());
+    BOOST_CHECK(copy.get_context() == queue.get_context());
+
+    // the cached handles match the ones of the queue
+    BOOST_CHECK(copy.get_device().id() ==
+                copy.get_info<cl_device_id>(CL_QUEUE_DEVICE));
+    BOOST_CHECK(copy.get_context().get() ==
+                copy.get_info<cl_context>(CL_QUEUE_CONTEXT));
+
+    copy = boost::compute::command_queue(context, device);
+    BOOST_CHECK(copy.get_device() == device);
+    BOOST_CHECK(copy.get_context() == context);
+}
+
+BOOST_AUTO_TEST_CASE(priority_and_throttle_hints)
+{
+    // unsupported hints are ignored
+    boost::compute::command_queue high(
+        context, device, 0, boost::compute::command_queue::priority_high
+    );
+    boost::compute::command_queue low(
+        context, device, 0,
+        boost::compute::command_queue::priority_low,
+        boost::compute::command_queue::throttle_low
+    );
+    BOOST_CHECK(high.get_device() == device);
+    BOOST_CHECK(low.get_context() == context);
+    BOOST_CHECK(high != low);
+
+    boost::compute::vector<int> vector(4, context);
+    boost::compute::fill(vector.begin(), vector.end(), 3, high);
+    high.finish();
+    CHECK_RANGE_EQUAL(int, 4, vector, (3, 3, 3, 3));
+}
+
 #ifdef CL_VERSION_1_1
 BOOST_AUTO_TEST_CASE(write_buffer_rect)
 {
@@ -279,4 +319,34 @@ BOOST_AUTO_TEST_CASE(enqueue_kernel_with_extents)
     CHECK_RANGE_EQUAL(int, 4, output2, (0, 1, 0, 1));
 }
 
+BOOST_AUTO_TEST_CASE(transfer_counters)
+{
+    compute::command_queue queue(
+        context, device, compute::command_queue::enable_profiling
+    );
+    queue.enable_transfer_counters(true);
+
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> a(4, context);
+    compute::vector<int> b(4, context);
+    compute::copy(data, data + 4, a.begin(), queue);
+    compute::copy(a.begin(), a.end(), b.begin(), queue);
+    compute::copy(b.begin(), b.end(), data, queue);
+    queue.finish();
+
+    compute::transfer_counters counters = queue.get_transfer_counters();
+    BOOST_CHECK_EQUAL(counters.host_to_device_bytes, compute::ulong_(4 * sizeof(int)));
+    BOOST_CHECK_EQUAL(counters.host_to_device_commands, compute::ulong_(1));
+    BOOST_CHECK_EQUAL(counters.device_to_device_bytes, compute::ulong_(4 * sizeof(int)));
+    BOOST_CHECK_EQUAL(counters.device_to_host_bytes, compute::ulong_(4 * sizeof(int)));
+    BOOST_CHECK_EQUAL(counters.device_to_host_commands, compute::ulong_(1));
+
+    queue.reset_transfer_counters();
+    BOOST_CHECK_EQUAL(queue.get_transfer_counters().host_to_device_commands, compute::ulong_(0));
+
+    queue.disable_transfer_counters();
+    compute::copy(data, data + 4, a.begin(), queue);
+    BOOST_CHECK_EQUAL(queue.get_transfer_counters().host_to_device_commands, compute::ulong_(0));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
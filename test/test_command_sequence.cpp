@@ -0,0 +1,118 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestCommandSequence
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/program.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/command_sequence.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(empty_sequence)
+{
+    BOOST_CHECK(!queue.is_recording());
+    queue.begin_recording();
+    BOOST_CHECK(queue.is_recording());
+
+    // a queue records one sequence at a time
+    BOOST_CHECK_THROW(queue.begin_recording(), compute::opencl_error);
+
+    compute::command_sequence sequence = queue.end_recording();
+    BOOST_CHECK(!queue.is_recording());
+    BOOST_CHECK(sequence.empty());
+    BOOST_CHECK(sequence.replay(queue).get() == 0);
+
+    BOOST_CHECK_THROW(queue.end_recording(), compute::opencl_error);
+}
+
+BOOST_AUTO_TEST_CASE(replay_algorithms)
+{
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> input(data, data + 4, queue);
+    compute::vector<int> sum(4, context);
+    compute::vector<int> output(4, context);
+
+    queue.begin_recording();
+    compute::transform(
+        input.begin(), input.end(), input.begin(), sum.begin(),
+        compute::plus<int>(), queue
+    );
+    compute::copy(sum.begin(), sum.end(), output.begin(), queue);
+    compute::command_sequence sequence = queue.end_recording();
+    BOOST_CHECK(sequence.size() >= 2);
+    CHECK_RANGE_EQUAL(int, 4, output, (2, 4, 6, 8));
+
+    // replays read the current contents of the buffers
+    int new_data[] = { 5, 6, 7, 8 };
+    compute::copy(new_data, new_data + 4, input.begin(), queue);
+    sequence.replay(queue).wait();
+    CHECK_RANGE_EQUAL(int, 4, output, (10, 12, 14, 16));
+}
+
+BOOST_AUTO_TEST_CASE(replay_blocking_write)
+{
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> vector(4, context);
+
+    queue.begin_recording();
+    compute::copy(data, data + 4, vector.begin(), queue);
+    compute::command_sequence sequence = queue.end_recording();
+
+    // the data of blocking writes is copied when they are recorded
+    data[0] = 9;
+    compute::copy(data, data + 4, vector.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 4, vector, (9, 2, 3, 4));
+
+    sequence.replay(queue).wait();
+    CHECK_RANGE_EQUAL(int, 4, vector, (1, 2, 3, 4));
+}
+
+BOOST_AUTO_TEST_CASE(replay_kernel_arguments)
+{
+    const char source[] =
+        "__kernel void set_value(__global int *output, const int value)\n"
+        "{\n"
+        "    output[get_global_id(0)] = value;\n"
+        "}\n";
+
+    compute::program program =
+        compute::program::create_with_source(source, context);
+    program.build();
+
+    compute::kernel kernel(program, "set_value");
+    compute::vector<int> vector(4, context);
+    kernel.set_arg(0, vector);
+    kernel.set_arg(1, 3);
+
+    queue.begin_recording();
+    queue.enqueue_1d_range_kernel(kernel, 0, 4, 0);
+    compute::command_sequence sequence = queue.end_recording();
+    BOOST_CHECK_EQUAL(sequence.size(), size_t(1));
+
+    // arguments set after recording do not change the sequence
+    kernel.set_arg(1, 5);
+    queue.enqueue_1d_range_kernel(kernel, 0, 4, 0);
+    CHECK_RANGE_EQUAL(int, 4, vector, (5, 5, 5, 5));
+
+    sequence.replay(queue).wait();
+    CHECK_RANGE_EQUAL(int, 4, vector, (3, 3, 3, 3));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
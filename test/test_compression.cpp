@@ -0,0 +1,157 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestCompression
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/experimental/compression.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(delta_encode_decode_int)
+{
+    int data[] = { 5, 7, 8, 8, 3, 10, -2, 0 };
+    bc::vector<int> input(data, data + 8, queue);
+
+    bc::vector<bc::uint_> deltas(8, context);
+    bc::experimental::delta_encode(input.begin(), input.end(), deltas.begin(), queue);
+    CHECK_RANGE_EQUAL(
+        bc::uint_, 8, deltas,
+        (10, 4, 2, 0, 9, 14, 23, 4)
+    );
+
+    bc::vector<int> output(8, context);
+    bc::experimental::delta_decode(deltas.begin(), deltas.end(), output.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 8, output, (5, 7, 8, 8, 3, 10, -2, 0));
+}
+
+BOOST_AUTO_TEST_CASE(bit_pack_unpack)
+{
+    bc::vector<bc::uint_> input(1000, context);
+    bc::iota(input.begin(), input.end(), 0, queue);
+
+    const size_t bits = bc::experimental::bit_width(input.begin(), input.end(), queue);
+    BOOST_CHECK_EQUAL(bits, size_t(10));
+
+    const size_t words = bc::experimental::packed_size(input.size(), bits);
+    BOOST_CHECK_EQUAL(words, size_t(313));
+
+    bc::vector<bc::uint_> packed(words, context);
+    bc::vector<bc::uint_>::iterator packed_end = bc::experimental::bit_pack(
+        input.begin(), input.end(), bits, packed.begin(), queue
+    );
+    BOOST_CHECK(packed_end == packed.end());
+
+    bc::vector<bc::uint_> output(1000, context);
+    bc::experimental::bit_unpack(packed.begin(), 1000, bits, output.begin(), queue);
+
+    std::vector<bc::uint_> host_output(1000);
+    bc::copy(output.begin(), output.end(), host_output.begin(), queue);
+    for(size_t i = 0; i < host_output.size(); i++){
+        BOOST_CHECK_EQUAL(host_output[i], bc::uint_(i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(bit_pack_full_width)
+{
+    bc::uint_ data[] = { 0xffffffff, 0, 0x80000001, 42 };
+    bc::vector<bc::uint_> input(data, data + 4, queue);
+
+    bc::vector<bc::uint_> packed(4, context);
+    bc::experimental::bit_pack(input.begin(), input.end(), 32, packed.begin(), queue);
+
+    bc::vector<bc::uint_> output(4, context);
+    bc::experimental::bit_unpack(packed.begin(), 4, 32, output.begin(), queue);
+    CHECK_RANGE_EQUAL(bc::uint_, 4, output, (0xffffffff, 0, 0x80000001, 42));
+}
+
+BOOST_AUTO_TEST_CASE(run_length_encode_decode)
+{
+    int data[] = { 1, 1, 1, 4, 4, 2, 7, 7, 7, 7 };
+    bc::vector<int> input(data, data + 10, queue);
+
+    bc::vector<int> values(10, context);
+    bc::vector<bc::uint_> lengths(10, context);
+    size_t runs = bc::experimental::run_length_encode(
+        input.begin(), input.end(), values.begin(), lengths.begin(), queue
+    );
+    BOOST_CHECK_EQUAL(runs, size_t(4));
+    CHECK_RANGE_EQUAL(int, 4, values, (1, 4, 2, 7));
+    CHECK_RANGE_EQUAL(bc::uint_, 4, lengths, (3, 2, 1, 4));
+
+    bc::vector<int> output(10, context);
+    bc::vector<int>::iterator end = bc::experimental::run_length_decode(
+        values.begin(), values.begin() + runs, lengths.begin(), output.begin(), queue
+    );
+    BOOST_CHECK(end == output.end());
+    CHECK_RANGE_EQUAL(int, 10, output, (1, 1, 1, 4, 4, 2, 7, 7, 7, 7));
+}
+
+BOOST_AUTO_TEST_CASE(dictionary_decode)
+{
+    float dictionary_data[] = { 0.5f, 1.5f, 2.5f };
+    bc::vector<float> dictionary(dictionary_data, dictionary_data + 3, queue);
+
+    bc::uint_ index_data[] = { 2, 0, 0, 1, 2 };
+    bc::vector<bc::uint_> indices(index_data, index_data + 5, queue);
+
+    bc::vector<float> output(5, context);
+    bc::experimental::dictionary_decode(
+        indices.begin(), indices.end(), dictionary.begin(), output.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(float, 5, output, (2.5f, 0.5f, 0.5f, 1.5f, 2.5f));
+}
+
+BOOST_AUTO_TEST_CASE(copy_delta_packed)
+{
+    std::vector<int> host(5000);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = static_cast<int>(1000000 + 3 * i - (i % 7));
+    }
+
+    bc::vector<int> vector(host.size(), context);
+    bc::experimental::copy_delta_packed(host.begin(), host.end(), vector.begin(), queue);
+
+    std::vector<int> result(host.size());
+    bc::copy(vector.begin(), vector.end(), result.begin(), queue);
+    BOOST_CHECK(result == host);
+}
+
+BOOST_AUTO_TEST_CASE(copy_run_length)
+{
+    int data[] = { 9, 9, 9, 9, 3, 3, 5 };
+
+    bc::vector<int> vector(7, context);
+    bc::experimental::copy_run_length(data, data + 7, vector.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 7, vector, (9, 9, 9, 9, 3, 3, 5));
+}
+
+BOOST_AUTO_TEST_CASE(copy_dictionary_encoded)
+{
+    int dictionary[] = { 100, 200 };
+    bc::uchar_ indices[] = { 1, 1, 0, 1, 0 };
+
+    bc::vector<int> vector(5, context);
+    bc::experimental::copy_dictionary_encoded(
+        indices, indices + 5, dictionary, dictionary + 2, vector.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 5, vector, (200, 200, 100, 200, 100));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,80 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestConstantTable
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+
+#include <boost/compute/closure.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/constant_table.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(closure_capture)
+{
+    // y = 1 + 2x + 3x^2
+    int coefficients[] = { 1, 2, 3 };
+    compute::constant_table<int> table(coefficients, coefficients + 3, context);
+    BOOST_CHECK_EQUAL(table.size(), size_t(3));
+    BOOST_CHECK(!table.empty());
+
+    const compute::uint_ n = static_cast<compute::uint_>(table.size());
+
+    BOOST_COMPUTE_CLOSURE(int, polynomial, (int x), (table, n),
+    {
+        int y = 0;
+        for(uint i = n; i > 0; i--){
+            y = y * x + table[i - 1];
+        }
+        return y;
+    });
+
+    compute::vector<int> vector(4, context);
+    compute::iota(vector.begin(), vector.end(), 0, queue);
+    compute::transform(
+        vector.begin(), vector.end(), vector.begin(), polynomial, queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, vector, (1, 6, 17, 34));
+}
+
+BOOST_AUTO_TEST_CASE(buffer_view)
+{
+    // tables can be views of values computed on the device
+    compute::vector<int> values(8, context);
+    compute::iota(values.begin(), values.end(), 10, queue);
+
+    compute::constant_table<int> table(values.get_buffer(), values.size());
+
+    compute::vector<int> result(8, context);
+    compute::copy(table.begin(), table.end(), result.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 8, result, (10, 11, 12, 13, 14, 15, 16, 17));
+}
+
+BOOST_AUTO_TEST_CASE(too_large)
+{
+    const compute::ulong_ limit =
+        device.get_info<compute::ulong_>(CL_DEVICE_MAX_CONSTANT_BUFFER_SIZE);
+
+    compute::buffer buffer(context, static_cast<size_t>(limit) + 4);
+    BOOST_CHECK_THROW(
+        compute::constant_table<char>(buffer, static_cast<size_t>(limit) + 1),
+        std::length_error
+    );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
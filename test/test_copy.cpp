@@ -24,10 +24,12 @@
 #include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/copy_n.hpp>
 #include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
 #include <boost/compute/algorithm/iota.hpp>
 #include <boost/compute/async/future.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/iterator/detail/swizzle_iterator.hpp>
+#include <boost/compute/iterator/transform_iterator.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -306,4 +308,186 @@ BOOST_AUTO_TEST_CASE(copy_to_vector_bool)
     BOOST_CHECK(host_vec[1] == false);
 }
 
+BOOST_AUTO_TEST_CASE(copy_vector_bool_as_bits)
+{
+    // large enough to be packed to bits on the device
+    const size_t size = 10000;
+
+    std::vector<bool> mask(size);
+    for(size_t i = 0; i < size; i++){
+        mask[i] = (i % 3 == 0) || (i % 7 == 0);
+    }
+
+    compute::vector<int> vec(size, context);
+    compute::copy(mask.begin(), mask.end(), vec.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 8, vec, (1, 0, 0, 1, 0, 0, 1, 1));
+
+    std::vector<bool> host_mask(size);
+    compute::copy(vec.begin(), vec.end(), host_mask.begin(), queue);
+    BOOST_CHECK(host_mask == mask);
+}
+
+BOOST_AUTO_TEST_CASE(copy_int_to_float_unaligned)
+{
+    // copies values which do not fill a whole number of vectors from and
+    // to unaligned offsets
+    const size_t size = 1029;
+
+    std::vector<int> host_input(size);
+    for(size_t i = 0; i < size; i++){
+        host_input[i] = static_cast<int>(i);
+    }
+    compute::vector<int> input(host_input.begin(), host_input.end(), queue);
+    compute::vector<float> output(size + 2, context);
+    compute::fill(output.begin(), output.end(), -1.0f, queue);
+
+    compute::copy(input.begin() + 3, input.end(), output.begin() + 1, queue);
+
+    std::vector<float> host_output(size + 2);
+    compute::copy(output.begin(), output.end(), host_output.begin(), queue);
+
+    BOOST_CHECK_EQUAL(host_output[0], -1.0f);
+    for(size_t i = 0; i < size - 3; i++){
+        BOOST_CHECK_EQUAL(host_output[i + 1], static_cast<float>(i + 3));
+    }
+    BOOST_CHECK_EQUAL(host_output[size - 2], -1.0f);
+}
+
+BOOST_AUTO_TEST_CASE(copy_staged)
+{
+    // large enough to be split into several chunks of the staging ring
+    const size_t size = 3 * (1 << 20) + 17;
+
+    std::vector<int> host_input(size);
+    for(size_t i = 0; i < size; i++){
+        host_input[i] = static_cast<int>(i);
+    }
+
+    compute::vector<int> vector(size + 1, context);
+    compute::fill_n(vector.begin(), 1, -1, queue);
+    compute::copy(host_input.begin(), host_input.end(), vector.begin() + 1, queue);
+
+    std::vector<int> host_output(size);
+    compute::copy(vector.begin() + 1, vector.end(), host_output.begin(), queue);
+    BOOST_CHECK(host_output == host_input);
+
+    // non-contiguous ranges are staged regardless of their size
+    std::list<int> host_list(host_input.begin(), host_input.begin() + 1000);
+    compute::copy(host_list.begin(), host_list.end(), vector.begin(), queue);
+    std::list<int> host_list_output(1000);
+    compute::copy(
+        vector.begin(), vector.begin() + 1000, host_list_output.begin(), queue
+    );
+    BOOST_CHECK(host_list_output == host_list);
+
+    // the rings are torn down explicitly and recreated on the next copy
+    compute::detail::staging_ring::release_global_rings();
+    compute::copy(host_list.begin(), host_list.end(), vector.begin() + 1, queue);
+    CHECK_RANGE_EQUAL(int, 3, vector, (0, 0, 1));
+}
+
+BOOST_AUTO_TEST_CASE(copy_between_contexts)
+{
+    // a second context for the same device
+    compute::context other_context(device);
+    compute::command_queue other_queue(other_context, device);
+
+    // large enough to be split into several chunks of the staging ring
+    const size_t size = (1 << 20) + 17;
+
+    std::vector<int> host_input(size);
+    for(size_t i = 0; i < size; i++){
+        host_input[i] = static_cast<int>(i);
+    }
+
+    compute::vector<int> input(host_input.begin(), host_input.end(), queue);
+    compute::vector<int> output(size + 1, other_context);
+
+    compute::vector<int>::iterator end = compute::copy(
+        input.begin(), input.end(), output.begin() + 1, queue
+    );
+    BOOST_CHECK(end == output.end());
+
+    std::vector<int> host_output(size);
+    compute::copy(output.begin() + 1, output.end(), host_output.begin(), other_queue);
+    BOOST_CHECK(host_output == host_input);
+
+    // and back with the queue of the destination context
+    compute::copy(output.begin() + 1, output.begin() + 5, input.begin(), other_queue);
+    compute::future<compute::vector<int>::iterator> future = compute::copy_async(
+        output.begin() + 1, output.begin() + 5, input.begin() + 4, queue
+    );
+    future.wait();
+    CHECK_RANGE_EQUAL(int, 8, input, (0, 1, 2, 3, 0, 1, 2, 3));
+}
+
+// the copy kernel used on cpu devices (each work-item copying a chunk of
+// the range), run directly so that it is tested on every device
+BOOST_AUTO_TEST_CASE(copy_chunked)
+{
+    typedef compute::buffer_iterator<int> iterator;
+    typedef compute::transform_iterator<iterator, compute::abs<int> > transform;
+
+    const size_t size = 40009;
+    compute::vector<int> input(size, context);
+    compute::vector<int> output(size, context);
+    compute::iota(input.begin(), input.end(), -int(size - 1), queue);
+
+    compute::detail::copy_kernel<transform, iterator> kernel(device, true);
+    kernel.set_range(
+        compute::make_transform_iterator(input.begin(), compute::abs<int>()),
+        compute::make_transform_iterator(input.end(), compute::abs<int>()),
+        output.begin()
+    );
+    kernel.exec(queue);
+
+    std::vector<int> host_output(size);
+    compute::copy(output.begin(), output.end(), host_output.begin(), queue);
+    for(size_t i = 0; i < size; i++){
+        BOOST_CHECK_EQUAL(host_output[i], static_cast<int>(size - 1 - i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(copy_converting_types)
+{
+    // widening host -> device, converted on the device
+    compute::uchar_ bytes[] = { 0, 1, 2, 255 };
+    compute::vector<float> floats(4, context);
+    compute::copy(bytes, bytes + 4, floats.begin(), queue);
+    CHECK_RANGE_EQUAL(float, 4, floats, (0.f, 1.f, 2.f, 255.f));
+
+    // narrowing host -> device, converted on the host
+    std::vector<double> doubles;
+    doubles.push_back(1.5);
+    doubles.push_back(-2.25);
+    doubles.push_back(8.0);
+    compute::copy(doubles.begin(), doubles.end(), floats.begin() + 1, queue);
+    CHECK_RANGE_EQUAL(float, 4, floats, (0.f, 1.5f, -2.25f, 8.f));
+
+    // from a non-contiguous host range
+    std::list<short> shorts;
+    shorts.push_back(3);
+    shorts.push_back(-4);
+    compute::vector<int> ints(2, context);
+    compute::copy(shorts.begin(), shorts.end(), ints.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 2, ints, (3, -4));
+
+    // narrowing device -> host, converted on the device
+    compute::uchar_ output_bytes[4];
+    compute::copy(floats.begin(), floats.end(), output_bytes, queue);
+    BOOST_CHECK_EQUAL(int(output_bytes[0]), 0);
+    BOOST_CHECK_EQUAL(int(output_bytes[3]), 8);
+
+    // widening device -> host, converted on the host
+    std::vector<double> output_doubles(4);
+    compute::copy(floats.begin(), floats.end(), output_doubles.begin(), queue);
+    BOOST_CHECK_EQUAL(output_doubles[1], 1.5);
+    BOOST_CHECK_EQUAL(output_doubles[2], -2.25);
+
+    std::list<long> output_longs(2);
+    compute::copy(ints.begin(), ints.end(), output_longs.begin(), queue);
+    BOOST_CHECK_EQUAL(output_longs.front(), 3);
+    BOOST_CHECK_EQUAL(output_longs.back(), -4);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,90 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestCopyBatch
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/copy_batch.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(copy_ranges)
+{
+    compute::vector<int> a(8, context);
+    compute::vector<float> b(4, context);
+    compute::vector<char> c(5, context);
+    compute::fill(a.begin(), a.end(), 0, queue);
+    compute::fill(c.begin(), c.end(), 'x', queue);
+
+    int a1[] = { 1, 2, 3 };
+    int a2[] = { 7, 8 };
+    std::vector<float> b1(4, 1.5f);
+    char c1[] = { 'a', 'b', 'c' };
+
+    compute::copy_batch batch;
+    BOOST_CHECK(batch.empty());
+    batch.add(a1, a1 + 3, a.begin() + 1);
+    batch.add(a2, a2 + 2, a.begin() + 6);
+    batch.add(b1, b.begin());
+    batch.add(c1, c1 + 3, c.begin() + 1);
+    BOOST_CHECK_EQUAL(batch.size(), size_t(4));
+    BOOST_CHECK_EQUAL(batch.size_bytes(), size_t(5 * 4 + 4 * 4 + 3));
+
+    compute::future<void> future = batch.enqueue(queue);
+    future.wait();
+    CHECK_RANGE_EQUAL(int, 8, a, (0, 1, 2, 3, 0, 0, 7, 8));
+    CHECK_RANGE_EQUAL(float, 4, b, (1.5f, 1.5f, 1.5f, 1.5f));
+    CHECK_RANGE_EQUAL(char, 5, c, ('x', 'a', 'b', 'c', 'x'));
+
+    // the host values are packed by enqueue()
+    a1[0] = 9;
+    batch.enqueue(queue).wait();
+    CHECK_RANGE_EQUAL(int, 8, a, (0, 9, 2, 3, 0, 0, 7, 8));
+}
+
+BOOST_AUTO_TEST_CASE(copy_many_buffers)
+{
+    // more destination buffers than scattered by one kernel launch
+    const size_t count = compute::copy_batch::max_buffers() + 3;
+
+    std::vector<compute::vector<int> > vectors;
+    std::vector<std::vector<int> > values;
+    compute::copy_batch batch;
+    for(size_t i = 0; i < count; i++){
+        vectors.push_back(compute::vector<int>(i + 1, context));
+        values.push_back(std::vector<int>(i + 1, int(i)));
+    }
+    for(size_t i = 0; i < count; i++){
+        batch.add(values[i], vectors[i].begin());
+    }
+
+    batch.enqueue(queue).wait();
+    for(size_t i = 0; i < count; i++){
+        std::vector<int> host(i + 1);
+        compute::copy(vectors[i].begin(), vectors[i].end(), host.begin(), queue);
+        BOOST_CHECK(host == values[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(empty_batch)
+{
+    compute::copy_batch batch;
+    BOOST_CHECK(!batch.enqueue(queue).valid());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
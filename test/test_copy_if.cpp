@@ -11,8 +11,12 @@
 #define BOOST_TEST_MODULE TestCopyIf
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
+#include <boost/compute/function.hpp>
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/algorithm/copy_if.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
 #include <boost/compute/container/vector.hpp>
 
 #include "check_macros.hpp"
@@ -108,4 +112,77 @@ BOOST_AUTO_TEST_CASE(copy_index_if_int)
     CHECK_RANGE_EQUAL(int, 7, output, (0, 2, 5, 6, -1, -1, -1));
 }
 
+BOOST_AUTO_TEST_CASE(copy_if_odd_large)
+{
+    // many work-groups with unevenly distributed selected values
+    std::vector<int> data(123457);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>((i * 7919) % 1000);
+    }
+    compute::vector<int> input(data.begin(), data.end(), queue);
+    compute::vector<int> output(input.size(), context);
+
+    std::vector<int> expected;
+    for(size_t i = 0; i < data.size(); i++){
+        if(data[i] % 3 == 1){
+            expected.push_back(data[i]);
+        }
+    }
+
+    using ::boost::compute::_1;
+
+    compute::vector<int>::iterator iter = compute::copy_if(
+        input.begin(), input.end(), output.begin(), _1 % 3 == 1, queue
+    );
+    BOOST_CHECK_EQUAL(size_t(std::distance(output.begin(), iter)), expected.size());
+
+    std::vector<int> host_output(expected.size());
+    compute::copy(output.begin(), iter, host_output.begin(), queue);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        host_output.begin(), host_output.end(), expected.begin(), expected.end()
+    );
+}
+
+// the stream compaction used on cpu devices, run directly so that it is
+// tested on every device
+BOOST_AUTO_TEST_CASE(stream_compact_on_cpu)
+{
+    std::vector<int> data(54321);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>((i * 7919) % 1000);
+    }
+    compute::vector<int> input(data.begin(), data.end(), queue);
+    compute::vector<int> output(input.size(), context);
+
+    std::vector<int> expected;
+    for(size_t i = 0; i < data.size(); i++){
+        if(data[i] < 100){
+            expected.push_back(data[i]);
+        }
+    }
+
+    BOOST_COMPUTE_FUNCTION(bool, is_small, (int x),
+    {
+        return x < 100;
+    });
+
+    compute::vector<int>::iterator iter = compute::detail::stream_compact_on_cpu(
+        input.begin(),
+        input.size(),
+        output.begin(),
+        compute::detail::stream_compact_if<
+            compute::vector<int>::iterator, compute::function<bool(int)>
+        >(input.begin(), is_small),
+        false,
+        queue
+    );
+    BOOST_CHECK_EQUAL(size_t(std::distance(output.begin(), iter)), expected.size());
+
+    std::vector<int> host_output(expected.size());
+    compute::copy(output.begin(), iter, host_output.begin(), queue);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        host_output.begin(), host_output.end(), expected.begin(), expected.end()
+    );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,73 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestCopyRect
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/copy_rect.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(copy_rect_device_to_device)
+{
+    // 4x3 block at row 1, column 2 of a 8x5 matrix
+    bc::vector<int> matrix(8 * 5, context);
+    bc::iota(matrix.begin(), matrix.end(), 0, queue);
+
+    bc::vector<int> block(4 * 3, context);
+    bc::vector<int>::iterator end = bc::copy_rect(
+        matrix.begin() + 1 * 8 + 2, 8, block.begin(), 4, 4, 3, queue
+    );
+    BOOST_CHECK(end == block.end());
+    CHECK_RANGE_EQUAL(
+        int, 12, block,
+        (10, 11, 12, 13, 18, 19, 20, 21, 26, 27, 28, 29)
+    );
+}
+
+BOOST_AUTO_TEST_CASE(copy_rect_host_to_device)
+{
+    // rows of 3 values padded to 4 on the host
+    const int host[] = { 1, 2, 3, -1, 4, 5, 6, -1 };
+
+    bc::vector<int> vector(10, context);
+    bc::fill(vector.begin(), vector.end(), 0, queue);
+    bc::copy_rect(host, 4, vector.begin() + 1, 5, 3, 2, queue);
+    CHECK_RANGE_EQUAL(int, 10, vector, (0, 1, 2, 3, 0, 0, 4, 5, 6, 0));
+}
+
+BOOST_AUTO_TEST_CASE(copy_rect_device_to_host)
+{
+    bc::vector<int> vector(12, context);
+    bc::iota(vector.begin(), vector.end(), 0, queue);
+
+    // second and third columns of the 4x3 matrix
+    std::vector<int> host(6, -1);
+    int *end = bc::copy_rect(vector.begin() + 1, 4, &host[0], 2, 2, 3, queue);
+    BOOST_CHECK(end == &host[0] + 6);
+    BOOST_CHECK_EQUAL(host[0], 1);
+    BOOST_CHECK_EQUAL(host[1], 2);
+    BOOST_CHECK_EQUAL(host[2], 5);
+    BOOST_CHECK_EQUAL(host[3], 6);
+    BOOST_CHECK_EQUAL(host[4], 9);
+    BOOST_CHECK_EQUAL(host[5], 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
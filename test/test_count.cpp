@@ -11,7 +11,9 @@
 #define BOOST_TEST_MODULE TestCount
 #include <boost/test/unit_test.hpp>
 
+#include <iostream>
 #include <string>
+#include <vector>
 
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/function.hpp>
@@ -23,6 +25,7 @@
 #include <boost/compute/algorithm/iota.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/iterator/constant_iterator.hpp>
+#include <boost/compute/detail/sub_group.hpp>
 
 #include "context_setup.hpp"
 
@@ -216,4 +219,42 @@ BOOST_AUTO_TEST_CASE(count_if_with_reduce)
     );
 }
 
+BOOST_AUTO_TEST_CASE(count_if_with_ballot)
+{
+    if(!compute::detail::sub_group_functions(device).supported()){
+        std::cerr << "skipping count_if_with_ballot test: "
+                  << "device does not support sub-group functions" << std::endl;
+        return;
+    }
+
+    compute::vector<int> vec(10000, context);
+    compute::iota(vec.begin(), vec.end(), 0, queue);
+
+    using boost::compute::lambda::_1;
+
+    BOOST_CHECK_EQUAL(
+        compute::detail::count_if_with_ballot(
+            vec.begin(), vec.end(), _1 > 1024, queue
+        ),
+        size_t(8975)
+    );
+}
+
+BOOST_AUTO_TEST_CASE(count_if_to_device)
+{
+    using compute::lambda::_1;
+
+    compute::vector<int> vector(100, context);
+    compute::iota(vector.begin(), vector.end(), 0, queue);
+
+    compute::vector<compute::ulong_> count(2, context);
+    compute::count_if(vector.begin(), vector.end(), _1 < 10, count.begin(), queue);
+    compute::count_if(vector.begin(), vector.begin(), _1 < 10, count.begin() + 1, queue);
+
+    std::vector<compute::ulong_> host_count(2);
+    compute::copy(count.begin(), count.end(), host_count.begin(), queue);
+    BOOST_CHECK_EQUAL(host_count[0], compute::ulong_(10));
+    BOOST_CHECK_EQUAL(host_count[1], compute::ulong_(0));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -216,6 +216,25 @@ BOOST_AUTO_TEST_CASE(partition_by_affinity_domain)
     BOOST_CHECK(sub_devices.size() > 0);
     BOOST_CHECK(sub_devices[0].is_subdevice() == true);
 }
+
+BOOST_AUTO_TEST_CASE(partition_by_numa_domain)
+{
+    boost::compute::device device = boost::compute::system::default_device();
+
+    REQUIRES_OPENCL_VERSION(1,2);
+
+    if(!device.supports_affinity_domain(CL_DEVICE_AFFINITY_DOMAIN_NUMA)){
+        std::cout << "skipping test: "
+                  << "device does not support partitioning by numa node"
+                  << std::endl;
+        return;
+    }
+
+    std::vector<boost::compute::device> sub_devices =
+        device.partition_by_affinity_domain(CL_DEVICE_AFFINITY_DOMAIN_NUMA);
+    BOOST_CHECK(sub_devices.size() > 0);
+    BOOST_CHECK(sub_devices[0].is_subdevice() == true);
+}
 #endif // CL_VERSION_1_2
 
 BOOST_AUTO_TEST_CASE(nvidia_compute_capability)
@@ -11,8 +11,11 @@
 #define BOOST_TEST_MODULE TestDiscreteDistribution
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/count_if.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/random/default_random_engine.hpp>
@@ -21,6 +24,39 @@
 
 #include "context_setup.hpp"
 
+// checks that the frequency of each value in vec is close to the
+// probability given by its weight
+template<class Weight>
+static void check_frequencies(const boost::compute::vector<boost::compute::uint_> &vec,
+                              const std::vector<Weight> &weights,
+                              double tolerance,
+                              boost::compute::command_queue &queue)
+{
+    std::vector<boost::compute::uint_> host_vec(vec.size());
+    boost::compute::copy(vec.begin(), vec.end(), host_vec.begin(), queue);
+
+    double sum = 0;
+    for(size_t i = 0; i < weights.size(); i++){
+        sum += weights[i];
+    }
+
+    std::vector<size_t> counts(weights.size(), 0);
+    for(size_t i = 0; i < host_vec.size(); i++){
+        BOOST_REQUIRE(host_vec[i] < weights.size());
+        counts[host_vec[i]]++;
+    }
+    for(size_t i = 0; i < weights.size(); i++){
+        const double expected = weights[i] / sum;
+        const double actual = double(counts[i]) / host_vec.size();
+        if(weights[i] == 0){
+            BOOST_CHECK_EQUAL(counts[i], size_t(0));
+        }
+        else {
+            BOOST_CHECK_SMALL(actual - expected, tolerance);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(discrete_distribution_doctest)
 {
     using boost::compute::uint_;
@@ -51,4 +87,57 @@ distribution.generate(vec.begin(), vec.end(), engine, queue);
     );
 }
 
+BOOST_AUTO_TEST_CASE(discrete_distribution_frequencies)
+{
+    using boost::compute::uint_;
+
+    std::vector<int> weights;
+    for(int i = 0; i < 10; i++){
+        weights.push_back(i % 3 == 0 ? 0 : i);
+    }
+
+    boost::compute::vector<uint_> vec(100000, context);
+    boost::compute::default_random_engine engine(queue);
+    boost::compute::discrete_distribution<uint_> distribution(
+        weights.begin(), weights.end()
+    );
+    BOOST_CHECK_EQUAL(distribution.n(), uint_(10));
+    BOOST_CHECK_CLOSE(distribution.probabilities()[2], 2.0 / 33.0, 1e-6);
+
+    distribution.generate(vec.begin(), vec.end(), engine, queue);
+    check_frequencies(vec, weights, 0.01, queue);
+}
+
+BOOST_AUTO_TEST_CASE(discrete_distribution_device_weights)
+{
+    using boost::compute::uint_;
+
+    // ten thousand skewed weights with every tenth weight zero
+    std::vector<float> weights(10000);
+    for(size_t i = 0; i < weights.size(); i++){
+        weights[i] = i % 10 == 0 ? 0.f : float(i % 100);
+    }
+    weights[7] = 50000.f;
+    boost::compute::vector<float> device_weights(
+        weights.begin(), weights.end(), queue
+    );
+
+    boost::compute::vector<uint_> vec(200000, context);
+    boost::compute::default_random_engine engine(queue);
+    boost::compute::discrete_distribution<uint_> distribution(
+        device_weights.begin(), device_weights.end(), queue
+    );
+    BOOST_CHECK_EQUAL(distribution.n(), uint_(10000));
+
+    distribution.generate(vec.begin(), vec.end(), engine, queue);
+    check_frequencies(vec, weights, 0.005, queue);
+
+    // the same tables built on the host
+    boost::compute::discrete_distribution<uint_> host_distribution(
+        weights.begin(), weights.end(), queue
+    );
+    host_distribution.generate(vec.begin(), vec.end(), engine, queue);
+    check_frequencies(vec, weights, 0.005, queue);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
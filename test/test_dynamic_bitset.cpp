@@ -12,7 +12,9 @@
 #include <boost/test/unit_test.hpp>
 
 #include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
 #include <boost/compute/container/dynamic_bitset.hpp>
+#include <boost/compute/container/vector.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -93,4 +95,102 @@ BOOST_AUTO_TEST_CASE(none_and_any)
     BOOST_CHECK(bits.none(queue) == true);
 }
 
+BOOST_AUTO_TEST_CASE(bit_operations)
+{
+    compute::dynamic_bitset<> a(100, queue);
+    compute::dynamic_bitset<> b(100, queue);
+    a.set(1, queue);
+    a.set(70, queue);
+    b.set(70, queue);
+    b.set(99, queue);
+
+    compute::dynamic_bitset<> c(a);
+    c.bit_and(b, queue);
+    BOOST_CHECK_EQUAL(c.count(queue), size_t(1));
+    BOOST_CHECK(c.test(70, queue) == true);
+
+    c = a;
+    c.bit_or(b, queue);
+    BOOST_CHECK_EQUAL(c.count(queue), size_t(3));
+
+    c = a;
+    c.bit_xor(b, queue);
+    BOOST_CHECK_EQUAL(c.count(queue), size_t(2));
+    BOOST_CHECK(c.test(70, queue) == false);
+
+    // the bits past the end must stay cleared
+    c.flip(queue);
+    BOOST_CHECK_EQUAL(c.count(queue), size_t(98));
+    BOOST_CHECK(c.test(1, queue) == false);
+    BOOST_CHECK(c.test(99, queue) == false);
+}
+
+BOOST_AUTO_TEST_CASE(rank_and_select)
+{
+    compute::dynamic_bitset<> bits(200, queue);
+    bits.set(3, queue);
+    bits.set(64, queue);
+    bits.set(65, queue);
+    bits.set(199, queue);
+
+    compute::uint_ positions_data[] = { 0, 3, 4, 64, 66, 199, 200 };
+    compute::vector<compute::uint_> positions(positions_data, positions_data + 7, queue);
+    compute::vector<compute::uint_> ranks(7, context);
+    bits.rank(positions.begin(), positions.end(), ranks.begin(), queue);
+    CHECK_RANGE_EQUAL(compute::uint_, 7, ranks, (0, 0, 1, 1, 3, 3, 4));
+
+    compute::vector<compute::uint_> indices(5, context);
+    compute::iota(indices.begin(), indices.end(), compute::uint_(0), queue);
+    compute::vector<compute::uint_> selected(5, context);
+    bits.select(indices.begin(), indices.end(), selected.begin(), queue);
+    CHECK_RANGE_EQUAL(compute::uint_, 5, selected, (3, 64, 65, 199, 200));
+
+    // the ranks are rebuilt after the bitset changes
+    bits.set(10, queue);
+    bits.rank(positions.begin(), positions.end(), ranks.begin(), queue);
+    CHECK_RANGE_EQUAL(compute::uint_, 7, ranks, (0, 0, 1, 2, 4, 4, 5));
+}
+
+BOOST_AUTO_TEST_CASE(copy_if_stencil)
+{
+    compute::dynamic_bitset<> stencil(10, queue);
+    stencil.set(2, queue);
+    stencil.set(5, queue);
+    stencil.set(9, queue);
+
+    compute::vector<int> input(10, context);
+    compute::iota(input.begin(), input.end(), 0, queue);
+
+    compute::vector<int> output(10, context);
+    compute::vector<int>::iterator end = compute::copy_if(
+        input.begin(), input.end(), stencil, output.begin(), queue
+    );
+    BOOST_CHECK(end == output.begin() + 3);
+    CHECK_RANGE_EQUAL(int, 3, output, (2, 5, 9));
+}
+
+BOOST_AUTO_TEST_CASE(assign_predicate)
+{
+    using compute::lambda::_1;
+
+    // more values than bits in a block
+    compute::vector<int> input(100, context);
+    compute::iota(input.begin(), input.end(), 0, queue);
+
+    compute::dynamic_bitset<> bits(10, queue);
+    bits.assign(input.begin(), input.end(), _1 % 3 == 0, queue);
+    BOOST_CHECK_EQUAL(bits.size(), size_t(100));
+    BOOST_CHECK_EQUAL(bits.count(queue), size_t(34));
+    BOOST_CHECK(bits.test(0, queue));
+    BOOST_CHECK(!bits.test(64, queue));
+    BOOST_CHECK(bits.test(99, queue));
+
+    compute::vector<int> output(100, context);
+    compute::vector<int>::iterator end = compute::copy_if(
+        input.begin(), input.end(), bits, output.begin(), queue
+    );
+    BOOST_CHECK(end == output.begin() + 34);
+    CHECK_RANGE_EQUAL(int, 4, output, (0, 3, 6, 9));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
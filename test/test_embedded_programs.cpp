@@ -0,0 +1,86 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestEmbeddedPrograms
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <sstream>
+
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/program.hpp>
+#include <boost/compute/utility/embedded_programs.hpp>
+#include <boost/compute/utility/program_cache.hpp>
+
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(record_programs)
+{
+    const char source[] =
+        "__kernel void recorded(__global int *a)\n"
+        "{\n"
+        "    a[get_global_id(0)] = 42;\n"
+        "}\n";
+
+    compute::record_embedded_programs(true);
+    compute::program_cache cache(4);
+    cache.get_or_build("recorded", "-DRECORDED", source, context);
+    compute::record_embedded_programs(false);
+
+    std::ostringstream stream;
+    compute::write_embedded_programs(stream, "test_programs");
+
+    const std::string generated = stream.str();
+    BOOST_CHECK(
+        generated.find(compute::embedded_program_hash(source, "-DRECORDED")) != std::string::npos
+    );
+    BOOST_CHECK(generated.find("test_programs_registration") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(use_embedded_program)
+{
+    const char embedded_source[] =
+        "__kernel void embedded(__global int *a)\n"
+        "{\n"
+        "    a[get_global_id(0)] = 7;\n"
+        "}\n";
+
+    // register the binary of embedded_source for the hash of another
+    // source, so building that source returns the embedded program
+    static std::vector<unsigned char> binary;
+    binary = compute::program::build_with_source(embedded_source, context).binary();
+    static std::string hash;
+    hash = compute::embedded_program_hash("never compiled", "-DEMBEDDED");
+    static std::string device_name;
+    device_name = device.name();
+
+    const compute::embedded_program programs[] = {
+        { hash.c_str(), device_name.c_str(), &binary[0], binary.size() }
+    };
+    compute::register_embedded_programs(programs, 1);
+
+    compute::program_cache cache(4);
+    compute::program p = cache.get_or_build("embedded", "-DEMBEDDED", "never compiled", context);
+    BOOST_CHECK_EQUAL(cache.get_statistics().binary_builds, size_t(1));
+
+    compute::buffer buffer(context, sizeof(int));
+    compute::kernel kernel(p, "embedded");
+    kernel.set_arg(0, buffer);
+    queue.enqueue_task(kernel);
+
+    int value = 0;
+    queue.enqueue_read_buffer(buffer, 0, sizeof(int), &value);
+    BOOST_CHECK_EQUAL(value, 7);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,203 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestExecutionPolicy
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include <boost/compute/function.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/is_sorted.hpp>
+#include <boost/compute/algorithm/reverse.hpp>
+#include <boost/compute/algorithm/scratch_size.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/experimental/execution_policy.hpp>
+#include <boost/compute/functional/math.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/utility/scratch_space.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+namespace bce = boost::compute::experimental;
+
+BOOST_AUTO_TEST_CASE(sort_with_each_policy)
+{
+    std::vector<int> data(1000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = int((i * 7919) % 1000) - 500;
+    }
+
+    bc::vector<int> vector(context);
+
+    vector.assign(data.begin(), data.end(), queue);
+    bce::sort(bce::par_gpu.on(queue), vector.begin(), vector.end());
+    BOOST_CHECK(bc::is_sorted(vector.begin(), vector.end(), queue));
+    CHECK_RANGE_EQUAL(int, 3, vector, (-500, -499, -498));
+
+    vector.assign(data.begin(), data.end(), queue);
+    bce::sort(bce::par_cpu.on(queue), vector.begin(), vector.end());
+    BOOST_CHECK(bc::is_sorted(vector.begin(), vector.end(), queue));
+
+    vector.assign(data.begin(), data.begin() + 100, queue);
+    bce::sort(bce::seq_device.on(queue), vector.begin(), vector.end());
+    BOOST_CHECK(bc::is_sorted(vector.begin(), vector.end(), queue));
+
+    // host ranges are sorted by sort()
+    std::vector<int> host_data(data.begin(), data.begin() + 100);
+    bce::sort(bce::seq_device.on(queue), host_data.begin(), host_data.end());
+    BOOST_CHECK(std::adjacent_find(host_data.begin(), host_data.end(),
+                                   std::greater<int>()) == host_data.end());
+
+    // the merge sort with a user-defined compare
+    BOOST_COMPUTE_FUNCTION(bool, descending, (int a, int b),
+    {
+        return a > b;
+    });
+
+    vector.assign(data.begin(), data.end(), queue);
+    bce::sort(bce::par_gpu.on(queue), vector.begin(), vector.end(), descending);
+    CHECK_RANGE_EQUAL(int, 3, vector, (499, 498, 497));
+}
+
+BOOST_AUTO_TEST_CASE(reduce_with_each_policy)
+{
+    bc::vector<int> vector(10000, context);
+    bc::iota(vector.begin(), vector.end(), 0, queue);
+
+    int sum = 0;
+    bce::reduce(bce::par_gpu.on(queue), vector.begin(), vector.end(), &sum);
+    BOOST_CHECK_EQUAL(sum, 49995000);
+
+    sum = 0;
+    bce::reduce(bce::par_cpu.on(queue), vector.begin(), vector.end(), &sum);
+    BOOST_CHECK_EQUAL(sum, 49995000);
+
+    sum = 0;
+    bce::reduce(bce::seq_device.on(queue), vector.begin(), vector.end(), &sum);
+    BOOST_CHECK_EQUAL(sum, 49995000);
+
+    int largest = 0;
+    bce::reduce(
+        bce::par_gpu.on(queue), vector.begin(), vector.end(), &largest,
+        bc::max<int>()
+    );
+    BOOST_CHECK_EQUAL(largest, 9999);
+}
+
+BOOST_AUTO_TEST_CASE(scan_with_each_policy)
+{
+    int data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    bc::vector<int> input(data, data + 8, queue);
+    bc::vector<int> output(8, context);
+
+    bce::inclusive_scan(bce::par_gpu.on(queue), input.begin(), input.end(), output.begin());
+    CHECK_RANGE_EQUAL(int, 8, output, (1, 3, 6, 10, 15, 21, 28, 36));
+
+    bce::exclusive_scan(bce::par_cpu.on(queue), input.begin(), input.end(), output.begin());
+    CHECK_RANGE_EQUAL(int, 8, output, (0, 1, 3, 6, 10, 15, 21, 28));
+
+    bce::inclusive_scan(bce::seq_device.on(queue), input.begin(), input.end(), output.begin());
+    CHECK_RANGE_EQUAL(int, 8, output, (1, 3, 6, 10, 15, 21, 28, 36));
+}
+
+BOOST_AUTO_TEST_CASE(transform_with_each_policy)
+{
+    float data[] = { 1.0f, 4.0f, 9.0f, 16.0f };
+    bc::vector<float> input(data, data + 4, queue);
+    bc::vector<float> output(4, context);
+
+    bce::transform(
+        bce::par_gpu.on(queue), input.begin(), input.end(), output.begin(),
+        bc::sqrt<float>()
+    );
+    CHECK_RANGE_EQUAL(float, 4, output, (1.0f, 2.0f, 3.0f, 4.0f));
+
+    bce::transform(
+        bce::seq_device.on(queue), output.begin(), output.end(), output.begin(),
+        bc::lambda::_1 * -1.0f
+    );
+    CHECK_RANGE_EQUAL(float, 4, output, (-1.0f, -2.0f, -3.0f, -4.0f));
+}
+
+BOOST_AUTO_TEST_CASE(hybrid_policy)
+{
+    std::vector<bc::command_queue> queues;
+    queues.push_back(queue);
+    queues.push_back(bc::command_queue(context, device));
+
+    typedef bce::execution_policy<bce::hybrid_target, bce::tuning<0, 1000> > policy_type;
+    const policy_type policy = policy_type().on(queues);
+
+    bc::vector<int> input(10000, context);
+    bc::iota(input.begin(), input.end(), 0, queue);
+    queue.finish();
+
+    bc::vector<int> output(10000, context);
+    bce::transform(
+        policy, input.begin(), input.end(), output.begin(), bc::lambda::_1 * -1
+    );
+    CHECK_RANGE_EQUAL(int, 3, output, (0, -1, -2));
+
+    int sum = 0;
+    bce::reduce(policy, input.begin(), input.end(), &sum);
+    BOOST_CHECK_EQUAL(sum, 49995000);
+
+    // not split between the queues
+    bc::reverse(input.begin(), input.end(), queue);
+    bce::sort(policy, input.begin(), input.end());
+    BOOST_CHECK(bc::is_sorted(input.begin(), input.end(), queue));
+}
+
+BOOST_AUTO_TEST_CASE(serial_threshold)
+{
+    typedef bce::execution_policy<bce::gpu_target, bce::tuning<64> > policy_type;
+    policy_type policy(queue);
+
+    int data[] = { 9, 3, 7, 1, 5 };
+    bc::vector<int> vector(data, data + 5, queue);
+    bce::sort(policy, vector.begin(), vector.end());
+    CHECK_RANGE_EQUAL(int, 5, vector, (1, 3, 5, 7, 9));
+
+    int sum = 0;
+    bce::reduce(policy, vector.begin(), vector.end(), &sum);
+    BOOST_CHECK_EQUAL(sum, 25);
+}
+
+#ifdef CL_VERSION_1_1
+BOOST_AUTO_TEST_CASE(policy_with_scratch_space)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    std::vector<int> data(5000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = int(data.size() - i);
+    }
+    bc::vector<int> vector(data.begin(), data.end(), queue);
+
+    bc::scratch_space scratch(
+        bc::buffer(context, 2 * bc::sort_scratch_size<int>(data.size(), queue))
+    );
+    bce::sort(bce::par_gpu.on(queue).with(scratch), vector.begin(), vector.end());
+    queue.finish();
+    CHECK_RANGE_EQUAL(int, 3, vector, (1, 2, 3));
+
+    // the temporaries were drawn from the scratch space
+    BOOST_CHECK_GT(scratch.peak(), size_t(0));
+    BOOST_CHECK_EQUAL(scratch.used(), size_t(0));
+}
+#endif // CL_VERSION_1_1
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,106 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestExpand
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/expand.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/load_balanced_search.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+using compute::uint_;
+
+BOOST_AUTO_TEST_CASE(load_balanced_search)
+{
+    uint_ offsets_data[] = { 0, 3, 3, 4 };
+    compute::vector<uint_> offsets(offsets_data, offsets_data + 4, queue);
+
+    compute::vector<uint_> sources(6, context);
+    compute::vector<uint_> ranks(6, context);
+    compute::load_balanced_search(
+        offsets.begin(), offsets.end(),
+        sources.begin(), sources.end(), ranks.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(uint_, 6, sources, (0, 0, 0, 2, 3, 3));
+    CHECK_RANGE_EQUAL(uint_, 6, ranks, (0, 1, 2, 0, 0, 1));
+}
+
+BOOST_AUTO_TEST_CASE(expand_counts)
+{
+    int counts_data[] = { 2, 0, 0, 1, 3, 0 };
+    compute::vector<int> counts(counts_data, counts_data + 6, queue);
+
+    compute::vector<uint_> sources(6, context);
+    compute::vector<int> ranks(6, context);
+    std::pair<compute::vector<uint_>::iterator, compute::vector<int>::iterator> ends =
+        compute::expand(
+            counts.begin(), counts.end(), sources.begin(), ranks.begin(), queue
+        );
+    BOOST_CHECK(ends.first == sources.end());
+    BOOST_CHECK(ends.second == ranks.end());
+    CHECK_RANGE_EQUAL(uint_, 6, sources, (0, 0, 3, 4, 4, 4));
+    CHECK_RANGE_EQUAL(int, 6, ranks, (0, 1, 0, 0, 1, 2));
+
+    // no outputs
+    compute::fill(counts.begin(), counts.end(), 0, queue);
+    ends = compute::expand(
+        counts.begin(), counts.end(), sources.begin(), ranks.begin(), queue
+    );
+    BOOST_CHECK(ends.first == sources.begin());
+    BOOST_CHECK(ends.second == ranks.begin());
+}
+
+BOOST_AUTO_TEST_CASE(expand_skewed_counts)
+{
+    // a few inputs with most of the outputs between many empty ones
+    const size_t n = 10000;
+    std::vector<uint_> host_counts(n, 0);
+    host_counts[1] = 20000;
+    host_counts[5000] = 1;
+    host_counts[9999] = 7000;
+    for(size_t i = 6000; i < 6100; i++){
+        host_counts[i] = 3;
+    }
+
+    std::vector<uint_> expected_sources;
+    std::vector<uint_> expected_ranks;
+    for(size_t i = 0; i < n; i++){
+        for(uint_ r = 0; r < host_counts[i]; r++){
+            expected_sources.push_back(static_cast<uint_>(i));
+            expected_ranks.push_back(r);
+        }
+    }
+    const size_t total = expected_sources.size();
+
+    compute::vector<uint_> counts(host_counts.begin(), host_counts.end(), queue);
+    compute::vector<uint_> sources(total, context);
+    compute::vector<uint_> ranks(total, context);
+    compute::expand(
+        counts.begin(), counts.end(), sources.begin(), ranks.begin(), queue
+    );
+
+    std::vector<uint_> host_sources(total);
+    std::vector<uint_> host_ranks(total);
+    compute::copy(sources.begin(), sources.end(), host_sources.begin(), queue);
+    compute::copy(ranks.begin(), ranks.end(), host_ranks.begin(), queue);
+    BOOST_CHECK(host_sources == expected_sources);
+    BOOST_CHECK(host_ranks == expected_ranks);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,66 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestExternalSort
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/experimental/external_sort.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(sort_ulong)
+{
+    std::vector<compute::ulong_> keys(10000);
+    for(size_t i = 0; i < keys.size(); i++){
+        keys[i] = (compute::ulong_(std::rand()) << 32) | compute::ulong_(std::rand() % 100);
+    }
+    std::vector<compute::ulong_> expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    // ten sorted runs of 1024 keys (the last one is partial)
+    std::vector<compute::ulong_> scratch(keys.size());
+    compute::experimental::external_sort(
+        keys.begin(), keys.end(), scratch.begin(), 1024, queue
+    );
+    BOOST_CHECK(keys == expected);
+}
+
+BOOST_AUTO_TEST_CASE(sort_with_duplicates)
+{
+    // many equal keys across runs and runs smaller than a merge block
+    std::vector<compute::uint_> keys(3000);
+    for(size_t i = 0; i < keys.size(); i++){
+        keys[i] = static_cast<compute::uint_>((i * 37) % 11);
+    }
+    std::vector<compute::uint_> expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    compute::experimental::external_sort(keys.begin(), keys.end(), 40, queue);
+    BOOST_CHECK(keys == expected);
+}
+
+BOOST_AUTO_TEST_CASE(sort_single_chunk)
+{
+    compute::int_ data[] = { 5, -2, 9, 0, -7, 3 };
+    std::vector<compute::int_> keys(data, data + 6);
+
+    compute::experimental::external_sort(keys.begin(), keys.end(), 64, queue);
+    CHECK_HOST_RANGE_EQUAL(compute::int_, 6, keys.begin(), (-7, -2, 0, 3, 5, 9));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
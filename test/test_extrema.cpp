@@ -11,6 +11,9 @@
 #define BOOST_TEST_MODULE TestExtrema
 #include <boost/test/unit_test.hpp>
 
+#include <utility>
+#include <vector>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/copy.hpp>
@@ -170,4 +173,59 @@ BOOST_AUTO_TEST_CASE(max_bits_set)
     BOOST_CHECK_EQUAL(uint_(*iter), uint_(7));
 }
 
+BOOST_AUTO_TEST_CASE(minmax_large_float)
+{
+    const size_t size = 1000000;
+
+    std::vector<float> host_vector(size);
+    for(size_t i = 0; i < size; i++){
+        host_vector[i] = static_cast<float>((i * 7919) % 100003);
+    }
+    host_vector[123456] = -1.0f;
+    host_vector[654321] = 200000.0f;
+
+    // later duplicates of the extrema are not returned
+    host_vector[900000] = -1.0f;
+    host_vector[900001] = 200000.0f;
+
+    boost::compute::vector<float> vector(host_vector.begin(), host_vector.end(), queue);
+
+    std::pair<boost::compute::vector<float>::iterator,
+              boost::compute::vector<float>::iterator> result =
+        boost::compute::minmax_element(vector.begin(), vector.end(), queue);
+    BOOST_CHECK(result.first == vector.begin() + 123456);
+    BOOST_CHECK(result.second == vector.begin() + 654321);
+
+    BOOST_CHECK(
+        boost::compute::min_element(vector.begin(), vector.end(), queue) ==
+            vector.begin() + 123456
+    );
+    BOOST_CHECK(
+        boost::compute::max_element(vector.begin(), vector.end(), queue) ==
+            vector.begin() + 654321
+    );
+}
+
+BOOST_AUTO_TEST_CASE(min_max_first_of_equal_values)
+{
+    // small enough for the kernel updating the index with atomics, all of
+    // the extrema are equal and the first of them is returned
+    const size_t size = 10000;
+
+    std::vector<int> host_vector(size);
+    for(size_t i = 0; i < size; i++){
+        host_vector[i] = static_cast<int>(i % 100);
+    }
+    boost::compute::vector<int> vector(host_vector.begin(), host_vector.end(), queue);
+
+    BOOST_CHECK(
+        boost::compute::min_element(vector.begin() + 1, vector.end(), queue) ==
+            vector.begin() + 100
+    );
+    BOOST_CHECK(
+        boost::compute::max_element(vector.begin(), vector.end(), queue) ==
+            vector.begin() + 99
+    );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
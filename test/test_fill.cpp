@@ -204,4 +204,19 @@ BOOST_AUTO_TEST_CASE(empty_fill)
     compute::fill_async(vec.begin(), vec.end(), 42, queue);
 }
 
+BOOST_AUTO_TEST_CASE(fill_with_device_value)
+{
+    compute::vector<int> value(2, context);
+    compute::fill(value.begin(), value.end(), 42, queue);
+
+    // the value is read from the buffer by the fill kernel
+    compute::vector<int> vector(8, context);
+    compute::fill(vector.begin(), vector.end(), value[1], queue);
+    CHECK_RANGE_EQUAL(int, 8, vector, (42, 42, 42, 42, 42, 42, 42, 42));
+
+    compute::fill_n(vector.begin(), 2, value[0], queue);
+    compute::fill_async(vector.begin() + 2, vector.end(), value[0], queue).wait();
+    CHECK_RANGE_EQUAL(int, 8, vector, (42, 42, 42, 42, 42, 42, 42, 42));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
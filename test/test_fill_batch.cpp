@@ -0,0 +1,87 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestFillBatch
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <algorithm>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/fill_batch.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(fill_ranges)
+{
+    int data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    compute::vector<int> a(data, data + 8, queue);
+    compute::vector<float> b(4, context);
+    compute::vector<compute::ulong_> c(3, context);
+
+    compute::fill_batch batch;
+    BOOST_CHECK(batch.empty());
+    batch.add(a.begin() + 2, a.begin() + 5, 0);
+    batch.add(b.begin(), b.end(), 1.5f);
+    batch.add(c.begin(), c.end(), compute::ulong_(0x100000002ull));
+    BOOST_CHECK_EQUAL(batch.size(), size_t(3));
+
+    batch.enqueue(queue);
+    CHECK_RANGE_EQUAL(int, 8, a, (1, 2, 0, 0, 0, 6, 7, 8));
+    CHECK_RANGE_EQUAL(float, 4, b, (1.5f, 1.5f, 1.5f, 1.5f));
+    CHECK_RANGE_EQUAL(
+        compute::ulong_, 3, c,
+        (0x100000002ull, 0x100000002ull, 0x100000002ull)
+    );
+
+    // the batch can be enqueued again
+    compute::copy(data, data + 8, a.begin(), queue);
+    batch.enqueue(queue);
+    CHECK_RANGE_EQUAL(int, 8, a, (1, 2, 0, 0, 0, 6, 7, 8));
+}
+
+BOOST_AUTO_TEST_CASE(fill_many_ranges)
+{
+    // more ranges than filled by one kernel launch
+    const size_t count = compute::fill_batch::max_ranges() + 3;
+
+    std::vector<compute::vector<int> > vectors;
+    compute::fill_batch batch;
+    for(size_t i = 0; i < count; i++){
+        vectors.push_back(compute::vector<int>(i + 1, context));
+    }
+    for(size_t i = 0; i < count; i++){
+        batch.add(vectors[i].begin(), vectors[i].end(), int(i));
+    }
+    batch.enqueue(queue).wait();
+
+    for(size_t i = 0; i < count; i++){
+        std::vector<int> host(vectors[i].size());
+        compute::copy(vectors[i].begin(), vectors[i].end(), host.begin(), queue);
+        BOOST_CHECK(std::count(host.begin(), host.end(), int(i)) == int(i + 1));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(fill_unaligned_range)
+{
+    char data[] = "abcdefgh";
+    compute::vector<char> vector(data, data + 8, queue);
+
+    compute::fill_batch batch;
+    batch.add(vector.begin() + 1, vector.begin() + 4, 'x');
+    batch.enqueue(queue);
+    CHECK_RANGE_EQUAL(char, 8, vector, ('a', 'x', 'x', 'x', 'e', 'f', 'g', 'h'));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -14,9 +14,11 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
 #include <boost/compute/algorithm/find.hpp>
 #include <boost/compute/algorithm/find_if.hpp>
 #include <boost/compute/algorithm/find_if_not.hpp>
+#include <boost/compute/algorithm/detail/find_with_early_exit.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/iterator/constant_buffer_iterator.hpp>
 
@@ -26,6 +28,23 @@
 namespace bc = boost::compute;
 namespace compute = boost::compute;
 
+// matches only the position target, without reading any values
+struct position_matcher
+{
+    position_matcher(compute::ulong_ target)
+        : m_target(target)
+    {
+    }
+
+    void operator()(compute::detail::meta_kernel &k) const
+    {
+        k.add_set_arg<const compute::ulong_>("target", m_target);
+        k << "match = i == target;\n";
+    }
+
+    compute::ulong_ m_target;
+};
+
 BOOST_AUTO_TEST_CASE(find_int)
 {
     int data[] = { 9, 15, 1, 4, 9, 9, 4, 15, 12, 1 };
@@ -103,4 +122,55 @@ BOOST_AUTO_TEST_CASE(find_point_by_distance)
     BOOST_CHECK_EQUAL(value, float2_(4, 4));
 }
 
+BOOST_AUTO_TEST_CASE(find_if_to_device)
+{
+    using boost::compute::lambda::_1;
+
+    int data[] = { 2, 4, 6, 7, 8, 9 };
+    compute::vector<int> vector(data, data + 6, queue);
+
+    compute::vector<compute::uint_> index(2, context);
+    compute::find_if(vector.begin(), vector.end(), _1 % 2 == 1, index.begin(), queue);
+    compute::find_if(vector.begin(), vector.end(), _1 > 10, index.begin() + 1, queue);
+    CHECK_RANGE_EQUAL(compute::uint_, 2, index, (3, 6));
+}
+
+BOOST_AUTO_TEST_CASE(find_in_large_range)
+{
+    // the match positions are spread over many chunks of work-items
+    compute::vector<int> vector(1000000, context);
+    compute::fill(vector.begin(), vector.end(), 0, queue);
+
+    BOOST_CHECK(compute::find(vector.begin(), vector.end(), 1, queue) == vector.end());
+
+    vector[987654] = 1;
+    BOOST_CHECK(compute::find(vector.begin(), vector.end(), 1, queue) == vector.begin() + 987654);
+
+    vector[12] = 1;
+    vector[500000] = 1;
+    BOOST_CHECK(compute::find(vector.begin(), vector.end(), 1, queue) == vector.begin() + 12);
+}
+
+BOOST_AUTO_TEST_CASE(find_with_early_exit_64bit_positions)
+{
+    if(sizeof(size_t) < 8){
+        return;
+    }
+
+    // more positions than fit in a uint, searched from the back so that
+    // the match is found in the first window
+    const size_t count = size_t(6000000000ULL);
+    const size_t target = size_t(5999999000ULL);
+
+    size_t position = compute::detail::find_with_early_exit(
+        count, position_matcher(target), true, queue
+    );
+    BOOST_CHECK_EQUAL(position, target);
+
+    position = compute::detail::find_with_early_exit(
+        count, position_matcher(7), false, queue
+    );
+    BOOST_CHECK_EQUAL(position, size_t(7));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -13,6 +13,7 @@
 
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/fill.hpp>
 #include <boost/compute/algorithm/find_end.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/types/fundamental.hpp>
@@ -60,4 +61,24 @@ BOOST_AUTO_TEST_CASE(find_end_string)
     BOOST_VERIFY(iter == vectort.begin() + 15);
 }
 
+BOOST_AUTO_TEST_CASE(find_end_large_text)
+{
+    bc::vector<bc::char_> vectort(500000, context);
+    bc::fill(vectort.begin(), vectort.end(), 'a', queue);
+
+    char pattern[] = "ba";
+    bc::vector<bc::char_> vectorp(pattern, pattern + 2, queue);
+
+    bc::vector<bc::char_>::iterator iter =
+        bc::find_end(vectort.begin(), vectort.end(),
+                     vectorp.begin(), vectorp.end(), queue);
+    BOOST_CHECK(iter == vectort.end());
+
+    vectort[10] = 'b';
+    vectort[200000] = 'b';
+    iter = bc::find_end(vectort.begin(), vectort.end(),
+                        vectorp.begin(), vectorp.end(), queue);
+    BOOST_CHECK(iter == vectort.begin() + 200000);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
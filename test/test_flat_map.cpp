@@ -12,6 +12,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <utility>
+#include <vector>
 
 #include <boost/concept_check.hpp>
 
@@ -20,6 +21,7 @@
 #include <boost/compute/type_traits/type_name.hpp>
 #include <boost/compute/type_traits/type_definition.hpp>
 
+#include "check_macros.hpp"
 #include "context_setup.hpp"
 
 BOOST_AUTO_TEST_CASE(concept_check)
@@ -142,4 +144,46 @@ BOOST_AUTO_TEST_CASE(custom_kernel)
     BOOST_CHECK_EQUAL(result.begin().read(queue), 5.6f);
 }
 
+BOOST_AUTO_TEST_CASE(insert_range)
+{
+    boost::compute::flat_map<int, float> map(context);
+    map.insert(std::make_pair(1, 1.1f), queue);
+    map.insert(std::make_pair(3, 3.3f), queue);
+
+    std::vector<std::pair<int, float> > data;
+    data.push_back(std::make_pair(5, 5.5f));
+    data.push_back(std::make_pair(2, 2.2f));
+    data.push_back(std::make_pair(3, 30.f));
+    data.push_back(std::make_pair(2, 20.f));
+    map.insert(data.begin(), data.end(), queue);
+
+    // values already in the map and the first of equal keys are kept
+    BOOST_CHECK_EQUAL(map.size(), size_t(4));
+
+    std::vector<std::pair<int, float> > host(map.size());
+    boost::compute::copy(map.begin(), map.end(), host.begin(), queue);
+    BOOST_CHECK(host[0] == std::make_pair(1, 1.1f));
+    BOOST_CHECK(host[1] == std::make_pair(2, 2.2f));
+    BOOST_CHECK(host[2] == std::make_pair(3, 3.3f));
+    BOOST_CHECK(host[3] == std::make_pair(5, 5.5f));
+}
+
+BOOST_AUTO_TEST_CASE(find_range)
+{
+    boost::compute::flat_map<int, float> map(context);
+    map.insert(std::make_pair(1, 1.1f), queue);
+    map.insert(std::make_pair(3, 3.3f), queue);
+    map.insert(std::make_pair(5, 5.5f), queue);
+
+    BOOST_CHECK(map.find(3, queue) == map.begin() + 1);
+    BOOST_CHECK(map.find(4, queue) == map.end());
+
+    int data[] = { 5, 2, 1, 6 };
+    boost::compute::vector<int> keys(data, data + 4, queue);
+
+    boost::compute::vector<boost::compute::uint_> indices(4, context);
+    map.find(keys.begin(), keys.end(), indices.begin(), queue);
+    CHECK_RANGE_EQUAL(boost::compute::uint_, 4, indices, (2, 3, 0, 3));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
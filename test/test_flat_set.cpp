@@ -19,6 +19,7 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/container/flat_set.hpp>
 
+#include "check_macros.hpp"
 #include "context_setup.hpp"
 
 namespace bc = boost::compute;
@@ -122,4 +123,35 @@ BOOST_AUTO_TEST_CASE(clear)
     BOOST_CHECK_EQUAL(set.size(), size_t(0));
 }
 
+BOOST_AUTO_TEST_CASE(insert_range)
+{
+    bc::flat_set<int> set(context);
+    set.insert(3, queue);
+    set.insert(7, queue);
+
+    int data[] = { 9, 1, 7, 5, 1, 3, 8 };
+    set.insert(data, data + 7, queue);
+
+    BOOST_CHECK_EQUAL(set.size(), size_t(6));
+    CHECK_RANGE_EQUAL(int, 6, set, (1, 3, 5, 7, 8, 9));
+}
+
+BOOST_AUTO_TEST_CASE(find_range)
+{
+    bc::flat_set<int> set(context);
+    int data[] = { 2, 4, 6, 8, 10 };
+    set.insert(data, data + 5, queue);
+
+    bc::vector<int> keys(context);
+    keys.push_back(4, queue);
+    keys.push_back(5, queue);
+    keys.push_back(10, queue);
+    keys.push_back(0, queue);
+    keys.push_back(11, queue);
+
+    bc::vector<bc::uint_> indices(keys.size(), context);
+    set.find(keys.begin(), keys.end(), indices.begin(), queue);
+    CHECK_RANGE_EQUAL(bc::uint_, 5, indices, (1, 5, 4, 5, 5));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -16,6 +16,7 @@
 #include <boost/compute/algorithm/for_each.hpp>
 #include <boost/compute/algorithm/for_each_n.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/dim.hpp>
 
 #include "context_setup.hpp"
 
@@ -41,4 +42,14 @@ BOOST_AUTO_TEST_CASE(for_each_n_nop)
     bc::for_each_n(vector.begin(), vector.size(), nop, queue);
 }
 
+BOOST_AUTO_TEST_CASE(for_each_2d_nop)
+{
+    bc::vector<int> vector(12, context);
+    bc::iota(vector.begin(), vector.end(), 0, queue);
+
+    BOOST_COMPUTE_FUNCTION(void, nop, (int ignored), {});
+
+    bc::for_each(vector.begin(), bc::dim(4, 3), nop, queue);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -206,4 +206,26 @@ BOOST_AUTO_TEST_CASE(define)
     CHECK_RANGE_EQUAL(int, 1, vec, (2));
 }
 
+BOOST_AUTO_TEST_CASE(macro_source_reused)
+{
+    // the source is generated once for each use of the macro and each
+    // signature the macro is instantiated with
+    std::string sources[2];
+    for(int i = 0; i < 2; i++){
+        BOOST_COMPUTE_FUNCTION(int, add_one, (int x),
+        {
+            return x + 1;
+        });
+        sources[i] = add_one.source();
+    }
+    BOOST_CHECK_EQUAL(sources[0], sources[1]);
+    BOOST_CHECK(sources[0].find("add_one(int x)") != std::string::npos);
+
+    const std::string int_source = make_negate_function<int>().source();
+    const std::string float_source = make_negate_function<float>().source();
+    BOOST_CHECK(int_source.find("int negate(const int x)") != std::string::npos);
+    BOOST_CHECK(float_source.find("float negate(const float x)") != std::string::npos);
+    BOOST_CHECK_EQUAL(make_negate_function<int>().source(), int_source);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,102 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestFunctionalMathPrecision
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/math.hpp>
+#include <boost/compute/functional/math_precision.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(math_function_names)
+{
+    using compute::detail::math_function_name;
+
+    BOOST_CHECK_EQUAL(math_function_name("sin", true), "sin");
+    {
+        compute::scoped_math_precision precision(compute::math_precision_native);
+        BOOST_CHECK_EQUAL(math_function_name("sin", true), "native_sin");
+        BOOST_CHECK_EQUAL(math_function_name("powr", true), "native_powr");
+        BOOST_CHECK_EQUAL(math_function_name("sin", false), "sin");
+        BOOST_CHECK_EQUAL(math_function_name("atan2", true), "atan2");
+
+        {
+            compute::scoped_math_precision half(compute::math_precision_half);
+            BOOST_CHECK_EQUAL(math_function_name("exp", true), "half_exp");
+        }
+        BOOST_CHECK_EQUAL(math_function_name("exp", true), "native_exp");
+    }
+    BOOST_CHECK_EQUAL(math_function_name("exp", true), "exp");
+
+    BOOST_CHECK(compute::detail::is_reduced_precision_math_type<float>::value);
+    BOOST_CHECK(compute::detail::is_reduced_precision_math_type<compute::float4_>::value);
+    BOOST_CHECK(!compute::detail::is_reduced_precision_math_type<double>::value);
+    BOOST_CHECK(!compute::detail::is_reduced_precision_math_type<int>::value);
+}
+
+BOOST_AUTO_TEST_CASE(transform_native_precision)
+{
+    float data[] = { 0.5f, 1.0f, 2.0f, 4.0f, 8.0f };
+    compute::vector<float> input(data, data + 5, queue);
+    compute::vector<float> output(5, context);
+    std::vector<float> host(5);
+
+    for(int i = 0; i < 3; i++){
+        compute::scoped_math_precision precision(
+            static_cast<compute::math_precision>(i)
+        );
+
+        compute::transform(
+            input.begin(), input.end(), output.begin(), compute::sqrt<float>(), queue
+        );
+        compute::copy(output.begin(), output.end(), host.begin(), queue);
+        for(size_t j = 0; j < 5; j++){
+            BOOST_CHECK_CLOSE(host[j], std::sqrt(data[j]), 0.5);
+        }
+
+        using compute::lambda::_1;
+        compute::transform(
+            input.begin(), input.end(), output.begin(), compute::lambda::log(_1), queue
+        );
+        compute::copy(output.begin(), output.end(), host.begin(), queue);
+        for(size_t j = 0; j < 5; j++){
+            BOOST_CHECK_SMALL(host[j] - std::log(data[j]), 1e-2f);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(native_function_objects)
+{
+    float data[] = { 1.0f, 2.0f, 4.0f };
+    compute::vector<float> input(data, data + 3, queue);
+    compute::vector<float> output(3, context);
+
+    compute::transform(
+        input.begin(), input.end(), output.begin(), compute::native_recip<float>(), queue
+    );
+    std::vector<float> host(3);
+    compute::copy(output.begin(), output.end(), host.begin(), queue);
+    BOOST_CHECK_CLOSE(host[0], 1.0f, 0.5);
+    BOOST_CHECK_CLOSE(host[1], 0.5f, 0.5);
+    BOOST_CHECK_CLOSE(host[2], 0.25f, 0.5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
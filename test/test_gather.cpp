@@ -12,9 +12,24 @@
 #include <boost/test/unit_test.hpp>
 
 #include <boost/compute/system.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/copy_if.hpp>
 #include <boost/compute/algorithm/gather.hpp>
+#include <boost/compute/algorithm/gather_if.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
+#include <boost/compute/types/struct.hpp>
+
+struct GatherItem
+{
+    int id;
+    float x;
+    float y;
+    float z;
+};
+
+BOOST_COMPUTE_ADAPT_STRUCT(GatherItem, GatherItem, (id, x, y, z))
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -63,4 +78,117 @@ BOOST_AUTO_TEST_CASE(copy_index_then_gather)
     CHECK_RANGE_EQUAL(int, 5, odd_values, (1, 3, 5, 9, 7));
 }
 
+BOOST_AUTO_TEST_CASE(gather_if_int)
+{
+    using compute::lambda::_1;
+
+    int input_data[] = { 10, 20, 30, 40, 50 };
+    compute::vector<int> input(input_data, input_data + 5, queue);
+
+    int map_data[] = { 4, 3, 2, 1, 0 };
+    compute::vector<int> map(map_data, map_data + 5, queue);
+
+    int stencil_data[] = { 1, 0, 1, 0, 2 };
+    compute::vector<int> stencil(stencil_data, stencil_data + 5, queue);
+
+    int output_data[] = { 0, 0, 0, 0, 0 };
+    compute::vector<int> output(output_data, output_data + 5, queue);
+
+    compute::gather_if(
+        map.begin(), map.end(), stencil.begin(), input.begin(), output.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 5, output, (50, 0, 30, 0, 10));
+
+    compute::gather_if(
+        map.begin(), map.end(), stencil.begin(), input.begin(), output.begin(),
+        _1 == 0, queue
+    );
+    CHECK_RANGE_EQUAL(int, 5, output, (50, 40, 30, 20, 10));
+}
+
+BOOST_AUTO_TEST_CASE(gather_with_offsets)
+{
+    int input_data[] = { 1, 2, 3, 4, 5 };
+    compute::vector<int> input(input_data, input_data + 5, queue);
+
+    int indices_data[] = { 9, 9, 3, 0, 2 };
+    compute::vector<int> indices(indices_data, indices_data + 5, queue);
+
+    int output_data[] = { 0, 0, 0, 0, 0 };
+    compute::vector<int> output(output_data, output_data + 5, queue);
+
+    compute::gather(
+        indices.begin() + 2, indices.end(), input.begin() + 1,
+        output.begin() + 1, queue
+    );
+    CHECK_RANGE_EQUAL(int, 5, output, (0, 5, 2, 4, 0));
+}
+
+BOOST_AUTO_TEST_CASE(gather_struct)
+{
+    std::vector<GatherItem> items(4);
+    for(int i = 0; i < 4; i++){
+        items[i].id = i;
+        items[i].x = i * 1.5f;
+        items[i].y = i * 2.5f;
+        items[i].z = -i * 1.0f;
+    }
+    compute::vector<GatherItem> input(items.begin(), items.end(), queue);
+
+    int indices_data[] = { 3, 0, 2, 2, 1 };
+    compute::vector<int> indices(indices_data, indices_data + 5, queue);
+
+    // the 16 byte structs are copied as uint4 words
+    compute::vector<GatherItem> output(5, context);
+    compute::gather(
+        indices.begin(), indices.end(), input.begin(), output.begin(), queue
+    );
+
+    std::vector<GatherItem> results(5);
+    compute::copy(output.begin(), output.end(), results.begin(), queue);
+    for(int i = 0; i < 5; i++){
+        const GatherItem &expected = items[indices_data[i]];
+        BOOST_CHECK_EQUAL(results[i].id, expected.id);
+        BOOST_CHECK_EQUAL(results[i].x, expected.x);
+        BOOST_CHECK_EQUAL(results[i].y, expected.y);
+        BOOST_CHECK_EQUAL(results[i].z, expected.z);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(gather_columns)
+{
+    int keys_data[] = { 10, 20, 30, 40 };
+    compute::vector<int> keys(keys_data, keys_data + 4, queue);
+
+    compute::float4_ points_data[] = {
+        compute::float4_(0, 0, 0, 0), compute::float4_(1, 1, 1, 1),
+        compute::float4_(2, 2, 2, 2), compute::float4_(3, 3, 3, 3)
+    };
+    compute::vector<compute::float4_> points(points_data, points_data + 4, queue);
+
+    int indices_data[] = { 2, 2, 0, 3 };
+    compute::vector<int> indices(indices_data, indices_data + 4, queue);
+
+    compute::vector<int> output_keys(4, context);
+    compute::vector<compute::float4_> output_points(4, context);
+
+    // both columns are gathered by a single kernel
+    compute::gather(
+        indices.begin(), indices.end(),
+        compute::make_zip_iterator(
+            boost::make_tuple(keys.begin(), points.begin())
+        ),
+        compute::make_zip_iterator(
+            boost::make_tuple(output_keys.begin(), output_points.begin())
+        ),
+        queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, output_keys, (30, 30, 10, 40));
+    CHECK_RANGE_EQUAL(
+        compute::float4_, 4, output_points,
+        (compute::float4_(2, 2, 2, 2), compute::float4_(2, 2, 2, 2),
+         compute::float4_(0, 0, 0, 0), compute::float4_(3, 3, 3, 3))
+    );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
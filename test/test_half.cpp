@@ -0,0 +1,166 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestHalf
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/math.hpp>
+#include <boost/compute/types/half.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(half_host_conversion)
+{
+    BOOST_CHECK_EQUAL(sizeof(bc::half_), size_t(2));
+    BOOST_CHECK_EQUAL(sizeof(bc::bfloat16_), size_t(2));
+
+    BOOST_CHECK_EQUAL(bc::half_(1.0f).bits(), 0x3c00);
+    BOOST_CHECK_EQUAL(bc::half_(-2.0f).bits(), 0xc000);
+    BOOST_CHECK_EQUAL(bc::half_(65504.0f).bits(), 0x7bff);
+    BOOST_CHECK_EQUAL(bc::half_(1e6f).bits(), 0x7c00);
+    BOOST_CHECK_EQUAL(float(bc::half_::from_bits(0x0001)), 5.9604644775390625e-8f);
+    BOOST_CHECK_EQUAL(float(bc::half_(0.333251953125f)), 0.333251953125f);
+
+    // ties round to even
+    BOOST_CHECK_EQUAL(bc::half_(2049.0f).bits(), bc::half_(2048.0f).bits());
+    BOOST_CHECK_EQUAL(bc::half_(2051.0f).bits(), bc::half_(2052.0f).bits());
+
+    BOOST_CHECK_EQUAL(bc::bfloat16_(1.0f).bits(), 0x3f80);
+    BOOST_CHECK_EQUAL(float(bc::bfloat16_(3.0e38f)), 3.00405527e38f);
+    BOOST_CHECK_EQUAL(float(bc::bfloat16_(-1.5f)), -1.5f);
+
+    BOOST_CHECK_EQUAL(std::string(bc::type_name<bc::half_>()), "half");
+    BOOST_CHECK_EQUAL(std::string(bc::type_name<bc::bfloat16_>()), "ushort");
+}
+
+BOOST_AUTO_TEST_CASE(copy_half_float)
+{
+    float data[] = { 1.0f, -0.5f, 3.25f, 1024.0f, -65504.0f, 0.0f, 2.0f };
+    bc::vector<float> input(data, data + 7, queue);
+
+    bc::vector<bc::half_> halves(7, context);
+    bc::copy(input.begin(), input.end(), halves.begin(), queue);
+
+    std::vector<bc::half_> host(7);
+    bc::copy(halves.begin(), halves.end(), host.begin(), queue);
+    for(size_t i = 0; i < 7; i++){
+        BOOST_CHECK_EQUAL(host[i].bits(), bc::half_(data[i]).bits());
+    }
+
+    bc::vector<float> output(7, context);
+    bc::copy(halves.begin(), halves.end(), output.begin(), queue);
+    CHECK_RANGE_EQUAL(float, 7, output, (1.0f, -0.5f, 3.25f, 1024.0f, -65504.0f, 0.0f, 2.0f));
+}
+
+BOOST_AUTO_TEST_CASE(copy_bfloat16_float)
+{
+    float data[] = { 1.0f, -0.5f, 3.0e38f, 1.00390625f };
+    bc::vector<float> input(data, data + 4, queue);
+
+    bc::vector<bc::bfloat16_> values(4, context);
+    bc::copy(input.begin(), input.end(), values.begin(), queue);
+
+    std::vector<bc::bfloat16_> host(4);
+    bc::copy(values.begin(), values.end(), host.begin(), queue);
+    for(size_t i = 0; i < 4; i++){
+        BOOST_CHECK_EQUAL(host[i].bits(), bc::bfloat16_(data[i]).bits());
+    }
+
+    bc::vector<float> output(4, context);
+    bc::copy(values.begin(), values.end(), output.begin(), queue);
+    CHECK_RANGE_EQUAL(float, 4, output, (1.0f, -0.5f, 3.00405527e38f, 1.0f));
+}
+
+BOOST_AUTO_TEST_CASE(transform_half)
+{
+    std::vector<bc::half_> data;
+    data.push_back(1.0f);
+    data.push_back(4.0f);
+    data.push_back(9.0f);
+    data.push_back(16.0f);
+    bc::vector<bc::half_> input(data.begin(), data.end(), queue);
+
+    bc::vector<bc::half_> output(4, context);
+    bc::transform(
+        input.begin(), input.end(), output.begin(), bc::sqrt<float>(), queue
+    );
+
+    std::vector<bc::half_> host(4);
+    bc::copy(output.begin(), output.end(), host.begin(), queue);
+    BOOST_CHECK_EQUAL(float(host[0]), 1.0f);
+    BOOST_CHECK_EQUAL(float(host[1]), 2.0f);
+    BOOST_CHECK_EQUAL(float(host[2]), 3.0f);
+    BOOST_CHECK_EQUAL(float(host[3]), 4.0f);
+}
+
+BOOST_AUTO_TEST_CASE(reduce_half)
+{
+    // the sum is not representable as a half value, it is accumulated
+    // in float
+    std::vector<bc::half_> data(5000, bc::half_(1.5f));
+    bc::vector<bc::half_> vector(data.begin(), data.end(), queue);
+
+    float sum = 0;
+    bc::reduce(vector.begin(), vector.end(), &sum, bc::plus<float>(), queue);
+    BOOST_CHECK_EQUAL(sum, 7500.0f);
+
+    bc::vector<float> device_sum(1, context);
+    bc::reduce(vector.begin(), vector.end(), device_sum.begin(), queue);
+    CHECK_RANGE_EQUAL(float, 1, device_sum, (7500.0f));
+
+    std::vector<bc::bfloat16_> bdata(100, bc::bfloat16_(2.0f));
+    bc::vector<bc::bfloat16_> bvector(bdata.begin(), bdata.end(), queue);
+
+    float bmax = 0;
+    bc::reduce(bvector.begin(), bvector.end(), &bmax, bc::max<float>(), queue);
+    BOOST_CHECK_EQUAL(bmax, 2.0f);
+}
+
+BOOST_AUTO_TEST_CASE(sort_half)
+{
+    std::vector<bc::half_> data;
+    for(int i = 0; i < 1000; i++){
+        data.push_back(bc::half_(float((i * 37) % 1000 - 500) / 8.0f));
+    }
+    bc::vector<bc::half_> vector(data.begin(), data.end(), queue);
+
+    bc::sort(vector.begin(), vector.end(), queue);
+
+    std::vector<bc::half_> host(data.size());
+    bc::copy(vector.begin(), vector.end(), host.begin(), queue);
+    for(size_t i = 1; i < host.size(); i++){
+        BOOST_CHECK_LE(float(host[i-1]), float(host[i]));
+    }
+    BOOST_CHECK_EQUAL(float(host.front()), -62.5f);
+    BOOST_CHECK_EQUAL(float(host.back()), 62.375f);
+
+    // small ranges are sorted by radix sort too
+    bc::vector<bc::half_> small(data.begin(), data.begin() + 8, queue);
+    bc::sort(small.begin(), small.end(), bc::greater<bc::half_>(), queue);
+
+    std::vector<bc::half_> small_host(8);
+    bc::copy(small.begin(), small.end(), small_host.begin(), queue);
+    for(size_t i = 1; i < small_host.size(); i++){
+        BOOST_CHECK_GE(float(small_host[i-1]), float(small_host[i]));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
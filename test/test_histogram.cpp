@@ -0,0 +1,134 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestHistogram
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/histogram.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(histogram_even_int)
+{
+    int data[] = { 0, 1, 1, 5, 9, 9, 9, 3, 10, -1 };
+    bc::vector<int> input(data, data + 10, queue);
+
+    // bins of width 2 in [0, 10), 10 and -1 are not counted
+    bc::vector<bc::uint_> bins(5, context);
+    bc::vector<bc::uint_>::iterator end = bc::histogram(
+        input.begin(), input.end(), bins.begin(), 5, 0, 10, queue
+    );
+    BOOST_CHECK(end == bins.end());
+    CHECK_RANGE_EQUAL(bc::uint_, 5, bins, (3, 1, 1, 0, 3));
+}
+
+BOOST_AUTO_TEST_CASE(histogram_even_float)
+{
+    float data[] = { 0.0f, 0.1f, 0.5f, 0.75f, 0.99f, 1.0f, -0.5f };
+    bc::vector<float> input(data, data + 7, queue);
+
+    bc::vector<bc::uint_> bins(4, context);
+    bc::histogram(input.begin(), input.end(), bins.begin(), 4, 0.0f, 1.0f, queue);
+    CHECK_RANGE_EQUAL(bc::uint_, 4, bins, (2, 0, 1, 2));
+}
+
+BOOST_AUTO_TEST_CASE(histogram_uchar_pixels)
+{
+    std::vector<bc::uchar_> pixels(100000);
+    for(size_t i = 0; i < pixels.size(); i++){
+        pixels[i] = static_cast<bc::uchar_>((i * 7) % 256);
+    }
+    bc::vector<bc::uchar_> input(pixels.begin(), pixels.end(), queue);
+
+    // one bin per pixel value
+    bc::vector<bc::uint_> bins(256, context);
+    bc::histogram(
+        input.begin(), input.end(), bins.begin(), 256, 0, 256, queue
+    );
+
+    std::vector<bc::uint_> expected(256, 0);
+    for(size_t i = 0; i < pixels.size(); i++){
+        expected[pixels[i]]++;
+    }
+
+    std::vector<bc::uint_> result(256);
+    bc::copy(bins.begin(), bins.end(), result.begin(), queue);
+    BOOST_CHECK(result == expected);
+}
+
+BOOST_AUTO_TEST_CASE(histogram_custom_boundaries)
+{
+    float data[] = { 0.5f, 1.0f, 1.5f, 4.0f, 9.0f, 100.0f, -1.0f, 2.0f };
+    bc::vector<float> input(data, data + 8, queue);
+
+    float boundary_data[] = { 0.0f, 1.0f, 2.0f, 10.0f };
+    bc::vector<float> boundaries(boundary_data, boundary_data + 4, queue);
+
+    bc::vector<int> bins(3, context);
+    bc::histogram(
+        input.begin(), input.end(),
+        boundaries.begin(), boundaries.end(),
+        bins.begin(),
+        queue
+    );
+    CHECK_RANGE_EQUAL(int, 3, bins, (1, 2, 3));
+}
+
+BOOST_AUTO_TEST_CASE(histogram_empty_range)
+{
+    bc::vector<int> input(context);
+
+    bc::vector<bc::uint_> bins(3, context);
+    bc::fill(bins.begin(), bins.end(), bc::uint_(7), queue);
+    bc::histogram(input.begin(), input.end(), bins.begin(), 3, 0, 3, queue);
+    CHECK_RANGE_EQUAL(bc::uint_, 3, bins, (0, 0, 0));
+}
+
+BOOST_AUTO_TEST_CASE(histogram_with_sort)
+{
+    boost::shared_ptr<bc::detail::parameter_cache> parameters =
+        bc::detail::parameter_cache::get_global_cache(device);
+
+    // count all histograms by sorting the bins of the values
+    parameters->set("__boost_histogram", "max_local_bins", 0);
+
+    std::vector<int> data(5000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>((i * 31) % 1200) - 100;
+    }
+    bc::vector<int> input(data.begin(), data.end(), queue);
+
+    bc::vector<bc::uint_> bins(1000, context);
+    bc::histogram(input.begin(), input.end(), bins.begin(), 1000, 0, 1000, queue);
+
+    std::vector<bc::uint_> expected(1000, 0);
+    for(size_t i = 0; i < data.size(); i++){
+        if(data[i] >= 0 && data[i] < 1000){
+            expected[data[i]]++;
+        }
+    }
+
+    std::vector<bc::uint_> result(1000);
+    bc::copy(bins.begin(), bins.end(), result.begin(), queue);
+    BOOST_CHECK(result == expected);
+
+    parameters->reset("__boost_histogram");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
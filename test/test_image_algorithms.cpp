@@ -0,0 +1,208 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestImageAlgorithms
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/image/image2d.hpp>
+#include <boost/compute/image/convolve_image.hpp>
+#include <boost/compute/image/reduce_image.hpp>
+#include <boost/compute/image/transform_image.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// creates a width x height CL_R CL_FLOAT image with the values of data,
+// returns a null image if the format is not supported
+compute::image2d make_float_image(const compute::context &context,
+                                  compute::command_queue &queue,
+                                  size_t width,
+                                  size_t height,
+                                  const float *data)
+{
+    compute::image_format format(CL_R, CL_FLOAT);
+    if(!compute::image2d::is_supported_format(format, context)){
+        std::cerr << "skipping test, image format not supported" << std::endl;
+        return compute::image2d();
+    }
+
+    compute::image2d image(context, width, height, format);
+    if(data){
+        queue.enqueue_write_image(image, image.origin(), image.size(), data);
+    }
+    return image;
+}
+
+std::vector<float> read_float_image(compute::image2d &image,
+                                    compute::command_queue &queue)
+{
+    std::vector<float> data(image.width() * image.height());
+    queue.enqueue_read_image(image, image.origin(), image.size(), &data[0]);
+    return data;
+}
+
+BOOST_AUTO_TEST_CASE(transform_image_square)
+{
+    const float data[] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f };
+    compute::image2d input = make_float_image(context, queue, 3, 2, data);
+    if(!input.get()){
+        return;
+    }
+    compute::image2d output = make_float_image(context, queue, 3, 2, 0);
+
+    BOOST_COMPUTE_FUNCTION(compute::float4_, square, (compute::float4_ texel),
+    {
+        return texel * texel;
+    });
+
+    compute::transform_image(input, output, square, queue);
+
+    std::vector<float> result = read_float_image(output, queue);
+    for(size_t i = 0; i < 6; i++){
+        BOOST_CHECK_CLOSE(result[i], data[i] * data[i], 1e-4f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(transform_image_downsample)
+{
+    const float data[] = {
+        1.0f, 1.0f, 2.0f, 2.0f,
+        1.0f, 1.0f, 2.0f, 2.0f,
+        3.0f, 3.0f, 4.0f, 4.0f,
+        3.0f, 3.0f, 4.0f, 4.0f
+    };
+    compute::image2d input = make_float_image(context, queue, 4, 4, data);
+    if(!input.get()){
+        return;
+    }
+    compute::image2d output = make_float_image(context, queue, 2, 2, 0);
+
+    BOOST_COMPUTE_FUNCTION(compute::float4_, identity, (compute::float4_ texel),
+    {
+        return texel;
+    });
+
+    // each output texel maps to the center of a 2x2 block of the input
+    compute::transform_image(input, output, identity, queue);
+
+    std::vector<float> result = read_float_image(output, queue);
+    BOOST_CHECK_CLOSE(result[0], 1.0f, 1e-4f);
+    BOOST_CHECK_CLOSE(result[1], 2.0f, 1e-4f);
+    BOOST_CHECK_CLOSE(result[2], 3.0f, 1e-4f);
+    BOOST_CHECK_CLOSE(result[3], 4.0f, 1e-4f);
+}
+
+BOOST_AUTO_TEST_CASE(box_blur_impulse)
+{
+    // single texel of value 9 in the middle of a 40x40 image
+    std::vector<float> data(40 * 40, 0.0f);
+    data[20 * 40 + 20] = 9.0f;
+
+    compute::image2d input = make_float_image(context, queue, 40, 40, &data[0]);
+    if(!input.get()){
+        return;
+    }
+    compute::image2d output = make_float_image(context, queue, 40, 40, 0);
+
+    compute::box_blur(input, output, 1, queue);
+
+    std::vector<float> result = read_float_image(output, queue);
+    for(size_t y = 0; y < 40; y++){
+        for(size_t x = 0; x < 40; x++){
+            const bool inside = x >= 19 && x <= 21 && y >= 19 && y <= 21;
+            BOOST_CHECK_SMALL(result[y * 40 + x] - (inside ? 1.0f : 0.0f), 1e-4f);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(gaussian_blur_constant)
+{
+    // blurring a constant image (with clamped edges) does not change it
+    std::vector<float> data(37 * 21, 0.5f);
+
+    compute::image2d input = make_float_image(context, queue, 37, 21, &data[0]);
+    if(!input.get()){
+        return;
+    }
+    compute::image2d output = make_float_image(context, queue, 37, 21, 0);
+
+    compute::gaussian_blur(input, output, 2.0f, queue);
+
+    std::vector<float> result = read_float_image(output, queue);
+    for(size_t i = 0; i < result.size(); i++){
+        BOOST_CHECK_CLOSE(result[i], 0.5f, 1e-3f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(reduce_image_sum)
+{
+    std::vector<float> data(100 * 30);
+    float expected = 0.0f;
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<float>(i % 10);
+        expected += data[i];
+    }
+
+    compute::image2d image = make_float_image(context, queue, 100, 30, &data[0]);
+    if(!image.get()){
+        return;
+    }
+
+    compute::float4_ sum = compute::reduce_image(
+        image, compute::plus<compute::float4_>(), queue
+    );
+    BOOST_CHECK_CLOSE(sum[0], expected, 1e-4f);
+}
+
+BOOST_AUTO_TEST_CASE(image_histogram_rgba8)
+{
+    compute::image_format format(CL_RGBA, CL_UNORM_INT8);
+    if(!compute::image2d::is_supported_format(format, context)){
+        std::cerr << "skipping image_histogram_rgba8 test, image format not supported" << std::endl;
+        return;
+    }
+
+    std::vector<compute::uchar_> pixels(64 * 64 * 4);
+    for(size_t i = 0; i < 64 * 64; i++){
+        pixels[i * 4 + 0] = static_cast<compute::uchar_>(i % 256);
+        pixels[i * 4 + 1] = 0;
+        pixels[i * 4 + 2] = 255;
+        pixels[i * 4 + 3] = static_cast<compute::uchar_>(i % 2 ? 255 : 0);
+    }
+
+    compute::image2d image(context, 64, 64, format);
+    queue.enqueue_write_image(image, image.origin(), image.size(), &pixels[0]);
+
+    compute::vector<compute::uint_> bins(4 * 256, context);
+    compute::image_histogram(image, bins.begin(), 256, queue);
+
+    std::vector<compute::uint_> result(4 * 256);
+    compute::copy(bins.begin(), bins.end(), result.begin(), queue);
+
+    for(size_t b = 0; b < 256; b++){
+        BOOST_CHECK_EQUAL(result[b], compute::uint_(16));
+        BOOST_CHECK_EQUAL(result[256 + b], compute::uint_(b == 0 ? 4096 : 0));
+        BOOST_CHECK_EQUAL(result[512 + b], compute::uint_(b == 255 ? 4096 : 0));
+    }
+    BOOST_CHECK_EQUAL(result[768], compute::uint_(2048));
+    BOOST_CHECK_EQUAL(result[768 + 255], compute::uint_(2048));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
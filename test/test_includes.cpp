@@ -11,6 +11,8 @@
 #define BOOST_TEST_MODULE TestIncludes
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/includes.hpp>
 #include <boost/compute/container/vector.hpp>
@@ -57,4 +59,36 @@ BOOST_AUTO_TEST_CASE(includes_string)
     BOOST_VERIFY(includes == false);
 }
 
+BOOST_AUTO_TEST_CASE(includes_small_subset)
+{
+    // the few values of the second range are searched for in the first
+    std::vector<int> data1(4096);
+    for(size_t i = 0; i < data1.size(); i++){
+        data1[i] = static_cast<int>(i / 3);
+    }
+    bc::vector<int> set1(data1.begin(), data1.end(), queue);
+
+    int dataset2[] = {7, 7, 7, 500, 1300};
+    bc::vector<int> set2(dataset2, dataset2 + 5, queue);
+
+    BOOST_CHECK(bc::includes(set1.begin(), set1.end(),
+                             set2.begin(), set2.end(), queue));
+
+    // four copies of 7, the first range has three
+    set2[3] = 7;
+    BOOST_CHECK(!bc::includes(set1.begin(), set1.end(),
+                              set2.begin(), set2.end(), queue));
+
+    set2[3] = 500;
+    set2[4] = 1400;
+    BOOST_CHECK(!bc::includes(set1.begin(), set1.end(),
+                              set2.begin(), set2.end(), queue));
+
+    // the larger range is never included in the smaller one
+    BOOST_CHECK(!bc::includes(set2.begin(), set2.end(),
+                              set1.begin(), set1.end(), queue));
+    BOOST_CHECK(bc::includes(set1.begin(), set1.end(),
+                             set2.begin(), set2.begin(), queue));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
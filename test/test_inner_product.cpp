@@ -11,6 +11,9 @@
 #define BOOST_TEST_MODULE TestInnerProduct
 #include <boost/test/unit_test.hpp>
 
+#include <limits>
+#include <vector>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/algorithm/inner_product.hpp>
 #include <boost/compute/container/vector.hpp>
@@ -50,4 +53,37 @@ BOOST_AUTO_TEST_CASE(inner_product_counting_iterator)
     );
 }
 
+BOOST_AUTO_TEST_CASE(inner_product_large)
+{
+    const size_t size = 65537;
+
+    std::vector<int> data(size);
+    for(size_t i = 0; i < size; i++){
+        data[i] = static_cast<int>(i % 5);
+    }
+    bc::vector<int> input(data.begin(), data.end(), queue);
+
+    int expected = 0;
+    for(size_t i = 0; i + 1 < size; i++){
+        expected += data[i] * data[i + 1];
+    }
+
+    int product = bc::inner_product(input.begin(),
+                                    input.end() - 1,
+                                    input.begin() + 1,
+                                    0,
+                                    queue);
+    BOOST_CHECK_EQUAL(product, expected);
+
+    // the maximum of the sums of consecutive values
+    int max_sum = bc::inner_product(input.begin(),
+                                    input.end() - 1,
+                                    input.begin() + 1,
+                                    (std::numeric_limits<int>::min)(),
+                                    bc::max<int>(),
+                                    bc::plus<int>(),
+                                    queue);
+    BOOST_CHECK_EQUAL(max_sum, 7);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -11,7 +11,11 @@
 #define BOOST_TEST_MODULE TestInplaceMerge
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/inplace_merge.hpp>
 #include <boost/compute/container/vector.hpp>
 
@@ -44,4 +48,29 @@ BOOST_AUTO_TEST_CASE(simple_merge_int)
     CHECK_RANGE_EQUAL(int, 8, vector, (1, 2, 3, 4, 5, 6, 7, 8));
 }
 
+BOOST_AUTO_TEST_CASE(merge_unequal_halves)
+{
+    // a short first range, many equal values and a sub-range
+    std::vector<int> host(5002);
+    for(size_t i = 0; i < 301; i++){
+        host[i + 1] = int(i * 3) / 2;
+    }
+    for(size_t i = 301; i < 5001; i++){
+        host[i + 1] = int(i - 301) / 7;
+    }
+    host[0] = 1000000;
+    host[5001] = -1;
+
+    compute::vector<int> vector(host.begin(), host.end(), queue);
+    compute::inplace_merge(
+        vector.begin() + 1, vector.begin() + 302, vector.end() - 1, queue
+    );
+
+    std::inplace_merge(host.begin() + 1, host.begin() + 302, host.end() - 1);
+
+    std::vector<int> result(host.size());
+    compute::copy(vector.begin(), vector.end(), result.begin(), queue);
+    BOOST_CHECK(result == host);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -11,11 +11,15 @@
 #define BOOST_TEST_MODULE TestIsPermutation
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/is_permutation.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/scratch_space.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -68,4 +72,87 @@ BOOST_AUTO_TEST_CASE(is_permutation_string)
     BOOST_VERIFY(result == false);
 }
 
+BOOST_AUTO_TEST_CASE(is_permutation_empty_key)
+{
+    // -1 is the value marking empty slots of the hash table
+    int dataset1[] = {-1, 3, -1, 0, 7};
+    bc::vector<int> vector1(dataset1, dataset1 + 5, queue);
+
+    int dataset2[] = {7, -1, 0, -1, 3};
+    bc::vector<int> vector2(dataset2, dataset2 + 5, queue);
+
+    BOOST_CHECK(bc::is_permutation(vector1.begin(), vector1.end(),
+                                   vector2.begin(), vector2.end(), queue));
+
+    vector2[1] = 3;
+    BOOST_CHECK(!bc::is_permutation(vector1.begin(), vector1.end(),
+                                    vector2.begin(), vector2.end(), queue));
+}
+
+BOOST_AUTO_TEST_CASE(is_permutation_large)
+{
+    std::vector<bc::ushort_> data1(10000);
+    for(size_t i = 0; i < data1.size(); i++){
+        data1[i] = static_cast<bc::ushort_>((i * 7) % 1000);
+    }
+    std::vector<bc::ushort_> data2(data1.rbegin(), data1.rend());
+
+    bc::vector<bc::ushort_> vector1(data1.begin(), data1.end(), queue);
+    bc::vector<bc::ushort_> vector2(data2.begin(), data2.end(), queue);
+
+    BOOST_CHECK(bc::is_permutation(vector1.begin(), vector1.end(),
+                                   vector2.begin(), vector2.end(), queue));
+
+    // all distinct values, more than fit in the table
+    for(size_t i = 0; i < data2.size(); i++){
+        data2[i] = static_cast<bc::ushort_>(20000 + i);
+    }
+    bc::copy(data2.begin(), data2.end(), vector2.begin(), queue);
+    BOOST_CHECK(!bc::is_permutation(vector1.begin(), vector1.end(),
+                                    vector2.begin(), vector2.end(), queue));
+}
+
+BOOST_AUTO_TEST_CASE(is_permutation_float)
+{
+    float dataset1[] = {1.5f, 2.0f, -0.5f, 2.0f};
+    bc::vector<float> vector1(dataset1, dataset1 + 4, queue);
+
+    float dataset2[] = {2.0f, -0.5f, 2.0f, 1.5f};
+    bc::vector<float> vector2(dataset2, dataset2 + 4, queue);
+
+    BOOST_CHECK(bc::is_permutation(vector1.begin(), vector1.end(),
+                                   vector2.begin(), vector2.end(), queue));
+
+    vector2[0] = 1.5f;
+    BOOST_CHECK(!bc::is_permutation(vector1.begin(), vector1.end(),
+                                    vector2.begin(), vector2.end(), queue));
+}
+
+#ifdef CL_VERSION_1_1
+BOOST_AUTO_TEST_CASE(is_permutation_with_little_memory)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    std::vector<int> data1(10000);
+    std::vector<int> data2(10000);
+    for(size_t i = 0; i < data1.size(); i++){
+        data1[i] = static_cast<int>((i * 7919) % 1000);
+        data2[data1.size() - 1 - i] = data1[i];
+    }
+    bc::vector<int> vector1(data1.begin(), data1.end(), queue);
+    bc::vector<int> vector2(data2.begin(), data2.end(), queue);
+
+    // too small for the hash table, the ranges are compared on the host
+    bc::scratch_space scratch(bc::buffer(context, 4096), false);
+    bc::scoped_scratch_space use_scratch(scratch);
+
+    BOOST_CHECK(bc::is_permutation(vector1.begin(), vector1.end(),
+                                   vector2.begin(), vector2.end(), queue));
+
+    vector2[0] = -1;
+    BOOST_CHECK(!bc::is_permutation(vector1.begin(), vector1.end(),
+                                    vector2.begin(), vector2.end(), queue));
+}
+#endif // CL_VERSION_1_1
+
 BOOST_AUTO_TEST_SUITE_END()
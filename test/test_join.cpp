@@ -0,0 +1,100 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestJoin
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/experimental/join.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+using compute::uint_;
+using compute::experimental::join_no_match;
+
+BOOST_AUTO_TEST_CASE(inner_join_sorted)
+{
+    int left_data[] = { 1, 2, 2, 4, 5 };
+    int right_data[] = { 2, 2, 3, 4, 4, 4 };
+    compute::vector<int> left(left_data, left_data + 5, queue);
+    compute::vector<int> right(right_data, right_data + 6, queue);
+
+    compute::vector<uint_> left_rows(context);
+    compute::vector<uint_> right_rows(context);
+    size_t count = compute::experimental::inner_join(
+        left.begin(), left.end(), right.begin(), right.end(),
+        left_rows, right_rows, queue
+    );
+    BOOST_CHECK_EQUAL(count, size_t(7));
+    BOOST_CHECK_EQUAL(left_rows.size(), size_t(7));
+    CHECK_RANGE_EQUAL(uint_, 7, left_rows, (1, 1, 2, 2, 3, 3, 3));
+    CHECK_RANGE_EQUAL(uint_, 7, right_rows, (0, 1, 0, 1, 3, 4, 5));
+
+    // no matches
+    count = compute::experimental::inner_join(
+        left.begin(), left.begin() + 1, right.begin(), right.end(),
+        left_rows, right_rows, queue
+    );
+    BOOST_CHECK_EQUAL(count, size_t(0));
+    BOOST_CHECK(left_rows.empty());
+}
+
+BOOST_AUTO_TEST_CASE(left_join_sorted)
+{
+    int left_data[] = { 1, 2, 4, 5 };
+    int right_data[] = { 2, 2, 4 };
+    compute::vector<int> left(left_data, left_data + 4, queue);
+    compute::vector<int> right(right_data, right_data + 3, queue);
+
+    compute::vector<uint_> left_rows(context);
+    compute::vector<uint_> right_rows(context);
+    size_t count = compute::experimental::left_join(
+        left.begin(), left.end(), right.begin(), right.end(),
+        left_rows, right_rows, queue
+    );
+    BOOST_CHECK_EQUAL(count, size_t(5));
+    CHECK_RANGE_EQUAL(uint_, 5, left_rows, (0, 1, 1, 2, 3));
+    CHECK_RANGE_EQUAL(
+        uint_, 5, right_rows, (join_no_match, 0, 1, 2, join_no_match)
+    );
+}
+
+BOOST_AUTO_TEST_CASE(hash_join_unsorted)
+{
+    int left_data[] = { 4, 7, 2, 9 };
+    int right_data[] = { 2, 4, 8, 4, 2 };
+    compute::vector<int> left(left_data, left_data + 4, queue);
+    compute::vector<int> right(right_data, right_data + 5, queue);
+
+    compute::vector<uint_> left_rows(context);
+    compute::vector<uint_> right_rows(context);
+    size_t count = compute::experimental::hash_inner_join(
+        left.begin(), left.end(), right.begin(), right.end(),
+        left_rows, right_rows, queue
+    );
+    BOOST_CHECK_EQUAL(count, size_t(4));
+    CHECK_RANGE_EQUAL(uint_, 4, left_rows, (0, 0, 2, 2));
+    CHECK_RANGE_EQUAL(uint_, 4, right_rows, (1, 3, 0, 4));
+
+    count = compute::experimental::hash_left_join(
+        left.begin(), left.end(), right.begin(), right.end(),
+        left_rows, right_rows, queue
+    );
+    BOOST_CHECK_EQUAL(count, size_t(6));
+    CHECK_RANGE_EQUAL(uint_, 6, left_rows, (0, 0, 1, 2, 2, 3));
+    CHECK_RANGE_EQUAL(
+        uint_, 6, right_rows, (1, 3, join_no_match, 0, 4, join_no_match)
+    );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
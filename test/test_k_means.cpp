@@ -0,0 +1,101 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestKMeans
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/experimental/k_means.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(k_means_float2)
+{
+    // three well separated groups of 1000 points around these centers
+    const float centers[][2] = { { 0, 0 }, { 100, 100 }, { -100, 50 } };
+
+    std::vector<compute::float2_> host_points;
+    for(int group = 0; group < 3; group++){
+        for(int i = 0; i < 1000; i++){
+            host_points.push_back(compute::float2_(
+                centers[group][0] + float(i % 10) - 4.5f,
+                centers[group][1] + float(i / 10 % 10) - 4.5f
+            ));
+        }
+    }
+
+    compute::vector<compute::float2_> points(
+        host_points.begin(), host_points.end(), queue
+    );
+    compute::vector<compute::uint_> labels(points.size(), context);
+
+    // start from one (off-center) point of each group
+    compute::float2_ initial[] = {
+        host_points[0], host_points[1000], host_points[2000]
+    };
+    compute::vector<compute::float2_> centroids(initial, initial + 3, queue);
+
+    size_t iterations = compute::experimental::k_means(
+        points.begin(), points.end(), centroids.begin(), centroids.end(),
+        labels.begin(), 50, 0, queue
+    );
+    BOOST_CHECK(iterations > 0);
+    BOOST_CHECK(iterations < 50);
+
+    std::vector<compute::uint_> host_labels(labels.size());
+    compute::copy(labels.begin(), labels.end(), host_labels.begin(), queue);
+    for(size_t i = 0; i < host_labels.size(); i++){
+        BOOST_CHECK_EQUAL(host_labels[i], compute::uint_(i / 1000));
+    }
+
+    std::vector<compute::float2_> host_centroids(3);
+    compute::copy(centroids.begin(), centroids.end(), host_centroids.begin(), queue);
+    for(int group = 0; group < 3; group++){
+        BOOST_CHECK_CLOSE(host_centroids[group][0] + 1000.f, centers[group][0] + 1000.f, 1e-3);
+        BOOST_CHECK_CLOSE(host_centroids[group][1] + 1000.f, centers[group][1] + 1000.f, 1e-3);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(k_means_float)
+{
+    float data[] = { 1, 2, 3, 10, 11, 12, 20, 21, 22 };
+    compute::vector<float> points(data, data + 9, queue);
+    compute::vector<compute::uint_> labels(9, context);
+
+    // the second centroid starts without any points
+    float initial[] = { 0, 100, 30 };
+    compute::vector<float> centroids(initial, initial + 3, queue);
+
+    compute::experimental::k_means(
+        points.begin(), points.end(), centroids.begin(), centroids.end(),
+        labels.begin(), 20, 0, queue
+    );
+    CHECK_RANGE_EQUAL(compute::uint_, 9, labels, (0, 0, 0, 0, 0, 0, 2, 2, 2));
+    CHECK_RANGE_EQUAL(float, 3, centroids, (6.5f, 100.f, 21.f));
+
+    // a single iteration with a tolerance larger than the changes
+    compute::copy(initial, initial + 3, centroids.begin(), queue);
+    size_t iterations = compute::experimental::k_means(
+        points.begin(), points.end(), centroids.begin(), centroids.end(),
+        labels.begin(), 20, 9, queue
+    );
+    BOOST_CHECK_EQUAL(iterations, size_t(1));
+    CHECK_RANGE_EQUAL(float, 3, centroids, (0.f, 100.f, 30.f));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
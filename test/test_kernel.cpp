@@ -15,6 +15,8 @@
 #include <boost/compute/kernel.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/utility/source.hpp>
+#include <boost/compute/detail/kernel_cache.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
 
 #include "context_setup.hpp"
 
@@ -148,4 +150,137 @@ BOOST_AUTO_TEST_CASE(get_arg_info)
 }
 #endif // CL_VERSION_1_2
 
+BOOST_AUTO_TEST_CASE(set_same_arg_twice)
+{
+    compute::kernel k = compute::kernel::create_with_source(
+        "__kernel void foo(__global int *x, int y) { *x = y; }", "foo", context
+    );
+
+    compute::buffer x(context, sizeof(int));
+    k.set_arg(0, x);
+
+    int value = 0;
+
+    // setting an argument to its current value is skipped
+    k.set_arg(1, 1);
+    k.set_arg(1, 1);
+    queue.enqueue_1d_range_kernel(k, 0, 1, 0);
+    queue.enqueue_read_buffer(x, 0, sizeof(int), &value);
+    BOOST_CHECK_EQUAL(value, 1);
+
+    // copies of a kernel object know the arguments set through the others
+    compute::kernel copy = k;
+    copy.set_arg(1, 2);
+    k.set_arg(1, 1);
+    queue.enqueue_1d_range_kernel(copy, 0, 1, 0);
+    queue.enqueue_read_buffer(x, 0, sizeof(int), &value);
+    BOOST_CHECK_EQUAL(value, 1);
+
+    // arguments set directly on the cl_kernel
+    const int three = 3;
+    clSetKernelArg(k.get(), 1, sizeof(int), &three);
+    k.reset_args();
+    k.set_arg(1, 1);
+    queue.enqueue_1d_range_kernel(k, 0, 1, 0);
+    queue.enqueue_read_buffer(x, 0, sizeof(int), &value);
+    BOOST_CHECK_EQUAL(value, 1);
+}
+
+BOOST_AUTO_TEST_CASE(set_arg_does_not_retain_buffer)
+{
+    compute::kernel k = compute::kernel::create_with_source(
+        "__kernel void foo(__global int *x) { *x = 1; }", "foo", context
+    );
+
+    // the kernel does not keep the buffer alive once it is destroyed
+    cl_mem mem = 0;
+    {
+        compute::buffer x(context, sizeof(int));
+        k.set_arg(0, x);
+        k.set_arg(0, x);
+
+        mem = x.get();
+        clRetainMemObject(mem);
+    }
+    compute::uint_ count = 0;
+    clGetMemObjectInfo(
+        mem, CL_MEM_REFERENCE_COUNT, sizeof(count), &count, 0
+    );
+    BOOST_CHECK_EQUAL(count, compute::uint_(1));
+    clReleaseMemObject(mem);
+
+    // and a new buffer is always set, even if it reuses the handle
+    int value = 0;
+    compute::buffer y(context, sizeof(int));
+    queue.enqueue_write_buffer(y, 0, sizeof(int), &value);
+    k.set_arg(0, y);
+    queue.enqueue_task(k);
+    queue.enqueue_read_buffer(y, 0, sizeof(int), &value);
+    BOOST_CHECK_EQUAL(value, 1);
+}
+
+BOOST_AUTO_TEST_CASE(kernel_cache)
+{
+    compute::program program = compute::program::build_with_source(
+        "__kernel void foo(int x) { }", context
+    );
+
+    compute::detail::kernel_cache cache(4);
+
+    // a kernel which is no longer in use is reused
+    cl_kernel k1 = cache.get(program, "foo").get();
+    cl_kernel k2 = cache.get(program, "foo").get();
+    BOOST_CHECK(k1 == k2);
+    BOOST_CHECK_EQUAL(cache.size(), size_t(1));
+
+    // a kernel still in use is not handed out a second time
+    compute::kernel a = cache.get(program, "foo");
+    compute::kernel b = cache.get(program, "foo");
+    BOOST_CHECK(a.get() != b.get());
+    BOOST_CHECK_EQUAL(a.name(), "foo");
+    BOOST_CHECK_EQUAL(b.name(), "foo");
+
+    // a copy keeps the kernel checked out
+    const cl_kernel handle = a.get();
+    compute::kernel c = a;
+    a = compute::kernel();
+    b = compute::kernel();
+    BOOST_CHECK(cache.get(program, "foo").get() != handle);
+    BOOST_CHECK(c.get() == handle);
+
+    // ownership is tracked by the cache, not by the reference count
+    clRetainKernel(handle);
+    c = compute::kernel();
+    compute::kernel d = cache.get(program, "foo");
+    compute::kernel e = cache.get(program, "foo");
+    BOOST_CHECK(d.get() == handle || e.get() == handle);
+    clReleaseKernel(handle);
+}
+
+BOOST_AUTO_TEST_CASE(resource_usage)
+{
+    compute::kernel foo = compute::kernel::create_with_source(
+        "__kernel __attribute__((reqd_work_group_size(1, 1, 1)))\n"
+        "void foo(__global int *x) { __local int tile[16]; tile[0] = 1; x[0] = tile[0]; }",
+        "foo", context
+    );
+
+    compute::kernel_resource_usage usage = foo.get_resource_usage(device);
+    BOOST_CHECK(usage.work_group_size >= 1);
+    BOOST_CHECK(usage.work_group_size <= device.max_work_group_size());
+    BOOST_CHECK(usage.preferred_work_group_size_multiple >= 1);
+    BOOST_CHECK_EQUAL(usage.compile_work_group_size[0], size_t(1));
+    BOOST_CHECK_EQUAL(usage.compile_work_group_size[1], size_t(1));
+    BOOST_CHECK_EQUAL(usage.compile_work_group_size[2], size_t(1));
+
+    compute::detail::meta_kernel k("resource_usage");
+    k << "const uint i = get_global_id(0);\n";
+
+    const size_t work_group_size = k.work_group_size(queue, 100);
+    BOOST_CHECK(work_group_size >= 1);
+    BOOST_CHECK(work_group_size <= 64);
+    BOOST_CHECK_EQUAL(work_group_size & (work_group_size - 1), size_t(0));
+    BOOST_CHECK(k.resource_usage(queue).work_group_size >= work_group_size);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,114 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestKernelVariants
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/algorithm/count_if.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/kernel_variants.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+#include <boost/compute/detail/sub_group.hpp>
+
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+static bool never(const compute::device &)
+{
+    return false;
+}
+
+BOOST_AUTO_TEST_CASE(device_requirements)
+{
+    BOOST_CHECK(compute::device_requirements().matches(device));
+    BOOST_CHECK(compute::device_requirements().type(device.type()).matches(device));
+    BOOST_CHECK(compute::device_requirements().vendor(device.vendor()).matches(device));
+    BOOST_CHECK(!compute::device_requirements().vendor("no such vendor").matches(device));
+    BOOST_CHECK(!compute::device_requirements().extension("cl_no_such_extension").matches(device));
+    BOOST_CHECK(!compute::device_requirements().version(99, 0).matches(device));
+    BOOST_CHECK(!compute::device_requirements().predicate(&never).matches(device));
+}
+
+BOOST_AUTO_TEST_CASE(default_variants)
+{
+    compute::kernel_variant_registry registry;
+
+    const bool local_memory =
+        compute::detail::device_profile::get(device)->has_local_memory();
+    const bool sub_groups =
+        compute::detail::sub_group_functions(device).supported();
+
+    const std::string expected =
+        !local_memory ? "threads" : sub_groups ? "ballot" : "reduce";
+    BOOST_CHECK_EQUAL(registry.select("count_if", device), expected);
+
+    BOOST_CHECK_EQUAL(registry.variants("count_if").size(), size_t(3));
+    BOOST_CHECK_EQUAL(registry.select("no_such_algorithm", device, "none"), "none");
+}
+
+BOOST_AUTO_TEST_CASE(insert_and_erase)
+{
+    compute::kernel_variant_registry registry;
+
+    registry.insert("scan", "generic", compute::device_requirements());
+    BOOST_CHECK_EQUAL(registry.select("scan", device), "generic");
+
+    // variants for other devices are not selected
+    registry.insert(
+        "scan", "other", compute::device_requirements().vendor("no such vendor"), 10
+    );
+    BOOST_CHECK_EQUAL(registry.select("scan", device), "generic");
+
+    // of variants with the same priority the last inserted one is selected
+    registry.insert("scan", "tuned", compute::device_requirements());
+    BOOST_CHECK_EQUAL(registry.select("scan", device), "tuned");
+
+    registry.erase("scan", "tuned");
+    BOOST_CHECK_EQUAL(registry.select("scan", device), "generic");
+    BOOST_CHECK_EQUAL(registry.variants("scan").size(), size_t(2));
+}
+
+BOOST_AUTO_TEST_CASE(count_if_variants)
+{
+    using compute::lambda::_1;
+
+    compute::vector<int> vector(100000, context);
+    compute::iota(vector.begin(), vector.end(), 0, queue);
+
+    boost::shared_ptr<compute::kernel_variant_registry> registry =
+        compute::kernel_variant_registry::get_global_registry();
+
+    const char *variants[] = { "threads", "reduce", "ballot" };
+    for(size_t i = 0; i < 3; i++){
+        compute::device_requirements requirements;
+        if(variants[i] == std::string("ballot")){
+            // ballots need sub-group functions
+            requirements.sub_groups();
+        }
+
+        registry->insert("count_if", variants[i], requirements, 10);
+        BOOST_CHECK_EQUAL(
+            compute::count_if(vector.begin(), vector.end(), _1 % 3 == 0, queue),
+            size_t(33334)
+        );
+    }
+
+    // restore the default variants
+    registry->insert("count_if", "threads", compute::device_requirements(), 0);
+    registry->insert("count_if", "reduce", compute::device_requirements().local_memory(), 1);
+    registry->insert(
+        "count_if", "ballot", compute::device_requirements().local_memory().sub_groups(), 2
+    );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
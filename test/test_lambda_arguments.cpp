@@ -0,0 +1,87 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestLambdaArguments
+#include <boost/test/unit_test.hpp>
+
+#define BOOST_COMPUTE_VALUES_AS_KERNEL_ARGUMENTS
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/iterator/constant_iterator.hpp>
+#include <boost/compute/detail/program_source_cache.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(lambda_terminals)
+{
+    using compute::lambda::_1;
+
+    compute::detail::program_source_cache &cache =
+        compute::detail::program_source_cache::get_global_cache();
+
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> input(data, data + 4, queue);
+    compute::vector<int> output(4, context);
+
+    compute::transform(
+        input.begin(), input.end(), output.begin(), _1 * 2, queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, output, (2, 4, 6, 8));
+    const size_t programs = cache.size();
+
+    // a different constant reuses the program of the first transform
+    compute::transform(
+        input.begin(), input.end(), output.begin(), _1 * 3, queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, output, (3, 6, 9, 12));
+    BOOST_CHECK_EQUAL(cache.size(), programs);
+
+    // bool terminals are still inserted as literals
+    compute::vector<int> flags(4, context);
+    compute::transform(
+        input.begin(), input.end(), flags.begin(), (_1 > 2) == true, queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, flags, (0, 0, 1, 1));
+}
+
+BOOST_AUTO_TEST_CASE(constant_iterator_values)
+{
+    compute::detail::program_source_cache &cache =
+        compute::detail::program_source_cache::get_global_cache();
+
+    compute::vector<float> vector(4, context);
+
+    compute::copy(
+        compute::make_constant_iterator(1.5f, 0),
+        compute::make_constant_iterator(1.5f, 4),
+        vector.begin(),
+        queue
+    );
+    CHECK_RANGE_EQUAL(float, 4, vector, (1.5f, 1.5f, 1.5f, 1.5f));
+    const size_t programs = cache.size();
+
+    compute::copy(
+        compute::make_constant_iterator(2.5f, 0),
+        compute::make_constant_iterator(2.5f, 4),
+        vector.begin(),
+        queue
+    );
+    CHECK_RANGE_EQUAL(float, 4, vector, (2.5f, 2.5f, 2.5f, 2.5f));
+    BOOST_CHECK_EQUAL(cache.size(), programs);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -13,7 +13,9 @@
 
 #include <boost/compute/container/string.hpp>
 #include <boost/compute/container/basic_string.hpp>
+#include <boost/compute/algorithm/fill.hpp>
 #include <boost/compute/algorithm/lexicographical_compare.hpp>
+#include <boost/compute/container/vector.hpp>
 
 #include "context_setup.hpp"
 #include "check_macros.hpp"
@@ -69,4 +71,61 @@ BOOST_AUTO_TEST_CASE(lexicographical_compare_number)
                                                         vector4.end()) == true);
 }
 
+BOOST_AUTO_TEST_CASE(lexicographical_compare_first_difference)
+{
+    // only the first difference decides the result
+    int data1[] = { 2, 1, 1, 1 };
+    int data2[] = { 1, 2, 2, 2 };
+
+    boost::compute::vector<int> vector1(data1, data1 + 4, queue);
+    boost::compute::vector<int> vector2(data2, data2 + 4, queue);
+
+    BOOST_CHECK(boost::compute::lexicographical_compare(vector1.begin(),
+                                                        vector1.end(),
+                                                        vector2.begin(),
+                                                        vector2.end(),
+                                                        queue) == false);
+
+    BOOST_CHECK(boost::compute::lexicographical_compare(vector2.begin(),
+                                                        vector2.end(),
+                                                        vector1.begin(),
+                                                        vector1.end(),
+                                                        queue) == true);
+
+    // ranges starting at an offset
+    BOOST_CHECK(boost::compute::lexicographical_compare(vector1.begin() + 1,
+                                                        vector1.end(),
+                                                        vector2.begin() + 1,
+                                                        vector2.end(),
+                                                        queue) == true);
+
+    // an empty range is less than any non-empty range
+    BOOST_CHECK(boost::compute::lexicographical_compare(vector1.begin(),
+                                                        vector1.begin(),
+                                                        vector2.begin(),
+                                                        vector2.end(),
+                                                        queue) == true);
+}
+
+BOOST_AUTO_TEST_CASE(lexicographical_compare_large_equal_prefix)
+{
+    boost::compute::vector<int> vector1(100000, context);
+    boost::compute::vector<int> vector2(100001, context);
+    boost::compute::fill(vector1.begin(), vector1.end(), 3, queue);
+    boost::compute::fill(vector2.begin(), vector2.end(), 3, queue);
+
+    // a proper prefix is less than the longer range
+    BOOST_CHECK(boost::compute::lexicographical_compare(vector1.begin(),
+                                                        vector1.end(),
+                                                        vector2.begin(),
+                                                        vector2.end(),
+                                                        queue) == true);
+
+    BOOST_CHECK(boost::compute::lexicographical_compare(vector2.begin(),
+                                                        vector2.end(),
+                                                        vector1.begin(),
+                                                        vector1.end(),
+                                                        queue) == false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,168 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestLinearAlgebra
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/container/valarray.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/linear_algebra.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(dot_product_axpy)
+{
+    float x_data[] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+    float y_data[] = { 5.0f, 4.0f, 3.0f, 2.0f, 1.0f };
+    bc::vector<float> x(x_data, x_data + 5, queue);
+    bc::vector<float> y(y_data, y_data + 5, queue);
+
+    BOOST_CHECK_CLOSE(bc::dot_product(x.begin(), x.end(), y.begin(), queue), 35.0f, 1e-4f);
+    BOOST_CHECK_EQUAL(bc::dot_product(x.begin(), x.begin(), y.begin(), queue), 0.0f);
+
+    bc::axpy(2.0f, x.begin(), x.end(), y.begin(), queue);
+    CHECK_RANGE_EQUAL(float, 5, y, (7.0f, 8.0f, 9.0f, 10.0f, 11.0f));
+
+    bc::valarray<float> a(x_data, 5, context);
+    bc::valarray<float> b(y_data, 5, context);
+    BOOST_CHECK_CLOSE(bc::dot_product(a, b, queue), 35.0f, 1e-4f);
+}
+
+BOOST_AUTO_TEST_CASE(gemv_gemm)
+{
+    // dimensions which are not multiples of the tile sizes
+    const size_t m = 37;
+    const size_t n = 29;
+    const size_t depth = 43;
+
+    std::vector<float> a(m * depth);
+    std::vector<float> b(depth * n);
+    for(size_t i = 0; i < a.size(); i++){
+        a[i] = static_cast<float>(i % 7) - 3.0f;
+    }
+    for(size_t i = 0; i < b.size(); i++){
+        b[i] = static_cast<float>(i % 5) - 2.0f;
+    }
+
+    bc::vector<float> device_a(a.begin(), a.end(), queue);
+    bc::vector<float> device_b(b.begin(), b.end(), queue);
+    bc::vector<float> device_c(m * n, 1.0f, queue);
+
+    boost::shared_ptr<bc::detail::parameter_cache> parameters =
+        bc::detail::parameter_cache::get_global_cache(device);
+
+    const bc::uint_ tile_sizes[] = { 16, 4 };
+    for(size_t t = 0; t < 2; t++){
+        parameters->set("__boost_gemm", "tile_size", tile_sizes[t]);
+
+        bc::fill(device_c.begin(), device_c.end(), 1.0f, queue);
+        bc::gemm(m, n, depth, 2.0f, device_a.begin(), device_b.begin(),
+                 3.0f, device_c.begin(), queue);
+
+        std::vector<float> c(m * n);
+        bc::copy(device_c.begin(), device_c.end(), c.begin(), queue);
+        for(size_t i = 0; i < m; i++){
+            for(size_t j = 0; j < n; j++){
+                float sum = 0;
+                for(size_t l = 0; l < depth; l++){
+                    sum += a[i * depth + l] * b[l * n + j];
+                }
+                BOOST_CHECK_EQUAL(c[i * n + j], 2.0f * sum + 3.0f);
+            }
+        }
+    }
+    parameters->reset("__boost_gemm");
+
+    // y = A * x with the first column of b as x
+    bc::vector<float> y(m, context);
+    bc::gemv(m, depth, 1.0f, device_a.begin(), device_b.begin(),
+             0.0f, y.begin(), queue);
+
+    std::vector<float> host_y(m);
+    bc::copy(y.begin(), y.end(), host_y.begin(), queue);
+    for(size_t i = 0; i < m; i++){
+        float sum = 0;
+        for(size_t l = 0; l < depth; l++){
+            sum += a[i * depth + l] * b[l];
+        }
+        BOOST_CHECK_EQUAL(host_y[i], sum);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(batched_matrix_multiply_inverse)
+{
+    // two 3x3 matrices stored as consecutive floats
+    float data[] = {
+        2.0f, 0.0f, 0.0f,  0.0f, 4.0f, 0.0f,  0.0f, 0.0f, 8.0f,
+        0.0f, 1.0f, 0.0f,  1.0f, 0.0f, 0.0f,  0.0f, 0.0f, 2.0f
+    };
+    bc::vector<float> matrices(data, data + 18, queue);
+    bc::vector<float> inverses(18, context);
+    bc::vector<float> products(18, context);
+
+    bc::batched_matrix_inverse(
+        3, matrices.begin(), matrices.end(), inverses.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(
+        float, 18, inverses,
+        (0.5f, 0.0f, 0.0f, 0.0f, 0.25f, 0.0f, 0.0f, 0.0f, 0.125f,
+         0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.5f)
+    );
+
+    bc::batched_matrix_multiply(
+        3, matrices.begin(), matrices.end(), inverses.begin(), products.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(
+        float, 18, products,
+        (1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+         1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f)
+    );
+
+    // 4x4 matrices stored as float16
+    bc::float16_ m;
+    const float values[] = {
+        1.0f, 2.0f, 0.0f, 3.0f,
+        2.0f, 1.0f, 2.0f, 0.0f,
+        0.0f, 3.0f, 1.0f, 2.0f,
+        2.0f, 0.0f, 2.0f, 1.0f
+    };
+    for(size_t i = 0; i < 16; i++){
+        m[i] = values[i];
+    }
+    bc::vector<bc::float16_> m4(4, m, queue);
+    bc::vector<bc::float16_> m4_inverse(4, context);
+    bc::vector<bc::float16_> m4_product(4, context);
+
+    bc::batched_matrix_inverse(m4.begin(), m4.end(), m4_inverse.begin(), queue);
+    bc::batched_matrix_multiply(
+        m4.begin(), m4.end(), m4_inverse.begin(), m4_product.begin(), queue
+    );
+
+    std::vector<bc::float16_> host(4);
+    bc::copy(m4_product.begin(), m4_product.end(), host.begin(), queue);
+    for(size_t i = 0; i < 4; i++){
+        for(size_t j = 0; j < 16; j++){
+            const float expected = j % 5 == 0 ? 1.0f : 0.0f;
+            BOOST_CHECK_SMALL(host[i][j] - expected, 1e-4f);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
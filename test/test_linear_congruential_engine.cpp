@@ -11,6 +11,11 @@
 #define BOOST_TEST_MODULE TestLinearCongruentialEngine
 #include <boost/test/unit_test.hpp>
 
+#include <string>
+
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/program.hpp>
+#include <boost/compute/algorithm/equal.hpp>
 #include <boost/compute/random/linear_congruential_engine.hpp>
 #include <boost/compute/container/vector.hpp>
 
@@ -63,4 +68,55 @@ BOOST_AUTO_TEST_CASE(discard_uint)
     );
 }
 
+BOOST_AUTO_TEST_CASE(generate_streams)
+{
+    using boost::compute::uint_;
+
+    typedef boost::compute::linear_congruential_engine<uint_> engine_type;
+
+    // four streams of eight numbers each continue each other
+    engine_type rng(queue);
+    boost::compute::vector<uint_> states(4, context);
+    rng.generate_streams(states.begin(), states.end(), 8, queue);
+
+    const std::string source = engine_type::stream_source() +
+        "__kernel void draw(__global uint *states, __global uint *output)\n"
+        "{\n"
+        "    const uint i = get_global_id(0);\n"
+        "    uint state = states[i];\n"
+        "    for(uint j = 0; j < 8; j++){\n"
+        "        output[i * 8 + j] = boost_lcg_next(&state);\n"
+        "    }\n"
+        "    boost_lcg_discard(&state, 2);\n"
+        "    states[i] = state;\n"
+        "}\n";
+    boost::compute::kernel kernel =
+        boost::compute::program::build_with_source(source, context)
+            .create_kernel("draw");
+
+    boost::compute::vector<uint_> output(32, context);
+    kernel.set_arg(0, states.get_buffer());
+    kernel.set_arg(1, output.get_buffer());
+    queue.enqueue_1d_range_kernel(kernel, 0, 4, 0);
+
+    engine_type reference(queue);
+    boost::compute::vector<uint_> expected(44, context);
+    reference.generate(expected.begin(), expected.end(), queue);
+    BOOST_CHECK(
+        boost::compute::equal(output.begin(), output.end(), expected.begin(), queue)
+    );
+
+    // the discarded numbers after the eight numbers of the first stream
+    CHECK_RANGE_EQUAL(
+        uint_, 1, states,
+        (uint_(3237988505))
+    );
+
+    // the engine continues after the last stream
+    rng.generate(output.begin(), output.begin() + 12, queue);
+    BOOST_CHECK(
+        boost::compute::equal(output.begin(), output.begin() + 12, expected.begin() + 32, queue)
+    );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
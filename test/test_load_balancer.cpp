@@ -0,0 +1,110 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestLoadBalancer
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/experimental/load_balancer.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// one profiled queue and one without profiling on the same device, with
+// small chunks so the range is split into many of them
+static compute::experimental::load_balancer
+make_balancer(const compute::command_queue &queue)
+{
+    std::vector<compute::command_queue> queues;
+    queues.push_back(
+        compute::command_queue(
+            queue.get_context(),
+            queue.get_device(),
+            compute::command_queue::enable_profiling
+        )
+    );
+    queues.push_back(
+        compute::command_queue(queue.get_context(), queue.get_device())
+    );
+
+    return compute::experimental::load_balancer(queues, 64);
+}
+
+BOOST_AUTO_TEST_CASE(transform)
+{
+    compute::experimental::load_balancer balancer = make_balancer(queue);
+
+    compute::vector<int> input(1000, context);
+    compute::iota(input.begin(), input.end(), 0, queue);
+    queue.finish();
+
+    compute::vector<int> output(1000, context);
+    compute::experimental::transform(
+        input.begin(), input.end(), output.begin(), compute::abs<int>(), balancer
+    );
+    BOOST_CHECK(balancer.throughput(0) > 0);
+    BOOST_CHECK_EQUAL(balancer.throughput(1), 0);
+
+    std::vector<int> host(1000);
+    compute::copy(output.begin(), output.end(), host.begin(), queue);
+    for(size_t i = 0; i < host.size(); i++){
+        BOOST_CHECK_EQUAL(host[i], static_cast<int>(i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(for_each)
+{
+    compute::experimental::load_balancer balancer = make_balancer(queue);
+
+    BOOST_COMPUTE_FUNCTION(void, add_one, (int &x),
+    {
+        x += 1;
+    });
+
+    compute::vector<int> vector(500, context);
+    compute::fill(vector.begin(), vector.end(), 1, queue);
+    queue.finish();
+
+    compute::experimental::for_each(vector.begin(), vector.end(), add_one, balancer);
+
+    std::vector<int> host(500);
+    compute::copy(vector.begin(), vector.end(), host.begin(), queue);
+    BOOST_CHECK(std::count(host.begin(), host.end(), 2) == 500);
+}
+
+BOOST_AUTO_TEST_CASE(transform_reduce)
+{
+    compute::experimental::load_balancer balancer = make_balancer(queue);
+
+    compute::vector<int> input(1000, context);
+    compute::iota(input.begin(), input.end(), -500, queue);
+    queue.finish();
+
+    // sum of the absolute values
+    int sum = 0;
+    compute::experimental::transform_reduce(
+        input.begin(), input.end(), &sum,
+        compute::abs<int>(), compute::plus<int>(),
+        balancer
+    );
+    BOOST_CHECK_EQUAL(sum, 500 * 501 / 2 + 499 * 500 / 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,92 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestMappedFile
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/mapped_file.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(read_file)
+{
+    const char *path = "test_mapped_file_read.bin";
+
+    std::vector<int> values(1000);
+    for(size_t i = 0; i < values.size(); i++){
+        values[i] = int(i) * 3;
+    }
+    {
+        std::ofstream stream(path, std::ios::out | std::ios::binary);
+        stream.write(reinterpret_cast<const char *>(&values[0]),
+                     values.size() * sizeof(int));
+    }
+
+    {
+        compute::mapped_file<int> file(path);
+        BOOST_CHECK_EQUAL(file.size(), size_t(1000));
+
+        compute::vector<int> vector(file.size(), context);
+        compute::copy(file.begin(), file.end(), vector.begin(), queue);
+        CHECK_RANGE_EQUAL(int, 4, vector, (0, 3, 6, 9));
+
+        compute::vector<int> copy(1000, context);
+        compute::copy_from_file<int>(path, copy.begin(), queue);
+        CHECK_RANGE_EQUAL(int, 4, copy, (0, 3, 6, 9));
+    }
+
+    std::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(write_file)
+{
+    const char *path = "test_mapped_file_write.bin";
+
+    // larger than the staging threshold so the copies are chunked
+    const size_t count = 1 << 20;
+    compute::vector<int> vector(count, context);
+    compute::iota(vector.begin(), vector.end(), 0, queue);
+
+    compute::copy_to_file(vector.begin(), vector.end(), path, queue);
+
+    {
+        compute::mapped_file<int> file(path);
+        BOOST_CHECK_EQUAL(file.size(), count);
+        BOOST_CHECK_EQUAL(file.data()[0], 0);
+        BOOST_CHECK_EQUAL(file.data()[count - 1], int(count - 1));
+    }
+
+    std::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(empty_file)
+{
+    const char *path = "test_mapped_file_empty.bin";
+
+    {
+        compute::mapped_file<float> file(path, 0);
+        BOOST_CHECK(file.empty());
+        BOOST_CHECK(file.begin() == file.end());
+    }
+
+    std::remove(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -11,11 +11,17 @@
 #define BOOST_TEST_MODULE TestMappedView
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/sort.hpp>
 #include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/mapped_double_buffer.hpp>
 #include <boost/compute/container/mapped_view.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/lambda.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -52,6 +58,51 @@ BOOST_AUTO_TEST_CASE(sort)
     view.unmap(queue);
 }
 
+BOOST_AUTO_TEST_CASE(map_async)
+{
+    int data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    compute::mapped_view<int> view(data, 8, context);
+    compute::fill(view.begin(), view.end(), 3, queue);
+
+    compute::future<void> mapped = view.map_async(CL_MAP_READ, queue);
+    BOOST_CHECK(view.is_mapped());
+    mapped.wait();
+    for(int i = 0; i < 8; i++){
+        BOOST_CHECK_EQUAL(data[i], 3);
+    }
+
+    view.unmap_async(queue).wait();
+    BOOST_CHECK(!view.is_mapped());
+}
+
+BOOST_AUTO_TEST_CASE(double_buffer)
+{
+    using compute::lambda::_1;
+
+    compute::mapped_double_buffer<int> staging(16, CL_MAP_WRITE, queue);
+    BOOST_CHECK_EQUAL(staging.size(), size_t(16));
+
+    compute::vector<int> result(16 * 4, context);
+    for(int chunk = 0; chunk < 4; chunk++){
+        int *host = staging.host_data();
+        for(int i = 0; i < 16; i++){
+            host[i] = chunk * 16 + i;
+        }
+
+        compute::future<void> mapped = staging.swap();
+        compute::transform(
+            staging.begin(), staging.end(), result.begin() + chunk * 16, _1 * 2, queue
+        );
+        mapped.wait();
+    }
+
+    std::vector<int> host_result(16 * 4);
+    compute::copy(result.begin(), result.end(), host_result.begin(), queue);
+    for(int i = 0; i < 16 * 4; i++){
+        BOOST_CHECK_EQUAL(host_result[i], i * 2);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(mapped_view_reduce_doctest)
 {
 //! [reduce]
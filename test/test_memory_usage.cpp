@@ -0,0 +1,141 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestMemoryUsage
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/is_sorted.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/reverse.hpp>
+#include <boost/compute/algorithm/scratch_size.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/utility/buffer_pool.hpp>
+#include <boost/compute/utility/memory_usage.hpp>
+#include <boost/compute/utility/scratch_space.hpp>
+
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(track_containers)
+{
+    boost::shared_ptr<compute::memory_usage> usage =
+        compute::memory_usage::get_global_usage(context);
+
+    const size_t before = usage->current(compute::memory_usage::containers);
+    {
+        compute::vector<int> vector(1000, context);
+        BOOST_CHECK_EQUAL(
+            usage->current(compute::memory_usage::containers),
+            before + 1000 * sizeof(int)
+        );
+        BOOST_CHECK(usage->peak() >= usage->current());
+    }
+    BOOST_CHECK_EQUAL(usage->current(compute::memory_usage::containers), before);
+}
+
+BOOST_AUTO_TEST_CASE(track_temporaries)
+{
+    boost::shared_ptr<compute::memory_usage> usage =
+        compute::memory_usage::get_global_usage(context);
+    compute::buffer_pool::get_global_pool(context)->trim();
+
+    compute::vector<int> vector(100000, context);
+    compute::iota(vector.begin(), vector.end(), 0, queue);
+    compute::reverse(vector.begin(), vector.end(), queue);
+
+    usage->reset_peak();
+    const size_t before = usage->current();
+
+    compute::sort(vector.begin(), vector.end(), queue);
+    BOOST_CHECK(compute::is_sorted(vector.begin(), vector.end(), queue));
+
+    // the temporaries of the sort are returned to the pool
+    BOOST_CHECK_EQUAL(usage->current(compute::memory_usage::temporaries), size_t(0));
+    BOOST_CHECK(usage->current(compute::memory_usage::cached) > 0);
+
+    const size_t scratch = compute::sort_scratch_size<int>(vector.size(), queue);
+    BOOST_CHECK(scratch >= vector.size() * sizeof(int));
+    BOOST_CHECK(usage->peak(compute::memory_usage::temporaries) >= vector.size() * sizeof(int));
+    BOOST_CHECK(usage->peak() >= before + vector.size() * sizeof(int));
+
+    compute::buffer_pool::get_global_pool(context)->trim();
+    BOOST_CHECK_EQUAL(usage->current(compute::memory_usage::cached), size_t(0));
+}
+
+BOOST_AUTO_TEST_CASE(scratch_size)
+{
+    BOOST_CHECK_EQUAL(compute::sort_scratch_size<int>(10, queue), size_t(0));
+    BOOST_CHECK(
+        compute::is_permutation_scratch_size<int>(1000, queue) >=
+        2 * 1000 * sizeof(int) + compute::sort_scratch_size<int>(1000, queue)
+    );
+    BOOST_CHECK(
+        compute::inplace_merge_scratch_size<float>(300, 700) >= 1000 * sizeof(float)
+    );
+    BOOST_CHECK(compute::set_operation_scratch_size<int>(1000, 1000, queue) > 0);
+    BOOST_CHECK_EQUAL(compute::set_operation_scratch_size<int>(0, 0, queue), size_t(0));
+}
+
+#ifdef CL_VERSION_1_1
+BOOST_AUTO_TEST_CASE(sort_with_scratch_space)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    const size_t size = 100000;
+    compute::vector<int> vector(size, context);
+    compute::iota(vector.begin(), vector.end(), 0, queue);
+    compute::reverse(vector.begin(), vector.end(), queue);
+
+    const size_t scratch_size = compute::sort_scratch_size<int>(size, queue);
+    compute::scratch_space scratch(
+        compute::buffer(context, 2 * scratch_size), false
+    );
+
+    {
+        compute::scoped_scratch_space use_scratch(scratch);
+        compute::sort(vector.begin(), vector.end(), queue);
+        queue.finish();
+    }
+
+    BOOST_CHECK(compute::is_sorted(vector.begin(), vector.end(), queue));
+    BOOST_CHECK(scratch.peak() > 0);
+    BOOST_CHECK(scratch.peak() <= scratch.size());
+    BOOST_CHECK_EQUAL(scratch.used(), size_t(0));
+}
+
+BOOST_AUTO_TEST_CASE(scratch_space_without_fallback)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    BOOST_COMPUTE_FUNCTION(bool, descending, (int a, int b),
+    {
+        return a > b;
+    });
+
+    compute::vector<int> vector(100000, context);
+    compute::iota(vector.begin(), vector.end(), 0, queue);
+
+    // too small for the temporaries of the merge sort, which has no
+    // lower-footprint strategy
+    compute::scratch_space scratch(compute::buffer(context, 4096), false);
+
+    compute::scoped_scratch_space use_scratch(scratch);
+    BOOST_CHECK_THROW(
+        compute::sort(vector.begin(), vector.end(), descending, queue),
+        compute::opencl_error
+    );
+}
+#endif // CL_VERSION_1_1
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,107 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestMergeRuns
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/merge_runs.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/types/pair.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(merge_runs_int)
+{
+    int data[] = { 1, 4, 7,  2, 5, 8,  0,  3, 6, 9 };
+    compute::uint_ offsets_data[] = { 0, 3, 6, 6, 7, 10 };
+
+    compute::vector<int> input(data, data + 10, queue);
+    compute::vector<compute::uint_> offsets(offsets_data, offsets_data + 6, queue);
+    compute::vector<int> output(10, context);
+
+    compute::vector<int>::iterator end = compute::merge_runs(
+        input.begin(), offsets.begin(), offsets.end(), output.begin(), queue
+    );
+    BOOST_CHECK(end == output.end());
+    CHECK_RANGE_EQUAL(int, 10, output, (0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
+
+BOOST_AUTO_TEST_CASE(merge_runs_stable)
+{
+    // equal values keep the order of their runs
+    std::pair<int, int> data[] = {
+        std::make_pair(1, 0), std::make_pair(2, 0),
+        std::make_pair(1, 1), std::make_pair(2, 1),
+        std::make_pair(1, 2)
+    };
+    compute::uint_ offsets_data[] = { 0, 2, 4, 5 };
+
+    compute::vector<std::pair<int, int> > input(data, data + 5, queue);
+    compute::vector<compute::uint_> offsets(offsets_data, offsets_data + 4, queue);
+    compute::vector<std::pair<int, int> > output(5, context);
+
+    BOOST_COMPUTE_FUNCTION(bool, compare_first, (std::pair<int, int> a, std::pair<int, int> b),
+    {
+        return a.first < b.first;
+    });
+
+    compute::merge_runs(
+        input.begin(), offsets.begin(), offsets.end(), output.begin(), compare_first, queue
+    );
+
+    std::vector<std::pair<int, int> > host(5);
+    compute::copy(output.begin(), output.end(), host.begin(), queue);
+    BOOST_CHECK(host[0] == std::make_pair(1, 0));
+    BOOST_CHECK(host[1] == std::make_pair(1, 1));
+    BOOST_CHECK(host[2] == std::make_pair(1, 2));
+    BOOST_CHECK(host[3] == std::make_pair(2, 0));
+    BOOST_CHECK(host[4] == std::make_pair(2, 1));
+}
+
+BOOST_AUTO_TEST_CASE(merge_runs_many)
+{
+    // more runs than are merged by a single pass
+    std::vector<int> host;
+    std::vector<compute::uint_> host_offsets(1, 0);
+    for(int run = 0; run < 1500; run++){
+        const int size = (run * 37) % 100;
+        for(int i = 0; i < size; i++){
+            host.push_back((run * 7 + i * 13) % 1000 + i * 1000);
+        }
+        std::sort(host.end() - size, host.end());
+        host_offsets.push_back(static_cast<compute::uint_>(host.size()));
+    }
+
+    compute::vector<int> input(host.begin(), host.end(), queue);
+    compute::vector<compute::uint_> offsets(
+        host_offsets.begin(), host_offsets.end(), queue
+    );
+    compute::vector<int> output(host.size(), context);
+
+    compute::merge_runs(
+        input.begin(), offsets.begin(), offsets.end(), output.begin(), queue
+    );
+
+    std::sort(host.begin(), host.end());
+    std::vector<int> result(host.size());
+    compute::copy(output.begin(), output.end(), result.begin(), queue);
+    BOOST_CHECK(result == host);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,110 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestMultiQueue
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/is_sorted.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/experimental/multi_queue.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// three queues on the same device exercise the splitting and combining
+// the same way as one queue per device
+static compute::experimental::multi_queue
+make_queues(const compute::command_queue &queue)
+{
+    std::vector<compute::command_queue> queues;
+    queues.push_back(queue);
+    queues.push_back(compute::command_queue(queue.get_context(), queue.get_device()));
+    queues.push_back(compute::command_queue(queue.get_context(), queue.get_device()));
+    return compute::experimental::multi_queue(queues);
+}
+
+BOOST_AUTO_TEST_CASE(offset)
+{
+    compute::experimental::multi_queue queues = make_queues(queue);
+    BOOST_CHECK_EQUAL(queues.size(), size_t(3));
+    BOOST_CHECK_EQUAL(queues.offset(10, 0), size_t(0));
+    BOOST_CHECK_EQUAL(queues.offset(10, 1), size_t(4));
+    BOOST_CHECK_EQUAL(queues.offset(10, 2), size_t(7));
+    BOOST_CHECK_EQUAL(queues.offset(10, 3), size_t(10));
+    BOOST_CHECK_EQUAL(queues.offset(2, 3), size_t(2));
+}
+
+BOOST_AUTO_TEST_CASE(copy_transform_reduce)
+{
+    compute::experimental::multi_queue queues = make_queues(queue);
+
+    std::vector<int> host(1000);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = static_cast<int>(i);
+    }
+
+    compute::vector<int> input(host.size(), context);
+    compute::experimental::copy(host.begin(), host.end(), input.begin(), queues);
+
+    compute::vector<int> output(host.size(), context);
+    compute::experimental::transform(
+        input.begin(), input.end(), output.begin(), compute::abs<int>(), queues
+    );
+
+    int sum = 0;
+    compute::experimental::reduce(output.begin(), output.end(), &sum, queues);
+    BOOST_CHECK_EQUAL(sum, 999 * 1000 / 2);
+
+    int max = 0;
+    compute::experimental::reduce(
+        output.begin(), output.end(), &max, compute::max<int>(), queues
+    );
+    BOOST_CHECK_EQUAL(max, 999);
+
+    // fewer elements than queues
+    compute::experimental::reduce(output.begin() + 1, output.begin() + 3, &sum, queues);
+    BOOST_CHECK_EQUAL(sum, 3);
+}
+
+BOOST_AUTO_TEST_CASE(sort)
+{
+    compute::experimental::multi_queue queues = make_queues(queue);
+
+    std::vector<int> host(1001);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = static_cast<int>((i * 7919) % 1001);
+    }
+    compute::vector<int> vector(host.begin(), host.end(), queue);
+
+    compute::experimental::sort(vector.begin(), vector.end(), queues);
+    BOOST_CHECK(compute::is_sorted(vector.begin(), vector.end(), queue));
+
+    compute::experimental::sort(
+        vector.begin(), vector.end(), compute::greater<int>(), queues
+    );
+    BOOST_CHECK(compute::is_sorted(
+        vector.begin(), vector.end(), compute::greater<int>(), queue
+    ));
+
+    std::vector<int> sorted(host.size());
+    compute::copy(vector.begin(), vector.end(), sorted.begin(), queue);
+    std::sort(host.begin(), host.end());
+    BOOST_CHECK(std::equal(sorted.rbegin(), sorted.rend(), host.begin()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
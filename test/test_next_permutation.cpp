@@ -11,9 +11,13 @@
 #define BOOST_TEST_MODULE TestNextPermutation
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/next_permutation.hpp>
 #include <boost/compute/container/vector.hpp>
 
@@ -68,4 +72,38 @@ BOOST_AUTO_TEST_CASE(next_permutation_string)
     BOOST_VERIFY(result == false);
 }
 
+BOOST_AUTO_TEST_CASE(next_permutation_large)
+{
+    // only the last few values change in most steps
+    std::vector<int> data(4096);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>(i / 2);
+    }
+    bc::vector<int> vector(data.begin(), data.end(), queue);
+
+    for(int step = 0; step < 4; step++){
+        bool expected = std::next_permutation(data.begin(), data.end());
+        bool result = bc::next_permutation(vector.begin(), vector.end(), queue);
+        BOOST_CHECK_EQUAL(result, expected);
+
+        std::vector<int> host(vector.size());
+        bc::copy(vector.begin(), vector.end(), host.begin(), queue);
+        BOOST_CHECK(host == data);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(next_permutation_last)
+{
+    int dataset[] = {4, 3, 3, 1};
+    bc::vector<int> vector(dataset, dataset + 4, queue);
+
+    bool result = bc::next_permutation(vector.begin(), vector.end(), queue);
+    BOOST_VERIFY(result == false);
+    CHECK_RANGE_EQUAL(int, 4, vector, (1, 3, 3, 4));
+
+    result = bc::next_permutation(vector.begin(), vector.begin() + 1, queue);
+    BOOST_VERIFY(result == false);
+    CHECK_RANGE_EQUAL(int, 4, vector, (1, 3, 3, 4));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -11,11 +11,16 @@
 #define BOOST_TEST_MODULE TestNormalDistribution
 #include <boost/test/unit_test.hpp>
 
+#include <cmath>
+#include <vector>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/count_if.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/random/default_random_engine.hpp>
+#include <boost/compute/random/linear_congruential_engine.hpp>
 #include <boost/compute/random/normal_distribution.hpp>
 #include <boost/compute/lambda.hpp>
 
@@ -39,4 +44,46 @@ distribution.generate(vec.begin(), vec.end(), engine, queue);
 //! [generate]
 }
 
+template<class Engine>
+void check_normal_moments(Engine &engine, boost::compute::command_queue &queue)
+{
+    const size_t n = 100001;
+
+    boost::compute::vector<float> vec(n, queue.get_context());
+
+    boost::compute::normal_distribution<float> distribution(5.0f, 2.0f);
+    distribution.generate(vec.begin(), vec.end(), engine, queue);
+
+    std::vector<float> host_vec(n);
+    boost::compute::copy(vec.begin(), vec.end(), host_vec.begin(), queue);
+
+    double sum = 0;
+    for(size_t i = 0; i < n; i++){
+        BOOST_REQUIRE(host_vec[i] == host_vec[i]);
+        sum += host_vec[i];
+    }
+    const double mean = sum / n;
+
+    double sum_sq = 0;
+    for(size_t i = 0; i < n; i++){
+        sum_sq += (host_vec[i] - mean) * (host_vec[i] - mean);
+    }
+    const double stddev = std::sqrt(sum_sq / n);
+
+    BOOST_CHECK_CLOSE(mean, 5.0, 1.0);
+    BOOST_CHECK_CLOSE(stddev, 2.0, 2.0);
+}
+
+BOOST_AUTO_TEST_CASE(normal_distribution_philox)
+{
+    boost::compute::philox4x32 engine(queue);
+    check_normal_moments(engine, queue);
+}
+
+BOOST_AUTO_TEST_CASE(normal_distribution_linear_congruential)
+{
+    boost::compute::linear_congruential_engine<> engine(queue);
+    check_normal_moments(engine, queue);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
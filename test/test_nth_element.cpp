@@ -11,12 +11,18 @@
 #define BOOST_TEST_MODULE TestNthElement
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/copy_n.hpp>
 #include <boost/compute/algorithm/is_partitioned.hpp>
 #include <boost/compute/algorithm/nth_element.hpp>
 #include <boost/compute/algorithm/partition_point.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/lambda.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -110,4 +116,50 @@ BOOST_AUTO_TEST_CASE(nth_element_comparator)
     CHECK_RANGE_EQUAL(int, 10, vector, (9, 15, 1, 4, 9, 9, 4, 15, 12, 1));
 }
 
+BOOST_AUTO_TEST_CASE(nth_element_large)
+{
+    // large enough to be selected with several passes on the device
+    std::vector<float> data(1000003);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<float>((i * 7919) % 100003) * 0.5f;
+    }
+    boost::compute::vector<float> vector(data.begin(), data.end(), queue);
+
+    const size_t nth = 123456;
+    boost::compute::nth_element(
+        vector.begin(), vector.begin() + nth, vector.end(),
+        boost::compute::greater<float>(), queue
+    );
+
+    std::vector<float> expected = data;
+    std::nth_element(expected.begin(), expected.begin() + nth, expected.end(),
+                     std::greater<float>());
+
+    std::vector<float> host(data.size());
+    boost::compute::copy(vector.begin(), vector.end(), host.begin(), queue);
+    BOOST_CHECK_EQUAL(host[nth], expected[nth]);
+    BOOST_CHECK(*std::min_element(host.begin(), host.begin() + nth) >= host[nth]);
+    BOOST_CHECK(*std::max_element(host.begin() + nth + 1, host.end()) <= host[nth]);
+
+    // the values are only rearranged
+    std::sort(host.begin(), host.end());
+    std::sort(expected.begin(), expected.end());
+    BOOST_CHECK(host == expected);
+}
+
+BOOST_AUTO_TEST_CASE(nth_element_large_equal)
+{
+    std::vector<int> data(100000, 7);
+    data[500] = 3;
+    data[99000] = 9;
+    boost::compute::vector<int> vector(data.begin(), data.end(), queue);
+
+    boost::compute::nth_element(
+        vector.begin(), vector.begin() + 50000, vector.end(), queue
+    );
+    BOOST_CHECK_EQUAL(vector[0], 3);
+    BOOST_CHECK_EQUAL(vector[50000], 7);
+    BOOST_CHECK_EQUAL(vector[99999], 9);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
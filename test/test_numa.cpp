@@ -0,0 +1,65 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestNuma
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/algorithm/count.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/experimental/multi_queue.hpp>
+#include <boost/compute/experimental/numa.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(numa_nodes)
+{
+    // at least the device itself, sub-devices only for numa nodes
+    std::vector<compute::device> nodes = compute::experimental::numa_nodes(device);
+    BOOST_CHECK(!nodes.empty());
+    if(nodes.size() == 1){
+        BOOST_CHECK(nodes[0] == device);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(numa_vector_transform)
+{
+    compute::context numa = compute::experimental::numa_context(device);
+    compute::command_queue numa_queue(numa, numa.get_devices()[0]);
+    compute::experimental::multi_queue queues(numa);
+
+    // the allocator zeroes the memory while placing it
+    compute::vector<int, compute::experimental::numa_allocator<int> > a(1000, numa);
+    BOOST_CHECK_EQUAL(
+        compute::count(a.begin(), a.end(), 0, numa_queue), size_t(1000)
+    );
+
+    compute::iota(a.begin(), a.end(), 0, numa_queue);
+    numa_queue.finish();
+
+    compute::vector<int, compute::experimental::numa_allocator<int> > b(1000, numa);
+    compute::experimental::transform(
+        a.begin(), a.end(), b.begin(), compute::abs<int>(), queues
+    );
+
+    int sum = 0;
+    compute::experimental::reduce(b.begin(), b.end(), &sum, queues);
+    BOOST_CHECK_EQUAL(sum, 999 * 1000 / 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,95 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestOfflineCache
+#include <boost/test/unit_test.hpp>
+
+#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <boost/compute/detail/offline_cache.hpp>
+
+namespace compute = boost::compute;
+
+static std::string temp_cache_path()
+{
+    return (boost::filesystem::temp_directory_path() /
+            boost::filesystem::unique_path("boost_compute_test_%%%%-%%%%")).string();
+}
+
+BOOST_AUTO_TEST_CASE(store_and_load)
+{
+    const std::string path = temp_cache_path();
+
+    compute::detail::offline_cache cache(path, 1024);
+
+    std::vector<unsigned char> binary;
+    BOOST_CHECK(!cache.load("0123456789abcdef", binary));
+
+    std::vector<unsigned char> data(100, 0x42);
+    cache.store("0123456789abcdef", data);
+
+    BOOST_CHECK(cache.load("0123456789abcdef", binary));
+    BOOST_CHECK(binary == data);
+
+    // a second cache sharing the directory sees the stored binary
+    compute::detail::offline_cache other(path, 1024);
+    binary.clear();
+    BOOST_CHECK(other.load("0123456789abcdef", binary));
+    BOOST_CHECK(binary == data);
+
+    cache.clear();
+    BOOST_CHECK(!cache.load("0123456789abcdef", binary));
+
+    boost::filesystem::remove_all(path);
+}
+
+BOOST_AUTO_TEST_CASE(evict_over_limit)
+{
+    const std::string path = temp_cache_path();
+
+    compute::detail::offline_cache cache(path, 1000);
+
+    // store more than the size limit
+    std::vector<unsigned char> data(300, 0x7f);
+    cache.store("aa00", data);
+    cache.store("aa01", data);
+    cache.store("aa02", data);
+    cache.store("aa03", data);
+
+    // the most recently stored binary is kept
+    std::vector<unsigned char> binary;
+    BOOST_CHECK(cache.load("aa03", binary));
+    BOOST_CHECK(binary == data);
+
+    // and the total size is within the limit
+    size_t count = 0;
+    const char *hashes[] = { "aa00", "aa01", "aa02", "aa03" };
+    for(size_t i = 0; i < 4; i++){
+        if(cache.load(hashes[i], binary)){
+            count++;
+        }
+    }
+    BOOST_CHECK(count * data.size() <= cache.max_size());
+
+    // binaries larger than the limit are not stored
+    cache.store("bb00", std::vector<unsigned char>(2000, 1));
+    BOOST_CHECK(!cache.load("bb00", binary));
+
+    boost::filesystem::remove_all(path);
+}
+#else
+BOOST_AUTO_TEST_CASE(offline_cache_disabled)
+{
+    // offline cache is not enabled
+}
+#endif // BOOST_COMPUTE_USE_OFFLINE_CACHE
@@ -0,0 +1,64 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestPartialSort
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/partial_sort.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(partial_sort_int)
+{
+    int data[] = { 9, 15, 1, 4, 9, 9, 4, 15, 12, 1 };
+    compute::vector<int> vector(data, data + 10, queue);
+
+    compute::partial_sort(
+        vector.begin(), vector.begin() + 4, vector.end(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, vector, (1, 1, 4, 4));
+}
+
+BOOST_AUTO_TEST_CASE(top_k_large)
+{
+    std::vector<int> data(500000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>((i * 104729) % 1000003);
+    }
+    compute::vector<int> vector(data.begin(), data.end(), queue);
+
+    // the 100 largest values in descending order
+    compute::partial_sort(
+        vector.begin(), vector.begin() + 100, vector.end(),
+        compute::greater<int>(), queue
+    );
+
+    std::partial_sort(data.begin(), data.begin() + 100, data.end(),
+                      std::greater<int>());
+
+    std::vector<int> host(100);
+    compute::copy(vector.begin(), vector.begin() + 100, host.begin(), queue);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        host.begin(), host.end(), data.begin(), data.begin() + 100
+    );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
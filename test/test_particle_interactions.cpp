@@ -0,0 +1,185 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestParticleInteractions
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/experimental/all_pairs.hpp>
+#include <boost/compute/experimental/uniform_grid.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// counts the neighbors within a distance of one
+BOOST_COMPUTE_FUNCTION(compute::uint_, count_neighbor, (compute::float4_ p, compute::float4_ q),
+{
+    const float4 r = (float4)(q.xyz - p.xyz, 0);
+    return dot(r, r) < 1.0f ? 1 : 0;
+});
+
+BOOST_COMPUTE_FUNCTION(compute::uint_, count_neighbor_2d, (compute::float2_ p, compute::float2_ q),
+{
+    const float2 r = q - p;
+    return dot(r, r) < 1.0f ? 1 : 0;
+});
+
+// pseudo-random points in [0, 10)^3
+static std::vector<compute::float4_> make_points(size_t count)
+{
+    std::vector<compute::float4_> points;
+    compute::uint_ seed = 1;
+    for(size_t i = 0; i < count; i++){
+        float xyz[3];
+        for(int j = 0; j < 3; j++){
+            seed = seed * 1103515245u + 12345u;
+            xyz[j] = float((seed >> 8) % 10000) / 1000.0f;
+        }
+        points.push_back(compute::float4_(xyz[0], xyz[1], xyz[2], 1.0f));
+    }
+    return points;
+}
+
+static std::vector<compute::uint_>
+count_neighbors_on_host(const std::vector<compute::float4_> &points)
+{
+    std::vector<compute::uint_> counts(points.size(), 0);
+    for(size_t i = 0; i < points.size(); i++){
+        for(size_t j = 0; j < points.size(); j++){
+            float d2 = 0;
+            for(int k = 0; k < 3; k++){
+                const float d = points[j][k] - points[i][k];
+                d2 += d * d;
+            }
+            if(i != j && d2 < 1.0f){
+                counts[i]++;
+            }
+        }
+    }
+    return counts;
+}
+
+BOOST_AUTO_TEST_CASE(all_pairs_reduce_count)
+{
+    // not a multiple of the work-group size
+    std::vector<compute::float4_> host_points = make_points(1000);
+    compute::vector<compute::float4_> points(
+        host_points.begin(), host_points.end(), queue
+    );
+    compute::vector<compute::uint_> counts(points.size(), context);
+
+    compute::vector<compute::uint_>::iterator end =
+        compute::experimental::all_pairs_reduce(
+            points.begin(), points.end(), counts.begin(),
+            compute::uint_(0), count_neighbor, queue
+        );
+    BOOST_CHECK(end == counts.end());
+
+    std::vector<compute::uint_> host_counts(counts.size());
+    compute::copy(counts.begin(), counts.end(), host_counts.begin(), queue);
+    BOOST_CHECK(host_counts == count_neighbors_on_host(host_points));
+}
+
+BOOST_AUTO_TEST_CASE(all_pairs_reduce_gravity)
+{
+    BOOST_COMPUTE_FUNCTION(compute::float4_, gravity, (compute::float4_ p, compute::float4_ q),
+    {
+        const float4 r = (float4)(q.xyz - p.xyz, 0);
+        return r * (q.w / pow(dot(r, r), 1.5f));
+    });
+
+    // two unit masses at distance two attract each other with 1/4
+    compute::float4_ data[] = {
+        compute::float4_(0, 0, 0, 1), compute::float4_(2, 0, 0, 1)
+    };
+    compute::vector<compute::float4_> points(data, data + 2, queue);
+    compute::vector<compute::float4_> forces(2, context);
+
+    compute::experimental::all_pairs_reduce(
+        points.begin(), points.end(), forces.begin(),
+        compute::float4_(0, 0, 0, 0), gravity, queue
+    );
+
+    std::vector<compute::float4_> host_forces(2);
+    compute::copy(forces.begin(), forces.end(), host_forces.begin(), queue);
+    BOOST_CHECK_CLOSE(host_forces[0][0], 0.25f, 1e-3);
+    BOOST_CHECK_CLOSE(host_forces[1][0], -0.25f, 1e-3);
+    BOOST_CHECK_EQUAL(host_forces[0][1], 0.0f);
+}
+
+BOOST_AUTO_TEST_CASE(uniform_grid_neighbor_reduce)
+{
+    std::vector<compute::float4_> host_points = make_points(2000);
+    compute::vector<compute::float4_> points(
+        host_points.begin(), host_points.end(), queue
+    );
+
+    // cells as large as the radius, the grid covers [0, 8)^3 so some of
+    // the points are clamped to its border cells
+    compute::experimental::uniform_grid<compute::float4_> grid(
+        compute::float4_(0, 0, 0, 0), 1.0f, 8, 8, 8, context
+    );
+    BOOST_CHECK_EQUAL(grid.cell_count(), size_t(512));
+    grid.build(points.begin(), points.end(), queue);
+
+    std::vector<compute::uint_> starts(grid.cell_count());
+    std::vector<compute::uint_> ends(grid.cell_count());
+    compute::copy(grid.cell_starts().begin(), grid.cell_starts().end(), starts.begin(), queue);
+    compute::copy(grid.cell_ends().begin(), grid.cell_ends().end(), ends.begin(), queue);
+    size_t total = 0;
+    for(size_t cell = 0; cell < starts.size(); cell++){
+        total += ends[cell] - starts[cell];
+    }
+    BOOST_CHECK_EQUAL(total, host_points.size());
+
+    compute::vector<compute::uint_> counts(points.size(), context);
+    grid.neighbor_reduce(
+        points.begin(), points.end(), counts.begin(),
+        compute::uint_(0), count_neighbor, queue
+    );
+
+    std::vector<compute::uint_> host_counts(counts.size());
+    compute::copy(counts.begin(), counts.end(), host_counts.begin(), queue);
+    BOOST_CHECK(host_counts == count_neighbors_on_host(host_points));
+}
+
+BOOST_AUTO_TEST_CASE(uniform_grid_2d)
+{
+    compute::float2_ data[] = {
+        compute::float2_(0.5f, 0.5f), compute::float2_(1.2f, 0.5f),
+        compute::float2_(3.5f, 3.5f), compute::float2_(0.5f, 1.4f)
+    };
+    compute::vector<compute::float2_> points(data, data + 4, queue);
+
+    compute::experimental::uniform_grid<compute::float2_> grid(
+        compute::float2_(0, 0), 1.0f, 4, 4, 1, context
+    );
+    BOOST_CHECK_EQUAL(grid.dimensions(), size_t(2));
+    grid.build(points.begin(), points.end(), queue);
+    CHECK_RANGE_EQUAL(compute::uint_, 4, grid.cells(), (0, 1, 4, 15));
+    CHECK_RANGE_EQUAL(compute::uint_, 4, grid.indices(), (0, 1, 3, 2));
+
+    compute::vector<compute::uint_> counts(4, context);
+    grid.neighbor_reduce(
+        points.begin(), points.end(), counts.begin(),
+        compute::uint_(0), count_neighbor_2d, queue
+    );
+    CHECK_RANGE_EQUAL(compute::uint_, 4, counts, (2, 1, 0, 1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
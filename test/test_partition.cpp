@@ -13,6 +13,7 @@
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
+#include <boost/compute/lambda.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/partition.hpp>
 #include <boost/compute/algorithm/partition_copy.hpp>
@@ -79,4 +80,21 @@ BOOST_AUTO_TEST_CASE(partition_small_vector)
     CHECK_RANGE_EQUAL(float, 2, vector, (-1.0f, 1.0f));
 }
 
+BOOST_AUTO_TEST_CASE(partition_copy_int)
+{
+    int data[] = { 1, -2, 3, -4, -5, 6, 7, -8 };
+    bc::vector<int> input(data, data + 8, queue);
+    bc::vector<int> positive(8, context);
+    bc::vector<int> negative(8, context);
+
+    std::pair<bc::vector<int>::iterator, bc::vector<int>::iterator> ends =
+        bc::partition_copy(input.begin(), input.end(),
+                           positive.begin(), negative.begin(),
+                           bc::_1 > 0, queue);
+    BOOST_CHECK(ends.first == positive.begin() + 4);
+    BOOST_CHECK(ends.second == negative.begin() + 4);
+    CHECK_RANGE_EQUAL(int, 4, positive, (1, 3, 6, 7));
+    CHECK_RANGE_EQUAL(int, 4, negative, (-2, -4, -5, -8));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,75 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestPersistentTransform
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/experimental/persistent_transform.hpp>
+
+#include "context_setup.hpp"
+#include "opencl_version_check.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+}
+
+#if defined(CL_VERSION_2_0) && !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+BOOST_AUTO_TEST_CASE(transform_batches)
+{
+    REQUIRES_OPENCL_VERSION(2, 0);
+
+    if(!compute::experimental::persistent_transform<int, int>::is_supported(device)){
+        std::cout << "skipping test: device does not support svm atomics" << std::endl;
+        return;
+    }
+
+    using compute::lambda::_1;
+
+    compute::experimental::persistent_transform<int, int>
+        processor(_1 * 2 + 1, 1000, 3, queue);
+    BOOST_CHECK_EQUAL(processor.batch_capacity(), size_t(1000));
+    BOOST_CHECK_EQUAL(processor.slot_count(), size_t(3));
+
+    // batches of different sizes, with up to all slots in use
+    for(int batch = 0; batch < 20; batch++){
+        const size_t pushed = size_t(batch % 3) + 1;
+        for(size_t j = 0; j < pushed; j++){
+            std::vector<int> input(1000 - 100 * j);
+            for(size_t i = 0; i < input.size(); i++){
+                input[i] = batch * 1000 + int(i);
+            }
+            processor.push(input.begin(), input.end());
+        }
+        BOOST_CHECK_EQUAL(processor.pending(), pushed);
+
+        for(size_t j = 0; j < pushed; j++){
+            std::vector<int> output(1000, -1);
+            std::vector<int>::iterator end = processor.pop(output.begin());
+            BOOST_CHECK_EQUAL(size_t(end - output.begin()), 1000 - 100 * j);
+            for(size_t i = 0; i < 1000 - 100 * j; i++){
+                BOOST_CHECK_EQUAL(output[i], (batch * 1000 + int(i)) * 2 + 1);
+            }
+        }
+    }
+
+    processor.push(static_cast<int *>(0), static_cast<int *>(0));
+    std::vector<int> output(1);
+    BOOST_CHECK(processor.pop(output.begin()) == output.begin());
+
+    processor.stop();
+}
+#endif // CL_VERSION_2_0 && !BOOST_NO_CXX11_HDR_ATOMIC
+
+BOOST_AUTO_TEST_SUITE_END()
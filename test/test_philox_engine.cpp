@@ -0,0 +1,146 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestPhiloxEngine
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/program.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/equal.hpp>
+#include <boost/compute/random/philox_engine.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+BOOST_AUTO_TEST_CASE(generate_uint)
+{
+    using boost::compute::uint_;
+
+    boost::compute::philox4x32 rng(queue);
+
+    boost::compute::vector<uint_> vector(8, context);
+
+    rng.generate(vector.begin(), vector.end(), queue);
+
+    // known answers for the key and counters (0, 0, 0, 0) and (1, 0, 0, 0)
+    CHECK_RANGE_EQUAL(
+        uint_, 8, vector,
+        (uint_(1713891541),
+         uint_(3781805453),
+         uint_(3159862348),
+         uint_(2600524760),
+         uint_(4175744164),
+         uint_(1555169499),
+         uint_(2980410603),
+         uint_(159317863))
+    );
+}
+
+BOOST_AUTO_TEST_CASE(discard_uint)
+{
+    using boost::compute::uint_;
+
+    boost::compute::philox4x32 rng(queue);
+
+    boost::compute::vector<uint_> vector(5, context);
+
+    rng.discard(3, queue);
+    rng.generate(vector.begin(), vector.end(), queue);
+
+    CHECK_RANGE_EQUAL(
+        uint_, 5, vector,
+        (uint_(2600524760),
+         uint_(4175744164),
+         uint_(1555169499),
+         uint_(2980410603),
+         uint_(159317863))
+    );
+}
+
+BOOST_AUTO_TEST_CASE(generate_in_parts)
+{
+    using boost::compute::uint_;
+
+    boost::compute::vector<uint_> whole(100003, context);
+    boost::compute::philox4x32 rng1(queue, 42);
+    rng1.generate(whole.begin(), whole.end(), queue);
+
+    // generating the same range in unaligned parts gives the same sequence
+    boost::compute::vector<uint_> parts(100003, context);
+    boost::compute::philox4x32 rng2(queue, 42);
+    rng2.generate(parts.begin(), parts.begin() + 1, queue);
+    rng2.generate(parts.begin() + 1, parts.begin() + 50002, queue);
+    rng2.generate(parts.begin() + 50002, parts.end(), queue);
+
+    BOOST_CHECK(
+        boost::compute::equal(whole.begin(), whole.end(), parts.begin(), queue)
+    );
+}
+
+BOOST_AUTO_TEST_CASE(generate_streams)
+{
+    using boost::compute::uint_;
+    using boost::compute::uint4_;
+
+    boost::compute::philox4x32 rng(queue, 42);
+
+    boost::compute::vector<uint4_> states(3, context);
+    rng.generate_streams(states.begin(), states.begin() + 2, queue);
+    rng.generate_streams(states.begin() + 2, states.end(), queue);
+    CHECK_RANGE_EQUAL(
+        uint4_, 3, states,
+        (uint4_(0, 0, 1, 42), uint4_(0, 0, 2, 42), uint4_(0, 0, 3, 42))
+    );
+
+    const std::string source = boost::compute::philox4x32::stream_source() +
+        "__kernel void draw(__global uint4 *states, __global uint4 *output)\n"
+        "{\n"
+        "    const uint i = get_global_id(0);\n"
+        "    uint4 state = states[i];\n"
+        "    output[i * 2] = boost_philox4x32_next(&state);\n"
+        "    boost_philox4x32_discard(&state, 0xFFFFFFFFul);\n"
+        "    output[i * 2 + 1] = boost_philox4x32_next(&state);\n"
+        "    states[i] = state;\n"
+        "}\n";
+    boost::compute::kernel kernel =
+        boost::compute::program::build_with_source(source, context)
+            .create_kernel("draw");
+
+    // the stream with the counter word of the engine and the default key
+    // has the numbers of the engine
+    const uint4_ engine_state(0, 0, 0, 0);
+    boost::compute::copy(&engine_state, &engine_state + 1, states.begin(), queue);
+    boost::compute::vector<uint4_> output(6, context);
+    kernel.set_arg(0, states.get_buffer());
+    kernel.set_arg(1, output.get_buffer());
+    queue.enqueue_1d_range_kernel(kernel, 0, 3, 0);
+
+    CHECK_RANGE_EQUAL(
+        uint4_, 1, output,
+        (uint4_(1713891541, 3781805453, 3159862348, 2600524760))
+    );
+    CHECK_RANGE_EQUAL(
+        uint4_, 3, states,
+        (uint4_(1, 1, 0, 0), uint4_(1, 1, 2, 42), uint4_(1, 1, 3, 42))
+    );
+
+    // each stream has its own numbers
+    std::vector<uint4_> host_output(6);
+    boost::compute::copy(output.begin(), output.end(), host_output.begin(), queue);
+    BOOST_CHECK(host_output[2] != host_output[4]);
+    BOOST_CHECK(host_output[3] != host_output[5]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
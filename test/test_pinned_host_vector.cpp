@@ -0,0 +1,85 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestPinnedHostVector
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/pinned_host_vector.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(construct_and_access)
+{
+    compute::pinned_host_vector<int> empty(context);
+    BOOST_CHECK(empty.empty());
+    BOOST_CHECK_EQUAL(empty.size(), size_t(0));
+
+    compute::pinned_host_vector<int> vector(4, 7, context);
+    BOOST_CHECK_EQUAL(vector.size(), size_t(4));
+    BOOST_CHECK(vector.capacity() >= size_t(4));
+    BOOST_CHECK_EQUAL(vector[0], 7);
+    BOOST_CHECK_EQUAL(vector[3], 7);
+
+    vector.push_back(8);
+    BOOST_CHECK_EQUAL(vector.size(), size_t(5));
+    BOOST_CHECK_EQUAL(vector.back(), 8);
+    BOOST_CHECK_EQUAL(vector.front(), 7);
+
+    int data[] = { 1, 2, 3 };
+    compute::pinned_host_vector<int> copy(data, data + 3, context);
+    BOOST_CHECK_EQUAL(copy.size(), size_t(3));
+    BOOST_CHECK(std::equal(copy.begin(), copy.end(), data));
+}
+
+BOOST_AUTO_TEST_CASE(copy_to_and_from_device)
+{
+    // larger than the staging threshold
+    const size_t size = 1 << 20;
+
+    compute::vector<int> device_vector(size, context);
+    compute::iota(device_vector.begin(), device_vector.end(), 0, queue);
+
+    compute::pinned_host_vector<int> host(size, context);
+    compute::copy(device_vector.begin(), device_vector.end(), host.begin(), queue);
+    BOOST_CHECK_EQUAL(host[0], 0);
+    BOOST_CHECK_EQUAL(host[size - 1], int(size - 1));
+
+    host[0] = 42;
+    compute::copy(host.begin(), host.end(), device_vector.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 3, device_vector, (42, 1, 2));
+
+    // async copies read the pinned memory directly
+    compute::future<int *> future = compute::copy_async(
+        device_vector.begin(), device_vector.end(), host.begin(), queue
+    );
+    future.wait();
+    BOOST_CHECK_EQUAL(host[0], 42);
+}
+
+BOOST_AUTO_TEST_CASE(pinned_memory_is_reused)
+{
+    void *ptr = 0;
+    {
+        compute::pinned_host_vector<float> vector(1024, context);
+        ptr = vector.data();
+    }
+
+    // the memory of the destroyed vector is still mapped
+    compute::pinned_host_vector<float> vector(1024, context);
+    BOOST_CHECK(vector.data() == ptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,113 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestPipeline
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <vector>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/experimental/pipeline.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(transform_copy)
+{
+    using compute::lambda::_1;
+
+    int data[] = { -1, 2, -3, 4, -5, 6, -7, 8 };
+    compute::vector<int> input(data, data + 8, queue);
+    compute::vector<int> output(8, context);
+
+    compute::experimental::make_pipeline(input.begin(), input.end())
+        .transform(compute::abs<int>())
+        .transform(_1 * 2)
+        .copy(output.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 8, output, (2, 4, 6, 8, 10, 12, 14, 16));
+}
+
+BOOST_AUTO_TEST_CASE(binary_transform_reduce)
+{
+    using compute::lambda::_1;
+
+    int data1[] = { 1, 2, 3, 4, 5 };
+    int data2[] = { 5, 1, 3, 6, 2 };
+    compute::vector<int> input1(data1, data1 + 5, queue);
+    compute::vector<int> input2(data2, data2 + 5, queue);
+
+    // sum of the squared differences
+    int sum = 0;
+    compute::experimental::make_pipeline(input1.begin(), input1.end())
+        .transform(input2.begin(), compute::minus<int>())
+        .transform(_1 * _1)
+        .reduce(&sum, queue);
+    BOOST_CHECK_EQUAL(sum, 16 + 1 + 0 + 4 + 9);
+}
+
+BOOST_AUTO_TEST_CASE(filter_accumulate_large)
+{
+    using compute::lambda::_1;
+
+    const int size = 100000;
+    std::vector<int> data(size);
+    for(int i = 0; i < size; i++){
+        data[i] = (i % 101) - 50;
+    }
+    compute::vector<int> input(data.begin(), data.end(), queue);
+
+    int expected_sum = 7;
+    int expected_count = 0;
+    for(int i = 0; i < size; i++){
+        const int value = 3 * std::abs(data[i]);
+        if(value % 2 == 0){
+            expected_sum += value;
+            expected_count++;
+        }
+    }
+
+    int sum = compute::experimental::make_pipeline(input.begin(), input.end())
+                  .transform(compute::abs<int>())
+                  .transform(_1 * 3)
+                  .filter(_1 % 2 == 0)
+                  .accumulate(7, queue);
+    BOOST_CHECK_EQUAL(sum, expected_sum);
+
+    size_t count = compute::experimental::make_pipeline(input.begin(), input.end())
+                       .transform(compute::abs<int>())
+                       .transform(_1 * 3)
+                       .filter(_1 % 2 == 0)
+                       .count(queue);
+    BOOST_CHECK_EQUAL(count, size_t(expected_count));
+}
+
+BOOST_AUTO_TEST_CASE(filter_copy)
+{
+    using compute::lambda::_1;
+
+    int data[] = { 1, 6, 3, 8, 5, 2, 7, 4 };
+    compute::vector<int> input(data, data + 8, queue);
+    compute::vector<int> output(8, context);
+
+    compute::vector<int>::iterator end =
+        compute::experimental::make_pipeline(input.begin(), input.end())
+            .transform(_1 + 1)
+            .filter(_1 % 2 == 0)
+            .copy(output.begin(), queue);
+    BOOST_CHECK_EQUAL(std::distance(output.begin(), end), 4);
+    CHECK_RANGE_EQUAL(int, 4, output, (2, 4, 6, 8));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
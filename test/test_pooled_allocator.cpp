@@ -0,0 +1,47 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestPooledAllocator
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/allocator/pooled_allocator.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(reuse_buffer)
+{
+    compute::pooled_allocator<int> allocator(context);
+    allocator.get_pool()->trim();
+
+    typedef compute::pooled_allocator<int>::pointer pointer;
+    pointer x = allocator.allocate(100);
+    cl_mem mem = x.get_buffer().get();
+    allocator.deallocate(x, 100);
+
+    // a request of similar size is served from the pool
+    pointer y = allocator.allocate(99);
+    BOOST_CHECK(y.get_buffer().get() == mem);
+    allocator.deallocate(y, 99);
+}
+
+BOOST_AUTO_TEST_CASE(vector_with_pooled_allocator)
+{
+    compute::vector<int, compute::pooled_allocator<int> > vector(context);
+    vector.push_back(1, queue);
+    vector.push_back(2, queue);
+    vector.push_back(3, queue);
+    CHECK_RANGE_EQUAL(int, 3, vector, (1, 2, 3));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,58 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestPrefetch
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/prefetch.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+#include "opencl_version_check.hpp"
+
+namespace compute = boost::compute;
+
+#ifdef CL_VERSION_1_2
+BOOST_AUTO_TEST_CASE(prefetch_buffer)
+{
+    REQUIRES_OPENCL_VERSION(1, 2);
+
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> vector(data, data + 4, queue);
+
+    // migrating keeps the contents of the buffer
+    compute::prefetch(vector.get_buffer(), queue).wait();
+    CHECK_RANGE_EQUAL(int, 4, vector, (1, 2, 3, 4));
+
+    compute::prefetch(vector.begin(), vector.end(), queue).wait();
+    CHECK_RANGE_EQUAL(int, 4, vector, (1, 2, 3, 4));
+
+    // an empty range is not migrated
+    compute::event event = compute::prefetch(vector.begin(), vector.begin(), queue);
+    BOOST_CHECK(event.get() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(prefetch_output)
+{
+    REQUIRES_OPENCL_VERSION(1, 2);
+
+    compute::vector<int> vector(4, context);
+    compute::prefetch(
+        vector.get_buffer(), queue, CL_MIGRATE_MEM_OBJECT_CONTENT_UNDEFINED
+    );
+    compute::fill(vector.begin(), vector.end(), 7, queue);
+    CHECK_RANGE_EQUAL(int, 4, vector, (7, 7, 7, 7));
+}
+#endif // CL_VERSION_1_2
+
+BOOST_AUTO_TEST_SUITE_END()
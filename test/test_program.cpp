@@ -184,4 +184,38 @@ BOOST_AUTO_TEST_CASE(build_log)
     }
 }
 
+#ifdef CL_VERSION_1_1
+BOOST_AUTO_TEST_CASE(build_async)
+{
+    REQUIRES_OPENCL_VERSION(1,1);
+
+    compute::program program =
+        compute::program::create_with_source(source, context);
+
+    compute::future<compute::program> future = program.build_async();
+    BOOST_CHECK(future.valid());
+
+    compute::program built = future.get();
+    BOOST_CHECK(built == program);
+
+    compute::kernel foo = built.create_kernel("foo");
+    BOOST_CHECK_EQUAL(foo.name(), "foo");
+}
+
+BOOST_AUTO_TEST_CASE(build_async_failure)
+{
+    REQUIRES_OPENCL_VERSION(1,1);
+
+    const char invalid_source[] =
+        "__kernel void foo(__global int *input) { !@#$%^&*() }";
+
+    compute::program invalid_program =
+        compute::program::create_with_source(invalid_source, context);
+
+    compute::future<compute::program> future = invalid_program.build_async();
+    BOOST_CHECK_THROW(future.wait(), compute::opencl_error);
+    BOOST_CHECK(!invalid_program.build_log().empty());
+}
+#endif // CL_VERSION_1_1
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -11,8 +11,16 @@
 #define BOOST_TEST_MODULE TestProgramCache
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+
+#include <boost/compute/kernel.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/utility/program_cache.hpp>
+#include <boost/compute/detail/hash128.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/program_source_cache.hpp>
 
 namespace compute = boost::compute;
 
@@ -93,3 +101,331 @@ BOOST_AUTO_TEST_CASE(evict)
     BOOST_CHECK(cache.get("d") == boost::none);
     BOOST_CHECK(cache.get("e") == boost::none);
 }
+
+BOOST_AUTO_TEST_CASE(get_or_build)
+{
+    compute::context ctx = compute::system::default_context();
+    compute::program_cache cache(4);
+
+    const char source[] =
+        "__kernel void sub(__global int *a, int x)\n"
+        "{\n"
+        "    a[get_global_id(0)] -= x;\n"
+        "}\n";
+
+    // first call builds the program and stores it in the cache
+    compute::program p1 = cache.get_or_build("sub", "-DFOO", source, ctx);
+    BOOST_CHECK_EQUAL(cache.size(), size_t(1));
+    BOOST_CHECK(cache.get("sub", "-DFOO") == p1);
+
+    // second call returns the cached program
+    compute::program p2 = cache.get_or_build("sub", "-DFOO", source, ctx);
+    BOOST_CHECK(p2 == p1);
+    BOOST_CHECK_EQUAL(cache.size(), size_t(1));
+
+    // different options build a new program
+    compute::program p3 = cache.get_or_build("sub", "-DBAR", source, ctx);
+    BOOST_CHECK(p3 != p1);
+    BOOST_CHECK_EQUAL(cache.size(), size_t(2));
+}
+
+BOOST_AUTO_TEST_CASE(get_or_build_all)
+{
+    compute::context ctx = compute::system::default_context();
+    compute::program_cache cache(8);
+
+    std::vector<std::string> keys;
+    std::vector<std::string> sources;
+    for(int i = 0; i < 4; i++){
+        const std::string n = boost::lexical_cast<std::string>(i);
+
+        keys.push_back("add" + n);
+        sources.push_back(
+            "__kernel void add" + n + "(__global int *a)\n"
+            "{\n"
+            "    a[get_global_id(0)] += " + n + ";\n"
+            "}\n"
+        );
+    }
+
+    // one of the programs is already in the cache
+    compute::program p0 = cache.get_or_build(keys[0], "", sources[0], ctx);
+
+    std::vector<compute::program> programs =
+        cache.get_or_build_all(keys, "", sources, ctx);
+    BOOST_CHECK_EQUAL(programs.size(), size_t(4));
+    BOOST_CHECK_EQUAL(cache.size(), size_t(4));
+    BOOST_CHECK(programs[0] == p0);
+    for(size_t i = 0; i < programs.size(); i++){
+        BOOST_CHECK(cache.get(keys[i]) == programs[i]);
+        BOOST_CHECK_EQUAL(programs[i].create_kernel(keys[i]).name(), keys[i]);
+    }
+    BOOST_CHECK_EQUAL(cache.get_statistics().builds, size_t(4));
+}
+
+#ifdef CL_VERSION_1_1
+BOOST_AUTO_TEST_CASE(get_or_build_async)
+{
+    compute::context ctx = compute::system::default_context();
+    compute::program_cache cache(4);
+
+    const char source[] =
+        "__kernel void add(__global int *a, int x)\n"
+        "{\n"
+        "    a[get_global_id(0)] += x;\n"
+        "}\n";
+
+    // the pending program is stored in the cache immediately
+    compute::future<compute::program> f1 =
+        cache.get_or_build_async("add", "", source, ctx);
+    BOOST_CHECK_EQUAL(cache.size(), size_t(1));
+
+    // a second request returns the same (possibly pending) program
+    compute::future<compute::program> f2 =
+        cache.get_or_build_async("add", "", source, ctx);
+    BOOST_CHECK(f2.get() == f1.get());
+
+    // get() waits for the build to complete
+    boost::optional<compute::program> p = cache.get("add");
+    BOOST_CHECK(p == f1.get());
+
+    compute::kernel add_kernel = p->create_kernel("add");
+    BOOST_CHECK_EQUAL(add_kernel.name(), "add");
+}
+#endif // CL_VERSION_1_1
+
+BOOST_AUTO_TEST_CASE(evict_least_recently_used)
+{
+    compute::program_cache cache(3);
+    cache.insert("a", compute::program());
+    cache.insert("b", compute::program());
+    cache.insert("c", compute::program());
+
+    // access "a" so that "b" becomes the least recently used program
+    BOOST_CHECK(cache.get("a") != boost::none);
+
+    cache.insert("d", compute::program());
+    BOOST_CHECK(cache.get("a") != boost::none);
+    BOOST_CHECK(cache.get("b") == boost::none);
+    BOOST_CHECK(cache.get("c") != boost::none);
+    BOOST_CHECK(cache.get("d") != boost::none);
+
+    // programs with the same key but different options are distinct
+    cache.insert("a", "-DFOO", compute::program());
+    BOOST_CHECK(cache.get("a", "-DFOO") != boost::none);
+    BOOST_CHECK(cache.get("a", "-DBAR") == boost::none);
+}
+
+BOOST_AUTO_TEST_CASE(statistics)
+{
+    compute::program_cache cache(2);
+    cache.insert("a", compute::program());
+    cache.insert("b", "", compute::program(), 100);
+
+    BOOST_CHECK(cache.get("a") != boost::none);
+    BOOST_CHECK(cache.get("c") == boost::none);
+    cache.insert("c", compute::program());
+
+    compute::program_cache::statistics stats = cache.get_statistics();
+    BOOST_CHECK_EQUAL(stats.hits, size_t(1));
+    BOOST_CHECK_EQUAL(stats.misses, size_t(1));
+    BOOST_CHECK_EQUAL(stats.evictions, size_t(1));
+    BOOST_CHECK_EQUAL(stats.builds, size_t(0));
+    BOOST_CHECK_EQUAL(stats.binary_builds, size_t(0));
+    BOOST_CHECK_EQUAL(stats.build_time, compute::ulong_(100));
+
+    cache.reset_statistics();
+    stats = cache.get_statistics();
+    BOOST_CHECK_EQUAL(stats.hits, size_t(0));
+    BOOST_CHECK_EQUAL(stats.evictions, size_t(0));
+    BOOST_CHECK_EQUAL(stats.build_time, compute::ulong_(0));
+}
+
+BOOST_AUTO_TEST_CASE(set_capacity)
+{
+    compute::program_cache cache(4);
+    cache.insert("a", compute::program());
+    cache.insert("b", compute::program());
+    cache.insert("c", compute::program());
+
+    // shrinking the cache evicts the least recently used programs
+    cache.set_capacity(2);
+    BOOST_CHECK_EQUAL(cache.capacity(), size_t(2));
+    BOOST_CHECK_EQUAL(cache.size(), size_t(2));
+    BOOST_CHECK(cache.get("a") == boost::none);
+    BOOST_CHECK(cache.get("b") != boost::none);
+    BOOST_CHECK(cache.get("c") != boost::none);
+    BOOST_CHECK_EQUAL(cache.get_statistics().evictions, size_t(1));
+}
+
+BOOST_AUTO_TEST_CASE(evict_cost_aware)
+{
+    compute::program_cache cache(4);
+    cache.set_eviction_policy(compute::program_cache::cost_aware);
+    cache.insert("a", "", compute::program(), 1000);
+    cache.insert("b", "", compute::program(), 10);
+    cache.insert("c", "", compute::program(), 500);
+    cache.insert("d", "", compute::program(), 500);
+
+    // "b" is the cheapest of the two least recently used programs
+    cache.insert("e", "", compute::program(), 500);
+    BOOST_CHECK(cache.get("a") != boost::none);
+    BOOST_CHECK(cache.get("b") == boost::none);
+
+    // "a" was used last, so "c" and "d" are the least recently used
+    cache.insert("f", "", compute::program(), 500);
+    BOOST_CHECK(cache.get("a") != boost::none);
+    BOOST_CHECK(cache.get("c") == boost::none);
+    BOOST_CHECK(cache.get("d") != boost::none);
+}
+
+BOOST_AUTO_TEST_CASE(global_cache_capacity)
+{
+    compute::context ctx = compute::system::default_context();
+
+    const size_t capacity = compute::program_cache::global_cache_capacity();
+    BOOST_CHECK(capacity > 0);
+
+    compute::program_cache::set_global_cache_capacity(capacity + 16);
+    BOOST_CHECK_EQUAL(
+        compute::program_cache::get_global_cache(ctx)->capacity(), capacity + 16
+    );
+
+    compute::program_cache::set_global_cache_capacity(capacity);
+    BOOST_CHECK_EQUAL(
+        compute::program_cache::get_global_cache(ctx)->capacity(), capacity
+    );
+}
+
+BOOST_AUTO_TEST_CASE(share_binaries_between_contexts)
+{
+    compute::device device = compute::system::default_device();
+    compute::context ctx1(device);
+    compute::context ctx2(device);
+
+    const char source[] =
+        "__kernel void triple(__global int *a)\n"
+        "{\n"
+        "    a[get_global_id(0)] *= 3;\n"
+        "}\n";
+
+    // the first context compiles the source
+    compute::program_cache cache1(4);
+    cache1.get_or_build("triple", "-DSHARED", source, ctx1);
+    BOOST_CHECK_EQUAL(cache1.get_statistics().builds, size_t(1));
+    BOOST_CHECK_EQUAL(cache1.get_statistics().binary_builds, size_t(0));
+
+    // the second context uses its binary
+    compute::program_cache cache2(4);
+    compute::program p = cache2.get_or_build("triple", "-DSHARED", source, ctx2);
+    BOOST_CHECK_EQUAL(cache2.get_statistics().builds, size_t(1));
+    BOOST_CHECK_EQUAL(cache2.get_statistics().binary_builds, size_t(1));
+    BOOST_CHECK(p.get_context() == ctx2);
+
+    compute::command_queue queue(ctx2, device);
+    int data[] = { 1, 2, 3, 4 };
+    compute::buffer buffer(ctx2, sizeof(data), compute::buffer::copy_host_ptr, data);
+
+    compute::kernel kernel(p, "triple");
+    kernel.set_arg(0, buffer);
+    queue.enqueue_1d_range_kernel(kernel, 0, 4, 0);
+    queue.enqueue_read_buffer(buffer, 0, sizeof(data), data);
+    BOOST_CHECK_EQUAL(data[0], 3);
+    BOOST_CHECK_EQUAL(data[3], 12);
+}
+
+BOOST_AUTO_TEST_CASE(meta_kernel_source_cache)
+{
+    compute::context ctx = compute::system::default_context();
+
+    compute::detail::program_source_cache &cache =
+        compute::detail::program_source_cache::get_global_cache();
+    cache.clear();
+
+    compute::detail::meta_kernel k1("add_one");
+    k1.add_arg<int *>(compute::memory_object::global_memory, "a");
+    k1 << "a[get_global_id(0)] += 1;\n";
+    compute::kernel kernel1 = k1.compile(ctx);
+    BOOST_CHECK_EQUAL(cache.size(), size_t(1));
+
+    // the same source is found by its text
+    compute::detail::meta_kernel k2("add_one");
+    k2.add_arg<int *>(compute::memory_object::global_memory, "a");
+    k2 << "a[get_global_id(0)] += 1;\n";
+    compute::kernel kernel2 = k2.compile(ctx);
+    BOOST_CHECK_EQUAL(cache.size(), size_t(1));
+    BOOST_CHECK(kernel1.get_program() == kernel2.get_program());
+
+    // different source (e.g. another literal value) is a different program
+    compute::detail::meta_kernel k3("add_one");
+    k3.add_arg<int *>(compute::memory_object::global_memory, "a");
+    k3 << "a[get_global_id(0)] += 2;\n";
+    compute::kernel kernel3 = k3.compile(ctx);
+    BOOST_CHECK_EQUAL(cache.size(), size_t(2));
+    BOOST_CHECK(kernel1.get_program() != kernel3.get_program());
+
+    // and so are different build options
+    compute::detail::meta_kernel k4("add_one");
+    k4.add_arg<int *>(compute::memory_object::global_memory, "a");
+    k4 << "a[get_global_id(0)] += 1;\n";
+    k4.compile(ctx, "-DFOO");
+    BOOST_CHECK_EQUAL(cache.size(), size_t(3));
+}
+
+BOOST_AUTO_TEST_CASE(meta_kernel_argument_qualifiers)
+{
+    compute::context ctx = compute::system::default_context();
+
+    compute::buffer input(ctx, 64 * sizeof(int));
+    compute::buffer output(ctx, 64 * sizeof(int));
+
+    compute::detail::meta_kernel k("qualifiers");
+    const std::string in = k.get_buffer_identifier<int>(input);
+    const std::string out = k.get_buffer_identifier<int>(output);
+    k << "const uint i = get_global_id(0);\n"
+      << out << "[i] = " << in << "[i] + " << in << "[(i + 1) % 64];\n";
+
+    // only the buffer which is read is const
+    std::string source = k.source();
+    BOOST_CHECK(source.find("__global const int* " + in) != std::string::npos);
+    BOOST_CHECK(source.find("__global int* " + out) != std::string::npos);
+    BOOST_CHECK(source.find("restrict") == std::string::npos);
+
+    k.set_restrict_buffers(true);
+    k.set_reqd_work_group_size(16);
+    source = k.source();
+    BOOST_CHECK(source.find("__global const int* restrict " + in) != std::string::npos);
+    BOOST_CHECK(source.find("__global int* restrict " + out) != std::string::npos);
+    BOOST_CHECK(
+        source.find("__attribute__((reqd_work_group_size(16, 1, 1)))") != std::string::npos
+    );
+
+    compute::kernel kernel = k.compile(ctx);
+    BOOST_CHECK_EQUAL(kernel.name(), std::string("qualifiers"));
+}
+
+BOOST_AUTO_TEST_CASE(hash128_incremental)
+{
+    const std::string text = "The quick brown fox jumps over the lazy dog";
+
+    compute::detail::hash128 hash;
+    hash.process_string(text);
+    const compute::detail::hash128_digest digest = hash.digest();
+    BOOST_CHECK_EQUAL(digest.str().size(), size_t(32));
+
+    // the digest does not depend on how the bytes are split
+    compute::detail::hash128 bytewise;
+    for(size_t i = 0; i < text.size(); i++){
+        bytewise.process_bytes(&text[i], 1);
+    }
+    BOOST_CHECK(bytewise.digest() == digest);
+
+    compute::detail::hashing_stringstream stream;
+    stream << "The quick brown " << "fox jumps over the lazy" << ' ' << "dog";
+    BOOST_CHECK_EQUAL(stream.str(), text);
+    BOOST_CHECK(stream.digest() == digest);
+
+    compute::detail::hash128 other;
+    other.process_string(text + ".");
+    BOOST_CHECK(other.digest() != digest);
+}
@@ -11,10 +11,17 @@
 #define BOOST_TEST_MODULE TestRadixSort
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+#include <utility>
+#include <algorithm>
+
 #include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/is_sorted.hpp>
 #include <boost/compute/algorithm/detail/radix_sort.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/scratch_space.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -186,4 +193,121 @@ BOOST_AUTO_TEST_CASE(sort_partial_vector)
     CHECK_RANGE_EQUAL(int, 10, vec, (9, 8, 2, 3, 4, 5, 6, 7, 1, 0));
 }
 
+BOOST_AUTO_TEST_CASE(sort_with_custom_parameters)
+{
+    using boost::compute::uint_;
+
+    boost::shared_ptr<bc::detail::parameter_cache> parameters =
+        bc::detail::parameter_cache::get_global_cache(device);
+
+    std::vector<uint_> data(5000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<uint_>((i * 2654435761u) ^ (i << 7));
+    }
+
+    // 3-bit digits need an odd number of passes for 32-bit keys
+    const uint_ digits[] = { 3, 8 };
+    for(size_t i = 0; i < 2; i++){
+        parameters->set("__boost_radix_sort_uint", "k", digits[i]);
+        parameters->set("__boost_radix_sort_uint", "block_size", 64);
+
+        bc::detail::radix_sort_parameters params =
+            bc::detail::get_radix_sort_parameters<uint_>(queue);
+        BOOST_CHECK_EQUAL(params.k, digits[i]);
+
+        bc::vector<uint_> vector(data.begin(), data.end(), queue);
+        bc::detail::radix_sort(vector.begin(), vector.end(), queue);
+        BOOST_CHECK(bc::is_sorted(vector.begin(), vector.end(), queue));
+    }
+
+    parameters->reset("__boost_radix_sort_uint");
+}
+
+#ifdef CL_VERSION_1_1
+BOOST_AUTO_TEST_CASE(sort_with_little_memory)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    using boost::compute::float_;
+
+    std::vector<float_> data(100000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<float_>(static_cast<int>((i * 7919) % 20011) - 10000) * 0.5f;
+    }
+    std::vector<float_> expected(data);
+    std::sort(expected.begin(), expected.end());
+
+    // room for the temporaries of about an eighth of the keys, which are
+    // sorted in chunks and merged on the host
+    const size_t scratch_size =
+        bc::detail::radix_sort_scratch_size<float_, int>(data.size() / 8, false, queue);
+    bc::scratch_space scratch(bc::buffer(context, scratch_size + 16384), false);
+
+    bc::vector<float_> vector(data.begin(), data.end(), queue);
+    {
+        bc::scoped_scratch_space use_scratch(scratch);
+        bc::detail::radix_sort(vector.begin(), vector.end(), queue);
+        queue.finish();
+    }
+
+    std::vector<float_> host(data.size());
+    bc::copy(vector.begin(), vector.end(), host.begin(), queue);
+    BOOST_CHECK(host == expected);
+
+    // without room for a chunk the keys are sorted on the host
+    bc::scratch_space tiny(bc::buffer(context, 4096), false);
+
+    bc::copy(data.begin(), data.end(), vector.begin(), queue);
+    {
+        bc::scoped_scratch_space use_scratch(tiny);
+        bc::detail::radix_sort(vector.begin(), vector.end(), queue);
+        queue.finish();
+    }
+
+    bc::copy(vector.begin(), vector.end(), host.begin(), queue);
+    BOOST_CHECK(host == expected);
+}
+
+BOOST_AUTO_TEST_CASE(sort_by_key_with_little_memory)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    using boost::compute::int_;
+    using boost::compute::uint_;
+
+    const size_t size = 50000;
+    std::vector<int_> keys(size);
+    std::vector<uint_> values(size);
+    std::vector<std::pair<int_, uint_> > expected(size);
+    for(size_t i = 0; i < size; i++){
+        keys[i] = static_cast<int_>((i * 7919) % 101) - 50;
+        values[i] = static_cast<uint_>(i);
+        expected[i] = std::make_pair(keys[i], values[i]);
+    }
+    // the values of equal keys keep their order
+    std::sort(expected.begin(), expected.end());
+
+    const size_t scratch_size =
+        bc::detail::radix_sort_scratch_size<int_, uint_>(size / 4, true, queue);
+    bc::scratch_space scratch(bc::buffer(context, scratch_size + 16384), false);
+
+    bc::vector<int_> device_keys(keys.begin(), keys.end(), queue);
+    bc::vector<uint_> device_values(values.begin(), values.end(), queue);
+    {
+        bc::scoped_scratch_space use_scratch(scratch);
+        bc::detail::radix_sort_by_key(
+            device_keys.begin(), device_keys.end(), device_values.begin(), queue
+        );
+        queue.finish();
+    }
+
+    bc::copy(device_keys.begin(), device_keys.end(), keys.begin(), queue);
+    bc::copy(device_values.begin(), device_values.end(), values.begin(), queue);
+    for(size_t i = 0; i < size; i++){
+        BOOST_REQUIRE_EQUAL(keys[i], expected[i].first);
+        BOOST_REQUIRE_EQUAL(values[i], expected[i].second);
+    }
+}
+#endif // CL_VERSION_1_1
+
 BOOST_AUTO_TEST_SUITE_END()
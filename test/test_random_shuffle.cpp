@@ -16,8 +16,12 @@
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/equal.hpp>
+#include <boost/compute/algorithm/iota.hpp>
 #include <boost/compute/algorithm/random_shuffle.hpp>
+#include <boost/compute/algorithm/sort.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/random/default_random_engine.hpp>
 
 #include "context_setup.hpp"
 
@@ -50,4 +54,32 @@ BOOST_AUTO_TEST_CASE(shuffle_int_vector)
     BOOST_VERIFY(original_values == shuffled_values);
 }
 
+BOOST_AUTO_TEST_CASE(shuffle_with_seeded_engine)
+{
+    const int n = 10000;
+
+    bc::vector<int> a(n, context);
+    bc::vector<int> b(n, context);
+    bc::iota(a.begin(), a.end(), 0, queue);
+    bc::iota(b.begin(), b.end(), 0, queue);
+
+    bc::default_random_engine engine_a(queue, 42);
+    bc::random_shuffle(a.begin(), a.end(), engine_a, queue);
+
+    bc::default_random_engine engine_b(queue, 42);
+    bc::random_shuffle(b.begin(), b.end(), engine_b, queue);
+
+    // the same seed gives the same permutation
+    BOOST_CHECK(bc::equal(a.begin(), a.end(), b.begin(), queue));
+
+    // the values have been moved
+    bc::vector<int> sorted(n, context);
+    bc::iota(sorted.begin(), sorted.end(), 0, queue);
+    BOOST_CHECK(!bc::equal(a.begin(), a.end(), sorted.begin(), queue));
+
+    // and are a permutation of the input
+    bc::sort(a.begin(), a.end(), queue);
+    BOOST_CHECK(bc::equal(a.begin(), a.end(), sorted.begin(), queue));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -11,6 +11,11 @@
 #define BOOST_TEST_MODULE TestReduce
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <vector>
+
+#include <boost/tuple/tuple.hpp>
+
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
@@ -266,4 +271,75 @@ BOOST_AUTO_TEST_CASE(reduce_complex)
     BOOST_CHECK(result == std::complex<float>(-168, -576));
 }
 
+BOOST_AUTO_TEST_CASE(reduce_int_unaligned)
+{
+    const size_t size = 100001;
+
+    std::vector<int> data(size);
+    for(size_t i = 0; i < size; i++){
+        data[i] = static_cast<int>(i % 13);
+    }
+    compute::vector<int> vector(data.begin(), data.end(), queue);
+
+    int expected = 0;
+    for(size_t i = 5; i < size; i++){
+        expected += data[i];
+    }
+
+    int sum = 0;
+    compute::reduce(vector.begin() + 5, vector.end(), &sum, queue);
+    BOOST_CHECK_EQUAL(sum, expected);
+}
+
+BOOST_AUTO_TEST_CASE(reduce_tuple_of_functions)
+{
+    int data[] = { 11, 5, 92, 13, 42 };
+    compute::vector<int> vector(data, data + 5, queue);
+
+    boost::tuple<int, int, int> result;
+    compute::reduce(
+        vector.begin(),
+        vector.end(),
+        &result,
+        boost::make_tuple(
+            compute::plus<int>(), compute::min<int>(), compute::max<int>()
+        ),
+        queue
+    );
+    BOOST_CHECK_EQUAL(boost::get<0>(result), 163);
+    BOOST_CHECK_EQUAL(boost::get<1>(result), 5);
+    BOOST_CHECK_EQUAL(boost::get<2>(result), 92);
+
+    // enough values for several work-groups
+    const size_t size = 100001;
+    std::vector<int> host_data(size);
+    for(size_t i = 0; i < size; i++){
+        host_data[i] = static_cast<int>((i * 7919) % 1000) - 500;
+    }
+    compute::vector<int> large(host_data.begin(), host_data.end(), queue);
+
+    compute::reduce(
+        large.begin() + 1,
+        large.end(),
+        &result,
+        boost::make_tuple(
+            compute::plus<int>(), compute::min<int>(), compute::max<int>()
+        ),
+        queue
+    );
+    int sum = 0;
+    for(size_t i = 1; i < size; i++){
+        sum += host_data[i];
+    }
+    BOOST_CHECK_EQUAL(boost::get<0>(result), sum);
+    BOOST_CHECK_EQUAL(
+        boost::get<1>(result),
+        *std::min_element(host_data.begin() + 1, host_data.end())
+    );
+    BOOST_CHECK_EQUAL(
+        boost::get<2>(result),
+        *std::max_element(host_data.begin() + 1, host_data.end())
+    );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
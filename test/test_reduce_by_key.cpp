@@ -0,0 +1,171 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestReduceByKey
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/reduce_by_key.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(reduce_by_key_int)
+{
+//! [reduce_by_key_int]
+// setup keys and values
+int keys[] = { 0, 2, -3, -3, -3, -3, -3, 4 };
+int data[] = { 1, 1, 1, 1, 1, 2, 5, 1 };
+
+boost::compute::vector<int> keys_input(keys, keys + 8, queue);
+boost::compute::vector<int> values_input(data, data + 8, queue);
+
+boost::compute::vector<int> keys_output(8, context);
+boost::compute::vector<int> values_output(8, context);
+
+// reduce by key
+boost::compute::reduce_by_key(keys_input.begin(), keys_input.end(), values_input.begin(),
+                              keys_output.begin(), values_output.begin(), queue);
+
+// keys_output = { 0, 2, -3, 4 }
+// values_output = { 1, 1, 10, 1 }
+//! [reduce_by_key_int]
+
+    CHECK_RANGE_EQUAL(int, 4, keys_output, (0, 2, -3, 4));
+    CHECK_RANGE_EQUAL(int, 4, values_output, (1, 1, 10, 1));
+}
+
+BOOST_AUTO_TEST_CASE(reduce_by_key_end_iterators)
+{
+    int keys[] = { 1, 1, 2, 3, 3, 3 };
+    int data[] = { 1, 2, 3, 4, 5, 6 };
+
+    compute::vector<int> keys_input(keys, keys + 6, queue);
+    compute::vector<int> values_input(data, data + 6, queue);
+
+    compute::vector<int> keys_output(6, context);
+    compute::vector<int> values_output(6, context);
+
+    std::pair<compute::vector<int>::iterator, compute::vector<int>::iterator> result =
+        compute::reduce_by_key(
+            keys_input.begin(), keys_input.end(), values_input.begin(),
+            keys_output.begin(), values_output.begin(),
+            compute::multiplies<int>(), queue
+        );
+
+    BOOST_CHECK(result.first == keys_output.begin() + 3);
+    BOOST_CHECK(result.second == values_output.begin() + 3);
+    CHECK_RANGE_EQUAL(int, 3, keys_output, (1, 2, 3));
+    CHECK_RANGE_EQUAL(int, 3, values_output, (2, 3, 120));
+}
+
+BOOST_AUTO_TEST_CASE(reduce_by_key_first_key_of_group)
+{
+    int keys[] = { 1, 4, 7, 12, 15, 21 };
+    int data[] = { 1, 2, 3, 4, 5, 6 };
+
+    compute::vector<int> keys_input(keys, keys + 6, queue);
+    compute::vector<int> values_input(data, data + 6, queue);
+
+    compute::vector<int> keys_output(6, context);
+    compute::vector<int> values_output(6, context);
+
+    // keys with the same tens digit belong to the same group
+    BOOST_COMPUTE_FUNCTION(bool, same_tens, (int a, int b),
+    {
+        return a / 10 == b / 10;
+    });
+
+    compute::reduce_by_key(
+        keys_input.begin(), keys_input.end(), values_input.begin(),
+        keys_output.begin(), values_output.begin(),
+        compute::plus<int>(), same_tens, queue
+    );
+
+    CHECK_RANGE_EQUAL(int, 3, keys_output, (1, 12, 21));
+    CHECK_RANGE_EQUAL(int, 3, values_output, (6, 9, 6));
+}
+
+BOOST_AUTO_TEST_CASE(reduce_by_key_empty)
+{
+    compute::vector<int> keys(context);
+    compute::vector<int> values(context);
+
+    std::pair<compute::vector<int>::iterator, compute::vector<int>::iterator> result =
+        compute::reduce_by_key(
+            keys.begin(), keys.end(), values.begin(),
+            keys.begin(), values.begin(), queue
+        );
+
+    BOOST_CHECK(result.first == keys.begin());
+    BOOST_CHECK(result.second == values.begin());
+}
+
+BOOST_AUTO_TEST_CASE(reduce_by_key_large)
+{
+    // segments of varying length which span several work-groups
+    const size_t size = 100000;
+
+    std::vector<int> host_keys(size);
+    std::vector<int> host_values(size);
+    for(size_t i = 0; i < size; i++){
+        host_keys[i] = static_cast<int>(i / (1 + (i / 1000) % 300));
+        host_values[i] = static_cast<int>(i % 5);
+    }
+
+    // reduce on the host
+    std::vector<int> expected_keys;
+    std::vector<int> expected_values;
+    for(size_t i = 0; i < size; i++){
+        if(i == 0 || host_keys[i] != host_keys[i - 1]){
+            expected_keys.push_back(host_keys[i]);
+            expected_values.push_back(0);
+        }
+        expected_values.back() += host_values[i];
+    }
+
+    compute::vector<int> keys_input(host_keys.begin(), host_keys.end(), queue);
+    compute::vector<int> values_input(host_values.begin(), host_values.end(), queue);
+    compute::vector<int> keys_output(size, context);
+    compute::vector<int> values_output(size, context);
+
+    std::pair<compute::vector<int>::iterator, compute::vector<int>::iterator> result =
+        compute::reduce_by_key(
+            keys_input.begin(), keys_input.end(), values_input.begin(),
+            keys_output.begin(), values_output.begin(), queue
+        );
+
+    const size_t segment_count = expected_keys.size();
+    BOOST_CHECK(result.first == keys_output.begin() + segment_count);
+
+    std::vector<int> actual_keys(segment_count);
+    std::vector<int> actual_values(segment_count);
+    compute::copy(keys_output.begin(), result.first, actual_keys.begin(), queue);
+    compute::copy(values_output.begin(), result.second, actual_values.begin(), queue);
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        actual_keys.begin(), actual_keys.end(),
+        expected_keys.begin(), expected_keys.end()
+    );
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        actual_values.begin(), actual_values.end(),
+        expected_values.begin(), expected_values.end()
+    );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
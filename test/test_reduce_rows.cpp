@@ -0,0 +1,145 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestReduceRows
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/compute/functional.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/reduce_columns.hpp>
+#include <boost/compute/algorithm/reduce_rows.hpp>
+#include <boost/compute/container/array_view.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/dim.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// returns a rows x columns row-major matrix of small integers
+static std::vector<int> make_matrix(size_t rows, size_t columns)
+{
+    std::vector<int> values(rows * columns);
+    for(size_t i = 0; i < values.size(); i++){
+        values[i] = static_cast<int>((i * 7919) % 1000) - 500;
+    }
+    return values;
+}
+
+BOOST_AUTO_TEST_CASE(reduce_rows_int)
+{
+    int data[] = { 1, 2, 3,
+                   4, 5, 6 };
+    compute::vector<int> matrix(data, data + 6, queue);
+    compute::vector<int> sums(2, context);
+
+    compute::vector<int>::iterator end =
+        compute::reduce_rows(matrix.begin(), 2, 3, sums.begin(), queue);
+    BOOST_CHECK(end == sums.end());
+    CHECK_RANGE_EQUAL(int, 2, sums, (6, 15));
+
+    compute::vector<int> maximums(3, context);
+    compute::reduce_columns(
+        matrix.begin(), 2, 3, maximums.begin(), compute::max<int>(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 3, maximums, (4, 5, 6));
+}
+
+BOOST_AUTO_TEST_CASE(reduce_rows_large)
+{
+    // rows longer than a work-group and not a multiple of the vector width
+    const size_t rows = 37;
+    const size_t columns = 1021;
+    std::vector<int> host_matrix = make_matrix(rows, columns);
+    compute::vector<int> matrix(host_matrix.begin(), host_matrix.end(), queue);
+
+    std::vector<int> expected_sums(rows, 0);
+    std::vector<int> expected_mins(columns, 1000);
+    for(size_t i = 0; i < rows; i++){
+        for(size_t j = 0; j < columns; j++){
+            expected_sums[i] += host_matrix[i * columns + j];
+            expected_mins[j] = (std::min)(expected_mins[j], host_matrix[i * columns + j]);
+        }
+    }
+
+    compute::vector<int> sums(rows, context);
+    compute::reduce_rows(matrix.begin(), rows, columns, sums.begin(), queue);
+    std::vector<int> host_sums(rows);
+    compute::copy(sums.begin(), sums.end(), host_sums.begin(), queue);
+    BOOST_CHECK(host_sums == expected_sums);
+
+    compute::vector<int> mins(columns, context);
+    compute::reduce_columns(
+        matrix.begin(), rows, columns, mins.begin(), compute::min<int>(), queue
+    );
+    std::vector<int> host_mins(columns);
+    compute::copy(mins.begin(), mins.end(), host_mins.begin(), queue);
+    BOOST_CHECK(host_mins == expected_mins);
+}
+
+BOOST_AUTO_TEST_CASE(reduce_columns_tall)
+{
+    // few columns so the rows are split between work-groups
+    const size_t rows = 20000;
+    const size_t columns = 3;
+    std::vector<int> host_matrix = make_matrix(rows, columns);
+    compute::vector<int> matrix(host_matrix.begin(), host_matrix.end(), queue);
+
+    std::vector<int> expected(columns, 0);
+    for(size_t i = 0; i < rows; i++){
+        for(size_t j = 0; j < columns; j++){
+            expected[j] += host_matrix[i * columns + j];
+        }
+    }
+
+    compute::vector<int> sums(columns, context);
+    compute::reduce_columns(matrix.begin(), rows, columns, sums.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 3, sums, (expected[0], expected[1], expected[2]));
+}
+
+BOOST_AUTO_TEST_CASE(reduce_rows_array_view)
+{
+    int data[] = { 1, 2, 3, 4,
+                   5, 6, 7, 8,
+                   9, 10, 11, 12 };
+    compute::vector<int> matrix(data, data + 12, queue);
+    compute::array_view<int, 2> view(matrix.begin(), compute::dim(3, 4));
+
+    // the 2 x 3 section starting at (1, 1)
+    compute::vector<int> sums(3, context);
+    compute::reduce_rows(
+        view.section(compute::dim(1, 1), compute::dim(2, 3)), sums.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 2, sums, (21, 33));
+
+    compute::reduce_columns(
+        view.section(compute::dim(1, 1), compute::dim(2, 3)), sums.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 3, sums, (16, 18, 20));
+
+    // the rows of the transposed view are the columns of the matrix
+    compute::vector<int> maximums(4, context);
+    compute::vector<int>::iterator end = compute::reduce_rows(
+        view.transpose(), maximums.begin(), compute::max<int>(), queue
+    );
+    BOOST_CHECK(end == maximums.end());
+    CHECK_RANGE_EQUAL(int, 4, maximums, (9, 10, 11, 12));
+
+    compute::reduce_columns(
+        view.transpose(), maximums.begin(), compute::max<int>(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 3, maximums, (4, 8, 12));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
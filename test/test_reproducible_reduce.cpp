@@ -0,0 +1,105 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestReproducibleReduce
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/compute/functional.hpp>
+#include <boost/compute/algorithm/reproducible_reduce.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// values of very different magnitudes, whose sum depends on the order of
+// the additions
+static std::vector<float> make_values(size_t count)
+{
+    std::vector<float> values(count);
+    for(size_t i = 0; i < count; i++){
+        const float scale = (i % 3 == 0) ? 1e6f : (i % 3 == 1) ? 1.0f : 1e-3f;
+        values[i] = scale * float((i * 7919) % 1000) / 1000.0f;
+    }
+    return values;
+}
+
+// reduces the values on the host in the order of reproducible_reduce()
+static float reproducible_sum_on_host(std::vector<float> values)
+{
+    const size_t lanes = 32;
+    const size_t block_size = 1024;
+
+    while(values.size() > block_size){
+        std::vector<float> partials;
+        for(size_t start = 0; start < values.size(); start += block_size){
+            const size_t end = (std::min)(start + block_size, values.size());
+            for(size_t lane = start; lane < (std::min)(start + lanes, end); lane++){
+                float sum = values[lane];
+                for(size_t i = lane + lanes; i < end; i += lanes){
+                    sum = sum + values[i];
+                }
+                partials.push_back(sum);
+            }
+        }
+        values.swap(partials);
+    }
+
+    float sum = values[0];
+    for(size_t i = 1; i < values.size(); i++){
+        sum = sum + values[i];
+    }
+    return sum;
+}
+
+BOOST_AUTO_TEST_CASE(reproducible_reduce_int)
+{
+    int data[] = { 1, 5, 9, 13, 17 };
+    compute::vector<int> vector(data, data + 5, queue);
+
+    int sum = 0;
+    compute::reproducible_reduce(vector.begin(), vector.end(), &sum, queue);
+    BOOST_CHECK_EQUAL(sum, 45);
+
+    int max_value = 0;
+    compute::reproducible_reduce(
+        vector.begin(), vector.end(), &max_value, compute::max<int>(), queue
+    );
+    BOOST_CHECK_EQUAL(max_value, 17);
+}
+
+BOOST_AUTO_TEST_CASE(reproducible_reduce_float)
+{
+    // from none up to three passes before the last block
+    const size_t sizes[] = { 1000, 1025, 40000, 2000003 };
+
+    for(size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++){
+        const std::vector<float> host_values = make_values(sizes[i]);
+        compute::vector<float> values(host_values.begin(), host_values.end(), queue);
+
+        float sum = 0;
+        compute::reproducible_reduce(
+            values.begin(), values.end(), &sum, compute::plus<float>(), queue
+        );
+
+        // the same bits as the host sum in the same order
+        BOOST_CHECK_EQUAL(sum, reproducible_sum_on_host(host_values));
+
+        // and every time
+        float again = 0;
+        compute::reproducible_reduce(values.begin(), values.end(), &again, queue);
+        BOOST_CHECK_EQUAL(again, sum);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,142 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestRollingReduce
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/compute/functional.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/rolling_reduce.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// returns (i * 7919) % 1000 - 500 for i in [0, count)
+static std::vector<int> make_values(size_t count)
+{
+    std::vector<int> values(count);
+    for(size_t i = 0; i < count; i++){
+        values[i] = static_cast<int>((i * 7919) % 1000) - 500;
+    }
+    return values;
+}
+
+template<class T, class Function>
+static std::vector<T> rolling_reduce_on_host(const std::vector<T> &values,
+                                             size_t window,
+                                             Function function)
+{
+    std::vector<T> result;
+    for(size_t i = 0; i + window <= values.size(); i++){
+        T value = values[i];
+        for(size_t j = 1; j < window; j++){
+            value = function(value, values[i + j]);
+        }
+        result.push_back(value);
+    }
+    return result;
+}
+
+struct host_min
+{
+    int operator()(int a, int b) const { return (std::min)(a, b); }
+};
+
+struct host_max
+{
+    int operator()(int a, int b) const { return (std::max)(a, b); }
+};
+
+struct host_plus
+{
+    int operator()(int a, int b) const { return a + b; }
+};
+
+BOOST_AUTO_TEST_CASE(rolling_sum_int)
+{
+    int data[] = { 1, 2, 3, 4, 5, 6 };
+    compute::vector<int> input(data, data + 6, queue);
+    compute::vector<int> output(6, context);
+
+    compute::vector<int>::iterator end =
+        compute::rolling_reduce(input.begin(), input.end(), output.begin(), 3, queue);
+    BOOST_CHECK(end == output.begin() + 4);
+    CHECK_RANGE_EQUAL(int, 4, output, (6, 9, 12, 15));
+
+    // a window longer than the range has no results
+    end = compute::rolling_reduce(input.begin(), input.end(), output.begin(), 7, queue);
+    BOOST_CHECK(end == output.begin());
+}
+
+BOOST_AUTO_TEST_CASE(rolling_reduce_windows)
+{
+    // short (tiled) and long (van Herk and scan difference) windows
+    const size_t windows[] = { 1, 5, 16, 17, 100, 1000 };
+
+    std::vector<int> values = make_values(5000);
+    compute::vector<int> input(values.begin(), values.end(), queue);
+    compute::vector<int> output(values.size(), context);
+    std::vector<int> host(values.size());
+
+    for(size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); w++){
+        const size_t window = windows[w];
+        const size_t count = values.size() - window + 1;
+
+        compute::rolling_reduce(
+            input.begin(), input.end(), output.begin(), window,
+            compute::min<int>(), queue
+        );
+        compute::copy(output.begin(), output.begin() + count, host.begin(), queue);
+        BOOST_CHECK(std::equal(host.begin(), host.begin() + count,
+                               rolling_reduce_on_host(values, window, host_min()).begin()));
+
+        compute::rolling_reduce(
+            input.begin(), input.end(), output.begin(), window,
+            compute::max<int>(), queue
+        );
+        compute::copy(output.begin(), output.begin() + count, host.begin(), queue);
+        BOOST_CHECK(std::equal(host.begin(), host.begin() + count,
+                               rolling_reduce_on_host(values, window, host_max()).begin()));
+
+        compute::rolling_reduce(
+            input.begin(), input.end(), output.begin(), window, queue
+        );
+        compute::copy(output.begin(), output.begin() + count, host.begin(), queue);
+        BOOST_CHECK(std::equal(host.begin(), host.begin() + count,
+                               rolling_reduce_on_host(values, window, host_plus()).begin()));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(rolling_sum_float)
+{
+    // exact sums of small integers, the window covers parts of two blocks
+    std::vector<int> values = make_values(1000);
+    std::vector<float> float_values(values.begin(), values.end());
+    compute::vector<float> input(float_values.begin(), float_values.end(), queue);
+    compute::vector<float> output(values.size(), context);
+
+    const size_t window = 64;
+    compute::rolling_reduce(input.begin(), input.end(), output.begin(), window, queue);
+
+    std::vector<int> expected = rolling_reduce_on_host(values, window, host_plus());
+    std::vector<float> host(expected.size());
+    compute::copy(output.begin(), output.begin() + host.size(), host.begin(), queue);
+    for(size_t i = 0; i < expected.size(); i++){
+        BOOST_CHECK_EQUAL(host[i], float(expected[i]));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -66,4 +66,17 @@ BOOST_AUTO_TEST_CASE(rotate_9)
     CHECK_RANGE_EQUAL(int, 10, vector, (6, 1, 4, 2, 6, 3, 2, 5, 3, 4));
 }
 
+BOOST_AUTO_TEST_CASE(rotate_sub_range)
+{
+    int data[] = {1, 4, 2, 6, 3, 2, 5, 3, 4, 6};
+    boost::compute::vector<int> vector(10, context);
+
+    boost::compute::copy_n(data, 10, vector.begin(), queue);
+
+    boost::compute::rotate(
+        vector.begin()+2, vector.begin()+5, vector.begin()+9, queue
+    );
+    CHECK_RANGE_EQUAL(int, 10, vector, (1, 4, 2, 5, 3, 4, 2, 6, 3, 6));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,106 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSampleIf
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/sample_if.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/random/linear_congruential_engine.hpp>
+#include <boost/compute/random/philox_engine.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// checks that sample_if() selects the values whose random numbers from an
+// engine in the same state are below p * 2^32
+template<class Engine>
+void check_sample_if(size_t count, float p, Engine &engine, compute::command_queue &queue)
+{
+    const compute::context &context = queue.get_context();
+
+    compute::vector<int> input(count, context);
+    compute::iota(input.begin(), input.end(), 0, queue);
+
+    Engine reference = engine;
+    compute::vector<compute::uint_> random(count, context);
+    reference.generate(random.begin(), random.end(), queue);
+    std::vector<compute::uint_> host_random(count);
+    compute::copy(random.begin(), random.end(), host_random.begin(), queue);
+
+    compute::vector<int> output(count, context);
+    compute::vector<int>::iterator end = compute::sample_if(
+        input.begin(), input.end(), output.begin(), p, engine, queue
+    );
+
+    std::vector<int> expected;
+    for(size_t i = 0; i < count; i++){
+        if(double(host_random[i]) < double(p) * 4294967296.0){
+            expected.push_back(static_cast<int>(i));
+        }
+    }
+    BOOST_REQUIRE_EQUAL(size_t(end - output.begin()), expected.size());
+
+    std::vector<int> host_output(expected.size());
+    compute::copy(output.begin(), end, host_output.begin(), queue);
+    BOOST_CHECK(host_output == expected);
+
+    // the engine continues after the numbers drawn
+    compute::uint_ next = 0;
+    compute::uint_ reference_next = 0;
+    engine.generate(random.begin(), random.begin() + 1, queue);
+    compute::copy(random.begin(), random.begin() + 1, &next, queue);
+    reference.generate(random.begin(), random.begin() + 1, queue);
+    compute::copy(random.begin(), random.begin() + 1, &reference_next, queue);
+    BOOST_CHECK_EQUAL(next, reference_next);
+}
+
+BOOST_AUTO_TEST_CASE(sample_if_philox)
+{
+    compute::philox4x32 engine(queue, 7);
+    engine.discard(3, queue);
+    check_sample_if(10007, 0.3f, engine, queue);
+
+    // large enough for the single-pass stream compaction
+    check_sample_if(1000003, 0.9f, engine, queue);
+}
+
+BOOST_AUTO_TEST_CASE(sample_if_linear_congruential)
+{
+    compute::linear_congruential_engine<compute::uint_> engine(queue);
+    check_sample_if(5000, 0.5f, engine, queue);
+}
+
+BOOST_AUTO_TEST_CASE(sample_if_all_or_none)
+{
+    int data[] = { 1, 2, 3, 4, 5 };
+    compute::vector<int> input(data, data + 5, queue);
+    compute::vector<int> output(5, context);
+    compute::philox4x32 engine(queue);
+
+    compute::vector<int>::iterator end = compute::sample_if(
+        input.begin(), input.end(), output.begin(), 1.0f, engine, queue
+    );
+    BOOST_CHECK(end == output.end());
+    CHECK_RANGE_EQUAL(int, 5, output, (1, 2, 3, 4, 5));
+
+    end = compute::sample_if(
+        input.begin(), input.end(), output.begin(), 0.0f, engine, queue
+    );
+    BOOST_CHECK(end == output.begin());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
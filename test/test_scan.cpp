@@ -11,15 +11,22 @@
 #define BOOST_TEST_MODULE TestScan
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/fill.hpp>
 #include <boost/compute/algorithm/inclusive_scan.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/iterator/counting_iterator.hpp>
 #include <boost/compute/iterator/transform_iterator.hpp>
+#include <boost/compute/algorithm/detail/single_pass_scan.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/sub_group.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -175,4 +182,80 @@ boost::compute::exclusive_scan(
     CHECK_RANGE_EQUAL(int, 4, output, (0, 1, 3, 6));
 }
 
+BOOST_AUTO_TEST_CASE(scan_int_single_pass)
+{
+    // use the single-pass scan (if supported by the device) for any size
+    boost::shared_ptr<bc::detail::parameter_cache> parameters =
+        bc::detail::parameter_cache::get_global_cache(device);
+    const std::string object =
+        std::string("__boost_scan_") + bc::type_name<int>();
+    parameters->set(object, "single_pass_threshold", 1);
+
+    const size_t size = 100003;
+    std::vector<int> host_input(size);
+    for(size_t i = 0; i < size; i++){
+        host_input[i] = static_cast<int>(i % 7);
+    }
+
+    std::vector<int> expected(size);
+    int sum = 0;
+    for(size_t i = 0; i < size; i++){
+        expected[i] = sum;
+        sum += host_input[i];
+    }
+
+    bc::vector<int> vector(host_input.begin(), host_input.end(), queue);
+    std::vector<int> actual(size);
+
+    // exclusive scan in-place
+    bc::exclusive_scan(vector.begin(), vector.end(), vector.begin(), queue);
+    bc::copy(vector.begin(), vector.end(), actual.begin(), queue);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        actual.begin(), actual.end(), expected.begin(), expected.end()
+    );
+
+    // inclusive scan
+    bc::vector<int> input(host_input.begin(), host_input.end(), queue);
+    bc::inclusive_scan(input.begin(), input.end(), vector.begin(), queue);
+    bc::copy(vector.begin(), vector.end(), actual.begin(), queue);
+    BOOST_CHECK_EQUAL(actual[0], host_input[0]);
+    BOOST_CHECK_EQUAL(actual[size - 1], sum);
+    for(size_t i = 1; i < size; i++){
+        if(actual[i] != expected[i] + host_input[i]){
+            BOOST_ERROR("inclusive scan mismatch at " << i);
+            break;
+        }
+    }
+
+    parameters->reset(object);
+}
+
+BOOST_AUTO_TEST_CASE(scan_int_single_pass_fallback)
+{
+    // force the single-pass scan, devices whose compiler lacks the opencl
+    // 2.0 atomics (e.g. opencl 3.0 devices with opencl c 1.2) must fall
+    // back to the multi-pass scan instead of failing to build it
+    boost::shared_ptr<bc::detail::parameter_cache> parameters =
+        bc::detail::parameter_cache::get_global_cache(device);
+    const std::string object =
+        std::string("__boost_scan_") + bc::type_name<int>();
+    parameters->set(object, "single_pass_threshold", 1);
+
+    const size_t size = 1 << 18;
+    const bool qualifies =
+        bc::detail::device_profile::get(device)->has_local_memory() &&
+        !bc::detail::memory_model_options(device).empty();
+    BOOST_CHECK_EQUAL(bc::detail::use_single_pass_scan<int>(size, queue), qualifies);
+
+    bc::vector<int> vector(size, context);
+    bc::fill(vector.begin(), vector.end(), 1, queue);
+    bc::inclusive_scan(vector.begin(), vector.end(), vector.begin(), queue);
+
+    int last = 0;
+    bc::copy(vector.end() - 1, vector.end(), &last, queue);
+    BOOST_CHECK_EQUAL(last, static_cast<int>(size));
+
+    parameters->reset(object);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
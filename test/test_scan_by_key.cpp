@@ -0,0 +1,149 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestScanByKey
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/inclusive_scan_by_key.hpp>
+#include <boost/compute/algorithm/exclusive_scan_by_key.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(inclusive_scan_by_key_int)
+{
+//! [inclusive_scan_by_key_int]
+// setup keys and values
+int keys[] = { 0, 0, 1, 1, 1, 2, 3, 3 };
+int data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+boost::compute::vector<int> keys_input(keys, keys + 8, queue);
+boost::compute::vector<int> values_input(data, data + 8, queue);
+boost::compute::vector<int> output(8, context);
+
+// scan the values of each key
+boost::compute::inclusive_scan_by_key(
+    keys_input.begin(), keys_input.end(), values_input.begin(), output.begin(), queue
+);
+
+// output = { 1, 3, 3, 7, 12, 6, 7, 15 }
+//! [inclusive_scan_by_key_int]
+
+    CHECK_RANGE_EQUAL(int, 8, output, (1, 3, 3, 7, 12, 6, 7, 15));
+}
+
+BOOST_AUTO_TEST_CASE(exclusive_scan_by_key_int)
+{
+//! [exclusive_scan_by_key_int]
+// setup keys and values
+int keys[] = { 0, 0, 1, 1, 1, 2, 3, 3 };
+int data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+boost::compute::vector<int> keys_input(keys, keys + 8, queue);
+boost::compute::vector<int> values_input(data, data + 8, queue);
+boost::compute::vector<int> output(8, context);
+
+// scan the values of each key
+boost::compute::exclusive_scan_by_key(
+    keys_input.begin(), keys_input.end(), values_input.begin(), output.begin(), queue
+);
+
+// output = { 0, 1, 0, 3, 7, 0, 0, 7 }
+//! [exclusive_scan_by_key_int]
+
+    CHECK_RANGE_EQUAL(int, 8, output, (0, 1, 0, 3, 7, 0, 0, 7));
+}
+
+BOOST_AUTO_TEST_CASE(exclusive_scan_by_key_init_in_place)
+{
+    int keys[] = { 5, 5, 5, 2, 2, 9 };
+    int data[] = { 1, 2, 3, 4, 5, 6 };
+
+    compute::vector<int> keys_input(keys, keys + 6, queue);
+    compute::vector<int> values(data, data + 6, queue);
+
+    compute::vector<int>::iterator end = compute::exclusive_scan_by_key(
+        keys_input.begin(), keys_input.end(), values.begin(), values.begin(),
+        10, compute::plus<int>(), queue
+    );
+
+    BOOST_CHECK(end == values.end());
+    CHECK_RANGE_EQUAL(int, 6, values, (10, 11, 13, 10, 14, 10));
+}
+
+BOOST_AUTO_TEST_CASE(inclusive_scan_by_key_max)
+{
+    int keys[] = { 1, 1, 1, 1, 2, 2 };
+    int data[] = { 3, 1, 4, 1, 5, 9 };
+
+    compute::vector<int> keys_input(keys, keys + 6, queue);
+    compute::vector<int> values_input(data, data + 6, queue);
+    compute::vector<int> output(6, context);
+
+    compute::inclusive_scan_by_key(
+        keys_input.begin(), keys_input.end(), values_input.begin(), output.begin(),
+        compute::max<int>(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 6, output, (3, 3, 4, 4, 5, 9));
+}
+
+BOOST_AUTO_TEST_CASE(scan_by_key_many_segments)
+{
+    // rows of a CSR matrix with between 0 and 12 elements
+    std::vector<int> host_keys;
+    for(int row = 0; host_keys.size() < 200000; row++){
+        for(int j = 0; j < row % 13; j++){
+            host_keys.push_back(row);
+        }
+    }
+    const size_t size = host_keys.size();
+    std::vector<int> host_values(size, 1);
+
+    std::vector<int> expected_inclusive(size);
+    std::vector<int> expected_exclusive(size);
+    for(size_t i = 0; i < size; i++){
+        const bool head = i == 0 || host_keys[i] != host_keys[i - 1];
+        expected_exclusive[i] = head ? 0 : expected_inclusive[i - 1];
+        expected_inclusive[i] = expected_exclusive[i] + host_values[i];
+    }
+
+    compute::vector<int> keys_input(host_keys.begin(), host_keys.end(), queue);
+    compute::vector<int> values_input(host_values.begin(), host_values.end(), queue);
+    compute::vector<int> output(size, context);
+    std::vector<int> actual(size);
+
+    compute::inclusive_scan_by_key(
+        keys_input.begin(), keys_input.end(), values_input.begin(), output.begin(), queue
+    );
+    compute::copy(output.begin(), output.end(), actual.begin(), queue);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        actual.begin(), actual.end(),
+        expected_inclusive.begin(), expected_inclusive.end()
+    );
+
+    compute::exclusive_scan_by_key(
+        keys_input.begin(), keys_input.end(), values_input.begin(), output.begin(), queue
+    );
+    compute::copy(output.begin(), output.end(), actual.begin(), queue);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        actual.begin(), actual.end(),
+        expected_exclusive.begin(), expected_exclusive.end()
+    );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -12,9 +12,12 @@
 #include <boost/test/unit_test.hpp>
 
 #include <boost/compute/system.hpp>
+#include <boost/compute/lambda.hpp>
 #include <boost/compute/algorithm/scatter.hpp>
+#include <boost/compute/algorithm/scatter_if.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/iterator/constant_buffer_iterator.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -54,4 +57,76 @@ BOOST_AUTO_TEST_CASE(scatter_constant_indices)
     CHECK_RANGE_EQUAL(int, 5, output, (1, 3, 5, 4, 2));
 }
 
+BOOST_AUTO_TEST_CASE(scatter_if_int)
+{
+    using bc::lambda::_1;
+
+    int input_data[] = { 1, 2, 3, 4, 5 };
+    bc::vector<int> input(input_data, input_data + 5, queue);
+
+    int map_data[] = { 4, 3, 2, 1, 0 };
+    bc::vector<int> map(map_data, map_data + 5, queue);
+
+    int stencil_data[] = { 1, 0, 1, 0, 2 };
+    bc::vector<int> stencil(stencil_data, stencil_data + 5, queue);
+
+    int output_data[] = { 0, 0, 0, 0, 0 };
+    bc::vector<int> output(output_data, output_data + 5, queue);
+
+    bc::scatter_if(
+        input.begin(), input.end(), map.begin(), stencil.begin(), output.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 5, output, (5, 0, 3, 0, 1));
+
+    bc::scatter_if(
+        input.begin(), input.end(), map.begin(), stencil.begin(), output.begin(),
+        _1 == 0, queue
+    );
+    CHECK_RANGE_EQUAL(int, 5, output, (5, 4, 3, 2, 1));
+}
+
+BOOST_AUTO_TEST_CASE(scatter_with_offsets)
+{
+    int input_data[] = { 7, 1, 2, 3 };
+    bc::vector<int> input(input_data, input_data + 4, queue);
+
+    int map_data[] = { 2, 0, 1 };
+    bc::vector<int> map(map_data, map_data + 3, queue);
+
+    int output_data[] = { 0, 0, 0, 0 };
+    bc::vector<int> output(output_data, output_data + 4, queue);
+
+    bc::scatter(
+        input.begin() + 1, input.end(), map.begin(), output.begin() + 1, queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, output, (0, 2, 3, 1));
+}
+
+BOOST_AUTO_TEST_CASE(scatter_columns)
+{
+    int keys_data[] = { 1, 2, 3 };
+    bc::vector<int> keys(keys_data, keys_data + 3, queue);
+
+    float values_data[] = { 1.5f, 2.5f, 3.5f };
+    bc::vector<float> values(values_data, values_data + 3, queue);
+
+    int map_data[] = { 1, 2, 0 };
+    bc::vector<int> map(map_data, map_data + 3, queue);
+
+    bc::vector<int> output_keys(3, context);
+    bc::vector<float> output_values(3, context);
+
+    bc::scatter(
+        bc::make_zip_iterator(boost::make_tuple(keys.begin(), values.begin())),
+        bc::make_zip_iterator(boost::make_tuple(keys.end(), values.end())),
+        map.begin(),
+        bc::make_zip_iterator(
+            boost::make_tuple(output_keys.begin(), output_values.begin())
+        ),
+        queue
+    );
+    CHECK_RANGE_EQUAL(int, 3, output_keys, (3, 1, 2));
+    CHECK_RANGE_EQUAL(float, 3, output_values, (3.5f, 1.5f, 2.5f));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
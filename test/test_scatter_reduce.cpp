@@ -0,0 +1,116 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestScatterReduce
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/scatter_add.hpp>
+#include <boost/compute/algorithm/scatter_reduce.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/atomic.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(scatter_add_int)
+{
+    int input_data[] = { 1, 2, 3, 4, 5, 6 };
+    bc::vector<int> input(input_data, input_data + 6, queue);
+
+    int map_data[] = { 0, 2, 0, 1, 2, 2 };
+    bc::vector<int> map(map_data, map_data + 6, queue);
+
+    bc::vector<int> output(3, context);
+    bc::fill(output.begin(), output.end(), 10, queue);
+    bc::scatter_add(input.begin(), input.end(), map.begin(), output.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 3, output, (14, 14, 23));
+}
+
+BOOST_AUTO_TEST_CASE(scatter_add_float)
+{
+    // sums of small integers are exact in any order
+    float input_data[] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f };
+    bc::vector<float> input(input_data, input_data + 8, queue);
+
+    int map_data[] = { 3, 0, 3, 3, 1, 0, 3, 1 };
+    bc::vector<int> map(map_data, map_data + 8, queue);
+
+    bc::vector<float> output(4, context);
+    bc::fill(output.begin(), output.end(), 0.5f, queue);
+    bc::scatter_add(input.begin(), input.end(), map.begin(), output.begin(), queue);
+    CHECK_RANGE_EQUAL(float, 4, output, (8.5f, 13.5f, 0.5f, 15.5f));
+}
+
+BOOST_AUTO_TEST_CASE(scatter_add_double)
+{
+    if(!device.supports_extension("cl_khr_fp64") ||
+       !device.supports_extension("cl_khr_int64_base_atomics")){
+        std::cout << "skipping test: device does not support 64-bit atomics" << std::endl;
+        return;
+    }
+
+    double input_data[] = { 1.5, 2.5, 3.5, 4.5 };
+    bc::vector<double> input(input_data, input_data + 4, queue);
+
+    int map_data[] = { 1, 1, 0, 1 };
+    bc::vector<int> map(map_data, map_data + 4, queue);
+
+    bc::vector<double> output(2, context);
+    bc::fill(output.begin(), output.end(), 0.0, queue);
+    bc::scatter_add(input.begin(), input.end(), map.begin(), output.begin(), queue);
+    CHECK_RANGE_EQUAL(double, 2, output, (3.5, 8.5));
+}
+
+BOOST_AUTO_TEST_CASE(scatter_reduce_float_min_max)
+{
+    float input_data[] = { 2.5f, -1.0f, 7.0f, 3.0f, -4.5f, 0.5f };
+    bc::vector<float> input(input_data, input_data + 6, queue);
+
+    int map_data[] = { 0, 1, 0, 1, 1, 0 };
+    bc::vector<int> map(map_data, map_data + 6, queue);
+
+    bc::vector<float> output(3, context);
+    bc::fill(output.begin(), output.end(), 1.0f, queue);
+    bc::scatter_reduce(
+        input.begin(), input.end(), map.begin(), output.begin(),
+        bc::atomic_min<float>(), queue
+    );
+    CHECK_RANGE_EQUAL(float, 3, output, (0.5f, -4.5f, 1.0f));
+
+    bc::fill(output.begin(), output.end(), 1.0f, queue);
+    bc::scatter_reduce(
+        input.begin(), input.end(), map.begin(), output.begin(),
+        bc::atomic_max<float>(), queue
+    );
+    CHECK_RANGE_EQUAL(float, 3, output, (7.0f, 3.0f, 1.0f));
+}
+
+BOOST_AUTO_TEST_CASE(scatter_reduce_int_max)
+{
+    int input_data[] = { 4, 9, 2, 7 };
+    bc::vector<int> input(input_data, input_data + 4, queue);
+
+    int map_data[] = { 1, 0, 1, 1 };
+    bc::vector<int> map(map_data, map_data + 4, queue);
+
+    bc::vector<int> output(2, context);
+    bc::fill(output.begin(), output.end(), 0, queue);
+    bc::scatter_reduce(
+        input.begin(), input.end(), map.begin(), output.begin(),
+        bc::atomic_max<int>(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 2, output, (9, 7));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
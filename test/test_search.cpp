@@ -13,6 +13,7 @@
 
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/fill.hpp>
 #include <boost/compute/algorithm/search.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/types/fundamental.hpp>
@@ -60,4 +61,33 @@ BOOST_AUTO_TEST_CASE(search_string)
     BOOST_VERIFY(iter == vectort.begin() + 2);
 }
 
+BOOST_AUTO_TEST_CASE(search_large_text)
+{
+    bc::vector<bc::char_> vectort(500000, context);
+    bc::fill(vectort.begin(), vectort.end(), 'a', queue);
+
+    char pattern[] = "ab";
+    bc::vector<bc::char_> vectorp(pattern, pattern + 2, queue);
+
+    bc::vector<bc::char_>::iterator iter =
+        bc::search(vectort.begin(), vectort.end(),
+                   vectorp.begin(), vectorp.end(), queue);
+    BOOST_CHECK(iter == vectort.end());
+
+    vectort[499999] = 'b';
+    vectort[300000] = 'b';
+    iter = bc::search(vectort.begin(), vectort.end(),
+                      vectorp.begin(), vectorp.end(), queue);
+    BOOST_CHECK(iter == vectort.begin() + 299999);
+
+    // empty pattern and pattern longer than the text
+    iter = bc::search(vectort.begin(), vectort.end(),
+                      vectorp.begin(), vectorp.begin(), queue);
+    BOOST_CHECK(iter == vectort.begin());
+
+    iter = bc::search(vectorp.begin(), vectorp.begin() + 1,
+                      vectorp.begin(), vectorp.end(), queue);
+    BOOST_CHECK(iter == vectorp.begin() + 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
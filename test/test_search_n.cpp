@@ -12,6 +12,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill.hpp>
 #include <boost/compute/algorithm/search_n.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/types/fundamental.hpp>
@@ -48,4 +49,22 @@ BOOST_AUTO_TEST_CASE(search_string)
     BOOST_VERIFY(iter == vectort.begin() + 2);
 }
 
+BOOST_AUTO_TEST_CASE(search_n_large_text)
+{
+    bc::vector<bc::int_> vectort(500000, context);
+    bc::fill(vectort.begin(), vectort.end(), 0, queue);
+
+    bc::vector<bc::int_>::iterator iter =
+        bc::search_n(vectort.begin(), vectort.end(), 3, 1, queue);
+    BOOST_CHECK(iter == vectort.end());
+
+    bc::fill(vectort.begin() + 400000, vectort.begin() + 400003, 1, queue);
+    bc::fill(vectort.begin() + 7, vectort.begin() + 9, 1, queue);
+    iter = bc::search_n(vectort.begin(), vectort.end(), 3, 1, queue);
+    BOOST_CHECK(iter == vectort.begin() + 400000);
+
+    iter = bc::search_n(vectort.begin(), vectort.end(), 2, 1, queue);
+    BOOST_CHECK(iter == vectort.begin() + 7);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
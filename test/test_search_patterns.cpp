@@ -0,0 +1,127 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSearchPatterns
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/search_patterns.hpp>
+#include <boost/compute/container/string.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/pattern_set.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(build_pattern_set)
+{
+    std::vector<std::string> keywords;
+    keywords.push_back("he");
+    keywords.push_back("she");
+    keywords.push_back("his");
+    keywords.push_back("hers");
+
+    bc::pattern_set patterns(keywords, queue);
+    BOOST_CHECK_EQUAL(patterns.size(), size_t(4));
+    BOOST_CHECK_EQUAL(patterns.max_pattern_length(), size_t(4));
+
+    // root, h, he, her, hers, hi, his, s, sh, she
+    BOOST_CHECK_EQUAL(patterns.state_count(), size_t(10));
+    BOOST_CHECK_EQUAL(patterns.transitions().size(), size_t(10 * 256));
+
+    BOOST_CHECK_THROW(bc::pattern_set(std::vector<std::string>(), queue), std::invalid_argument);
+    keywords.push_back("");
+    BOOST_CHECK_THROW(bc::pattern_set(keywords, queue), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(count_keywords)
+{
+    std::vector<std::string> keywords;
+    keywords.push_back("he");
+    keywords.push_back("she");
+    keywords.push_back("his");
+    keywords.push_back("hers");
+    bc::pattern_set patterns(keywords, queue);
+
+    bc::string text("ushers said his hat was hers");
+
+    bc::vector<bc::uint_> counts(4, context);
+    bc::fill(counts.begin(), counts.end(), 0, queue);
+    bc::count_patterns(text.begin(), text.end(), patterns, counts.begin(), queue);
+
+    // "he" also occurs inside both "hers"
+    CHECK_RANGE_EQUAL(bc::uint_, 4, counts, (2, 1, 1, 2));
+}
+
+BOOST_AUTO_TEST_CASE(search_keywords)
+{
+    std::vector<std::string> keywords;
+    keywords.push_back("he");
+    keywords.push_back("she");
+    keywords.push_back("hers");
+    bc::pattern_set patterns(keywords, queue);
+
+    const char data[] = "ushers";
+    bc::vector<char> text(data, data + 6, queue);
+
+    bc::vector<bc::uint_> positions(8, context);
+    bc::vector<bc::uint_> ids(8, context);
+    size_t count = bc::search_patterns(
+        text.begin(), text.end(), patterns, positions.begin(), ids.begin(), queue
+    );
+
+    // "she" and "he" end at the same character, the longer one comes first
+    BOOST_CHECK_EQUAL(count, size_t(3));
+    CHECK_RANGE_EQUAL(bc::uint_, 3, positions, (1, 2, 2));
+    CHECK_RANGE_EQUAL(bc::uint_, 3, ids, (1, 0, 2));
+}
+
+BOOST_AUTO_TEST_CASE(search_across_segments)
+{
+    std::vector<std::string> keywords;
+    keywords.push_back("needle");
+    keywords.push_back("pin");
+    bc::pattern_set patterns(keywords, queue);
+
+    // matches at the start, straddling segment boundaries and at the end
+    std::string host_text(100000, 'x');
+    const size_t needles[] = { 0, 250, 253, 1021, 4093, 99994 };
+    for(size_t i = 0; i < 6; i++){
+        host_text.replace(needles[i], 6, "needle");
+    }
+    host_text.replace(50000, 3, "pin");
+
+    bc::vector<char> text(host_text.begin(), host_text.end(), queue);
+
+    bc::vector<bc::uint_> counts(2, context);
+    bc::fill(counts.begin(), counts.end(), 0, queue);
+    bc::count_patterns(text.begin(), text.end(), patterns, counts.begin(), queue);
+    CHECK_RANGE_EQUAL(bc::uint_, 2, counts, (5, 1));
+
+    // the needle at 250 was partly overwritten by the one at 253
+    bc::vector<bc::uint_> positions(16, context);
+    bc::vector<bc::uint_> ids(16, context);
+    size_t count = bc::search_patterns(
+        text.begin(), text.end(), patterns, positions.begin(), ids.begin(), queue
+    );
+    BOOST_CHECK_EQUAL(count, size_t(6));
+    CHECK_RANGE_EQUAL(bc::uint_, 6, positions, (0, 253, 1021, 4093, 50000, 99994));
+    CHECK_RANGE_EQUAL(bc::uint_, 6, ids, (0, 0, 0, 0, 1, 0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,74 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSegmentedSort
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/segmented_sort.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(segmented_sort_int)
+{
+    int data[] = { 3, 1, 2,  9,  5, 4, 8, 6, 7,  0, -1 };
+    compute::uint_ offsets_data[] = { 0, 3, 4, 4, 9, 11 };
+
+    compute::vector<int> vector(data, data + 11, queue);
+    compute::vector<compute::uint_> offsets(offsets_data, offsets_data + 6, queue);
+
+    compute::segmented_sort(vector.begin(), offsets.begin(), offsets.end(), queue);
+    CHECK_RANGE_EQUAL(int, 11, vector, (1, 2, 3, 9, 4, 5, 6, 7, 8, -1, 0));
+
+    compute::segmented_sort(
+        vector.begin(), offsets.begin(), offsets.end(), compute::greater<int>(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 11, vector, (3, 2, 1, 9, 8, 7, 6, 5, 4, 0, -1));
+}
+
+BOOST_AUTO_TEST_CASE(segmented_sort_many_segments)
+{
+    // small segments sorted in local memory and large ones by sort()
+    std::vector<compute::uint_> host_offsets(1, 0);
+    for(compute::uint_ i = 0; i < 500; i++){
+        const compute::uint_ size = i == 250 ? 20000 : (i * 37) % 2000;
+        host_offsets.push_back(host_offsets.back() + size);
+    }
+
+    std::vector<float> host(host_offsets.back());
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = float((i * 7919) % 10007);
+    }
+
+    compute::vector<float> vector(host.begin(), host.end(), queue);
+    compute::vector<compute::uint_> offsets(
+        host_offsets.begin(), host_offsets.end(), queue
+    );
+    compute::segmented_sort(vector.begin(), offsets.begin(), offsets.end(), queue);
+
+    for(size_t i = 0; i + 1 < host_offsets.size(); i++){
+        std::sort(host.begin() + host_offsets[i], host.begin() + host_offsets[i + 1]);
+    }
+
+    std::vector<float> result(host.size());
+    compute::copy(vector.begin(), vector.end(), result.begin(), queue);
+    BOOST_CHECK(result == host);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -11,10 +11,16 @@
 #define BOOST_TEST_MODULE TestSetIntersection
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/scratch_size.hpp>
 #include <boost/compute/algorithm/set_intersection.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/utility/scratch_space.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -59,4 +65,127 @@ BOOST_AUTO_TEST_CASE(set_intersection_string)
     BOOST_VERIFY(iter == result.begin()+5);
 }
 
+BOOST_AUTO_TEST_CASE(set_intersection_int_large)
+{
+    // many tiles and long runs of equal values
+    std::vector<int> data1(25000);
+    std::vector<int> data2(17000);
+    for(size_t i = 0; i < data1.size(); i++){
+        data1[i] = static_cast<int>(i / 7);
+    }
+    for(size_t i = 0; i < data2.size(); i++){
+        data2[i] = static_cast<int>((i * 3) / 5);
+    }
+    bc::vector<int> set1(data1.begin(), data1.end(), queue);
+    bc::vector<int> set2(data2.begin(), data2.end(), queue);
+    bc::vector<int> result(data1.size() + data2.size(), queue.get_context());
+
+    std::vector<int> expected(data1.size() + data2.size());
+    expected.erase(
+        std::set_intersection(data1.begin(), data1.end(),
+                data2.begin(), data2.end(),
+                expected.begin()),
+        expected.end()
+    );
+
+    bc::vector<int>::iterator iter =
+        bc::set_intersection(set1.begin(), set1.end(),
+               set2.begin(), set2.end(),
+               result.begin(), queue);
+    BOOST_CHECK_EQUAL(size_t(iter - result.begin()), expected.size());
+
+    std::vector<int> host_result(expected.size());
+    bc::copy(result.begin(), iter, host_result.begin(), queue);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        host_result.begin(), host_result.end(), expected.begin(), expected.end()
+    );
+}
+
+BOOST_AUTO_TEST_CASE(set_intersection_small_large)
+{
+    // the values of the smaller range are searched for in the larger one
+    std::vector<int> large(4096);
+    for(size_t i = 0; i < large.size(); i++){
+        large[i] = static_cast<int>(i / 2);
+    }
+    int small[] = {-1, 3, 3, 3, 100, 101, 5000};
+
+    bc::vector<int> large_set(large.begin(), large.end(), queue);
+    bc::vector<int> small_set(small, small + 7, queue);
+    bc::vector<int> result(large.size(), context);
+    std::vector<int> expected(large.size());
+    std::vector<int> host(large.size());
+
+    bc::vector<int>::iterator end =
+        bc::set_intersection(small_set.begin(), small_set.end(),
+                   large_set.begin(), large_set.end(),
+                   result.begin(), queue);
+    size_t count =
+        std::set_intersection(small, small + 7, large.begin(), large.end(),
+                    expected.begin()) - expected.begin();
+    BOOST_CHECK_EQUAL(size_t(end - result.begin()), count);
+    bc::copy(result.begin(), end, host.begin(), queue);
+    BOOST_CHECK(std::equal(host.begin(), host.begin() + count, expected.begin()));
+
+    end = bc::set_intersection(large_set.begin(), large_set.end(),
+                     small_set.begin(), small_set.end(),
+                     result.begin(), queue);
+    count =
+        std::set_intersection(large.begin(), large.end(), small, small + 7,
+                    expected.begin()) - expected.begin();
+    BOOST_CHECK_EQUAL(size_t(end - result.begin()), count);
+    bc::copy(result.begin(), end, host.begin(), queue);
+    BOOST_CHECK(std::equal(host.begin(), host.begin() + count, expected.begin()));
+}
+
+#ifdef CL_VERSION_1_1
+BOOST_AUTO_TEST_CASE(set_intersection_with_little_memory)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    // long runs of equal values in both ranges
+    std::vector<int> data1(100000);
+    std::vector<int> data2(100000);
+    for(size_t i = 0; i < data1.size(); i++){
+        data1[i] = static_cast<int>(i / 3);
+        data2[i] = static_cast<int>(i / 5) * 2;
+    }
+    data1.back() = 1000000;
+
+    bc::vector<int> set1(data1.begin(), data1.end(), queue);
+    bc::vector<int> set2(data2.begin(), data2.end(), queue);
+    bc::vector<int> result(data1.size() + data2.size(), queue.get_context());
+
+    std::vector<int> expected(data1.size() + data2.size());
+    expected.erase(
+        std::set_intersection(data1.begin(), data1.end(),
+                data2.begin(), data2.end(),
+                expected.begin()),
+        expected.end()
+    );
+
+    // room for the temporaries of about an eighth of the values, so the
+    // ranges are processed in chunks
+    const size_t scratch_size =
+        bc::set_operation_scratch_size<int>(data1.size() / 8, data2.size() / 8, queue);
+    bc::scratch_space scratch(bc::buffer(context, scratch_size + 16384), false);
+
+    bc::vector<int>::iterator iter;
+    {
+        bc::scoped_scratch_space use_scratch(scratch);
+        iter = bc::set_intersection(set1.begin(), set1.end(),
+                   set2.begin(), set2.end(),
+                   result.begin(), queue);
+        queue.finish();
+    }
+    BOOST_CHECK_EQUAL(size_t(iter - result.begin()), expected.size());
+
+    std::vector<int> host_result(expected.size());
+    bc::copy(result.begin(), iter, host_result.begin(), queue);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        host_result.begin(), host_result.end(), expected.begin(), expected.end()
+    );
+}
+#endif // CL_VERSION_1_1
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -11,7 +11,11 @@
 #define BOOST_TEST_MODULE TestSetSymmetricDifference
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/set_symmetric_difference.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/types/fundamental.hpp>
@@ -60,4 +64,40 @@ BOOST_AUTO_TEST_CASE(set_symmetric_difference_string)
     BOOST_VERIFY(iter == result.begin()+9);
 }
 
+BOOST_AUTO_TEST_CASE(set_symmetric_difference_int_large)
+{
+    // many tiles and long runs of equal values
+    std::vector<int> data1(25000);
+    std::vector<int> data2(17000);
+    for(size_t i = 0; i < data1.size(); i++){
+        data1[i] = static_cast<int>(i / 7);
+    }
+    for(size_t i = 0; i < data2.size(); i++){
+        data2[i] = static_cast<int>((i * 3) / 5);
+    }
+    bc::vector<int> set1(data1.begin(), data1.end(), queue);
+    bc::vector<int> set2(data2.begin(), data2.end(), queue);
+    bc::vector<int> result(data1.size() + data2.size(), queue.get_context());
+
+    std::vector<int> expected(data1.size() + data2.size());
+    expected.erase(
+        std::set_symmetric_difference(data1.begin(), data1.end(),
+                data2.begin(), data2.end(),
+                expected.begin()),
+        expected.end()
+    );
+
+    bc::vector<int>::iterator iter =
+        bc::set_symmetric_difference(set1.begin(), set1.end(),
+               set2.begin(), set2.end(),
+               result.begin(), queue);
+    BOOST_CHECK_EQUAL(size_t(iter - result.begin()), expected.size());
+
+    std::vector<int> host_result(expected.size());
+    bc::copy(result.begin(), iter, host_result.begin(), queue);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        host_result.begin(), host_result.end(), expected.begin(), expected.end()
+    );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,161 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSoaVector
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/soa_vector.hpp>
+#include <boost/compute/functional/field.hpp>
+#include <boost/compute/types/struct.hpp>
+
+namespace compute = boost::compute;
+
+struct particle
+{
+    float x;
+    float y;
+    int id;
+};
+
+BOOST_COMPUTE_ADAPT_STRUCT(particle, particle, (x, y, id))
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+static std::vector<particle> make_particles(size_t count)
+{
+    std::vector<particle> particles(count);
+    for(size_t i = 0; i < count; i++){
+        particles[i].x = float(i);
+        particles[i].y = float(i) * 2.f;
+        particles[i].id = int(i) + 100;
+    }
+    return particles;
+}
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+    compute::soa_vector<particle> particles(context);
+    BOOST_CHECK(particles.empty());
+    BOOST_CHECK_EQUAL(particles.size(), size_t(0));
+    BOOST_CHECK_EQUAL(particles.member_count(), size_t(3));
+}
+
+BOOST_AUTO_TEST_CASE(host_round_trip)
+{
+    std::vector<particle> host = make_particles(16);
+    compute::soa_vector<particle> particles(host.begin(), host.end(), queue);
+    BOOST_CHECK_EQUAL(particles.size(), size_t(16));
+
+    std::vector<particle> result(16);
+    compute::copy(particles.begin(), particles.end(), result.begin(), queue);
+    for(size_t i = 0; i < 16; i++){
+        BOOST_CHECK_EQUAL(result[i].x, host[i].x);
+        BOOST_CHECK_EQUAL(result[i].y, host[i].y);
+        BOOST_CHECK_EQUAL(result[i].id, host[i].id);
+    }
+
+    // the members are stored in separate buffers
+    CHECK_RANGE_EQUAL(
+        int, 4, compute::vector<int>(
+            particles.member_begin(&particle::id),
+            particles.member_begin(&particle::id) + 4,
+            queue
+        ),
+        (100, 101, 102, 103)
+    );
+}
+
+BOOST_AUTO_TEST_CASE(member_algorithms)
+{
+    using compute::lambda::_1;
+
+    std::vector<particle> host = make_particles(8);
+    compute::soa_vector<particle> particles(host.begin(), host.end(), queue);
+
+    // only the x-coordinates are read and written
+    compute::transform(
+        particles.member_begin(&particle::x),
+        particles.member_end(&particle::x),
+        particles.member_begin(&particle::x),
+        _1 + 1.f,
+        queue
+    );
+
+    float sum = 0;
+    compute::reduce(
+        particles.member_begin(&particle::x),
+        particles.member_end(&particle::x),
+        &sum,
+        queue
+    );
+    BOOST_CHECK_CLOSE(sum, 36.f, 1e-4f);
+}
+
+BOOST_AUTO_TEST_CASE(struct_values)
+{
+    std::vector<particle> host = make_particles(8);
+    compute::soa_vector<particle> particles(host.begin(), host.end(), queue);
+
+    // the structs are assembled from their members in the kernel
+    compute::vector<int> ids(8, context);
+    compute::transform(
+        particles.begin(),
+        particles.end(),
+        ids.begin(),
+        compute::field<int>("id"),
+        queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, ids, (100, 101, 102, 103));
+
+    // array-of-structs to structure-of-arrays on the device
+    compute::vector<particle> aos(host.begin(), host.end(), queue);
+    compute::soa_vector<particle> copy(context);
+    copy.assign(aos.begin(), aos.end(), queue);
+    BOOST_CHECK_EQUAL(copy.size(), size_t(8));
+
+    std::vector<particle> result(8);
+    compute::copy(copy.begin(), copy.end(), result.begin(), queue);
+    BOOST_CHECK_EQUAL(result[7].y, 14.f);
+    BOOST_CHECK_EQUAL(result[7].id, 107);
+}
+
+BOOST_AUTO_TEST_CASE(resize)
+{
+    std::vector<particle> host = make_particles(4);
+    compute::soa_vector<particle> particles(host.begin(), host.end(), queue);
+
+    particles.resize(64, queue);
+    BOOST_CHECK_EQUAL(particles.size(), size_t(64));
+    BOOST_CHECK(particles.capacity() >= 64);
+
+    std::vector<particle> result(4);
+    compute::copy(particles.begin(), particles.begin() + 4, result.begin(), queue);
+    BOOST_CHECK_EQUAL(result[3].x, 3.f);
+    BOOST_CHECK_EQUAL(result[3].id, 103);
+}
+
+BOOST_AUTO_TEST_CASE(member_not_found)
+{
+    compute::soa_vector<particle> particles(4, context);
+
+    float particle::*none = 0;
+    BOOST_CHECK_THROW(particles.member_begin(none), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,122 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSobolEngine
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/function.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/equal.hpp>
+#include <boost/compute/algorithm/transform_reduce.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/random/sobol_engine.hpp>
+#include <boost/compute/random/uniform_real_distribution.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(generate_uint)
+{
+    using compute::uint_;
+
+    compute::sobol_engine engine(queue, 2);
+    BOOST_CHECK_EQUAL(engine.dimensions(), size_t(2));
+
+    // (0, 0), (1/2, 1/2), (3/4, 1/4), (1/4, 3/4), (3/8, 3/8)
+    compute::vector<uint_> vector(10, context);
+    engine.generate(vector.begin(), vector.end(), queue);
+    CHECK_RANGE_EQUAL(
+        uint_, 10, vector,
+        (uint_(0), uint_(0),
+         uint_(0x80000000), uint_(0x80000000),
+         uint_(0xC0000000), uint_(0x40000000),
+         uint_(0x40000000), uint_(0xC0000000),
+         uint_(0x60000000), uint_(0x60000000))
+    );
+
+    // the next points continue the sequence
+    engine.generate(vector.begin(), vector.begin() + 2, queue);
+    CHECK_RANGE_EQUAL(
+        uint_, 2, vector,
+        (uint_(0xE0000000), uint_(0xE0000000))
+    );
+}
+
+BOOST_AUTO_TEST_CASE(generate_in_parts)
+{
+    using compute::uint_;
+
+    // parts that do not start at the blocks of the work-items
+    compute::vector<uint_> whole(3 * 10007, context);
+    compute::sobol_engine engine1(queue, 3);
+    engine1.generate(whole.begin(), whole.end(), queue);
+
+    compute::vector<uint_> parts(3 * 10007, context);
+    compute::sobol_engine engine2(queue, 3);
+    engine2.generate(parts.begin(), parts.begin() + 3 * 5, queue);
+    engine2.discard(1000, queue);
+    engine2.seed(queue);
+    engine2.discard(5, queue);
+    engine2.generate(parts.begin() + 3 * 5, parts.begin() + 3 * 4000, queue);
+    engine2.generate(parts.begin() + 3 * 4000, parts.end(), queue);
+
+    BOOST_CHECK(
+        compute::equal(whole.begin(), whole.end(), parts.begin(), queue)
+    );
+
+    // the same points with the coordinates of each dimension together
+    compute::vector<uint_> by_dimension(3 * 10007, context);
+    compute::sobol_engine engine3(queue, 3);
+    engine3.generate_by_dimension(by_dimension.begin(), by_dimension.end(), queue);
+
+    std::vector<uint_> host_whole(whole.size());
+    std::vector<uint_> host_by_dimension(by_dimension.size());
+    compute::copy(whole.begin(), whole.end(), host_whole.begin(), queue);
+    compute::copy(by_dimension.begin(), by_dimension.end(), host_by_dimension.begin(), queue);
+    for(size_t p = 0; p < 10007; p++){
+        for(size_t d = 0; d < 3; d++){
+            BOOST_CHECK_EQUAL(host_by_dimension[d * 10007 + p], host_whole[p * 3 + d]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(integrate)
+{
+    BOOST_COMPUTE_FUNCTION(float, product, (compute::float2_ p),
+    {
+        return p.x * p.y;
+    });
+
+    // the integral of x * y over the unit square is 1/4
+    const size_t count = 4096;
+    compute::vector<compute::float2_> points(count, context);
+    compute::sobol_engine engine(queue, 2);
+    compute::uniform_real_distribution<float> distribution;
+    distribution.generate(
+        compute::make_buffer_iterator<float>(points.get_buffer(), 0),
+        compute::make_buffer_iterator<float>(points.get_buffer(), count * 2),
+        engine,
+        queue
+    );
+
+    float sum = 0;
+    compute::transform_reduce(
+        points.begin(), points.end(), &sum, product, compute::plus<float>(), queue
+    );
+    BOOST_CHECK_CLOSE(sum / count, 0.25f, 0.1f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -11,10 +11,18 @@
 #define BOOST_TEST_MODULE TestSort
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <vector>
+
 #include <boost/compute/system.hpp>
+#include <boost/compute/function.hpp>
 #include <boost/compute/algorithm/sort.hpp>
 #include <boost/compute/algorithm/is_sorted.hpp>
+#include <boost/compute/algorithm/detail/merge_sort_on_cpu.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -269,6 +277,56 @@ BOOST_AUTO_TEST_CASE(sort_vectors_by_length)
     BOOST_CHECK_EQUAL(data[9], 0.0f);
 }
 
+BOOST_AUTO_TEST_CASE(sort_int_custom_function)
+{
+    BOOST_COMPUTE_FUNCTION(bool, descending, (int a, int b),
+    {
+        return a > b;
+    });
+
+    std::vector<int> data(10000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>((i * 7919) % 1000);
+    }
+
+    boost::compute::vector<int> vector(data.begin(), data.end(), queue);
+    BOOST_CHECK(!boost::compute::is_sorted(vector.begin(), vector.end(), descending, queue));
+
+    // custom comparators use the parallel merge sort
+    boost::compute::sort(vector.begin(), vector.end(), descending, queue);
+    BOOST_CHECK(boost::compute::is_sorted(vector.begin(), vector.end(), descending, queue));
+
+    std::sort(data.begin(), data.end(), std::greater<int>());
+    std::vector<int> result(data.size());
+    boost::compute::copy(vector.begin(), vector.end(), result.begin(), queue);
+    BOOST_CHECK(result == data);
+}
+
+BOOST_AUTO_TEST_CASE(sort_uint_bit_range)
+{
+    using boost::compute::uint_;
+
+    // 20-bit keys, large enough to skip the constant high digits
+    std::vector<uint_> data(100000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<uint_>((i * 7919) % (1 << 20));
+    }
+
+    boost::compute::vector<uint_> vector(data.begin(), data.end(), queue);
+    boost::compute::sort(vector.begin(), vector.end(), 0, 20, queue);
+
+    std::sort(data.begin(), data.end());
+    std::vector<uint_> result(data.size());
+    boost::compute::copy(vector.begin(), vector.end(), result.begin(), queue);
+    BOOST_CHECK(result == data);
+
+    // sorting by the high 4 of the 8 bits ignores the low bits
+    uint_ values[] = { 0x21, 0x13, 0x12, 0x20, 0x11 };
+    boost::compute::vector<uint_> small(values, values + 5, queue);
+    boost::compute::sort(small.begin(), small.end(), 4, 8, queue);
+    CHECK_RANGE_EQUAL(uint_, 5, small, (0x13, 0x12, 0x11, 0x21, 0x20));
+}
+
 BOOST_AUTO_TEST_CASE(sort_host_vector)
 {
     int data[] = { 5, 2, 3, 6, 7, 4, 0, 1 };
@@ -277,4 +335,91 @@ BOOST_AUTO_TEST_CASE(sort_host_vector)
     CHECK_RANGE_EQUAL(int, 8, vector, (0, 1, 2, 3, 4, 5, 6, 7));
 }
 
+BOOST_AUTO_TEST_CASE(sort_host_vector_on_host_and_device)
+{
+    boost::shared_ptr<boost::compute::detail::parameter_cache> parameters =
+        boost::compute::detail::parameter_cache::get_global_cache(device);
+
+    std::vector<int> data(20000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>((i * 7919) % data.size());
+    }
+
+    std::vector<int> ascending = data;
+    std::sort(ascending.begin(), ascending.end());
+    std::vector<int> descending(ascending.rbegin(), ascending.rend());
+
+    // sorted on the device (threshold of zero) and on the host
+    const boost::compute::uint_ thresholds[] = { 0, 1 << 20 };
+    for(size_t i = 0; i < 2; i++){
+        parameters->set("__boost_host_sort_int", "threshold", thresholds[i]);
+
+        std::vector<int> vector = data;
+        boost::compute::sort(vector.begin(), vector.end(), queue);
+        BOOST_CHECK(vector == ascending);
+
+        vector = data;
+        boost::compute::sort(
+            vector.begin(), vector.end(), boost::compute::greater<int>(), queue
+        );
+        BOOST_CHECK(vector == descending);
+    }
+
+    parameters->reset("__boost_host_sort_int");
+}
+
+BOOST_AUTO_TEST_CASE(sort_host_vector_with_nan)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    std::vector<float> data(1000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = i % 10 == 0 ? nan : static_cast<float>((i * 7919) % 1000) - 500.0f;
+    }
+
+    // sorted on the host, nan values are ordered after the largest value
+    std::vector<float> vector = data;
+    boost::compute::sort(vector.begin(), vector.end(), queue);
+    BOOST_CHECK(
+        std::adjacent_find(vector.begin(), vector.begin() + 900,
+                           std::greater<float>()) == vector.begin() + 900
+    );
+    for(size_t i = 900; i < vector.size(); i++){
+        BOOST_CHECK(vector[i] != vector[i]);
+    }
+
+    vector = data;
+    boost::compute::sort(
+        vector.begin(), vector.end(), boost::compute::greater<float>(), queue
+    );
+    for(size_t i = 0; i < 100; i++){
+        BOOST_CHECK(vector[i] != vector[i]);
+    }
+    BOOST_CHECK(
+        std::adjacent_find(vector.begin() + 100, vector.end(),
+                           std::less<float>()) == vector.end()
+    );
+}
+
+// the merge sort used on cpu devices, run directly so that it is tested
+// on every device
+BOOST_AUTO_TEST_CASE(merge_sort_on_cpu)
+{
+    std::vector<int> data(100003);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>((i * 7919) % 10007) - 5000;
+    }
+
+    bc::vector<int> vec(data.begin(), data.end(), queue);
+    bc::detail::merge_sort_on_cpu(
+        vec.begin(), vec.end(), bc::greater<int>(), queue
+    );
+
+    std::sort(data.begin(), data.end(), std::greater<int>());
+
+    std::vector<int> host_vec(vec.size());
+    bc::copy(vec.begin(), vec.end(), host_vec.begin(), queue);
+    BOOST_CHECK(host_vec == data);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -11,10 +11,15 @@
 #define BOOST_TEST_MODULE TestSortByKey
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
 #include <boost/compute/system.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/sort_by_key.hpp>
 #include <boost/compute/algorithm/is_sorted.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -102,4 +107,129 @@ BOOST_AUTO_TEST_CASE(sort_int_and_float)
     BOOST_CHECK(compute::is_sorted(values.begin(), values.end(), queue) == true);
 }
 
+BOOST_AUTO_TEST_CASE(sort_by_key_custom_function)
+{
+    BOOST_COMPUTE_FUNCTION(bool, compare_abs, (int a, int b),
+    {
+        return abs(a) < abs(b);
+    });
+
+    int n = 4096;
+    std::vector<int> host_keys(n);
+    std::vector<int> host_values(n);
+    for(int i = 0; i < n; i++){
+        host_keys[i] = (i % 2 ? -1 : 1) * (n - i);
+        host_values[i] = i;
+    }
+
+    compute::vector<int> keys(host_keys.begin(), host_keys.end(), queue);
+    compute::vector<int> values(host_values.begin(), host_values.end(), queue);
+
+    compute::sort_by_key(keys.begin(), keys.end(), values.begin(), compare_abs, queue);
+    BOOST_CHECK(compute::is_sorted(keys.begin(), keys.end(), compare_abs, queue));
+
+    // each value must still be paired with its key
+    compute::copy(keys.begin(), keys.end(), host_keys.begin(), queue);
+    compute::copy(values.begin(), values.end(), host_values.begin(), queue);
+    for(int i = 0; i < n; i++){
+        int j = host_values[i];
+        BOOST_CHECK_EQUAL(host_keys[i], (j % 2 ? -1 : 1) * (n - j));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sort_by_key_bit_range)
+{
+    compute::uint_ keys_data[] = { 5, 3, 7, 1, 0, 6, 2, 4 };
+    int values_data[] = { 50, 30, 70, 10, 0, 60, 20, 40 };
+
+    compute::vector<compute::uint_> keys(keys_data, keys_data + 8, queue);
+    compute::vector<int> values(values_data, values_data + 8, queue);
+
+    // keys only use the low 3 bits
+    compute::sort_by_key(keys.begin(), keys.end(), values.begin(), 0, 3, queue);
+    CHECK_RANGE_EQUAL(compute::uint_, 8, keys, (0, 1, 2, 3, 4, 5, 6, 7));
+    CHECK_RANGE_EQUAL(int, 8, values, (0, 10, 20, 30, 40, 50, 60, 70));
+}
+
+BOOST_AUTO_TEST_CASE(sort_by_key_constant_digits)
+{
+    // the high digits of the keys are the same in all keys and their
+    // passes are skipped
+    std::vector<compute::uint_> keys_data(100000);
+    std::vector<compute::uint_> values_data(keys_data.size());
+    for(size_t i = 0; i < keys_data.size(); i++){
+        keys_data[i] = static_cast<compute::uint_>((i * 7919) % 16);
+        values_data[i] = static_cast<compute::uint_>(i);
+    }
+
+    compute::vector<compute::uint_> keys(keys_data.begin(), keys_data.end(), queue);
+    compute::vector<compute::uint_> values(values_data.begin(), values_data.end(), queue);
+    compute::sort_by_key(keys.begin(), keys.end(), values.begin(), queue);
+
+    std::vector<compute::uint_> sorted_keys(keys.size());
+    std::vector<compute::uint_> sorted_values(values.size());
+    compute::copy(keys.begin(), keys.end(), sorted_keys.begin(), queue);
+    compute::copy(values.begin(), values.end(), sorted_values.begin(), queue);
+
+    // the sort is stable
+    bool ordered = true;
+    for(size_t i = 0; i < sorted_keys.size(); i++){
+        ordered = ordered && sorted_keys[i] == keys_data[sorted_values[i]];
+        if(i > 0 && sorted_keys[i] == sorted_keys[i - 1]){
+            ordered = ordered && sorted_values[i] > sorted_values[i - 1];
+        }
+        else if(i > 0){
+            ordered = ordered && sorted_keys[i] > sorted_keys[i - 1];
+        }
+    }
+    BOOST_CHECK(ordered);
+}
+
+BOOST_AUTO_TEST_CASE(sort_by_key_value_columns)
+{
+    int n = 5000;
+    std::vector<int> host_keys(n);
+    std::vector<float> host_a(n);
+    std::vector<compute::uchar_> host_b(n);
+    for(int i = 0; i < n; i++){
+        host_keys[i] = (i * 7919) % n;
+        host_a[i] = float(host_keys[i]) / 2.0f;
+        host_b[i] = static_cast<compute::uchar_>(host_keys[i] % 256);
+    }
+
+    compute::vector<int> keys(host_keys.begin(), host_keys.end(), queue);
+    compute::vector<float> a(host_a.begin(), host_a.end(), queue);
+    compute::vector<compute::uchar_> b(host_b.begin(), host_b.end(), queue);
+
+    compute::sort_by_key(
+        keys.begin(),
+        keys.end(),
+        compute::make_zip_iterator(boost::make_tuple(a.begin(), b.begin())),
+        queue
+    );
+    BOOST_CHECK(compute::is_sorted(keys.begin(), keys.end(), queue));
+
+    compute::copy(keys.begin(), keys.end(), host_keys.begin(), queue);
+    compute::copy(a.begin(), a.end(), host_a.begin(), queue);
+    compute::copy(b.begin(), b.end(), host_b.begin(), queue);
+    for(int i = 0; i < n; i++){
+        BOOST_CHECK_EQUAL(host_keys[i], i);
+        BOOST_CHECK_EQUAL(host_a[i], float(i) / 2.0f);
+        BOOST_CHECK_EQUAL(int(host_b[i]), i % 256);
+    }
+
+    // descending order and a small range
+    compute::sort_by_key(
+        keys.begin(),
+        keys.begin() + 10,
+        compute::make_zip_iterator(boost::make_tuple(a.begin(), b.begin())),
+        compute::greater<int>(),
+        queue
+    );
+    CHECK_RANGE_EQUAL(int, 10, keys, (9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+    CHECK_RANGE_EQUAL(
+        float, 10, a, (4.5f, 4.0f, 3.5f, 3.0f, 2.5f, 2.0f, 1.5f, 1.0f, 0.5f, 0.0f)
+    );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
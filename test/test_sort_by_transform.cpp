@@ -14,7 +14,9 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/algorithm/copy_n.hpp>
 #include <boost/compute/algorithm/is_sorted.hpp>
+#include <boost/compute/algorithm/sort_by_transform.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/get.hpp>
 #include <boost/compute/experimental/sort_by_transform.hpp>
 
 #include "check_macros.hpp"
@@ -107,4 +109,34 @@ BOOST_AUTO_TEST_CASE(sort_vectors_by_component)
     BOOST_CHECK_EQUAL(host_vector[3], float4_(9.0f, 8.0f, 7.0f, 0.0f));
 }
 
+BOOST_AUTO_TEST_CASE(sort_int2_by_component)
+{
+    using compute::int2_;
+
+    // values larger than an index with the same keys keep their order
+    int2_ data[] = {
+        int2_(3, 0), int2_(1, 1), int2_(2, 2), int2_(1, 3),
+        int2_(0, 4), int2_(3, 5), int2_(2, 6), int2_(1, 7)
+    };
+    compute::vector<int2_> vector(data, data + 8, queue);
+
+    compute::sort_by_transform(
+        vector.begin(),
+        vector.end(),
+        compute::get<0>(),
+        queue
+    );
+
+    std::vector<int2_> host_vector(8);
+    compute::copy(vector.begin(), vector.end(), host_vector.begin(), queue);
+    BOOST_CHECK_EQUAL(host_vector[0], int2_(0, 4));
+    BOOST_CHECK_EQUAL(host_vector[1], int2_(1, 1));
+    BOOST_CHECK_EQUAL(host_vector[2], int2_(1, 3));
+    BOOST_CHECK_EQUAL(host_vector[3], int2_(1, 7));
+    BOOST_CHECK_EQUAL(host_vector[4], int2_(2, 2));
+    BOOST_CHECK_EQUAL(host_vector[5], int2_(2, 6));
+    BOOST_CHECK_EQUAL(host_vector[6], int2_(3, 0));
+    BOOST_CHECK_EQUAL(host_vector[7], int2_(3, 5));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,219 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSortIndices
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/algorithm/apply_permutation.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/sort_indices.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(sort_indices_int)
+{
+    int data[] = { 5, -2, 9, 0, -2, 7 };
+    compute::vector<int> keys(data, data + 6, queue);
+    compute::vector<compute::uint_> indices(6, context);
+
+    compute::sort_indices(keys.begin(), keys.end(), indices.begin(), queue);
+    CHECK_RANGE_EQUAL(compute::uint_, 6, indices, (1, 4, 3, 0, 5, 2));
+
+    // the keys are not modified
+    CHECK_RANGE_EQUAL(int, 6, keys, (5, -2, 9, 0, -2, 7));
+
+    compute::sort_indices(
+        keys.begin(), keys.end(), indices.begin(), compute::greater<int>(), queue
+    );
+    std::vector<compute::uint_> host(6);
+    compute::copy(indices.begin(), indices.end(), host.begin(), queue);
+    for(size_t i = 1; i < host.size(); i++){
+        BOOST_CHECK_GE(data[host[i-1]], data[host[i]]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sort_indices_equal_keys)
+{
+    // no radix pass is needed (and for large inputs all of them are
+    // skipped), the indices are still written
+    const size_t sizes[] = { 100, 100000 };
+    for(size_t s = 0; s < 2; s++){
+        compute::vector<float> keys(sizes[s], context);
+        compute::fill(keys.begin(), keys.end(), 2.5f, queue);
+
+        compute::vector<compute::uint_> indices(sizes[s], context);
+        compute::fill(indices.begin(), indices.end(), 1234, queue);
+        compute::sort_indices(keys.begin(), keys.end(), indices.begin(), queue);
+
+        std::vector<compute::uint_> host(sizes[s]);
+        compute::copy(indices.begin(), indices.end(), host.begin(), queue);
+        bool identity = true;
+        for(size_t i = 0; i < host.size(); i++){
+            identity = identity && host[i] == compute::uint_(i);
+        }
+        BOOST_CHECK(identity);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sort_indices_large)
+{
+    std::vector<compute::uint_> data(100000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<compute::uint_>((i * 7919) % data.size());
+    }
+    compute::vector<compute::uint_> keys(data.begin(), data.end(), queue);
+    compute::vector<compute::uint_> indices(data.size(), context);
+
+    compute::sort_indices(keys.begin(), keys.end(), indices.begin(), queue);
+
+    std::vector<compute::uint_> host(data.size());
+    compute::copy(indices.begin(), indices.end(), host.begin(), queue);
+    for(size_t i = 0; i < host.size(); i++){
+        BOOST_CHECK_EQUAL(data[host[i]], compute::uint_(i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sort_indices_custom_compare)
+{
+    BOOST_COMPUTE_FUNCTION(bool, abs_less, (int a, int b),
+    {
+        return abs(a) < abs(b);
+    });
+
+    int data[] = { -5, 3, -1, 4, 2 };
+    compute::vector<int> keys(data, data + 5, queue);
+    compute::vector<int> indices(5, context);
+
+    compute::sort_indices(keys.begin(), keys.end(), indices.begin(), abs_less, queue);
+    CHECK_RANGE_EQUAL(int, 5, indices, (2, 4, 1, 3, 0));
+}
+
+BOOST_AUTO_TEST_CASE(apply_permutation_columns)
+{
+    int keys_data[] = { 3, 1, 2, 0 };
+    float values_data[] = { 3.5f, 1.5f, 2.5f, 0.5f };
+    compute::vector<int> keys(keys_data, keys_data + 4, queue);
+    compute::vector<float> values(values_data, values_data + 4, queue);
+
+    compute::vector<compute::uint_> indices(4, context);
+    compute::sort_indices(keys.begin(), keys.end(), indices.begin(), queue);
+
+    // one column
+    compute::vector<float> sorted_values(4, context);
+    compute::apply_permutation(
+        indices.begin(), indices.end(), values.begin(), sorted_values.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(float, 4, sorted_values, (0.5f, 1.5f, 2.5f, 3.5f));
+
+    // both columns with a single kernel
+    compute::vector<int> sorted_keys(4, context);
+    compute::fill(sorted_values.begin(), sorted_values.end(), 0.0f, queue);
+    compute::apply_permutation(
+        indices.begin(),
+        indices.end(),
+        compute::make_zip_iterator(
+            boost::make_tuple(keys.begin(), values.begin())
+        ),
+        compute::make_zip_iterator(
+            boost::make_tuple(sorted_keys.begin(), sorted_values.begin())
+        ),
+        queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, sorted_keys, (0, 1, 2, 3));
+    CHECK_RANGE_EQUAL(float, 4, sorted_values, (0.5f, 1.5f, 2.5f, 3.5f));
+}
+
+BOOST_AUTO_TEST_CASE(sort_indices_zip_columns)
+{
+    // rows sorted by (a, b, c)
+    int a_data[] = { 2, 1, 2, 1, 2, 1 };
+    float b_data[] = { 0.5f, 1.5f, 0.5f, -1.0f, -3.0f, 1.5f };
+    compute::uint_ c_data[] = { 7, 4, 3, 9, 1, 2 };
+    compute::vector<int> a(a_data, a_data + 6, queue);
+    compute::vector<float> b(b_data, b_data + 6, queue);
+    compute::vector<compute::uint_> c(c_data, c_data + 6, queue);
+
+    compute::vector<compute::uint_> indices(6, context);
+    compute::sort_indices(
+        compute::make_zip_iterator(
+            boost::make_tuple(a.begin(), b.begin(), c.begin())
+        ),
+        compute::make_zip_iterator(
+            boost::make_tuple(a.end(), b.end(), c.end())
+        ),
+        indices.begin(),
+        queue
+    );
+    CHECK_RANGE_EQUAL(compute::uint_, 6, indices, (3, 5, 1, 4, 2, 0));
+
+    // the columns are not modified
+    CHECK_RANGE_EQUAL(int, 6, a, (2, 1, 2, 1, 2, 1));
+
+    // sorting the columns themselves
+    compute::sort(
+        compute::make_zip_iterator(
+            boost::make_tuple(a.begin(), b.begin(), c.begin())
+        ),
+        compute::make_zip_iterator(
+            boost::make_tuple(a.end(), b.end(), c.end())
+        ),
+        queue
+    );
+    CHECK_RANGE_EQUAL(int, 6, a, (1, 1, 1, 2, 2, 2));
+    CHECK_RANGE_EQUAL(float, 6, b, (-1.0f, 1.5f, 1.5f, -3.0f, 0.5f, 0.5f));
+    CHECK_RANGE_EQUAL(compute::uint_, 6, c, (9, 2, 4, 1, 3, 7));
+}
+
+BOOST_AUTO_TEST_CASE(sort_zip_columns_large)
+{
+    const size_t n = 50000;
+    std::vector<compute::uint_> a_data(n);
+    std::vector<int> b_data(n);
+    for(size_t i = 0; i < n; i++){
+        a_data[i] = static_cast<compute::uint_>((i * 7919) % 13);
+        b_data[i] = static_cast<int>((i * 104729) % 1000) - 500;
+    }
+    compute::vector<compute::uint_> a(a_data.begin(), a_data.end(), queue);
+    compute::vector<int> b(b_data.begin(), b_data.end(), queue);
+
+    compute::sort(
+        compute::make_zip_iterator(boost::make_tuple(a.begin(), b.begin())),
+        compute::make_zip_iterator(boost::make_tuple(a.end(), b.end())),
+        queue
+    );
+
+    std::vector<std::pair<compute::uint_, int> > expected(n);
+    for(size_t i = 0; i < n; i++){
+        expected[i] = std::make_pair(a_data[i], b_data[i]);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    compute::copy(a.begin(), a.end(), a_data.begin(), queue);
+    compute::copy(b.begin(), b.end(), b_data.begin(), queue);
+    for(size_t i = 0; i < n; i++){
+        BOOST_CHECK_EQUAL(a_data[i], expected[i].first);
+        BOOST_CHECK_EQUAL(b_data[i], expected[i].second);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
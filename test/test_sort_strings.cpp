@@ -0,0 +1,91 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSortStrings
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/sort_strings.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// sorts strings on the device and checks that the permutation sorts them
+static void check_sort_strings(const std::vector<std::string> &strings,
+                               compute::command_queue &queue)
+{
+    std::vector<char> host_chars;
+    std::vector<compute::uint_> host_offsets(1, 0);
+    for(size_t i = 0; i < strings.size(); i++){
+        host_chars.insert(host_chars.end(), strings[i].begin(), strings[i].end());
+        host_offsets.push_back(static_cast<compute::uint_>(host_chars.size()));
+    }
+
+    compute::vector<char> chars(host_chars.begin(), host_chars.end(), queue);
+    compute::vector<compute::uint_> offsets(
+        host_offsets.begin(), host_offsets.end(), queue
+    );
+    compute::vector<compute::uint_> indices(strings.size(), queue.get_context());
+
+    compute::sort_strings(
+        chars.begin(), offsets.begin(), offsets.end(), indices.begin(), queue
+    );
+
+    std::vector<compute::uint_> host_indices(strings.size());
+    compute::copy(indices.begin(), indices.end(), host_indices.begin(), queue);
+
+    std::vector<compute::uint_> sorted_indices = host_indices;
+    std::sort(sorted_indices.begin(), sorted_indices.end());
+    for(size_t i = 0; i < sorted_indices.size(); i++){
+        BOOST_CHECK_EQUAL(sorted_indices[i], compute::uint_(i));
+    }
+
+    for(size_t i = 1; i < host_indices.size(); i++){
+        BOOST_CHECK(strings[host_indices[i-1]] <= strings[host_indices[i]]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sort_strings_small)
+{
+    std::vector<std::string> strings;
+    strings.push_back("compute");
+    strings.push_back("boost");
+    strings.push_back("");
+    strings.push_back("boost.compute");
+    strings.push_back("boost");
+    strings.push_back("b");
+    check_sort_strings(strings, queue);
+}
+
+BOOST_AUTO_TEST_CASE(sort_strings_long_common_prefixes)
+{
+    // strings sharing prefixes longer than the 8 characters of each key
+    std::vector<std::string> strings;
+    for(int i = 0; i < 5000; i++){
+        std::stringstream stream;
+        stream << "http://www.example.com/" << (i * 7919) % 5000;
+        if(i % 3 == 0){
+            stream << "/index.html";
+        }
+        strings.push_back(stream.str());
+    }
+    check_sort_strings(strings, queue);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,120 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSparseMatrix
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/linear_algebra/csr_matrix.hpp>
+#include <boost/compute/linear_algebra/ell_matrix.hpp>
+#include <boost/compute/linear_algebra/hyb_matrix.hpp>
+#include <boost/compute/linear_algebra/spmv.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(csr_from_coo)
+{
+    // [ 1 0 2 ]
+    // [ 0 0 0 ]
+    // [ 3 4 0 ]
+    // [ 0 0 5 ]
+    // with the entries in no particular order
+    int rows[] = { 2, 0, 3, 2, 0 };
+    int columns[] = { 1, 2, 2, 0, 0 };
+    float values[] = { 4.0f, 2.0f, 5.0f, 3.0f, 1.0f };
+
+    bc::csr_matrix<float> matrix(4, 3, rows, rows + 5, columns, values, queue);
+    BOOST_CHECK_EQUAL(matrix.rows(), size_t(4));
+    BOOST_CHECK_EQUAL(matrix.cols(), size_t(3));
+    BOOST_CHECK_EQUAL(matrix.nonzeros(), size_t(5));
+    BOOST_CHECK_EQUAL(matrix.max_row_length(), size_t(2));
+    CHECK_RANGE_EQUAL(bc::uint_, 5, matrix.row_offsets(), (0, 2, 2, 4, 5));
+
+    float x_data[] = { 1.0f, 2.0f, 3.0f };
+    bc::vector<float> x(x_data, x_data + 3, queue);
+    bc::vector<float> y(4, 1.0f, queue);
+
+    bc::spmv(1.0f, matrix, x.begin(), 2.0f, y.begin(), queue);
+    CHECK_RANGE_EQUAL(float, 4, y, (9.0f, 2.0f, 13.0f, 17.0f));
+
+    bc::ell_matrix<float> ell(matrix, queue);
+    BOOST_CHECK_EQUAL(ell.width(), size_t(2));
+    bc::spmv(1.0f, ell, x.begin(), 0.0f, y.begin(), queue);
+    CHECK_RANGE_EQUAL(float, 4, y, (7.0f, 0.0f, 11.0f, 15.0f));
+}
+
+BOOST_AUTO_TEST_CASE(spmv_kernels)
+{
+    // rows of lengths 0 to 99, a few of them much longer than the others
+    const size_t n = 100;
+    std::vector<int> rows;
+    std::vector<int> columns;
+    std::vector<float> values;
+    for(size_t r = 0; r < n; r++){
+        const size_t length = r % 10 == 9 ? 90 + r % 10 : r % 7;
+        for(size_t c = 0; c < length; c++){
+            rows.push_back(static_cast<int>(r));
+            columns.push_back(static_cast<int>((r + c * 3) % n));
+            values.push_back(static_cast<float>(c % 4) - 1.5f);
+        }
+    }
+
+    std::vector<float> host_x(n);
+    for(size_t i = 0; i < n; i++){
+        host_x[i] = static_cast<float>(i % 5);
+    }
+    std::vector<float> expected(n, 0.0f);
+    for(size_t i = 0; i < rows.size(); i++){
+        expected[rows[i]] += values[i] * host_x[columns[i]];
+    }
+
+    bc::csr_matrix<float> matrix(
+        n, n, rows.begin(), rows.end(), columns.begin(), values.begin(), queue
+    );
+    bc::hyb_matrix<float> hyb(matrix, queue);
+    BOOST_CHECK(hyb.ell_width() < matrix.max_row_length());
+    BOOST_CHECK(hyb.csr().nonzeros() > 0);
+
+    bc::vector<float> x(host_x.begin(), host_x.end(), queue);
+    bc::vector<float> y(n, context);
+    std::vector<float> host_y(n);
+
+    boost::shared_ptr<bc::detail::parameter_cache> parameters =
+        bc::detail::parameter_cache::get_global_cache(device);
+
+    // scalar and vector csr kernels
+    const bc::uint_ row_lengths[] = { 1024, 1 };
+    for(size_t i = 0; i < 2; i++){
+        parameters->set("__boost_spmv", "vector_row_length", row_lengths[i]);
+
+        bc::spmv(1.0f, matrix, x.begin(), 0.0f, y.begin(), queue);
+        bc::copy(y.begin(), y.end(), host_y.begin(), queue);
+        for(size_t r = 0; r < n; r++){
+            BOOST_CHECK_SMALL(host_y[r] - expected[r], 1e-3f);
+        }
+    }
+    parameters->reset("__boost_spmv");
+
+    bc::spmv(1.0f, hyb, x.begin(), 0.0f, y.begin(), queue);
+    bc::copy(y.begin(), y.end(), host_y.begin(), queue);
+    for(size_t r = 0; r < n; r++){
+        BOOST_CHECK_SMALL(host_y[r] - expected[r], 1e-3f);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,90 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSplit
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/algorithm/split.hpp>
+#include <boost/compute/container/string.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(split_string)
+{
+    bc::string text("the quick  brown fox ");
+
+    bc::vector<bc::uint_> starts(11, context);
+    bc::vector<bc::uint_> ends(11, context);
+
+    std::pair<bc::vector<bc::uint_>::iterator, bc::vector<bc::uint_>::iterator> result =
+        bc::split(text.begin(), text.end(), starts.begin(), ends.begin(), ' ', queue);
+
+    BOOST_CHECK(result.first == starts.begin() + 4);
+    BOOST_CHECK(result.second == ends.begin() + 4);
+    CHECK_RANGE_EQUAL(bc::uint_, 4, starts, (0, 4, 11, 17));
+    CHECK_RANGE_EQUAL(bc::uint_, 4, ends, (3, 9, 16, 20));
+}
+
+BOOST_AUTO_TEST_CASE(split_if_whitespace)
+{
+    using bc::lambda::_1;
+
+    const char data[] = "\tkey=value\n\nx";
+    bc::vector<char> text(data, data + 13, queue);
+
+    bc::vector<bc::uint_> starts(7, context);
+    bc::vector<bc::uint_> ends(7, context);
+
+    std::pair<bc::vector<bc::uint_>::iterator, bc::vector<bc::uint_>::iterator> result =
+        bc::split_if(text.begin(), text.end(), starts.begin(), ends.begin(),
+                     _1 == '\t' || _1 == '\n' || _1 == '=', queue);
+
+    BOOST_CHECK(result.first == starts.begin() + 3);
+    CHECK_RANGE_EQUAL(bc::uint_, 3, starts, (1, 5, 12));
+    CHECK_RANGE_EQUAL(bc::uint_, 3, ends, (4, 10, 13));
+}
+
+BOOST_AUTO_TEST_CASE(split_large_text)
+{
+    // 10000 tokens of three characters each separated by commas
+    std::string host_text;
+    for(int i = 0; i < 10000; i++){
+        host_text += "abc,";
+    }
+
+    bc::vector<char> text(host_text.begin(), host_text.end(), queue);
+    bc::vector<bc::uint_> starts(20000, context);
+    bc::vector<bc::uint_> ends(20000, context);
+
+    std::pair<bc::vector<bc::uint_>::iterator, bc::vector<bc::uint_>::iterator> result =
+        bc::split(text.begin(), text.end(), starts.begin(), ends.begin(), ',', queue);
+
+    BOOST_CHECK(result.first == starts.begin() + 10000);
+    BOOST_CHECK(result.second == ends.begin() + 10000);
+    BOOST_CHECK_EQUAL(bc::uint_(starts[9999]), bc::uint_(39996));
+    BOOST_CHECK_EQUAL(bc::uint_(ends[9999]), bc::uint_(39999));
+
+    // an empty text and a text of delimiters have no tokens
+    result = bc::split(text.begin(), text.begin(), starts.begin(), ends.begin(), ',', queue);
+    BOOST_CHECK(result.first == starts.begin());
+    result = bc::split(text.begin() + 3, text.begin() + 4, starts.begin(), ends.begin(), ',', queue);
+    BOOST_CHECK(result.first == starts.begin());
+    BOOST_CHECK(result.second == ends.begin());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
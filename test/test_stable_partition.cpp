@@ -11,11 +11,18 @@
 #define BOOST_TEST_MODULE TestStablePartition
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
+#include <boost/compute/lambda.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/stable_partition.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/scratch_space.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -35,4 +42,63 @@ BOOST_AUTO_TEST_CASE(partition_int)
     BOOST_VERIFY(iter == vector.begin()+5);
 }
 
+BOOST_AUTO_TEST_CASE(partition_large)
+{
+    // spans several chunks of the partitioning kernels
+    const int size = 100000;
+    std::vector<int> data(size);
+    for(int i = 0; i < size; i++){
+        data[i] = (i % 3 == 0) ? i : -i;
+    }
+    bc::vector<int> vector(data.begin(), data.end(), queue);
+
+    bc::vector<int>::iterator iter =
+        bc::stable_partition(vector.begin(), vector.end(), bc::_1 >= 0, queue);
+
+    std::vector<int> expected(data);
+    std::stable_partition(
+        expected.begin(), expected.end(), std::bind2nd(std::greater_equal<int>(), 0)
+    );
+
+    std::vector<int> host(size);
+    bc::copy(vector.begin(), vector.end(), host.begin(), queue);
+    BOOST_CHECK(iter == vector.begin() + (size + 2) / 3);
+    BOOST_CHECK(host == expected);
+}
+
+#ifdef CL_VERSION_1_1
+BOOST_AUTO_TEST_CASE(partition_with_little_memory)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    const int size = 100000;
+    std::vector<int> data(size);
+    for(int i = 0; i < size; i++){
+        data[i] = (i % 7 < 3) ? i : -i;
+    }
+    bc::vector<int> vector(data.begin(), data.end(), queue);
+
+    // room for a copy of about a tenth of the values, so the values are
+    // partitioned in chunks
+    bc::scratch_space scratch(bc::buffer(context, size * sizeof(int) / 10), false);
+
+    bc::vector<int>::iterator iter;
+    {
+        bc::scoped_scratch_space use_scratch(scratch);
+        iter = bc::stable_partition(vector.begin(), vector.end(), bc::_1 >= 0, queue);
+        queue.finish();
+    }
+
+    std::vector<int> expected(data);
+    std::vector<int>::iterator expected_iter = std::stable_partition(
+        expected.begin(), expected.end(), std::bind2nd(std::greater_equal<int>(), 0)
+    );
+
+    std::vector<int> host(size);
+    bc::copy(vector.begin(), vector.end(), host.begin(), queue);
+    BOOST_CHECK(iter == vector.begin() + (expected_iter - expected.begin()));
+    BOOST_CHECK(host == expected);
+}
+#endif // CL_VERSION_1_1
+
 BOOST_AUTO_TEST_SUITE_END()
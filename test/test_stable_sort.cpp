@@ -11,6 +11,9 @@
 #define BOOST_TEST_MODULE TestStableSort
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/function.hpp>
 #include <boost/compute/algorithm/stable_sort.hpp>
@@ -89,4 +92,35 @@ BOOST_AUTO_TEST_CASE(sort_int2)
     BOOST_CHECK_EQUAL(result[3], int2_(2, 2));
 }
 
+bool host_compare_first(const compute::int2_ &a, const compute::int2_ &b)
+{
+    return a[0] < b[0];
+}
+
+BOOST_AUTO_TEST_CASE(stable_sort_int2_large)
+{
+    using compute::int2_;
+
+    std::vector<int2_> data(5000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = int2_(static_cast<int>((i * 31) % 17), static_cast<int>(i));
+    }
+
+    compute::vector<int2_> vec(data.begin(), data.end(), queue);
+
+    BOOST_COMPUTE_FUNCTION(bool, compare_first, (int2_ a, int2_ b),
+    {
+        return a.x < b.x;
+    });
+
+    compute::stable_sort(vec.begin(), vec.end(), compare_first, queue);
+
+    // equal elements must keep their original order
+    std::stable_sort(data.begin(), data.end(), host_compare_first);
+
+    std::vector<int2_> result(vec.size());
+    compute::copy(vec.begin(), vec.end(), result.begin(), queue);
+    BOOST_CHECK(result == data);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
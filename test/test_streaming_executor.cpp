@@ -0,0 +1,87 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestStreamingExecutor
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include <boost/compute/function.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/experimental/streaming_executor.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(transform)
+{
+    BOOST_COMPUTE_FUNCTION(int, square, (int x),
+    {
+        return x * x;
+    });
+
+    std::vector<int> input(1050);
+    for(size_t i = 0; i < input.size(); i++){
+        input[i] = static_cast<int>(i);
+    }
+    std::vector<float> output(input.size());
+
+    // eleven chunks through three buffers, the last chunk is partial
+    compute::experimental::streaming_executor executor(queue, 100, 3);
+    std::vector<float>::iterator end =
+        executor.transform(input.begin(), input.end(), output.begin(), square);
+    BOOST_CHECK(end == output.end());
+
+    for(size_t i = 0; i < output.size(); i++){
+        BOOST_CHECK_EQUAL(output[i], float(i * i));
+    }
+}
+
+struct sort_stage
+{
+    template<class InputIterator, class OutputIterator>
+    void operator()(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result,
+                    compute::command_queue &queue) const
+    {
+        compute::sort(first, last, queue);
+        compute::copy(first, last, result, queue);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(run_in_place)
+{
+    std::vector<int> data(500);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>(data.size() - i);
+    }
+
+    compute::experimental::streaming_executor executor(queue, 128);
+    executor.run(data.begin(), data.end(), data.begin(), sort_stage());
+
+    // each chunk is sorted on its own
+    for(size_t offset = 0; offset < data.size(); offset += 128){
+        std::vector<int>::iterator chunk_end =
+            data.begin() + (std::min)(offset + 128, data.size());
+        BOOST_CHECK(std::adjacent_find(
+            data.begin() + offset, chunk_end, std::greater<int>()
+        ) == chunk_end);
+    }
+    BOOST_CHECK_EQUAL(data[0], 373);
+    BOOST_CHECK_EQUAL(data[499], 116);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestStridedIterator
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <iterator>
+
+#include <boost/type_traits.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/types.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/strided_iterator.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(value_type)
+{
+    BOOST_STATIC_ASSERT((
+        boost::is_same<
+            bc::strided_iterator<bc::buffer_iterator<float> >::value_type,
+            float
+        >::value
+    ));
+    BOOST_STATIC_ASSERT((
+        bc::is_device_iterator<
+            bc::strided_iterator<bc::buffer_iterator<int> >
+        >::value
+    ));
+}
+
+BOOST_AUTO_TEST_CASE(distance)
+{
+    bc::vector<int> vector(12, context);
+
+    bc::strided_iterator<bc::buffer_iterator<int> > first =
+        bc::make_strided_iterator(vector.begin() + 1, 3);
+    bc::strided_iterator<bc::buffer_iterator<int> > last = first + 4;
+
+    BOOST_CHECK_EQUAL(std::distance(first, last), 4);
+    BOOST_CHECK_EQUAL(last.get_index(), size_t(13));
+    BOOST_CHECK_EQUAL(first.stride(), size_t(3));
+}
+
+// a 4x3 matrix stored in row-major order
+//   0  1  2
+//   3  4  5
+//   6  7  8
+//   9 10 11
+BOOST_AUTO_TEST_CASE(copy_column_device_to_device)
+{
+    bc::vector<int> matrix(12, context);
+    bc::iota(matrix.begin(), matrix.end(), 0, queue);
+
+    bc::vector<int> column(4, context);
+    bc::copy(
+        bc::make_strided_iterator(matrix.begin() + 1, 3),
+        bc::make_strided_iterator(matrix.begin() + 1, 3) + 4,
+        column.begin(),
+        queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, column, (1, 4, 7, 10));
+}
+
+BOOST_AUTO_TEST_CASE(copy_column_device_to_host)
+{
+    bc::vector<int> matrix(12, context);
+    bc::iota(matrix.begin(), matrix.end(), 0, queue);
+
+    std::vector<int> column(4);
+    bc::copy(
+        bc::make_strided_iterator(matrix.begin() + 2, 3),
+        bc::make_strided_iterator(matrix.begin() + 2, 3) + 4,
+        column.begin(),
+        queue
+    );
+    BOOST_CHECK_EQUAL(column[0], 2);
+    BOOST_CHECK_EQUAL(column[1], 5);
+    BOOST_CHECK_EQUAL(column[2], 8);
+    BOOST_CHECK_EQUAL(column[3], 11);
+}
+
+BOOST_AUTO_TEST_CASE(copy_column_host_to_device)
+{
+    bc::vector<int> matrix(12, context);
+    bc::fill(matrix.begin(), matrix.end(), 0, queue);
+
+    int column[] = { 1, 2, 3, 4 };
+    bc::copy(
+        column,
+        column + 4,
+        bc::make_strided_iterator(matrix.begin(), 3),
+        queue
+    );
+    CHECK_RANGE_EQUAL(
+        int, 12, matrix, (1, 0, 0, 2, 0, 0, 3, 0, 0, 4, 0, 0)
+    );
+}
+
+BOOST_AUTO_TEST_CASE(transform_column)
+{
+    bc::vector<int> matrix(12, context);
+    bc::iota(matrix.begin(), matrix.end(), 0, queue);
+
+    // negate the first column in place
+    bc::transform(
+        bc::make_strided_iterator(matrix.begin(), 3),
+        bc::make_strided_iterator(matrix.begin(), 3) + 4,
+        bc::make_strided_iterator(matrix.begin(), 3),
+        bc::_1 * -1,
+        queue
+    );
+    CHECK_RANGE_EQUAL(
+        int, 12, matrix, (0, 1, 2, -3, 4, 5, -6, 7, 8, -9, 10, 11)
+    );
+}
+
+BOOST_AUTO_TEST_CASE(reduce_column)
+{
+    bc::vector<int> matrix(12, context);
+    bc::iota(matrix.begin(), matrix.end(), 0, queue);
+
+    int sum = 0;
+    bc::reduce(
+        bc::make_strided_iterator(matrix.begin() + 1, 3),
+        bc::make_strided_iterator(matrix.begin() + 1, 3) + 4,
+        &sum,
+        queue
+    );
+    BOOST_CHECK_EQUAL(sum, 1 + 4 + 7 + 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
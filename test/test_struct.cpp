@@ -46,6 +46,17 @@ struct Atom
 // adapt the chemistry::Atom class
 BOOST_COMPUTE_ADAPT_STRUCT(chemistry::Atom, Atom, (x, y, z, number))
 
+// struct with padding between its members
+struct TaggedPoint
+{
+    char tag;
+    float x;
+    short id;
+    float y;
+};
+
+BOOST_COMPUTE_ADAPT_STRUCT_ALIGNED(TaggedPoint, TaggedPoint, (tag, x, id, y))
+
 #include "check_macros.hpp"
 #include "context_setup.hpp"
 
@@ -124,4 +135,40 @@ BOOST_AUTO_TEST_CASE(custom_kernel)
     queue.enqueue_1d_range_kernel(custom_kernel, 0, atoms.size(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(aligned_struct)
+{
+    BOOST_CHECK(
+        compute::type_definition<TaggedPoint>().find("packed") == std::string::npos
+    );
+
+    std::vector<TaggedPoint> data(3);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i].tag = 'a' + char(i);
+        data[i].x = float(i);
+        data[i].id = short(10 * i);
+        data[i].y = float(2 * i);
+    }
+
+    compute::vector<TaggedPoint> points(data.size(), context);
+    compute::copy(data.begin(), data.end(), points.begin(), queue);
+
+    compute::vector<short> ids(points.size(), context);
+    compute::transform(
+        points.begin(), points.end(),
+        ids.begin(),
+        compute::field<short>("id"),
+        queue
+    );
+    CHECK_RANGE_EQUAL(short, 3, ids, (0, 10, 20));
+
+    compute::vector<float> ys(points.size(), context);
+    compute::transform(
+        points.begin(), points.end(),
+        ys.begin(),
+        compute::field<float>("y"),
+        queue
+    );
+    CHECK_RANGE_EQUAL(float, 3, ys, (0.f, 2.f, 4.f));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,77 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSvmVector
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/svm_vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+#include "opencl_version_check.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+}
+
+#ifdef CL_VERSION_2_0
+BOOST_AUTO_TEST_CASE(algorithms)
+{
+    REQUIRES_OPENCL_VERSION(2, 0);
+
+    using compute::lambda::_1;
+
+    compute::svm_vector<int> vector(64, context);
+    BOOST_CHECK_EQUAL(vector.size(), size_t(64));
+
+    // algorithms use the svm pointers directly in their kernels
+    compute::iota(vector.begin(), vector.end(), 0, queue);
+    compute::transform(
+        vector.begin(), vector.end(), vector.begin(), _1 * 2, queue
+    );
+
+    int sum = 0;
+    compute::reduce(vector.begin(), vector.end(), &sum, queue);
+    BOOST_CHECK_EQUAL(sum, 63 * 64);
+
+    compute::vector<int> result(4, context);
+    compute::copy(vector.begin(), vector.begin() + 4, result.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 4, result, (0, 2, 4, 6));
+}
+
+BOOST_AUTO_TEST_CASE(host_access)
+{
+    REQUIRES_OPENCL_VERSION(2, 0);
+
+    std::vector<float> host(16, 1.5f);
+    compute::svm_vector<float> vector(host.begin(), host.end(), queue);
+
+    vector.map(queue, CL_MAP_READ | CL_MAP_WRITE);
+    BOOST_CHECK_EQUAL(vector.data()[15], 1.5f);
+    vector.data()[0] = 4.0f;
+    vector.unmap(queue);
+
+    float sum = 0;
+    compute::reduce(vector.begin(), vector.end(), &sum, queue);
+    BOOST_CHECK_CLOSE(sum, 15 * 1.5f + 4.0f, 1e-4f);
+}
+#endif // CL_VERSION_2_0
+
+BOOST_AUTO_TEST_SUITE_END()
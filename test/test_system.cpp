@@ -11,9 +11,15 @@
 #define BOOST_TEST_MODULE TestSystem
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+
 #include <boost/compute/device.hpp>
 #include <boost/compute/system.hpp>
 
+#if defined(BOOST_COMPUTE_THREAD_SAFE) && defined(BOOST_COMPUTE_USE_CPP11)
+#include <thread>
+#endif
+
 BOOST_AUTO_TEST_CASE(platform_count)
 {
     BOOST_CHECK(boost::compute::system::platform_count() >= 1);
@@ -36,3 +42,70 @@ BOOST_AUTO_TEST_CASE(find_device)
     const std::string &name = device.name();
     BOOST_CHECK(boost::compute::system::find_device(name).name() == device.name());
 }
+
+BOOST_AUTO_TEST_CASE(per_thread_default_queues)
+{
+    namespace compute = boost::compute;
+
+    compute::command_queue &shared_queue = compute::system::default_queue();
+    BOOST_CHECK_EQUAL(compute::system::default_queue_count(), size_t(1));
+
+    compute::system::set_default_queue_count(0);
+    compute::command_queue &queue = compute::system::default_queue();
+    BOOST_CHECK(&queue != &shared_queue);
+    BOOST_CHECK(queue.get_context() == compute::system::default_context());
+    BOOST_CHECK(&compute::system::default_queue() == &queue);
+
+#if defined(BOOST_COMPUTE_THREAD_SAFE) && defined(BOOST_COMPUTE_USE_CPP11)
+    // another thread gets a queue of its own
+    cl_command_queue other_queue = 0;
+    std::thread thread([&other_queue](){
+        other_queue = compute::system::default_queue().get();
+    });
+    thread.join();
+    BOOST_CHECK(other_queue != 0);
+    BOOST_CHECK(other_queue != queue.get());
+#endif
+
+    compute::system::set_default_queue_count(1);
+    BOOST_CHECK(&compute::system::default_queue() == &shared_queue);
+}
+
+BOOST_AUTO_TEST_CASE(priority_default_queues)
+{
+    namespace compute = boost::compute;
+
+    compute::command_queue &high =
+        compute::system::default_queue(compute::command_queue::priority_high);
+    compute::command_queue &low =
+        compute::system::default_queue(compute::command_queue::priority_low);
+    BOOST_CHECK(&high != &low);
+    BOOST_CHECK(high.get() != low.get());
+    BOOST_CHECK(high.get_context() == compute::system::default_context());
+    BOOST_CHECK(&compute::system::default_queue(compute::command_queue::priority_high) == &high);
+    BOOST_CHECK(&compute::system::default_queue(compute::command_queue::priority_default) ==
+                &compute::system::default_queue());
+}
+
+BOOST_AUTO_TEST_CASE(ranked_device)
+{
+    namespace compute = boost::compute;
+
+    const std::vector<compute::device> devices = compute::system::devices();
+    const std::vector<compute::platform> platforms = compute::system::platforms();
+
+    const compute::device scored =
+        compute::detail::select_ranked_device(platforms, "score");
+    BOOST_CHECK(std::find(devices.begin(), devices.end(), scored) != devices.end());
+
+    // no device is ranked higher
+    const double rank = compute::detail::device_rank(scored, "score");
+    for(size_t i = 0; i < devices.size(); i++){
+        BOOST_CHECK(compute::detail::device_rank(devices[i], "score") <= rank);
+    }
+
+    // the benchmark timings vary between runs
+    const compute::device benchmarked =
+        compute::detail::select_ranked_device(platforms, "benchmark");
+    BOOST_CHECK(std::find(devices.begin(), devices.end(), benchmarked) != devices.end());
+}
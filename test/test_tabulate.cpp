@@ -14,6 +14,7 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/function.hpp>
 #include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/tabulate.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/experimental/tabulate.hpp>
 
@@ -34,4 +35,17 @@ BOOST_AUTO_TEST_CASE(tabulate_negative_int)
     CHECK_RANGE_EQUAL(int, 10, vector, (0, -1, -2, -3, -4, -5, -6, -7, -8, -9));
 }
 
+BOOST_AUTO_TEST_CASE(tabulate_square)
+{
+    BOOST_COMPUTE_FUNCTION(int, square, (int x),
+    {
+        return x * x;
+    });
+
+    compute::vector<int> vector(8, context);
+    compute::tabulate(vector.begin() + 2, vector.end(), square, queue);
+    compute::tabulate(vector.begin(), vector.begin() + 2, square, queue);
+    CHECK_RANGE_EQUAL(int, 8, vector, (0, 1, 0, 1, 4, 9, 16, 25));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
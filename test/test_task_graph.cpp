@@ -0,0 +1,148 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestTaskGraph
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/experimental/task_graph.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+struct fill_task
+{
+    fill_task(compute::vector<int> &vector_, int value_)
+        : vector(vector_), value(value_)
+    {
+    }
+
+    void operator()(compute::command_queue &q) const
+    {
+        compute::fill(vector.begin(), vector.end(), value, q);
+    }
+
+    compute::vector<int> &vector;
+    int value;
+};
+
+struct plus_task
+{
+    plus_task(compute::vector<int> &a_,
+              compute::vector<int> &b_,
+              compute::vector<int> &result_)
+        : a(a_), b(b_), result(result_)
+    {
+    }
+
+    void operator()(compute::command_queue &q) const
+    {
+        compute::transform(
+            a.begin(), a.end(), b.begin(), result.begin(), compute::plus<int>(), q
+        );
+    }
+
+    compute::vector<int> &a;
+    compute::vector<int> &b;
+    compute::vector<int> &result;
+};
+
+BOOST_AUTO_TEST_CASE(diamond)
+{
+    std::vector<compute::command_queue> queues;
+    queues.push_back(queue);
+    queues.push_back(compute::command_queue(context, device));
+
+    compute::vector<int> a(16, context);
+    compute::vector<int> b(16, context);
+    compute::vector<int> c(16, context);
+
+    compute::experimental::task_graph graph(queues);
+    compute::experimental::task_graph::node fill_a =
+        graph.add_algorithm(fill_task(a, 1));
+    compute::experimental::task_graph::node fill_b =
+        graph.add_algorithm(fill_task(b, 2));
+    compute::experimental::task_graph::node sum =
+        graph.add_algorithm(plus_task(a, b, c), fill_a, fill_b);
+    BOOST_CHECK_EQUAL(graph.size(), size_t(3));
+
+    graph.run();
+    graph.wait();
+
+    // the independent fills run on different queues
+    BOOST_CHECK(graph.get_queue(fill_a) != graph.get_queue(fill_b));
+    BOOST_CHECK(graph.get_event(sum).get() != 0);
+
+    CHECK_RANGE_EQUAL(
+        int, 16, c,
+        (3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3)
+    );
+}
+
+BOOST_AUTO_TEST_CASE(chain)
+{
+    compute::vector<int> a(8, context);
+    compute::vector<int> b(8, context);
+
+    compute::experimental::task_graph graph(queue);
+    compute::experimental::task_graph::node fill_a =
+        graph.add_algorithm(fill_task(a, 4));
+    graph.add_algorithm(plus_task(a, a, b), fill_a);
+
+    graph.run();
+    graph.wait();
+    CHECK_RANGE_EQUAL(int, 8, b, (8, 8, 8, 8, 8, 8, 8, 8));
+}
+
+BOOST_AUTO_TEST_CASE(priority_classes)
+{
+    compute::vector<int> a(8, context);
+    compute::vector<int> b(8, context);
+    compute::vector<int> c(8, context);
+
+    std::vector<compute::command_queue> queues;
+    queues.push_back(compute::command_queue(context, device));
+    queues.push_back(
+        compute::command_queue(context, device, 0, compute::command_queue::priority_high)
+    );
+    std::vector<compute::command_queue::priority_hint> priorities;
+    priorities.push_back(compute::command_queue::priority_low);
+    priorities.push_back(compute::command_queue::priority_high);
+
+    compute::experimental::task_graph graph(queues, priorities);
+    compute::experimental::task_graph::node fill_a =
+        graph.add_algorithm(fill_task(a, 1));
+    compute::experimental::task_graph::node fill_b =
+        graph.add_algorithm(fill_task(b, 2));
+    graph.set_priority(fill_a, compute::command_queue::priority_high);
+    graph.set_priority(fill_b, compute::command_queue::priority_high);
+    compute::experimental::task_graph::node sum =
+        graph.add_algorithm(plus_task(a, b, c), fill_a, fill_b);
+    graph.set_priority(sum, compute::command_queue::priority_low);
+
+    graph.run();
+    graph.wait();
+    CHECK_RANGE_EQUAL(int, 8, c, (3, 3, 3, 3, 3, 3, 3, 3));
+
+    // both high-priority tasks run on the high-priority queue
+    BOOST_CHECK(graph.get_queue(fill_a) == queues[1]);
+    BOOST_CHECK(graph.get_queue(fill_b) == queues[1]);
+    BOOST_CHECK(graph.get_queue(sum) == queues[0]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
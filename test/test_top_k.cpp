@@ -0,0 +1,83 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestTopK
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <algorithm>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/experimental/top_k.hpp>
+#include <boost/compute/functional/operator.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(top_k_fewer_values)
+{
+    compute::experimental::top_k_accumulator<int> top(5, queue);
+    BOOST_CHECK_EQUAL(top.k(), size_t(5));
+    BOOST_CHECK(top.empty());
+
+    int data1[] = { 3, 9, 1 };
+    compute::vector<int> batch1(data1, data1 + 3, queue);
+    top.push(batch1.begin(), batch1.end(), queue);
+    BOOST_CHECK_EQUAL(top.size(), size_t(3));
+    CHECK_RANGE_EQUAL(int, 3, top, (9, 3, 1));
+
+    int data2[] = { 4, 2, 8, 0 };
+    compute::vector<int> batch2(data2, data2 + 4, queue);
+    top.push(batch2.begin(), batch2.end(), queue);
+    BOOST_CHECK_EQUAL(top.size(), size_t(5));
+    CHECK_RANGE_EQUAL(int, 5, top, (9, 8, 4, 3, 2));
+
+    // none of the values are larger than the fifth one
+    top.push(batch1.begin() + 2, batch1.end(), queue);
+    CHECK_RANGE_EQUAL(int, 5, top, (9, 8, 4, 3, 2));
+
+    top.clear();
+    BOOST_CHECK(top.empty());
+}
+
+BOOST_AUTO_TEST_CASE(top_k_batches)
+{
+    const size_t k = 100;
+    const size_t batch_size = 50000;
+
+    compute::experimental::top_k_accumulator<
+        int, compute::less<int>
+    > top(k, queue);
+
+    std::vector<int> all;
+    std::vector<int> host(batch_size);
+    compute::vector<int> batch(batch_size, context);
+    for(size_t b = 0; b < 6; b++){
+        for(size_t i = 0; i < batch_size; i++){
+            host[i] = static_cast<int>(((b * batch_size + i) * 7919) % 1000003);
+        }
+        compute::copy(host.begin(), host.end(), batch.begin(), queue);
+        all.insert(all.end(), host.begin(), host.end());
+
+        // the smallest values seen so far
+        top.push(batch.begin(), batch.end(), queue);
+        BOOST_CHECK_EQUAL(top.size(), k);
+
+        std::partial_sort(all.begin(), all.begin() + k, all.end());
+        std::vector<int> result(k);
+        compute::copy(top.begin(), top.end(), result.begin(), queue);
+        BOOST_CHECK(std::equal(result.begin(), result.end(), all.begin()));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,198 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestTrace
+#include <boost/test/unit_test.hpp>
+
+#define BOOST_COMPUTE_ENABLE_TRACING
+
+#include <string>
+#include <vector>
+
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/program.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/is_permutation.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/program_cache.hpp>
+#include <boost/compute/utility/scratch_space.hpp>
+#include <boost/compute/utility/trace.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+class recording_listener : public compute::trace_listener
+{
+public:
+    recording_listener()
+        : hits(0), misses(0)
+    {
+    }
+
+    void on_enqueue(const compute::trace_record &record)
+    {
+        records.push_back(record);
+    }
+
+    void on_strategy(const std::string &algorithm, const std::string &strategy)
+    {
+        strategies.push_back(algorithm + ":" + strategy);
+    }
+
+    void on_program_cache(const std::string &key, bool hit)
+    {
+        (void) key;
+
+        if(hit){
+            hits++;
+        }
+        else {
+            misses++;
+        }
+    }
+
+    size_t count(cl_command_type command, const std::string &algorithm) const
+    {
+        size_t n = 0;
+        for(size_t i = 0; i < records.size(); i++){
+            if(records[i].command == command &&
+               records[i].algorithm == algorithm){
+                n++;
+            }
+        }
+        return n;
+    }
+
+    std::vector<compute::trace_record> records;
+    std::vector<std::string> strategies;
+    size_t hits;
+    size_t misses;
+};
+
+BOOST_AUTO_TEST_CASE(disabled_by_default)
+{
+    BOOST_CHECK(compute::get_trace_listener() == 0);
+
+    int data[] = { 3, 1, 2 };
+    compute::vector<int> vector(data, data + 3, queue);
+    compute::sort(vector.begin(), vector.end(), queue);
+    CHECK_RANGE_EQUAL(int, 3, vector, (1, 2, 3));
+}
+
+BOOST_AUTO_TEST_CASE(trace_copy)
+{
+    recording_listener listener;
+    compute::set_trace_listener(&listener);
+
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> vector(4, context);
+    compute::copy(data, data + 4, vector.begin(), queue);
+
+    compute::set_trace_listener(0);
+
+    BOOST_CHECK_EQUAL(listener.count(CL_COMMAND_WRITE_BUFFER, "copy"), size_t(1));
+    BOOST_CHECK_EQUAL(listener.records.back().bytes, 4 * sizeof(int));
+    BOOST_CHECK(listener.records.back().queue == queue.get());
+    BOOST_CHECK(listener.records.back().event_.get() != 0);
+    CHECK_RANGE_EQUAL(int, 4, vector, (1, 2, 3, 4));
+}
+
+BOOST_AUTO_TEST_CASE(trace_sort)
+{
+    std::vector<int> data(4096);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>(data.size() - i);
+    }
+    compute::vector<int> vector(data.begin(), data.end(), queue);
+
+    recording_listener listener;
+    compute::set_trace_listener(&listener);
+
+    compute::sort(vector.begin(), vector.end(), queue);
+    queue.finish();
+
+    compute::set_trace_listener(0);
+
+    // all of the internal kernels are attributed to sort()
+    BOOST_CHECK(listener.count(CL_COMMAND_NDRANGE_KERNEL, "sort") > 0);
+    BOOST_CHECK_EQUAL(listener.count(CL_COMMAND_NDRANGE_KERNEL, ""), size_t(0));
+    for(size_t i = 0; i < listener.records.size(); i++){
+        if(listener.records[i].command == CL_COMMAND_NDRANGE_KERNEL){
+            BOOST_CHECK(!listener.records[i].kernel.empty());
+        }
+    }
+    BOOST_CHECK(listener.hits + listener.misses > 0);
+
+    std::vector<int> host(data.size());
+    compute::copy(vector.begin(), vector.end(), host.begin(), queue);
+    BOOST_CHECK_EQUAL(host.front(), 1);
+    BOOST_CHECK_EQUAL(host.back(), 4096);
+}
+
+BOOST_AUTO_TEST_CASE(trace_program_cache)
+{
+    boost::shared_ptr<compute::program_cache> cache =
+        compute::program_cache::get_global_cache(context);
+
+    const char source[] =
+        "__kernel void trace_foo(__global int *x) { x[0] = 1; }";
+
+    recording_listener listener;
+    compute::set_trace_listener(&listener);
+
+    cache->get_or_build("test_trace_foo", std::string(), source, context);
+    cache->get_or_build("test_trace_foo", std::string(), source, context);
+
+    compute::set_trace_listener(0);
+
+    BOOST_CHECK_EQUAL(listener.misses, size_t(1));
+    BOOST_CHECK_EQUAL(listener.hits, size_t(1));
+}
+
+#ifdef CL_VERSION_1_1
+BOOST_AUTO_TEST_CASE(trace_strategy)
+{
+    REQUIRES_OPENCL_VERSION(1, 1);
+
+    std::vector<int> data(10000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>(i % 100);
+    }
+    compute::vector<int> vector1(data.begin(), data.end(), queue);
+    compute::vector<int> vector2(data.rbegin(), data.rend(), queue);
+
+    recording_listener listener;
+    compute::set_trace_listener(&listener);
+
+    BOOST_CHECK(compute::is_permutation(
+        vector1.begin(), vector1.end(), vector2.begin(), vector2.end(), queue
+    ));
+    BOOST_CHECK(listener.strategies.empty());
+
+    // too small for the hash table of is_permutation()
+    compute::scratch_space scratch(compute::buffer(context, 4096), false);
+    {
+        compute::scoped_scratch_space use_scratch(scratch);
+        BOOST_CHECK(compute::is_permutation(
+            vector1.begin(), vector1.end(), vector2.begin(), vector2.end(), queue
+        ));
+    }
+
+    compute::set_trace_listener(0);
+
+    BOOST_REQUIRE_EQUAL(listener.strategies.size(), size_t(1));
+    BOOST_CHECK_EQUAL(listener.strategies[0], "is_permutation:host");
+}
+#endif // CL_VERSION_1_1
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -16,9 +16,11 @@
 #include <boost/compute/function.hpp>
 #include <boost/compute/functional.hpp>
 #include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/iterator/counting_iterator.hpp>
 #include <boost/compute/functional/field.hpp>
+#include <boost/compute/utility/dim.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -298,4 +300,90 @@ boost::compute::transform(
     CHECK_RANGE_EQUAL(int, 4, vec, (1, 2, 3, 4));
 }
 
+BOOST_AUTO_TEST_CASE(transform_with_device_value)
+{
+    float data[] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    compute::vector<float> vector(data, data + 4, queue);
+
+    // normalize by the sum without reading it on the host
+    compute::vector<float> sum(1, context);
+    compute::reduce(vector.begin(), vector.end(), sum.begin(), queue);
+    compute::transform(
+        vector.begin(), vector.end(), sum[0], vector.begin(),
+        compute::divides<float>(), queue
+    );
+    CHECK_RANGE_EQUAL(float, 4, vector, (0.1f, 0.2f, 0.3f, 0.4f));
+}
+
+BOOST_AUTO_TEST_CASE(transform_memoized_kernel)
+{
+    int data[] = { -1, 2, -3, 4, -5, 6, -7, 8 };
+    bc::vector<int> input(data, data + 8, queue);
+    bc::vector<int> output(8, context);
+
+    // the kernel is memoized for the offsets of the iterators and for
+    // whether they share a buffer
+    bc::transform(input.begin(), input.end(), output.begin(), bc::abs<int>(), queue);
+    CHECK_RANGE_EQUAL(int, 8, output, (1, 2, 3, 4, 5, 6, 7, 8));
+
+    bc::transform(input.begin() + 2, input.end(), output.begin(), bc::abs<int>(), queue);
+    CHECK_RANGE_EQUAL(int, 8, output, (3, 4, 5, 6, 7, 8, 7, 8));
+
+    bc::transform(input.begin(), input.begin() + 4, input.begin() + 4, bc::abs<int>(), queue);
+    CHECK_RANGE_EQUAL(int, 8, input, (-1, 2, -3, 4, 1, 2, 3, 4));
+
+    // and for the source of the function
+    {
+        BOOST_COMPUTE_FUNCTION(int, memoized_function, (int x),
+        {
+            return x + 1;
+        });
+        bc::transform(input.begin(), input.end(), output.begin(), memoized_function, queue);
+        CHECK_RANGE_EQUAL(int, 8, output, (0, 3, -2, 5, 2, 3, 4, 5));
+    }
+    {
+        BOOST_COMPUTE_FUNCTION(int, memoized_function, (int x),
+        {
+            return x * 2;
+        });
+        bc::transform(input.begin(), input.end(), output.begin(), memoized_function, queue);
+        CHECK_RANGE_EQUAL(int, 8, output, (-2, 4, -6, 8, 2, 4, 6, 8));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(transform_2d_and_3d)
+{
+    using compute::lambda::_1;
+
+    // image of 5x3 values
+    compute::vector<int> output(15, context);
+    compute::transform(
+        compute::make_counting_iterator<int>(0),
+        compute::dim(5, 3),
+        output.begin(),
+        _1 * 2,
+        queue
+    );
+    CHECK_RANGE_EQUAL(
+        int, 15, output,
+        (0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28)
+    );
+
+    // volume of 3x2x4 values
+    compute::vector<int> volume(24, context);
+    compute::transform(
+        compute::make_counting_iterator<int>(0),
+        compute::dim(3, 2, 4),
+        volume.begin(),
+        _1 + 1,
+        queue
+    );
+
+    std::vector<int> host(24);
+    compute::copy(volume.begin(), volume.end(), host.begin(), queue);
+    for(int i = 0; i < 24; i++){
+        BOOST_CHECK_EQUAL(host[i], i + 1);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
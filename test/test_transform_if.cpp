@@ -13,8 +13,10 @@
 
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/functional.hpp>
+#include <boost/compute/algorithm/transform_if.hpp>
 #include <boost/compute/experimental/transform_if.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/dynamic_bitset.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -43,4 +45,52 @@ BOOST_AUTO_TEST_CASE(abs_if_odd)
     CHECK_RANGE_EQUAL(int, 8, vector, (-2, +3, -4, +5, -6, +7, -8, +9));
 }
 
+BOOST_AUTO_TEST_CASE(abs_if_stencil)
+{
+    int data[] = { -2, -3, -4, -5, -6, -7, -8, -9 };
+    compute::vector<int> vector(data, data + 8, queue);
+
+    compute::dynamic_bitset<> stencil(8, queue);
+    stencil.set(0, queue);
+    stencil.set(3, queue);
+    stencil.set(7, queue);
+
+    compute::experimental::transform_if(
+        vector.begin(),
+        vector.end(),
+        stencil,
+        vector.begin(),
+        compute::abs<int>(),
+        queue
+    );
+
+    CHECK_RANGE_EQUAL(int, 8, vector, (+2, -3, -4, +5, -6, -7, -8, +9));
+}
+
+BOOST_AUTO_TEST_CASE(abs_if_odd_compacted)
+{
+    using compute::lambda::_1;
+
+    int data[] = { -2, -3, -4, -5, -6, -7, -8, -9 };
+    compute::vector<int> input(data, data + 8, queue);
+    compute::vector<int> output(8, context);
+
+    compute::vector<int>::iterator end = compute::transform_if(
+        input.begin(),
+        input.end(),
+        output.begin(),
+        compute::abs<int>(),
+        _1 % 2 != 0,
+        queue
+    );
+    BOOST_CHECK(end == output.begin() + 4);
+    CHECK_RANGE_EQUAL(int, 4, output, (3, 5, 7, 9));
+
+    // none selected
+    end = compute::transform_if(
+        input.begin(), input.end(), output.begin(), compute::abs<int>(), _1 > 0, queue
+    );
+    BOOST_CHECK(end == output.begin());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -11,6 +11,11 @@
 #define BOOST_TEST_MODULE TestTransformReduce
 #include <boost/test/unit_test.hpp>
 
+#include <cstdlib>
+#include <vector>
+
+#include <boost/tuple/tuple.hpp>
+
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
@@ -98,4 +103,76 @@ BOOST_AUTO_TEST_CASE(mean_and_std_dev)
     BOOST_CHECK_CLOSE(std_dev, 2.8722813232690143, 1e-4);
 }
 
+BOOST_AUTO_TEST_CASE(sum_abs_int_large)
+{
+    // an odd number of values starting at an unaligned offset so that
+    // both the vector loads and the remaining values are reduced
+    const size_t size = 100003;
+
+    std::vector<int> data(size);
+    for(size_t i = 0; i < size; i++){
+        data[i] = static_cast<int>(i % 7) - 3;
+    }
+    compute::vector<int> vec(data.begin(), data.end(), queue);
+
+    int expected = 0;
+    for(size_t i = 1; i < size; i++){
+        expected += std::abs(data[i]);
+    }
+
+    int sum = 0;
+    compute::transform_reduce(
+        vec.begin() + 1, vec.end(), &sum, compute::abs<int>(), compute::plus<int>(), queue
+    );
+    BOOST_CHECK_EQUAL(sum, expected);
+
+    // sum of the differences of consecutive values
+    compute::transform_reduce(
+        vec.begin() + 1, vec.end(), vec.begin(), &sum,
+        compute::minus<int>(), compute::plus<int>(), queue
+    );
+    BOOST_CHECK_EQUAL(sum, data[size - 1] - data[0]);
+}
+
+BOOST_AUTO_TEST_CASE(sum_and_sum_of_squares)
+{
+    using compute::lambda::_1;
+
+    float data[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    compute::vector<float> vector(data, data + 10, queue);
+
+    // mean and variance from a single pass over the values
+    boost::tuple<float, float> sums;
+    compute::transform_reduce(
+        vector.begin(),
+        vector.end(),
+        &sums,
+        boost::make_tuple(compute::identity<float>(), _1 * _1),
+        boost::make_tuple(compute::plus<float>(), compute::plus<float>()),
+        queue
+    );
+    BOOST_CHECK_CLOSE(boost::get<0>(sums), 55.0f, 1e-4);
+    BOOST_CHECK_CLOSE(boost::get<1>(sums), 385.0f, 1e-4);
+
+    const float mean = boost::get<0>(sums) / vector.size();
+    const float variance = boost::get<1>(sums) / vector.size() - mean * mean;
+    BOOST_CHECK_CLOSE(variance, 8.25f, 1e-3);
+
+    // sum of the absolute values and largest absolute value
+    int int_data[] = { -4, 9, -12, 3 };
+    compute::vector<int> int_vector(int_data, int_data + 4, queue);
+
+    boost::tuple<int, int> abs_values;
+    compute::transform_reduce(
+        int_vector.begin(),
+        int_vector.end(),
+        &abs_values,
+        boost::make_tuple(compute::abs<int>(), compute::abs<int>()),
+        boost::make_tuple(compute::plus<int>(), compute::max<int>()),
+        queue
+    );
+    BOOST_CHECK_EQUAL(boost::get<0>(abs_values), 28);
+    BOOST_CHECK_EQUAL(boost::get<1>(abs_values), 12);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,76 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestTranspose
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/transpose.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(transpose_small)
+{
+    bc::vector<int> matrix(6, context);
+    bc::iota(matrix.begin(), matrix.end(), 1, queue);
+
+    // 2x3 -> 3x2
+    bc::vector<int> result(6, context);
+    bc::vector<int>::iterator end =
+        bc::transpose(matrix.begin(), 2, 3, result.begin(), queue);
+    BOOST_CHECK(end == result.end());
+    CHECK_RANGE_EQUAL(int, 6, result, (1, 4, 2, 5, 3, 6));
+}
+
+BOOST_AUTO_TEST_CASE(transpose_across_tiles)
+{
+    // dimensions which are not multiples of the tile size
+    const size_t rows = 131;
+    const size_t columns = 77;
+
+    std::vector<float> host(rows * columns);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = static_cast<float>(i);
+    }
+
+    bc::vector<float> matrix(host.begin(), host.end(), queue);
+    bc::vector<float> result(host.size(), context);
+
+    boost::shared_ptr<bc::detail::parameter_cache> parameters =
+        bc::detail::parameter_cache::get_global_cache(device);
+
+    const bc::uint_ tile_sizes[] = { 32, 16, 4 };
+    for(size_t t = 0; t < 3; t++){
+        parameters->set("__boost_transpose", "tile_size", tile_sizes[t]);
+
+        bc::transpose(matrix.begin(), rows, columns, result.begin(), queue);
+
+        std::vector<float> transposed(host.size());
+        bc::copy(result.begin(), result.end(), transposed.begin(), queue);
+        for(size_t r = 0; r < rows; r++){
+            for(size_t c = 0; c < columns; c++){
+                BOOST_CHECK_EQUAL(transposed[c * rows + r], host[r * columns + c]);
+            }
+        }
+    }
+
+    parameters->reset("__boost_transpose");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -11,8 +11,15 @@
 #define BOOST_TEST_MODULE TestUniqueCopy
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+#include <algorithm>
+
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/unique_copy.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/sub_group.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -34,4 +41,52 @@ BOOST_AUTO_TEST_CASE(unique_copy_int)
     CHECK_RANGE_EQUAL(int, 5, result, (1, 6, 4, 2, 4));
 }
 
+BOOST_AUTO_TEST_CASE(unique_copy_across_tiles)
+{
+    // runs of equal values spanning the tiles of the work-groups
+    std::vector<int> data(100000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>((i / 3) % 7 + (i / 1000));
+    }
+
+    std::vector<int> expected(data.size());
+    expected.erase(
+        std::unique_copy(data.begin(), data.end(), expected.begin()),
+        expected.end()
+    );
+
+    boost::shared_ptr<bc::detail::parameter_cache> parameters =
+        bc::detail::parameter_cache::get_global_cache(device);
+
+    // check with the default and with the smallest single-pass threshold
+    // (which is only used on devices supporting the opencl 2.0 atomics,
+    // others fall back to the two-pass stream compaction)
+    const bool qualifies =
+        bc::detail::device_profile::get(device)->has_local_memory() &&
+        !bc::detail::memory_model_options(device).empty();
+    const bc::uint_ thresholds[] = { 1 << 16, 1 };
+    for(size_t t = 0; t < 2; t++){
+        parameters->set("__boost_stream_compact", "single_pass_threshold", thresholds[t]);
+        if(t == 1){
+            BOOST_CHECK_EQUAL(
+                bc::detail::use_single_pass_stream_compact(data.size(), queue), qualifies
+            );
+        }
+
+        bc::vector<int> input(data.begin(), data.end(), queue);
+        bc::vector<int> result(data.size(), context);
+        bc::vector<int>::iterator end =
+            bc::unique_copy(input.begin(), input.end(), result.begin(), queue);
+        BOOST_CHECK_EQUAL(
+            static_cast<size_t>(std::distance(result.begin(), end)), expected.size()
+        );
+
+        std::vector<int> host_result(expected.size());
+        bc::copy(result.begin(), end, host_result.begin(), queue);
+        BOOST_CHECK(host_result == expected);
+    }
+
+    parameters->reset("__boost_stream_compact");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
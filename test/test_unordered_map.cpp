@@ -0,0 +1,146 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestUnorderedMap
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/equal.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/unordered_map.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/lambda.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(empty_map)
+{
+    bc::unordered_map<int, float> map(context);
+    BOOST_CHECK(map.empty());
+    BOOST_CHECK_EQUAL(map.size(), size_t(0));
+
+    int data[] = { 1, 2, 3 };
+    bc::vector<int> keys(data, data + 3, queue);
+
+    bc::vector<bc::uint_> counts(3, context);
+    map.count(keys.begin(), keys.end(), counts.begin(), queue);
+    CHECK_RANGE_EQUAL(bc::uint_, 3, counts, (0, 0, 0));
+}
+
+BOOST_AUTO_TEST_CASE(insert_find)
+{
+    bc::unordered_map<int, float> map(context);
+
+    int keys_data[] = { 5, 3, 9, 3, 1 };
+    float values_data[] = { 5.5f, 3.3f, 9.9f, 3.3f, 1.1f };
+    bc::vector<int> keys(keys_data, keys_data + 5, queue);
+    bc::vector<float> values(values_data, values_data + 5, queue);
+
+    map.insert(keys.begin(), keys.end(), values.begin(), queue);
+    BOOST_CHECK_EQUAL(map.size(), size_t(4));
+    BOOST_CHECK(map.load_factor() <= map.max_load_factor());
+
+    int queries_data[] = { 1, 2, 3, 9, 10 };
+    bc::vector<int> queries(queries_data, queries_data + 5, queue);
+
+    bc::vector<float> found(5, context);
+    map.find(queries.begin(), queries.end(), found.begin(), -1.f, queue);
+    CHECK_RANGE_EQUAL(float, 5, found, (1.1f, -1.f, 3.3f, 9.9f, -1.f));
+
+    bc::vector<bc::uint_> counts(5, context);
+    map.count(queries.begin(), queries.end(), counts.begin(), queue);
+    CHECK_RANGE_EQUAL(bc::uint_, 5, counts, (1, 0, 1, 1, 0));
+}
+
+BOOST_AUTO_TEST_CASE(insert_existing_key)
+{
+    bc::unordered_map<bc::uint_, int> map(context);
+
+    bc::vector<bc::uint_> key(1, context);
+    bc::fill(key.begin(), key.end(), bc::uint_(7), queue);
+    bc::vector<int> value(1, context);
+    bc::fill(value.begin(), value.end(), 1, queue);
+    map.insert(key.begin(), key.end(), value.begin(), queue);
+
+    // the stored value is kept
+    bc::fill(value.begin(), value.end(), 2, queue);
+    map.insert(key.begin(), key.end(), value.begin(), queue);
+    BOOST_CHECK_EQUAL(map.size(), size_t(1));
+
+    bc::vector<int> found(1, context);
+    map.find(key.begin(), key.end(), found.begin(), 0, queue);
+    CHECK_RANGE_EQUAL(int, 1, found, (1));
+}
+
+BOOST_AUTO_TEST_CASE(erase)
+{
+    bc::unordered_map<int, int> map(context);
+
+    bc::vector<int> keys(100, context);
+    bc::iota(keys.begin(), keys.end(), 0, queue);
+    map.insert(keys.begin(), keys.end(), keys.begin(), queue);
+    BOOST_CHECK_EQUAL(map.size(), size_t(100));
+
+    BOOST_CHECK_EQUAL(map.erase(keys.begin() + 10, keys.begin() + 20, queue), size_t(10));
+    BOOST_CHECK_EQUAL(map.size(), size_t(90));
+
+    // erasing again removes nothing
+    BOOST_CHECK_EQUAL(map.erase(keys.begin() + 10, keys.begin() + 20, queue), size_t(0));
+
+    bc::vector<bc::uint_> counts(100, context);
+    map.count(keys.begin(), keys.end(), counts.begin(), queue);
+
+    std::vector<bc::uint_> host_counts(100);
+    bc::copy(counts.begin(), counts.end(), host_counts.begin(), queue);
+    for(size_t i = 0; i < 100; i++){
+        BOOST_CHECK_EQUAL(host_counts[i], bc::uint_(i < 10 || i >= 20));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(rehash_and_copy)
+{
+    using bc::lambda::_1;
+
+    const int n = 10000;
+
+    bc::unordered_map<int, int> map(context);
+
+    // insert in a few batches so that the table grows several times
+    bc::vector<int> keys(n, context);
+    bc::iota(keys.begin(), keys.end(), 0, queue);
+    bc::vector<int> values(n, context);
+    bc::transform(keys.begin(), keys.end(), values.begin(), _1 * 2, queue);
+
+    for(int i = 0; i < n; i += 1000){
+        map.insert(keys.begin() + i, keys.begin() + i + 1000, values.begin() + i, queue);
+    }
+    BOOST_CHECK_EQUAL(map.size(), size_t(n));
+    BOOST_CHECK(map.load_factor() <= map.max_load_factor());
+
+    bc::vector<int> found(n, context);
+    map.find(keys.begin(), keys.end(), found.begin(), -1, queue);
+    BOOST_CHECK(bc::equal(found.begin(), found.end(), values.begin(), queue));
+
+    // the stored keys are unique
+    bc::vector<int> stored(n, context);
+    BOOST_CHECK(map.copy_keys(stored.begin(), queue) == stored.end());
+    bc::sort(stored.begin(), stored.end(), queue);
+    BOOST_CHECK(bc::equal(stored.begin(), stored.end(), keys.begin(), queue));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -13,6 +13,7 @@
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/function.hpp>
 #include <boost/compute/container/valarray.hpp>
 
 #include "context_setup.hpp"
@@ -59,4 +60,56 @@ BOOST_AUTO_TEST_CASE(sum)
     BOOST_CHECK_EQUAL(array.sum(), int(10));
 }
 
+BOOST_AUTO_TEST_CASE(expression)
+{
+    float a_data[] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    float b_data[] = { 2.0f, 3.0f, 4.0f, 5.0f };
+    boost::compute::valarray<float> a(a_data, 4);
+    boost::compute::valarray<float> b(b_data, 4);
+
+    boost::compute::valarray<float> r = a * b + 2.0f * a - b / 2.0f;
+    BOOST_CHECK_EQUAL(r.size(), size_t(4));
+    boost::compute::system::finish();
+    BOOST_CHECK_CLOSE(float(r[0]), 3.0f, 1e-4f);
+    BOOST_CHECK_CLOSE(float(r[1]), 8.5f, 1e-4f);
+    BOOST_CHECK_CLOSE(float(r[2]), 16.0f, 1e-4f);
+    BOOST_CHECK_CLOSE(float(r[3]), 25.5f, 1e-4f);
+
+    // the result may alias an operand
+    r = -r + r * 2.0f;
+    r += a;
+    r *= 2.0f;
+    boost::compute::system::finish();
+    BOOST_CHECK_CLOSE(float(r[0]), 8.0f, 1e-4f);
+    BOOST_CHECK_CLOSE(float(r[3]), 59.0f, 1e-4f);
+
+    // the copy holds its own values
+    boost::compute::valarray<float> copy(a);
+    a = 0.0f;
+    boost::compute::system::finish();
+    BOOST_CHECK_EQUAL(float(copy[2]), 3.0f);
+}
+
+BOOST_AUTO_TEST_CASE(expression_reduce)
+{
+    int a_data[] = { 1, 2, 3, 4, 5 };
+    int b_data[] = { 5, 1, 4, 2, 3 };
+    boost::compute::valarray<int> a(a_data, 5);
+    boost::compute::valarray<int> b(b_data, 5);
+
+    BOOST_CHECK_EQUAL((a * b).sum(), 42);
+    BOOST_CHECK_EQUAL(((a - b).min)(), -4);
+    BOOST_CHECK_EQUAL(((a - b).max)(), 2);
+
+    BOOST_COMPUTE_FUNCTION(int, square, (int x),
+    {
+        return x * x;
+    });
+    BOOST_CHECK_EQUAL((a + 1).apply(square).sum(), 90);
+
+    boost::compute::valarray<int> squares = a.apply(square);
+    boost::compute::system::finish();
+    BOOST_CHECK_EQUAL(int(squares[4]), 25);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
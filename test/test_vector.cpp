@@ -13,6 +13,8 @@
 
 #include <boost/concept_check.hpp>
 
+#include <list>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/copy.hpp>
@@ -329,4 +331,93 @@ BOOST_AUTO_TEST_CASE(resize_throw_exception)
     CHECK_RANGE_EQUAL(int, 8, vec, (1, 2, 3, 4, 5, 6, 7, 8));
 }
 
+BOOST_AUTO_TEST_CASE(reserve_and_shrink_to_fit)
+{
+    bc::vector<int> vector(context);
+    vector.push_back(1, queue);
+    vector.push_back(2, queue);
+
+    vector.reserve(100, queue);
+    BOOST_CHECK_EQUAL(vector.size(), size_t(2));
+    BOOST_CHECK_GE(vector.capacity(), size_t(100));
+    CHECK_RANGE_EQUAL(int, 2, vector, (1, 2));
+
+    // appending within the capacity keeps the buffer
+    const bc::buffer buffer = vector.get_buffer();
+    for(int i = 0; i < 50; i++){
+        vector.push_back(i, queue);
+    }
+    BOOST_CHECK(vector.get_buffer() == buffer);
+
+    vector.resize(3, queue);
+    vector.shrink_to_fit(queue);
+    BOOST_CHECK_EQUAL(vector.size(), size_t(3));
+    BOOST_CHECK_LT(vector.capacity(), size_t(100));
+    CHECK_RANGE_EQUAL(int, 3, vector, (1, 2, 0));
+}
+
+BOOST_AUTO_TEST_CASE(resize_uninitialized_and_reserve_discard)
+{
+    int data[] = { 1, 2, 3, 4 };
+    bc::vector<int> vector(data, data + 4, queue);
+
+    vector.resize_uninitialized(2);
+    BOOST_CHECK_EQUAL(vector.size(), size_t(2));
+
+    // growing replaces the buffer without copying the values
+    vector.resize_uninitialized(100);
+    BOOST_CHECK_EQUAL(vector.size(), size_t(100));
+    BOOST_CHECK_GE(vector.capacity(), size_t(100));
+    bc::fill(vector.begin(), vector.end(), 7, queue);
+    queue.finish();
+    BOOST_CHECK_EQUAL(vector[99], 7);
+
+    vector.reserve_discard(500);
+    BOOST_CHECK_EQUAL(vector.size(), size_t(100));
+    BOOST_CHECK_GE(vector.capacity(), size_t(500));
+
+    // reserving within the capacity keeps the buffer
+    const bc::buffer buffer = vector.get_buffer();
+    vector.reserve_discard(200);
+    BOOST_CHECK(vector.get_buffer() == buffer);
+}
+
+BOOST_AUTO_TEST_CASE(push_back_amortized_growth)
+{
+    bc::vector<int> vector(context);
+
+    // count the number of reallocations
+    size_t reallocations = 0;
+    size_t capacity = vector.capacity();
+    for(int i = 0; i < 1000; i++){
+        vector.push_back(i, queue);
+        if(vector.capacity() != capacity){
+            capacity = vector.capacity();
+            reallocations++;
+        }
+    }
+    BOOST_CHECK_EQUAL(vector.size(), size_t(1000));
+    BOOST_CHECK_LT(reallocations, size_t(20));
+    BOOST_CHECK_EQUAL(int(vector[999]), 999);
+}
+
+BOOST_AUTO_TEST_CASE(append)
+{
+    bc::vector<int> vector(context);
+    vector.push_back(1, queue);
+
+    // contiguous host range
+    int data[] = { 2, 3, 4 };
+    vector.append(data, data + 3, queue);
+
+    // non-contiguous host range
+    std::list<int> list;
+    list.push_back(5);
+    list.push_back(6);
+    vector.append(list.begin(), list.end(), queue);
+
+    BOOST_CHECK_EQUAL(vector.size(), size_t(6));
+    CHECK_RANGE_EQUAL(int, 6, vector, (1, 2, 3, 4, 5, 6));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestWaitStrategy
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/wait_strategy.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(blocking)
+{
+    compute::wait_strategy strategy = compute::wait_strategy::blocking();
+    BOOST_CHECK(strategy.is_blocking());
+    BOOST_CHECK_EQUAL(strategy.spin_time(), compute::ulong_(0));
+
+    strategy = compute::wait_strategy(50, 100);
+    BOOST_CHECK(!strategy.is_blocking());
+    BOOST_CHECK_EQUAL(strategy.spin_time(), compute::ulong_(50));
+    BOOST_CHECK_EQUAL(strategy.yield_time(), compute::ulong_(100));
+}
+
+BOOST_AUTO_TEST_CASE(finish_with_spin)
+{
+    compute::vector<int> vector(1024, context);
+    compute::fill(vector.begin(), vector.end(), 7, queue);
+
+    queue.finish(compute::wait_strategy(1000, 1000));
+
+    std::vector<int> host(1024);
+    queue.enqueue_read_buffer(
+        vector.get_buffer(), 0, vector.size() * sizeof(int), &host[0]
+    );
+    BOOST_CHECK_EQUAL(host[0], 7);
+    BOOST_CHECK_EQUAL(host[1023], 7);
+}
+
+BOOST_AUTO_TEST_CASE(default_strategy)
+{
+    const compute::wait_strategy previous = compute::wait_strategy::get_default();
+    compute::wait_strategy::set_default(compute::wait_strategy(1000));
+
+    // blocking copies now poll their events
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> vector(4, context);
+    compute::copy(data, data + 4, vector.begin(), queue);
+    compute::fill(vector.begin() + 2, vector.end(), 0, queue);
+    CHECK_RANGE_EQUAL(int, 4, vector, (1, 2, 0, 0));
+    queue.finish();
+
+    compute::wait_strategy::set_default(previous);
+}
+
+#ifdef CL_VERSION_1_1
+BOOST_AUTO_TEST_CASE(wait_for_user_event)
+{
+    compute::user_event event(context);
+    event.set_status(CL_COMPLETE);
+    event.wait(compute::wait_strategy(1000));
+    BOOST_CHECK(event.status() == CL_COMPLETE);
+
+    // failed commands are reported by throwing
+    compute::user_event failed(context);
+    failed.set_status(-1);
+    BOOST_CHECK_THROW(
+        failed.wait(compute::wait_strategy(1000)), compute::opencl_error
+    );
+}
+#endif // CL_VERSION_1_1
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,128 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestWalkImage
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/image/image2d.hpp>
+#include <boost/compute/image/walk_image.hpp>
+#include <boost/compute/utility/dim.hpp>
+
+#include "quirks.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(walk_image2d_uint)
+{
+    compute::image_format format(CL_RGBA, CL_UNSIGNED_INT8);
+    if(!compute::image2d::is_supported_format(format, context)){
+        std::cerr << "skipping walk_image2d_uint test, image format not supported" << std::endl;
+        return;
+    }
+
+    compute::image2d image(context, 64, 32, format);
+
+    BOOST_COMPUTE_FUNCTION(compute::uint4_, coordinates, (compute::int2_ coord),
+    {
+        return (uint4)(coord.x, coord.y, coord.x + coord.y, 255);
+    });
+
+    compute::walk_image(image, coordinates, queue);
+
+    std::vector<compute::uchar_> texels(64 * 32 * 4);
+    queue.enqueue_read_image(
+        image, image.origin(), image.size(), &texels[0]
+    );
+
+    for(size_t y = 0; y < 32; y++){
+        for(size_t x = 0; x < 64; x++){
+            const compute::uchar_ *texel = &texels[(y * 64 + x) * 4];
+            BOOST_CHECK_EQUAL(int(texel[0]), int(x));
+            BOOST_CHECK_EQUAL(int(texel[1]), int(y));
+            BOOST_CHECK_EQUAL(int(texel[2]), int(x + y));
+            BOOST_CHECK_EQUAL(int(texel[3]), 255);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(walk_image2d_region)
+{
+    compute::image_format format(CL_R, CL_FLOAT);
+    if(!compute::image2d::is_supported_format(format, context)){
+        std::cerr << "skipping walk_image2d_region test, image format not supported" << std::endl;
+        return;
+    }
+
+    compute::image2d image(context, 8, 8, format);
+
+    BOOST_COMPUTE_FUNCTION(compute::float4_, zero, (compute::int2_ coord),
+    {
+        return (float4)(0.0f);
+    });
+    BOOST_COMPUTE_FUNCTION(compute::float4_, row, (compute::int2_ coord),
+    {
+        return (float4)(coord.y);
+    });
+
+    // only the 4x2 rectangle at (2, 3) is written with the second function
+    compute::walk_image(image, zero, queue);
+    compute::walk_image(image, compute::dim(2, 3), compute::dim(4, 2), row, queue);
+
+    std::vector<float> texels(8 * 8);
+    queue.enqueue_read_image(
+        image, image.origin(), image.size(), &texels[0]
+    );
+
+    for(size_t y = 0; y < 8; y++){
+        for(size_t x = 0; x < 8; x++){
+            const bool inside = x >= 2 && x < 6 && y >= 3 && y < 5;
+            BOOST_CHECK_EQUAL(texels[y * 8 + x], inside ? float(y) : 0.0f);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(rawfill_image2d)
+{
+    compute::image_format format(CL_RGBA, CL_UNSIGNED_INT8);
+    if(!compute::image2d::is_supported_format(format, context)){
+        std::cerr << "skipping rawfill_image2d test, image format not supported" << std::endl;
+        return;
+    }
+
+    compute::image2d image(context, 16, 16, format);
+
+    const compute::uchar_ black[] = { 0, 0, 0, 255 };
+    const compute::uchar_ red[] = { 255, 0, 0, 255 };
+    compute::rawfill_image(image, black, image.origin(), image.size(), queue);
+    compute::rawfill_image(image, red, compute::dim(4, 4), compute::dim(8, 8), queue);
+
+    std::vector<compute::uchar_> texels(16 * 16 * 4);
+    queue.enqueue_read_image(
+        image, image.origin(), image.size(), &texels[0]
+    );
+
+    for(size_t y = 0; y < 16; y++){
+        for(size_t x = 0; x < 16; x++){
+            const bool inside = x >= 4 && x < 12 && y >= 4 && y < 12;
+            const compute::uchar_ *expected = inside ? red : black;
+            const compute::uchar_ *texel = &texels[(y * 16 + x) * 4];
+            BOOST_CHECK(std::equal(texel, texel + 4, expected));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
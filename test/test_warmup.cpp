@@ -0,0 +1,56 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestWarmup
+#include <boost/test/unit_test.hpp>
+
+#include <boost/mpl/vector.hpp>
+
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/is_sorted.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/warmup.hpp>
+#include <boost/compute/utility/program_cache.hpp>
+
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(warmup_sort_int)
+{
+    boost::shared_ptr<compute::program_cache> cache =
+        compute::program_cache::get_global_cache(context);
+    cache->clear();
+
+    compute::warmup<int>(compute::warmup_sort, queue);
+    size_t size = cache->size();
+    BOOST_CHECK(size > 0);
+
+    // sorting ints now uses the programs built by warmup()
+    int data[] = { 5, 2, 8, 1, 9, 3, 7, 4, 6, 0 };
+    compute::vector<int> vector(data, data + 10, queue);
+    compute::sort(vector.begin(), vector.end(), queue);
+    BOOST_CHECK_EQUAL(cache->size(), size);
+    BOOST_CHECK(compute::is_sorted(vector.begin(), vector.end(), queue));
+}
+
+BOOST_AUTO_TEST_CASE(warmup_type_list)
+{
+    boost::shared_ptr<compute::program_cache> cache =
+        compute::program_cache::get_global_cache(context);
+    cache->clear();
+
+    compute::warmup<boost::mpl::vector<compute::uint_, float> >(
+        compute::warmup_reduce | compute::warmup_scan, queue
+    );
+    BOOST_CHECK(cache->size() > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,112 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestWorkQueue
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <algorithm>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/equal.hpp>
+#include <boost/compute/algorithm/for_each.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/work_queue.hpp>
+#include <boost/compute/lambda.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(push_from_kernel)
+{
+    compute::work_queue<int> work(1000, queue);
+    BOOST_CHECK_EQUAL(work.capacity(), size_t(1000));
+    BOOST_CHECK(work.empty(queue));
+
+    compute::vector<int> values(500, context);
+    compute::iota(values.begin(), values.end(), 0, queue);
+
+    // each work-item pushes its value
+    compute::for_each(values.begin(), values.end(), work.pusher(), queue);
+    BOOST_CHECK_EQUAL(work.size(queue), size_t(500));
+    BOOST_CHECK(!work.overflowed(queue));
+
+    // the values are pushed in an unspecified order
+    compute::sort(work.begin(), work.end(queue), queue);
+    BOOST_CHECK(compute::equal(work.begin(), work.end(queue), values.begin(), queue));
+
+    work.clear(queue);
+    BOOST_CHECK(work.empty(queue));
+}
+
+BOOST_AUTO_TEST_CASE(push_if)
+{
+    using compute::_1;
+
+    std::vector<int> data(12345);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int>((i * 7919) % 1000);
+    }
+    compute::vector<int> input(data.begin(), data.end(), queue);
+
+    compute::work_queue<int> work(data.size(), queue);
+    work.push_if(input.begin(), input.end(), _1 < 10, queue);
+    work.push(input.begin(), input.begin() + 10, queue);
+
+    std::vector<int> expected;
+    for(size_t i = 0; i < data.size(); i++){
+        if(data[i] < 10){
+            expected.push_back(data[i]);
+        }
+    }
+    expected.insert(expected.end(), data.begin(), data.begin() + 10);
+    std::sort(expected.begin(), expected.end());
+
+    BOOST_CHECK_EQUAL(work.size(queue), expected.size());
+
+    std::vector<int> drained(expected.size());
+    BOOST_CHECK(work.drain(drained.begin(), queue) == drained.end());
+    BOOST_CHECK(work.empty(queue));
+
+    std::sort(drained.begin(), drained.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        drained.begin(), drained.end(), expected.begin(), expected.end()
+    );
+}
+
+BOOST_AUTO_TEST_CASE(overflow)
+{
+    compute::work_queue<int> work(100, queue);
+
+    compute::vector<int> values(250, context);
+    compute::iota(values.begin(), values.end(), 0, queue);
+
+    // the values pushed when the queue is full are dropped
+    work.push(values.begin(), values.end(), queue);
+    BOOST_CHECK_EQUAL(work.size(queue), size_t(100));
+    BOOST_CHECK(work.overflowed(queue));
+
+    work.clear(queue);
+    BOOST_CHECK(!work.overflowed(queue));
+
+    // swapping exchanges the values and capacities
+    compute::work_queue<int> other(10, queue);
+    other.push(values.begin(), values.begin() + 5, queue);
+    work.swap(other);
+    BOOST_CHECK_EQUAL(work.capacity(), size_t(10));
+    BOOST_CHECK_EQUAL(work.size(queue), size_t(5));
+    BOOST_CHECK(other.empty(queue));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,69 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2015 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://kylelutz.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestZeroCopyAllocator
+#include <boost/test/unit_test.hpp>
+
+#include <list>
+#include <vector>
+
+#include <boost/compute/allocator/zero_copy_allocator.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/device_profile.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(mem_flags)
+{
+    compute::zero_copy_allocator<int> allocator(context);
+    compute::detail::device_ptr<int> ptr = allocator.allocate(16);
+
+    const bool host_memory =
+        (ptr.get_buffer().get_memory_flags() & CL_MEM_ALLOC_HOST_PTR) != 0;
+    BOOST_CHECK_EQUAL(
+        host_memory,
+        compute::detail::device_profile::get(device)->host_unified_memory()
+    );
+
+    allocator.deallocate(ptr, 16);
+}
+
+BOOST_AUTO_TEST_CASE(copy_to_and_from_host)
+{
+    typedef compute::vector<int, compute::zero_copy_allocator<int> > vector_type;
+
+    std::vector<int> host(1024);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = int(i);
+    }
+
+    vector_type vector(host.size(), context);
+    compute::copy(host.begin(), host.end(), vector.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 4, vector, (0, 1, 2, 3));
+
+    compute::iota(vector.begin(), vector.end(), 10, queue);
+
+    // non-contiguous host ranges are copied directly as well
+    std::list<int> list(host.size());
+    compute::copy(vector.begin(), vector.end(), list.begin(), queue);
+    BOOST_CHECK_EQUAL(list.front(), 10);
+    BOOST_CHECK_EQUAL(list.back(), int(host.size()) + 9);
+
+    // copies of a sub-range only touch that range
+    compute::copy(host.begin(), host.begin() + 2, vector.begin() + 1, queue);
+    CHECK_RANGE_EQUAL(int, 4, vector, (10, 0, 1, 13));
+}
+
+BOOST_AUTO_TEST_SUITE_END()